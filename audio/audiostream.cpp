@@ -20,9 +20,13 @@
  *
  */
 
+#include "common/array.h"
+#include "common/atomic.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/mutex.h"
+#include "common/system.h"
+#include "common/taskscheduler.h"
 #include "common/textconsole.h"
 #include "common/queue.h"
 #include "common/util.h"
@@ -66,25 +70,33 @@ static const StreamFileFormat STREAM_FILEFORMATS[] = {
 
 SeekableAudioStream *SeekableAudioStream::openStreamFile(const Common::String &basename) {
 	SeekableAudioStream *stream = NULL;
+	StreamFileFactory factory;
+	Common::SeekableReadStream *fileHandle = findStreamFile(basename, factory);
+
+	// Create the stream object
+	if (fileHandle)
+		stream = factory(fileHandle, DisposeAfterUse::YES);
+
+	if (stream == NULL)
+		debug(1, "SeekableAudioStream::openStreamFile: Could not open compressed AudioFile %s", basename.c_str());
+
+	return stream;
+}
+
+Common::SeekableReadStream *SeekableAudioStream::findStreamFile(const Common::String &basename, StreamFileFactory &factory) {
 	Common::File *fileHandle = new Common::File();
 
 	for (int i = 0; i < ARRAYSIZE(STREAM_FILEFORMATS); ++i) {
 		Common::String filename = basename + STREAM_FILEFORMATS[i].fileExtension;
 		fileHandle->open(filename);
 		if (fileHandle->isOpen()) {
-			// Create the stream object
-			stream = STREAM_FILEFORMATS[i].openStreamFile(fileHandle, DisposeAfterUse::YES);
-			fileHandle = 0;
-			break;
+			factory = STREAM_FILEFORMATS[i].openStreamFile;
+			return fileHandle;
 		}
 	}
 
 	delete fileHandle;
-
-	if (stream == NULL)
-		debug(1, "SeekableAudioStream::openStreamFile: Could not open compressed AudioFile %s", basename.c_str());
-
-	return stream;
+	return NULL;
 }
 
 #pragma mark -
@@ -111,29 +123,43 @@ int LoopingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
 
 	int samplesRead = _parent->readBuffer(buffer, numSamples);
 
-	if (_parent->endOfStream()) {
-		++_completeIterations;
-		if (_completeIterations == _loops)
-			return samplesRead;
+	if (_parent->endOfStream() && startNextLoop())
+		return samplesRead + readBuffer(buffer + samplesRead, numSamples - samplesRead);
 
-		const int remainingSamples = numSamples - samplesRead;
+	return samplesRead;
+}
 
-		if (!_parent->rewind()) {
-			// TODO: Properly indicate error
-			_loops = _completeIterations = 1;
-			return samplesRead;
-		}
-		if (_parent->endOfStream()) {
-			// Apparently this is an empty stream
-			_loops = _completeIterations = 1;
-		}
+int LoopingAudioStream::getReadPointer(const int16 *&samples, int numSamples) {
+	if ((_loops && _completeIterations == _loops) || !numSamples)
+		return 0;
 
-		return samplesRead + readBuffer(buffer + samplesRead, remainingSamples);
-	}
+	// The samples stay valid over the rewind, and the caller reads the
+	// next loop with its next call
+	const int samplesRead = _parent->getReadPointer(samples, numSamples);
+	if (samplesRead >= 0 && _parent->endOfStream())
+		startNextLoop();
 
 	return samplesRead;
 }
 
+bool LoopingAudioStream::startNextLoop() {
+	++_completeIterations;
+	if (_completeIterations == _loops)
+		return false;
+
+	if (!_parent->rewind()) {
+		// TODO: Properly indicate error
+		_loops = _completeIterations = 1;
+		return false;
+	}
+	if (_parent->endOfStream()) {
+		// Apparently this is an empty stream
+		_loops = _completeIterations = 1;
+	}
+
+	return true;
+}
+
 bool LoopingAudioStream::endOfData() const {
 	return (_loops != 0 && _completeIterations == _loops) || _parent->endOfData();
 }
@@ -221,6 +247,36 @@ int SubLoopingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
 	}
 }
 
+int SubLoopingAudioStream::getReadPointer(const int16 *&samples, int numSamples) {
+	if (_done)
+		return 0;
+
+	const int framesLeft = MIN(_loopEnd.frameDiff(_pos), numSamples);
+	const int framesRead = _parent->getReadPointer(samples, framesLeft);
+	if (framesRead < 0)
+		return -1;
+
+	_pos = _pos.addFrames(framesRead);
+
+	// The samples stay valid over the seek, and the caller reads the next
+	// loop with its next call
+	if (framesRead < framesLeft && _parent->endOfStream()) {
+		// TODO: Proper error indication.
+		_done = true;
+	} else if (_pos == _loopEnd) {
+		if (_loops != 0 && !--_loops) {
+			_done = true;
+		} else if (!_parent->seek(_loopStart)) {
+			// TODO: Proper error indication.
+			_done = true;
+		} else {
+			_pos = _loopStart;
+		}
+	}
+
+	return framesRead;
+}
+
 bool SubLoopingAudioStream::endOfData() const {
 	// We're out of data if this stream is finished or the parent
 	// has run out of data for now.
@@ -254,6 +310,13 @@ int SubSeekableAudioStream::readBuffer(int16 *buffer, const int numSamples) {
 	return framesRead;
 }
 
+int SubSeekableAudioStream::getReadPointer(const int16 *&samples, int numSamples) {
+	const int framesRead = _parent->getReadPointer(samples, MIN(_length.frameDiff(_pos), numSamples));
+	if (framesRead > 0)
+		_pos = _pos.addFrames(framesRead);
+	return framesRead;
+}
+
 bool SubSeekableAudioStream::seek(const Timestamp &where) {
 	_pos = convertTimeToStreamPos(where, getRate(), isStereo());
 	if (_pos > _length) {
@@ -323,13 +386,23 @@ private:
 	 */
 	Common::Queue<StreamHolder> _queue;
 
+	/**
+	 * A stream taken off the queue whose samples getReadPointer() may
+	 * still point to, until the next read.
+	 */
+	AudioStream *_retired;
+
+	/** Take the front stream off the queue, destroying it when due */
+	void popStream(bool keepSamples);
+
 public:
 	QueuingAudioStreamImpl(int rate, bool stereo)
-	    : _rate(rate), _stereo(stereo), _finished(false) {}
+	    : _rate(rate), _stereo(stereo), _finished(false), _retired(nullptr) {}
 	~QueuingAudioStreamImpl();
 
 	// Implement the AudioStream API
 	virtual int readBuffer(int16 *buffer, const int numSamples);
+	virtual int getReadPointer(const int16 *&samples, int numSamples);
 	virtual bool isStereo() const { return _stereo; }
 	virtual int getRate() const { return _rate; }
 
@@ -358,6 +431,7 @@ public:
 };
 
 QueuingAudioStreamImpl::~QueuingAudioStreamImpl() {
+	delete _retired;
 	while (!_queue.empty()) {
 		StreamHolder tmp = _queue.pop();
 		if (tmp._disposeAfterUse == DisposeAfterUse::YES)
@@ -374,19 +448,30 @@ void QueuingAudioStreamImpl::queueAudioStream(AudioStream *stream, DisposeAfterU
 	_queue.push(StreamHolder(stream, disposeAfterUse));
 }
 
+void QueuingAudioStreamImpl::popStream(bool keepSamples) {
+	StreamHolder tmp = _queue.pop();
+	if (tmp._disposeAfterUse == DisposeAfterUse::YES) {
+		if (keepSamples)
+			_retired = tmp._stream;
+		else
+			delete tmp._stream;
+	}
+}
+
 int QueuingAudioStreamImpl::readBuffer(int16 *buffer, const int numSamples) {
 	Common::StackLock lock(_mutex);
 	int samplesDecoded = 0;
 
+	delete _retired;
+	_retired = nullptr;
+
 	while (samplesDecoded < numSamples && !_queue.empty()) {
 		AudioStream *stream = _queue.front()._stream;
 		samplesDecoded += stream->readBuffer(buffer + samplesDecoded, numSamples - samplesDecoded);
 
 		// Done with the stream completely
 		if (stream->endOfStream()) {
-			StreamHolder tmp = _queue.pop();
-			if (tmp._disposeAfterUse == DisposeAfterUse::YES)
-				delete stream;
+			popStream(false);
 			continue;
 		}
 
@@ -398,6 +483,31 @@ int QueuingAudioStreamImpl::readBuffer(int16 *buffer, const int numSamples) {
 	return samplesDecoded;
 }
 
+int QueuingAudioStreamImpl::getReadPointer(const int16 *&samples, int numSamples) {
+	Common::StackLock lock(_mutex);
+
+	delete _retired;
+	_retired = nullptr;
+
+	// Streams with nothing left are taken off right away, like in
+	// readBuffer(), so that endOfData() looks at the next one
+	while (!_queue.empty()) {
+		AudioStream *stream = _queue.front()._stream;
+		const int samplesRead = stream->getReadPointer(samples, numSamples);
+		if (samplesRead < 0)
+			return -1;
+
+		const bool ended = stream->endOfStream();
+		if (ended)
+			popStream(samplesRead > 0);
+
+		if (samplesRead > 0 || !ended)
+			return samplesRead;
+	}
+
+	return 0;
+}
+
 QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo) {
 	return new QueuingAudioStreamImpl(rate, stereo);
 }
@@ -448,6 +558,13 @@ public:
 		return samplesRead;
 	}
 
+	int getReadPointer(const int16 *&samples, int numSamples) {
+		const int samplesRead = _parentStream->getReadPointer(samples, MIN<int>(numSamples, _totalSamples - _samplesRead));
+		if (samplesRead > 0)
+			_samplesRead += samplesRead;
+		return samplesRead;
+	}
+
 	bool endOfData() const { return _parentStream->endOfData() || reachedLimit(); }
 	bool endOfStream() const { return _parentStream->endOfStream() || reachedLimit(); }
 	bool isStereo() const { return _parentStream->isStereo(); }
@@ -486,4 +603,229 @@ AudioStream *makeNullAudioStream() {
 	return new NullAudioStream();
 }
 
+#pragma mark -
+#pragma mark --- BufferedAudioStream ---
+#pragma mark -
+
+/**
+ * A SeekableAudioStream wrapper which decodes its parent ahead on a
+ * TaskScheduler worker, into a ring buffer with a single reader and a
+ * single writer.
+ */
+class BufferedAudioStream : public SeekableAudioStream {
+public:
+	BufferedAudioStream(SeekableAudioStream *parent, DisposeAfterUse::Flag disposeAfterUse, uint bufferLength, Common::TaskScheduler *scheduler);
+	~BufferedAudioStream();
+
+	int readBuffer(int16 *buffer, const int numSamples);
+	bool endOfData() const;
+	bool isStereo() const { return _stereo; }
+	int getRate() const { return _rate; }
+
+	bool seek(const Timestamp &where);
+	Timestamp getLength() const { return _length; }
+
+private:
+	class DecodeTask;
+	friend class DecodeTask;
+
+	/** Decode until the buffer is full, on the worker. */
+	void decode();
+	/** Start the worker, unless it runs already or there is no room for a chunk. */
+	void scheduleDecode();
+	/** Wait for the worker to stop. */
+	void stopDecode();
+
+	uint32 getFreeSpace() const { return _size - (uint32)(_writePos.load() - _readPos.load()); }
+
+	Common::DisposablePtr<SeekableAudioStream> _parent;
+	/** Null when reading from the parent directly */
+	Common::TaskScheduler *_scheduler;
+
+	// Asking the parent while it is decoding is not safe
+	const bool _stereo;
+	const int _rate;
+	const Timestamp _length;
+
+	/** The ring buffer, its size in samples a power of two */
+	Common::Array<int16> _buffer;
+	uint32 _size;
+	/** Samples the worker decodes at a time, and the room to start it for */
+	uint32 _chunkSize;
+
+	/** Samples read and decoded since the last seek, written by the reader and by the worker */
+	Common::AtomicInt32 _readPos, _writePos;
+	/** Set by the worker once the parent has run out of data */
+	Common::AtomicInt32 _ended;
+	/** Whether the worker is scheduled or running */
+	Common::AtomicInt32 _decoding;
+	/** Asks the worker to stop */
+	Common::AtomicInt32 _stop;
+	/**
+	 * Guards _future, which both the reader and a seeking thread set. Null
+	 * without an OSystem, which implies a single thread.
+	 */
+	Common::Mutex *_futureMutex;
+	Common::TaskFuture _future;
+};
+
+class BufferedAudioStream::DecodeTask : public Common::Task {
+public:
+	DecodeTask(BufferedAudioStream &stream) : _stream(stream) {}
+
+	virtual void run() { _stream.decode(); }
+
+private:
+	BufferedAudioStream &_stream;
+};
+
+BufferedAudioStream::BufferedAudioStream(SeekableAudioStream *parent, DisposeAfterUse::Flag disposeAfterUse, uint bufferLength, Common::TaskScheduler *scheduler)
+	: _parent(parent, disposeAfterUse), _scheduler(scheduler), _stereo(parent->isStereo()), _rate(parent->getRate()),
+	  _length(parent->getLength()), _size(0), _chunkSize(0), _futureMutex(nullptr) {
+
+	if (!_scheduler && g_system)
+		_scheduler = g_system->getTaskScheduler();
+
+	// A serial scheduler would decode in readBuffer() all the same
+	if (!_scheduler || _scheduler->isSerial()) {
+		_scheduler = nullptr;
+		return;
+	}
+
+	const uint32 samples = (uint32)_rate * bufferLength / 1000 * (_stereo ? 2 : 1);
+	_size = 1024;
+	while (_size < samples)
+		_size *= 2;
+
+	_buffer.resize(_size);
+	_chunkSize = _size / 4;
+
+	if (g_system)
+		_futureMutex = new Common::Mutex();
+
+	scheduleDecode();
+}
+
+BufferedAudioStream::~BufferedAudioStream() {
+	if (_scheduler)
+		stopDecode();
+	delete _futureMutex;
+}
+
+int BufferedAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	if (!_scheduler)
+		return _parent->readBuffer(buffer, numSamples);
+
+	// When the worker falls behind, return what there is rather than wait
+	const uint32 readPos = _readPos.load();
+	uint32 count = MIN<uint32>(numSamples, (uint32)_writePos.load() - readPos);
+	if (_stereo)
+		count &= ~1;
+
+	const uint32 start = readPos & (_size - 1);
+	const uint32 first = MIN(count, _size - start);
+	memcpy(buffer, &_buffer[start], first * sizeof(int16));
+	memcpy(buffer + first, &_buffer[0], (count - first) * sizeof(int16));
+	_readPos.store(readPos + count);
+
+	scheduleDecode();
+	return count;
+}
+
+bool BufferedAudioStream::endOfData() const {
+	if (!_scheduler)
+		return _parent->endOfData();
+
+	// Nothing is decoded anymore once _ended is set
+	return _ended.load() && _writePos.load() == _readPos.load();
+}
+
+bool BufferedAudioStream::seek(const Timestamp &where) {
+	if (!_scheduler)
+		return _parent->seek(where);
+
+	// Drop what was decoded from the old position
+	stopDecode();
+	const bool result = _parent->seek(where);
+	_readPos.store(0);
+	_writePos.store(0);
+	_ended.store(0);
+
+	scheduleDecode();
+	return result;
+}
+
+void BufferedAudioStream::decode() {
+	for (;;) {
+		bool dry = false;
+
+		while (!_stop.load() && !_ended.load()) {
+			const uint32 space = getFreeSpace();
+			if (space < _chunkSize)
+				break;
+
+			const uint32 writePos = _writePos.load();
+			const uint32 start = writePos & (_size - 1);
+			const int count = MIN(MIN(space, _chunkSize), _size - start);
+
+			const int samples = _parent->readBuffer(&_buffer[start], count);
+			if (samples > 0)
+				_writePos.store(writePos + samples);
+
+			if (samples < count) {
+				if (samples < 0 || _parent->endOfData())
+					_ended.store(1);
+
+				// Otherwise the parent has no data for now: try again on the next read
+				dry = true;
+				break;
+			}
+		}
+
+		_decoding.store(0);
+
+		// The reader may have made room after the last check, and left
+		// decoding it to this worker
+		if (dry || _stop.load() || _ended.load() || getFreeSpace() < _chunkSize || !_decoding.compareExchange(0, 1))
+			return;
+	}
+}
+
+void BufferedAudioStream::scheduleDecode() {
+	if (_stop.load() || _ended.load() || _decoding.load() || getFreeSpace() < _chunkSize)
+		return;
+
+	if (_futureMutex)
+		_futureMutex->lock();
+
+	// _stop is checked again under the lock, so that stopDecode() gets the
+	// future of any task started before it asked to stop
+	if (!_stop.load() && _decoding.compareExchange(0, 1))
+		_future = _scheduler->schedule(new DecodeTask(*this));
+
+	if (_futureMutex)
+		_futureMutex->unlock();
+}
+
+void BufferedAudioStream::stopDecode() {
+	_stop.store(1);
+
+	// Wait outside the lock, the reader must not block on it meanwhile
+	Common::TaskFuture future;
+	if (_futureMutex)
+		_futureMutex->lock();
+	future = _future;
+	_future = Common::TaskFuture();
+	if (_futureMutex)
+		_futureMutex->unlock();
+
+	if (future.isValid())
+		future.wait();
+	_stop.store(0);
+}
+
+SeekableAudioStream *makeBufferedAudioStream(SeekableAudioStream *parentStream, DisposeAfterUse::Flag disposeAfterUse, uint bufferLength, Common::TaskScheduler *scheduler) {
+	return new BufferedAudioStream(parentStream, disposeAfterUse, bufferLength, scheduler);
+}
+
 } // End of namespace Audio
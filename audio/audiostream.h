@@ -32,6 +32,7 @@
 
 namespace Common {
 class SeekableReadStream;
+class TaskScheduler;
 }
 
 namespace Audio {
@@ -59,6 +60,20 @@ public:
 	 */
 	virtual int readBuffer(int16 *buffer, const int numSamples) = 0;
 
+	/**
+	 * Read up to numSamples samples without copying them, from a stream
+	 * which holds them in memory already, in the format readBuffer() fills
+	 * its buffer with. The samples stay valid until the stream is read from
+	 * again or destroyed; seeking or rewinding it does not move them.
+	 *
+	 * @param samples    Set to the samples read
+	 * @param numSamples The most samples to read, as whole sample frames
+	 * @return The number of samples read, which may be less than numSamples
+	 *         before the end of the stream too, or -1 if the stream has to
+	 *         be read with readBuffer() instead
+	 */
+	virtual int getReadPointer(const int16 *&samples, int numSamples) { return -1; }
+
 	/** Is this a stereo stream? */
 	virtual bool isStereo() const = 0;
 
@@ -121,6 +136,7 @@ public:
 	LoopingAudioStream(RewindableAudioStream *stream, uint loops, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
 	int readBuffer(int16 *buffer, const int numSamples);
+	int getReadPointer(const int16 *&samples, int numSamples);
 	bool endOfData() const;
 	bool endOfStream() const;
 
@@ -132,6 +148,13 @@ public:
 	 */
 	uint getCompleteIterations() const { return _completeIterations; }
 private:
+	/**
+	 * Count the loop the parent just ended, and rewind it for the next one.
+	 *
+	 * @return Whether there is another loop to play
+	 */
+	bool startNextLoop();
+
 	Common::DisposablePtr<RewindableAudioStream> _parent;
 
 	uint _loops;
@@ -170,6 +193,20 @@ public:
 	 */
 	static SeekableAudioStream *openStreamFile(const Common::String &basename);
 
+	/** Creates a stream decoding a file, as makeMP3Stream() and the like do */
+	typedef SeekableAudioStream *(*StreamFileFactory)(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+	/**
+	 * Looks for a file like openStreamFile() does, without decoding any of
+	 * it yet. The decoder can then be created elsewhere, e.g. on a worker,
+	 * which for some formats means reading the whole file.
+	 *
+	 * @param basename a filename without an extension
+	 * @param factory  set to the function creating the decoder for the file
+	 * @return  the opened file, or NULL if there is none in any available format
+	 */
+	static Common::SeekableReadStream *findStreamFile(const Common::String &basename, StreamFileFactory &factory);
+
 	/**
 	 * Seeks to a given offset in the stream.
 	 *
@@ -250,6 +287,7 @@ public:
 	                      DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
 	int readBuffer(int16 *buffer, const int numSamples);
+	int getReadPointer(const int16 *&samples, int numSamples);
 	bool endOfData() const;
 	bool endOfStream() const;
 
@@ -286,6 +324,7 @@ public:
 	SubSeekableAudioStream(SeekableAudioStream *parent, const Timestamp start, const Timestamp end, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
 	int readBuffer(int16 *buffer, const int numSamples);
+	int getReadPointer(const int16 *&samples, int numSamples);
 
 	bool isStereo() const { return _parent->isStereo(); }
 
@@ -371,6 +410,25 @@ Timestamp convertTimeToStreamPos(const Timestamp &where, int rate, bool isStereo
  */
 AudioStream *makeLimitingAudioStream(AudioStream *parentStream, const Timestamp &length, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
+/**
+ * Factory function for a SeekableAudioStream wrapper which decodes its parent
+ * ahead on a TaskScheduler worker, into a ring buffer. Reading from the
+ * wrapper, as the mixer does, then only copies samples instead of waiting
+ * for the codec and the file I/O. When the worker falls behind, fewer samples
+ * than asked for are returned.
+ *
+ * The parent must not be used on its own anymore. Seeking waits for the
+ * worker and drops what was decoded ahead. With a serial scheduler, the
+ * wrapper reads from the parent directly.
+ *
+ * @param parentStream    The stream to decode ahead
+ * @param disposeAfterUse Whether the parent stream object should be destroyed on destruction of the returned stream
+ * @param bufferLength    How far to decode ahead, in milliseconds
+ * @param scheduler       The scheduler to decode on, the one of g_system by default
+ */
+SeekableAudioStream *makeBufferedAudioStream(SeekableAudioStream *parentStream, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES,
+                                             uint bufferLength = 500, Common::TaskScheduler *scheduler = nullptr);
+
 /**
  * An AudioStream designed to work in terms of packets.
  *
@@ -412,6 +470,7 @@ public:
 	bool isStereo() const { return _channels == 2; }
 	int getRate() const { return _rate; }
 	int readBuffer(int16 *data, const int numSamples) { return _stream->readBuffer(data, numSamples); }
+	int getReadPointer(const int16 *&samples, int numSamples) { return _stream->getReadPointer(samples, numSamples); }
 	bool endOfData() const { return _stream->endOfData(); }
 	bool endOfStream() const { return _stream->endOfStream(); }
 
@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "audio/cpustats.h"
+
+#include "common/system.h"
+
+namespace Common {
+DECLARE_SINGLETON(Audio::CPUStats);
+}
+
+namespace Audio {
+
+static const char *const s_counterNames[CPUStats::kCounterDrivers] = {
+	"mixer", "plain", "music", "sfx", "speech"
+};
+
+CPUStats::CPUStats() : _enabled(false), _currentFrames(0) {
+	for (int i = 0; i < kMaxDrivers; i++)
+		_driverNames[i] = nullptr;
+	for (int i = 0; i < kCounterCount; i++) {
+		_currentUsec[i] = 0;
+		_currentPeak[i] = 0;
+	}
+}
+
+uint64 CPUStats::now() {
+	return g_system->getMicroseconds();
+}
+
+int CPUStats::getDriverCounter(const char *name) {
+	const int count = MIN<int>(_driverCount.load(), kMaxDrivers);
+	for (int i = 0; i < count; i++) {
+		if (_driverNames[i] && !strcmp(_driverNames[i], name))
+			return kCounterDrivers + i;
+	}
+
+	const int index = _driverCount.fetchAdd(1);
+	if (index >= kMaxDrivers) {
+		_driverCount.store(kMaxDrivers);
+		return -1;
+	}
+
+	_driverNames[index] = name;
+	return kCounterDrivers + index;
+}
+
+void CPUStats::add(int counter, uint32 usec) {
+	_currentUsec[counter] += usec;
+	_currentPeak[counter] = MAX(_currentPeak[counter], usec);
+}
+
+void CPUStats::endMix(uint frames, uint rate) {
+	_currentFrames += frames;
+	if (_currentFrames < rate)
+		return;
+
+	// Scaled to exactly one second, as the last mix usually overshoots it
+	for (int i = 0; i < kCounterCount; i++) {
+		_lastUsec[i].store((int32)((uint64)_currentUsec[i] * rate / _currentFrames));
+		_lastPeak[i].store((int32)_currentPeak[i]);
+		_currentUsec[i] = 0;
+		_currentPeak[i] = 0;
+	}
+	_currentFrames = 0;
+}
+
+Common::Array<CPUStats::Counter> CPUStats::getCounters() const {
+	Common::Array<Counter> counters;
+	const int driverCount = MIN<int>(_driverCount.load(), kMaxDrivers);
+
+	for (int i = 0; i < kCounterDrivers + driverCount; i++) {
+		Counter counter;
+		counter.name = i < kCounterDrivers ? s_counterNames[i] : _driverNames[i - kCounterDrivers];
+		counter.usec = (uint32)_lastUsec[i].load();
+		counter.peakUsec = (uint32)_lastPeak[i].load();
+
+		if (counter.name && (i == kCounterMixer || counter.peakUsec))
+			counters.push_back(counter);
+	}
+
+	return counters;
+}
+
+Common::String CPUStats::formatCounters() const {
+	Common::Array<Counter> counters = getCounters();
+	Common::String line;
+
+	for (uint i = 0; i < counters.size(); i++) {
+		if (i)
+			line += ' ';
+		line += Common::String::format("%s %u.%u%% (peak %uus)", counters[i].name,
+		                               counters[i].usec / 10000, counters[i].usec / 1000 % 10, counters[i].peakUsec);
+	}
+
+	return line;
+}
+
+} // End of namespace Audio
@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_CPUSTATS_H
+#define AUDIO_CPUSTATS_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/atomic.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+#include "audio/mixer.h"
+
+namespace Audio {
+
+/**
+ * Counts the CPU time the mixing thread spends, split into the mixer
+ * itself, the channels of each sound type and the emulated synths which
+ * render into them. Synth time is also counted in the time of the channel
+ * playing it.
+ *
+ * The counters roll over every second of mixed audio, and what can be read
+ * are the totals of the last full second. Nothing is timed until
+ * setEnabled(true) is called, which the debug console command "audiostats"
+ * and the libretro performance statistics do.
+ */
+class CPUStats : public Common::Singleton<CPUStats> {
+public:
+	enum {
+		/** The whole of MixerImpl::mixCallback */
+		kCounterMixer = 0,
+		/** Channel::mix, one counter for each Mixer::SoundType from here */
+		kCounterSoundTypes = 1,
+		/** The synths, one counter for each driver name from here */
+		kCounterDrivers = kCounterSoundTypes + 4,
+		kMaxDrivers = 16,
+		kCounterCount = kCounterDrivers + kMaxDrivers
+	};
+
+	struct Counter {
+		const char *name;
+		/** Microseconds spent per second of audio, in the last second */
+		uint32 usec;
+		/** The most a single mix took, in microseconds */
+		uint32 peakUsec;
+	};
+
+	void setEnabled(bool enabled) { _enabled = enabled; }
+	bool isEnabled() const { return _enabled; }
+
+	/** Whether timing is enabled, without creating the instance */
+	static bool isActive() { return hasInstance() && instance().isEnabled(); }
+
+	static uint64 now();
+
+	/**
+	 * The counter to time a synth with. Synths of the same name share one.
+	 *
+	 * @param name The name of the driver, which has to stay valid for the
+	 *             rest of the program, like a string literal
+	 * @return The counter, or -1 when all are taken
+	 */
+	int getDriverCounter(const char *name);
+
+	static int getSoundTypeCounter(Mixer::SoundType type) { return kCounterSoundTypes + type; }
+
+	/** Add to a counter. Only the mixing thread may do this. */
+	void add(int counter, uint32 usec);
+
+	/**
+	 * Count a mix of the given length, after its time was added. Rolls the
+	 * counters over once a second of audio was mixed.
+	 */
+	void endMix(uint frames, uint rate);
+
+	/**
+	 * The totals of the last full second of audio, of the mixer and each
+	 * counter which was used in it.
+	 */
+	Common::Array<Counter> getCounters() const;
+
+	/** The counters on one line, as percentages of the audio duration */
+	Common::String formatCounters() const;
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	CPUStats();
+
+	volatile bool _enabled;
+
+	/** Names of the driver counters, set once */
+	const char *_driverNames[kMaxDrivers];
+	Common::AtomicInt32 _driverCount;
+
+	/** The running totals, only touched by the mixing thread */
+	uint32 _currentUsec[kCounterCount];
+	uint32 _currentPeak[kCounterCount];
+	uint32 _currentFrames;
+
+	/** The totals of the last full second */
+	Common::AtomicInt32 _lastUsec[kCounterCount];
+	Common::AtomicInt32 _lastPeak[kCounterCount];
+};
+
+/**
+ * Adds the time from its construction to its destruction to a counter of
+ * CPUStats, when that is enabled.
+ */
+class CPUStatsScope {
+public:
+	explicit CPUStatsScope(int counter) : _counter(counter), _start(0) {
+		if (counter >= 0 && CPUStats::isActive())
+			_start = CPUStats::now();
+	}
+
+	~CPUStatsScope() {
+		if (_start)
+			CPUStats::instance().add(_counter, (uint32)(CPUStats::now() - _start));
+	}
+
+private:
+	const int _counter;
+	uint64 _start;
+};
+
+} // End of namespace Audio
+
+#endif
@@ -63,6 +63,22 @@ bool ADPCMStream::rewind() {
 	return true;
 }
 
+// The most bytes the block decoders read from the stream at once
+static const uint32 kChunkSize = 512;
+
+// Decodes an IMA nibble with the channel state held by the caller, so the
+// loops over whole chunks can keep it in registers
+static inline int16 decodeIMANibble(int32 &last, int32 &stepIndex, byte code) {
+	const int32 E = (2 * (code & 0x7) + 1) * Ima_ADPCMStream::_imaTable[stepIndex] / 8;
+	const int32 diff = (code & 0x08) ? -E : E;
+	const int32 samp = CLIP<int32>(last + diff, -32768, 32767);
+
+	last = samp;
+	stepIndex = CLIP<int32>(stepIndex + ADPCMStream::_stepAdjustTable[code], 0, ARRAYSIZE(Ima_ADPCMStream::_imaTable) - 1);
+
+	return samp;
+}
+
 
 #pragma mark -
 
@@ -120,20 +136,42 @@ int16 Oki_ADPCMStream::decodeOKI(byte code) {
 
 
 int DVI_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+	int samples = 0;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeIMA((data >> 4) & 0x0f, 0);
-			_decodedSamples[1] = decodeIMA((data >> 0) & 0x0f, _channels == 2 ? 1 : 0);
-			_decodedSampleCount = 2;
+	// The second sample of the byte the last call ended in
+	if (_decodedSampleCount != 0 && numSamples > 0) {
+		buffer[samples++] = _decodedSamples[1];
+		_decodedSampleCount = 0;
+	}
+
+	// Decode with the state kept locally, in chunks read at once. With one
+	// channel, both nibbles belong to the first one.
+	int32 last[2] = { _status.ima_ch[0].last, _status.ima_ch[1].last };
+	int32 stepIndex[2] = { _status.ima_ch[0].stepIndex, _status.ima_ch[1].stepIndex };
+	const int second = _channels == 2 ? 1 : 0;
+
+	while (samples < numSamples && !endOfData()) {
+		byte data[kChunkSize];
+		const uint32 wanted = MIN<uint32>(MIN<uint32>((numSamples - samples + 1) / 2, kChunkSize), _endpos - _stream->pos());
+		const uint32 count = _stream->read(data, wanted);
+		if (count == 0)
+			break;
+
+		for (uint32 i = 0; i < count; i++) {
+			buffer[samples++] = decodeIMANibble(last[0], stepIndex[0], (data[i] >> 4) & 0x0f);
+			const int16 sample = decodeIMANibble(last[second], stepIndex[second], data[i] & 0x0f);
+			if (samples < numSamples) {
+				buffer[samples++] = sample;
+			} else {
+				_decodedSamples[1] = sample;
+				_decodedSampleCount = 1;
+			}
 		}
+	}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+	for (int i = 0; i < 2; i++) {
+		_status.ima_ch[i].last = last[i];
+		_status.ima_ch[i].stepIndex = stepIndex[i];
 	}
 
 	return samples;
@@ -213,7 +251,11 @@ int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	// Need to write at least one sample per channel
 	assert((numSamples % _channels) == 0);
 
-	int samples = 0;
+	int samples = drainBuffer(buffer, numSamples);
+
+	// The stream encodes groups of four bytes per channel at a time
+	const uint32 groupSize = _channels * 4;
+	const int groupSamples = _channels * 8;
 
 	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
 		if (_blockPos[0] == _blockAlign) {
@@ -226,26 +268,67 @@ int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 			_blockPos[0] = _channels * 4;
 		}
 
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
-			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
-			}
-		}
+		// Whole groups are decoded straight into the buffer, the group that
+		// does not fit into it any more into _buffer
+		const int bufferGroups = (numSamples - samples) / groupSamples;
+		uint32 groups = MIN<uint32>((_blockAlign - _blockPos[0]) / groupSize, (_endpos - _stream->pos() + groupSize - 1) / groupSize);
+		groups = MIN<uint32>(groups, MAX(bufferGroups, 1));
+		groups = MIN<uint32>(groups, kChunkSize / groupSize);
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
+		byte data[kChunkSize];
+		const uint32 count = _stream->read(data, groups * groupSize);
+		if (count == 0)
+			break;
+
+		// What is missing of a truncated group decodes as zeroes
+		groups = (count + groupSize - 1) / groupSize;
+		memset(data + count, 0, groups * groupSize - count);
+		_blockPos[0] += groups * groupSize;
+
+		for (uint32 group = 0; group < groups; group++) {
 			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
+				const byte *src = data + group * groupSize + i * 4;
+				int32 last = _status.ima_ch[i].last;
+				int32 stepIndex = _status.ima_ch[i].stepIndex;
+
+				if (bufferGroups != 0) {
+					int16 *dst = buffer + samples + i;
+					for (int j = 0; j < 4; j++) {
+						dst[(j * 2) * _channels] = decodeIMANibble(last, stepIndex, src[j] & 0x0f);
+						dst[(j * 2 + 1) * _channels] = decodeIMANibble(last, stepIndex, (src[j] >> 4) & 0x0f);
+					}
+				} else {
+					for (int j = 0; j < 4; j++) {
+						_buffer[i][j * 2] = decodeIMANibble(last, stepIndex, src[j] & 0x0f);
+						_buffer[i][j * 2 + 1] = decodeIMANibble(last, stepIndex, (src[j] >> 4) & 0x0f);
+					}
+					_samplesLeft[i] = 8;
+				}
+
+				_status.ima_ch[i].last = last;
+				_status.ima_ch[i].stepIndex = stepIndex;
 			}
 
-			samples += _channels;
+			if (bufferGroups != 0)
+				samples += groupSamples;
+		}
+
+		samples += drainBuffer(buffer + samples, numSamples - samples);
+	}
+
+	return samples;
+}
+
+int MSIma_ADPCMStream::drainBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples && _samplesLeft[0] != 0) {
+		for (int i = 0; i < _channels; i++) {
+			buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
+			_samplesLeft[i]--;
 		}
+
+		samples += _channels;
 	}
 
 	return samples;
@@ -291,7 +374,7 @@ int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	byte data;
 	int i;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
+	for (samples = 0; samples < numSamples && !endOfData();) {
 		if (_decodedSampleCount == 0) {
 			if (_blockPos[0] == _blockAlign) {
 				// read block header
@@ -314,6 +397,26 @@ int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
 
 				_blockPos[0] = _channels * 7;
+			} else if (numSamples - samples >= 2) {
+				// As many whole bytes as fit, decoded straight into the buffer
+				byte chunk[kChunkSize];
+				const uint32 wanted = MIN<uint32>(MIN<uint32>((numSamples - samples) / 2, kChunkSize),
+				                                  MIN<uint32>(_blockAlign - _blockPos[0], _endpos - _stream->pos()));
+				const uint32 count = _stream->read(chunk, wanted);
+				if (count == 0)
+					break;
+
+				ADPCMChannelStatus status[2] = { _status.ch[0], _status.ch[1] };
+				ADPCMChannelStatus *second = &status[_channels - 1];
+				for (uint32 j = 0; j < count; j++) {
+					buffer[samples++] = decodeMS(&status[0], (chunk[j] >> 4) & 0x0f);
+					buffer[samples++] = decodeMS(second, chunk[j] & 0x0f);
+				}
+				_status.ch[0] = status[0];
+				_status.ch[1] = status[1];
+
+				_blockPos[0] += count;
+				continue;
 			} else {
 				data = _stream->readByte();
 				_blockPos[0]++;
@@ -324,7 +427,7 @@ int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 		}
 
 		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
+		buffer[samples++] = _decodedSamples[_decodedSampleIndex++];
 		_decodedSampleCount--;
 	}
 
@@ -445,15 +548,7 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 };
 
 int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
-	int32 E = (2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex] / 8;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
-
-	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
-
-	return samp;
+	return decodeIMANibble(_status.ima_ch[channel].last, _status.ima_ch[channel].stepIndex, code);
 }
 
 SeekableAudioStream *makeADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
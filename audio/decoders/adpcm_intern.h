@@ -168,6 +168,8 @@ public:
 		_samplesLeft[1] = 0;
 	}
 
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_samplesLeft[0] == 0); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 	void reset() {
@@ -177,6 +179,9 @@ public:
 	}
 
 private:
+	/** Copies what is left of the last group decoded, interleaved */
+	int drainBuffer(int16 *buffer, const int numSamples);
+
 	int16 _buffer[2][8];
 	int _samplesLeft[2];
 };
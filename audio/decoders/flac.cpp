@@ -27,6 +27,7 @@
 
 #ifdef USE_FLAC
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
@@ -81,6 +82,13 @@ namespace Audio {
 
 static const uint MAX_OUTPUT_CHANNELS = 2;
 
+/**
+ * Seeking decodes from the last known frame before the sample when that is at
+ * most this many seconds of audio away. Further away, the bisection of the
+ * FLAC decoder, which brackets with the SEEKTABLE itself, is quicker.
+ */
+static const uint MAX_SEEK_DECODE_SECONDS = 1;
+
 
 class FLACStream : public SeekableAudioStream {
 protected:
@@ -122,6 +130,27 @@ protected:
 	typedef void (*PFCONVERTBUFFERS)(SampleType*, const FLAC__int32*[], uint, const uint, const uint8);
 	PFCONVERTBUFFERS _methodConvertBuffers;
 
+	/** Where a frame starts */
+	struct FramePosition {
+		FLAC__uint64 sample;
+		/** Byte offset from the start of the stream */
+		FLAC__uint64 offset;
+	};
+
+	/**
+	 * Frame positions sorted by sample: the SEEKTABLE points, the first
+	 * frame, and frames decoded at least _indexInterval samples apart.
+	 */
+	Common::Array<FramePosition> _frameIndex;
+	FLAC__uint64 _indexInterval;
+
+	/** The first sample of the frame after the one last written */
+	FLAC__uint64 _nextFrameSample;
+	bool _frameWritten;
+
+	/** Samples before this one are dropped, after seeking to a frame before it */
+	FLAC__uint64 _skipToSample;
+
 
 public:
 	FLACStream(Common::SeekableReadStream *inStream, bool dispose);
@@ -150,7 +179,11 @@ protected:
 
 	inline bool processSingleBlock();
 	inline bool processUntilEndOfMetadata();
+	inline bool getDecodePosition(FLAC__uint64 *position) const;
+	inline bool flush();
 	bool seekAbsolute(FLAC__uint64 sample);
+	bool seekIndexed(FLAC__uint64 sample);
+	void addFramePosition(FLAC__uint64 sample, FLAC__uint64 offset);
 
 	inline ::FLAC__SeekableStreamDecoderReadStatus callbackRead(FLAC__byte buffer[], FLAC_size_t *bytes);
 	inline ::FLAC__SeekableStreamDecoderSeekStatus callbackSeek(FLAC__uint64 absoluteByteOffset);
@@ -189,7 +222,8 @@ FLACStream::FLACStream(Common::SeekableReadStream *inStream, bool dispose)
 		_disposeAfterUse(dispose),
 		_length(0, 1000), _lastSample(0),
 		_outBuffer(NULL), _requestedSamples(0), _lastSampleWritten(false),
-		_methodConvertBuffers(&FLACStream::convertBuffersGeneric)
+		_methodConvertBuffers(&FLACStream::convertBuffersGeneric),
+		_indexInterval(0), _nextFrameSample(0), _frameWritten(false), _skipToSample(0)
 {
 	assert(_inStream);
 	memset(&_streaminfo, 0, sizeof(_streaminfo));
@@ -210,9 +244,11 @@ FLACStream::FLACStream(Common::SeekableReadStream *inStream, bool dispose)
 	::FLAC__seekable_stream_decoder_set_metadata_callback(_decoder, &FLACStream::callWrapMetadata);
 	::FLAC__seekable_stream_decoder_set_error_callback(_decoder, &FLACStream::callWrapError);
 	::FLAC__seekable_stream_decoder_set_client_data(_decoder, (void *)this);
+	::FLAC__seekable_stream_decoder_set_metadata_respond(_decoder, FLAC__METADATA_TYPE_SEEKTABLE);
 
 	success = (::FLAC__seekable_stream_decoder_init(_decoder) == FLAC__SEEKABLE_STREAM_DECODER_OK);
 #else
+	::FLAC__stream_decoder_set_metadata_respond(_decoder, FLAC__METADATA_TYPE_SEEKTABLE);
 	success = (::FLAC__stream_decoder_init_stream(
 		_decoder,
 		&FLACStream::callWrapRead,
@@ -230,6 +266,18 @@ FLACStream::FLACStream(Common::SeekableReadStream *inStream, bool dispose)
 		if (processUntilEndOfMetadata() && _streaminfo.channels > 0) {
 			_lastSample = _streaminfo.total_samples + 1;
 			_length = Timestamp(0, _lastSample - 1, getRate());
+
+			// Record a frame for every quarter second decoded. The SEEKTABLE offsets
+			// count from the first frame, which follows the metadata.
+			_indexInterval = getRate() / 4;
+			FLAC__uint64 firstFrame;
+			if (getDecodePosition(&firstFrame)) {
+				for (uint i = 0; i < _frameIndex.size(); i++)
+					_frameIndex[i].offset += firstFrame;
+				addFramePosition(0, firstFrame);
+			} else {
+				_frameIndex.clear();
+			}
 			return; // no error occurred
 		}
 	}
@@ -278,8 +326,28 @@ inline bool FLACStream::processUntilEndOfMetadata() {
 #endif
 }
 
+inline bool FLACStream::getDecodePosition(FLAC__uint64 *position) const {
+	assert(_decoder != NULL);
+#ifdef LEGACY_FLAC
+	return 0 != ::FLAC__seekable_stream_decoder_get_decode_position(_decoder, position);
+#else
+	return 0 != ::FLAC__stream_decoder_get_decode_position(_decoder, position);
+#endif
+}
+
+inline bool FLACStream::flush() {
+	assert(_decoder != NULL);
+#ifdef LEGACY_FLAC
+	return 0 != ::FLAC__seekable_stream_decoder_flush(_decoder);
+#else
+	return 0 != ::FLAC__stream_decoder_flush(_decoder);
+#endif
+}
+
 bool FLACStream::seekAbsolute(FLAC__uint64 sample) {
 	assert(_decoder != NULL);
+	// The decoder writes the frame it seeked to already
+	_skipToSample = 0;
 #ifdef LEGACY_FLAC
 	const bool result = (0 != ::FLAC__seekable_stream_decoder_seek_absolute(_decoder, sample));
 #else
@@ -291,12 +359,56 @@ bool FLACStream::seekAbsolute(FLAC__uint64 sample) {
 	return result;
 }
 
+bool FLACStream::seekIndexed(FLAC__uint64 sample) {
+	// The last frame starting at or before the sample
+	uint lo = 0, hi = _frameIndex.size();
+	while (lo < hi) {
+		const uint mid = (lo + hi) / 2;
+		if (_frameIndex[mid].sample <= sample)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == 0)
+		return false;
+
+	const FramePosition &position = _frameIndex[lo - 1];
+	if (sample - position.sample > MAX_SEEK_DECODE_SECONDS * (FLAC__uint64)getRate())
+		return false;
+
+	_inStream->seek((int32)position.offset, SEEK_SET);
+	if ((FLAC__uint64)_inStream->pos() != position.offset || !flush())
+		return false;
+
+	_lastSampleWritten = (_lastSample != 0 && sample >= _lastSample);
+	_skipToSample = sample;
+	return true;
+}
+
+void FLACStream::addFramePosition(FLAC__uint64 sample, FLAC__uint64 offset) {
+	uint pos = _frameIndex.size();
+	while (pos > 0 && _frameIndex[pos - 1].sample > sample)
+		pos--;
+
+	// Keep the index sparse
+	if (pos > 0 && sample - _frameIndex[pos - 1].sample < _indexInterval)
+		return;
+	if (pos < _frameIndex.size() && _frameIndex[pos].sample - sample < _indexInterval)
+		return;
+
+	FramePosition position;
+	position.sample = sample;
+	position.offset = offset;
+	_frameIndex.insert_at(pos, position);
+}
+
 bool FLACStream::seek(const Timestamp &where) {
 	_sampleCache.bufFill = 0;
 	_sampleCache.bufReadPos = NULL;
 	// FLAC uses the sample pair number, thus we always use "false" for the isStereo parameter
 	// of the convertTimeToStreamPos helper.
-	return seekAbsolute((FLAC__uint64)convertTimeToStreamPos(where, getRate(), false).totalNumberOfFrames());
+	const FLAC__uint64 sample = (FLAC__uint64)convertTimeToStreamPos(where, getRate(), false).totalNumberOfFrames();
+	return seekIndexed(sample) || seekAbsolute(sample);
 }
 
 int FLACStream::readBuffer(int16 *buffer, const int numSamples) {
@@ -339,11 +451,17 @@ int FLACStream::readBuffer(int16 *buffer, const int numSamples) {
 	while (!_lastSampleWritten && _requestedSamples > 0 && state == FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC) {
 		assert(_sampleCache.bufFill == 0);
 		assert(_requestedSamples % numChannels == 0);
+		_frameWritten = false;
 		processSingleBlock();
 		state = getStreamDecoderState();
 
 		if (state == FLAC__STREAM_DECODER_END_OF_STREAM)
 			_lastSampleWritten = true;
+
+		// Remember where the next frame starts, for seeking back to it
+		FLAC__uint64 offset;
+		if (_frameWritten && state == FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC && _nextFrameSample < _lastSample - 1 && getDecodePosition(&offset))
+			addFramePosition(_nextFrameSample, offset);
 	}
 
 	// Error handling
@@ -583,19 +701,33 @@ inline ::FLAC__StreamDecoderWriteStatus FLACStream::callbackWrite(const ::FLAC__
 	const FLAC__uint64 firstSampleNumber = (frame->header.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER) ?
 		frame->header.number.sample_number : (static_cast<FLAC__uint64>(frame->header.number.frame_number)) * _streaminfo.max_blocksize;
 
+	_nextFrameSample = firstSampleNumber + numSamples;
+	_frameWritten = true;
+
 	// Check whether we are about to reach beyond the last sample we are supposed to play.
 	if (_lastSample != 0 && firstSampleNumber + numSamples >= _lastSample) {
 		numSamples = (uint)(firstSampleNumber >= _lastSample ? 0 : _lastSample - firstSampleNumber);
 		_lastSampleWritten = true;
 	}
 
+	// Drop what comes before the sample seeked to
+	uint skipSamples = 0;
+	if (_skipToSample > firstSampleNumber) {
+		skipSamples = (uint)MIN<FLAC__uint64>(numSamples, _skipToSample - firstSampleNumber);
+		numSamples -= skipSamples;
+		if (_skipToSample <= firstSampleNumber + frame->header.blocksize)
+			_skipToSample = 0;
+	} else {
+		_skipToSample = 0;
+	}
+
 	// The value in _requestedSamples counts raw samples, so if there are more than one
 	// channel, we have to multiply the number of available sample "pairs" by numChannels
 	numSamples *= numChannels;
 
 	const FLAC__int32 *inChannels[MAX_OUTPUT_CHANNELS];
 	for (uint i = 0; i < numChannels; ++i)
-		inChannels[i] = buffer[i];
+		inChannels[i] = buffer[i] + skipSamples;
 
 	// write the incoming samples directly into the buffer provided to us by the mixer
 	if (_requestedSamples > 0) {
@@ -661,6 +793,25 @@ inline bool FLACStream::callbackEOF() {
 
 inline void FLACStream::callbackMetadata(const ::FLAC__StreamMetadata *metadata) {
 	assert(_decoder != NULL);
+
+	if (metadata->type == FLAC__METADATA_TYPE_SEEKTABLE) {
+		// The offsets are made absolute once the first frame is found
+		const FLAC__StreamMetadata_SeekTable &seekTable = metadata->data.seek_table;
+		for (uint i = 0; i < seekTable.num_points; i++) {
+			const FLAC__StreamMetadata_SeekPoint &point = seekTable.points[i];
+			if (point.sample_number == FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER)
+				continue;
+			if (!_frameIndex.empty() && point.sample_number <= _frameIndex.back().sample)
+				continue;
+
+			FramePosition position;
+			position.sample = point.sample_number;
+			position.offset = point.stream_offset;
+			_frameIndex.push_back(position);
+		}
+		return;
+	}
+
 	assert(metadata->type == FLAC__METADATA_TYPE_STREAMINFO); // others arent really interesting
 
 	_streaminfo = metadata->data.stream_info;
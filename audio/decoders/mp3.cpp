@@ -24,6 +24,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -63,6 +64,7 @@ protected:
 
 	void initStream(Common::ReadStream &stream);
 	void readHeader(Common::ReadStream &stream);
+	bool primeFrame(Common::ReadStream &stream);
 	void deinitStream();
 
 	int fillBuffer(Common::ReadStream &stream, int16 *buffer, const int numSamples);
@@ -108,6 +110,21 @@ protected:
 	Timestamp _length;
 
 private:
+	/** Where decoding can start again, and the playback time there */
+	struct SeekPoint {
+		uint32 offset;
+		mad_timer_t time;
+	};
+
+	enum {
+		// A seek decodes at most this many frames before the one it stops at
+		SEEK_POINT_INTERVAL = 16
+	};
+
+	const SeekPoint &findSeekPoint(const mad_timer_t &time) const;
+
+	Common::Array<SeekPoint> _seekPoints;
+
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
 };
 
@@ -278,6 +295,51 @@ void BaseMP3Stream::readHeader(Common::ReadStream &stream) {
 		_state = MP3_STATE_EOS;
 }
 
+bool BaseMP3Stream::primeFrame(Common::ReadStream &stream) {
+	if (_state != MP3_STATE_READY)
+		return false;
+
+	// If necessary, load more data into the stream decoder
+	if (_stream.error == MAD_ERROR_BUFLEN)
+		readMP3Data(stream);
+
+	bool synthesized = false;
+	while (_state != MP3_STATE_EOS) {
+		_stream.error = MAD_ERROR_NONE;
+
+		// Decode the whole frame, unlike readHeader, so that the Layer III bit
+		// reservoir and the synthesis filter hold what the following frames need
+		if (mad_frame_decode(&_frame, &_stream) == -1) {
+			if (_stream.error == MAD_ERROR_BUFLEN) {
+				readMP3Data(stream);  // Read more data
+				continue;
+			} else if (_stream.error == MAD_ERROR_BADDATAPTR) {
+				// The frame needs data from before where decoding started. It
+				// still fills the bit reservoir, so count it and move on.
+				_stream.error = MAD_ERROR_NONE;
+			} else if (MAD_RECOVERABLE(_stream.error)) {
+				debug(6, "MP3Stream: Recoverable error in mad_frame_decode (%s)", mad_stream_errorstr(&_stream));
+				continue;
+			} else {
+				warning("MP3Stream: Unrecoverable error in mad_frame_decode (%s)", mad_stream_errorstr(&_stream));
+				break;
+			}
+		} else {
+			mad_synth_frame(&_synth, &_frame);
+			synthesized = true;
+		}
+
+		// Sum up the total playback time so far
+		mad_timer_add(&_curTime, _frame.header.duration);
+		break;
+	}
+
+	if (_stream.error != MAD_ERROR_NONE)
+		_state = MP3_STATE_EOS;
+
+	return synthesized;
+}
+
 void BaseMP3Stream::deinitStream() {
 	if (_state == MP3_STATE_INIT)
 		return;
@@ -337,10 +399,25 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream, and note where every few frames
+	// start so that seeking does not need to scan the stream again
+	SeekPoint start;
+	start.offset = 0;
+	start.time = mad_timer_zero;
+	_seekPoints.push_back(start);
+
+	for (uint frame = 1; _state != MP3_STATE_EOS; frame++) {
+		const mad_timer_t frameStart = _curTime;
 		readHeader(*_inStream);
 
+		if (_state != MP3_STATE_EOS && frame % SEEK_POINT_INTERVAL == 0) {
+			SeekPoint point;
+			point.offset = (uint32)(_inStream->pos() - (_stream.bufend - _stream.this_frame));
+			point.time = frameStart;
+			_seekPoints.push_back(point);
+		}
+	}
+
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
 	// We need to assure this, since else we might trigger an assertion in Timestamp
@@ -377,19 +454,50 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
-		_inStream->seek(0);
+	// Restart from the last seek point before the destination, unless
+	// decoding on from the current position gets there sooner
+	const SeekPoint &point = findSeekPoint(destination);
+	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0 ||
+	    mad_timer_compare(point.time, _curTime) > 0) {
+		_inStream->seek(point.offset);
 		initStream(*_inStream);
+		_curTime = point.time;
 	}
 
-	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS)
-		readHeader(*_inStream);
+	// Decode up to the frame holding the destination, and start reading
+	// from the destination within it
+	bool synthesized = false;
+	mad_timer_t frameStart = _curTime;
+	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS) {
+		frameStart = _curTime;
+		synthesized = primeFrame(*_inStream);
+	}
 
-	decodeMP3Data(*_inStream);
+	if (synthesized) {
+		mad_timer_t offset = frameStart;
+		mad_timer_negate(&offset);
+		mad_timer_add(&offset, destination);
+		_posInFrame = MIN<uint>(mad_timer_count(offset, (enum mad_units)getRate()), _synth.pcm.length);
+	} else {
+		decodeMP3Data(*_inStream);
+	}
 
 	return (_state != MP3_STATE_EOS);
 }
 
+const MP3Stream::SeekPoint &MP3Stream::findSeekPoint(const mad_timer_t &time) const {
+	// The first seek point is at the start of the stream, so there is always one
+	uint first = 0, last = _seekPoints.size();
+	while (last - first > 1) {
+		const uint middle = (first + last) / 2;
+		if (mad_timer_compare(_seekPoints[middle].time, time) <= 0)
+			first = middle;
+		else
+			last = middle;
+	}
+	return _seekPoints[first];
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
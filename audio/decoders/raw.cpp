@@ -49,8 +49,9 @@ namespace Audio {
 template<bool is16Bit, bool isUnsigned, bool isLE>
 class RawStream : public SeekableAudioStream {
 public:
-	RawStream(int rate, bool stereo, DisposeAfterUse::Flag disposeStream, Common::SeekableReadStream *stream)
-		: _rate(rate), _isStereo(stereo), _playtime(0, rate), _stream(stream, disposeStream), _endOfData(false), _buffer(0) {
+	RawStream(int rate, bool stereo, DisposeAfterUse::Flag disposeStream, Common::SeekableReadStream *stream, const byte *memory)
+		: _rate(rate), _isStereo(stereo), _playtime(0, rate), _stream(stream, disposeStream), _endOfData(false), _buffer(0),
+		  _memory(isNative() && !((uintptr)memory & 1) ? memory : 0) {
 		// Setup our buffer for readBuffer
 		_buffer = new byte[kSampleBufferLength * (is16Bit ? 2 : 1)];
 		assert(_buffer);
@@ -64,6 +65,7 @@ public:
 	}
 
 	int readBuffer(int16 *buffer, const int numSamples);
+	int getReadPointer(const int16 *&samples, int numSamples);
 
 	bool isStereo() const  { return _isStereo; }
 	bool endOfData() const { return _endOfData; }
@@ -80,6 +82,7 @@ private:
 	bool _endOfData;                                           ///< Whether the stream end has been reached
 
 	byte *_buffer;                                             ///< Buffer used in readBuffer
+	const byte *_memory;                                       ///< The data of the stream, when it can be read in place
 	enum {
 		/**
 		 * How many samples we can buffer at once.
@@ -97,6 +100,15 @@ private:
 	 * @return actual count of samples read.
 	 */
 	int fillBuffer(int maxSamples);
+
+	/** Whether the samples are in the format readBuffer returns */
+	static bool isNative() {
+#ifdef SCUMM_LITTLE_ENDIAN
+		return is16Bit && !isUnsigned && isLE;
+#else
+		return is16Bit && !isUnsigned && !isLE;
+#endif
+	}
 };
 
 template<bool is16Bit, bool isUnsigned, bool isLE>
@@ -126,6 +138,25 @@ int RawStream<is16Bit, isUnsigned, isLE>::readBuffer(int16 *buffer, const int nu
 	return numSamples - samplesLeft;
 }
 
+template<bool is16Bit, bool isUnsigned, bool isLE>
+int RawStream<is16Bit, isUnsigned, isLE>::getReadPointer(const int16 *&samples, int numSamples) {
+	if (!_memory)
+		return -1;
+
+	if (endOfData())
+		return 0;
+
+	const int32 pos = _stream->pos();
+	numSamples = MIN<int32>(numSamples, (_stream->size() - pos) / 2);
+	samples = (const int16 *)(_memory + pos);
+	_stream->seek(pos + numSamples * 2, SEEK_SET);
+
+	if (_stream->size() - _stream->pos() < 2)
+		_endOfData = true;
+
+	return numSamples;
+}
+
 template<bool is16Bit, bool isUnsigned, bool isLE>
 int RawStream<is16Bit, isUnsigned, isLE>::fillBuffer(int maxSamples) {
 	int bufferedSamples = 0;
@@ -192,15 +223,19 @@ bool RawStream<is16Bit, isUnsigned, isLE>::seek(const Timestamp &where) {
 #define MAKE_RAW_STREAM(UNSIGNED) \
 		if (is16Bit) { \
 			if (isLE) \
-				return new RawStream<true, UNSIGNED, true>(rate, isStereo, disposeAfterUse, stream); \
+				return new RawStream<true, UNSIGNED, true>(rate, isStereo, disposeAfterUse, stream, memory); \
 			else  \
-				return new RawStream<true, UNSIGNED, false>(rate, isStereo, disposeAfterUse, stream); \
+				return new RawStream<true, UNSIGNED, false>(rate, isStereo, disposeAfterUse, stream, memory); \
 		} else \
-			return new RawStream<false, UNSIGNED, false>(rate, isStereo, disposeAfterUse, stream)
+			return new RawStream<false, UNSIGNED, false>(rate, isStereo, disposeAfterUse, stream, memory)
 
-SeekableAudioStream *makeRawStream(Common::SeekableReadStream *stream,
-                                   int rate, byte flags,
-                                   DisposeAfterUse::Flag disposeAfterUse) {
+/**
+ * Create a raw stream, which reads its samples straight from memory
+ * when it is given its stream's data.
+ */
+static SeekableAudioStream *createRawStream(Common::SeekableReadStream *stream, const byte *memory,
+                                            int rate, byte flags,
+                                            DisposeAfterUse::Flag disposeAfterUse) {
 	const bool isStereo   = (flags & Audio::FLAG_STEREO) != 0;
 	const bool is16Bit    = (flags & Audio::FLAG_16BITS) != 0;
 	const bool isUnsigned = (flags & Audio::FLAG_UNSIGNED) != 0;
@@ -215,6 +250,18 @@ SeekableAudioStream *makeRawStream(Common::SeekableReadStream *stream,
 	}
 }
 
+SeekableAudioStream *makeRawStream(Common::SeekableReadStream *stream,
+                                   int rate, byte flags,
+                                   DisposeAfterUse::Flag disposeAfterUse) {
+	return createRawStream(stream, 0, rate, flags, disposeAfterUse);
+}
+
+SeekableAudioStream *makeRawStream(Common::MemoryReadStream *stream,
+                                   int rate, byte flags,
+                                   DisposeAfterUse::Flag disposeAfterUse) {
+	return createRawStream(stream, stream->getDataPointer(), rate, flags, disposeAfterUse);
+}
+
 SeekableAudioStream *makeRawStream(const byte *buffer, uint32 size,
                                    int rate, byte flags,
                                    DisposeAfterUse::Flag disposeAfterUse) {
@@ -30,6 +30,7 @@
 
 
 namespace Common {
+class MemoryReadStream;
 class SeekableReadStream;
 }
 
@@ -90,6 +91,22 @@ SeekableAudioStream *makeRawStream(Common::SeekableReadStream *stream,
                                    int rate, byte flags,
                                    DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
+/**
+ * Creates an audio stream, which plays from the given memory stream. Signed
+ * 16 bit samples in native endianness are then read straight from its
+ * memory, see AudioStream::getReadPointer.
+ *
+ * @param stream Stream object to play from.
+ * @param rate   Rate of the sound data.
+ * @param flags  Audio flags combination.
+ * @see RawFlags
+ * @param disposeAfterUse Whether to delete the stream after use.
+ * @return The new SeekableAudioStream (or 0 on failure).
+ */
+SeekableAudioStream *makeRawStream(Common::MemoryReadStream *stream,
+                                   int rate, byte flags,
+                                   DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
 /**
  * Creates a PacketizedAudioStream that will automatically queue
  * packets as individual AudioStreams like returned by makeRawStream.
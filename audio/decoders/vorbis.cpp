@@ -118,6 +118,14 @@ public:
 	Timestamp getLength() const { return _length; }
 protected:
 	bool refill();
+
+	/**
+	 * Decode up to the given number of samples, fewer only at the end of
+	 * the stream. It has to be a whole number of sample frames.
+	 *
+	 * @return The number of samples decoded, or -1 on errors
+	 */
+	int decode(int16 *buffer, int numSamples);
 };
 
 VorbisStream::VorbisStream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -160,6 +168,22 @@ int VorbisStream::readBuffer(int16 *buffer, const int numSamples) {
 		_pos += len;
 		samples += len;
 		if (_pos >= _bufferEnd) {
+			// Decode straight into the caller's buffer what the internal
+			// one would only be copied through. The last of it still goes
+			// through the internal buffer, which tells the end of the stream.
+			int direct = numSamples - samples - ARRAYSIZE(_buffer);
+			if (_isStereo)
+				direct &= ~1;
+			if (direct > 0) {
+				const int decoded = decode(buffer, direct);
+				if (decoded < 0) {
+					_pos = _bufferEnd;
+					break;
+				}
+				buffer += decoded;
+				samples += decoded;
+			}
+
 			if (!refill())
 				break;
 		}
@@ -181,9 +205,23 @@ bool VorbisStream::seek(const Timestamp &where) {
 }
 
 bool VorbisStream::refill() {
-	// Read the samples
-	uint len_left = sizeof(_buffer);
-	char *read_pos = (char *)_buffer;
+	const int samples = decode(_buffer, ARRAYSIZE(_buffer));
+	if (samples < 0) {
+		_pos = _bufferEnd;
+		// Don't delete it yet, that causes problems in
+		// the CD player emulation code.
+		return false;
+	}
+
+	_pos = _buffer;
+	_bufferEnd = _buffer + samples;
+
+	return true;
+}
+
+int VorbisStream::decode(int16 *buffer, int numSamples) {
+	uint len_left = numSamples * 2;
+	char *read_pos = (char *)buffer;
 
 	while (len_left > 0) {
 		long result;
@@ -214,25 +252,17 @@ bool VorbisStream::refill() {
 			warning("Corrupted data in Vorbis file");
 		} else if (result == 0) {
 			//warning("End of file while reading from Vorbis file");
-			//_pos = _bufferEnd;
-			//return false;
 			break;
 		} else if (result < 0) {
 			warning("Error reading from Vorbis stream (%d)", int(result));
-			_pos = _bufferEnd;
-			// Don't delete it yet, that causes problems in
-			// the CD player emulation code.
-			return false;
+			return -1;
 		} else {
 			len_left -= result;
 			read_pos += result;
 		}
 	}
 
-	_pos = _buffer;
-	_bufferEnd = (int16 *)read_pos;
-
-	return true;
+	return (read_pos - (char *)buffer) / 2;
 }
 
 
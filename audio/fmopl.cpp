@@ -22,6 +22,7 @@
 
 #include "audio/fmopl.h"
 
+#include "audio/cpustats.h"
 #include "audio/mixer.h"
 #include "audio/softsynth/opl/dosbox.h"
 #include "audio/softsynth/opl/mame.h"
@@ -302,6 +303,12 @@ void RealOPL::onTimer() {
 EmulatedOPL::EmulatedOPL() :
 	_nextTick(0),
 	_samplesPerTick(0),
+	_statsCounter(-2),
+	_recording(false),
+	_inCallbacks(false),
+	_callbackFrame(0),
+	_renderBuffer(0),
+	_renderedFrames(0),
 	_baseFreq(0),
 	_handle(new Audio::SoundHandle()) {
 }
@@ -318,31 +325,109 @@ EmulatedOPL::~EmulatedOPL() {
 
 int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
 	const int stereoFactor = isStereo() ? 2 : 1;
-	int len = numSamples / stereoFactor;
-	int step;
+	const int len = numSamples / stereoFactor;
 
-	do {
-		step = len;
-		if (step > (_nextTick >> FIXP_SHIFT))
-			step = (_nextTick >> FIXP_SHIFT);
+	if (_statsCounter == -2 && Audio::CPUStats::isActive())
+		_statsCounter = Audio::CPUStats::instance().getDriverCounter("opl");
+
+	{
+		Common::StackLock lock(_writeMutex);
+		_recording = true;
+		_inCallbacks = true;
+		_renderBuffer = buffer;
+		_renderedFrames = 0;
+	}
 
-		generateSamples(buffer, step * stereoFactor);
+	// Run the callbacks due within the buffer, at the same sample frames
+	// as when rendering up to each of them
+	int frame = 0;
+	do {
+		const int step = MIN(len - frame, _nextTick >> FIXP_SHIFT);
+		frame += step;
 
 		_nextTick -= step << FIXP_SHIFT;
 		if (!(_nextTick >> FIXP_SHIFT)) {
-			if (_callback && _callback->isValid())
+			if (_callback && _callback->isValid()) {
+				{
+					Common::StackLock lock(_writeMutex);
+					_callbackFrame = frame;
+				}
 				(*_callback)();
+			}
 
 			_nextTick += _samplesPerTick;
 		}
+	} while (frame < len);
 
-		buffer += step * stereoFactor;
-		len -= step;
-	} while (len);
+	Common::StackLock lock(_writeMutex);
+	_inCallbacks = false;
+	{
+		Audio::CPUStatsScope scope(_statsCounter);
+		renderUntil(len);
+	}
+	_recording = false;
 
 	return numSamples;
 }
 
+void EmulatedOPL::renderUntil(int frame) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+
+	uint next = 0;
+	for (;;) {
+		const int until = next < _writes.size() ? _writes[next].frame : frame;
+		if (until > _renderedFrames) {
+			// Other threads can write while the block renders, and their
+			// writes will be due right after it
+			_writeMutex.unlock();
+			generateSamples(_renderBuffer + _renderedFrames * stereoFactor, (until - _renderedFrames) * stereoFactor);
+			_writeMutex.lock();
+			_renderedFrames = until;
+			continue;
+		}
+
+		if (next == _writes.size())
+			break;
+
+		const Write &entry = _writes[next++];
+		if (entry.isReg)
+			emuWriteReg(entry.address, entry.value);
+		else
+			emuWrite(entry.address, entry.value);
+	}
+	_writes.resize(0);
+}
+
+void EmulatedOPL::write(int a, int v) {
+	Common::StackLock lock(_writeMutex);
+	if (_recording) {
+		const Write entry = { _inCallbacks ? _callbackFrame : _renderedFrames, false, a, v };
+		_writes.push_back(entry);
+	} else {
+		emuWrite(a, v);
+	}
+}
+
+void EmulatedOPL::writeReg(int r, int v) {
+	Common::StackLock lock(_writeMutex);
+	if (_recording) {
+		const Write entry = { _inCallbacks ? _callbackFrame : _renderedFrames, true, r, v };
+		_writes.push_back(entry);
+	} else {
+		emuWriteReg(r, v);
+	}
+}
+
+byte EmulatedOPL::read(int a) {
+	Common::StackLock lock(_writeMutex);
+
+	// A callback reading the chip has to see it as the writes so far left it
+	if (_inCallbacks)
+		renderUntil(_callbackFrame);
+
+	return emuRead(a);
+}
+
 int EmulatedOPL::getRate() const {
 	return g_system->getMixer()->getOutputRate();
 }
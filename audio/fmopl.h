@@ -25,7 +25,9 @@
 
 #include "audio/audiostream.h"
 
+#include "common/array.h"
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
 #include "common/scummsys.h"
 
@@ -236,6 +238,12 @@ private:
  *
  * This will send callbacks based on the number of samples
  * decoded in readBuffer().
+ *
+ * readBuffer() runs the callbacks due in a buffer first, recording the
+ * writes they make with the sample they are due at. It then renders the
+ * buffer in as few blocks as there are samples with writes due, rather
+ * than one block per callback, which is the same output at less overhead at
+ * high callback frequencies.
  */
 class EmulatedOPL : public OPL, protected Audio::AudioStream {
 public:
@@ -244,6 +252,9 @@ public:
 
 	// OPL API
 	void setCallbackFrequency(int timerFrequency);
+	void write(int a, int v);
+	byte read(int a);
+	void writeReg(int r, int v);
 
 	// AudioStream API
 	int readBuffer(int16 *buffer, const int numSamples);
@@ -267,7 +278,30 @@ protected:
 	 */
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
+	/**
+	 * The emulator's implementations of write(), read() and writeReg(),
+	 * which are called when the emulator is due to see the access.
+	 */
+	virtual void emuWrite(int a, int v) = 0;
+	virtual byte emuRead(int a) = 0;
+	virtual void emuWriteReg(int r, int v) = 0;
+
 private:
+	/** A write recorded while a buffer is rendered */
+	struct Write {
+		/** The sample frame of the buffer the write is due at */
+		int frame;
+		bool isReg;
+		int address;
+		int value;
+	};
+
+	/**
+	 * Apply the recorded writes, and render the buffer up to each of them
+	 * and up to the given frame. Must be called with _writeMutex locked.
+	 */
+	void renderUntil(int frame);
+
 	int _baseFreq;
 
 	enum {
@@ -277,6 +311,25 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	/** The Audio::CPUStats counter, or -2 before it was looked up */
+	int _statsCounter;
+
+	/**
+	 * Guards the recorded writes, so that the emulator only sees writes
+	 * from other threads between the blocks it renders.
+	 */
+	Common::Mutex _writeMutex;
+	/** Whether a buffer is being rendered, so writes are recorded */
+	bool _recording;
+	/** Whether the callbacks are being run, rather than samples rendered */
+	bool _inCallbacks;
+	/** The sample frame the callback running is due at */
+	int _callbackFrame;
+	/** The buffer being rendered, and the sample frames rendered of it */
+	int16 *_renderBuffer;
+	int _renderedFrames;
+	Common::Array<Write> _writes;
+
 	Audio::SoundHandle *_handle;
 };
 
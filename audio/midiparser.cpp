@@ -31,6 +31,9 @@
 //
 //////////////////////////////////////////////////
 
+/** The number of events jumpToTick() scans between two jump points. */
+static const uint32 kJumpPointInterval = 64;
+
 MidiParser::MidiParser() :
 _hangingNotesCount(0),
 _driver(0),
@@ -45,7 +48,9 @@ _sendSustainOffOnNotesOff(false),
 _numTracks(0),
 _activeTrack(255),
 _abortParse(false),
-_jumpingToTick(false) {
+_jumpingToTick(false),
+_jumpPointsTrack(255),
+_jumpPointsPsecPerTick(0) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
 	_nextEvent.start = NULL;
@@ -312,6 +317,11 @@ void MidiParser::resetTracking() {
 	_position.clear();
 }
 
+void MidiParser::clearJumpPoints() {
+	_jumpPoints.clear();
+	_jumpPointsTrack = 255;
+}
+
 bool MidiParser::setTrack(int track) {
 	if (track < 0 || track >= _numTracks)
 		return false;
@@ -393,9 +403,56 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	Tracker currentPos(_position);
 	EventInfo currentEvent(_nextEvent);
 
+	if (_jumpPointsTrack != _activeTrack) {
+		clearJumpPoints();
+		_jumpPointsTrack = _activeTrack;
+	}
+
+	// Events are counted so jump points are recorded at regular intervals,
+	// and ticks are counted up to the first tempo event, since their time
+	// depends on the tempo the scan starts with
+	const uint32 startPsecPerTick = _psecPerTick;
+	uint32 events = 0;
+	uint32 startTicks = 0;
+	bool tempoSet = false;
+
 	resetTracking();
-	_position._playPos = _tracks[_activeTrack];
-	parseNextEvent(_nextEvent);
+
+	// When the events are not fired, the scan can resume from the last jump
+	// point an earlier scan passed on its way to the tick
+	uint lo = 0, hi = _jumpPoints.size();
+	if (tick > 0 && !fireEvents) {
+		while (lo < hi) {
+			const uint mid = (lo + hi) / 2;
+			const JumpPoint &point = _jumpPoints[mid];
+			if (point.position._lastEventTick + point.nextEvent.delta < tick)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+	}
+
+	if (lo > 0) {
+		const JumpPoint &point = _jumpPoints[lo - 1];
+		const uint32 timeOffset = point.startTicks * startPsecPerTick - point.startTicks * _jumpPointsPsecPerTick;
+
+		_position = point.position;
+		_position._playTime += timeOffset;
+		_position._lastEventTime += timeOffset;
+		_nextEvent = point.nextEvent;
+		if (point.tempoSet)
+			setTempo(point.tempo);
+
+		events = point.events;
+		startTicks = point.startTicks;
+		tempoSet = point.tempoSet;
+	} else {
+		if (_jumpPoints.empty())
+			_jumpPointsPsecPerTick = startPsecPerTick;
+		_position._playPos = _tracks[_activeTrack];
+		parseNextEvent(_nextEvent);
+	}
+
 	if (tick > 0) {
 		while (true) {
 			EventInfo &info = _nextEvent;
@@ -425,7 +482,25 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 				processEvent(info, fireEvents);
 			}
 
+			// The delta up to a tempo event is still timed at the old tempo
+			if (!tempoSet) {
+				startTicks = _position._lastEventTick;
+				tempoSet = (info.event == 0xFF && info.ext.type == 0x51 && info.length >= 3);
+			}
+
 			parseNextEvent(_nextEvent);
+			++events;
+
+			if (events >= (_jumpPoints.empty() ? 0 : _jumpPoints.back().events) + kJumpPointInterval && canRecordJumpPoint()) {
+				JumpPoint point;
+				point.position = _position;
+				point.nextEvent = _nextEvent;
+				point.tempo = _tempo;
+				point.tempoSet = tempoSet;
+				point.startTicks = startTicks;
+				point.events = events;
+				_jumpPoints.push_back(point);
+			}
 		}
 	}
 
@@ -452,6 +527,7 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 
 void MidiParser::unloadMusic() {
 	resetTracking();
+	clearJumpPoints();
 	allNotesOff();
 	_numTracks = 0;
 	_activeTrack = 255;
@@ -26,6 +26,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 
 class MidiDriver_BASE;
@@ -289,6 +290,23 @@ protected:
 	bool   _abortParse;    ///< If a jump or other operation interrupts parsing, flag to abort.
 	bool   _jumpingToTick; ///< True if currently inside jumpToTick
 
+	/**
+	 * A position in the active track reached by an earlier jumpToTick()
+	 * scan, along with everything needed to resume scanning from it.
+	 */
+	struct JumpPoint {
+		Tracker position;    ///< The position after the event that was parsed last
+		EventInfo nextEvent; ///< The preparsed event at that position
+		uint32 tempo;        ///< The tempo at that position, if tempoSet
+		bool   tempoSet;     ///< Whether a tempo event came before that position
+		uint32 startTicks;   ///< The ticks before the first tempo event, timed at the tempo the scan started with
+		uint32 events;       ///< The number of events scanned from the start of the track
+	};
+
+	Common::Array<JumpPoint> _jumpPoints; ///< Jump points of the active track, by increasing position
+	byte   _jumpPointsTrack;       ///< The track _jumpPoints were recorded in
+	uint32 _jumpPointsPsecPerTick; ///< The microseconds per tick the recording scan started with
+
 protected:
 	static uint32 readVLQ(byte * &data);
 	virtual void resetTracking();
@@ -296,6 +314,15 @@ protected:
 	virtual void parseNextEvent(EventInfo &info) = 0;
 	virtual bool processEvent(const EventInfo &info, bool fireEvents = true);
 
+	/**
+	 * Whether jumpToTick() may record the current position as a jump point.
+	 * Formats return true only where the position, the preparsed event and
+	 * the tempo are all the state parsing on from there depends on, and
+	 * where skipping the parsing up to there has no side effects.
+	 */
+	virtual bool canRecordJumpPoint() const { return false; }
+	void clearJumpPoints();
+
 	void activeNote(byte channel, byte note, bool active);
 	void hangingNote(byte channel, byte note, uint32 ticksLeft, bool recycle = true);
 	void hangAllActiveNotes();
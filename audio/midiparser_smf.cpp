@@ -35,6 +35,7 @@ protected:
 protected:
 	void compressToType0();
 	void parseNextEvent(EventInfo &info);
+	bool canRecordJumpPoint() const { return true; }
 
 public:
 	MidiParser_SMF() : _buffer(0), _malformedPitchBends(false) {}
@@ -68,6 +68,12 @@ protected:
 		_loopCount = -1;
 	}
 
+	// Inside a loop, parsing on depends on the loop stack, and skipping the
+	// parsing up to a jump point would skip the callbacks of a client
+	virtual bool canRecordJumpPoint() const {
+		return _loopCount < 0 && (!_callbackProc || _callbackProc == defaultXMidiCallback);
+	}
+
 public:
 	MidiParser_XMIDI(XMidiCallbackProc proc, void *data, XMidiNewTimbreListProc newTimbreListProc, MidiDriver_BASE *newTimbreListDriver) {
 		_callbackProc = proc;
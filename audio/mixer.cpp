@@ -22,9 +22,11 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
+#include "audio/cpustats.h"
 #include "audio/mixer_intern.h"
 #include "audio/rate.h"
 #include "audio/audiostream.h"
@@ -49,13 +51,13 @@ public:
 	/**
 	 * Mixes the channel's samples into the given buffer.
 	 *
-	 * @param data buffer where to mix the data
+	 * @param data buffer where to mix the data, without clipping
 	 * @param len  number of sample *pairs*. So a value of
 	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             32 bits, for a total of 80 bytes.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -79,8 +81,9 @@ public:
 	 *
 	 * @param paused true, when the channel should be paused.
 	 *               false when it should be unpaused.
+	 * @param time   when the pause was asked for, in milliseconds
 	 */
-	void pause(bool paused);
+	void pause(bool paused, uint32 time);
 
 	/**
 	 * Queries whether the channel is currently paused.
@@ -122,9 +125,10 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Copies what tells how long the channel has been playing into its
+	 * status, for MixerImpl::getElapsedTime().
 	 */
-	Timestamp getElapsedTime();
+	void publishTimes(ChannelStatus &status) const;
 
 	/**
 	 * Queries the channel's sound type.
@@ -172,32 +176,234 @@ private:
 #pragma mark --- Mixer ---
 #pragma mark -
 
+#ifdef SCUMMVM_THREAD_LOCAL
+// Set on the thread which currently owns the channels, see stopSlot()
+static SCUMMVM_THREAD_LOCAL bool s_ownsChannels = false;
+#endif
+
 MixerImpl::MixerImpl(uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _owner(kOwnerNone), _commandHead(0), _commandTail(0) {
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
 		_channels[i] = 0;
+		_status[i].handle.store(kSlotFree);
+		_status[i].timesHandle.store(kSlotFree);
+	}
+
+	for (int i = 0; i != COMMAND_QUEUE_SIZE; i++)
+		_commands[i].sequence.store(i);
 }
 
 MixerImpl::~MixerImpl() {
+#ifdef SCUMMVM_THREAD_LOCAL
+	// Streams stopping other sounds when deleted must not wait for this
+	s_ownsChannels = true;
+#endif
+
+	// Hand over the channels still waiting to be played
+	applyCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+#ifdef SCUMMVM_THREAD_LOCAL
+	s_ownsChannels = false;
+#endif
 }
 
 void MixerImpl::setReady(bool ready) {
-	_mixerReady = ready;
+	_mixerReady.store(ready);
 }
 
 uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
 
+bool MixerImpl::pushCommand(const Command &command) {
+	for (;;) {
+		const int32 pos = _commandHead.load();
+		CommandCell &cell = _commands[pos & (COMMAND_QUEUE_SIZE - 1)];
+		const int32 diff = (int32)((uint32)cell.sequence.load() - (uint32)pos);
+
+		if (diff == 0) {
+			if (_commandHead.compareExchange(pos, pos + 1)) {
+				cell.command = command;
+				cell.sequence.store(pos + 1);
+				return true;
+			}
+		} else if (diff < 0) {
+			// The queue is full
+			return false;
+		}
+	}
+}
+
+bool MixerImpl::popCommand(Command &command) {
+	const int32 pos = _commandTail.load();
+	CommandCell &cell = _commands[pos & (COMMAND_QUEUE_SIZE - 1)];
+
+	// Empty, or the next command is still being written
+	if (cell.sequence.load() != pos + 1)
+		return false;
+
+	command = cell.command;
+	cell.sequence.store(pos + COMMAND_QUEUE_SIZE);
+	_commandTail.store(pos + 1);
+	return true;
+}
+
+void MixerImpl::sendCommand(const Command &command) {
+	while (!pushCommand(command)) {
+		// Nothing has been mixed for a while, so apply the commands here
+		if (_owner.compareExchange(kOwnerNone, kOwnerEngine)) {
+#ifdef SCUMMVM_THREAD_LOCAL
+			s_ownsChannels = true;
+#endif
+			applyCommands();
+#ifdef SCUMMVM_THREAD_LOCAL
+			s_ownsChannels = false;
+#endif
+			_owner.store(kOwnerNone);
+		} else {
+			g_system->delayMillis(1);
+		}
+	}
+}
+
+void MixerImpl::applyCommands() {
+	Command command;
+	while (popCommand(command)) {
+		Channel *chan = 0;
+
+		switch (command.type) {
+		case kCommandPlay: {
+			// Whatever is left in the slot was stopped, or the slot could
+			// not have been taken again
+			const int index = command.handle % NUM_CHANNELS;
+			delete _channels[index];
+			_channels[index] = command.channel;
+			break;
+		}
+
+		case kCommandPause:
+			chan = findChannel(command.handle);
+			if (chan) {
+				chan->pause(command.value != 0, command.time);
+				publishStatus(command.handle % NUM_CHANNELS);
+			}
+			break;
+
+		case kCommandPauseID:
+		case kCommandPauseAll:
+			for (int i = 0; i != NUM_CHANNELS; i++) {
+				if (isChannelLive(i) && (command.type == kCommandPauseAll || _channels[i]->getId() == command.id)) {
+					_channels[i]->pause(command.value != 0, command.time);
+					publishStatus(i);
+					if (command.type == kCommandPauseID)
+						break;
+				}
+			}
+			break;
+
+		case kCommandVolume:
+			chan = findChannel(command.handle);
+			if (chan)
+				chan->setVolume(command.value);
+			break;
+
+		case kCommandBalance:
+			chan = findChannel(command.handle);
+			if (chan)
+				chan->setBalance(command.value);
+			break;
+
+		case kCommandSoundType:
+			for (int i = 0; i != NUM_CHANNELS; ++i) {
+				if (isChannelLive(i) && _channels[i]->getType() == command.value)
+					_channels[i]->notifyGlobalVolChange();
+			}
+			break;
+		}
+	}
+}
+
+int MixerImpl::findSlot(SoundHandle handle) const {
+	// An unset handle has the value of a free slot
+	if ((int32)handle._val == kSlotFree || (int32)handle._val == kSlotReserved)
+		return -1;
+
+	const int index = handle._val % NUM_CHANNELS;
+	if ((uint32)_status[index].handle.load() != handle._val)
+		return -1;
+	return index;
+}
+
+void MixerImpl::stopSlot(int index, int32 handle) {
+	ChannelStatus &status = _status[index];
+	if (!status.handle.compareExchange(handle, kSlotFree))
+		return;
+
+	// A stream may stop a sound while it is mixed, or from its destructor
+	// when the channel holding it is deleted. This thread owns the channels
+	// then, and the next mix deletes the channel, as it drops every channel
+	// whose slot was freed.
+#ifdef SCUMMVM_THREAD_LOCAL
+	if (s_ownsChannels)
+		return;
+
+	// Otherwise delete the channel and its stream before returning, since
+	// the stream may belong to an engine or plugin which goes away right
+	// after. Wait for the mix to be done to take the channels over.
+	while (!_owner.compareExchange(kOwnerNone, kOwnerEngine))
+		g_system->delayMillis(1);
+	s_ownsChannels = true;
+#else
+	// Without thread local storage the owner is not known, so the deletion
+	// is left to the mix whenever the channels are taken
+	if (!_owner.compareExchange(kOwnerNone, kOwnerEngine))
+		return;
+#endif
+
+	// The channel may still be waiting in the command queue
+	applyCommands();
+
+	Channel *chan = _channels[index];
+	if (chan && (int32)chan->getHandle()._val == handle) {
+		delete chan;
+		_channels[index] = 0;
+	}
+
+#ifdef SCUMMVM_THREAD_LOCAL
+	s_ownsChannels = false;
+#endif
+	_owner.store(kOwnerNone);
+}
+
+Channel *MixerImpl::findChannel(uint32 handle) {
+	const int index = handle % NUM_CHANNELS;
+	if (!_channels[index] || _channels[index]->getHandle()._val != handle || !isChannelLive(index))
+		return 0;
+	return _channels[index];
+}
+
+bool MixerImpl::isChannelLive(int index) const {
+	return _channels[index] && (uint32)_status[index].handle.load() == _channels[index]->getHandle()._val;
+}
+
+void MixerImpl::publishStatus(int index) {
+	ChannelStatus &status = _status[index];
+	status.serial.fetchAdd(1);
+	_channels[index]->publishTimes(status);
+	status.serial.fetchAdd(1);
+}
+
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == 0) {
+		if (_status[i].handle.compareExchange(kSlotFree, kSlotReserved)) {
 			index = i;
 			break;
 		}
@@ -208,13 +414,24 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		return;
 	}
 
-	_channels[index] = chan;
-
 	SoundHandle chanHandle;
-	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+	do {
+		chanHandle._val = index + ((uint32)_handleSeed.fetchAdd(1) * NUM_CHANNELS);
+	} while ((int32)chanHandle._val == kSlotFree || (int32)chanHandle._val == kSlotReserved);
 
 	chan->setHandle(chanHandle);
-	_handleSeed++;
+
+	ChannelStatus &status = _status[index];
+	status.id.store(chan->getId());
+	status.type.store(chan->getType());
+	status.permanent.store(chan->isPermanent());
+	status.volume.store(chan->getVolume());
+	status.balance.store(chan->getBalance());
+	status.handle.store(chanHandle._val);
+
+	const Command command = { kCommandPlay, chanHandle._val, 0, 0, 0, chan };
+	sendCommand(command);
+
 	if (handle)
 		*handle = chanHandle;
 }
@@ -227,30 +444,25 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
-
 	if (stream == 0) {
 		warning("stream is 0");
 		return;
 	}
 
 
-	assert(_mixerReady);
+	assert(isReady());
 
 	// Prevent duplicate sounds
-	if (id != -1) {
-		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != 0 && _channels[i]->getId() == id) {
-				// Delete the stream if were asked to auto-dispose it.
-				// Note: This could cause trouble if the client code does not
-				// yet expect the stream to be gone. The primary example to
-				// keep in mind here is QueuingAudioStream.
-				// Thus, as a quick rule of thumb, you should never, ever,
-				// try to play QueuingAudioStreams with a sound id.
-				if (autofreeStream == DisposeAfterUse::YES)
-					delete stream;
-				return;
-			}
+	if (id != -1 && isSoundIDActive(id)) {
+		// Delete the stream if were asked to auto-dispose it.
+		// Note: This could cause trouble if the client code does not
+		// yet expect the stream to be gone. The primary example to
+		// keep in mind here is QueuingAudioStream.
+		// Thus, as a quick rule of thumb, you should never, ever,
+		// try to play QueuingAudioStreams with a sound id.
+		if (autofreeStream == DisposeAfterUse::YES)
+			delete stream;
+		return;
 	}
 
 #ifdef AUDIO_REVERSE_STEREO
@@ -265,120 +477,159 @@ void MixerImpl::playStream(
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	PROFILE_ZONE("MixerImpl::mixCallback");
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
-
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
 	assert(len % 4 == 0);
 	len >>= 2;
 
 	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
+	_mixerReady.store(true);
+
+	// An engine thread is applying the commands after the queue filled up.
+	// Rather than wait for it, play silence this time.
+	if (!_owner.compareExchange(kOwnerNone, kOwnerMixer)) {
+		memset(buf, 0, 4 * len);
+		return 0;
+	}
+
+#ifdef SCUMMVM_THREAD_LOCAL
+	s_ownsChannels = true;
+#endif
 
-	//  zero the buf
-	memset(buf, 0, 2 * len * sizeof(int16));
+	const bool timing = CPUStats::isActive();
+	const uint64 start = timing ? CPUStats::now() : 0;
+
+	applyCommands();
+
+	// The channels are mixed at 32 bits and clipped once at the end
+	if (_mixBuffer.size() < 2 * len)
+		_mixBuffer.resize(2 * len);
+	memset(_mixBuffer.begin(), 0, 2 * len * sizeof(int32));
 
 	// mix all channels
 	int res = 0, tmp;
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i]) {
-			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
-			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		Channel *chan = _channels[i];
+		if (!chan)
+			continue;
+
+		// Channels stopped during a mix are left to be dropped here, as
+		// their slot is not their own any more
+		ChannelStatus &status = _status[i];
+		const int32 chanHandle = chan->getHandle()._val;
+
+		if (status.handle.load() != chanHandle) {
+			delete chan;
+			_channels[i] = 0;
+		} else if (chan->isFinished()) {
+			delete chan;
+			_channels[i] = 0;
+			status.handle.compareExchange(chanHandle, kSlotFree);
+		} else {
+			if (!chan->isPaused()) {
+				CPUStatsScope scope(timing ? CPUStats::getSoundTypeCounter(chan->getType()) : -1);
+				tmp = chan->mix(_mixBuffer.begin(), len);
 
 				if (tmp > res)
 					res = tmp;
 			}
+			publishStatus(i);
 		}
+	}
+
+#ifdef SCUMMVM_THREAD_LOCAL
+	s_ownsChannels = false;
+#endif
+	_owner.store(kOwnerNone);
+
+	clampedPack(buf, _mixBuffer.begin(), 2 * len);
+
+	if (timing) {
+		CPUStats &stats = CPUStats::instance();
+		stats.add(CPUStats::kCounterMixer, (uint32)(CPUStats::now() - start));
+		stats.endMix(len, _sampleRate);
+	}
 
 	return res;
 }
 
 void MixerImpl::stopAll() {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+		const int32 handle = _status[i].handle.load();
+		if (handle != kSlotFree && handle != kSlotReserved && !_status[i].permanent.load())
+			stopSlot(i, handle);
 	}
 }
 
 void MixerImpl::stopID(int id) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+		const int32 handle = _status[i].handle.load();
+		if (handle != kSlotFree && handle != kSlotReserved && _status[i].id.load() == id)
+			stopSlot(i, handle);
 	}
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	delete _channels[index];
-	_channels[index] = 0;
+	stopSlot(index, handle._val);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
+	_soundTypeSettings[type].mute.store(mute);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	const Command command = { kCommandSoundType, 0, 0, type, 0, 0 };
+	sendCommand(command);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	return _soundTypeSettings[type].mute;
+	return _soundTypeSettings[type].mute.load() != 0;
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setVolume(volume);
+	_status[index].volume.store(volume);
+
+	const Command command = { kCommandVolume, handle._val, 0, volume, 0, 0 };
+	sendCommand(command);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getVolume();
+	return _status[index].volume.load();
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setBalance(balance);
+	_status[index].balance.store(balance);
+
+	const Command command = { kCommandBalance, handle._val, 0, balance, 0, 0 };
+	sendCommand(command);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getBalance();
+	return _status[index].balance.load();
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -386,82 +637,104 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Audio::Timestamp ts(0, _sampleRate);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	const int index = findSlot(handle);
+	if (index == -1)
+		return ts;
+
+	// Read the times the owner of the channels last published
+	const ChannelStatus &status = _status[index];
+	int32 serial, timesHandle;
+	uint32 samplesConsumed, mixerTimeStamp, pauseTime, pauseStartTime;
+	bool paused;
+	do {
+		serial = status.serial.load();
+		timesHandle = status.timesHandle.load();
+		samplesConsumed = status.samplesConsumed.load();
+		mixerTimeStamp = status.mixerTimeStamp.load();
+		pauseTime = status.pauseTime.load();
+		pauseStartTime = status.pauseStartTime.load();
+		paused = status.paused.load() != 0;
+	} while ((serial & 1) || status.serial.load() != serial);
+
+	// Not mixed yet
+	if ((uint32)timesHandle != handle._val || mixerTimeStamp == 0)
+		return ts;
+
+	uint32 delta = 0;
+	if (paused)
+		delta = pauseStartTime - mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - mixerTimeStamp - pauseTime;
+
+	// Convert the number of samples into a time duration.
+
+	ts = ts.addFrames(samplesConsumed);
+	ts = ts.addMsecs(delta);
+
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
+	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
+	// isn't invoked at the regular intervals that I first imagined.
 
-	return _channels[index]->getElapsedTime();
+	return ts;
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0) {
-			_channels[i]->pause(paused);
-		}
-	}
+	const Command command = { kCommandPauseAll, 0, 0, paused, g_system->getMillis(true), 0 };
+	sendCommand(command);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
-			return;
-		}
-	}
+	const Command command = { kCommandPauseID, 0, id, paused, g_system->getMillis(true), 0 };
+	sendCommand(command);
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
-
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (findSlot(handle) == -1)
 		return;
 
-	_channels[index]->pause(paused);
+	const Command command = { kCommandPause, handle._val, 0, paused, g_system->getMillis(true), 0 };
+	sendCommand(command);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		const int32 handle = _status[i].handle.load();
+		if (handle != kSlotFree && handle != kSlotReserved && _status[i].id.load() == id)
 			return true;
+	}
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
-	return 0;
+	const int index = findSlot(handle);
+	if (index == -1)
+		return 0;
+	return _status[index].id.load();
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return findSlot(handle) != -1;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		const int32 handle = _status[i].handle.load();
+		if (handle != kSlotFree && handle != kSlotReserved && _status[i].type.load() == type)
 			return true;
+	}
 	return false;
 }
 
@@ -474,19 +747,16 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
-	_soundTypeSettings[type].volume = volume;
+	_soundTypeSettings[type].volume.store(volume);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	const Command command = { kCommandSoundType, 0, 0, type, 0, 0 };
+	sendCommand(command);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 
-	return _soundTypeSettings[type].volume;
+	return _soundTypeSettings[type].volume.load();
 }
 
 
@@ -556,53 +826,34 @@ void Channel::updateChannelVolumes() {
 	}
 }
 
-void Channel::pause(bool paused) {
+void Channel::pause(bool paused, uint32 time) {
 	//assert((paused && _pauseLevel >= 0) || (!paused && _pauseLevel));
 
 	if (paused) {
 		_pauseLevel++;
 
 		if (_pauseLevel == 1)
-			_pauseStartTime = g_system->getMillis(true);
+			_pauseStartTime = time;
 	} else if (_pauseLevel > 0) {
 		_pauseLevel--;
 
 		if (!_pauseLevel) {
-			_pauseTime = (g_system->getMillis(true) - _pauseStartTime);
+			_pauseTime = (time - _pauseStartTime);
 			_pauseStartTime = 0;
 		}
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
-
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
-
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
-
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
-
-	return ts;
+void Channel::publishTimes(ChannelStatus &status) const {
+	status.timesHandle.store(_handle._val);
+	status.samplesConsumed.store(_samplesConsumed);
+	status.mixerTimeStamp.store(_mixerTimeStamp);
+	status.pauseTime.store(_pauseTime);
+	status.pauseStartTime.store(_pauseStartTime);
+	status.paused.store(isPaused());
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(int32 *data, uint len) {
 	assert(_stream);
 
 	int res = 0;
@@ -613,7 +864,7 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
-		res = _converter->flow(*_stream, data, len, _volL, _volR);
+		res = _converter->mix(*_stream, data, len, _volL, _volR);
 		_samplesDecoded += res;
 	}
 
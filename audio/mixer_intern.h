@@ -24,11 +24,30 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
-#include "common/mutex.h"
+#include "common/array.h"
+#include "common/atomic.h"
 #include "audio/mixer.h"
 
 namespace Audio {
 
+/**
+ * What engine threads can find out about the channel in one mixer slot
+ * without touching the channel itself.
+ */
+struct ChannelStatus {
+	/** Handle of the channel in the slot, or one of the kSlot values */
+	Common::AtomicInt32 handle;
+
+	/** Written by the control calls */
+	Common::AtomicInt32 id, type, permanent, volume, balance;
+
+	/** Odd while the owner of the channels updates the times below */
+	Common::AtomicInt32 serial;
+	/** Handle of the channel the times are for */
+	Common::AtomicInt32 timesHandle;
+	Common::AtomicInt32 samplesConsumed, mixerTimeStamp, pauseTime, pauseStartTime, paused;
+};
+
 /**
  * The (default) implementation of the ScummVM audio mixing subsystem.
  *
@@ -51,24 +70,103 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 16
+		NUM_CHANNELS = 16,
+		/** Number of control calls which can wait for the next mix, a power of two */
+		COMMAND_QUEUE_SIZE = 256
+	};
+
+	/** Slot states in ChannelStatus::handle, which no handle takes */
+	enum {
+		kSlotFree = -1,
+		kSlotReserved = -2
 	};
 
-	Common::Mutex _mutex;
+	/**
+	 * Who may touch _channels and the channels in it. That is the mixing
+	 * thread, except when a sound is stopped, or when the command queue
+	 * fills up while nothing is mixed: then the engine thread takes over
+	 * for a moment. Sounds stopped by the owner itself, from a stream, are
+	 * deleted by the next mix.
+	 */
+	enum Owner {
+		kOwnerNone,
+		kOwnerMixer,
+		kOwnerEngine
+	};
+
+	enum CommandType {
+		kCommandPlay,
+		kCommandPause,
+		kCommandPauseID,
+		kCommandPauseAll,
+		kCommandVolume,
+		kCommandBalance,
+		kCommandSoundType
+	};
+
+	/**
+	 * A control call, applied by the owner of the channels. Stopping a
+	 * channel needs no command: it frees the slot, and the mix drops the
+	 * channels it finds without one.
+	 */
+	struct Command {
+		CommandType type;
+		uint32 handle;
+		int id;
+		int value;
+		/** When the call was made, for pausing */
+		uint32 time;
+		/** The new channel, for kCommandPlay */
+		Channel *channel;
+	};
+
+	struct CommandCell {
+		/** Queue position the cell is ready for, to write or to read */
+		Common::AtomicInt32 sequence;
+		Command command;
+	};
 
 	const uint _sampleRate;
-	bool _mixerReady;
-	uint32 _handleSeed;
+	Common::AtomicInt32 _mixerReady;
+	Common::AtomicInt32 _handleSeed;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		Common::AtomicInt32 mute;
+		Common::AtomicInt32 volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
+
+	/** Owned by _owner */
 	Channel *_channels[NUM_CHANNELS];
+	ChannelStatus _status[NUM_CHANNELS];
+	Common::AtomicInt32 _owner;
+
+	/**
+	 * Bounded queue of commands: any thread adds to the head, the owner of
+	 * the channels takes from the tail.
+	 */
+	CommandCell _commands[COMMAND_QUEUE_SIZE];
+	Common::AtomicInt32 _commandHead, _commandTail;
+
+	// The 32-bit buffer all channels are mixed into
+	Common::Array<int32> _mixBuffer;
+
+	bool pushCommand(const Command &command);
+	bool popCommand(Command &command);
+	void sendCommand(const Command &command);
+	void applyCommands();
+
+	/** Index of the slot holding the handle, or -1 */
+	int findSlot(SoundHandle handle) const;
+	void stopSlot(int index, int32 handle);
+
+	/** The channel with the handle, if the slot still holds it */
+	Channel *findChannel(uint32 handle);
+	bool isChannelLive(int index) const;
+	void publishStatus(int index);
 
 
 public:
@@ -76,7 +174,7 @@ public:
 	MixerImpl(uint sampleRate);
 	~MixerImpl();
 
-	virtual bool isReady() const { return _mixerReady; }
+	virtual bool isReady() const { return _mixerReady.load() != 0; }
 
 	virtual void playStream(
 		SoundType type,
@@ -127,6 +225,9 @@ public:
 	 * the backend (e.g. from an audio mixing thread). All the actual mixing
 	 * work is done from here.
 	 *
+	 * It applies the control calls made since the last call, and never
+	 * waits for them.
+	 *
 	 * @param samples Sample buffer, in which stereo 16-bit samples will be stored.
 	 * @param len Length of the provided buffer to fill (in bytes, should be divisible by 4).
 	 * @return number of sample pairs processed (which can still be silence!)
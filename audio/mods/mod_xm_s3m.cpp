@@ -69,6 +69,14 @@
 #include "audio/mods/mod_xm_s3m.h"
 #include "audio/mods/module_mod_xm_s3m.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MODS_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MODS_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Modules {
 
 class ModXmS3mStream : public Audio::AudioStream {
@@ -105,6 +113,10 @@ private:
 	int *_mixBuffer;
 	int _mixBufferSamples;	// number of samples kept in _mixBuffer
 
+	// buffer a tick is mixed into, kept between ticks
+	int *_tickBuffer;
+	int _tickBufferLength;
+
 	static const int FP_SHIFT;
 	static const int FP_ONE;
 	static const int FP_MASK;
@@ -180,6 +192,9 @@ ModXmS3mStream::ModXmS3mStream(Common::SeekableReadStream *stream, int rate, int
 	_rampBuf = nullptr;
 	_playCount = nullptr;
 	_channels = nullptr;
+	_mixBuffer = nullptr;
+	_tickBuffer = nullptr;
+	_tickBufferLength = 0;
 
 	if (!_module.load(*stream)) {
 		warning("It's not a valid Mod/S3m/Xm sound file");
@@ -195,7 +210,6 @@ ModXmS3mStream::ModXmS3mStream(Common::SeekableReadStream *stream, int rate, int
 	_rampBuf = new int[128];
 	_channels = new Channel[_module.numChannels];
 	_dataLeft = calculateDuration() * 4; // stereo and uint16
-	_mixBuffer = nullptr;
 }
 
 ModXmS3mStream::~ModXmS3mStream() {
@@ -218,6 +232,11 @@ ModXmS3mStream::~ModXmS3mStream() {
 		delete []_mixBuffer;
 		_mixBuffer = nullptr;
 	}
+
+	if (_tickBuffer) {
+		delete []_tickBuffer;
+		_tickBuffer = nullptr;
+	}
 }
 
 int ModXmS3mStream::initPlayCount(int8 **playCount) {
@@ -1152,10 +1171,79 @@ int ModXmS3mStream::seek(int samplePos) {
 	return currentPos;
 }
 
+/**
+ * Add a run of interpolated or nearest samples to the stereo mix buffer,
+ * with the sample position advancing by step each frame. The run must end
+ * before the position reaches the end of the sample or of its loop. The
+ * positions have the same 15 bit fractions as ModXmS3mStream::FP_SHIFT.
+ */
+template<bool interpolation>
+static void mixRun(int *mixBuf, const int16 *sampleData, int samIdx, int samFra, int step, int count, int lGain, int rGain) {
+	// Gathering the samples stays scalar, the gains are applied to eight
+	// frames at once. The gains are below 32768, so the products fit the
+	// 16x16 bit multiplications.
+	int16 samples[256];
+
+	while (count > 0) {
+		const int frames = MIN(count, (int)ARRAYSIZE(samples));
+		for (int i = 0; i < frames; i++) {
+			if (interpolation) {
+				const int c = sampleData[samIdx];
+				const int m = sampleData[samIdx + 1] - c;
+				samples[i] = (int16)(((m * samFra) >> 15) + c);
+			} else {
+				samples[i] = sampleData[samIdx];
+			}
+			samFra += step;
+			samIdx += samFra >> 15;
+			samFra &= 0x7FFF;
+		}
+
+		int i = 0;
+#if defined(MODS_USE_SSE2)
+		const __m128i gains = _mm_setr_epi16(lGain, rGain, lGain, rGain, lGain, rGain, lGain, rGain);
+		for (; i + 8 <= frames; i += 8) {
+			const __m128i y = _mm_loadu_si128((const __m128i *)(samples + i));
+			const __m128i pairs[2] = { _mm_unpacklo_epi16(y, y), _mm_unpackhi_epi16(y, y) };
+			for (int j = 0; j < 2; j++) {
+				const __m128i lo = _mm_mullo_epi16(pairs[j], gains);
+				const __m128i hi = _mm_mulhi_epi16(pairs[j], gains);
+				int *dst = mixBuf + (i + j * 4) * 2;
+				const __m128i out0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+				const __m128i out1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+				_mm_storeu_si128((__m128i *)dst, _mm_add_epi32(_mm_loadu_si128((const __m128i *)dst), out0));
+				_mm_storeu_si128((__m128i *)(dst + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(dst + 4)), out1));
+			}
+		}
+#elif defined(MODS_USE_NEON)
+		const int16 gainPairs[4] = { (int16)lGain, (int16)rGain, (int16)lGain, (int16)rGain };
+		const int16x4_t gains = vld1_s16(gainPairs);
+		for (; i + 8 <= frames; i += 8) {
+			const int16x8_t y = vld1q_s16(samples + i);
+			const int16x8x2_t zipped = vzipq_s16(y, y);
+			for (int j = 0; j < 2; j++) {
+				int *dst = mixBuf + (i + j * 4) * 2;
+				const int32x4_t out0 = vshrq_n_s32(vmull_s16(vget_low_s16(zipped.val[j]), gains), 15);
+				const int32x4_t out1 = vshrq_n_s32(vmull_s16(vget_high_s16(zipped.val[j]), gains), 15);
+				vst1q_s32(dst, vaddq_s32(vld1q_s32(dst), out0));
+				vst1q_s32(dst + 4, vaddq_s32(vld1q_s32(dst + 4), out1));
+			}
+		}
+#endif
+		for (; i < frames; i++) {
+			mixBuf[i * 2] += (samples[i] * lGain) >> 15;
+			mixBuf[i * 2 + 1] += (samples[i] * rGain) >> 15;
+		}
+
+		mixBuf += frames * 2;
+		count -= frames;
+	}
+}
+
 void ModXmS3mStream::resample(Channel &channel, int *mixBuf, int offset, int count, int sampleRate) {
 	Sample *sample = channel.sample;
 	int lGain = 0, rGain = 0, samIdx = 0, samFra = 0, step = 0;
-	int loopLen = 0, loopEnd = 0, outIdx = 0, outEnd = 0, y = 0, m = 0, c = 0;
+	int loopLen = 0, loopEnd = 0, outIdx = 0, outEnd = 0;
 	int16 *sampleData = channel.sample->data;
 	if (channel.ampl > 0) {
 		lGain = channel.ampl * (255 - channel.pann) >> 8;
@@ -1167,46 +1255,37 @@ void ModXmS3mStream::resample(Channel &channel, int *mixBuf, int offset, int cou
 		loopEnd = sample->loopStart + loopLen;
 		outIdx = offset * 2;
 		outEnd = (offset + count) * 2;
-		if (_interpolation) {
-			while (outIdx < outEnd) {
-				if (samIdx >= loopEnd) {
-					if (loopLen > 1) {
-						while (samIdx >= loopEnd) {
-							samIdx -= loopLen;
-						}
-					} else {
-						break;
+		if (!_interpolation && samIdx < 0)
+			samIdx = 0;
+
+		// Mix the runs of frames between the loop restarts, so there is
+		// no check for the loop end per frame
+		while (outIdx < outEnd) {
+			if (samIdx >= loopEnd) {
+				if (loopLen > 1) {
+					while (samIdx >= loopEnd) {
+						samIdx -= loopLen;
 					}
+				} else {
+					break;
 				}
-				c = sampleData[samIdx];
-				m = sampleData[samIdx + 1] - c;
-				y = ((m * samFra) >> FP_SHIFT) + c;
-				mixBuf[outIdx++] += (y * lGain) >> FP_SHIFT;
-				mixBuf[outIdx++] += (y * rGain) >> FP_SHIFT;
-				samFra += step;
-				samIdx += samFra >> FP_SHIFT;
-				samFra &= FP_MASK;
 			}
-		} else {
-			while (outIdx < outEnd) {
-				if (samIdx >= loopEnd) {
-					if (loopLen > 1) {
-						while (samIdx >= loopEnd) {
-							samIdx -= loopLen;
-						}
-					} else {
-						break;
-					}
-				}
-				if (samIdx < 0)
-					samIdx = 0;
-				y = sampleData[samIdx];
-				mixBuf[outIdx++] += (y * lGain) >> FP_SHIFT;
-				mixBuf[outIdx++] += (y * rGain) >> FP_SHIFT;
-				samFra += step;
-				samIdx += samFra >> FP_SHIFT;
-				samFra &= FP_MASK;
+
+			int frames = (outEnd - outIdx) / 2;
+			if (step > 0) {
+				const int64 left = ((int64)(loopEnd - samIdx) << FP_SHIFT) - samFra;
+				frames = (int)MIN<int64>(frames, (left + step - 1) / step);
 			}
+
+			if (_interpolation)
+				mixRun<true>(&mixBuf[outIdx], sampleData, samIdx, samFra, step, frames, lGain, rGain);
+			else
+				mixRun<false>(&mixBuf[outIdx], sampleData, samIdx, samFra, step, frames, lGain, rGain);
+
+			const int64 advance = (int64)step * frames + samFra;
+			samIdx += (int)(advance >> FP_SHIFT);
+			samFra = (int)(advance & FP_MASK);
+			outIdx += frames * 2;
 		}
 	}
 }
@@ -1272,7 +1351,15 @@ int ModXmS3mStream::getAudio(int *mixBuf) {
 int ModXmS3mStream::readBuffer(int16 *buffer, const int numSamples) {
 	int samplesRead = 0;
 	while (samplesRead < numSamples && _dataLeft >= 0) {
-		int *mixBuf = new int[calculateMixBufLength()];
+		// The tick length changes with the tempo
+		const int mixBufLength = calculateMixBufLength();
+		if (mixBufLength > _tickBufferLength) {
+			delete []_tickBuffer;
+			_tickBuffer = new int[mixBufLength];
+			_tickBufferLength = mixBufLength;
+		}
+
+		int *mixBuf = _tickBuffer;
 		int samples = getAudio(mixBuf);
 		if (samplesRead + samples > numSamples) {
 			_mixBufferSamples = samplesRead + samples - numSamples;
@@ -1280,7 +1367,19 @@ int ModXmS3mStream::readBuffer(int16 *buffer, const int numSamples) {
 			_mixBuffer = new int[_mixBufferSamples];
 			memcpy(_mixBuffer, mixBuf + samples, _mixBufferSamples * sizeof(int));
 		}
-		for (int idx = 0; idx < samples; ++idx) {
+
+		int idx = 0;
+#if defined(MODS_USE_SSE2)
+		for (; idx + 8 <= samples; idx += 8) {
+			const __m128i lo = _mm_loadu_si128((const __m128i *)(mixBuf + idx));
+			const __m128i hi = _mm_loadu_si128((const __m128i *)(mixBuf + idx + 4));
+			_mm_storeu_si128((__m128i *)(buffer + idx), _mm_packs_epi32(lo, hi));
+		}
+#elif defined(MODS_USE_NEON)
+		for (; idx + 8 <= samples; idx += 8)
+			vst1q_s16(buffer + idx, vcombine_s16(vqmovn_s32(vld1q_s32(mixBuf + idx)), vqmovn_s32(vld1q_s32(mixBuf + idx + 4))));
+#endif
+		for (; idx < samples; ++idx) {
 			int ampl = mixBuf[idx];
 			if (ampl > 32767) {
 				ampl = 32767;
@@ -1288,10 +1387,10 @@ int ModXmS3mStream::readBuffer(int16 *buffer, const int numSamples) {
 			if (ampl < -32768) {
 				ampl = -32768;
 			}
-			*buffer++ = ampl;
+			buffer[idx] = ampl;
 		}
+		buffer += samples;
 		samplesRead += samples;
-		delete []mixBuf; // free
 	}
 	_dataLeft -= samplesRead * 2;
 
@@ -38,6 +38,11 @@
 #include "audio/mods/paula.h"
 #include "audio/null.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PAULA_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Audio {
 
 Paula::Paula(bool stereo, int rate, uint interruptFreq, FilterMode filterMode) :
@@ -120,10 +125,11 @@ int Paula::readBuffer(int16 *buffer, const int numSamples) {
  * The current filtering should be accurate to 2 dB with the filter on,
  * and to 1 dB with the filter off.
  */
+template<Paula::FilterMode mode>
 inline int32 filter(int32 input, Paula::FilterState &state, int voice) {
 	float normalOutput, ledOutput;
 
-	switch (state.mode) {
+	switch (mode) {
 	case Paula::kFilterModeA500:
 		state.rc[voice][0] = state.a0[0] * input + (1 - state.a0[0]) * state.rc[voice][0] + DENORMAL_OFFSET;
 		state.rc[voice][1] = state.a0[1] * state.rc[voice][0] + (1-state.a0[1]) * state.rc[voice][1];
@@ -155,30 +161,115 @@ inline int32 filter(int32 input, Paula::FilterState &state, int voice) {
 	return CLIP<int32>(state.ledFilter ? ledOutput : normalOutput, -32768, 32767);
 }
 
-template<bool stereo>
-inline int mixBuffer(int16 *&buf, const int8 *data, Paula::Offset &offset, frac_t rate, int neededSamples, uint bufSize, byte volume, byte panning, Paula::FilterState &filterState, int voice) {
-	int samples;
-	for (samples = 0; samples < neededSamples && offset.int_off < bufSize; ++samples) {
-		const int32 tmp = filter(((int32) data[offset.int_off]) * volume, filterState, voice);
-		if (stereo) {
-			*buf++ += (tmp * (255 - panning)) >> 7;
-			*buf++ += (tmp * (panning)) >> 7;
-		} else
-			*buf++ += tmp;
+/**
+ * Copy the volume scaled samples of a voice until the end of its buffer, to
+ * every NUM_VOICES-th int32 of dst.
+ */
+inline int gatherSamples(int32 *&dst, const int8 *data, Paula::Offset &offset, frac_t rate, int neededSamples, uint bufSize, byte volume) {
+	if (offset.int_off >= bufSize)
+		return 0;
+
+	// Work out how many samples are left before the end of the buffer, so
+	// the loop does not check for it on every sample
+	uint64 pos = ((uint64)offset.int_off << FRAC_BITS) | offset.rem_off;
+	int samples = neededSamples;
+	if (rate > 0)
+		samples = (int)MIN<uint64>(neededSamples, (((uint64)bufSize << FRAC_BITS) - pos + rate - 1) / rate);
+
+	for (int i = 0; i < samples; ++i) {
+		*dst = ((int32) data[pos >> FRAC_BITS]) * volume;
+		dst += Paula::NUM_VOICES;
 
 		// Step to next source sample
-		offset.rem_off += rate;
-		if (offset.rem_off >= (frac_t)FRAC_ONE) {
-			offset.int_off += fracToInt(offset.rem_off);
-			offset.rem_off &= FRAC_LO_MASK;
-		}
+		pos += rate;
 	}
 
+	offset.int_off = (uint)(pos >> FRAC_BITS);
+	offset.rem_off = (frac_t)(pos & FRAC_LO_MASK);
 	return samples;
 }
 
+/**
+ * Filter the first counts[voice] samples of each voice, in place.
+ */
+template<Paula::FilterMode mode>
+void filterBlock(int32 *samples, const int *counts, Paula::FilterState &state) {
+	if (mode == Paula::kFilterModeNone)
+		return;
+
+#ifdef PAULA_USE_SSE2
+	// All four voices are filtered together, with the voices that have no
+	// more samples keeping their state. The additions of DENORMAL_OFFSET
+	// are done in double precision like in filter().
+	const __m128 a0[3] = { _mm_set1_ps(state.a0[0]), _mm_set1_ps(state.a0[1]), _mm_set1_ps(state.a0[2]) };
+	const __m128 a1[3] = { _mm_set1_ps(1 - state.a0[0]), _mm_set1_ps(1 - state.a0[1]), _mm_set1_ps(1 - state.a0[2]) };
+	const __m128d denormalOffset = _mm_set1_pd(DENORMAL_OFFSET);
+	const __m128i voiceCounts = _mm_loadu_si128((const __m128i *)counts);
+
+	__m128 rc[5];
+	for (int i = 0; i < 5; i++)
+		rc[i] = _mm_setr_ps(state.rc[0][i], state.rc[1][i], state.rc[2][i], state.rc[3][i]);
+
+	const int maxCount = MAX(MAX(counts[0], counts[1]), MAX(counts[2], counts[3]));
+	for (int i = 0; i < maxCount; i++) {
+		const __m128 active = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_set1_epi32(i), voiceCounts));
+		const __m128i input = _mm_loadu_si128((const __m128i *)(samples + i * Paula::NUM_VOICES));
+		const __m128 x = _mm_cvtepi32_ps(input);
+		__m128 updated[5];
+		__m128 output;
+
+		const __m128 first = (mode == Paula::kFilterModeA500) ?
+			_mm_add_ps(_mm_mul_ps(a0[0], x), _mm_mul_ps(a1[0], rc[0])) :
+			_mm_add_ps(_mm_mul_ps(a0[2], x), _mm_mul_ps(a1[2], rc[1]));
+		const __m128 firstOffset = _mm_movelh_ps(
+			_mm_cvtpd_ps(_mm_add_pd(_mm_cvtps_pd(first), denormalOffset)),
+			_mm_cvtpd_ps(_mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(first, first)), denormalOffset)));
+
+		if (mode == Paula::kFilterModeA500) {
+			updated[0] = firstOffset;
+			updated[1] = _mm_add_ps(_mm_mul_ps(a0[1], updated[0]), _mm_mul_ps(a1[1], rc[1]));
+			updated[2] = _mm_add_ps(_mm_mul_ps(a0[2], updated[1]), _mm_mul_ps(a1[2], rc[2]));
+			updated[3] = _mm_add_ps(_mm_mul_ps(a0[2], updated[2]), _mm_mul_ps(a1[2], rc[3]));
+			updated[4] = _mm_add_ps(_mm_mul_ps(a0[2], updated[3]), _mm_mul_ps(a1[2], rc[4]));
+			output = state.ledFilter ? updated[4] : updated[1];
+		} else {
+			updated[0] = rc[0];
+			updated[1] = firstOffset;
+			updated[2] = _mm_add_ps(_mm_mul_ps(a0[2], updated[1]), _mm_mul_ps(a1[2], rc[2]));
+			updated[3] = _mm_add_ps(_mm_mul_ps(a0[2], updated[2]), _mm_mul_ps(a1[2], rc[3]));
+			updated[4] = rc[4];
+			output = state.ledFilter ? updated[3] : x;
+		}
+
+		for (int j = 0; j < 5; j++)
+			rc[j] = _mm_or_ps(_mm_and_ps(active, updated[j]), _mm_andnot_ps(active, rc[j]));
+
+		// Packing with saturation clips like CLIP
+		const __m128i clipped = _mm_packs_epi32(_mm_cvttps_epi32(output), _mm_setzero_si128());
+		_mm_storeu_si128((__m128i *)(samples + i * Paula::NUM_VOICES), _mm_srai_epi32(_mm_unpacklo_epi16(clipped, clipped), 16));
+	}
+
+	for (int i = 0; i < 5; i++) {
+		float lanes[4];
+		_mm_storeu_ps(lanes, rc[i]);
+		for (int voice = 0; voice < Paula::NUM_VOICES; voice++)
+			state.rc[voice][i] = lanes[voice];
+	}
+#else
+	for (int voice = 0; voice < Paula::NUM_VOICES; voice++) {
+		int32 *sample = samples + voice;
+		for (int i = 0; i < counts[voice]; i++, sample += Paula::NUM_VOICES)
+			*sample = filter<mode>(*sample, state, voice);
+	}
+#endif
+}
+
 template<bool stereo>
 int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
+	// The samples of all voices, interleaved, for filtering them together
+	int32 voiceSamples[kBlockSize * NUM_VOICES];
+	int counts[NUM_VOICES];
+
 	int samples = _stereo ? numSamples / 2 : numSamples;
 	while (samples > 0) {
 
@@ -191,10 +282,12 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 
 		// Compute how many samples to generate: at most the requested number of samples,
 		// of course, but we may stop earlier when an 'interrupt' is expected.
-		const uint nSamples = MIN((uint)samples, _curInt);
+		const uint nSamples = MIN(MIN((uint)samples, _curInt), (uint)kBlockSize);
 
 		// Loop over the four channels of the emulated Paula chip
 		for (int voice = 0; voice < NUM_VOICES; voice++) {
+			counts[voice] = 0;
+
 			// No data, or paused -> skip channel
 			if (!_voice[voice].data || (_voice[voice].period <= 0))
 				continue;
@@ -211,19 +304,19 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 
 
 			Channel &ch = _voice[voice];
-			int16 *p = buffer;
+			int32 *p = voiceSamples + voice;
 			int neededSamples = nSamples;
 
 			// NOTE: A Protracker (or other module format) player might actually
 			// push the offset past the sample length in its interrupt(), in which
-			// case the first mixBuffer() call should not mix anything, and the loop
-			// should be triggered.
+			// case the first gatherSamples() call should not copy anything, and the
+			// loop should be triggered.
 			// Thus, doing an assert(ch.offset.int_off < ch.length) here is wrong.
 			// An example where this happens is a certain Protracker module played
 			// by the OS/2 version of Hopkins FBI.
 
-			// Mix the generated samples into the output buffer
-			neededSamples -= mixBuffer<stereo>(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
+			// Copy the samples to generate
+			neededSamples -= gatherSamples(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume);
 
 			// Wrap around if necessary
 			if (ch.offset.int_off >= ch.length) {
@@ -244,8 +337,8 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 			if (neededSamples > 0 && ch.length > 2) {
 				// Repeat as long as necessary.
 				while (neededSamples > 0) {
-					// Mix the generated samples into the output buffer
-					neededSamples -= mixBuffer<stereo>(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
+					// Copy the samples to generate
+					neededSamples -= gatherSamples(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume);
 
 					if (ch.offset.int_off >= ch.length) {
 						// Wrap around. See also the note above.
@@ -255,7 +348,35 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 				}
 			}
 
+			counts[voice] = nSamples - neededSamples;
+		}
+
+		switch (_filterState.mode) {
+		case kFilterModeA500:
+			filterBlock<kFilterModeA500>(voiceSamples, counts, _filterState);
+			break;
+		case kFilterModeA1200:
+			filterBlock<kFilterModeA1200>(voiceSamples, counts, _filterState);
+			break;
+		case kFilterModeNone:
+		default:
+			break;
 		}
+
+		// Mix the generated samples into the output buffer
+		for (int voice = 0; voice < NUM_VOICES; voice++) {
+			const int32 *sample = voiceSamples + voice;
+			const byte panning = _voice[voice].panning;
+			int16 *p = buffer;
+			for (int i = 0; i < counts[voice]; i++, sample += NUM_VOICES) {
+				if (stereo) {
+					*p++ += (*sample * (255 - panning)) >> 7;
+					*p++ += (*sample * (panning)) >> 7;
+				} else
+					*p++ += *sample;
+			}
+		}
+
 		buffer += _stereo ? nSamples * 2 : nSamples;
 		_curInt -= nSamples;
 		samples -= nSamples;
@@ -215,6 +215,9 @@ private:
 
 	FilterState _filterState;
 
+	/** The number of samples of each voice generated and filtered at once */
+	static const int kBlockSize = 256;
+
 	template<bool stereo>
 	int readBufferIntern(int16 *buffer, const int numSamples);
 
@@ -3,6 +3,7 @@ MODULE := audio
 MODULE_OBJS := \
 	adlib.o \
 	audiostream.o \
+	cpustats.o \
 	fmopl.o \
 	mididrv.o \
 	midiparser_qt.o \
@@ -16,6 +17,8 @@ MODULE_OBJS := \
 	mpu401.o \
 	musicplugin.o \
 	null.o \
+	rate_common.o \
+	soundcache.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
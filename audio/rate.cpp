@@ -31,10 +31,20 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/algorithm.h"
+#include "common/array.h"
 #include "common/frac.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RATE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RATE_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Audio {
 
 
@@ -57,6 +67,18 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Add a sample to the output: clipped for 16-bit output, as is for the
+ * 32-bit mixing buffer.
+ */
+static inline void mixSample(st_sample_t &a, int b) {
+	clampedAdd(a, b);
+}
+
+static inline void mixSample(int32 &a, int b) {
+	a += b;
+}
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -79,10 +101,19 @@ protected:
 
 public:
 	SimpleRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
+	int mix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+
+private:
+	template<typename SampleInt>
+	int flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
 };
 
 
@@ -112,8 +143,9 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+template<typename SampleInt>
+int SimpleRateConverter<stereo, reverseStereo>::flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	SampleInt *ostart, *oend;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
@@ -144,10 +176,10 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 		opos += opos_inc;
 
 		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
 		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
 
 		obuf += 2;
 	}
@@ -185,10 +217,19 @@ protected:
 
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
+	int mix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+
+private:
+	template<typename SampleInt>
+	int flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
 };
 
 
@@ -221,8 +262,9 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+template<typename SampleInt>
+int LinearRateConverter<stereo, reverseStereo>::flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	SampleInt *ostart, *oend;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
@@ -259,10 +301,10 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 						  out0);
 
 			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
 			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
 
 			obuf += 2;
 
@@ -277,6 +319,392 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 #pragma mark -
 
 
+/**
+ * The largest number of filter phases computed for a sinc rate converter.
+ * Ratios with more phases than this use the nearest of them.
+ */
+#define SINC_MAX_PHASES 512
+
+/** The largest number of filter taps of a sinc rate converter. */
+#define SINC_MAX_TAPS 32
+
+/** The number of fractional bits of the sinc filter coefficients. */
+#define SINC_COEF_BITS 14
+
+/**
+ * Zeroth order modified Bessel function of the first kind, used by the
+ * Kaiser window.
+ */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; term > sum * 1e-12; k++) {
+		const double factor = x / (2 * k);
+		term *= factor * factor;
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Compute the coefficients of one phase of a Kaiser-windowed sinc filter.
+ *
+ * The phase is centred between tap taps / 2 - 1 and the next one, at the
+ * given fraction of a frame after it. Its coefficients add up to exactly
+ * 1 << SINC_COEF_BITS, so that a constant input stays constant.
+ *
+ * @param coefs   the coefficients to compute
+ * @param taps    the number of taps, even
+ * @param frac    the position of the output frame, in [0, 1)
+ * @param cutoff  the cutoff frequency, relative to the input Nyquist frequency
+ * @param beta    the Kaiser window shape
+ */
+static void makeSincPhase(int16 *coefs, uint taps, double frac, double cutoff, double beta) {
+	const double half = taps / 2;
+	const double windowScale = 1.0 / besselI0(beta);
+
+	double values[SINC_MAX_TAPS];
+	double sum = 0.0;
+	for (uint i = 0; i < taps; i++) {
+		const double t = i - (half - 1) - frac;
+		const double x = t / half;
+		const double window = (x * x < 1.0) ? besselI0(beta * sqrt(1.0 - x * x)) * windowScale : 0.0;
+		const double sinc = (t == 0.0) ? 1.0 : sin(M_PI * cutoff * t) / (M_PI * cutoff * t);
+		values[i] = sinc * window;
+		sum += values[i];
+	}
+
+	// Put the rounding error on the largest coefficient
+	int total = 0;
+	uint largest = 0;
+	for (uint i = 0; i < taps; i++) {
+		coefs[i] = (int16)floor(values[i] / sum * (1 << SINC_COEF_BITS) + 0.5);
+		total += coefs[i];
+		if (coefs[i] > coefs[largest])
+			largest = i;
+	}
+	coefs[largest] += (1 << SINC_COEF_BITS) - total;
+}
+
+/**
+ * Apply a filter phase to the samples of one channel.
+ *
+ * @param taps  the number of taps, a multiple of 8
+ */
+static inline st_sample_t sincFilter(const int16 *samples, const int16 *coefs, uint taps) {
+#if defined(RATE_USE_SSE2)
+	__m128i sum = _mm_setzero_si128();
+	for (uint i = 0; i < taps; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(samples + i));
+		const __m128i c = _mm_loadu_si128((const __m128i *)(coefs + i));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(s, c));
+	}
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	const int32 total = _mm_cvtsi128_si32(sum);
+#elif defined(RATE_USE_NEON)
+	int32x4_t sum = vdupq_n_s32(0);
+	for (uint i = 0; i < taps; i += 8) {
+		const int16x8_t s = vld1q_s16(samples + i);
+		const int16x8_t c = vld1q_s16(coefs + i);
+		sum = vmlal_s16(sum, vget_low_s16(s), vget_low_s16(c));
+		sum = vmlal_s16(sum, vget_high_s16(s), vget_high_s16(c));
+	}
+	const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	const int32 total = vget_lane_s32(vpadd_s32(pair, pair), 0);
+#else
+	int32 total = 0;
+	for (uint i = 0; i < taps; i++)
+		total += samples[i] * coefs[i];
+#endif
+
+	return (st_sample_t)CLIP<int32>((total + (1 << (SINC_COEF_BITS - 1))) >> SINC_COEF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+/**
+ * Audio rate converter based on a polyphase Kaiser-windowed sinc filter.
+ *
+ * The ratio of the rates is reduced to out / in = D / S, and the output
+ * advances S / D input frames per frame. The filter has one phase for each
+ * of the D positions between two input frames, up to SINC_MAX_PHASES of
+ * them, all computed when the converter is made.
+ */
+template<bool stereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+protected:
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/** The input frames of each channel, starting with the filter window */
+	int16 _history[stereo ? 2 : 1][INTERMEDIATE_BUFFER_SIZE];
+	/** Start of the filter window in the history */
+	int _historyPos;
+	/** Number of frames from the window start on, negative for frames to skip */
+	int _historyLen;
+
+	/** Number of filter taps */
+	const uint _taps;
+	/** The filter coefficients, one row of _taps for each phase */
+	Common::Array<int16> _coefs;
+	/** Number of rows in _coefs */
+	uint32 _phases;
+
+	/** Position of the output between two input frames, in 1 / _phaseRange */
+	uint32 _phase, _phaseRange;
+	/** Increment of the output position: whole frames and phase */
+	uint32 _frameStep, _phaseStep;
+
+public:
+	SincRateConverter(st_rate_t inrate, st_rate_t outrate, uint taps, double beta, double rolloff);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
+	int mix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+
+private:
+	bool fillHistory(AudioStream &input);
+
+	template<typename SampleInt>
+	int flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+};
+
+
+/*
+ * Prepare processing.
+ */
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::SincRateConverter(st_rate_t inrate, st_rate_t outrate, uint taps, double beta, double rolloff) : _taps(taps) {
+	assert(taps % 8 == 0 && taps <= SINC_MAX_TAPS);
+
+	const st_rate_t divisor = Common::gcd(inrate, outrate);
+	_phaseRange = outrate / divisor;
+	_frameStep = (inrate / divisor) / _phaseRange;
+	_phaseStep = (inrate / divisor) % _phaseRange;
+	_phase = 0;
+
+	// When there are fewer rows than phases, each row covers several
+	// phases and is computed for the middle of them
+	_phases = MIN<uint32>(_phaseRange, SINC_MAX_PHASES);
+	const double offset = (_phases < _phaseRange) ? 0.5 : 0.0;
+
+	// Filter out everything above the output Nyquist frequency too when
+	// downsampling
+	const double cutoff = MIN<double>(1.0, (double)outrate / inrate) * rolloff;
+
+	_coefs.resize(_phases * taps);
+	for (uint32 phase = 0; phase < _phases; phase++)
+		makeSincPhase(&_coefs[phase * taps], taps, (phase + offset) / _phases, cutoff, beta);
+
+	// Start with silence, so that the first output frame is the first input frame
+	memset(_history, 0, sizeof(_history));
+	_historyPos = 0;
+	_historyLen = taps / 2 - 1;
+}
+
+/*
+ * Read input until the whole filter window is in the history.
+ * Return false if the input ran out first.
+ */
+template<bool stereo, bool reverseStereo>
+bool SincRateConverter<stereo, reverseStereo>::fillHistory(AudioStream &input) {
+	const int channels = stereo ? 2 : 1;
+
+	if (_historyLen > 0) {
+		for (int c = 0; c < channels; c++)
+			memmove(_history[c], _history[c] + _historyPos, _historyLen * sizeof(int16));
+	}
+	_historyPos = 0;
+
+	while (_historyLen < (int)_taps) {
+		const int space = INTERMEDIATE_BUFFER_SIZE - MAX(_historyLen, 0);
+		const int len = input.readBuffer(inBuf, MIN<int>(space * channels, ARRAYSIZE(inBuf)));
+		if (len <= 0)
+			return false;
+
+		const st_sample_t *inPtr = inBuf;
+		int frames = len / channels;
+
+		// Drop the frames the window has already moved past
+		if (_historyLen < 0) {
+			const int skip = MIN(frames, -_historyLen);
+			inPtr += skip * channels;
+			frames -= skip;
+			_historyLen += skip;
+		}
+
+		for (int i = 0; i < frames; i++, _historyLen++) {
+			_history[0][_historyLen] = *inPtr++;
+			if (stereo)
+				_history[1][_historyLen] = *inPtr++;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+template<typename SampleInt>
+int SincRateConverter<stereo, reverseStereo>::flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	assert(input.isStereo() == stereo);
+
+	SampleInt *ostart, *oend;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	while (obuf < oend) {
+		if (_historyLen < (int)_taps && !fillHistory(input))
+			return (obuf - ostart) / 2;
+
+		const int16 *coefs = &_coefs[(_phase * _phases / _phaseRange) * _taps];
+
+		st_sample_t out0, out1;
+		out0 = sincFilter(_history[0] + _historyPos, coefs, _taps);
+		out1 = (stereo ? sincFilter(_history[stereo ? 1 : 0] + _historyPos, coefs, _taps) : out0);
+
+		// output left channel
+		mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		obuf += 2;
+
+		// Increment output position
+		uint32 frames = _frameStep;
+		_phase += _phaseStep;
+		if (_phase >= _phaseRange) {
+			_phase -= _phaseRange;
+			frames++;
+		}
+		_historyPos += frames;
+		_historyLen -= frames;
+	}
+	return (obuf - ostart) / 2;
+}
+
+
+#pragma mark -
+
+
+/**
+ * Add the input samples to the output, with volume and balance applied.
+ *
+ * @return The end of the output.
+ */
+template<bool stereo, bool reverseStereo, typename SampleInt>
+static inline SampleInt *mixCopy(SampleInt *obuf, const st_sample_t *ptr, st_size_t len, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; len > 0; len -= (stereo ? 2 : 1)) {
+		st_sample_t out0, out1;
+		out0 = *ptr++;
+		out1 = (stereo ? *ptr++ : out0);
+
+		// output left channel
+		mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		obuf += 2;
+	}
+
+	return obuf;
+}
+
+#if defined(RATE_USE_SSE2) || defined(RATE_USE_NEON)
+
+/**
+ * Add eight input frames to the 32-bit mixing buffer, with volume and
+ * balance applied to all of them at once. kMaxMixerVolume is 256, so the
+ * division is a shift rounding towards zero.
+ */
+template<bool stereo, bool reverseStereo>
+static inline const st_sample_t *mixFrames8(int32 *obuf, const st_sample_t *ptr, st_volume_t vol_l, st_volume_t vol_r) {
+#ifdef RATE_USE_SSE2
+	const __m128i volume = _mm_setr_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r);
+
+	__m128i frames[2];
+	if (stereo) {
+		frames[0] = _mm_loadu_si128((const __m128i *)ptr);
+		frames[1] = _mm_loadu_si128((const __m128i *)(ptr + 8));
+		ptr += 16;
+	} else {
+		const __m128i samples = _mm_loadu_si128((const __m128i *)ptr);
+		frames[0] = _mm_unpacklo_epi16(samples, samples);
+		frames[1] = _mm_unpackhi_epi16(samples, samples);
+		ptr += 8;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		const __m128i lo = _mm_mullo_epi16(frames[i], volume);
+		const __m128i hi = _mm_mulhi_epi16(frames[i], volume);
+		const __m128i products[2] = { _mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi) };
+
+		for (int j = 0; j < 2; j++) {
+			__m128i out = _mm_add_epi32(products[j], _mm_srli_epi32(_mm_srai_epi32(products[j], 31), 24));
+			out = _mm_srai_epi32(out, 8);
+			if (reverseStereo)
+				out = _mm_shuffle_epi32(out, _MM_SHUFFLE(2, 3, 0, 1));
+
+			int32 *dst = obuf + i * 8 + j * 4;
+			_mm_storeu_si128((__m128i *)dst, _mm_add_epi32(_mm_loadu_si128((const __m128i *)dst), out));
+		}
+	}
+#else
+	const int16 volumes[4] = { (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r };
+	const int16x4_t volume = vld1_s16(volumes);
+
+	int16x8_t frames[2];
+	if (stereo) {
+		frames[0] = vld1q_s16(ptr);
+		frames[1] = vld1q_s16(ptr + 8);
+		ptr += 16;
+	} else {
+		const int16x8_t samples = vld1q_s16(ptr);
+		const int16x8x2_t zipped = vzipq_s16(samples, samples);
+		frames[0] = zipped.val[0];
+		frames[1] = zipped.val[1];
+		ptr += 8;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		const int32x4_t products[2] = { vmull_s16(vget_low_s16(frames[i]), volume), vmull_s16(vget_high_s16(frames[i]), volume) };
+
+		for (int j = 0; j < 2; j++) {
+			const uint32x4_t sign = vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(products[j], 31)), 24);
+			int32x4_t out = vshrq_n_s32(vaddq_s32(products[j], vreinterpretq_s32_u32(sign)), 8);
+			if (reverseStereo)
+				out = vrev64q_s32(out);
+
+			int32 *dst = obuf + i * 8 + j * 4;
+			vst1q_s32(dst, vaddq_s32(vld1q_s32(dst), out));
+		}
+	}
+#endif
+
+	return ptr;
+}
+
+template<bool stereo, bool reverseStereo>
+static inline int32 *mixCopy(int32 *obuf, const st_sample_t *ptr, st_size_t len, st_volume_t vol_l, st_volume_t vol_r) {
+	const st_size_t step = stereo ? 16 : 8;
+	for (; len >= step; len -= step) {
+		ptr = mixFrames8<stereo, reverseStereo>(obuf, ptr, vol_l, vol_r);
+		obuf += 16;
+	}
+
+	return mixCopy<stereo, reverseStereo, int32>(obuf, ptr, len, vol_l, vol_r);
+}
+
+#endif
+
 /**
  * Simple audio rate converter for the case that the inrate equals the outrate.
  */
@@ -291,16 +719,42 @@ public:
 	}
 
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-		assert(input.isStereo() == stereo);
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
+
+	virtual int mix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return flowInto(input, obuf, osamp, vol_l, vol_r);
+	}
 
-		st_sample_t *ptr;
-		st_size_t len;
+	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
 
-		st_sample_t *ostart = obuf;
+private:
+	template<typename SampleInt>
+	int flowInto(AudioStream &input, SampleInt *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		assert(input.isStereo() == stereo);
 
 		if (stereo)
 			osamp *= 2;
 
+		// Mix straight from the memory of streams which hold their samples
+		// there already
+		SampleInt *oend = obuf;
+		int len = 0;
+		while (osamp > 0) {
+			const int16 *samples;
+			len = input.getReadPointer(samples, osamp);
+			if (len <= 0)
+				break;
+
+			oend = mixCopy<stereo, reverseStereo>(oend, samples, len, vol_l, vol_r);
+			osamp -= len;
+		}
+
+		if (len >= 0 || !osamp)
+			return (oend - obuf) / 2;
+
 		// Reallocate temp buffer, if necessary
 		if (osamp > _bufferSize) {
 			free(_buffer);
@@ -315,25 +769,8 @@ public:
 		len = input.readBuffer(_buffer, osamp);
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-		}
-		return (obuf - ostart) / 2;
-	}
-
-	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
-		return ST_SUCCESS;
+		oend = mixCopy<stereo, reverseStereo>(oend, _buffer, len, vol_l, vol_r);
+		return (oend - obuf) / 2;
 	}
 };
 
@@ -341,9 +778,13 @@ public:
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (quality == kRateConverterHigh) {
+			return new SincRateConverter<stereo, reverseStereo>(inrate, outrate, 32, 7.0, 0.88);
+		} else if (quality == kRateConverterMedium) {
+			return new SincRateConverter<stereo, reverseStereo>(inrate, outrate, 16, 5.0, 0.80);
+		} else if ((inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -356,14 +797,22 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
+	if (quality == kRateConverterDefault) {
+#if defined(RATE_USE_SSE2) || defined(RATE_USE_NEON)
+		quality = kRateConverterHigh;
+#else
+		quality = kRateConverterLow;
+#endif
+	}
+
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
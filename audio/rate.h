@@ -65,6 +65,15 @@ static inline void clampedAdd(int16& a, int b) {
 #endif
 }
 
+/**
+ * Clip 32-bit mixed samples to 16-bit output samples.
+ *
+ * @param dst    the output samples
+ * @param src    the mixed samples, as added up by RateConverter::mix()
+ * @param count  the number of samples, not sample pairs
+ */
+void clampedPack(st_sample_t *dst, const int32 *src, st_size_t count);
+
 class RateConverter {
 public:
 	RateConverter() {}
@@ -75,10 +84,36 @@ public:
 	 */
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Like flow(), but add the samples to a 32-bit buffer without clipping
+	 * them. Several streams can be mixed that way and clipped only once at
+	 * the end with clampedPack().
+	 *
+	 * The default implementation goes through flow(), which clips the
+	 * samples of each call.
+	 *
+	 * @return Number of sample pairs added to the buffer.
+	 */
+	virtual int mix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * The resampling quality of a rate converter.
+ */
+enum RateConverterQuality {
+	kRateConverterLow,     ///< Sample dropping or linear interpolation
+	kRateConverterMedium,  ///< 16-tap windowed-sinc filter
+	kRateConverterHigh,    ///< 32-tap windowed-sinc filter
+	/**
+	 * High quality where the filter is vectorized, low quality on the
+	 * targets that would have to run it in scalar code.
+	 */
+	kRateConverterDefault
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterDefault);
 
 } // End of namespace Audio
 
@@ -0,0 +1,98 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/rate.h"
+
+#include "common/util.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RATE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RATE_USE_NEON
+#include <arm_neon.h>
+#endif
+
+// Mixing code needed with either of rate.cpp and rate_arm.cpp
+
+namespace Audio {
+
+void clampedPack(st_sample_t *dst, const int32 *src, st_size_t count) {
+	st_size_t i = 0;
+
+#if defined(RATE_USE_SSE2)
+	for (; i + 8 <= count; i += 8) {
+		const __m128i lo = _mm_loadu_si128((const __m128i *)(src + i));
+		const __m128i hi = _mm_loadu_si128((const __m128i *)(src + i + 4));
+		__m128i out = _mm_packs_epi32(lo, hi);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = _mm_xor_si128(out, _mm_set1_epi16((int16)0x8000));
+#endif
+		_mm_storeu_si128((__m128i *)(dst + i), out);
+	}
+#elif defined(RATE_USE_NEON)
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t out = vcombine_s16(vqmovn_s32(vld1q_s32(src + i)), vqmovn_s32(vld1q_s32(src + i + 4)));
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = veorq_s16(out, vdupq_n_s16((int16)0x8000));
+#endif
+		vst1q_s16(dst + i, out);
+	}
+#endif
+
+	for (; i < count; i++) {
+		const int32 val = CLIP<int32>(src[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		dst[i] = ((int16)val) ^ 0x8000;
+#else
+		dst[i] = val;
+#endif
+	}
+}
+
+int RateConverter::mix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t buffer[512];
+	int total = 0;
+
+	while (osamp > 0) {
+		const st_size_t chunk = MIN<st_size_t>(osamp, ARRAYSIZE(buffer) / 2);
+		memset(buffer, 0, sizeof(buffer));
+
+		const int res = flow(input, buffer, chunk, vol_l, vol_r);
+		if (res <= 0)
+			break;
+
+		for (int i = 0; i < res * 2; i++)
+			obuf[i] += buffer[i];
+
+		obuf += res * 2;
+		osamp -= res;
+		total += res;
+
+		if ((st_size_t)res < chunk)
+			break;
+	}
+
+	return total;
+}
+
+} // End of namespace Audio
@@ -24,6 +24,7 @@
 #define AUDIO_SOFTSYNTH_EMUMIDI_H
 
 #include "audio/audiostream.h"
+#include "audio/cpustats.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
@@ -44,12 +45,18 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	/** The CPUStats counter, or -2 before it was looked up */
+	int _statsCounter;
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/** The name the synth's CPU time is counted under in Audio::CPUStats */
+	virtual const char *getStatsName() const { return "emulated midi"; }
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -58,6 +65,7 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_statsCounter(-2),
 		_baseFreq(250) {
 	}
 
@@ -93,12 +101,18 @@ public:
 		int len = numSamples / stereoFactor;
 		int step;
 
+		if (_statsCounter == -2 && Audio::CPUStats::isActive())
+			_statsCounter = Audio::CPUStats::instance().getDriverCounter(getStatsName());
+
 		do {
 			step = len;
 			if (step > (_nextTick >> FIXP_SHIFT))
 				step = (_nextTick >> FIXP_SHIFT);
 
-			generateSamples(data, step);
+			{
+				Audio::CPUStatsScope scope(_statsCounter);
+				generateSamples(data, step);
+			}
 
 			_nextTick -= step << FIXP_SHIFT;
 			if (!(_nextTick >> FIXP_SHIFT)) {
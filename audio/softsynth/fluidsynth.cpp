@@ -24,9 +24,14 @@
 
 #ifdef USE_FLUIDSYNTH
 
+#include "common/array.h"
+#include "common/atomic.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/error.h"
+#include "common/mutex.h"
 #include "common/system.h"
+#include "common/taskscheduler.h"
 #include "common/textconsole.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
@@ -41,6 +46,22 @@
 #include <fluidsynth.h>
 #endif
 
+/**
+ * MIDI driver for FluidSynth.
+ *
+ * When the task scheduler has worker threads and "fluidsynth_render_ahead"
+ * is set, FluidSynth renders that many milliseconds ahead on a worker, into
+ * a ring buffer the mixer callback only copies from, the way the MT-32
+ * driver does. FluidSynth cannot play events at a sample position, so the
+ * worker stops rendering at the position each queued event is due at and
+ * plays it there.
+ *
+ * With "fluidsynth_adaptive_quality" set, the time rendering takes is
+ * measured against the duration of the audio rendered. While it is over
+ * budget, or the worker fell behind the mixer, the polyphony, interpolation
+ * and effects are lowered one tier at a time, and they are raised again
+ * after some time well within budget.
+ */
 class MidiDriver_FluidSynth : public MidiDriver_Emulated {
 private:
 	MidiChannel_MPU401 _midiChannels[16];
@@ -49,6 +70,99 @@ private:
 	int _soundFont;
 	int _outputRate;
 
+	/** A MIDI message waiting for the render worker */
+	struct Event {
+		uint32 msg;
+		/** In frames rendered */
+		uint32 timestamp;
+	};
+
+	struct EventCell {
+		/** Vyukov's bounded queue: which lap of the queue the cell is in */
+		Common::AtomicInt32 sequence;
+		Event event;
+	};
+
+	enum {
+		EVENT_QUEUE_SIZE = 1024
+	};
+
+	class RenderTask;
+	friend class RenderTask;
+
+	/** Null when rendering in the mixer callback */
+	Common::TaskScheduler *_scheduler;
+
+	/**
+	 * Bounded queue of events: any thread adds to the head, the render
+	 * worker takes from the tail.
+	 */
+	EventCell _events[EVENT_QUEUE_SIZE];
+	Common::AtomicInt32 _eventHead, _eventTail;
+
+	/** The ring buffer of stereo frames, its size a power of two */
+	Common::Array<int16> _buffer;
+	uint32 _bufferFrames;
+	/** Frames to render ahead of the mixer, and to render at a time */
+	uint32 _aheadFrames, _chunkFrames;
+
+	/** Frames read by the mixer and rendered since opening */
+	Common::AtomicInt32 _readPos, _renderPos;
+	/** Whether the worker is scheduled or running */
+	Common::AtomicInt32 _rendering;
+	/** Asks the worker to stop */
+	Common::AtomicInt32 _stop;
+	/** Set by the mixer when the worker had not rendered enough */
+	Common::AtomicInt32 _underrun;
+	/** Guards _future, which both the mixer and the engine thread set */
+	Common::Mutex _futureMutex;
+	Common::TaskFuture _future;
+
+	enum {
+		QUALITY_TIERS = 4,
+		/** Never lower the polyphony below this */
+		MIN_POLYPHONY = 16,
+		/** Percentages of the audio duration that rendering may take */
+		LOAD_HIGH = 60,
+		LOAD_LOW = 20,
+		/** Measure the load over this many milliseconds of audio */
+		LOAD_WINDOW = 500,
+		/** Windows within LOAD_LOW before raising the quality again */
+		LOAD_LOW_WINDOWS = 8
+	};
+
+	/** What the quality tiers are relative to, as configured */
+	bool _adaptiveQuality;
+	int _basePolyphony;
+	int _baseInterpolation;
+	bool _baseChorus, _baseReverb;
+
+	/**
+	 * The quality tier, and the load measured, only touched by the thread
+	 * rendering.
+	 */
+	int _qualityTier;
+	uint32 _loadUsec, _loadFrames;
+	int _lowLoadWindows;
+
+	void playMessage(uint32 b);
+	/** Render with FluidSynth, and adapt the quality to the time it took. */
+	void renderSynth(int16 *data, uint32 frames);
+	void setQualityTier(int tier);
+
+	bool pushEvent(const Event &event);
+	bool peekEvent(Event &event);
+	void popEvent();
+
+	uint32 getRenderSpace() const { return (uint32)_readPos.load() + _aheadFrames - (uint32)_renderPos.load(); }
+
+	/** Render until the worker is ahead by _aheadFrames, on the worker. */
+	void render();
+	/** Start the worker, unless it runs already or has nothing to do. */
+	void scheduleRender(bool force = false);
+	/** Wait for the worker to stop. */
+	void stopRender();
+
 protected:
 	// Because GCC complains about casting from const to non-const...
 	void setInt(const char *name, int val);
@@ -56,9 +170,11 @@ protected:
 	void setStr(const char *name, const char *str);
 
 	void generateSamples(int16 *buf, int len);
+	const char *getStatsName() const { return "fluidsynth"; }
 
 public:
 	MidiDriver_FluidSynth(Audio::Mixer *mixer);
+	virtual ~MidiDriver_FluidSynth();
 
 	int open();
 	void close();
@@ -89,6 +205,25 @@ MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer)
 		_outputRate = 22050;
 	else if (_outputRate > 96000)
 		_outputRate = 96000;
+
+	_scheduler = nullptr;
+	_bufferFrames = 0;
+	_aheadFrames = 0;
+	_chunkFrames = 0;
+
+	_adaptiveQuality = false;
+	_basePolyphony = 0;
+	_baseInterpolation = FLUID_INTERP_4THORDER;
+	_baseChorus = false;
+	_baseReverb = false;
+	_qualityTier = 0;
+	_loadUsec = 0;
+	_loadFrames = 0;
+	_lowLoadWindows = 0;
+}
+
+MidiDriver_FluidSynth::~MidiDriver_FluidSynth() {
+	close();
 }
 
 // The string duplication below is there only because older versions (1.1.6
@@ -187,6 +322,16 @@ int MidiDriver_FluidSynth::open() {
 
 	fluid_synth_set_interp_method(_synth, -1, interpMethod);
 
+	_adaptiveQuality = ConfMan.getBool("fluidsynth_adaptive_quality");
+	_basePolyphony = fluid_synth_get_polyphony(_synth);
+	_baseInterpolation = interpMethod;
+	_baseChorus = ConfMan.getBool("fluidsynth_chorus_activate");
+	_baseReverb = ConfMan.getBool("fluidsynth_reverb_activate");
+	_qualityTier = 0;
+	_loadUsec = 0;
+	_loadFrames = 0;
+	_lowLoadWindows = 0;
+
 	const char *soundfont = ConfMan.get("soundfont").c_str();
 
 #if defined(IPHONE_IOS7) && defined(IPHONE_SANDBOXED)
@@ -204,6 +349,30 @@ int MidiDriver_FluidSynth::open() {
 	if (_soundFont == -1)
 		error("Failed loading custom sound font '%s'", soundfont);
 
+	// A serial scheduler would render in the mixer callback all the same
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	const int renderAhead = ConfMan.getInt("fluidsynth_render_ahead");
+	if (renderAhead > 0 && !scheduler->isSerial()) {
+		_aheadFrames = (uint32)_outputRate * renderAhead / 1000;
+		_bufferFrames = 256;
+		while (_bufferFrames < _aheadFrames)
+			_bufferFrames *= 2;
+		_buffer.resize(_bufferFrames * 2);
+		_chunkFrames = MAX<uint32>(_aheadFrames / 4, 1);
+
+		for (uint i = 0; i < EVENT_QUEUE_SIZE; ++i) {
+			_events[i].sequence.store(i);
+		}
+		_eventHead.store(0);
+		_eventTail.store(0);
+		_readPos.store(0);
+		_renderPos.store(0);
+		_underrun.store(0);
+		_scheduler = scheduler;
+
+		scheduleRender();
+	}
+
 	MidiDriver_Emulated::open();
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
@@ -217,6 +386,12 @@ void MidiDriver_FluidSynth::close() {
 
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	if (_scheduler) {
+		stopRender();
+		_buffer.clear();
+		_scheduler = nullptr;
+	}
+
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
 
@@ -225,6 +400,25 @@ void MidiDriver_FluidSynth::close() {
 }
 
 void MidiDriver_FluidSynth::send(uint32 b) {
+	if (!_scheduler) {
+		playMessage(b);
+		return;
+	}
+
+	// The mixer has played up to _readPos, and FluidSynth is at most
+	// _aheadFrames past it
+	Event event;
+	event.msg = b;
+	event.timestamp = (uint32)_readPos.load() + _aheadFrames;
+
+	while (!pushEvent(event)) {
+		// The worker may be idle with the ring buffer full
+		scheduleRender(true);
+		g_system->delayMillis(1);
+	}
+}
+
+void MidiDriver_FluidSynth::playMessage(uint32 b) {
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
 	uint param2 = (byte) ((b >> 16) & 0xFF);
 	uint param1 = (byte) ((b >>  8) & 0xFF);
@@ -275,7 +469,196 @@ MidiChannel *MidiDriver_FluidSynth::getPercussionChannel() {
 }
 
 void MidiDriver_FluidSynth::generateSamples(int16 *data, int len) {
-	fluid_synth_write_s16(_synth, len, data, 0, 2, data, 1, 2);
+	if (!_scheduler) {
+		renderSynth(data, len);
+		return;
+	}
+
+	// When the worker falls behind, play silence rather than wait
+	const uint32 readPos = _readPos.load();
+	const uint32 count = MIN<uint32>(len, (uint32)_renderPos.load() - readPos);
+
+	const uint32 start = readPos & (_bufferFrames - 1);
+	const uint32 first = MIN(count, _bufferFrames - start);
+	memcpy(data, &_buffer[start * 2], first * 2 * sizeof(int16));
+	memcpy(data + first * 2, &_buffer[0], (count - first) * 2 * sizeof(int16));
+	memset(data + count * 2, 0, (len - count) * 2 * sizeof(int16));
+	_readPos.store(readPos + count);
+
+	// The worker starts out behind, when it was first scheduled
+	if (count < (uint32)len && readPos >= _aheadFrames)
+		_underrun.store(1);
+
+	scheduleRender();
+}
+
+void MidiDriver_FluidSynth::renderSynth(int16 *data, uint32 frames) {
+	if (!_adaptiveQuality) {
+		fluid_synth_write_s16(_synth, frames, data, 0, 2, data, 1, 2);
+		return;
+	}
+
+	const uint64 start = g_system->getMicroseconds();
+	fluid_synth_write_s16(_synth, frames, data, 0, 2, data, 1, 2);
+	_loadUsec += (uint32)(g_system->getMicroseconds() - start);
+	_loadFrames += frames;
+
+	if (_loadFrames < (uint32)_outputRate * LOAD_WINDOW / 1000)
+		return;
+
+	// As a percentage of the duration of the audio
+	const uint32 load = (uint32)((uint64)_loadUsec * _outputRate / 10000 / _loadFrames);
+	const bool underrun = _underrun.load() != 0;
+	_underrun.store(0);
+	_loadUsec = 0;
+	_loadFrames = 0;
+
+	if (load > LOAD_HIGH || underrun) {
+		_lowLoadWindows = 0;
+		if (_qualityTier + 1 < QUALITY_TIERS)
+			setQualityTier(_qualityTier + 1);
+	} else if (load < LOAD_LOW && _qualityTier > 0) {
+		if (++_lowLoadWindows >= LOAD_LOW_WINDOWS) {
+			_lowLoadWindows = 0;
+			setQualityTier(_qualityTier - 1);
+		}
+	} else {
+		_lowLoadWindows = 0;
+	}
+}
+
+void MidiDriver_FluidSynth::setQualityTier(int tier) {
+	// Each tier about halves the work of the voices, and the effects are
+	// left out last as they change the sound the most
+	static const int tierInterpolation[QUALITY_TIERS] = {
+		FLUID_INTERP_7THORDER, FLUID_INTERP_4THORDER, FLUID_INTERP_LINEAR, FLUID_INTERP_NONE
+	};
+
+	_qualityTier = tier;
+
+	const int polyphony = MAX(_basePolyphony >> tier, MIN<int>(_basePolyphony, MIN_POLYPHONY));
+	const int interpolation = MIN(_baseInterpolation, tierInterpolation[tier]);
+	fluid_synth_set_polyphony(_synth, polyphony);
+	fluid_synth_set_interp_method(_synth, -1, interpolation);
+	fluid_synth_set_chorus_on(_synth, _baseChorus && tier < 2);
+	fluid_synth_set_reverb_on(_synth, _baseReverb && tier < 3);
+
+	debug(2, "MidiDriver_FluidSynth: Quality tier %d, %d voices, interpolation %d", tier, polyphony, interpolation);
+}
+
+class MidiDriver_FluidSynth::RenderTask : public Common::Task {
+public:
+	RenderTask(MidiDriver_FluidSynth &driver) : _driver(driver) {}
+
+	virtual void run() { _driver.render(); }
+
+private:
+	MidiDriver_FluidSynth &_driver;
+};
+
+bool MidiDriver_FluidSynth::pushEvent(const Event &event) {
+	for (;;) {
+		const int32 pos = _eventHead.load();
+		EventCell &cell = _events[pos & (EVENT_QUEUE_SIZE - 1)];
+		const int32 diff = (int32)((uint32)cell.sequence.load() - (uint32)pos);
+
+		if (diff == 0) {
+			if (_eventHead.compareExchange(pos, pos + 1)) {
+				cell.event = event;
+				cell.sequence.store(pos + 1);
+				return true;
+			}
+		} else if (diff < 0) {
+			// The queue is full
+			return false;
+		}
+	}
+}
+
+bool MidiDriver_FluidSynth::peekEvent(Event &event) {
+	const int32 pos = _eventTail.load();
+	const EventCell &cell = _events[pos & (EVENT_QUEUE_SIZE - 1)];
+
+	// Empty, or the next event is still being written
+	if (cell.sequence.load() != pos + 1)
+		return false;
+
+	event = cell.event;
+	return true;
+}
+
+void MidiDriver_FluidSynth::popEvent() {
+	const int32 pos = _eventTail.load();
+	_events[pos & (EVENT_QUEUE_SIZE - 1)].sequence.store(pos + EVENT_QUEUE_SIZE);
+	_eventTail.store(pos + 1);
+}
+
+void MidiDriver_FluidSynth::render() {
+	for (;;) {
+		while (!_stop.load() && getRenderSpace() >= _chunkFrames) {
+			const uint32 renderPos = _renderPos.load();
+			const uint32 start = renderPos & (_bufferFrames - 1);
+			uint32 count = MIN(_chunkFrames, _bufferFrames - start);
+
+			// Play the events which are due, and render up to the next one.
+			// Events sent from several threads may be slightly out of
+			// order, those which are late are played right away.
+			Event event;
+			while (peekEvent(event)) {
+				const int32 due = (int32)(event.timestamp - renderPos);
+				if (due > 0) {
+					count = MIN<uint32>(count, due);
+					break;
+				}
+
+				playMessage(event.msg);
+				popEvent();
+			}
+
+			renderSynth(&_buffer[start * 2], count);
+			_renderPos.store(renderPos + count);
+		}
+
+		_rendering.store(0);
+
+		// The mixer may have made room after the last check, and left it
+		// to this worker. Queued events wait for the rendering to reach them.
+		if (_stop.load() || getRenderSpace() < _chunkFrames)
+			return;
+		if (!_rendering.compareExchange(0, 1))
+			return;
+	}
+}
+
+void MidiDriver_FluidSynth::scheduleRender(bool force) {
+	if (_stop.load() || _rendering.load())
+		return;
+
+	if (!force && getRenderSpace() < _chunkFrames)
+		return;
+
+	// Both the mixer and the engine thread start the worker. _stop is
+	// checked again under the lock, so that stopRender() gets the future of
+	// any task started before it asked to stop.
+	Common::StackLock lock(_futureMutex);
+	if (!_stop.load() && _rendering.compareExchange(0, 1))
+		_future = _scheduler->schedule(new RenderTask(*this));
+}
+
+void MidiDriver_FluidSynth::stopRender() {
+	_stop.store(1);
+
+	// Wait outside the lock, the mixer must not block on it meanwhile
+	Common::TaskFuture future;
+	{
+		Common::StackLock lock(_futureMutex);
+		future = _future;
+		_future = Common::TaskFuture();
+	}
+
+	if (future.isValid())
+		future.wait();
+	_stop.store(0);
 }
 
 
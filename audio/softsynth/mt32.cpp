@@ -29,12 +29,15 @@
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 
+#include "common/array.h"
+#include "common/atomic.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/error.h"
 #include "common/events.h"
 #include "common/file.h"
 #include "common/system.h"
+#include "common/taskscheduler.h"
 #include "common/util.h"
 #include "common/archive.h"
 #include "common/textconsole.h"
@@ -102,6 +105,16 @@ class MidiChannel_MT32 : public MidiChannel_MPU401 {
 	void chorusLevel(byte value) { }
 };
 
+/**
+ * MIDI driver for the MUNT MT-32 emulator.
+ *
+ * When the task scheduler has worker threads and "mt32_render_ahead" is
+ * set, MUNT renders a fixed number of milliseconds ahead on a worker, into a
+ * ring buffer the mixer callback only copies from. The MIDI events then
+ * reach the worker through a lock-free queue, stamped with the sample
+ * position they are due at, which is where they would have been played when
+ * rendering in the mixer callback plus the render-ahead time.
+ */
 class MidiDriver_MT32 : public MidiDriver_Emulated {
 private:
 	MidiChannel_MT32 _midiChannels[16];
@@ -113,8 +126,76 @@ private:
 
 	int _outputRate;
 
+	/** A MIDI message or sysex waiting for the render worker */
+	struct Event {
+		uint32 msg;
+		/** A copy of the sysex, including its framing, or null for a message */
+		byte *sysex;
+		uint32 length;
+		/** In frames rendered */
+		uint32 timestamp;
+	};
+
+	struct EventCell {
+		/** Vyukov's bounded queue: which lap of the queue the cell is in */
+		Common::AtomicInt32 sequence;
+		Event event;
+	};
+
+	enum {
+		EVENT_QUEUE_SIZE = 1024
+	};
+
+	class RenderTask;
+	friend class RenderTask;
+
+	/** Null when rendering in the mixer callback */
+	Common::TaskScheduler *_scheduler;
+
+	/**
+	 * Bounded queue of events: any thread adds to the head, the render
+	 * worker takes from the tail.
+	 */
+	EventCell _events[EVENT_QUEUE_SIZE];
+	Common::AtomicInt32 _eventHead, _eventTail;
+	/** Only touched by the render worker */
+	uint32 _lastTimestamp;
+
+	/** The ring buffer of stereo frames, its size a power of two */
+	Common::Array<int16> _buffer;
+	uint32 _bufferFrames;
+	/** Frames to render ahead of the mixer, and to render at a time */
+	uint32 _aheadFrames, _chunkFrames;
+
+	/** Frames read by the mixer and rendered since opening */
+	Common::AtomicInt32 _readPos, _renderPos;
+	/** Whether the worker is scheduled or running */
+	Common::AtomicInt32 _rendering;
+	/** Asks the worker to stop */
+	Common::AtomicInt32 _stop;
+	/** Set under _mutex, as both the mixer and the engine thread start the worker */
+	Common::TaskFuture _future;
+
+	void playEvent(uint32 msg, const byte *sysex, uint32 length);
+	void writeSysex(byte device, const byte *data, uint32 length);
+
+	bool pushEvent(const Event &event);
+	bool peekEvent(Event &event);
+	void popEvent();
+
+	uint32 getRenderSpace() const { return (uint32)_readPos.load() + _aheadFrames - (uint32)_renderPos.load(); }
+	bool hasEvents() const { return _eventHead.load() != _eventTail.load(); }
+
+	/** Render until the worker is ahead by _aheadFrames, on the worker. */
+	void render();
+	/** Start the worker, unless it runs already or has nothing to do. */
+	void scheduleRender(bool force = false);
+	/** Wait for the worker to stop. */
+	void stopRender();
+
 protected:
 	void generateSamples(int16 *buf, int len);
+	const char *getStatsName() const { return "mt32"; }
 
 public:
 	MidiDriver_MT32(Audio::Mixer *mixer);
@@ -150,6 +231,12 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+
+	_scheduler = nullptr;
+	_lastTimestamp = 0;
+	_bufferFrames = 0;
+	_aheadFrames = 0;
+	_chunkFrames = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -219,6 +306,30 @@ int MidiDriver_MT32::open() {
 	// AudioStream.
 	_outputRate = _service.getActualStereoOutputSamplerate();
 
+	// A serial scheduler would render in the mixer callback all the same
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	const int renderAhead = ConfMan.getInt("mt32_render_ahead");
+	if (renderAhead > 0 && !scheduler->isSerial()) {
+		_aheadFrames = (uint32)_outputRate * renderAhead / 1000;
+		_bufferFrames = 256;
+		while (_bufferFrames < _aheadFrames)
+			_bufferFrames *= 2;
+		_buffer.resize(_bufferFrames * 2);
+		_chunkFrames = MAX<uint32>(_aheadFrames / 4, 1);
+
+		for (uint i = 0; i < EVENT_QUEUE_SIZE; ++i) {
+			_events[i].sequence.store(i);
+		}
+		_eventHead.store(0);
+		_eventTail.store(0);
+		_lastTimestamp = 0;
+		_readPos.store(0);
+		_renderPos.store(0);
+		_scheduler = scheduler;
+
+		scheduleRender();
+	}
+
 	MidiDriver_Emulated::open();
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
@@ -227,8 +338,7 @@ int MidiDriver_MT32::open() {
 }
 
 void MidiDriver_MT32::send(uint32 b) {
-	Common::StackLock lock(_mutex);
-	_service.playMsg(b);
+	playEvent(b, nullptr, 0);
 }
 
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
@@ -238,14 +348,12 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 		warning("setPitchBendRange() called with range > 24: %d", range);
 	}
 	byte benderRangeSysex[4] = { 0, 0, 4, (uint8)range };
-	Common::StackLock lock(_mutex);
-	_service.writeSysex(channel, benderRangeSysex, 4);
+	writeSysex(channel, benderRangeSysex, 4);
 }
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	if (msg[0] == 0xf0) {
-		Common::StackLock lock(_mutex);
-		_service.playSysex(msg, length);
+		playEvent(0, msg, length);
 	} else {
 		enum {
 			SYSEX_CMD_DT1 = 0x12,
@@ -253,14 +361,70 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 		};
 
 		if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
-			Common::StackLock lock(_mutex);
-			_service.writeSysex(msg[1], msg + 4, length - 5);
+			writeSysex(msg[1], msg + 4, length - 5);
 		} else {
 			warning("Unused sysEx command %d", msg[3]);
 		}
 	}
 }
 
+void MidiDriver_MT32::playEvent(uint32 msg, const byte *sysex, uint32 length) {
+	if (!_scheduler) {
+		Common::StackLock lock(_mutex);
+		if (sysex)
+			_service.playSysex(sysex, length);
+		else
+			_service.playMsg(msg);
+		return;
+	}
+
+	// The mixer has played up to _readPos, and MUNT is at most
+	// _aheadFrames past it
+	Event event;
+	event.msg = msg;
+	event.sysex = nullptr;
+	event.length = length;
+	event.timestamp = (uint32)_readPos.load() + _aheadFrames;
+	if (sysex) {
+		event.sysex = new byte[length];
+		memcpy(event.sysex, sysex, length);
+	}
+
+	while (!pushEvent(event)) {
+		// The worker may be idle with the ring buffer full
+		scheduleRender(true);
+		g_system->delayMillis(1);
+	}
+}
+
+void MidiDriver_MT32::writeSysex(byte device, const byte *data, uint32 length) {
+	if (!_scheduler) {
+		Common::StackLock lock(_mutex);
+		_service.writeSysex(device, data, length);
+		return;
+	}
+
+	// MUNT has no timestamped writeSysex, so wrap the data in a DT1 message
+	// with the header and checksum writeSysex does without
+	Common::Array<byte> sysex;
+	sysex.resize(length + 7);
+	sysex[0] = 0xF0;
+	sysex[1] = 0x41;
+	sysex[2] = device;
+	sysex[3] = 0x16;
+	sysex[4] = 0x12;
+
+	byte checksum = 0;
+	for (uint32 i = 0; i < length; ++i) {
+		sysex[5 + i] = data[i];
+		checksum += data[i];
+	}
+	sysex[length + 5] = (128 - (checksum & 0x7F)) & 0x7F;
+	sysex[length + 6] = 0xF7;
+
+	playEvent(0, &sysex[0], sysex.size());
+}
+
 void MidiDriver_MT32::close() {
 	if (!_isOpen)
 		return;
@@ -271,6 +435,19 @@ void MidiDriver_MT32::close() {
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	if (_scheduler) {
+		stopRender();
+
+		Event event;
+		while (peekEvent(event)) {
+			delete[] event.sysex;
+			popEvent();
+		}
+
+		_buffer.clear();
+		_scheduler = nullptr;
+	}
+
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
 	_service.freeContext();
@@ -281,153 +458,184 @@ void MidiDriver_MT32::close() {
 }
 
 void MidiDriver_MT32::generateSamples(int16 *data, int len) {
-	Common::StackLock lock(_mutex);
-	_service.renderBit16s(data, len);
-}
-
-uint32 MidiDriver_MT32::property(int prop, uint32 param) {
-	switch (prop) {
-	case PROP_CHANNEL_MASK:
-		_channelMask = param & 0xFFFF;
-		return 1;
+	if (!_scheduler) {
+		Common::StackLock lock(_mutex);
+		_service.renderBit16s(data, len);
+		return;
 	}
 
-	return 0;
-}
+	// When the worker falls behind, play silence rather than wait
+	const uint32 readPos = _readPos.load();
+	const uint32 count = MIN<uint32>(len, (uint32)_renderPos.load() - readPos);
 
-MidiChannel *MidiDriver_MT32::allocateChannel() {
-	MidiChannel_MT32 *chan;
-	uint i;
+	const uint32 start = readPos & (_bufferFrames - 1);
+	const uint32 first = MIN(count, _bufferFrames - start);
+	memcpy(data, &_buffer[start * 2], first * 2 * sizeof(int16));
+	memcpy(data + first * 2, &_buffer[0], (count - first) * 2 * sizeof(int16));
+	memset(data + count * 2, 0, (len - count) * 2 * sizeof(int16));
+	_readPos.store(readPos + count);
 
-	for (i = 0; i < ARRAYSIZE(_midiChannels); ++i) {
-		if (i == 9 || !(_channelMask & (1 << i)))
-			continue;
-		chan = &_midiChannels[i];
-		if (chan->allocate()) {
-			return chan;
-		}
-	}
-	return NULL;
+	scheduleRender();
 }
 
-MidiChannel *MidiDriver_MT32::getPercussionChannel() {
-	return &_midiChannels[9];
-}
-
-// This code should be used when calling the timer callback from the mixer thread is undesirable.
-// Note that it results in less accurate timing.
-#if 0
-class MidiEvent_MT32 {
+class MidiDriver_MT32::RenderTask : public Common::Task {
 public:
-	MidiEvent_MT32 *_next;
-	uint32 _msg; // 0xFFFFFFFF indicates a sysex message
-	byte *_data;
-	uint32 _len;
-
-	MidiEvent_MT32(uint32 msg, byte *data, uint32 len) {
-		_msg = msg;
-		if (len > 0) {
-			_data = new byte[len];
-			memcpy(_data, data, len);
-		}
-		_len = len;
-		_next = NULL;
-	}
+	RenderTask(MidiDriver_MT32 &driver) : _driver(driver) {}
 
-	MidiEvent_MT32() {
-		if (_len > 0)
-			delete _data;
-	}
-};
+	virtual void run() { _driver.render(); }
 
-class MidiDriver_ThreadedMT32 : public MidiDriver_MT32 {
 private:
-	OSystem::Mutex _eventMutex;
-	MidiEvent_MT32 *_events;
-	TimerManager::TimerProc _timer_proc;
+	MidiDriver_MT32 &_driver;
+};
 
-	void pushMidiEvent(MidiEvent_MT32 *event);
-	MidiEvent_MT32 *popMidiEvent();
+bool MidiDriver_MT32::pushEvent(const Event &event) {
+	for (;;) {
+		const int32 pos = _eventHead.load();
+		EventCell &cell = _events[pos & (EVENT_QUEUE_SIZE - 1)];
+		const int32 diff = (int32)((uint32)cell.sequence.load() - (uint32)pos);
+
+		if (diff == 0) {
+			if (_eventHead.compareExchange(pos, pos + 1)) {
+				cell.event = event;
+				cell.sequence.store(pos + 1);
+				return true;
+			}
+		} else if (diff < 0) {
+			// The queue is full
+			return false;
+		}
+	}
+}
 
-protected:
-	void send(uint32 b);
-	void sysEx(const byte *msg, uint16 length);
+bool MidiDriver_MT32::peekEvent(Event &event) {
+	const int32 pos = _eventTail.load();
+	const EventCell &cell = _events[pos & (EVENT_QUEUE_SIZE - 1)];
 
-public:
-	MidiDriver_ThreadedMT32(Audio::Mixer *mixer);
-
-	void onTimer();
-	void close();
-	void setTimerCallback(void *timer_param, TimerManager::TimerProc timer_proc);
-};
+	// Empty, or the next event is still being written
+	if (cell.sequence.load() != pos + 1)
+		return false;
 
+	event = cell.event;
+	return true;
+}
 
-MidiDriver_ThreadedMT32::MidiDriver_ThreadedMT32(Audio::Mixer *mixer) : MidiDriver_MT32(mixer) {
-	_events = NULL;
-	_timer_proc = NULL;
+void MidiDriver_MT32::popEvent() {
+	const int32 pos = _eventTail.load();
+	_events[pos & (EVENT_QUEUE_SIZE - 1)].sequence.store(pos + EVENT_QUEUE_SIZE);
+	_eventTail.store(pos + 1);
 }
 
-void MidiDriver_ThreadedMT32::close() {
-	MidiDriver_MT32::close();
-	while ((popMidiEvent() != NULL)) {
-		// Just eat any leftover events
+void MidiDriver_MT32::render() {
+	for (;;) {
+		bool queueFull = false;
+
+		while (!_stop.load()) {
+			// Hand the queued events to MUNT, which plays them at their sample
+			// position while rendering. Events sent from several threads may
+			// be slightly out of order, but MUNT needs them in order.
+			Event event;
+			while (peekEvent(event)) {
+				if ((int32)(event.timestamp - _lastTimestamp) < 0)
+					event.timestamp = _lastTimestamp;
+
+				const MT32Emu::Bit32u timestamp = _service.convertOutputToSynthTimestamp(event.timestamp);
+				const mt32emu_return_code result = event.sysex ?
+					_service.playSysexAt(event.sysex, event.length, timestamp) :
+					_service.playMsgAt(event.msg, timestamp);
+
+				// Leave the rest until MUNT has played some
+				if (result == MT32EMU_RC_QUEUE_FULL) {
+					queueFull = true;
+					break;
+				}
+
+				_lastTimestamp = event.timestamp;
+				delete[] event.sysex;
+				popEvent();
+			}
+
+			const uint32 space = getRenderSpace();
+			if (space < _chunkFrames)
+				break;
+
+			const uint32 renderPos = _renderPos.load();
+			const uint32 start = renderPos & (_bufferFrames - 1);
+			const uint32 count = MIN(_chunkFrames, _bufferFrames - start);
+			_service.renderBit16s(&_buffer[start * 2], count);
+			_renderPos.store(renderPos + count);
+			queueFull = false;
+		}
+
+		_rendering.store(0);
+
+		// The mixer may have made room, or an event may have been queued,
+		// after the last check, and left it to this worker
+		if (_stop.load() || (getRenderSpace() < _chunkFrames && (queueFull || !hasEvents())))
+			return;
+		if (!_rendering.compareExchange(0, 1))
+			return;
 	}
 }
 
-void MidiDriver_ThreadedMT32::setTimerCallback(void *timer_param, TimerManager::TimerProc timer_proc) {
-	if (!_timer_proc || !timer_proc) {
-		if (_timer_proc)
-			_vm->_timer->removeTimerProc(_timer_proc);
-		_timer_proc = timer_proc;
-		if (timer_proc)
-			_vm->_timer->installTimerProc(timer_proc, getBaseTempo(), timer_param, "MT32tempo");
-	}
+void MidiDriver_MT32::scheduleRender(bool force) {
+	if (_stop.load() || _rendering.load())
+		return;
+
+	if (!force && getRenderSpace() < _chunkFrames)
+		return;
+
+	// Both the mixer and the engine thread start the worker. _stop is
+	// checked again under the lock, so that stopRender() gets the future of
+	// any task started before it asked to stop.
+	Common::StackLock lock(_mutex);
+	if (!_stop.load() && _rendering.compareExchange(0, 1))
+		_future = _scheduler->schedule(new RenderTask(*this));
 }
 
-void MidiDriver_ThreadedMT32::pushMidiEvent(MidiEvent_MT32 *event) {
-	Common::StackLock lock(_eventMutex);
-	if (_events == NULL) {
-		_events = event;
-	} else {
-		MidiEvent_MT32 *last = _events;
-		while (last->_next != NULL)
-			last = last->_next;
-		last->_next = event;
+void MidiDriver_MT32::stopRender() {
+	_stop.store(1);
+
+	// Wait outside the lock, the mixer must not block on it meanwhile
+	Common::TaskFuture future;
+	{
+		Common::StackLock lock(_mutex);
+		future = _future;
+		_future = Common::TaskFuture();
 	}
-}
 
-MidiEvent_MT32 *MidiDriver_ThreadedMT32::popMidiEvent() {
-	Common::StackLock lock(_eventMutex);
-	MidiEvent_MT32 *event;
-	event = _events;
-	if (event != NULL)
-		_events = event->_next;
-	return event;
+	if (future.isValid())
+		future.wait();
+	_stop.store(0);
 }
 
-void MidiDriver_ThreadedMT32::send(uint32 b) {
-	MidiEvent_MT32 *event = new MidiEvent_MT32(b, NULL, 0);
-	pushMidiEvent(event);
-}
+uint32 MidiDriver_MT32::property(int prop, uint32 param) {
+	switch (prop) {
+	case PROP_CHANNEL_MASK:
+		_channelMask = param & 0xFFFF;
+		return 1;
+	}
 
-void MidiDriver_ThreadedMT32::sysEx(const byte *msg, uint16 length) {
-	MidiEvent_MT32 *event = new MidiEvent_MT32(0xFFFFFFFF, msg, length);
-	pushMidiEvent(event);
+	return 0;
 }
 
-void MidiDriver_ThreadedMT32::onTimer() {
-	MidiEvent_MT32 *event;
-	while ((event = popMidiEvent()) != NULL) {
-		if (event->_msg == 0xFFFFFFFF) {
-			MidiDriver_MT32::sysEx(event->_data, event->_len);
-		} else {
-			MidiDriver_MT32::send(event->_msg);
+MidiChannel *MidiDriver_MT32::allocateChannel() {
+	MidiChannel_MT32 *chan;
+	uint i;
+
+	for (i = 0; i < ARRAYSIZE(_midiChannels); ++i) {
+		if (i == 9 || !(_channelMask & (1 << i)))
+			continue;
+		chan = &_midiChannels[i];
+		if (chan->allocate()) {
+			return chan;
 		}
-		delete event;
 	}
+	return NULL;
 }
-#endif
 
+MidiChannel *MidiDriver_MT32::getPercussionChannel() {
+	return &_midiChannels[9];
+}
 
 // Plugin interface
 
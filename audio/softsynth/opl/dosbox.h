@@ -90,15 +90,15 @@ public:
 	bool init();
 	void reset();
 
-	void write(int a, int v);
-	byte read(int a);
-
-	void writeReg(int r, int v);
 
 	bool isStereo() const { return _type != Config::kOpl2; }
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+
+	void emuWrite(int a, int v);
+	byte emuRead(int a);
+	void emuWriteReg(int r, int v);
 };
 
 } // End of namespace DOSBox
@@ -379,6 +379,13 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     Bit8u reset = 0;
     slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
                  + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+    // A released slot which has faded out stays that way until keyed on:
+    // everything below leaves its state as it is
+    if (!slot->key && slot->eg_gen == envelope_gen_num_release && slot->eg_rout == 0x1ff)
+    {
+        slot->pg_reset = 0;
+        return;
+    }
     if (slot->key && slot->eg_gen == envelope_gen_num_release)
     {
         reset = 1;
@@ -406,6 +413,19 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
         }
     }
     slot->pg_reset = reset;
+    // With a zero rate, a slot in sustain or release keeps its level
+    if (!reset && !reg_rate && slot->eg_gen >= envelope_gen_num_sustain)
+    {
+        if ((slot->eg_rout & 0x1f8) == 0x1f8)
+        {
+            slot->eg_rout = 0x1ff;
+        }
+        if (!slot->key)
+        {
+            slot->eg_gen = envelope_gen_num_release;
+        }
+        return;
+    }
     ks = slot->channel->ksv >> ((slot->reg_ksr ^ 1) << 1);
     nonzero = (reg_rate != 0);
     rate = ks + (reg_rate << 2);
@@ -667,9 +687,35 @@ static void OPL3_SlotWriteE0(opl3_slot *slot, Bit8u data)
     }
 }
 
+static Bit16s OPL3_EnvelopeCalcSilent(Bit16u phase, Bit8u wf)
+{
+    // What the waveform functions return once the attenuation rounds the
+    // sample to zero: only the sign flips of the negative halves remain
+    switch (wf)
+    {
+    case 0:
+    case 6:
+    case 7:
+        return (phase & 0x200) ? -1 : 0;
+    case 4:
+        return ((phase & 0x300) == 0x100) ? -1 : 0;
+    default:
+        return 0;
+    }
+}
+
 static void OPL3_SlotGenerate(opl3_slot *slot)
 {
-    slot->out = envelope_sin[slot->reg_wf](slot->pg_phase_out + *slot->mod, slot->eg_out);
+    Bit16u phase = slot->pg_phase_out + *slot->mod;
+    // From 0xc00 on, OPL3_EnvelopeCalcExp shifts every exprom entry to zero
+    if (slot->eg_out >= 0x180)
+    {
+        slot->out = OPL3_EnvelopeCalcSilent(phase, slot->reg_wf);
+    }
+    else
+    {
+        slot->out = envelope_sin[slot->reg_wf](phase, slot->eg_out);
+    }
 }
 
 static void OPL3_SlotCalcFB(opl3_slot *slot)
@@ -1405,7 +1451,7 @@ void OPL::reset() {
 	OPL3_Reset(&chip, _rate);
 }
 
-void OPL::write(int port, int val) {
+void OPL::emuWrite(int port, int val) {
 	if (port & 1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -1449,7 +1495,7 @@ void OPL::write(int port, int val) {
 }
 
 
-void OPL::writeReg(int r, int v) {
+void OPL::emuWriteReg(int r, int v) {
 	OPL3_WriteRegBuffered(&chip, (Bit16u)r, (Bit8u)v);
 }
 
@@ -1473,7 +1519,7 @@ void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 	OPL3_WriteRegBuffered(&chip, (Bit16u)fullReg, (Bit8u)val);
 }
 
-byte OPL::read(int port) {
+byte OPL::emuRead(int port) {
 	return 0;
 }
 
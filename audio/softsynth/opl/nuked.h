@@ -169,15 +169,15 @@ public:
 	bool init();
 	void reset();
 
-	void write(int a, int v);
-	byte read(int a);
-
-	void writeReg(int r, int v);
 
 	bool isStereo() const { return true; }
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+
+	void emuWrite(int a, int v);
+	byte emuRead(int a);
+	void emuWriteReg(int r, int v);
 };
 
 }
@@ -899,6 +899,24 @@ RESID_INLINE void EnvelopeGenerator::updateClock(cycle_count delta_t) {
 		rate_step += 0x7fff;
 	}
 
+	// While the envelope counter is frozen at zero or at the sustain level,
+	// the steps only run the exponential counter, which the counter period
+	// is already set for. Take them all at once.
+	if (delta_t >= rate_step && exponential_counter < exponential_counter_period &&
+		(hold_zero || (state == DECAY_SUSTAIN && envelope_counter == sustain_level[sustain]))) {
+		delta_t -= rate_step;
+		const cycle_count steps = 1 + delta_t/rate_period;
+		rate_counter = delta_t%rate_period;
+
+		if (state == ATTACK) {
+			exponential_counter = 0;
+		}
+		else {
+			exponential_counter = (exponential_counter + steps)%exponential_counter_period;
+		}
+		return;
+	}
+
 	while (delta_t) {
 		if (delta_t < rate_step) {
 			rate_counter += delta_t;
@@ -0,0 +1,191 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "audio/soundcache.h"
+
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+
+#include "common/atomic.h"
+#include "common/hash-str.h"
+#include "common/memstream.h"
+#include "common/textconsole.h"
+
+namespace Audio {
+
+/** Decoded samples, shared by the cache and the streams playing them */
+struct DecodedSoundCache::Buffer {
+	byte *data;
+	uint32 size;
+	int rate;
+	bool stereo;
+	/** The cache and every stream reading the buffer hold one reference */
+	Common::AtomicInt32 refs;
+
+	Buffer() : data(nullptr), size(0), rate(0), stereo(false) {}
+	~Buffer() { free(data); }
+
+	void incRef() { refs.fetchAdd(1); }
+
+	void decRef() {
+		if (refs.fetchAdd(-1) == 1)
+			delete this;
+	}
+};
+
+/** Reads a shared buffer, and releases it when destroyed */
+class DecodedSoundCache::BufferReadStream : public Common::MemoryReadStream {
+public:
+	BufferReadStream(Buffer *buffer) : Common::MemoryReadStream(buffer->data, buffer->size), _buffer(buffer) {
+		_buffer->incRef();
+	}
+
+	~BufferReadStream() {
+		_buffer->decRef();
+	}
+
+private:
+	Buffer *_buffer;
+};
+
+uint DecodedSoundCache::KeyHash::operator()(const Key &key) const {
+	return Common::hashit(key.archive) ^ (key.id * 2654435761U) ^ (key.format * 40503U);
+}
+
+DecodedSoundCache::DecodedSoundCache(uint32 maxSize) : _size(0), _maxSize(maxSize) {
+}
+
+DecodedSoundCache::~DecodedSoundCache() {
+	clear();
+}
+
+SeekableAudioStream *DecodedSoundCache::find(const Key &key) {
+	EntryMap::iterator entry = _entries.find(key);
+	if (entry == _entries.end())
+		return nullptr;
+
+	// Make it the most recently used sound
+	_lru.erase(entry->_value.lru);
+	_lru.push_back(key);
+	entry->_value.lru = _lru.reverse_begin();
+
+	return makeStream(entry->_value.buffer);
+}
+
+SeekableAudioStream *DecodedSoundCache::insert(const Key &key, AudioStream *source) {
+	if (!source)
+		return nullptr;
+
+	Buffer *buffer = new Buffer();
+	buffer->rate = source->getRate();
+	buffer->stereo = source->isStereo();
+
+	// Decode straight into the buffer, growing it as needed. The reads are
+	// whole frames, so a stereo buffer never ends within one.
+	const int chunkSamples = 4096;
+	uint32 capacity = 0;
+	while (!source->endOfData()) {
+		if (capacity - buffer->size < chunkSamples * sizeof(int16)) {
+			capacity = MAX<uint32>(capacity * 2, chunkSamples * sizeof(int16));
+			buffer->data = (byte *)realloc(buffer->data, capacity);
+			if (!buffer->data)
+				error("DecodedSoundCache::insert(): Out of memory decoding %s:%u", key.archive.c_str(), key.id);
+		}
+
+		const int samples = source->readBuffer((int16 *)(buffer->data + buffer->size), chunkSamples);
+		if (samples <= 0)
+			break;
+		buffer->size += samples * sizeof(int16);
+	}
+	delete source;
+
+	if (buffer->size < capacity && buffer->size != 0) {
+		byte *data = (byte *)realloc(buffer->data, buffer->size);
+		if (data)
+			buffer->data = data;
+	}
+
+	remove(key);
+
+	if (buffer->size <= _maxSize) {
+		shrinkTo(_maxSize - buffer->size);
+
+		_lru.push_back(key);
+		Entry entry;
+		entry.buffer = buffer;
+		entry.lru = _lru.reverse_begin();
+		_entries[key] = entry;
+
+		buffer->incRef();
+		_size += buffer->size;
+	}
+
+	// An uncached buffer is freed together with the stream
+	return makeStream(buffer);
+}
+
+bool DecodedSoundCache::contains(const Key &key) const {
+	return _entries.contains(key);
+}
+
+void DecodedSoundCache::remove(const Key &key) {
+	EntryMap::iterator entry = _entries.find(key);
+	if (entry != _entries.end())
+		dropEntry(entry);
+}
+
+void DecodedSoundCache::clear() {
+	shrinkTo(0);
+}
+
+void DecodedSoundCache::setMaxSize(uint32 maxSize) {
+	_maxSize = maxSize;
+	shrinkTo(maxSize);
+}
+
+SeekableAudioStream *DecodedSoundCache::makeStream(Buffer *buffer) {
+	byte flags = FLAG_16BITS;
+	if (buffer->stereo)
+		flags |= FLAG_STEREO;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= FLAG_LITTLE_ENDIAN;
+#endif
+
+	return makeRawStream(new BufferReadStream(buffer), buffer->rate, flags, DisposeAfterUse::YES);
+}
+
+void DecodedSoundCache::dropEntry(EntryMap::iterator entry) {
+	Buffer *buffer = entry->_value.buffer;
+	_size -= buffer->size;
+	_lru.erase(entry->_value.lru);
+	_entries.erase(entry);
+	buffer->decRef();
+}
+
+void DecodedSoundCache::shrinkTo(uint32 maxSize) {
+	while (_size > maxSize || (maxSize == 0 && !_lru.empty()))
+		dropEntry(_entries.find(_lru.front()));
+}
+
+} // End of namespace Audio
+
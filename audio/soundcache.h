@@ -0,0 +1,146 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_SOUNDCACHE_H
+#define AUDIO_SOUNDCACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+namespace Audio {
+
+class AudioStream;
+class SeekableAudioStream;
+
+/**
+ * A cache of decoded sounds, for short effects which are played again and
+ * again from compressed sources, like footsteps or clicks.
+ *
+ * Sounds are kept as 16-bit samples and handed out as raw streams reading
+ * from the shared decoded buffer, so any number of them can play at once
+ * and be rewound or seeked. When storing a sound would take the cache over
+ * its memory budget, the least recently used sounds are dropped. A dropped
+ * buffer is freed once the last stream reading from it is destroyed.
+ *
+ * The cache itself is meant to be used from one thread, the engine's. The
+ * streams it returns can be played by the mixer and be destroyed on any
+ * thread, also after the cache is gone.
+ *
+ * Usage:
+ * @code
+ * Audio::SeekableAudioStream *stream = cache.find(key);
+ * if (!stream)
+ *     stream = cache.insert(key, makeADPCMStream(...));
+ * @endcode
+ */
+class DecodedSoundCache : Common::NonCopyable {
+public:
+	/** Identifies a sound: the archive it comes from, its resource id and a format tag of the engine's choosing */
+	struct Key {
+		Common::String archive;
+		uint32 id;
+		uint32 format;
+
+		Key() : id(0), format(0) {}
+		Key(const Common::String &a, uint32 i, uint32 f = 0) : archive(a), id(i), format(f) {}
+
+		bool operator==(const Key &other) const {
+			return id == other.id && format == other.format && archive == other.archive;
+		}
+	};
+
+	/**
+	 * @param maxSize The most memory decoded sounds may take, in bytes
+	 */
+	explicit DecodedSoundCache(uint32 maxSize);
+	~DecodedSoundCache();
+
+	/**
+	 * Look up a sound, and make it the most recently used one.
+	 *
+	 * @return A new stream playing the sound from the start, or 0 if it is
+	 *         not in the cache.
+	 */
+	SeekableAudioStream *find(const Key &key);
+
+	/**
+	 * Decode a sound until its end and store it, replacing a sound stored
+	 * with the same key. A sound larger than the whole budget is not stored,
+	 * but still returned. The source must end; looping streams never do.
+	 *
+	 * @param key             The key to store the sound under
+	 * @param source          The stream to decode, which is destroyed afterwards
+	 * @return A new stream playing the decoded sound from the start, or 0 if
+	 *         source is 0
+	 */
+	SeekableAudioStream *insert(const Key &key, AudioStream *source);
+
+	/** Whether a sound is stored, without changing the order sounds are dropped in */
+	bool contains(const Key &key) const;
+
+	/** Drop a sound. Streams already playing it are not affected. */
+	void remove(const Key &key);
+
+	/** Drop all sounds. Streams already playing them are not affected. */
+	void clear();
+
+	/** The memory the stored sounds take, in bytes */
+	uint32 getSize() const { return _size; }
+
+	uint32 getMaxSize() const { return _maxSize; }
+
+	/** Change the memory budget, dropping sounds until they fit into it */
+	void setMaxSize(uint32 maxSize);
+
+private:
+	struct Buffer;
+	class BufferReadStream;
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	typedef Common::List<Key> LRUList;
+
+	struct Entry {
+		Buffer *buffer;
+		LRUList::iterator lru;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	static SeekableAudioStream *makeStream(Buffer *buffer);
+	void dropEntry(EntryMap::iterator entry);
+	void shrinkTo(uint32 maxSize);
+
+	EntryMap _entries;
+	/** The keys of all sounds, the least recently used first */
+	LRUList _lru;
+	uint32 _size;
+	uint32 _maxSize;
+};
+
+} // End of namespace Audio
+
+#endif
@@ -23,7 +23,141 @@
 #include "backends/audiocd/default/default-audiocd.h"
 #include "audio/audiostream.h"
 #include "common/config-manager.h"
+#include "common/stream.h"
 #include "common/system.h"
+#include "common/taskscheduler.h"
+#include "common/textconsole.h"
+
+/**
+ * A track file kept open, with the decoder created for it on a task, and the
+ * samples of the region last looped.
+ */
+struct DefaultAudioCDManager::CachedTrack {
+	/** Samples of a region, recorded by the stream playing it the first time */
+	struct Recording {
+		Audio::Timestamp start, end;
+		bool stereo;
+		int rate;
+		/** Sized for the whole region */
+		Common::Array<int16> samples;
+		uint32 size;
+		bool complete;
+	};
+
+	explicit CachedTrack(int t) : track(t), file(0), factory(0), stream(0), recording(0) {}
+
+	~CachedTrack() {
+		getStream();
+		delete stream;
+		delete file;
+		delete recording;
+	}
+
+	/** The decoder, once the task creating it is done */
+	Audio::SeekableAudioStream *getStream() {
+		if (future.isValid()) {
+			future.wait();
+			future = Common::TaskFuture();
+		}
+		return stream;
+	}
+
+	int track;
+	/** The file, until the task hands it to the decoder */
+	Common::SeekableReadStream *file;
+	Audio::SeekableAudioStream::StreamFileFactory factory;
+	Audio::SeekableAudioStream *stream;
+	Common::TaskFuture future;
+	Recording *recording;
+};
+
+namespace {
+
+/** Creates the decoder of a track, which may read the whole file */
+class OpenTrackTask : public Common::Task {
+public:
+	OpenTrackTask(Audio::SeekableAudioStream *&stream, Common::SeekableReadStream *&file,
+	              Audio::SeekableAudioStream::StreamFileFactory factory) :
+		_stream(stream), _file(file), _factory(factory) {}
+
+	virtual void run() {
+		_stream = _factory(_file, DisposeAfterUse::YES);
+		_file = 0;
+	}
+
+private:
+	Audio::SeekableAudioStream *&_stream;
+	Common::SeekableReadStream *&_file;
+	Audio::SeekableAudioStream::StreamFileFactory _factory;
+};
+
+} // End of anonymous namespace
+
+/**
+ * Plays a region of a track, and records its samples while doing so. Once
+ * the whole region was recorded, rewinding plays from the recording.
+ */
+class DefaultAudioCDManager::RecordingStream : public Audio::RewindableAudioStream {
+public:
+	/**
+	 * @param source    The region, destroyed with this stream, or 0 when the
+	 *                  recording is complete
+	 * @param recording Where to record to, which has to outlive this stream
+	 */
+	RecordingStream(Audio::SeekableAudioStream *source, CachedTrack::Recording &recording) :
+		_source(source, DisposeAfterUse::YES), _recording(recording), _pos(0), _recordable(true) {}
+
+	virtual int readBuffer(int16 *buffer, const int numSamples) {
+		if (_recording.complete) {
+			const int count = MIN<int>(numSamples, _recording.size - _pos);
+			memcpy(buffer, &_recording.samples[_pos], count * sizeof(int16));
+			_pos += count;
+			return count;
+		}
+
+		const int count = _source->readBuffer(buffer, numSamples);
+		if (count > 0 && _recordable) {
+			if (_recording.size + count <= _recording.samples.size()) {
+				memcpy(&_recording.samples[_recording.size], buffer, count * sizeof(int16));
+				_recording.size += count;
+			} else {
+				// Longer than the region should be, so a leftover of the codec
+				_recordable = false;
+			}
+		}
+		return count;
+	}
+
+	virtual bool isStereo() const { return _recording.stereo; }
+	virtual int getRate() const { return _recording.rate; }
+
+	virtual bool endOfData() const {
+		return _recording.complete ? _pos >= _recording.size : _source->endOfData();
+	}
+
+	virtual bool endOfStream() const {
+		return _recording.complete ? _pos >= _recording.size : _source->endOfStream();
+	}
+
+	virtual bool rewind() {
+		if (!_recording.complete && _recordable && _source->endOfStream())
+			_recording.complete = true;
+
+		_pos = 0;
+		if (_recording.complete)
+			return true;
+
+		_recording.size = 0;
+		_recordable = true;
+		return _source->rewind();
+	}
+
+private:
+	Common::DisposablePtr<Audio::SeekableAudioStream> _source;
+	CachedTrack::Recording &_recording;
+	uint32 _pos;
+	bool _recordable;
+};
 
 DefaultAudioCDManager::DefaultAudioCDManager() {
 	_cd.playing = false;
@@ -52,6 +186,7 @@ bool DefaultAudioCDManager::open() {
 void DefaultAudioCDManager::close() {
 	// Only need to stop for emulation
 	stop();
+	clearTrackCache();
 }
 
 bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int duration, bool onlyEmulate,
@@ -67,26 +202,58 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 		// Try to load the track from a compressed data file, and if found, use
 		// that. If not found, attempt to start regular Audio CD playback of
 		// the requested track.
-		char trackName[2][16];
-		sprintf(trackName[0], "track%d", track);
-		sprintf(trackName[1], "track%02d", track);
-		Audio::SeekableAudioStream *stream = 0;
-
-		for (int i = 0; !stream && i < 2; ++i)
-			stream = Audio::SeekableAudioStream::openStreamFile(trackName[i]);
+		CachedTrack *cached = openTrack(track);
+		Audio::SeekableAudioStream *stream = cached ? cached->getStream() : 0;
 
 		if (stream != 0) {
 			Audio::Timestamp start = Audio::Timestamp(0, startFrame, 75);
 			Audio::Timestamp end = duration ? Audio::Timestamp(0, startFrame + duration, 75) : stream->getLength();
 
+			if (start >= end) {
+				warning("DefaultAudioCDManager::play: start (%d) >= end (%d)", start.msecs(), end.msecs());
+				return false;
+			}
+
 			/*
 			FIXME: Seems numLoops == 0 and numLoops == 1 both indicate a single repetition,
 			while all other positive numbers indicate precisely the number of desired
 			repetitions. Finally, -1 means infinitely many
 			*/
+			const uint loops = (numLoops < 1) ? numLoops + 1 : numLoops;
+
+			// The decoder stays with the cached track, to play it again
+			Audio::AudioStream *playing;
+			if (loops != 1 && (end - start).msecs() <= (int)kMaxRecordedSeconds * 1000) {
+				CachedTrack::Recording *recording = cached->recording;
+				if (!recording || recording->start != start || recording->end != end) {
+					delete recording;
+					recording = cached->recording = new CachedTrack::Recording();
+					recording->start = start;
+					recording->end = end;
+					recording->stereo = stream->isStereo();
+					recording->rate = stream->getRate();
+					const int channels = recording->stereo ? 2 : 1;
+					recording->samples.resize((end - start).convertToFramerate(recording->rate).totalNumberOfFrames() * channels + channels);
+					recording->size = 0;
+					recording->complete = false;
+				}
+
+				Audio::SeekableAudioStream *region = 0;
+				if (!recording->complete)
+					region = new Audio::SubSeekableAudioStream(stream, start, end, DisposeAfterUse::NO);
+				playing = Audio::makeLoopingAudioStream(new RecordingStream(region, *recording), loops);
+			} else {
+				playing = Audio::makeLoopingAudioStream(new Audio::SubSeekableAudioStream(stream, start, end, DisposeAfterUse::NO), loops);
+			}
+
 			_emulating = true;
-			_mixer->playStream(soundType, &_handle,
-			                        Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops), -1, _cd.volume, _cd.balance);
+			_mixer->playStream(soundType, &_handle, playing, -1, _cd.volume, _cd.balance);
+
+			// The next track is the most likely to be played next. Without
+			// worker threads, opening it would only hold up this one.
+			if (!g_system->getTaskScheduler()->isSerial())
+				openTrack(track + 1, true);
+
 			return true;
 		}
 	}
@@ -94,6 +261,53 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 	return false;
 }
 
+DefaultAudioCDManager::CachedTrack *DefaultAudioCDManager::openTrack(int track, bool prefetch) {
+	for (uint i = 0; i < _tracks.size(); ++i) {
+		CachedTrack *cached = _tracks[i];
+		if (cached->track != track)
+			continue;
+
+		if (!prefetch) {
+			_tracks.remove_at(i);
+			_tracks.insert_at(0, cached);
+		}
+		return cached;
+	}
+
+	char trackName[2][16];
+	sprintf(trackName[0], "track%d", track);
+	sprintf(trackName[1], "track%02d", track);
+
+	Audio::SeekableAudioStream::StreamFileFactory factory = 0;
+	Common::SeekableReadStream *file = 0;
+	for (int i = 0; !file && i < 2; ++i)
+		file = Audio::SeekableAudioStream::findStreamFile(trackName[i], factory);
+
+	if (!file)
+		return 0;
+
+	// Some decoders read the whole file to find its length
+	CachedTrack *cached = new CachedTrack(track);
+	cached->file = file;
+	cached->factory = factory;
+	cached->future = g_system->getTaskScheduler()->schedule(new OpenTrackTask(cached->stream, cached->file, factory));
+
+	// A prefetched track goes after the one playing
+	_tracks.insert_at(prefetch && !_tracks.empty() ? 1 : 0, cached);
+	while (_tracks.size() > kMaxCachedTracks) {
+		delete _tracks.back();
+		_tracks.pop_back();
+	}
+
+	return cached;
+}
+
+void DefaultAudioCDManager::clearTrackCache() {
+	for (uint i = 0; i < _tracks.size(); ++i)
+		delete _tracks[i];
+	_tracks.clear();
+}
+
 void DefaultAudioCDManager::stop() {
 	if (_emulating) {
 		// Audio CD emulation
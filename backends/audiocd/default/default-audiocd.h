@@ -25,6 +25,7 @@
 
 #include "backends/audiocd/audiocd.h"
 #include "audio/mixer.h"
+#include "common/array.h"
 
 namespace Common {
 class String;
@@ -32,6 +33,13 @@ class String;
 
 /**
  * The default audio cd manager. Implements emulation of audio cd playback.
+ *
+ * The last few tracks played are kept open, and the track after the one
+ * played is opened ahead on a worker of the task scheduler, where its
+ * decoder scans the file, so playing them again or next starts right away.
+ * When a short region of a track is looped, the samples of its first pass
+ * are kept, and the further passes, and playing the region again, read from
+ * memory instead of seeking and decoding the file.
  */
 class DefaultAudioCDManager : public AudioCDManager {
 public:
@@ -72,6 +80,30 @@ protected:
 	Audio::SoundHandle _handle;
 	bool _emulating;
 
+	struct CachedTrack;
+	class RecordingStream;
+
+	/** The most tracks kept open */
+	static const uint kMaxCachedTracks = 4;
+	/** The longest region whose samples are kept when it loops, in seconds */
+	static const uint kMaxRecordedSeconds = 20;
+
+	/** The tracks kept open, the most recently played first */
+	Common::Array<CachedTrack *> _tracks;
+
+	/**
+	 * The cached track of a number, opening its file and scheduling the
+	 * creation of its decoder when it is not cached yet. The least recently
+	 * played tracks are dropped from the cache beyond kMaxCachedTracks.
+	 *
+	 * @param track    The number of the track
+	 * @param prefetch Whether the track is only opened ahead, which leaves the
+	 *                 track played last the most recent
+	 * @return The track, or 0 when there is no file for it
+	 */
+	CachedTrack *openTrack(int track, bool prefetch = false);
+	void clearTrackCache();
+
 	Status _cd;
 	Audio::Mixer *_mixer;
 };
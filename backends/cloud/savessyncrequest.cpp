@@ -44,6 +44,7 @@ SavesSyncRequest::~SavesSyncRequest() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
+	finishDownloads();
 	delete _boolCallback;
 }
 
@@ -52,7 +53,7 @@ void SavesSyncRequest::start() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
-	_currentDownloadingFile = StorageFile();
+	finishDownloads();
 	_currentUploadingFile = "";
 	_filesToDownload.clear();
 	_filesToUpload.clear();
@@ -160,7 +161,7 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 
 	//start downloading files
 	if (!_filesToDownload.empty()) {
-		downloadNextFile();
+		downloadNextFiles();
 	} else {
 		uploadNextFile();
 	}
@@ -267,54 +268,78 @@ void SavesSyncRequest::directoryCreatedErrorCallback(Networking::ErrorResponse e
 	finishError(error);
 }
 
-void SavesSyncRequest::downloadNextFile() {
-	if (_filesToDownload.empty()) {
-		_currentDownloadingFile = StorageFile("", 0, 0, false); //so getFilesToDownload() would return an empty array
+void SavesSyncRequest::downloadNextFiles() {
+	if (_filesToDownload.empty() && _currentDownloads.empty()) {
 		sendCommand(GUI::kSavesSyncEndedCmd, 0);
 		uploadNextFile();
 		return;
 	}
 
-	_currentDownloadingFile = _filesToDownload.back();
-	_filesToDownload.pop_back();
+	//saves are small, so several are downloaded at once to not wait for each round trip
+	while (!_filesToDownload.empty() && _currentDownloads.size() < MAX_PARALLEL_DOWNLOADS) {
+		StorageFile file = _filesToDownload.back();
+		_filesToDownload.pop_back();
+
+		debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", file.name().c_str(), (int)(getProgress() * 100));
+		Request *request = _storage->downloadById(
+			file.id(),
+			DefaultSaveFileManager::concatWithSavesPath(file.name()),
+			new Common::Callback<SavesSyncRequest, Storage::BoolResponse>(this, &SavesSyncRequest::fileDownloadedCallback),
+			new Common::Callback<SavesSyncRequest, Networking::ErrorResponse>(this, &SavesSyncRequest::fileDownloadedErrorCallback)
+		);
+		if (!request) {
+			finishError(Networking::ErrorResponse(this, "SavesSyncRequest::downloadNextFiles: Storage couldn't create Request to download a file"));
+			return;
+		}
+		_currentDownloads.push_back(DownloadingFile(request, file));
+	}
 
 	sendCommand(GUI::kSavesSyncProgressCmd, (int)(getDownloadingProgress() * 100));
+}
 
-	debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", _currentDownloadingFile.name().c_str(), (int)(getProgress() * 100));
-	_workingRequest = _storage->downloadById(
-		_currentDownloadingFile.id(),
-		DefaultSaveFileManager::concatWithSavesPath(_currentDownloadingFile.name()),
-		new Common::Callback<SavesSyncRequest, Storage::BoolResponse>(this, &SavesSyncRequest::fileDownloadedCallback),
-		new Common::Callback<SavesSyncRequest, Networking::ErrorResponse>(this, &SavesSyncRequest::fileDownloadedErrorCallback)
-	);
-	if (!_workingRequest)
-		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::downloadNextFile: Storage couldn't create Request to download a file"));
+void SavesSyncRequest::finishDownloads() {
+	//the downloads' callbacks are ignored, as we're the one who interrupts them
+	bool ignoreCallback = _ignoreCallback;
+	_ignoreCallback = true;
+	for (uint32 i = 0; i < _currentDownloads.size(); ++i) {
+		if (_currentDownloads[i].request->state() != Networking::FINISHED)
+			_currentDownloads[i].request->finish();
+	}
+	_currentDownloads.clear();
+	_ignoreCallback = ignoreCallback;
 }
 
 void SavesSyncRequest::fileDownloadedCallback(Storage::BoolResponse response) {
-	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
 
+	StorageFile file;
+	for (uint32 i = 0; i < _currentDownloads.size(); ++i) {
+		if (_currentDownloads[i].request == response.request) {
+			file = _currentDownloads[i].file;
+			_currentDownloads.remove_at(i);
+			break;
+		}
+	}
+
 	//stop syncing if download failed
 	if (!response.value) {
 		//delete the incomplete file
-		g_system->getSavefileManager()->removeSavefile(_currentDownloadingFile.name());
+		g_system->getSavefileManager()->removeSavefile(file.name());
 		finishError(Networking::ErrorResponse(this, false, true, "SavesSyncRequest::fileDownloadedCallback: failed to download a file", -1));
 		return;
 	}
 
 	//update local timestamp for downloaded file
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
-	_localFilesTimestamps[_currentDownloadingFile.name()] = _currentDownloadingFile.timestamp();
+	_localFilesTimestamps[file.name()] = file.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
 
 	//continue downloading files
-	downloadNextFile();
+	downloadNextFiles();
 }
 
 void SavesSyncRequest::fileDownloadedErrorCallback(Networking::ErrorResponse error) {
-	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
 
@@ -388,7 +413,7 @@ double SavesSyncRequest::getDownloadingProgress() const {
 		return 1; //nothing to download => download complete
 
 	uint32 totalFilesToDownload = _totalFilesToHandle - _filesToUpload.size();
-	uint32 filesLeftToDownload = _filesToDownload.size() + (_currentDownloadingFile.name() != "" ? 1 : 0);
+	uint32 filesLeftToDownload = _filesToDownload.size() + _currentDownloads.size();
 	return (double)(totalFilesToDownload - filesLeftToDownload) / (double)(totalFilesToDownload);
 }
 
@@ -399,23 +424,25 @@ double SavesSyncRequest::getProgress() const {
 		return 0; //directory not listed yet
 	}
 
-	return (double)(_totalFilesToHandle - _filesToDownload.size() - _filesToUpload.size()) / (double)(_totalFilesToHandle);
+	return (double)(_totalFilesToHandle - _filesToDownload.size() - _currentDownloads.size() - _filesToUpload.size()) / (double)(_totalFilesToHandle);
 }
 
 Common::Array<Common::String> SavesSyncRequest::getFilesToDownload() {
 	Common::Array<Common::String> result;
 	for (uint32 i = 0; i < _filesToDownload.size(); ++i)
 		result.push_back(_filesToDownload[i].name());
-	if (_currentDownloadingFile.name() != "")
-		result.push_back(_currentDownloadingFile.name());
+	for (uint32 i = 0; i < _currentDownloads.size(); ++i)
+		result.push_back(_currentDownloads[i].file.name());
 	return result;
 }
 
 void SavesSyncRequest::finishError(Networking::ErrorResponse error) {
 	debug(9, "SavesSync::finishError");
-	//if we were downloading a file - remember the name
-	//and make the Request close() it, so we can delete it
-	Common::String name = _currentDownloadingFile.name();
+	//if we were downloading files - remember the names
+	//and make the Requests close() them, so we can delete them
+	Common::Array<Common::String> names;
+	for (uint32 i = 0; i < _currentDownloads.size(); ++i)
+		names.push_back(_currentDownloads[i].file.name());
 	if (_workingRequest) {
 		_ignoreCallback = true;
 		_workingRequest->finish();
@@ -423,11 +450,11 @@ void SavesSyncRequest::finishError(Networking::ErrorResponse error) {
 		_ignoreCallback = false;
 	}
 	//unlock all the files by making getFilesToDownload() return empty array
-	_currentDownloadingFile = StorageFile();
+	finishDownloads();
 	_filesToDownload.clear();
-	//delete the incomplete file
-	if (name != "")
-		g_system->getSavefileManager()->removeSavefile(name);
+	//delete the incomplete files
+	for (uint32 i = 0; i < names.size(); ++i)
+		g_system->getSavefileManager()->removeSavefile(names[i]);
 	Request::finishError(error);
 }
 
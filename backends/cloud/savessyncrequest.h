@@ -32,12 +32,22 @@
 namespace Cloud {
 
 class SavesSyncRequest: public Networking::Request, public GUI::CommandSender {
+	static const uint32 MAX_PARALLEL_DOWNLOADS = 4;
+
+	/** A file being downloaded, with the Request downloading it. */
+	struct DownloadingFile {
+		Request *request;
+		StorageFile file;
+
+		DownloadingFile(Request *rq = nullptr, const StorageFile &f = StorageFile()): request(rq), file(f) {}
+	};
+
 	Storage *_storage;
 	Storage::BoolCallback _boolCallback;
 	Common::HashMap<Common::String, uint32> _localFilesTimestamps;
 	Common::Array<StorageFile> _filesToDownload;
 	Common::Array<Common::String> _filesToUpload;
-	StorageFile _currentDownloadingFile;
+	Common::Array<DownloadingFile> _currentDownloads;
 	Common::String _currentUploadingFile;
 	Request *_workingRequest;
 	bool _ignoreCallback;
@@ -53,7 +63,8 @@ class SavesSyncRequest: public Networking::Request, public GUI::CommandSender {
 	void fileDownloadedErrorCallback(Networking::ErrorResponse error);
 	void fileUploadedCallback(Storage::UploadResponse response);
 	void fileUploadedErrorCallback(Networking::ErrorResponse error);
-	void downloadNextFile();
+	void downloadNextFiles();
+	void finishDownloads();
 	void uploadNextFile();
 	virtual void finishError(Networking::ErrorResponse error);
 	void finishSync(bool success);
@@ -26,6 +26,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/keymapper.h"
@@ -85,6 +86,7 @@ void DefaultEventManager::init() {
 }
 
 bool DefaultEventManager::pollEvent(Common::Event &event) {
+	PROFILE_ZONE("EventManager::pollEvent");
 	_dispatcher.dispatch();
 
 	if (_shouldGenerateKeyRepeatEvents) {
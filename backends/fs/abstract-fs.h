@@ -173,6 +173,12 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time the object referred by this path was last modified,
+	 * in seconds since the Unix epoch. Backends which can not tell return 0.
+	 */
+	virtual uint32 getModificationTime() const { return 0; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -183,6 +189,15 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance which may map the file into
+	 * memory, see Common::FSNode::createMappedReadStream(). By default the
+	 * file is read like with createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -70,6 +70,10 @@ bool ChRootFilesystemNode::isWritable() const {
 	return _realNode->isWritable();
 }
 
+uint32 ChRootFilesystemNode::getModificationTime() const {
+	return _realNode->getModificationTime();
+}
+
 AbstractFSNode *ChRootFilesystemNode::getChild(const Common::String &n) const {
 	return new ChRootFilesystemNode(_root, (POSIXFilesystemNode *)_realNode->getChild(n));
 }
@@ -96,6 +100,10 @@ Common::SeekableReadStream *ChRootFilesystemNode::createReadStream() {
 	return _realNode->createReadStream();
 }
 
+Common::SeekableReadStream *ChRootFilesystemNode::createMappedReadStream() {
+	return _realNode->createMappedReadStream();
+}
+
 Common::WriteStream *ChRootFilesystemNode::createWriteStream() {
 	return _realNode->createWriteStream();
 }
@@ -29,12 +29,14 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit		//Needed for IRIX's unistd.h
 
 #include "backends/fs/libretro/libretro-fs.h"
+#include "backends/fs/libretro/libretro-vfs.h"
 #include "backends/fs/stdiostream.h"
 #include "common/algorithm.h"
 
 #include "../../platform/libretro/libretro-common/include/retro_dirent.h"
 #include "../../platform/libretro/libretro-common/include/retro_stat.h"
 #include "../../platform/libretro/libretro-common/include/file/file_path.h"
+#include "../../platform/libretro/libretro.h"
 #include <stdio.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -42,10 +44,34 @@
 void LibRetroFilesystemNode::setFlags() {
 	const char *fspath = _path.c_str();
 
+	struct retro_vfs_interface *vfs = LibRetroVFS::getInterface(3);
+	if (vfs) {
+		const int flags = vfs->stat(fspath, nullptr);
+		_isValid     = (flags & RETRO_VFS_STAT_IS_VALID) != 0;
+		_isDirectory = (flags & RETRO_VFS_STAT_IS_DIRECTORY) != 0;
+		return;
+	}
+
 	_isValid     = path_is_valid(fspath);
 	_isDirectory = path_is_directory(fspath);
 }
 
+bool LibRetroFilesystemNode::exists() const {
+	struct retro_vfs_interface *vfs = LibRetroVFS::getInterface(3);
+	if (vfs)
+		return (vfs->stat(_path.c_str(), nullptr) & RETRO_VFS_STAT_IS_VALID) != 0;
+
+	return access(_path.c_str(), F_OK) == 0;
+}
+
+bool LibRetroFilesystemNode::isReadable() const {
+	// The VFS has no permission checks, anything it can stat it can open
+	if (LibRetroVFS::getInterface(3))
+		return exists();
+
+	return access(_path.c_str(), R_OK) == 0;
+}
+
 LibRetroFilesystemNode::LibRetroFilesystemNode(const Common::String &p) {
 	assert(p.size() > 0);
 
@@ -89,6 +115,10 @@ AbstractFSNode *LibRetroFilesystemNode::getChild(const Common::String &n) const
 bool LibRetroFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
 	assert(_isDirectory);
 
+	struct retro_vfs_interface *vfs = LibRetroVFS::getInterface(3);
+	if (vfs)
+		return getChildrenVFS(vfs, myList, mode, hidden);
+
 	struct RDIR *dirp = retro_opendir(_path.c_str());
 
 	if (dirp == NULL)
@@ -134,6 +164,48 @@ bool LibRetroFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode,
 	return true;
 }
 
+bool LibRetroFilesystemNode::getChildrenVFS(struct retro_vfs_interface *vfs, AbstractFSList &myList, ListMode mode, bool hidden) const {
+	struct retro_vfs_dir_handle *dirp = vfs->opendir(_path.c_str(), hidden);
+
+	if (dirp == NULL)
+		return false;
+
+	while (vfs->readdir(dirp)) {
+		const char *d_name = vfs->dirent_get_name(dirp);
+		if (!d_name)
+			continue;
+
+		// Skip 'invisible' files if necessary
+		if (d_name[0] == '.' && !hidden) {
+			continue;
+		}
+		// Skip '.' and '..' to avoid cycles
+		if ((d_name[0] == '.' && d_name[1] == 0) || (d_name[0] == '.' && d_name[1] == '.')) {
+			continue;
+		}
+
+		// Start with a clone of this node, with the correct path set
+		LibRetroFilesystemNode entry(*this);
+		entry._displayName = d_name;
+		if (_path.lastChar() != '/')
+			entry._path += '/';
+		entry._path += entry._displayName;
+
+		entry._isValid     = true;
+		entry._isDirectory = vfs->dirent_is_dir(dirp);
+
+		// Honor the chosen mode
+		if ((mode == Common::FSNode::kListFilesOnly && entry._isDirectory) ||
+		    (mode == Common::FSNode::kListDirectoriesOnly && !entry._isDirectory))
+			continue;
+
+		myList.push_back(new LibRetroFilesystemNode(entry));
+	}
+	vfs->closedir(dirp);
+
+	return true;
+}
+
 AbstractFSNode *LibRetroFilesystemNode::getParent() const {
 	if (_path == "/")
 		return 0;	// The filesystem root has no parent
@@ -154,15 +226,24 @@ AbstractFSNode *LibRetroFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *LibRetroFilesystemNode::createReadStream() {
+	if (LibRetroVFS::getInterface(1))
+		return LibRetroVFSStream::makeFromPath(getPath(), false);
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
 Common::WriteStream *LibRetroFilesystemNode::createWriteStream() {
+	if (LibRetroVFS::getInterface(1))
+		return LibRetroVFSStream::makeFromPath(getPath(), true);
 	return StdioStream::makeFromPath(getPath(), true);
 }
 
 bool LibRetroFilesystemNode::createDirectory() {
-	if (mkdir_norecurse(_path.c_str()))
+	struct retro_vfs_interface *vfs = LibRetroVFS::getInterface(3);
+	if (vfs) {
+		// -2 means the directory already exists
+		if (vfs->mkdir(_path.c_str()) != -1)
+			setFlags();
+	} else if (mkdir_norecurse(_path.c_str()))
 		setFlags();
 
 	return _isValid && _isDirectory;
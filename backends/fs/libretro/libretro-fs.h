@@ -59,6 +59,8 @@ static inline char *getenv(const char *name)
 }
 #endif
 
+struct retro_vfs_interface;
+
 /**
  * Implementation of the ScummVM file system API based on LibRetro.
  *
@@ -88,12 +90,12 @@ public:
 	 */
 	LibRetroFilesystemNode(const Common::String &path);
 
-	virtual bool exists() const { return access(_path.c_str(), F_OK) == 0; }
+	virtual bool exists() const;
 	virtual Common::String getDisplayName() const { return _displayName; }
 	virtual Common::String getName() const { return _displayName; }
 	virtual Common::String getPath() const { return _path; }
 	virtual bool isDirectory() const { return _isDirectory; }
-	virtual bool isReadable() const { return access(_path.c_str(), R_OK) == 0; }
+	virtual bool isReadable() const;
 	virtual bool isWritable() const { return access(_path.c_str(), W_OK) == 0; }
 
 	virtual AbstractFSNode *getChild(const Common::String &n) const;
@@ -109,6 +111,11 @@ private:
 	 * Tests and sets the _isValid and _isDirectory flags, using the stat() function.
 	 */
 	virtual void setFlags();
+
+	/**
+	 * Lists the directory through the frontend VFS.
+	 */
+	bool getChildrenVFS(struct retro_vfs_interface *vfs, AbstractFSList &list, ListMode mode, bool hidden) const;
 };
 
 namespace Posix {
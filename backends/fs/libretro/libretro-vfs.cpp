@@ -0,0 +1,208 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if defined(__LIBRETRO__)
+
+#include "backends/fs/libretro/libretro-vfs.h"
+#include "common/util.h"
+
+#include "../../platform/libretro/libretro.h"
+
+namespace LibRetroVFS {
+
+static struct retro_vfs_interface *s_vfs = NULL;
+static uint32 s_version = 0;
+
+void setInterface(struct retro_vfs_interface *vfs, uint32 version) {
+	s_vfs = vfs;
+	s_version = vfs ? version : 0;
+}
+
+struct retro_vfs_interface *getInterface(uint32 minVersion) {
+	return (s_version >= minVersion) ? s_vfs : NULL;
+}
+
+} // End of namespace LibRetroVFS
+
+using LibRetroVFS::s_vfs;
+
+LibRetroVFSStream::LibRetroVFSStream(struct retro_vfs_file_handle *handle, bool writeMode) :
+	_handle(handle), _buffer(nullptr), _bufferSize(0), _bufferPos(0), _filePos(0),
+	_size(-1), _eos(false), _err(false) {
+	assert(handle);
+
+	if (!writeMode) {
+		_buffer = (byte *)malloc(kReadAheadSize);
+		_size = (int32)s_vfs->size(_handle);
+	}
+}
+
+LibRetroVFSStream::~LibRetroVFSStream() {
+	s_vfs->close(_handle);
+	free(_buffer);
+}
+
+void LibRetroVFSStream::dropBuffer() {
+	_bufferSize = 0;
+	_bufferPos = 0;
+}
+
+bool LibRetroVFSStream::err() const {
+	return _err;
+}
+
+void LibRetroVFSStream::clearErr() {
+	_eos = false;
+	_err = false;
+}
+
+bool LibRetroVFSStream::eos() const {
+	return _eos;
+}
+
+int32 LibRetroVFSStream::pos() const {
+	if (!_buffer)
+		return (int32)s_vfs->tell(_handle);
+
+	return (int32)(_filePos - (_bufferSize - _bufferPos));
+}
+
+int32 LibRetroVFSStream::size() const {
+	if (!_buffer)
+		return (int32)s_vfs->size(_handle);
+
+	return _size;
+}
+
+bool LibRetroVFSStream::seek(int32 offs, int whence) {
+	if (!_buffer) {
+		if (s_vfs->seek(_handle, offs, whence) < 0)
+			return false;
+		_eos = false;
+		return true;
+	}
+
+	int64 target;
+	switch (whence) {
+	case SEEK_CUR:
+		target = pos() + (int64)offs;
+		break;
+	case SEEK_END:
+		target = _size + (int64)offs;
+		break;
+	case SEEK_SET:
+	default:
+		target = offs;
+		break;
+	}
+
+	if (target < 0)
+		return false;
+
+	// Seeks inside the read-ahead window are free
+	const int64 bufferStart = _filePos - _bufferSize;
+	if (target >= bufferStart && target <= _filePos) {
+		_bufferPos = (uint32)(target - bufferStart);
+	} else {
+		if (s_vfs->seek(_handle, target, RETRO_VFS_SEEK_POSITION_START) < 0) {
+			_err = true;
+			return false;
+		}
+		_filePos = target;
+		dropBuffer();
+	}
+
+	_eos = false;
+	return true;
+}
+
+uint32 LibRetroVFSStream::read(void *ptr, uint32 len) {
+	assert(_buffer);
+
+	byte *out = (byte *)ptr;
+	uint32 total = 0;
+
+	while (len > 0) {
+		if (_bufferPos == _bufferSize) {
+			// Large reads bypass the buffer, small ones refill it
+			const bool direct = len >= kReadAheadSize;
+			const int64 result = s_vfs->read(_handle, direct ? out : _buffer, direct ? len : (uint32)kReadAheadSize);
+			dropBuffer();
+
+			if (result < 0) {
+				_err = true;
+				break;
+			}
+			if (result == 0) {
+				_eos = true;
+				break;
+			}
+
+			_filePos += result;
+			if (direct) {
+				total += (uint32)result;
+				out += result;
+				len -= (uint32)result;
+				continue;
+			}
+			_bufferSize = (uint32)result;
+		}
+
+		const uint32 count = MIN(len, _bufferSize - _bufferPos);
+		memcpy(out, _buffer + _bufferPos, count);
+		_bufferPos += count;
+		total += count;
+		out += count;
+		len -= count;
+	}
+
+	return total;
+}
+
+uint32 LibRetroVFSStream::write(const void *ptr, uint32 len) {
+	assert(!_buffer);
+
+	const int64 result = s_vfs->write(_handle, ptr, len);
+	if (result < 0) {
+		_err = true;
+		return 0;
+	}
+	return (uint32)result;
+}
+
+bool LibRetroVFSStream::flush() {
+	return _buffer || s_vfs->flush(_handle) == 0;
+}
+
+LibRetroVFSStream *LibRetroVFSStream::makeFromPath(const Common::String &path, bool writeMode) {
+	if (!s_vfs)
+		return nullptr;
+
+	const unsigned mode = writeMode ? RETRO_VFS_FILE_ACCESS_WRITE : RETRO_VFS_FILE_ACCESS_READ;
+	struct retro_vfs_file_handle *handle = s_vfs->open(path.c_str(), mode, RETRO_VFS_FILE_ACCESS_HINT_NONE);
+
+	if (handle)
+		return new LibRetroVFSStream(handle, writeMode);
+	return nullptr;
+}
+
+#endif
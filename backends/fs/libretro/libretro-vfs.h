@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_FS_LIBRETRO_VFS_H
+#define BACKENDS_FS_LIBRETRO_VFS_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/stream.h"
+#include "common/str.h"
+
+struct retro_vfs_interface;
+struct retro_vfs_file_handle;
+
+namespace LibRetroVFS {
+
+/**
+ * Install the VFS interface provided by the frontend. Until this is called,
+ * or if the frontend has none, file access goes through stdio.
+ *
+ * @param vfs		the interface, or NULL
+ * @param version	the interface version the frontend reported
+ */
+void setInterface(struct retro_vfs_interface *vfs, uint32 version);
+
+/**
+ * Get the frontend VFS interface, if it is at least the given version.
+ * Version 1 covers file streams, version 3 adds stat and directory listing.
+ */
+struct retro_vfs_interface *getInterface(uint32 minVersion);
+
+} // End of namespace LibRetroVFS
+
+/**
+ * Stream on a file of the frontend VFS. Reads go through a large read-ahead
+ * buffer, so the many small reads of game detection and startup turn into a
+ * few big requests.
+ */
+class LibRetroVFSStream : public Common::SeekableReadStream, public Common::SeekableWriteStream, public Common::NonCopyable {
+protected:
+	enum {
+		kReadAheadSize = 64 * 1024
+	};
+
+	/** VFS handle to the actual file. */
+	struct retro_vfs_file_handle *_handle;
+
+	/** Read-ahead buffer, NULL for write streams. */
+	byte *_buffer;
+	/** Number of valid bytes in _buffer. */
+	uint32 _bufferSize;
+	/** Read position inside _buffer. */
+	uint32 _bufferPos;
+	/** File position of the VFS handle, i.e. just past the buffered data. */
+	int64 _filePos;
+
+	int32 _size;
+	bool _eos;
+	bool _err;
+
+	void dropBuffer();
+
+public:
+	/**
+	 * Given a path, opens it through the frontend VFS and wraps the result
+	 * in a LibRetroVFSStream instance.
+	 */
+	static LibRetroVFSStream *makeFromPath(const Common::String &path, bool writeMode);
+
+	LibRetroVFSStream(struct retro_vfs_file_handle *handle, bool writeMode);
+	virtual ~LibRetroVFSStream();
+
+	virtual bool err() const override;
+	virtual void clearErr() override;
+	virtual bool eos() const override;
+
+	virtual uint32 write(const void *dataPtr, uint32 dataSize) override;
+	virtual bool flush() override;
+
+	virtual int32 pos() const override;
+	virtual int32 size() const override;
+	virtual bool seek(int32 offs, int whence = SEEK_SET) override;
+	virtual uint32 read(void *dataPtr, uint32 dataSize) override;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use the native file APIs
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/mmapstream.h"
+
+#if defined(DISABLE_MMAP_FILESTREAM)
+// Always fall back to StdioStream
+#elif defined(WIN32) && !defined(_WIN32_WCE)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define USE_WIN32_MMAP
+#elif defined(POSIX)
+#include <unistd.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define USE_POSIX_MMAP
+#endif
+#endif
+
+// Keep 32-bit hosts from running out of address space on huge data files
+static const uint64 kMaxMapSize = sizeof(void *) < 8 ? 256 * 1024 * 1024 : 0x7FFFFFFF;
+
+MmapStream::MmapStream(const byte *mapping, uint32 size)
+	: Common::MemoryReadStream(mapping, size), _mapping(mapping), _mappingSize(size) {
+}
+
+MmapStream::~MmapStream() {
+#if defined(USE_WIN32_MMAP)
+	UnmapViewOfFile(_mapping);
+#elif defined(USE_POSIX_MMAP)
+	munmap(const_cast<byte *>(_mapping), _mappingSize);
+#endif
+}
+
+MmapStream *MmapStream::makeFromPath(const Common::String &path) {
+#if defined(USE_WIN32_MMAP)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+	                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < kMinMapSize || (uint64)size.QuadPart > kMaxMapSize) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// The view keeps the mapping and the file open until it is unmapped
+	HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return nullptr;
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data)
+		return nullptr;
+
+	return new MmapStream((const byte *)data, (uint32)size.QuadPart);
+#elif defined(USE_POSIX_MMAP)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < kMinMapSize || (uint64)st.st_size > kMaxMapSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	return new MmapStream((const byte *)data, (uint32)st.st_size);
+#else
+	return nullptr;
+#endif
+}
@@ -0,0 +1,59 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_FS_MMAPSTREAM_H
+#define BACKENDS_FS_MMAPSTREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+/**
+ * A read stream over a file mapped into memory, so its contents can be
+ * borrowed through getDataPointer() instead of being copied.
+ */
+class MmapStream : public Common::MemoryReadStream, public Common::NonCopyable {
+protected:
+	/** Files smaller than this are cheaper to read through stdio. */
+	static const uint32 kMinMapSize = 64 * 1024;
+
+	const byte *_mapping;
+	uint32 _mappingSize;
+
+	MmapStream(const byte *mapping, uint32 size);
+
+public:
+	/**
+	 * Given a path, maps the file at that path into memory and wraps the
+	 * mapping in a MmapStream instance.
+	 *
+	 * @return the new stream, or nullptr if the file can not or should not
+	 *         be mapped, in which case callers should fall back to
+	 *         StdioStream
+	 */
+	static MmapStream *makeFromPath(const Common::String &path);
+
+	virtual ~MmapStream();
+};
+
+#endif
@@ -33,6 +33,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_srandom
 
 #include "backends/fs/posix/posix-fs.h"
+#include "backends/fs/mmapstream.h"
 #include "backends/fs/stdiostream.h"
 #include "common/algorithm.h"
 
@@ -73,6 +74,13 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+uint32 POSIXFilesystemNode::getModificationTime() const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return 0;
+	return (uint32)st.st_mtime;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -315,6 +323,15 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+	// Large files are mapped, so their data can be used without copying
+	Common::SeekableReadStream *stream = MmapStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
+
+	return createReadStream();
+}
+
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
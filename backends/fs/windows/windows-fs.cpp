@@ -26,6 +26,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "backends/fs/windows/windows-fs.h"
+#include "backends/fs/mmapstream.h"
 #include "backends/fs/stdiostream.h"
 
 // F_OK, R_OK and W_OK are not defined under MSVC, so we define them here
@@ -55,6 +56,16 @@ bool WindowsFilesystemNode::isWritable() const {
 	return _access(_path.c_str(), W_OK) == 0;
 }
 
+uint32 WindowsFilesystemNode::getModificationTime() const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data))
+		return 0;
+
+	// FILETIME counts 100ns intervals since 1601-01-01
+	uint64 time = ((uint64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return (uint32)(time / 10000000 - 11644473600ULL);
+}
+
 void WindowsFilesystemNode::addFile(AbstractFSList &list, ListMode mode, const char *base, bool hidden, WIN32_FIND_DATA* find_data) {
 	WindowsFilesystemNode entry;
 	char *asciiName = toAscii(find_data->cFileName);
@@ -245,6 +256,15 @@ Common::SeekableReadStream *WindowsFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *WindowsFilesystemNode::createMappedReadStream() {
+	// Large files are mapped, so their data can be used without copying
+	Common::SeekableReadStream *stream = MmapStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
+
+	return createReadStream();
+}
+
 Common::WriteStream *WindowsFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/null/null-graphics.h"
+
+#include "common/rect.h"
+#include "common/textconsole.h"
+
+// The smallest overlay the GUI can lay out its dialogs in
+enum {
+	kMinOverlayWidth = 320,
+	kMinOverlayHeight = 200
+};
+
+NullGraphicsManager::NullGraphicsManager()
+	: _screenChangeID(0), _frameCount(0), _mouseVisible(false) {
+	memset(_palette, 0, sizeof(_palette));
+	_screen.format = Graphics::PixelFormat::createFormatCLUT8();
+	_overlay.create(kMinOverlayWidth, kMinOverlayHeight, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+}
+
+NullGraphicsManager::~NullGraphicsManager() {
+	_screen.free();
+	_overlay.free();
+}
+
+Common::List<Graphics::PixelFormat> NullGraphicsManager::getSupportedFormats() const {
+	Common::List<Graphics::PixelFormat> list;
+#ifdef USE_RGB_COLOR
+	list.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	list.push_back(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	list.push_back(Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
+#endif
+	list.push_back(Graphics::PixelFormat::createFormatCLUT8());
+	return list;
+}
+
+void NullGraphicsManager::initSize(uint width, uint height, const Graphics::PixelFormat *format) {
+	Graphics::PixelFormat newFormat = format ? *format : Graphics::PixelFormat::createFormatCLUT8();
+	if (_screen.getPixels() && (int)width == _screen.w && (int)height == _screen.h && newFormat == _screen.format) {
+		return;
+	}
+
+	_screen.free();
+	_screen.create(width, height, newFormat);
+
+	uint overlayWidth = MAX<uint>(width, kMinOverlayWidth);
+	uint overlayHeight = MAX<uint>(height, kMinOverlayHeight);
+	if ((int)overlayWidth != _overlay.w || (int)overlayHeight != _overlay.h) {
+		Graphics::PixelFormat overlayFormat = _overlay.format;
+		_overlay.free();
+		_overlay.create(overlayWidth, overlayHeight, overlayFormat);
+	}
+
+	_screenChangeID++;
+}
+
+void NullGraphicsManager::setPalette(const byte *colors, uint start, uint num) {
+	assert(start + num <= 256);
+	memcpy(_palette + start * 3, colors, num * 3);
+}
+
+void NullGraphicsManager::grabPalette(byte *colors, uint start, uint num) const {
+	assert(start + num <= 256);
+	memcpy(colors, _palette + start * 3, num * 3);
+}
+
+void NullGraphicsManager::copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {
+	assert(x >= 0 && x + w <= _screen.w);
+	assert(y >= 0 && y + h <= _screen.h);
+	_screen.copyRectToSurface(buf, pitch, x, y, w, h);
+}
+
+void NullGraphicsManager::fillScreen(uint32 col) {
+	_screen.fillRect(Common::Rect(_screen.w, _screen.h), col);
+}
+
+void NullGraphicsManager::clearOverlay() {
+	_overlay.fillRect(Common::Rect(_overlay.w, _overlay.h), 0);
+}
+
+void NullGraphicsManager::grabOverlay(void *buf, int pitch) const {
+	const byte *src = (const byte *)_overlay.getPixels();
+	byte *dst = (byte *)buf;
+	for (int y = 0; y < _overlay.h; y++) {
+		memcpy(dst, src, _overlay.w * _overlay.format.bytesPerPixel);
+		src += _overlay.pitch;
+		dst += pitch;
+	}
+}
+
+void NullGraphicsManager::copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {
+	const byte *src = (const byte *)buf;
+
+	// The GUI may pass rects partly outside of the overlay
+	if (x < 0) {
+		w += x;
+		src -= x * _overlay.format.bytesPerPixel;
+		x = 0;
+	}
+	if (y < 0) {
+		h += y;
+		src -= y * pitch;
+		y = 0;
+	}
+	w = MIN<int>(w, _overlay.w - x);
+	h = MIN<int>(h, _overlay.h - y);
+	if (w <= 0 || h <= 0) {
+		return;
+	}
+
+	_overlay.copyRectToSurface(src, pitch, x, y, w, h);
+}
+
+bool NullGraphicsManager::showMouse(bool visible) {
+	bool last = _mouseVisible;
+	_mouseVisible = visible;
+	return last;
+}
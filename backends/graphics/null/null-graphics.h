@@ -24,12 +24,20 @@
 #define BACKENDS_GRAPHICS_NULL_H
 
 #include "backends/graphics/graphics.h"
+#include "graphics/surface.h"
 
 static const OSystem::GraphicsMode s_noGraphicsModes[] = { {0, 0, 0} };
 
+/**
+ * Graphics manager without a display. The game screen and the overlay are
+ * kept in memory, so engines which read back the screen behave as they
+ * would on a real backend, and the number of frames is counted so that a
+ * headless run can be limited to a number of frames.
+ */
 class NullGraphicsManager : public GraphicsManager {
 public:
-	virtual ~NullGraphicsManager() {}
+	NullGraphicsManager();
+	virtual ~NullGraphicsManager();
 
 	bool hasFeature(OSystem::Feature f) const override { return false; }
 	void setFeatureState(OSystem::Feature f, bool enable) override {}
@@ -41,45 +49,52 @@ public:
 	void resetGraphicsScale() override {}
 	int getGraphicsMode() const override { return 0; }
 	inline Graphics::PixelFormat getScreenFormat() const override {
-		return Graphics::PixelFormat::createFormatCLUT8();
-	}
-	inline Common::List<Graphics::PixelFormat> getSupportedFormats() const override {
-		Common::List<Graphics::PixelFormat> list;
-		list.push_back(Graphics::PixelFormat::createFormatCLUT8());
-		return list;
+		return _screen.format;
 	}
-	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) override {}
-	virtual int getScreenChangeID() const override { return 0; }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const override;
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) override;
+	virtual int getScreenChangeID() const override { return _screenChangeID; }
 
 	void beginGFXTransaction() override {}
 	OSystem::TransactionError endGFXTransaction() override { return OSystem::kTransactionSuccess; }
 
-	int16 getHeight() const override { return 0; }
-	int16 getWidth() const override { return 0; }
-	void setPalette(const byte *colors, uint start, uint num) override {}
-	void grabPalette(byte *colors, uint start, uint num) const override {}
-	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {}
-	Graphics::Surface *lockScreen() override { return NULL; }
+	int16 getHeight() const override { return _screen.h; }
+	int16 getWidth() const override { return _screen.w; }
+	void setPalette(const byte *colors, uint start, uint num) override;
+	void grabPalette(byte *colors, uint start, uint num) const override;
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	Graphics::Surface *lockScreen() override { return &_screen; }
 	void unlockScreen() override {}
-	void fillScreen(uint32 col) override {}
-	void updateScreen() override {}
+	void fillScreen(uint32 col) override;
+	void updateScreen() override { _frameCount++; }
 	void setShakePos(int shakeXOffset, int shakeYOffset) override {}
 	void setFocusRectangle(const Common::Rect& rect) override {}
 	void clearFocusRectangle() override {}
 
 	void showOverlay() override {}
 	void hideOverlay() override {}
-	Graphics::PixelFormat getOverlayFormat() const override { return Graphics::PixelFormat(); }
-	void clearOverlay() override {}
-	void grabOverlay(void *buf, int pitch) const override {}
-	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override {}
-	int16 getOverlayHeight() const override { return 0; }
-	int16 getOverlayWidth() const override { return 0; }
+	Graphics::PixelFormat getOverlayFormat() const override { return _overlay.format; }
+	void clearOverlay() override;
+	void grabOverlay(void *buf, int pitch) const override;
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override;
+	int16 getOverlayHeight() const override { return _overlay.h; }
+	int16 getOverlayWidth() const override { return _overlay.w; }
 
-	bool showMouse(bool visible) override { return !visible; }
+	bool showMouse(bool visible) override;
 	void warpMouse(int x, int y) override {}
 	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale = false, const Graphics::PixelFormat *format = NULL) override {}
 	void setCursorPalette(const byte *colors, uint start, uint num) override {}
+
+	/** Number of times updateScreen was called */
+	uint32 getFrameCount() const { return _frameCount; }
+
+private:
+	Graphics::Surface _screen;
+	Graphics::Surface _overlay;
+	byte _palette[256 * 3];
+	int _screenChangeID;
+	uint32 _frameCount;
+	bool _mouseVisible;
 };
 
 #endif
@@ -38,6 +38,7 @@ void Context::reset() {
 	shadersSupported = false;
 	multitextureSupported = false;
 	framebufferObjectSupported = false;
+	pixelBufferObjectSupported = false;
 
 #define GL_FUNC_DEF(ret, name, param) name = nullptr;
 #include "backends/graphics/opengl/opengl-func.h"
@@ -119,6 +120,8 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	bool ARBShadingLanguage100 = false;
 	bool ARBVertexShader = false;
 	bool ARBFragmentShader = false;
+	bool ARBPixelBufferObject = false;
+	bool NVPixelBufferObject = false;
 
 	Common::StringTokenizer tokenizer(extString, " ");
 	while (!tokenizer.empty()) {
@@ -138,6 +141,10 @@ void OpenGLGraphicsManager::initializeGLContext() {
 			g_context.multitextureSupported = true;
 		} else if (token == "GL_EXT_framebuffer_object") {
 			g_context.framebufferObjectSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object" || token == "GL_EXT_pixel_buffer_object") {
+			ARBPixelBufferObject = true;
+		} else if (token == "GL_NV_pixel_buffer_object") {
+			NVPixelBufferObject = true;
 		}
 	}
 
@@ -153,10 +160,24 @@ void OpenGLGraphicsManager::initializeGLContext() {
 
 		// GLES2 always has FBO support.
 		g_context.framebufferObjectSupported = true;
+
+		// GLES3 contexts, which are created as GLES2 contexts, always have
+		// PBO support.
+		const char *versionString = (const char *)g_context.glGetString(GL_VERSION);
+		const bool isGLES3 = versionString && !strncmp(versionString, "OpenGL ES 3", 11);
+		g_context.pixelBufferObjectSupported = isGLES3 || NVPixelBufferObject;
 	} else {
 		g_context.shadersSupported = ARBShaderObjects & ARBShadingLanguage100 & ARBVertexShader & ARBFragmentShader;
+
+		// PBOs are not available for GLES 1 contexts.
+		g_context.pixelBufferObjectSupported = g_context.type == kContextGL && ARBPixelBufferObject;
 	}
 
+#if USE_FORCED_GLES
+	// The buffer functions are not loaded for forced GLES 1 contexts.
+	g_context.pixelBufferObjectSupported = false;
+#endif
+
 	// Log context type.
 	switch (g_context.type) {
 	case kContextGL:
@@ -177,6 +198,7 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	debug(5, "OpenGL: Shader support: %d", g_context.shadersSupported);
 	debug(5, "OpenGL: Multitexture support: %d", g_context.multitextureSupported);
 	debug(5, "OpenGL: FBO support: %d", g_context.framebufferObjectSupported);
+	debug(5, "OpenGL: PBO support: %d", g_context.pixelBufferObjectSupported);
 }
 
 } // End of namespace OpenGL
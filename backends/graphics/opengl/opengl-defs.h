@@ -76,6 +76,7 @@ typedef float  GLclampf; /* single precision float in [0,1] */
 typedef double GLdouble; /* double precision float */
 typedef double GLclampd; /* double precision float in [0,1] */
 typedef char   GLchar;
+typedef ptrdiff_t GLsizeiptr;
 #if defined(MACOSX)
 typedef void  *GLhandleARB;
 #else
@@ -259,4 +260,8 @@ typedef GLhandleARB GLshader;
 #define GL_COLOR_ATTACHMENT0              0x8CE0
 #define GL_FRAMEBUFFER                    0x8D40
 
+/* Pixel buffer objects */
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_PIXEL_UNPACK_BUFFER            0x88EC
+
 #endif
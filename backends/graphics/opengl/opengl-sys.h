@@ -129,6 +129,9 @@ struct Context {
 	/** Whether FBO support is available or not. */
 	bool framebufferObjectSupported;
 
+	/** Whether textures can be uploaded from pixel buffer objects or not. */
+	bool pixelBufferObjectSupported;
+
 #define GL_FUNC_DEF(ret, name, param) ret (GL_CALL_CONV *name)param
 #include "backends/graphics/opengl/opengl-func.h"
 #undef GL_FUNC_DEF
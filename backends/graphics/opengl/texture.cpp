@@ -37,12 +37,17 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
     : _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
       _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
       _texCoords(), _glFilter(GL_NEAREST),
-      _glTexture(0) {
+      _glTexture(0), _pixelBuffers(), _nextPixelBuffer(0) {
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#if !USE_FORCED_GLES
+	if (_pixelBuffers[0]) {
+		GL_CALL_SAFE(glDeleteBuffers, (ARRAYSIZE(_pixelBuffers), _pixelBuffers));
+	}
+#endif
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -61,6 +66,13 @@ void GLTexture::enableLinearFiltering(bool enable) {
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+#if !USE_FORCED_GLES
+	if (_pixelBuffers[0]) {
+		GL_CALL(glDeleteBuffers(ARRAYSIZE(_pixelBuffers), _pixelBuffers));
+		memset(_pixelBuffers, 0, sizeof(_pixelBuffers));
+	}
+#endif
 }
 
 void GLTexture::create() {
@@ -70,6 +82,12 @@ void GLTexture::create() {
 	// Get a new texture name.
 	GL_CALL(glGenTextures(1, &_glTexture));
 
+#if !USE_FORCED_GLES
+	if (g_context.pixelBufferObjectSupported) {
+		GL_CALL(glGenBuffers(ARRAYSIZE(_pixelBuffers), _pixelBuffers));
+	}
+#endif
+
 	// Set up all texture parameters.
 	bind();
 	GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
@@ -153,8 +171,31 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	//
 	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
 	//    graphics manager did but it is much slower! Thus, we do not use it.
+	//
+	// Since whole lines are uploaded, the data is contiguous in memory.
+	const void *pixels = src.getBasePtr(0, area.top);
+
+#if !USE_FORCED_GLES
+	// With pixel buffer objects the driver copies the data right away and
+	// transfers it to the texture asynchronously, instead of stalling until
+	// the GPU is done with the texture. The buffer storage is respecified
+	// every time, so the driver never has to wait for the old contents.
+	if (_pixelBuffers[0]) {
+		assert((uint)src.pitch == src.w * src.format.bytesPerPixel);
+
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_nextPixelBuffer]));
+		GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, src.pitch * area.height(), pixels, GL_STREAM_DRAW));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
+		                       _glFormat, _glType, nullptr));
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+		_nextPixelBuffer = (_nextPixelBuffer + 1) % ARRAYSIZE(_pixelBuffers);
+		return;
+	}
+#endif
+
 	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
-	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	                       _glFormat, _glType, pixels));
 }
 
 //
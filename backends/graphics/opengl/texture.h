@@ -143,6 +143,14 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	/**
+	 * Pixel buffer objects used for uploads, when supported by the context.
+	 * They are used in turns, so uploading never waits for the previous
+	 * frame's transfer from the same buffer.
+	 */
+	GLuint _pixelBuffers[2];
+	uint _nextPixelBuffer;
 };
 
 /**
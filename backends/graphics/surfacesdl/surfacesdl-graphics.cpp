@@ -31,6 +31,7 @@
 #include "common/translation.h"
 #include "common/util.h"
 #include "common/frac.h"
+#include "common/taskscheduler.h"
 #ifdef USE_RGB_COLOR
 #include "common/list.h"
 #endif
@@ -1197,6 +1198,99 @@ void SurfaceSdlGraphicsManager::updateShader() {
 	// hardware-based up-scaling (sharp-bilinear-simple, etc.)
 }
 
+namespace {
+
+/** A dirty rect to be scaled and stretched onto the hardware screen */
+struct ScaleJob {
+	const byte *src;
+	byte *dst;
+	int width, height;	// Source size, a width of 0 means nothing to do
+	bool stretch;	// Whether to stretch for aspect ratio correction
+	int origDstY;	// Scaled y before aspect ratio correction
+	Common::Rect area;	// Screen area read and written
+};
+
+void runScaleJob(const ScaleJob &job, SDL_Rect &rect, ScalerProc *scaler, int scaleFactor, uint32 srcPitch,
+                 SDL_Surface *screen, bool filtering, Common::TaskScheduler *scheduler) {
+	if (!job.width)
+		return;
+
+	if (scheduler) {
+		scaleInStrips(*scheduler, scaler, scaleFactor, job.src, srcPitch, job.dst, screen->pitch, job.width, job.height);
+	} else {
+		scaler(job.src, srcPitch, job.dst, screen->pitch, job.width, job.height);
+	}
+
+#ifdef USE_SCALERS
+	if (job.stretch)
+		rect.h = stretch200To240((uint8 *)screen->pixels, screen->pitch, rect.w, rect.h, rect.x, rect.y, job.origDstY, filtering);
+#endif
+}
+
+class ScaleJobsBody : public Common::ParallelForBody {
+public:
+	ScaleJobsBody(const ScaleJob *jobs, SDL_Rect *rects, ScalerProc *scaler, int scaleFactor,
+	              uint32 srcPitch, SDL_Surface *screen, bool filtering)
+	    : _jobs(jobs), _rects(rects), _scaler(scaler), _scaleFactor(scaleFactor),
+	      _srcPitch(srcPitch), _screen(screen), _filtering(filtering) {}
+
+	virtual void run(uint begin, uint end) {
+		for (uint i = begin; i < end; ++i)
+			runScaleJob(_jobs[i], _rects[i], _scaler, _scaleFactor, _srcPitch, _screen, _filtering, nullptr);
+	}
+
+private:
+	const ScaleJob *_jobs;
+	SDL_Rect *_rects;
+	ScalerProc *_scaler;
+	int _scaleFactor;
+	uint32 _srcPitch;
+	SDL_Surface *_screen;
+	bool _filtering;
+};
+
+/**
+ * Scales the dirty rects onto the screen, and updates their heights when
+ * they are stretched for aspect ratio correction.
+ */
+void scaleDirtyRects(ScaleJob *jobs, SDL_Rect *rects, int count, ScalerProc *scaler, int scaleFactor,
+                     uint32 srcPitch, SDL_Surface *screen, bool filtering) {
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+
+	// Dirty rects may overlap, and the aspect ratio correction works in
+	// place and also reads the line above each rect. Rects are only scaled
+	// in parallel when none of the screen areas they touch overlap, since
+	// the result would depend on their order otherwise.
+	bool parallel = count >= 2 && !scheduler->isSerial() && isScalerThreadSafe(scaler);
+	for (int i = 0; parallel && i < count; ++i) {
+		ScaleJob &job = jobs[i];
+		if (!job.width)
+			continue;
+
+		job.area = Common::Rect(rects[i].x, rects[i].y - 1, rects[i].x + rects[i].w, rects[i].y + rects[i].h);
+		if (job.stretch)
+			job.area.bottom = real2Aspect(job.origDstY + rects[i].h - 1) + 1;
+
+		for (int j = 0; j < i; ++j) {
+			if (jobs[j].width && jobs[j].area.intersects(job.area)) {
+				parallel = false;
+				break;
+			}
+		}
+	}
+
+	if (parallel) {
+		ScaleJobsBody body(jobs, rects, scaler, scaleFactor, srcPitch, screen, filtering);
+		scheduler->parallelFor(0, count, body);
+	} else {
+		// Large rects are still split into strips scaled in parallel
+		for (int i = 0; i < count; ++i)
+			runScaleJob(jobs[i], rects[i], scaler, scaleFactor, srcPitch, screen, filtering, scheduler);
+	}
+}
+
+} // End of anonymous namespace
+
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	SDL_Surface *srcSurf, *origSurf;
 	int height, width;
@@ -1306,7 +1400,11 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwScreen->pitch;
 
-		for (r = _dirtyRectList; r != lastRect; ++r) {
+		const bool stretch = _videoMode.aspectRatioCorrection && !_overlayVisible;
+		ScaleJob jobs[NUM_DIRTY_RECT];
+		ScaleJob *job = jobs;
+
+		for (r = _dirtyRectList; r != lastRect; ++r, ++job) {
 			int dst_x = r->x + _currentShakeXOffset;
 			int dst_y = r->y + _currentShakeYOffset;
 			int dst_w = 0;
@@ -1315,6 +1413,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			int orig_dst_y = 0;
 #endif
 
+			job->width = 0;
+			job->stretch = false;
+
 			if (dst_x < width && dst_y < height) {
 				dst_w = r->w;
 				if (dst_w > width - dst_x)
@@ -1330,12 +1431,13 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				dst_x *= scale1;
 				dst_y *= scale1;
 
-				if (_videoMode.aspectRatioCorrection && !_overlayVisible)
+				if (stretch)
 					dst_y = real2Aspect(dst_y);
 
-				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, dst_w, dst_h);
+				job->src = (const byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch;
+				job->dst = (byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch;
+				job->width = dst_w;
+				job->height = dst_h;
 			}
 
 			r->x = dst_x;
@@ -1344,10 +1446,16 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			r->h = dst_h * scale1;
 
 #ifdef USE_SCALERS
-			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible)
-				r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering);		
+			if (stretch && orig_dst_y < height) {
+				job->stretch = true;
+				job->origDstY = orig_dst_y * scale1;
+			}
 #endif
 		}
+
+		assert(scalerProc != NULL);
+		scaleDirtyRects(jobs, _dirtyRectList, _numDirtyRects, scalerProc, scale1, srcPitch, _hwScreen, _videoMode.filtering);
+
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwScreen);
 
@@ -24,7 +24,9 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/mutex/mutex.h"
+#include "engines/engine.h"
 #include "gui/EventRecorder.h"
+#include "common/profiler.h"
 
 #include "audio/mixer.h"
 #include "graphics/pixelformat.h"
@@ -172,6 +174,7 @@ void ModularBackend::fillScreen(uint32 col) {
 }
 
 void ModularBackend::updateScreen() {
+	PROFILE_ZONE("OSystem::updateScreen");
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.preDrawOverlayGui();
 #endif
@@ -181,6 +184,9 @@ void ModularBackend::updateScreen() {
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.postDrawOverlayGui();
 #endif
+
+	if (g_engine)
+		g_engine->frameShown();
 }
 
 void ModularBackend::setShakePos(int shakeXOffset, int shakeYOffset) {
@@ -7,6 +7,7 @@ MODULE_OBJS := \
 	audiocd/default/default-audiocd.o \
 	events/default/default-events.o \
 	fs/abstract-fs.o \
+	fs/mmapstream.o \
 	fs/stdiostream.o \
 	log/log.o \
 	midi/alsa.o \
@@ -142,6 +143,7 @@ MODULE_OBJS += \
 	graphics/surfacesdl/surfacesdl-graphics.o \
 	mixer/sdl/sdl-mixer.o \
 	mutex/sdl/sdl-mutex.o \
+	taskscheduler/sdl/sdl-taskscheduler.o \
 	plugins/sdl/sdl-provider.o \
 	timer/sdl/sdl-timer.o
 
@@ -283,7 +285,8 @@ endif
 ifeq ($(BACKEND),libretro)
 MODULE_OBJS += \
 	fs/libretro/libretro-fs.o \
-	fs/libretro/libretro-fs-factory.o
+	fs/libretro/libretro-fs-factory.o \
+	fs/libretro/libretro-vfs.o
 endif
 
 ifeq ($(BACKEND),linuxmoto)
@@ -305,6 +308,11 @@ MODULE_OBJS += \
 	fs/n64/romfsstream.o
 endif
 
+ifeq ($(BACKEND),null)
+MODULE_OBJS += \
+	graphics/null/null-graphics.o
+endif
+
 ifeq ($(BACKEND),openpandora)
 MODULE_OBJS += \
 	events/openpandora/op-events.o \
@@ -25,6 +25,7 @@
 #include <curl/curl.h>
 #include "backends/networking/curl/connectionmanager.h"
 #include "backends/networking/curl/networkreadstream.h"
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/fs.h"
 #include "common/system.h"
@@ -41,6 +42,24 @@ namespace Networking {
 ConnectionManager::ConnectionManager(): _multi(0), _timerStarted(false), _frame(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+
+	// All transfers share the multi handle's connection cache, so requests
+	// to the same host reuse its connections. Limit how many are opened at
+	// once, so that a long series of small requests (such as a saves sync)
+	// queues on the open connections instead of opening new ones.
+	long maxConnections = DEFAULT_MAX_CONNECTIONS;
+	if (ConfMan.hasKey("max_connections", "cloud")) {
+		maxConnections = MAX(ConfMan.getInt("max_connections", "cloud"), 1);
+	}
+#if LIBCURL_VERSION_NUM >= 0x071E00
+	// CURLMOPT_MAX_HOST_CONNECTIONS and CURLMOPT_MAX_TOTAL_CONNECTIONS available since curl 7.30.0
+	curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, maxConnections);
+	curl_multi_setopt(_multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxConnections);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// CURLPIPE_MULTIPLEX available since curl 7.43.0
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
 }
 
 ConnectionManager::~ConnectionManager() {
@@ -67,6 +86,14 @@ ConnectionManager::~ConnectionManager() {
 }
 
 void ConnectionManager::registerEasyHandle(CURL *easy) const {
+#if LIBCURL_VERSION_NUM >= 0x072F00
+	// CURL_HTTP_VERSION_2TLS available since curl 7.47.0
+	// Use HTTP/2 with hosts which support it, so transfers to the same
+	// host are multiplexed over one connection...
+	curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+	// ...and wait for that connection rather than opening another one
+	curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+#endif
 	curl_multi_add_handle(_multi, easy);
 }
 
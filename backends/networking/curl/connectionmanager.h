@@ -43,6 +43,7 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	static const uint32 CLOUD_PERIOD = 1; //every frame
 	static const uint32 CURL_PERIOD = 1; //every frame
 	static const uint32 DEBUG_PRINT_PERIOD = FRAMES_PER_SECOND; // once per second
+	static const long DEFAULT_MAX_CONNECTIONS = 6; // unless set by "max_connections" in "cloud" domain
 
 	friend void connectionsThread(void *); //calls handle()
 
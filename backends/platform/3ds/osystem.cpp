@@ -147,6 +147,18 @@ void OSystem_3DS::delayMillis(uint msecs) {
 	svcSleepThread(msecs * 1000000);
 }
 
+uint64 OSystem_3DS::getTicks() {
+	return svcGetSystemTick();
+}
+
+void OSystem_3DS::sleepUntil(uint64 deadline) {
+	const uint64 now = svcGetSystemTick();
+	if (deadline > now) {
+		const uint64 ticks = deadline - now;
+		svcSleepThread((ticks / SYSCLOCK_ARM11) * 1000000000 + (ticks % SYSCLOCK_ARM11) * 1000000000 / SYSCLOCK_ARM11);
+	}
+}
+
 void OSystem_3DS::getTimeAndDate(TimeDate& td) const {
 	time_t curTime = time(0);
 	struct tm t = *localtime(&curTime);
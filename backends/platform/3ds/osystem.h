@@ -77,6 +77,9 @@ public:
 
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
+	virtual uint64 getTicks();
+	virtual uint64 getTickFrequency() { return SYSCLOCK_ARM11; }
+	virtual void sleepUntil(uint64 deadline);
 	virtual void getTimeAndDate(TimeDate &t) const;
 
 	virtual MutexRef createMutex();
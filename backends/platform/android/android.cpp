@@ -433,6 +433,28 @@ void OSystem_Android::delayMillis(uint msecs) {
 	usleep(msecs * 1000);
 }
 
+uint64 OSystem_Android::getTicks() {
+	timespec curTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+	return (uint64)curTime.tv_sec * 1000000000 + curTime.tv_nsec;
+}
+
+void OSystem_Android::sleepUntil(uint64 deadline) {
+	uint64 now = getTicks();
+
+	// nanosleep returns early when a signal comes in
+	while (now < deadline) {
+		const uint64 remaining = deadline - now;
+		timespec delay;
+		delay.tv_sec = remaining / 1000000000;
+		delay.tv_nsec = remaining % 1000000000;
+		nanosleep(&delay, 0);
+		now = getTicks();
+	}
+}
+
 void OSystem_Android::quit() {
 	ENTER();
 
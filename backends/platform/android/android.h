@@ -124,6 +124,9 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
+	virtual uint64 getTicks();
+	virtual uint64 getTickFrequency() { return 1000000000; }
+	virtual void sleepUntil(uint64 deadline);
 
 	virtual void quit();
 
@@ -3,8 +3,12 @@
 #include "base/main.h"
 #include "common/scummsys.h"
 #include "graphics/surface.libretro.h"
+#include "audio/cpustats.h"
 #include "audio/mixer_intern.h"
+#include "common/memstream.h"
+#include "engines/engine.h"
 #include "os.h"
+#include "backends/fs/libretro/libretro-vfs.h"
 #include <libco.h>
 #include "libretro.h"
 #ifdef _WIN32
@@ -29,6 +33,17 @@
 #include "base/internal_version.h"
 
 #include "libretro_core_options.h"
+#include "libretro_perf.h"
+#ifdef HAVE_OPENGL
+#include "libretro_gl.h"
+#endif
+#ifdef HAVE_THREADS
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "libretro_thread.h"
+#endif
 
 retro_log_printf_t log_cb = NULL;
 static retro_video_refresh_t video_cb = NULL;
@@ -54,6 +69,23 @@ static bool analog_response_is_quadratic = false;
 static float mouse_speed = 1.0f;
 
 static bool speed_hack_is_enabled = false;
+static bool hw_render_requested = false;
+static bool hw_render = false;
+static bool audio_callback_requested = false;
+static bool threaded_requested = false;
+
+static struct retro_perf_callback perf_cb;
+static bool perf_cb_valid = false;
+
+/* Audio is mixed in batches sized by the time the frontend says has passed */
+#define AUDIO_BATCH_MAX 2048
+static const retro_usec_t frame_time_reference = 1000000 / 60;
+static retro_usec_t frame_time_usec = frame_time_reference;
+static double audio_frames_pending = 0.0;
+static bool audio_callback_registered = false;
+static volatile bool audio_callback_enabled = false;
+
+static bool can_dupe = false;
 
 void retro_set_environment(retro_environment_t cb)
 {
@@ -62,10 +94,26 @@ void retro_set_environment(retro_environment_t cb)
 
    environ_cb(RETRO_ENVIRONMENT_SET_SUPPORT_NO_GAME, &tmp);
    libretro_set_core_options(environ_cb);
+
+   /* File access goes through the frontend VFS when there is one. Version 3
+    * also covers directories, older versions only the file streams. */
+   struct retro_vfs_interface_info vfs_info = { 3, NULL };
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_VFS_INTERFACE, &vfs_info) || !vfs_info.iface)
+   {
+      vfs_info.required_interface_version = 1;
+      vfs_info.iface = NULL;
+      if (!environ_cb(RETRO_ENVIRONMENT_GET_VFS_INTERFACE, &vfs_info))
+         vfs_info.iface = NULL;
+   }
+   LibRetroVFS::setInterface(vfs_info.iface, vfs_info.required_interface_version);
 }
 
 bool FRONTENDwantsExit;
+#ifdef HAVE_THREADS
+std::atomic<bool> EMULATORexited(false);
+#else
 bool EMULATORexited;
+#endif
 
 cothread_t mainThread;
 cothread_t emuThread;
@@ -73,21 +121,182 @@ cothread_t emuThread;
 static char cmd_params[20][200];
 static char cmd_params_num;
 
+/* Save states have to be taken on the emulator thread while the engine is
+ * waiting for us, so the requests are handed over to retro_leave_thread(). */
+enum state_request_type
+{
+   STATE_REQUEST_NONE,
+   STATE_REQUEST_SAVE,
+   STATE_REQUEST_LOAD
+};
+
+static state_request_type state_request = STATE_REQUEST_NONE;
+static Common::SeekableWriteStream *state_out = NULL;
+static const void *state_in = NULL;
+static size_t state_in_size = 0;
+static bool state_result = false;
+
+static void service_state_request(void)
+{
+   if (state_request == STATE_REQUEST_SAVE)
+      state_result = retroSaveState(*state_out);
+   else
+      state_result = retroLoadState(state_in, state_in_size);
+
+   state_request = STATE_REQUEST_NONE;
+}
+
+#ifdef HAVE_THREADS
+/* In threaded mode the engine runs on its own OS thread and never waits for
+ * retro_run. Finished frames are copied into a small pool of buffers that
+ * cycle between the two threads through lock-free queues. */
+#define THREADED_FRAME_COUNT 3
+
+static bool threaded = false;
+static std::thread *emu_os_thread = NULL;
+
+static Graphics::Surface threaded_frames[THREADED_FRAME_COUNT];
+static RetroSPSCQueue<Graphics::Surface*, THREADED_FRAME_COUNT + 1> frames_ready;
+static RetroSPSCQueue<Graphics::Surface*, THREADED_FRAME_COUNT + 1> frames_free;
+static Graphics::Surface *frame_shown = NULL;
+static bool frame_pending = false;
+
+static std::mutex state_mutex;
+static std::condition_variable state_cond;
+
+/* Emulator thread */
+static void publish_frame(void)
+{
+   if (retroScreenUpdated())
+      frame_pending = true;
+
+   /* If the frontend is behind, keep the frame pending and try again later */
+   Graphics::Surface *frame;
+   if (!frame_pending || !frames_free.pop(frame))
+      return;
+
+   const Graphics::Surface &screen = getScreen();
+   if (frame->w != screen.w || frame->h != screen.h || frame->format != screen.format)
+   {
+      frame->free();
+      frame->create(screen.w, screen.h, screen.format);
+   }
+
+   for (int i = 0; i < screen.h; i ++)
+      memcpy(frame->getBasePtr(0, i), screen.getBasePtr(0, i), screen.w * screen.format.bytesPerPixel);
+
+   frames_ready.push(frame);
+   frame_pending = false;
+}
+#endif
+
 void retro_leave_thread(void)
 {
+#ifdef HAVE_THREADS
+   if (threaded)
+   {
+      publish_frame();
+
+      std::lock_guard<std::mutex> lock(state_mutex);
+      if (state_request != STATE_REQUEST_NONE)
+      {
+         service_state_request();
+         state_cond.notify_one();
+      }
+      return;
+   }
+#endif
+
    co_switch(mainThread);
+
+   while (state_request != STATE_REQUEST_NONE)
+   {
+      service_state_request();
+      co_switch(mainThread);
+   }
 }
 
-static void retro_wrap_emulator(void)
+static bool run_state_request(state_request_type request)
 {
-   g_system = retroBuildOS(speed_hack_is_enabled);
+#ifdef HAVE_THREADS
+   if (threaded)
+   {
+      if (!emu_os_thread || EMULATORexited || !g_engine)
+         return false;
+
+      /* Wait for the emulator thread to pick the request up in retro_leave_thread() */
+      std::unique_lock<std::mutex> lock(state_mutex);
+      state_request = request;
+      state_result = false;
+      while (state_request != STATE_REQUEST_NONE && !EMULATORexited)
+         state_cond.wait_for(lock, std::chrono::milliseconds(10));
+
+      state_request = STATE_REQUEST_NONE;
+      return state_result;
+   }
+#endif
+
+   /* A running engine implies the emulator thread sits in retro_leave_thread() */
+   if (!emuThread || EMULATORexited || !g_engine)
+      return false;
+
+   state_request = request;
+   state_result = false;
+   co_switch(emuThread);
+   return state_result;
+}
 
+static void frame_time_cb(retro_usec_t usec)
+{
+   /* Don't mix seconds of audio in one go after the frontend was paused */
+   frame_time_usec = MIN(usec, frame_time_reference * 6);
+}
+
+static void mix_audio(unsigned frames)
+{
+   static int16_t buf[AUDIO_BATCH_MAX * 2];
+
+   Audio::MixerImpl *mixer = (Audio::MixerImpl*)g_system->getMixer();
+   if (!mixer)
+      return;
+
+   RetroPerfScope scope(RETRO_PERF_MIX);
+
+   /* The mixer clears the buffer first, so silence is a full batch too */
+   while (frames)
+   {
+      const unsigned count = MIN<unsigned>(frames, AUDIO_BATCH_MAX);
+      mixer->mixCallback((byte*)buf, count * 4);
+      audio_batch_cb(buf, count);
+      frames -= count;
+   }
+}
+
+static void audio_cb(void)
+{
+   if (audio_callback_enabled && g_system && !EMULATORexited)
+      mix_audio(RETRO_AUDIO_SAMPLE_RATE / 100);
+}
+
+static void audio_set_state_cb(bool enabled)
+{
+   audio_callback_enabled = enabled;
+}
+
+static void run_emulator(void)
+{
    static const char* argv[20];
    for(int i=0; i<cmd_params_num; i++)
       argv[i] = cmd_params[i];
 
    scummvm_main(cmd_params_num, argv);
    EMULATORexited = true;
+}
+
+static void retro_wrap_emulator(void)
+{
+   g_system = retroBuildOS(speed_hack_is_enabled);
+   run_emulator();
 
    // NOTE: Deleting g_system here will crash...
 
@@ -101,6 +310,51 @@ static void retro_wrap_emulator(void)
    }
 }
 
+#ifdef HAVE_THREADS
+static void start_threaded_emulator(void)
+{
+   for (int i = 0; i < THREADED_FRAME_COUNT; i ++)
+      frames_free.push(&threaded_frames[i]);
+
+   g_system = retroBuildOS(speed_hack_is_enabled);
+   retroSetThreaded(true);
+   emu_os_thread = new std::thread(run_emulator);
+}
+
+static void stop_threaded_emulator(void)
+{
+   emu_os_thread->join();
+   delete emu_os_thread;
+   emu_os_thread = NULL;
+}
+
+/* Frontend thread: show the newest finished frame, or repeat the last one */
+static void present_threaded_frame(void)
+{
+   Graphics::Surface *frame;
+   bool updated = false;
+   while (frames_ready.pop(frame))
+   {
+      if (frame_shown)
+         frames_free.push(frame_shown);
+      frame_shown = frame;
+      updated = true;
+   }
+
+   if (!frame_shown)
+   {
+      if (can_dupe)
+         video_cb(NULL, RES_W, RES_H, 0);
+      return;
+   }
+
+   if (updated || !can_dupe)
+      video_cb(frame_shown->getPixels(), frame_shown->w, frame_shown->h, frame_shown->pitch);
+   else
+      video_cb(NULL, frame_shown->w, frame_shown->h, frame_shown->pitch);
+}
+#endif
+
 unsigned retro_api_version(void)
 {
    return RETRO_API_VERSION;
@@ -126,7 +380,7 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
    info->geometry.max_height = RES_H;
    info->geometry.aspect_ratio = 4.0f / 3.0f;
    info->timing.fps = 60.0;
-   info->timing.sample_rate = 44100.0;
+   info->timing.sample_rate = RETRO_AUDIO_SAMPLE_RATE;
 }
 
 void retro_init (void)
@@ -137,6 +391,7 @@ void retro_init (void)
    else
       log_cb = NULL;
 
+   perf_cb_valid = environ_cb(RETRO_ENVIRONMENT_GET_PERF_INTERFACE, &perf_cb);
 }
 
 void retro_deinit(void)
@@ -255,6 +510,50 @@ static void update_variables(void)
 		if (strcmp(var.value, "enabled") == 0)
 			speed_hack_is_enabled = true;
 	}
+
+	var.key = "scummvm_hw_render";
+	var.value = NULL;
+	hw_render_requested = false;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+	{
+		if (strcmp(var.value, "enabled") == 0)
+			hw_render_requested = true;
+	}
+
+	var.key = "scummvm_audio_callback";
+	var.value = NULL;
+	audio_callback_requested = false;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+	{
+		if (strcmp(var.value, "enabled") == 0)
+			audio_callback_requested = true;
+	}
+
+	var.key = "scummvm_perf_stats";
+	var.value = NULL;
+	bool perf_log = false;
+	bool perf_overlay = false;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+	{
+		perf_overlay = strcmp(var.value, "overlay") == 0;
+		perf_log = perf_overlay || strcmp(var.value, "log") == 0;
+	}
+	if (perf_log != retro_perf_enabled)
+	{
+		if (!retroPerfSetup(perf_cb_valid ? &perf_cb : NULL, perf_log) && log_cb)
+			log_cb(RETRO_LOG_WARN, "Frontend has no performance interface, stats are not available.\n");
+		Audio::CPUStats::instance().setEnabled(retro_perf_enabled);
+	}
+	retroSetPerfOverlay(perf_overlay && retro_perf_enabled && !hw_render);
+
+	var.key = "scummvm_threaded";
+	var.value = NULL;
+	threaded_requested = false;
+	if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+	{
+		if (strcmp(var.value, "enabled") == 0)
+			threaded_requested = true;
+	}
 }
 
 static int retro_device = RETRO_DEVICE_JOYPAD;
@@ -350,21 +649,59 @@ bool retro_load_game(const struct retro_game_info *game)
 
    environ_cb(RETRO_ENVIRONMENT_SET_INPUT_DESCRIPTORS, desc);
 
-   /* Get color mode: 32 first as VGA has 6 bits per pixel */
-#if 0
-   RDOSGFXcolorMode = RETRO_PIXEL_FORMAT_XRGB8888;
-   if(!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &RDOSGFXcolorMode))
-   {
-      RDOSGFXcolorMode = RETRO_PIXEL_FORMAT_RGB565;
-      if(!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &RDOSGFXcolorMode))
-         RDOSGFXcolorMode = RETRO_PIXEL_FORMAT_0RGB1555;
-   }
-#endif
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_CAN_DUPE, &can_dupe))
+      can_dupe = false;
 
 #ifdef FRONTEND_SUPPORTS_RGB565
    enum retro_pixel_format rgb565 = RETRO_PIXEL_FORMAT_RGB565;
    if (!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &rgb565) && log_cb)
       log_cb(RETRO_LOG_INFO, "Frontend supports RGB565 -will use that instead of XRGB1555.\n");
+#else
+   enum retro_pixel_format rgb1555 = RETRO_PIXEL_FORMAT_0RGB1555;
+   environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &rgb1555);
+#endif
+
+#if defined(HAVE_OPENGL) && defined(FRONTEND_SUPPORTS_RGB565)
+   /* Hardware rendering keeps the RGB565 format for the software fallback */
+   hw_render = hw_render_requested && retroGLSetup(environ_cb);
+   if (hw_render_requested && !hw_render && log_cb)
+      log_cb(RETRO_LOG_WARN, "Hardware rendering is not available, falling back to software.\n");
+   retroSetHWRender(hw_render);
+#endif
+
+   /* Frontends may only accept the pixel format here, so it stays fixed for
+    * the session. Software rendering prefers XRGB8888, which keeps true
+    * color games at full depth, and the blitters convert everything else. */
+   bool true_color = false;
+   if (!hw_render)
+   {
+      enum retro_pixel_format xrgb8888 = RETRO_PIXEL_FORMAT_XRGB8888;
+      true_color = environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &xrgb8888);
+   }
+   retroSetTrueColorOutput(true_color);
+
+   /* The state size depends on what the engine currently has loaded */
+   uint64_t quirks = RETRO_SERIALIZATION_QUIRK_CORE_VARIABLE_SIZE | RETRO_SERIALIZATION_QUIRK_ENDIAN_DEPENDENT;
+   environ_cb(RETRO_ENVIRONMENT_SET_SERIALIZATION_QUIRKS, &quirks);
+
+   /* Let the engine scheduler pace itself to the display, not a fixed 60 Hz */
+   float refresh_rate = 0.0f;
+   if (environ_cb(RETRO_ENVIRONMENT_GET_TARGET_REFRESH_RATE, &refresh_rate) && refresh_rate > 1.0f)
+      retroSetFrameInterval((uint32)(1000.0f / refresh_rate));
+
+   struct retro_frame_time_callback frame_time = { frame_time_cb, frame_time_reference };
+   if (!environ_cb(RETRO_ENVIRONMENT_SET_FRAME_TIME_CALLBACK, &frame_time))
+      frame_time_usec = frame_time_reference;
+
+#ifdef HAVE_THREADS
+   /* Mixing on the frontend's audio thread relies on the backend mutexes */
+   if (audio_callback_requested)
+   {
+      struct retro_audio_callback audio = { audio_cb, audio_set_state_cb };
+      audio_callback_registered = environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_CALLBACK, &audio);
+      if (!audio_callback_registered && log_cb)
+         log_cb(RETRO_LOG_WARN, "Frontend has no audio callback support, mixing in retro_run.\n");
+   }
 #endif
 
    retro_keyboard_callback cb = {retroKeyEvent};
@@ -388,6 +725,17 @@ bool retro_load_game(const struct retro_game_info *game)
       retroSetSaveDir(".");
    }
 
+#ifdef HAVE_THREADS
+   /* The GL renderer reads the backend surfaces directly, so it needs the cothread */
+   threaded = threaded_requested && !hw_render;
+   if (threaded)
+   {
+      if (!emu_os_thread)
+         start_threaded_emulator();
+      return true;
+   }
+#endif
+
    if(!emuThread && !mainThread)
    {
       mainThread = co_active();
@@ -402,9 +750,36 @@ bool retro_load_game_special(unsigned game_type, const struct retro_game_info *i
    return false;
 }
 
-void retro_run (void)
+/* Upload video, or let the frontend repeat the last frame if nothing changed */
+static void upload_video(void)
 {
+   const Graphics::Surface& screen = getScreen();
+#if defined(HAVE_OPENGL) && defined(FRONTEND_SUPPORTS_RGB565)
+   if (hw_render)
+   {
+      if (retroGLIsActive() && (retroScreenUpdated() || retroGLNeedsRedraw() || !can_dupe))
+      {
+         retroRenderGL();
+         video_cb(RETRO_HW_FRAME_BUFFER_VALID, screen.w, screen.h, 0);
+      }
+      else
+         video_cb(NULL, screen.w, screen.h, 0);
+   }
+   else
+#endif
+   if (retroScreenUpdated() || !can_dupe)
+      video_cb(screen.pixels, screen.w, screen.h, screen.pitch);
+   else
+      video_cb(NULL, screen.w, screen.h, screen.pitch);
+}
+
+static void run_frame(void)
+{
+#ifdef HAVE_THREADS
+   if(threaded ? !emu_os_thread : !emuThread) {
+#else
    if(!emuThread) {
+#endif
       environ_cb(RETRO_ENVIRONMENT_SHUTDOWN, 0);
       return;
    }
@@ -421,19 +796,39 @@ void retro_run (void)
    }
 
    /* Run emu */
-   co_switch(emuThread);
+#ifdef HAVE_THREADS
+   if (!threaded)
+#endif
+   {
+      RetroPerfScope scope(RETRO_PERF_ENGINE);
+      co_switch(emuThread);
+   }
 
    if(g_system)
    {
-      /* Upload video: TODO: Check the CANDUPE env value */
-      const Graphics::Surface& screen = getScreen();
-      video_cb(screen.pixels, screen.w, screen.h, screen.pitch);
+#ifdef HAVE_THREADS
+      if (threaded)
+         present_threaded_frame();
+      else
+#endif
+      upload_video();
 
-      // Upload audio
-      static uint32 buf[735];
-      int count = ((Audio::MixerImpl*)g_system->getMixer())->mixCallback((byte*)buf, 735*4);
-      audio_batch_cb((int16_t*)buf, count);
+      // Upload audio, carrying the fractional part over to the next frame
+      if (!audio_callback_registered)
+      {
+         audio_frames_pending += (double)RETRO_AUDIO_SAMPLE_RATE * frame_time_usec / 1000000.0;
+         const unsigned count = (unsigned)audio_frames_pending;
+         audio_frames_pending -= count;
+         mix_audio(count);
+      }
+   }
+
+#ifdef HAVE_THREADS
+   if(threaded && EMULATORexited) {
+      stop_threaded_emulator();
+      return;
    }
+#endif
 
    if(EMULATORexited) {
       co_delete(emuThread);
@@ -441,8 +836,35 @@ void retro_run (void)
    }
 }
 
+void retro_run (void)
+{
+   {
+      RetroPerfScope scope(RETRO_PERF_FRAME);
+      run_frame();
+   }
+   retroPerfEndFrame();
+}
+
 void retro_unload_game (void)
 {
+#ifdef HAVE_THREADS
+   if(threaded)
+   {
+      if(!emu_os_thread)
+         return;
+
+      FRONTENDwantsExit = true;
+      while(!EMULATORexited)
+      {
+         retroPostQuit();
+         std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+
+      stop_threaded_emulator();
+      return;
+   }
+#endif
+
    if(!emuThread)
       return;
 
@@ -457,16 +879,68 @@ void retro_unload_game (void)
    emuThread = 0;
 }
 
+/* Engine state registered through OSystem::setMemoryRegion() */
+void *retro_get_memory_data(unsigned type) { return retroGetMemoryData(type); }
+size_t retro_get_memory_size(unsigned type) { return retroGetMemorySize(type); }
+
 // Stubs
-void *retro_get_memory_data(unsigned type) { return 0; }
-size_t retro_get_memory_size(unsigned type) { return 0; }
 void retro_reset (void) { }
-size_t retro_serialize_size (void) { return 0; }
-bool retro_serialize(void *data, size_t size) { return false; }
-bool retro_unserialize(const void * data, size_t size) { return false; }
 void retro_cheat_reset(void) { }
 void retro_cheat_set(unsigned unused, bool unused1, const char* unused2) { }
 
+/* Frontends ask for the size before every rewind or run-ahead step, so the
+ * engine state is only measured when nothing is known for the running engine
+ * yet, or when it outgrew the last size. */
+static size_t state_size = 0;
+static const Engine *state_size_engine = NULL;
+
+/* Leave room for the engine state growing while the game runs */
+static void set_state_size(size_t used)
+{
+   state_size = used + used / 2;
+   state_size_engine = g_engine;
+}
+
+size_t retro_serialize_size (void)
+{
+   if (state_size && state_size_engine == g_engine)
+      return state_size;
+
+   Common::MemoryWriteStreamDynamic state(DisposeAfterUse::YES);
+
+   state_out = &state;
+   if (!run_state_request(STATE_REQUEST_SAVE))
+      return 0;
+
+   set_state_size(state.size());
+   return state_size;
+}
+
+bool retro_serialize(void *data, size_t size)
+{
+   Common::SeekableMemoryWriteStream state((byte *)data, size);
+
+   state_out = &state;
+   if (!run_state_request(STATE_REQUEST_SAVE) || state.err())
+   {
+      /* Measure again on the next size request */
+      state_size = 0;
+      return false;
+   }
+
+   /* Keep the headroom as the state grows, without another measuring save */
+   if (state_size_engine == g_engine && (size_t)state.pos() > state_size - state_size / 3)
+      set_state_size(state.pos());
+   return true;
+}
+
+bool retro_unserialize(const void * data, size_t size)
+{
+   state_in = data;
+   state_in_size = size;
+   return run_state_request(STATE_REQUEST_LOAD);
+}
+
 unsigned retro_get_region (void) { return RETRO_REGION_NTSC; }
 
 #if (defined(GEKKO) && !defined(WIIU)) || defined(__CELLOS_LV2__)
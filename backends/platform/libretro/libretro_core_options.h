@@ -138,6 +138,55 @@ struct retro_core_option_definition option_defs_us[] = {
       "disabled"
 #endif
    },
+   {
+      "scummvm_perf_stats",
+      "Performance Statistics",
+      "Collects frame, engine, screen conversion and audio mixing times. 'log' writes a summary to the frontend log once a second, 'overlay' also shows it on screen (not with hardware rendering).",
+      {
+         { "disabled", NULL },
+         { "log",      NULL },
+         { "overlay",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#ifdef HAVE_THREADS
+   {
+      "scummvm_threaded",
+      "Threaded Emulation (Restart)",
+      "Runs the game engine on its own thread instead of in lockstep with the frontend, so game logic and video presentation can use separate CPU cores. Helps demanding high resolution games on multi-core devices. Not used together with hardware rendering.",
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "scummvm_audio_callback",
+      "Threaded Audio Mixing (Restart)",
+      "Mixes audio on the frontend's audio thread when it asks for more, instead of once per video frame. This lowers audio latency and keeps mixing out of the video frame budget, which can avoid crackling on slow devices.",
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#endif
+#if defined(HAVE_OPENGL) && defined(FRONTEND_SUPPORTS_RGB565)
+   {
+      "scummvm_hw_render",
+      "Hardware Rendering (Restart)",
+      "Uses OpenGL to present the game. Palette conversion, cursor and GUI overlay compositing are done on the GPU instead of the CPU, which helps on low power hardware.",
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#endif
    { NULL, NULL, NULL, {{0}}, NULL },
 };
 
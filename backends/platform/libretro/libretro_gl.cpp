@@ -0,0 +1,438 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <string.h>
+
+#include "graphics/surface.libretro.h"
+#include "libretro_gl.h"
+
+extern retro_log_printf_t log_cb;
+
+/*
+ * Only a handful of GL ES 2 / GL 2 entry points are needed, so they are
+ * resolved through the frontend instead of depending on platform GL headers.
+ */
+#if defined(_WIN32) && !defined(_XBOX)
+#define RETRO_GLAPIENTRY __stdcall
+#else
+#define RETRO_GLAPIENTRY
+#endif
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned int GLbitfield;
+typedef float GLfloat;
+typedef unsigned char GLboolean;
+typedef char GLchar;
+
+#define GL_FALSE                  0
+#define GL_TRIANGLE_STRIP         0x0005
+#define GL_SRC_ALPHA              0x0302
+#define GL_ONE_MINUS_SRC_ALPHA    0x0303
+#define GL_BLEND                  0x0BE2
+#define GL_UNPACK_ALIGNMENT       0x0CF5
+#define GL_TEXTURE_2D             0x0DE1
+#define GL_UNSIGNED_BYTE          0x1401
+#define GL_FLOAT                  0x1406
+#define GL_RGB                    0x1907
+#define GL_RGBA                   0x1908
+#define GL_LUMINANCE              0x1909
+#define GL_NEAREST                0x2600
+#define GL_TEXTURE_MAG_FILTER     0x2800
+#define GL_TEXTURE_MIN_FILTER     0x2801
+#define GL_TEXTURE_WRAP_S         0x2802
+#define GL_TEXTURE_WRAP_T         0x2803
+#define GL_COLOR_BUFFER_BIT       0x4000
+#define GL_CLAMP_TO_EDGE          0x812F
+#define GL_UNSIGNED_SHORT_5_6_5   0x8363
+#define GL_TEXTURE0               0x84C0
+#define GL_TEXTURE1               0x84C1
+#define GL_FRAGMENT_SHADER        0x8B30
+#define GL_VERTEX_SHADER          0x8B31
+#define GL_COMPILE_STATUS         0x8B81
+#define GL_LINK_STATUS            0x8B82
+#define GL_FRAMEBUFFER            0x8D40
+
+#define GL_FUNCTIONS \
+   GL_FUNC(void, ActiveTexture, (GLenum texture)) \
+   GL_FUNC(void, AttachShader, (GLuint program, GLuint shader)) \
+   GL_FUNC(void, BindAttribLocation, (GLuint program, GLuint index, const GLchar *name)) \
+   GL_FUNC(void, BindFramebuffer, (GLenum target, GLuint framebuffer)) \
+   GL_FUNC(void, BindTexture, (GLenum target, GLuint texture)) \
+   GL_FUNC(void, BlendFunc, (GLenum sfactor, GLenum dfactor)) \
+   GL_FUNC(void, Clear, (GLbitfield mask)) \
+   GL_FUNC(void, ClearColor, (GLfloat r, GLfloat g, GLfloat b, GLfloat a)) \
+   GL_FUNC(void, CompileShader, (GLuint shader)) \
+   GL_FUNC(GLuint, CreateProgram, (void)) \
+   GL_FUNC(GLuint, CreateShader, (GLenum type)) \
+   GL_FUNC(void, DeleteProgram, (GLuint program)) \
+   GL_FUNC(void, DeleteShader, (GLuint shader)) \
+   GL_FUNC(void, DeleteTextures, (GLsizei n, const GLuint *textures)) \
+   GL_FUNC(void, Disable, (GLenum cap)) \
+   GL_FUNC(void, DisableVertexAttribArray, (GLuint index)) \
+   GL_FUNC(void, DrawArrays, (GLenum mode, GLint first, GLsizei count)) \
+   GL_FUNC(void, Enable, (GLenum cap)) \
+   GL_FUNC(void, EnableVertexAttribArray, (GLuint index)) \
+   GL_FUNC(void, GenTextures, (GLsizei n, GLuint *textures)) \
+   GL_FUNC(void, GetProgramiv, (GLuint program, GLenum pname, GLint *params)) \
+   GL_FUNC(void, GetShaderiv, (GLuint shader, GLenum pname, GLint *params)) \
+   GL_FUNC(GLint, GetUniformLocation, (GLuint program, const GLchar *name)) \
+   GL_FUNC(void, LinkProgram, (GLuint program)) \
+   GL_FUNC(void, PixelStorei, (GLenum pname, GLint param)) \
+   GL_FUNC(void, ShaderSource, (GLuint shader, GLsizei count, const GLchar *const *string, const GLint *length)) \
+   GL_FUNC(void, TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)) \
+   GL_FUNC(void, TexParameteri, (GLenum target, GLenum pname, GLint param)) \
+   GL_FUNC(void, TexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)) \
+   GL_FUNC(void, Uniform1i, (GLint location, GLint v0)) \
+   GL_FUNC(void, UseProgram, (GLuint program)) \
+   GL_FUNC(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)) \
+   GL_FUNC(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height))
+
+#define GL_FUNC(ret, name, args) typedef ret (RETRO_GLAPIENTRY *PFN_gl##name) args; static PFN_gl##name gl##name = NULL;
+GL_FUNCTIONS
+#undef GL_FUNC
+
+enum
+{
+   ATTRIB_POSITION = 0,
+   ATTRIB_TEXCOORD = 1
+};
+
+struct RetroGLProgram
+{
+   GLuint program;
+   GLint texture;
+   GLint palette;
+};
+
+struct RetroGLTexture
+{
+   GLuint id;
+   int width;
+   int height;
+   GLenum format;
+   GLenum type;
+};
+
+static struct retro_hw_render_callback s_hwRender;
+static bool s_contextReady = false;
+static bool s_frameLost = true;
+
+static RetroGLProgram s_indexedProgram;
+static RetroGLProgram s_rgbProgram;
+static RetroGLTexture s_imageTexture;
+static RetroGLTexture s_paletteTexture;
+static RetroGLTexture s_cursorTexture;
+
+static const char *s_vertexShader =
+   "attribute vec2 aPosition;\n"
+   "attribute vec2 aTexCoord;\n"
+   "varying vec2 vTexCoord;\n"
+   "void main() {\n"
+   "   vTexCoord = aTexCoord;\n"
+   "   gl_Position = vec4(aPosition, 0.0, 1.0);\n"
+   "}\n";
+
+// The palette lookup happens here instead of on the CPU
+static const char *s_indexedFragmentShader =
+   "#ifdef GL_ES\n"
+   "precision mediump float;\n"
+   "#endif\n"
+   "uniform sampler2D uTexture;\n"
+   "uniform sampler2D uPalette;\n"
+   "varying vec2 vTexCoord;\n"
+   "void main() {\n"
+   "   float index = texture2D(uTexture, vTexCoord).r;\n"
+   "   gl_FragColor = texture2D(uPalette, vec2(index * (255.0 / 256.0) + (0.5 / 256.0), 0.5));\n"
+   "}\n";
+
+static const char *s_rgbFragmentShader =
+   "#ifdef GL_ES\n"
+   "precision mediump float;\n"
+   "#endif\n"
+   "uniform sampler2D uTexture;\n"
+   "varying vec2 vTexCoord;\n"
+   "void main() {\n"
+   "   gl_FragColor = texture2D(uTexture, vTexCoord);\n"
+   "}\n";
+
+static GLuint compileShader(GLenum aType, const char *aSource)
+{
+   GLuint shader = glCreateShader(aType);
+   glShaderSource(shader, 1, &aSource, NULL);
+   glCompileShader(shader);
+
+   GLint status = 0;
+   glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+   if (!status)
+   {
+      if (log_cb)
+         log_cb(RETRO_LOG_ERROR, "[scummvm] Failed to compile shader.\n");
+      glDeleteShader(shader);
+      return 0;
+   }
+
+   return shader;
+}
+
+static bool createProgram(RetroGLProgram &aProgram, const char *aFragmentSource)
+{
+   GLuint vertex = compileShader(GL_VERTEX_SHADER, s_vertexShader);
+   GLuint fragment = compileShader(GL_FRAGMENT_SHADER, aFragmentSource);
+   if (!vertex || !fragment)
+      return false;
+
+   aProgram.program = glCreateProgram();
+   glAttachShader(aProgram.program, vertex);
+   glAttachShader(aProgram.program, fragment);
+   glBindAttribLocation(aProgram.program, ATTRIB_POSITION, "aPosition");
+   glBindAttribLocation(aProgram.program, ATTRIB_TEXCOORD, "aTexCoord");
+   glLinkProgram(aProgram.program);
+   glDeleteShader(vertex);
+   glDeleteShader(fragment);
+
+   GLint status = 0;
+   glGetProgramiv(aProgram.program, GL_LINK_STATUS, &status);
+   if (!status)
+   {
+      if (log_cb)
+         log_cb(RETRO_LOG_ERROR, "[scummvm] Failed to link shader program.\n");
+      glDeleteProgram(aProgram.program);
+      aProgram.program = 0;
+      return false;
+   }
+
+   aProgram.texture = glGetUniformLocation(aProgram.program, "uTexture");
+   aProgram.palette = glGetUniformLocation(aProgram.program, "uPalette");
+   return true;
+}
+
+/**
+ * Upload pixels into a texture, only reallocating the texture storage when
+ * the size or format changes.
+ */
+static void uploadTexture(RetroGLTexture &aTexture, int aWidth, int aHeight, GLenum aFormat, GLenum aType, const void *aPixels)
+{
+   if (!aTexture.id)
+   {
+      glGenTextures(1, &aTexture.id);
+      glBindTexture(GL_TEXTURE_2D, aTexture.id);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+   }
+   else
+      glBindTexture(GL_TEXTURE_2D, aTexture.id);
+
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+   if (aTexture.width != aWidth || aTexture.height != aHeight || aTexture.format != aFormat || aTexture.type != aType)
+   {
+      glTexImage2D(GL_TEXTURE_2D, 0, aFormat, aWidth, aHeight, 0, aFormat, aType, aPixels);
+      aTexture.width = aWidth;
+      aTexture.height = aHeight;
+      aTexture.format = aFormat;
+      aTexture.type = aType;
+   }
+   else
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, aWidth, aHeight, aFormat, aType, aPixels);
+}
+
+static void deleteTexture(RetroGLTexture &aTexture)
+{
+   if (aTexture.id && s_contextReady)
+      glDeleteTextures(1, &aTexture.id);
+   memset(&aTexture, 0, sizeof(aTexture));
+}
+
+static void drawQuad(float aLeft, float aTop, float aRight, float aBottom)
+{
+   const GLfloat position[] = {
+      aLeft,  aBottom,
+      aRight, aBottom,
+      aLeft,  aTop,
+      aRight, aTop
+   };
+   static const GLfloat texCoord[] = {
+      0.0f, 1.0f,
+      1.0f, 1.0f,
+      0.0f, 0.0f,
+      1.0f, 0.0f
+   };
+
+   glVertexAttribPointer(ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, 0, position);
+   glVertexAttribPointer(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, texCoord);
+   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
+static void contextReset(void)
+{
+   s_contextReady = false;
+   memset(&s_imageTexture, 0, sizeof(s_imageTexture));
+   memset(&s_paletteTexture, 0, sizeof(s_paletteTexture));
+   memset(&s_cursorTexture, 0, sizeof(s_cursorTexture));
+
+#define GL_FUNC(ret, name, args) \
+   gl##name = (PFN_gl##name)s_hwRender.get_proc_address("gl" #name); \
+   if (!gl##name) \
+   { \
+      if (log_cb) \
+         log_cb(RETRO_LOG_ERROR, "[scummvm] Missing GL function gl%s.\n", #name); \
+      return; \
+   }
+   GL_FUNCTIONS
+#undef GL_FUNC
+
+   if (!createProgram(s_indexedProgram, s_indexedFragmentShader) || !createProgram(s_rgbProgram, s_rgbFragmentShader))
+      return;
+
+   s_contextReady = true;
+   s_frameLost = true;
+}
+
+static void contextDestroy(void)
+{
+   if (s_contextReady)
+   {
+      deleteTexture(s_imageTexture);
+      deleteTexture(s_paletteTexture);
+      deleteTexture(s_cursorTexture);
+      glDeleteProgram(s_indexedProgram.program);
+      glDeleteProgram(s_rgbProgram.program);
+   }
+
+   memset(&s_indexedProgram, 0, sizeof(s_indexedProgram));
+   memset(&s_rgbProgram, 0, sizeof(s_rgbProgram));
+   s_contextReady = false;
+}
+
+bool retroGLSetup(retro_environment_t aEnviron)
+{
+   memset(&s_hwRender, 0, sizeof(s_hwRender));
+   s_hwRender.context_type = RETRO_HW_CONTEXT_OPENGL;
+   s_hwRender.context_reset = contextReset;
+   s_hwRender.context_destroy = contextDestroy;
+   s_hwRender.bottom_left_origin = true;
+
+   if (aEnviron(RETRO_ENVIRONMENT_SET_HW_RENDER, &s_hwRender))
+      return true;
+
+   s_hwRender.context_type = RETRO_HW_CONTEXT_OPENGLES2;
+   return aEnviron(RETRO_ENVIRONMENT_SET_HW_RENDER, &s_hwRender);
+}
+
+bool retroGLIsActive()
+{
+   return s_contextReady;
+}
+
+bool retroGLNeedsRedraw()
+{
+   return s_frameLost;
+}
+
+void retroGLRender(const RetroGLFrame &aFrame)
+{
+   const Graphics::Surface &image = *aFrame.image;
+
+   glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)s_hwRender.get_current_framebuffer());
+   glViewport(0, 0, image.w, image.h);
+   glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+   glClear(GL_COLOR_BUFFER_BIT);
+
+   // The frontend may have changed the context state since the last frame
+   glDisable(GL_BLEND);
+   glEnableVertexAttribArray(ATTRIB_POSITION);
+   glEnableVertexAttribArray(ATTRIB_TEXCOORD);
+
+   // A texture change also needs the pixels to be uploaded again
+   const bool reuploadImage = aFrame.imageChanged || s_imageTexture.width != image.w || s_imageTexture.height != image.h;
+
+   if (aFrame.palette)
+   {
+      glActiveTexture(GL_TEXTURE1);
+      if (aFrame.paletteChanged || !s_paletteTexture.id)
+         uploadTexture(s_paletteTexture, 256, 1, GL_RGB, GL_UNSIGNED_BYTE, aFrame.palette);
+      else
+         glBindTexture(GL_TEXTURE_2D, s_paletteTexture.id);
+
+      glActiveTexture(GL_TEXTURE0);
+      if (reuploadImage || s_imageTexture.format != GL_LUMINANCE)
+         uploadTexture(s_imageTexture, image.w, image.h, GL_LUMINANCE, GL_UNSIGNED_BYTE, image.getPixels());
+      else
+         glBindTexture(GL_TEXTURE_2D, s_imageTexture.id);
+
+      glUseProgram(s_indexedProgram.program);
+      glUniform1i(s_indexedProgram.texture, 0);
+      glUniform1i(s_indexedProgram.palette, 1);
+   }
+   else
+   {
+      glActiveTexture(GL_TEXTURE0);
+      if (reuploadImage || s_imageTexture.format != GL_RGB)
+         uploadTexture(s_imageTexture, image.w, image.h, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, image.getPixels());
+      else
+         glBindTexture(GL_TEXTURE_2D, s_imageTexture.id);
+
+      glUseProgram(s_rgbProgram.program);
+      glUniform1i(s_rgbProgram.texture, 0);
+   }
+
+   drawQuad(-1.0f, 1.0f, 1.0f, -1.0f);
+
+   // The cursor is a separate blended quad on top of the screen
+   if (aFrame.cursor && aFrame.cursor->w && aFrame.cursor->h)
+   {
+      const Graphics::Surface &cursor = *aFrame.cursor;
+
+      glActiveTexture(GL_TEXTURE0);
+      if (aFrame.cursorChanged || !s_cursorTexture.id)
+         uploadTexture(s_cursorTexture, cursor.w, cursor.h, GL_RGBA, GL_UNSIGNED_BYTE, cursor.getPixels());
+      else
+         glBindTexture(GL_TEXTURE_2D, s_cursorTexture.id);
+
+      glUseProgram(s_rgbProgram.program);
+      glUniform1i(s_rgbProgram.texture, 0);
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+      const float left = (aFrame.cursorX * 2.0f) / image.w - 1.0f;
+      const float top = 1.0f - (aFrame.cursorY * 2.0f) / image.h;
+      const float right = ((aFrame.cursorX + cursor.w) * 2.0f) / image.w - 1.0f;
+      const float bottom = 1.0f - ((aFrame.cursorY + cursor.h) * 2.0f) / image.h;
+      drawQuad(left, top, right, bottom);
+
+      glDisable(GL_BLEND);
+   }
+
+   glDisableVertexAttribArray(ATTRIB_POSITION);
+   glDisableVertexAttribArray(ATTRIB_TEXCOORD);
+   glUseProgram(0);
+   glBindTexture(GL_TEXTURE_2D, 0);
+
+   s_frameLost = false;
+}
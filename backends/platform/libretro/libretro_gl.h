@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_LIBRETRO_GL_H
+#define BACKENDS_LIBRETRO_GL_H
+
+#include "libretro.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+/**
+ * Everything the GPU presentation needs for one frame. Images are only
+ * uploaded again when flagged as changed.
+ */
+struct RetroGLFrame
+{
+   /** The game screen (CLUT8 when palette is set, RGB565 otherwise) */
+   const Graphics::Surface *image;
+   /** 256 RGB triplets for CLUT8 images, NULL otherwise */
+   const unsigned char *palette;
+   bool imageChanged;
+   bool paletteChanged;
+
+   /** The cursor already converted to RGBA8888 byte order, or NULL */
+   const Graphics::Surface *cursor;
+   bool cursorChanged;
+   int cursorX;
+   int cursorY;
+};
+
+/**
+ * Ask the frontend for an OpenGL context. Must be called from retro_load_game.
+ * @return true if the frontend will provide hardware rendering
+ */
+bool retroGLSetup(retro_environment_t aEnviron);
+
+/** Whether a context was set up and is currently usable. */
+bool retroGLIsActive();
+
+/** Whether the framebuffer contents were lost, e.g. after a context reset. */
+bool retroGLNeedsRedraw();
+
+/** Draw the frame into the frontend's framebuffer. */
+void retroGLRender(const RetroGLFrame &aFrame);
+
+#endif
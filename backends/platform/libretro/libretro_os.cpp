@@ -32,7 +32,13 @@
 #include "graphics/surface.libretro.h"
 #include "backends/base-backend.h"
 #include "common/events.h"
+#include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/profiler.h"
+#include "common/serializer.h"
+#include "common/substream.h"
 #include "audio/mixer_intern.h"
+#include "engines/engine.h"
 
 #if defined(_WIN32)
 #include "backends/fs/windows/windows-fs-factory.h"
@@ -44,6 +50,8 @@
 
 #include "backends/timer/default/default-timer.h"
 #include "graphics/colormasks.h"
+#include "graphics/font.h"
+#include "graphics/fontman.h"
 #include "graphics/palette.h"
 #include "backends/saves/default/default-saves.h"
 #if defined(_WIN32)
@@ -61,7 +69,18 @@
 #include <time.h>
 #endif
 
+#ifdef HAVE_THREADS
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+#include "libretro_thread.h"
+#endif
+
 #include "libretro.h"
+#include "libretro_perf.h"
+#ifdef HAVE_OPENGL
+#include "libretro_gl.h"
+#endif
 
 extern retro_log_printf_t log_cb;
 
@@ -90,135 +109,104 @@ struct RetroPalette
    }
 };
 
-static INLINE void blit_uint8_uint16_fast(Graphics::Surface& aOut, const Graphics::Surface& aIn, const RetroPalette& aColors)
+template<typename OutT>
+static INLINE void blit_clut(Graphics::Surface& aOut, const Graphics::Surface& aIn, const RetroPalette& aColors, const Common::Rect& aArea)
 {
-   for(int i = 0; i < aIn.h; i ++)
+   for(int i = aArea.top; i < aArea.bottom; i ++)
    {
-      if(i >= aOut.h)
+      if(i >= aOut.h || i >= aIn.h)
          continue;
 
-      uint8_t * const in  = (uint8_t*)aIn.pixels + (i * aIn.w);
-      uint16_t* const out = (uint16_t*)aOut.pixels + (i * aOut.w);
+      const uint8_t* const in = (const uint8_t*)aIn.getBasePtr(0, i);
+      OutT* const out = (OutT*)aOut.getBasePtr(0, i);
 
-      for(int j = 0; j < aIn.w; j ++)
+      for(int j = aArea.left; j < aArea.right; j ++)
       {
-         if (j >= aOut.w)
+         if (j >= aOut.w || j >= aIn.w)
             continue;
 
-         uint8 r, g, b;
-
-         const uint8_t val = in[j];
-         if(val != 0xFFFFFFFF)
-         {
-            if(aIn.format.bytesPerPixel == 1)
-            {
-               unsigned char *col = aColors.getColor(val);
-               r = *col++;
-               g = *col++;
-               b = *col++;
-            }
-            else
-               aIn.format.colorToRGB(in[j], r, g, b);
-
-            out[j] = aOut.format.RGBToColor(r, g, b);
-         }
+         const unsigned char *col = aColors.getColor(in[j]);
+         out[j] = aOut.format.RGBToColor(col[0], col[1], col[2]);
       }
    }
 }
 
-static INLINE void blit_uint32_uint16(Graphics::Surface& aOut, const Graphics::Surface& aIn, const RetroPalette& aColors)
+template<typename InT, typename OutT>
+static INLINE void blit_rgb(Graphics::Surface& aOut, const Graphics::Surface& aIn, const Common::Rect& aArea)
 {
-   for(int i = 0; i < aIn.h; i ++)
+   for(int i = aArea.top; i < aArea.bottom; i ++)
    {
-      if(i >= aOut.h)
+      if(i >= aOut.h || i >= aIn.h)
          continue;
 
-      uint32_t* const in = (uint32_t*)aIn.pixels + (i * aIn.w);
-      uint16_t* const out = (uint16_t*)aOut.pixels + (i * aOut.w);
+      const InT* const in = (const InT*)aIn.getBasePtr(0, i);
+      OutT* const out = (OutT*)aOut.getBasePtr(0, i);
 
-      for(int j = 0; j < aIn.w; j ++)
+      for(int j = aArea.left; j < aArea.right; j ++)
       {
-         if(j >= aOut.w)
+         if(j >= aOut.w || j >= aIn.w)
             continue;
 
          uint8 r, g, b;
-
-         const uint32_t val = in[j];
-         if(val != 0xFFFFFFFF)
-         {
-            aIn.format.colorToRGB(in[j], r, g, b);
-            out[j] = aOut.format.RGBToColor(r, g, b);
-         }
+         aIn.format.colorToRGB(in[j], r, g, b);
+         out[j] = aOut.format.RGBToColor(r, g, b);
       }
    }
 }
 
-static INLINE void blit_uint16_uint16(Graphics::Surface& aOut, const Graphics::Surface& aIn, const RetroPalette& aColors)
+// Source and target share the same layout, so whole rows can be copied
+static INLINE void blit_copy(Graphics::Surface& aOut, const Graphics::Surface& aIn, const Common::Rect& aArea)
 {
-   for(int i = 0; i < aIn.h; i ++)
+   const int bpp = aOut.format.bytesPerPixel;
+   const int right = MIN<int>(aArea.right, MIN(aIn.w, aOut.w));
+   if (aArea.left >= right)
+      return;
+
+   for(int i = aArea.top; i < aArea.bottom; i ++)
    {
-      if(i >= aOut.h)
+      if(i >= aOut.h || i >= aIn.h)
          continue;
 
-      uint16_t* const in = (uint16_t*)aIn.pixels + (i * aIn.w);
-      uint16_t* const out = (uint16_t*)aOut.pixels + (i * aOut.w);
-
-      for(int j = 0; j < aIn.w; j ++)
-      {
-         if(j >= aOut.w)
-            continue;
-
-         uint8 r, g, b;
-
-         const uint16_t val = in[j];
-         if(val != 0xFFFFFFFF)
-         {
-            aIn.format.colorToRGB(in[j], r, g, b);
-            out[j] = aOut.format.RGBToColor(r, g, b);
-         }
-      }
+      memcpy(aOut.getBasePtr(aArea.left, i), aIn.getBasePtr(aArea.left, i), (right - aArea.left) * bpp);
    }
 }
 
-static void blit_uint8_uint16(Graphics::Surface& aOut, const Graphics::Surface& aIn, int aX, int aY, const RetroPalette& aColors, uint32 aKeyColor)
+template<typename OutT>
+static void blit_clut_keyed(Graphics::Surface& aOut, const Graphics::Surface& aIn, int aX, int aY, const RetroPalette& aColors, uint32 aKeyColor)
 {
    for(int i = 0; i < aIn.h; i ++)
    {
       if((i + aY) < 0 || (i + aY) >= aOut.h)
          continue;
 
-      uint8_t* const in = (uint8_t*)aIn.pixels + (i * aIn.w);
-      uint16_t* const out = (uint16_t*)aOut.pixels + ((i + aY) * aOut.w);
+      const uint8_t* const in = (const uint8_t*)aIn.getBasePtr(0, i);
+      OutT* const out = (OutT*)aOut.getBasePtr(0, i + aY);
 
       for(int j = 0; j < aIn.w; j ++)
       {
          if((j + aX) < 0 || (j + aX) >= aOut.w)
             continue;
 
-         uint8 r, g, b;
-
          const uint8_t val = in[j];
          if(val != aKeyColor)
          {
-            unsigned char *col = aColors.getColor(val);
-            r = *col++;
-            g = *col++;
-            b = *col++;
-            out[j + aX] = aOut.format.RGBToColor(r, g, b);
+            const unsigned char *col = aColors.getColor(val);
+            out[j + aX] = aOut.format.RGBToColor(col[0], col[1], col[2]);
          }
       }
    }
 }
 
-static void blit_uint16_uint16(Graphics::Surface& aOut, const Graphics::Surface& aIn, int aX, int aY, const RetroPalette& aColors, uint32 aKeyColor)
+template<typename InT, typename OutT>
+static void blit_rgb_keyed(Graphics::Surface& aOut, const Graphics::Surface& aIn, int aX, int aY, uint32 aKeyColor)
 {
    for(int i = 0; i < aIn.h; i ++)
    {
       if((i + aY) < 0 || (i + aY) >= aOut.h)
          continue;
 
-      uint16_t* const in = (uint16_t*)aIn.pixels + (i * aIn.w);
-      uint16_t* const out = (uint16_t*)aOut.pixels + ((i + aY) * aOut.w);
+      const InT* const in = (const InT*)aIn.getBasePtr(0, i);
+      OutT* const out = (OutT*)aOut.getBasePtr(0, i + aY);
 
       for(int j = 0; j < aIn.w; j ++)
       {
@@ -227,16 +215,50 @@ static void blit_uint16_uint16(Graphics::Surface& aOut, const Graphics::Surface&
 
          uint8 r, g, b;
 
-         const uint16_t val = in[j];
+         const InT val = in[j];
          if(val != aKeyColor)
          {
-            aIn.format.colorToRGB(in[j], r, g, b);
+            aIn.format.colorToRGB(val, r, g, b);
             out[j + aX] = aOut.format.RGBToColor(r, g, b);
          }
       }
    }
 }
 
+template<typename OutT>
+static void blit_area(Graphics::Surface& aOut, const Graphics::Surface& aIn, const RetroPalette& aColors, const Common::Rect& aArea)
+{
+   switch(aIn.format.bytesPerPixel)
+   {
+      case 1:
+         blit_clut<OutT>(aOut, aIn, aColors, aArea);
+         break;
+      case 2:
+         blit_rgb<uint16_t, OutT>(aOut, aIn, aArea);
+         break;
+      case 4:
+         blit_rgb<uint32_t, OutT>(aOut, aIn, aArea);
+         break;
+   }
+}
+
+template<typename OutT>
+static void blit_keyed(Graphics::Surface& aOut, const Graphics::Surface& aIn, int aX, int aY, const RetroPalette& aColors, uint32 aKeyColor)
+{
+   switch(aIn.format.bytesPerPixel)
+   {
+      case 1:
+         blit_clut_keyed<OutT>(aOut, aIn, aX, aY, aColors, aKeyColor);
+         break;
+      case 2:
+         blit_rgb_keyed<uint16_t, OutT>(aOut, aIn, aX, aY, aKeyColor);
+         break;
+      case 4:
+         blit_rgb_keyed<uint32_t, OutT>(aOut, aIn, aX, aY, aKeyColor);
+         break;
+   }
+}
+
 static INLINE void copyRectToSurface(uint8_t *pixels, int out_pitch, const uint8_t *src, int pitch, int x, int y, int w, int h, int out_bpp)
 {
    uint8_t *dst = pixels + y * out_pitch + x * out_bpp;
@@ -249,8 +271,120 @@ static INLINE void copyRectToSurface(uint8_t *pixels, int out_pitch, const uint8
    }while(--h);
 }
 
+/**
+ * Forwards writes to a stream owned by somebody else, so that the OutSaveFile
+ * deleting its wrapped stream does not dispose of the captured state.
+ */
+class RetroCaptureStream : public Common::WriteStream
+{
+   public:
+      RetroCaptureStream(Common::WriteStream *aOut) : _out(aOut), _start(aOut->pos()) {}
+
+      virtual uint32 write(const void *dataPtr, uint32 dataSize) { return _out->write(dataPtr, dataSize); }
+      virtual int32 pos() const { return _out->pos() - _start; }
+      virtual bool err() const { return _out->err(); }
+      virtual void clearErr() { _out->clearErr(); }
+
+   private:
+      Common::WriteStream *_out;
+      int32 _start;
+};
+
+/**
+ * Savefile manager which can redirect a single save or load to memory. This
+ * lets the core snapshot engines that only implement slot based saving,
+ * without touching the disk.
+ */
+class RetroSaveFileManager : public DefaultSaveFileManager
+{
+   public:
+      RetroSaveFileManager(const Common::String &aPath) :
+         DefaultSaveFileManager(aPath), _capture(0), _restoreData(0), _restoreSize(0)
+      {
+      }
+
+      void beginCapture(Common::WriteStream *aOut)
+      {
+         _capture = aOut;
+      }
+
+      bool endCapture()
+      {
+         // The capture stream is cleared once the engine opened it
+         const bool captured = !_capture;
+         _capture = 0;
+         return captured;
+      }
+
+      void beginRestore(const byte *aData, uint32 aSize)
+      {
+         _restoreData = aData;
+         _restoreSize = aSize;
+      }
+
+      bool endRestore()
+      {
+         const bool restored = !_restoreData;
+         _restoreData = 0;
+         return restored;
+      }
+
+      virtual Common::InSaveFile *openForLoading(const Common::String &filename)
+      {
+         if (_restoreData)
+         {
+            Common::InSaveFile *file = new Common::MemoryReadStream(_restoreData, _restoreSize);
+            _restoreData = 0;
+            return file;
+         }
+
+         return DefaultSaveFileManager::openForLoading(filename);
+      }
+
+      virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true)
+      {
+         if (_capture)
+         {
+            Common::OutSaveFile *file = new Common::OutSaveFile(new RetroCaptureStream(_capture));
+            _capture = 0;
+            return file;
+         }
+
+         return DefaultSaveFileManager::openForSaving(filename, compress);
+      }
+
+   private:
+      Common::WriteStream *_capture;
+      const byte *_restoreData;
+      uint32 _restoreSize;
+};
+
 static Common::String s_systemDir;
 static Common::String s_saveDir;
+// Whether the frontend takes XRGB8888 frames, chosen once at load time
+static bool s_trueColorOutput = false;
+static bool s_hwRender = false;
+static uint32 s_frameInterval = 1000 / 60;
+static bool s_perfOverlay = false;
+
+// Native output format of frontends using RETRO_PIXEL_FORMAT_XRGB8888
+static const Graphics::PixelFormat s_xrgb8888Format(4, 8, 8, 8, 0, 16, 8, 0, 0);
+
+// Formats the hardware renderer can upload without conversion
+static const Graphics::PixelFormat s_rgb565Format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+#ifdef SCUMM_BIG_ENDIAN
+static const Graphics::PixelFormat s_rgbaBytesFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+#else
+static const Graphics::PixelFormat s_rgbaBytesFormat(4, 8, 8, 8, 8, 0, 8, 16, 24);
+#endif
+
+static INLINE bool sameColorLayout(const Graphics::PixelFormat &aA, const Graphics::PixelFormat &aB)
+{
+   // Alpha is ignored by the frontend, so it does not matter here
+   return aA.bytesPerPixel == aB.bytesPerPixel &&
+      aA.rLoss == aB.rLoss && aA.gLoss == aB.gLoss && aA.bLoss == aB.bLoss &&
+      aA.rShift == aB.rShift && aA.gShift == aB.gShift && aA.bShift == aB.bShift;
+}
 
 #ifdef FRONTEND_SUPPORTS_RGB565
 #define SURF_BPP 2
@@ -284,6 +418,26 @@ static Common::String s_saveDir;
 
 std::list<Common::Event> _events;
 
+#ifdef HAVE_THREADS
+// When the emulator runs on its own thread, input still arrives on the
+// frontend thread and is handed over to pollEvent() through this queue.
+static bool s_threaded = false;
+static RetroSPSCQueue<Common::Event, 256> s_inputQueue;
+#endif
+
+static void queueEvent(const Common::Event &ev)
+{
+#ifdef HAVE_THREADS
+   if (s_threaded)
+   {
+      if (!s_inputQueue.push(ev) && log_cb)
+         log_cb(RETRO_LOG_WARN, "[scummvm] Input queue full, dropping event.\n");
+      return;
+   }
+#endif
+   _events.push_back(ev);
+}
+
 class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
    public:
       Graphics::Surface _screen;
@@ -294,12 +448,39 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       Graphics::Surface _overlay;
       bool _overlayVisible;
 
+      // Area of the source surface which changed since the last conversion
+      Common::Rect _dirtyRect;
+      // Area the cursor was last drawn to
+      Common::Rect _cursorRect;
+      bool _cursorDirty;
+      // Whether _screen changed since the frontend last fetched it
+      bool _screenUpdated;
+      // Whether the game surface is handed to the frontend as is
+      bool _directOutput;
+
+      // Engine memory exposed through retro_get_memory_data()
+      void *_memoryData[kMemoryRegionCount];
+      uint32 _memorySize[kMemoryRegionCount];
+
+      // Performance stats drawn over the frame, see drawPerfOverlay()
+      Common::String _perfText;
+      Common::Rect _perfRect;
+
+      // Hardware rendering state, see updateScreenHW()
+      Graphics::Surface _cursorRGBA;
+      bool _hwImageChanged;
+      bool _hwPaletteChanged;
+      bool _hwCursorChanged;
+
       Graphics::Surface _mouseImage;
       RetroPalette _mousePalette;
       bool _mousePaletteEnabled;
       bool _mouseVisible;
       int _mouseX;
       int _mouseY;
+      // Guards the mouse position. processMouse() moves it on the frontend
+      // thread, while the engine reads and warps it on the emulator thread.
+      MutexRef _mouseMutex;
       float _mouseXAcc;
       float _mouseYAcc;
       int _mouseHotspotX;
@@ -315,6 +496,14 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 
       uint32 _startTime;
       uint32 _threadExitTime;
+
+      // Frame pacing, see leaveFrame()
+      uint32 _frameStartTime;
+      uint32 _frameSleepTime;
+      uint32 _frameBudgetUsage;
+      uint32 _budgetUsageSum;
+      uint32 _budgetUsagePeak;
+      uint32 _budgetFrames;
       
       bool _speed_hack_enabled;
 
@@ -325,17 +514,25 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       OSystem_RETRO(bool aEnableSpeedHack) :
          _mousePaletteEnabled(false), _mouseVisible(false),
          _mouseX(0), _mouseY(0), _mouseXAcc(0.0), _mouseYAcc(0.0), _mouseHotspotX(0), _mouseHotspotY(0),
-         _mouseKeyColor(0), _mouseDontScale(false),
+         _mouseKeyColor(0), _mouseDontScale(false), _overlayVisible(false),
+         _cursorDirty(false), _screenUpdated(false), _directOutput(false),
+         _hwImageChanged(true), _hwPaletteChanged(true), _hwCursorChanged(true),
          _joypadnumpadLast(8), _joypadnumpadActive(false),
          _mixer(0), _startTime(0), _threadExitTime(10),
+         _frameStartTime(0), _frameSleepTime(0), _frameBudgetUsage(0),
+         _budgetUsageSum(0), _budgetUsagePeak(0), _budgetFrames(0),
          _speed_hack_enabled(aEnableSpeedHack)
    {
       _fsFactory = new FS_SYSTEM_FACTORY();
+      _mouseMutex = createMutex();
       memset(_mouseButtons, 0, sizeof(_mouseButtons));
       memset(_joypadmouseButtons, 0, sizeof(_joypadmouseButtons));
       memset(_joypadkeyboardButtons, 0, sizeof(_joypadkeyboardButtons));
+      memset(_memoryData, 0, sizeof(_memoryData));
+      memset(_memorySize, 0, sizeof(_memorySize));
 
       _startTime = getMillis();
+      _threadExitTime = getFrameSlice();
 
       if(s_systemDir.empty())
          s_systemDir = ".";
@@ -349,20 +546,22 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
          _gameScreen.free();
          _overlay.free();
          _mouseImage.free();
+         _cursorRGBA.free();
          _screen.free();
 
          delete _mixer;
+         deleteMutex(_mouseMutex);
       }
 
       virtual void initBackend()
       {
-         _savefileManager = new DefaultSaveFileManager(s_saveDir);
+         _savefileManager = new RetroSaveFileManager(s_saveDir);
 #ifdef FRONTEND_SUPPORTS_RGB565
          _overlay.create(RES_W, RES_H, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 #else
          _overlay.create(RES_W, RES_H, Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15));
 #endif
-         _mixer = new Audio::MixerImpl(44100);
+         _mixer = new Audio::MixerImpl(RETRO_AUDIO_SAMPLE_RATE);
          _timerManager = new DefaultTimerManager();
 
          _mixer->setReady(true);
@@ -410,6 +609,8 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       virtual void initSize(uint width, uint height, const Graphics::PixelFormat *format)
       {
          _gameScreen.create(width, height, format ? *format : Graphics::PixelFormat::createFormatCLUT8());
+
+         markFullDirty();
       }
 
       virtual int16 getHeight()
@@ -431,6 +632,10 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       {
          Common::List<Graphics::PixelFormat> result;
 
+         /* ARGB8888 - matches the frontend's XRGB8888 output */
+         if (s_trueColorOutput)
+            result.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+
          /* RGBA8888 */
          result.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
 
@@ -454,6 +659,12 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       virtual void setPalette(const byte *colors, uint start, uint num)
       {
          _gamePalette.set(colors, start, num);
+         _hwPaletteChanged = true;
+
+         if (!_overlayVisible && _gameScreen.format.bytesPerPixel == 1)
+            markDirty(Common::Rect(_gameScreen.w, _gameScreen.h));
+         if (!_mousePaletteEnabled)
+            _cursorDirty = true;
       }
 
       virtual void grabPalette(byte *colors, uint start, uint num) const
@@ -468,39 +679,251 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
          const uint8_t *src = (const uint8_t*)buf;
          uint8_t *pix = (uint8_t*)_gameScreen.pixels;
          copyRectToSurface(pix, _gameScreen.pitch, src, pitch, x, y, w, h, _gameScreen.format.bytesPerPixel);
+
+         if (!_overlayVisible)
+            markDirty(Common::Rect(x, y, x + w, y + h));
       }
 
-      virtual void updateScreen()
+      void markDirty(const Common::Rect &aRect)
+      {
+         if (aRect.isEmpty())
+            return;
+
+         if (_dirtyRect.isEmpty())
+            _dirtyRect = aRect;
+         else
+            _dirtyRect.extend(aRect);
+      }
+
+      void markFullDirty()
       {
          const Graphics::Surface& srcSurface = (_overlayVisible) ? _overlay : _gameScreen;
-         if(srcSurface.w && srcSurface.h)
+         markDirty(Common::Rect(srcSurface.w, srcSurface.h));
+      }
+
+      bool canOutputDirect() const
+      {
+         return s_trueColorOutput && !_overlayVisible && !s_perfOverlay &&
+            sameColorLayout(_gameScreen.format, s_xrgb8888Format) &&
+            !(_mouseVisible && _mouseImage.w && _mouseImage.h);
+      }
+
+      Common::Rect getCursorRect() const
+      {
+         Common::Rect cursorRect;
+         if(_mouseVisible && _mouseImage.w && _mouseImage.h)
          {
-            switch(srcSurface.format.bytesPerPixel)
+            Common::StackLock lock(_mouseMutex);
+            cursorRect.left = _mouseX - _mouseHotspotX;
+            cursorRect.top = _mouseY - _mouseHotspotY;
+            cursorRect.setWidth(_mouseImage.w);
+            cursorRect.setHeight(_mouseImage.h);
+         }
+         return cursorRect;
+      }
+
+      static bool isHWNativeFormat(const Graphics::PixelFormat &aFormat)
+      {
+         return aFormat.bytesPerPixel == 1 || aFormat == s_rgb565Format;
+      }
+
+      void buildCursorRGBA()
+      {
+         if(_cursorRGBA.w != _mouseImage.w || _cursorRGBA.h != _mouseImage.h)
+            _cursorRGBA.create(_mouseImage.w, _mouseImage.h, s_rgbaBytesFormat);
+
+         const RetroPalette& cursorPalette = _mousePaletteEnabled ? _mousePalette : _gamePalette;
+         for(int i = 0; i < _mouseImage.h; i ++)
+         {
+            uint32* const out = (uint32*)_cursorRGBA.getBasePtr(0, i);
+            for(int j = 0; j < _mouseImage.w; j ++)
             {
-               case 1:
-               case 3:
-                  blit_uint8_uint16_fast(_screen, srcSurface, _gamePalette);
-                  break;
-               case 2:
-                  blit_uint16_uint16(_screen, srcSurface, _gamePalette);
-                  break;
-               case 4:
-                  blit_uint32_uint16(_screen, srcSurface, _gamePalette);
-                  break;
+               uint32 val;
+               uint8 r, g, b;
+
+               if(_mouseImage.format.bytesPerPixel == 1)
+               {
+                  val = *(const uint8*)_mouseImage.getBasePtr(j, i);
+                  const unsigned char *col = cursorPalette.getColor(val);
+                  r = col[0];
+                  g = col[1];
+                  b = col[2];
+               }
+               else
+               {
+                  if(_mouseImage.format.bytesPerPixel == 2)
+                     val = *(const uint16*)_mouseImage.getBasePtr(j, i);
+                  else
+                     val = *(const uint32*)_mouseImage.getBasePtr(j, i);
+                  _mouseImage.format.colorToRGB(val, r, g, b);
+               }
+
+               out[j] = (val == (uint32)_mouseKeyColor) ? 0 : _cursorRGBA.format.ARGBToColor(255, r, g, b);
             }
          }
+      }
 
-         // Draw Mouse
-         if(_mouseVisible && _mouseImage.w && _mouseImage.h)
+      // With hardware rendering only the formats the GPU can not read need
+      // converting, the cursor is drawn by the renderer.
+      void updateScreenHW()
+      {
+         if(_cursorDirty)
          {
-            const int x = _mouseX - _mouseHotspotX;
-            const int y = _mouseY - _mouseHotspotY;
+            buildCursorRGBA();
+            _cursorDirty = false;
+            _hwCursorChanged = true;
+            _screenUpdated = true;
+         }
 
-            if(_mouseImage.format.bytesPerPixel == 1)
-               blit_uint8_uint16(_screen, _mouseImage, x, y, _mousePaletteEnabled ? _mousePalette : _gamePalette, _mouseKeyColor);
+         const Common::Rect cursorRect = getCursorRect();
+         if(cursorRect != _cursorRect)
+         {
+            _cursorRect = cursorRect;
+            _screenUpdated = true;
+         }
+
+         const Graphics::Surface& srcSurface = (_overlayVisible) ? _overlay : _gameScreen;
+         if(isHWNativeFormat(srcSurface.format))
+            _dirtyRect.clip(Common::Rect(srcSurface.w, srcSurface.h));
+         else
+            _dirtyRect.clip(Common::Rect(MIN(srcSurface.w, _screen.w), MIN(srcSurface.h, _screen.h)));
+         if(_dirtyRect.isEmpty())
+            return;
+
+         if(!isHWNativeFormat(srcSurface.format))
+            blit_area<uint16_t>(_screen, srcSurface, _gamePalette, _dirtyRect);
+
+         _dirtyRect = Common::Rect();
+         _hwImageChanged = true;
+         _screenUpdated = true;
+      }
+
+      void drawPerfOverlay(bool aForce)
+      {
+         const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont);
+         if(!font)
+            return;
+
+         if(!aForce && !_perfRect.isEmpty() && !_perfRect.intersects(_dirtyRect))
+            return;
+
+         Common::Rect textRect(2, 2, 2 + font->getStringWidth(_perfText) + 4, 2 + font->getFontHeight() + 2);
+         textRect.clip(Common::Rect(_screen.w, _screen.h));
+         _perfRect = textRect;
+         if(textRect.isEmpty())
+            return;
+
+         _screen.fillRect(textRect, 0);
+         font->drawString(&_screen, _perfText, textRect.left + 2, textRect.top + 1, textRect.width() - 2, _screen.format.RGBToColor(255, 255, 0));
+      }
+
+#ifdef HAVE_OPENGL
+      void renderGL()
+      {
+         const Graphics::Surface& srcSurface = (_overlayVisible) ? _overlay : _gameScreen;
+
+         RetroGLFrame frame;
+         frame.image = isHWNativeFormat(srcSurface.format) ? &srcSurface : &_screen;
+         frame.palette = (frame.image->format.bytesPerPixel == 1) ? _gamePalette._colors : NULL;
+         frame.imageChanged = _hwImageChanged;
+         frame.paletteChanged = _hwPaletteChanged;
+         frame.cursor = _cursorRect.isEmpty() ? NULL : &_cursorRGBA;
+         frame.cursorChanged = _hwCursorChanged;
+         frame.cursorX = _cursorRect.left;
+         frame.cursorY = _cursorRect.top;
+
+         retroGLRender(frame);
+
+         _hwImageChanged = false;
+         _hwPaletteChanged = false;
+         _hwCursorChanged = false;
+      }
+#endif
+
+      virtual void updateScreen()
+      {
+         PROFILE_ZONE("OSystem::updateScreen");
+         if(s_hwRender)
+         {
+            updateScreenHW();
+            return;
+         }
+
+         const bool direct = canOutputDirect();
+         if(direct != _directOutput)
+         {
+            _directOutput = direct;
+            _cursorDirty = true;
+            markFullDirty();
+         }
+
+         // Nothing to convert, the frontend reads the game surface directly
+         if(_directOutput)
+         {
+            if(!_dirtyRect.isEmpty())
+               _screenUpdated = true;
+            _dirtyRect = Common::Rect();
+            _cursorRect = Common::Rect();
+            return;
+         }
+
+         // The cursor is composited into _screen, so both where it was and
+         // where it is now need to be redrawn when it changes.
+         const Common::Rect cursorRect = getCursorRect();
+
+         if(_cursorDirty || cursorRect != _cursorRect)
+         {
+            markDirty(_cursorRect);
+            markDirty(cursorRect);
+            _cursorRect = cursorRect;
+            _cursorDirty = false;
+         }
+
+         // New stats: convert the old text area again before drawing the new one
+         bool perfChanged = false;
+         if(s_perfOverlay && _perfText != retroPerfSummary())
+         {
+            _perfText = retroPerfSummary();
+            markDirty(_perfRect);
+            perfChanged = true;
+         }
+         else if(!s_perfOverlay && !_perfRect.isEmpty())
+         {
+            markDirty(_perfRect);
+            _perfRect = Common::Rect();
+         }
+
+         const Graphics::Surface& srcSurface = (_overlayVisible) ? _overlay : _gameScreen;
+         _dirtyRect.clip(Common::Rect(MIN(srcSurface.w, _screen.w), MIN(srcSurface.h, _screen.h)));
+         if(_dirtyRect.isEmpty() && !perfChanged)
+            return;
+
+         RetroPerfScope convertScope(RETRO_PERF_CONVERT);
+         if(retro_perf_enabled)
+            retroPerfAddDirtyPixels(_dirtyRect.width() * _dirtyRect.height());
+
+         if(sameColorLayout(srcSurface.format, _screen.format))
+            blit_copy(_screen, srcSurface, _dirtyRect);
+         else if(_screen.format.bytesPerPixel == 4)
+            blit_area<uint32_t>(_screen, srcSurface, _gamePalette, _dirtyRect);
+         else
+            blit_area<uint16_t>(_screen, srcSurface, _gamePalette, _dirtyRect);
+
+         // Draw Mouse
+         if(!cursorRect.isEmpty() && cursorRect.intersects(_dirtyRect))
+         {
+            const RetroPalette& cursorPalette = _mousePaletteEnabled ? _mousePalette : _gamePalette;
+            if(_screen.format.bytesPerPixel == 4)
+               blit_keyed<uint32_t>(_screen, _mouseImage, cursorRect.left, cursorRect.top, cursorPalette, _mouseKeyColor);
             else
-               blit_uint16_uint16(_screen, _mouseImage, x, y, _mousePaletteEnabled ? _mousePalette : _gamePalette, _mouseKeyColor);
+               blit_keyed<uint16_t>(_screen, _mouseImage, cursorRect.left, cursorRect.top, cursorPalette, _mouseKeyColor);
          }
+
+         if(s_perfOverlay)
+            drawPerfOverlay(perfChanged);
+
+         _dirtyRect = Common::Rect();
+         _screenUpdated = true;
       }
 
       virtual Graphics::Surface *lockScreen()
@@ -510,7 +933,8 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 
       virtual void unlockScreen()
       {
-         /* EMPTY */
+         if (!_overlayVisible)
+            markDirty(Common::Rect(_gameScreen.w, _gameScreen.h));
       }
 
       virtual void setShakePos(int shakeXOffset, int shakeYOffset)
@@ -521,16 +945,21 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       virtual void showOverlay()
       {
          _overlayVisible = true;
+         markFullDirty();
       }
 
       virtual void hideOverlay()
       {
          _overlayVisible = false;
+         markFullDirty();
       }
 
       virtual void clearOverlay()
       {
          _overlay.fillRect(Common::Rect(_overlay.w, _overlay.h), 0);
+
+         if (_overlayVisible)
+            markFullDirty();
       }
 
       virtual void grabOverlay(void *buf, int pitch)
@@ -551,6 +980,9 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
          const uint8_t *src = (const uint8_t*)buf;
          uint8_t *pix = (uint8_t*)_overlay.pixels;
          copyRectToSurface(pix, _overlay.pitch, src, pitch, x, y, w, h, _overlay.format.bytesPerPixel);
+
+         if (_overlayVisible)
+            markDirty(Common::Rect(x, y, x + w, y + h));
       }
 
       virtual int16 getOverlayHeight()
@@ -579,6 +1011,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 
       virtual void warpMouse(int x, int y)
       {
+         Common::StackLock lock(_mouseMutex);
          _mouseX = x;
          _mouseY = y;
       }
@@ -598,31 +1031,76 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
          _mouseHotspotY = hotspotY;
          _mouseKeyColor = keycolor;
          _mouseDontScale = dontScale;
+         _cursorDirty = true;
       }
 
       virtual void setCursorPalette(const byte *colors, uint start, uint num)
       {
          _mousePalette.set(colors, start, num);
          _mousePaletteEnabled = true;
+         _cursorDirty = true;
       }
       
-		void retroCheckThread(uint32 offset = 0)
+      // The part of a frame the engine may run before handing control back,
+      // the rest is left to the frontend for presentation and vsync.
+      static uint32 getFrameSlice()
       {
-         if(_threadExitTime <= (getMillis() + offset))
-         {
-            extern void retro_leave_thread();
-            retro_leave_thread();
+         return MAX<uint32>(s_frameInterval * 6 / 10, 1);
+      }
 
-            _threadExitTime = getMillis() + 10;
+      void updateFrameBudget(uint32 now)
+      {
+         const uint32 elapsed = now - _frameStartTime;
+         const uint32 busy = (elapsed > _frameSleepTime) ? elapsed - _frameSleepTime : 0;
+         _frameBudgetUsage = busy * 100 / MAX<uint32>(s_frameInterval, 1);
+
+         _budgetUsageSum += _frameBudgetUsage;
+         _budgetUsagePeak = MAX(_budgetUsagePeak, _frameBudgetUsage);
+         if(++_budgetFrames == 600)
+         {
+            if(log_cb)
+               log_cb(RETRO_LOG_DEBUG, "[scummvm] Frame budget used: %u%% average, %u%% peak.\n", _budgetUsageSum / _budgetFrames, _budgetUsagePeak);
+            _budgetUsageSum = 0;
+            _budgetUsagePeak = 0;
+            _budgetFrames = 0;
          }
       }
 
+      void leaveFrame()
+      {
+         extern void retro_leave_thread();
+
+         updateFrameBudget(getMillis());
+         retro_leave_thread();
+
+         _frameStartTime = getMillis();
+         _frameSleepTime = 0;
+         _threadExitTime = _frameStartTime + getFrameSlice();
+      }
+
+      void sleepMillis(uint32 msecs)
+      {
+         retro_sleep(msecs);
+         _frameSleepTime += msecs;
+      }
+
+		void retroCheckThread(uint32 offset = 0)
+      {
+         if(_threadExitTime <= (getMillis() + offset))
+            leaveFrame();
+      }
+
       virtual bool pollEvent(Common::Event &event)
       {
          retroCheckThread();
 
          ((DefaultTimerManager*)_timerManager)->handler();
 
+#ifdef HAVE_THREADS
+         Common::Event queued;
+         while(s_inputQueue.pop(queued))
+            _events.push_back(queued);
+#endif
 
          if(!_events.empty())
          {
@@ -650,37 +1128,70 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 #endif
       }
 
+      // Microseconds from the same clocks as getMillis(). sleepUntil()
+      // is left to the default, which goes through delayMillis() and so
+      // keeps the timers and the frame slicing going.
+      virtual uint64 getTicks()
+      {
+#if (defined(GEKKO) && !defined(WIIU))
+         return ticks_to_microsecs(gettime());
+#elif defined(WIIU)
+         return cpu_features_get_time_usec();
+#elif defined(__CELLOS_LV2__)
+         return sys_time_get_system_time();
+#elif defined(_WIN32)
+         struct timeval t;
+         gettimeofday(&t, 0);
+
+         return (uint64)t.tv_sec * 1000000 + t.tv_usec;
+#else
+         struct timespec t;
+         clock_gettime(CLOCK_MONOTONIC, &t);
+
+         return (uint64)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+#endif
+      }
+
       virtual void delayMillis(uint msecs)
       {
 			// Implement 'non-blocking' sleep...
 			uint32 start_time = getMillis();
 			if (_speed_hack_enabled)
 			{
-				// Use janky inaccurate method...
-				uint32 elapsed_time = 0;
-				uint32 time_remaining = msecs;
-				while(time_remaining > 0)
+				// Deadline based method: sleep straight to the next point
+				// where the engine has something to do, instead of polling.
+				DefaultTimerManager *timerManager = (DefaultTimerManager*)_timerManager;
+				const uint32 wake_time = start_time + msecs;
+				while(true)
 				{
-					// If delay would take us past the next
-					// thread exit time, exit the thread immediately
-					// (i.e. start burning delay time in the main RetroArch
-					// thread as soon as possible...)
-					retroCheckThread(time_remaining);
-					// Check how much delay time remains...
-					elapsed_time = getMillis() - start_time;
-					if (time_remaining > elapsed_time)
-					{
-						time_remaining = time_remaining - elapsed_time;
-						retro_sleep(1);
-					}
-					else
-					{
-						time_remaining = 0;
-					}
 					// Have to handle the timer manager here, since some engines
 					// (e.g. dreamweb) sit in a delayMillis() loop waiting for a
 					// timer callback...
-					((DefaultTimerManager*)_timerManager)->handler();
+					timerManager->handler();
+
+					const uint32 now = getMillis();
+					if (now >= wake_time)
+						break;
+
+					// If the delay would take us past the end of the frame
+					// slice, exit the thread immediately (i.e. start burning
+					// delay time in the main RetroArch thread as soon as
+					// possible...)
+					if (wake_time >= _threadExitTime)
+					{
+						leaveFrame();
+						continue;
+					}
+
+					// Otherwise sleep until the delay is over or the next
+					// timer callback is due, whichever comes first. Timers
+					// fire once their due time has passed.
+					uint32 until = wake_time;
+					uint32 timer_time;
+					if (timerManager->getNextFireTime(timer_time) && timer_time + 1 < until)
+						until = timer_time + 1;
+					if (until > now)
+						sleepMillis(until - now);
 				}
 			}
 			else
@@ -688,7 +1199,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 				// Use accurate method...
 				while(getMillis() < start_time + msecs)
 				{
-					retro_sleep(1);
+					sleepMillis(1);
 					retroCheckThread();
 					// Have to handle the timer manager here, since some engines
 					// (e.g. dreamweb) sit in a delayMillis() loop waiting for a
@@ -698,6 +1209,54 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 			}
       }
 
+#ifdef HAVE_THREADS
+      // The frontend's audio thread may mix while the engine runs, so the
+      // mutexes need to be real (and recursive, like on other backends).
+      virtual MutexRef createMutex(void)
+      {
+#ifdef _WIN32
+         CRITICAL_SECTION *mutex = new CRITICAL_SECTION;
+         InitializeCriticalSection(mutex);
+#else
+         pthread_mutex_t *mutex = new pthread_mutex_t;
+         pthread_mutexattr_t attr;
+         pthread_mutexattr_init(&attr);
+         pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+         pthread_mutex_init(mutex, &attr);
+         pthread_mutexattr_destroy(&attr);
+#endif
+         return (MutexRef)mutex;
+      }
+
+      virtual void lockMutex(MutexRef mutex)
+      {
+#ifdef _WIN32
+         EnterCriticalSection((CRITICAL_SECTION *)mutex);
+#else
+         pthread_mutex_lock((pthread_mutex_t *)mutex);
+#endif
+      }
+
+      virtual void unlockMutex(MutexRef mutex)
+      {
+#ifdef _WIN32
+         LeaveCriticalSection((CRITICAL_SECTION *)mutex);
+#else
+         pthread_mutex_unlock((pthread_mutex_t *)mutex);
+#endif
+      }
+
+      virtual void deleteMutex(MutexRef mutex)
+      {
+#ifdef _WIN32
+         DeleteCriticalSection((CRITICAL_SECTION *)mutex);
+         delete (CRITICAL_SECTION *)mutex;
+#else
+         pthread_mutex_destroy((pthread_mutex_t *)mutex);
+         delete (pthread_mutex_t *)mutex;
+#endif
+      }
+#else
       virtual MutexRef createMutex(void)
       {
          return MutexRef();
@@ -717,6 +1276,20 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       {
          /* EMPTY */
       }
+#endif
+
+      virtual void setMemoryRegion(MemoryRegion region, void *data, uint32 size)
+      {
+         _memoryData[region] = data;
+         _memorySize[region] = data ? size : 0;
+      }
+
+      virtual void engineDone()
+      {
+         // Nothing may point into a destroyed engine
+         memset(_memoryData, 0, sizeof(_memoryData));
+         memset(_memorySize, 0, sizeof(_memorySize));
+      }
 
       virtual void quit()
       {
@@ -784,19 +1357,152 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
       {
          const Graphics::Surface& srcSurface = (_overlayVisible) ? _overlay : _gameScreen;
 
-         if(srcSurface.w != _screen.w || srcSurface.h != _screen.h)
-         {
 #ifdef FRONTEND_SUPPORTS_RGB565
-            _screen.create(srcSurface.w, srcSurface.h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+         const Graphics::PixelFormat screenFormat = s_trueColorOutput ? s_xrgb8888Format : Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
 #else
-            _screen.create(srcSurface.w, srcSurface.h, Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15));
+         const Graphics::PixelFormat screenFormat = s_trueColorOutput ? s_xrgb8888Format : Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15);
 #endif
+
+         if(srcSurface.w != _screen.w || srcSurface.h != _screen.h || screenFormat != _screen.format)
+         {
+            _screen.create(srcSurface.w, srcSurface.h, screenFormat);
+            markFullDirty();
          }
 
+         // _screen is still kept at the right size, the mouse code relies on it
+         if(_directOutput)
+            return _gameScreen;
 
          return _screen;
       }
 
+      bool screenUpdated()
+      {
+         const bool updated = _screenUpdated;
+         _screenUpdated = false;
+         return updated;
+      }
+
+      // Save states
+
+#define RETRO_STATE_VERSION 1
+#define RETRO_STATE_SLOT 1
+
+      bool canSaveState()
+      {
+         return g_engine && g_engine->hasFeature(Engine::kSupportsSavingDuringRuntime) && g_engine->canSaveGameStateCurrently();
+      }
+
+      bool canLoadState()
+      {
+         return g_engine && g_engine->hasFeature(Engine::kSupportsLoadingDuringRuntime) && g_engine->canLoadGameStateCurrently();
+      }
+
+      void syncState(Common::Serializer &s)
+      {
+         s.syncAsByte(_overlayVisible);
+         s.syncBytes(_gamePalette._colors, sizeof(_gamePalette._colors));
+         s.syncBytes(_mousePalette._colors, sizeof(_mousePalette._colors));
+         s.syncAsByte(_mousePaletteEnabled);
+         s.syncAsByte(_mouseVisible);
+         {
+            Common::StackLock lock(_mouseMutex);
+            s.syncAsSint32LE(_mouseX);
+            s.syncAsSint32LE(_mouseY);
+         }
+         s.syncBytes((byte *)_gameScreen.getPixels(), _gameScreen.pitch * _gameScreen.h);
+      }
+
+      bool saveState(Common::SeekableWriteStream &out)
+      {
+         if (!canSaveState())
+            return false;
+
+         Common::Serializer s(0, &out);
+         uint32 tag = MKTAG('S','V','M','R');
+         uint16 width = _gameScreen.w;
+         uint16 height = _gameScreen.h;
+         byte bpp = _gameScreen.format.bytesPerPixel;
+         uint32 engineSize = 0;
+
+         s.syncAsUint32BE(tag);
+         s.syncVersion(RETRO_STATE_VERSION);
+         s.syncAsUint16LE(width);
+         s.syncAsUint16LE(height);
+         s.syncAsByte(bpp);
+         syncState(s);
+
+         // The engine data size is patched in once it is known
+         const int32 sizePos = out.pos();
+         s.syncAsUint32LE(engineSize);
+
+         Common::Error result = g_engine->saveGameStream(&out);
+         if (result.getCode() != Common::kNoError)
+         {
+            // Fall back to slot based saving, redirected to memory
+            RetroSaveFileManager *saveMan = (RetroSaveFileManager *)_savefileManager;
+            out.seek(sizePos + 4);
+            saveMan->beginCapture(&out);
+            result = g_engine->saveGameState(RETRO_STATE_SLOT, "libretro");
+            if (!saveMan->endCapture())
+               return false;
+         }
+
+         if (result.getCode() != Common::kNoError || out.err())
+            return false;
+
+         engineSize = out.pos() - (sizePos + 4);
+         out.seek(sizePos);
+         out.writeUint32LE(engineSize);
+         out.seek(sizePos + 4 + engineSize);
+         return !out.err();
+      }
+
+      bool loadState(const byte *data, uint32 size)
+      {
+         if (!canLoadState())
+            return false;
+
+         Common::MemoryReadStream in(data, size);
+         Common::Serializer s(&in, 0);
+         uint32 tag = 0;
+         uint16 width = 0;
+         uint16 height = 0;
+         byte bpp = 0;
+         uint32 engineSize = 0;
+
+         s.syncAsUint32BE(tag);
+         if (tag != MKTAG('S','V','M','R') || !s.syncVersion(RETRO_STATE_VERSION))
+            return false;
+
+         s.syncAsUint16LE(width);
+         s.syncAsUint16LE(height);
+         s.syncAsByte(bpp);
+         if (width != _gameScreen.w || height != _gameScreen.h || bpp != _gameScreen.format.bytesPerPixel)
+            return false;
+
+         syncState(s);
+         markFullDirty();
+         _cursorDirty = true;
+
+         s.syncAsUint32LE(engineSize);
+         if (in.err() || engineSize > (uint32)(in.size() - in.pos()))
+            return false;
+
+         Common::SeekableSubReadStream engineData(&in, in.pos(), in.pos() + engineSize);
+         Common::Error result = g_engine->loadGameStream(&engineData);
+         if (result.getCode() != Common::kNoError)
+         {
+            RetroSaveFileManager *saveMan = (RetroSaveFileManager *)_savefileManager;
+            saveMan->beginRestore(data + in.pos(), engineSize);
+            result = g_engine->loadGameState(RETRO_STATE_SLOT);
+            if (!saveMan->endRestore())
+               return false;
+         }
+
+         return result.getCode() == Common::kNoError;
+      }
+
 #define ANALOG_RANGE 0x8000
 #define BASE_CURSOR_SPEED 4
 #define PI 3.141592653589793238
@@ -841,6 +1547,10 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
 				{ (unsigned)Common::KEYCODE_KP7, 55 },
 				{ (unsigned)Common::KEYCODE_KP4, 52 },
 			};
+
+         // The whole update is one step, so the engine never sees a
+         // position moved on one axis only
+         Common::StackLock lock(_mouseMutex);
 			
 			// Reduce gamepad cursor speed, if required
 			if (device == RETRO_DEVICE_JOYPAD &&
@@ -981,7 +1691,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             {
                Common::Event ev;
                ev.type = Common::EVENT_MAINMENU;
-               _events.push_back(ev);
+               queueEvent(ev);
             }
          }
 
@@ -1006,7 +1716,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = Common::EVENT_MOUSEMOVE;
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
 	}
 
 	if(ptrhold>10 && _ptrmouseButton==0){
@@ -1015,7 +1725,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = eventID[0][_ptrmouseButton ? 0 : 1];
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
 	}
 	else if (ptrhold==0 && _ptrmouseButton==1){
 	    _ptrmouseButton=0;
@@ -1023,7 +1733,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = eventID[0][_ptrmouseButton ? 0 : 1];
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
 	}
 
 #endif
@@ -1034,7 +1744,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = Common::EVENT_MOUSEMOVE;
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
          }
 
          // Gampad mouse buttons
@@ -1047,7 +1757,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = eventID[0][down ? 0 : 1];
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
          }
 
          down = aCallback(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_B);
@@ -1059,7 +1769,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = eventID[1][down ? 0 : 1];
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
          }
 
 			// Gamepad keyboard buttons
@@ -1207,7 +1917,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
             ev.type = Common::EVENT_MOUSEMOVE;
             ev.mouse.x = _mouseX;
             ev.mouse.y = _mouseY;
-            _events.push_back(ev);
+            queueEvent(ev);
          }
 
          for(int i = 0; i < 2; i ++)
@@ -1221,7 +1931,7 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
                ev.type = eventID[i][down ? 0 : 1];
                ev.mouse.x = _mouseX;
                ev.mouse.y = _mouseY;
-               _events.push_back(ev);
+               queueEvent(ev);
             }
 
          }
@@ -1251,13 +1961,21 @@ class OSystem_RETRO : public EventsBaseBackend, public PaletteManager {
          if(ev.kbd.ascii >= 97 && ev.kbd.ascii <= 122 && (_keyflags & Common::KBD_SHIFT))
             ev.kbd.ascii = ev.kbd.ascii & ~0x20;
 
-         _events.push_back(ev);
+         queueEvent(ev);
       }
 
       void postQuit()
       {
          Common::Event ev;
          ev.type = Common::EVENT_QUIT;
+#ifdef HAVE_THREADS
+         // The event manager belongs to the emulator thread
+         if (s_threaded)
+         {
+            queueEvent(ev);
+            return;
+         }
+#endif
          ((OSystem_RETRO*)g_system)->getEventManager()->pushEvent(ev);
       }
 };
@@ -1272,6 +1990,11 @@ const Graphics::Surface& getScreen()
    return ((OSystem_RETRO*)g_system)->getScreen();
 }
 
+bool retroScreenUpdated()
+{
+   return ((OSystem_RETRO*)g_system)->screenUpdated();
+}
+
 void retroProcessMouse(retro_input_state_t aCallback, int device, float gampad_cursor_speed, bool analog_response_is_quadratic, int analog_deadzone, float mouse_speed)
 {
    ((OSystem_RETRO*)g_system)->processMouse(aCallback, device, gampad_cursor_speed, analog_response_is_quadratic, analog_deadzone, mouse_speed);
@@ -1282,11 +2005,87 @@ void retroPostQuit()
    ((OSystem_RETRO*)g_system)->postQuit();
 }
 
+bool retroSaveState(Common::SeekableWriteStream &aOut)
+{
+   return ((OSystem_RETRO*)g_system)->saveState(aOut);
+}
+
+bool retroLoadState(const void *aData, size_t aSize)
+{
+   return ((OSystem_RETRO*)g_system)->loadState((const byte *)aData, aSize);
+}
+
 void retroSetSystemDir(const char* aPath)
 {
    s_systemDir = Common::String(aPath ? aPath : ".");
 }
 
+// Custom libretro memory types are RETRO_MEMORY_SYSTEM_RAM | (n << 8) for the
+// further regions, the game variables are the system RAM.
+static int retroMemoryRegion(unsigned aType)
+{
+   if((aType & RETRO_MEMORY_MASK) != RETRO_MEMORY_SYSTEM_RAM)
+      return -1;
+
+   const unsigned region = aType >> 8;
+   return (region < OSystem::kMemoryRegionCount) ? (int)region : -1;
+}
+
+void *retroGetMemoryData(unsigned aType)
+{
+   const int region = retroMemoryRegion(aType);
+   if(!g_system || region < 0)
+      return NULL;
+   return ((OSystem_RETRO*)g_system)->_memoryData[region];
+}
+
+size_t retroGetMemorySize(unsigned aType)
+{
+   const int region = retroMemoryRegion(aType);
+   if(!g_system || region < 0)
+      return 0;
+   return ((OSystem_RETRO*)g_system)->_memorySize[region];
+}
+
+void retroSetPerfOverlay(bool aEnabled)
+{
+   s_perfOverlay = aEnabled;
+}
+
+void retroSetFrameInterval(uint32 aMillis)
+{
+   s_frameInterval = MAX<uint32>(aMillis, 1);
+}
+
+uint32 retroGetFrameBudgetUsage()
+{
+   return g_system ? ((OSystem_RETRO*)g_system)->_frameBudgetUsage : 0;
+}
+
+#ifdef HAVE_THREADS
+void retroSetThreaded(bool aEnabled)
+{
+   s_threaded = aEnabled;
+}
+#endif
+
+void retroSetHWRender(bool aEnabled)
+{
+   s_hwRender = aEnabled;
+}
+
+#ifdef HAVE_OPENGL
+void retroRenderGL()
+{
+   ((OSystem_RETRO*)g_system)->renderGL();
+}
+#endif
+
+void retroSetTrueColorOutput(bool aEnabled)
+{
+   s_trueColorOutput = aEnabled;
+}
+
 void retroSetSaveDir(const char* aPath)
 {
    s_saveDir = Common::String(aPath ? aPath : ".");
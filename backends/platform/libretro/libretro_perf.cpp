@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "audio/cpustats.h"
+#include "common/memtracker.h"
+#include "libretro_perf.h"
+
+extern retro_log_printf_t log_cb;
+
+bool retro_perf_enabled = false;
+
+static retro_perf_get_time_usec_t s_getTime = NULL;
+
+/* More than enough for a second at the highest refresh rates */
+#define PERF_MAX_FRAMES 512
+
+static retro_time_t s_current[RETRO_PERF_COUNT];
+static retro_time_t s_samples[RETRO_PERF_COUNT][PERF_MAX_FRAMES];
+static unsigned s_frames = 0;
+static uint64_t s_dirtyPixels = 0;
+static retro_time_t s_periodStart = 0;
+static char s_summary[128] = "";
+
+static const char *const s_counterNames[RETRO_PERF_COUNT] = { "frame", "engine", "convert", "mix" };
+
+bool retroPerfSetup(const struct retro_perf_callback *aCallback, bool aEnabled)
+{
+   s_getTime = aCallback ? aCallback->get_time_usec : NULL;
+   retro_perf_enabled = aEnabled && s_getTime;
+
+   memset(s_current, 0, sizeof(s_current));
+   s_frames = 0;
+   s_dirtyPixels = 0;
+   s_periodStart = retro_perf_enabled ? s_getTime() : 0;
+   s_summary[0] = 0;
+
+   return retro_perf_enabled || !aEnabled;
+}
+
+retro_time_t retroPerfNow()
+{
+   return s_getTime();
+}
+
+void retroPerfAdd(RetroPerfCounter aCounter, retro_time_t aUsec)
+{
+   s_current[aCounter] += aUsec;
+}
+
+void retroPerfAddDirtyPixels(uint32_t aPixels)
+{
+   s_dirtyPixels += aPixels;
+}
+
+static double average(const retro_time_t *aSamples, unsigned aCount)
+{
+   retro_time_t sum = 0;
+   for (unsigned i = 0; i < aCount; i++)
+      sum += aSamples[i];
+   return aCount ? (double)sum / aCount : 0.0;
+}
+
+static retro_time_t percentile99(retro_time_t *aSamples, unsigned aCount)
+{
+   if (!aCount)
+      return 0;
+
+   const unsigned index = (aCount * 99) / 100;
+   std::nth_element(aSamples, aSamples + index, aSamples + aCount);
+   return aSamples[index];
+}
+
+void retroPerfEndFrame()
+{
+   if (!retro_perf_enabled)
+      return;
+
+   if (s_frames < PERF_MAX_FRAMES)
+   {
+      for (int i = 0; i < RETRO_PERF_COUNT; i++)
+         s_samples[i][s_frames] = s_current[i];
+      s_frames++;
+   }
+   memset(s_current, 0, sizeof(s_current));
+
+   const retro_time_t now = s_getTime();
+   if (now - s_periodStart < 1000000)
+      return;
+
+   const double frameAvg = average(s_samples[RETRO_PERF_FRAME], s_frames) / 1000.0;
+   const double engineAvg = average(s_samples[RETRO_PERF_ENGINE], s_frames) / 1000.0;
+   const double convertAvg = average(s_samples[RETRO_PERF_CONVERT], s_frames) / 1000.0;
+   const double mixAvg = average(s_samples[RETRO_PERF_MIX], s_frames) / 1000.0;
+   const double frameP99 = percentile99(s_samples[RETRO_PERF_FRAME], s_frames) / 1000.0;
+   const unsigned dirty = s_frames ? (unsigned)(s_dirtyPixels / s_frames) : 0;
+
+   snprintf(s_summary, sizeof(s_summary), "%u FPS %.1f/%.1f MS ENG %.1f CNV %.1f MIX %.1f DIRTY %u",
+      s_frames, frameAvg, frameP99, engineAvg, convertAvg, mixAvg, dirty);
+
+   if (log_cb)
+      log_cb(RETRO_LOG_INFO, "[scummvm] %u frames, %s avg %.2f ms p99 %.2f ms, %s %.2f ms, %s %.2f ms, %s %.2f ms, %u dirty pixels per frame\n",
+         s_frames, s_counterNames[RETRO_PERF_FRAME], frameAvg, frameP99,
+         s_counterNames[RETRO_PERF_ENGINE], engineAvg, s_counterNames[RETRO_PERF_CONVERT], convertAvg,
+         s_counterNames[RETRO_PERF_MIX], mixAvg, dirty);
+
+   /* The mixer's own split of its time, per sound type and synth */
+   if (log_cb && Audio::CPUStats::isActive())
+      log_cb(RETRO_LOG_INFO, "[scummvm] audio %s\n", Audio::CPUStats::instance().formatCounters().c_str());
+
+   /* Current and peak KB of the big memory consumers */
+   if (log_cb)
+      log_cb(RETRO_LOG_INFO, "[scummvm] memory %s\n", Common::MemoryTracker::formatUsage().c_str());
+
+   s_frames = 0;
+   s_dirtyPixels = 0;
+   s_periodStart = now;
+}
+
+const char *retroPerfSummary()
+{
+   return s_summary;
+}
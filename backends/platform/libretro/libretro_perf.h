@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_LIBRETRO_PERF_H
+#define BACKENDS_LIBRETRO_PERF_H
+
+#include "libretro.h"
+
+/** What the per frame timings are collected for. */
+enum RetroPerfCounter
+{
+   RETRO_PERF_FRAME,   /**< The whole of retro_run */
+   RETRO_PERF_ENGINE,  /**< The engine slice on the emulator thread */
+   RETRO_PERF_CONVERT, /**< Converting the screen to the output format */
+   RETRO_PERF_MIX,     /**< Audio mixing */
+   RETRO_PERF_COUNT
+};
+
+/** Checked before any timing is done, so disabled stats cost a branch. */
+extern bool retro_perf_enabled;
+
+/**
+ * Enable or disable the statistics.
+ * @param aCallback the frontend perf interface, used for its clock
+ * @return false if the frontend has no usable clock
+ */
+bool retroPerfSetup(const struct retro_perf_callback *aCallback, bool aEnabled);
+
+retro_time_t retroPerfNow();
+void retroPerfAdd(RetroPerfCounter aCounter, retro_time_t aUsec);
+void retroPerfAddDirtyPixels(uint32_t aPixels);
+
+/** Close the current frame, once a second the stats are logged. */
+void retroPerfEndFrame();
+
+/** The last per second summary, a single line for the overlay. */
+const char *retroPerfSummary();
+
+/** Adds the time until it goes out of scope to a counter. */
+class RetroPerfScope
+{
+   public:
+      RetroPerfScope(RetroPerfCounter aCounter) : _counter(aCounter), _start(-1)
+      {
+         if (retro_perf_enabled)
+            _start = retroPerfNow();
+      }
+
+      ~RetroPerfScope()
+      {
+         if (_start >= 0)
+            retroPerfAdd(_counter, retroPerfNow() - _start);
+      }
+
+   private:
+      RetroPerfCounter _counter;
+      retro_time_t _start;
+};
+
+#endif
@@ -0,0 +1,70 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_LIBRETRO_THREAD_H
+#define BACKENDS_LIBRETRO_THREAD_H
+
+#include <atomic>
+
+/**
+ * Lock-free queue for exactly one producer and one consumer thread, used to
+ * hand frames and input between the frontend and the emulator thread.
+ * Holds up to N - 1 items.
+ */
+template<class T, unsigned N>
+class RetroSPSCQueue
+{
+   public:
+      RetroSPSCQueue() : _head(0), _tail(0) {}
+
+      /** Producer side. @return false if the queue is full */
+      bool push(const T &aItem)
+      {
+         const unsigned tail = _tail.load(std::memory_order_relaxed);
+         const unsigned next = (tail + 1) % N;
+         if (next == _head.load(std::memory_order_acquire))
+            return false;
+
+         _items[tail] = aItem;
+         _tail.store(next, std::memory_order_release);
+         return true;
+      }
+
+      /** Consumer side. @return false if the queue is empty */
+      bool pop(T &aItem)
+      {
+         const unsigned head = _head.load(std::memory_order_relaxed);
+         if (head == _tail.load(std::memory_order_acquire))
+            return false;
+
+         aItem = _items[head];
+         _head.store((head + 1) % N, std::memory_order_release);
+         return true;
+      }
+
+   private:
+      T _items[N];
+      std::atomic<unsigned> _head;
+      std::atomic<unsigned> _tail;
+};
+
+#endif
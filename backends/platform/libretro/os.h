@@ -44,12 +44,29 @@ extern int access(const char *path, int amode);
 
 OSystem* retroBuildOS(bool aEnableSpeedHack);
 const Graphics::Surface& getScreen();
+bool retroScreenUpdated();
 
 void retroProcessMouse(retro_input_state_t aCallback, int device, float gampad_cursor_speed, bool analog_response_is_quadratic, int analog_deadzone, float mouse_speed);
 void retroPostQuit();
 
+bool retroSaveState(Common::SeekableWriteStream &aOut);
+bool retroLoadState(const void *aData, size_t aSize);
+
 void retroSetSystemDir(const char* aPath);
 void retroSetSaveDir(const char* aPath);
+void retroSetTrueColorOutput(bool aEnabled);
+void retroSetHWRender(bool aEnabled);
+void retroSetFrameInterval(uint32 aMillis);
+void retroSetPerfOverlay(bool aEnabled);
+void *retroGetMemoryData(unsigned aType);
+size_t retroGetMemorySize(unsigned aType);
+uint32 retroGetFrameBudgetUsage();
+#ifdef HAVE_THREADS
+void retroSetThreaded(bool aEnabled);
+#endif
+#ifdef HAVE_OPENGL
+void retroRenderGL();
+#endif
 
 void retroKeyEvent(bool down, unsigned keycode, uint32_t character, uint16_t key_modifiers);
 
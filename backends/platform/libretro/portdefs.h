@@ -36,3 +36,5 @@
 
 #define RES_W 640
 #define RES_H 480
+
+#define RETRO_AUDIO_SAMPLE_RATE 44100
@@ -41,6 +41,10 @@
 #include "audio/mixer_intern.h"
 #include "common/scummsys.h"
 
+#if defined(POSIX)
+#include <sys/time.h>
+#endif
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -54,9 +58,17 @@
 	#include "backends/fs/windows/windows-fs-factory.h"
 #endif
 
+/**
+ * Backend without display, input or sound output.
+ *
+ * Time is virtual: it only moves on when the engine waits in delayMillis,
+ * or when it keeps asking for the time without waiting. Timers and the
+ * mixer are run against that clock, so a run does not depend on the speed
+ * of the host and finishes as fast as the engine allows.
+ */
 class OSystem_NULL : public ModularBackend, Common::EventSource {
 public:
-	OSystem_NULL();
+	OSystem_NULL(uint32 frameLimit = 0);
 	virtual ~OSystem_NULL();
 
 	virtual void initBackend();
@@ -66,14 +78,42 @@ public:
 
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
+	// Unlike getMillis, reading the counter does not move the clock on,
+	// so that profiling does not change the outcome of a run
+	virtual uint64 getTicks() { return (uint64)_virtualMillis * 1000; }
+	virtual void sleepUntil(uint64 deadline);
 	virtual void getTimeAndDate(TimeDate &t) const {}
 
 	virtual void quit();
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+	/** Print the number of frames drawn and how long they took */
+	void printBenchmarkReport();
+
+private:
+	enum {
+		kOutputRate = 22050,
+		kMixBufferFrames = 1024,
+		// Calls to getMillis after which the clock moves on by itself
+		kMaxMillisPolls = 100
+	};
+
+	void advanceClock(uint msecs);
+	uint32 getFrameCount() const { return ((NullGraphicsManager *)_graphicsManager)->getFrameCount(); }
+	uint64 getWallMicroseconds() const;
+
+	uint32 _virtualMillis;
+	uint32 _millisPolls;
+	uint32 _mixRemainder;
+	uint32 _frameLimit;
+	bool _quitSent;
+	uint64 _startTime;
+	byte _mixBuffer[kMixBufferFrames * 4];
 };
 
-OSystem_NULL::OSystem_NULL() {
+OSystem_NULL::OSystem_NULL(uint32 frameLimit) :
+	_virtualMillis(0), _millisPolls(0), _mixRemainder(0), _frameLimit(frameLimit), _quitSent(false), _startTime(0) {
 	#if defined(__amigaos4__)
 		_fsFactory = new AmigaOSFilesystemFactory();
 	#elif defined(POSIX)
@@ -85,37 +125,109 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+	// The configuration may be written before initBackend is called
+	_mutexManager = new NullMutexManager();
 }
 
 OSystem_NULL::~OSystem_NULL() {
+	// Pending tasks, such as writing the configuration file, and the
+	// timer manager still need the mutex manager, which ModularBackend
+	// deletes before OSystem gets to them
+	delete _taskScheduler;
+	_taskScheduler = 0;
+	delete _timerManager;
+	_timerManager = 0;
 }
 
 void OSystem_NULL::initBackend() {
-	_mutexManager = new NullMutexManager();
 	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
 	_savefileManager = new DefaultSaveFileManager();
 	_graphicsManager = new NullGraphicsManager();
-	_mixer = new Audio::MixerImpl(22050);
+	_mixer = new Audio::MixerImpl(kOutputRate);
 
-	((Audio::MixerImpl *)_mixer)->setReady(false);
+	// The mixer and the timer manager are driven by advanceClock
+	((Audio::MixerImpl *)_mixer)->setReady(true);
 
-	// Note that both the mixer and the timer manager are useless
-	// this way; they need to be hooked into the system somehow to
-	// be functional. Of course, can't do that in a NULL backend :).
+	_startTime = getWallMicroseconds();
 
 	ModularBackend::initBackend();
 }
 
 bool OSystem_NULL::pollEvent(Common::Event &event) {
+	if (_frameLimit && !_quitSent && getFrameCount() >= _frameLimit) {
+		event.type = Common::EVENT_QUIT;
+		_quitSent = true;
+		return true;
+	}
 	return false;
 }
 
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
-	return 0;
+	// Engines which busy wait for the time to change would never
+	// get anywhere otherwise
+	if (++_millisPolls >= kMaxMillisPolls) {
+		advanceClock(1);
+	}
+	return _virtualMillis;
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	advanceClock(msecs);
+}
+
+void OSystem_NULL::sleepUntil(uint64 deadline) {
+	// The clock only has millisecond steps, so round up to the next one
+	const uint64 now = getTicks();
+	if (deadline > now) {
+		advanceClock((uint)((deadline - now + 999) / 1000));
+	}
+}
+
+void OSystem_NULL::advanceClock(uint msecs) {
+	if (msecs == 0) {
+		return;
+	}
+
+	_virtualMillis += msecs;
+	_millisPolls = 0;
+
+	if (_mixer) {
+		uint32 samples = msecs * kOutputRate + _mixRemainder;
+		uint32 frames = samples / 1000;
+		_mixRemainder = samples % 1000;
+
+		while (frames) {
+			uint32 chunk = MIN<uint32>(frames, kMixBufferFrames);
+			((Audio::MixerImpl *)_mixer)->mixCallback(_mixBuffer, chunk * 4);
+			frames -= chunk;
+		}
+	}
+
+	if (_timerManager) {
+		((DefaultTimerManager *)_timerManager)->handler();
+	}
+}
+
+uint64 OSystem_NULL::getWallMicroseconds() const {
+#if defined(POSIX)
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+#else
+	return 0;
+#endif
+}
+
+void OSystem_NULL::printBenchmarkReport() {
+	uint32 frames = getFrameCount();
+	uint64 wallTime = getWallMicroseconds() - _startTime;
+	uint32 fps = wallTime ? (uint32)((uint64)frames * 1000000 / wallTime) : 0;
+
+	Common::String report = Common::String::format("bench:frames=%u virtualms=%u wallms=%u fps=%u\n",
+		frames, _virtualMillis, (uint32)(wallTime / 1000), fps);
+	logMessage(LogMessageType::kInfo, report.c_str());
 }
 
 void OSystem_NULL::quit() {
@@ -139,11 +251,27 @@ OSystem *OSystem_NULL_create() {
 }
 
 int main(int argc, char *argv[]) {
-	g_system = OSystem_NULL_create();
-	assert(g_system);
+	// --bench-frames=N quits after N frames and prints how long they
+	// took. It is taken out before the common options are parsed.
+	uint32 frameLimit = 0;
+	int newArgc = 0;
+	for (int i = 0; i < argc; i++) {
+		if (!strncmp(argv[i], "--bench-frames=", 15)) {
+			frameLimit = atoi(argv[i] + 15);
+		} else {
+			argv[newArgc++] = argv[i];
+		}
+	}
+	argv[newArgc] = NULL;
+
+	OSystem_NULL *system = new OSystem_NULL(frameLimit);
+	g_system = system;
 
 	// Invoke the actual ScummVM main entry point:
-	int res = scummvm_main(argc, argv);
+	int res = scummvm_main(newArgc, argv);
+	if (frameLimit) {
+		system->printBenchmarkReport();
+	}
 	g_system->destroy();
 	return res;
 }
@@ -42,6 +42,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/taskscheduler/sdl/sdl-taskscheduler.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -97,6 +98,9 @@ OSystem_SDL::~OSystem_SDL() {
 	// destructor would also take care of this for us. However, various
 	// of our managers must be deleted *before* we call SDL_Quit().
 	// Hence, we perform the destruction on our own.
+	// The worker threads go first, as running tasks may use any manager.
+	delete _taskScheduler;
+	_taskScheduler = 0;
 	delete _savefileManager;
 	_savefileManager = 0;
 	if (_graphicsManager) {
@@ -510,6 +514,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+uint64 OSystem_SDL::getTicks() {
+	return SDL_GetPerformanceCounter();
+}
+
+uint64 OSystem_SDL::getTickFrequency() {
+	return SDL_GetPerformanceFrequency();
+}
+#endif
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -552,6 +566,27 @@ Common::TimerManager *OSystem_SDL::getTimerManager() {
 #endif
 }
 
+Common::TaskScheduler *OSystem_SDL::createTaskScheduler() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// Threads waiting for tasks help running them, so leave one core for them
+	const int cpuCount = SDL_GetCPUCount();
+	if (cpuCount > 1)
+		return new SdlTaskScheduler(cpuCount - 1);
+#endif
+
+	return ModularBackend::createTaskScheduler();
+}
+
+uint64 OSystem_SDL::getPhysicalMemorySize() {
+#if SDL_VERSION_ATLEAST(2, 0, 1)
+	const int ram = SDL_GetSystemRAM();
+	if (ram > 0)
+		return (uint64)ram * 1024 * 1024;
+#endif
+
+	return ModularBackend::getPhysicalMemorySize();
+}
+
 AudioCDManager *OSystem_SDL::createAudioCDManager() {
 	// Audio CD support was removed with SDL 2.0
 #if SDL_VERSION_ATLEAST(2, 0, 0)
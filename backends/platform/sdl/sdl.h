@@ -79,11 +79,17 @@ public:
 	virtual void setWindowCaption(const char *caption);
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0);
 	virtual uint32 getMillis(bool skipRecord = false);
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	virtual uint64 getTicks();
+	virtual uint64 getTickFrequency();
+#endif
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td) const;
 	virtual Audio::Mixer *getMixer();
 	virtual Common::TimerManager *getTimerManager();
 	virtual Common::SaveFileManager *getSavefileManager();
+	virtual Common::TaskScheduler *createTaskScheduler();
+	virtual uint64 getPhysicalMemorySize();
 
 	//Screenshots
 	virtual Common::String getScreenshotsPath();
@@ -85,6 +85,11 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 	if (getError().getCode() != Common::kNoError)
 		return Common::StringArray();
 
+	// Launchers and save dialogs tend to list the same saves over and over
+	SaveFileListCache::const_iterator cached = _saveFileListCache.find(pattern);
+	if (cached != _saveFileListCache.end())
+		return cached->_value;
+
 	Common::HashMap<Common::String, bool> locked;
 	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
 		locked[*i] = true;
@@ -96,10 +101,15 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 			results.push_back(file->_key);
 		}
 	}
+
+	_saveFileListCache[pattern] = results;
 	return results;
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	// Let a background save of the file finish first
+	waitForAsyncSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -116,6 +126,9 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	// Let a background save of the file finish first
+	waitForAsyncSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -138,6 +151,8 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	waitForAsyncSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::String savePathName = getSavePath();
 	assureCached(savePathName);
@@ -173,15 +188,23 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::WriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	// Saves are compressed with gzip unless the fast codec was chosen,
+	// either globally or for the running game
+	const Common::CompressionMethod method = ConfMan.get("save_compression") == "lz4" ? Common::kCompressionLZ4 : Common::kCompressionGZip;
+	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf, method) : sf);
 
 	// Add file to cache now that it exists.
+	if (file == _saveFileCache.end())
+		_saveFileListCache.clear();
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
 
 	return result;
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	// Let a background save of the file finish first
+	waitForAsyncSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -206,6 +229,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 		// Remove from cache, this invalidates the 'file' iterator.
 		_saveFileCache.erase(file);
 		file = _saveFileCache.end();
+		_saveFileListCache.clear();
 
 		// FIXME: remove does not exist on all systems. If your port fails to
 		// compile because of this, please let us know (scummvm-devel).
@@ -255,7 +279,10 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	Common::Array<Common::String> files = CloudMan.getSyncingFiles(); //returns empty array if not syncing
 	if (!files.empty()) updateSavefilesList(files); //makes this cache invalid
-	else _lockedFiles = files;
+	else if (!_lockedFiles.empty()) {
+		_lockedFiles = files;
+		_saveFileListCache.clear();
+	}
 #endif
 
 	if (_cachedDirectory == savePathName) {
@@ -263,6 +290,7 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 	}
 
 	_saveFileCache.clear();
+	_saveFileListCache.clear();
 	_cachedDirectory.clear();
 
 	if (getError().getCode() != Common::kNoError) {
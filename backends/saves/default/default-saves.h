@@ -88,6 +88,16 @@ protected:
 	 */
 	SaveFileCache _saveFileCache;
 
+	typedef Common::HashMap<Common::String, Common::StringArray> SaveFileListCache;
+
+	/**
+	 * Results of listSavefiles, by pattern.
+	 *
+	 * This needs to be cleared whenever files are added to or removed from
+	 * _saveFileCache, or the locked files change.
+	 */
+	SaveFileListCache _saveFileListCache;
+
 	/**
 	 * List of "locked" files. These cannot be used for saving/loading
 	 * because CloudManager is downloading those.
@@ -21,8 +21,10 @@
  */
 
 #include "common/util.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/str.h"
+#include "common/system.h"
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 #include "backends/cloud/cloudmanager.h"
 #endif
@@ -46,6 +48,10 @@ void OutSaveFile::finalize() {
 #endif
 }
 
+void OutSaveFile::finalizeStream() {
+	_wrapped->finalize();
+}
+
 bool OutSaveFile::flush() { return _wrapped->flush(); }
 
 uint32 OutSaveFile::write(const void *dataPtr, uint32 dataSize) {
@@ -56,6 +62,156 @@ int32 OutSaveFile::pos() const {
 	return _wrapped->pos();
 }
 
+/**
+ * Savefile returned by SaveFileManager::openForSavingAsync(), collecting the
+ * data in memory until it is finalized.
+ */
+class AsyncOutSaveFile : public OutSaveFile {
+public:
+	AsyncOutSaveFile(SaveFileManager *manager, const String &name, bool compress, SaveFileManager::AsyncSaveCallback *callback) :
+		OutSaveFile(new MemoryWriteStreamDynamic(DisposeAfterUse::YES)),
+		_manager(manager), _name(name), _compress(compress), _callback(callback), _queued(false), _openFailed(false) {}
+
+	virtual ~AsyncOutSaveFile() {
+		// Like other savefiles, write out the data if no one finalized it
+		if (!_queued)
+			finalize();
+	}
+
+	virtual bool err() const { return _openFailed || _wrapped->err(); }
+
+	virtual void clearErr() {
+		_openFailed = false;
+		_wrapped->clearErr();
+	}
+
+	virtual void finalize() {
+		if (_queued)
+			return;
+		_queued = true;
+
+		// Hand the data to the manager, and keep an empty buffer around
+		// in case the caller still uses the stream
+		MemoryWriteStreamDynamic *data = (MemoryWriteStreamDynamic *)_wrapped;
+		_wrapped = new MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		_openFailed = !_manager->queueAsyncSave(_name, _compress, data, _callback);
+		_callback = nullptr;
+	}
+
+private:
+	SaveFileManager *_manager;
+	String _name;
+	bool _compress;
+	SaveFileManager::AsyncSaveCallback *_callback;
+	bool _queued;
+	bool _openFailed;
+};
+
+namespace {
+
+/**
+ * Writes the data collected by an AsyncOutSaveFile. Only the file itself is
+ * touched on the task, the rest is left to finish() on the main thread.
+ */
+class AsyncSaveTask : public Task {
+public:
+	AsyncSaveTask(OutSaveFile *file, MemoryWriteStreamDynamic *data, SaveFileManager::AsyncSaveCallback *callback) :
+		_file(file), _data(data), _callback(callback), _success(false) {}
+
+	virtual ~AsyncSaveTask() {
+		delete _file;
+		delete _data;
+		delete _callback;
+	}
+
+	virtual void run() {
+		_file->write(_data->getData(), _data->size());
+		_file->finalizeStream();
+		_success = !_file->err();
+
+		// Close the file right away, not whenever the task is released
+		delete _file;
+		_file = nullptr;
+		delete _data;
+		_data = nullptr;
+	}
+
+	/** Report the result once the task is done. */
+	void finish() {
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+		CloudMan.syncSaves();
+#endif
+
+		if (_callback)
+			(*_callback)(_success);
+	}
+
+private:
+	OutSaveFile *_file;
+	MemoryWriteStreamDynamic *_data;
+	SaveFileManager::AsyncSaveCallback *_callback;
+	bool _success;
+};
+
+} // End of anonymous namespace
+
+OutSaveFile *SaveFileManager::openForSavingAsync(const String &name, bool compress, AsyncSaveCallback *callback) {
+	return new AsyncOutSaveFile(this, name, compress, callback);
+}
+
+bool SaveFileManager::queueAsyncSave(const String &name, bool compress, MemoryWriteStreamDynamic *data, AsyncSaveCallback *callback) {
+	// The file must not be opened again while the last write is going on
+	waitForAsyncSave(name);
+
+	OutSaveFile *file = openForSaving(name, compress);
+	if (!file) {
+		delete data;
+		if (callback)
+			(*callback)(false);
+		delete callback;
+		return false;
+	}
+
+	PendingSave pending;
+	pending.name = name;
+	pending.task = new AsyncSaveTask(file, data, callback);
+	pending.future = g_system->getTaskScheduler()->schedule(pending.task, DisposeAfterUse::NO);
+	_pendingSaves.push_back(pending);
+	return true;
+}
+
+void SaveFileManager::finishAsyncSave(PendingSave &pending) {
+	AsyncSaveTask *task = (AsyncSaveTask *)pending.task;
+	task->finish();
+	delete task;
+}
+
+void SaveFileManager::waitForAsyncSave(const String &name) {
+	for (uint i = 0; i < _pendingSaves.size(); ) {
+		if (_pendingSaves[i].name.equalsIgnoreCase(name))
+			_pendingSaves[i].future.wait();
+
+		// Finish every save which is done while at it. The save is removed
+		// first, in case the callback or the cloud sync use the manager.
+		if (_pendingSaves[i].future.isDone()) {
+			PendingSave pending = _pendingSaves[i];
+			_pendingSaves.remove_at(i);
+			finishAsyncSave(pending);
+		} else {
+			++i;
+		}
+	}
+}
+
+void SaveFileManager::waitForAsyncSaves() {
+	while (!_pendingSaves.empty()) {
+		PendingSave pending = _pendingSaves[0];
+		_pendingSaves.remove_at(0);
+		pending.future.wait();
+		finishAsyncSave(pending);
+	}
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename, bool compress) {
 	InSaveFile *inFile = 0;
 	OutSaveFile *outFile = 0;
@@ -0,0 +1,203 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/taskscheduler/sdl/sdl-taskscheduler.h"
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+
+#include "common/str.h"
+#include "common/textconsole.h"
+
+SdlTaskScheduler::SdlTaskScheduler(uint threadCount) {
+	_pending = SDL_CreateSemaphore(0);
+	_doneMutex = SDL_CreateMutex();
+	_doneCond = SDL_CreateCond();
+	SDL_AtomicSet(&_next, 0);
+	SDL_AtomicSet(&_quit, 0);
+
+	for (uint i = 0; i < threadCount; i++) {
+		Worker *worker = new Worker();
+		worker->scheduler = this;
+		worker->index = i;
+		worker->queueMutex = SDL_CreateMutex();
+		worker->thread = nullptr;
+		worker->threadId = 0;
+		_workers.push_back(worker);
+	}
+
+	// Start the threads only once all workers exist, since they steal
+	// from each other
+	for (uint i = 0; i < _workers.size(); i++) {
+		Worker *worker = _workers[i];
+		const Common::String name = Common::String::format("ScummVM worker %u", i);
+
+		worker->thread = SDL_CreateThread(workerMain, name.c_str(), worker);
+		if (!worker->thread)
+			error("SdlTaskScheduler: Could not create worker thread: %s", SDL_GetError());
+		worker->threadId = SDL_GetThreadID(worker->thread);
+	}
+}
+
+SdlTaskScheduler::~SdlTaskScheduler() {
+	SDL_AtomicSet(&_quit, 1);
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_SemPost(_pending);
+
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_WaitThread(_workers[i]->thread, nullptr);
+
+	// Finish anything still queued, someone may hold a future for it
+	while (runQueuedTask(-1))
+		;
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		SDL_DestroyMutex(_workers[i]->queueMutex);
+		delete _workers[i];
+	}
+
+	SDL_DestroyCond(_doneCond);
+	SDL_DestroyMutex(_doneMutex);
+	SDL_DestroySemaphore(_pending);
+}
+
+void SdlTaskScheduler::enqueue(Common::TaskState *state) {
+	int target = findCurrentWorker();
+	if (target < 0)
+		target = (uint)SDL_AtomicAdd(&_next, 1) % _workers.size();
+
+	Worker *worker = _workers[target];
+	SDL_LockMutex(worker->queueMutex);
+	worker->queue.push_back(state);
+	SDL_UnlockMutex(worker->queueMutex);
+
+	SDL_SemPost(_pending);
+}
+
+bool SdlTaskScheduler::isDone(const Common::TaskState &state) const {
+	SDL_LockMutex(_doneMutex);
+	const bool done = state.done;
+	SDL_UnlockMutex(_doneMutex);
+	return done;
+}
+
+void SdlTaskScheduler::wait(Common::TaskState *state) {
+	const int self = findCurrentWorker();
+
+	while (!isDone(*state)) {
+		if (runQueuedTask(self))
+			continue;
+
+		// Wake up now and then to help with tasks queued in the meantime
+		SDL_LockMutex(_doneMutex);
+		if (!state->done)
+			SDL_CondWaitTimeout(_doneCond, _doneMutex, 1);
+		SDL_UnlockMutex(_doneMutex);
+	}
+}
+
+void SdlTaskScheduler::retain(Common::TaskState *state) {
+	SDL_LockMutex(_doneMutex);
+	state->refCount++;
+	SDL_UnlockMutex(_doneMutex);
+}
+
+void SdlTaskScheduler::release(Common::TaskState *state) {
+	SDL_LockMutex(_doneMutex);
+	const bool last = (--state->refCount == 0);
+	SDL_UnlockMutex(_doneMutex);
+
+	if (last)
+		delete state;
+}
+
+int SDLCALL SdlTaskScheduler::workerMain(void *data) {
+	Worker *worker = (Worker *)data;
+	SdlTaskScheduler *scheduler = worker->scheduler;
+
+	while (true) {
+		SDL_SemWait(scheduler->_pending);
+		if (SDL_AtomicGet(&scheduler->_quit))
+			break;
+
+		while (scheduler->runQueuedTask(worker->index))
+			;
+	}
+
+	return 0;
+}
+
+int SdlTaskScheduler::findCurrentWorker() const {
+	const SDL_threadID id = SDL_ThreadID();
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		if (_workers[i]->threadId == id)
+			return i;
+	}
+
+	return -1;
+}
+
+bool SdlTaskScheduler::runQueuedTask(int self) {
+	Common::TaskState *state = nullptr;
+
+	if (self >= 0) {
+		Worker *worker = _workers[self];
+		SDL_LockMutex(worker->queueMutex);
+		if (!worker->queue.empty()) {
+			state = worker->queue.back();
+			worker->queue.pop_back();
+		}
+		SDL_UnlockMutex(worker->queueMutex);
+	}
+
+	const uint count = _workers.size();
+	for (uint i = 0; i < count && !state; i++) {
+		Worker *victim = _workers[(self + 1 + i) % count];
+		SDL_LockMutex(victim->queueMutex);
+		if (!victim->queue.empty()) {
+			state = victim->queue.front();
+			victim->queue.pop_front();
+		}
+		SDL_UnlockMutex(victim->queueMutex);
+	}
+
+	if (!state)
+		return false;
+
+	runTask(state);
+
+	SDL_LockMutex(_doneMutex);
+	state->done = true;
+	SDL_CondBroadcast(_doneCond);
+	SDL_UnlockMutex(_doneMutex);
+
+	release(state);
+	return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_TASKSCHEDULER_SDL_H
+#define BACKENDS_TASKSCHEDULER_SDL_H
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/taskscheduler.h"
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+
+/**
+ * Work-stealing task scheduler running on SDL threads.
+ *
+ * Every worker thread has its own queue. Tasks scheduled from a worker go
+ * to its own queue, which it works through newest first; other tasks are
+ * spread over the workers. A worker whose queue is empty steals the oldest
+ * task of another worker. Threads waiting for a task run queued tasks too.
+ */
+class SdlTaskScheduler : public Common::TaskScheduler {
+public:
+	SdlTaskScheduler(uint threadCount);
+	virtual ~SdlTaskScheduler();
+
+	virtual uint getConcurrency() const { return _workers.size() + 1; }
+
+protected:
+	virtual void enqueue(Common::TaskState *state);
+	virtual bool isDone(const Common::TaskState &state) const;
+	virtual void wait(Common::TaskState *state);
+	virtual void retain(Common::TaskState *state);
+	virtual void release(Common::TaskState *state);
+
+private:
+	struct Worker {
+		SdlTaskScheduler *scheduler;
+		uint index;
+		SDL_Thread *thread;
+		SDL_threadID threadId;
+
+		SDL_mutex *queueMutex;
+		Common::List<Common::TaskState *> queue;
+	};
+
+	Common::Array<Worker *> _workers;
+
+	SDL_sem *_pending;     ///< Posted once for every queued task
+	SDL_mutex *_doneMutex; ///< Guards the done flags and reference counts of all tasks
+	SDL_cond *_doneCond;   ///< Signalled whenever a task finished
+	SDL_atomic_t _next;    ///< Round robin counter for tasks scheduled from other threads
+	SDL_atomic_t _quit;
+
+	static int SDLCALL workerMain(void *data);
+
+	/** Return the index of the worker running on this thread, or -1. */
+	int findCurrentWorker() const;
+
+	/**
+	 * Run one queued task, preferring the given worker's own queue.
+	 * @return false if there was no task to run
+	 */
+	bool runQueuedTask(int self);
+};
+
+#endif
+
+#endif
@@ -23,6 +23,7 @@
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
 #include "common/util.h"
+#include "common/debug.h"
 #include "common/system.h"
 
 struct TimerSlot {
@@ -34,9 +35,28 @@ struct TimerSlot {
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
+	// How late the callback ran, for tracking down timing problems
+	uint32 fireCount;
+	uint32 totalLateness;	// in milliseconds
+	uint32 maxLateness;	// in milliseconds
+
 	TimerSlot *next;
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0),
+		fireCount(0), totalLateness(0), maxLateness(0), next(nullptr) {}
+
+	void recordFire(uint32 curTime) {
+		const uint32 lateness = curTime - nextFireTime;
+		fireCount++;
+		totalLateness += lateness;
+		maxLateness = MAX(maxLateness, lateness);
+	}
+
+	void printStats() const {
+		if (fireCount)
+			debug(2, "Timer '%s': %u calls, %u ms late on average, %u ms at most",
+				id.c_str(), fireCount, totalLateness / fireCount, maxLateness);
+	}
 };
 
 void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
@@ -90,6 +110,8 @@ void DefaultTimerManager::handler() {
 		// Remove the slot from the priority queue
 		_head->next = slot->next;
 
+		slot->recordFire(curTime);
+
 		// Update the fire time and reinsert the TimerSlot into the priority
 		// queue.
 		assert(slot->interval > 0);
@@ -110,6 +132,16 @@ void DefaultTimerManager::handler() {
 	}
 }
 
+bool DefaultTimerManager::getNextFireTime(uint32 &time) {
+	Common::StackLock lock(_mutex);
+
+	if (!_head->next)
+		return false;
+
+	time = _head->next->nextFireTime;
+	return true;
+}
+
 bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, void *refCon, const Common::String &id) {
 	assert(interval > 0);
 	Common::StackLock lock(_mutex);
@@ -150,6 +182,7 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	while (slot->next) {
 		if (slot->next->callback == callback) {
 			TimerSlot *next = slot->next->next;
+			slot->next->printStats();
 			delete slot->next;
 			slot->next = next;
 		} else {
@@ -48,6 +48,15 @@ public:
 	 * Timer callback, to be invoked at regular time intervals by the backend.
 	 */
 	void handler();
+
+	/**
+	 * Get the time at which the next timer callback is due, so backends can
+	 * sleep until then instead of calling handler() at a fixed rate.
+	 *
+	 * @param time	set to the due time, in getMillis() milliseconds
+	 * @return false if no timer is installed
+	 */
+	bool getNextFireTime(uint32 &time);
 };
 
 #endif
@@ -27,6 +27,7 @@
 
 #include <limits.h>
 
+#include "engines/advancedDetector.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
 #include "base/plugins.h"
@@ -148,6 +149,9 @@ static const char HELP_STRING[] =
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
 	"                           passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --record-benchmark       Play back the record as fast as possible and print\n"
+	"                           timings when it ends\n"
+	"  --record-checksum        Checksum the screen while benchmarking a playback\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 #endif
@@ -230,6 +234,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("native_mt32", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("mt32_render_ahead", 50);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -249,6 +254,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_scripts", false);
 	ConfMan.registerDefault("save_slot", -1);
 	ConfMan.registerDefault("autosave_period", 5 * 60); // By default, trigger autosave every 5 minutes
+	ConfMan.registerDefault("save_compression", "gzip"); // "gzip", or "lz4" for faster saving
 
 #if defined(ENABLE_SCUMM) || defined(ENABLE_SWORD2)
 	ConfMan.registerDefault("object_labels", true);
@@ -275,10 +281,14 @@ void registerDefaults() {
 	ConfMan.registerDefault("joystick_num", -1);
 	ConfMan.registerDefault("confirm_exit", false);
 	ConfMan.registerDefault("disable_sdl_parachute", false);
+	ConfMan.registerDefault("frame_stall_threshold", 100);
+	ConfMan.registerDefault("memory_budget", 0);
 
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("record_benchmark", false);
+	ConfMan.registerDefault("record_checksum", false);
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -305,6 +315,8 @@ void registerDefaults() {
 	ConfMan.registerDefault("fluidsynth_reverb_level", 57);
 
 	ConfMan.registerDefault("fluidsynth_misc_interpolation", "4th");
+	ConfMan.registerDefault("fluidsynth_render_ahead", 50);
+	ConfMan.registerDefault("fluidsynth_adaptive_quality", true);
 #endif
 }
 
@@ -504,6 +516,12 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
+
+			DO_LONG_OPTION_BOOL("record-benchmark")
+			END_OPTION
+
+			DO_LONG_OPTION_BOOL("record-checksum")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
@@ -904,6 +922,7 @@ static Common::String detectGames(const Common::String &path, const Common::Stri
 	//Current directory
 	Common::FSNode dir(path);
 	DetectedGames candidates = recListGames(dir, gameId, recursive);
+	AdvancedMetaEngine::saveMD5Cache(true);
 
 	if (candidates.empty()) {
 		printf("WARNING: ScummVM could not find any game in %s\n", dir.getPath().c_str());
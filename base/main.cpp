@@ -53,6 +53,7 @@
 #include "common/translation.h"
 #include "common/text-to-speech.h"
 #include "common/osd_message_queue.h"
+#include "common/profiler.h"
 
 #include "gui/gui-manager.h"
 #include "gui/error.h"
@@ -277,7 +278,11 @@ static Common::Error runGame(const Plugin *plugin, OSystem &system, const Common
 	system.engineInit();
 
 	// Run the engine
-	Common::Error result = engine->run();
+	Common::Error result;
+	{
+		PROFILE_ZONE("Engine::run");
+		result = engine->run();
+	}
 
 	// Inform backend that the engine finished
 	system.engineDone();
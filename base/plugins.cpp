@@ -339,6 +339,7 @@ void PluginManagerUncached::updateConfigWithFileName(const Common::String &gameI
 		(*domain)[gameId] = (*_currentPlugin)->getFileName();
 
 		ConfMan.flushToDisk();
+		_pluginIndexChanged = false;
 	}
 }
 
@@ -349,6 +350,7 @@ void PluginManagerUncached::loadFirstPlugin() {
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addCurrentPluginToIndex();
 			break;
 		}
 	}
@@ -360,9 +362,16 @@ bool PluginManagerUncached::loadNextPlugin() {
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addCurrentPluginToIndex();
 			return true;
 		}
 	}
+
+	// Keep what this scan found out for the next lookup
+	if (_pluginIndexChanged) {
+		ConfMan.flushToDisk();
+		_pluginIndexChanged = false;
+	}
 	return false; // no more in list
 }
 
@@ -469,12 +478,39 @@ void PluginManager::addToPluginsInMemList(Plugin *plugin) {
 
 // Engine plugins
 
+#include "engines/advancedDetector.h"
 #include "engines/metaengine.h"
 
 namespace Common {
 DECLARE_SINGLETON(EngineManager);
 }
 
+/**
+ * Record every game the current plugin supports under 'plugin_files', so
+ * looking any of them up later loads this plugin straight away instead of
+ * scanning through all of them again. Entries already there are kept, as
+ * they may have been confirmed by updateConfigWithFileName().
+ **/
+void PluginManagerUncached::addCurrentPluginToIndex() {
+	const char *filename = (*_currentPlugin)->getFileName();
+	if (!filename || (*_currentPlugin)->getType() != PLUGIN_TYPE_ENGINE)
+		return;
+
+	if (!ConfMan.hasMiscDomain("plugin_files"))
+		ConfMan.addMiscDomain("plugin_files");
+
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("plugin_files");
+	assert(domain);
+
+	PlainGameList games = (*_currentPlugin)->get<MetaEngine>().getSupportedGames();
+	for (PlainGameList::const_iterator game = games.begin(); game != games.end(); ++game) {
+		if (!domain->contains(game->gameId)) {
+			(*domain)[game->gameId] = filename;
+			_pluginIndexChanged = true;
+		}
+	}
+}
+
 /**
  * This function works for both cached and uncached PluginManagers.
  * For the cached version, most of the logic here will short circuit.
@@ -560,6 +596,8 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) const
 		}
 	} while (PluginManager::instance().loadNextPlugin());
 
+	AdvancedMetaEngine::saveMD5Cache();
+
 	return DetectionResults(candidates);
 }
 
@@ -337,9 +337,11 @@ protected:
 	friend class PluginManager;
 	PluginList _allEnginePlugins;
 	PluginList::iterator _currentPlugin;
+	bool _pluginIndexChanged;
 
-	PluginManagerUncached() {}
+	PluginManagerUncached() : _pluginIndexChanged(false) {}
 	bool loadPluginByFileName(const Common::String &filename);
+	void addCurrentPluginToIndex();
 
 public:
 	virtual void init();
@@ -92,6 +92,33 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	_index.clear();
+}
+
+Archive *SearchSet::findArchive(const String &name) const {
+	if (_useIndex) {
+		LookupIndex::const_iterator cached = _index.find(name);
+		if (cached != _index.end())
+			return cached->_value;
+	}
+
+	Archive *found = nullptr;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		if (it->_arc->hasFile(name)) {
+			found = it->_arc;
+			break;
+		}
+	}
+
+	if (_useIndex)
+		_index[name] = found;
+	return found;
+}
+
+void SearchSet::setLookupIndexEnabled(bool enable) {
+	_useIndex = enable;
+	_index.clear();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -173,6 +200,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		_index.clear();
 	}
 }
 
@@ -187,6 +215,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_index.clear();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -202,20 +231,14 @@ void SearchSet::setPriority(const String &name, int priority) {
 	Node node(*it);
 	_list.erase(it);
 	node._priority = priority;
-	insert(node);
+	insert(node); // also drops the lookup index
 }
 
 bool SearchSet::hasFile(const String &name) const {
 	if (name.empty())
 		return false;
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return true;
-	}
-
-	return false;
+	return findArchive(name) != nullptr;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
@@ -242,11 +265,9 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	Archive *arc = findArchive(name);
+	if (arc)
+		return arc->getMember(name);
 
 	return ArchiveMemberPtr();
 }
@@ -255,6 +276,15 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return nullptr;
 
+	// Archives are asked in turn below, so a hit from the index is only
+	// a shortcut; an archive may still fail to open a file it has.
+	if (_useIndex) {
+		Archive *arc = findArchive(name);
+		SeekableReadStream *stream = arc ? arc->createReadStreamForMember(name) : nullptr;
+		if (stream || !arc)
+			return stream;
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
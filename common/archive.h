@@ -24,6 +24,8 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -146,15 +148,39 @@ class SearchSet : public Archive {
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	// Maps file names to the first archive containing them (or nullptr),
+	// filled in as lookups happen. See setLookupIndexEnabled().
+	typedef HashMap<String, Archive *, IgnoreCase_Hash, IgnoreCase_EqualTo> LookupIndex;
+	mutable LookupIndex _index;
+	bool _useIndex;
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
 	// Add an archive keeping the list sorted by descending priority.
 	void insert(const Node& node);
 
+	// Find the highest priority archive which has the given file.
+	Archive *findArchive(const String &name) const;
+
 public:
+	SearchSet() : _useIndex(false) {}
 	virtual ~SearchSet() { clear(); }
 
+	/**
+	 * Remember which archive a name was found in, or that it was not found
+	 * at all, so repeated lookups of the same name are a single hash probe
+	 * instead of a walk over all archives. The index is dropped whenever
+	 * archives are added to, removed from or reprioritized in this set.
+	 *
+	 * Only enable this when the archives do not change their contents. That
+	 * includes archives nested in them, like a SearchSet which is one of
+	 * the archives: changes to it are not noticed. Lookups also update the
+	 * index, so a set with the index enabled must only be used from one
+	 * thread. It is disabled by default, also for SearchMan.
+	 */
+	void setLookupIndexEnabled(bool enable);
+
 	/**
 	 * Add a new archive to the searchable set.
 	 */
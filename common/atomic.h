@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+#if defined(_MSC_VER)
+// See common/math.h for why setjmp and longjmp need this around intrin.h
+#undef setjmp
+#undef longjmp
+#include <intrin.h>
+#ifndef FORBIDDEN_SYMBOL_EXCEPTION_setjmp
+#undef setjmp
+#define setjmp(a)	FORBIDDEN_SYMBOL_REPLACEMENT
+#endif
+#ifndef FORBIDDEN_SYMBOL_EXCEPTION_longjmp
+#undef longjmp
+#define longjmp(a,b)	FORBIDDEN_SYMBOL_REPLACEMENT
+#endif
+#endif
+
+#if !defined(__ATOMIC_SEQ_CST) && !GCC_ATLEAST(4, 1) && !defined(_MSC_VER)
+#error "Common::AtomicInt32 is not implemented for this compiler"
+#endif
+
+namespace Common {
+
+/**
+ * A 32-bit integer which can be shared between threads without a mutex.
+ * All operations are sequentially consistent.
+ *
+ * This uses the compiler builtins, since the code does not require C++11.
+ */
+class AtomicInt32 : NonCopyable {
+public:
+	explicit AtomicInt32(int32 value = 0) : _value(value) {}
+
+	int32 load() const {
+#if defined(__ATOMIC_SEQ_CST)
+		return __atomic_load_n(&_value, __ATOMIC_SEQ_CST);
+#elif GCC_ATLEAST(4, 1)
+		return __sync_fetch_and_add(const_cast<volatile int32 *>(&_value), 0);
+#elif defined(_MSC_VER)
+		return _InterlockedCompareExchange((volatile long *)&_value, 0, 0);
+#endif
+	}
+
+	void store(int32 value) {
+#if defined(__ATOMIC_SEQ_CST)
+		__atomic_store_n(&_value, value, __ATOMIC_SEQ_CST);
+#elif GCC_ATLEAST(4, 1)
+		__sync_synchronize();
+		_value = value;
+		__sync_synchronize();
+#elif defined(_MSC_VER)
+		_InterlockedExchange((volatile long *)&_value, value);
+#endif
+	}
+
+	/**
+	 * Replace the value with desired if it equals expected.
+	 *
+	 * @return Whether the value was replaced.
+	 */
+	bool compareExchange(int32 expected, int32 desired) {
+#if defined(__ATOMIC_SEQ_CST)
+		return __atomic_compare_exchange_n(&_value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif GCC_ATLEAST(4, 1)
+		return __sync_bool_compare_and_swap(&_value, expected, desired);
+#elif defined(_MSC_VER)
+		return _InterlockedCompareExchange((volatile long *)&_value, desired, expected) == expected;
+#endif
+	}
+
+	/**
+	 * Add to the value.
+	 *
+	 * @return The value before the addition.
+	 */
+	int32 fetchAdd(int32 delta) {
+#if defined(__ATOMIC_SEQ_CST)
+		return __atomic_fetch_add(&_value, delta, __ATOMIC_SEQ_CST);
+#elif GCC_ATLEAST(4, 1)
+		return __sync_fetch_and_add(&_value, delta);
+#elif defined(_MSC_VER)
+		return _InterlockedExchangeAdd((volatile long *)&_value, delta);
+#endif
+	}
+
+private:
+	volatile int32 _value;
+};
+
+} // End of namespace Common
+
+#endif
@@ -42,12 +42,18 @@ namespace Common {
  * For example, a bit stream with the layout parameters 32, true, false
  * for valueBits, isLE and isMSB2LSB, reads 32bit little-endian values
  * from the data stream and hands out the bits in the order of LSB to MSB.
+ *
+ * With fastRefill set, and if the input stream exposes its contents through
+ * getDataPointer(), the container is refilled with as many whole values as
+ * fit into it using one unaligned 64bit load straight from memory. In that
+ * mode the position of the input stream itself is not advanced.
  */
-template<class STREAM, int valueBits, bool isLE, bool MSB2LSB>
+template<class STREAM, int valueBits, bool isLE, bool MSB2LSB, bool fastRefill = false>
 class BitStreamImpl {
 private:
 	STREAM *_stream;			///< The input stream.
 	DisposeAfterUse::Flag _disposeAfterUse; ///< Should we delete the stream on destruction?
+	const byte *_data;    ///< The stream contents, when refilling directly from memory.
 
 	uint64 _bitContainer; ///< The currently available bits.
 	uint8  _bitsLeft; ///< Number of bits currently left in the bit container.
@@ -56,6 +62,17 @@ private:
 
 	/** Read a data value. */
 	inline uint32 readData() {
+		if (fastRefill && _data) {
+			const byte *ptr = _data + ((_pos + _bitsLeft) >> 3);
+
+			if (valueBits ==  8)
+				return *ptr;
+			if (valueBits == 16)
+				return isLE ? READ_LE_UINT16(ptr) : READ_BE_UINT16(ptr);
+			if (valueBits == 32)
+				return isLE ? READ_LE_UINT32(ptr) : READ_BE_UINT32(ptr);
+		}
+
 		if (isLE) {
 			if (valueBits ==  8)
 				return _stream->readByte();
@@ -76,8 +93,50 @@ private:
 		return 0;
 	}
 
+	/**
+	 * Load the next 64 bits of data, ordered so that the bit handed out
+	 * first sits where fillContainer() expects it.
+	 */
+	inline static uint64 loadData(const byte *ptr) {
+		uint64 data = MSB2LSB ? READ_BE_UINT64(ptr) : READ_LE_UINT64(ptr);
+
+		// The 64bit load has the byte order of the bit order. Swap the bytes
+		// inside each value if the values themselves are stored the other way.
+		if (valueBits > 8 && isLE == MSB2LSB) {
+			const uint64 mask8  = ((uint64)0x00FF00FF << 32) | 0x00FF00FF;
+			const uint64 mask16 = ((uint64)0x0000FFFF << 32) | 0x0000FFFF;
+
+			data = ((data >> 8) & mask8) | ((data & mask8) << 8);
+			if (valueBits == 32)
+				data = ((data >> 16) & mask16) | ((data & mask16) << 16);
+		}
+
+		return data;
+	}
+
 	/** Fill the container with at least min bits. */
 	inline void fillContainer(size_t min) {
+		if (_bitsLeft >= min)
+			return;
+
+		if (fastRefill && _data) {
+			const uint32 bytePos = (_pos + _bitsLeft) >> 3;
+
+			if (bytePos + 8 <= (_size >> 3)) {
+				// Take as many whole values as fit, at least 32 bits
+				const uint bits = ((64 - _bitsLeft) / valueBits) * valueBits;
+				const uint64 data = loadData(_data + bytePos);
+
+				if (MSB2LSB)
+					_bitContainer |= (data >> (64 - bits)) << (64 - bits - _bitsLeft);
+				else
+					_bitContainer |= (data & (~(uint64)0 >> (64 - bits))) << _bitsLeft;
+
+				_bitsLeft += bits;
+				return;
+			}
+		}
+
 		while (_bitsLeft < min) {
 
 			uint64 data;
@@ -104,15 +163,11 @@ private:
 
 	/** Get n bits from the bit container. */
 	inline static uint32 getNBits(uint64 value, size_t n) {
-		if (n == 0)
-			return 0;
-
-		const size_t toShift = 64 - n;
-
+		// Split shifts and masks keep n == 0 well defined without branching
 		if (MSB2LSB)
-			return value >> toShift;
+			return (value >> 1) >> (63 - n);
 		else
-			return (value << toShift) >> toShift;
+			return value & (((uint64)1 << n) - 1);
 	}
 
 	/** Skip already read bits. */
@@ -132,22 +187,28 @@ private:
 public:
 	/** Create a bit stream using this input data stream and optionally delete it on destruction. */
 	BitStreamImpl(STREAM *stream, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::NO) :
-	    _stream(stream), _disposeAfterUse(disposeAfterUse), _bitContainer(0), _bitsLeft(0), _pos(0) {
+	    _stream(stream), _disposeAfterUse(disposeAfterUse), _data(0), _bitContainer(0), _bitsLeft(0), _pos(0) {
 
 		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
 			error("BitStreamImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, MSB2LSB);
 
 		_size = (_stream->size() & ~((uint32) ((valueBits >> 3) - 1))) * 8;
+
+		if (fastRefill && _stream->pos() == 0)
+			_data = _stream->getDataPointer();
 	}
 
 	/** Create a bit stream using this input data stream. */
 	BitStreamImpl(STREAM &stream) :
-	    _stream(&stream), _disposeAfterUse(DisposeAfterUse::NO), _bitContainer(0), _bitsLeft(0), _pos(0) {
+	    _stream(&stream), _disposeAfterUse(DisposeAfterUse::NO), _data(0), _bitContainer(0), _bitsLeft(0), _pos(0) {
 
 		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
 			error("BitStreamImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, MSB2LSB);
 
 		_size = (_stream->size() & ~((uint32) ((valueBits >> 3) - 1))) * 8;
+
+		if (fastRefill && _stream->pos() == 0)
+			_data = _stream->getDataPointer();
 	}
 
 	~BitStreamImpl() {
@@ -324,6 +385,10 @@ public:
 		return _size;
 	}
 
+	const byte *getDataPointer() const {
+		return _ptrOrig;
+	}
+
 	bool seek(uint32 offset) {
 		assert(offset <= _size);
 
@@ -445,6 +510,11 @@ typedef BitStreamImpl<SeekableReadStream, 32, false, true > BitStream32BEMSB;
 /** 32-bit big-endian data, LSB to MSB. */
 typedef BitStreamImpl<SeekableReadStream, 32, false, false> BitStream32BELSB;
 
+/** 32-bit little-endian data, LSB to MSB, refilled straight from memory where possible. */
+typedef BitStreamImpl<SeekableReadStream, 32, true , false, true> BitStream32LELSBFast;
+/** 32-bit big-endian data, MSB to LSB, refilled straight from memory where possible. */
+typedef BitStreamImpl<SeekableReadStream, 32, false, true , true> BitStream32BEMSBFast;
+
 
 
 /** 8-bit data, MSB to LSB. */
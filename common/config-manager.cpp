@@ -24,6 +24,8 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -52,7 +54,23 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+/** Writes the configurations flushed by flushToDisk(). */
+class ConfigManager::FlushTask : public Task {
+public:
+	explicit FlushTask(ConfigManager *manager) : _manager(manager) {}
+
+	virtual void run() { _manager->writePendingFlushes(); }
+
+private:
+	ConfigManager *_manager;
+};
+
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _flushMutex(nullptr), _hasPendingFlush(false), _flushScheduled(false) {
+}
+
+ConfigManager::~ConfigManager() {
+	waitForFlush();
+	delete _flushMutex;
 }
 
 void ConfigManager::defragment() {
@@ -175,16 +193,37 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	_cloudDomain.clear();
 #endif
 
+	// Config files with many games get large, so read the whole file at
+	// once and split it into lines in place, instead of building a String
+	// for every line.
+	const int32 size = stream.size() - stream.pos();
+	if (size <= 0)
+		return;
+	char *const data = (char *)malloc(size + 1);
+	if (!data)
+		::error("ConfigManager: Not enough memory for a %d bytes config file", size);
+	const uint32 dataSize = stream.read(data, size);
+	data[dataSize] = 0;
+
 	// TODO: Detect if a domain occurs multiple times (or likewise, if
 	// a key occurs multiple times inside one domain).
 
-	while (!stream.eos() && !stream.err()) {
+	char *next = data;
+	char *const dataEnd = data + dataSize;
+	while (next < dataEnd) {
 		lineno++;
 
-		// Read a line
-		String line = stream.readLine();
-
-		if (line.size() == 0) {
+		// Find the end of the line. CR, LF and CR/LF are all line breaks.
+		char *const line = next;
+		char *lineEnd = line;
+		while (lineEnd < dataEnd && *lineEnd != '\n' && *lineEnd != '\r')
+			lineEnd++;
+		next = lineEnd + 1;
+		if (lineEnd < dataEnd && *lineEnd == '\r' && next < dataEnd && *next == '\n')
+			next++;
+		*lineEnd = 0;
+
+		if (line == lineEnd) {
 			// Do nothing
 		} else if (line[0] == '#') {
 			// Accumulate comments here. Once we encounter either the start
@@ -197,7 +236,7 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			// Determine where the previously accumulated domain goes, if we accumulated anything.
 			addDomain(domainName, domain);
 			domain.clear();
-			const char *p = line.c_str() + 1;
+			const char *p = line + 1;
 			// Get the domain name, and check whether it's valid (that
 			// is, verify that it only consists of alphanumerics,
 			// dashes and underscores).
@@ -209,7 +248,7 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			else if (*p != ']')
 				error("Config file buggy: Invalid character '%c' occurred in section name in line %d", *p, lineno);
 
-			domainName = String(line.c_str() + 1, p);
+			domainName = String(line + 1, p);
 
 			domain.setDomainComment(comment);
 			comment.clear();
@@ -218,7 +257,7 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			// This line should be a line with a 'key=value' pair, or an empty one.
 
 			// Skip leading whitespaces
-			const char *t = line.c_str();
+			const char *t = line;
 			while (isSpace(*t))
 				t++;
 
@@ -236,16 +275,20 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 			if (!p)
 				error("Config file buggy: Junk found in line line %d: '%s'", lineno, t);
 
-			// Extract the key/value pair
-			String key(t, p);
-			String value(p + 1);
-
-			// Trim of spaces
-			key.trim();
-			value.trim();
+			// Trim off spaces before building the key/value pair
+			const char *keyEnd = p;
+			while (keyEnd > t && isSpace(keyEnd[-1]))
+				keyEnd--;
+			const char *value = p + 1;
+			while (isSpace(*value))
+				value++;
+			const char *valueEnd = value + strlen(value);
+			while (valueEnd > value && isSpace(valueEnd[-1]))
+				valueEnd--;
 
 			// Finally, store the key/value pair in the active domain
-			domain[key] = value;
+			const String key(t, keyEnd);
+			domain.setVal(key, String(value, valueEnd));
 
 			// Store comment
 			domain.setKVComment(key, comment);
@@ -253,49 +296,32 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 		}
 	}
 
+	free(data);
+
 	addDomain(domainName, domain); // Add the last domain found
 }
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(stream, kApplicationDomain, _appDomain);
 
 #ifdef ENABLE_KEYMAPPER
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(stream, kKeymapperDomain, _keymapperDomain);
 #endif
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(stream, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(stream, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
@@ -304,21 +330,107 @@ void ConfigManager::flushToDisk() {
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
 		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+			writeDomain(stream, *i, _gameDomains[*i]);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
 		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+			writeDomain(stream, d->_key, d->_value);
 	}
 
-	delete stream;
+	const String config = stream.size() ? String((const char *)stream.getData(), stream.size()) : String();
+
+	if (!_flushMutex)
+		_flushMutex = new Mutex();
 
+	{
+		StackLock lock(*_flushMutex);
+		// Most flushes do not change anything, e.g. when starting a game.
+		// While the task runs, the file may already differ from
+		// _flushedConfig, so only idle flushes are skipped.
+		if (_flushFuture.isValid() && !_flushScheduled && config == _flushedConfig)
+			return;
+
+		// Replace any configuration which was not written yet, so that
+		// quick successive flushes only write once. String copies share
+		// their buffer and reference count, so the task gets its own.
+		_pendingFlush = String(config.c_str());
+		_pendingFlushFilename = String(_filename.c_str());
+		_hasPendingFlush = true;
+		if (_flushScheduled)
+			return;
+		_flushScheduled = true;
+	}
+
+	assert(g_system);
+	_flushFuture = g_system->getTaskScheduler()->schedule(new FlushTask(this));
 #endif // !__DC__
 }
 
+void ConfigManager::waitForFlush() {
+	if (_flushFuture.isValid())
+		_flushFuture.wait();
+}
+
+void ConfigManager::writePendingFlushes() {
+	for (;;) {
+		String config;
+		String filename;
+		{
+			StackLock lock(*_flushMutex);
+			if (!_hasPendingFlush) {
+				_flushScheduled = false;
+				return;
+			}
+			config = _pendingFlush;
+			filename = _pendingFlushFilename;
+			_pendingFlush.clear();
+			_pendingFlushFilename.clear();
+			_hasPendingFlush = false;
+		}
+
+		// A failed write is not remembered, so the next flush tries again
+		if (writeConfigFile(config, filename)) {
+			StackLock lock(*_flushMutex);
+			_flushedConfig = String(config.c_str());
+		}
+	}
+}
+
+bool ConfigManager::writeConfigFile(const String &config, const String &filename) {
+	WriteStream *stream;
+
+	if (filename.empty()) {
+		// Write to the default config file
+		stream = g_system->createConfigWriteStream();
+		if (!stream)    // If writing to the config file is not possible, do nothing
+			return false;
+	} else {
+		DumpFile *dump = new DumpFile();
+		assert(dump);
+
+		if (!dump->open(filename)) {
+			warning("Unable to write configuration file: %s", filename.c_str());
+			delete dump;
+			return false;
+		}
+
+		stream = dump;
+	}
+
+	// Write everything at once, to keep the time a partially written file
+	// is on disk short
+	stream->write(config.c_str(), config.size());
+	stream->finalize();
+	const bool success = !stream->err();
+	if (!success)
+		warning("Error writing configuration file");
+	delete stream;
+	return success;
+}
+
 void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
 	if (domain.empty())
 		return; // Don't bother writing empty domains.
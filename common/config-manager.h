@@ -28,9 +28,11 @@
 #include "common/singleton.h"
 #include "common/str.h"
 #include "common/hash-str.h"
+#include "common/taskscheduler.h"
 
 namespace Common {
 
+class Mutex;
 class WriteStream;
 class SeekableReadStream;
 
@@ -149,8 +151,18 @@ public:
 	void				registerDefault(const String &key, int value);
 	void				registerDefault(const String &key, bool value);
 
+	/**
+	 * Write the configuration to disk. The configuration is serialized right
+	 * away, but written by a task of the task scheduler. Flushing again while
+	 * a write is still going on only writes the latest configuration once
+	 * the earlier write is done, and flushing an unchanged configuration
+	 * does not write anything.
+	 */
 	void				flushToDisk();
 
+	/** Wait until everything flushed with flushToDisk() is written. */
+	void				waitForFlush();
+
 	void				setActiveDomain(const String &domName);
 	Domain *			getActiveDomain() { return _activeDomain; }
 	const Domain *		getActiveDomain() const { return _activeDomain; }
@@ -177,10 +189,15 @@ public:
 private:
 	friend class Singleton<SingletonBaseType>;
 	ConfigManager();
+	~ConfigManager();
+
+	class FlushTask;
 
 	void			loadFromStream(SeekableReadStream &stream);
 	void			addDomain(const String &domainName, const Domain &domain);
 	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
+	void			writePendingFlushes();
+	bool			writeConfigFile(const String &config, const String &filename);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
 
 	Domain			_transientDomain;
@@ -203,6 +220,20 @@ private:
 	Domain *		_activeDomain;
 
 	String			_filename;
+
+	/** The configuration the flush task last wrote successfully. */
+	String			_flushedConfig;
+	/**
+	 * Guards _flushedConfig, _pendingFlush and _flushScheduled, shared with
+	 * the flush task.
+	 */
+	Mutex *			_flushMutex;
+	/** Configuration waiting to be written, along with the file to write it to. */
+	String			_pendingFlush;
+	String			_pendingFlushFilename;
+	bool			_hasPendingFlush;
+	bool			_flushScheduled;
+	TaskFuture		_flushFuture;
 };
 
 } // End of namespace Common
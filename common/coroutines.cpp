@@ -20,6 +20,10 @@
  *
  */
 
+// Used by stackful coroutines to abandon the stack of a killed process
+#define FORBIDDEN_SYMBOL_EXCEPTION_setjmp
+#define FORBIDDEN_SYMBOL_EXCEPTION_longjmp
+
 #include "common/coroutines.h"
 #include "common/algorithm.h"
 #include "common/debug.h"
@@ -28,6 +32,11 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 
+#ifdef USE_STACKFUL_COROUTINES
+#include <setjmp.h>
+#include <libco.h>
+#endif
+
 namespace Common {
 
 /** Helper null context instance */
@@ -35,6 +44,81 @@ CoroContext nullContext = nullptr;
 
 DECLARE_SINGLETON(CoroutineScheduler);
 
+#ifdef USE_STACKFUL_COROUTINES
+
+// The size of the stack of each process. Stacks are only allocated for
+// processes running at the same time, and reused once these finish.
+#ifndef CORO_STACK_SIZE
+#define CORO_STACK_SIZE (512 * 1024)
+#endif
+
+CoroContext stackfulSubContext = nullptr;
+
+/**
+ * A stack a process runs on, with the libco thread switching to it.
+ */
+struct CoroStack {
+	cothread_t thread;          ///< the libco thread running on this stack
+	cothread_t caller;          ///< the thread to return to when the process sleeps or ends
+	jmp_buf restart;            ///< where a killed process abandons its coroutines
+	PROCESS *process;           ///< the process running on this stack
+	CoroBaseContext *frames;    ///< context of the innermost running coroutine
+	int sleep;                  ///< cycles to sleep, or 0 once the process ended
+	bool running;               ///< whether the process is active on this stack
+	bool killed;                ///< tells a sleeping process to abandon its coroutines
+	CoroStack *next;            ///< next stack in the free list
+};
+
+namespace {
+
+/** The stack of the process currently running, if any */
+CoroStack *s_currentStack = nullptr;
+
+/**
+ * Entry point of the libco threads. Runs one process after the other,
+ * each time it is switched to with a new process.
+ */
+void runStack() {
+	CoroStack *const stack = s_currentStack;
+
+	for (;;) {
+		stack->running = true;
+		if (!setjmp(stack->restart)) {
+			CoroContext state = nullptr;
+			stack->process->coroAddr(state, stack->process->param);
+		}
+
+		stack->running = false;
+		stack->killed = false;
+		stack->sleep = 0;
+		co_switch(stack->caller);
+	}
+}
+
+/**
+ * Continues the process running on the given stack.
+ */
+void switchToStack(CoroStack *stack) {
+	CoroStack *previous = s_currentStack;
+	s_currentStack = stack;
+	stack->caller = co_active();
+	co_switch(stack->thread);
+	s_currentStack = previous;
+}
+
+/**
+ * Destroys the contexts of all coroutines active on the given stack,
+ * from the innermost one outwards.
+ */
+void destroyFrames(CoroStack *stack) {
+	while (stack->frames)
+		stack->frames->~CoroBaseContext();
+}
+
+} // End of anonymous namespace
+
+#endif // USE_STACKFUL_COROUTINES
+
 #ifdef COROUTINE_DEBUG
 namespace {
 /** Count of active coroutines */
@@ -74,6 +158,15 @@ static void displayCoroStats() {
 
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(nullptr) {
+#ifdef USE_STACKFUL_COROUTINES
+	// Keep track of the contexts on the stack, so they can be destroyed
+	// when the process gets killed
+	_stack = s_currentStack;
+	if (_stack) {
+		_subctx = _stack->frames;
+		_stack->frames = this;
+	}
+#endif
 #ifdef COROUTINE_DEBUG
 	_funcName = func;
 	changeCoroStats(_funcName, +1);
@@ -89,7 +182,14 @@ CoroBaseContext::~CoroBaseContext() {
 	      _funcName, (void *)this, (void *)_subctx);
 	displayCoroStats();
 #endif
+#ifdef USE_STACKFUL_COROUTINES
+	if (_stack) {
+		assert(_stack->frames == this);
+		_stack->frames = _subctx;
+	}
+#else
 	delete _subctx;
+#endif
 }
 
 //--------------------- Scheduler Class ------------------------
@@ -108,6 +208,10 @@ CoroutineScheduler::CoroutineScheduler() {
 	pRCfunction = nullptr;
 	pidCounter = 0;
 
+#ifdef USE_STACKFUL_COROUTINES
+	_freeStacks = nullptr;
+#endif
+
 	active = new PROCESS;
 	active->pPrevious = nullptr;
 	active->pNext = nullptr;
@@ -119,11 +223,23 @@ CoroutineScheduler::~CoroutineScheduler() {
 	// Kill all running processes (i.e. free memory allocated for their state).
 	PROCESS *pProc = active->pNext;
 	while (pProc != nullptr) {
+#ifdef USE_STACKFUL_COROUTINES
+		releaseStack(pProc);
+#endif
 		delete pProc->state;
 		pProc->state = nullptr;
 		pProc = pProc->pNext;
 	}
 
+#ifdef USE_STACKFUL_COROUTINES
+	while (_freeStacks) {
+		CoroStack *stack = _freeStacks;
+		_freeStacks = stack->next;
+		co_delete(stack->thread);
+		delete stack;
+	}
+#endif
+
 	free(processList);
 	processList = nullptr;
 
@@ -158,6 +274,9 @@ void CoroutineScheduler::reset() {
 	// Kill all running processes (i.e. free memory allocated for their state).
 	PROCESS *pProc = active->pNext;
 	while (pProc != nullptr) {
+#ifdef USE_STACKFUL_COROUTINES
+		releaseStack(pProc);
+#endif
 		delete pProc->state;
 		pProc->state = nullptr;
 		Common::fill(&pProc->pidWaiting[0], &pProc->pidWaiting[CORO_MAX_PID_WAITING], 0);
@@ -229,14 +348,19 @@ void CoroutineScheduler::schedule() {
 		if (--pProc->sleepTime <= 0) {
 			// process is ready for dispatch, activate it
 			pCurrent = pProc;
+#ifdef USE_STACKFUL_COROUTINES
+			const int sleep = runProcess(pProc);
+#else
 			pProc->coroAddr(pProc->state, pProc->param);
+			const int sleep = pProc->state ? pProc->state->_sleep : 0;
+#endif
 
-			if (!pProc->state || pProc->state->_sleep <= 0) {
+			if (sleep <= 0) {
 				// Coroutine finished
 				pCurrent = pCurrent->pPrevious;
 				killProcess(pProc);
 			} else {
-				pProc->sleepTime = pProc->state->_sleep;
+				pProc->sleepTime = sleep;
 			}
 
 			// pCurrent may have been changed
@@ -488,6 +612,74 @@ void CoroutineScheduler::sleep(CORO_PARAM, uint32 duration) {
 	CORO_END_CODE;
 }
 
+#ifdef USE_STACKFUL_COROUTINES
+void CoroutineScheduler::suspend(int delay) {
+	CoroStack *stack = s_currentStack;
+	if (!stack)
+		error("Coroutine tried to sleep outside of a process");
+
+	stack->sleep = delay;
+	co_switch(stack->caller);
+
+	// The process has been killed while sleeping: the contexts are gone
+	// already, so just drop everything on the stack
+	if (stack->killed)
+		longjmp(stack->restart, 1);
+}
+
+void CoroutineScheduler::killSelf() {
+	CoroStack *stack = s_currentStack;
+	if (!stack)
+		return;
+
+	destroyFrames(stack);
+	longjmp(stack->restart, 1);
+}
+
+int CoroutineScheduler::runProcess(PROCESS *pProc) {
+	CoroStack *stack = pProc->stack;
+	if (!stack) {
+		// First time the process runs, get it a stack
+		if (_freeStacks) {
+			stack = _freeStacks;
+			_freeStacks = stack->next;
+		} else {
+			stack = new CoroStack();
+			stack->thread = co_create(CORO_STACK_SIZE, runStack);
+			if (!stack->thread)
+				error("Cannot allocate memory for coroutine stack");
+		}
+
+		stack->process = pProc;
+		stack->frames = nullptr;
+		stack->killed = false;
+		pProc->stack = stack;
+	}
+
+	switchToStack(stack);
+	return stack->sleep;
+}
+
+void CoroutineScheduler::releaseStack(PROCESS *pProc) {
+	CoroStack *stack = pProc->stack;
+	if (!stack)
+		return;
+
+	if (stack->running) {
+		// The process is sleeping inside its coroutines. Destroy their
+		// contexts, and let the process abandon the stack
+		assert(stack != s_currentStack);
+		destroyFrames(stack);
+		stack->killed = true;
+		switchToStack(stack);
+	}
+
+	stack->next = _freeStacks;
+	_freeStacks = stack;
+	pProc->stack = nullptr;
+}
+#endif
+
 PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const void *pParam, int sizeParam) {
 	PROCESS *pProc;
 
@@ -533,6 +725,9 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// clear coroutine state
 	pProc->state = nullptr;
+#ifdef USE_STACKFUL_COROUTINES
+	pProc->stack = nullptr;
+#endif
 
 	// wake process up as soon as possible
 	pProc->sleepTime = 1;
@@ -578,6 +773,9 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 	if (pRCfunction != nullptr)
 		(pRCfunction)(pKillProc);
 
+#ifdef USE_STACKFUL_COROUTINES
+	releaseStack(pKillProc);
+#endif
 	delete pKillProc->state;
 	pKillProc->state = nullptr;
 
@@ -627,6 +825,9 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 				if (pRCfunction != nullptr)
 					(pRCfunction)(pProc);
 
+#ifdef USE_STACKFUL_COROUTINES
+				releaseStack(pProc);
+#endif
 				delete pProc->state;
 				pProc->state = nullptr;
 
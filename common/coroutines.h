@@ -46,6 +46,18 @@ namespace Common {
 // Enable this macro to enable some debugging support in the coroutine code.
 //#define COROUTINE_DEBUG
 
+/**
+ * With USE_STACKFUL_COROUTINES, the coroutine macros below don't simulate
+ * resumable functions through a switch statement, but every process runs
+ * on a stack of its own and sleeping simply switches back to the scheduler.
+ * Contexts are then plain local variables of the coroutine functions, so
+ * calling a coroutine doesn't allocate anything. This depends on the stack
+ * switching provided by libco, so ports without it use the macro version.
+ */
+#ifdef USE_STACKFUL_COROUTINES
+struct CoroStack;
+#endif
+
 /**
  * The core of any coroutine context which captures the 'state' of a coroutine.
  * Private use only.
@@ -53,7 +65,15 @@ namespace Common {
 struct CoroBaseContext {
 	int _line;
 	int _sleep;
+	/**
+	 * The context of the invoked coroutine. With stackful coroutines, this
+	 * is the context of the calling coroutine instead.
+	 */
 	CoroBaseContext *_subctx;
+#ifdef USE_STACKFUL_COROUTINES
+	/** The stack of the process this context lives on, if any */
+	CoroStack *_stack;
+#endif
 #ifdef COROUTINE_DEBUG
 	const char *_funcName;
 #endif
@@ -132,6 +152,78 @@ public:
  CoroContextTag() : CoroBaseContext(SCUMMVM_CURRENT_FUNCTION) { DUMMY = 0; } \
 		int DUMMY
 
+#ifdef USE_STACKFUL_COROUTINES
+
+/**
+ * End the declaration of a coroutine context.
+ * @param x name of the coroutine context
+ * @see CORO_BEGIN_CONTEXT
+ */
+#define CORO_END_CONTEXT(x)    } x##Frame; CoroContextTag *x = &x##Frame
+
+/**
+ * Begin the code section of a coroutine.
+ * @param x name of the coroutine context
+ * @see CORO_BEGIN_CODE
+ */
+#define CORO_BEGIN_CODE(x) \
+	x->DUMMY = 0; \
+	switch (0) { case 0:;
+
+/**
+ * End the code section of a coroutine.
+ * @see CORO_END_CODE
+ */
+#define CORO_END_CODE \
+	}
+
+/**
+ * Sleep for the specified number of scheduler cycles.
+ */
+#define CORO_SLEEP(delay) \
+	CoroScheduler.suspend(delay)
+
+#define CORO_GIVE_WAY do { CoroScheduler.giveWay(); CORO_SLEEP(1); } while (0)
+#define CORO_RESCHEDULE do { CoroScheduler.reschedule(); CORO_SLEEP(1); } while (0)
+
+/**
+ * Stop the currently running coroutine and all calling coroutines.
+ */
+#define CORO_KILL_SELF() \
+	do { if (&coroParam != &Common::nullContext) { CoroScheduler.killSelf(); } return; } while (0)
+
+/**
+ * This macro is to be used in conjunction with CORO_INVOKE_ARGS and
+ * similar macros for calling coroutines-enabled subroutines.
+ */
+#define CORO_SUBCTX   Common::stackfulSubContext
+
+/**
+ * Invoke another coroutine. As it runs on the same stack, this is
+ * a plain function call.
+ */
+#define CORO_INVOKE_ARGS(subCoro, ARGS) \
+	do { \
+		subCoro ARGS; \
+	} while (0)
+
+/**
+ * Invoke another coroutine. Similar to CORO_INVOKE_ARGS, the result
+ * is only needed by the macro based coroutines.
+ */
+#define CORO_INVOKE_ARGS_V(subCoro, RESULT, ARGS) \
+	do { \
+		subCoro ARGS; \
+	} while (0)
+
+/**
+ * Context passed to invoked coroutines. It is always null, since
+ * stackful coroutines keep their contexts on the stack.
+ */
+extern CoroContext stackfulSubContext;
+
+#else
+
 /**
  * End the declaration of a coroutine context.
  * @param x name of the coroutine context
@@ -246,6 +338,8 @@ public:
 		} while (1); \
 	} while (0)
 
+#endif // USE_STACKFUL_COROUTINES
+
 /**
  * Convenience wrapper for CORO_INVOKE_ARGS for invoking a coroutine
  * with no parameters.
@@ -309,6 +403,9 @@ struct PROCESS {
 	uint32 pid;         ///< process ID
 	uint32 pidWaiting[CORO_MAX_PID_WAITING];    ///< Process ID(s) process is currently waiting on
 	char param[CORO_PARAM_SIZE];    ///< process specific info
+#ifdef USE_STACKFUL_COROUTINES
+	CoroStack *stack;   ///< the stack the process runs on, once it has started
+#endif
 };
 typedef PROCESS *PPROCESS;
 
@@ -382,6 +479,23 @@ private:
 
 	PROCESS *getProcess(uint32 pid);
 	EVENT *getEvent(uint32 pid);
+
+#ifdef USE_STACKFUL_COROUTINES
+	/** Stacks of finished processes, kept for reuse */
+	CoroStack *_freeStacks;
+
+	/**
+	 * Runs the given process on its stack until it sleeps or ends.
+	 * @return      The number of cycles to sleep, or 0 if the process ended
+	 */
+	int runProcess(PROCESS *pProc);
+
+	/**
+	 * Destroys the contexts of a process, and returns its stack to the pool.
+	 */
+	void releaseStack(PROCESS *pProc);
+#endif
+
 public:
 	/**
 	 * Kills all processes and places them on the free list.
@@ -448,6 +562,20 @@ public:
 	 */
 	void sleep(CORO_PARAM, uint32 duration);
 
+#ifdef USE_STACKFUL_COROUTINES
+	/**
+	 * Suspends the running process for the given number of scheduler cycles.
+	 * Used by CORO_SLEEP.
+	 */
+	void suspend(int delay);
+
+	/**
+	 * Ends the running process, destroying the contexts of all its coroutines.
+	 * Used by CORO_KILL_SELF. Does nothing when called outside of a process.
+	 */
+	void killSelf();
+#endif
+
 	/**
 	 * Creates a new process.
 	 *
@@ -456,10 +456,188 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 	return true; // For targets featuring dynamic size we always succeed
 }
 
-bool decompressDCL(ReadStream *src, byte *dest, uint32 packedSize, uint32 unpackedSize) {
-	bool success = false;
-	DecompressorDCL dcl;
+/**
+ * Decompresses from memory to memory. It decodes the same data as
+ * DecompressorDCL, but keeps up to 64 bits in its bit buffer, so it only
+ * has to refill it once per token. The Huffman codes are decoded through
+ * tables for their first 8 bits. Matches are copied straight from the
+ * output, as the dictionary is never larger than the distances it allows.
+ */
+class FastDecompressorDCL {
+public:
+	FastDecompressorDCL(const byte *source, uint32 sourceSize, byte *target, uint32 targetSize);
+
+	bool unpack();
+
+private:
+	enum {
+		kTableBits = 8
+	};
+
+	/** The result of decoding the first kTableBits bits of a code */
+	struct TableEntry {
+		uint16 value;  ///< The value of a leaf, otherwise the tree node reached
+		byte bits;     ///< The number of bits used
+		bool leaf;
+	};
+
+	static void buildTable(const int *tree, TableEntry *table);
+
+	void refill() {
+		// Past the end of the source, zeros are read like from a stream at its end
+		while (_nBits <= 56) {
+			if (_source < _sourceEnd)
+				_bits |= (uint64)*_source++ << _nBits;
+			_nBits += 8;
+		}
+	}
+
+	uint32 getBits(int n) {
+		uint32 ret = (uint32)(_bits & ((1 << n) - 1));
+		_bits >>= n;
+		_nBits -= n;
+		return ret;
+	}
+
+	int decode(const int *tree, const TableEntry *table);
+
+	const byte *_source;
+	const byte *_sourceEnd;
+	byte *const _target;
+	const uint32 _targetSize;
+	uint32 _bytesWritten;
+
+	uint64 _bits;
+	int _nBits;
+
+	TableEntry _lengthTable[1 << kTableBits];
+	TableEntry _distanceTable[1 << kTableBits];
+	TableEntry _asciiTable[1 << kTableBits];
+};
+
+FastDecompressorDCL::FastDecompressorDCL(const byte *source, uint32 sourceSize, byte *target, uint32 targetSize) :
+		_source(source), _sourceEnd(source + sourceSize), _target(target), _targetSize(targetSize), _bytesWritten(0),
+		_bits(0), _nBits(0) {
+}
+
+void FastDecompressorDCL::buildTable(const int *tree, TableEntry *table) {
+	for (uint code = 0; code < (1 << kTableBits); code++) {
+		int pos = 0;
+		byte bits = 0;
+
+		while (!(tree[pos] & HUFFMAN_LEAF) && bits < kTableBits) {
+			pos = ((code >> bits) & 1) ? tree[pos] & 0xFFF : tree[pos] >> 12;
+			bits++;
+		}
+
+		table[code].leaf = (tree[pos] & HUFFMAN_LEAF) != 0;
+		table[code].value = table[code].leaf ? tree[pos] & 0xFFFF : pos;
+		table[code].bits = bits;
+	}
+}
+
+int FastDecompressorDCL::decode(const int *tree, const TableEntry *table) {
+	const TableEntry &entry = table[_bits & ((1 << kTableBits) - 1)];
+	_bits >>= entry.bits;
+	_nBits -= entry.bits;
+
+	if (entry.leaf)
+		return entry.value;
+
+	// Only the longest literal codes of the ASCII tree get here
+	int pos = entry.value;
+	while (!(tree[pos] & HUFFMAN_LEAF))
+		pos = getBits(1) ? tree[pos] & 0xFFF : tree[pos] >> 12;
+	return tree[pos] & 0xFFFF;
+}
+
+bool FastDecompressorDCL::unpack() {
+	refill();
+	const byte mode = getBits(8);
+	const byte dictionaryType = getBits(8);
+
+	if (mode != DCL_BINARY_MODE && mode != DCL_ASCII_MODE) {
+		warning("DCL-INFLATE: Error: Encountered mode %02x, expected 00 or 01", mode);
+		return false;
+	}
+
+	if (dictionaryType < 4 || dictionaryType > 6) {
+		warning("DCL-INFLATE: Error: unsupported dictionary type %02x", dictionaryType);
+		return false;
+	}
+
+	buildTable(length_tree, _lengthTable);
+	buildTable(distance_tree, _distanceTable);
+	if (mode == DCL_ASCII_MODE)
+		buildTable(ascii_tree, _asciiTable);
+
+	while (_bytesWritten < _targetSize) {
+		// A token takes at most 30 bits, a literal at most 14
+		refill();
+
+		if (getBits(1)) { // (length,distance) pair
+			int value = decode(length_tree, _lengthTable);
+
+			uint32 tokenLength;
+			if (value < 8)
+				tokenLength = value + 2;
+			else
+				tokenLength = 8 + (1 << (value - 7)) + getBits(value - 7);
+
+			if (tokenLength == 519)
+				break; // End of stream signal
+
+			value = decode(distance_tree, _distanceTable);
+
+			uint32 tokenOffset;
+			if (tokenLength == 2)
+				tokenOffset = (value << 2) | getBits(2);
+			else
+				tokenOffset = (value << dictionaryType) | getBits(dictionaryType);
+			tokenOffset++;
+
+			if (tokenLength + _bytesWritten > _targetSize) {
+				warning("DCL-INFLATE Error: Write out of bounds while copying %d bytes (declared unpacked size is %d bytes, current is %d + %d bytes)",
+						tokenLength, _targetSize, _bytesWritten, tokenLength);
+				return false;
+			}
+
+			if (_bytesWritten < tokenOffset) {
+				warning("DCL-INFLATE Error: Attempt to copy from before beginning of input stream (declared unpacked size is %d bytes, current is %d bytes)",
+						_targetSize, _bytesWritten);
+				return false;
+			}
 
+			byte *dst = _target + _bytesWritten;
+			const byte *src = dst - tokenOffset;
+			_bytesWritten += tokenLength;
+
+			if (tokenOffset >= tokenLength) {
+				memcpy(dst, src, tokenLength);
+			} else {
+				// The match overlaps itself and repeats the last tokenOffset bytes
+				while (tokenLength--)
+					*dst++ = *src++;
+			}
+		} else { // Copy byte verbatim
+			_target[_bytesWritten++] = (mode == DCL_ASCII_MODE) ? decode(ascii_tree, _asciiTable) : getBits(8);
+		}
+	}
+
+	if (_bytesWritten != _targetSize)
+		warning("DCL-INFLATE Error: Inconsistent bytes written (%d) and target buffer size (%d)", _bytesWritten, _targetSize);
+	return _bytesWritten == _targetSize;
+}
+
+bool decompressDCL(const byte *source, uint32 packedSize, byte *dest, uint32 unpackedSize) {
+	if (!source || !dest)
+		return false;
+
+	FastDecompressorDCL dcl(source, packedSize, dest, unpackedSize);
+	return dcl.unpack();
+}
+
+bool decompressDCL(ReadStream *src, byte *dest, uint32 packedSize, uint32 unpackedSize) {
 	if (!src || !dest)
 		return false;
 
@@ -470,29 +648,25 @@ bool decompressDCL(ReadStream *src, byte *dest, uint32 packedSize, uint32 unpack
 	// Read source into memory
 	src->read(sourceBufferPtr, packedSize);
 
-	Common::MemoryReadStream  *sourceStream = new MemoryReadStream(sourceBufferPtr, packedSize, DisposeAfterUse::YES);
-	Common::MemoryWriteStream *targetStream = new MemoryWriteStream(dest, unpackedSize);
-
-	success = dcl.unpack(sourceStream, targetStream, unpackedSize, true);
-	delete sourceStream;
-	delete targetStream;
+	bool success = decompressDCL(sourceBufferPtr, packedSize, dest, unpackedSize);
+	free(sourceBufferPtr);
 	return success;
 }
 
 SeekableReadStream *decompressDCL(SeekableReadStream *sourceStream, uint32 packedSize, uint32 unpackedSize) {
-	bool success = false;
-	byte *targetPtr = nullptr;
-	Common::MemoryWriteStream *targetStream;
-	DecompressorDCL dcl;
-
-	targetPtr = (byte *)malloc(unpackedSize);
+	byte *targetPtr = (byte *)malloc(unpackedSize);
 	if (!targetPtr)
 		return nullptr;
 
-	targetStream = new MemoryWriteStream(targetPtr, unpackedSize);
-
-	success = dcl.unpack(sourceStream, targetStream, unpackedSize, true);
-	delete targetStream;
+	bool success;
+	const byte *data = sourceStream->getDataPointer();
+	if (data && sourceStream->pos() + packedSize <= (uint32)sourceStream->size()) {
+		// Decompress straight from memory the stream already holds
+		success = decompressDCL(data + sourceStream->pos(), packedSize, targetPtr, unpackedSize);
+		sourceStream->skip(packedSize);
+	} else {
+		success = decompressDCL(sourceStream, targetPtr, packedSize, unpackedSize);
+	}
 
 	if (!success) {
 		free(targetPtr);
@@ -24,6 +24,7 @@
 #define COMMON_DEBUG_CHANNELS_H
 
 #include "common/scummsys.h"
+#include "common/debug.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -123,10 +124,9 @@ private:
 	typedef HashMap<String, DebugChannel, IgnoreCase_Hash, IgnoreCase_EqualTo> DebugChannelMap;
 
 	DebugChannelMap gDebugChannels;
-	uint32 gDebugChannelsEnabled;
 
 	friend class Singleton<SingletonBaseType>;
-	DebugManager() : gDebugChannelsEnabled(0) {}
+	DebugManager() { gDebugChannelsEnabled = 0; }
 };
 
 /** Shortcut for accessing the debug manager. */
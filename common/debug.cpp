@@ -31,6 +31,7 @@
 // TODO: Move gDebugLevel into namespace Common.
 int gDebugLevel = -1;
 bool gDebugChannelsOnly = false;
+uint32 gDebugChannelsEnabled = 0;
 
 namespace Common {
 
@@ -120,18 +121,6 @@ bool DebugManager::isDebugChannelEnabled(uint32 channel, bool enforce) {
 
 } // End of namespace Common
 
-bool debugLevelSet(int level) {
-	return level <= gDebugLevel;
-}
-
-bool debugChannelSet(int level, uint32 debugChannels) {
-	if (gDebugLevel != 11 || level == -1)
-		if ((level != -1 && level > gDebugLevel) || !(DebugMan.isDebugChannelEnabled(debugChannels, level == -1)))
-			return false;
-
-	return true;
-}
-
 
 #ifndef DISABLE_TEXT_CONSOLE
 
@@ -161,7 +150,7 @@ void debug(const char *s, ...) {
 void debug(int level, const char *s, ...) {
 	va_list va;
 
-	if (level > gDebugLevel || gDebugChannelsOnly)
+	if (!debugLevelSet(level) || gDebugChannelsOnly)
 		return;
 
 	va_start(va, s);
@@ -184,7 +173,7 @@ void debugN(const char *s, ...) {
 void debugN(int level, const char *s, ...) {
 	va_list va;
 
-	if (level > gDebugLevel || gDebugChannelsOnly)
+	if (!debugLevelSet(level) || gDebugChannelsOnly)
 		return;
 
 	va_start(va, s);
@@ -195,10 +184,8 @@ void debugN(int level, const char *s, ...) {
 void debugC(int level, uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (level > gDebugLevel || !(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugCEnabled(level, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va);
@@ -208,10 +195,8 @@ void debugC(int level, uint32 debugChannels, const char *s, ...) {
 void debugCN(int level, uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (level > gDebugLevel || !(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugCEnabled(level, debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va, false);
@@ -221,10 +206,8 @@ void debugCN(int level, uint32 debugChannels, const char *s, ...) {
 void debugC(uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (!(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugCEnabled(debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va);
@@ -234,10 +217,8 @@ void debugC(uint32 debugChannels, const char *s, ...) {
 void debugCN(uint32 debugChannels, const char *s, ...) {
 	va_list va;
 
-	// Debug level 11 turns on all special debug level messages
-	if (gDebugLevel != 11)
-		if (!(DebugMan.isDebugChannelEnabled(debugChannels)))
-			return;
+	if (!debugCEnabled(debugChannels))
+		return;
 
 	va_start(va, s);
 	debugHelper(s, va, false);
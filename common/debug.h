@@ -109,19 +109,6 @@ void debugCN(uint32 debugChannels, const char *s, ...) GCC_PRINTF(2, 3);
 
 #endif
 
-/**
- * Returns true if the debug level is set to the specified level
- */
-bool debugLevelSet(int level);
-
-/**
- * Returns true if the debug level and channel are active
- *
- * @param level debug level to check against. If set to -1, only channel check is active
- * @see enableDebugChannel
- */
-bool debugChannelSet(int level, uint32 debugChannels);
-
 /**
  * The debug level. Initially set to -1, indicating that no debug output
  * should be shown. Positive values usually imply an increasing number of
@@ -139,6 +126,75 @@ extern int gDebugLevel;
  */
 extern bool gDebugChannelsOnly;
 
+/**
+ * The debug channels currently enabled, maintained by the DebugManager.
+ */
+extern uint32 gDebugChannelsEnabled;
+
+#ifndef DEBUG_LEVEL_MAX
+/**
+ * Debug output above this level is never shown. Set it with the
+ * --debug-level-max configure option, so that the checks below are
+ * constant for higher levels and guarded debug output is left out of the
+ * build altogether.
+ */
+#define DEBUG_LEVEL_MAX 0x7FFFFFFF
+#endif
+
+/**
+ * Returns true if the debug level is set to the specified level
+ */
+inline bool debugLevelSet(int level) {
+	return level <= DEBUG_LEVEL_MAX && level <= gDebugLevel;
+}
+
+/**
+ * Returns true if the debug level and channel are active
+ *
+ * @param level debug level to check against. If set to -1, only channel check is active
+ * @see enableDebugChannel
+ */
+inline bool debugChannelSet(int level, uint32 debugChannels) {
+	if (level > DEBUG_LEVEL_MAX)
+		return false;
+	// Debug level 11 turns on all special debug level messages
+	if (level != -1 && gDebugLevel == 11)
+		return true;
+	return (level == -1 || level <= gDebugLevel) && (gDebugChannelsEnabled & debugChannels) != 0;
+}
+
+/**
+ * Returns true if debugC() and debugCN() would show output for the given
+ * level and channels.
+ *
+ * The check is inline and cheap, and constant when the level is above
+ * DEBUG_LEVEL_MAX. Guarding debug output in hot code with it avoids the
+ * call and evaluating the arguments when the output is not shown:
+ *
+ *   if (debugCEnabled(2, kDebugLevelScripts))
+ *       debugC(2, kDebugLevelScripts, "%s()", getOpcodeName(op));
+ */
+inline bool debugCEnabled(int level, uint32 debugChannels) {
+#ifdef DISABLE_TEXT_CONSOLE
+	return false;
+#else
+	return level <= DEBUG_LEVEL_MAX &&
+		(gDebugLevel == 11 || (level <= gDebugLevel && (gDebugChannelsEnabled & debugChannels) != 0));
+#endif
+}
+
+/**
+ * Returns true if debugC() and debugCN() would show output for the given
+ * channels, when called without a level.
+ */
+inline bool debugCEnabled(uint32 debugChannels) {
+#ifdef DISABLE_TEXT_CONSOLE
+	return false;
+#else
+	return gDebugLevel == 11 || (gDebugChannelsEnabled & debugChannels) != 0;
+#endif
+}
+
 //Global constant for EventRecorder debug channel
 enum GlobalDebugLevels {
 	kDebugLevelEventRec = 1 << 30
@@ -31,6 +31,14 @@
 #include "common/util.h"
 #include "common/textconsole.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FFT_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FFT_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
 FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
@@ -176,11 +184,95 @@ static void name(Complex *z, const float *wre, unsigned int n) { \
 	} while(--n);\
 }
 
+#if defined(FFT_USE_SSE2) || defined(FFT_USE_NEON)
+
+#undef BUTTERFLIES
+#define BUTTERFLIES BUTTERFLIES_BIG
+
+// Two complex values, laid out as re0, im0, re1, im1
+
+#ifdef FFT_USE_SSE2
+typedef __m128 FFTVec;
+
+static inline FFTVec vecLoad(const Complex *z) { return _mm_loadu_ps(&z->re); }
+static inline void vecStore(Complex *z, FFTVec v) { _mm_storeu_ps(&z->re, v); }
+static inline FFTVec vecSet(float a, float b) { return _mm_set_ps(b, b, a, a); }
+static inline FFTVec vecAdd(FFTVec a, FFTVec b) { return _mm_add_ps(a, b); }
+static inline FFTVec vecSub(FFTVec a, FFTVec b) { return _mm_sub_ps(a, b); }
+static inline FFTVec vecMul(FFTVec a, FFTVec b) { return _mm_mul_ps(a, b); }
+static inline FFTVec vecSwap(FFTVec v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline FFTVec vecNegRe(FFTVec v) { return _mm_xor_ps(v, _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000))); }
+static inline FFTVec vecNegIm(FFTVec v) { return _mm_xor_ps(v, _mm_castsi128_ps(_mm_set_epi32(0x80000000, 0, 0x80000000, 0))); }
+#else
+typedef float32x4_t FFTVec;
+
+static inline FFTVec vecLoad(const Complex *z) { return vld1q_f32(&z->re); }
+static inline void vecStore(Complex *z, FFTVec v) { vst1q_f32(&z->re, v); }
+static inline FFTVec vecSet(float a, float b) { return vcombine_f32(vdup_n_f32(a), vdup_n_f32(b)); }
+static inline FFTVec vecAdd(FFTVec a, FFTVec b) { return vaddq_f32(a, b); }
+static inline FFTVec vecSub(FFTVec a, FFTVec b) { return vsubq_f32(a, b); }
+static inline FFTVec vecMul(FFTVec a, FFTVec b) { return vmulq_f32(a, b); }
+static inline FFTVec vecSwap(FFTVec v) { return vrev64q_f32(v); }
+static inline FFTVec vecNegMask(FFTVec v, uint32 re, uint32 im) {
+	const uint32x4_t mask = vcombine_u32(vcreate_u32(((uint64)im << 32) | re), vcreate_u32(((uint64)im << 32) | re));
+	return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), mask));
+}
+static inline FFTVec vecNegRe(FFTVec v) { return vecNegMask(v, 0x80000000, 0); }
+static inline FFTVec vecNegIm(FFTVec v) { return vecNegMask(v, 0, 0x80000000); }
+#endif
+
+/**
+ * Vectorized version of pass(), doing two TRANSFORMs at once. It performs
+ * the same operations in the same order, so the results match pass().
+ * All inputs are loaded before storing, so it also replaces pass_big().
+ */
+static void pass_simd(Complex *z, const float *wre, unsigned int n) {
+	float t1, t2, t3, t4, t5, t6;
+	int o1 = 2 * n;
+	int o2 = 4 * n;
+	int o3 = 6 * n;
+	const float *wim = wre + o1;
+	n--;
+
+	TRANSFORM_ZERO(z[0], z[o1], z[o2], z[o3]);
+	TRANSFORM(z[1], z[o1 + 1], z[o2 + 1], z[o3 + 1], wre[1], wim[-1]);
+	do {
+		z += 2;
+		wre += 2;
+		wim -= 2;
+
+		const FFTVec wr = vecSet(wre[0], wre[1]);
+		const FFTVec wi = vecSet(wim[0], wim[-1]);
+
+		const FFTVec a0 = vecLoad(z);
+		const FFTVec a1 = vecLoad(z + o1);
+		const FFTVec a2 = vecLoad(z + o2);
+		const FFTVec a3 = vecLoad(z + o3);
+
+		// (t1, t2) = a2 * conj(w), (t5, t6) = a3 * w
+		const FFTVec t12 = vecAdd(vecMul(a2, wr), vecNegIm(vecMul(vecSwap(a2), wi)));
+		const FFTVec t56 = vecAdd(vecMul(a3, wr), vecNegRe(vecMul(vecSwap(a3), wi)));
+
+		// (t5 + t1, t6 + t2) and (t4, t3)
+		const FFTVec sum  = vecAdd(t56, t12);
+		const FFTVec diff = vecNegIm(vecSwap(vecSub(t12, t56)));
+
+		vecStore(z,      vecAdd(a0, sum));
+		vecStore(z + o2, vecSub(a0, sum));
+		vecStore(z + o1, vecAdd(a1, diff));
+		vecStore(z + o3, vecSub(a1, diff));
+	} while (--n);
+}
+
+#else
+
 PASS(pass)
 #undef BUTTERFLIES
 #define BUTTERFLIES BUTTERFLIES_BIG
 PASS(pass_big)
 
+#endif // FFT_USE_SSE2 || FFT_USE_NEON
+
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -245,10 +337,14 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
+#if defined(FFT_USE_SSE2) || defined(FFT_USE_NEON)
+		pass_simd(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#else
 		if (n > 1024)
 			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
 		else
 			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#endif
 	}
 }
 
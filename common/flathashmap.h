@@ -0,0 +1,555 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// The open addressing scheme in this file follows the "Swiss table" design
+// used by Abseil: a separate array of control bytes, probed a group at a
+// time, in front of the inline key/value slots.
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/func.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLATHASHMAP_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define FLATHASHMAP_USE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap for maps which
+ * are looked up very often, like caches keyed by small integers.
+ *
+ * Keys and values are stored inline in one array instead of in separately
+ * allocated nodes, and each slot has a control byte holding 7 bits of its
+ * hash. A lookup compares the control bytes of a group of 16 slots at once
+ * (with SSE2 or NEON where available) and usually touches only the one
+ * slot holding the key.
+ *
+ * The interface is the same as the one of HashMap, with one important
+ * difference: inserting may move the stored keys and values, so pointers
+ * and references to them, as well as iterators, are only valid until the
+ * next insertion. Erasing never moves anything.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(const Key &key, const Val &value) : _value(value), _key(key) {}
+	};
+
+	enum {
+		FLATHASHMAP_GROUP_WIDTH = 16,
+		FLATHASHMAP_MIN_CAPACITY = FLATHASHMAP_GROUP_WIDTH,
+
+		// The storage is grown once more than 7/8 of the slots are either
+		// used or marked as erased. This is higher than for HashMap, since
+		// probing a group is cheap.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	/**
+	 * Control byte values. Used slots store the low 7 bits of their hash,
+	 * so the high bit is set exactly for the unused slots.
+	 */
+	enum {
+		kCtrlEmpty = 0x80,
+		kCtrlDeleted = 0xFE
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	byte *_control;     ///< One control byte per slot.
+	Node *_slots;       ///< Raw storage, only slots with a used control byte are constructed.
+	size_type _mask;    ///< Capacity minus one; the capacity is a power of two and a multiple of the group width.
+	size_type _size;
+	size_type _deleted; ///< Number of slots marked kCtrlDeleted.
+	uint _groupShift;   ///< Shift selecting the top bits of a hash as group index.
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/**
+	 * Spread the bits of the hash, since the trivial hashes of integers
+	 * would otherwise put consecutive keys into the same group.
+	 */
+	static uint mix(uint hash) {
+		return hash * 0x9E3779B1;
+	}
+
+	/** The bits of the 16 slots in a group whose control byte is value. */
+	static uint32 matchGroup(const byte *group, byte value) {
+#if defined(FLATHASHMAP_USE_SSE2)
+		const __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+		return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)value)));
+#elif defined(FLATHASHMAP_USE_NEON)
+		static const uint8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t match = vandq_u8(vceqq_u8(vld1q_u8(group), vdupq_n_u8(value)), vld1q_u8(bits));
+		return (uint32)vaddv_u8(vget_low_u8(match)) | ((uint32)vaddv_u8(vget_high_u8(match)) << 8);
+#else
+		uint32 mask = 0;
+		for (int i = 0; i < FLATHASHMAP_GROUP_WIDTH; ++i) {
+			if (group[i] == value)
+				mask |= 1 << i;
+		}
+		return mask;
+#endif
+	}
+
+	/** The bits of the 16 slots in a group which are empty or erased. */
+	static uint32 matchUnused(const byte *group) {
+#if defined(FLATHASHMAP_USE_SSE2)
+		return (uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+		uint32 mask = 0;
+		for (int i = 0; i < FLATHASHMAP_GROUP_WIDTH; ++i) {
+			if (group[i] & 0x80)
+				mask |= 1 << i;
+		}
+		return mask;
+#endif
+	}
+
+	/** Index of the lowest set bit of a non-zero mask. */
+	static int lowestBit(uint32 mask) {
+#if defined(__GNUC__)
+		return __builtin_ctz(mask);
+#else
+		int bit = 0;
+		while (!(mask & 1)) {
+			mask >>= 1;
+			bit++;
+		}
+		return bit;
+#endif
+	}
+
+	bool isUsed(size_type idx) const { return !(_control[idx] & 0x80); }
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	size_type findUnusedSlot(uint hash) const;
+	void rehash(size_type newCapacity);
+
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isUsed(_idx));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextUsed(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	/** The first used slot at or after idx, or (size_type)-1. */
+	size_type nextUsed(size_type idx) const {
+		for (; idx <= _mask; ++idx) {
+			if (isUsed(idx))
+				return idx;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() { return iterator(nextUsed(0), this); }
+	iterator	end() { return iterator((size_type)-1, this); }
+
+	const_iterator	begin() const { return const_iterator(nextUsed(0), this); }
+	const_iterator	end() const { return const_iterator((size_type)-1, this); }
+
+	iterator	find(const Key &key) { return iterator(lookup(key), this); }
+	const_iterator	find(const Key &key) const { return const_iterator(lookup(key), this); }
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating empty storage.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+	_mask = capacity - 1;
+	_groupShift = 32;
+	for (size_type groups = capacity / FLATHASHMAP_GROUP_WIDTH; groups > 1; groups >>= 1)
+		_groupShift--;
+	// A single group is selected by masking with zero instead
+	_groupShift &= 31;
+
+	_control = new byte[capacity];
+	assert(_control != nullptr);
+	memset(_control, kCtrlEmpty, capacity);
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	assert(_slots != nullptr);
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	delete[] _control;
+	free(_slots);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slots are simply copied one by one, the probe sequences stay valid
+	memcpy(_control, map._control, _mask + 1);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(ctr))
+			new ((void *)&_slots[ctr]) Node(map._slots[ctr]);
+	}
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(ctr))
+			_slots[ctr].~Node();
+	}
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_control, kCtrlEmpty, _mask + 1);
+		_size = 0;
+		_deleted = 0;
+	}
+}
+
+/**
+ * Internal method for moving all elements into storage of the given
+ * capacity, which also drops the slots marked as erased.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	byte *oldControl = _control;
+	Node *oldSlots = _slots;
+	const size_type oldSize = _size;
+	const size_type oldMask = _mask;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (oldControl[ctr] & 0x80)
+			continue;
+
+		const uint hash = mix(_hash(oldSlots[ctr]._key));
+		const size_type idx = findUnusedSlot(hash);
+		_control[idx] = hash & 0x7F;
+		new ((void *)&_slots[idx]) Node(oldSlots[ctr]);
+		oldSlots[ctr].~Node();
+		_size++;
+	}
+
+	// Perform a sanity check (to help track down hashmap corruption)
+	assert(_size == oldSize);
+
+	delete[] oldControl;
+	free(oldSlots);
+}
+
+/**
+ * Internal method returning the index of the first unused slot in the probe
+ * sequence of a hash. There has to be at least one unused slot.
+ *
+ * The groups are probed in triangular order, which visits every group once
+ * since the number of groups is a power of two.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::findUnusedSlot(uint hash) const {
+	const size_type groupMask = _mask / FLATHASHMAP_GROUP_WIDTH;
+	size_type group = (hash >> _groupShift) & groupMask;
+
+	for (size_type step = 1; ; ++step) {
+		const size_type base = group * FLATHASHMAP_GROUP_WIDTH;
+		const uint32 unused = matchUnused(_control + base);
+		if (unused)
+			return base + lowestBit(unused);
+		group = (group + step) & groupMask;
+	}
+}
+
+/**
+ * Internal method returning the slot holding the given key, or (size_type)-1.
+ *
+ * The search ends at the first group with an empty slot. erase() only
+ * marks a slot as empty when its group already has an empty slot, so no
+ * key was probed past it.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const uint hash = mix(_hash(key));
+	const byte tag = hash & 0x7F;
+	const size_type groupMask = _mask / FLATHASHMAP_GROUP_WIDTH;
+	size_type group = (hash >> _groupShift) & groupMask;
+
+	for (size_type step = 1; step <= groupMask + 1; ++step) {
+		const size_type base = group * FLATHASHMAP_GROUP_WIDTH;
+		const byte *control = _control + base;
+
+		for (uint32 match = matchGroup(control, tag); match; match &= match - 1) {
+			const size_type idx = base + lowestBit(match);
+			if (_equal(_slots[idx]._key, key))
+				return idx;
+		}
+
+		if (matchGroup(control, kCtrlEmpty))
+			break;
+		group = (group + step) & groupMask;
+	}
+
+	return (size_type)-1;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return ctr;
+
+	// Keep room for the new element. If many slots are only marked as
+	// erased, rehashing at the same capacity is enough to free them.
+	const size_type capacity = _mask + 1;
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		if ((_size + 1) * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			rehash(capacity * 2);
+		else
+			rehash(capacity);
+	}
+
+	const uint hash = mix(_hash(key));
+	ctr = findUnusedSlot(hash);
+	if (_control[ctr] == kCtrlDeleted)
+		_deleted--;
+	_control[ctr] = hash & 0x7F;
+	new ((void *)&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != (size_type)-1;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	// The lookup may reallocate _slots, so it has to happen first
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	const size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(isUsed(ctr));
+
+	_slots[ctr].~Node();
+
+	// A group without empty slots may have made lookups probe past it, so
+	// the slot has to stay marked in that case.
+	const byte *group = _control + (ctr & ~(size_type)(FLATHASHMAP_GROUP_WIDTH - 1));
+	if (matchGroup(group, kCtrlEmpty)) {
+		_control[ctr] = kCtrlEmpty;
+	} else {
+		_control[ctr] = kCtrlDeleted;
+		_deleted++;
+	}
+	_size--;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	const size_type ctr = lookup(key);
+	if (ctr == (size_type)-1)
+		return;
+
+	erase(iterator(ctr, this));
+}
+
+} // End of namespace Common
+
+#endif
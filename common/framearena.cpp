@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/framearena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+FrameArena::FrameArena(size_t pageSize) : _pageSize(pageSize), _currentPage(0), _offset(0), _used(0) {
+	assert(pageSize > 0);
+}
+
+FrameArena::~FrameArena() {
+	freePages();
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+	assert(alignment && !(alignment & (alignment - 1)));
+
+	if (_currentPage < _pages.size()) {
+		const Page &page = _pages[_currentPage];
+		const uintptr address = (uintptr)(page.start + _offset);
+		const size_t offset = _offset + (((address + alignment - 1) & ~(uintptr)(alignment - 1)) - address);
+		if (offset + size <= page.size) {
+			_offset = offset + size;
+			_used += size;
+			return page.start + offset;
+		}
+	}
+
+	return allocateSlow(size, alignment);
+}
+
+void *FrameArena::allocateSlow(size_t size, size_t alignment) {
+	// The rest of the current page is wasted until the next reset
+	if (_currentPage < _pages.size())
+		_currentPage++;
+
+	// Leave room for the worst case padding
+	const size_t needed = size + alignment - 1;
+	while (_currentPage < _pages.size() && _pages[_currentPage].size < needed)
+		_currentPage++;
+
+	if (_currentPage == _pages.size()) {
+		Page page;
+		page.size = MAX(_pageSize, needed);
+		page.start = (byte *)malloc(page.size);
+		if (!page.start)
+			::error("Common::FrameArena: failure to allocate %u bytes", (uint)page.size);
+		_pages.push_back(page);
+	}
+
+	_offset = 0;
+	return allocate(size, alignment);
+}
+
+void FrameArena::reset() {
+	// Merge the pages, so the next frame does not need to switch pages
+	if (_pages.size() > 1) {
+		const size_t capacity = getCapacity();
+		freePages();
+
+		Page page;
+		page.size = capacity;
+		page.start = (byte *)malloc(capacity);
+		if (!page.start)
+			::error("Common::FrameArena: failure to allocate %u bytes", (uint)capacity);
+		_pages.push_back(page);
+	}
+
+	_currentPage = 0;
+	_offset = 0;
+	_used = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _pages.size(); ++i)
+		capacity += _pages[i].size;
+	return capacity;
+}
+
+void FrameArena::freePages() {
+	for (uint i = 0; i < _pages.size(); ++i)
+		free(_pages[i].start);
+	_pages.clear();
+}
+
+} // End of namespace Common
@@ -0,0 +1,181 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FRAMEARENA_H
+#define COMMON_FRAMEARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * A bump allocator for memory which only lives until the end of a frame,
+ * like temporary buffers in render code.
+ *
+ * Allocating only advances a pointer, and nothing is freed individually.
+ * Instead the owner calls reset() once per frame, usually right after
+ * OSystem::updateScreen(), which makes all of the memory available again.
+ * Destructors of objects in the arena are never called, so it should only
+ * hold plain data.
+ *
+ * The memory is taken from pages of a configurable size. If a frame needed
+ * more than one page, reset() replaces them with a single page large
+ * enough for all of it, so after a few frames no more allocations are made.
+ */
+class FrameArena : NonCopyable {
+public:
+	/**
+	 * Constructor for an arena.
+	 * @param pageSize	the minimal size of the pages memory is taken from
+	 */
+	explicit FrameArena(size_t pageSize = 64 * 1024);
+	~FrameArena();
+
+	/**
+	 * Allocate memory which stays valid until the next reset().
+	 * @param size		the number of bytes
+	 * @param alignment	the alignment of the returned pointer, a power of two
+	 */
+	void *allocate(size_t size, size_t alignment = 16);
+
+	/** Allocate uninitialized memory for count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T));
+	}
+
+	/**
+	 * Make all memory available again. Pointers obtained from
+	 * allocate() are invalid afterwards.
+	 */
+	void reset();
+
+	/** Return the number of bytes allocated since the last reset(). */
+	size_t getUsedSize() const { return _used; }
+
+	/** Return the number of bytes in all pages. */
+	size_t getCapacity() const;
+
+private:
+	struct Page {
+		byte *start;
+		size_t size;
+	};
+
+	const size_t _pageSize;
+	Array<Page> _pages;
+	uint _currentPage;
+	size_t _offset;  ///< Offset of the free memory in the current page.
+	size_t _used;
+
+	void *allocateSlow(size_t size, size_t alignment);
+	void freePages();
+};
+
+/**
+ * A dynamic array for plain data stored in a FrameArena, with the subset
+ * of the Common::Array interface used for building temporary lists.
+ *
+ * Growing the array leaves the old storage in the arena until it is reset.
+ * Elements are never destroyed, so T has to be a type without destructor,
+ * like Common::Rect.
+ */
+template<class T>
+class ArenaArray {
+public:
+	typedef T *iterator;
+	typedef const T *const_iterator;
+
+	typedef T value_type;
+
+	typedef uint size_type;
+
+	explicit ArenaArray(FrameArena &arena) : _arena(arena), _capacity(0), _size(0), _storage(nullptr) {}
+
+	void push_back(const T &element) {
+		if (_size == _capacity)
+			reserve(_capacity ? _capacity * 2 : 8);
+		new ((void *)&_storage[_size++]) T(element);
+	}
+
+	void pop_back() {
+		assert(_size > 0);
+		_size--;
+	}
+
+	void reserve(size_type newCapacity) {
+		if (newCapacity <= _capacity)
+			return;
+
+		T *newStorage = _arena.allocateArray<T>(newCapacity);
+		for (size_type i = 0; i < _size; ++i)
+			new ((void *)&newStorage[i]) T(_storage[i]);
+		_storage = newStorage;
+		_capacity = newCapacity;
+	}
+
+	void clear() { _size = 0; }
+
+	T &operator[](size_type idx) {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	const T &operator[](size_type idx) const {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	size_type size() const { return _size; }
+	bool empty() const { return (_size == 0); }
+
+	T &back() { return _storage[_size - 1]; }
+	const T &back() const { return _storage[_size - 1]; }
+
+	iterator begin() { return _storage; }
+	iterator end() { return _storage + _size; }
+	const_iterator begin() const { return _storage; }
+	const_iterator end() const { return _storage + _size; }
+
+private:
+	FrameArena &_arena;
+	size_type _capacity;
+	size_type _size;
+	T *_storage;
+};
+
+} // End of namespace Common
+
+/**
+ * A custom placement new operator, allocating from a FrameArena. The
+ * destructor of the object must not need to be called.
+ */
+inline void *operator new(size_t nbytes, Common::FrameArena &arena) {
+	return arena.allocate(nbytes);
+}
+
+inline void operator delete(void *p, Common::FrameArena &arena) {
+}
+
+#endif
@@ -125,6 +125,10 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+uint32 FSNode::getModificationTime() const {
+	return _realNode ? _realNode->getModificationTime() : 0;
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -140,6 +144,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createMappedReadStream();
+}
+
 WriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -246,7 +265,9 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const String &name) c
 	FSNode *node = lookupCache(_fileCache, name);
 	if (!node)
 		return nullptr;
-	SeekableReadStream *stream = node->createReadStream();
+	// Directories in the search paths hold game and support data, which
+	// nothing writes to while it is used, so it may be mapped
+	SeekableReadStream *stream = node->createMappedReadStream();
 	if (!stream)
 		warning("FSDirectory::createReadStreamForMember: Can't create stream for file '%s'", name.c_str());
 
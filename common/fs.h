@@ -213,6 +213,14 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Returns the time the object referred by this node was last modified.
+	 *
+	 * @return seconds since the Unix epoch, or 0 if unknown or not supported
+	 *         by the backend
+	 */
+	uint32 getModificationTime() const;
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -222,6 +230,17 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Like createReadStream(), but lets the backend map a large file into
+	 * memory instead of reading it, so getDataPointer() works on the
+	 * stream. A mapped file must not be truncated or rewritten while the
+	 * stream is open, so this is meant for game data, and not for
+	 * savefiles or other files which ScummVM or others may write.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -26,7 +26,6 @@
 #define COMMON_HUFFMAN_H
 
 #include "common/array.h"
-#include "common/list.h"
 #include "common/types.h"
 
 namespace Common {
@@ -63,29 +62,50 @@ public:
 	uint32 getSymbol(BITSTREAM &bits) const;
 
 private:
-	struct Symbol {
-		uint32 code;
-		uint32 symbol;
+	/**
+	 * Entry of the lookup tables. The first level table is indexed by the
+	 * first _rootBits bits of a code. The entries of longer codes point to a
+	 * second level table, indexed by the bits following those.
+	 */
+	struct TableEntry {
+		uint32 value;   ///< The symbol, or the start of the second level table
+		uint8  length;  ///< Full length of the code; 0 if there is no such code
+		uint8  subBits; ///< Index bits of the second level table; 0 for codes
 
-		Symbol(uint32 c, uint32 s) : code(c), symbol(s) {}
+		TableEntry() : value(0), length(0), subBits(0) {}
 	};
 
-	typedef List<Symbol> CodeList;
-	typedef Array<CodeList> CodeLists;
+	/** Largest first level table, unless needed to keep the second level small. */
+	static const uint8 kMaxRootBits = 9;
+	/** Largest second level table. */
+	static const uint8 kMaxSubTableBits = 12;
 
-	/** Lists of codes and their symbols, sorted by code length. */
-	CodeLists _codes;
+	uint8 _maxLength;
+	uint8 _rootBits;
 
-	/** Prefix lookup table used to speed up the decoding of short codes. */
-	struct PrefixEntry {
-		uint32 symbol;
-		uint8  length;
+	/** The first level table, followed by all second level tables. */
+	Array<TableEntry> _table;
 
-		PrefixEntry() : length(0xFF) {}
-	};
+	/** Index of the first table entry for a code within a table of the given size. */
+	static uint32 tableIndex(uint32 code, uint8 length, uint8 bits) {
+		if (BITSTREAM::isMSB2LSB())
+			return code << (bits - length);
+		else
+			return REVERSEBITS(code) >> (32 - length);
+	}
 
-	static const uint8 _prefixTableBits = 8;
-	PrefixEntry _prefixTable[1 << _prefixTableBits];
+	/** Set all entries of the table starting at base which begin with the code. */
+	void fillTable(uint32 base, uint8 bits, uint32 code, uint8 length, const TableEntry &entry) {
+		uint32 index = tableIndex(code, length, bits);
+
+		for (uint32 i = 0; i < (1U << (bits - length)); i++) {
+			TableEntry &slot = _table[base + (BITSTREAM::isMSB2LSB() ? (index | i) : (index | (i << length)))];
+
+			// Keep links to second level tables if the codes are not prefix-free
+			if (!slot.subBits)
+				slot = entry;
+		}
+	}
 };
 
 template <class BITSTREAM>
@@ -101,62 +121,73 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 
 	assert(maxLength <= 32);
 
-	// Codes that don't fit in the prefix table are stored in the _codes array
-	_codes.resize(MAX(maxLength - _prefixTableBits, 0));
+	// Choose the table sizes so that every code is found with at most two lookups
+	_maxLength = maxLength;
+	_rootBits = MIN(maxLength, kMaxRootBits);
+	if (_maxLength > _rootBits + kMaxSubTableBits)
+		_rootBits = _maxLength - kMaxSubTableBits;
+
+	_table.resize(1 << _rootBits);
+
+	// Size the second level tables after the longest code sharing their prefix
+	for (uint32 i = 0; i < codeCount; i++) {
+		uint8 length = lengths[i];
+		if (length <= _rootBits)
+			continue;
+
+		TableEntry &root = _table[tableIndex(codes[i] >> (length - _rootBits), _rootBits, _rootBits)];
+		root.subBits = MAX<uint8>(root.subBits, length - _rootBits);
+	}
+
+	for (uint32 i = 0; i < (1U << _rootBits); i++) {
+		if (_table[i].subBits) {
+			_table[i].value = _table.size();
+			_table.resize(_table.size() + (1 << _table[i].subBits));
+		}
+	}
 
-	for (uint i = 0; i < codeCount; i++) {
+	for (uint32 i = 0; i < codeCount; i++) {
 		uint8 length = lengths[i];
+		if (length == 0)
+			continue;
 
+		TableEntry entry;
+		entry.length = length;
 		// The symbol. If none were specified, just assume it's identical to the code index
-		uint32 symbol = symbols ? symbols[i] : i;
-
-		if (length <= _prefixTableBits) {
-			// Short codes go in the prefix lookup table. Set all the entries in the table
-			// with an index starting with the code to the symbol value.
-			uint32 startIndex;
-			if (BITSTREAM::isMSB2LSB()) {
-				startIndex = codes[i] << (_prefixTableBits - length);
-			} else {
-				startIndex = REVERSEBITS(codes[i]) >> (32 - _prefixTableBits);
-			}
-
-			uint32 endIndex = startIndex | ((1 << (_prefixTableBits - length)) - 1);
-
-			for (uint32 j = startIndex; j <= endIndex; j++) {
-				uint32 index = BITSTREAM::isMSB2LSB() ? j : REVERSEBITS(j) >> (32 - _prefixTableBits);
-				_prefixTable[index].symbol = symbol;
-				_prefixTable[index].length = length;
-			}
+		entry.value = symbols ? symbols[i] : i;
+
+		if (length <= _rootBits) {
+			fillTable(0, _rootBits, codes[i], length, entry);
 		} else {
-			// Put the code and symbol into the correct list for the length
-			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
+			// The remaining bits of the code select entries of the second level table
+			const TableEntry &root = _table[tableIndex(codes[i] >> (length - _rootBits), _rootBits, _rootBits)];
+			uint8 subLength = length - _rootBits;
+			fillTable(root.value, root.subBits, codes[i] & ((1 << subLength) - 1), subLength, entry);
 		}
 	}
 }
 
 template <class BITSTREAM>
 uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
-	uint32 code = bits.peekBits(_prefixTableBits);
-
-	uint8 length = _prefixTable[code].length;
-
-	if (length != 0xFF) {
-		bits.skip(length);
-		return _prefixTable[code].symbol;
+	// Peeking past the end of the stream is fine, it returns 0 bits
+	uint32 code = bits.peekBits(_maxLength);
+
+	const TableEntry *entry;
+	if (BITSTREAM::isMSB2LSB()) {
+		entry = &_table[code >> (_maxLength - _rootBits)];
+		if (entry->subBits)
+			entry = &_table[entry->value + ((code >> (_maxLength - _rootBits - entry->subBits)) & ((1 << entry->subBits) - 1))];
 	} else {
-		bits.skip(_prefixTableBits);
-
-		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i + _prefixTableBits);
-
-			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-				if (code == cCode->code)
-					return cCode->symbol;
-		}
+		entry = &_table[code & ((1 << _rootBits) - 1)];
+		if (entry->subBits)
+			entry = &_table[entry->value + ((code >> _rootBits) & ((1 << entry->subBits) - 1))];
 	}
 
-	error("Unknown Huffman code");
-	return 0;
+	if (entry->length == 0)
+		error("Unknown Huffman code");
+
+	bits.skip(entry->length);
+	return entry->value;
 }
 
 } // End of namespace Common
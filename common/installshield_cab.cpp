@@ -47,7 +47,8 @@
 #include "common/debug.h"
 #include "common/hash-str.h"
 #include "common/installshield_cab.h"
-#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
 #include "common/zlib.h"
 
 namespace Common {
@@ -74,17 +75,30 @@ private:
 	typedef HashMap<String, FileEntry, IgnoreCase_Hash, IgnoreCase_EqualTo> FileMap;
 	FileMap _map;
 	Common::SeekableReadStream *_stream;
-	DisposeAfterUse::Flag _disposeAfterUse;
+	// Owns _stream if it is to be disposed of, shared with member streams
+	SharedPtr<SeekableReadStream> _streamRef;
+};
+
+/**
+ * The bytes of one member inside the cabinet file. If the cabinet owns the
+ * file, this shares ownership, so it stays valid after the cabinet is gone.
+ */
+class InstallShieldMemberReadStream : public SafeSeekableSubReadStream {
+	SharedPtr<SeekableReadStream> _cabinetStream;
+
+public:
+	InstallShieldMemberReadStream(SeekableReadStream *stream, const SharedPtr<SeekableReadStream> &streamRef, uint32 begin, uint32 end) :
+		SafeSeekableSubReadStream(stream, begin, end), _cabinetStream(streamRef) {}
 };
 
 InstallShieldCabinet::~InstallShieldCabinet() {
 	_map.clear();
-
-	if (_disposeAfterUse == DisposeAfterUse::YES)
-		delete _stream;
 }
 
-InstallShieldCabinet::InstallShieldCabinet(SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) : _stream(stream), _disposeAfterUse(disposeAfterUse) {
+InstallShieldCabinet::InstallShieldCabinet(SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) : _stream(stream) {
+	if (disposeAfterUse == DisposeAfterUse::YES)
+		_streamRef = SharedPtr<SeekableReadStream>(stream);
+
 	// Note that we only support a limited subset of cabinet files
 	// Only single cabinet files and ones without data shared between
 	// cabinets.
@@ -178,27 +192,14 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 
 	const FileEntry &entry = _map[name];
 
-	_stream->seek(entry.offset);
-
+	// Members are read straight from the cabinet, compressed ones being
+	// inflated as they are read.
 	if (!(entry.flags & 0x04)) // Not compressed
-		return _stream->readStream(entry.uncompressedSize);
+		return new InstallShieldMemberReadStream(_stream, _streamRef, entry.offset, entry.offset + entry.uncompressedSize);
 
 #ifdef USE_ZLIB
-	byte *src = (byte *)malloc(entry.compressedSize);
-	byte *dst = (byte *)malloc(entry.uncompressedSize);
-
-	_stream->read(src, entry.compressedSize);
-
-	bool result = inflateZlibInstallShield(dst, entry.uncompressedSize, src, entry.compressedSize);
-	free(src);
-
-	if (!result) {
-		warning("failed to inflate CAB file '%s'", name.c_str());
-		free(dst);
-		return nullptr;
-	}
-
-	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+	SeekableReadStream *data = new InstallShieldMemberReadStream(_stream, _streamRef, entry.offset, entry.offset + entry.compressedSize);
+	return wrapInstallShieldReadStream(data, entry.uncompressedSize);
 #else
 	warning("zlib required to extract compressed CAB file '%s'", name.c_str());
 	return 0;
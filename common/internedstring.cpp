@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/internedstring.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+
+namespace Common {
+
+struct InternedString::Entry {
+	const String str;
+	const uint hash;
+	const uint hashLower;
+	/** The entry of the lowercase string, which may be this one. */
+	const Entry *lower;
+
+	Entry(const String &s) : str(s), hash(hashit(s)), hashLower(hashit_lower(s)), lower(nullptr) {}
+};
+
+namespace {
+
+const String s_emptyString;
+
+} // End of anonymous namespace
+
+InternedString::InternedString(const String &str) : _entry(intern(str)) {
+}
+
+InternedString::InternedString(const char *str) : _entry(intern(String(str))) {
+}
+
+const InternedString::Entry *InternedString::intern(const String &str) {
+	if (str.empty())
+		return nullptr;
+
+	// Entries are never freed, so neither is the table
+	typedef HashMap<String, Entry *> InternTable;
+	static InternTable *table = new InternTable();
+
+	InternTable::const_iterator it = table->find(str);
+	if (it != table->end())
+		return it->_value;
+
+	Entry *entry = new Entry(str);
+	(*table)[str] = entry;
+
+	String lower(str);
+	lower.toLowercase();
+	entry->lower = (lower == str) ? entry : intern(lower);
+	return entry;
+}
+
+const String &InternedString::toString() const {
+	return _entry ? _entry->str : s_emptyString;
+}
+
+bool InternedString::equalsIgnoreCase(const InternedString &x) const {
+	if (!_entry || !x._entry)
+		return _entry == x._entry;
+	return _entry->lower == x._entry->lower;
+}
+
+InternedString InternedString::toLowercase() const {
+	return InternedString(_entry ? _entry->lower : nullptr);
+}
+
+uint InternedString::hash() const {
+	return _entry ? _entry->hash : hashit("");
+}
+
+uint InternedString::hashIgnoreCase() const {
+	return _entry ? _entry->hashLower : hashit_lower("");
+}
+
+} // End of namespace Common
@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_INTERNEDSTRING_H
+#define COMMON_INTERNEDSTRING_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * An immutable string stored once in a global table, for names which are
+ * looked up over and over again, like file and symbol names.
+ *
+ * Creating an InternedString costs one hash table lookup; afterwards
+ * copies are plain pointer copies, comparing two interned strings is a
+ * pointer comparison (also when ignoring case), and both the case
+ * sensitive and the case insensitive hashes are precomputed.
+ *
+ * Strings stay in the table until the program ends, so do not intern
+ * names which are only used once. The table is not thread safe; intern
+ * strings on the main thread only.
+ */
+class InternedString {
+public:
+	/** The empty string. */
+	InternedString() : _entry(nullptr) {}
+	explicit InternedString(const String &str);
+	explicit InternedString(const char *str);
+
+	/** Return the string. The reference stays valid until the program ends. */
+	const String &toString() const;
+	const char *c_str() const { return toString().c_str(); }
+	bool empty() const { return _entry == nullptr; }
+
+	bool operator==(const InternedString &x) const { return _entry == x._entry; }
+	bool operator!=(const InternedString &x) const { return _entry != x._entry; }
+
+	/** Compare two interned strings ignoring case. Constant time. */
+	bool equalsIgnoreCase(const InternedString &x) const;
+
+	/** Return the interned lowercase version of this string. Constant time. */
+	InternedString toLowercase() const;
+
+	/** Return the hash of the string, the same as Common::hashit(). */
+	uint hash() const;
+
+	/** Return the case insensitive hash of the string, the same as Common::hashit_lower(). */
+	uint hashIgnoreCase() const;
+
+private:
+	struct Entry;
+	const Entry *_entry;
+
+	explicit InternedString(const Entry *entry) : _entry(entry) {}
+	static const Entry *intern(const String &str);
+};
+
+struct InternedString_Hash {
+	uint operator()(const InternedString &x) const { return x.hash(); }
+};
+
+struct InternedString_EqualTo {
+	bool operator()(const InternedString &x, const InternedString &y) const { return x == y; }
+};
+
+struct InternedString_IgnoreCase_Hash {
+	uint operator()(const InternedString &x) const { return x.hashIgnoreCase(); }
+};
+
+struct InternedString_IgnoreCase_EqualTo {
+	bool operator()(const InternedString &x, const InternedString &y) const { return x.equalsIgnoreCase(y); }
+};
+
+} // End of namespace Common
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "lauxlib.h"
 #include "scummvm_file.h"
+#include "common/memorypool.h"
 #include "common/textconsole.h"
 
 #define FREELIST_REF	0	/* free list of references */
@@ -630,15 +631,98 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s) {
 /* }====================================================== */
 
 
+/*
+** Most blocks Lua allocates are strings, tables and closures of a few
+** dozen bytes, so those come from one pool per power of two size instead
+** of the heap. Lua always passes the old size of a block, which tells
+** which pool it belongs to.
+*/
+#define POOL_CLASSES	5
+#define POOL_MINSIZE	16
+#define POOL_MAXSIZE	(POOL_MINSIZE << (POOL_CLASSES - 1))
+
+typedef struct PoolAllocator {
+  Common::MemoryPool *pools[POOL_CLASSES];
+  luaL_AllocStats stats;
+} PoolAllocator;
+
+
+static int pool_class (size_t size) {
+  int c = 0;
+  size_t s = POOL_MINSIZE;
+  if (size == 0 || size > POOL_MAXSIZE)
+    return -1;  /* not pooled */
+  while (s < size) {
+    s <<= 1;
+    c++;
+  }
+  return c;
+}
+
+
+static void pool_free (PoolAllocator *a, void *ptr, int c) {
+  if (c >= 0)
+    a->pools[c]->freeChunk(ptr);
+  else
+    free(ptr);
+}
+
+
 static void *l_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
-  (void)ud;
-  (void)osize;
+  PoolAllocator *a = (PoolAllocator *)ud;
+  int oclass = ptr ? pool_class(osize) : -1;
+  int nclass = pool_class(nsize);
+  void *nptr;
   if (nsize == 0) {
-    free(ptr);
+    if (ptr) {
+      pool_free(a, ptr, oclass);
+      a->stats.inUse -= osize;
+    }
     return NULL;
   }
-  else
-    return realloc(ptr, nsize);
+  if (ptr && oclass == nclass) {
+    if (oclass >= 0)
+      nptr = ptr;  /* still fits in its chunk */
+    else {
+      nptr = realloc(ptr, nsize);
+      if (nptr == NULL) return NULL;
+    }
+  }
+  else {
+    if (nclass >= 0) {
+      nptr = a->pools[nclass]->allocChunk();
+      a->stats.poolAllocs++;
+    }
+    else {
+      nptr = malloc(nsize);
+      a->stats.heapAllocs++;
+    }
+    if (nptr == NULL) return NULL;
+    if (ptr) {
+      memcpy(nptr, ptr, osize < nsize ? osize : nsize);
+      pool_free(a, ptr, oclass);
+    }
+  }
+  a->stats.inUse += nsize - (ptr ? osize : 0);
+  if (a->stats.inUse > a->stats.peakInUse)
+    a->stats.peakInUse = a->stats.inUse;
+  return nptr;
+}
+
+
+static PoolAllocator *newallocator (void) {
+  PoolAllocator *a = new PoolAllocator;
+  for (int i = 0; i < POOL_CLASSES; i++)
+    a->pools[i] = new Common::MemoryPool(POOL_MINSIZE << i);
+  memset(&a->stats, 0, sizeof(a->stats));
+  return a;
+}
+
+
+static void freeallocator (PoolAllocator *a) {
+  for (int i = 0; i < POOL_CLASSES; i++)
+    delete a->pools[i];
+  delete a;
 }
 
 
@@ -651,7 +735,28 @@ static int panic (lua_State *L) {
 
 
 LUALIB_API lua_State *luaL_newstate (void) {
-  lua_State *L = lua_newstate(l_alloc, NULL);
+  PoolAllocator *a = newallocator();
+  lua_State *L = lua_newstate(l_alloc, a);
   if (L) lua_atpanic(L, &panic);
+  else freeallocator(a);
   return L;
 }
+
+
+/* closes a state made by luaL_newstate, and frees its pools */
+LUALIB_API void luaL_closestate (lua_State *L) {
+  void *ud;
+  lua_Alloc f = lua_getallocf(L, &ud);
+  lua_close(L);
+  if (f == l_alloc)
+    freeallocator((PoolAllocator *)ud);
+}
+
+
+LUALIB_API int luaL_getallocstats (lua_State *L, luaL_AllocStats *stats) {
+  void *ud;
+  if (lua_getallocf(L, &ud) != l_alloc)
+    return 0;
+  *stats = ((PoolAllocator *)ud)->stats;
+  return 1;
+}
@@ -81,6 +81,17 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s);
 
 LUALIB_API lua_State *(luaL_newstate) (void);
 
+/* ScummVM: states made by luaL_newstate allocate small blocks from pools */
+typedef struct luaL_AllocStats {
+  size_t inUse;  /* bytes currently allocated */
+  size_t peakInUse;  /* most bytes allocated at once */
+  unsigned long poolAllocs;  /* blocks allocated from the pools */
+  unsigned long heapAllocs;  /* blocks too large for the pools */
+} luaL_AllocStats;
+
+LUALIB_API void (luaL_closestate) (lua_State *L);
+LUALIB_API int (luaL_getallocstats) (lua_State *L, luaL_AllocStats *stats);
+
 
 LUALIB_API const char *(luaL_gsub) (lua_State *L, const char *s, const char *p,
                                                   const char *r);
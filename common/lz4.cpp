@@ -0,0 +1,405 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// The block format written and read here is the one of the LZ4 library
+// by Yann Collet, so data can be inspected with its tools. The container
+// around the blocks is our own.
+
+#include "common/lz4.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+namespace {
+
+enum {
+	kMinMatch = 4,
+	// The last match has to start at least 12 bytes before the end, and
+	// the last 5 bytes are always literals
+	kMatchSearchLimit = 12,
+	kLastLiterals = 5,
+	kMaxOffset = 65535,
+	kMaxBlockSize = 65536,
+
+	kHashLog = 12,
+	// Positions without a match are skipped faster the longer no match
+	// was found
+	kSkipTrigger = 6
+};
+
+const uint32 kLZ4StreamTag = MKTAG('L', 'Z', '4', 'B');
+
+// The high bit of the compressed size marks a block stored uncompressed
+const uint32 kStoredBlockFlag = 0x80000000;
+
+inline uint32 hashSequence(uint32 sequence) {
+	return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+inline byte *writeLength(byte *dst, uint32 length) {
+	for (; length >= 255; length -= 255)
+		*dst++ = 255;
+	*dst++ = (byte)length;
+	return dst;
+}
+
+} // End of anonymous namespace
+
+uint32 getLZ4CompressBound(uint32 srcLen) {
+	return srcLen + srcLen / 255 + 16;
+}
+
+uint32 compressLZ4(byte *dst, const byte *src, uint32 srcLen) {
+	assert(srcLen <= kMaxBlockSize);
+
+	const byte *ip = src;
+	const byte *anchor = src;
+	const byte *const srcEnd = src + srcLen;
+	byte *op = dst;
+
+	if (srcLen >= kMatchSearchLimit + 1) {
+		const byte *const matchSearchEnd = srcEnd - kMatchSearchLimit;
+		const byte *const matchEnd = srcEnd - kLastLiterals;
+
+		// Positions relative to src, which always fit since blocks are at
+		// most 64 KiB
+		uint16 table[1 << kHashLog];
+		memset(table, 0, sizeof(table));
+
+		ip++;
+		while (ip < matchSearchEnd) {
+			// Find a match
+			const byte *match;
+			uint32 step = 1, searches = 1 << kSkipTrigger;
+			for (;;) {
+				const uint32 h = hashSequence(READ_UINT32(ip));
+				match = src + table[h];
+				table[h] = (uint16)(ip - src);
+				if (ip - match <= kMaxOffset && match < ip && READ_UINT32(match) == READ_UINT32(ip))
+					break;
+
+				ip += step;
+				step = searches++ >> kSkipTrigger;
+				if (ip >= matchSearchEnd)
+					goto lastLiterals;
+			}
+
+			// Extend it backwards over the pending literals
+			while (ip > anchor && match > src && ip[-1] == match[-1]) {
+				ip--;
+				match--;
+			}
+
+			// Token and literals
+			const uint32 literals = ip - anchor;
+			byte *token = op++;
+			if (literals >= 15) {
+				*token = 15 << 4;
+				op = writeLength(op, literals - 15);
+			} else {
+				*token = (byte)(literals << 4);
+			}
+			memcpy(op, anchor, literals);
+			op += literals;
+
+			// Offset and match length
+			WRITE_LE_UINT16(op, (uint16)(ip - match));
+			op += 2;
+
+			const byte *matchStart = ip;
+			ip += kMinMatch;
+			match += kMinMatch;
+			while (ip < matchEnd && *ip == *match) {
+				ip++;
+				match++;
+			}
+
+			const uint32 length = ip - matchStart - kMinMatch;
+			if (length >= 15) {
+				*token |= 15;
+				op = writeLength(op, length - 15);
+			} else {
+				*token |= (byte)length;
+			}
+
+			anchor = ip;
+			if (ip < matchSearchEnd)
+				table[hashSequence(READ_UINT32(ip - 2))] = (uint16)(ip - 2 - src);
+		}
+	}
+
+lastLiterals:
+	const uint32 literals = srcEnd - anchor;
+	if (literals >= 15) {
+		*op++ = 15 << 4;
+		op = writeLength(op, literals - 15);
+	} else {
+		*op++ = (byte)(literals << 4);
+	}
+	memcpy(op, anchor, literals);
+	op += literals;
+
+	return op - dst;
+}
+
+bool decompressLZ4(byte *dst, uint32 dstLen, const byte *src, uint32 srcLen) {
+	const byte *ip = src;
+	const byte *const srcEnd = src + srcLen;
+	byte *op = dst;
+	byte *const dstEnd = dst + dstLen;
+
+	while (ip < srcEnd) {
+		const byte token = *ip++;
+
+		// Literals
+		uint32 length = token >> 4;
+		if (length == 15) {
+			byte b;
+			do {
+				if (ip >= srcEnd)
+					return false;
+				b = *ip++;
+				length += b;
+			} while (b == 255);
+		}
+		if (length > (uint32)(srcEnd - ip) || length > (uint32)(dstEnd - op))
+			return false;
+		memcpy(op, ip, length);
+		ip += length;
+		op += length;
+
+		// The last sequence has no match
+		if (ip == srcEnd)
+			break;
+
+		// Match
+		if (srcEnd - ip < 2)
+			return false;
+		const uint32 offset = READ_LE_UINT16(ip);
+		ip += 2;
+		if (offset == 0 || offset > (uint32)(op - dst))
+			return false;
+
+		length = token & 15;
+		if (length == 15) {
+			byte b;
+			do {
+				if (ip >= srcEnd)
+					return false;
+				b = *ip++;
+				length += b;
+			} while (b == 255);
+		}
+		length += kMinMatch;
+		if (length > (uint32)(dstEnd - op))
+			return false;
+
+		// Matches may overlap their own output, so copy bytewise unless
+		// they are far enough apart
+		const byte *match = op - offset;
+		if (offset >= length) {
+			memcpy(op, match, length);
+			op += length;
+		} else {
+			while (length--)
+				*op++ = *match++;
+		}
+	}
+
+	return op == dstEnd;
+}
+
+bool isLZ4Stream(SeekableReadStream &stream) {
+	const int32 pos = stream.pos();
+	const uint32 tag = stream.readUint32BE();
+	const bool eos = stream.eos();
+	stream.seek(pos);
+	return !eos && tag == kLZ4StreamTag;
+}
+
+SeekableReadStream *wrapLZ4ReadStream(SeekableReadStream *toBeWrapped) {
+	if (!toBeWrapped)
+		return nullptr;
+
+	ScopedPtr<SeekableReadStream> in(toBeWrapped);
+	if (in->readUint32BE() != kLZ4StreamTag)
+		return nullptr;
+
+	// Saves are usually compressed to a fraction of their size, so start
+	// with room for a multiple of the input
+	uint32 capacity = MAX<uint32>(kMaxBlockSize, in->size() * 4);
+	byte *data = (byte *)malloc(capacity);
+	byte *block = (byte *)malloc(getLZ4CompressBound(kMaxBlockSize));
+
+	uint32 size = 0;
+	bool ok = data && block;
+	while (ok) {
+		const uint32 rawSize = in->readUint32BE();
+		if (in->eos() || rawSize == 0) {
+			// A missing end marker means the data was truncated
+			ok = !in->eos();
+			break;
+		}
+
+		const uint32 storedSize = in->readUint32BE();
+		const uint32 dataSize = storedSize & ~kStoredBlockFlag;
+		if (rawSize > kMaxBlockSize || dataSize > getLZ4CompressBound(kMaxBlockSize)) {
+			ok = false;
+			break;
+		}
+
+		if (size + rawSize > capacity) {
+			capacity *= 2;
+			byte *grown = (byte *)realloc(data, capacity);
+			if (!grown) {
+				ok = false;
+				break;
+			}
+			data = grown;
+		}
+
+		if (storedSize & kStoredBlockFlag) {
+			ok = dataSize == rawSize && in->read(data + size, rawSize) == rawSize;
+		} else {
+			ok = in->read(block, dataSize) == dataSize && decompressLZ4(data + size, rawSize, block, dataSize);
+		}
+		size += rawSize;
+	}
+
+	free(block);
+	if (!ok || in->err()) {
+		free(data);
+		warning("wrapLZ4ReadStream: Corrupt or truncated data");
+		return nullptr;
+	}
+
+	return new MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+/**
+ * A wrapper compressing everything written to it with LZ4. After a tag,
+ * the data is stored in blocks of the uncompressed size, the compressed
+ * size and the compressed data, with sizes in big endian. A block with
+ * uncompressed size 0 marks the end.
+ */
+class LZ4WriteStream : public WriteStream {
+private:
+	ScopedPtr<WriteStream> _wrapped;
+	byte *_buf;
+	byte *_compressed;
+	uint32 _bufFill;
+	uint32 _pos;
+	bool _err;
+	bool _finalized;
+
+	void flushBlock() {
+		if (!_bufFill || err())
+			return;
+
+		uint32 dataSize = compressLZ4(_compressed, _buf, _bufFill);
+		const byte *data = _compressed;
+		uint32 storedSize = dataSize;
+		if (dataSize >= _bufFill) {
+			data = _buf;
+			dataSize = _bufFill;
+			storedSize = _bufFill | kStoredBlockFlag;
+		}
+
+		_wrapped->writeUint32BE(_bufFill);
+		_wrapped->writeUint32BE(storedSize);
+		if (_wrapped->write(data, dataSize) != dataSize)
+			_err = true;
+		_bufFill = 0;
+	}
+
+public:
+	LZ4WriteStream(WriteStream *w) : _wrapped(w), _bufFill(0), _pos(0), _err(false), _finalized(false) {
+		assert(w != nullptr);
+		_buf = (byte *)malloc(kMaxBlockSize);
+		_compressed = (byte *)malloc(getLZ4CompressBound(kMaxBlockSize));
+		assert(_buf && _compressed);
+
+		_wrapped->writeUint32BE(kLZ4StreamTag);
+	}
+
+	~LZ4WriteStream() {
+		finalize();
+		free(_buf);
+		free(_compressed);
+	}
+
+	virtual bool err() const {
+		return _err || _wrapped->err();
+	}
+
+	virtual void clearErr() {
+		// Note: we don't reset _err here, as the data already written
+		// would be incomplete anyway
+		_wrapped->clearErr();
+	}
+
+	virtual void finalize() {
+		if (_finalized)
+			return;
+		_finalized = true;
+
+		flushBlock();
+		_wrapped->writeUint32BE(0);
+
+		// Finalize the wrapped savefile, too
+		_wrapped->finalize();
+	}
+
+	virtual uint32 write(const void *dataPtr, uint32 dataSize) {
+		if (err() || _finalized)
+			return 0;
+
+		const byte *data = (const byte *)dataPtr;
+		uint32 left = dataSize;
+		while (left) {
+			const uint32 chunk = MIN<uint32>(left, kMaxBlockSize - _bufFill);
+			memcpy(_buf + _bufFill, data, chunk);
+			_bufFill += chunk;
+			data += chunk;
+			left -= chunk;
+			if (_bufFill == kMaxBlockSize)
+				flushBlock();
+		}
+
+		_pos += dataSize;
+		return dataSize;
+	}
+
+	virtual int32 pos() const { return _pos; }
+};
+
+WriteStream *wrapLZ4WriteStream(WriteStream *toBeWrapped) {
+	if (!toBeWrapped)
+		return nullptr;
+	return new LZ4WriteStream(toBeWrapped);
+}
+
+} // End of namespace Common
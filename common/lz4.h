@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_LZ4_H
+#define COMMON_LZ4_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+class SeekableReadStream;
+class WriteStream;
+
+/**
+ * Return the largest possible size of srcLen bytes after compressLZ4().
+ */
+uint32 getLZ4CompressBound(uint32 srcLen);
+
+/**
+ * Compress a buffer into the LZ4 block format. The compressor only does a
+ * single hash lookup per position, trading compression ratio for speed:
+ * it runs several times faster than zlib, in particular on ARM.
+ *
+ * @param dst       the buffer to store into, at least getLZ4CompressBound(srcLen) bytes.
+ * @param src       the data to be compressed.
+ * @param srcLen    the size of the data, at most 64 KiB.
+ *
+ * @return the size of the compressed data.
+ */
+uint32 compressLZ4(byte *dst, const byte *src, uint32 srcLen);
+
+/**
+ * Decompress a buffer in the LZ4 block format.
+ *
+ * @param dst       the buffer to store into.
+ * @param dstLen    the size of the data after decompression.
+ * @param src       the data to be decompressed.
+ * @param srcLen    the size of the compressed data.
+ *
+ * @return true on success, false if the data is corrupt or does not
+ *         decompress to exactly dstLen bytes.
+ */
+bool decompressLZ4(byte *dst, uint32 dstLen, const byte *src, uint32 srcLen);
+
+/**
+ * Check whether a stream starts with the header written by
+ * wrapLZ4WriteStream(). The stream position is not changed.
+ */
+bool isLZ4Stream(SeekableReadStream &stream);
+
+/**
+ * Take a SeekableReadStream written by wrapLZ4WriteStream() and return a
+ * stream with the decompressed data. The data is decompressed at once, so
+ * this is only meant for data like savegames which is read completely.
+ * The wrapped stream is destroyed.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned). NULL is also returned if the data is corrupt.
+ */
+SeekableReadStream *wrapLZ4ReadStream(SeekableReadStream *toBeWrapped);
+
+/**
+ * Take an arbitrary WriteStream and wrap it in a custom stream which
+ * compresses the data with LZ4, in blocks of 64 KiB after a header which
+ * identifies the format.
+ * The created stream also becomes responsible for freeing the passed stream.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+WriteStream *wrapLZ4WriteStream(WriteStream *toBeWrapped);
+
+} // End of namespace Common
+
+#endif
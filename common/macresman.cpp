@@ -27,6 +27,7 @@
 #include "common/fs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/memstream.h"
 #include "common/substream.h"
 #include "common/textconsole.h"
 #include "common/archive.h"
@@ -46,9 +47,21 @@ namespace Common {
 #define MBI_RFLEN 87
 #define MAXNAMELEN 63
 
-MacResManager::MacResManager() {
-	memset(this, 0, sizeof(MacResManager));
-	close();
+/** A resource in the memory of a fork, which keeps the fork open */
+class MappedForkStream : public MemoryReadStream {
+public:
+	MappedForkStream(const SharedPtr<SeekableReadStream> &fork, const byte *data, uint32 size) :
+		MemoryReadStream(data, size), _fork(fork) {}
+
+private:
+	SharedPtr<SeekableReadStream> _fork;
+};
+
+MacResManager::MacResManager() :
+		_stream(nullptr), _mode(kResForkNone), _resForkOffset(-1), _resForkSize(0),
+		_dataOffset(0), _dataLength(0), _mapOffset(0), _mapLength(0),
+		_resTypes(nullptr), _resLists(nullptr), _mapRead(false) {
+	memset(&_resMap, 0, sizeof(_resMap));
 }
 
 MacResManager::~MacResManager() {
@@ -69,8 +82,19 @@ void MacResManager::close() {
 
 	delete[] _resLists; _resLists = nullptr;
 	delete[] _resTypes; _resTypes = nullptr;
-	delete _stream; _stream = nullptr;
 	_resMap.numTypes = 0;
+
+	_typeIndex.clear();
+	_resIndex.clear();
+	_nameIndex.clear();
+	_mapRead = false;
+
+	// Resources pointing into the stream may still hold on to it
+	if (_sharedStream)
+		_sharedStream.reset();
+	else
+		delete _stream;
+	_stream = nullptr;
 }
 
 bool MacResManager::hasDataFork() const {
@@ -100,7 +124,7 @@ String MacResManager::computeResForkMD5AsString(uint32 length) const {
 
 
 	SeekableSubReadStream resForkStream(_stream, dataOffset, dataOffset + dataLength);
-	return computeStreamMD5AsString(resForkStream, MIN<uint32>(length, _resForkSize));
+	return computeStreamMD5AsString(resForkStream, MIN<uint32>(length, dataLength));
 }
 
 bool MacResManager::open(const String &fileName) {
@@ -462,7 +486,7 @@ bool MacResManager::load(SeekableReadStream &stream) {
 
 	_stream = &stream;
 
-	readMap();
+	// The map is read on the first lookup, detection only needs the header
 	return true;
 }
 
@@ -473,6 +497,10 @@ SeekableReadStream *MacResManager::getDataFork() {
 	if (_mode == kResForkMacBinary) {
 		_stream->seek(MBI_DFLEN);
 		uint32 dataSize = _stream->readUint32BE();
+
+		SeekableReadStream *mapped = createMappedStream(MBI_INFOHDR, dataSize);
+		if (mapped)
+			return mapped;
 		return new SeekableSubReadStream(_stream, MBI_INFOHDR, MBI_INFOHDR + dataSize);
 	}
 
@@ -484,16 +512,49 @@ SeekableReadStream *MacResManager::getDataFork() {
 	return nullptr;
 }
 
+SeekableReadStream *MacResManager::createMappedStream(uint32 offset, uint32 size) {
+	const byte *data = _stream->getDataPointer();
+	if (!data || offset + size > (uint32)_stream->size())
+		return nullptr;
+
+	if (!_sharedStream)
+		_sharedStream = SharedPtr<SeekableReadStream>(_stream);
+	return new MappedForkStream(_sharedStream, data + offset, size);
+}
+
+int MacResManager::getTypeNum(uint32 typeID) const {
+	TypeIndex::const_iterator type = _typeIndex.find(typeID);
+	return type != _typeIndex.end() ? type->_value : -1;
+}
+
+MacResManager::ResPtr MacResManager::findResource(uint32 typeID, uint16 resID) const {
+	ResKey key;
+	key.type = typeID;
+	key.id = resID;
+
+	ResIndex::const_iterator res = _resIndex.find(key);
+	return res != _resIndex.end() ? res->_value : nullptr;
+}
+
+SeekableReadStream *MacResManager::readResource(const Resource &res) {
+	_stream->seek(_dataOffset + res.dataOffset);
+	uint32 len = _stream->readUint32BE();
+
+	// Ignore resources with 0 length
+	if (!len)
+		return nullptr;
+
+	SeekableReadStream *mapped = createMappedStream(_dataOffset + res.dataOffset + 4, len);
+	if (mapped)
+		return mapped;
+	return _stream->readStream(len);
+}
+
 MacResIDArray MacResManager::getResIDArray(uint32 typeID) {
-	int typeNum = -1;
 	MacResIDArray res;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
+	readMap();
+	int typeNum = getTypeNum(typeID);
 	if (typeNum == -1)
 		return res;
 
@@ -511,6 +572,7 @@ MacResTagArray MacResManager::getResTagArray() {
 	if (!hasResFork())
 		return tagArray;
 
+	readMap();
 	tagArray.resize(_resMap.numTypes);
 
 	for (uint32 i = 0; i < _resMap.numTypes; i++)
@@ -520,98 +582,64 @@ MacResTagArray MacResManager::getResTagArray() {
 }
 
 String MacResManager::getResName(uint32 typeID, uint16 resID) const {
-	int typeNum = -1;
+	// Reading the map does not change the contents of the fork
+	const_cast<MacResManager *>(this)->readMap();
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
+	ResPtr res = findResource(typeID, resID);
+	if (!res || !res->name)
 		return "";
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID)
-			return _resLists[typeNum][i].name;
-
-	return "";
+	return res->name;
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
-	int typeNum = -1;
-	int resNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
-		return nullptr;
-
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID) {
-			resNum = i;
-			break;
-		}
-
-	if (resNum == -1)
-		return nullptr;
-
-	_stream->seek(_dataOffset + _resLists[typeNum][resNum].dataOffset);
-	uint32 len = _stream->readUint32BE();
+	readMap();
 
-	// Ignore resources with 0 length
-	if (!len)
+	ResPtr res = findResource(typeID, resID);
+	if (!res)
 		return nullptr;
 
-	return _stream->readStream(len);
+	return readResource(*res);
 }
 
 SeekableReadStream *MacResManager::getResource(const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
-
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+	readMap();
 
-				return _stream->readStream(len);
-			}
-		}
-	}
+	NameIndex::const_iterator res = _nameIndex.find(fileName);
+	if (res == _nameIndex.end())
+		return nullptr;
 
-	return nullptr;
+	return readResource(*res->_value);
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		if (_resTypes[i].id != typeID)
-			continue;
+	readMap();
 
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
+	// The first resource with the name usually has the right type as well
+	NameIndex::const_iterator res = _nameIndex.find(fileName);
+	if (res == _nameIndex.end())
+		return nullptr;
 
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+	if (_resTypes[res->_value->typeNum].id == typeID)
+		return readResource(*res->_value);
 
-				return _stream->readStream(len);
-			}
-		}
+	int typeNum = getTypeNum(typeID);
+	if (typeNum == -1)
+		return nullptr;
+
+	for (uint32 j = 0; j < _resTypes[typeNum].items; j++) {
+		if (_resLists[typeNum][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[typeNum][j].name))
+			return readResource(_resLists[typeNum][j]);
 	}
 
 	return nullptr;
 }
 
 void MacResManager::readMap() {
+	if (_mapRead || _mode == kResForkNone || !_stream)
+		return;
+	_mapRead = true;
+
 	_stream->seek(_mapOffset + 22);
 
 	_resMap.resAttr = _stream->readUint16BE();
@@ -629,6 +657,9 @@ void MacResManager::readMap() {
 		_resTypes[i].offset = _stream->readUint16BE();
 		_resTypes[i].items++;
 
+		if (!_typeIndex.contains(_resTypes[i].id))
+			_typeIndex[_resTypes[i].id] = i;
+
 		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(_resTypes[i].id), _resTypes[i].items,  _resTypes[i].offset, _resTypes[i].offset);
 	}
 
@@ -646,9 +677,16 @@ void MacResManager::readMap() {
 			resPtr->dataOffset = _stream->readUint32BE();
 			_stream->readUint32BE();
 			resPtr->name = nullptr;
+			resPtr->typeNum = i;
 
 			resPtr->attr = resPtr->dataOffset >> 24;
 			resPtr->dataOffset &= 0xFFFFFF;
+
+			ResKey key;
+			key.type = _resTypes[i].id;
+			key.id = resPtr->id;
+			if (!_resIndex.contains(key))
+				_resIndex[key] = resPtr;
 		}
 
 		for (int j = 0; j < _resTypes[i].items; j++) {
@@ -659,6 +697,9 @@ void MacResManager::readMap() {
 				_resLists[i][j].name = new char[len + 1];
 				_resLists[i][j].name[len] = 0;
 				_stream->read(_resLists[i][j].name, len);
+
+				if (!_nameIndex.contains(_resLists[i][j].name))
+					_nameIndex[_resLists[i][j].name] = _resLists[i] + j;
 			}
 		}
 	}
@@ -32,6 +32,9 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/ptr.h"
 #include "common/str.h"
 #include "common/str-array.h"
 
@@ -46,6 +49,11 @@ typedef Array<uint32> MacResTagArray;
 /**
  * Class for handling Mac data and resource forks.
  * It can read from raw, MacBinary, and AppleDouble formats.
+ *
+ * The resource map is only read on the first lookup, and indexed by type,
+ * ID and name. When the fork sits in memory, like a mapped file does, the
+ * returned resources point into it instead of being copied. They keep the
+ * fork alive, so they stay valid after the manager is closed.
  */
 class MacResManager {
 
@@ -154,7 +162,8 @@ public:
 	uint32 getResForkDataSize() const;
 
 	/**
-	 * Calculate the MD5 checksum of the resource fork
+	 * Calculate the MD5 checksum of the resource fork. Only the first length
+	 * bytes are read, and the resource map is not needed for it.
 	 * @param length The maximum length to compute for
 	 * @return The MD5 checksum of the resource fork
 	 */
@@ -185,6 +194,12 @@ private:
 	SeekableReadStream *_stream;
 	String _baseFileName;
 
+	/**
+	 * Shares the ownership of _stream with the resources pointing into it,
+	 * once there are any.
+	 */
+	SharedPtr<SeekableReadStream> _sharedStream;
+
 	bool load(SeekableReadStream &stream);
 
 	bool loadFromRawFork(SeekableReadStream &stream);
@@ -213,6 +228,7 @@ private:
 		kResForkAppleDouble
 	} _mode;
 
+	/** Read and index the resource map, unless that was done already. */
 	void readMap();
 
 	struct ResMap {
@@ -234,10 +250,36 @@ private:
 		byte attr;
 		uint32 dataOffset;
 		char *name;
+		uint16 typeNum; ///< Index into _resTypes
 	};
 
 	typedef Resource *ResPtr;
 
+	struct ResKey {
+		uint32 type;
+		uint16 id;
+
+		bool operator==(const ResKey &other) const { return type == other.type && id == other.id; }
+	};
+
+	struct ResKeyHash {
+		uint operator()(const ResKey &key) const { return key.type * 31 + key.id; }
+	};
+
+	typedef HashMap<uint32, uint16> TypeIndex;
+	typedef HashMap<ResKey, ResPtr, ResKeyHash> ResIndex;
+	typedef HashMap<String, ResPtr, IgnoreCase_Hash, IgnoreCase_EqualTo> NameIndex;
+
+	int getTypeNum(uint32 typeID) const;
+	ResPtr findResource(uint32 typeID, uint16 resID) const;
+	SeekableReadStream *readResource(const Resource &res);
+
+	/**
+	 * Create a stream for part of _stream which points into its memory, or
+	 * return nullptr when _stream does not sit in memory.
+	 */
+	SeekableReadStream *createMappedStream(uint32 offset, uint32 size);
+
 	int32 _resForkOffset;
 	uint32 _resForkSize;
 
@@ -248,6 +290,11 @@ private:
 	ResMap _resMap;
 	ResType *_resTypes;
 	ResPtr  *_resLists;
+
+	bool _mapRead;
+	TypeIndex _typeIndex; ///< The first type with each ID
+	ResIndex _resIndex;   ///< The first resource with each type and ID
+	NameIndex _nameIndex; ///< The first resource with each name, of any type
 };
 
 } // End of namespace Common
@@ -23,6 +23,7 @@
 #ifndef COMMON_MEMSTREAM_H
 #define COMMON_MEMSTREAM_H
 
+#include "common/memtracker.h"
 #include "common/stream.h"
 #include "common/types.h"
 #include "common/util.h"
@@ -47,7 +48,8 @@ public:
 	/**
 	 * This constructor takes a pointer to a memory buffer and a length, and
 	 * wraps it. If disposeMemory is true, the MemoryReadStream takes ownership
-	 * of the buffer and hence free's it when destructed.
+	 * of the buffer and hence free's it when destructed. Owned buffers are
+	 * accounted as kMemoryStreams by the MemoryTracker.
 	 */
 	MemoryReadStream(const byte *dataPtr, uint32 dataSize, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO) :
 		_ptrOrig(dataPtr),
@@ -55,11 +57,16 @@ public:
 		_size(dataSize),
 		_pos(0),
 		_disposeMemory(disposeMemory),
-		_eos(false) {}
+		_eos(false) {
+		if (_disposeMemory)
+			MemoryTracker::add(kMemoryStreams, _size);
+	}
 
 	~MemoryReadStream() {
-		if (_disposeMemory)
+		if (_disposeMemory) {
 			free(const_cast<byte *>(_ptrOrig));
+			MemoryTracker::add(kMemoryStreams, -(int32)_size);
+		}
 	}
 
 	uint32 read(void *dataPtr, uint32 dataSize);
@@ -71,6 +78,27 @@ public:
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
+
+	const byte *getDataPointer() const { return _ptrOrig; }
+
+	/**
+	 * Move past the next dataSize bytes and return a pointer to them, for
+	 * callers which parse the data in place. If fewer bytes are left, the
+	 * stream is moved to its end, the end of stream flag is set and
+	 * nullptr is returned.
+	 */
+	const byte *advance(uint32 dataSize) {
+		if (dataSize > _size - _pos) {
+			_ptr = _ptrOrig + _size;
+			_pos = _size;
+			_eos = true;
+			return nullptr;
+		}
+		const byte *ptr = _ptr;
+		_ptr += dataSize;
+		_pos += dataSize;
+		return ptr;
+	}
 };
 
 
@@ -210,6 +238,20 @@ public:
 
 	byte *getData() { return _data; }
 
+	/**
+	 * Move past the next dataSize bytes, growing the stream as needed, and
+	 * return a pointer to them for the caller to fill in place.
+	 */
+	byte *advance(uint32 dataSize) {
+		ensureCapacity(_pos + dataSize);
+		byte *ptr = _ptr;
+		_ptr += dataSize;
+		_pos += dataSize;
+		if (_pos > _size)
+			_size = _pos;
+		return ptr;
+	}
+
 	virtual bool seek(int32 offs, int whence = SEEK_SET) override {
 		// Pre-Condition
 		assert(_pos <= _size);
@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/memtracker.h"
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/atomic.h"
+
+namespace Common {
+
+static AtomicInt32 s_current[kMemoryTagCount];
+static AtomicInt32 s_peak[kMemoryTagCount];
+static AtomicInt32 s_total;
+static AtomicInt32 s_budget;
+
+static Array<MemoryReclaimer *> s_reclaimers;
+
+static const char *const s_tagNames[kMemoryTagCount] = {
+	"resources",
+	"video",
+	"streams",
+	"images",
+	"transforms"
+};
+
+void MemoryTracker::add(MemoryTag tag, int32 delta) {
+	assert(tag < kMemoryTagCount);
+
+	const int32 current = s_current[tag].fetchAdd(delta) + delta;
+	s_total.fetchAdd(delta);
+
+	int32 peak = s_peak[tag].load();
+	while (current > peak && !s_peak[tag].compareExchange(peak, current))
+		peak = s_peak[tag].load();
+}
+
+uint32 MemoryTracker::getCurrent(MemoryTag tag) {
+	assert(tag < kMemoryTagCount);
+	return (uint32)s_current[tag].load();
+}
+
+uint32 MemoryTracker::getPeak(MemoryTag tag) {
+	assert(tag < kMemoryTagCount);
+	return (uint32)s_peak[tag].load();
+}
+
+uint32 MemoryTracker::getTotal() {
+	return (uint32)s_total.load();
+}
+
+void MemoryTracker::resetPeaks() {
+	for (int i = 0; i < kMemoryTagCount; i++)
+		s_peak[i].store(s_current[i].load());
+}
+
+const char *MemoryTracker::getTagName(MemoryTag tag) {
+	assert(tag < kMemoryTagCount);
+	return s_tagNames[tag];
+}
+
+String MemoryTracker::formatUsage() {
+	String result;
+	for (int i = 0; i < kMemoryTagCount; i++) {
+		const MemoryTag tag = (MemoryTag)i;
+		result += String::format("%s %u/%u KB, ", getTagName(tag), getCurrent(tag) / 1024, getPeak(tag) / 1024);
+	}
+
+	result += String::format("total %u KB", getTotal() / 1024);
+	if (getBudget())
+		result += String::format(" of %u KB", getBudget() / 1024);
+	return result;
+}
+
+void MemoryTracker::setBudget(uint32 bytes) {
+	s_budget.store((int32)bytes);
+}
+
+uint32 MemoryTracker::getBudget() {
+	return (uint32)s_budget.load();
+}
+
+bool MemoryTracker::isOverBudget() {
+	const uint32 budget = getBudget();
+	return budget && getTotal() > budget;
+}
+
+void MemoryTracker::addReclaimer(MemoryReclaimer *reclaimer) {
+	if (find(s_reclaimers.begin(), s_reclaimers.end(), reclaimer) == s_reclaimers.end())
+		s_reclaimers.push_back(reclaimer);
+}
+
+void MemoryTracker::removeReclaimer(MemoryReclaimer *reclaimer) {
+	Array<MemoryReclaimer *>::iterator i = find(s_reclaimers.begin(), s_reclaimers.end(), reclaimer);
+	if (i != s_reclaimers.end())
+		s_reclaimers.erase(i);
+}
+
+uint32 MemoryTracker::enforceBudget() {
+	uint32 freed = 0;
+	for (uint i = 0; i < s_reclaimers.size() && isOverBudget(); i++)
+		freed += s_reclaimers[i]->reclaimMemory(getTotal() - getBudget());
+	return freed;
+}
+
+} // End of namespace Common
@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_MEMTRACKER_H
+#define COMMON_MEMTRACKER_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+namespace Common {
+
+/** The big memory consumers whose usage is accounted. */
+enum MemoryTag {
+	kMemoryResources,      ///< Engine resource managers
+	kMemoryVideo,          ///< Frames decoded ahead by VideoDecoder
+	kMemoryStreams,        ///< Buffers owned by MemoryReadStream, mostly archive members
+	kMemoryImages,         ///< Surfaces of the image decoders
+	kMemoryTransformCache, ///< Results kept by Graphics::TransformCache
+
+	kMemoryTagCount
+};
+
+/**
+ * A cache which can give memory back when the memory budget is exceeded.
+ */
+class MemoryReclaimer {
+public:
+	virtual ~MemoryReclaimer() {}
+
+	/**
+	 * Free memory which can be recreated later.
+	 *
+	 * @param bytes how many bytes should be freed at least
+	 * @return the number of bytes actually freed
+	 */
+	virtual uint32 reclaimMemory(uint32 bytes) = 0;
+};
+
+/**
+ * Keeps the current and peak number of bytes used by each MemoryTag.
+ *
+ * Accounting is lock-free, so it may be done from any thread. Only the
+ * total of the tags is checked against the budget; everything which
+ * concerns reclaimers has to be done on the main thread.
+ */
+class MemoryTracker {
+public:
+	/** Account delta more bytes, which may be negative, for tag. */
+	static void add(MemoryTag tag, int32 delta);
+
+	static uint32 getCurrent(MemoryTag tag);
+	static uint32 getPeak(MemoryTag tag);
+	/** The current usage of all tags together. */
+	static uint32 getTotal();
+
+	/** Set the peaks back to the current usage. */
+	static void resetPeaks();
+
+	static const char *getTagName(MemoryTag tag);
+
+	/** Describe the current and peak usage of all tags on one line. */
+	static String formatUsage();
+
+	/** Set the memory budget in bytes for all tags together, 0 for none. */
+	static void setBudget(uint32 bytes);
+	static uint32 getBudget();
+
+	static bool isOverBudget();
+
+	/**
+	 * Register a cache to be asked for memory when over budget. The
+	 * reclaimers are asked in the order they were added.
+	 */
+	static void addReclaimer(MemoryReclaimer *reclaimer);
+	static void removeReclaimer(MemoryReclaimer *reclaimer);
+
+	/**
+	 * Ask the reclaimers for memory until the total usage is within the
+	 * budget again, or all of them were asked.
+	 *
+	 * @return the number of bytes freed
+	 */
+	static uint32 enforceBudget();
+};
+
+/**
+ * The memory accounted for one object. Whatever is still accounted is
+ * given back on destruction.
+ */
+class MemoryUsage : NonCopyable {
+public:
+	explicit MemoryUsage(MemoryTag tag) : _tag(tag), _size(0) {}
+	~MemoryUsage() { set(0); }
+
+	/** Change the accounted usage to size bytes. */
+	void set(uint32 size) {
+		if (size != _size) {
+			MemoryTracker::add(_tag, (int32)(size - _size));
+			_size = size;
+		}
+	}
+
+	uint32 get() const { return _size; }
+
+private:
+	const MemoryTag _tag;
+	uint32 _size;
+};
+
+} // End of namespace Common
+
+#endif
@@ -10,18 +10,22 @@ MODULE_OBJS := \
 	EventDispatcher.o \
 	EventMapper.o \
 	file.o \
+	framearena.o \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
 	iff_container.o \
 	ini-file.o \
 	installshield_cab.o \
+	internedstring.o \
 	json.o \
 	language.o \
 	localization.o \
+	lz4.o \
 	macresman.o \
 	memorypool.o \
 	md5.o \
+	memtracker.o \
 	mutex.o \
 	osd_message_queue.o \
 	platform.o \
@@ -32,6 +36,7 @@ MODULE_OBJS := \
 	str.o \
 	stream.o \
 	system.o \
+	taskscheduler.o \
 	textconsole.o \
 	tokenizer.o \
 	translation.o \
@@ -58,6 +63,16 @@ MODULE_OBJS += \
 	recorderfile.o
 endif
 
+ifdef ENABLE_PROFILER
+MODULE_OBJS += \
+	profiler.o
+endif
+
+ifdef USE_STACKFUL_COROUTINES
+MODULE_OBJS += \
+	coroutines-libco.o
+endif
+
 ifdef USE_UPDATES
 MODULE_OBJS += \
 	updates.o
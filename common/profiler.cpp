@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/profiler.h"
+
+#ifdef ENABLE_PROFILER
+
+#include "common/stream.h"
+#include "common/str.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+#ifndef SCUMMVM_THREAD_LOCAL
+#error The profiler needs thread local storage, see SCUMMVM_THREAD_LOCAL in common/scummsys.h
+#endif
+
+// The buffer of the calling thread, set up on its first zone
+static SCUMMVM_THREAD_LOCAL void *s_threadBuffer = 0;
+
+Profiler::Profiler() : _recording(false) {
+}
+
+Profiler::~Profiler() {
+	for (uint i = 0; i < _buffers.size(); i++)
+		delete _buffers[i];
+}
+
+uint64 Profiler::now() {
+	return g_system->getMicroseconds();
+}
+
+Profiler::ThreadBuffer *Profiler::getThreadBuffer() {
+	if (!s_threadBuffer) {
+		ThreadBuffer *buffer = new ThreadBuffer();
+		buffer->next = 0;
+		buffer->count = 0;
+
+		StackLock lock(_mutex);
+		buffer->threadIndex = _buffers.size();
+		_buffers.push_back(buffer);
+		s_threadBuffer = buffer;
+	}
+
+	return (ThreadBuffer *)s_threadBuffer;
+}
+
+void Profiler::addZone(const char *name, uint64 start, uint64 end) {
+	ThreadBuffer *buffer = getThreadBuffer();
+
+	Zone &zone = buffer->zones[buffer->next];
+	zone.name = name;
+	zone.start = start;
+	zone.end = end;
+
+	buffer->next = (buffer->next + 1) % kEventsPerThread;
+	if (buffer->count < kEventsPerThread)
+		buffer->count++;
+}
+
+void Profiler::clear() {
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _buffers.size(); i++) {
+		_buffers[i]->next = 0;
+		_buffers[i]->count = 0;
+	}
+}
+
+Array<Profiler::Zone> Profiler::getZones(uint64 start, uint64 end) {
+	StackLock lock(_mutex);
+
+	Array<Zone> zones;
+	for (uint i = 0; i < _buffers.size(); i++) {
+		const ThreadBuffer *buffer = _buffers[i];
+		const uint32 first = (buffer->next + kEventsPerThread - buffer->count) % kEventsPerThread;
+
+		for (uint32 j = 0; j < buffer->count; j++) {
+			const Zone &zone = buffer->zones[(first + j) % kEventsPerThread];
+			if (zone.start >= start && zone.end <= end)
+				zones.push_back(zone);
+		}
+	}
+
+	return zones;
+}
+
+static String escapeJSON(const char *str) {
+	String result;
+
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			result += '\\';
+		result += *str;
+	}
+
+	return result;
+}
+
+uint Profiler::writeChromeTrace(WriteStream &out) {
+	StackLock lock(_mutex);
+
+	uint written = 0;
+	out.writeString("{\"traceEvents\":[\n");
+
+	for (uint i = 0; i < _buffers.size(); i++) {
+		const ThreadBuffer *buffer = _buffers[i];
+		const uint32 first = (buffer->next + kEventsPerThread - buffer->count) % kEventsPerThread;
+
+		for (uint32 j = 0; j < buffer->count; j++) {
+			const Zone &zone = buffer->zones[(first + j) % kEventsPerThread];
+
+			out.writeString(String::format("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%llu}",
+				written ? ",\n" : "", escapeJSON(zone.name).c_str(), buffer->threadIndex,
+				(unsigned long long)zone.start, (unsigned long long)(zone.end - zone.start)));
+			written++;
+		}
+	}
+
+	out.writeString("\n],\"displayTimeUnit\":\"ms\"}\n");
+	return written;
+}
+
+} // End of namespace Common
+
+#endif // ENABLE_PROFILER
@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+/**
+ * @def PROFILE_ZONE(name)
+ * Record the time from here to the end of the enclosing scope as a zone
+ * called name, which has to stay valid for the rest of the program, like
+ * a string literal. Expands to nothing unless
+ * ScummVM is configured with --enable-profiler.
+ *
+ * @def PROFILE_FUNCTION()
+ * A PROFILE_ZONE named after the enclosing function.
+ */
+
+#ifdef ENABLE_PROFILER
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * Collects timed zones from all threads, to be inspected with the
+ * chrome://tracing viewer of Chrome or compatible tools.
+ *
+ * Each thread records into its own ring buffer, keeping the most recent
+ * kEventsPerThread zones. Nothing is recorded until start() is called,
+ * which the debug console command "profile" does.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	enum {
+		kEventsPerThread = 65536
+	};
+
+	/** Start recording zones. Previously recorded zones are kept. */
+	void start() { _recording = true; }
+
+	/** Stop recording zones. */
+	void stop() { _recording = false; }
+
+	bool isRecording() const { return _recording; }
+
+	/** Throw away all recorded zones. */
+	void clear();
+
+	/** Record a zone of the calling thread. Times are in microseconds. */
+	void addZone(const char *name, uint64 start, uint64 end);
+
+	/**
+	 * Write all recorded zones as a Chrome trace event JSON file. Stop the
+	 * recording first to get consistent data.
+	 *
+	 * @return the number of zones written
+	 */
+	uint writeChromeTrace(WriteStream &out);
+
+	/** The time stamp used for zones. */
+	static uint64 now();
+
+	struct Zone {
+		const char *name;
+		uint64 start;
+		uint64 end;
+	};
+
+	/** The recorded zones of all threads which lie between start and end. */
+	Array<Zone> getZones(uint64 start, uint64 end);
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	Profiler();
+	~Profiler();
+
+	struct ThreadBuffer {
+		uint threadIndex;
+		uint32 next;  ///< Where the next zone goes
+		uint32 count; ///< Number of valid zones, up to kEventsPerThread
+		Zone zones[kEventsPerThread];
+	};
+
+	ThreadBuffer *getThreadBuffer();
+
+	volatile bool _recording;
+	Mutex _mutex; ///< Guards _buffers
+	Array<ThreadBuffer *> _buffers;
+};
+
+/**
+ * Records the time from its construction to its destruction as a zone.
+ * Use PROFILE_ZONE instead.
+ */
+class ProfileZone {
+public:
+	explicit ProfileZone(const char *name) : _name(name), _active(Profiler::hasInstance() && Profiler::instance().isRecording()), _start(0) {
+		if (_active)
+			_start = Profiler::now();
+	}
+
+	~ProfileZone() {
+		if (_active)
+			Profiler::instance().addZone(_name, _start, Profiler::now());
+	}
+
+private:
+	const char *_name;
+	const bool _active;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+
+#define PROFILE_ZONE(name) Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_FUNCTION() do {} while (0)
+
+#endif // ENABLE_PROFILER
+
+#endif
@@ -852,4 +852,97 @@ QuickTimeParser::Track::~Track() {
 		delete sampleDescs[i];
 }
 
+const QuickTimeParser::SampleTableEntry &QuickTimeParser::Track::getSample(uint32 sample) {
+	if (_sampleTable.empty())
+		buildSampleTable();
+
+	assert(sample < _sampleTable.size());
+	return _sampleTable[sample];
+}
+
+uint32 QuickTimeParser::Track::findFrameAtTime(uint32 mediaTime) {
+	if (frameCount == 0)
+		return 0;
+
+	const SampleTableEntry &last = getSample(frameCount - 1);
+	if (mediaTime >= last.time + last.duration)
+		return frameCount;
+
+	// Binary search for the last frame starting at or before the time
+	uint32 lo = 0, hi = frameCount;
+	while (hi - lo > 1) {
+		uint32 mid = (lo + hi) / 2;
+		if (_sampleTable[mid].time <= mediaTime)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+uint32 QuickTimeParser::Track::findKeyframe(uint32 frame) const {
+	// The keyframes are stored in ascending order
+	uint32 lo = 0, hi = keyframeCount;
+	while (lo < hi) {
+		uint32 mid = (lo + hi) / 2;
+		if (keyframes[mid] <= frame)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	// If none found, we'll assume the requested frame is a key frame
+	return lo > 0 ? keyframes[lo - 1] : frame;
+}
+
+void QuickTimeParser::Track::buildSampleTable() {
+	const uint32 count = MAX(sampleCount, frameCount);
+	if (count == 0) {
+		// Keep the table non-empty, so it is only built once
+		_sampleTable.resize(1);
+		memset(&_sampleTable[0], 0, sizeof(SampleTableEntry));
+		return;
+	}
+
+	_sampleTable.resize(count);
+	memset(&_sampleTable[0], 0, count * sizeof(SampleTableEntry));
+
+	// Sample sizes and locations, walking the chunks once
+	uint32 sample = 0;
+	uint32 sampleToChunkIndex = 0;
+	for (uint32 i = 0; i < chunkCount && sample < count; i++) {
+		if (sampleToChunkIndex < sampleToChunkCount && i >= sampleToChunk[sampleToChunkIndex].first)
+			sampleToChunkIndex++;
+
+		if (sampleToChunkIndex == 0)
+			continue;
+
+		const SampleToChunkEntry &entry = sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = chunkOffsets[i];
+		for (uint32 j = 0; j < entry.count && sample < count; j++, sample++) {
+			SampleTableEntry &dest = _sampleTable[sample];
+			dest.offset = offset;
+			dest.size = sampleSize != 0 ? sampleSize : (sample < sampleCount ? sampleSizes[sample] : 0);
+			dest.descId = entry.id;
+			dest.inChunk = true;
+			offset += dest.size;
+		}
+	}
+
+	// Sample times; samples past the end of stts have no duration
+	uint32 time = 0;
+	sample = 0;
+	for (int32 i = 0; i < timeToSampleCount; i++) {
+		for (int j = 0; j < timeToSample[i].count && sample < count; j++, sample++) {
+			_sampleTable[sample].time = time;
+			_sampleTable[sample].duration = timeToSample[i].duration;
+			time += timeToSample[i].duration;
+		}
+	}
+
+	for (; sample < count; sample++)
+		_sampleTable[sample].time = time;
+}
+
 } // End of namespace Video
@@ -96,6 +96,16 @@ protected:
 		uint32 id;
 	};
 
+	/** Location and timing of a single sample, see Track::getSample(). */
+	struct SampleTableEntry {
+		uint32 offset;   ///< Offset of the sample data in the file
+		uint32 size;     ///< Size of the sample data
+		uint32 time;     ///< Start time, in the track's time scale
+		uint32 duration; ///< Duration, in the track's time scale
+		uint16 descId;   ///< Sample description index, starting at 1
+		bool inChunk;    ///< Whether any chunk holds the sample data
+	};
+
 	struct EditListEntry {
 		uint32 trackDuration;
 		uint32 timeOffset;
@@ -158,6 +168,30 @@ protected:
 		uint32 startTime;
 		Rational scaleFactorX;
 		Rational scaleFactorY;
+
+		/**
+		 * Get the sample table entry of a sample.
+		 *
+		 * The flat sample table is built from the stsc, stco, stsz and stts
+		 * atoms on first use, so tracks that are only read chunk by chunk,
+		 * like audio, never pay for it.
+		 */
+		const SampleTableEntry &getSample(uint32 sample);
+
+		/**
+		 * Find the frame playing at a media time, in the track's time scale.
+		 *
+		 * @return the frame, or frameCount if the time is past the last frame
+		 */
+		uint32 findFrameAtTime(uint32 mediaTime);
+
+		/** Find the last keyframe at or before a frame, or the frame itself if there is none. */
+		uint32 findKeyframe(uint32 frame) const;
+
+	private:
+		Array<SampleTableEntry> _sampleTable;
+
+		void buildSampleTable();
 	};
 
 	virtual SampleDesc *readSampleDesc(Track *track, uint32 format, uint32 descSize) = 0;
@@ -25,12 +25,16 @@
 
 #include "common/noncopyable.h"
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/func.h"
 #include "common/stream.h"
 #include "common/str-array.h"
 #include "common/error.h"
+#include "common/taskscheduler.h"
 
 namespace Common {
 
+class MemoryWriteStreamDynamic;
 
 /**
  * A class which allows game engines to load game state data.
@@ -58,6 +62,13 @@ public:
 	virtual bool flush();
 	virtual uint32 write(const void *dataPtr, uint32 dataSize);
 	virtual int32 pos() const;
+
+	/**
+	 * Finalize only the wrapped stream, without syncing the saves to the
+	 * cloud. This is what background saves do on the task, the sync is
+	 * started from the main thread once they are done.
+	 */
+	void finalizeStream();
 };
 
 /**
@@ -80,11 +91,34 @@ public:
  * SaveFileManager instances to be used.
  */
 class SaveFileManager : NonCopyable {
+public:
+	/**
+	 * Called once a save written through openForSavingAsync() is done, with
+	 * whether it was written successfully. It is called on the main thread,
+	 * from the first waitForAsyncSave() or waitForAsyncSaves() call which
+	 * finds the save done.
+	 */
+	typedef Functor1<bool, void> AsyncSaveCallback;
 
 protected:
 	Error _error;
 	String _errorDesc;
 
+	struct PendingSave {
+		String name;
+		Task *task;
+		TaskFuture future;
+	};
+
+	/**
+	 * Run the callback of a finished save, and start the cloud sync which
+	 * the task left out.
+	 */
+	void finishAsyncSave(PendingSave &pending);
+
+	/** Saves handed to the task scheduler which may not be written yet. */
+	Array<PendingSave> _pendingSaves;
+
 	/**
 	 * Set some information about the last error which occurred .
 	 * @param error Code identifying the last error.
@@ -141,6 +175,43 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the savefile with the specified name for saving in the background.
+	 *
+	 * Everything written to the returned file is kept in memory. On
+	 * finalize() the savefile is opened through openForSaving(), and the
+	 * data is compressed and written by a task of the task scheduler, so the
+	 * caller does not have to wait for slow storage. If the savefile could
+	 * not be opened, err() is set once finalize() returns. Errors while
+	 * writing are only reported to the callback. Once the data is written,
+	 * the saves are synced to the cloud from the main thread, like
+	 * OutSaveFile::finalize() does.
+	 *
+	 * Saving a file again while it is still being written first waits for
+	 * the earlier write. The savefile manager must only be used from the
+	 * main thread, and waitForAsyncSaves() must be called before it is
+	 * destroyed.
+	 *
+	 * @param name      The name of the savefile.
+	 * @param compress  Toggles whether to compress the resulting save file
+	 *                  (default) or not.
+	 * @param callback  Optional callback for when the save is done. It is
+	 *                  called exactly once, and deleted afterwards.
+	 * @return Pointer to an OutSaveFile.
+	 */
+	OutSaveFile *openForSavingAsync(const String &name, bool compress = true, AsyncSaveCallback *callback = nullptr);
+
+	/**
+	 * Wait until the savefile with the specified name, if it was saved
+	 * through openForSavingAsync(), is completely written. Backends call
+	 * this before touching a file, so loading a save right after saving it
+	 * returns the new data.
+	 */
+	void waitForAsyncSave(const String &name);
+
+	/** Wait until all saves written through openForSavingAsync() are done. */
+	virtual void waitForAsyncSaves();
+
 	/**
 	 * Open the file with the specified name in the given directory for loading.
 	 *
@@ -207,6 +278,16 @@ public:
 	 * for saving or loading because they are being synced by CloudManager.
 	 */
 	virtual void updateSavefilesList(StringArray &lockedFiles) = 0;
+
+private:
+	friend class AsyncOutSaveFile;
+
+	/**
+	 * Open the savefile and schedule writing data to it. Takes ownership of
+	 * data and callback.
+	 * @return false if the savefile could not be opened.
+	 */
+	bool queueAsyncSave(const String &name, bool compress, MemoryWriteStreamDynamic *data, AsyncSaveCallback *callback);
 };
 
 } // End of namespace Common
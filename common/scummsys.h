@@ -393,6 +393,14 @@
 	#endif
 #endif
 
+#ifndef SCUMMVM_THREAD_LOCAL
+	#if defined(_MSC_VER)
+		#define SCUMMVM_THREAD_LOCAL __declspec(thread)
+	#elif defined(__GNUC__) || defined(__INTEL_COMPILER)
+		#define SCUMMVM_THREAD_LOCAL __thread
+	#endif
+#endif
+
 #ifndef WARN_UNUSED_RESULT
 	#if __cplusplus >= 201703L
 		#define WARN_UNUSED_RESULT [[nodiscard]]
@@ -23,6 +23,8 @@
 #ifndef COMMON_SERIALIZER_H
 #define COMMON_SERIALIZER_H
 
+#include "common/endian.h"
+#include "common/memstream.h"
 #include "common/stream.h"
 #include "common/str.h"
 
@@ -30,12 +32,21 @@ namespace Common {
 
 #define VER(x) Common::Serializer::Version(x)
 
-#define SYNC_AS(SUFFIX,TYPE,SIZE) \
+#define SYNC_READ_BYTE(ptr) (*(ptr))
+#define SYNC_WRITE_BYTE(ptr, value) (*(ptr) = (value))
+
+#define SYNC_AS(SUFFIX,TYPE,SIZE,READ,WRITE) \
 	template<typename T> \
 	void syncAs ## SUFFIX(T &val, Version minVersion = 0, Version maxVersion = kLastVersion) { \
 		if (_version < minVersion || _version > maxVersion) \
 			return; \
-		if (_loadStream) \
+		if (_memLoadStream) { \
+			const byte *ptr = _memLoadStream->advance(SIZE); \
+			val = static_cast<T>(ptr ? (TYPE)READ(ptr) : 0); \
+		} else if (_memSaveStream) { \
+			TYPE tmp = val; \
+			WRITE(_memSaveStream->advance(SIZE), tmp); \
+		} else if (_loadStream) \
 			val = static_cast<T>(_loadStream->read ## SUFFIX()); \
 		else { \
 			TYPE tmp = val; \
@@ -44,6 +55,18 @@ namespace Common {
 		_bytesSynced += SIZE; \
 	}
 
+#define SYNC_ARRAY_BULK(TYPE,SUFFIX) \
+	void syncArray(TYPE *arr, size_t entries, void (*serializer)(Serializer &, TYPE &), Version minVersion = 0, Version maxVersion = kLastVersion) { \
+		if (_version < minVersion || _version > maxVersion) \
+			return; \
+		if (serializer == &SUFFIX ## LE<TYPE>) \
+			syncBulk(arr, entries, false); \
+		else if (serializer == &SUFFIX ## BE<TYPE>) \
+			syncBulk(arr, entries, true); \
+		else \
+			syncEach(arr, entries, serializer); \
+	}
+
 #define SYNC_PRIMITIVE(suffix) \
 	template <typename T> \
 	static inline void suffix(Serializer &s, T &value) { \
@@ -88,13 +111,21 @@ protected:
 	SeekableReadStream *_loadStream;
 	WriteStream *_saveStream;
 
+	/**
+	 * Set when the streams are memory streams. Primitives are then read
+	 * and written in place rather than through the stream interface.
+	 */
+	MemoryReadStream *_memLoadStream;
+	MemoryWriteStreamDynamic *_memSaveStream;
+
 	uint _bytesSynced;
 
 	Version _version;
 
 public:
 	Serializer(SeekableReadStream *in, WriteStream *out)
-		: _loadStream(in), _saveStream(out), _bytesSynced(0), _version(0) {
+		: _loadStream(in), _saveStream(out), _memLoadStream(nullptr), _memSaveStream(nullptr),
+		  _bytesSynced(0), _version(0) {
 		assert(in || out);
 	}
 	virtual ~Serializer() {}
@@ -110,18 +141,18 @@ public:
 	// of the class declaration. This caused an internal compiler error
 	// in the line "syncAsUint32LE(_version);" of
 	// "bool syncVersion(Version currentVersion)".
-	SYNC_AS(Byte, byte, 1)
-	SYNC_AS(SByte, int8, 1)
+	SYNC_AS(Byte, byte, 1, SYNC_READ_BYTE, SYNC_WRITE_BYTE)
+	SYNC_AS(SByte, int8, 1, SYNC_READ_BYTE, SYNC_WRITE_BYTE)
 
-	SYNC_AS(Uint16LE, uint16, 2)
-	SYNC_AS(Uint16BE, uint16, 2)
-	SYNC_AS(Sint16LE, int16, 2)
-	SYNC_AS(Sint16BE, int16, 2)
+	SYNC_AS(Uint16LE, uint16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_AS(Uint16BE, uint16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+	SYNC_AS(Sint16LE, int16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_AS(Sint16BE, int16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
 
-	SYNC_AS(Uint32LE, uint32, 4)
-	SYNC_AS(Uint32BE, uint32, 4)
-	SYNC_AS(Sint32LE, int32, 4)
-	SYNC_AS(Sint32BE, int32, 4)
+	SYNC_AS(Uint32LE, uint32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_AS(Uint32BE, uint32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+	SYNC_AS(Sint32LE, int32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_AS(Sint32BE, int32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
 
 	/**
 	 * Returns true if an I/O failure occurred.
@@ -255,19 +286,113 @@ public:
 		}
 	}
 
+	/**
+	 * Sync an array by calling the serializer on each of its entries.
+	 *
+	 * Arrays of 8, 16 and 32 bit integers synced with the primitive of
+	 * their own size, e.g. an uint16 array with Serializer::Uint16LE, are
+	 * read and written as a whole, and byte swapped in bulk if needed.
+	 */
 	template <typename T>
 	void syncArray(T *arr, size_t entries, void (*serializer)(Serializer &, T &), Version minVersion = 0, Version maxVersion = kLastVersion) {
 		if (_version < minVersion || _version > maxVersion)
 			return;
 
+		syncEach(arr, entries, serializer);
+	}
+
+	void syncArray(byte *arr, size_t entries, void (*serializer)(Serializer &, byte &), Version minVersion = 0, Version maxVersion = kLastVersion) {
+		if (serializer == &Byte<byte>)
+			syncBytes(arr, entries, minVersion, maxVersion);
+		else if (_version >= minVersion && _version <= maxVersion)
+			syncEach(arr, entries, serializer);
+	}
+
+	void syncArray(int8 *arr, size_t entries, void (*serializer)(Serializer &, int8 &), Version minVersion = 0, Version maxVersion = kLastVersion) {
+		if (serializer == &SByte<int8>)
+			syncBytes((byte *)arr, entries, minVersion, maxVersion);
+		else if (_version >= minVersion && _version <= maxVersion)
+			syncEach(arr, entries, serializer);
+	}
+
+	SYNC_ARRAY_BULK(uint16, Uint16)
+	SYNC_ARRAY_BULK(int16, Sint16)
+	SYNC_ARRAY_BULK(uint32, Uint32)
+	SYNC_ARRAY_BULK(int32, Sint32)
+
+private:
+	template <typename T>
+	void syncEach(T *arr, size_t entries, void (*serializer)(Serializer &, T &)) {
 		for (size_t i = 0; i < entries; ++i) {
 			serializer(*this, arr[i]);
 		}
 	}
+
+	static inline uint16 swapValue(uint16 value) { return SWAP_BYTES_16(value); }
+	static inline int16 swapValue(int16 value) { return (int16)SWAP_BYTES_16((uint16)value); }
+	static inline uint32 swapValue(uint32 value) { return SWAP_BYTES_32(value); }
+	static inline int32 swapValue(int32 value) { return (int32)SWAP_BYTES_32((uint32)value); }
+
+	template <typename T>
+	void syncBulk(T *arr, size_t entries, bool bigEndian) {
+#ifdef SCUMM_BIG_ENDIAN
+		const bool swap = !bigEndian;
+#else
+		const bool swap = bigEndian;
+#endif
+		const uint32 size = entries * sizeof(T);
+
+		if (isLoading()) {
+			// Entries past the end of the data are cleared, as the
+			// primitives do for single values
+			const uint32 count = _loadStream->read(arr, size);
+			if (count < size)
+				memset((byte *)arr + count, 0, size - count);
+			if (swap) {
+				for (size_t i = 0; i < entries; ++i)
+					arr[i] = swapValue(arr[i]);
+			}
+		} else if (!swap) {
+			_saveStream->write(arr, size);
+		} else {
+			// Swap into a copy, the caller's array must stay as it is
+			T buffer[256];
+			for (size_t i = 0; i < entries; i += ARRAYSIZE(buffer)) {
+				const size_t chunk = MIN<size_t>(entries - i, ARRAYSIZE(buffer));
+				for (size_t j = 0; j < chunk; ++j)
+					buffer[j] = swapValue(arr[i + j]);
+				_saveStream->write(buffer, chunk * sizeof(T));
+			}
+		}
+		_bytesSynced += size;
+	}
+};
+
+/**
+ * Serializer working on memory streams. The primitives access the memory
+ * directly instead of going through the stream interface, which makes
+ * syncing everything with many small fields much faster, e.g. for taking
+ * snapshots of the game state in memory.
+ *
+ * The streams must stay alive as long as the serializer; any other stream
+ * operation, like syncString(), goes through them as usual.
+ */
+class MemorySerializer : public Serializer {
+public:
+	explicit MemorySerializer(MemoryReadStream *in) : Serializer(in, nullptr) {
+		_memLoadStream = in;
+	}
+
+	explicit MemorySerializer(MemoryWriteStreamDynamic *out) : Serializer(nullptr, out) {
+		_memSaveStream = out;
+	}
 };
 
 #undef SYNC_PRIMITIVE
 #undef SYNC_AS
+#undef SYNC_ARRAY_BULK
+#undef SYNC_READ_BYTE
+#undef SYNC_WRITE_BYTE
 
 
 // Mixin class / interface
@@ -600,6 +600,18 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Returns a pointer to the complete contents of the stream, if these
+	 * are held in memory which stays valid and unchanged for the lifetime
+	 * of the stream, e.g. a memory buffer or a memory-mapped file. Client
+	 * code may use the data directly instead of copying it with read().
+	 * The stream position is not affected.
+	 *
+	 * @return a pointer to size() bytes of data, or nullptr if the stream
+	 *         has no such buffer
+	 */
+	virtual const byte *getDataPointer() const { return nullptr; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
@@ -77,6 +77,11 @@ public:
 	virtual int32 size() const { return _end - _begin; }
 
 	virtual bool seek(int32 offset, int whence = SEEK_SET);
+
+	virtual const byte *getDataPointer() const {
+		const byte *data = _parentStream->getDataPointer();
+		return data ? data + _begin : nullptr;
+	}
 };
 
 /**
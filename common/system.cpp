@@ -23,11 +23,13 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
 
 #include "common/system.h"
+#include "common/config-manager.h"
 #include "common/events.h"
 #include "common/fs.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/taskbar.h"
+#include "common/taskscheduler.h"
 #include "common/updates.h"
 #include "common/dialogs.h"
 #include "common/textconsole.h"
@@ -57,10 +59,17 @@ OSystem::OSystem() {
 	_dialogManager = nullptr;
 #endif
 	_fsFactory = nullptr;
+	_taskScheduler = nullptr;
 	_backendInitialized = false;
 }
 
 OSystem::~OSystem() {
+	// Tasks might still use any of the managers
+	if (_savefileManager)
+		_savefileManager->waitForAsyncSaves();
+	delete _taskScheduler;
+	_taskScheduler = nullptr;
+
 	delete _audiocdManager;
 	_audiocdManager = nullptr;
 
@@ -122,6 +131,10 @@ void OSystem::initBackend() {
 }
 
 void OSystem::destroy() {
+	// Finish writing the configuration while all of the backend is usable
+	if (Common::ConfigManager::hasInstance())
+		ConfMan.waitForFlush();
+
 	_backendInitialized = false;
 	Common::String::releaseMemoryPoolMutex();
 	delete this;
@@ -210,6 +223,55 @@ Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
 
+uint64 OSystem::getTicks() {
+	return (uint64)getMillis(true) * 1000;
+}
+
+uint64 OSystem::getTickFrequency() {
+	return 1000000;
+}
+
+uint64 OSystem::getMicroseconds() {
+	const uint64 counter = getTicks();
+	const uint64 frequency = getTickFrequency();
+
+	// Split up to not overflow with nanosecond counters
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+}
+
+uint64 OSystem::microsecondsToTicks(uint64 usecs) {
+	const uint64 frequency = getTickFrequency();
+	return (usecs / 1000000) * frequency + (usecs % 1000000) * frequency / 1000000;
+}
+
+void OSystem::sleepUntil(uint64 deadline) {
+	const uint64 frequency = getTickFrequency();
+	const uint64 ticksPerMilli = MAX<uint64>(frequency / 1000, 1);
+
+	uint64 now = getTicks();
+	if (now >= deadline)
+		return;
+
+	// delayMillis() may oversleep by a bit, so the last millisecond is
+	// spent waiting for the counter instead
+	const uint64 millis = (deadline - now) / ticksPerMilli;
+	if (millis > 1)
+		delayMillis((uint)MIN<uint64>(millis - 1, 0xFFFFFFFF));
+
+	while (getTicks() < deadline)
+		;
+}
+
+Common::TaskScheduler *OSystem::getTaskScheduler() {
+	if (!_taskScheduler)
+		_taskScheduler = createTaskScheduler();
+	return _taskScheduler;
+}
+
+Common::TaskScheduler *OSystem::createTaskScheduler() {
+	return new Common::TaskScheduler();
+}
+
 Common::SaveFileManager *OSystem::getSavefileManager() {
 	return _savefileManager;
 }
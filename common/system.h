@@ -56,6 +56,7 @@ class TextToSpeechManager;
 class DialogManager;
 #endif
 class TimerManager;
+class TaskScheduler;
 class SeekableReadStream;
 class WriteStream;
 #ifdef ENABLE_KEYMAPPER
@@ -216,6 +217,14 @@ protected:
 	 */
 	FilesystemFactory *_fsFactory;
 
+	/**
+	 * Created on first use by getTaskScheduler(), through
+	 * createTaskScheduler().
+	 *
+	 * @note _taskScheduler is deleted by the OSystem destructor.
+	 */
+	Common::TaskScheduler *_taskScheduler;
+
 	/**
 	 * Used by the default clipboard implementation, for backends that don't
 	 * implement clipboard support.
@@ -271,6 +280,30 @@ public:
 	 */
 	virtual void engineDone() { }
 
+	/**
+	 * Kinds of engine memory a backend may make available to external
+	 * tools, e.g. for achievements or debugging.
+	 */
+	enum MemoryRegion {
+		/** The main game variables, e.g. SCUMM and AGI variables or SCI globals */
+		kMemoryRegionGameVariables,
+
+		kMemoryRegionCount
+	};
+
+	/**
+	 * Tell the backend where the engine keeps a region of its state, so
+	 * it can be read in place. The memory has to stay valid until the
+	 * region is set again, or cleared by passing a null pointer.
+	 *
+	 * The default implementation ignores it.
+	 *
+	 * @param region	which region this is
+	 * @param data		the memory, or nullptr to clear the region
+	 * @param size		the size of the memory in bytes
+	 */
+	virtual void setMemoryRegion(MemoryRegion region, void *data, uint32 size) {}
+
 	/** @name Feature flags */
 	//@{
 
@@ -1112,9 +1145,47 @@ public:
 	*/
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the value of the most precise monotonic counter the backend has.
+	 * The starting point is arbitrary, so this is only good for measuring
+	 * durations and for computing deadlines for sleepUntil(). The counter
+	 * runs at getTickFrequency() ticks per second. The default
+	 * implementation is based on getMillis().
+	 */
+	virtual uint64 getTicks();
+
+	/**
+	 * Get the number of ticks per second of the counter returned by
+	 * getTicks(). This never changes while the program runs.
+	 */
+	virtual uint64 getTickFrequency();
+
+	/**
+	 * Get a time stamp in microseconds from the most precise clock the
+	 * backend has. The starting point is arbitrary, so this is only good for
+	 * measuring durations, e.g. by the profiler. The default implementation
+	 * converts getTicks().
+	 */
+	virtual uint64 getMicroseconds();
+
+	/**
+	 * Convert a duration in microseconds to ticks of getTicks().
+	 */
+	uint64 microsecondsToTicks(uint64 usecs);
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
+	/**
+	 * Sleep until getTicks() reaches the given deadline, returning
+	 * immediately if it already has. Frame limiters should use this rather
+	 * than delayMillis(), since the deadline does not drift by the rounding
+	 * and the overhead of each call. The default implementation sleeps
+	 * with delayMillis() for all but the last millisecond, and then waits
+	 * for the counter to get there.
+	 */
+	virtual void sleepUntil(uint64 deadline);
+
 	/**
 	 * Get the current time and date, in the local timezone.
 	 * Corresponds on many systems to the combination of time()
@@ -1231,6 +1302,38 @@ public:
 
 
 
+	/**
+	 * @name Task scheduling
+	 * Backends with thread support can offer a pool of worker threads,
+	 * which decoders, scalers and engines use to run work in parallel.
+	 * Backends without threads get a serial scheduler, which runs every
+	 * task right away on the calling thread.
+	 */
+	//@{
+
+	/**
+	 * Return the task scheduler shared by all users. It is created on
+	 * first use.
+	 */
+	Common::TaskScheduler *getTaskScheduler();
+
+	/**
+	 * Create the task scheduler returned by getTaskScheduler(). The default
+	 * implementation returns a serial scheduler.
+	 * The caller takes ownership of the returned object.
+	 */
+	virtual Common::TaskScheduler *createTaskScheduler();
+
+	//@}
+
+	/**
+	 * Return the size of the physical memory of the device in bytes, or 0
+	 * if it is unknown. Engines may use it to size their caches.
+	 */
+	virtual uint64 getPhysicalMemorySize() { return 0; }
+
+
+
 	/** @name Sound */
 	//@{
 
@@ -0,0 +1,137 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/taskscheduler.h"
+#include "common/array.h"
+#include "common/util.h"
+
+namespace Common {
+
+TaskFuture::TaskFuture(TaskScheduler *scheduler, TaskState *state) : _scheduler(scheduler), _state(state) {
+	_scheduler->retain(_state);
+}
+
+TaskFuture::TaskFuture(const TaskFuture &other) : _scheduler(other._scheduler), _state(other._state) {
+	if (_state)
+		_scheduler->retain(_state);
+}
+
+TaskFuture::~TaskFuture() {
+	if (_state)
+		_scheduler->release(_state);
+}
+
+TaskFuture &TaskFuture::operator=(const TaskFuture &other) {
+	if (other._state)
+		other._scheduler->retain(other._state);
+	if (_state)
+		_scheduler->release(_state);
+
+	_scheduler = other._scheduler;
+	_state = other._state;
+	return *this;
+}
+
+bool TaskFuture::isDone() const {
+	assert(_state);
+	return _scheduler->isDone(*_state);
+}
+
+void TaskFuture::wait() const {
+	assert(_state);
+	_scheduler->wait(_state);
+}
+
+TaskFuture TaskScheduler::schedule(Task *task, DisposeAfterUse::Flag disposeAfterUse) {
+	assert(task);
+
+	// The future takes its reference before the task is queued, so the
+	// state survives the task finishing right away
+	TaskState *state = new TaskState(task, disposeAfterUse);
+	TaskFuture future(this, state);
+	enqueue(state);
+	return future;
+}
+
+void TaskScheduler::enqueue(TaskState *state) {
+	runTask(state);
+	state->done = true;
+	release(state);
+}
+
+void TaskScheduler::release(TaskState *state) {
+	if (--state->refCount == 0)
+		delete state;
+}
+
+namespace {
+
+class ParallelForTask : public Task {
+public:
+	ParallelForTask(ParallelForBody &body, uint begin, uint end) : _body(body), _begin(begin), _end(end) {}
+
+	virtual void run() {
+		_body.run(_begin, _end);
+	}
+
+private:
+	ParallelForBody &_body;
+	const uint _begin, _end;
+};
+
+} // End of anonymous namespace
+
+void TaskScheduler::parallelFor(uint begin, uint end, ParallelForBody &body, uint grainSize) {
+	if (begin >= end)
+		return;
+
+	const uint count = end - begin;
+	grainSize = MAX<uint>(grainSize, 1);
+
+	// A few chunks per thread evens out chunks of different cost
+	uint chunks = MIN<uint>((count + grainSize - 1) / grainSize, getConcurrency() * 4);
+	if (chunks <= 1 || isSerial()) {
+		body.run(begin, end);
+		return;
+	}
+
+	Array<TaskFuture> futures;
+	futures.reserve(chunks - 1);
+
+	uint chunkBegin = begin;
+	for (uint i = 0; i < chunks; i++) {
+		const uint chunkEnd = begin + (uint)((uint64)count * (i + 1) / chunks);
+
+		// The calling thread takes the last chunk itself
+		if (i == chunks - 1)
+			body.run(chunkBegin, chunkEnd);
+		else
+			futures.push_back(schedule(new ParallelForTask(body, chunkBegin, chunkEnd)));
+
+		chunkBegin = chunkEnd;
+	}
+
+	for (uint i = 0; i < futures.size(); i++)
+		futures[i].wait();
+}
+
+} // End of namespace Common
@@ -0,0 +1,182 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_TASKSCHEDULER_H
+#define COMMON_TASKSCHEDULER_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/types.h"
+
+namespace Common {
+
+class TaskScheduler;
+
+/**
+ * A unit of work which can be handed to a TaskScheduler.
+ */
+class Task {
+public:
+	virtual ~Task() {}
+
+	/** Do the work. May be called on any thread. */
+	virtual void run() = 0;
+};
+
+/**
+ * Bookkeeping for a task handed to a TaskScheduler. Shared between the
+ * scheduler and all TaskFutures of the task, and only ever touched through
+ * the scheduler, which takes care of synchronizing.
+ */
+struct TaskState : NonCopyable {
+	Task *task;
+	DisposeAfterUse::Flag disposeAfterUse;
+	/** Set once the task has run. */
+	bool done;
+	/** Number of futures, plus one while the task is queued. */
+	int refCount;
+
+	TaskState(Task *t, DisposeAfterUse::Flag dispose) : task(t), disposeAfterUse(dispose), done(false), refCount(1) {}
+	~TaskState() {
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete task;
+	}
+};
+
+/**
+ * Handle to a task scheduled with TaskScheduler::schedule(), used to find
+ * out whether it finished, or to wait for it.
+ *
+ * A future must not outlive the scheduler it belongs to.
+ */
+class TaskFuture {
+public:
+	TaskFuture() : _scheduler(nullptr), _state(nullptr) {}
+	TaskFuture(const TaskFuture &other);
+	~TaskFuture();
+
+	TaskFuture &operator=(const TaskFuture &other);
+
+	/** Whether this future refers to a task at all. */
+	bool isValid() const { return _state != nullptr; }
+
+	/** Whether the task has finished running. */
+	bool isDone() const;
+
+	/**
+	 * Block until the task has finished running. A thread waiting for a
+	 * task helps running the queued tasks in the meantime, so waiting from
+	 * inside a task is fine.
+	 */
+	void wait() const;
+
+private:
+	friend class TaskScheduler;
+
+	TaskFuture(TaskScheduler *scheduler, TaskState *state);
+
+	TaskScheduler *_scheduler;
+	TaskState *_state;
+};
+
+/**
+ * Body of a TaskScheduler::parallelFor() loop.
+ */
+class ParallelForBody {
+public:
+	virtual ~ParallelForBody() {}
+
+	/** Process the indices from begin up to, but not including, end. */
+	virtual void run(uint begin, uint end) = 0;
+};
+
+/**
+ * Runs tasks, possibly in parallel to each other and to the caller.
+ *
+ * This base class is the serial scheduler used by backends without thread
+ * support: every task is run right away on the thread scheduling it.
+ * Backends with threads return a subclass from OSystem::createTaskScheduler()
+ * which uses a pool of worker threads instead.
+ *
+ * Code using a scheduler must therefore not rely on tasks running in
+ * parallel, nor on them running after schedule() returns.
+ *
+ * @see OSystem::getTaskScheduler()
+ */
+class TaskScheduler : NonCopyable {
+public:
+	virtual ~TaskScheduler() {}
+
+	/**
+	 * Return the number of tasks which may run at the same time, counting
+	 * the thread which waits for them. A serial scheduler returns 1.
+	 */
+	virtual uint getConcurrency() const { return 1; }
+
+	/** Whether this scheduler runs every task right away on the calling thread. */
+	bool isSerial() const { return getConcurrency() <= 1; }
+
+	/**
+	 * Schedule a task for running.
+	 *
+	 * @param task            the task to run
+	 * @param disposeAfterUse whether to delete the task once it has run
+	 * @return a future to wait for the task with
+	 */
+	TaskFuture schedule(Task *task, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+	/**
+	 * Run body over the index range [begin, end), split into chunks of at
+	 * least grainSize indices which are processed in parallel. Returns once
+	 * the whole range has been processed.
+	 */
+	void parallelFor(uint begin, uint end, ParallelForBody &body, uint grainSize = 1);
+
+protected:
+	friend class TaskFuture;
+
+	/**
+	 * Queue a task with the scheduler. The scheduler owns one reference to
+	 * the state, which it has to release() after running the task. The
+	 * default implementation runs the task right away.
+	 */
+	virtual void enqueue(TaskState *state);
+
+	/** Return whether the task has run. */
+	virtual bool isDone(const TaskState &state) const { return state.done; }
+
+	/** Wait for the task to have run. */
+	virtual void wait(TaskState *state) {}
+
+	/** Add a reference to the state. */
+	virtual void retain(TaskState *state) { state->refCount++; }
+
+	/** Drop a reference to the state, deleting it along with the last one. */
+	virtual void release(TaskState *state);
+
+	/** Run the task, for use by subclasses. This does not set the done flag. */
+	static void runTask(TaskState *state) { state->task->run(); }
+};
+
+} // End of namespace Common
+
+#endif
@@ -124,7 +124,7 @@ const char *TranslationManager::getTranslation(const char *message, const char *
 		const int midIndex = (leftIndex + rightIndex) / 2;
 		const PoMessageEntry *const m = &_currentTranslationMessages[midIndex];
 
-		int compareResult = strcmp(message, _messageIds[m->msgid].c_str());
+		int compareResult = strcmp(message, &_messageIdData[_messageIds[m->msgid]]);
 
 		if (compareResult == 0) {
 			// Get the range of messages with the same ID (but different context)
@@ -143,17 +143,17 @@ const char *TranslationManager::getTranslation(const char *message, const char *
 			}
 			// Find the context we want
 			if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
-				return _currentTranslationMessages[leftIndex].msgstr.c_str();
+				return &_currentTranslationData[_currentTranslationMessages[leftIndex].msgstr];
 			// We could use again binary search, but there should be only a small number of contexts.
 			while (rightIndex > leftIndex) {
-				compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt.c_str());
+				compareResult = strcmp(context, &_currentTranslationData[_currentTranslationMessages[rightIndex].msgctxt]);
 				if (compareResult == 0)
-					return _currentTranslationMessages[rightIndex].msgstr.c_str();
+					return &_currentTranslationData[_currentTranslationMessages[rightIndex].msgstr];
 				else if (compareResult > 0)
 					break;
 				--rightIndex;
 			}
-			return _currentTranslationMessages[leftIndex].msgstr.c_str();
+			return &_currentTranslationData[_currentTranslationMessages[leftIndex].msgstr];
 		} else if (compareResult < 0)
 			rightIndex = midIndex - 1;
 		else
@@ -295,8 +295,13 @@ void TranslationManager::loadTranslationsInfoDat() {
 
 	// Determine where the codepages start
 	_charmapStart = 0;
-	for (int i = 0; i < nbTranslations + 3; ++i)
-		_charmapStart += in.readUint16BE();
+	uint32 messageIdsSize = 0;
+	for (int i = 0; i < nbTranslations + 3; ++i) {
+		const uint16 blockSize = in.readUint16BE();
+		if (i == 2)
+			messageIdsSize = blockSize;
+		_charmapStart += blockSize;
+	}
 	_charmapStart += in.pos();
 
 	// Read list of languages
@@ -321,21 +326,29 @@ void TranslationManager::loadTranslationsInfoDat() {
 
 	// Read messages
 	int numMessages = in.readUint16BE();
+	_messageIdData.clear();
+	_messageIdData.reserve(messageIdsSize);
 	_messageIds.resize(numMessages);
-	for (int i = 0; i < numMessages; ++i) {
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
-		}
-		_messageIds[i] = msg;
-	}
+	for (int i = 0; i < numMessages; ++i)
+		_messageIds[i] = readString(in, _messageIdData);
+}
+
+uint32 TranslationManager::readString(File &in, Array<char> &data) {
+	const uint32 offset = data.size();
+	const uint len = in.readUint16BE();
+
+	// The strings are stored with their terminating zero, apart from empty
+	// ones, which are stored without any data at all
+	data.resize(offset + MAX<uint>(len, 1));
+	if (len > 0)
+		in.read(&data[offset], len);
+	data[data.size() - 1] = '\0';
+	return offset;
 }
 
 void TranslationManager::loadLanguageDat(int index) {
 	_currentTranslationMessages.clear();
+	_currentTranslationData.clear();
 	_currentCharset.clear();
 	// Sanity check
 	if (index < 0 || index >= (int)_langs.size()) {
@@ -369,8 +382,9 @@ void TranslationManager::loadLanguageDat(int index) {
 	int skipSize = 0;
 	for (int i = 0; i < index + 3; ++i)
 		skipSize += in.readUint16BE();
+	const uint32 blockSize = in.readUint16BE();
 	// We also need to skip the remaining block sizes
-	skipSize += 2 * (nbTranslations - index);
+	skipSize += 2 * (nbTranslations - index - 1);
 
 	// Seek to start of block we want to read
 	in.seek(skipSize, SEEK_CUR);
@@ -384,22 +398,13 @@ void TranslationManager::loadLanguageDat(int index) {
 	in.read(buf, len);
 	_currentCharset = String(buf, len - 1);
 
-	// Read messages
+	// Read messages. All their strings go into one buffer, which the block
+	// size is enough for.
+	_currentTranslationData.reserve(blockSize);
 	for (int i = 0; i < nbMessages; ++i) {
 		_currentTranslationMessages[i].msgid = in.readUint16BE();
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
-		}
-		_currentTranslationMessages[i].msgstr = msg;
-		len = in.readUint16BE();
-		if (len > 0) {
-			in.read(buf, len);
-			_currentTranslationMessages[i].msgctxt = String(buf, len - 1);
-		}
+		_currentTranslationMessages[i].msgstr = readString(in, _currentTranslationData);
+		_currentTranslationMessages[i].msgctxt = readString(in, _currentTranslationData);
 	}
 
 	// Find the charset
@@ -52,10 +52,14 @@ bool operator<(const TLanguage &l, const TLanguage &r);
 
 typedef Array<TLanguage> TLangArray;
 
+/**
+ * A translated message. The strings are offsets into the data of the current
+ * language, so each message does not need allocations of its own.
+ */
 struct PoMessageEntry {
 	int msgid;
-	String msgctxt;
-	String msgstr;
+	uint32 msgctxt;
+	uint32 msgstr;
 };
 
 /**
@@ -214,11 +218,20 @@ private:
 	 */
 	bool checkHeader(File &in);
 
+	/**
+	 * Append the string at the current position of the given file to data.
+	 *
+	 * @return the offset of the string in data
+	 */
+	static uint32 readString(File &in, Array<char> &data);
+
 	StringArray _langs;
 	StringArray _langNames;
 	StringArray _charmaps;
 
-	StringArray _messageIds;
+	Array<char> _messageIdData;
+	Array<uint32> _messageIds;	///< Offsets into _messageIdData
+	Array<char> _currentTranslationData;
 	Array<PoMessageEntry> _currentTranslationMessages;
 	String _currentCharset;
 	int _currentLang;
@@ -105,7 +105,9 @@ typedef struct {
 
 #include "common/fs.h"
 #include "common/unzip.h"
-#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
+#include "common/zlib.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -382,6 +384,7 @@ typedef Common::HashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_H
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _streamRef;	/* owns _stream, shared with member streams */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -544,6 +547,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	int err=UNZ_OK;
 
 	us->_stream = stream;
+	us->_streamRef = Common::SharedPtr<Common::SeekableReadStream>(stream);
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos==0)
@@ -595,7 +599,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		err=UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -644,7 +647,6 @@ int unzClose(unzFile file) {
 	if (s->pfile_in_zip_read != nullptr)
 		unzCloseCurrentFile(file);
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -1453,6 +1455,18 @@ public:
 };
 */
 
+/**
+ * The bytes of one member inside the archive file. It shares ownership of the
+ * archive file, so it stays valid after the ZipArchive itself is destroyed.
+ */
+class ZipMemberReadStream : public SafeSeekableSubReadStream {
+	SharedPtr<SeekableReadStream> _archiveStream;
+
+public:
+	ZipMemberReadStream(const SharedPtr<SeekableReadStream> &archiveStream, uint32 begin, uint32 end) :
+		SafeSeekableSubReadStream(archiveStream.get(), begin, end), _archiveStream(archiveStream) {}
+};
+
 ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
 	assert(_zipFile);
 }
@@ -1490,31 +1504,25 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 		return nullptr;
 
 	unz_file_info fileInfo;
-	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
-		return nullptr;
-
 	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
 		return nullptr;
 
-	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
-	assert(buffer);
-
-	if (unzReadCurrentFile(_zipFile, buffer, fileInfo.uncompressed_size) != (int)fileInfo.uncompressed_size) {
-		free(buffer);
-		return nullptr;
-	}
-
-	if (unzCloseCurrentFile(_zipFile) != UNZ_OK) {
-		free(buffer);
+	// Opening the member checks its local header and tells where its data starts
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	if (unzOpenCurrentFile(_zipFile) != UNZ_OK) {
+		unzCloseCurrentFile(_zipFile);
 		return nullptr;
 	}
+	const uint32 begin = archive->pfile_in_zip_read->pos_in_zipfile + archive->pfile_in_zip_read->byte_before_the_zipfile;
+	unzCloseCurrentFile(_zipFile);
 
-	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
+	// Members are read straight from the archive file, stored ones without
+	// any copying and deflated ones decompressed as they are read.
+	SeekableReadStream *data = new ZipMemberReadStream(archive->_streamRef, begin, begin + fileInfo.compressed_size);
+	if (fileInfo.compression_method == 0)
+		return data;
 
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
+	return wrapDeflateReadStream(data, fileInfo.uncompressed_size);
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -34,6 +34,7 @@ XMLParser::~XMLParser() {
 
 	delete _XMLkeys;
 	delete _stream;
+	freeText();
 
 	for (List<XMLKeyLayout *>::iterator i = _layoutList.begin();
 		i != _layoutList.end(); ++i)
@@ -75,58 +76,50 @@ bool XMLParser::loadStream(SeekableReadStream *stream) {
 void XMLParser::close() {
 	delete _stream;
 	_stream = nullptr;
+	freeText();
+}
+
+void XMLParser::freeText() {
+	free(_textBuffer);
+	_textBuffer = nullptr;
+	_text = _textPos = _textEnd = nullptr;
 }
 
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
-	const int startPosition = _stream->pos();
-	int currentPosition = startPosition;
+	const int startPosition = _textPos - _text;
 	int lineCount = 1;
-	char c = 0;
-
-	_stream->seek(0, SEEK_SET);
-
-	while (currentPosition--) {
-		c = _stream->readByte();
 
-		if (c == '\n' || c == '\r')
+	for (int i = 0; i < startPosition; i++) {
+		if (_text[i] == '\n' || _text[i] == '\r')
 			lineCount++;
 	}
 
-	assert(_stream->pos() == startPosition);
-	currentPosition = startPosition;
-
 	Common::String errorMessage = Common::String::format("\n  File <%s>, line %d:\n", _fileName.c_str(), lineCount);
 
 	if (startPosition > 1) {
 		int keyOpening = 0;
 		int keyClosing = 0;
 
-		while (currentPosition-- && keyOpening == 0) {
-			_stream->seek(-2, SEEK_CUR);
-			c = _stream->readByte();
-
-			if (c == '<')
-				keyOpening = currentPosition - 1;
-			else if (c == '>')
-				keyClosing = currentPosition;
+		// Find the start of the key the error is in...
+		for (int i = startPosition - 2; i >= 0; i--) {
+			if (_text[i] == '<') {
+				keyOpening = i;
+				break;
+			} else if (_text[i] == '>') {
+				keyClosing = i + 1;
+			}
 		}
 
-		_stream->seek(startPosition, SEEK_SET);
-		currentPosition = startPosition;
-		while (keyClosing == 0 && c && currentPosition++) {
-			c = _stream->readByte();
-
-			if (c == '>')
-				keyClosing = currentPosition;
+		// ...and its end, if it is not before the error
+		for (int i = startPosition - 1; keyClosing == 0 && i < _textEnd - _text && _text[i]; i++) {
+			if (_text[i] == '>')
+				keyClosing = i + 1;
 		}
 
-		currentPosition = (keyClosing - keyOpening);
-		_stream->seek(keyOpening, SEEK_SET);
-
-		while (currentPosition--)
-			errorMessage += (char)_stream->readByte();
+		if (keyClosing > keyOpening)
+			errorMessage += String(_text + keyOpening, _text + keyClosing);
 	}
 
 	errorMessage += "\n\nParser error: ";
@@ -166,16 +159,17 @@ bool XMLParser::parseActiveKey(bool closed) {
 
 	XMLKeyLayout *layout = (_activeKey.size() == 1) ? _XMLkeys : getParentNode(key)->layout;
 
-	if (layout->children.contains(key->name)) {
-		key->layout = layout->children[key->name];
+	ChildMap::const_iterator child = layout->children.find(key->name);
+	if (child != layout->children.end()) {
+		key->layout = child->_value;
 
-		StringMap localMap = key->values;
-		int keyCount = localMap.size();
+		int keyCount = key->values.size();
 
 		for (List<XMLKeyLayout::XMLKeyProperty>::const_iterator i = key->layout->properties.begin(); i != key->layout->properties.end(); ++i) {
-			if (i->required && !localMap.contains(i->name))
-				return parserError("Missing required property '" + i->name + "' inside key '" + key->name + "'");
-			else if (localMap.contains(i->name))
+			const bool present = key->values.contains(i->name);
+			if (i->required && !present)
+				return parserError("Missing required property '" + i->name.toString() + "' inside key '" + key->name + "'");
+			else if (present)
 				keyCount--;
 		}
 
@@ -209,34 +203,32 @@ bool XMLParser::parseActiveKey(bool closed) {
 	return true;
 }
 
-bool XMLParser::parseKeyValue(String keyName) {
+bool XMLParser::parseKeyValue(const String &keyName) {
 	assert(_activeKey.empty() == false);
 
-	if (_activeKey.top()->values.contains(keyName))
+	const InternedString name(keyName);
+	if (_activeKey.top()->values.contains(name))
 		return false;
 
-	_token.clear();
-	char stringStart;
-
 	if (_char == '"' || _char == '\'') {
-		stringStart = _char;
-		_char = _stream->readByte();
+		const char stringStart = _char;
+		const char *start = _textPos;
+		_char = nextChar();
 
-		while (_char && _char != stringStart) {
-			_token += _char;
-			_char = _stream->readByte();
-		}
+		while (_char && _char != stringStart)
+			_char = nextChar();
 
 		if (_char == 0)
 			return false;
 
-		_char = _stream->readByte();
+		_token = String(start, _textPos - 1);
+		_char = nextChar();
 
 	} else if (!parseToken()) {
 		return false;
 	}
 
-	_activeKey.top()->values[keyName] = _token;
+	_activeKey.top()->values.add(name, _token);
 	return true;
 }
 
@@ -302,8 +294,19 @@ bool XMLParser::parse() {
 	if (_stream == nullptr)
 		return false;
 
-	// Make sure we are at the start of the stream.
-	_stream->seek(0, SEEK_SET);
+	// Parse straight from memory. Streams which have no buffer of their
+	// own are read in one go.
+	freeText();
+	const byte *data = _stream->getDataPointer();
+	uint32 size = _stream->size();
+	if (!data) {
+		_stream->seek(0, SEEK_SET);
+		_textBuffer = (byte *)malloc(MAX<uint32>(size, 1));
+		size = _stream->read(_textBuffer, size);
+		data = _textBuffer;
+	}
+	_text = _textPos = (const char *)data;
+	_textEnd = _text + size;
 
 	if (_XMLkeys == nullptr)
 		buildLayout();
@@ -320,7 +323,7 @@ bool XMLParser::parse() {
 	_state = kParserNeedHeader;
 	_activeKey.clear();
 
-	_char = _stream->readByte();
+	_char = nextChar();
 
 	while (_char && _state != kParserError) {
 		if (skipSpaces())
@@ -337,7 +340,7 @@ bool XMLParser::parse() {
 				break;
 			}
 
-			if ((_char = _stream->readByte()) == 0) {
+			if ((_char = nextChar()) == 0) {
 				parserError("Unexpected end of file.");
 				break;
 			}
@@ -348,10 +351,10 @@ bool XMLParser::parse() {
 					break;
 				}
 
-				_char = _stream->readByte();
+				_char = nextChar();
 				activeHeader = true;
 			} else if (_char == '/') {
-				_char = _stream->readByte();
+				_char = nextChar();
 				activeClosure = true;
 			} else if (_char == '?') {
 				parserError("Unexpected header. There may only be one XML header per file.");
@@ -399,7 +402,7 @@ bool XMLParser::parse() {
 				else
 					_state = kParserNeedKey;
 
-				_char = _stream->readByte();
+				_char = nextChar();
 				break;
 			}
 
@@ -407,14 +410,14 @@ bool XMLParser::parse() {
 
 			if (_char == '/' || (_char == '?' && activeHeader)) {
 				selfClosure = true;
-				_char = _stream->readByte();
+				_char = nextChar();
 			}
 
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
 				} else if (parseActiveKey(selfClosure)) {
-					_char = _stream->readByte();
+					_char = nextChar();
 					_state = kParserNeedKey;
 				}
 
@@ -437,7 +440,7 @@ bool XMLParser::parse() {
 			else
 				_state = kParserNeedPropertyValue;
 
-			_char = _stream->readByte();
+			_char = nextChar();
 			break;
 
 		case kParserNeedPropertyValue:
@@ -467,39 +470,36 @@ bool XMLParser::skipSpaces() {
 		return false;
 
 	while (_char && isSpace(_char))
-		_char = _stream->readByte();
+		_char = nextChar();
 
 	return true;
 }
 
 bool XMLParser::skipComments() {
 	if (_char == '<') {
-		_char = _stream->readByte();
-
-		if (_char != '!') {
-			_stream->seek(-1, SEEK_CUR);
-			_char = '<';
+		if (_textPos == _textEnd || *_textPos != '!')
 			return false;
-		}
 
-		if (_stream->readByte() != '-' || _stream->readByte() != '-')
+		_textPos++;
+
+		if (nextChar() != '-' || nextChar() != '-')
 			return parserError("Malformed comment syntax.");
 
-		_char = _stream->readByte();
+		_char = nextChar();
 
 		while (_char) {
 			if (_char == '-') {
-				if (_stream->readByte() == '-') {
+				if (nextChar() == '-') {
 
-					if (_stream->readByte() != '>')
+					if (nextChar() != '>')
 						return parserError("Malformed comment (double-hyphen inside comment body).");
 
-					_char = _stream->readByte();
+					_char = nextChar();
 					return true;
 				}
 			}
 
-			_char = _stream->readByte();
+			_char = nextChar();
 		}
 
 		return parserError("Comment has no closure.");
@@ -511,12 +511,54 @@ bool XMLParser::skipComments() {
 bool XMLParser::parseToken() {
 	_token.clear();
 
-	while (isValidNameChar(_char)) {
-		_token += _char;
-		_char = _stream->readByte();
+	if (isValidNameChar(_char)) {
+		// The current character has already been read from the text
+		const char *start = _textPos - 1;
+		const char *end;
+
+		do {
+			end = _textPos;
+			_char = nextChar();
+		} while (isValidNameChar(_char));
+
+		_token = String(start, end);
 	}
 
 	return isSpace(_char) != 0 || _char == '>' || _char == '=' || _char == '/';
 }
 
+String &XMLParser::PropertyMap::operator[](const String &name) {
+	const String *value = find(name);
+	if (value)
+		return *const_cast<String *>(value);
+
+	add(InternedString(name), String());
+	return _properties.back().value;
+}
+
+void XMLParser::PropertyMap::add(const InternedString &name, const String &value) {
+	assert(!contains(name));
+
+	Property property;
+	property.name = name;
+	property.value = value;
+	_properties.push_back(property);
+}
+
+const String *XMLParser::PropertyMap::find(const String &name) const {
+	for (const_iterator i = _properties.begin(); i != _properties.end(); ++i) {
+		if (i->name.toString() == name)
+			return &i->value;
+	}
+	return nullptr;
+}
+
+const String *XMLParser::PropertyMap::find(const InternedString &name) const {
+	for (const_iterator i = _properties.begin(); i != _properties.end(); ++i) {
+		if (i->name == name)
+			return &i->value;
+	}
+	return nullptr;
+}
+
 } // End of namespace Common
@@ -26,10 +26,12 @@
 #include "common/scummsys.h"
 #include "common/types.h"
 
+#include "common/array.h"
 #include "common/fs.h"
 #include "common/list.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/internedstring.h"
 #include "common/stack.h"
 #include "common/memorypool.h"
 
@@ -55,7 +57,7 @@ class SeekableReadStream;
 #define KEY_END() layout.pop(); }
 
 #define XML_PROP(propName, req) {\
-		prop.name = #propName; \
+		prop.name = Common::InternedString(#propName); \
 		prop.required = req; \
 		layout.top()->properties.push_back(prop); }
 
@@ -92,7 +94,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _text(nullptr), _textPos(nullptr), _textEnd(nullptr), _textBuffer(nullptr) {}
 
 	virtual ~XMLParser();
 
@@ -117,7 +119,7 @@ public:
 	/** nested struct representing the layout of the XML file */
 	struct XMLKeyLayout {
 		struct XMLKeyProperty {
-			String name;
+			InternedString name;
 			bool required;
 		};
 
@@ -133,10 +135,50 @@ public:
 
 	XMLKeyLayout *_XMLkeys;
 
+	/**
+	 * The properties of a parsed node. A key only has a handful of them,
+	 * so they are kept in a flat array with interned names, which is
+	 * cheaper to fill and to search than a hash map per node.
+	 */
+	class PropertyMap {
+	public:
+		struct Property {
+			InternedString name;
+			String value;
+		};
+
+		typedef Array<Property>::const_iterator const_iterator;
+
+		bool contains(const String &name) const { return find(name) != nullptr; }
+		bool contains(const InternedString &name) const { return find(name) != nullptr; }
+
+		/**
+		 * Return the value of a property. Like HashMap, this adds the
+		 * property with an empty value if it is missing.
+		 */
+		String &operator[](const String &name);
+
+		/** Add a property which is not in the map yet. */
+		void add(const InternedString &name, const String &value);
+
+		uint size() const { return _properties.size(); }
+		bool empty() const { return _properties.empty(); }
+		void clear() { _properties.clear(); }
+
+		const_iterator begin() const { return _properties.begin(); }
+		const_iterator end() const { return _properties.end(); }
+
+	private:
+		const String *find(const String &name) const;
+		const String *find(const InternedString &name) const;
+
+		Array<Property> _properties;
+	};
+
 	/** Struct representing a parsed node */
 	struct ParserNode {
 		String name;
-		StringMap values;
+		PropertyMap values;
 		bool ignore;
 		bool header;
 		int depth;
@@ -262,7 +304,7 @@ protected:
 	/**
 	 * Parses the value of a given key. There's no reason to overload this.
 	 */
-	bool parseKeyValue(String keyName);
+	bool parseKeyValue(const String &keyName);
 
 	/**
 	 * Called once a key has been parsed. It handles the closing/cleanup of the
@@ -337,10 +379,27 @@ protected:
 	List<XMLKeyLayout *> _layoutList;
 
 private:
+	/** Returns the next character of the text, or 0 at its end. */
+	char nextChar() {
+		return _textPos < _textEnd ? *_textPos++ : 0;
+	}
+
+	/** Frees the copy of the stream made by parse(), if any. */
+	void freeText();
+
 	char _char;
 	SeekableReadStream *_stream;
 	String _fileName;
 
+	/**
+	 * The text being parsed. This is the stream's own buffer if it has
+	 * one, or else a copy of the whole stream in _textBuffer.
+	 */
+	const char *_text;
+	const char *_textPos;
+	const char *_textEnd;
+	byte *_textBuffer;
+
 	ParserState _state; /** Internal state of the parser */
 
 	String _error; /** Current error message */
@@ -24,6 +24,8 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/lz4.h"
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -411,10 +413,365 @@ public:
 	virtual int32 pos() const { return _pos; }
 };
 
+/**
+ * A wrapper around a raw deflate stream of known uncompressed size, as found
+ * in ZIP archives. Unlike GZipReadStream, it keeps a copy of the inflate state
+ * every so often, so seeking backward only has to decompress from the nearest
+ * checkpoint instead of from the start of the data.
+ */
+class DeflateReadStream : public SeekableReadStream {
+protected:
+	enum {
+		BUFSIZE = 16384,
+		kMinCheckpointInterval = 1024 * 1024,
+		kMaxCheckpoints = 32
+	};
+
+	struct Checkpoint {
+		uint32 outPos;
+		uint32 inPos;
+		z_stream state;
+	};
+
+	byte	_buf[BUFSIZE];
+
+	ScopedPtr<SeekableReadStream> _wrapped;
+	z_stream _stream;
+	int _zlibErr;
+	uint32 _pos;
+	uint32 _size;
+	bool _eos;
+
+	uint32 _checkpointInterval;
+	Array<Checkpoint *> _checkpoints;
+
+	// The last checkpoint at or before the given position, if any
+	Checkpoint *findCheckpoint(uint32 target) const {
+		Checkpoint *found = nullptr;
+		for (uint i = 0; i < _checkpoints.size() && _checkpoints[i]->outPos <= target; ++i)
+			found = _checkpoints[i];
+		return found;
+	}
+
+	void saveCheckpoint() {
+		Checkpoint *checkpoint = new Checkpoint();
+		if (inflateCopy(&checkpoint->state, &_stream) != Z_OK) {
+			delete checkpoint;
+			return;
+		}
+
+		checkpoint->outPos = _pos;
+		// Input still in the buffer has not been consumed by inflate yet
+		checkpoint->inPos = _wrapped->pos() - _stream.avail_in;
+		_checkpoints.push_back(checkpoint);
+	}
+
+	void restart(Checkpoint *checkpoint) {
+		if (checkpoint) {
+			inflateEnd(&_stream);
+			_zlibErr = inflateCopy(&_stream, &checkpoint->state);
+			_pos = checkpoint->outPos;
+			_wrapped->seek(checkpoint->inPos, SEEK_SET);
+		} else {
+			_zlibErr = inflateReset(&_stream);
+			_pos = 0;
+			_wrapped->seek(0, SEEK_SET);
+		}
+
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+	}
+
+	uint32 inflateChunk(byte *dst, uint32 dataSize) {
+		_stream.next_out = dst;
+		_stream.avail_out = dataSize;
+
+		// Keep going while we get no error
+		while (_zlibErr == Z_OK && _stream.avail_out) {
+			if (_stream.avail_in == 0 && !_wrapped->eos()) {
+				// If we are out of input data: Read more data, if available.
+				_stream.next_in = _buf;
+				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
+			}
+			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+		}
+
+		return dataSize - _stream.avail_out;
+	}
+
+public:
+	DeflateReadStream(SeekableReadStream *w, uint32 size) : _wrapped(w), _stream(), _pos(0), _size(size), _eos(false) {
+		assert(w != nullptr);
+
+		_checkpointInterval = MAX<uint32>(kMinCheckpointInterval, _size / kMaxCheckpoints);
+
+		w->seek(0, SEEK_SET);
+
+		// Negative windowBits tell zlib there is no header
+		_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+		if (_zlibErr != Z_OK)
+			return;
+
+		// Setup input buffer
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+	}
+
+	~DeflateReadStream() {
+		inflateEnd(&_stream);
+		for (uint i = 0; i < _checkpoints.size(); ++i) {
+			inflateEnd(&_checkpoints[i]->state);
+			delete _checkpoints[i];
+		}
+	}
+
+	bool err() const { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
+	void clearErr() {
+		// only reset _eos; I/O errors are not recoverable
+		_eos = false;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		if (dataSize > _size - _pos) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+		while (total < dataSize && _zlibErr == Z_OK) {
+			// Stop exactly at the next checkpoint so it can be taken
+			uint32 next = (_checkpoints.empty() ? 0 : _checkpoints.back()->outPos) + _checkpointInterval;
+			uint32 chunk = dataSize - total;
+			if (_pos < next && chunk > next - _pos)
+				chunk = next - _pos;
+
+			uint32 decompressed = inflateChunk(dst + total, chunk);
+			total += decompressed;
+			_pos += decompressed;
+
+			if (_pos == next && _pos < _size)
+				saveCheckpoint();
+			if (decompressed < chunk)
+				break;
+		}
+
+		if (total < dataSize)
+			_eos = true;
+		return total;
+	}
+
+	bool eos() const {
+		return _eos;
+	}
+	int32 pos() const {
+		return _pos;
+	}
+	int32 size() const {
+		return _size;
+	}
+	bool seek(int32 offset, int whence = SEEK_SET) {
+		int32 newPos = 0;
+		switch (whence) {
+		case SEEK_SET:
+			newPos = offset;
+			break;
+		case SEEK_CUR:
+			newPos = _pos + offset;
+			break;
+		case SEEK_END:
+			newPos = _size + offset;
+			break;
+		}
+
+		if (newPos < 0 || (uint32)newPos > _size)
+			return false;
+
+		// Jump to a checkpoint when going backward, or when one is closer
+		// than the current position
+		Checkpoint *checkpoint = findCheckpoint(newPos);
+		if ((uint32)newPos < _pos || (checkpoint && checkpoint->outPos > _pos))
+			restart(checkpoint);
+
+		byte tmpBuf[4096];
+		while (!err() && _pos < (uint32)newPos) {
+			if (read(tmpBuf, MIN<uint32>(sizeof(tmpBuf), newPos - _pos)) == 0)
+				break;
+		}
+
+		_eos = false;
+		return _pos == (uint32)newPos;
+	}
+};
+
+/**
+ * A stream over InstallShield cabinet data made of independently deflated
+ * chunks, each preceded by its 16-bit length. Only one chunk is held
+ * decompressed at a time. The starts of all chunks seen so far are kept, so
+ * seeking anywhere already visited only needs that single chunk inflated.
+ */
+class InstallShieldReadStream : public SeekableReadStream {
+protected:
+	struct Chunk {
+		uint32 inPos;
+		uint32 outPos;
+	};
+
+	byte _in[0xFFFF];
+	byte _out[kTempBufSize];
+
+	ScopedPtr<SeekableReadStream> _wrapped;
+	uint32 _pos;
+	uint32 _size;
+	bool _eos;
+	bool _err;
+
+	Array<Chunk> _chunks;
+	int _current;
+	uint32 _outSize;
+
+	// The last known chunk starting at or before the given position
+	uint findChunk(uint32 target) const {
+		uint lo = 0, hi = _chunks.size();
+		while (hi - lo > 1) {
+			uint mid = (lo + hi) / 2;
+			if (_chunks[mid].outPos <= target)
+				lo = mid;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	bool inflateChunk(uint index) {
+		const Chunk &chunk = _chunks[index];
+		if (chunk.inPos + 2 > (uint32)_wrapped->size())
+			return false;
+
+		_wrapped->seek(chunk.inPos, SEEK_SET);
+		uint16 chunkSize = _wrapped->readUint16LE();
+		if (_wrapped->read(_in, chunkSize) != chunkSize) {
+			_err = true;
+			return false;
+		}
+
+		z_stream stream;
+		stream.next_in = _in;
+		stream.avail_in = chunkSize;
+		stream.next_out = _out;
+		stream.avail_out = kTempBufSize;
+		stream.zalloc = Z_NULL;
+		stream.zfree = Z_NULL;
+		stream.opaque = Z_NULL;
+
+		// Negative MAX_WBITS tells zlib there's no zlib header
+		int err = inflateInit2(&stream, -MAX_WBITS);
+		if (err == Z_OK)
+			err = inflate(&stream, Z_FINISH);
+		inflateEnd(&stream);
+		if (err != Z_OK && err != Z_STREAM_END) {
+			_err = true;
+			return false;
+		}
+
+		_current = index;
+		_outSize = stream.total_out;
+
+		if (index + 1 == _chunks.size()) {
+			Chunk next;
+			next.inPos = chunk.inPos + 2 + chunkSize;
+			next.outPos = chunk.outPos + _outSize;
+			_chunks.push_back(next);
+		}
+		return true;
+	}
+
+public:
+	InstallShieldReadStream(SeekableReadStream *w, uint32 size) : _wrapped(w), _pos(0), _size(size), _eos(false), _err(false), _current(-1), _outSize(0) {
+		assert(w != nullptr);
+
+		Chunk first;
+		first.inPos = 0;
+		first.outPos = 0;
+		_chunks.push_back(first);
+	}
+
+	bool err() const { return _err; }
+	void clearErr() {
+		// only reset _eos; I/O errors are not recoverable
+		_eos = false;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		if (dataSize > _size - _pos) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+		while (total < dataSize) {
+			uint index = findChunk(_pos);
+			if (_current != (int)index && !inflateChunk(index))
+				break;
+
+			const uint32 chunkStart = _chunks[index].outPos;
+			if (_pos >= chunkStart + _outSize) {
+				// Further ahead; inflating this chunk located the next one
+				continue;
+			}
+
+			uint32 count = MIN(dataSize - total, chunkStart + _outSize - _pos);
+			memcpy(dst + total, _out + (_pos - chunkStart), count);
+			total += count;
+			_pos += count;
+		}
+
+		if (total < dataSize)
+			_eos = true;
+		return total;
+	}
+
+	bool eos() const {
+		return _eos;
+	}
+	int32 pos() const {
+		return _pos;
+	}
+	int32 size() const {
+		return _size;
+	}
+	bool seek(int32 offset, int whence = SEEK_SET) {
+		int32 newPos = 0;
+		switch (whence) {
+		case SEEK_SET:
+			newPos = offset;
+			break;
+		case SEEK_CUR:
+			newPos = _pos + offset;
+			break;
+		case SEEK_END:
+			newPos = _size + offset;
+			break;
+		}
+
+		if (newPos < 0 || (uint32)newPos > _size)
+			return false;
+
+		// Chunks are only inflated once they are read from
+		_pos = newPos;
+		_eos = false;
+		return true;
+	}
+};
+
 #endif	// USE_ZLIB
 
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize) {
 	if (toBeWrapped) {
+		if (isLZ4Stream(*toBeWrapped))
+			return wrapLZ4ReadStream(toBeWrapped);
+
 		uint16 header = toBeWrapped->readUint16BE();
 		bool isCompressed = (header == 0x1F8B ||
 				     ((header & 0x0F00) == 0x0800 &&
@@ -432,7 +789,42 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 	return toBeWrapped;
 }
 
-WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 uncompressedSize) {
+	if (!toBeWrapped)
+		return nullptr;
+
+#if defined(USE_ZLIB)
+	return new DeflateReadStream(toBeWrapped, uncompressedSize);
+#else
+	delete toBeWrapped;
+	return nullptr;
+#endif
+}
+
+SeekableReadStream *wrapInstallShieldReadStream(SeekableReadStream *toBeWrapped, uint32 uncompressedSize) {
+	if (!toBeWrapped)
+		return nullptr;
+
+#if defined(USE_ZLIB)
+	// With sync bytes at the end, the data is a single deflate stream
+	uint32 syncBytes = 0;
+	if (toBeWrapped->size() >= 4 && toBeWrapped->seek(-4, SEEK_END))
+		syncBytes = toBeWrapped->readUint32BE();
+	toBeWrapped->seek(0, SEEK_SET);
+
+	if (syncBytes == 0xFFFF)
+		return new DeflateReadStream(toBeWrapped, uncompressedSize);
+	return new InstallShieldReadStream(toBeWrapped, uncompressedSize);
+#else
+	delete toBeWrapped;
+	return nullptr;
+#endif
+}
+
+WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped, CompressionMethod method) {
+	if (method == kCompressionLZ4)
+		return wrapLZ4WriteStream(toBeWrapped);
+
 #if defined(USE_ZLIB)
 	if (toBeWrapped)
 		return new GZipWriteStream(toBeWrapped);
@@ -98,14 +98,23 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
 
 #endif
 
+/**
+ * The formats wrapCompressedWriteStream() can write. Both are recognized
+ * by wrapCompressedReadStream().
+ */
+enum CompressionMethod {
+	kCompressionGZip,	///< gzip; the default and the most compact
+	kCompressionLZ4		///< LZ4 blocks; several times faster, but larger
+};
+
 /**
  * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
  * provides transparent on-the-fly decompression. Assumes the data it
- * retrieves from the wrapped stream to be either uncompressed or in gzip
- * format. In the former case, the original stream is returned unmodified
- * (and in particular, not wrapped). In the latter case the stream is
- * returned wrapped, unless there is no ZLIB support, then NULL is returned
- * and the old stream is destroyed.
+ * retrieves from the wrapped stream to be either uncompressed, in gzip
+ * format or written by wrapLZ4WriteStream(). In the first case, the original
+ * stream is returned unmodified (and in particular, not wrapped). Otherwise
+ * the stream is returned wrapped, unless there is no ZLIB support for gzip
+ * data, then NULL is returned and the old stream is destroyed.
  *
  * Certain GZip-formats don't supply an easily readable length, if you
  * still need the length carried along with the stream, and you know
@@ -121,17 +130,47 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
  */
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize = 0);
 
+/**
+ * Take an arbitrary SeekableReadStream holding raw deflate data (without a
+ * zlib or gzip header, as stored in ZIP archives) and wrap it in a stream
+ * which decompresses it on the fly. Seeking is supported, and backward seeks
+ * resume from periodically saved decompressor states rather than from the
+ * start of the data.
+ * The created stream also becomes responsible for freeing the passed stream.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned). Without ZLIB support NULL is returned and the stream is destroyed.
+ *
+ * @param toBeWrapped		the stream holding the deflate data
+ * @param uncompressedSize	the size of the data after decompression
+ */
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 uncompressedSize);
+
+/**
+ * Take an arbitrary SeekableReadStream holding one compressed InstallShield
+ * cabinet member, and wrap it in a stream which decompresses it on the fly,
+ * in the same formats as inflateZlibInstallShield() handles.
+ * The created stream also becomes responsible for freeing the passed stream.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned). Without ZLIB support NULL is returned and the stream is destroyed.
+ *
+ * @param toBeWrapped		the stream holding the compressed member
+ * @param uncompressedSize	the size of the member after decompression
+ */
+SeekableReadStream *wrapInstallShieldReadStream(SeekableReadStream *toBeWrapped, uint32 uncompressedSize);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which provides
  * transparent on-the-fly compression. The compressed data is written in the
- * gzip format, unless ZLIB support has been disabled, in which case the given
+ * given format. For gzip, if ZLIB support has been disabled, the given
  * stream is returned unmodified (and in particular, not wrapped).
  * The created stream also becomes responsible for freeing the passed stream.
  *
  * It is safe to call this with a NULL parameter (in this case, NULL is
  * returned).
  */
-WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped);
+WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped, CompressionMethod method = kCompressionGZip);
 
 } // End of namespace Common
 
@@ -26,6 +26,9 @@
 #include "common/macresman.h"
 #include "common/md5.h"
 #include "common/config-manager.h"
+#include "common/fs.h"
+#include "common/singleton.h"
+#include "common/str-array.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -33,6 +36,183 @@
 #include "engines/advancedDetector.h"
 #include "engines/obsolete.h"
 
+namespace {
+
+/**
+ * File sizes and MD5s computed by detection, kept in a file next to the
+ * config file. Entries are keyed by the number of bytes hashed and the path
+ * of the file, and only used while the file's size and modification time
+ * match. Entries for files which are gone are dropped once per run.
+ */
+class DetectionMD5Cache : public Common::Singleton<DetectionMD5Cache> {
+public:
+	DetectionMD5Cache() : _loaded(false), _dirty(false), _pruned(false), _lastSave(0) {}
+
+	bool lookup(const Common::String &key, uint32 mtime, int32 size, Common::String &md5) {
+		load();
+
+		EntryMap::iterator it = _entries.find(key);
+		if (it == _entries.end() || it->_value.mtime != mtime || it->_value.size != size)
+			return false;
+
+		it->_value.seen = true;
+		md5 = it->_value.md5;
+		return true;
+	}
+
+	void store(const Common::String &key, uint32 mtime, int32 size, const Common::String &md5) {
+		// Keys are written as the last field of a line
+		if (key.contains('\n') || key.contains('\r'))
+			return;
+
+		load();
+
+		Entry &entry = _entries[key];
+		entry.mtime = mtime;
+		entry.size = size;
+		entry.md5 = md5;
+		entry.seen = true;
+		_dirty = true;
+	}
+
+	void save(bool force) {
+		if (!_dirty)
+			return;
+
+		uint32 now = g_system->getMillis();
+		if (!force && _lastSave && now - _lastSave < kSaveInterval)
+			return;
+		_lastSave = now;
+
+		Common::FSNode node = getFileNode();
+		if (!node.getParent().isDirectory())
+			return;
+
+		prune();
+
+		Common::WriteStream *file = node.createWriteStream();
+		if (!file)
+			return;
+
+		file->writeString(kHeader);
+		file->writeByte('\n');
+		for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+			file->writeString(Common::String::format("%u\t%d\t%s\t%s\n", it->_value.mtime,
+				it->_value.size, it->_value.md5.c_str(), it->_key.c_str()));
+		}
+
+		file->finalize();
+		if (file->err())
+			warning("Could not write the detection cache '%s'", node.getPath().c_str());
+		else
+			_dirty = false;
+		delete file;
+	}
+
+private:
+	static const char *const kFileName;
+	static const char *const kHeader;
+
+	enum {
+		kSaveInterval = 10 * 1000
+	};
+
+	struct Entry {
+		uint32 mtime;
+		int32 size;
+		Common::String md5;
+		// Whether detection used the entry during this run
+		bool seen;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+	bool _pruned;
+	uint32 _lastSave;
+
+	/**
+	 * The cache is not a savefile, so it is kept out of the save path,
+	 * which may be synced to the cloud.
+	 */
+	static Common::FSNode getFileNode() {
+		Common::FSNode configFile(g_system->getDefaultConfigFileName());
+		return configFile.getParent().getChild(kFileName);
+	}
+
+	/** Drop the entries of files which are gone, once per run. */
+	void prune() {
+		if (_pruned)
+			return;
+		_pruned = true;
+
+		Common::StringArray gone;
+		for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+			if (it->_value.seen)
+				continue;
+
+			const char *path = strchr(it->_key.c_str(), '\t');
+			if (!path || !Common::FSNode(path + 1).exists())
+				gone.push_back(it->_key);
+		}
+
+		for (uint i = 0; i < gone.size(); i++)
+			_entries.erase(gone[i]);
+	}
+
+	void load() {
+		// Detection from the command line runs before the backend is set up
+		if (_loaded || !g_system->getSavefileManager())
+			return;
+		_loaded = true;
+
+		Common::FSNode node = getFileNode();
+		if (!node.exists())
+			return;
+
+		Common::SeekableReadStream *file = node.createReadStream();
+		if (!file)
+			return;
+
+		if (file->readLine() == kHeader) {
+			while (!file->eos() && !file->err()) {
+				Common::String line = file->readLine();
+
+				// mtime, size and MD5, followed by the key
+				Entry entry;
+				char *end;
+				entry.mtime = (uint32)strtoul(line.c_str(), &end, 10);
+				if (*end != '\t')
+					continue;
+				entry.size = (int32)strtol(end + 1, &end, 10);
+				if (*end != '\t')
+					continue;
+				const char *md5 = end + 1;
+				const char *key = strchr(md5, '\t');
+				if (!key)
+					continue;
+				entry.md5 = Common::String(md5, key);
+				entry.seen = false;
+
+				_entries[key + 1] = entry;
+			}
+		}
+
+		delete file;
+	}
+};
+
+const char *const DetectionMD5Cache::kFileName = "detection-md5.cache";
+const char *const DetectionMD5Cache::kHeader = "ScummVM detection cache 1";
+
+} // End of anonymous namespace
+
+namespace Common {
+DECLARE_SINGLETON(DetectionMD5Cache);
+}
+
 static Common::String sanitizeName(const char *name) {
 	Common::String res;
 
@@ -381,10 +561,24 @@ bool AdvancedMetaEngine::getFileProperties(const Common::FSNode &parent, const F
 		return false;
 
 	fileProps.size = (int32)testFile.size();
+
+	// Hashing is the slow part when scanning large game libraries
+	const Common::FSNode &node = allFiles[fname];
+	const uint32 mtime = node.getModificationTime();
+	const Common::String key = Common::String::format("%u\t%s", _md5Bytes, node.getPath().c_str());
+	if (mtime && DetectionMD5Cache::instance().lookup(key, mtime, fileProps.size, fileProps.md5))
+		return true;
+
 	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+	if (mtime)
+		DetectionMD5Cache::instance().store(key, mtime, fileProps.size, fileProps.md5);
 	return true;
 }
 
+void AdvancedMetaEngine::saveMD5Cache(bool force) {
+	DetectionMD5Cache::instance().save(force);
+}
+
 ADDetectedGames AdvancedMetaEngine::detectGame(const Common::FSNode &parent, const FileMap &allFiles, Common::Language language, Common::Platform platform, const Common::String &extra) const {
 	FilePropertiesMap filesProps;
 	ADDetectedGames matched;
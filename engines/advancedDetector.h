@@ -275,6 +275,14 @@ public:
 
 	virtual const ExtraGuiOptions getExtraGuiOptions(const Common::String &target) const;
 
+	/**
+	 * Write the file sizes and MD5s computed by detection to the detection
+	 * cache, so they do not have to be computed again on the next run.
+	 * Unless forced, this is skipped if the cache was written a few seconds
+	 * ago, so scanning many directories does not rewrite it every time.
+	 */
+	static void saveMD5Cache(bool force = false);
+
 protected:
 	// To be implemented by subclasses
 	virtual bool createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const = 0;
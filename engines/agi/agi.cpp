@@ -497,6 +497,9 @@ void AgiEngine::initialize() {
 	setupOpCodes(getVersion());
 
 	debugC(2, kDebugLevelMain, "Init sound");
+
+	// The variables live in _game for the whole session
+	_system->setMemoryRegion(OSystem::kMemoryRegionGameVariables, _game.vars, sizeof(_game.vars));
 }
 
 bool AgiEngine::promptIsEnabled() {
@@ -514,6 +517,7 @@ void AgiEngine::redrawScreen() {
 }
 
 AgiEngine::~AgiEngine() {
+	_system->setMemoryRegion(OSystem::kMemoryRegionGameVariables, nullptr, 0);
 	agiDeinit();
 	delete _loader;
 	if (_gfx) {
@@ -170,6 +170,14 @@ public:
 
 	byte getColor(int16 x, int16 y);
 	byte getPriority(int16 x, int16 y);
+
+	// Direct access to the game and priority screens, for filling whole spans
+	byte *getGameScreen() {
+		return _gameScreen;
+	}
+	byte *getPriorityScreen() {
+		return _priorityScreen;
+	}
 	bool checkControlPixel(int16 x, int16 y, byte newPriority);
 
 	byte getCGAMixtureColor(byte color);
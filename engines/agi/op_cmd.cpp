@@ -2325,8 +2325,10 @@ int AgiEngine::runLogic(int16 logicNr) {
 	state->logic_list[0] = 0;
 	state->max_logics = 0;
 
-	debugC(2, kDebugLevelScripts, "=================");
-	debugC(2, kDebugLevelScripts, "runLogic(%d)", logicNr);
+	if (debugCEnabled(2, kDebugLevelScripts)) {
+		debugC(2, kDebugLevelScripts, "=================");
+		debugC(2, kDebugLevelScripts, "runLogic(%d)", logicNr);
+	}
 
 	sp.script = logicNr;
 	sp.curIP = 0;
@@ -2404,7 +2406,8 @@ int AgiEngine::runLogic(int16 logicNr) {
 			memmove(p, state->_curLogic->data + state->_curLogic->cIP, curParameterSize);
 			memset(p + curParameterSize, 0, CMD_BSIZE - curParameterSize);
 
-			debugC(2, kDebugLevelScripts, "%s%s(%d %d %d)", st, _opCodes[op].name, p[0], p[1], p[2]);
+			if (debugCEnabled(2, kDebugLevelScripts))
+				debugC(2, kDebugLevelScripts, "%s%s(%d %d %d)", st, _opCodes[op].name, p[0], p[1], p[2]);
 
 			if (!_opCodes[op].functionPtr) {
 				error("Illegal opcode %x in logic %d, ip %d", op, state->curLogicNr, state->_curLogic->cIP);
@@ -2432,7 +2435,8 @@ int AgiEngine::runLogic(int16 logicNr) {
 }
 
 void AgiEngine::executeAgiCommand(uint8 op, uint8 *p) {
-	debugC(2, kDebugLevelScripts, "%s(%d %d %d)", _opCodes[op].name, p[0], p[1], p[2]);
+	if (debugCEnabled(2, kDebugLevelScripts))
+		debugC(2, kDebugLevelScripts, "%s(%d %d %d)", _opCodes[op].name, p[0], p[1], p[2]);
 
 	_opCodes[op].functionPtr(&_game, this, p);
 }
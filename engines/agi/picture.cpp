@@ -838,6 +838,83 @@ void PictureMgr::draw_Fill(int16 x, int16 y) {
 	if (!_scrOn && !_priOn)
 		return;
 
+	if (_flags & kPicFTrollMode) {
+		draw_FillSlow(x, y);
+		return;
+	}
+
+	// Outside of troll mode, a pixel may be filled exactly when one of
+	// the screens still holds its cleared value there, and filling it
+	// changes that value. See draw_FillCheck().
+	const byte *checkScreen;
+	byte checkValue;
+	if (!_priOn && _scrOn && _scrColor != 15) {
+		checkScreen = _gfx->getGameScreen();
+		checkValue = 15;
+	} else if (_priOn && !_scrOn && _priColor != 4) {
+		checkScreen = _gfx->getPriorityScreen();
+		checkValue = 4;
+	} else if (_scrOn && _scrColor != 15) {
+		checkScreen = _gfx->getGameScreen();
+		checkValue = 15;
+	} else {
+		return;
+	}
+
+	if (x < 0 || x >= _width || y < 0 || y >= _height)
+		return;
+
+	byte *gameScreen = _gfx->getGameScreen();
+	byte *priorityScreen = _gfx->getPriorityScreen();
+
+	// Each entry is a pixel to fill the span around
+	Common::Stack<Common::Point> stack;
+	stack.push(Common::Point(x, y));
+
+	while (!stack.empty()) {
+		Common::Point p = stack.pop();
+		int offset = (p.y + _yOffset) * SCRIPT_WIDTH + _xOffset;
+		const byte *checkRow = checkScreen + offset;
+
+		// Already filled by an earlier span
+		if (checkRow[p.x] != checkValue)
+			continue;
+
+		int16 left = p.x;
+		while (left > 0 && checkRow[left - 1] == checkValue)
+			left--;
+
+		int16 right = p.x;
+		while (right < _width - 1 && checkRow[right + 1] == checkValue)
+			right++;
+
+		if (_scrOn)
+			memset(gameScreen + offset + left, _scrColor, right - left + 1);
+		if (_priOn)
+			memset(priorityScreen + offset + left, _priColor, right - left + 1);
+
+		// Continue with every run of fillable pixels above and below the span
+		for (int16 nextY = p.y - 1; nextY <= p.y + 1; nextY += 2) {
+			if (nextY < 0 || nextY >= _height)
+				continue;
+
+			const byte *nextRow = checkScreen + (nextY + _yOffset) * SCRIPT_WIDTH + _xOffset;
+			bool newSpan = true;
+			for (int16 c = left; c <= right; c++) {
+				if (nextRow[c] == checkValue) {
+					if (newSpan) {
+						stack.push(Common::Point(c, nextY));
+						newSpan = false;
+					}
+				} else {
+					newSpan = true;
+				}
+			}
+		}
+	}
+}
+
+void PictureMgr::draw_FillSlow(int16 x, int16 y) {
 	// Push initial pixel on the stack
 	Common::Stack<Common::Point> stack;
 	stack.push(Common::Point(x, y));
@@ -931,14 +1008,24 @@ int PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256, i
 	_width = pic_width;
 	_height = pic_height;
 
-	if (clearScreen && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
-		_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
-	}
-
-	if (!agi256) {
-		drawPicture(); // Draw 16 color picture.
+	if (clearScreen && !agi256 && _data && !(_flags & kPicFStep)) {
+		// Drawn onto a cleared screen, a picture always comes out the
+		// same, so scripts showing one again can use what it drew before
+		if (!restoreCachedPicture()) {
+			_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
+			drawPicture(); // Draw 16 color picture.
+			addCachedPicture();
+		}
 	} else {
-		drawPictureAGI256();
+		if (clearScreen && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
+			_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
+		}
+
+		if (!agi256) {
+			drawPicture(); // Draw 16 color picture.
+		} else {
+			drawPictureAGI256();
+		}
 	}
 
 	if (clearScreen)
@@ -948,6 +1035,64 @@ int PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256, i
 	return errOK;
 }
 
+#define PICTURE_CACHE_SIZE 4
+
+/**
+ * Look for the screens the current picture resource drew before, with
+ * the same drawing state and data, and restore them if there are any.
+ * @return true if the screens were restored from the cache
+ */
+bool PictureMgr::restoreCachedPicture() {
+	const bool nibbleMode = (_vm->_game.dirPic[_resourceNr].flags & RES_PICTURE_V3_NIBBLE_PARM) != 0;
+
+	for (Common::List<CachedPicture>::iterator it = _pictureCache.begin(); it != _pictureCache.end(); ++it) {
+		if (it->resourceNr != _resourceNr || it->width != _width || it->height != _height ||
+				it->xOffset != _xOffset || it->yOffset != _yOffset || it->flags != _flags ||
+				it->pictureVersion != _pictureVersion || it->nibbleMode != nibbleMode)
+			continue;
+
+		// The resource may have been reloaded with different data since
+		if (it->data.size() != _dataSize || memcmp(it->data.begin(), _data, _dataSize) != 0)
+			continue;
+
+		_gfx->block_restore(0, 0, SCRIPT_WIDTH, SCRIPT_HEIGHT, it->screens.begin());
+
+		// Move it to the front, so the least recently used one gets dropped first
+		if (it != _pictureCache.begin()) {
+			_pictureCache.push_front(*it);
+			_pictureCache.erase(it);
+		}
+
+		debugC(8, kDebugLevelResources, "Picture %d restored from cache", _resourceNr);
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Keep the screens the current picture resource just drew onto a
+ * cleared screen.
+ */
+void PictureMgr::addCachedPicture() {
+	if (_pictureCache.size() >= PICTURE_CACHE_SIZE)
+		_pictureCache.pop_back();
+
+	_pictureCache.push_front(CachedPicture());
+	CachedPicture &cached = _pictureCache.front();
+	cached.resourceNr = _resourceNr;
+	cached.width = _width;
+	cached.height = _height;
+	cached.xOffset = _xOffset;
+	cached.yOffset = _yOffset;
+	cached.flags = _flags;
+	cached.pictureVersion = _pictureVersion;
+	cached.nibbleMode = (_vm->_game.dirPic[_resourceNr].flags & RES_PICTURE_V3_NIBBLE_PARM) != 0;
+	cached.data = Common::Array<byte>(_data, _dataSize);
+	cached.screens.resize(SCRIPT_WIDTH * SCRIPT_HEIGHT * 2);
+	_gfx->block_save(0, 0, SCRIPT_WIDTH, SCRIPT_HEIGHT, cached.screens.begin());
+}
+
 /**
  * Decode an AGI picture resource.
  * This function decodes an AGI picture resource into the correct slot
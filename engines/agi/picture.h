@@ -23,6 +23,9 @@
 #ifndef AGI_PICTURE_H
 #define AGI_PICTURE_H
 
+#include "common/array.h"
+#include "common/list.h"
+
 namespace Agi {
 
 #define _DEFAULT_WIDTH      160
@@ -107,8 +110,12 @@ private:
 
 	int  draw_FillCheck(int16 x, int16 y);
 	void draw_Fill(int16 x, int16 y);
+	void draw_FillSlow(int16 x, int16 y);
 	void draw_Fill();
 
+	bool restoreCachedPicture();
+	void addCachedPicture();
+
 public:
 	void showPic(); // <-- for regular AGI games
 	void showPic(int16 x, int16 y, int16 pic_width, int16 pic_height); // <-- for preAGI games
@@ -158,6 +165,23 @@ private:
 
 	int _flags;
 	int _currentStep;
+
+	/**
+	 * The screens a picture resource drew onto a cleared screen, kept
+	 * together with the drawing state and resource data they depend on.
+	 */
+	struct CachedPicture {
+		int16 resourceNr;
+		int16 width, height;
+		int16 xOffset, yOffset;
+		int flags;
+		AgiPictureVersion pictureVersion;
+		bool nibbleMode;
+		Common::Array<byte> data;    // the picture resource data
+		Common::Array<byte> screens; // visual then priority screen, as saved by GfxMgr::block_save()
+	};
+
+	Common::List<CachedPicture> _pictureCache; // most recently used first
 };
 
 } // End of namespace Agi
@@ -32,6 +32,7 @@ Lights::Lights(BladeRunnerEngine *vm) {
 	_ambientLightColor.b = 0.0;
 
 	_frame = 0;
+	_changeCount = 0;
 }
 
 Lights::~Lights() {
@@ -39,6 +40,8 @@ Lights::~Lights() {
 }
 
 void Lights::read(Common::ReadStream *stream, int frameCount) {
+	_changeCount++;
+
 	_ambientLightColor.r = stream->readFloatLE();
 	_ambientLightColor.g = stream->readFloatLE();
 	_ambientLightColor.b = stream->readFloatLE();
@@ -73,6 +76,8 @@ void Lights::read(Common::ReadStream *stream, int frameCount) {
 }
 
 void Lights::removeAnimated() {
+	_changeCount++;
+
 	for (int i = (int)(_lights.size() - 1); i >= 0; i--) {
 		if (_lights[i]->_animated) {
 			delete _lights.remove_at(i);
@@ -126,6 +131,8 @@ void Lights::setupFrame(int frame) {
 }
 
 void Lights::reset() {
+	_changeCount++;
+
 	for (int i = (int)(_lights.size() - 1); i >= 0; i--) {
 		delete _lights.remove_at(i);
 	}
@@ -40,6 +40,7 @@ class Lights {
 	Color                  _ambientLightColor;
 	Common::Array<Light *> _lights;
 	int                    _frame;
+	uint32                 _changeCount;
 
 public:
 	Lights(BladeRunnerEngine *vm);
@@ -52,6 +53,9 @@ public:
 
 	void setupFrame(int frame);
 
+	/** Changes whenever lights are added or removed */
+	uint32 getChangeCount() const { return _changeCount; }
+
 private:
 	void removeAnimated();
 };
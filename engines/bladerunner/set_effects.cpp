@@ -39,6 +39,8 @@ SetEffects::SetEffects(BladeRunnerEngine *vm) {
 
 	_fogCount = 0;
 	_fogs = nullptr;
+
+	_changeCount = 0;
 }
 
 SetEffects::~SetEffects() {
@@ -46,6 +48,8 @@ SetEffects::~SetEffects() {
 }
 
 void SetEffects::read(Common::ReadStream *stream, int frameCount) {
+	_changeCount++;
+
 	_distanceCoeficient = stream->readFloatLE();
 	_distanceColor.r = stream->readFloatLE();
 	_distanceColor.g = stream->readFloatLE();
@@ -80,6 +84,8 @@ void SetEffects::read(Common::ReadStream *stream, int frameCount) {
 void SetEffects::reset() {
 	Fog *nextFog;
 
+	_changeCount++;
+
 	if (!_fogs) {
 		return;
 	}
@@ -101,10 +107,14 @@ void SetEffects::setFadeColor(float r, float g, float b) {
 	_fadeColor.r = r;
 	_fadeColor.g = g;
 	_fadeColor.b = b;
+
+	_changeCount++;
 }
 
 void SetEffects::setFadeDensity(float density) {
 	_fadeDensity = density;
+
+	_changeCount++;
 }
 
 void SetEffects::setFogColor(const Common::String &fogName, float r, float g, float b) {
@@ -116,6 +126,8 @@ void SetEffects::setFogColor(const Common::String &fogName, float r, float g, fl
 	fog->_fogColor.r = r;
 	fog->_fogColor.g = g;
 	fog->_fogColor.b = b;
+
+	_changeCount++;
 }
 
 void SetEffects::setFogDensity(const Common::String &fogName, float density) {
@@ -125,6 +137,8 @@ void SetEffects::setFogDensity(const Common::String &fogName, float density) {
 	}
 
 	fog->_fogDensity = density;
+
+	_changeCount++;
 }
 
 void SetEffects::calculateColor(Vector3 viewPosition, Vector3 position, float *outCoeficient, Color *outColor) const {
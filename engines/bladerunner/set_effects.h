@@ -43,6 +43,8 @@ class SetEffects {
 	int   _fogCount;
 	Fog  *_fogs;
 
+	uint32 _changeCount;
+
 public:
 	SetEffects(BladeRunnerEngine *vm);
 	~SetEffects();
@@ -60,6 +62,9 @@ public:
 
 	void calculateColor(Vector3 viewPosition, Vector3 position, float *outCoeficient, Color *outColor) const;
 
+	/** Changes whenever the effects are loaded or changed by the scripts */
+	uint32 getChangeCount() const { return _changeCount; }
+
 private:
 	Fog *findFog(const Common::String &fogName) const;
 };
@@ -30,8 +30,18 @@
 
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/system.h"
+#include "common/taskscheduler.h"
 #include "common/util.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SLICE_RENDERER_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SLICE_RENDERER_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace BladeRunner {
 
 SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
@@ -58,8 +68,6 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_frameSliceCount   = 0;
 	_startSlice        = 0.0f;
 	_endSlice          = 0.0f;
-	_m13               = 0;
-	_m23               = 0;
 
 	_shadowPolygonDefault[ 0] = Vector3( 16.0f,  96.0f, 0.0f);
 	_shadowPolygonDefault[ 1] = Vector3( 16.0f, 160.0f, 0.0f);
@@ -80,6 +88,7 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 }
 
 SliceRenderer::~SliceRenderer() {
+	clearLineColorsCache();
 }
 
 void SliceRenderer::setScreenEffects(ScreenEffects *screenEffects) {
@@ -88,14 +97,17 @@ void SliceRenderer::setScreenEffects(ScreenEffects *screenEffects) {
 
 void SliceRenderer::setView(View *view) {
 	_view = view;
+	clearLineColorsCache();
 }
 
 void SliceRenderer::setLights(Lights *lights) {
 	_lights = lights;
+	clearLineColorsCache();
 }
 
 void SliceRenderer::setSetEffects(SetEffects *setEffects) {
 	_setEffects = setEffects;
+	clearLineColorsCache();
 }
 
 void SliceRenderer::setupFrameInWorld(int animationId, int animationFrame, Vector3 position, float facing, float scale) {
@@ -370,6 +382,131 @@ static void setupLookupTable(int t[256], int inc) {
 	}
 }
 
+static bool sameVector(const Vector3 &a, const Vector3 &b) {
+	return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+bool SliceRenderer::LineColors::sameKey(const LineColors &other) const {
+	return sameVector(position, other.position)
+		&& frameBottomZ == other.frameBottomZ
+		&& frameSliceHeight == other.frameSliceHeight
+		&& sameVector(startScreenVector, other.startScreenVector)
+		&& sameVector(endScreenVector, other.endScreenVector)
+		&& startSlice == other.startSlice
+		&& endSlice == other.endSlice
+		&& sameVector(cameraPosition, other.cameraPosition)
+		&& viewFrame == other.viewFrame
+		&& lightsChangeCount == other.lightsChangeCount
+		&& setEffectsChangeCount == other.setEffectsChangeCount;
+}
+
+void SliceRenderer::clearLineColorsCache() {
+	for (Common::List<LineColors *>::iterator i = _lineColorsCache.begin(); i != _lineColorsCache.end(); ++i) {
+		delete *i;
+	}
+	_lineColorsCache.clear();
+}
+
+const SliceRenderer::LineColors *SliceRenderer::getLineColors(const SliceLineIterator &sliceLineIterator) {
+	LineColors key;
+	key.position              = _position;
+	key.frameBottomZ          = _frameBottomZ;
+	key.frameSliceHeight      = _frameSliceHeight;
+	key.startScreenVector     = _startScreenVector;
+	key.endScreenVector       = _endScreenVector;
+	key.startSlice            = _startSlice;
+	key.endSlice              = _endSlice;
+	key.cameraPosition        = _view->_cameraPosition;
+	key.viewFrame             = _view->_frame;
+	key.lightsChangeCount     = _lights->getChangeCount();
+	key.setEffectsChangeCount = _setEffects->getChangeCount();
+
+	for (Common::List<LineColors *>::iterator i = _lineColorsCache.begin(); i != _lineColorsCache.end(); ++i) {
+		if ((*i)->sameKey(key)) {
+			LineColors *lineColors = *i;
+			_lineColorsCache.erase(i);
+			_lineColorsCache.push_front(lineColors);
+			return lineColors;
+		}
+	}
+
+	LineColors *lineColors;
+	if (_lineColorsCache.size() >= kMaxCachedLineColors) {
+		lineColors = _lineColorsCache.back();
+		_lineColorsCache.pop_back();
+	} else {
+		lineColors = new LineColors();
+	}
+	*lineColors = key;
+	_lineColorsCache.push_front(lineColors);
+
+	SliceLineIterator it = sliceLineIterator;
+	SliceRendererLights sliceRendererLights = SliceRendererLights(_lights);
+
+	float sliceLine = it.line();
+
+	sliceRendererLights.calculateColorBase(
+		Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight),
+		Vector3(_position.x, _position.y, _position.z + _frameBottomZ),
+		it._endY - it._startY);
+
+	float setEffectsColorCoeficient;
+	Color setEffectColor;
+	_setEffects->calculateColor(
+		_view->_cameraPosition,
+		Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight),
+		&setEffectsColorCoeficient,
+		&setEffectColor);
+
+	lineColors->baseSetEffectColor = setEffectColor;
+
+	while (it._currentY <= it._endY) {
+		sliceLine = it.line();
+
+		sliceRendererLights.calculateColorSlice(Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight));
+
+		if (it._currentY & 1) {
+			_setEffects->calculateColor(
+				_view->_cameraPosition,
+				Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight),
+				&setEffectsColorCoeficient,
+				&setEffectColor);
+		}
+
+		LineColor lineColor;
+		lineColor.lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
+		lineColor.lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
+		lineColor.lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
+
+		lineColor.setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
+		lineColor.setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
+		lineColor.setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+
+		lineColors->lines.push_back(lineColor);
+
+		it.advance();
+	}
+
+	return lineColors;
+}
+
+struct SliceRenderer::DrawLinesBody : public Common::ParallelForBody {
+	const SliceRenderer *_renderer;
+	const SliceLine *_lines;
+	Graphics::Surface &_surface;
+	uint16 *_zbuffer;
+
+	DrawLinesBody(const SliceRenderer *renderer, const SliceLine *lines, Graphics::Surface &surface, uint16 *zbuffer)
+		: _renderer(renderer), _lines(lines), _surface(surface), _zbuffer(zbuffer) {}
+
+	virtual void run(uint begin, uint end) {
+		// Each line only touches its own row of the surface and the z-buffer
+		for (uint i = begin; i < end; ++i) {
+			_renderer->drawSlice(_lines[i], true, _surface, _zbuffer + 640 * _lines[i].y);
+		}
+	}
+};
+
 void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 position, float facing, float scale, Graphics::Surface &surface, uint16 *zbuffer) {
 	assert(_lights);
 	assert(_setEffects);
@@ -391,89 +528,52 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		_mvpMatrix
 	);
 
-	SliceRendererLights sliceRendererLights = SliceRendererLights(_lights);
-
 	_lights->setupFrame(_view->_frame);
 	_setEffects->setupFrame(_view->_frame);
 
-	float sliceLine = sliceLineIterator.line();
-
-	sliceRendererLights.calculateColorBase(
-		Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight),
-		Vector3(_position.x, _position.y, _position.z + _frameBottomZ),
-		sliceLineIterator._endY - sliceLineIterator._startY);
-
-	float setEffectsColorCoeficient;
-	Color setEffectColor;
-	_setEffects->calculateColor(
-		_view->_cameraPosition,
-		Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight),
-		&setEffectsColorCoeficient,
-		&setEffectColor);
-
-	_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-	_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-	_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
-
-	_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-	_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-	_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+	const LineColors *lineColors = getLineColors(sliceLineIterator);
 
 	setupLookupTable(_m12lookup, sliceLineIterator._sliceMatrix(0, 1));
 	setupLookupTable(_m11lookup, sliceLineIterator._sliceMatrix(0, 0));
-	_m13 = sliceLineIterator._sliceMatrix(0, 2);
 	setupLookupTable(_m21lookup, sliceLineIterator._sliceMatrix(1, 0));
 	setupLookupTable(_m22lookup, sliceLineIterator._sliceMatrix(1, 1));
-	_m23 = sliceLineIterator._sliceMatrix(1, 2);
 
 	if (_animationsShadowEnabled[_animation]) {
-		float coeficientShadow;
-		Color colorShadow;
-		_setEffects->calculateColor(
-				_view->_cameraPosition,
-				_position,
-				&coeficientShadow,
-				&colorShadow);
-
+		const Color &setEffectColor = lineColors->baseSetEffectColor;
 		int transparency = 32.0f * sqrt(setEffectColor.r * setEffectColor.r + setEffectColor.g * setEffectColor.g + setEffectColor.b * setEffectColor.b);
 
 		drawShadowInWorld(transparency, surface, zbuffer);
 	}
 
-	int frameY = sliceLineIterator._startY;
-
-	uint16 *zBufferLinePtr = zbuffer + 640 * frameY;
-
-	while (sliceLineIterator._currentY <= sliceLineIterator._endY) {
-		_m13 = sliceLineIterator._sliceMatrix(0, 2);
-		_m23 = sliceLineIterator._sliceMatrix(1, 2);
-		sliceLine = sliceLineIterator.line();
-
-		sliceRendererLights.calculateColorSlice(Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight));
-
-		if (sliceLineIterator._currentY & 1) {
-			_setEffects->calculateColor(
-				_view->_cameraPosition,
-				Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight),
-				&setEffectsColorCoeficient,
-				&setEffectColor);
-		}
-
-		_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-		_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-		_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
+	Common::Array<SliceLine> lines;
+	lines.reserve(lineColors->lines.size());
 
-		_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-		_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-		_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+	int frameY = sliceLineIterator._startY;
 
+	for (uint i = 0; sliceLineIterator._currentY <= sliceLineIterator._endY; ++i) {
 		if (frameY >= 0 && frameY < surface.h) {
-			drawSlice((int)sliceLine, true, frameY, surface, zBufferLinePtr);
+			SliceLine line;
+			line.y              = frameY;
+			line.slice          = (int)sliceLineIterator.line();
+			line.m13            = sliceLineIterator._sliceMatrix(0, 2);
+			line.m23            = sliceLineIterator._sliceMatrix(1, 2);
+			line.setEffectColor = lineColors->lines[i].setEffectColor;
+			line.lightsColor    = lineColors->lines[i].lightsColor;
+			lines.push_back(line);
 		}
 
 		sliceLineIterator.advance();
 		frameY += 1;
-		zBufferLinePtr += 640;
+	}
+
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (lines.size() >= 64 && !scheduler->isSerial()) {
+		DrawLinesBody body(this, lines.begin(), surface, zbuffer);
+		scheduler->parallelFor(0, lines.size(), body, 16);
+	} else {
+		for (uint i = 0; i < lines.size(); ++i) {
+			drawSlice(lines[i], true, surface, zbuffer + 640 * lines[i].y);
+		}
 	}
 }
 
@@ -514,10 +614,12 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 
 	setupLookupTable(_m11lookup, m(0, 0));
 	setupLookupTable(_m12lookup, m(0, 1));
-	_m13 = m(0, 2);
 	setupLookupTable(_m21lookup, m(1, 0));
 	setupLookupTable(_m22lookup, m(1, 1));
-	_m23 = m(1, 2);
+
+	SliceLine line;
+	line.m13 = m(0, 2);
+	line.m23 = m(1, 2);
 
 	int frameY = screenY + (size / 2.0f * frameHeight);
 	int currentY = frameY;
@@ -530,21 +632,118 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	while (currentSlice < _frameSliceCount) {
 		if (currentY >= 0 && currentY < surface.h) {
 			memset(lineZbuffer, 0xFF, 640 * 2);
-			drawSlice(currentSlice, false, currentY, surface, lineZbuffer);
+			line.y     = currentY;
+			line.slice = currentSlice;
+			drawSlice(line, false, surface, lineZbuffer);
 			currentSlice += sliceStep;
 			currentY--;
 		}
 	}
 }
 
-void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
-	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
+/** Draws the pixels of a span which are nearer than the z-buffer */
+template<typename T>
+static void drawSpan(T *dst, uint16 *zbuffer, int width, uint16 z, T color) {
+	for (int x = 0; x < width; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = color;
+		}
+	}
+}
+
+#if defined(SLICE_RENDERER_USE_SSE2) || defined(SLICE_RENDERER_USE_NEON)
+template<>
+void drawSpan<uint16>(uint16 *dst, uint16 *zbuffer, int width, uint16 z, uint16 color) {
+	int x = 0;
+
+#ifdef SLICE_RENDERER_USE_SSE2
+	// SSE2 only compares signed words, so compare with the sign bits flipped
+	const __m128i bias = _mm_set1_epi16((int16)0x8000);
+	const __m128i zVec = _mm_set1_epi16((int16)z);
+	const __m128i zBiased = _mm_xor_si128(zVec, bias);
+	const __m128i colorVec = _mm_set1_epi16((int16)color);
+	for (; x + 8 <= width; x += 8) {
+		const __m128i zbufferVec = _mm_loadu_si128((const __m128i *)(zbuffer + x));
+		const __m128i dstVec = _mm_loadu_si128((const __m128i *)(dst + x));
+		const __m128i mask = _mm_cmpgt_epi16(_mm_xor_si128(zbufferVec, bias), zBiased);
+		_mm_storeu_si128((__m128i *)(zbuffer + x), _mm_or_si128(_mm_and_si128(mask, zVec), _mm_andnot_si128(mask, zbufferVec)));
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_and_si128(mask, colorVec), _mm_andnot_si128(mask, dstVec)));
+	}
+#else
+	const uint16x8_t zVec = vdupq_n_u16(z);
+	const uint16x8_t colorVec = vdupq_n_u16(color);
+	for (; x + 8 <= width; x += 8) {
+		const uint16x8_t zbufferVec = vld1q_u16(zbuffer + x);
+		const uint16x8_t mask = vcltq_u16(zVec, zbufferVec);
+		vst1q_u16(zbuffer + x, vbslq_u16(mask, zVec, zbufferVec));
+		vst1q_u16(dst + x, vbslq_u16(mask, colorVec, vld1q_u16(dst + x)));
+	}
+#endif
+
+	for (; x < width; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = color;
+		}
+	}
+}
+
+template<>
+void drawSpan<uint32>(uint32 *dst, uint16 *zbuffer, int width, uint16 z, uint32 color) {
+	int x = 0;
+
+#ifdef SLICE_RENDERER_USE_SSE2
+	const __m128i bias = _mm_set1_epi16((int16)0x8000);
+	const __m128i zVec = _mm_set1_epi16((int16)z);
+	const __m128i zBiased = _mm_xor_si128(zVec, bias);
+	const __m128i colorVec = _mm_set1_epi32((int32)color);
+	for (; x + 8 <= width; x += 8) {
+		const __m128i zbufferVec = _mm_loadu_si128((const __m128i *)(zbuffer + x));
+		const __m128i mask = _mm_cmpgt_epi16(_mm_xor_si128(zbufferVec, bias), zBiased);
+		_mm_storeu_si128((__m128i *)(zbuffer + x), _mm_or_si128(_mm_and_si128(mask, zVec), _mm_andnot_si128(mask, zbufferVec)));
+
+		// Widen the word masks to the pixels
+		const __m128i maskLow = _mm_unpacklo_epi16(mask, mask);
+		const __m128i maskHigh = _mm_unpackhi_epi16(mask, mask);
+		const __m128i dstLow = _mm_loadu_si128((const __m128i *)(dst + x));
+		const __m128i dstHigh = _mm_loadu_si128((const __m128i *)(dst + x + 4));
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_and_si128(maskLow, colorVec), _mm_andnot_si128(maskLow, dstLow)));
+		_mm_storeu_si128((__m128i *)(dst + x + 4), _mm_or_si128(_mm_and_si128(maskHigh, colorVec), _mm_andnot_si128(maskHigh, dstHigh)));
+	}
+#else
+	const uint16x8_t zVec = vdupq_n_u16(z);
+	const uint32x4_t colorVec = vdupq_n_u32(color);
+	for (; x + 8 <= width; x += 8) {
+		const uint16x8_t zbufferVec = vld1q_u16(zbuffer + x);
+		const uint16x8_t mask = vcltq_u16(zVec, zbufferVec);
+		vst1q_u16(zbuffer + x, vbslq_u16(mask, zVec, zbufferVec));
+
+		// Widen the word masks to the pixels
+		const uint32x4_t maskLow = vreinterpretq_u32_s32(vmovl_s16(vreinterpret_s16_u16(vget_low_u16(mask))));
+		const uint32x4_t maskHigh = vreinterpretq_u32_s32(vmovl_s16(vreinterpret_s16_u16(vget_high_u16(mask))));
+		vst1q_u32(dst + x, vbslq_u32(maskLow, colorVec, vld1q_u32(dst + x)));
+		vst1q_u32(dst + x + 4, vbslq_u32(maskHigh, colorVec, vld1q_u32(dst + x + 4)));
+	}
+#endif
+
+	for (; x < width; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = color;
+		}
+	}
+}
+#endif
+
+void SliceRenderer::drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) const {
+	if (line.slice < 0 || (uint32)line.slice >= _frameSliceCount) {
 		return;
 	}
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
-	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
+	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * line.slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
 
@@ -553,6 +752,10 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 	uint32 polyCount = READ_LE_UINT32(p);
 	p += 4;
 
+	int y = CLIP(line.y, 0, surface.h - 1);
+	byte *dstLine = (byte *)surface.getBasePtr(0, y);
+	int maxX = MIN<int>(640, surface.w);
+
 	while (polyCount--) {
 		uint32 vertexCount = READ_LE_UINT32(p);
 		p += 4;
@@ -561,37 +764,46 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 			continue;
 
 		uint32 lastVertex = vertexCount - 1;
-		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + _m13) / 65536, 0);
+		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + line.m13) / 65536, 0);
 
 		int previousVertexX = lastVertexX;
 
 		while (vertexCount--) {
-			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + _m13) / 65536, 0, 640);
+			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + line.m13) / 65536, 0, 640);
 
 			if (vertexX > previousVertexX) {
-				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
+				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + line.m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
 					uint32 outColor = palette.value[p[2]];
 					if (advanced) {
 						Color256 aescColor = { 0, 0, 0 };
-						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
+						_screenEffects->getColor(&aescColor, vertexX, line.y, vertexZ);
 
 						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+						color.r = ((int)(line.setEffectColor.r + line.lightsColor.r * color.r) / 65536) + aescColor.r;
+						color.g = ((int)(line.setEffectColor.g + line.lightsColor.g * color.g) / 65536) + aescColor.g;
+						color.b = ((int)(line.setEffectColor.b + line.lightsColor.b * color.b) / 65536) + aescColor.b;
 
 						int bladeToScummVmConstant = 256 / 32;
 						outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
-
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+					int spanEnd = MIN(vertexX, maxX);
+					if (spanEnd > previousVertexX) {
+						int width = spanEnd - previousVertexX;
+						uint16 *zbufferSpan = zbufferLine + previousVertexX;
+
+						switch (surface.format.bytesPerPixel) {
+						case 1:
+							drawSpan<uint8>(dstLine + previousVertexX, zbufferSpan, width, vertexZ, outColor);
+							break;
+						case 2:
+							drawSpan<uint16>((uint16 *)dstLine + previousVertexX, zbufferSpan, width, vertexZ, outColor);
+							break;
+						case 4:
+							drawSpan<uint32>((uint32 *)dstLine + previousVertexX, zbufferSpan, width, vertexZ, outColor);
+							break;
 						}
 					}
 				}
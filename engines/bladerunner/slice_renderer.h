@@ -28,6 +28,8 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
+#include "common/list.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
@@ -42,8 +44,54 @@ class ScreenEffects;
 class BladeRunnerEngine;
 class Lights;
 class SetEffects;
+struct SliceLineIterator;
 
 class SliceRenderer {
+	/** Everything needed for drawing one line of a frame */
+	struct SliceLine {
+		int   y;
+		int   slice;
+		int   m13;
+		int   m23;
+		Color setEffectColor;
+		Color lightsColor;
+	};
+
+	struct LineColor {
+		Color setEffectColor;
+		Color lightsColor;
+	};
+
+	/**
+	 * The lighting of the lines of a frame drawn at some position. It only
+	 * depends on where the frame is drawn and the state of the set, so it
+	 * is kept for actors which don't move.
+	 */
+	struct LineColors {
+		Vector3 position;
+		float   frameBottomZ;
+		float   frameSliceHeight;
+		Vector3 startScreenVector;
+		Vector3 endScreenVector;
+		float   startSlice;
+		float   endSlice;
+		Vector3 cameraPosition;
+		uint32  viewFrame;
+		uint32  lightsChangeCount;
+		uint32  setEffectsChangeCount;
+
+		Color   baseSetEffectColor;
+		Common::Array<LineColor> lines;
+
+		bool sameKey(const LineColors &other) const;
+	};
+
+	enum {
+		kMaxCachedLineColors = 16
+	};
+
+	struct DrawLinesBody;
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -76,18 +124,16 @@ class SliceRenderer {
 
 	int _m11lookup[256];
 	int _m12lookup[256];
-	int _m13;
 	int _m21lookup[256];
 	int _m22lookup[256];
-	int _m23;
 
 	bool _animationsShadowEnabled[997];
 
 	Vector3 _shadowPolygonDefault[12];
 	Vector3 _shadowPolygonCurrent[12];
 
-	Color _setEffectColor;
-	Color _lightsColor;
+	// Most recently used first
+	Common::List<LineColors *> _lineColorsCache;
 
 	Graphics::PixelFormat _pixelFormat;
 
@@ -114,7 +160,10 @@ private:
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	const LineColors *getLineColors(const SliceLineIterator &sliceLineIterator);
+	void clearLineColorsCache();
+
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) const;
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
@@ -36,6 +36,7 @@
 #include "common/array.h"
 #include "common/util.h"
 #include "common/memstream.h"
+#include "common/system.h"
 
 namespace BladeRunner {
 
@@ -137,9 +138,13 @@ VQADecoder::VQADecoder() {
 	_header.unk5         = 0;
 	_readingFrame        = -1;
 	_decodingFrame       = -1;
+	_aheadFrame          = -1;
 }
 
 VQADecoder::~VQADecoder() {
+	// The worker may still be using the codebooks
+	cancelVideoFrameAhead();
+
 	for (uint i = 0; i < _codebooks.size(); ++i) {
 		delete[] _codebooks[i].data;
 	}
@@ -221,6 +226,53 @@ void VQADecoder::decodeLights(Lights *lights) {
 	_videoTrack->decodeLights(lights);
 }
 
+void VQADecoder::decodeVideoFrameAhead(int frame, const Graphics::PixelFormat &format) {
+	cancelVideoFrameAhead();
+
+	if (frame < 0 || frame >= numFrames() || g_system->getTaskScheduler()->isSerial()) {
+		return;
+	}
+
+	// The stream is only read here, the worker gets everything it needs
+	CodebookInfo &codebookInfo = codebookInfoForFrame(frame);
+	if (!codebookInfo.data) {
+		readFrame(codebookInfo.frame, kVQAReadCodebook);
+	}
+
+	_videoTrack->setReadingAhead(true);
+	readFrame(frame, kVQAReadCodebook | kVQAReadVectorPointerTable | kVQAReadZBuffer);
+	_videoTrack->setReadingAhead(false);
+
+	if (!codebookInfo.data) {
+		return;
+	}
+
+	_videoTrack->startDecodeAhead(codebookInfo.data, format);
+	_aheadFrame = frame;
+}
+
+bool VQADecoder::useVideoFrameAhead(int frame, Graphics::Surface *surface) {
+	if (_aheadFrame != frame) {
+		cancelVideoFrameAhead();
+		return false;
+	}
+
+	_aheadFrame = -1;
+	if (!_videoTrack->useDecodedAhead(surface)) {
+		return false;
+	}
+
+	_decodingFrame = frame;
+	return true;
+}
+
+void VQADecoder::cancelVideoFrameAhead() {
+	if (_aheadFrame != -1) {
+		_videoTrack->cancelDecodeAhead();
+		_aheadFrame = -1;
+	}
+}
+
 void VQADecoder::readPacket(uint readFlags) {
 	IFFChunkHeader chd;
 
@@ -242,7 +294,7 @@ void VQADecoder::readPacket(uint readFlags) {
 		case kVIEW: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVIEW(_s, chd.size); break;
 		case kVQFL: rc = ((readFlags & kVQAReadVideo ) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVQFL(_s, chd.size, readFlags); break;
 		case kVQFR: rc = ((readFlags & kVQAReadVideo ) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readVQFR(_s, chd.size, readFlags); break;
-		case kZBUF: rc = ((readFlags & kVQAReadCustom) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readZBUF(_s, chd.size); break;
+		case kZBUF: rc = ((readFlags & kVQAReadZBuffer) == 0) ? _s->skip(roundup(chd.size)) : _videoTrack->readZBUF(_s, chd.size); break;
 		// Sound track
 		case kSN2J: rc = ((readFlags & kVQAReadAudio) == 0) ? _s->skip(roundup(chd.size)) : _audioTrack->readSN2J(_s, chd.size); break;
 		case kSND2: rc = ((readFlags & kVQAReadAudio) == 0) ? _s->skip(roundup(chd.size)) : _audioTrack->readSND2(_s, chd.size); break;
@@ -595,7 +647,6 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_maxCBFZSize = header->maxCBFZSize;
 	_maxZBUFChunkSize = vqaDecoder->_maxZBUFChunkSize;
 
-	_codebook = nullptr;
 	_cbfz     = nullptr;
 
 	_vpointerSize = 0;
@@ -614,12 +665,36 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 
 	_lightsDataSize = 0;
 	_lightsData     = nullptr;
+
+	_zbufDecoded    = nullptr;
+	_hasZbufDecoded = false;
+
+	_readingAhead        = false;
+	_aheadCodebook       = nullptr;
+	_aheadHasNewFrame    = false;
+	_aheadVPointerSize   = 0;
+	_aheadVPointer       = nullptr;
+	_aheadHasZbuf        = false;
+	_aheadZbufChunkSize  = 0;
+	_aheadZbufChunk      = nullptr;
+	_aheadZbufDecoded    = nullptr;
+	_aheadHasZbufDecoded = false;
+	_aheadMask           = nullptr;
 }
 
 VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
+	cancelDecodeAhead();
+
 	delete[] _cbfz;
 	delete[] _zbufChunk;
 	delete[] _vpointer;
+	delete[] _zbufDecoded;
+
+	delete[] _aheadVPointer;
+	delete[] _aheadZbufChunk;
+	delete[] _aheadZbufDecoded;
+	delete[] _aheadMask;
+	_aheadSurface.free();
 
 	delete[] _viewData;
 	delete[] _screenEffectsData;
@@ -709,8 +784,19 @@ bool VQADecoder::VQAVideoTrack::readZBUF(Common::SeekableReadStream *s, uint32 s
 		return false;
 	}
 
+	if (_readingAhead) {
+		if (!_aheadZbufChunk) {
+			_aheadZbufChunk = new uint8[roundup(_maxZBUFChunkSize)];
+		}
+		_aheadZbufChunkSize = size;
+		s->read(_aheadZbufChunk, roundup(size));
+		_aheadHasZbuf = true;
+		return true;
+	}
+
 	_zbufChunkSize = size;
 	s->read(_zbufChunk, roundup(size));
+	_hasZbufDecoded = false;
 
 	return true;
 }
@@ -720,6 +806,11 @@ void VQADecoder::VQAVideoTrack::decodeZBuffer(ZBuffer *zbuffer) {
 		return;
 	}
 
+	if (_hasZbufDecoded) {
+		zbuffer->setData(_zbufDecoded, _width, _height);
+		return;
+	}
+
 	zbuffer->decodeData(_zbufChunk, _zbufChunkSize);
 }
 
@@ -805,6 +896,16 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	if (size > _maxVPTRSize)
 		return false;
 
+	if (_readingAhead) {
+		if (!_aheadVPointer) {
+			_aheadVPointer = new uint8[roundup(_maxVPTRSize)];
+		}
+		_aheadVPointerSize = size;
+		s->read(_aheadVPointer, roundup(size));
+		_aheadHasNewFrame = true;
+		return true;
+	}
+
 	if (!_vpointer) {
 		_vpointer = new uint8[roundup(_maxVPTRSize)];
 	}
@@ -817,8 +918,8 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
-void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
-	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, const uint8 *codebook, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha, uint8 *mask) const {
+	const uint8 *const block_src = &codebook[2 * srcBlock * _blockW * _blockH];
 
 	int blocks_per_line = _width / _blockW;
 
@@ -842,6 +943,9 @@ void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsig
 					void* dstPtr = surface->getBasePtr(dst_x + x, dst_y + y);
 					// Ignore the alpha in the output as it is inversed in the input
 					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+					if (mask) {
+						mask[(dst_y + y) * surface->w + dst_x + x] = 1;
+					}
 				}
 			}
 		}
@@ -855,12 +959,16 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 		_vqaDecoder->readFrame(codebookInfo.frame, kVQAReadCodebook);
 	}
 
-	_codebook = codebookInfo.data;
-	if (!_codebook || !_vpointer)
+	if (!codebookInfo.data || !_vpointer)
 		return false;
 
-	uint8 *src = _vpointer;
-	uint8 *end = _vpointer + _vpointerSize;
+	decodeVectorPointers(surface, codebookInfo.data, _vpointer, _vpointerSize, nullptr);
+	return true;
+}
+
+void VQADecoder::VQAVideoTrack::decodeVectorPointers(Graphics::Surface *surface, const uint8 *codebook, const uint8 *vpointer, uint32 vpointerSize, uint8 *mask) const {
+	const uint8 *src = vpointer;
+	const uint8 *end = vpointer + vpointerSize;
 
 	uint16 count, srcBlock, dstBlock = 0;
 	(void)srcBlock;
@@ -879,19 +987,19 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 			count = 2 * (((command >> 8) & 0x1f) + 1);
 			srcBlock = command & 0x00ff;
 
-			VPTRWriteBlock(surface, dstBlock, srcBlock, count);
+			VPTRWriteBlock(surface, codebook, dstBlock, srcBlock, count, false, mask);
 			dstBlock += count;
 			break;
 		case 2:
 			count = 2 * (((command >> 8) & 0x1f) + 1);
 			srcBlock = command & 0x00ff;
 
-			VPTRWriteBlock(surface, dstBlock, srcBlock, 1);
+			VPTRWriteBlock(surface, codebook, dstBlock, srcBlock, 1, false, mask);
 			++dstBlock;
 
 			for (int i = 0; i < count; ++i) {
 				srcBlock = *src++;
-				VPTRWriteBlock(surface, dstBlock, srcBlock, 1);
+				VPTRWriteBlock(surface, codebook, dstBlock, srcBlock, 1, false, mask);
 				++dstBlock;
 			}
 			break;
@@ -900,7 +1008,7 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 			count = 1;
 			srcBlock = command & 0x1fff;
 
-			VPTRWriteBlock(surface, dstBlock, srcBlock, count, prefix == 4);
+			VPTRWriteBlock(surface, codebook, dstBlock, srcBlock, count, prefix == 4, mask);
 			++dstBlock;
 			break;
 		case 5:
@@ -908,17 +1016,141 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 			count = *src++;
 			srcBlock = command & 0x1fff;
 
-			VPTRWriteBlock(surface, dstBlock, srcBlock, count, prefix == 6);
+			VPTRWriteBlock(surface, codebook, dstBlock, srcBlock, count, prefix == 6, mask);
 			dstBlock += count;
 			break;
 		default:
 			warning("VQAVideoTrack::decodeFrame: Undefined case %d", command >> 13);
 		}
 	}
+}
+
+class VQADecoder::VQAVideoTrack::DecodeAheadTask : public Common::Task {
+	VQAVideoTrack *_videoTrack;
+
+public:
+	DecodeAheadTask(VQAVideoTrack *videoTrack) : _videoTrack(videoTrack) {}
+
+	void run() {
+		_videoTrack->decodeAhead();
+	}
+};
+
+void VQADecoder::VQAVideoTrack::setReadingAhead(bool readingAhead) {
+	if (readingAhead) {
+		_aheadHasNewFrame = false;
+		_aheadHasZbuf = false;
+	}
+	_readingAhead = readingAhead;
+}
+
+void VQADecoder::VQAVideoTrack::startDecodeAhead(const uint8 *codebook, const Graphics::PixelFormat &format) {
+	_aheadCodebook = codebook;
+
+	// Covers the same area as the surface the frame will be drawn on, the
+	// mask records which of its pixels the frame actually drew
+	if (_aheadHasNewFrame && (!_aheadMask || _aheadSurface.format != format)) {
+		_aheadSurface.free();
+		_aheadSurface.create(_offsetX + _width, _offsetY + _height, format);
+
+		delete[] _aheadMask;
+		_aheadMask = new uint8[_aheadSurface.w * _aheadSurface.h];
+	}
+
+	if (_aheadHasZbuf && !_aheadZbufDecoded) {
+		_aheadZbufDecoded = new uint16[_width * _height];
+	}
+
+	_aheadFuture = g_system->getTaskScheduler()->schedule(new DecodeAheadTask(this));
+}
+
+void VQADecoder::VQAVideoTrack::decodeAhead() {
+	if (_aheadHasNewFrame) {
+		memset(_aheadMask, 0, _aheadSurface.w * _aheadSurface.h);
+		decodeVectorPointers(&_aheadSurface, _aheadCodebook, _aheadVPointer, _aheadVPointerSize, _aheadMask);
+	}
+
+	_aheadHasZbufDecoded = false;
+	if (_aheadHasZbuf && _aheadZbufChunkSize > 16) {
+		uint32 width    = READ_LE_UINT32(_aheadZbufChunk + 0);
+		uint32 height   = READ_LE_UINT32(_aheadZbufChunk + 4);
+		uint32 complete = READ_LE_UINT32(_aheadZbufChunk + 8);
+
+		// Partial z-buffers are applied on top of the previous one, so they
+		// are still decoded when used
+		if (complete && width == _width && height == _height) {
+			size_t zbufOutSize;
+			decompress_lzo1x(_aheadZbufChunk + 16, _aheadZbufChunkSize - 16, (uint8 *)_aheadZbufDecoded, &zbufOutSize);
+#ifdef SCUMM_BIG_ENDIAN
+			uint8 *rawZbuf = (uint8 *)_aheadZbufDecoded;
+			for (size_t i = 0; i < zbufOutSize - 1; i += 2) {
+				SWAP(rawZbuf[i], rawZbuf[i + 1]);
+			}
+#endif
+			_aheadHasZbufDecoded = true;
+		}
+	}
+}
+
+template<typename T>
+static void copyMaskedPixels(const Graphics::Surface &src, const uint8 *mask, Graphics::Surface &dst, int x1, int y1) {
+	for (int y = y1; y < src.h; ++y) {
+		const T *srcLine = (const T *)src.getBasePtr(0, y);
+		const uint8 *maskLine = mask + y * src.w;
+		T *dstLine = (T *)dst.getBasePtr(0, y);
+		for (int x = x1; x < src.w; ++x) {
+			if (maskLine[x]) {
+				dstLine[x] = srcLine[x];
+			}
+		}
+	}
+}
+
+bool VQADecoder::VQAVideoTrack::useDecodedAhead(Graphics::Surface *surface) {
+	cancelDecodeAhead();
+
+	if (_aheadHasNewFrame) {
+		if (!surface || surface->format != _aheadSurface.format || surface->w < _aheadSurface.w || surface->h < _aheadSurface.h) {
+			return false;
+		}
+
+		switch (surface->format.bytesPerPixel) {
+		case 1:
+			copyMaskedPixels<uint8>(_aheadSurface, _aheadMask, *surface, _offsetX, _offsetY);
+			break;
+		case 2:
+			copyMaskedPixels<uint16>(_aheadSurface, _aheadMask, *surface, _offsetX, _offsetY);
+			break;
+		case 4:
+			copyMaskedPixels<uint32>(_aheadSurface, _aheadMask, *surface, _offsetX, _offsetY);
+			break;
+		default:
+			return false;
+		}
+
+		// The vector pointers are kept for redrawing the frame
+		SWAP(_vpointer, _aheadVPointer);
+		SWAP(_vpointerSize, _aheadVPointerSize);
+		_hasNewFrame = false;
+	}
+
+	if (_aheadHasZbuf) {
+		SWAP(_zbufChunk, _aheadZbufChunk);
+		SWAP(_zbufChunkSize, _aheadZbufChunkSize);
+		SWAP(_zbufDecoded, _aheadZbufDecoded);
+		_hasZbufDecoded = _aheadHasZbufDecoded;
+	}
 
 	return true;
 }
 
+void VQADecoder::VQAVideoTrack::cancelDecodeAhead() {
+	if (_aheadFuture.isValid()) {
+		_aheadFuture.wait();
+		_aheadFuture = Common::TaskFuture();
+	}
+}
+
 VQADecoder::VQAAudioTrack::VQAAudioTrack(VQADecoder *vqaDecoder) {
 	_frequency = vqaDecoder->_header.freq;
 }
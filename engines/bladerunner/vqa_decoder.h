@@ -30,6 +30,7 @@
 #include "common/debug.h"
 #include "common/str.h"
 #include "common/stream.h"
+#include "common/taskscheduler.h"
 #include "common/types.h"
 
 #include "graphics/surface.h"
@@ -47,7 +48,8 @@ enum VQADecoderSkipFlags {
 	kVQAReadCodebook           = 1,
 	kVQAReadVectorPointerTable = 2,
 	kVQAReadCustom             = 4,
-	kVQAReadVideo              = kVQAReadCodebook|kVQAReadVectorPointerTable|kVQAReadCustom,
+	kVQAReadZBuffer            = 16,
+	kVQAReadVideo              = kVQAReadCodebook|kVQAReadVectorPointerTable|kVQAReadCustom|kVQAReadZBuffer,
 	kVQAReadAudio              = 8,
 	kVQAReadAll                = kVQAReadVideo|kVQAReadAudio
 };
@@ -70,6 +72,27 @@ public:
 	void                        decodeScreenEffects(ScreenEffects *aesc);
 	void                        decodeLights(Lights *lights);
 
+	/**
+	 * Reads the vector pointers and z-buffer of a frame and starts decoding
+	 * them on a worker thread, for useVideoFrameAhead(). Does nothing when
+	 * the task scheduler has no worker threads.
+	 */
+	void decodeVideoFrameAhead(int frame, const Graphics::PixelFormat &format);
+
+	/**
+	 * Draws a frame decoded by decodeVideoFrameAhead() and makes its
+	 * z-buffer the one decodeZBuffer() uses, like readFrame() with the
+	 * video flags but kVQAReadCustom followed by decodeVideoFrame() would.
+	 * Returns false, and drops what was decoded ahead, when that was
+	 * another frame or can't be drawn on the surface.
+	 */
+	bool useVideoFrameAhead(int frame, Graphics::Surface *surface);
+
+	void cancelVideoFrameAhead();
+
+	/** The frame being decoded ahead, or -1 */
+	int  getVideoFrameAhead() const { return _aheadFrame; }
+
 	uint16 numFrames() const { return _header.numFrames; }
 	uint8  frameRate() const { return _header.frameRate; }
 
@@ -142,6 +165,7 @@ public:
 	Header   _header;
 	int      _readingFrame;
 	int      _decodingFrame;
+	int      _aheadFrame;
 	LoopInfo _loopInfo;
 
 	Common::Array<CodebookInfo> _codebooks;
@@ -184,6 +208,12 @@ public:
 		void decodeScreenEffects(ScreenEffects *aesc);
 		void decodeLights(Lights *lights);
 
+		void setReadingAhead(bool readingAhead);
+		void startDecodeAhead(const uint8 *codebook, const Graphics::PixelFormat &format);
+		void decodeAhead();
+		bool useDecodedAhead(Graphics::Surface *surface);
+		void cancelDecodeAhead();
+
 		bool readVQFR(Common::SeekableReadStream *s, uint32 size, uint readFlags);
 		bool readVPTR(Common::SeekableReadStream *s, uint32 size);
 		bool readVQFL(Common::SeekableReadStream *s, uint32 size, uint readFlags);
@@ -214,7 +244,6 @@ public:
 		uint32  _maxCBFZSize;
 		uint32  _maxZBUFChunkSize;
 
-		uint8   *_codebook;
 		uint8   *_cbfz;
 		uint32   _zbufChunkSize;
 		uint8   *_zbufChunk;
@@ -231,8 +260,31 @@ public:
 		uint8   *_screenEffectsData;
 		uint32   _screenEffectsDataSize;
 
-		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
+		// A complete z-buffer the current frame got decompressed ahead of time
+		uint16  *_zbufDecoded;
+		bool     _hasZbufDecoded;
+
+		// The next frame, read into separate buffers and decoded by a
+		// worker thread while the current one is shown
+		bool               _readingAhead;
+		Common::TaskFuture _aheadFuture;
+		const uint8       *_aheadCodebook;
+		bool               _aheadHasNewFrame;
+		uint32             _aheadVPointerSize;
+		uint8             *_aheadVPointer;
+		bool               _aheadHasZbuf;
+		uint32             _aheadZbufChunkSize;
+		uint8             *_aheadZbufChunk;
+		uint16            *_aheadZbufDecoded;
+		bool               _aheadHasZbufDecoded;
+		Graphics::Surface  _aheadSurface;
+		uint8             *_aheadMask;
+
+		class DecodeAheadTask;
+
+		void VPTRWriteBlock(Graphics::Surface *surface, const uint8 *codebook, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha, uint8 *mask) const;
 		bool decodeFrame(Graphics::Surface *surface);
+		void decodeVectorPointers(Graphics::Surface *surface, const uint8 *codebook, const uint8 *vpointer, uint32 vpointerSize, uint8 *mask) const;
 	};
 
 	class VQAAudioTrack {
@@ -77,6 +77,7 @@ bool VQAPlayer::open() {
 }
 
 void VQAPlayer::close() {
+	_decoder.cancelVideoFrameAhead();
 	_vm->_mixer->stopHandle(_soundHandle);
 	delete _s;
 	_s = nullptr;
@@ -120,11 +121,24 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 		// _repeatsCount == 0, so return here at the end of the video, to release the resource
 		return result;
 	} else if (useTime && (now < _frameNextTime)) {
+		// Decode the next frame while waiting for its time, a changed loop
+		// makes it a different frame and it is just decoded again
+		if (advanceFrame && _frameNext >= 0 && _frameNext <= _frameEnd && _decoder.getVideoFrameAhead() != _frameNext) {
+			Graphics::Surface *surface = customSurface != nullptr ? customSurface : _surface;
+			if (surface) {
+				_decoder.decodeVideoFrameAhead(_frameNext, surface->format);
+			}
+		}
 		result = -1;
 	} else if (advanceFrame) {
 		_frame = _frameNext;
-		_decoder.readFrame(_frameNext, kVQAReadVideo);
-		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext);
+		Graphics::Surface *surface = customSurface != nullptr ? customSurface : _surface;
+		if (_decoder.useVideoFrameAhead(_frameNext, surface)) {
+			_decoder.readFrame(_frameNext, kVQAReadCustom);
+		} else {
+			_decoder.readFrame(_frameNext, kVQAReadVideo);
+			_decoder.decodeVideoFrame(surface, _frameNext);
+		}
 
 		if (_hasAudio) {
 			int audioPreloadFrames = 14;
@@ -28,53 +28,102 @@
 
 namespace BladeRunner {
 
-void ZBufferDirtyRects::reset() {
+ZBufferDirtyTiles::ZBufferDirtyTiles() {
+	_width = 0;
+	_height = 0;
+	_tilesX = 0;
+	_tilesY = 0;
+	_tiles = nullptr;
 	_count = 0;
+	_next = 0;
 }
 
-bool ZBufferDirtyRects::add(Common::Rect rect) {
-	if (_count == MAX_DIRTY_RECTS)
-		return false;
+ZBufferDirtyTiles::~ZBufferDirtyTiles() {
+	delete[] _tiles;
+}
+
+void ZBufferDirtyTiles::init(int width, int height) {
+	_width = width;
+	_height = height;
+	_tilesX = (width + ZBUFFER_TILE_SIZE - 1) / ZBUFFER_TILE_SIZE;
+	_tilesY = (height + ZBUFFER_TILE_SIZE - 1) / ZBUFFER_TILE_SIZE;
+
+	delete[] _tiles;
+	_tiles = new uint8[_tilesX * _tilesY];
+	memset(_tiles, 0, _tilesX * _tilesY);
+	_count = 0;
+	_next = 0;
+}
 
-	_rects[_count++] = rect;
-	if (_count > 1) {
-		extendExisting();
+void ZBufferDirtyTiles::reset() {
+	if (_count) {
+		memset(_tiles, 0, _tilesX * _tilesY);
 	}
-	return true;
+	_count = 0;
+	_next = 0;
 }
 
-void ZBufferDirtyRects::extendExisting() {
-	if (_count < 2)
+void ZBufferDirtyTiles::add(Common::Rect rect) {
+	if (rect.isEmpty()) {
 		return;
+	}
 
-	Common::Rect last = _rects[_count - 1];
-
-	int i;
-	for (i = 0; i != _count - 1; ++i) {
-		if (last.intersects(_rects[i])) {
-			_rects[i].extend(last);
-			_count--;
-			break;
+	int x1 = rect.left / ZBUFFER_TILE_SIZE;
+	int y1 = rect.top / ZBUFFER_TILE_SIZE;
+	int x2 = (rect.right - 1) / ZBUFFER_TILE_SIZE;
+	int y2 = (rect.bottom - 1) / ZBUFFER_TILE_SIZE;
+
+	for (int y = y1; y <= y2; ++y) {
+		uint8 *tile = &_tiles[y * _tilesX + x1];
+		for (int x = x1; x <= x2; ++x, ++tile) {
+			if (!*tile) {
+				*tile = 1;
+				++_count;
+			}
 		}
 	}
 }
 
-int ZBufferDirtyRects::getCount() const {
+int ZBufferDirtyTiles::getCount() const {
 	return _count;
 }
 
-bool ZBufferDirtyRects::popRect(Common::Rect *rect) {
-	if (_count == 0)
+bool ZBufferDirtyTiles::popRect(Common::Rect *rect) {
+	if (_count == 0) {
 		return false;
+	}
 
-	*rect = _rects[--_count];
+	int end = _tilesX * _tilesY;
+	while (_next < end && !_tiles[_next]) {
+		++_next;
+	}
+	assert(_next < end);
+
+	// Extend over the following dirty tiles on the same row
+	int y = _next / _tilesX;
+	int x1 = _next % _tilesX;
+	int x2 = x1;
+	do {
+		_tiles[_next++] = 0;
+		--_count;
+		++x2;
+	} while (x2 < _tilesX && _tiles[_next]);
+
+	rect->left   = x1 * ZBUFFER_TILE_SIZE;
+	rect->top    = y * ZBUFFER_TILE_SIZE;
+	rect->right  = MIN(x2 * ZBUFFER_TILE_SIZE, _width);
+	rect->bottom = MIN((y + 1) * ZBUFFER_TILE_SIZE, _height);
+
+	if (_count == 0) {
+		_next = 0;
+	}
 	return true;
 }
 
 ZBuffer::ZBuffer() {
 	_zbuf1 = nullptr;
 	_zbuf2 = nullptr;
-	_dirtyRects = new ZBufferDirtyRects();
+	_dirtyTiles = new ZBufferDirtyTiles();
 	_width = 0;
 	_height = 0;
 	enable();
@@ -83,7 +132,7 @@ ZBuffer::ZBuffer() {
 ZBuffer::~ZBuffer() {
 	delete[] _zbuf2;
 	delete[] _zbuf1;
-	delete _dirtyRects;
+	delete _dirtyTiles;
 }
 
 void ZBuffer::init(int width, int height) {
@@ -92,6 +141,8 @@ void ZBuffer::init(int width, int height) {
 
 	_zbuf1 = new uint16[width * height];
 	_zbuf2 = new uint16[width * height];
+
+	_dirtyTiles->init(width, height);
 }
 
 static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen) {
@@ -171,6 +222,23 @@ bool ZBuffer::decodeData(const uint8 *data, int size) {
 	return true;
 }
 
+bool ZBuffer::setData(const uint16 *data, int width, int height) {
+	if (_disabled) {
+		return false;
+	}
+
+	if (width != _width || height != _height) {
+		warning("zbuffer size mismatch (%d, %d) != (%d, %d)", _width, _height, width, height);
+		return false;
+	}
+
+	resetUpdates();
+	memcpy(_zbuf1, data, 2 * _width * _height);
+	memcpy(_zbuf2, data, 2 * _width * _height);
+
+	return true;
+}
+
 uint16 *ZBuffer::getData() const {
 	return _zbuf2;
 }
@@ -200,19 +268,19 @@ void ZBuffer::mark(Common::Rect rect) {
 
 	// debug("mark %d, %d, %d, %d", rect.top, rect.right, rect.bottom, rect.left);
 	rect.clip(_width, _height);
-	_dirtyRects->add(rect);
+	_dirtyTiles->add(rect);
 }
 
 void ZBuffer::clean() {
 	Common::Rect rect;
-	while (_dirtyRects->popRect(&rect)) {
+	while (_dirtyTiles->popRect(&rect)) {
 		// debug("blit %d, %d, %d, %d", rect.top, rect.right, rect.bottom, rect.left);
 		blit(rect);
 	}
 }
 
 void ZBuffer::resetUpdates() {
-	_dirtyRects->reset();
+	_dirtyTiles->reset();
 }
 
 void ZBuffer::disable() {
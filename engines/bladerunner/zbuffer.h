@@ -29,20 +29,28 @@
 
 namespace BladeRunner {
 
-#define MAX_DIRTY_RECTS 20
+#define ZBUFFER_TILE_SIZE 16
 
-class ZBufferDirtyRects {
-	int          _count;
-	Common::Rect _rects[MAX_DIRTY_RECTS];
+/**
+ * Records which tiles of the z-buffer were drawn over, and returns them as
+ * rects covering horizontal runs of dirty tiles.
+ */
+class ZBufferDirtyTiles {
+	int    _width;
+	int    _height;
+	int    _tilesX;
+	int    _tilesY;
+	uint8 *_tiles;
+	int    _count;
+	int    _next;
 
 public:
-	ZBufferDirtyRects() :
-		_count(0)
-	{}
+	ZBufferDirtyTiles();
+	~ZBufferDirtyTiles();
 
+	void init(int width, int height);
 	void reset();
-	bool add(Common::Rect rect);
-	void extendExisting();
+	void add(Common::Rect rect);
 	int  getCount() const;
 	bool popRect(Common::Rect *rect);
 };
@@ -54,7 +62,7 @@ class ZBuffer {
 	uint16 *_zbuf1;
 	uint16 *_zbuf2;
 
-	ZBufferDirtyRects *_dirtyRects;
+	ZBufferDirtyTiles *_dirtyTiles;
 
 	bool _disabled;
 
@@ -64,6 +72,7 @@ public:
 
 	void init(int width, int height);
 	bool decodeData(const uint8 *data, int size);
+	bool setData(const uint16 *data, int width, int height);
 
 	uint16 *getData() const;
 	uint16 getZValue(int x, int y) const;
@@ -23,6 +23,8 @@
 #include "cryomni3d/omni3d.h"
 
 #include "common/rect.h"
+#include "common/system.h"
+#include "common/taskscheduler.h"
 
 namespace CryOmni3D {
 
@@ -62,6 +64,12 @@ void Omni3DManager::init(double hfov) {
 		}
 	}
 
+	_betaCoords = 0.;
+	_betaCoordsValid = false;
+	_coordsAlpha = 0.;
+	_coordsBeta = 0.;
+	_imageCoordsValid = false;
+
 	_surface.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
 	clearConstraints();
 }
@@ -140,43 +148,132 @@ void Omni3DManager::updateImageCoords() {
 		_beta = -0.9 * _vfov;
 	}
 
+	_dirtyCoords = false;
+
+	// Nothing moved, so the image stays the same
+	if (_imageCoordsValid && _alpha == _coordsAlpha && _beta == _coordsBeta) {
+		return;
+	}
+
+	// Turning around only changes alpha, which just offsets the
+	// coordinates, so the trigonometry is only redone when beta changes
+	if (!_betaCoordsValid || _beta != _betaCoords) {
+		updateBetaCoords();
+	}
+
 	double tmp = (2048 * 65536) - 2048 * 65536 / (2. * M_PI) * _alpha;
 
 	uint k = 0;
 	for (uint i = 0; i < 31; i++) {
-		double v11 = _anglesH[i] + _beta;
-		double v26 = sin(v11);
-		double v25 = cos(v11) * _hypothenusesH[i];
-
 		uint offset = 80;
 		uint j;
 		for (j = 0; j < 20; j++) {
-			double v16 = atan2(_oppositeV[j], v25);
-			double v17 = v16 * _helperValue;
-			double v18 = (384 * 65536) - _squaresCoords[i][j] * v26;
+			double v17 = _hCoords[i][j];
 
 			k += 2;
 			_imageCoords[k + 0] = (int)(tmp + v17);
 			_imageCoords[k + offset + 0] = (int)(tmp - v17);
-			_imageCoords[k + 1] = (int) v18;
-			_imageCoords[k + offset + 1] = (int) v18;
+			_imageCoords[k + 1] = _vCoords[i][j];
+			_imageCoords[k + offset + 1] = _vCoords[i][j];
 
 			offset -= 4;
 		}
 
-		double v19 = atan2(_oppositeV[j], v25);
+		double v19 = _hCoords[i][j];
 
 		k += 2;
 		_imageCoords[k + 0] = (int)((2048.*65536.) - (_alpha - v19) * _helperValue);
-		_imageCoords[k + 1] = (int)((384.*65536.) - _squaresCoords[i][j] * v26);
+		_imageCoords[k + 1] = _vCoords[i][j];
 
 		k += 40;
 	}
 
-	_dirtyCoords = false;
+	_coordsAlpha = _alpha;
+	_coordsBeta = _beta;
+	_imageCoordsValid = true;
 	_dirty = true;
 }
 
+void Omni3DManager::updateBetaCoords() {
+	for (uint i = 0; i < 31; i++) {
+		double v11 = _anglesH[i] + _beta;
+		double v26 = sin(v11);
+		double v25 = cos(v11) * _hypothenusesH[i];
+
+		uint j;
+		for (j = 0; j < 20; j++) {
+			double v16 = atan2(_oppositeV[j], v25);
+			_hCoords[i][j] = v16 * _helperValue;
+			_vCoords[i][j] = (int)((384 * 65536) - _squaresCoords[i][j] * v26);
+		}
+
+		// The last column is offset by alpha differently
+		_hCoords[i][j] = atan2(_oppositeV[j], v25);
+		_vCoords[i][j] = (int)((384.*65536.) - _squaresCoords[i][j] * v26);
+	}
+
+	_betaCoords = _beta;
+	_betaCoordsValid = true;
+}
+
+struct Omni3DManager::DrawSquaresBody : public Common::ParallelForBody {
+	Omni3DManager *_manager;
+
+	DrawSquaresBody(Omni3DManager *manager) : _manager(manager) {}
+
+	void run(uint begin, uint end) {
+		_manager->drawSquaresRows(begin, end);
+	}
+};
+
+void Omni3DManager::drawSquaresRows(uint begin, uint end) {
+	const byte *src = (const byte *)_sourceSurface->getBasePtr(0, 0);
+
+	for (uint i = begin; i < end; i++) {
+		uint off = 2 + i * 82;
+		byte *dst = (byte *)_surface.getBasePtr(0, i * 16);
+
+		for (uint j = 0; j < 40; j++) {
+			int x1  = (_imageCoords[off + 2] - _imageCoords[off + 0]) >> 4;
+			int y1  = (_imageCoords[off + 3] - _imageCoords[off + 1]) >> 4;
+			int x1_ = (_imageCoords[off + 82 + 2] - _imageCoords[off + 82 + 0]) >> 4;
+			int y1_ = (_imageCoords[off + 82 + 3] - _imageCoords[off + 82 + 1]) >> 4;
+
+			int dx1 = (x1_ - x1) >> 10;
+			int dy1 = (y1_ - y1) >> 15;
+
+			y1 >>= 5;
+
+			int dx2  = (_imageCoords[off + 82 + 0] - _imageCoords[off + 0]) >> 4;
+			int dy2  = (_imageCoords[off + 82 + 1] - _imageCoords[off + 1]) >> 9;
+			int x2 = (((_imageCoords[off + 0] >> 0) * 2) + dx2) >> 1;
+			int y2 = (((_imageCoords[off + 1] >> 5) * 2) + dy2) >> 1;
+
+			for (uint y = 0; y < 16; y++) {
+				uint px = (x2 * 2 + x1) * 16;
+				uint py = (y2 * 2 + y1) / 2;
+				uint deltaX = x1 * 32;
+				uint deltaY = y1;
+
+				for (uint x = 0; x < 16; x++) {
+					uint srcOff = (py & 0x1ff800) | (px >> 21);
+					dst[x] = src[srcOff];
+					px += deltaX;
+					py += deltaY;
+				}
+				dst += 640;
+
+				x1 += dx1;
+				y1 += dy1;
+				x2 += dx2;
+				y2 += dy2;
+			}
+			dst -= 16 * 640 - 16;
+			off += 2;
+		}
+	}
+}
+
 const Graphics::Surface *Omni3DManager::getSurface() {
 	if (!_sourceSurface) {
 		return nullptr;
@@ -187,52 +284,9 @@ const Graphics::Surface *Omni3DManager::getSurface() {
 	}
 
 	if (_dirty) {
-		uint off = 2;
-		byte *dst = (byte *)_surface.getBasePtr(0, 0);
-		const byte *src = (const byte *)_sourceSurface->getBasePtr(0, 0);
-
-		for (uint i = 0; i < 30; i++) {
-			for (uint j = 0; j < 40; j++) {
-				int x1  = (_imageCoords[off + 2] - _imageCoords[off + 0]) >> 4;
-				int y1  = (_imageCoords[off + 3] - _imageCoords[off + 1]) >> 4;
-				int x1_ = (_imageCoords[off + 82 + 2] - _imageCoords[off + 82 + 0]) >> 4;
-				int y1_ = (_imageCoords[off + 82 + 3] - _imageCoords[off + 82 + 1]) >> 4;
-
-				int dx1 = (x1_ - x1) >> 10;
-				int dy1 = (y1_ - y1) >> 15;
-
-				y1 >>= 5;
-
-				int dx2  = (_imageCoords[off + 82 + 0] - _imageCoords[off + 0]) >> 4;
-				int dy2  = (_imageCoords[off + 82 + 1] - _imageCoords[off + 1]) >> 9;
-				int x2 = (((_imageCoords[off + 0] >> 0) * 2) + dx2) >> 1;
-				int y2 = (((_imageCoords[off + 1] >> 5) * 2) + dy2) >> 1;
-
-				for (uint y = 0; y < 16; y++) {
-					uint px = (x2 * 2 + x1) * 16;
-					uint py = (y2 * 2 + y1) / 2;
-					uint deltaX = x1 * 32;
-					uint deltaY = y1;
-
-					for (uint x = 0; x < 16; x++) {
-						uint srcOff = (py & 0x1ff800) | (px >> 21);
-						dst[x] = src[srcOff];
-						px += deltaX;
-						py += deltaY;
-					}
-					dst += 640;
-
-					x1 += dx1;
-					y1 += dy1;
-					x2 += dx2;
-					y2 += dy2;
-				}
-				dst -= 16 * 640 - 16;
-				off += 2;
-			}
-			dst += 15 * 640;
-			off += 2;
-		}
+		// Each row of 16x16 squares only reads the coordinates at its corners
+		DrawSquaresBody body(this);
+		g_system->getTaskScheduler()->parallelFor(0, 30, body, 5);
 
 		_dirty = false;
 	}
@@ -56,6 +56,10 @@ public:
 
 private:
 	void updateImageCoords();
+	void updateBetaCoords();
+	void drawSquaresRows(uint begin, uint end);
+
+	struct DrawSquaresBody;
 
 	double _vfov;
 
@@ -72,6 +76,17 @@ private:
 	double _oppositeV[21];
 	double _helperValue;
 
+	// The parts of the image coordinates only depending on beta, for the
+	// beta they were last computed with and only valid when _betaCoordsValid is set
+	double _betaCoords;
+	bool _betaCoordsValid;
+	double _hCoords[31][21];
+	int _vCoords[31][21];
+
+	// The angles _imageCoords were last computed with
+	double _coordsAlpha, _coordsBeta;
+	bool _imageCoordsValid;
+
 	bool _dirty;
 	bool _dirtyCoords;
 	const Graphics::Surface *_sourceSurface;
@@ -31,6 +31,7 @@
 
 #include "director/director.h"
 #include "director/archive.h"
+#include "director/images.h"
 #include "director/sound.h"
 #include "director/lingo/lingo.h"
 
@@ -59,6 +60,7 @@ DirectorEngine::DirectorEngine(OSystem *syst, const DirectorGameDescription *gam
 	_sharedScore = nullptr;
 
 	_currentScore = nullptr;
+	_bitmapCache = new BitmapCache();
 	_soundManager = nullptr;
 	_currentPalette = nullptr;
 	_currentPaletteLength = 0;
@@ -104,6 +106,8 @@ DirectorEngine::~DirectorEngine() {
 
 	delete _currentScore;
 
+	delete _bitmapCache;
+
 	cleanupMainArchive();
 
 	delete _soundManager;
@@ -54,6 +54,7 @@ class DirectorSound;
 class Lingo;
 class Score;
 class Cast;
+class BitmapCache;
 
 enum {
 	kDebugLingoExec		= 1 << 0,
@@ -113,6 +114,7 @@ public:
 	Common::HashMap<int, Common::SeekableSubReadStreamEndian *> *getSharedBMP() const { return _sharedBMP; }
 	Common::HashMap<int, Common::SeekableSubReadStreamEndian *> *getSharedSTXT() const { return _sharedSTXT; }
 	Common::HashMap<int, CastType> *getSharedCastTypes();
+	BitmapCache *getBitmapCache() const { return _bitmapCache; }
 
 	Common::HashMap<Common::String, Score *> *_movies;
 
@@ -159,6 +161,7 @@ private:
 	Lingo *_lingo;
 
 	Score *_currentScore;
+	BitmapCache *_bitmapCache;
 
 	Graphics::MacPatterns _director3Patterns;
 	Graphics::MacPatterns _director3QuickDrawPatterns;
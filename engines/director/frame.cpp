@@ -60,6 +60,8 @@ Frame::Frame(DirectorEngine *vm) {
 
 	_palette = NULL;
 
+	_hasUnclippedSprites = false;
+
 	_sprites.resize(CHANNEL_COUNT + 1);
 
 	for (uint16 i = 0; i < _sprites.size(); i++) {
@@ -84,6 +86,8 @@ Frame::Frame(const Frame &frame) {
 	_blend = frame._blend;
 	_palette = new PaletteInfo();
 
+	_hasUnclippedSprites = false;
+
 	debugC(1, kDebugLoading, "Frame. action: %d transType: %d transDuration: %d", _actionId, _transType, _transDuration);
 
 	_sprites.resize(CHANNEL_COUNT + 1);
@@ -95,6 +99,8 @@ Frame::Frame(const Frame &frame) {
 
 Frame::~Frame() {
 	delete _palette;
+
+	clearDrawRects();
 }
 
 void Frame::readChannel(Common::SeekableSubReadStreamEndian &stream, uint16 offset, uint16 size) {
@@ -403,9 +409,28 @@ void Frame::readSprite(Common::SeekableSubReadStreamEndian &stream, uint16 offse
 }
 
 void Frame::prepareFrame(Score *score) {
-	_drawRects.clear();
-	renderSprites(*score->_surface, false);
-	renderSprites(*score->_trailSurface, true);
+	Common::Array<Common::Rect> dirtyRects;
+	bool redrawAll = !findDirtyRects(score, dirtyRects);
+
+	if (redrawAll) {
+		score->_surface->blitFrom(*score->_trailSurface);
+
+		_clipRect = score->_surface->getBounds();
+		clearDrawRects();
+		renderSprites(*score->_surface, false);
+		renderSprites(*score->_trailSurface, true);
+	} else {
+		// Draw the damaged areas from scratch. Every pass lays out all the
+		// channels, as the ink effects depend on the sprites underneath.
+		for (uint i = 0; i < dirtyRects.size(); i++) {
+			const Common::Rect &r = dirtyRects[i];
+			score->_surface->blitFrom(*score->_trailSurface, r, Common::Point(r.left, r.top));
+
+			_clipRect = r;
+			clearDrawRects();
+			renderSprites(*score->_surface, false);
+		}
+	}
 
 	if (_transType != 0)
 		// TODO Handle changing area case
@@ -415,7 +440,71 @@ void Frame::prepareFrame(Score *score) {
 		playSoundChannel();
 	}
 
-	g_system->copyRectToScreen(score->_surface->getPixels(), score->_surface->pitch, 0, 0, score->_surface->getBounds().width(), score->_surface->getBounds().height());
+	if (redrawAll) {
+		g_system->copyRectToScreen(score->_surface->getPixels(), score->_surface->pitch, 0, 0, score->_surface->getBounds().width(), score->_surface->getBounds().height());
+	} else {
+		for (uint i = 0; i < dirtyRects.size(); i++) {
+			const Common::Rect &r = dirtyRects[i];
+			g_system->copyRectToScreen(score->_surface->getBasePtr(r.left, r.top), score->_surface->pitch, r.left, r.top, r.width(), r.height());
+		}
+	}
+}
+
+static void addDirtyRect(Common::Array<Common::Rect> &dirtyRects, Common::Rect rect, const Common::Rect &stage) {
+	rect = rect.findIntersectingRect(stage);
+	if (rect.isEmpty())
+		return;
+
+	// Merge overlapping areas, so that no pixel is drawn twice
+	for (uint i = 0; i < dirtyRects.size(); i++) {
+		if (dirtyRects[i].intersects(rect)) {
+			rect.extend(dirtyRects[i]);
+			dirtyRects.remove_at(i);
+			i = (uint)-1;
+		}
+	}
+
+	dirtyRects.push_back(rect);
+}
+
+bool Frame::findDirtyRects(Score *score, Common::Array<Common::Rect> &dirtyRects) {
+	// Lay out the sprites without drawing them, to find out where each
+	// channel goes
+	_clipRect = Common::Rect();
+	_hasUnclippedSprites = false;
+	_spriteBounds.clear();
+	_spriteBounds.resize(CHANNEL_COUNT);
+	clearDrawRects();
+	renderSprites(*score->_surface, false);
+
+	// Transitions and trails work on the whole stage
+	bool partial = score->_stageValid && _transType == 0 && !_hasUnclippedSprites &&
+		score->_channelStates.size() == CHANNEL_COUNT;
+
+	bool hasTrails = false;
+	for (uint16 i = 0; i < CHANNEL_COUNT; i++) {
+		if (_sprites[i]->_enabled && _sprites[i]->_trails != 0)
+			hasTrails = true;
+	}
+
+	const Common::Rect stage = score->_surface->getBounds();
+
+	score->_channelStates.resize(CHANNEL_COUNT);
+	for (uint16 i = 0; i < CHANNEL_COUNT; i++) {
+		SpriteRenderState state(*_sprites[i], _spriteBounds[i], score->_currentMouseDownSpriteId == i);
+
+		if (partial && state != score->_channelStates[i]) {
+			addDirtyRect(dirtyRects, score->_channelStates[i].bounds, stage);
+			addDirtyRect(dirtyRects, state.bounds, stage);
+		}
+
+		score->_channelStates[i] = state;
+	}
+
+	// Sprites drawn on the trail surface show up on the next frame's stage
+	score->_stageValid = !hasTrails;
+
+	return partial && !hasTrails;
 }
 
 void Frame::playSoundChannel() {
@@ -641,12 +730,39 @@ void Frame::addDrawRect(uint16 spriteId, Common::Rect &rect) {
 	_drawRects.push_back(fi);
 }
 
+void Frame::clearDrawRects() {
+	for (uint i = 0; i < _drawRects.size(); i++)
+		delete _drawRects[i];
+
+	_drawRects.clear();
+}
+
+void Frame::addSpriteBounds(uint16 spriteId, const Common::Rect &rect) {
+	if (spriteId >= _spriteBounds.size() || rect.isEmpty())
+		return;
+
+	if (_spriteBounds[spriteId].isEmpty())
+		_spriteBounds[spriteId] = rect;
+	else
+		_spriteBounds[spriteId].extend(rect);
+}
+
 void Frame::renderShape(Graphics::ManagedSurface &surface, uint16 spriteId) {
 	Common::Rect shapeRect = Common::Rect(_sprites[spriteId]->_startPoint.x,
 		_sprites[spriteId]->_startPoint.y,
 		_sprites[spriteId]->_startPoint.x + _sprites[spriteId]->_width,
 		_sprites[spriteId]->_startPoint.y + _sprites[spriteId]->_height);
 
+	// Nothing of the shape is drawn, so don't build it
+	if (!shapeRect.intersects(_clipRect)) {
+		if (_vm->getVersion() <= 3 && _sprites[spriteId]->_spriteType == 0x0c)
+			_sprites[spriteId]->_ink = kInkTypeReverse;
+
+		addDrawRect(spriteId, shapeRect);
+		addSpriteBounds(spriteId, shapeRect);
+		return;
+	}
+
 	Graphics::ManagedSurface tmpSurface;
 	tmpSurface.create(shapeRect.width(), shapeRect.height(), Graphics::PixelFormat::createFormatCLUT8());
 	if (_vm->getVersion() <= 3 && _sprites[spriteId]->_spriteType == 0x0c) {
@@ -674,6 +790,9 @@ void Frame::renderButton(Graphics::ManagedSurface &surface, uint16 spriteId) {
 	uint16 castId = _sprites[spriteId]->_castId;
 	ButtonCast *button = _vm->getCurrentScore()->_loadedButtons->getVal(castId);
 
+	// The button outlines are drawn straight onto the stage
+	_hasUnclippedSprites = true;
+
 	uint32 rectLeft = button->initialRect.left;
 	uint32 rectTop = button->initialRect.top;
 
@@ -695,13 +814,16 @@ void Frame::renderButton(Graphics::ManagedSurface &surface, uint16 spriteId) {
 	case kTypeCheckBox:
 		// Magic numbers: checkbox square need to move left about 5px from text and 12px side size (D4)
 		_rect = Common::Rect(x - 17, y, x + 12, y + 12);
-		surface.frameRect(_rect, 0);
+		if (!_clipRect.isEmpty())
+			surface.frameRect(_rect, 0);
 		addDrawRect(spriteId, _rect);
 		break;
 	case kTypeButton: {
 			_rect = Common::Rect(x, y, x + width, y + height + 3);
-			Graphics::MacPlotData pd(&surface, &_vm->getMacWindowManager()->getPatterns(), Graphics::MacGUIConstants::kPatternSolid, 1, Graphics::kColorWhite);
-			Graphics::drawRoundRect(_rect, 4, 0, false, Graphics::macDrawPixel, &pd);
+			if (!_clipRect.isEmpty()) {
+				Graphics::MacPlotData pd(&surface, &_vm->getMacWindowManager()->getPatterns(), Graphics::MacGUIConstants::kPatternSolid, 1, Graphics::kColorWhite);
+				Graphics::drawRoundRect(_rect, 4, 0, false, Graphics::macDrawPixel, &pd);
+			}
 			addDrawRect(spriteId, _rect);
 		}
 		break;
@@ -712,29 +834,46 @@ void Frame::renderButton(Graphics::ManagedSurface &surface, uint16 spriteId) {
 }
 
 void Frame::inkBasedBlit(Graphics::ManagedSurface &targetSurface, const Graphics::Surface &spriteSurface, uint16 spriteId, Common::Rect drawRect) {
+	// Blits cover the sprite surface, the ink effects span the draw rectangle
+	Common::Rect bounds(drawRect.left, drawRect.top, drawRect.left + MAX<int>(spriteSurface.w, drawRect.width()), drawRect.top + spriteSurface.h);
+	addSpriteBounds(spriteId, bounds);
+
+	// Only the part within the clip rectangle is drawn, in sprite coordinates
+	Common::Rect area = bounds.findIntersectingRect(_clipRect.findIntersectingRect(targetSurface.getBounds()));
+	if (area.isEmpty())
+		return;
+	area.translate(-drawRect.left, -drawRect.top);
+
+	Common::Rect blitArea = area.findIntersectingRect(Common::Rect(spriteSurface.w, spriteSurface.h));
+	Common::Point blitPos(drawRect.left + blitArea.left, drawRect.top + blitArea.top);
+	Common::Rect inkArea = area.findIntersectingRect(Common::Rect(drawRect.width(), spriteSurface.h));
+
 	switch (_sprites[spriteId]->_ink) {
 	case kInkTypeCopy:
-		targetSurface.blitFrom(spriteSurface, Common::Point(drawRect.left, drawRect.top));
+		if (!blitArea.isEmpty())
+			targetSurface.blitFrom(spriteSurface, blitArea, blitPos);
 		break;
 	case kInkTypeTransparent:
 		// FIXME: is it always white (last entry in pallette)?
-		targetSurface.transBlitFrom(spriteSurface, Common::Point(drawRect.left, drawRect.top), _vm->getPaletteColorCount() - 1);
+		if (!blitArea.isEmpty())
+			targetSurface.transBlitFrom(spriteSurface, blitArea, blitPos, _vm->getPaletteColorCount() - 1);
 		break;
 	case kInkTypeBackgndTrans:
-		drawBackgndTransSprite(targetSurface, spriteSurface, drawRect);
+		drawBackgndTransSprite(targetSurface, spriteSurface, drawRect, inkArea);
 		break;
 	case kInkTypeMatte:
-		drawMatteSprite(targetSurface, spriteSurface, drawRect);
+		drawMatteSprite(targetSurface, spriteSurface, drawRect, inkArea);
 		break;
 	case kInkTypeGhost:
-		drawGhostSprite(targetSurface, spriteSurface, drawRect);
+		drawGhostSprite(targetSurface, spriteSurface, drawRect, inkArea);
 		break;
 	case kInkTypeReverse:
-		drawReverseSprite(targetSurface, spriteSurface, drawRect);
+		drawReverseSprite(targetSurface, spriteSurface, drawRect, inkArea);
 		break;
 	default:
 		warning("Unhandled ink type %d", _sprites[spriteId]->_ink);
-		targetSurface.blitFrom(spriteSurface, Common::Point(drawRect.left, drawRect.top));
+		if (!blitArea.isEmpty())
+			targetSurface.blitFrom(spriteSurface, blitArea, blitPos);
 		break;
 	}
 }
@@ -838,7 +977,17 @@ void Frame::renderText(Graphics::ManagedSurface &surface, uint16 spriteId, Commo
 		break;
 	}
 
-	Graphics::ManagedSurface textWithFeatures(width + (borderSize * 2) + boxShadow + textShadow, height + borderSize + boxShadow + textShadow);
+	int featuresWidth = width + (borderSize * 2) + boxShadow + textShadow;
+	int featuresHeight = height + borderSize + boxShadow + textShadow;
+
+	// Nothing of the text is drawn, so don't build it
+	Common::Rect textBounds(x, y, x + MAX(featuresWidth, width), y + featuresHeight);
+	if (!textBounds.intersects(_clipRect)) {
+		addSpriteBounds(spriteId, textBounds);
+		return;
+	}
+
+	Graphics::ManagedSurface textWithFeatures(featuresWidth, featuresHeight);
 	textWithFeatures.fillRect(Common::Rect(textWithFeatures.w, textWithFeatures.h), 0xff);
 
 	if (textSize == NULL && boxShadow > 0) {
@@ -861,14 +1010,14 @@ void Frame::renderText(Graphics::ManagedSurface &surface, uint16 spriteId, Commo
 	inkBasedBlit(surface, textWithFeatures, spriteId, Common::Rect(x, y, x + width, y + height));
 }
 
-void Frame::drawBackgndTransSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect) {
+void Frame::drawBackgndTransSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area) {
 	uint8 skipColor = _vm->getPaletteColorCount() - 1; // FIXME is it always white (last entry in pallette) ?
 
-	for (int ii = 0; ii < sprite.h; ii++) {
-		const byte *src = (const byte *)sprite.getBasePtr(0, ii);
-		byte *dst = (byte *)target.getBasePtr(drawRect.left, drawRect.top + ii);
+	for (int ii = area.top; ii < area.bottom; ii++) {
+		const byte *src = (const byte *)sprite.getBasePtr(area.left, ii);
+		byte *dst = (byte *)target.getBasePtr(drawRect.left + area.left, drawRect.top + ii);
 
-		for (int j = 0; j < drawRect.width(); j++) {
+		for (int j = area.left; j < area.right; j++) {
 			if (*src != skipColor)
 				*dst = *src;
 
@@ -878,13 +1027,13 @@ void Frame::drawBackgndTransSprite(Graphics::ManagedSurface &target, const Graph
 	}
 }
 
-void Frame::drawGhostSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect) {
+void Frame::drawGhostSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area) {
 	uint8 skipColor = _vm->getPaletteColorCount() - 1;
-	for (int ii = 0; ii < sprite.h; ii++) {
-		const byte *src = (const byte *)sprite.getBasePtr(0, ii);
-		byte *dst = (byte *)target.getBasePtr(drawRect.left, drawRect.top + ii);
+	for (int ii = area.top; ii < area.bottom; ii++) {
+		const byte *src = (const byte *)sprite.getBasePtr(area.left, ii);
+		byte *dst = (byte *)target.getBasePtr(drawRect.left + area.left, drawRect.top + ii);
 
-		for (int j = 0; j < drawRect.width(); j++) {
+		for (int j = area.left; j < area.right; j++) {
 			if ((getSpriteIDFromPos(Common::Point(drawRect.left + j, drawRect.top + ii)) != 0) && (*src != skipColor))
 				*dst = (_vm->getPaletteColorCount() - 1) - *src; // Oposite color
 
@@ -894,13 +1043,13 @@ void Frame::drawGhostSprite(Graphics::ManagedSurface &target, const Graphics::Su
 	}
 }
 
-void Frame::drawReverseSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect) {
+void Frame::drawReverseSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area) {
 	uint8 skipColor = _vm->getPaletteColorCount() - 1;
-	for (int ii = 0; ii < sprite.h; ii++) {
-		const byte *src = (const byte *)sprite.getBasePtr(0, ii);
-		byte *dst = (byte *)target.getBasePtr(drawRect.left, drawRect.top + ii);
+	for (int ii = area.top; ii < area.bottom; ii++) {
+		const byte *src = (const byte *)sprite.getBasePtr(area.left, ii);
+		byte *dst = (byte *)target.getBasePtr(drawRect.left + area.left, drawRect.top + ii);
 
-		for (int j = 0; j < drawRect.width(); j++) {
+		for (int j = area.left; j < area.right; j++) {
 			if ((getSpriteIDFromPos(Common::Point(drawRect.left + j, drawRect.top + ii)) != 0)) {
 				if (*src != skipColor) {
 					*dst = (*dst == *src ? (*src == 0 ? 0xff : 0) : *src);
@@ -914,7 +1063,7 @@ void Frame::drawReverseSprite(Graphics::ManagedSurface &target, const Graphics::
 	}
 }
 
-void Frame::drawMatteSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect) {
+void Frame::drawMatteSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area) {
 	// Like background trans, but all white pixels NOT ENCLOSED by coloured pixels are transparent
 	Graphics::Surface tmp;
 	tmp.copyFrom(sprite);
@@ -939,11 +1088,11 @@ void Frame::drawMatteSprite(Graphics::ManagedSurface &target, const Graphics::Su
 	if (whiteColor == -1) {
 		debugC(1, kDebugImages, "No white color for Matte image");
 
-		for (int yy = 0; yy < tmp.h; yy++) {
-			const byte *src = (const byte *)tmp.getBasePtr(0, yy);
-			byte *dst = (byte *)target.getBasePtr(drawRect.left, drawRect.top + yy);
+		for (int yy = area.top; yy < area.bottom; yy++) {
+			const byte *src = (const byte *)tmp.getBasePtr(area.left, yy);
+			byte *dst = (byte *)target.getBasePtr(drawRect.left + area.left, drawRect.top + yy);
 
-			for (int xx = 0; xx < drawRect.width(); xx++, src++, dst++)
+			for (int xx = area.left; xx < area.right; xx++, src++, dst++)
 				*dst = *src;
 		}
 	} else {
@@ -960,12 +1109,12 @@ void Frame::drawMatteSprite(Graphics::ManagedSurface &target, const Graphics::Su
 		}
 		ff.fillMask();
 
-		for (int yy = 0; yy < tmp.h; yy++) {
-			const byte *src = (const byte *)tmp.getBasePtr(0, yy);
-			const byte *mask = (const byte *)ff.getMask()->getBasePtr(0, yy);
-			byte *dst = (byte *)target.getBasePtr(drawRect.left, drawRect.top + yy);
+		for (int yy = area.top; yy < area.bottom; yy++) {
+			const byte *src = (const byte *)tmp.getBasePtr(area.left, yy);
+			const byte *mask = (const byte *)ff.getMask()->getBasePtr(area.left, yy);
+			byte *dst = (byte *)target.getBasePtr(drawRect.left + area.left, drawRect.top + yy);
 
-			for (int xx = 0; xx < drawRect.width(); xx++, src++, dst++, mask++)
+			for (int xx = area.left; xx < area.right; xx++, src++, dst++, mask++)
 				if (*mask == 0)
 					*dst = *src;
 		}
@@ -133,12 +133,15 @@ private:
 	void readMainChannels(Common::SeekableSubReadStreamEndian &stream, uint16 offset, uint16 size);
 	Image::ImageDecoder *getImageFrom(uint16 spriteId);
 	Common::String readTextStream(Common::SeekableSubReadStreamEndian *textStream, TextCast *textCast);
-	void drawBackgndTransSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect);
-	void drawMatteSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect);
-	void drawGhostSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect);
-	void drawReverseSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect);
+	void drawBackgndTransSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area);
+	void drawMatteSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area);
+	void drawGhostSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area);
+	void drawReverseSprite(Graphics::ManagedSurface &target, const Graphics::Surface &sprite, Common::Rect &drawRect, const Common::Rect &area);
 	void inkBasedBlit(Graphics::ManagedSurface &targetSurface, const Graphics::Surface &spriteSurface, uint16 spriteId, Common::Rect drawRect);
 	void addDrawRect(uint16 entityId, Common::Rect &rect);
+	void clearDrawRects();
+	void addSpriteBounds(uint16 spriteId, const Common::Rect &rect);
+	bool findDirtyRects(Score *score, Common::Array<Common::Rect> &dirtyRects);
 
 public:
 	byte _channelData[kChannelDataSize];
@@ -160,6 +163,14 @@ public:
 	Common::Array<Sprite *> _sprites;
 	Common::Array<FrameEntity *> _drawRects;
 	DirectorEngine *_vm;
+
+private:
+	// Drawing on the stage is limited to this area
+	Common::Rect _clipRect;
+	// The area each channel drew on
+	Common::Array<Common::Rect> _spriteBounds;
+	// Whether a sprite was drawn which can't be limited to the clip rectangle
+	bool _hasUnclippedSprites;
 };
 
 } // End of namespace Director
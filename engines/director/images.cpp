@@ -349,4 +349,88 @@ bool BITDDecoderV4::loadStream(Common::SeekableReadStream &stream) {
 	return true;
 }
 
+BitmapCache::BitmapCache(uint32 maxSize) {
+	_maxSize = maxSize;
+	_usedSize = 0;
+	_useClock = 0;
+}
+
+BitmapCache::~BitmapCache() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete i->_value.decoder;
+}
+
+Common::String BitmapCache::makeKey(const Common::String &fileName, uint32 tag, uint16 imgId, int w, int h, uint16 bitsPerPixel) {
+	return Common::String::format("%s:%s:%d:%dx%d:%d", fileName.c_str(), tag2str(tag), imgId, w, h, bitsPerPixel);
+}
+
+const Graphics::Surface *BitmapCache::acquire(const Common::String &key) {
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end())
+		return nullptr;
+
+	i->_value.useCount++;
+	i->_value.lastUse = ++_useClock;
+
+	debugC(4, kDebugImages, "BitmapCache: reusing %s", key.c_str());
+
+	return i->_value.decoder->getSurface();
+}
+
+const Graphics::Surface *BitmapCache::add(const Common::String &key, Image::ImageDecoder *decoder) {
+	const Graphics::Surface *surface = decoder->getSurface();
+
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		// Already decoded, which only happens when a cast loads the same
+		// image twice
+		delete decoder;
+		return acquire(key);
+	}
+
+	Entry entry;
+	entry.decoder = decoder;
+	entry.size = surface ? surface->pitch * surface->h : 0;
+	entry.useCount = 1;
+	entry.lastUse = ++_useClock;
+	_entries[key] = entry;
+	_usedSize += entry.size;
+
+	trim();
+
+	return surface;
+}
+
+void BitmapCache::release(const Graphics::Surface *surface) {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (i->_value.decoder->getSurface() == surface) {
+			assert(i->_value.useCount > 0);
+			i->_value.useCount--;
+			break;
+		}
+	}
+
+	trim();
+}
+
+void BitmapCache::trim() {
+	while (_usedSize > _maxSize) {
+		EntryMap::iterator oldest = _entries.end();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.useCount == 0 && (oldest == _entries.end() || i->_value.lastUse < oldest->_value.lastUse))
+				oldest = i;
+		}
+
+		// Everything left is in use
+		if (oldest == _entries.end())
+			return;
+
+		debugC(4, kDebugImages, "BitmapCache: dropping %s", oldest->_key.c_str());
+
+		_usedSize -= oldest->_value.size;
+		delete oldest->_value.decoder;
+		_entries.erase(oldest);
+	}
+}
+
 } // End of namespace Director
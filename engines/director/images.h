@@ -24,6 +24,7 @@
 #define DIRECTOR_IMAGES_H
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 #include "image/image_decoder.h"
 #include "image/codecs/bmp_raw.h"
@@ -101,6 +102,57 @@ private:
 	uint16 _bitsPerPixel;
 };
 
+/** The most memory the decoded bitmaps no movie uses may take */
+#define DIRECTOR_BITMAPCACHE_SIZE (16 * 1024 * 1024)
+
+/**
+ * Decoded cast bitmaps, kept across movies, so that going back to a movie
+ * or loading a cast again doesn't decode its bitmaps again. The bitmaps in
+ * use are kept, the least recently used others are dropped when they go
+ * over the memory limit.
+ */
+class BitmapCache {
+public:
+	BitmapCache(uint32 maxSize = DIRECTOR_BITMAPCACHE_SIZE);
+	~BitmapCache();
+
+	/**
+	 * The key of a bitmap. It names the cast file, the image resource and
+	 * everything the decoding depends on.
+	 */
+	static Common::String makeKey(const Common::String &fileName, uint32 tag, uint16 imgId, int w, int h, uint16 bitsPerPixel);
+
+	/**
+	 * Returns the decoded bitmap and marks it used until release() is
+	 * called, or returns nullptr when it isn't cached.
+	 */
+	const Graphics::Surface *acquire(const Common::String &key);
+
+	/**
+	 * Takes a decoded bitmap, which is marked used until release() is
+	 * called, and returns its surface.
+	 */
+	const Graphics::Surface *add(const Common::String &key, Image::ImageDecoder *decoder);
+
+	void release(const Graphics::Surface *surface);
+
+private:
+	struct Entry {
+		Image::ImageDecoder *decoder;
+		uint32 size;
+		uint useCount;
+		uint32 lastUse;
+	};
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void trim();
+
+	EntryMap _entries;
+	uint32 _maxSize;
+	uint32 _usedSize;
+	uint32 _useClock;
+};
+
 } // End of namespace Director
 
 #endif
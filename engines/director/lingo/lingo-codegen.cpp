@@ -208,11 +208,33 @@ void Lingo::cleanLocalVars() {
 }
 
 void Lingo::define(Common::String &name, int start, int nargs, Common::String *prefix, int end) {
-	if (prefix)
+	if (prefix) {
 		name = *prefix + "-" + name;
 
+		// Methods belong to the factory of an earlier script
+		if (_compiling)
+			_compiling->cacheable = false;
+	}
+
 	debugC(1, kDebugLingoCompile, "define(\"%s\", %d, %d, %d)", name.c_str(), start, _currentScript->size() - 1, nargs);
 
+	if (end == -1)
+		end = _currentScript->size();
+
+	ScriptData *defn = new ScriptData(&(*_currentScript)[start], end - start + 1);
+
+	installHandler(name, defn, nargs);
+
+	if (_compiling) {
+		CompiledHandler handler;
+		handler.name = name;
+		handler.defn = *defn;
+		handler.nargs = nargs;
+		_compiling->handlers.push_back(handler);
+	}
+}
+
+void Lingo::installHandler(Common::String &name, ScriptData *defn, int nargs) {
 	Symbol *sym = getHandler(name);
 	if (sym == NULL) { // Create variable if it was not defined
 		sym = new Symbol;
@@ -232,10 +254,7 @@ void Lingo::define(Common::String &name, int start, int nargs, Common::String *p
 		delete sym->u.defn;
 	}
 
-	if (end == -1)
-		end = _currentScript->size();
-
-	sym->u.defn = new ScriptData(&(*_currentScript)[start], end - start + 1);
+	sym->u.defn = defn;
 	sym->nargs = nargs;
 	sym->maxArgs = nargs;
 }
@@ -390,6 +409,10 @@ void Lingo::processIf(int elselabel, int endlabel) {
 void Lingo::codeFactory(Common::String &name) {
 	_currentFactory = name;
 
+	// The methods which follow depend on the factory
+	if (_compiling)
+		_compiling->cacheable = false;
+
 	Symbol *sym = new Symbol;
 
 	sym->name = name;
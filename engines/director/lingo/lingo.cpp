@@ -69,6 +69,8 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 
 	_localvars = NULL;
 
+	_compiling = NULL;
+
 	initEventHandlerTypes();
 
 	initBuiltIns();
@@ -79,6 +81,8 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 }
 
 Lingo::~Lingo() {
+	for (CompiledScriptHash::iterator it = _compiledScripts.begin(); it != _compiledScripts.end(); ++it)
+		delete it->_value;
 }
 
 const char *Lingo::findNextDefinition(const char *s) {
@@ -130,6 +134,42 @@ void Lingo::addCode(const char *code, ScriptType type, uint16 id) {
 	_scripts[type][id] = _currentScript;
 	_currentEntityId = id;
 
+	// Compiling a script only depends on its source, so unchanged scripts
+	// are not parsed again, e.g. when a movie is played once more
+	Common::String cacheKey = Common::String::format("%d:%d:", type, id) + code;
+	if (_compiledScripts.contains(cacheKey)) {
+		debugC(1, kDebugLingoCompile, "Using cached compilation");
+		useCompiledScript(*_compiledScripts[cacheKey]);
+		return;
+	}
+
+	_compiling = new CompiledScript;
+
+	compileCode(code);
+
+	if (_compiling->cacheable) {
+		_compiling->script = *_currentScript;
+		_compiling->hadError = _hadError;
+		_compiledScripts[cacheKey] = _compiling;
+	} else {
+		delete _compiling;
+	}
+	_compiling = NULL;
+}
+
+void Lingo::useCompiledScript(const CompiledScript &compiled) {
+	*_currentScript = compiled.script;
+
+	// Define the handlers once more, in the order the script defined them
+	for (uint i = 0; i < compiled.handlers.size(); i++) {
+		Common::String name = compiled.handlers[i].name;
+		installHandler(name, new ScriptData(compiled.handlers[i].defn), compiled.handlers[i].nargs);
+	}
+
+	_hadError = compiled.hadError;
+}
+
+void Lingo::compileCode(const char *code) {
 	_linenumber = _colnumber = 1;
 	_hadError = false;
 
@@ -137,6 +177,7 @@ void Lingo::addCode(const char *code, ScriptType type, uint16 id) {
 
 	if (!strncmp(code, "menu:", 5)) {
 		debugC(1, kDebugLingoCompile, "Parsing menu");
+		_compiling->cacheable = false;
 		parseMenu(code);
 
 		return;
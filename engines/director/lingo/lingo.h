@@ -155,6 +155,23 @@ struct CFrame {	/* proc/func call stack frame */
 	SymbolHash *localvars;
 };
 
+struct CompiledHandler {	/* handler defined while compiling a script */
+	Common::String name;
+	ScriptData defn;
+	int nargs;
+};
+
+struct CompiledScript {	/* compilation result of a script, for reuse */
+	ScriptData script;
+	Common::Array<CompiledHandler> handlers;
+	bool hadError;
+	bool cacheable;	/* whether the result depends on the source only */
+
+	CompiledScript() : hadError(false), cacheable(true) {}
+};
+
+typedef Common::HashMap<Common::String, CompiledScript *> CompiledScriptHash;
+
 class Lingo {
 public:
 	Lingo(DirectorEngine *vm);
@@ -175,6 +192,8 @@ public:
 
 private:
 	const char *findNextDefinition(const char *s);
+	void compileCode(const char *code);
+	void useCompiledScript(const CompiledScript &compiled);
 
 	// lingo-events.cpp
 private:
@@ -199,6 +218,7 @@ public:
 	Symbol *lookupVar(const char *name, bool create = true, bool putInGlobalList = false);
 	void cleanLocalVars();
 	void define(Common::String &s, int start, int nargs, Common::String *prefix = NULL, int end = -1);
+	void installHandler(Common::String &name, ScriptData *defn, int nargs);
 	void processIf(int elselabel, int endlabel);
 
 	int alignTypes(Datum &d1, Datum &d2);
@@ -552,6 +572,9 @@ private:
 
 	ScriptHash _scripts[kMaxScriptType + 1];
 
+	CompiledScriptHash _compiledScripts;
+	CompiledScript *_compiling;
+
 	SymbolHash _globalvars;
 	SymbolHash *_localvars;
 
@@ -64,6 +64,7 @@ Score::Score(DirectorEngine *vm) {
 	_vm = vm;
 	_surface = new Graphics::ManagedSurface;
 	_trailSurface = new Graphics::ManagedSurface;
+	_stageValid = false;
 	_lingo = _vm->getLingo();
 	_soundManager = _vm->getSoundManager();
 	_currentMouseDownSpriteId = 0;
@@ -228,6 +229,17 @@ void Score::loadSpriteImages(bool isSharedCast) {
 				tag = bitmapCast->children[0].tag;
 			}
 
+			int w = bitmapCast->initialRect.width(), h = bitmapCast->initialRect.height();
+
+			// Movies of the same title share casts, and can be played again
+			Common::String key = BitmapCache::makeKey(_movieArchive->getFileName(), tag, imgId, w, h, bitmapCast->bitsPerPixel);
+			const Graphics::Surface *cached = _vm->getBitmapCache()->acquire(key);
+			if (cached) {
+				bitmapCast->surface = cached;
+				_cachedBitmaps.push_back(cached);
+				continue;
+			}
+
 			Image::ImageDecoder *img = NULL;
 			Common::SeekableReadStream *pic = NULL;
 
@@ -236,11 +248,9 @@ void Score::loadSpriteImages(bool isSharedCast) {
 				if (_movieArchive->hasResource(MKTAG('D', 'I', 'B', ' '), imgId)) {
 					img = new DIBDecoder();
 					img->loadStream(*_movieArchive->getResource(MKTAG('D', 'I', 'B', ' '), imgId));
-					bitmapCast->surface = img->getSurface();
 				} else if (isSharedCast && _vm->getSharedDIB() != NULL && _vm->getSharedDIB()->contains(imgId)) {
 					img = new DIBDecoder();
 					img->loadStream(*_vm->getSharedDIB()->getVal(imgId));
-					bitmapCast->surface = img->getSurface();
 				}
 				break;
 			case MKTAG('B', 'I', 'T', 'D'):
@@ -258,7 +268,6 @@ void Score::loadSpriteImages(bool isSharedCast) {
 				break;
 			}
 
-			int w = bitmapCast->initialRect.width(), h = bitmapCast->initialRect.height();
 			debugC(4, kDebugImages, "id: %d, w: %d, h: %d, flags: %x, some: %x, unk1: %d, unk2: %d",
 				imgId, w, h, bitmapCast->flags, bitmapCast->someFlaggyThing, bitmapCast->unk1, bitmapCast->unk2);
 
@@ -272,10 +281,14 @@ void Score::loadSpriteImages(bool isSharedCast) {
 				}
 
 				img->loadStream(*pic);
-				bitmapCast->surface = img->getSurface();
-			} else {
+			} else if (img == NULL) {
 				warning("Image %d not found", imgId);
 			}
+
+			if (img != NULL) {
+				bitmapCast->surface = _vm->getBitmapCache()->add(key, img);
+				_cachedBitmaps.push_back(bitmapCast->surface);
+			}
 		}
 	}
 }
@@ -296,6 +309,9 @@ Score::~Score() {
 	delete _font;
 	delete _labels;
 	delete _loadedStxts;
+
+	for (uint i = 0; i < _cachedBitmaps.size(); i++)
+		_vm->getBitmapCache()->release(_cachedBitmaps[i]);
 }
 
 void Score::loadPalette(Common::SeekableSubReadStreamEndian &stream) {
@@ -1180,6 +1196,8 @@ void Score::startLoop() {
 	else
 		_trailSurface->clear(_stageColor);
 
+	_stageValid = false;
+
 	_currentFrame = 0;
 	_stopPlay = false;
 	_nextFrameTime = 0;
@@ -1199,9 +1217,6 @@ void Score::update() {
 	if (g_system->getMillis() < _nextFrameTime)
 		return;
 
-	_surface->clear();
-	_surface->copyFrom(*_trailSurface);
-
 	_lingo->executeImmediateScripts(_frames[_currentFrame]);
 
 	// Enter and exit from previous frame (Director 4)
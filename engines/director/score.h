@@ -28,6 +28,7 @@
 #include "director/archive.h"
 #include "director/cast.h"
 #include "director/images.h"
+#include "director/sprite.h"
 #include "director/stxt.h"
 
 namespace Graphics {
@@ -121,6 +122,10 @@ public:
 	Common::HashMap<uint16, Common::String> _fontMap;
 	Graphics::ManagedSurface *_surface;
 	Graphics::ManagedSurface *_trailSurface;
+	// Whether _surface holds the last frame drawn, so that only what changed needs drawing
+	bool _stageValid;
+	// The sprite channels as _surface shows them
+	Common::Array<SpriteRenderState> _channelStates;
 	Graphics::Font *_font;
 	Archive *_movieArchive;
 	Common::Rect _movieRect;
@@ -133,6 +138,8 @@ public:
 	Common::HashMap<int, TextCast *> *_loadedText;
 	//Common::HashMap<int, SoundCast *> _loadedSound;
 	Common::HashMap<int, BitmapCast *> *_loadedBitmaps;
+	// The bitmaps in use from the engine's bitmap cache
+	Common::Array<const Graphics::Surface *> _cachedBitmaps;
 	Common::HashMap<int, ShapeCast *> *_loadedShapes;
 	Common::HashMap<int, ScriptCast *> *_loadedScripts;
 	Common::HashMap<int, const Stxt *> *_loadedStxts;
@@ -125,4 +125,51 @@ Sprite::~Sprite() {
 		delete _buttonCast;
 }
 
+SpriteRenderState::SpriteRenderState() {
+	enabled = false;
+	castId = 0;
+	spriteType = 0;
+	ink = kInkTypeCopy;
+	trails = 0;
+	bitmapCast = nullptr;
+	shapeCast = nullptr;
+	textCast = nullptr;
+	buttonCast = nullptr;
+	width = 0;
+	height = 0;
+	backColor = 0;
+	foreColor = 0;
+	lineSize = 0;
+	mouseDown = false;
+}
+
+SpriteRenderState::SpriteRenderState(const Sprite &sprite, const Common::Rect &drawBounds, bool isMouseDown) {
+	enabled = sprite._enabled;
+	castId = sprite._castId;
+	spriteType = sprite._spriteType;
+	ink = sprite._ink;
+	trails = sprite._trails;
+	bitmapCast = sprite._bitmapCast;
+	shapeCast = sprite._shapeCast;
+	textCast = sprite._textCast;
+	buttonCast = sprite._buttonCast;
+	startPoint = sprite._startPoint;
+	width = sprite._width;
+	height = sprite._height;
+	backColor = sprite._backColor;
+	foreColor = sprite._foreColor;
+	lineSize = sprite._lineSize;
+	mouseDown = isMouseDown;
+	bounds = drawBounds;
+}
+
+bool SpriteRenderState::operator==(const SpriteRenderState &other) const {
+	return enabled == other.enabled && castId == other.castId && spriteType == other.spriteType &&
+		ink == other.ink && trails == other.trails && bitmapCast == other.bitmapCast &&
+		shapeCast == other.shapeCast && textCast == other.textCast && buttonCast == other.buttonCast &&
+		startPoint == other.startPoint && width == other.width && height == other.height &&
+		backColor == other.backColor && foreColor == other.foreColor && lineSize == other.lineSize &&
+		mouseDown == other.mouseDown && bounds == other.bounds;
+}
+
 } // End of namespace Director
@@ -148,6 +148,37 @@ public:
 	Common::String _editableText;
 };
 
+/**
+ * What a sprite channel looked like when the stage was last drawn, for
+ * finding the channels which changed since.
+ */
+struct SpriteRenderState {
+	SpriteRenderState();
+	SpriteRenderState(const Sprite &sprite, const Common::Rect &drawBounds, bool isMouseDown);
+
+	bool operator==(const SpriteRenderState &other) const;
+	bool operator!=(const SpriteRenderState &other) const { return !(*this == other); }
+
+	bool enabled;
+	uint16 castId;
+	byte spriteType;
+	InkType ink;
+	uint16 trails;
+	BitmapCast *bitmapCast;
+	ShapeCast *shapeCast;
+	TextCast *textCast;
+	ButtonCast *buttonCast;
+	Common::Point startPoint;
+	uint16 width;
+	uint16 height;
+	byte backColor;
+	byte foreColor;
+	byte lineSize;
+	bool mouseDown;
+	// The area the channel drew on
+	Common::Rect bounds;
+};
+
 } // End of namespace Director
 
 #endif
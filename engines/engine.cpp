@@ -32,6 +32,7 @@
 #include "engines/dialogs.h"
 #include "engines/util.h"
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/file.h"
@@ -40,6 +41,9 @@
 #include "common/error.h"
 #include "common/list.h"
 #include "common/memstream.h"
+#include "common/memtracker.h"
+#include "common/profiler.h"
+#include "common/savefile.h"
 #include "common/scummsys.h"
 #include "common/taskbar.h"
 #include "common/textconsole.h"
@@ -151,9 +155,12 @@ Engine::Engine(OSystem *syst)
 		_pauseStartTime(0),
 		_saveSlotToLoad(-1),
 		_engineStartTime(_system->getMillis()),
+		_lastFrameTime(0),
+		_frameStallThreshold(ConfMan.getInt("frame_stall_threshold")),
 		_mainMenuDialog(NULL) {
 
 	g_engine = this;
+	Common::MemoryTracker::setBudget(ConfMan.getInt("memory_budget") * 1024 * 1024);
 	Common::setErrorOutputFormatter(defaultOutputFormatter);
 	Common::setErrorHandler(defaultErrorHandler);
 
@@ -185,6 +192,10 @@ Engine::Engine(OSystem *syst)
 Engine::~Engine() {
 	_mixer->stopAll();
 
+	// Make sure background saves are on disk before returning to the launcher
+	if (_saveFileMan)
+		_saveFileMan->waitForAsyncSaves();
+
 	delete _mainMenuDialog;
 	g_engine = NULL;
 
@@ -508,6 +519,82 @@ void Engine::pauseEngine(bool pause) {
 		_engineStartTime += _system->getMillis() - _pauseStartTime;
 		_pauseStartTime = 0;
 	}
+
+	// The time spent paused is not a frame
+	_lastFrameTime = 0;
+}
+
+void FrameTimeHistogram::reset() {
+	memset(_buckets, 0, sizeof(_buckets));
+	_frameCount = 0;
+	_totalMillis = 0;
+	_maxMillis = 0;
+}
+
+void FrameTimeHistogram::addFrame(uint32 millis) {
+	_buckets[MIN<uint32>(millis, kMaxMillis)]++;
+	_frameCount++;
+	_totalMillis += millis;
+	_maxMillis = MAX(_maxMillis, millis);
+}
+
+uint32 FrameTimeHistogram::countFrames(uint32 minMillis, uint32 maxMillis) const {
+	uint32 count = 0;
+	for (uint32 i = minMillis; i <= MIN<uint32>(maxMillis, kMaxMillis); i++)
+		count += _buckets[i];
+	return count;
+}
+
+uint32 FrameTimeHistogram::getPercentile(uint percent) const {
+	const uint64 target = ((uint64)_frameCount * percent + 99) / 100;
+	uint64 count = 0;
+	for (uint32 i = 0; i < kMaxMillis; i++) {
+		count += _buckets[i];
+		if (count >= target)
+			return i;
+	}
+	return kMaxMillis;
+}
+
+#ifdef ENABLE_PROFILER
+static bool zoneLonger(const Common::Profiler::Zone &a, const Common::Profiler::Zone &b) {
+	return a.end - a.start > b.end - b.start;
+}
+#endif
+
+void Engine::frameShown() {
+	// Caches are only trimmed between frames, when nothing uses their entries
+	if (Common::MemoryTracker::isOverBudget()) {
+		const uint32 freed = Common::MemoryTracker::enforceBudget();
+		debug(2, "Over the memory budget, freed %u bytes: %s", freed, Common::MemoryTracker::formatUsage().c_str());
+	}
+
+	if (isPaused())
+		return;
+
+	const uint64 now = _system->getMicroseconds();
+	if (_lastFrameTime) {
+		const uint32 millis = (uint32)((now - _lastFrameTime) / 1000);
+		_frameTimes.addFrame(millis);
+
+		if (_frameStallThreshold && millis > _frameStallThreshold) {
+			debug(1, "Frame stall: %u ms", millis);
+#ifdef ENABLE_PROFILER
+			if (Common::Profiler::instance().isRecording()) {
+				Common::Array<Common::Profiler::Zone> zones = Common::Profiler::instance().getZones(_lastFrameTime, now);
+				Common::sort(zones.begin(), zones.end(), zoneLonger);
+				for (uint i = 0; i < zones.size() && i < 5; i++)
+					debug(1, "  %s: %u us", zones[i].name, (uint32)(zones[i].end - zones[i].start));
+			}
+#endif
+		}
+	}
+	_lastFrameTime = now;
+}
+
+void Engine::resetFrameTimes() {
+	_frameTimes.reset();
+	_lastFrameTime = 0;
 }
 
 void Engine::pauseEngineIntern(bool pause) {
@@ -661,6 +748,16 @@ bool Engine::canSaveGameStateCurrently() {
 	return false;
 }
 
+Common::Error Engine::saveGameStream(Common::WriteStream *stream) {
+	// Not supported by default
+	return Common::kWritingFailed;
+}
+
+Common::Error Engine::loadGameStream(Common::SeekableReadStream *stream) {
+	// Not supported by default
+	return Common::kReadingFailed;
+}
+
 void Engine::quitGame() {
 	Common::Event event;
 
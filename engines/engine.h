@@ -39,7 +39,9 @@ namespace Common {
 class Error;
 class EventManager;
 class SaveFileManager;
+class SeekableReadStream;
 class TimerManager;
+class WriteStream;
 class FSNode;
 }
 namespace GUI {
@@ -53,6 +55,42 @@ class Dialog;
 void GUIErrorMessage(const Common::String &msg);
 void GUIErrorMessageFormat(const char *fmt, ...) GCC_PRINTF(1, 2);
 
+/**
+ * Histogram of the time between frames, with one bucket per millisecond.
+ * Adding a frame is constant time, and percentiles are read by walking
+ * the buckets, so it can be kept up to date on every frame.
+ */
+class FrameTimeHistogram {
+public:
+	enum {
+		kMaxMillis = 250 ///< Longer frames are all counted in the last bucket
+	};
+
+	FrameTimeHistogram() { reset(); }
+
+	void reset();
+	void addFrame(uint32 millis);
+
+	uint32 getTotalFrames() const { return _frameCount; }
+	uint32 getAverageMillis() const { return _frameCount ? (uint32)(_totalMillis / _frameCount) : 0; }
+	uint32 getMaxMillis() const { return _maxMillis; }
+
+	/** Number of frames which took from minMillis to maxMillis ms, both included. */
+	uint32 countFrames(uint32 minMillis, uint32 maxMillis) const;
+
+	/**
+	 * Time in ms that the given percentage of frames did not exceed.
+	 * Frames longer than kMaxMillis count as kMaxMillis.
+	 */
+	uint32 getPercentile(uint percent) const;
+
+private:
+	uint32 _buckets[kMaxMillis + 1];
+	uint32 _frameCount;
+	uint64 _totalMillis;
+	uint32 _maxMillis;
+};
+
 
 class Engine {
 public:
@@ -89,6 +127,19 @@ private:
 	 */
 	int32 _engineStartTime;
 
+	/**
+	 * When the last frame was shown, in microseconds, or 0 if frame times
+	 * are not being recorded at the moment (e.g. while paused).
+	 */
+	uint64 _lastFrameTime;
+
+	/**
+	 * Frames taking longer than this many ms are logged.
+	 */
+	uint32 _frameStallThreshold;
+
+	FrameTimeHistogram _frameTimes;
+
 	/**
 	 * Save slot selected via global main menu.
 	 * This slot will be loaded after main menu execution (not from inside
@@ -254,6 +305,22 @@ public:
 	 */
 	virtual bool canSaveGameStateCurrently();
 
+	/**
+	 * Save the current game state to a stream instead of a savefile slot.
+	 * This is used by backends which need to keep in-memory snapshots of
+	 * the running game. The default implementation does not support this.
+	 * @param stream	the stream into which the savestate should be written
+	 * @return returns kNoError on success, else an error code.
+	 */
+	virtual Common::Error saveGameStream(Common::WriteStream *stream);
+
+	/**
+	 * Load a game state previously written by saveGameStream().
+	 * @param stream	the stream from which the savestate should be read
+	 * @return returns kNoError on success, else an error code.
+	 */
+	virtual Common::Error loadGameStream(Common::SeekableReadStream *stream);
+
 protected:
 
 	/**
@@ -297,6 +364,18 @@ public:
 	 */
 	bool isPaused() const { return _pauseLevel != 0; }
 
+	/**
+	 * Record that a frame was shown. The backend calls this from
+	 * OSystem::updateScreen, so that the time between frames ends up in
+	 * the frame time histogram, whatever the engine's main loop looks like.
+	 * Frames taking longer than "frame_stall_threshold" ms are logged at
+	 * debug level 1, with the longest profiler zones recorded meanwhile.
+	 */
+	void frameShown();
+
+	const FrameTimeHistogram &getFrameTimes() const { return _frameTimes; }
+	void resetFrameTimes();
+
 	/**
 	 * Run the Global Main Menu Dialog
 	 */
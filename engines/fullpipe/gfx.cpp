@@ -571,7 +571,9 @@ void Picture::draw(int x, int y, int style, int angle) {
 	case 1: {
 		//flip
 		const Dims dims = getDimensions();
-		_bitmap->flipVertical()->drawShaded(1, x1, y1 + 30 + dims.y, *pal, _alpha);
+		Bitmap flipped(*_bitmap);
+		flipped._flipping ^= Graphics::FLIP_V;
+		flipped.drawShaded(1, x1, y1 + 30 + dims.y, *pal, _alpha);
 		break;
 	}
 	case 2:
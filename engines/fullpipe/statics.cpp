@@ -32,6 +32,8 @@
 #include "fullpipe/constants.h"
 #include "fullpipe/objectnames.h"
 
+#include "graphics/transparent_surface.h"
+
 namespace Fullpipe {
 
 StepArray::StepArray() {
@@ -489,19 +491,19 @@ void Movement::draw(bool flipFlag, int angle) {
 	if (_currDynamicPhase->getPaletteData().size())
 		g_fp->_globalPalette = &_currDynamicPhase->getPaletteData();
 
-	Common::ScopedPtr<Bitmap> bmp;
-	if (_currMovement) {
-		bmp.reset(_currDynamicPhase->getPixelData()->reverseImage());
-	} else {
-		bmp.reset(_currDynamicPhase->getPixelData()->reverseImage(false));
-	}
+	// The phase keeps its decoded surface, so drawing it only needs a
+	// shallow copy carrying the flipping of this frame
+	Bitmap bmp(*_currDynamicPhase->getPixelData());
+	if (_currMovement)
+		bmp._flipping ^= Graphics::FLIP_H;
 
 	if (flipFlag) {
-		bmp->flipVertical()->drawShaded(1, x, y + 30 + _currDynamicPhase->_rect.bottom, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
+		bmp._flipping ^= Graphics::FLIP_V;
+		bmp.drawShaded(1, x, y + 30 + _currDynamicPhase->_rect.bottom, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
 	} else if (angle) {
-		bmp->drawRotated(x, y, angle, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
+		bmp.drawRotated(x, y, angle, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
 	} else {
-		bmp->putDib(x, y, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
+		bmp.putDib(x, y, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
 	}
 
 	if (_currDynamicPhase->_rect.top) {
@@ -512,15 +514,15 @@ void Movement::draw(bool flipFlag, int angle) {
 		}
 
 		if (_currDynamicPhase->getConvertedBitmap()) {
+			Bitmap converted(*_currDynamicPhase->getConvertedBitmap());
 			if (_currMovement) {
 				//vrtSetAlphaBlendMode(g_vrtDrawHandle, 1, LOBYTE(_currDynamicPhase->rect.top));
-				bmp.reset(_currDynamicPhase->getConvertedBitmap()->reverseImage());
-				bmp->putDib(x, y, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
+				converted._flipping ^= Graphics::FLIP_H;
+				converted.putDib(x, y, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
 				//vrtSetAlphaBlendMode(g_vrtDrawHandle, 0, 255);
 			} else {
 				//vrtSetAlphaBlendMode(g_vrtDrawHandle, 1, LOBYTE(_currDynamicPhase->rect.top));
-				bmp.reset(_currDynamicPhase->getConvertedBitmap()->reverseImage(false));
-				bmp->putDib(x, y, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
+				converted.putDib(x, y, _currDynamicPhase->getPaletteData(), _currDynamicPhase->getAlpha());
 				//vrtSetAlphaBlendMode(g_vrtDrawHandle, 0, 255);
 			}
 		}
@@ -34,6 +34,8 @@ Glulxe::Glulxe(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst,
 		ramstart(0), endgamefile(0), origendmem(0),  stacksize(0), startfuncaddr(0), checksum(0),
 		stackptr(0), frameptr(0), pc(0), prevpc(0), origstringtable(0), stringtable(0), valstackbase(0),
 		localsbase(0), endmem(0), protectstart(0), protectend(0),
+		// operand
+		decoded_cache(nullptr),
 		stream_char_handler(nullptr), stream_unichar_handler(nullptr),
 		// main
 		library_autorestore_hook(nullptr),
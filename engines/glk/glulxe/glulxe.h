@@ -143,6 +143,11 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Instructions in ROM which have been decoded already, indexed by the low bits of their address
+	 */
+	decodedinst_t *decoded_cache;
+
 	/**@}*/
 
 	/**
@@ -538,6 +543,23 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Return the decoded form of the instruction at the given address in ROM, decoding it if it
+	 * isn't cached yet. Returns nullptr for invalid instructions, which are left to the normal decoding
+	 * to report.
+	 */
+	const decodedinst_t *lookup_decoded(uint addr);
+
+	/**
+	 * Like parse_operands(), but for a decoded instruction. The PC is moved to the next instruction.
+	 */
+	void parse_decoded_operands(oparg_t *opargs, const decodedinst_t *decoded);
+
+	/**
+	 * Free the decoded instruction cache
+	 */
+	void final_operands();
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
@@ -352,6 +352,40 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How a decoded operand gets its value. Constants and addresses come from the
+ * instruction itself, so they are read when it is decoded.
+ */
+enum decodedmode_t {
+	decodedmode_Const = 0,
+	decodedmode_Pop = 1,
+	decodedmode_Mem = 2,
+	decodedmode_Locals = 3,
+	decodedmode_Discard = 4,
+	decodedmode_Push = 5,
+	decodedmode_StoreMem = 6,
+	decodedmode_StoreLocals = 7
+};
+
+/**
+ * An instruction whose opcode and operand modes have been decoded already.
+ * Only instructions in ROM are decoded, as those can never change.
+ */
+struct decodedinst_struct {
+	uint addr;                       ///< The instruction's address, or zero if the entry is unused
+	uint opcode;
+	const operandlist_t *oplist;
+	uint nextpc;                     ///< The address of the following instruction
+	byte modes[MAX_OPERANDS];        ///< A decodedmode_t for each operand
+	uint values[MAX_OPERANDS];       ///< The constant or address of each operand
+};
+typedef decodedinst_struct decodedinst_t;
+
+/**
+ * Number of entries in the decoded instruction cache. Must be a power of two.
+ */
+#define DECODED_CACHE_SIZE (8192)
+
 typedef uint(Glulxe::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -67,6 +67,16 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulxe::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	final_operands();
+	decoded_cache = new decodedinst_t[DECODED_CACHE_SIZE];
+	for (int ix = 0; ix < DECODED_CACHE_SIZE; ix++)
+		decoded_cache[ix].addr = 0;
+}
+
+void Glulxe::final_operands() {
+	delete[] decoded_cache;
+	decoded_cache = nullptr;
 }
 
 const operandlist_t *Glulxe::lookup_operandlist(uint opcode) {
@@ -517,6 +527,220 @@ WrLocalsAddr:
 	}
 }
 
+const decodedinst_t *Glulxe::lookup_decoded(uint addr) {
+	decodedinst_t *decoded = &decoded_cache[addr & (DECODED_CACHE_SIZE - 1)];
+	if (decoded->addr == addr)
+		return decoded;
+
+	/* Address zero is the header, so it never holds an instruction. */
+	decoded->addr = 0;
+	if (addr == 0 || addr >= ramstart)
+		return nullptr;
+
+	uint curpc = addr;
+	uint opcode = Mem1(curpc);
+	curpc++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(curpc);
+			opcode = (opcode << 8) | Mem1(curpc + 1);
+			opcode = (opcode << 8) | Mem1(curpc + 2);
+			curpc += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(curpc);
+			curpc++;
+		}
+	}
+
+	const operandlist_t *oplist = (opcode < 0x80) ? fast_operandlist[opcode] : lookup_operandlist(opcode);
+	if (!oplist)
+		return nullptr;
+
+	int numops = oplist->num_ops;
+	uint modeaddr = curpc;
+	curpc += (numops + 1) / 2;
+
+	for (int ix = 0; ix < numops; ix++) {
+		int mode = Mem1(modeaddr + ix / 2);
+		mode = (ix & 1) ? ((mode >> 4) & 0x0F) : (mode & 0x0F);
+
+		/* Read the constant or address which follows the mode list, if any. */
+		uint value = 0;
+		switch (mode) {
+		case 1:
+		case 5:
+		case 9:
+		case 13:
+			value = (uint)(Mem1(curpc));
+			curpc++;
+			break;
+		case 2:
+		case 6:
+		case 10:
+		case 14:
+			value = (uint)Mem2(curpc);
+			curpc += 2;
+			break;
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			value = Mem4(curpc);
+			curpc += 4;
+			break;
+		default:
+			break;
+		}
+
+		if (mode == 1)
+			value = (int)(signed char)value;
+		else if (mode == 2)
+			value = (int)(signed short)value;
+		else if (mode >= 13)
+			value += ramstart;
+
+		byte decodedMode;
+		if (oplist->formlist[ix] == modeform_Load) {
+			switch (mode) {
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+				decodedMode = decodedmode_Const;
+				break;
+			case 8:
+				decodedMode = decodedmode_Pop;
+				break;
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				decodedMode = decodedmode_Mem;
+				break;
+			case 9:
+			case 10:
+			case 11:
+				decodedMode = decodedmode_Locals;
+				break;
+			default:
+				return nullptr;
+			}
+		} else {
+			switch (mode) {
+			case 0:
+				decodedMode = decodedmode_Discard;
+				break;
+			case 8:
+				decodedMode = decodedmode_Push;
+				break;
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				decodedMode = decodedmode_StoreMem;
+				break;
+			case 9:
+			case 10:
+			case 11:
+				decodedMode = decodedmode_StoreLocals;
+				break;
+			default:
+				return nullptr;
+			}
+		}
+
+		decoded->modes[ix] = decodedMode;
+		decoded->values[ix] = value;
+	}
+
+	/* An instruction running on into RAM could still change. */
+	if (curpc > ramstart)
+		return nullptr;
+
+	decoded->opcode = opcode;
+	decoded->oplist = oplist;
+	decoded->nextpc = curpc;
+	decoded->addr = addr;
+	return decoded;
+}
+
+void Glulxe::parse_decoded_operands(oparg_t *args, const decodedinst_t *decoded) {
+	int numops = decoded->oplist->num_ops;
+	int argsize = decoded->oplist->arg_size;
+	uint addr;
+
+	pc = decoded->nextpc;
+
+	for (int ix = 0; ix < numops; ix++) {
+		oparg_t *curarg = &args[ix];
+		curarg->desttype = 0;
+
+		switch (decoded->modes[ix]) {
+		case decodedmode_Const:
+			curarg->value = decoded->values[ix];
+			break;
+
+		case decodedmode_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case decodedmode_Mem:
+			addr = decoded->values[ix];
+			if (argsize == 4) {
+				curarg->value = Mem4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Mem2(addr);
+			} else {
+				curarg->value = Mem1(addr);
+			}
+			break;
+
+		case decodedmode_Locals:
+			addr = decoded->values[ix] + localsbase;
+			if (argsize == 4) {
+				curarg->value = Stk4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Stk2(addr);
+			} else {
+				curarg->value = Stk1(addr);
+			}
+			break;
+
+		case decodedmode_Discard:
+			curarg->value = 0;
+			break;
+
+		case decodedmode_Push:
+			curarg->desttype = 3;
+			curarg->value = 0;
+			break;
+
+		case decodedmode_StoreMem:
+			curarg->desttype = 1;
+			curarg->value = decoded->values[ix];
+			break;
+
+		case decodedmode_StoreLocals:
+			curarg->desttype = 2;
+			curarg->value = decoded->values[ix];
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
 void Glulxe::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
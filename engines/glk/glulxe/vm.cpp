@@ -117,6 +117,7 @@ void Glulxe::finalize_vm() {
 	}
 
 	final_serial();
+	final_operands();
 }
 
 void Glulxe::vm_restart() {
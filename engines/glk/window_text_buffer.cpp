@@ -849,12 +849,13 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
-
 		// skip if we can
-		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
+		if (!_lines[i]._dirty && !_lines[i]._repaint && !Windows::_forceRedraw && _scrollPos == 0)
 			continue;
 
+		// copied, as selected characters are reversed in it
+		TextBufferRow ln(_lines[i]);
+
 		// repaint previously selected lines if needed
 		if (ln._repaint && !Windows::_forceRedraw)
 			_windows->redrawRect(Rect(x0 / GLI_SUBPIX, y,
@@ -1079,8 +1080,9 @@ void TextBufferWindow::redraw() {
 	/*
 	 * draw the images
 	 */
-	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+	// Pictures extend down from their row, so rows below the window are never visible
+	for (i = _scrollPos; i < _scrollBack; i++) {
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1521,10 +1523,16 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lastSeen++;
 	_scrollMax++;
 
-	if (_scrollMax > _scrollBack - 1
-			|| _lastSeen > _scrollBack - 1)
+	if ((_scrollMax > _scrollBack - 1
+			|| _lastSeen > _scrollBack - 1) && _scrollBack < SCROLLBACK_MAX)
 		scrollResize();
 
+	// The oldest lines drop out of a full scrollback
+	if (_scrollMax > _scrollBack - 1)
+		_scrollMax = _scrollBack - 1;
+	if (_lastSeen > _scrollBack - 1)
+		_lastSeen = _scrollBack - 1;
+
 	if (_lastSeen >= _height)
 		_scrollPos++;
 
@@ -1540,11 +1548,18 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// The oldest row is reused as the new first one
+	TextBufferRow &oldest = _lines[_scrollBack - 1];
+	if (oldest._lPic)
+		oldest._lPic->decrement();
+	if (oldest._rPic)
+		oldest._rPic->decrement();
+	_lines.rotate();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1579,7 +1594,6 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 void TextBufferWindow::scrollResize() {
 	int i;
 
-	_lines.clear();
 	_lines.resize(_scrollBack + SCROLLBACK);
 
 	_chars = _lines[0]._chars;
@@ -1642,4 +1656,21 @@ TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(
 	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
 }
 
+/*--------------------------------------------------------------------------*/
+
+void TextBufferWindow::TextBufferRows::resize(uint count) {
+	if (_first == 0 || _rows.empty()) {
+		_rows.resize(count);
+		return;
+	}
+
+	Common::Array<TextBufferRow> rows;
+	rows.resize(count);
+	for (uint idx = 0; idx < count && idx < _rows.size(); ++idx)
+		rows[idx] = (*this)[idx];
+
+	_rows = rows;
+	_first = 0;
+}
+
 } // End of namespace Glk
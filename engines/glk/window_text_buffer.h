@@ -53,7 +53,36 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window, newest first. They are kept in a ring, so that
+	 * scrolling doesn't need to move every row of the scrollback
+	 */
+	class TextBufferRows {
+		Common::Array<TextBufferRow> _rows;
+		uint _first;
+	public:
+		TextBufferRows() : _first(0) {}
+
+		TextBufferRow &operator[](int idx) {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+		const TextBufferRow &operator[](int idx) const {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+
+		/**
+		 * Change the number of rows, keeping the newest ones
+		 */
+		void resize(uint count);
+
+		/**
+		 * Makes the oldest row the first one, and every other row one older
+		 */
+		void rotate() {
+			_first = (_first + _rows.size() - 1) % _rows.size();
+		}
+	};
 private:
 	PropFontInfo &_font;
 private:
@@ -41,6 +41,7 @@ class PairWindow;
 
 #define HISTORYLEN 100
 #define SCROLLBACK 512
+#define SCROLLBACK_MAX (SCROLLBACK * 8)
 #define TBLINELEN 300
 #define GLI_SUBPIX 8
 
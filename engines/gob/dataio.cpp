@@ -71,35 +71,33 @@ void DataIO::getArchiveInfo(Common::Array<ArchiveInfo> &info) const {
 	}
 }
 
-uint32 DataIO::getSizeChunks(Common::SeekableReadStream &src) {
+uint32 DataIO::getSizeChunks(const byte *src, uint32 srcSize) {
 	uint32 size = 0;
 
-	uint32 chunkSize = 2, realSize;
+	uint32 pos = 0, chunkSize = 0;
 	while (chunkSize != 0xFFFF) {
-		src.skip(chunkSize - 2);
+		assert(pos + 4 <= srcSize);
 
-		chunkSize = src.readUint16LE();
-		realSize  = src.readUint16LE();
+		chunkSize = READ_LE_UINT16(src + pos);
+		uint32 realSize = READ_LE_UINT16(src + pos + 2);
 
 		assert(chunkSize >= 4);
 
 		size += realSize;
+		pos  += chunkSize + 2;
 	}
 
-	assert(!src.eos());
-
-	src.seek(0);
-
 	return size;
 }
 
-byte *DataIO::unpack(Common::SeekableReadStream &src, int32 &size, uint8 compression, bool useMalloc) {
+byte *DataIO::unpack(const byte *src, uint32 srcSize, int32 &size, uint8 compression, bool useMalloc) {
 	assert((compression == 1) || (compression == 2));
 
-	if      (compression == 1)
-		size = src.readUint32LE();
-	else if (compression == 2)
-		size = getSizeChunks(src);
+	if (compression == 1) {
+		assert(srcSize >= 4);
+		size = READ_LE_UINT32(src);
+	} else if (compression == 2)
+		size = getSizeChunks(src, srcSize);
 
 	assert(size > 0);
 
@@ -110,102 +108,112 @@ byte *DataIO::unpack(Common::SeekableReadStream &src, int32 &size, uint8 compres
 		data = new byte[size];
 
 	if      (compression == 1)
-		unpackChunk(src, data, size);
+		unpackChunk(src + 4, srcSize - 4, data, size);
 	else if (compression == 2)
-		unpackChunks(src, data, size);
+		unpackChunks(src, srcSize, data, size);
 
 	return data;
 }
 
 byte *DataIO::unpack(const byte *src, uint32 srcSize, int32 &size, uint8 compression) {
-	Common::MemoryReadStream srcStream(src, srcSize);
-
-	return unpack(srcStream, size, compression, false);
+	return unpack(src, srcSize, size, compression, false);
 }
 
 Common::SeekableReadStream *DataIO::unpack(Common::SeekableReadStream &src, uint8 compression) {
+	// Unpack from memory, instead of reading the stream byte by byte
+	uint32 srcSize = src.size() - src.pos();
+	byte *srcData = new byte[srcSize];
+	if (src.read(srcData, srcSize) != srcSize) {
+		delete[] srcData;
+		return 0;
+	}
+
 	int32 size;
 
-	byte *data = unpack(src, size, compression, true);
+	byte *data = unpack(srcData, srcSize, size, compression, true);
+
+	delete[] srcData;
+
 	if (!data)
 		return 0;
 
 	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
 }
 
-void DataIO::unpackChunks(Common::SeekableReadStream &src, byte *dest, uint32 size) {
-	uint32 chunkSize = 0, realSize;
+void DataIO::unpackChunks(const byte *src, uint32 srcSize, byte *dest, uint32 size) {
+	uint32 pos = 0, chunkSize = 0;
 	while (chunkSize != 0xFFFF) {
-		uint32 pos = src.pos();
+		assert(pos + 4 <= srcSize);
 
-		chunkSize = src.readUint16LE();
-		realSize  = src.readUint16LE();
+		chunkSize = READ_LE_UINT16(src + pos);
+		uint32 realSize = READ_LE_UINT16(src + pos + 2);
 
 		assert(chunkSize >= 4);
 		assert(size >= realSize);
 
-		src.skip(2);
-
-		unpackChunk(src, dest, realSize);
-
-		if (chunkSize != 0xFFFF)
-			src.seek(pos + chunkSize + 2);
+		// The packed data starts after two more bytes
+		const uint32 dataPos = MIN<uint32>(pos + 6, srcSize);
+		unpackChunk(src + dataPos, srcSize - dataPos, dest, realSize);
 
+		pos  += chunkSize + 2;
 		size -= realSize;
 		dest += realSize;
 	}
 }
 
-void DataIO::unpackChunk(Common::SeekableReadStream &src, byte *dest, uint32 size) {
-	byte *tmpBuf = new byte[4114];
-	assert(tmpBuf);
+void DataIO::unpackChunk(const byte *src, uint32 srcSize, byte *dest, uint32 size) {
+	byte tmpBuf[4096];
 
-	uint32 counter = size;
-
-	for (int i = 0; i < 4078; i++)
-		tmpBuf[i] = 0x20;
+	memset(tmpBuf, 0x20, 4078);
+	memset(tmpBuf + 4078, 0, 4096 - 4078);
 	uint16 tmpIndex = 4078;
 
+	const byte *srcEnd = src + srcSize;
+
+	// Like reading past the end of a stream, reading past the end of the data gives 0
+#define UNPACK_READ_BYTE() ((src < srcEnd) ? *src++ : 0)
+
+	uint32 counter = size;
+
 	uint16 cmd = 0;
 	while (1) {
 		cmd >>= 1;
 		if ((cmd & 0x0100) == 0)
-			cmd = src.readByte() | 0xFF00;
+			cmd = UNPACK_READ_BYTE() | 0xFF00;
 
 		if ((cmd & 1) != 0) { /* copy */
-			byte tmp = src.readByte();
+			byte tmp = UNPACK_READ_BYTE();
 
 			*dest++ = tmp;
 			tmpBuf[tmpIndex] = tmp;
 
-			tmpIndex++;
-			tmpIndex %= 4096;
+			tmpIndex = (tmpIndex + 1) & 4095;
 			counter--;
 			if (counter == 0)
 				break;
 		} else { /* copy string */
-			byte tmp1 = src.readByte();
-			byte tmp2 = src.readByte();
+			byte tmp1 = UNPACK_READ_BYTE();
+			byte tmp2 = UNPACK_READ_BYTE();
 
-			int16 off = tmp1 | ((tmp2 & 0xF0) << 4);
-			byte  len =         (tmp2 & 0x0F) + 3;
+			uint16 off = tmp1 | ((tmp2 & 0xF0) << 4);
+			byte   len =         (tmp2 & 0x0F) + 3;
 
 			for (int i = 0; i < len; i++) {
-				*dest++ = tmpBuf[(off + i) % 4096];
+				byte tmp = tmpBuf[(off + i) & 4095];
+
+				*dest++ = tmp;
 				counter--;
-				if (counter == 0) {
-					delete[] tmpBuf;
+				if (counter == 0)
 					return;
-				}
-				tmpBuf[tmpIndex] = tmpBuf[(off + i) % 4096];
-				tmpIndex++;
-				tmpIndex %= 4096;
+
+				tmpBuf[tmpIndex] = tmp;
+				tmpIndex = (tmpIndex + 1) & 4095;
 			}
 
 		}
 	}
 
-	delete[] tmpBuf;
+#undef UNPACK_READ_BYTE
 }
 
 bool DataIO::openArchive(Common::String name, bool base) {
@@ -239,6 +247,8 @@ bool DataIO::openArchive(Common::String name, bool base) {
 		return false;
 
 	(*archive)->base = base;
+
+	rebuildFileIndex();
 	return true;
 }
 
@@ -294,6 +304,7 @@ bool DataIO::closeArchive(bool base) {
 			delete _archives[archive];
 			_archives[archive] = 0;
 
+			rebuildFileIndex();
 			return true;
 		}
 	}
@@ -307,6 +318,21 @@ bool DataIO::closeArchive(Archive &archive) {
 	return true;
 }
 
+void DataIO::rebuildFileIndex() {
+	_fileIndex.clear();
+
+	// Later archives take precedence, so they are added last
+	for (uint i = 0; i < _archives.size(); i++) {
+		Archive *archive = _archives[i];
+		if (!archive)
+			// Empty slot
+			continue;
+
+		for (FileMap::iterator file = archive->files.begin(); file != archive->files.end(); ++file)
+			_fileIndex.setVal(file->_key, &file->_value);
+	}
+}
+
 bool DataIO::hasFile(const Common::String &name){
 	// Look up the files in the opened archives
 	if (findFile(name))
@@ -388,17 +414,10 @@ byte *DataIO::getFile(const Common::String &name, int32 &size) {
 }
 
 DataIO::File *DataIO::findFile(const Common::String &name) {
-	for (int i = _archives.size() - 1; i >= 0; i--) {
-		Archive *archive = _archives[i];
-		if (!archive)
-			// Empty slot
-			continue;
-
-		// Look up the file in the file map
-		FileMap::iterator file = archive->files.find(name);
-		if (file != archive->files.end())
-			return &file->_value;
-	}
+	// Look up the file in the index of all opened archives
+	FileIndex::iterator file = _fileIndex.find(name);
+	if (file != _fileIndex.end())
+		return file->_value;
 
 	return 0;
 }
@@ -413,17 +432,25 @@ Common::SeekableReadStream *DataIO::getFile(File &file) {
 	if (!file.archive->file.seek(file.offset))
 		return 0;
 
-	Common::SeekableReadStream *rawData =
-		new Common::SafeSeekableSubReadStream(&file.archive->file, file.offset, file.offset + file.size);
-
 	if (file.compression == 0)
-		return rawData;
+		return new Common::SafeSeekableSubReadStream(&file.archive->file, file.offset, file.offset + file.size);
+
+	// Read the packed data in one go and unpack it from memory
+	byte *rawData = new byte[file.size];
+	if (file.archive->file.read(rawData, file.size) != file.size) {
+		delete[] rawData;
+		return 0;
+	}
+
+	int32 size;
+	byte *unpackedData = unpack(rawData, file.size, size, file.compression, true);
 
-	Common::SeekableReadStream *unpackedData = unpack(*rawData, file.compression);
+	delete[] rawData;
 
-	delete rawData;
+	if (!unpackedData)
+		return 0;
 
-	return unpackedData;
+	return new Common::MemoryReadStream(unpackedData, size, DisposeAfterUse::YES);
 }
 
 byte *DataIO::getFile(File &file, int32 &size) {
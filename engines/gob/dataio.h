@@ -89,22 +89,29 @@ private:
 		bool base;
 	};
 
+	typedef Common::HashMap<Common::String, File *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileIndex;
+
 	Common::Array<Archive *> _archives;
 
+	/** All files in the opened archives, the later archives overriding the earlier ones. */
+	FileIndex _fileIndex;
+
 	Archive *openArchive(const Common::String &name);
 	bool closeArchive(Archive &archive);
 
+	void rebuildFileIndex();
+
 	File *findFile(const Common::String &name);
 
 	Common::SeekableReadStream *getFile(File &file);
 	byte *getFile(File &file, int32 &size);
 
-	static byte *unpack(Common::SeekableReadStream &src, int32 &size, uint8 compression, bool useMalloc);
+	static byte *unpack(const byte *src, uint32 srcSize, int32 &size, uint8 compression, bool useMalloc);
 
-	static uint32 getSizeChunks(Common::SeekableReadStream &src);
+	static uint32 getSizeChunks(const byte *src, uint32 srcSize);
 
-	static void unpackChunks(Common::SeekableReadStream &src, byte *dest, uint32 size);
-	static void unpackChunk (Common::SeekableReadStream &src, byte *dest, uint32 size);
+	static void unpackChunks(const byte *src, uint32 srcSize, byte *dest, uint32 size);
+	static void unpackChunk (const byte *src, uint32 srcSize, byte *dest, uint32 size);
 };
 
 } // End of namespace Gob
@@ -22,8 +22,45 @@
 
 #include "groovie/cell.h"
 
+#include "common/system.h"
+
 namespace Groovie {
 
+/** Calculates a move of a CellGame, see playStaufAsync() */
+class CellGame::StaufTask : public Common::Task {
+public:
+	StaufTask(CellGame *game, byte color, uint16 depth) : _game(game), _color(color), _depth(depth) {}
+
+	void run() override {
+		_game->calcMove(_color, _depth);
+	}
+
+private:
+	CellGame *_game;
+	byte _color;
+	uint16 _depth;
+};
+
+/** Searches the first moves of doGame() past the first one */
+class CellGame::RootMovesBody : public Common::ParallelForBody {
+public:
+	RootMovesBody(const CellGame &game, Common::Array<RootMove> &moves, int8 color, bool type, uint16 depth, int bestWeight) :
+		_game(game), _moves(moves), _color(color), _type(type), _depth(depth), _bestWeight(bestWeight) {}
+
+	void run(uint begin, uint end) override {
+		for (uint i = begin; i < end; i++)
+			_moves[i].weight = _game.searchRootMove(_moves[i], _color, _type, _depth, _bestWeight);
+	}
+
+private:
+	const CellGame &_game;
+	Common::Array<RootMove> &_moves;
+	int8 _color;
+	bool _type;
+	uint16 _depth;
+	int _bestWeight;
+};
+
 CellGame::CellGame() {
 	_startX = _startY = _endX = _endY = 255;
 
@@ -34,6 +71,11 @@ CellGame::CellGame() {
 	_coeff3 = 0;
 
 	_moveCount = 0;
+
+	_staufColor = 0;
+	_staufDepth = 0;
+	memset(_staufBoard, 0, sizeof(_staufBoard));
+	_staufMoveCount = 0;
 }
 
 byte CellGame::getStartX() {
@@ -73,6 +115,7 @@ byte CellGame::getEndY() {
 }
 
 CellGame::~CellGame() {
+	cancelStauf();
 }
 
 const int8 possibleMoves[][9] = {
@@ -181,15 +224,11 @@ const int8 strategy2[][17] = {
 };
 
 void CellGame::copyToTempBoard() {
-	for (int i = 0; i < 53; ++i) {
-		_tempBoard[i] = _board[i];
-	}
+	memcpy(_tempBoard, _board, 53);
 }
 
 void CellGame::copyFromTempBoard() {
-	for (int i = 0; i < 53; ++i) {
-		_board[i] = _tempBoard[i];
-	}
+	memcpy(_board, _tempBoard, 53);
 }
 
 void CellGame::copyToShadowBoard() {
@@ -197,16 +236,13 @@ void CellGame::copyToShadowBoard() {
 	_board[55] = 1;
 	_board[56] = 0;
 
-	for (int i = 0; i < 49; ++i) {
-		_shadowBoard[i] = _board[i];
-	}
+	memcpy(_shadowBoard, _board, 49);
 }
 
 void CellGame::pushBoard() {
 	assert(_boardStackPtr < 57 * 9);
 
-	for (int i = 0; i < 57; ++i)
-		_boardStack[_boardStackPtr + i] = _board[i];
+	memcpy(_boardStack + _boardStackPtr, _board, 57);
 	_boardStackPtr += 57;
 }
 
@@ -214,17 +250,13 @@ void CellGame::popBoard() {
 	assert(_boardStackPtr > 0);
 
 	_boardStackPtr -= 57;
-	for (int i = 0; i < 57; ++i) {
-		_board[i] = _boardStack[_boardStackPtr + i];
-	}
+	memcpy(_board, _boardStack + _boardStackPtr, 57);
 }
 
 void CellGame::pushShadowBoard() {
 	assert(_boardStackPtr < 57 * 9);
 
-	for (int i = 0; i < 57; ++i)
-		_boardStack[_boardStackPtr + i] = _shadowBoard[i];
-
+	memcpy(_boardStack + _boardStackPtr, _shadowBoard, 57);
 	_boardStackPtr += 57;
 }
 
@@ -232,10 +264,7 @@ void CellGame::popShadowBoard() {
 	assert(_boardStackPtr > 0);
 
 	_boardStackPtr -= 57;
-
-	for (int i = 0; i < 57; ++i) {
-		_shadowBoard[i] = _boardStack[_boardStackPtr + i];
-	}
+	memcpy(_shadowBoard, _boardStack + _boardStackPtr, 57);
 }
 
 void CellGame::clearMoves() {
@@ -699,6 +728,11 @@ int16 CellGame::doGame(int8 color, int depth) {
 			w2 = getBoardWeight(color, color);
 		}
 		int8 currBoardWeight = 2 * (2 * _board[color + 48] - _board[49] - _board[50] - _board[51] - _board[52]);
+
+		// The searches of the other moves don't change the state the moves
+		// are enumerated from, so they are collected first and searched
+		// in parallel afterwards
+		Common::Array<RootMove> moves;
 		while (1) {
 			if (type)
 				canMove = canMoveFunc2(color);
@@ -716,19 +750,37 @@ int16 CellGame::doGame(int8 color, int depth) {
 			}
 			if (_board[55] == 1)
 				_coeff3 = 1;
+
+			RootMove move;
 			if (depth) {
 				makeMove(color);
-				_flag4 = false;
-				if (type) {
-					w1 = calcBestWeight(color, color, depth, w2);
-				} else {
-					pushShadowBoard();
-					w1 = calcBestWeight(color, color, depth, w2);
-					popShadowBoard();
-				}
+				memcpy(move.tempBoard, _tempBoard, sizeof(move.tempBoard));
+				memcpy(move.shadowBoard, _shadowBoard, sizeof(move.shadowBoard));
+				move.weight = 0;
 			} else {
-				w1 = getBoardWeight(color, color);
+				move.weight = getBoardWeight(color, color);
 			}
+			memcpy(move.board, _board, sizeof(move.board));
+			move.coeff3 = _coeff3;
+			moves.push_back(move);
+		}
+
+		// Searching them all against the weight of the first move instead of
+		// the best one so far only prunes less. The weights which are cut off
+		// are still below it, so the same moves are chosen.
+		if (depth && !moves.empty()) {
+			_flag4 = false;
+			RootMovesBody body(*this, moves, color, type, depth, w2);
+			g_system->getTaskScheduler()->parallelFor(0, moves.size(), body);
+		}
+
+		for (uint i = 0; i < moves.size(); i++) {
+			// The move bookkeeping only records these
+			_board[53] = moves[i].board[53];
+			_board[54] = moves[i].board[54];
+			_board[55] = moves[i].board[55];
+
+			w1 = moves[i].weight;
 			if (w1 == w2)
 				pushMove();
 
@@ -773,7 +825,26 @@ int16 CellGame::calcMove(int8 color, uint16 depth) {
 	return result;
 }
 
-int CellGame::playStauf(byte color, uint16 depth, byte *scriptBoard) {
+int8 CellGame::searchRootMove(RootMove &move, int8 color, bool type, uint16 depth, int bestWeight) const {
+	CellGame search;
+	memcpy(search._board, move.board, sizeof(search._board));
+	memcpy(search._tempBoard, move.tempBoard, sizeof(search._tempBoard));
+	memcpy(search._shadowBoard, move.shadowBoard, sizeof(search._shadowBoard));
+	search._coeff3 = move.coeff3;
+	search._flag1 = _flag1;
+	search._flag2 = _flag2;
+	search._flag4 = _flag4;
+
+	if (type)
+		return search.calcBestWeight(color, color, depth, bestWeight);
+
+	search.pushShadowBoard();
+	int8 weight = search.calcBestWeight(color, color, depth, bestWeight);
+	search.popShadowBoard();
+	return weight;
+}
+
+void CellGame::setupBoard(const byte *scriptBoard) {
 	int i;
 
 	for (i = 0; i < 49; i++, scriptBoard++) {
@@ -785,9 +856,47 @@ int CellGame::playStauf(byte color, uint16 depth, byte *scriptBoard) {
 	}
 	for (i = 49; i < 57; i++)
 		_board[i] = 0;
+}
+
+int CellGame::playStauf(byte color, uint16 depth, byte *scriptBoard) {
+	cancelStauf();
+	setupBoard(scriptBoard);
 
 	return calcMove(color, depth);
 }
 
+bool CellGame::playStaufAsync(byte color, uint16 depth, const byte *scriptBoard) {
+	// Not the same move as the one being calculated, e.g. after loading a game
+	if (_staufFuture.isValid() && (color != _staufColor || depth != _staufDepth || memcmp(scriptBoard, _staufBoard, 49)))
+		cancelStauf();
+
+	if (!_staufFuture.isValid()) {
+		_staufColor = color;
+		_staufDepth = depth;
+		memcpy(_staufBoard, scriptBoard, 49);
+		_staufMoveCount = _moveCount;
+
+		setupBoard(scriptBoard);
+		_staufFuture = g_system->getTaskScheduler()->schedule(new StaufTask(this, color, depth));
+	}
+
+	if (!_staufFuture.isDone())
+		return false;
+
+	_staufFuture = Common::TaskFuture();
+	return true;
+}
+
+void CellGame::cancelStauf() {
+	if (!_staufFuture.isValid())
+		return;
+
+	_staufFuture.wait();
+	_staufFuture = Common::TaskFuture();
+
+	// The move count picks the search depth, so the abandoned move must not count
+	_moveCount = _staufMoveCount;
+}
+
 
 } // End of Groovie namespace
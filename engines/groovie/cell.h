@@ -23,6 +23,8 @@
 #ifndef GROOVIE_CELL_H
 #define GROOVIE_CELL_H
 
+#include "common/array.h"
+#include "common/taskscheduler.h"
 #include "common/textconsole.h"
 
 #define BOARDSIZE 7
@@ -45,7 +47,32 @@ public:
 	byte getEndY();
 	int playStauf(byte color, uint16 depth, byte *scriptBoard);
 
+	/**
+	 * Calculate Stauf's move like playStauf(), but on a worker thread.
+	 *
+	 * Returns false while the move is still being calculated, in which
+	 * case it has to be called again with the same arguments until it
+	 * returns true. The move can then be read with the getters.
+	 */
+	bool playStaufAsync(byte color, uint16 depth, const byte *scriptBoard);
+
 private:
+	class StaufTask;
+	class RootMovesBody;
+
+	/** A first move searched on its own, with the state to search it from */
+	struct RootMove {
+		int8 board[57];
+		int8 tempBoard[58];
+		int8 shadowBoard[64];
+		int coeff3;
+		int8 weight;
+	};
+
+	void setupBoard(const byte *scriptBoard);
+	void cancelStauf();
+	int8 searchRootMove(RootMove &move, int8 color, bool type, uint16 depth, int bestWeight) const;
+
 	void copyToTempBoard();
 	void copyFromTempBoard();
 	void copyToShadowBoard();
@@ -90,6 +117,13 @@ private:
 	int _coeff3;
 	bool _flag1, _flag2, _flag4;
 	int _moveCount;
+
+	// Move being calculated by playStaufAsync()
+	Common::TaskFuture _staufFuture;
+	byte _staufColor;
+	uint16 _staufDepth;
+	byte _staufBoard[49];
+	int _staufMoveCount;
 };
 
 } // End of Groovie namespace
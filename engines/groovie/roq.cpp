@@ -128,17 +128,26 @@ void ROQPlayer::buildShowBuf() {
 	if (_alpha)
 		_fg->copyFrom(*_bg);
 
+	// Handle transparency in Gamepad videos
+	// TODO: For now, we detect these videos by checking for full screen
+	bool gamepad = _fg->h == 480;
+	uint32 white = _vm->_pixelFormat.RGBToColor(255, 255, 255);
+
 	for (int line = 0; line < _bg->h; line++) {
 		uint32 *out = _alpha ? (uint32 *)_fg->getBasePtr(0, line) : (uint32 *)_bg->getBasePtr(0, line);
 		uint32 *in = (uint32 *)_currBuf->getBasePtr(0, line / _scaleY);
 
+		// Without transparency nor horizontal scaling, lines are copied as they are
+		if (!_alpha && !gamepad && _scaleX == 1) {
+			memcpy(out, in, _bg->w * 4);
+			continue;
+		}
+
 		for (int x = 0; x < _bg->w; x++) {
 			// Copy a pixel, checking the alpha channel first
 			if (_alpha && !(*in & 0xFF))
 				out++;
-			else if (_fg->h == 480 && *in == _vm->_pixelFormat.RGBToColor(255, 255, 255))
-				// Handle transparency in Gamepad videos
-				// TODO: For now, we detect these videos by checking for full screen
+			else if (gamepad && *in == white)
 				out++;
 			else
 				*out++ = *in;
@@ -374,9 +383,34 @@ bool ROQPlayer::processBlockQuadCodebook(ROQBlockHeader &blockHeader) {
 	// Read the 4x4 codebook
 	_file->read(_codebook4, _num4blocks * 4);
 
+	// Expand it once, so painting the blocks is only copying pixels
+	expandCodebook4();
+
 	return true;
 }
 
+void ROQPlayer::expandCodebook4() {
+	// All the blocks are expanded, even those not redefined by this
+	// codebook, since the 2x2 blocks they are made of may have changed
+	for (int i = 0; i < 256; i++) {
+		const byte *block4 = &_codebook4[i * 4];
+		uint32 *pixels = &_codebook4Pixels[i * 16];
+
+		_codebook4Valid[i] = true;
+		for (int j = 0; j < 4; j++) {
+			if (block4[j] > _num2blocks)
+				_codebook4Valid[i] = false;
+
+			const uint32 *block2 = _codebook2 + block4[j] * 4;
+			uint32 *ptr = pixels + (j >> 1) * 8 + (j & 1) * 2;
+			ptr[0] = block2[0];
+			ptr[1] = block2[1];
+			ptr[4] = block2[2];
+			ptr[5] = block2[3];
+		}
+	}
+}
+
 bool ROQPlayer::processBlockQuadVector(ROQBlockHeader &blockHeader) {
 	debugC(5, kDebugVideo, "Groovie::ROQ: Processing quad vector block");
 
@@ -628,12 +662,19 @@ void ROQPlayer::paint4(byte i, int destx, int desty) {
 		error("Groovie::ROQ: Invalid 4x4 block %d (%d available)", i, _num4blocks);
 	}
 
-	byte *block4 = &_codebook4[i * 4];
-	for (int origy = 0; origy < 4; origy += 2) {
-		for (int origx = 0; origx < 4; origx += 2) {
-			paint2(*block4, destx + origx, desty + origy);
-			block4++;
-		}
+	if (!_codebook4Valid[i]) {
+		// Report the first invalid 2x2 block, like painting them one by one would
+		for (int j = 0; j < 4; j++)
+			paint2(_codebook4[i * 4 + j], destx + (j & 1) * 2, desty + (j >> 1) * 2);
+	}
+
+	const uint32 *pixels = &_codebook4Pixels[i * 16];
+	byte *ptr = (byte *)_currBuf->getBasePtr(destx, desty);
+
+	for (int y = 0; y < 4; y++) {
+		memcpy(ptr, pixels, 4 * 4);
+		pixels += 4;
+		ptr += _currBuf->pitch;
 	}
 }
 
@@ -642,20 +683,20 @@ void ROQPlayer::paint8(byte i, int destx, int desty) {
 		error("Groovie::ROQ: Invalid 4x4 block %d (%d available)", i, _num4blocks);
 	}
 
-	byte *block4 = &_codebook4[i * 4];
-	for (int y4 = 0; y4 < 2; y4++) {
-		for (int x4 = 0; x4 < 2; x4++) {
-			uint32 *block2 = _codebook2 + *block4++ * 4;
+	// Upsample the expanded 4x4 block, doubling every pixel
+	const uint32 *pixels = &_codebook4Pixels[i * 16];
+	uint32 *ptr = (uint32 *)_currBuf->getBasePtr(destx, desty);
+	uint32 pitch = _currBuf->pitch / 4;
 
-			for (int y2 = 0; y2 < 2; y2++) {
-				for (int x2 = 0; x2 < 2; x2++) {
-					uint32 *ptr = (uint32 *)_currBuf->getBasePtr(destx + x4 * 4 + x2 * 2, desty + y4 * 4 + y2 * 2);
-					uint32 pitch = _currBuf->pitch / 4;
-					uint32 color = *block2++;
-					ptr[0] = ptr[1] = ptr[pitch] = ptr[pitch + 1] = color;
-				}
-			}
+	for (int y = 0; y < 4; y++) {
+		for (int x = 0; x < 4; x++) {
+			uint32 color = pixels[x];
+			ptr[x * 2] = ptr[x * 2 + 1] = color;
 		}
+		memcpy(ptr + pitch, ptr, 8 * 4);
+
+		pixels += 4;
+		ptr += pitch * 2;
 	}
 }
 
@@ -667,13 +708,19 @@ void ROQPlayer::copy(byte size, int destx, int desty, int offx, int offy) {
 	byte *dst = (byte *)_currBuf->getBasePtr(destx, desty);
 	byte *src = (byte *)_prevBuf->getBasePtr(destx + offx, desty + offy);
 
-	for (int i = 0; i < size; i++) {
-		// Copy the current line
-		memcpy(dst, src, size * _currBuf->format.bytesPerPixel);
-
-		// Move to the beginning of the next line
-		dst += _currBuf->pitch;
-		src += _prevBuf->pitch;
+	// Copy the lines with constant sizes for the compiler to inline them
+	if (size == 8) {
+		for (int i = 0; i < 8; i++) {
+			memcpy(dst, src, 8 * 4);
+			dst += _currBuf->pitch;
+			src += _prevBuf->pitch;
+		}
+	} else {
+		for (int i = 0; i < size; i++) {
+			memcpy(dst, src, 4 * 4);
+			dst += _currBuf->pitch;
+			src += _prevBuf->pitch;
+		}
 	}
 }
 
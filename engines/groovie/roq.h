@@ -63,6 +63,7 @@ private:
 	void paint4(byte i, int destx, int desty);
 	void paint8(byte i, int destx, int desty);
 	void copy(byte size, int destx, int desty, int offx, int offy);
+	void expandCodebook4();
 
 	// Block coding type
 	byte getCodingType();
@@ -74,6 +75,9 @@ private:
 	uint16 _num4blocks;
 	uint32 _codebook2[256 * 4];
 	byte _codebook4[256 * 4];
+	// The 4x4 codebook expanded to pixels, and whether its 2x2 blocks are valid
+	uint32 _codebook4Pixels[256 * 16];
+	bool _codebook4Valid[256];
 
 	// Flags
 	bool _flagTwo;
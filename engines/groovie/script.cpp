@@ -1505,7 +1505,13 @@ void Script::o_cellmove() {
 	if (!_staufsMove)
 		_staufsMove = new CellGame;
 
-	_staufsMove->playStauf(2, depth, scriptBoard);
+	if (!_staufsMove->playStaufAsync(2, depth, scriptBoard)) {
+		// Let the engine handle events while Stauf is thinking, and
+		// come back to this instruction
+		_vm->_system->delayMillis(10);
+		_currentInstruction -= 2;
+		return;
+	}
 
 	startX = _staufsMove->getStartX();
 	startY = _staufsMove->getStartY();
@@ -377,6 +377,12 @@ void Gfx::updateVideo() {
 	g_system->updateScreen();
 }
 
+void Gfx::copyToScreen(Common::Rect rect) {
+	rect.clip(_globalSurface.getBounds());
+	if (!rect.isEmpty())
+		g_system->copyRectToScreen(_globalSurface.getBasePtr(rect.left, rect.top), _globalSurface.pitch, rect.left, rect.top, rect.width(), rect.height());
+}
+
 void Gfx::drawPointer() {
 	static int anim = 0;
 	static uint32 animTime = 0;
@@ -1434,11 +1440,7 @@ Graphics::Surface Tile::load(Common::SeekableReadStream *stream) {
 }
 
 int Tile::draw(int x, int y) {
-	g_hdb->_gfx->_globalSurface.blitFrom(_surface, Common::Point(x, y));
-
-	Common::Rect clip(_surface.getBounds());
-	clip.moveTo(x, y);
-	clip.clip(g_hdb->_gfx->_globalSurface.getBounds());
+	Common::Rect clip(blit(x, y));
 	if (!clip.isEmpty()) {
 		g_system->copyRectToScreen(g_hdb->_gfx->_globalSurface.getBasePtr(clip.left, clip.top), g_hdb->_gfx->_globalSurface.pitch, clip.left, clip.top, clip.width(), clip.height());
 		return 1;
@@ -1447,11 +1449,7 @@ int Tile::draw(int x, int y) {
 }
 
 int Tile::drawMasked(int x, int y, int alpha) {
-	g_hdb->_gfx->_globalSurface.transBlitFrom(_surface, Common::Point(x, y), 0xf81f, false, 0, alpha & 0xff);
-
-	Common::Rect clip(_surface.getBounds());
-	clip.moveTo(x, y);
-	clip.clip(g_hdb->_gfx->_globalSurface.getBounds());
+	Common::Rect clip(blitMasked(x, y, alpha));
 	if (!clip.isEmpty()) {
 		g_system->copyRectToScreen(g_hdb->_gfx->_globalSurface.getBasePtr(clip.left, clip.top), g_hdb->_gfx->_globalSurface.pitch, clip.left, clip.top, clip.width(), clip.height());
 		return 1;
@@ -1459,4 +1457,22 @@ int Tile::drawMasked(int x, int y, int alpha) {
 	return 0;
 }
 
+Common::Rect Tile::blit(int x, int y) {
+	g_hdb->_gfx->_globalSurface.blitFrom(_surface, Common::Point(x, y));
+
+	Common::Rect clip(_surface.getBounds());
+	clip.moveTo(x, y);
+	clip.clip(g_hdb->_gfx->_globalSurface.getBounds());
+	return clip;
+}
+
+Common::Rect Tile::blitMasked(int x, int y, int alpha) {
+	g_hdb->_gfx->_globalSurface.transBlitFrom(_surface, Common::Point(x, y), 0xf81f, false, 0, alpha & 0xff);
+
+	Common::Rect clip(_surface.getBounds());
+	clip.moveTo(x, y);
+	clip.clip(g_hdb->_gfx->_globalSurface.getBounds());
+	return clip;
+}
+
 }
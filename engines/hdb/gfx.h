@@ -82,6 +82,7 @@ public:
 	void loadSaveFile(Common::InSaveFile *in);
 	void fillScreen(uint32 color);
 	void updateVideo();
+	void copyToScreen(Common::Rect rect);
 	void setPointerState(int value);
 	void drawPointer();
 	void showPointer(bool status) {
@@ -264,6 +265,10 @@ public:
 	int draw(int x, int y);
 	int drawMasked(int x, int y, int alpha = 0xff);
 
+	// Like draw() and drawMasked(), but leave copying to the screen to the caller
+	Common::Rect blit(int x, int y);
+	Common::Rect blitMasked(int x, int y, int alpha = 0xff);
+
 	uint32 _flags;
 
 	char *getName() { return _name; }
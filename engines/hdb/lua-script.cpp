@@ -124,7 +124,7 @@ LuaScript::LuaScript() {
 
 LuaScript::~LuaScript() {
 	if (_state)
-		lua_close(_state);
+		luaL_closestate(_state);
 
 	if (_globalLuaStream)
 		delete _globalLuaStream;
@@ -1761,7 +1761,7 @@ void debugHook(lua_State *L, lua_Debug *ar) {
 
 bool LuaScript::initScript(Common::SeekableReadStream *stream, const char *scriptName, int32 length) {
 	if (_state != NULL) {
-		lua_close(_state);
+		luaL_closestate(_state);
 	}
 
 	// Initialize Lua Environment
@@ -857,6 +857,16 @@ bool Map::load(Common::SeekableReadStream *stream) {
 	return true;
 }
 
+static void addDrawnRect(Common::Rect &drawn, const Common::Rect &rect) {
+	if (rect.isEmpty())
+		return;
+
+	if (drawn.isEmpty())
+		drawn = rect;
+	else
+		drawn.extend(rect);
+}
+
 void Map::draw() {
 	if (!_mapLoaded)
 		return;
@@ -893,6 +903,9 @@ void Map::draw() {
 
 	_numForegrounds = _numGratings = 0;
 
+	// The tiles are copied to the screen together once they are all drawn
+	Common::Rect drawn;
+
 	for (int j = 0; j < maxTileY; j++) {
 		int screenX = _mapTileXOff;
 		for (int i = 0; i < maxTileX; i++) {
@@ -907,7 +920,7 @@ void Map::draw() {
 			if (!g_hdb->_gfx->isSky(tileIndex)) {
 				Tile *tile = g_hdb->_gfx->getTile(tileIndex);
 				if (tile)
-					tile->draw(screenX, screenY);
+					addDrawnRect(drawn, tile->blit(screenX, screenY));
 				else
 					warning("Cannot find tile with index %d at %d,%d", tileIndex, _mapTileX + i, _mapTileY + j);
 			}
@@ -934,9 +947,9 @@ void Map::draw() {
 							_numForegrounds++;
 					} else {
 						if (fTile->_flags & kFlagMasked) {
-							fTile->drawMasked(screenX, screenY);
+							addDrawnRect(drawn, fTile->blitMasked(screenX, screenY));
 						} else {
-							fTile->draw(screenX, screenY);
+							addDrawnRect(drawn, fTile->blit(screenX, screenY));
 						}
 					}
 				}
@@ -948,6 +961,8 @@ void Map::draw() {
 		screenY += kTileWidth;
 	}
 
+	g_hdb->_gfx->copyToScreen(drawn);
+
 	if (g_hdb->isDemo() && g_hdb->isPPC())
 		drawEnts();
 
@@ -992,18 +1007,26 @@ void Map::drawEnts() {
 }
 
 void Map::drawGratings() {
+	Common::Rect drawn;
+
 	for (int i = 0; i < _numGratings; i++) {
-		g_hdb->_gfx->getTile(_gratings[i].tile)->drawMasked(_gratings[i].x, _gratings[i].y);
+		addDrawnRect(drawn, g_hdb->_gfx->getTile(_gratings[i].tile)->blitMasked(_gratings[i].x, _gratings[i].y));
 	}
 
+	g_hdb->_gfx->copyToScreen(drawn);
+
 	debug(8, "Gratings Count: %d", _numGratings);
 }
 
 void Map::drawForegrounds() {
+	Common::Rect drawn;
+
 	for (int i = 0; i < _numForegrounds; i++) {
-		g_hdb->_gfx->getTile(_foregrounds[i].tile)->drawMasked(_foregrounds[i].x, _foregrounds[i].y);
+		addDrawnRect(drawn, g_hdb->_gfx->getTile(_foregrounds[i].tile)->blitMasked(_foregrounds[i].x, _foregrounds[i].y));
 	}
 
+	g_hdb->_gfx->copyToScreen(drawn);
+
 	debug(8, "Foregrounds Count: %d", _numForegrounds);
 }
 
@@ -907,9 +907,7 @@ bool IllusionsEngine_Duckman::loadScene(uint32 sceneId) {
 	uint resourcesCount;
 	uint32 *resources;
 	sceneInfo->getResources(resourcesCount, resources);
-	for (uint i = 0; i < resourcesCount; ++i) {
-		_resSys->loadResource(resources[i], sceneId, 0);
-	}
+	_resSys->loadResources(resourcesCount, resources, sceneId, 0);
 	return true;
 }
 
@@ -41,6 +41,14 @@ byte *ResourceReaderFileReader::readResource(uint32 sceneId, uint32 resId, uint3
 	return data;
 }
 
+Common::SeekableReadStream *ResourceReaderFileReader::openResource(uint32 sceneId, uint32 resId) {
+	Common::String filename = buildResourceFilename(resId);
+	Common::File *fd = new Common::File();
+	if (!fd->open(filename))
+		error("ResourceReaderFileReader::openResource() Could not open %s for reading", filename.c_str());
+	return fd;
+}
+
 Common::String ResourceReaderFileReader::buildResourceFilename(uint32 resId) {
 	const char *ext = getResourceExtension(resId);
 	return Common::String::format("%08X%s", resId, ext);
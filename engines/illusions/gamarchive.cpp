@@ -22,10 +22,12 @@
 
 #include "illusions/gamarchive.h"
 
+#include "common/substream.h"
+
 namespace Illusions {
 
 GamArchive::GamArchive(const char *filename)
-	: _fd(0), _groupCount(0), _groups(0) {
+	: _filename(filename), _fd(0), _groupCount(0), _groups(0) {
 	_fd = new Common::File();
 	if (!_fd->open(filename))
 		error("GamArchive::GamArchive() Could not open %s", filename);
@@ -45,6 +47,14 @@ byte *GamArchive::readResource(uint32 sceneId, uint32 resId, uint32 &dataSize) {
 	return data;
 }
 
+Common::SeekableReadStream *GamArchive::openResource(uint32 sceneId, uint32 resId) {
+	const GamFileEntry *fileEntry = getGroupFileEntry(sceneId, resId);
+	Common::File *fd = new Common::File();
+	if (!fd->open(_filename))
+		error("GamArchive::openResource() Could not open %s", _filename.c_str());
+	return new Common::SeekableSubReadStream(fd, fileEntry->_fileOffset, fileEntry->_fileOffset + fileEntry->_fileSize, DisposeAfterUse::YES);
+}
+
 void GamArchive::loadDictionary() {
 	_groupCount = _fd->readUint32LE();
 	_groups = new GamGroupEntry[_groupCount];
@@ -50,7 +50,9 @@ public:
 	GamArchive(const char *filename);
 	~GamArchive();
 	byte *readResource(uint32 sceneId, uint32 resId, uint32 &dataSize);
+	Common::SeekableReadStream *openResource(uint32 sceneId, uint32 resId);
 protected:
+	Common::String _filename;
 	Common::File *_fd;
 	uint _groupCount;
 	GamGroupEntry *_groups;
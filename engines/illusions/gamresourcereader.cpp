@@ -41,4 +41,8 @@ byte *ResourceReaderGamArchive::readResource(uint32 sceneId, uint32 resId, uint3
 	return _gamArchive->readResource(sceneId, resId, dataSize);
 }
 
+Common::SeekableReadStream *ResourceReaderGamArchive::openResource(uint32 sceneId, uint32 resId) {
+	return _gamArchive->openResource(sceneId, resId);
+}
+
 } // End of namespace Illusions
@@ -35,6 +35,7 @@ public:
 	ResourceReaderGamArchive(const char *filename);
 	~ResourceReaderGamArchive();
 	byte *readResource(uint32 sceneId, uint32 resId, uint32 &dataSize);
+	Common::SeekableReadStream *openResource(uint32 sceneId, uint32 resId);
 protected:
 	GamArchive *_gamArchive;
 };
@@ -31,6 +31,8 @@ class BaseResourceReader {
 public:
 	virtual ~BaseResourceReader() {}
 	virtual byte *readResource(uint32 sceneId, uint32 resId, uint32 &dataSize) = 0;
+	// Returns a stream with its own file handle, so that it can be read on any thread
+	virtual Common::SeekableReadStream *openResource(uint32 sceneId, uint32 resId) = 0;
 };
 
 } // End of namespace Illusions
@@ -26,6 +26,7 @@
 
 #include "common/algorithm.h"
 #include "common/debug.h"
+#include "common/taskscheduler.h"
 
 namespace Illusions {
 
@@ -79,18 +80,77 @@ void ResourceSystem::loadResource(uint32 resId, uint32 sceneId, uint32 threadId)
 	debug(1, "ResourceSystem::loadResource(%08X, %08X, %08X)", resId, sceneId, threadId);
 	BaseResourceLoader *resourceLoader = getResourceLoader(resId);
 
+	Resource *resource = createResource(resId, sceneId, threadId);
+
+	if (resourceLoader->isFlag(kRlfLoadFile)) {
+		debug(1, "ResourceSystem::loadResource() kRlfLoadFile");
+		resource->loadData(_vm->_resReader);
+	}
+
+	finishLoading(resource, resourceLoader);
+}
+
+class ResourceReadTask : public Common::Task {
+public:
+	ResourceReadTask(Resource *resource, Common::SeekableReadStream *stream)
+		: _resource(resource), _stream(stream) {
+	}
+	~ResourceReadTask() {
+		delete _stream;
+	}
+	void run() {
+		_resource->_dataSize = _stream->size();
+		_resource->_data = (byte*)malloc(_resource->_dataSize);
+		_stream->read(_resource->_data, _resource->_dataSize);
+	}
+protected:
+	Resource *_resource;
+	Common::SeekableReadStream *_stream;
+};
+
+void ResourceSystem::loadResources(uint count, const uint32 *resIds, uint32 sceneId, uint32 threadId) {
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (scheduler->isSerial() || count < 2) {
+		for (uint i = 0; i < count; ++i)
+			loadResource(resIds[i], sceneId, threadId);
+		return;
+	}
+
+	debug(1, "ResourceSystem::loadResources(%d, %08X, %08X)", count, sceneId, threadId);
+
+	// Only the data is read on other threads. The resource loaders register
+	// what they load with the engine, so they run here, in the given order,
+	// as soon as the data of their resource is in.
+	Common::Array<Resource*> resources;
+	Common::Array<Common::TaskFuture> reads;
+	resources.resize(count);
+	reads.resize(count);
+	for (uint i = 0; i < count; ++i) {
+		resources[i] = createResource(resIds[i], sceneId, threadId);
+		if (getResourceLoader(resIds[i])->isFlag(kRlfLoadFile)) {
+			Common::SeekableReadStream *stream = _vm->_resReader->openResource(sceneId, resIds[i]);
+			reads[i] = scheduler->schedule(new ResourceReadTask(resources[i], stream));
+		}
+	}
+
+	for (uint i = 0; i < count; ++i) {
+		if (reads[i].isValid())
+			reads[i].wait();
+		finishLoading(resources[i], getResourceLoader(resIds[i]));
+	}
+}
+
+Resource *ResourceSystem::createResource(uint32 resId, uint32 sceneId, uint32 threadId) {
 	Resource *resource = new Resource();
 	resource->_loaded = false;
 	resource->_resId = resId;
 	resource->_sceneId = sceneId;
 	resource->_threadId = threadId;
 	resource->_gameId = _vm->getGameId();
+	return resource;
+}
 
-	if (resourceLoader->isFlag(kRlfLoadFile)) {
-		debug(1, "ResourceSystem::loadResource() kRlfLoadFile");
-		resource->loadData(_vm->_resReader);
-	}
-
+void ResourceSystem::finishLoading(Resource *resource, BaseResourceLoader *resourceLoader) {
 	resourceLoader->load(resource);
 
 	if (resourceLoader->isFlag(kRlfFreeDataAfterLoad)) {
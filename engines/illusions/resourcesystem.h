@@ -91,6 +91,8 @@ public:
 	void addResourceLoader(uint32 resTypeId, BaseResourceLoader *resourceLoader);
 
 	void loadResource(uint32 resId, uint32 sceneId, uint32 threadId);
+	// Loads the resources in order, reading their data in parallel
+	void loadResources(uint count, const uint32 *resIds, uint32 sceneId, uint32 threadId);
 	void unloadResourceById(uint32 resId);
 	void unloadResourcesBySceneId(uint32 sceneId);
 	void unloadSceneResources(uint32 sceneId1, uint32 sceneId2);
@@ -139,6 +141,8 @@ protected:
 		}
 	};
 
+	Resource *createResource(uint32 resId, uint32 sceneId, uint32 threadId);
+	void finishLoading(Resource *resource, BaseResourceLoader *resourceLoader);
 	void unloadResource(Resource *resource);
 
 };
@@ -1686,6 +1686,20 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	if (flags & 0x800)
 		dsPlot3 = dsPlotFunc[((flags >> 8) & 0xF7) & 0x3F];
 
+	// Most shapes are drawn unscaled, either as they are or through a
+	// color table. Those lines are drawn by kernels which do the plotting
+	// inline instead of calling _dsPlot for every pixel.
+	if (!(drawFunc & DSF_SCALE) && (ppc == 0 || ppc == 4)) {
+		static const DsLineFunc dsLineFuncNoScalePlot[] = {
+			&Screen::drawShapeProcessLineNoScalePlot<false, 0>,
+			&Screen::drawShapeProcessLineNoScalePlot<true, 0>,
+			&Screen::drawShapeProcessLineNoScalePlot<false, 4>,
+			&Screen::drawShapeProcessLineNoScalePlot<true, 4>
+		};
+
+		_dsProcessLine = dsLineFuncNoScalePlot[(ppc >> 1) | (drawFunc & DSF_X_FLIPPED)];
+	}
+
 	if (!_dsPlot || !dsPlot2 || !dsPlot3) {
 		if (!dsPlot2)
 			warning("Missing drawShape plotting method type %d", ppc);
@@ -2087,6 +2101,38 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 	cnt = -1;
 }
 
+template<bool downwind, int plotType>
+void Screen::drawShapeProcessLineNoScalePlot(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
+	const uint8 *colorTable = _dsColorTable;
+
+	do {
+		if (*src) {
+			// Plot the whole run of pixels up to the next skip at once
+			int run = 1;
+			while (run < cnt && src[run])
+				++run;
+
+			if (plotType == 0 && !downwind) {
+				memcpy(dst, src, run);
+				dst += run;
+			} else {
+				for (int i = 0; i < run; ++i) {
+					*dst = (plotType == 4) ? colorTable[src[i]] : src[i];
+					dst += downwind ? -1 : 1;
+				}
+			}
+
+			src += run;
+			cnt -= run;
+		} else {
+			const uint8 c = src[1];
+			src += 2;
+			dst += downwind ? -c : c;
+			cnt -= c;
+		}
+	} while (cnt > 0);
+}
+
 void Screen::drawShapePlotType0(uint8 *dst, uint8 cmd) {
 	*dst = cmd;
 }
@@ -752,6 +752,10 @@ protected:
 	void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 	void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 
+	// Unscaled lines with plotting type 0 or 4 inlined, see drawShape()
+	template<bool downwind, int plotType>
+	void drawShapeProcessLineNoScalePlot(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+
 	void drawShapePlotType0(uint8 *dst, uint8 cmd);
 	void drawShapePlotType1(uint8 *dst, uint8 cmd);
 	void drawShapePlotType3_7(uint8 *dst, uint8 cmd);
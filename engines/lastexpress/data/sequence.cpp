@@ -78,7 +78,8 @@ void FrameInfo::read(Common::SeekableReadStream *in, bool isSequence) {
 
 AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /* ignoreSubtype */) : _palette(NULL) {
 	_palSize = 1;
-	// TODO: use just the needed rectangle
+	// Decompress at full screen size, as the data addresses pixels (and
+	// copies earlier ones) by screen offset, and crop the result afterwards
 	_image.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
 
 	//debugC(6, kLastExpressDebugGraphics, "    Offsets: data=%d, unknown=%d, palette=%d", f.dataOffset, f.unknown, f.paletteOffset);
@@ -94,32 +95,50 @@ AnimFrame::AnimFrame(Common::SeekableReadStream *in, const FrameInfo &f, bool /*
 	//debugC(6, kLastExpressDebugGraphics, "    Location: %d", f.location);
 	//debugC(6, kLastExpressDebugGraphics, "    next: %d", f.next);
 
+	// Decompress straight from memory when the stream is held there
+	uint32 size = (uint32)in->size();
+	const byte *data = in->getDataPointer();
+	byte *buffer = NULL;
+	if (!data) {
+		buffer = new byte[size];
+		in->seek(0);
+		in->read(buffer, size);
+		data = buffer;
+	}
+
+	const byte *start = data + MIN<uint32>(f.dataOffset, size);
+	const byte *end = data + size;
+
 	switch (f.compressionType) {
 	case 0:
 		// Empty frame
 		break;
 	case 3:
-		decomp3(in, f);
+		decomp3(start, end, f);
 		break;
 	case 4:
-		decomp4(in, f);
+		decomp4(start, end, f);
 		break;
 	case 5:
-		decomp5(in, f);
+		decomp5(start, end, f);
 		break;
 	case 7:
-		decomp7(in, f);
+		decomp7(start, end, f);
 		break;
 	case 255:
-		decompFF(in, f);
+		decompFF(start, end, f);
 		break;
 	default:
 		error("[AnimFrame::AnimFrame] Unknown frame compression: %d", f.compressionType);
 	}
 
+	delete[] buffer;
+
 	readPalette(in, f);
 	_rect = Common::Rect((int16)f.xPos1, (int16)f.yPos1, (int16)f.xPos2, (int16)f.yPos2);
 	//_rect.debugPrint(0, "Frame rect:");
+
+	crop();
 }
 
 AnimFrame::~AnimFrame() {
@@ -128,15 +147,56 @@ AnimFrame::~AnimFrame() {
 }
 
 Common::Rect AnimFrame::draw(Graphics::Surface *s) {
-	byte *inp = (byte *)_image.getPixels();
-	uint16 *outp = (uint16 *)s->getPixels();
-	for (int i = 0; i < 640 * 480; i++, inp++, outp++) {
-		if (*inp)
-			*outp = _palette[*inp];
+	for (int y = 0; y < _image.h; y++) {
+		const byte *inp = (const byte *)_image.getBasePtr(0, y);
+		uint16 *outp = (uint16 *)s->getBasePtr(_bounds.left, _bounds.top + y);
+		for (int x = 0; x < _image.w; x++) {
+			if (inp[x])
+				outp[x] = _palette[inp[x]];
+		}
 	}
 	return _rect;
 }
 
+uint32 AnimFrame::getMemorySize() const {
+	return sizeof(AnimFrame) + _image.h * _image.pitch + _palSize * sizeof(uint16);
+}
+
+void AnimFrame::crop() {
+	// Find the bounds of the non-transparent pixels
+	int16 left = 640, top = 480, right = 0, bottom = 0;
+	for (int16 y = 0; y < 480; y++) {
+		const byte *row = (const byte *)_image.getBasePtr(0, y);
+
+		int16 x1 = 0;
+		while (x1 < 640 && !row[x1])
+			x1++;
+		if (x1 == 640)
+			continue;
+
+		int16 x2 = 640;
+		while (!row[x2 - 1])
+			x2--;
+
+		left = MIN(left, x1);
+		right = MAX(right, x2);
+		if (top > y)
+			top = y;
+		bottom = y + 1;
+	}
+
+	Graphics::Surface cropped;
+	if (top < bottom) {
+		_bounds = Common::Rect(left, top, right, bottom);
+		cropped.copyFrom(_image.getSubArea(_bounds));
+	} else {
+		_bounds = Common::Rect();
+	}
+
+	_image.free();
+	_image = cropped;
+}
+
 void AnimFrame::readPalette(Common::SeekableReadStream *in, const FrameInfo &f) {
 	// Read the palette
 	in->seek((int)f.paletteOffset);
@@ -146,15 +206,20 @@ void AnimFrame::readPalette(Common::SeekableReadStream *in, const FrameInfo &f)
 	}
 }
 
-void AnimFrame::decomp3(Common::SeekableReadStream *in, const FrameInfo &f) {
-	decomp34(in, f, 0x7, 3);
+// Read the next byte of compressed data; like a stream, return 0 past the end
+static inline byte readData(const byte *&in, const byte *end) {
+	return (in < end) ? *in++ : 0;
+}
+
+void AnimFrame::decomp3(const byte *in, const byte *end, const FrameInfo &f) {
+	decomp34(in, end, f, 0x7, 3);
 }
 
-void AnimFrame::decomp4(Common::SeekableReadStream *in, const FrameInfo &f) {
-	decomp34(in, f, 0xf, 4);
+void AnimFrame::decomp4(const byte *in, const byte *end, const FrameInfo &f) {
+	decomp34(in, end, f, 0xf, 4);
 }
 
-void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte mask, byte shift) {
+void AnimFrame::decomp34(const byte *in, const byte *end, const FrameInfo &f, byte mask, byte shift) {
 	byte *p = (byte *)_image.getPixels();
 
 	uint32 skip = f.initialSkip / 2;
@@ -166,9 +231,8 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 
 	uint32 numBlanks = 640 - (f.xPos2 - f.xPos1);
 
-	in->seek((int)f.dataOffset);
 	for (uint32 out = skip; out < size; ) {
-		uint16 opcode = in->readByte();
+		uint16 opcode = readData(in, end);
 
 		if (opcode & 0x80) {
 			if (opcode & 0x40) {
@@ -177,7 +241,7 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 			} else {
 				opcode &= 0x3f;
 				if (opcode & 0x20) {
-					opcode = ((opcode & 0x1f) << 8) + in->readByte();
+					opcode = ((opcode & 0x1f) << 8) + readData(in, end);
 					if (opcode & 0x1000) {
 						out += opcode & 0xfff;
 						continue;
@@ -191,15 +255,14 @@ void AnimFrame::decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byt
 			if (_palSize <= value)
 				_palSize = value + 1;
 			if (!opcode)
-				opcode = in->readByte();
-			for (int i = 0; i < opcode; i++, out++) {
-				p[out] = value;
-			}
+				opcode = readData(in, end);
+			memset(p + out, value, opcode);
+			out += opcode;
 		}
 	}
 }
 
-void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
+void AnimFrame::decomp5(const byte *in, const byte *end, const FrameInfo &f) {
 	byte *p = (byte *)_image.getPixels();
 
 	uint32 skip = f.initialSkip / 2;
@@ -209,11 +272,10 @@ void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
 	//assert (f.yPos1 == skip / 640);
 	//assert (f.yPos2 == size / 640);
 
-	in->seek((int)f.dataOffset);
 	for (uint32 out = skip; out < size; ) {
-		uint16 opcode = in->readByte();
+		uint16 opcode = readData(in, end);
 		if (!(opcode & 0x1f)) {
-			opcode = (uint16)((opcode << 3) + in->readByte());
+			opcode = (uint16)((opcode << 3) + readData(in, end));
 			if (opcode & 0x400) {
 				// skip these 10 bits
 				out += (opcode & 0x3ff);
@@ -226,15 +288,14 @@ void AnimFrame::decomp5(Common::SeekableReadStream *in, const FrameInfo &f) {
 			if (_palSize <= value)
 				_palSize = value + 1;
 			if (!opcode)
-				opcode = in->readByte();
-			for (int i = 0; i < opcode; i++, out++) {
-				p[out] = value;
-			}
+				opcode = readData(in, end);
+			memset(p + out, value, opcode);
+			out += opcode;
 		}
 	}
 }
 
-void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
+void AnimFrame::decomp7(const byte *in, const byte *end, const FrameInfo &f) {
 	byte *p = (byte *)_image.getPixels();
 
 	uint32 skip = f.initialSkip / 2;
@@ -246,9 +307,8 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 
 	uint32 numBlanks = 640 - (f.xPos2 - f.xPos1);
 
-	in->seek((int)f.dataOffset);
 	for (uint32 out = skip; out < size; ) {
-		uint16 opcode = in->readByte();
+		uint16 opcode = readData(in, end);
 		if (opcode & 0x80) {
 			if (opcode & 0x40) {
 				if (opcode & 0x20) {
@@ -257,7 +317,7 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 				} else {
 					opcode &= 0x1f;
 					if (opcode & 0x10) {
-						opcode = ((opcode & 0xf) << 8) + in->readByte();
+						opcode = ((opcode & 0xf) << 8) + readData(in, end);
 						if (opcode & 0x800) {
 							// skip these 11 bits
 							out += (opcode & 0x7ff);
@@ -270,12 +330,11 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 				}
 			} else {
 				opcode &= 0x3f;
-				byte value = in->readByte();
+				byte value = readData(in, end);
 				if (_palSize <= value)
 					_palSize = value + 1;
-				for (int i = 0; i < opcode; i++, out++) {
-					p[out] = value;
-				}
+				memset(p + out, value, opcode);
+				out += opcode;
 			}
 		} else {
 			if (_palSize <= opcode)
@@ -287,15 +346,14 @@ void AnimFrame::decomp7(Common::SeekableReadStream *in, const FrameInfo &f) {
 	}
 }
 
-void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
+void AnimFrame::decompFF(const byte *in, const byte *end, const FrameInfo &f) {
 	byte *p = (byte *)_image.getPixels();
 
 	uint32 skip = f.initialSkip / 2;
 	uint32 size = f.decompressedEndOffset / 2;
 
-	in->seek((int)f.dataOffset);
 	for (uint32 out = skip; out < size; ) {
-		uint16 opcode = in->readByte();
+		uint16 opcode = readData(in, end);
 
 		if (opcode < 0x80) {
 			if (_palSize <= opcode)
@@ -307,22 +365,27 @@ void AnimFrame::decompFF(Common::SeekableReadStream *in, const FrameInfo &f) {
 			if (opcode < 0xf0) {
 				if (opcode < 0xe0) {
 					// copy old part
-					uint32 old = out + ((opcode & 0x7) << 8) + in->readByte() - 2048;
+					uint32 old = out + ((opcode & 0x7) << 8) + readData(in, end) - 2048;
 					opcode = ((opcode >> 3) & 0xf) + 3;
-					for (int i = 0; i < opcode; i++, out++, old++) {
-						p[out] = p[old];
+					if (out - old >= opcode) {
+						memcpy(p + out, p + old, opcode);
+						out += opcode;
+					} else {
+						// The copy overlaps its own output, repeating the last pixels
+						for (int i = 0; i < opcode; i++, out++, old++) {
+							p[out] = p[old];
+						}
 					}
 				} else {
 					opcode = (opcode & 0xf) + 1;
-					byte value = in->readByte();
+					byte value = readData(in, end);
 					if (_palSize <= value)
 						_palSize = value + 1;
-					for (int i = 0; i < opcode; i++, out++) {
-						p[out] = value;
-					}
+					memset(p + out, value, opcode);
+					out += opcode;
 				}
 			} else {
-				out += ((opcode & 0xf) << 8) + in->readByte();
+				out += ((opcode & 0xf) << 8) + readData(in, end);
 			}
 		}
 	}
@@ -338,11 +401,25 @@ Sequence::~Sequence() {
 }
 
 void Sequence::reset() {
+	for (uint i = 0; i < _cache.size(); i++)
+		freeFrame(_cache[i]);
+
 	_frames.clear();
+	_cache.clear();
+	_useCount = 0;
 	delete _stream;
 	_stream = NULL;
 }
 
+void Sequence::freeFrame(CachedFrame &cached) {
+	if (!cached.frame)
+		return;
+
+	_cacheSize -= cached.frame->getMemorySize();
+	delete cached.frame;
+	cached.frame = NULL;
+}
+
 Sequence *Sequence::load(Common::String name, Common::SeekableReadStream *stream, byte field30) {
 	Sequence *sequence = new Sequence(name);
 
@@ -363,8 +440,15 @@ bool Sequence::load(Common::SeekableReadStream *stream, byte field30) {
 
 	_field30 = field30;
 
-	// Keep stream for later decoding of sequence
-	_stream = stream;
+	// Keep stream for later decoding of sequence. The frames are decoded
+	// from memory, so sequences read from the archive are loaded whole
+	if (stream->getDataPointer()) {
+		_stream = stream;
+	} else {
+		stream->seek(0);
+		_stream = stream->readStream((uint32)stream->size());
+		delete stream;
+	}
 
 	// Read header to get the number of frames
 	_stream->seek(0);
@@ -389,6 +473,8 @@ bool Sequence::load(Common::SeekableReadStream *stream, byte field30) {
 		_frames.push_back(info);
 	}
 
+	_cache.resize(numframes);
+
 	_isLoaded = true;
 
 	return true;
@@ -415,9 +501,33 @@ AnimFrame *Sequence::getFrame(uint16 index) {
 	if (frame->compressionType == 0)
 		return NULL;
 
+	// Entities redraw the same few frames over and over, so keep the most
+	// recently used ones decoded
+	CachedFrame &cached = _cache[index];
+	cached.lastUse = ++_useCount;
+	if (cached.frame)
+		return cached.frame;
+
 	debugC(9, kLastExpressDebugGraphics, "Decoding sequence %s: frame %d / %d", _name.c_str(), index, _frames.size() - 1);
 
-	return new AnimFrame(_stream, *frame);
+	cached.frame = new AnimFrame(_stream, *frame);
+	_cacheSize += cached.frame->getMemorySize();
+
+	// Free the frames used longest ago, but always keep the new one
+	while (_cacheSize > _frameCacheSize) {
+		CachedFrame *oldest = NULL;
+		for (uint i = 0; i < _cache.size(); i++) {
+			if (i != index && _cache[i].frame && (!oldest || _cache[i].lastUse < oldest->lastUse))
+				oldest = &_cache[i];
+		}
+
+		if (!oldest)
+			break;
+
+		freeFrame(*oldest);
+	}
+
+	return cached.frame;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -438,11 +548,7 @@ Common::Rect SequenceFrame::draw(Graphics::Surface *surface) {
 	if (!f)
 		return Common::Rect();
 
-	Common::Rect rect = f->draw(surface);
-
-	delete f;
-
-	return rect;
+	return f->draw(surface);
 }
 
 bool SequenceFrame::setFrame(uint16 frame) {
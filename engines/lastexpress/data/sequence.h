@@ -134,16 +134,20 @@ public:
 	~AnimFrame();
 	Common::Rect draw(Graphics::Surface *s);
 
+	uint32 getMemorySize() const;
+
 private:
-	void decomp3(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decomp4(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decomp34(Common::SeekableReadStream *in, const FrameInfo &f, byte mask, byte shift);
-	void decomp5(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decomp7(Common::SeekableReadStream *in, const FrameInfo &f);
-	void decompFF(Common::SeekableReadStream *in, const FrameInfo &f);
+	void decomp3(const byte *in, const byte *end, const FrameInfo &f);
+	void decomp4(const byte *in, const byte *end, const FrameInfo &f);
+	void decomp34(const byte *in, const byte *end, const FrameInfo &f, byte mask, byte shift);
+	void decomp5(const byte *in, const byte *end, const FrameInfo &f);
+	void decomp7(const byte *in, const byte *end, const FrameInfo &f);
+	void decompFF(const byte *in, const byte *end, const FrameInfo &f);
 	void readPalette(Common::SeekableReadStream *in, const FrameInfo &f);
+	void crop();
 
-	Graphics::Surface _image;
+	Graphics::Surface _image;     ///< Non-transparent part of the frame, at _bounds on screen
+	Common::Rect _bounds;
 	uint16 _palSize;
 	uint16 *_palette;
 	Common::Rect _rect;
@@ -151,7 +155,7 @@ private:
 
 class Sequence {
 public:
-	Sequence(Common::String name) : _stream(NULL), _isLoaded(false), _name(name), _field30(15) {}
+	Sequence(Common::String name) : _cacheSize(0), _useCount(0), _stream(NULL), _isLoaded(false), _name(name), _field30(15) {}
 	~Sequence();
 
 	static Sequence *load(Common::String name, Common::SeekableReadStream *stream = NULL, byte field30 = 15);
@@ -159,7 +163,7 @@ public:
 	bool load(Common::SeekableReadStream *stream, byte field30 = 15);
 
 	uint16 count() const { return (uint16)_frames.size(); }
-	AnimFrame *getFrame(uint16 index = 0);
+	AnimFrame *getFrame(uint16 index = 0); ///< The frame is owned by the sequence
 	FrameInfo *getFrameInfo(uint16 index = 0);
 
 	Common::String getName() { return _name; }
@@ -170,10 +174,22 @@ public:
 private:
 	static const uint32 _sequenceHeaderSize = 8;
 	static const uint32 _sequenceFrameSize = 68;
+	static const uint32 _frameCacheSize = 256 * 1024; ///< Memory for decoded frames, per sequence
+
+	struct CachedFrame {
+		AnimFrame *frame;
+		uint32 lastUse;
+
+		CachedFrame() : frame(NULL), lastUse(0) {}
+	};
 
 	void reset();
+	void freeFrame(CachedFrame &cached);
 
 	Common::Array<FrameInfo> _frames;
+	Common::Array<CachedFrame> _cache;
+	uint32 _cacheSize;
+	uint32 _useCount;
 	Common::SeekableReadStream *_stream;
 	bool _isLoaded;
 
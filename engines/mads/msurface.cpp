@@ -32,6 +32,64 @@ namespace MADS {
 
 MADSEngine *BaseSurface::_vm = nullptr;
 
+enum SpriteDepthMode {
+	kSpriteDepthNone = 0,
+	kSpriteDepthNibbles = 1,
+	kSpriteDepthPacked = 2
+};
+
+typedef void (*SpriteLineProc)(byte *destP, const byte *srcP, const int *srcOffsets, int direction,
+	int count, DepthSurface *depthSurface, int destX, int destY, int depth, int transparentColor);
+
+/**
+ * Draws one line of a sprite from left to right, checking each pixel against
+ * the depth surface the same way DepthSurface::getDepth() does. The source
+ * pixel for each destination pixel is given by srcOffsets when scaled, and
+ * is the next one in the given direction otherwise.
+ */
+template<int DEPTH_MODE, bool SCALED>
+static void copySpriteLine(byte *destP, const byte *srcP, const int *srcOffsets, int direction,
+		int count, DepthSurface *depthSurface, int destX, int destY, int depth, int transparentColor) {
+	const byte *depthP = nullptr;
+	int depthCount = 0;
+
+	if (DEPTH_MODE == kSpriteDepthPacked) {
+		depthP = (const byte *)depthSurface->getBasePtr(0, destY);
+	} else if (DEPTH_MODE == kSpriteDepthNibbles) {
+		// Pixels outside of the depth surface have a depth of 0
+		if (destY >= 0 && destY < depthSurface->h && destX < depthSurface->w) {
+			depthP = (const byte *)depthSurface->getBasePtr(destX, destY);
+			depthCount = MIN(count, depthSurface->w - destX);
+		}
+	}
+
+	for (int xp = 0; xp < count; ++xp) {
+		byte pixel = SCALED ? srcP[srcOffsets[xp]] : srcP[xp * direction];
+		if (pixel == transparentColor)
+			continue;
+
+		int pixelDepth = 15;
+		if (DEPTH_MODE == kSpriteDepthPacked) {
+			int x = destX + xp;
+			pixelDepth = depthP[x >> 2] >> ((3 - (x % 4)) * 2);
+		} else if (DEPTH_MODE == kSpriteDepthNibbles) {
+			pixelDepth = (xp < depthCount) ? (depthP[xp] & 0xF) : 0;
+		}
+
+		if (depth <= pixelDepth)
+			destP[xp] = pixel;
+	}
+}
+
+template<bool SCALED>
+static SpriteLineProc getSpriteLineProc(DepthSurface *depthSurface) {
+	if (depthSurface == nullptr)
+		return &copySpriteLine<kSpriteDepthNone, SCALED>;
+	if (depthSurface->_depthStyle == 2)
+		return &copySpriteLine<kSpriteDepthPacked, SCALED>;
+	return &copySpriteLine<kSpriteDepthNibbles, SCALED>;
+}
+
 int BaseSurface::scaleValue(int value, int scale, int err) {
 	int scaled = 0;
 	while (value--) {
@@ -360,21 +418,16 @@ void BaseSurface::copyFrom(BaseSurface &src, const Common::Point &destPos, int d
 			srcPtr += copyRect.width() - 1;
 
 		// 100% scaling variation
+		SpriteLineProc copyLine = getSpriteLineProc<false>(depthSurface);
 		for (int rowCtr = 0; rowCtr < copyRect.height(); ++rowCtr) {
-			// Copy each byte one at a time checking against the depth
-			for (int xCtr = 0; xCtr < copyRect.width(); ++xCtr) {
-				byte *srcP = srcPtr + xCtr * direction;
-				int pixelDepth = depthSurface == nullptr ? 15 :
-					depthSurface->getDepth(Common::Point(destX + xCtr, destY + rowCtr));
-
-				if ((depth <= pixelDepth) && (*srcP != transparentColor))
-					destPtr[xCtr] = *srcP;
-			}
+			copyLine(destPtr, srcPtr, nullptr, direction, copyRect.width(), depthSurface,
+				destX, destY + rowCtr, depth, transparentColor);
 
 			srcPtr += src.w;
 			destPtr += this->w;
 		}
 
+		addDirtyRect(Common::Rect(destX, destY, destX + copyRect.width(), destY + copyRect.height()));
 		return;
 	}
 
@@ -401,11 +454,6 @@ void BaseSurface::copyFrom(BaseSurface &src, const Common::Point &destPos, int d
 		return;
 
 	int spriteRight = spriteLeft + spriteWidth;
-	if (flipped) {
-		destX += distXCount - 1;
-		spriteLeft = -(distXCount - spriteRight);
-		spriteRight = (-spriteLeft + spriteWidth);
-	}
 
 	// Check y bounding area
 	int spriteTop = 0;
@@ -424,9 +472,21 @@ void BaseSurface::copyFrom(BaseSurface &src, const Common::Point &destPos, int d
 	if (spriteHeight <= 0)
 		return;
 
-	byte *destPixelsP = this->getBasePtr(destX + spriteLeft, destY + spriteTop);
+	// Get the source column of each displayed pixel. When flipped, the
+	// displayed columns are drawn in reverse
+	int srcColumns[MADS_SCREEN_WIDTH];
+	int srcOffsets[MADS_SCREEN_WIDTH];
+	for (int xp = 0, sprX = 0; xp < frameWidth; ++xp) {
+		if (lineDist[xp])
+			srcColumns[sprX++] = xp;
+	}
+	for (int xp = 0; xp < spriteWidth; ++xp) {
+		int sprX = spriteLeft + xp;
+		srcOffsets[xp] = srcColumns[flipped ? distXCount - 1 - sprX : sprX];
+	}
 
-	spriteLeft = spriteLeft * direction;
+	SpriteLineProc copyLine = getSpriteLineProc<true>(depthSurface);
+	byte *destPixelsP = this->getBasePtr(destX + spriteLeft, destY + spriteTop);
 
 	// Loop through the lines of the sprite
 	for (int yp = 0, sprY = -1; yp < frameHeight; ++yp, srcPixelsP += src.pitch) {
@@ -438,36 +498,14 @@ void BaseSurface::copyFrom(BaseSurface &src, const Common::Point &destPos, int d
 		if ((sprY >= spriteBottom) || (sprY < spriteTop))
 			continue;
 
-		// Found a line to display. Loop through the pixels
-		const byte *srcP = srcPixelsP;
-		byte *destP = destPixelsP;
-
-		for (int xp = 0, sprX = -1; xp < frameWidth; ++xp, ++srcP) {
-			if (!lineDist[xp])
-				// Not a display pixel
-				continue;
-
-			++sprX;
-			if (sprX < spriteLeft || sprX >= spriteRight)
-				// Skip pixel if it's not in horizontal display portion
-				continue;
-
-			// Get depth of current output pixel in depth surface
-			Common::Point pt((destP - (byte *)getPixels()) % this->pitch,
-				(destP - (byte *)getPixels()) / this->pitch);
-			int pixelDepth = (depthSurface == nullptr) ? 15 : depthSurface->getDepth(pt);
-
-			if ((*srcP != transparentColor) && (depth <= pixelDepth))
-				*destP = *srcP;
-
-			destP += direction;
-		}
+		copyLine(destPixelsP, srcPixelsP, srcOffsets, direction, spriteWidth, depthSurface,
+			destX + spriteLeft, destY + sprY, depth, transparentColor);
 
 		// Move to the next destination line
 		destPixelsP += this->pitch;
 	}
 
-	addDirtyRect(Common::Rect(destX, destY, destX + frameWidth, destY + frameHeight));
+	addDirtyRect(Common::Rect(destX + spriteLeft, destY + spriteTop, destX + spriteRight, destY + spriteBottom));
 }
 
 /*------------------------------------------------------------------------*/
@@ -575,6 +575,44 @@ void RivenCard::initializeZipMode() {
 	}
 }
 
+void RivenCard::prefetchNeighbourCards() {
+	Common::Array<uint16> cardIds;
+	for (uint16 i = 0; i < _scripts.size(); i++) {
+		_scripts[i].script->collectCardChanges(cardIds);
+	}
+	for (uint16 i = 0; i < _hotspots.size(); i++) {
+		_hotspots[i]->collectCardChanges(cardIds);
+	}
+
+	// The first picture of a card is the one drawn when its scripts
+	// don't pick another, so those are requested before the others
+	Common::Array<uint16> firstImageIds;
+	Common::Array<uint16> otherImageIds;
+	for (uint i = 0; i < cardIds.size(); i++) {
+		if (cardIds[i] == _id || !_vm->hasResource(ID_PLST, cardIds[i]))
+			continue;
+
+		Common::SeekableReadStream *plst = _vm->getResource(ID_PLST, cardIds[i]);
+		uint16 recordCount = plst->readUint16BE();
+
+		for (uint16 j = 0; j < recordCount; j++) {
+			uint16 index = plst->readUint16BE();
+			uint16 id = plst->readUint16BE();
+			plst->skip(8); // rect
+
+			if (index == 1)
+				firstImageIds.push_back(id);
+			else
+				otherImageIds.push_back(id);
+		}
+
+		delete plst;
+	}
+
+	firstImageIds.push_back(otherImageIds);
+	_vm->_gfx->prefetchImages(firstImageIds);
+}
+
 RivenScriptPtr RivenCard::getScript(uint16 scriptType) const {
 	for (uint16 i = 0; i < _scripts.size(); i++)
 		if (_scripts[i].type == scriptType) {
@@ -1232,6 +1270,12 @@ void RivenHotspot::applyScriptPatches(uint32 cardGlobalId) {
 	}
 }
 
+void RivenHotspot::collectCardChanges(Common::Array<uint16> &cardIds) const {
+	for (uint16 i = 0; i < _scripts.size(); i++) {
+		_scripts[i].script->collectCardChanges(cardIds);
+	}
+}
+
 bool RivenHotspot::isEnabled() const {
 	return (_flags & kFlagEnabled) != 0;
 }
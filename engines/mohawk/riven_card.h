@@ -95,6 +95,9 @@ public:
 	/** Enable the zip hotspots if they match to already visited locations */
 	void initializeZipMode();
 
+	/** Start decoding the pictures of the cards the scripts may change to */
+	void prefetchNeighbourCards();
+
 	/** Get the hotspot containing the specified point */
 	RivenHotspot *getHotspotContainingPoint(const Common::Point &point) const;
 
@@ -276,6 +279,9 @@ public:
 	/** Apply patches to the hotspot's properties to fix bugs in the original game scripts */
 	void applyPropertiesPatches(uint32 cardGlobalId);
 
+	/** Add the ids of the cards the hotspot's scripts may change to, if not in the list yet */
+	void collectCardChanges(Common::Array<uint16> &cardIds) const;
+
 private:
 	enum {
 		kFlagZip = 1,
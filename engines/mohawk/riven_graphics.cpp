@@ -28,6 +28,7 @@
 #include "mohawk/riven_stack.h"
 #include "mohawk/riven_video.h"
 
+#include "common/memstream.h"
 #include "common/system.h"
 
 #include "engines/util.h"
@@ -343,6 +344,7 @@ RivenGraphics::RivenGraphics(MohawkEngine_Riven* vm) :
 }
 
 RivenGraphics::~RivenGraphics() {
+	clearPrefetchedImages();
 	_effectScreen->free();
 	delete _effectScreen;
 	_mainScreen->free();
@@ -353,12 +355,131 @@ RivenGraphics::~RivenGraphics() {
 	delete _menuFont;
 }
 
+/**
+ * Decodes an image from memory, with a decoder of its own so it can run
+ * on any thread
+ */
+class RivenGraphics::PrefetchTask : public Common::Task {
+public:
+	PrefetchTask(Common::SeekableReadStream *stream) : _stream(stream), _surface(nullptr) {}
+
+	~PrefetchTask() override {
+		delete _stream;
+		delete _surface;
+	}
+
+	void run() override {
+		MohawkBitmap bitmapDecoder;
+		_surface = bitmapDecoder.decodeImage(_stream); // Frees the stream
+		_stream = nullptr;
+	}
+
+	/** Get the decoded image, which the caller then owns */
+	MohawkSurface *takeSurface() {
+		MohawkSurface *surface = _surface;
+		_surface = nullptr;
+		return surface;
+	}
+
+private:
+	Common::SeekableReadStream *_stream;
+	MohawkSurface *_surface;
+};
+
+// Enough for the pictures of all the neighbours of most cards
+static const uint kPrefetchedImageCount = 32;
+
 MohawkSurface *RivenGraphics::decodeImage(uint16 id) {
-	MohawkSurface *surface = _bitmapDecoder->decodeImage(_vm->getResource(ID_TBMP, id));
+	MohawkSurface *surface = takePrefetchedImage(id);
+	if (!surface)
+		surface = _bitmapDecoder->decodeImage(_vm->getResource(ID_TBMP, id));
+
 	surface->convertToTrueColor();
 	return surface;
 }
 
+void RivenGraphics::prefetchImages(const Common::Array<uint16> &ids) {
+	Common::TaskScheduler *scheduler = _vm->_system->getTaskScheduler();
+
+	// Decoding right away on the main thread would only delay the current card
+	if (scheduler->isSerial())
+		return;
+
+	Common::List<PrefetchedImage> prefetchedImages;
+	for (uint i = 0; i < ids.size() && prefetchedImages.size() < kPrefetchedImageCount; i++) {
+		bool found = false;
+		for (Common::List<PrefetchedImage>::iterator it = prefetchedImages.begin(); it != prefetchedImages.end(); it++) {
+			if (it->id == ids[i]) {
+				found = true;
+				break;
+			}
+		}
+		if (found)
+			continue;
+
+		// Keep the images which are still wanted, decoded or not
+		for (Common::List<PrefetchedImage>::iterator it = _prefetchedImages.begin(); it != _prefetchedImages.end(); it++) {
+			if (it->id == ids[i]) {
+				prefetchedImages.push_back(*it);
+				_prefetchedImages.erase(it);
+				found = true;
+				break;
+			}
+		}
+		if (found || !_vm->hasResource(ID_TBMP, ids[i]))
+			continue;
+
+		// The archive file can only be read from the main thread,
+		// so only the decoding happens on the worker
+		Common::SeekableReadStream *resource = _vm->getResource(ID_TBMP, ids[i]);
+		Common::SeekableReadStream *stream = resource->readStream(resource->size());
+		delete resource;
+
+		PrefetchedImage image;
+		image.id = ids[i];
+		image.task = new PrefetchTask(stream);
+		image.future = scheduler->schedule(image.task, DisposeAfterUse::NO);
+		prefetchedImages.push_back(image);
+	}
+
+	// Fill up with the most recent of the images no longer requested
+	while (!_prefetchedImages.empty() && prefetchedImages.size() < kPrefetchedImageCount) {
+		prefetchedImages.push_back(_prefetchedImages.front());
+		_prefetchedImages.pop_front();
+	}
+
+	clearPrefetchedImages();
+	_prefetchedImages = prefetchedImages;
+}
+
+void RivenGraphics::clearPrefetchedImages() {
+	for (Common::List<PrefetchedImage>::iterator it = _prefetchedImages.begin(); it != _prefetchedImages.end(); it++)
+		freePrefetchedImage(*it);
+
+	_prefetchedImages.clear();
+}
+
+MohawkSurface *RivenGraphics::takePrefetchedImage(uint16 id) {
+	for (Common::List<PrefetchedImage>::iterator it = _prefetchedImages.begin(); it != _prefetchedImages.end(); it++) {
+		if (it->id == id) {
+			it->future.wait();
+			MohawkSurface *surface = it->task->takeSurface();
+			freePrefetchedImage(*it);
+			_prefetchedImages.erase(it);
+			return surface;
+		}
+	}
+
+	return nullptr;
+}
+
+void RivenGraphics::freePrefetchedImage(PrefetchedImage &image) {
+	// The worker may still be using the task
+	image.future.wait();
+	delete image.task;
+	image.task = nullptr;
+}
+
 void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uint32 right, uint32 bottom) {
 	Graphics::Surface *surface = findImage(image)->getSurface();
 
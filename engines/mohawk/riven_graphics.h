@@ -25,6 +25,8 @@
 
 #include "mohawk/graphics.h"
 
+#include "common/list.h"
+#include "common/taskscheduler.h"
 #include "common/ustr.h"
 
 namespace Graphics {
@@ -112,6 +114,17 @@ public:
 	void updateCredits();
 	uint getCurCreditsImage() const { return _creditsImage; }
 
+	/**
+	 * Start decoding images from the current stack on a worker thread
+	 *
+	 * The images are kept until they are drawn, or until too many others
+	 * were prefetched after them. Earlier images have priority.
+	 */
+	void prefetchImages(const Common::Array<uint16> &ids);
+
+	/** Drop all the prefetched images, for when they may no longer be valid */
+	void clearPrefetchedImages();
+
 protected:
 	MohawkSurface *decodeImage(uint16 id) override;
 	MohawkEngine *getVM() override { return (MohawkEngine *)_vm; }
@@ -151,6 +164,21 @@ private:
 
 	// Credits
 	uint _creditsImage, _creditsPos;
+
+	// Prefetched images
+	class PrefetchTask;
+
+	struct PrefetchedImage {
+		uint16 id;
+		PrefetchTask *task;
+		Common::TaskFuture future;
+	};
+
+	/** Prefetched images, most recently requested first */
+	Common::List<PrefetchedImage> _prefetchedImages;
+
+	MohawkSurface *takePrefetchedImage(uint16 id);
+	void freePrefetchedImage(PrefetchedImage &image);
 };
 
 /**
@@ -29,6 +29,7 @@
 #include "mohawk/riven_stack.h"
 #include "mohawk/riven_stacks/aspit.h"
 #include "mohawk/riven_video.h"
+#include "common/algorithm.h"
 #include "common/memstream.h"
 
 #include "common/debug-channels.h"
@@ -385,6 +386,12 @@ void RivenScript::applyCardPatches(MohawkEngine_Riven *vm, uint32 cardGlobalId,
 	}
 }
 
+void RivenScript::collectCardChanges(Common::Array<uint16> &cardIds) const {
+	for (uint i = 0; i < _commands.size(); i++) {
+		_commands[i]->collectCardChanges(cardIds);
+	}
+}
+
 RivenScriptPtr &operator+=(RivenScriptPtr &lhs, const RivenScriptPtr &rhs) {
 	if (rhs) {
 		*lhs += *rhs;
@@ -831,6 +838,13 @@ RivenCommandType RivenSimpleCommand::getType() const {
 	return _type;
 }
 
+void RivenSimpleCommand::collectCardChanges(Common::Array<uint16> &cardIds) const {
+	if (_type == kRivenCommandChangeCard && !_arguments.empty()
+			&& Common::find(cardIds.begin(), cardIds.end(), _arguments[0]) == cardIds.end()) {
+		cardIds.push_back(_arguments[0]);
+	}
+}
+
 RivenSwitchCommand::RivenSwitchCommand(MohawkEngine_Riven *vm) :
 		RivenCommand(vm),
 		_variableId(0) {
@@ -918,6 +932,12 @@ void RivenSwitchCommand::applyCardPatches(uint32 globalId, int scriptType, uint1
 	}
 }
 
+void RivenSwitchCommand::collectCardChanges(Common::Array<uint16> &cardIds) const {
+	for (uint i = 0; i < _branches.size(); i++) {
+		_branches[i].script->collectCardChanges(cardIds);
+	}
+}
+
 RivenStackChangeCommand::RivenStackChangeCommand(MohawkEngine_Riven *vm, uint16 stackId, uint32 globalCardId,
                                                  bool byStackId, bool byStackCardId) :
 		RivenCommand(vm),
@@ -63,9 +63,28 @@ void Screen::update() {
 
 	_microTiles->clear();
 
+	// An item needs no refresh if the other queue has an equal one. Most
+	// items keep their place in the queue from one frame to the next,
+	// so only the ones which don't are searched for in the other queue.
+	const uint renderQueueSize = _renderQueue->size();
+	const uint prevRenderQueueSize = _prevRenderQueue->size();
+
+	for (uint i = 0; i < renderQueueSize; i++) {
+		RenderItem &renderItem = (*_renderQueue)[i];
+		renderItem._refresh = true;
+		if (i < prevRenderQueueSize) {
+			RenderItem &prevRenderItem = (*_prevRenderQueue)[i];
+			prevRenderItem._refresh = !(prevRenderItem == renderItem);
+			renderItem._refresh = prevRenderItem._refresh;
+		}
+	}
+	for (uint i = renderQueueSize; i < prevRenderQueueSize; i++)
+		(*_prevRenderQueue)[i]._refresh = true;
+
 	for (RenderQueue::iterator it = _renderQueue->begin(); it != _renderQueue->end(); ++it) {
 		RenderItem &renderItem = (*it);
-		renderItem._refresh = true;
+		if (!renderItem._refresh)
+			continue;
 		for (RenderQueue::iterator jt = _prevRenderQueue->begin(); jt != _prevRenderQueue->end(); ++jt) {
 			RenderItem &prevRenderItem = (*jt);
 			if (prevRenderItem == renderItem) {
@@ -75,6 +94,18 @@ void Screen::update() {
 		}
 	}
 
+	for (RenderQueue::iterator jt = _prevRenderQueue->begin(); jt != _prevRenderQueue->end(); ++jt) {
+		RenderItem &prevRenderItem = (*jt);
+		if (!prevRenderItem._refresh)
+			continue;
+		for (RenderQueue::iterator it = _renderQueue->begin(); it != _renderQueue->end(); ++it) {
+			if (*it == prevRenderItem) {
+				prevRenderItem._refresh = false;
+				break;
+			}
+		}
+	}
+
 	for (RenderQueue::iterator jt = _prevRenderQueue->begin(); jt != _prevRenderQueue->end(); ++jt) {
 		RenderItem &prevRenderItem = (*jt);
 		if (prevRenderItem._refresh)
@@ -409,7 +440,23 @@ void Screen::blitRenderItem(const RenderItem &renderItem, const Common::Rect &cl
 		}
 	} else {
 		while (height--) {
-			for (int xc = 0; xc < width; xc++)
+			int xc = 0;
+			// Four pixels at a time, as sprites are mostly either fully
+			// transparent or fully opaque over such a group
+			for (; xc + 4 <= width; xc += 4) {
+				const uint32 pixels = READ_UINT32(source + xc);
+				if (pixels == 0)
+					continue;
+				if (((pixels - 0x01010101) & ~pixels & 0x80808080) == 0) {
+					// No transparent pixel in the group
+					WRITE_UINT32(dest + xc, pixels);
+					continue;
+				}
+				for (int i = xc; i < xc + 4; i++)
+					if (source[i] != 0)
+						dest[i] = source[i];
+			}
+			for (; xc < width; xc++)
 				if (source[xc] != 0)
 					dest[xc] = source[xc];
 			source += surface->pitch;
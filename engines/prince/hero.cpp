@@ -203,25 +203,38 @@ void Hero::countDrawPosition() {
 	}
 }
 
-void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
-	PrinceEngine *vm = (PrinceEngine *)drawNode->data;
-	int16 heroSurfaceWidth = drawNode->s->w;
-	int16 heroSurfaceHeight = drawNode->s->h;
-
-	Graphics::Surface *makeShadow = new Graphics::Surface();
-	makeShadow->create(heroSurfaceWidth, heroSurfaceHeight, Graphics::PixelFormat::createFormatCLUT8());
-
-	for (int y = 0; y < heroSurfaceHeight; y++) {
-		byte *src = (byte *)drawNode->s->getBasePtr(0, y);
-		byte *dst = (byte *)makeShadow->getBasePtr(0, y);
-		for (int x = 0; x < heroSurfaceWidth; x++, dst++, src++) {
-			if (*src != 0xFF) {
-				*dst = GraphicsMan::kShadowColor;
-			} else {
-				*dst = *src;
-			}
+// Move the shadow bitmap position count pixels to the right
+static void advanceShadowBit(int &bitMask, int &bitAddr, int count) {
+	bitAddr += count / 8;
+	for (int i = count % 8; i > 0; i--) {
+		if (bitMask == 1) {
+			bitMask = 128;
+			bitAddr++;
+		} else {
+			bitMask >>= 1;
 		}
 	}
+}
+
+// Return the number of transparent pixels starting at row[x], up to max
+static int transparentSpan(const byte *row, int x, int max) {
+	int span = 0;
+	while (span < max && row[x + span] == 0xFF)
+		span++;
+	return span;
+}
+
+void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
+	PrinceEngine *vm = (PrinceEngine *)drawNode->data;
+	const Graphics::Surface *heroSurface = drawNode->s;
+	int16 heroSurfaceWidth = heroSurface->w;
+	int16 heroSurfaceHeight = heroSurface->h;
+
+	// Every pixel of the sprite which is not transparent casts a shadow.
+	// The sprite is read directly instead of being turned into a shadow
+	// sprite first, and at full size whole transparent spans are skipped
+	// at once, as is the sprite's zoom then.
+	const bool fullSize = (drawNode->scaleValue == 10000);
 
 	if (drawNode->posY > 1 && drawNode->posY < PrinceEngine::kMaxPicHeight) {
 		int shadDirection;
@@ -255,8 +268,7 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 
 		int shadLastY = 0;
 
-		byte *shadowHero = (byte *)makeShadow->getBasePtr(shadowHeroX, shadowHeroY); // first pixel from last row of shadow hero
-		byte *background = (byte *)screen->getBasePtr(shadDrawX, shadDrawY); // pixel of background where shadow sprite starts
+		byte *background;
 
 		// banked2
 		byte *shadowLineStart = vm->_shadowLine + 8;
@@ -349,8 +361,8 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 					int backgroundDiff = shadSkipX;
 					int shadBitMaskCopyTrans = shadBitMask;
 					int shadBitAddrCopyTrans = shadBitAddr;
-					shadowHero = (byte *)makeShadow->getBasePtr(shadowHeroX, shadowHeroY);
-					background = (byte *)screen->getBasePtr(shadDrawX + diffX + backgroundDiff, shadDrawY + diffY);
+					const byte *heroRow = (const byte *)heroSurface->getBasePtr(0, shadowHeroY);
+					byte *backgroundRow = (byte *)screen->getBasePtr(shadDrawX + diffX, shadDrawY + diffY);
 
 					if (shadPosX < 0) {
 						if (heroSurfaceWidth > shadSkipX) {
@@ -371,11 +383,22 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 
 					//ct_loop:
 					for (int l = 0; l < ctLoop; l++) {
+						if (fullSize) {
+							const int span = transparentSpan(heroRow, shadowHeroX, ctLoop - l);
+							if (span) {
+								advanceShadowBit(shadBitMaskCopyTrans, shadBitAddrCopyTrans, span);
+								backgroundDiff += span;
+								shadowHeroX += span;
+								l += span - 1;
+								continue;
+							}
+						}
 						shadZoomX -= 100;
-						if (shadZoomX < 0 && drawNode->scaleValue != 10000) {
+						if (shadZoomX < 0 && !fullSize) {
 							shadZoomX += drawNode->scaleValue;
 						} else {
-							if (*shadowHero == GraphicsMan::kShadowColor) {
+							if (heroRow[shadowHeroX] != 0xFF) {
+								background = backgroundRow + backgroundDiff;
 								if ((shadBitMaskCopyTrans & vm->_shadowBitmap[shadBitAddrCopyTrans])) {
 									if (shadWallDown == 0) {
 										if ((shadBitMaskCopyTrans & vm->_shadowBitmap[shadBitAddrCopyTrans + PrinceEngine::kShadowBitmapSize])) {
@@ -398,10 +421,8 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 							}
 							//okok
 							backgroundDiff++;
-							background = (byte *)screen->getBasePtr(shadDrawX + diffX + backgroundDiff, shadDrawY + diffY);
 						}
 						shadowHeroX++;
-						shadowHero = (byte *)makeShadow->getBasePtr(shadowHeroX, shadowHeroY);
 					}
 					//byebyebye
 					if (!shadWallDown && shadWDFlag) {
@@ -417,8 +438,7 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 					if (shadDirection && shadWallDown) {
 						int shadBitMaskWallCopyTrans = shadWallBitMask;
 						int shadBitAddrWallCopyTrans = shadWallBitAddr;
-						background = shadWallDestAddr;
-						shadowHero = (byte *)makeShadow->getBasePtr(shadWallSkipX, shadowHeroY);
+						const byte *heroWallRow = (const byte *)heroSurface->getBasePtr(shadWallSkipX, shadowHeroY);
 
 						if (ctLoop > shadWallSkipX && ctLoop - shadWallSkipX > shadWallModulo) {
 							//WALL_copy_trans
@@ -428,13 +448,24 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 							int shadowHeroXWall = 0;
 							//ct_loop:
 							for (int m = 0; m < ctLoop; m++) {
+								if (fullSize) {
+									const int span = transparentSpan(heroWallRow, shadowHeroXWall, ctLoop - m);
+									if (span) {
+										advanceShadowBit(shadBitMaskWallCopyTrans, shadBitAddrWallCopyTrans, span);
+										backgroundDiffWall += span;
+										shadowHeroXWall += span;
+										m += span - 1;
+										continue;
+									}
+								}
 								shadZoomXWall -= 100;
-								if (shadZoomXWall < 0 && drawNode->scaleValue != 10000) {
+								if (shadZoomXWall < 0 && !fullSize) {
 									shadZoomXWall += drawNode->scaleValue;
 								} else {
 									//point_ok:
-									if (*shadowHero == GraphicsMan::kShadowColor) {
+									if (heroWallRow[shadowHeroXWall] != 0xFF) {
 										if ((shadBitMaskWallCopyTrans & vm->_shadowBitmap[shadBitAddrWallCopyTrans + PrinceEngine::kShadowBitmapSize])) {
+											background = shadWallDestAddr + backgroundDiffWall;
 											*background = *(sprShadow + *background);
 										}
 									}
@@ -447,10 +478,8 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 									}
 									//okok
 									backgroundDiffWall++;
-									background = shadWallDestAddr + backgroundDiffWall;
 								}
 								shadowHeroXWall++;
-								shadowHero = (byte *)makeShadow->getBasePtr(shadWallSkipX + shadowHeroXWall, shadowHeroY);
 							}
 						}
 						//krap2
@@ -502,13 +531,9 @@ void Hero::showHeroShadow(Graphics::Surface *screen, DrawNode *drawNode) {
 				break;
 			}
 			shadowHeroX = 0;
-			background = (byte *)screen->getBasePtr(shadDrawX + diffX, shadDrawY + diffY);
-			shadowHero = (byte *)makeShadow->getBasePtr(shadowHeroX, shadowHeroY);
 		}
 		//koniec_bajki - end_of_a_story
 	}
-	makeShadow->free();
-	delete makeShadow;
 }
 
 void Hero::setScale(int8 zoomBitmapValue) {
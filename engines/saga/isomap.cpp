@@ -97,6 +97,7 @@ IsoMap::IsoMap(SagaEngine *vm) : _vm(vm) {
 	_viewScroll.x = (128 - 8) * 16;
 	_viewScroll.y = (128 - 8) * 16 - 64;
 	_viewDiff = 1;
+	_tileCacheValid = false;
 	_platformHeight = 0;
 	_queueCount = _readCount = 0;
 
@@ -117,6 +118,7 @@ IsoMap::IsoMap(SagaEngine *vm) : _vm(vm) {
 }
 
 void IsoMap::loadImages(const ByteArray &resourceData) {
+	invalidateTileCache();
 	IsoTileData *tileData;
 	uint16 i;
 	size_t offsetDiff;
@@ -157,6 +159,7 @@ void IsoMap::loadImages(const ByteArray &resourceData) {
 }
 
 void IsoMap::loadPlatforms(const ByteArray &resourceData) {
+	invalidateTileCache();
 	TilePlatformData *tilePlatformData;
 	uint16 i, x, y;
 
@@ -186,6 +189,7 @@ void IsoMap::loadPlatforms(const ByteArray &resourceData) {
 }
 
 void IsoMap::loadMap(const ByteArray &resourceData) {
+	invalidateTileCache();
 	uint16 x, y;
 
 	if (resourceData.size() != SAGA_TILEMAP_LEN) {
@@ -205,6 +209,7 @@ void IsoMap::loadMap(const ByteArray &resourceData) {
 }
 
 void IsoMap::loadMetaTiles(const ByteArray &resourceData) {
+	invalidateTileCache();
 	MetaTileData *metaTileData;
 	uint16 i, j;
 
@@ -227,6 +232,7 @@ void IsoMap::loadMetaTiles(const ByteArray &resourceData) {
 }
 
 void IsoMap::loadMulti(const ByteArray &resourceData) {
+	invalidateTileCache();
 	MultiTileEntryData *multiTileEntryData;
 	uint16 i;
 	int16 offsetDiff;
@@ -268,6 +274,7 @@ void IsoMap::loadMulti(const ByteArray &resourceData) {
 }
 
 void IsoMap::clear() {
+	invalidateTileCache();
 	_tilesTable.clear();
 	_tilePlatformList.clear();
 	_metaTileList.clear();
@@ -367,11 +374,73 @@ int16 IsoMap::findMulti(int16 tileIndex, int16 absU, int16 absV, int16 absH) {
 }
 
 void IsoMap::draw() {
-	_tileClip = _vm->_scene->getSceneClip();
+	const Rect sceneClip = _vm->_scene->getSceneClip();
+	const uint16 pitch = _vm->_gfx->getBackBufferPitch();
+	byte *pixels = _vm->_gfx->getBackBufferPixels() + sceneClip.top * pitch + sceneClip.left;
+
+	// The tiles only change with the scroll position, the map and the door
+	// states. The last picture is kept, and after scrolling only the newly
+	// exposed strips are drawn. Actors are drawn on top of it afterwards by
+	// drawSprite(), which redraws just the tiles in front of them.
+	if (!_tileCacheValid || _tileCacheClip != sceneClip) {
+		drawTileArea(sceneClip);
+	} else {
+		if (_tileCacheScroll == _viewScroll) {
+			for (int y = 0; y < sceneClip.height(); y++)
+				memcpy(pixels + y * pitch, &_tileCache[y * sceneClip.width()], sceneClip.width());
+		} else {
+			scrollTileCache(_viewScroll - _tileCacheScroll);
+		}
+		_vm->_render->addDirtyRect(sceneClip);
+	}
+
+	_tileClip = sceneClip;
+
+	_tileCache.resize(sceneClip.width() * sceneClip.height());
+	for (int y = 0; y < sceneClip.height(); y++)
+		memcpy(&_tileCache[y * sceneClip.width()], pixels + y * pitch, sceneClip.width());
+	_tileCacheScroll = _viewScroll;
+	_tileCacheClip = sceneClip;
+	_tileCacheValid = true;
+}
+
+void IsoMap::drawTileArea(const Rect &rect) {
+	_tileClip = rect;
 	_vm->_gfx->drawRect(_tileClip, 0);
 	drawTiles(NULL);
 }
 
+void IsoMap::scrollTileCache(const Point &delta) {
+	const Rect &clip = _tileCacheClip;
+
+	// The part of the old picture which is still on screen
+	Rect kept(clip);
+	kept.translate(-delta.x, -delta.y);
+	kept.clip(clip);
+
+	if (kept.isEmpty()) {
+		drawTileArea(clip);
+		return;
+	}
+
+	const uint16 pitch = _vm->_gfx->getBackBufferPitch();
+	byte *pixels = _vm->_gfx->getBackBufferPixels();
+	for (int y = kept.top; y < kept.bottom; y++) {
+		const byte *src = &_tileCache[(y + delta.y - clip.top) * clip.width() + (kept.left + delta.x - clip.left)];
+		memcpy(pixels + y * pitch + kept.left, src, kept.width());
+	}
+
+	// Draw the strips which came into view
+	if (kept.top > clip.top)
+		drawTileArea(Rect(clip.left, clip.top, clip.right, kept.top));
+	if (kept.bottom < clip.bottom)
+		drawTileArea(Rect(clip.left, kept.bottom, clip.right, clip.bottom));
+	if (kept.left > clip.left)
+		drawTileArea(Rect(clip.left, kept.top, kept.left, kept.bottom));
+	if (kept.right < clip.right)
+		drawTileArea(Rect(kept.right, kept.top, clip.right, kept.bottom));
+}
+
 void IsoMap::setMapPosition(int x, int y) {
 	_mapPosition.x = x;
 	_mapPosition.y = y;
@@ -1609,6 +1678,8 @@ void IsoMap::setTileDoorState(int doorNumber, int doorState) {
 	}
 
 	multiTileEntryData = &_multiTable[doorNumber];
+	if (multiTileEntryData->currentState != doorState)
+		invalidateTileCache();
 	multiTileEntryData->currentState = doorState;
 }
 
@@ -178,6 +178,9 @@ public:
 
 private:
 	void drawTiles(const Location *location);
+	void drawTileArea(const Rect &rect);
+	void scrollTileCache(const Point &delta);
+	void invalidateTileCache() { _tileCacheValid = false; }
 	void drawMetaTile(uint16 metaTileIndex, const Point &point, int16 absU, int16 absV);
 	void drawSpriteMetaTile(uint16 metaTileIndex, const Point &point, Location &location, int16 absU, int16 absV);
 	void drawPlatform(uint16 platformIndex, const Point &point, int16 absU, int16 absV, int16 absH);
@@ -279,6 +282,13 @@ private:
 	Point _viewScroll;
 	Rect _tileClip;
 
+	// The scene clip as draw() left it, for the scroll position and the
+	// clip rect it was drawn with
+	ByteArray _tileCache;
+	Point _tileCacheScroll;
+	Rect _tileCacheClip;
+	bool _tileCacheValid;
+
 	SagaEngine *_vm;
 };
 
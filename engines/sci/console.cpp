@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -148,6 +149,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
 	registerCmd("visible_plane_items", WRAP_METHOD(Console, cmdVisiblePlaneItemList));
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
 	// Segments
@@ -365,6 +367,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_list / vpl - Shows a list of all the planes in the visible draw list (SCI2+)\n");
 	debugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
+	debugPrintf(" cel_cache - Shows the size and hit rates of the cel caches (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
 	debugPrintf("\n");
@@ -2134,6 +2137,19 @@ bool Console::cmdVisiblePlaneItemList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		CelObj::printCacheStats(this);
+	} else {
+		debugPrintf("This SCI version does not have cel caches\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdSavedBits(int argc, const char **argv) {
 	SegManager *segman = _engine->_gamestate->_segMan;
 	SegmentId id = segman->findSegmentByType(SEG_TYPE_HUNK);
@@ -98,6 +98,7 @@ private:
 	bool cmdVisiblePlaneList(int argc, const char **argv);
 	bool cmdPlaneItemList(int argc, const char **argv);
 	bool cmdVisiblePlaneItemList(int argc, const char **argv);
+	bool cmdCelCache(int argc, const char **argv);
 	bool cmdSavedBits(int argc, const char **argv);
 	bool cmdShowSavedBits(int argc, const char **argv);
 	// Segments
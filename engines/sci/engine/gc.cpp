@@ -56,10 +56,11 @@ void WorklistManager::push(reg_t reg) {
 
 	debugC(kDebugLevelGC, "[GC] Adding %04x:%04x", PRINT_REG(reg));
 
-	if (_map.contains(reg))
+	bool &known = _map[reg];
+	if (known)
 		return; // already dealt with it
 
-	_map.setVal(reg, true);
+	known = true;
 	_worklist.push_back(reg);
 }
 
@@ -191,6 +192,8 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
+	segMan->resetAllocatedSinceGC();
+
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
 
@@ -24,7 +24,7 @@
 #ifndef SCI_ENGINE_GC_H
 #define SCI_ENGINE_GC_H
 
-#include "common/hashmap.h"
+#include "common/flathashmap.h"
 #include "sci/engine/vm_types.h"
 #include "sci/engine/state.h"
 
@@ -38,9 +38,11 @@ struct reg_t_Hash {
 
 /*
  * The AddrSet is a "set" of reg_t values.
- * We don't have a HashSet type, so we abuse a HashMap for this.
+ * We don't have a HashSet type, so we abuse a hash map for this. A garbage
+ * collection fills it with every reachable reference, so the flat variant
+ * saves a node allocation per entry.
  */
-typedef Common::HashMap<reg_t, bool, reg_t_Hash> AddrSet;
+typedef Common::FlatHashMap<reg_t, bool, reg_t_Hash> AddrSet;
 
 /**
  * Finds all used references and normalises them to their memory addresses
@@ -57,7 +59,7 @@ void run_gc(EngineState *s);
 
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
-	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
+	AddrSet _map;	// used for lookups inside push() and run_gc()
 
 	void push(reg_t reg);
 	void pushArray(const Common::Array<reg_t> &tmp);
@@ -34,6 +34,7 @@
 #include "sci/graphics/frameout.h"
 #endif
 
+#include "common/array.h"
 #include "common/debug-channels.h"
 #include "common/list.h"
 #include "common/system.h"
@@ -117,10 +118,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in the vertex index of the pathfinding state
+	int index;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		index = -1;
 	}
 };
 
@@ -242,6 +247,38 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * The vertices visible from each other among the vertices of a polygon set.
+ * Actors in the same room path through the same polygons, often every few
+ * frames, so the graphs of the last polygon sets are kept across kAvoidPath
+ * calls.
+ */
+struct VisibilityGraph {
+	// The type, size and points of every polygon of the set, in order
+	Common::Array<int16> polygons;
+
+	// Hash of the polygons, to find the graph without comparing them all
+	uint32 hash;
+
+	// When the graph was last used, to replace the least recently used one
+	uint32 lastUse;
+
+	// Whether the vertices visible from each vertex have been found yet
+	Common::Array<bool> known;
+
+	// The indexes of the vertices visible from each vertex, in order
+	Common::Array<Common::Array<uint16> > visible;
+
+	VisibilityGraph() : hash(0), lastUse(0) {}
+};
+
+enum {
+	kMaxVisibilityGraphs = 4
+};
+
+static VisibilityGraph visibilityGraphs[kMaxVisibilityGraphs];
+static uint32 visibilityGraphUses = 0;
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -263,6 +300,14 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Visibility between the vertices of the polygon set, or NULL if merging
+	// the start and end points changed the edges of its polygons
+	VisibilityGraph *_graph;
+
+	// Number of vertices at the start of the vertex index which are not part
+	// of the polygon set of the visibility graph
+	int _graphOffset;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -270,6 +315,8 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_graph = NULL;
+		_graphOffset = 0;
 	}
 
 	~PathfindingState() {
@@ -699,6 +746,39 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether a vertex is visible from another vertex.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if no polygon is in the way, false otherwise
+ */
+static bool vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -708,37 +788,89 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
 
-	for (int i = 0; i < s->vertices; i++) {
+	// The list is in reverse order of the vertex index, which is the order
+	// in which the shortest path search breaks ties
+	if (!s->_graph || vertex_cur->index < s->_graphOffset) {
+		for (int i = 0; i < s->vertices; i++) {
+			Vertex *vertex = s->vertex_index[i];
+			if (vertex_visible(s, vertex_cur, vertex))
+				visVerts->push_front(vertex);
+		}
+
+		return visVerts;
+	}
+
+	// The start and end points do not have edges, so they do not change
+	// which vertices of the polygon set are visible from each other
+	for (int i = 0; i < s->_graphOffset; i++) {
 		Vertex *vertex = s->vertex_index[i];
+		if (vertex_visible(s, vertex_cur, vertex))
+			visVerts->push_front(vertex);
+	}
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
+	VisibilityGraph &graph = *s->_graph;
+	const int cur = vertex_cur->index - s->_graphOffset;
+	if (!graph.known[cur]) {
+		for (int i = s->_graphOffset; i < s->vertices; i++) {
+			if (vertex_visible(s, vertex_cur, s->vertex_index[i]))
+				graph.visible[cur].push_back(i - s->_graphOffset);
+		}
+		graph.known[cur] = true;
+	}
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+	const Common::Array<uint16> &visibleIndexes = graph.visible[cur];
+	for (uint i = 0; i < visibleIndexes.size(); i++)
+		visVerts->push_front(s->vertex_index[s->_graphOffset + visibleIndexes[i]]);
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+	return visVerts;
+}
+
+/**
+ * Finds the visibility graph of the polygons of a pathfinding state, or
+ * replaces the least recently used graph with an empty one for them.
+ * @param s			the pathfinding state
+ * @param vertices	the number of vertices of the polygons
+ * @return the visibility graph
+ */
+static VisibilityGraph *find_visibility_graph(PathfindingState *s, int vertices) {
+	Common::Array<int16> polygons;
+	polygons.reserve(s->polygons.size() * 2 + vertices * 2);
+
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Vertex *vertex;
+
+		polygons.push_back((*it)->type);
+		polygons.push_back((*it)->vertices.size());
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			polygons.push_back(vertex->v.x);
+			polygons.push_back(vertex->v.y);
 		}
+	}
 
-		if (j == s->vertices)
-			visVerts->push_front(vertex);
+	uint32 hash = 2166136261u;
+	for (uint i = 0; i < polygons.size(); i++)
+		hash = (hash ^ (uint16)polygons[i]) * 16777619u;
+
+	VisibilityGraph *oldest = &visibilityGraphs[0];
+	for (int i = 0; i < kMaxVisibilityGraphs; i++) {
+		VisibilityGraph &graph = visibilityGraphs[i];
+		if (graph.hash == hash && graph.polygons == polygons) {
+			graph.lastUse = ++visibilityGraphUses;
+			return &graph;
+		}
+
+		if (graph.lastUse < oldest->lastUse)
+			oldest = &graph;
 	}
 
-	return visVerts;
+	oldest->polygons = polygons;
+	oldest->hash = hash;
+	oldest->lastUse = ++visibilityGraphUses;
+	oldest->known.clear();
+	oldest->known.resize(vertices);
+	oldest->visible.clear();
+	oldest->visible.resize(vertices);
+	return oldest;
 }
 
 /**
@@ -1322,6 +1454,12 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	int graphVertices = 0;
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it)
+		graphVertices += (*it)->vertices.size();
+	const uint graphPolygons = pf_s->polygons.size();
+	VisibilityGraph *graph = find_visibility_graph(pf_s, graphVertices);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1339,12 +1477,22 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	// Points which are not on a vertex are added as single-vertex polygons
+	// in front of the others, unless they split an edge of a polygon, which
+	// changes the visibility between its vertices
+	const int addedPolygons = pf_s->polygons.size() - graphPolygons;
+	if (count - addedPolygons == graphVertices) {
+		pf_s->_graph = graph;
+		pf_s->_graphOffset = addedPolygons;
+	}
+
 	return pf_s;
 }
 
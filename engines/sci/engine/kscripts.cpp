@@ -262,6 +262,11 @@ reg_t kScriptID(EngineState *s, int argc, reg_t *argv) {
 	if (argv[0].getSegment())
 		return argv[0];
 
+	// Games load the script of a room once they switched over to it, and
+	// before the room loads its views and pics
+	if (script && script == s->currentRoomNumber() && !s->_segMan->getScriptIfLoaded(s->_segMan->getScriptSegment(script)))
+		g_sci->getResMan()->enterRoom(script);
+
 	SegmentId scriptSeg = s->_segMan->getScriptSegment(script, SCRIPT_GET_LOAD);
 
 	if (!scriptSeg)
@@ -28,6 +28,7 @@
 #include "sci/engine/state.h"
 #include "sci/engine/kernel.h"
 #include "sci/engine/script.h"
+#include "sci/engine/vm.h"
 
 #include "common/util.h"
 
@@ -73,6 +74,8 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_instructions.clear();
 }
 
 enum {
@@ -1271,6 +1274,31 @@ Common::Array<reg_t> Script::listObjectReferences() const {
 	return tmp;
 }
 
+const PMachineInstruction &Script::getInstruction(uint32 offset) {
+	// Filled lazily, as most of the code of a script hardly ever runs. The
+	// heap holds no code, so it is left out in SCI1.1 and newer.
+	if (_instructions.empty())
+		_instructions.resize(_script.size() + 1);
+
+	// Scripts can write to their own buffer through kMemory, string kernel
+	// calls and the like, which all get raw pointers from dereference().
+	// Rather than tracking every writer, the bytes are compared on each use.
+	// op_file carries a file name of any length, so it is never cached.
+	const byte *src = getBuf(offset);
+	PMachineInstruction &instruction = _instructions[MIN<uint32>(offset, _script.size())];
+	if (!instruction.size || instruction.size > kMaxPMachineInstructionSize ||
+		offset >= _script.size() || memcmp(instruction.bytes, src, instruction.size)) {
+		int16 opparams[4];
+		instruction.size = readPMachineInstruction(src, instruction.extOpcode, opparams);
+		for (uint i = 0; i < ARRAYSIZE(instruction.opparams); ++i)
+			instruction.opparams[i] = opparams[i];
+		if (instruction.size <= kMaxPMachineInstructionSize)
+			memcpy(instruction.bytes, src, instruction.size);
+	}
+
+	return instruction;
+}
+
 bool Script::offsetIsObject(uint32 offset) const {
 	return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
 }
@@ -69,6 +69,18 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+enum {
+	kMaxPMachineInstructionSize = 7 /**< An opcode and three word operands, op_file aside */
+};
+
+/** An instruction as decoded by readPMachineInstruction() */
+struct PMachineInstruction {
+	byte extOpcode;
+	uint16 size; /**< Length of the instruction in bytes, or 0 if not decoded yet */
+	int16 opparams[3];
+	byte bytes[kMaxPMachineInstructionSize]; /**< The bytes the instruction was decoded from */
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -97,6 +109,8 @@ private:
 protected:
 	offsetLookupArrayType _offsetLookupArray; // Table of all elements of currently loaded script, that may get pointed to
 
+	Common::Array<PMachineInstruction> _instructions; /**< Instructions decoded so far, by offset */
+
 private:
 	uint16 _offsetLookupObjectCount;
 	uint16 _offsetLookupStringCount;
@@ -128,6 +142,13 @@ public:
 	const ObjMap &getObjectMap() const { return _objects; }
 	bool offsetIsObject(uint32 offset) const;
 
+	/**
+	 * Returns the instruction at the given offset, decoding it the first time
+	 * it is asked for, and again whenever its bytes in the script buffer were
+	 * written to since.
+	 */
+	const PMachineInstruction &getInstruction(uint32 offset);
+
 public:
 	Script();
 	~Script();
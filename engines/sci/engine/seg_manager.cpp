@@ -43,6 +43,8 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
+	_allocatedSinceGC = true;
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_bitmapSegId = 0;
@@ -125,6 +127,7 @@ SegmentObj *SegManager::allocSegment(SegmentObj *mem, SegmentId *segid) {
 		_heap.push_back(0);
 	}
 	_heap[id] = mem;
+	_allocatedSinceGC = true;
 
 	return mem;
 }
@@ -403,6 +406,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	table = (HunkTable *)_heap[_hunksSegId];
 
 	offset = table->allocEntry();
+	_allocatedSinceGC = true;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk *h = &table->at(offset);
@@ -438,6 +442,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	_allocatedSinceGC = true;
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -452,6 +457,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	table = (ListTable *)_heap[_listsSegId];
 
 	offset = table->allocEntry();
+	_allocatedSinceGC = true;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -466,6 +472,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	table = (NodeTable *)_heap[_nodesSegId];
 
 	offset = table->allocEntry();
+	_allocatedSinceGC = true;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -893,6 +900,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 		table = (ArrayTable *)_heap[_arraysSegId];
 
 	offset = table->allocEntry();
+	_allocatedSinceGC = true;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -949,6 +957,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	offset = table->allocEntry();
+	_allocatedSinceGC = true;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1080,6 +1089,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_allocatedSinceGC = true;
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -458,6 +458,15 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Whether anything was allocated, or a script marked as deleted, since
+	 * the garbage collector last ran. If not, a periodic collection can be
+	 * skipped: what became garbage since then was live during the last
+	 * run, and is freed once the next run happens.
+	 */
+	bool hasAllocatedSinceGC() const { return _allocatedSinceGC; }
+	void resetAllocatedSinceGC() { _allocatedSinceGC = false; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -476,6 +485,8 @@ private:
 	reg_t _saveDirPtr;
 	reg_t _parserPtr;
 
+	bool _allocatedSinceGC;
+
 #ifdef ENABLE_SCI32
 	SegmentId _arraysSegId;
 	SegmentId _bitmapSegId;
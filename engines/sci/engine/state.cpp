@@ -74,6 +74,7 @@ EngineState::EngineState(SegManager *segMan)
 }
 
 EngineState::~EngineState() {
+	g_system->setMemoryRegion(OSystem::kMemoryRegionGameVariables, nullptr, 0);
 	delete _msgState;
 }
 
@@ -165,6 +166,9 @@ void EngineState::initGlobals() {
 	variablesSegment[VAR_GLOBAL] = script_000->getLocalsSegment();
 	variablesBase[VAR_GLOBAL] = variables[VAR_GLOBAL] = script_000->getLocalsBegin();
 	variablesMax[VAR_GLOBAL] = script_000->getLocalsCount();
+
+	// Script 0 is reloaded when restoring, so this is set again each time
+	g_system->setMemoryRegion(OSystem::kMemoryRegionGameVariables, variables[VAR_GLOBAL], variablesMax[VAR_GLOBAL] * sizeof(reg_t));
 }
 
 uint16 EngineState::currentRoomNumber() const {
@@ -69,8 +69,9 @@ static reg_t &validate_property(EngineState *s, Object *obj, int index) {
 	if (index < 0 || (uint)index >= obj->getVarCount()) {
 		// This is same way sierra does it and there are some games, that contain such scripts like
 		//  iceman script 998 (fred::canBeHere, executed right at the start)
-		debugC(kDebugLevelVM, "[VM] Invalid property #%d (out of [0..%d]) requested from object %04x:%04x (%s)",
-			index, obj->getVarCount(), PRINT_REG(obj->getPos()), s->_segMan->getObjectName(obj->getPos()));
+		if (debugCEnabled(kDebugLevelVM))
+			debugC(kDebugLevelVM, "[VM] Invalid property #%d (out of [0..%d]) requested from object %04x:%04x (%s)",
+				index, obj->getVarCount(), PRINT_REG(obj->getPos()), s->_segMan->getObjectName(obj->getPos()));
 		return dummyReg;
 	}
 
@@ -655,9 +656,14 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		// Get opcode. The instruction is copied, as the script may be freed
+		// while it runs.
+		const PMachineInstruction &instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+		const byte extOpcode = instruction.extOpcode;
+		opparams[0] = instruction.opparams[0];
+		opparams[1] = instruction.opparams[1];
+		opparams[2] = instruction.opparams[2];
+		s->xs->addr.pc.incOffset(instruction.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -883,7 +889,8 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				if (s->_segMan->hasAllocatedSinceGC())
+					run_gc(s);
 			}
 
 			// Call kernel function
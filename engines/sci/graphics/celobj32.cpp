@@ -20,6 +20,7 @@
  *
  */
 
+#include "sci/console.h"
 #include "sci/resource.h"
 #include "sci/engine/features.h"
 #include "sci/engine/seg_manager.h"
@@ -34,6 +35,7 @@
 #include "graphics/larryScale.h"
 #include "common/config-manager.h"
 #include "common/gui_options.h"
+#include "common/system.h"
 
 namespace Sci {
 #pragma mark CelScaler
@@ -92,11 +94,23 @@ void CelObj::init() {
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
 	_cache.reset(new CelCache(100));
+	_larryScaleCache.reset(new LarryScaleCache(16));
+
+	// Devices with plenty of memory get to keep the pixels of more cels, so
+	// that hi-res games do not decompress the same cels over and over again
+	uint32 decodedCelCacheSize = 8 * 1024 * 1024;
+	const uint64 physicalMemory = g_system->getPhysicalMemorySize();
+	if (physicalMemory) {
+		decodedCelCacheSize = MAX<uint64>(decodedCelCacheSize, MIN<uint64>(physicalMemory / 128, 32 * 1024 * 1024));
+	}
+	_decodedCelCache.reset(new DecodedCelCache(decodedCelCacheSize));
 }
 
 void CelObj::deinit() {
 	_scaler.reset();
 	_cache.reset();
+	_larryScaleCache.reset();
+	_decodedCelCache.reset();
 }
 
 #pragma mark -
@@ -233,14 +247,18 @@ struct SCALER_Scale {
 				scaledPosition.y,
 				scaledPosition.x + (celObj._width * scaleX).toInt(),
 				scaledPosition.y + (celObj._height * scaleY).toInt());
-			_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
-			_sourceBuffer->create(
-				scaledImageRect.width(), scaledImageRect.height(),
-				Graphics::PixelFormat::createFormatCLUT8());
-			Copier copier(_reader, *_sourceBuffer);
-			Graphics::larryScale(
-				celObj._width, celObj._height, celObj._skipColor, copier,
-				scaledImageRect.width(), scaledImageRect.height(), copier);
+			_sourceBuffer = celObj.searchLarryScaleCache(scaledImageRect.width(), scaledImageRect.height());
+			if (!_sourceBuffer) {
+				_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+				_sourceBuffer->create(
+					scaledImageRect.width(), scaledImageRect.height(),
+					Graphics::PixelFormat::createFormatCLUT8());
+				Copier copier(_reader, *_sourceBuffer);
+				Graphics::larryScale(
+					celObj._width, celObj._height, celObj._skipColor, copier,
+					scaledImageRect.width(), scaledImageRect.height(), copier);
+				celObj.putInLarryScaleCache(scaledImageRect.width(), scaledImageRect.height(), _sourceBuffer);
+			}
 
 			// Set _valuesX and _valuesY to reference the scaled image without additional scaling
 			for (int16 x = targetRect.left; x < targetRect.right; ++x) {
@@ -355,14 +373,77 @@ private:
 	uint32 _dataOffset;
 	uint32 _uncompressedDataOffset;
 	int16 _y;
+	const int16 _sourceWidth;
 	const int16 _sourceHeight;
 	const uint8 _skipColor;
 	const int16 _maxWidth;
 
+	/**
+	 * The decompressed pixels of the whole cel, if it is in the decoded cel
+	 * cache.
+	 */
+	Common::SharedPtr<Common::Array<byte> > _pixels;
+
+	/**
+	 * Decompresses the first `width` pixels of the given row into `_buffer`.
+	 */
+	void decodeRow(const int16 y, const int16 width) {
+		// compressed data segment for row
+		const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
+
+		uint32 rowCompressedSize;
+		if (y + 1 < _sourceHeight) {
+			rowCompressedSize = _resource.getUint32SEAt(_controlOffset + (y + 1) * sizeof(uint32)) - rowOffset;
+		} else {
+			rowCompressedSize = _resource.size() - rowOffset - _dataOffset;
+		}
+
+		const byte *row = _resource.getUnsafeDataAt(_dataOffset + rowOffset, rowCompressedSize);
+
+		// uncompressed data segment for row
+		const uint32 literalOffset = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + y * sizeof(uint32));
+
+		uint32 literalRowSize;
+		if (y + 1 < _sourceHeight) {
+			literalRowSize = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + (y + 1) * sizeof(uint32)) - literalOffset;
+		} else {
+			literalRowSize = _resource.size() - literalOffset - _uncompressedDataOffset;
+		}
+
+		const byte *literal = _resource.getUnsafeDataAt(_uncompressedDataOffset + literalOffset, literalRowSize);
+
+		uint8 length;
+		for (int16 i = 0; i < width; i += length) {
+			const byte controlByte = *row++;
+			length = controlByte;
+
+			// Run-length encoded
+			if (controlByte & 0x80) {
+				length &= 0x3F;
+				assert(i + length < (int)sizeof(_buffer));
+
+				// Fill with skip color
+				if (controlByte & 0x40) {
+					memset(_buffer + i, _skipColor, length);
+				// Next value is fill color
+				} else {
+					memset(_buffer + i, *literal, length);
+					++literal;
+				}
+			// Uncompressed
+			} else {
+				assert(i + length < (int)sizeof(_buffer));
+				memcpy(_buffer + i, literal, length);
+				literal += length;
+			}
+		}
+	}
+
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
 	_resource(celObj.getResPointer()),
 	_y(-1),
+	_sourceWidth(celObj._width),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
 	_maxWidth(maxWidth) {
@@ -372,60 +453,29 @@ public:
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
 		_controlOffset = celHeader.getUint32SEAt(32);
+
+		_pixels = celObj.searchDecodedCelCache();
+		if (!_pixels && celObj.canPutInDecodedCelCache()) {
+			// Rows are decoded from their start, so the first pixels of a
+			// whole row are the same as those of a row decoded to `maxWidth`
+			Common::SharedPtr<Common::Array<byte> > pixels(new Common::Array<byte>(_sourceWidth * _sourceHeight));
+			for (int16 y = 0; y < _sourceHeight; ++y) {
+				decodeRow(y, _sourceWidth);
+				memcpy(pixels->begin() + y * _sourceWidth, _buffer, _sourceWidth);
+			}
+			celObj.putInDecodedCelCache(pixels);
+			_pixels = pixels;
+		}
 	}
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
-		if (y != _y) {
-			// compressed data segment for row
-			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
-
-			uint32 rowCompressedSize;
-			if (y + 1 < _sourceHeight) {
-				rowCompressedSize = _resource.getUint32SEAt(_controlOffset + (y + 1) * sizeof(uint32)) - rowOffset;
-			} else {
-				rowCompressedSize = _resource.size() - rowOffset - _dataOffset;
-			}
-
-			const byte *row = _resource.getUnsafeDataAt(_dataOffset + rowOffset, rowCompressedSize);
-
-			// uncompressed data segment for row
-			const uint32 literalOffset = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + y * sizeof(uint32));
-
-			uint32 literalRowSize;
-			if (y + 1 < _sourceHeight) {
-				literalRowSize = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + (y + 1) * sizeof(uint32)) - literalOffset;
-			} else {
-				literalRowSize = _resource.size() - literalOffset - _uncompressedDataOffset;
-			}
-
-			const byte *literal = _resource.getUnsafeDataAt(_uncompressedDataOffset + literalOffset, literalRowSize);
-
-			uint8 length;
-			for (int16 i = 0; i < _maxWidth; i += length) {
-				const byte controlByte = *row++;
-				length = controlByte;
-
-				// Run-length encoded
-				if (controlByte & 0x80) {
-					length &= 0x3F;
-					assert(i + length < (int)sizeof(_buffer));
+		if (_pixels) {
+			return _pixels->begin() + y * _sourceWidth;
+		}
 
-					// Fill with skip color
-					if (controlByte & 0x40) {
-						memset(_buffer + i, _skipColor, length);
-					// Next value is fill color
-					} else {
-						memset(_buffer + i, *literal, length);
-						++literal;
-					}
-				// Uncompressed
-				} else {
-					assert(i + length < (int)sizeof(_buffer));
-					memcpy(_buffer + i, literal, length);
-					literal += length;
-				}
-			}
+		if (y != _y) {
+			decodeRow(y, _maxWidth);
 			_y = y;
 		}
 
@@ -669,19 +719,25 @@ Common::ScopedPtr<CelCache> CelObj::_cache;
 
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	Common::HashMap<CelInfo32, int, CelInfo32Hash>::const_iterator slot = _cache->slots.find(celInfo);
+	if (slot != _cache->slots.end()) {
+		++_cache->hits;
+		_cache->entries[slot->_value].id = ++_nextCacheId;
+		return slot->_value;
+	}
+
+	++_cache->misses;
+
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+	for (int i = 0, len = _cache->entries.size(); i < len; ++i) {
+		CelCacheEntry &entry = _cache->entries[i];
 
 		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
+			*nextInsertIndex = i;
+			break;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
@@ -700,9 +756,116 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 		error("Invalid cache index");
 	}
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	CelCacheEntry &entry = _cache->entries[cacheIndex];
+	if (entry.celObj) {
+		_cache->slots.erase(entry.celObj->_info);
+	}
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	_cache->slots[_info] = cacheIndex;
+}
+
+Common::ScopedPtr<LarryScaleCache> CelObj::_larryScaleCache;
+
+Common::SharedPtr<Buffer> CelObj::searchLarryScaleCache(const int16 width, const int16 height) const {
+	if (!_larryScaleCache) {
+		return Common::SharedPtr<Buffer>();
+	}
+
+	for (uint i = 0; i < _larryScaleCache->size(); ++i) {
+		LarryScaleCacheEntry &entry = (*_larryScaleCache)[i];
+		if (entry.buffer && entry.info == _info && entry.width == width && entry.height == height) {
+			entry.id = ++_nextCacheId;
+			return entry.buffer;
+		}
+	}
+
+	return Common::SharedPtr<Buffer>();
+}
+
+void CelObj::putInLarryScaleCache(const int16 width, const int16 height, const Common::SharedPtr<Buffer> &buffer) const {
+	// The pixels of memory bitmaps are changed by the game scripts, and
+	// resources are the only cels whose pixels are known to stay the same
+	if (!_larryScaleCache || (_info.type != kCelTypeView && _info.type != kCelTypePic)) {
+		return;
+	}
+
+	uint oldestIndex = 0;
+	for (uint i = 1; i < _larryScaleCache->size(); ++i) {
+		if ((*_larryScaleCache)[i].id < (*_larryScaleCache)[oldestIndex].id) {
+			oldestIndex = i;
+		}
+	}
+
+	LarryScaleCacheEntry &entry = (*_larryScaleCache)[oldestIndex];
+	entry.id = ++_nextCacheId;
+	entry.info = _info;
+	entry.width = width;
+	entry.height = height;
+	entry.buffer = buffer;
+}
+
+Common::ScopedPtr<DecodedCelCache> CelObj::_decodedCelCache;
+
+Common::SharedPtr<Common::Array<byte> > CelObj::searchDecodedCelCache() const {
+	if (!_decodedCelCache) {
+		return Common::SharedPtr<Common::Array<byte> >();
+	}
+
+	Common::HashMap<CelInfo32, DecodedCelCacheEntry, CelInfo32Hash>::iterator it = _decodedCelCache->entries.find(_info);
+	if (it == _decodedCelCache->entries.end()) {
+		++_decodedCelCache->misses;
+		return Common::SharedPtr<Common::Array<byte> >();
+	}
+
+	++_decodedCelCache->hits;
+	it->_value.id = ++_nextCacheId;
+	return it->_value.pixels;
+}
+
+bool CelObj::canPutInDecodedCelCache() const {
+	// The pixels of memory bitmaps are changed by the game scripts, and
+	// resources are the only cels whose pixels are known to stay the same
+	return _decodedCelCache &&
+		(_info.type == kCelTypeView || _info.type == kCelTypePic) &&
+		(uint32)_width * _height <= _decodedCelCache->maxSize / 4;
+}
+
+void CelObj::putInDecodedCelCache(const Common::SharedPtr<Common::Array<byte> > &pixels) const {
+	DecodedCelCache &cache = *_decodedCelCache;
+	while (cache.size + pixels->size() > cache.maxSize && !cache.entries.empty()) {
+		Common::HashMap<CelInfo32, DecodedCelCacheEntry, CelInfo32Hash>::iterator oldest = cache.entries.begin();
+		for (Common::HashMap<CelInfo32, DecodedCelCacheEntry, CelInfo32Hash>::iterator it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+			if (it->_value.id < oldest->_value.id) {
+				oldest = it;
+			}
+		}
+		cache.size -= oldest->_value.pixels->size();
+		cache.entries.erase(oldest);
+	}
+
+	DecodedCelCacheEntry &entry = cache.entries[_info];
+	entry.id = ++_nextCacheId;
+	entry.pixels = pixels;
+	cache.size += pixels->size();
+}
+
+void CelObj::printCacheStats(Console *con) {
+	if (!_cache || !_decodedCelCache) {
+		con->debugPrintf("The cel caches are not initialised\n");
+		return;
+	}
+
+	const uint32 cacheLookups = _cache->hits + _cache->misses;
+	con->debugPrintf("Cel cache: %u of %u cels, %u hits, %u misses (%u%% hits)\n",
+		_cache->slots.size(), _cache->entries.size(), _cache->hits, _cache->misses,
+		cacheLookups ? _cache->hits * 100 / cacheLookups : 0);
+
+	const uint32 decodedLookups = _decodedCelCache->hits + _decodedCelCache->misses;
+	con->debugPrintf("Decoded cel cache: %u cels, %u of %u bytes, %u hits, %u misses (%u%% hits)\n",
+		_decodedCelCache->entries.size(), _decodedCelCache->size, _decodedCelCache->maxSize,
+		_decodedCelCache->hits, _decodedCelCache->misses,
+		decodedLookups ? _decodedCelCache->hits * 100 / decodedLookups : 0);
 }
 
 #pragma mark -
@@ -949,7 +1112,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	int cacheInsertIndex;
 	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
 	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
+		CelCacheEntry &entry = _cache->entries[cacheIndex];
 		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
 		if (cachedCelObj == nullptr) {
 			error("Expected a CelObjView in cache slot %d", cacheIndex);
@@ -1168,7 +1331,7 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	int cacheInsertIndex;
 	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
 	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
+		CelCacheEntry &entry = _cache->entries[cacheIndex];
 		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
 		if (cachedCelObj == nullptr) {
 			error("Expected a CelObjPic in cache slot %d", cacheIndex);
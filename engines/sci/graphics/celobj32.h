@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource.h"
@@ -105,7 +106,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +116,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -138,6 +139,17 @@ struct CelInfo32 {
 	}
 };
 
+/**
+ * Hashes the same fields of a CelInfo32 that are compared by its equality
+ * operator.
+ */
+struct CelInfo32Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 6) ^ info.celNo ^
+			(info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
 class CelObj;
 struct CelCacheEntry {
 	/**
@@ -149,7 +161,69 @@ struct CelCacheEntry {
 	CelCacheEntry() : id(0) {}
 };
 
-typedef Common::Array<CelCacheEntry> CelCache;
+struct CelCache {
+	Common::Array<CelCacheEntry> entries;
+
+	/**
+	 * The slot in `entries` of every cached cel, so that a hit does not need
+	 * to compare against every entry.
+	 */
+	Common::HashMap<CelInfo32, int, CelInfo32Hash> slots;
+
+	/**
+	 * The number of cache lookups which did and did not find the cel.
+	 */
+	uint32 hits, misses;
+
+	CelCache(const uint size) : entries(size), hits(0), misses(0) {}
+};
+
+/**
+ * The decompressed pixels of a compressed view or pic cel.
+ */
+struct DecodedCelCacheEntry {
+	/**
+	 * A monotonically increasing cache ID used to identify the least recently
+	 * used item in the cache for replacement.
+	 */
+	int id;
+	Common::SharedPtr<Common::Array<byte> > pixels;
+	DecodedCelCacheEntry() : id(0) {}
+};
+
+struct DecodedCelCache {
+	Common::HashMap<CelInfo32, DecodedCelCacheEntry, CelInfo32Hash> entries;
+
+	/**
+	 * The total number of pixels held by the entries, and the number they
+	 * may hold before the least recently used ones are evicted.
+	 */
+	uint32 size, maxSize;
+
+	/**
+	 * The number of cache lookups which did and did not find the cel.
+	 */
+	uint32 hits, misses;
+
+	DecodedCelCache(const uint32 maxSize_) : size(0), maxSize(maxSize_), hits(0), misses(0) {}
+};
+
+/**
+ * A cel that has been scaled to a given size with LarryScale.
+ */
+struct LarryScaleCacheEntry {
+	/**
+	 * A monotonically increasing cache ID used to identify the least recently
+	 * used item in the cache for replacement.
+	 */
+	int id;
+	CelInfo32 info;
+	int16 width, height;
+	Common::SharedPtr<Buffer> buffer;
+	LarryScaleCacheEntry() : id(0), width(0), height(0) {}
+};
+
+typedef Common::Array<LarryScaleCacheEntry> LarryScaleCache;
 
 #pragma mark -
 #pragma mark CelScaler
@@ -237,6 +311,7 @@ public:
 #pragma mark -
 #pragma mark CelObj
 
+class Console;
 class ScreenItem;
 /**
  * A cel object is the lowest-level rendering primitive in the SCI engine and
@@ -471,6 +546,58 @@ protected:
 	 * Puts a copy of this CelObj into the cache at the given cache index.
 	 */
 	void putCopyInCache(int index) const;
+
+	/**
+	 * A cache of cels scaled with LarryScale. Scaling is much slower than
+	 * drawing, and scaled screen items usually keep their size over many
+	 * frames.
+	 */
+	static Common::ScopedPtr<LarryScaleCache> _larryScaleCache;
+
+	/**
+	 * A cache of the decompressed pixels of compressed view and pic cels, so
+	 * that cels drawn every frame are not decompressed every frame.
+	 */
+	static Common::ScopedPtr<DecodedCelCache> _decodedCelCache;
+
+public:
+	/**
+	 * Returns the decompressed pixels of this cel from the decoded cel cache,
+	 * or null if they are not in the cache.
+	 */
+	Common::SharedPtr<Common::Array<byte> > searchDecodedCelCache() const;
+
+	/**
+	 * Whether the decompressed pixels of this cel may be put into the decoded
+	 * cel cache. Only pixels that cannot change and are small enough to leave
+	 * room for other cels are cached.
+	 */
+	bool canPutInDecodedCelCache() const;
+
+	/**
+	 * Puts the decompressed pixels of this cel into the decoded cel cache,
+	 * evicting the least recently used entries until they fit.
+	 */
+	void putInDecodedCelCache(const Common::SharedPtr<Common::Array<byte> > &pixels) const;
+
+	/**
+	 * Prints the size and hit rates of the cel caches to the debugger console.
+	 */
+	static void printCacheStats(Console *con);
+
+	/**
+	 * Returns this cel scaled to the given size with LarryScale, or null if
+	 * it is not in the cache. The scaled pixels do not depend on the palette,
+	 * so one entry serves every palette the cel is drawn with.
+	 */
+	Common::SharedPtr<Buffer> searchLarryScaleCache(int16 width, int16 height) const;
+
+	/**
+	 * Puts this cel scaled to the given size into the LarryScale cache,
+	 * replacing the least recently used entry if the cache is full. Cels
+	 * whose pixels can change, like memory bitmaps, are not cached.
+	 */
+	void putInLarryScaleCache(int16 width, int16 height, const Common::SharedPtr<Buffer> &buffer) const;
 };
 
 #pragma mark -
@@ -42,6 +42,129 @@ void DrawList::add(ScreenItem *screenItem, const Common::Rect &rect) {
 	DrawListBase::add(drawItem);
 }
 
+#pragma mark -
+#pragma mark ScreenItemGrid
+
+/**
+ * Buckets the screen rects of the items of a plane into a coarse grid, so
+ * that the items which may intersect a rect are found without testing all of
+ * them. The candidates come in list order and include every item whose rect
+ * intersects, so a loop over them which still tests for intersection does
+ * exactly what a loop over the whole list does.
+ */
+class ScreenItemGrid {
+public:
+	ScreenItemGrid(const ScreenItemList &screenItemList, const ScreenItemList::size_type screenItemCount) :
+		_screenItemList(screenItemList),
+		_screenItemCount(MIN(screenItemCount, screenItemList.size())),
+		_query(0) {
+		// Short lists are faster to go through in full
+		if (_screenItemCount < kMinGridItems) {
+			return;
+		}
+
+		_cellStarts.resize(kCellCount + 1);
+		_seen.resize(_screenItemCount);
+
+		// Count the items of each cell, then place them, in list order
+		for (int pass = 0; pass < 2; ++pass) {
+			for (ScreenItemList::size_type i = 0; i < _screenItemCount; ++i) {
+				const ScreenItem *item = _screenItemList[i];
+				if (item == nullptr) {
+					continue;
+				}
+
+				int left, top, right, bottom;
+				getCells(item->_screenRect, left, top, right, bottom);
+				for (int y = top; y <= bottom; ++y) {
+					for (int x = left; x <= right; ++x) {
+						if (pass == 0) {
+							++_cellStarts[y * kGridSize + x + 1];
+						} else {
+							_entries[_cellStarts[y * kGridSize + x] + _cellFill[y * kGridSize + x]++] = i;
+						}
+					}
+				}
+			}
+
+			if (pass == 0) {
+				for (int i = 0; i < kCellCount; ++i) {
+					_cellStarts[i + 1] += _cellStarts[i];
+				}
+				_entries.resize(_cellStarts[kCellCount]);
+				_cellFill.resize(kCellCount);
+			}
+		}
+	}
+
+	/**
+	 * Fills `candidates` with the indexes of the items which may intersect
+	 * the given rect, in ascending order.
+	 */
+	void findCandidates(const Common::Rect &rect, Common::Array<ScreenItemList::size_type> &candidates) {
+		candidates.resize(0);
+
+		if (_cellStarts.empty()) {
+			for (ScreenItemList::size_type i = 0; i < _screenItemCount; ++i) {
+				if (_screenItemList[i] != nullptr) {
+					candidates.push_back(i);
+				}
+			}
+			return;
+		}
+
+		++_query;
+		int left, top, right, bottom;
+		getCells(rect, left, top, right, bottom);
+		for (int y = top; y <= bottom; ++y) {
+			for (int x = left; x <= right; ++x) {
+				const uint cell = y * kGridSize + x;
+				for (uint i = _cellStarts[cell]; i < _cellStarts[cell + 1]; ++i) {
+					const ScreenItemList::size_type index = _entries[i];
+					if (_seen[index] != _query) {
+						_seen[index] = _query;
+						candidates.push_back(index);
+					}
+				}
+			}
+		}
+
+		Common::sort(candidates.begin(), candidates.end());
+	}
+
+private:
+	enum {
+		kMinGridItems = 24,
+		kCellShift = 6,
+		kGridSize = 16,
+		kCellCount = kGridSize * kGridSize
+	};
+
+	/**
+	 * Gets the range of cells to bucket a rect in. Both edges are included,
+	 * and empty or inverted rects still cover the cells of their edges, as
+	 * Common::Rect::intersects can be true for those.
+	 */
+	static void getCells(const Common::Rect &rect, int &left, int &top, int &right, int &bottom) {
+		left = getCell(MIN(rect.left, rect.right));
+		right = getCell(MAX(rect.left, rect.right));
+		top = getCell(MIN(rect.top, rect.bottom));
+		bottom = getCell(MAX(rect.top, rect.bottom));
+	}
+
+	static int getCell(const int16 coordinate) {
+		return CLIP<int>(coordinate >> kCellShift, 0, kGridSize - 1);
+	}
+
+	const ScreenItemList &_screenItemList;
+	const ScreenItemList::size_type _screenItemCount;
+	Common::Array<uint> _cellStarts;
+	Common::Array<uint> _cellFill;
+	Common::Array<ScreenItemList::size_type> _entries;
+	Common::Array<uint> _seen;
+	uint _query;
+};
+
 #pragma mark -
 #pragma mark Plane
 uint16 Plane::_nextObjectId; // Will be initialized in Plane::init()
@@ -431,15 +554,20 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 	DrawList::size_type drawListSizePrimary = drawList.size();
 	const RectList::size_type eraseListCount = eraseList.size();
 
+	Common::Array<ScreenItemList::size_type> candidates;
+
 	if (getSciVersion() == SCI_VERSION_3) {
 		_screenItemList.sort();
 		bool pictureDrawn = false;
 		bool screenItemDrawn = false;
 
+		ScreenItemGrid grid(_screenItemList, screenItemCount);
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
 			const Common::Rect &rect = *eraseList[i];
 
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			grid.findCandidates(rect, candidates);
+			for (uint k = 0; k < candidates.size(); ++k) {
+				const ScreenItemList::size_type j = candidates[k];
 				ScreenItem *item = _screenItemList[j];
 
 				if (item == nullptr) {
@@ -476,10 +604,12 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 		_screenItemList.unsort();
 	} else {
 		// Add all items overlapping the erase list to the draw list
+		ScreenItemGrid grid(_screenItemList, screenItemCount);
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
 			const Common::Rect &rect = *eraseList[i];
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
-				ScreenItem *item = _screenItemList[j];
+			grid.findCandidates(rect, candidates);
+			for (uint k = 0; k < candidates.size(); ++k) {
+				ScreenItem *item = _screenItemList[candidates[k]];
 				if (
 					item != nullptr &&
 					!item->_created && !item->_updated && !item->_deleted &&
@@ -498,13 +628,20 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 		// We only loop over "primary" items in the draw list, skipping
 		// those that were added because of the erase list in the previous loop,
 		// or those to be added in this loop.
+		ScreenItemGrid grid(_screenItemList, screenItemCount);
 		for (DrawList::size_type i = 0; i < drawListSizePrimary; ++i) {
 			const DrawItem *drawListEntry = nullptr;
 			if (i < drawList.size()) {
 				drawListEntry = drawList[i];
 			}
 
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			if (drawListEntry == nullptr) {
+				continue;
+			}
+
+			grid.findCandidates(drawListEntry->rect, candidates);
+			for (uint k = 0; k < candidates.size(); ++k) {
+				const ScreenItemList::size_type j = candidates[k];
 				ScreenItem *newItem = nullptr;
 				if (j < _screenItemList.size()) {
 					newItem = _screenItemList[j];
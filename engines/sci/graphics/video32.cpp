@@ -831,6 +831,11 @@ void VMDPlayer::initOverlay() {
 	// enabled in Shivers.)
 	g_sci->_gfxFrameout->frameOut(true);
 
+	// Frames are copied out of the decoder in this mode, so they can be
+	// decoded while the one before them is shown. Two frames are enough to
+	// get over a large keyframe at the usual 15fps.
+	_decoder->setDecodeAhead(2);
+
 #ifdef USE_RGB_COLOR
 	// TODO: Allow interpolation for videos where the cursor is drawn, either by
 	// writing to an intermediate 4bpp surface and using that surface during
@@ -963,6 +968,10 @@ void VMDPlayer::initComposited() {
 	CelInfo32 vmdCelInfo;
 	vmdCelInfo.bitmap = _bitmapId;
 
+	// The decoder draws straight into the bitmap of the screen item, so the
+	// frames cannot be decoded ahead of the one being shown
+	_decoder->setDecodeAhead(0);
+
 	Video::AdvancedVMDDecoder *decoder = dynamic_cast<Video::AdvancedVMDDecoder *>(_decoder.get());
 	assert(decoder);
 	decoder->setSurfaceMemory(vmdBitmap.getPixels(), vmdBitmap.getWidth(), vmdBitmap.getHeight(), 1);
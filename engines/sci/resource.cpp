@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -966,13 +967,16 @@ void ResourceManager::freeResourceSources() {
 }
 
 ResourceManager::ResourceManager(const bool detectionMode) :
-	_detectionMode(detectionMode) {}
+	_detectionMode(detectionMode), _memoryUsage(Common::kMemoryResources) {}
 
 void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	updateMemoryUsage();
 	_LRU.clear();
+	Common::MemoryTracker::addReclaimer(this);
+	_currentRoom = -1;
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1032,6 +1036,18 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Devices with plenty of memory get to keep the resources of the rooms
+	// visited last, so that going back to them does not decompress their
+	// views and pics again
+	const uint64 physicalMemory = g_system->getPhysicalMemorySize();
+	if (physicalMemory) {
+		const uint64 maxMemory = getSciVersion() >= SCI_VERSION_2 ? 64 * 1024 * 1024 : 8 * 1024 * 1024;
+		const uint64 memoryLRU = MIN<uint64>(physicalMemory / 64, maxMemory);
+		if (memoryLRU > (uint64)_maxMemoryLRU)
+			_maxMemoryLRU = memoryLRU;
+	}
+	debugC(1, kDebugLevelResMan, "resMan: Keeping up to %d bytes of unlocked resources", _maxMemoryLRU);
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1058,6 +1074,9 @@ void ResourceManager::init() {
 }
 
 ResourceManager::~ResourceManager() {
+	Common::MemoryTracker::removeReclaimer(this);
+	cancelPrefetches();
+
 	// freeing resources
 	ResourceMap::iterator itr = _resMap.begin();
 	while (itr != _resMap.end()) {
@@ -1080,6 +1099,7 @@ void ResourceManager::removeFromLRU(Resource *res) {
 	}
 	_LRU.remove(res);
 	_memoryLRU -= res->size();
+	updateMemoryUsage();
 	res->_status = kResStatusAllocated;
 }
 
@@ -1090,6 +1110,7 @@ void ResourceManager::addToLRU(Resource *res) {
 	}
 	_LRU.push_front(res);
 	_memoryLRU += res->size();
+	updateMemoryUsage();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
@@ -1127,6 +1148,17 @@ void ResourceManager::freeOldResources() {
 	}
 }
 
+uint32 ResourceManager::reclaimMemory(uint32 bytes) {
+	uint32 freed = 0;
+	while (freed < bytes && !_LRU.empty()) {
+		Resource *goner = _LRU.back();
+		freed += goner->size();
+		removeFromLRU(goner);
+		goner->unalloc();
+	}
+	return freed;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1152,9 +1184,13 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
-		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	if (!_prefetches.empty())
+		collectPrefetches();
+
+	if (retval->_status == kResStatusNoMalloc) {
+		if (_prefetches.empty() || !adoptPrefetch(retval))
+			loadResource(retval);
+	} else if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
@@ -1172,6 +1208,7 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 			retval->_status = kResStatusLocked;
 			retval->_lockers = 0;
 			_memoryLocked += retval->_size;
+			updateMemoryUsage();
 		}
 		retval->_lockers++;
 	} else if (retval->_status != kResStatusLocked) { // Don't lock it
@@ -1179,6 +1216,10 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 			addToLRU(retval);
 	}
 
+	if (_currentRoom != -1 && (id.getType() == kResourceTypeView || id.getType() == kResourceTypePic) &&
+	    _currentRoomRequests.size() < MAX_ROOM_PREFETCHES && Common::find(_currentRoomRequests.begin(), _currentRoomRequests.end(), id) == _currentRoomRequests.end())
+		_currentRoomRequests.push_back(id);
+
 	if (retval->data())
 		return retval;
 	else {
@@ -1204,6 +1245,139 @@ void ResourceManager::unlockResource(Resource *res) {
 	freeOldResources();
 }
 
+/**
+ * Loads a resource from a stream of its own on a worker thread. The resource
+ * is not in the resource map, so nothing else touches it in the meantime.
+ */
+class ResourceManager::PrefetchTask : public Common::Task {
+public:
+	PrefetchTask(Resource *resource, Common::SeekableReadStream *stream, ResVersion volVersion) :
+		_resource(resource), _stream(stream), _volVersion(volVersion) {}
+
+	~PrefetchTask() {
+		delete _stream;
+	}
+
+	void run() {
+		_stream->seek(_resource->_fileOffset, SEEK_SET);
+		if (_resource->decompress(_volVersion, _stream))
+			_resource->unalloc();
+	}
+
+private:
+	Resource *_resource;
+	Common::SeekableReadStream *_stream;
+	const ResVersion _volVersion;
+};
+
+void ResourceManager::enterRoom(uint16 roomNumber) {
+	if (_currentRoom != -1)
+		_roomRequests.setVal(_currentRoom, _currentRoomRequests);
+	_currentRoomRequests.clear();
+	_currentRoom = roomNumber;
+
+	// Prefetches of the previous room which were not asked for yet are worth
+	// keeping, as they were requested during its last visit
+	collectPrefetches();
+
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	RoomRequestMap::const_iterator requests = _roomRequests.find(roomNumber);
+	if (_detectionMode || scheduler->isSerial() || requests == _roomRequests.end())
+		return;
+
+	for (uint i = 0; i < requests->_value.size(); ++i) {
+		const ResourceId &id = requests->_value[i];
+		Resource *res = testResource(id);
+		if (!res || res->_status != kResStatusNoMalloc || _prefetches.contains(id))
+			continue;
+
+		// Other sources do not read their resources from volume files, or
+		// share their streams
+		ResourceSource *source = res->_source;
+		if (source->getSourceType() != kSourceVolume)
+			continue;
+
+		Common::SeekableReadStream *stream;
+		if (source->_resourceFile) {
+			stream = source->_resourceFile->createReadStream();
+		} else {
+			Common::File *file = new Common::File;
+			if (!file->open(source->getLocationName())) {
+				delete file;
+				file = nullptr;
+			}
+			stream = file;
+		}
+
+		if (!stream)
+			continue;
+
+		Resource *prefetched = new Resource(this, id);
+		prefetched->_source = source;
+		prefetched->_fileOffset = res->_fileOffset;
+
+		Prefetch &prefetch = _prefetches[id];
+		prefetch.resource = prefetched;
+		prefetch.future = scheduler->schedule(new PrefetchTask(prefetched, stream, _volVersion));
+	}
+
+	debugC(2, kDebugLevelResMan, "resMan: Entering room %d, prefetching %d resources", roomNumber, _prefetches.size());
+}
+
+bool ResourceManager::adoptPrefetch(Resource *res) {
+	PrefetchMap::iterator it = _prefetches.find(res->_id);
+	if (it == _prefetches.end())
+		return false;
+
+	it->_value.future.wait();
+	Resource *prefetched = it->_value.resource;
+	_prefetches.erase(it);
+
+	// Failures are left to loadResource() to report
+	const bool loaded = prefetched->_status == kResStatusAllocated;
+	if (loaded) {
+		res->_id = prefetched->_id;
+		res->_data = prefetched->_data;
+		res->_size = prefetched->_size;
+		res->_status = kResStatusAllocated;
+		prefetched->_data = nullptr;
+	}
+
+	delete prefetched;
+	return loaded;
+}
+
+void ResourceManager::collectPrefetches() {
+	Common::Array<ResourceId> done;
+	for (PrefetchMap::const_iterator it = _prefetches.begin(); it != _prefetches.end(); ++it) {
+		if (it->_value.future.isDone())
+			done.push_back(it->_key);
+	}
+
+	for (uint i = 0; i < done.size(); ++i) {
+		Resource *res = testResource(done[i]);
+		if (res && res->_status == kResStatusNoMalloc) {
+			if (adoptPrefetch(res))
+				addToLRU(res);
+		} else {
+			delete _prefetches[done[i]].resource;
+			_prefetches.erase(done[i]);
+		}
+	}
+
+	if (!done.empty())
+		freeOldResources();
+}
+
+void ResourceManager::cancelPrefetches() {
+	for (PrefetchMap::iterator it = _prefetches.begin(); it != _prefetches.end(); ++it) {
+		it->_value.future.wait();
+		delete it->_value.resource;
+	}
+
+	_prefetches.clear();
+}
+
 const char *ResourceManager::versionDescription(ResVersion version) const {
 	switch (version) {
 	case kResVersionUnknown:
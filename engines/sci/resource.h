@@ -23,9 +23,12 @@
 #ifndef SCI_RESOURCE_H
 #define SCI_RESOURCE_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/memtracker.h"
+#include "common/taskscheduler.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/decompressor.h"
@@ -76,7 +79,8 @@ enum ResourceErrorCodes {
 };
 
 enum {
-	MAX_OPENED_VOLUMES = 5 ///< Max number of simultaneously opened volumes
+	MAX_OPENED_VOLUMES = 5, ///< Max number of simultaneously opened volumes
+	MAX_ROOM_PREFETCHES = 48 ///< Max number of resources prefetched when entering a room
 };
 
 enum ResourceType {
@@ -311,7 +315,7 @@ protected:
 typedef Common::HashMap<ResourceId, Resource *, ResourceIdHash> ResourceMap;
 
 class IntMapResourceSource;
-class ResourceManager {
+class ResourceManager : public Common::MemoryReclaimer {
 	// FIXME: These 'friend' declarations are meant to be a temporary hack to
 	// ease transition to the ResourceSource class system.
 	friend class ResourceSource;
@@ -340,6 +344,9 @@ public:
 	 */
 	void init();
 
+	/** Frees unlocked resources, least recently used first. */
+	virtual uint32 reclaimMemory(uint32 bytes);
+
 	/**
 	 * Adds all of the resource files for a game
 	 */
@@ -366,6 +373,15 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Tells the resource manager that the game enters a room. The views and
+	 * pics requested during the last visit of the room are prefetched on
+	 * worker threads, and the ones requested from now on are recorded for
+	 * the next visit.
+	 * @param roomNumber	The number of the room
+	 */
+	void enterRoom(uint16 roomNumber);
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -479,7 +495,24 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
+	Common::MemoryUsage _memoryUsage; ///< Both of the above, for the MemoryTracker
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+
+	class PrefetchTask;
+
+	/** A resource being loaded on a worker thread */
+	struct Prefetch {
+		Resource *resource; ///< Receives the data, for adoption by the resource in the map
+		Common::TaskFuture future;
+	};
+
+	typedef Common::HashMap<ResourceId, Prefetch, ResourceIdHash> PrefetchMap;
+	typedef Common::HashMap<uint16, Common::Array<ResourceId> > RoomRequestMap;
+
+	PrefetchMap _prefetches; ///< Resources being loaded on worker threads
+	RoomRequestMap _roomRequests; ///< Views and pics requested during the last visit of each room
+	Common::Array<ResourceId> _currentRoomRequests; ///< Views and pics requested since entering the current room
+	int _currentRoom; ///< The room last entered, or -1
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -540,6 +573,19 @@ protected:
 	void disposeVolumeFileStream(Common::SeekableReadStream *fileStream, ResourceSource *source);
 	void loadResource(Resource *res);
 	void freeOldResources();
+	void updateMemoryUsage() { _memoryUsage.set(_memoryLocked + _memoryLRU); }
+
+	/**
+	 * Picks the data of a prefetched resource, waiting for it to be loaded.
+	 * @return Whether the resource is now allocated
+	 */
+	bool adoptPrefetch(Resource *res);
+
+	/** Moves the prefetched resources done loading under LRU control */
+	void collectPrefetches();
+
+	/** Waits for all prefetches and drops their data */
+	void cancelPrefetches();
 	bool validateResource(const ResourceId &resourceId, const Common::String &sourceMapLocation, const Common::String &sourceName, const uint32 offset, const uint32 size, const uint32 sourceSize) const;
 	Resource *addResource(ResourceId resId, ResourceSource *src, uint32 offset, uint32 size = 0, const Common::String &sourceMapLocation = Common::String("(no map location)"));
 	Resource *updateResource(ResourceId resId, ResourceSource *src, uint32 size, const Common::String &sourceMapLocation = Common::String("(no map location)"));
@@ -30,6 +30,7 @@
 #include "common/str.h"              // for String
 #include "common/stream.h"           // for SeekableReadStream
 #include "common/substream.h"        // for SeekableSubReadStreamEndian
+#include "common/system.h"           // for g_system
 #include "common/textconsole.h"      // for error, warning
 #include "common/types.h"            // for Flag::NO, Flag::YES
 #include "sci/engine/seg_manager.h"  // for SegManager
@@ -612,6 +613,9 @@ void RobotDecoder::close() {
 	_recordPositions.clear();
 	_celDecompressionBuffer.clear();
 	_doVersion5Scratch.clear();
+	cancelDecodeAhead();
+	_decodedFrame.videoData.clear();
+	_decodedFrame.cels.clear();
 	delete _stream;
 	_stream = nullptr;
 }
@@ -1241,6 +1245,8 @@ void RobotDecoder::doRobot() {
 	if (_hasAudio) {
 		_audioList.submitDriverMax();
 	}
+
+	startDecodeAhead(_currentFrameNo + 1);
 }
 
 void RobotDecoder::frameAlmostVisible() {
@@ -1357,13 +1363,22 @@ void RobotDecoder::setPriority(const int16 newPriority) {
 
 void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 	const RobotScreenItemList::size_type oldScreenItemCount = _screenItemList.size();
-	const int videoSize = _videoSizes[_currentFrameNo];
-	_doVersion5Scratch.resize(videoSize);
 
-	byte *videoFrameData = _doVersion5Scratch.begin();
+	byte *videoFrameData;
+	if (_decodedFrame.frameNo == _currentFrameNo) {
+		_decodedFrame.future.wait();
+		videoFrameData = _decodedFrame.videoData.begin();
+	} else {
+		cancelDecodeAhead();
+
+		const int videoSize = _videoSizes[_currentFrameNo];
+		_doVersion5Scratch.resize(videoSize);
 
-	if (!_stream->read(videoFrameData, videoSize)) {
-		error("RobotDecoder::doVersion5: Read error");
+		videoFrameData = _doVersion5Scratch.begin();
+
+		if (!_stream->read(videoFrameData, videoSize)) {
+			error("RobotDecoder::doVersion5: Read error");
+		}
 	}
 
 	const RobotScreenItemList::size_type screenItemCount = READ_SCI11ENDIAN_UINT16(videoFrameData);
@@ -1507,41 +1522,29 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 	assert(bitmap.getHunkPaletteOffset() == (uint32)bitmap.getWidth() * bitmap.getHeight() + SciBitmap::getBitmapHeaderSize());
 	bitmap.setOrigin(origin);
 
-	byte *targetBuffer;
-	if (_verticalScaleFactor == 100) {
-		// direct copy to bitmap
-		targetBuffer = bitmap.getPixels();
-	} else {
-		// go through squashed cel decompressor
-		_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
-		targetBuffer = _celDecompressionBuffer.begin();
-	}
-
-	for (int i = 0; i < numDataChunks; ++i) {
-		uint compressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData);
-		uint decompressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData + 4);
-		uint16 compressionType = READ_SCI11ENDIAN_UINT16(rawVideoData + 8);
-		rawVideoData += 10;
-
-		switch (compressionType) {
-		case kCompressionLZS: {
-			Common::MemoryReadStream videoDataStream(rawVideoData, compressedSize, DisposeAfterUse::NO);
-			_decompressor.unpack(&videoDataStream, targetBuffer, compressedSize, decompressedSize);
-			break;
+	if (_decodedFrame.frameNo == _currentFrameNo) {
+		const ScratchMemory &decodedCel = _decodedFrame.cels[screenItemIndex];
+		if (_verticalScaleFactor == 100) {
+			Common::copy(decodedCel.begin(), decodedCel.begin() + celWidth * celHeight, bitmap.getPixels());
+		} else {
+			expandCel(bitmap.getPixels(), decodedCel.begin(), celWidth, celHeight);
 		}
-		case kCompressionNone:
-			Common::copy(rawVideoData, rawVideoData + decompressedSize, targetBuffer);
-			break;
-		default:
-			error("Unknown compression type %d!", compressionType);
+	} else {
+		byte *targetBuffer;
+		if (_verticalScaleFactor == 100) {
+			// direct copy to bitmap
+			targetBuffer = bitmap.getPixels();
+		} else {
+			// go through squashed cel decompressor
+			_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
+			targetBuffer = _celDecompressionBuffer.begin();
 		}
 
-		rawVideoData += compressedSize;
-		targetBuffer += decompressedSize;
-	}
+		decompressCel(_decompressor, rawVideoData, numDataChunks, targetBuffer);
 
-	if (_verticalScaleFactor != 100) {
-		expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight);
+		if (_verticalScaleFactor != 100) {
+			expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight);
+		}
 	}
 
 	if (usePalette) {
@@ -1618,4 +1621,104 @@ void RobotDecoder::preallocateCelMemory(const byte *rawVideoData, const int16 nu
 	}
 }
 
+void RobotDecoder::decompressCel(DecompressorLZS &decompressor, const byte *rawVideoData, const int16 numDataChunks, byte *target) {
+	for (int i = 0; i < numDataChunks; ++i) {
+		uint compressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData);
+		uint decompressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData + 4);
+		uint16 compressionType = READ_SCI11ENDIAN_UINT16(rawVideoData + 8);
+		rawVideoData += 10;
+
+		switch (compressionType) {
+		case kCompressionLZS: {
+			Common::MemoryReadStream videoDataStream(rawVideoData, compressedSize, DisposeAfterUse::NO);
+			decompressor.unpack(&videoDataStream, target, compressedSize, decompressedSize);
+			break;
+		}
+		case kCompressionNone:
+			Common::copy(rawVideoData, rawVideoData + decompressedSize, target);
+			break;
+		default:
+			error("Unknown compression type %d!", compressionType);
+		}
+
+		rawVideoData += compressedSize;
+		target += decompressedSize;
+	}
+}
+
+#pragma mark -
+#pragma mark RobotDecoder - Decoding ahead
+
+class RobotDecoder::DecodeAheadTask : public Common::Task {
+public:
+	DecodeAheadTask(RobotDecoder &decoder) : _decoder(decoder) {}
+
+	virtual void run() {
+		_decoder.decodeAhead();
+	}
+
+private:
+	RobotDecoder &_decoder;
+};
+
+void RobotDecoder::startDecodeAhead(const int frameNo) {
+	cancelDecodeAhead();
+
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (frameNo >= _numFramesTotal || scheduler->isSerial()) {
+		return;
+	}
+
+	const int videoSize = _videoSizes[frameNo];
+	_decodedFrame.videoData.resize(videoSize);
+	seekToFrame(frameNo);
+	if (_stream->read(_decodedFrame.videoData.begin(), videoSize) != (uint32)videoSize) {
+		return;
+	}
+
+	_decodedFrame.frameNo = frameNo;
+	_decodedFrame.future = scheduler->schedule(new DecodeAheadTask(*this));
+}
+
+void RobotDecoder::decodeAhead() {
+	const byte *rawVideoData = _decodedFrame.videoData.begin();
+	const uint16 numCels = READ_SCI11ENDIAN_UINT16(rawVideoData);
+
+	// doVersion5 skips such frames
+	if (numCels > kScreenItemListSize) {
+		return;
+	}
+
+	rawVideoData += 2;
+	_decodedFrame.cels.resize(numCels);
+	for (uint16 i = 0; i < numCels; ++i) {
+		const int16 verticalScaleFactor = rawVideoData[1];
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 4);
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(rawVideoData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 16);
+
+		uint decompressedSize = 0;
+		const byte *chunk = rawVideoData + kCelHeaderSize;
+		for (int16 j = 0; j < numDataChunks; ++j) {
+			decompressedSize += READ_SCI11ENDIAN_UINT32(chunk + 4);
+			chunk += 10 + READ_SCI11ENDIAN_UINT32(chunk);
+		}
+
+		ScratchMemory &cel = _decodedFrame.cels[i];
+		cel.resize(MAX<uint>(decompressedSize, celWidth * (celHeight * verticalScaleFactor / 100)));
+		decompressCel(_decodeAheadDecompressor, rawVideoData + kCelHeaderSize, numDataChunks, cel.begin());
+
+		rawVideoData += kCelHeaderSize + dataSize;
+	}
+}
+
+void RobotDecoder::cancelDecodeAhead() {
+	if (_decodedFrame.future.isValid()) {
+		_decodedFrame.future.wait();
+		_decodedFrame.future = Common::TaskFuture();
+	}
+	_decodedFrame.frameNo = -1;
+}
+
 } // End of namespace Sci
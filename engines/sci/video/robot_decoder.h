@@ -29,6 +29,7 @@
 #include "common/mutex.h"                // for StackLock, Mutex
 #include "common/rect.h"                 // for Point, Rect (ptr only)
 #include "common/scummsys.h"             // for int16, int32, byte, uint16
+#include "common/taskscheduler.h"        // for Task, TaskFuture
 #include "sci/engine/vm_types.h"         // for NULL_REG, reg_t
 #include "sci/graphics/helpers.h"        // for GuiResourceId
 #include "sci/graphics/screen_item32.h"  // for ScaleInfo, ScreenItem (ptr o...
@@ -1232,6 +1233,75 @@ private:
 	 */
 	void preallocateCelMemory(const byte *rawVideoData, const int16 numCels);
 
+	/**
+	 * Decompresses the data chunks of a cel into `target`.
+	 */
+	static void decompressCel(DecompressorLZS &decompressor, const byte *rawVideoData, const int16 numDataChunks, byte *target);
+
+#pragma mark -
+#pragma mark Rendering - Decoding ahead
+
+	class DecodeAheadTask;
+	friend class DecodeAheadTask;
+
+	/**
+	 * A frame whose cels are decompressed on the task scheduler while the
+	 * frame before it is shown, so that a frame with large cels does not
+	 * hold up the frame output.
+	 */
+	struct DecodedFrame {
+		/**
+		 * The number of the frame, or -1 if there is none.
+		 */
+		int frameNo;
+
+		/**
+		 * The compressed video data of the frame.
+		 */
+		ScratchMemory videoData;
+
+		/**
+		 * The decompressed pixels of each cel in the frame, before vertically
+		 * squashed cels are expanded.
+		 */
+		Common::Array<ScratchMemory> cels;
+
+		/**
+		 * The task decompressing the cels.
+		 */
+		Common::TaskFuture future;
+
+		DecodedFrame() : frameNo(-1) {}
+	};
+
+	/**
+	 * Reads the video data of the given frame and starts decompressing its
+	 * cels on the task scheduler. The stream is only read from the calling
+	 * thread, since audio is read from it as well.
+	 */
+	void startDecodeAhead(const int frameNo);
+
+	/**
+	 * Decompresses the cels of the decoded frame. Called on the task
+	 * scheduler.
+	 */
+	void decodeAhead();
+
+	/**
+	 * Waits for the frame being decoded ahead and forgets it.
+	 */
+	void cancelDecodeAhead();
+
+	/**
+	 * The frame being decoded ahead.
+	 */
+	DecodedFrame _decodedFrame;
+
+	/**
+	 * The decompressor used by the decode ahead task.
+	 */
+	DecompressorLZS _decodeAheadDecompressor;
+
 	/**
 	 * The decompressor for LZS-compressed cels.
 	 */
@@ -21,6 +21,7 @@
  */
 
 #include "common/debug-channels.h"
+#include "common/algorithm.h"
 #include "common/file.h"
 #include "common/str.h"
 #include "common/system.h"
@@ -97,6 +98,10 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+
+#ifdef ENABLE_PROFILER
+	registerCmd("scriptprofile",   WRAP_METHOD(ScummDebugger, Cmd_ScriptProfile));
+#endif
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -842,4 +847,87 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+#ifdef ENABLE_PROFILER
+namespace {
+
+struct ScriptProfileLine {
+	uint32 key;
+	uint32 calls;
+	uint64 totalTime;
+	uint64 selfTime;
+};
+
+struct ScriptProfileLineLess {
+	bool operator()(const ScriptProfileLine &a, const ScriptProfileLine &b) const {
+		return a.selfTime > b.selfTime;
+	}
+};
+
+} // End of anonymous namespace
+
+bool ScummDebugger::Cmd_ScriptProfile(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		_vm->_scriptProfileEnabled = true;
+		debugPrintf("Script profiling enabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		_vm->_scriptProfileEnabled = false;
+		debugPrintf("Script profiling disabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "clear")) {
+		_vm->_scriptProfile.clear();
+		debugPrintf("Script profile cleared\n");
+		return true;
+	} else if ((argc == 2 || argc == 3) && (!strcmp(argv[1], "opcodes") || !strcmp(argv[1], "scripts"))) {
+		const bool byScript = !strcmp(argv[1], "scripts");
+		const uint count = (argc == 3) ? atoi(argv[2]) : 20;
+
+		// Sum up the opcodes of each script when asked for whole scripts
+		Common::Array<ScriptProfileLine> lines;
+		Common::HashMap<uint32, uint> scriptLines;
+		for (ScummEngine::ScriptProfileMap::const_iterator i = _vm->_scriptProfile.begin(); i != _vm->_scriptProfile.end(); ++i) {
+			const uint32 key = byScript ? (i->_key >> 8) : i->_key;
+			Common::HashMap<uint32, uint>::const_iterator found = scriptLines.find(key);
+			uint line;
+			if (byScript && found != scriptLines.end()) {
+				line = found->_value;
+			} else {
+				line = lines.size();
+				if (byScript)
+					scriptLines[key] = line;
+				ScriptProfileLine empty = { key, 0, 0, 0 };
+				lines.push_back(empty);
+			}
+			lines[line].calls += i->_value.calls;
+			lines[line].totalTime += i->_value.totalTime;
+			lines[line].selfTime += i->_value.selfTime;
+		}
+
+		Common::sort(lines.begin(), lines.end(), ScriptProfileLineLess());
+
+		if (byScript)
+			debugPrintf("Script    Opcodes     Self ms    Total ms\n");
+		else
+			debugPrintf("Script Opcode                          Calls     Self ms    Total ms\n");
+		for (uint i = 0; i < lines.size() && i < count; i++) {
+			const ScriptProfileLine &line = lines[i];
+			if (byScript)
+				debugPrintf("%6u %10u %11.2f %11.2f\n", line.key, line.calls,
+					line.selfTime / 1000.0, line.totalTime / 1000.0);
+			else
+				debugPrintf("%6u [%02X] %-26s %8u %11.2f %11.2f\n", line.key >> 8, line.key & 0xFF,
+					_vm->getOpcodeDesc(line.key & 0xFF), line.calls,
+					line.selfTime / 1000.0, line.totalTime / 1000.0);
+		}
+		return true;
+	}
+
+	debugPrintf("scriptprofile on | off | clear | opcodes [<count>] | scripts [<count>]\n");
+	debugPrintf("  Times the opcodes of each script, hottest first by self time, which leaves\n");
+	debugPrintf("  out the scripts they run nested. While 'profile start' records, every\n");
+	debugPrintf("  opcode is also recorded as a zone\n");
+	return true;
+}
+#endif
+
 } // End of namespace Scumm
@@ -69,6 +69,10 @@ private:
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
+#ifdef ENABLE_PROFILER
+	bool Cmd_ScriptProfile(int argc, const char **argv);
+#endif
+
 	void printBox(int box);
 	void drawBox(int box);
 };
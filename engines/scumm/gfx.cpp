@@ -215,6 +215,8 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+	_cacheRoomStrips = true;
+	resetRoomStripCache();
 }
 
 Gdi::~Gdi() {
@@ -225,11 +227,13 @@ GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(0) {
 
 
 GdiNES::GdiNES(ScummEngine *vm) : Gdi(vm) {
+	_cacheRoomStrips = false;
 	memset(&_NES, 0, sizeof(_NES));
 }
 
 #ifdef USE_RGB_COLOR
 GdiPCEngine::GdiPCEngine(ScummEngine *vm) : Gdi(vm) {
+	_cacheRoomStrips = false;
 	memset(&_PCE, 0, sizeof(_PCE));
 }
 
@@ -241,10 +245,12 @@ GdiPCEngine::~GdiPCEngine() {
 #endif
 
 GdiV1::GdiV1(ScummEngine *vm) : Gdi(vm) {
+	_cacheRoomStrips = false;
 	memset(&_V1, 0, sizeof(_V1));
 }
 
 GdiV2::GdiV2(ScummEngine *vm) : Gdi(vm) {
+	_cacheRoomStrips = false;
 	_roomStrips = 0;
 }
 
@@ -254,6 +260,8 @@ GdiV2::~GdiV2() {
 
 #ifdef USE_RGB_COLOR
 GdiHE16bit::GdiHE16bit(ScummEngine *vm) : GdiHE(vm) {
+	// Room colors come from the HE palettes
+	_cacheRoomStrips = false;
 }
 #endif
 
@@ -905,6 +913,8 @@ void ScummEngine::initBGBuffers(int height) {
 	size = itemsize * _gdi->_numZBuffer;
 	memset(_res->createResource(rtBuffer, 9, size), 0, size);
 
+	_gdi->resetRoomStripCache();
+
 	for (i = 0; i < (int)ARRAYSIZE(_gdi->_imgBufOffs); i++) {
 		if (i < _gdi->_numZBuffer)
 			_gdi->_imgBufOffs[i] = i * itemsize;
@@ -1008,7 +1018,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbRoomImage);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1756,6 +1766,44 @@ int Gdi::getZPlanes(const byte *ptr, const byte *zplane_list[9], bool bmapImage)
 	return numzbuf;
 }
 
+void Gdi::resetRoomStripCache() {
+	_roomStripCache.image = 0;
+	_roomStripCache.data.clear();
+	_roomStripCache.state.clear();
+}
+
+/**
+ * Get the strip cache ready for drawing strips of the room image 'ptr',
+ * emptying it if anything the decoded strips depend on has changed.
+ */
+bool Gdi::prepareRoomStripCache(const byte *ptr, VirtScreen *vs, int height, int numzbuf, const byte *zplane_list[9]) {
+	if (!_cacheRoomStrips || vs->number != kMainVirtScreen)
+		return false;
+
+	RoomStripCache &cache = _roomStripCache;
+	const uint numStrips = MAX(_vm->_roomWidth, (int)vs->w) / 8;
+	const int stripSize = (8 * vs->format.bytesPerPixel + numzbuf) * height;
+	uint32 zPlanes = 0;
+	for (int i = 1; i < numzbuf; i++) {
+		if (zplane_list[i])
+			zPlanes |= 1 << i;
+	}
+
+	if (cache.image != ptr || cache.height != height || cache.zPlanes != zPlanes || cache.stripSize != stripSize ||
+		cache.state.size() != numStrips || memcmp(cache.palette, _vm->_roomPalette, sizeof(cache.palette))) {
+		cache.image = ptr;
+		cache.height = height;
+		cache.zPlanes = zPlanes;
+		cache.stripSize = stripSize;
+		memcpy(cache.palette, _vm->_roomPalette, sizeof(cache.palette));
+		cache.state.resize(numStrips);
+		memset(cache.state.begin(), 0, numStrips);
+		cache.data.resize(numStrips * stripSize);
+	}
+
+	return true;
+}
+
 /**
  * Draw a bitmap onto a virtual screen. This is main drawing method for room backgrounds
  * and objects, used throughout all SCUMM versions.
@@ -1784,6 +1832,9 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 
 	numzbuf = getZPlanes(ptr, zplane_list, false);
 
+	const bool useCache = (flag & dbRoomImage) && y == 0 && prepareRoomStripCache(ptr, vs, height, numzbuf, zplane_list);
+	const int rowSize = 8 * vs->format.bytesPerPixel;
+
 	if (y + height > vs->h) {
 		warning("Gdi::drawBitmap, strip drawn to %d below window bottom %d", y + height, vs->h);
 	}
@@ -1832,7 +1883,24 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		byte *cached = 0;
+		bool isCached = false;
+		if (useCache && stripnr >= 0 && stripnr < (int)_roomStripCache.state.size()) {
+			cached = &_roomStripCache.data[stripnr * _roomStripCache.stripSize];
+			isCached = _roomStripCache.state[stripnr] != 0;
+		}
+
+		if (isCached) {
+			for (int h = 0; h < height; h++)
+				memcpy(dstPtr + h * vs->pitch, cached + h * rowSize, rowSize);
+			transpStrip = _roomStripCache.state[stripnr] == 2;
+		} else {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+			if (cached) {
+				for (int h = 0; h < height; h++)
+					memcpy(cached + h * rowSize, dstPtr + h * vs->pitch, rowSize);
+			}
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -1846,7 +1914,25 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!isCached)
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+		if (cached) {
+			// Only the z-planes the room has are written by decodeMask()
+			for (int i = 1; i < numzbuf; i++) {
+				if (!(_roomStripCache.zPlanes & (1 << i)))
+					continue;
+				byte *maskPtr = getMaskBuffer(x, y, i);
+				byte *cachedMask = cached + rowSize * height + i * height;
+				for (int h = 0; h < height; h++) {
+					if (isCached)
+						maskPtr[h * _numStrips] = cachedMask[h];
+					else
+						cachedMask[h] = maskPtr[h * _numStrips];
+				}
+			}
+			_roomStripCache.state[stripnr] = transpStrip ? 2 : 1;
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -25,6 +25,7 @@
 
 #include "common/system.h"
 #include "common/list.h"
+#include "common/array.h"
 
 #include "graphics/surface.h"
 
@@ -209,6 +210,29 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * The strips of the room image decoded so far, with their z-plane masks.
+	 * The room image does not change while the room is shown, so background
+	 * strips which are redrawn get copied back from here.
+	 */
+	struct RoomStripCache {
+		const byte *image;
+		int height;
+		uint32 zPlanes;
+		int stripSize;
+		byte palette[256];
+		/** Strip pixels followed by a column of each z-plane mask */
+		Common::Array<byte> data;
+		/** 0 for strips not decoded yet, else 1 + the transparency flag */
+		Common::Array<byte> state;
+	};
+	RoomStripCache _roomStripCache;
+
+	/** Whether drawStrip() and decodeMask() only depend on the room image. */
+	bool _cacheRoomStrips;
+
+	bool prepareRoomStripCache(const byte *ptr, VirtScreen *vs, int height, int numzbuf, const byte *zplane_list[9]);
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -278,11 +302,13 @@ public:
 	void enableZBuffer() { _zbufferDisabled = false; }
 
 	void resetBackground(int top, int bottom, int strip);
+	void resetRoomStripCache();
 
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbRoomImage     = 1 << 4
 	};
 };
 
@@ -160,10 +160,12 @@ AI::AI(ScummEngine_v100he *vm) : _vm(vm) {
 
 	memset(_moveList, 0, sizeof(_moveList));
 	_mcpParams = 0;
+	_turnCacheEnabled = false;
 }
 
 void AI::resetAI() {
 	_aiState = STATE_CHOOSE_BEHAVIOR;
+	endTurnCache();
 	debugC(DEBUG_MOONBASE_AI, "----------------------> Resetting AI");
 
 	for (int i = 1; i != 5; i++) {
@@ -315,6 +317,7 @@ int AI::masterControlProgram(const int paramCount, const int32 *params) {
 
 	switch (_aiState) {
 	case STATE_CHOOSE_BEHAVIOR:
+		beginTurnCache();
 		_behavior = chooseBehavior();
 		debugC(DEBUG_MOONBASE_AI, "Behavior mode: %d", _behavior);
 
@@ -938,6 +941,7 @@ int AI::masterControlProgram(const int paramCount, const int32 *params) {
 		launchAction = NULL;
 
 		_aiState = STATE_CHOOSE_BEHAVIOR;
+		endTurnCache();
 
 		int rSh, rU, rP, rA = 0;
 		rSh = _vm->readVar(_vm->VAR_U32_USER_VAR_A);
@@ -2401,6 +2405,51 @@ int *AI::defendTarget(int &targetX, int &targetY, int index) {
 	return retVal;
 }
 
+void AI::beginTurnCache() {
+	for (int i = 0; i < kTurnCacheTypes; i++)
+		_turnCache[i].clear();
+	_turnCacheEnabled = true;
+}
+
+void AI::endTurnCache() {
+	for (int i = 0; i < kTurnCacheTypes; i++)
+		_turnCache[i].clear(true);
+	_turnCacheEnabled = false;
+}
+
+int AI::getTurnScummData(int dataType) {
+	if (_turnCacheEnabled) {
+		TurnCache::const_iterator i = _turnCache[kTurnCacheScummData].find(dataType);
+		if (i != _turnCache[kTurnCacheScummData].end())
+			return i->_value;
+	}
+
+	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, dataType);
+
+	if (_turnCacheEnabled)
+		_turnCache[kTurnCacheScummData][dataType] = retVal;
+
+	return retVal;
+}
+
+int AI::getTurnPointData(TurnCacheType type, int function, int x, int y) {
+	const bool cacheable = _turnCacheEnabled && x >= 0 && x < 0x10000 && y >= 0 && y < 0x10000;
+	const uint32 key = ((uint32)x << 16) | y;
+
+	if (cacheable) {
+		TurnCache::const_iterator i = _turnCache[type].find(key);
+		if (i != _turnCache[type].end())
+			return i->_value;
+	}
+
+	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[function], 2, x, y);
+
+	if (cacheable)
+		_turnCache[type][key] = retVal;
+
+	return retVal;
+}
+
 int AI::getClosestUnit(int x, int y, int radius, int player, int alignment, int unitType, int checkUnitEnabled) {
 	assert((unitType >= 0) && (unitType <= 12));
 
@@ -2430,7 +2479,7 @@ int AI::calcAngle(int originX, int originY, int endX, int endY, int noWrapFlag)
 }
 
 int AI::getTerrain(int x, int y) {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_TERRAIN_TYPE], 2, x, y);
+	int retVal = getTurnPointData(kTurnCacheTerrain, F_GET_TERRAIN_TYPE, x, y);
 	return retVal;
 }
 
@@ -2452,33 +2501,33 @@ int AI::getHubY(int hub) {
 }
 
 int AI::getMaxX() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_WORLD_X_SIZE);
+	int retVal = getTurnScummData(D_GET_WORLD_X_SIZE);
 	return retVal;
 }
 
 int AI::getMaxY() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_WORLD_Y_SIZE);
+	int retVal = getTurnScummData(D_GET_WORLD_Y_SIZE);
 	return retVal;
 }
 
 int AI::getCurrentPlayer() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_CURRENT_PLAYER);
+	int retVal = getTurnScummData(D_GET_CURRENT_PLAYER);
 	assert(retVal != 0);
 	return retVal;
 }
 
 int AI::getMaxPower() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_MAX_POWER);
+	int retVal = getTurnScummData(D_GET_MAX_POWER);
 	return retVal;
 }
 
 int AI::getMinPower() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_MIN_POWER);
+	int retVal = getTurnScummData(D_GET_MIN_POWER);
 	return retVal;
 }
 
 int AI::getTerrainSquareSize() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_TERRAIN_SQUARE_SIZE);
+	int retVal = getTurnScummData(D_GET_TERRAIN_SQUARE_SIZE);
 	return retVal;
 }
 
@@ -2560,37 +2609,37 @@ int AI::getPlayerMaxTime() {
 }
 
 int AI::getWindXSpeed() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_WIND_X_SPEED);
+	int retVal = getTurnScummData(D_GET_WIND_X_SPEED);
 	return retVal;
 }
 
 int AI::getWindYSpeed() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_WIND_Y_SPEED);
+	int retVal = getTurnScummData(D_GET_WIND_Y_SPEED);
 	return retVal;
 }
 
 int AI::getTotalWindSpeed() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_TOTAL_WIND_SPEED);
+	int retVal = getTurnScummData(D_GET_TOTAL_WIND_SPEED);
 	return retVal;
 }
 
 int AI::getWindXSpeedMax() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_WIND_X_SPEED_MAX);
+	int retVal = getTurnScummData(D_GET_WIND_X_SPEED_MAX);
 	return retVal;
 }
 
 int AI::getWindYSpeedMax() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_WIND_Y_SPEED_MAX);
+	int retVal = getTurnScummData(D_GET_WIND_Y_SPEED_MAX);
 	return retVal;
 }
 
 int AI::getBigXSize() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_BIG_X_SIZE);
+	int retVal = getTurnScummData(D_GET_BIG_X_SIZE);
 	return retVal;
 }
 
 int AI::getBigYSize() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_BIG_Y_SIZE);
+	int retVal = getTurnScummData(D_GET_BIG_Y_SIZE);
 	return retVal;
 }
 
@@ -2634,12 +2683,12 @@ int AI::getBuildingTeam(int building) {
 }
 
 int AI::getFOW() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_FOW);
+	int retVal = getTurnScummData(D_GET_FOW);
 	return retVal;
 }
 
 int AI::getAnimSpeed() {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_SCUMM_DATA], 1, D_GET_ANIM_SPEED);
+	int retVal = getTurnScummData(D_GET_ANIM_SPEED);
 	return retVal;
 }
 
@@ -2654,7 +2703,7 @@ int AI::getTurnCounter() {
 }
 
 int AI::getGroundAltitude(int x, int y) {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_GET_GROUND_ALTITUDE], 2, x, y);
+	int retVal = getTurnPointData(kTurnCacheGroundAltitude, F_GET_GROUND_ALTITUDE, x, y);
 	return retVal;
 }
 
@@ -2699,7 +2748,7 @@ int AI::getPowerAngleFromPoint(int originX, int originY, int endX, int endY, int
 }
 
 int AI::checkIfWaterState(int x, int y) {
-	int retVal = _vm->_moonbase->callScummFunction(_mcpParams[F_CHECK_IF_WATER_STATE], 2, x, y);
+	int retVal = getTurnPointData(kTurnCacheWaterState, F_CHECK_IF_WATER_STATE, x, y);
 	return retVal;
 }
 
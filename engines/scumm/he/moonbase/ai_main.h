@@ -24,6 +24,7 @@
 #define SCUMM_HE_MOONBASE_AI_MAIN_H
 
 #include "common/array.h"
+#include "common/hashmap.h"
 #include "scumm/he/moonbase/ai_tree.h"
 
 namespace Scumm {
@@ -189,6 +190,29 @@ private:
 	int energyPoolSize(int pool);
 	int getMaxCollectors(int pool);
 
+	/**
+	 * The map and the rules do not change while the AI plans a turn, so the
+	 * script answers the searches and launch simulations ask for over and
+	 * over are kept from the start of the turn until its launch.
+	 */
+	enum TurnCacheType {
+		kTurnCacheScummData,
+		kTurnCacheTerrain,
+		kTurnCacheGroundAltitude,
+		kTurnCacheWaterState,
+		kTurnCacheTypes
+	};
+
+	typedef Common::HashMap<uint32, int> TurnCache;
+
+	void beginTurnCache();
+	void endTurnCache();
+	int getTurnScummData(int dataType);
+	int getTurnPointData(TurnCacheType type, int function, int x, int y);
+
+	TurnCache _turnCache[kTurnCacheTypes];
+	bool _turnCacheEnabled;
+
 public:
 	Common::Array<int> _lastXCoord[5];
 	Common::Array<int> _lastYCoord[5];
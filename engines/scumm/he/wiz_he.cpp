@@ -736,6 +736,14 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 		dstInc = -2;
 	}
 
+	// Unflipped literal runs can be copied as they are when the destination
+	// is little endian, like the image data
+#ifdef SCUMM_LITTLE_ENDIAN
+	const bool runCopy = (type == kWizCopy && dstInc == 2);
+#else
+	const bool runCopy = (type == kWizCopy && dstInc == 2 && (dstType == kDstMemory || dstType == kDstResource));
+#endif
+
 	while (h--) {
 		xoff = srcRect.left;
 		w = srcRect.width();
@@ -791,10 +799,16 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
+					if (runCopy) {
+						memcpy(dstPtr, dataPtr, code * 2);
+						dataPtr += code * 2;
+						dstPtr += code * 2;
+					} else {
+						while (code--) {
+							write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
+							dataPtr += 2;
+							dstPtr += dstInc;
+						}
 					}
 				}
 			}
@@ -870,6 +884,9 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 		dstInc = -bitDepth;
 	}
 
+	// Unflipped 8-bit runs need no per-pixel writes, unless they are shadows
+	const bool runCopy = (bitDepth == 1 && dstInc == 1 && type != kWizXMap);
+
 	while (h--) {
 		xoff = srcRect.left;
 		w = srcRect.width();
@@ -905,9 +922,14 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dstPtr += dstInc;
+					if (runCopy) {
+						memset(dstPtr, (type == kWizRMap) ? palPtr[*dataPtr] : *dataPtr, code);
+						dstPtr += code;
+					} else {
+						while (code--) {
+							write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+							dstPtr += dstInc;
+						}
 					}
 					dataPtr++;
 				} else {
@@ -925,10 +947,21 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dataPtr++;
-						dstPtr += dstInc;
+					if (runCopy && type == kWizCopy) {
+						memcpy(dstPtr, dataPtr, code);
+						dataPtr += code;
+						dstPtr += code;
+					} else if (runCopy) {
+						for (int i = 0; i < code; i++)
+							dstPtr[i] = palPtr[dataPtr[i]];
+						dataPtr += code;
+						dstPtr += code;
+					} else {
+						while (code--) {
+							write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+							dataPtr++;
+							dstPtr += dstInc;
+						}
 					}
 				}
 			}
@@ -952,6 +985,14 @@ void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uin
 	if (w <= 0 || h <= 0) {
 		return;
 	}
+	if (type == kWizCopy && bitDepth == 1 && transColor == -1) {
+		while (h--) {
+			memcpy(dst, src, w);
+			src += srcPitch;
+			dst += dstPitch;
+		}
+		return;
+	}
 	while (h--) {
 		for (int i = 0; i < w; ++i) {
 			uint8 col = src[i];
@@ -22,6 +22,7 @@
 
 
 #include "common/scummsys.h"
+#include "common/system.h"
 #include "scumm/scumm.h"
 #include "scumm/util.h"
 #include "scumm/file.h"
@@ -38,6 +39,12 @@ BundleDirCache::BundleDirCache() {
 		_budleDirCache[fileId].isCompressed = false;
 		_budleDirCache[fileId].indexTable = NULL;
 	}
+
+	for (int i = 0; i < kNumDecodedBlocks; i++) {
+		_decodedBlocks[i].slot = -1;
+		_decodedBlocks[i].lastUse = 0;
+	}
+	_decodedBlockUse = 0;
 }
 
 BundleDirCache::~BundleDirCache() {
@@ -63,6 +70,37 @@ bool BundleDirCache::isSndDataExtComp(int slot) {
 	return _budleDirCache[slot].isCompressed;
 }
 
+const byte *BundleDirCache::findDecodedBlock(int slot, int32 index, int block, int32 &size) {
+	for (int i = 0; i < kNumDecodedBlocks; i++) {
+		DecodedBlock &decodedBlock = _decodedBlocks[i];
+		if (decodedBlock.slot == slot && decodedBlock.index == index && decodedBlock.block == block) {
+			decodedBlock.lastUse = ++_decodedBlockUse;
+			size = decodedBlock.size;
+			return decodedBlock.data;
+		}
+	}
+
+	return NULL;
+}
+
+void BundleDirCache::addDecodedBlock(int slot, int32 index, int block, const byte *data, int32 size) {
+	assert(size <= (int32)sizeof(_decodedBlocks[0].data));
+
+	// Replace the block which was used longest ago
+	DecodedBlock *oldest = &_decodedBlocks[0];
+	for (int i = 1; i < kNumDecodedBlocks; i++) {
+		if (_decodedBlocks[i].lastUse < oldest->lastUse)
+			oldest = &_decodedBlocks[i];
+	}
+
+	oldest->slot = slot;
+	oldest->index = index;
+	oldest->block = block;
+	oldest->size = size;
+	oldest->lastUse = ++_decodedBlockUse;
+	memcpy(oldest->data, data, size);
+}
+
 int BundleDirCache::matchFile(const char *filename) {
 	int32 tag, offset;
 	bool found = false;
@@ -149,6 +187,10 @@ BundleMgr::BundleMgr(BundleDirCache *cache) {
 	_fileBundleId = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
+	_slot = -1;
+	_decodeAhead.index = -1;
+	_decodeAhead.block = -1;
+	_decodeAhead.input = NULL;
 }
 
 BundleMgr::~BundleMgr() {
@@ -184,13 +226,13 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 		return false;
 	}
 
-	int slot = _cache->matchFile(filename);
-	assert(slot != -1);
-	compressed = _cache->isSndDataExtComp(slot);
-	_numFiles = _cache->getNumFiles(slot);
+	_slot = _cache->matchFile(filename);
+	assert(_slot != -1);
+	compressed = _cache->isSndDataExtComp(_slot);
+	_numFiles = _cache->getNumFiles(_slot);
 	assert(_numFiles);
-	_bundleTable = _cache->getTable(slot);
-	_indexTable = _cache->getIndexTable(slot);
+	_bundleTable = _cache->getTable(_slot);
+	_indexTable = _cache->getIndexTable(_slot);
 	assert(_bundleTable);
 	_compTableLoaded = false;
 	_outputSize = 0;
@@ -201,6 +243,9 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 void BundleMgr::close() {
 	if (_file->isOpen()) {
+		cancelDecodeAhead();
+		free(_decodeAhead.input);
+		_decodeAhead.input = NULL;
 		_file->close();
 		_bundleTable = NULL;
 		_numFiles = 0;
@@ -242,6 +287,8 @@ bool BundleMgr::loadCompTable(int32 index) {
 	// CMI hack: one more byte at the end of input buffer
 	_compInputBuff = (byte *)malloc(maxSize + 1);
 	assert(_compInputBuff);
+	_decodeAhead.input = (byte *)malloc(maxSize + 1);
+	assert(_decodeAhead.input);
 
 	return true;
 }
@@ -288,13 +335,16 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 	for (i = firstBlock; i <= lastBlock; i++) {
 		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
+			if (!getDecodedBlock(index, i)) {
+				// CMI hack: one more zero byte at the end of input buffer
+				_compInputBuff[_compTable[i].size] = 0;
+				_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
+				_file->read(_compInputBuff, _compTable[i].size);
+				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+				if (_outputSize > 0x2000) {
+					error("_outputSize: %d", _outputSize);
+				}
+				_cache->addDecodedBlock(_slot, index, i, _compOutputBuff, _outputSize);
 			}
 			_lastBlock = i;
 		}
@@ -327,9 +377,87 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 		skip = 0;
 	}
 
+	startDecodeAhead(index, _lastBlock + 1);
+
 	return finalSize;
 }
 
+bool BundleMgr::getDecodedBlock(int32 index, int block) {
+	if (_decodeAhead.block == block && _decodeAhead.index == index) {
+		_decodeAhead.future.wait();
+		_decodeAhead.future = Common::TaskFuture();
+		_decodeAhead.block = -1;
+
+		_outputSize = _decodeAhead.outputSize;
+		if (_outputSize > 0x2000) {
+			error("_outputSize: %d", _outputSize);
+		}
+		memcpy(_compOutputBuff, _decodeAhead.output, _outputSize);
+		_cache->addDecodedBlock(_slot, index, block, _compOutputBuff, _outputSize);
+		return true;
+	}
+
+	int32 size;
+	const byte *data = _cache->findDecodedBlock(_slot, index, block, size);
+	if (data) {
+		_outputSize = size;
+		memcpy(_compOutputBuff, data, size);
+		return true;
+	}
+
+	return false;
+}
+
+class BundleMgr::DecodeAheadTask : public Common::Task {
+public:
+	DecodeAheadTask(BundleMgr &bundle) : _bundle(bundle) {}
+
+	virtual void run() {
+		_bundle.decodeAhead();
+	}
+
+private:
+	BundleMgr &_bundle;
+};
+
+void BundleMgr::startDecodeAhead(int32 index, int block) {
+	if (block >= _numCompItems || (_decodeAhead.block == block && _decodeAhead.index == index))
+		return;
+
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (scheduler->isSerial())
+		return;
+
+	int32 size;
+	if (_cache->findDecodedBlock(_slot, index, block, size))
+		return;
+
+	cancelDecodeAhead();
+
+	// CMI hack: one more zero byte at the end of input buffer
+	_decodeAhead.input[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	if (_file->read(_decodeAhead.input, _compTable[block].size) != (uint32)_compTable[block].size)
+		return;
+
+	_decodeAhead.index = index;
+	_decodeAhead.block = block;
+	_decodeAhead.future = scheduler->schedule(new DecodeAheadTask(*this));
+}
+
+void BundleMgr::decodeAhead() {
+	const CompTable &compTable = _compTable[_decodeAhead.block];
+	_decodeAhead.outputSize = BundleCodecs::decompressCodec(compTable.codec, _decodeAhead.input, _decodeAhead.output, compTable.size);
+}
+
+void BundleMgr::cancelDecodeAhead() {
+	if (_decodeAhead.future.isValid()) {
+		_decodeAhead.future.wait();
+		_decodeAhead.future = Common::TaskFuture();
+	}
+	_decodeAhead.block = -1;
+}
+
 int32 BundleMgr::decompressSampleByName(const char *name, int32 offset, int32 size, byte **comp_final, bool header_outside) {
 	int32 final_size = 0;
 
@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/taskscheduler.h"
 
 namespace Scumm {
 
@@ -53,6 +54,27 @@ private:
 		IndexNode *indexTable;
 	} _budleDirCache[4];
 
+	/**
+	 * Recently decoded blocks of compressed sounds. They are shared by all
+	 * bundle managers, so a sound which is opened again, like a music track
+	 * crossfading into another of its regions, does not decode them again.
+	 */
+	struct DecodedBlock {
+		int slot;
+		int32 index;
+		int block;
+		int32 size;
+		uint32 lastUse;
+		byte data[0x2000];
+	};
+
+	enum {
+		kNumDecodedBlocks = 16
+	};
+
+	DecodedBlock _decodedBlocks[kNumDecodedBlocks];
+	uint32 _decodedBlockUse;
+
 public:
 	BundleDirCache();
 	~BundleDirCache();
@@ -62,6 +84,9 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	const byte *findDecodedBlock(int slot, int32 index, int block, int32 &size);
+	void addDecodedBlock(int slot, int32 index, int block, const byte *data, int32 size);
 };
 
 class BundleMgr {
@@ -89,8 +114,27 @@ private:
 	byte *_compInputBuff;
 	int _outputSize;
 	int _lastBlock;
+	int _slot;
+
+	/**
+	 * The block after the last one asked for is read and then decoded by a
+	 * task while the sound plays on.
+	 */
+	class DecodeAheadTask;
+	struct DecodeAhead {
+		int32 index;
+		int block;
+		byte *input;
+		byte output[0x2000];
+		int32 outputSize;
+		Common::TaskFuture future;
+	} _decodeAhead;
 
 	bool loadCompTable(int32 index);
+	bool getDecodedBlock(int32 index, int block);
+	void startDecodeAhead(int32 index, int block);
+	void decodeAhead();
+	void cancelDecodeAhead();
 
 public:
 
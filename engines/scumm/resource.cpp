@@ -830,6 +830,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
+	_memoryUsage.set(_allocatedSize);
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
@@ -867,7 +868,7 @@ ResourceManager::ResTypeData::ResTypeData() {
 ResourceManager::ResTypeData::~ResTypeData() {
 }
 
-ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
+ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm), _memoryUsage(Common::kMemoryResources) {
 	_allocatedSize = 0;
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
@@ -898,6 +899,7 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		_memoryUsage.set(_allocatedSize);
 		_types[type][idx].nuke();
 	}
 }
@@ -1032,8 +1034,27 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+int ResourceManager::getReloadCost(ResType type) const {
+	// HE images, rooms and sounds are large and partly compressed, so they
+	// take longer to load again than the raw script data of older games
+	if (_vm->_game.heversion >= 70) {
+		switch (type) {
+		case rtRoom:
+		case rtRoomImage:
+		case rtImage:
+		case rtCostume:
+			return 4;
+		case rtSound:
+			return 2;
+		default:
+			break;
+		}
+	}
+	return 1;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
+	uint64 best_score;
 	ResType best_type;
 	int best_res = 0;
 	uint32 oldAllocatedSize;
@@ -1050,7 +1071,7 @@ void ResourceManager::expireResources(uint32 size) {
 
 	do {
 		best_type = rtInvalid;
-		best_counter = 2;
+		best_score = 0;
 
 		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 			if (_types[type]._mode != kDynamicResTypeMode) {
@@ -1060,8 +1081,14 @@ void ResourceManager::expireResources(uint32 size) {
 				while (idx-- > 0) {
 					Resource &tmp = _types[type][idx];
 					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
+					if (counter < 2 || tmp.isLocked() || !tmp._address || _vm->isResourceInUse(type, idx) || tmp.isOffHeap())
+						continue;
+
+					// Old resources go first, and of those the ones which
+					// free the most memory for the time it takes to reload them
+					const uint64 score = (uint64)counter * (tmp._size + kExpireSizeBias) / getReloadCost(type);
+					if (score >= best_score) {
+						best_score = score;
 						best_type = type;
 						best_res = idx;
 					}
@@ -1342,6 +1369,7 @@ void ScummEngine::allocateArrays() {
 	_objs = (ObjectData *)calloc(_numLocalObjects, sizeof(ObjectData));
 	_roomVars = (int32 *)calloc(_numRoomVariables, sizeof(int32));
 	_scummVars = (int32 *)calloc(_numVariables, sizeof(int32));
+	_system->setMemoryRegion(OSystem::kMemoryRegionGameVariables, _scummVars, _numVariables * sizeof(int32));
 	_bitVars = (byte *)calloc(_numBitVariables >> 3, 1);
 	if (_game.heversion >= 60) {
 		_arraySlot = (byte *)calloc(_numArray, 1);
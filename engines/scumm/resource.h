@@ -24,6 +24,7 @@
 #define SCUMM_RESOURCE_H
 
 #include "common/array.h"
+#include "common/memtracker.h"
 #include "scumm/scumm.h"	// for ResType
 
 namespace Scumm {
@@ -100,7 +101,8 @@ public:
 		 * as high as 127. When memory falls low resp. when the engine decides
 		 * that it should throw out some unused stuff, then it begins by
 		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
+		 * resources and resources that are known to be in use). The counter
+		 * is weighed by the size of the resource and its reload cost.
 		 */
 		byte _flags;
 
@@ -173,6 +175,7 @@ public:
 
 protected:
 	uint32 _allocatedSize;
+	Common::MemoryUsage _memoryUsage; ///< _allocatedSize, for the MemoryTracker
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
@@ -228,6 +231,14 @@ public:
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
+	enum {
+		/** Added to the size of resources weighed for expiry, so that age counts for small ones */
+		kExpireSizeBias = 16 * 1024
+	};
+
+	/** How expensive it is to load a resource of the given type again, relative to raw data */
+	int getReloadCost(ResType type) const;
+
 	void expireResources(uint32 size);
 };
 
@@ -107,6 +107,22 @@ Common::Error ScummEngine::saveGameState(int slot, const Common::String &desc) {
 	return Common::kNoError;
 }
 
+Common::Error ScummEngine::saveGameStream(Common::WriteStream *stream) {
+	// Unlike saveGameState() this saves right away, so it must only be
+	// called from outside of the script loop (e.g. from the event polling).
+	if (!saveState(stream))
+		return Common::kWritingFailed;
+	return Common::kNoError;
+}
+
+Common::Error ScummEngine::loadGameStream(Common::SeekableReadStream *stream) {
+	if (!loadState(stream, false, "stream"))
+		return Common::kReadingFailed;
+
+	clearClickedStatus();
+	return Common::kNoError;
+}
+
 bool ScummEngine::canSaveGameStateCurrently() {
 	// Disallow saving in v0-v3 games when a 'prequel' to a cutscene is shown.
 	// This is a blank screen with text, and while this is shown, saving should
@@ -157,8 +173,31 @@ Common::SeekableReadStream *ScummEngine::openSaveFileForReading(int slot, bool c
 	return _saveFileMan->openForLoading(fileName);
 }
 
+/**
+ * Warns about an autosave which could not be written in the background.
+ * It does not refer to the engine, since it can run after it is gone.
+ */
+class AutosaveCallback : public Common::Functor1<bool, void> {
+public:
+	AutosaveCallback(const Common::String &fileName) : _fileName(fileName) {}
+
+	virtual bool isValid() const { return true; }
+
+	virtual void operator()(bool success) const {
+		if (!success)
+			warning("Could not write autosave '%s'", _fileName.c_str());
+	}
+
+private:
+	Common::String _fileName;
+};
+
 Common::WriteStream *ScummEngine::openSaveFileForWriting(int slot, bool compat, Common::String &fileName) {
 	fileName = makeSavegameName(slot, compat);
+	// Slot 0 is the autosave, which is written in the background so it
+	// does not stall the game on slow storage
+	if (slot == 0 && !compat)
+		return _saveFileMan->openForSavingAsync(fileName, true, new AutosaveCallback(fileName));
 	return _saveFileMan->openForSaving(fileName);
 }
 
@@ -320,16 +359,21 @@ bool ScummEngine::loadState(int slot, bool compat) {
 }
 
 bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
-	SaveGameHeader hdr;
-	int sb, sh;
-
 	Common::SeekableReadStream *in = openSaveFileForReading(slot, compat, filename);
 	if (!in)
 		return false;
 
+	bool success = loadState(in, compat, filename);
+	delete in;
+	return success;
+}
+
+bool ScummEngine::loadState(Common::SeekableReadStream *in, bool compat, const Common::String &filename) {
+	SaveGameHeader hdr;
+	int sb, sh;
+
 	if (!loadSaveGameHeader(in, hdr)) {
 		warning("Invalid savegame '%s'", filename.c_str());
-		delete in;
 		return false;
 	}
 
@@ -345,14 +389,12 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 	// information).
 	if (hdr.ver < VER(7) || hdr.ver > CURRENT_VER) {
 		warning("Invalid version of '%s'", filename.c_str());
-		delete in;
 		return false;
 	}
 
 	// We (deliberately) broke HE savegame compatibility at some point.
 	if (hdr.ver < VER(50) && _game.heversion >= 71) {
 		warning("Unsupported version of '%s'", filename.c_str());
-		delete in;
 		return false;
 	}
 
@@ -362,7 +404,6 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 		if (hdr.ver <= VER(74)) {
 			if (!Graphics::checkThumbnailHeader(*in)) {
 				warning("Can not load thumbnail");
-				delete in;
 				return false;
 			}
 		}
@@ -376,7 +417,6 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 		SaveStateMetaInfos infos;
 		if (!loadInfos(in, &infos)) {
 			warning("Info section could not be found");
-			delete in;
 			return false;
 		}
 
@@ -447,7 +487,6 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 	Common::Serializer ser(in, 0);
 	ser.setVersion(hdr.ver);
 	saveLoadWithSerializer(ser);
-	delete in;
 
 	// Update volume settings
 	syncSoundSettings();
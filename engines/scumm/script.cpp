@@ -21,6 +21,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -471,11 +472,12 @@ void ScummEngine::executeScript() {
 		_opcode = fetchScriptByte();
 		if (_game.version > 2) // V0-V2 games didn't use the didexec flag
 			vm.slot[_currentScript].didexec = true;
-		debugC(DEBUG_OPCODES, "Script %d, offset 0x%x: [%X] %s()",
-				vm.slot[_currentScript].number,
-				(uint)(_scriptPointer - _scriptOrgPointer),
-				_opcode,
-				getOpcodeDesc(_opcode));
+		if (debugCEnabled(DEBUG_OPCODES))
+			debugC(DEBUG_OPCODES, "Script %d, offset 0x%x: [%X] %s()",
+					vm.slot[_currentScript].number,
+					(uint)(_scriptPointer - _scriptOrgPointer),
+					_opcode,
+					getOpcodeDesc(_opcode));
 		if (_hexdumpScripts == true) {
 			for (c = -1; c < 15; c++) {
 				debugN(" %02x", *(_scriptPointer + c));
@@ -489,6 +491,13 @@ void ScummEngine::executeScript() {
 }
 
 void ScummEngine::executeOpcode(byte i) {
+#ifdef ENABLE_PROFILER
+	if (_scriptProfileEnabled || (Common::Profiler::hasInstance() && Common::Profiler::instance().isRecording())) {
+		executeOpcodeProfiled(i);
+		return;
+	}
+#endif
+
 	if (_opcodes[i].proc && _opcodes[i].proc->isValid())
 		(*_opcodes[i].proc)();
 	else {
@@ -496,6 +505,36 @@ void ScummEngine::executeOpcode(byte i) {
 	}
 }
 
+#ifdef ENABLE_PROFILER
+void ScummEngine::executeOpcodeProfiled(byte i) {
+	if (!_opcodes[i].proc || !_opcodes[i].proc->isValid())
+		error("Invalid opcode '%x' at %lx", i, (long)(_scriptPointer - _scriptOrgPointer));
+
+	// The opcode may stop or switch the current script, so take its
+	// number first
+	const uint32 key = ((uint32)vm.slot[_currentScript].number << 8) | i;
+	const uint64 outerNestedTime = _scriptProfileNestedTime;
+	_scriptProfileNestedTime = 0;
+
+	const uint64 start = Common::Profiler::now();
+	(*_opcodes[i].proc)();
+	const uint64 end = Common::Profiler::now();
+
+	if (_scriptProfileEnabled) {
+		ScriptOpcodeProfile &profile = _scriptProfile[key];
+		profile.calls++;
+		profile.totalTime += end - start;
+		profile.selfTime += end - start - MIN(_scriptProfileNestedTime, end - start);
+	}
+	_scriptProfileNestedTime = outerNestedTime + (end - start);
+
+	// The opcode descriptions are string literals, so they outlive the
+	// recorded zones as the profiler requires
+	if (Common::Profiler::hasInstance() && Common::Profiler::instance().isRecording())
+		Common::Profiler::instance().addZone(getOpcodeDesc(i), start, end);
+}
+#endif
+
 const char *ScummEngine::getOpcodeDesc(byte i) {
 #ifndef REDUCE_MEMORY_USAGE
 	return _opcodes[i].desc;
@@ -534,7 +573,8 @@ int ScummEngine::fetchScriptDWordSigned() {
 int ScummEngine::readVar(uint var) {
 	int a;
 
-	debugC(DEBUG_VARS, "readvar(%d)", var);
+	if (debugCEnabled(DEBUG_VARS))
+		debugC(DEBUG_VARS, "readvar(%d)", var);
 
 	if ((var & 0x2000) && (_game.version <= 5)) {
 		a = fetchScriptWord();
@@ -615,7 +655,8 @@ int ScummEngine::readVar(uint var) {
 }
 
 void ScummEngine::writeVar(uint var, int value) {
-	debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
+	if (debugCEnabled(DEBUG_VARS))
+		debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
 
 	if (!(var & 0xF000)) {
 		assertRange(0, var, _numVariables - 1, "variable (writing)");
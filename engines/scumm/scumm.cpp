@@ -225,6 +225,10 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_scriptPointer = NULL;
 	_scriptOrgPointer = NULL;
 	_opcode = 0;
+#ifdef ENABLE_PROFILER
+	_scriptProfileEnabled = false;
+	_scriptProfileNestedTime = 0;
+#endif
 	vm.numNestedScripts = 0;
 	_lastCodePtr = NULL;
 	_scummStackPos = 0;
@@ -641,6 +645,7 @@ ScummEngine::~ScummEngine() {
 	free(_verbs);
 	free(_objs);
 	free(_roomVars);
+	_system->setMemoryRegion(OSystem::kMemoryRegionGameVariables, nullptr, 0);
 	free(_scummVars);
 	free(_bitVars);
 	free(_newNames);
@@ -1431,7 +1436,17 @@ void ScummEngine::setupScumm() {
 		maxHeapThreshold = 550000;
 	}
 
-	_res->setHeapThreshold(400000, maxHeapThreshold);
+	int minHeapThreshold = 400000;
+
+	// Devices with more memory can keep more resources around, which saves
+	// reloading them on room changes
+	const uint64 physicalMemory = _system->getPhysicalMemorySize();
+	if (physicalMemory) {
+		maxHeapThreshold = MAX<uint64>(maxHeapThreshold, MIN<uint64>(physicalMemory / 64, 8 * (uint64)maxHeapThreshold));
+		minHeapThreshold = maxHeapThreshold / 4 * 3;
+	}
+
+	_res->setHeapThreshold(minHeapThreshold, maxHeapThreshold);
 
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
@@ -28,6 +28,7 @@
 #include "common/endian.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/hashmap.h"
 #include "common/savefile.h"
 #include "common/keyboard.h"
 #include "common/random.h"
@@ -162,6 +163,16 @@ enum GameFeatures {
 /* SCUMM Debug Channels */
 void debugC(int level, const char *s, ...) GCC_PRINTF(2, 3);
 
+/**
+ * Whether Scumm::debugC() shows output for the channel. Cheap enough to
+ * guard debug output in the script loop with.
+ */
+inline bool debugCEnabled(int channel) {
+	// FIXME: Still spew all debug at -d9, for crashes in startup etc.
+	// Like debugC(), this ignores DEBUG_LEVEL_MAX.
+	return (gDebugChannelsEnabled & channel) != 0 || gDebugLevel >= 9;
+}
+
 enum {
 	DEBUG_GENERAL	=	1 << 0,		// General debug
 	DEBUG_SCRIPTS	=	1 << 2,		// Track script execution (start/stop/pause)
@@ -437,6 +448,8 @@ public:
 	virtual bool canLoadGameStateCurrently();
 	virtual Common::Error saveGameState(int slot, const Common::String &desc);
 	virtual bool canSaveGameStateCurrently();
+	virtual Common::Error saveGameStream(Common::WriteStream *stream);
+	virtual Common::Error loadGameStream(Common::SeekableReadStream *stream);
 
 	virtual void pauseEngineIntern(bool pause);
 
@@ -608,6 +621,7 @@ protected:
 	bool saveState(int slot, bool compat, Common::String &fileName);
 	bool loadState(int slot, bool compat);
 	bool loadState(int slot, bool compat, Common::String &fileName);
+	bool loadState(Common::SeekableReadStream *in, bool compat, const Common::String &fileName);
 	virtual void saveLoadWithSerializer(Common::Serializer &s);
 	void saveResource(Common::Serializer &ser, ResType type, ResId idx);
 	void loadResource(Common::Serializer &ser, ResType type, ResId idx);
@@ -658,6 +672,28 @@ protected:
 	void executeOpcode(byte i);
 	const char *getOpcodeDesc(byte i);
 
+#ifdef ENABLE_PROFILER
+	/** Time spent in one opcode of one script, in microseconds. */
+	struct ScriptOpcodeProfile {
+		uint32 calls;
+		uint64 totalTime; ///< Including the scripts run nested by the opcode
+		uint64 selfTime;  ///< Without the nested scripts
+
+		ScriptOpcodeProfile() : calls(0), totalTime(0), selfTime(0) {}
+	};
+
+	/** Keyed by script number << 8 | opcode. */
+	typedef Common::HashMap<uint32, ScriptOpcodeProfile> ScriptProfileMap;
+
+	/** Set by the debug console command "scriptprofile". */
+	bool _scriptProfileEnabled;
+	ScriptProfileMap _scriptProfile;
+	/** The time spent by the opcodes nested in the one being profiled. */
+	uint64 _scriptProfileNestedTime;
+
+	void executeOpcodeProfiled(byte i);
+#endif
+
 	void initializeLocals(int slot, int *vars);
 	int	getScriptSlot();
 
@@ -325,6 +325,20 @@ void Codec37Decoder::maketable(int pitch, int index) {
 		dst += 4;						  \
 	} while (0)
 
+/*
+ * Copy a run of 4x4 pixel blocks on one block row, from the same place in
+ * the other buffer. The blocks are copied together, a pixel row at a time.
+ */
+
+#define COPY_4X4_RUN(dst2, dst, pitch, count)				\
+	do {								\
+		int x;							\
+		for (x=0; x<4; x++) {					\
+			memcpy(dst + pitch * x, dst2 + pitch * x, 4 * (count)); \
+		}							\
+		dst += 4 * (count);					\
+	} while (0)
+
 void Codec37Decoder::proc1(byte *dst, const byte *src, int32 next_offs, int bw, int bh, int pitch, int16 *offset_table) {
 	uint8 code;
 	bool filling, skipCode;
@@ -439,10 +453,12 @@ void Codec37Decoder::proc4WithFDFE(byte *dst, const byte *src, int32 next_offs,
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
+				while (length > 0) {
+					const int32 count = MIN<int32>(length, i);
 					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
+					COPY_4X4_RUN(dst2, dst, pitch, count);
+					length -= count;
+					i -= count;
 					if (i == 0) {
 						dst += pitch * 3;
 						bh--;
@@ -471,10 +487,12 @@ void Codec37Decoder::proc4WithoutFDFE(byte *dst, const byte *src, int32 next_off
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
+				while (length > 0) {
+					const int32 count = MIN<int32>(length, i);
 					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
+					COPY_4X4_RUN(dst2, dst, pitch, count);
+					length -= count;
+					i -= count;
 					if (i == 0) {
 						dst += pitch * 3;
 						bh--;
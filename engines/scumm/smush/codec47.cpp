@@ -27,6 +27,16 @@
 #include "scumm/bomp.h"
 #include "scumm/smush/codec47.h"
 
+#ifndef USE_ARM_SMUSH_ASM
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMUSH_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SMUSH_USE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 namespace Scumm {
 
 #if defined(SCUMM_NEED_ALIGNMENT)
@@ -262,6 +272,17 @@ void Codec47Decoder::makeTablesInterpolation(int param) {
 				}
 			}
 
+			// Every pixel of a glyph gets one of its two colors
+			if (param == 8) {
+				for (i = 0; i < 64; i++) {
+					_glyphMaskBig[s / 388 * 64 + i] = tableSmallBig[i] != 0 ? 0xFF : 0;
+				}
+			} else {
+				for (i = 0; i < 16; i++) {
+					_glyphMaskSmall[s / 128 * 16 + i] = tableSmallBig[i] != 0 ? 0xFF : 0;
+				}
+			}
+
 			if (param == 8) {
 				for (i = 64 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
@@ -360,6 +381,78 @@ extern "C" void ARM_Smush_decode2(      byte  *dst,
                    _offset1,_offset2,_tableSmall)
 
 #else
+
+#if defined(SMUSH_USE_SSE2) || defined(SMUSH_USE_NEON)
+
+// The 8x8 blocks are copied and filled a row at a time, and glyphs are
+// filled by selecting between their two colors with a mask instead of
+// storing each pixel through the offset tables. Every pixel of a glyph is
+// in one of its two offset lists, so the result is the same.
+
+#ifdef SMUSH_USE_SSE2
+static inline void copy8x8(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 8; i++, dst += pitch, src += pitch)
+		_mm_storel_epi64((__m128i *)dst, _mm_loadl_epi64((const __m128i *)src));
+}
+
+static inline void fill8x8(byte *dst, byte val, int pitch) {
+	const __m128i v = _mm_set1_epi8((char)val);
+	for (int i = 0; i < 8; i++, dst += pitch)
+		_mm_storel_epi64((__m128i *)dst, v);
+}
+
+static inline void glyph8x8(byte *dst, const byte *mask, byte val1, byte val2, int pitch) {
+	const __m128i v1 = _mm_set1_epi8((char)val1);
+	const __m128i v2 = _mm_set1_epi8((char)val2);
+	for (int i = 0; i < 8; i += 2, mask += 16) {
+		const __m128i m = _mm_loadu_si128((const __m128i *)mask);
+		const __m128i rows = _mm_or_si128(_mm_and_si128(m, v1), _mm_andnot_si128(m, v2));
+		_mm_storel_epi64((__m128i *)dst, rows);
+		dst += pitch;
+		_mm_storel_epi64((__m128i *)dst, _mm_srli_si128(rows, 8));
+		dst += pitch;
+	}
+}
+
+static inline void glyph4x4(byte *dst, const byte *mask, byte val1, byte val2, int pitch) {
+	const __m128i m = _mm_loadu_si128((const __m128i *)mask);
+	const __m128i v1 = _mm_set1_epi8((char)val1);
+	const __m128i v2 = _mm_set1_epi8((char)val2);
+	byte rows[16];
+	_mm_storeu_si128((__m128i *)rows, _mm_or_si128(_mm_and_si128(m, v1), _mm_andnot_si128(m, v2)));
+	for (int i = 0; i < 4; i++, dst += pitch)
+		memcpy(dst, rows + i * 4, 4);
+}
+#else
+static inline void copy8x8(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 8; i++, dst += pitch, src += pitch)
+		vst1_u8(dst, vld1_u8(src));
+}
+
+static inline void fill8x8(byte *dst, byte val, int pitch) {
+	const uint8x8_t v = vdup_n_u8(val);
+	for (int i = 0; i < 8; i++, dst += pitch)
+		vst1_u8(dst, v);
+}
+
+static inline void glyph8x8(byte *dst, const byte *mask, byte val1, byte val2, int pitch) {
+	const uint8x8_t v1 = vdup_n_u8(val1);
+	const uint8x8_t v2 = vdup_n_u8(val2);
+	for (int i = 0; i < 8; i++, dst += pitch, mask += 8)
+		vst1_u8(dst, vbsl_u8(vld1_u8(mask), v1, v2));
+}
+
+static inline void glyph4x4(byte *dst, const byte *mask, byte val1, byte val2, int pitch) {
+	byte rows[16];
+	vst1q_u8(rows, vbslq_u8(vld1q_u8(mask), vdupq_n_u8(val1), vdupq_n_u8(val2)));
+	for (int i = 0; i < 4; i++, dst += pitch)
+		memcpy(dst, rows + i * 4, 4);
+}
+#endif
+
+#define SMUSH_USE_SIMD
+#endif
+
 void Codec47Decoder::level3(byte *d_dst) {
 	int32 tmp;
 	byte code = *_d_src++;
@@ -413,6 +506,12 @@ void Codec47Decoder::level2(byte *d_dst) {
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
+#ifdef SMUSH_USE_SIMD
+		const byte *mask = _glyphMaskSmall + *_d_src++ * 16;
+		const byte val1 = *_d_src++;
+		const byte val2 = *_d_src++;
+		glyph4x4(d_dst, mask, val1, val2, _d_pitch);
+#else
 		byte *tmp_ptr = _tableSmall + *_d_src++ * 128;
 		int32 l = tmp_ptr[96];
 		byte val = *_d_src++;
@@ -428,6 +527,7 @@ void Codec47Decoder::level2(byte *d_dst) {
 			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
 			tmp_ptr2++;
 		}
+#endif
 	} else if (code == 0xFC) {
 		tmp = _offset2;
 		for (i = 0; i < 4; i++) {
@@ -446,15 +546,21 @@ void Codec47Decoder::level2(byte *d_dst) {
 void Codec47Decoder::level1(byte *d_dst) {
 	int32 tmp, tmp2;
 	byte code = *_d_src++;
+#ifndef SMUSH_USE_SIMD
 	int i;
+#endif
 
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
+#ifdef SMUSH_USE_SIMD
+		copy8x8(d_dst, d_dst + tmp2, _d_pitch);
+#else
 		for (i = 0; i < 8; i++) {
 			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
 			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
 			d_dst += _d_pitch;
 		}
+#endif
 	} else if (code == 0xFF) {
 		level2(d_dst);
 		d_dst += 4;
@@ -465,13 +571,22 @@ void Codec47Decoder::level1(byte *d_dst) {
 		level2(d_dst);
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
+#ifdef SMUSH_USE_SIMD
+		fill8x8(d_dst, t, _d_pitch);
+#else
 		for (i = 0; i < 8; i++) {
 			FILL_4X1_LINE(d_dst, t);
 			FILL_4X1_LINE(d_dst + 4, t);
 			d_dst += _d_pitch;
 		}
+#endif
 	} else if (code == 0xFD) {
 		tmp = *_d_src++;
+#ifdef SMUSH_USE_SIMD
+		const byte val1 = *_d_src++;
+		const byte val2 = *_d_src++;
+		glyph8x8(d_dst, _glyphMaskBig + tmp * 64, val1, val2, _d_pitch);
+#else
 		byte *tmp_ptr = _tableBig + tmp * 388;
 		byte l = tmp_ptr[384];
 		byte val = *_d_src++;
@@ -487,20 +602,29 @@ void Codec47Decoder::level1(byte *d_dst) {
 			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
 			tmp_ptr2++;
 		}
+#endif
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
+#ifdef SMUSH_USE_SIMD
+		copy8x8(d_dst, d_dst + tmp2, _d_pitch);
+#else
 		for (i = 0; i < 8; i++) {
 			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
 			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
 			d_dst += _d_pitch;
 		}
+#endif
 	} else {
 		byte t = _paramPtr[code];
+#ifdef SMUSH_USE_SIMD
+		fill8x8(d_dst, t, _d_pitch);
+#else
 		for (i = 0; i < 8; i++) {
 			FILL_4X1_LINE(d_dst, t);
 			FILL_4X1_LINE(d_dst + 4, t);
 			d_dst += _d_pitch;
 		}
+#endif
 	}
 }
 
@@ -41,6 +41,9 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	// For each glyph, 0xFF for the pixels filled with its first color
+	byte _glyphMaskBig[256 * 64];
+	byte _glyphMaskSmall[256 * 16];
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
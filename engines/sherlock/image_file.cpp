@@ -53,7 +53,7 @@ ImageFile::ImageFile(Common::SeekableReadStream &stream, bool skipPal) {
 
 ImageFile::~ImageFile() {
 	for (uint idx = 0; idx < size(); ++idx)
-		(*this)[idx]._frame.free();
+		(*this)[idx].free();
 }
 
 void ImageFile::load(Common::SeekableReadStream &stream, bool skipPalette, bool animImages) {
@@ -190,6 +190,37 @@ void ImageFrame::decompressFrame(const byte *src, bool isRoseTattoo) {
 
 /*----------------------------------------------------------------*/
 
+ImageFrame::ImageFrame() : _size(0), _width(0), _height(0), _paletteBase(0), _rleEncoded(false),
+		_rleMarker(0), _scaledFrame(nullptr), _scaledVal(0), _scaledFlipped(false) {
+}
+
+void ImageFrame::free() {
+	_frame.free();
+
+	delete _scaledFrame;
+	_scaledFrame = nullptr;
+}
+
+const Graphics::Surface &ImageFrame::getScaledFrame(int scaleVal, bool flipped, uint transColor) const {
+	if (_scaledFrame && _scaledVal == scaleVal && _scaledFlipped == flipped)
+		return *_scaledFrame;
+
+	if (!_scaledFrame)
+		_scaledFrame = new Graphics::ManagedSurface();
+
+	// Scale the frame the same way as drawing it scaled would
+	const int width = _frame.w * SCALE_THRESHOLD / scaleVal;
+	const int height = _frame.h * SCALE_THRESHOLD / scaleVal;
+	_scaledFrame->create(width, height, _frame.format);
+	_scaledFrame->clear(transColor);
+	_scaledFrame->transBlitFrom(_frame, Common::Rect(0, 0, _frame.w, _frame.h),
+		Common::Rect(0, 0, width, height), transColor, flipped);
+
+	_scaledVal = scaleVal;
+	_scaledFlipped = flipped;
+	return *_scaledFrame;
+}
+
 int ImageFrame::sDrawXSize(int scaleVal) const {
 	int width = _width;
 	int scale = scaleVal == 0 ? 1 : scaleVal;
@@ -1042,7 +1073,7 @@ void StreamingImageFile::close() {
 	_stream = nullptr;
 	_frameNumber = -1;
 	_active = false;
-	_imageFrame._frame.free();
+	_imageFrame.free();
 }
 
 bool StreamingImageFile::getNextFrame() {
@@ -1075,7 +1106,7 @@ bool StreamingImageFile::getNextFrame() {
 	_imageFrame._rleMarker = frameStream->readByte();
 
 	// Free the previous frame
-	_imageFrame._frame.free();
+	_imageFrame.free();
 
 	// Decode the frame
 	if (_compressed) {
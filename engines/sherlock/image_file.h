@@ -32,6 +32,10 @@
 #include "common/stream.h"
 #include "graphics/surface.h"
 
+namespace Graphics {
+class ManagedSurface;
+}
+
 namespace Sherlock {
 
 class SherlockEngine;
@@ -45,6 +49,24 @@ struct ImageFrame {
 	byte _rleMarker;
 	Graphics::Surface _frame;
 
+	// The frame as it was last drawn scaled, kept for drawing it at the same scale again
+	mutable Graphics::ManagedSurface *_scaledFrame;
+	mutable int _scaledVal;
+	mutable bool _scaledFlipped;
+
+	ImageFrame();
+
+	/**
+	 * Frees the frame's surface and its scaled copy
+	 */
+	void free();
+
+	/**
+	 * Returns the frame scaled by the given amount, and flipped if specified. Pixels not
+	 * covered by the frame are set to the transparent color
+	 */
+	const Graphics::Surface &getScaledFrame(int scaleVal, bool flipped, uint transColor) const;
+
 	/**
 	 * Converts an ImageFrame record to a surface for convenience in passing to drawing methods
 	 */
@@ -58,6 +58,16 @@ void BaseSurface::writeFancyString(const Common::String &str, const Common::Poin
 void BaseSurface::SHtransBlitFrom(const ImageFrame &src, const Common::Point &pt,
 		bool flipped, int overrideColor, int scaleVal) {
 	Common::Point drawPt(pt.x + src.sDrawXOffset(scaleVal), pt.y + src.sDrawYOffset(scaleVal));
+
+	if (scaleVal > 0 && scaleVal != SCALE_THRESHOLD) {
+		// People walking in and out of the scene are drawn at the same scale
+		// for many frames in a row, so the frame is only scaled when that changes
+		const uint transColor = IS_3DO ? 0 : TRANSPARENCY;
+		Graphics::Screen::transBlitFrom(src.getScaledFrame(scaleVal, flipped, transColor), drawPt,
+			transColor, false, overrideColor);
+		return;
+	}
+
 	SHtransBlitFrom(src._frame, drawPt, flipped, overrideColor, scaleVal);
 }
 
@@ -494,7 +494,12 @@ void GraphicsManager::resetSpriteLayers(ZBufferData *pz, int x, int y, bool upsi
 	_spriteLayers->numLayers = pz->numPanels;
 	debugC(3, kSludgeDebugZBuffer, "%i zBuffer layers", _spriteLayers->numLayers);
 	for (int i = 0; i < _spriteLayers->numLayers; ++i) {
-		SpriteDisplay *node = new SpriteDisplay(x, y, (upsidedown ? Graphics::FLIP_V : Graphics::FLIP_NONE), &pz->sprites[i], pz->sprites[i].w, pz->sprites[i].h);
+		// The panel sprites only hold the part of the scene they cover
+		const Common::Rect &rect = pz->spriteRect[i];
+		if (rect.isEmpty())
+			continue;
+		int top = upsidedown ? _sceneHeight - rect.bottom : rect.top;
+		SpriteDisplay *node = new SpriteDisplay(x + rect.left, y + top, (upsidedown ? Graphics::FLIP_V : Graphics::FLIP_NONE), &pz->sprites[i], pz->sprites[i].w, pz->sprites[i].h);
 		_spriteLayers->layer[i].push_back(node);
 		debugC(3, kSludgeDebugZBuffer, "Layer %i is of depth %i", i, pz->panel[i]);
 	}
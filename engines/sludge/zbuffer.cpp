@@ -165,6 +165,37 @@ bool GraphicsManager::setZBuffer(int num) {
 			stillToGo--;
 		}
 	}
+
+	// The panels are drawn on every frame, but most of them only cover a
+	// small part of the scene, so crop them to their non-transparent pixels
+	for (int i = 0; i < _zBuffer->numPanels; ++i) {
+		Graphics::Surface &sprite = _zBuffer->sprites[i];
+		Common::Rect bounds;
+		for (int y = 0; y < sprite.h; ++y) {
+			const uint32 *row = (const uint32 *)sprite.getBasePtr(0, y);
+			int x1 = 0;
+			while (x1 < sprite.w && !row[x1])
+				x1++;
+			if (x1 == sprite.w)
+				continue;
+			int x2 = sprite.w;
+			while (!row[x2 - 1])
+				x2--;
+
+			if (bounds.isEmpty())
+				bounds = Common::Rect(x1, y, x2, y + 1);
+			else
+				bounds.extend(Common::Rect(x1, y, x2, y + 1));
+		}
+
+		_zBuffer->spriteRect[i] = bounds;
+		Graphics::Surface cropped;
+		if (!bounds.isEmpty())
+			cropped.copyFrom(sprite.getSubArea(bounds));
+		sprite.free();
+		sprite = cropped;
+	}
+
 	g_sludge->_resMan->finishAccess();
 	setResourceForFatal(-1);
 	return true;
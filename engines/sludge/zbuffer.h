@@ -22,6 +22,7 @@
 #ifndef SLUDGE_ZBUFFER_H
 #define SLUDGE_ZBUFFER_H
 
+#include "common/rect.h"
 #include "graphics/surface.h"
 
 namespace Sludge {
@@ -32,6 +33,7 @@ struct ZBufferData {
 	int panel[16];
 	int originalNum;
 	Graphics::Surface *sprites;
+	Common::Rect spriteRect[16]; // Part of the scene covered by each panel, which its sprite holds
 };
 
 } // End of namespace Sludges
@@ -77,6 +77,9 @@ Router::Router(ObjectMan *pObjMan, ResMan *pResMan) {
 	_playerTargetX = _playerTargetY = _playerTargetDir = _playerTargetStance = 0;
 	_diagonalx = _diagonaly = 0;
 	_slidyWalkAnimatorState = false;
+	_gridResourceId = -1;
+	_gridDiagonalX = _gridDiagonalY = 0;
+	memset(_gridLinks, O_GRID_LINK_UNKNOWN, sizeof(_gridLinks));
 }
 
 /*
@@ -1431,7 +1434,7 @@ bool Router::scan(int32 level) {
 						distance = (6 * ABS(x2 - x1) + 36 * ABS(y2 - y1)) / (36 * 14) + 1;
 
 					if (distance + _node[i].dist < _node[_nNodes].dist && distance + _node[i].dist < _node[j].dist) {
-						if (newCheck(0, x1, y1, x2, y2)) {
+						if (nodesLinked(i, j)) {
 							_node[j].level = level + 1;
 							_node[j].dist = distance + _node[i].dist;
 							_node[j].prev = i;
@@ -1447,6 +1450,22 @@ bool Router::scan(int32 level) {
 }
 
 
+bool Router::nodesLinked(int32 i, int32 j) {
+	// The start and target nodes move with every route, but the walkgrid
+	// nodes between them stay put for as long as the floor does
+	if (i <= 0 || i >= _nNodes || j <= 0 || j >= _nNodes)
+		return newCheck(0, _node[i].x, _node[i].y, _node[j].x, _node[j].y) != 0;
+
+	if (_gridLinks[i][j] == O_GRID_LINK_UNKNOWN) {
+		if (newCheck(0, _node[i].x, _node[i].y, _node[j].x, _node[j].y))
+			_gridLinks[i][j] = O_GRID_LINK_OPEN;
+		else
+			_gridLinks[i][j] = O_GRID_LINK_BLOCKED;
+	}
+
+	return _gridLinks[i][j] == O_GRID_LINK_OPEN;
+}
+
 int32 Router::newCheck(int32 status, int32 x1, int32 y1, int32 x2, int32 y2) {
 	/*********************************************************************
 	 * newCheck routine checks if the route between two points can be
@@ -1839,63 +1858,69 @@ int32 Router::LoadWalkResources(Object *megaObject, int32 x, int32 y, int32 dir)
 	walkGridResourceId = floorObject->o_resource;
 	//Unlock_object(floorId);
 
-	//ResOpen(walkGridResourceId);          // mouse wiggle
-	//fPolygrid = ResLock(walkGridResourceId);          // mouse wiggle
-	fPolygrid = (uint8 *)_resMan->openFetchRes(walkGridResourceId);
+	// the bars and nodes of the walkgrid only need reading in again when
+	// the mega is on another floor
+	if (walkGridResourceId != _gridResourceId) {
+		//ResOpen(walkGridResourceId);          // mouse wiggle
+		//fPolygrid = ResLock(walkGridResourceId);          // mouse wiggle
+		fPolygrid = (uint8 *)_resMan->openFetchRes(walkGridResourceId);
 
 
-	fPolygrid += sizeof(Header);
-	memcpy(&floorHeader, fPolygrid, sizeof(WalkGridHeader));
-	fPolygrid += sizeof(WalkGridHeader);
-	_nBars = _resMan->getUint32(floorHeader.numBars);
+		fPolygrid += sizeof(Header);
+		memcpy(&floorHeader, fPolygrid, sizeof(WalkGridHeader));
+		fPolygrid += sizeof(WalkGridHeader);
+		_nBars = _resMan->getUint32(floorHeader.numBars);
 
-	if (_nBars >= O_GRID_SIZE) {
+		if (_nBars >= O_GRID_SIZE) {
 #ifdef DEBUG //check for id > number in file,
-		error("RouteFinder Error too many _bars %d", _nBars);
+			error("RouteFinder Error too many _bars %d", _nBars);
 #endif
-		_nBars = 0;
-	}
+			_nBars = 0;
+		}
 
-	_nNodes = _resMan->getUint32(floorHeader.numNodes) + 1; //array starts at 0 begins at a start _node has nnodes nodes and a target _node
+		_nNodes = _resMan->getUint32(floorHeader.numNodes) + 1; //array starts at 0 begins at a start _node has nnodes nodes and a target _node
 
-	if (_nNodes >= O_GRID_SIZE) {
+		if (_nNodes >= O_GRID_SIZE) {
 #ifdef DEBUG //check for id > number in file,
-		error("RouteFinder Error too many nodes %d", _nNodes);
+			error("RouteFinder Error too many nodes %d", _nNodes);
 #endif
-		_nNodes = 0;
-	}
+			_nNodes = 0;
+		}
 
-	/*memmove(&_bars[0],fPolygrid,_nBars*sizeof(BarData));
-	fPolygrid += _nBars*sizeof(BarData);//move pointer to start of _node data*/
-	for (cnt = 0; cnt < _nBars; cnt++) {
-		_bars[cnt].x1   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].y1   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].x2   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].y2   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].xmin = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].ymin = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].xmax = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].ymax = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].dx   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].dy   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_bars[cnt].co   = _resMan->readUint32(fPolygrid); fPolygrid += 4;
-	}
+		/*memmove(&_bars[0],fPolygrid,_nBars*sizeof(BarData));
+		fPolygrid += _nBars*sizeof(BarData);//move pointer to start of _node data*/
+		for (cnt = 0; cnt < _nBars; cnt++) {
+			_bars[cnt].x1   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].y1   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].x2   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].y2   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].xmin = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].ymin = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].xmax = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].ymax = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].dx   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].dy   = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_bars[cnt].co   = _resMan->readUint32(fPolygrid); fPolygrid += 4;
+		}
 
-	/*j = 1;// leave _node 0 for start _node
-	do {
-	    memmove(&_node[j].x,fPolygrid,2*sizeof(int16));
-	    fPolygrid += 2*sizeof(int16);
-	    j ++;
-	} while (j < _nNodes);//array starts at 0*/
-	for (cnt = 1; cnt < _nNodes; cnt++) {
-		_node[cnt].x = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-		_node[cnt].y = _resMan->readUint16(fPolygrid); fPolygrid += 2;
-	}
+		/*j = 1;// leave _node 0 for start _node
+		do {
+		    memmove(&_node[j].x,fPolygrid,2*sizeof(int16));
+		    fPolygrid += 2*sizeof(int16);
+		    j ++;
+		} while (j < _nNodes);//array starts at 0*/
+		for (cnt = 1; cnt < _nNodes; cnt++) {
+			_node[cnt].x = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+			_node[cnt].y = _resMan->readUint16(fPolygrid); fPolygrid += 2;
+		}
 
-	//ResUnlock(walkGridResourceId);            // mouse wiggle
-	//ResClose(walkGridResourceId);         // mouse wiggle
-	_resMan->resClose(walkGridResourceId);
+		//ResUnlock(walkGridResourceId);            // mouse wiggle
+		//ResClose(walkGridResourceId);         // mouse wiggle
+		_resMan->resClose(walkGridResourceId);
 
+		_gridResourceId = walkGridResourceId;
+		memset(_gridLinks, O_GRID_LINK_UNKNOWN, sizeof(_gridLinks));
+	}
 
 	// floor grid loaded
 
@@ -1952,6 +1977,13 @@ int32 Router::LoadWalkResources(Object *megaObject, int32 x, int32 y, int32 dir)
 	_diagonalx =  _modX[3]; //36
 	_diagonaly =  _modY[3]; //8
 
+	// the links between nodes depend on the mega's diagonal step
+	if (_diagonalx != _gridDiagonalX || _diagonaly != _gridDiagonalY) {
+		_gridDiagonalX = _diagonalx;
+		_gridDiagonalY = _diagonaly;
+		memset(_gridLinks, O_GRID_LINK_UNKNOWN, sizeof(_gridLinks));
+	}
+
 	// mega data ready
 
 	// finish setting grid by putting mega _node at begining
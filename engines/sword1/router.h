@@ -80,6 +80,9 @@ struct PathData {
 #define ROUTE_END_FLAG 255
 
 #define O_GRID_SIZE 200
+#define O_GRID_LINK_UNKNOWN 0
+#define O_GRID_LINK_OPEN    1
+#define O_GRID_LINK_BLOCKED 2
 #define O_ROUTE_SIZE 50
 
 class ObjectMan;
@@ -134,11 +137,18 @@ private:
 
 	bool        _slidyWalkAnimatorState;
 
+	// The walkgrid of the last floor routed on, and whether each of its
+	// nodes can be walked to from each other, worked out as scan() asks
+	int32       _gridResourceId;
+	int32       _gridDiagonalX, _gridDiagonalY;
+	uint8       _gridLinks[O_GRID_SIZE][O_GRID_SIZE];
+
 	int32 LoadWalkResources(Object *mega, int32 x, int32 y, int32 dir);
 	int32 getRoute();
 	int32 checkTarget(int32 x, int32 y);
 
 	bool scan(int32 level);
+	bool nodesLinked(int32 i, int32 j);
 	int32 newCheck(int32 status, int32 x1, int32 x2, int32 y1, int32 y2);
 	bool check(int32 x1, int32 y1, int32 x2, int32 y2);
 	bool horizCheck(int32 x1, int32 y, int32 x2);
@@ -85,6 +85,7 @@ MemoryManager::MemoryManager() {
 	}
 
 	_idStackPtr = MAX_MEMORY_BLOCKS;
+	_lastEncodedBlock = NULL;
 }
 
 MemoryManager::~MemoryManager() {
@@ -99,11 +100,19 @@ int32 MemoryManager::encodePtr(byte *ptr) {
 	if (ptr == NULL)
 		return 0;
 
-	int idx = findPointerInIndex(ptr);
+	// Scripts mostly encode pointers into the same resource over and
+	// over, so try the block of the previous pointer before searching
+	MemBlock *block = _lastEncodedBlock;
+	if (!block || ptr < block->ptr || ptr >= block->ptr + block->size) {
+		int idx = findPointerInIndex(ptr);
 
-	assert(idx != -1);
+		assert(idx != -1);
+
+		block = _memBlockIndex[idx];
+		_lastEncodedBlock = block;
+	}
 
-	uint32 id = _memBlockIndex[idx]->id;
+	uint32 id = block->id;
 	uint32 offset = ptr - _memBlocks[id].ptr;
 
 	assert(id < 0x03ff);
@@ -232,6 +241,9 @@ void MemoryManager::memFree(byte *ptr) {
 	// Put back the id on the stack
 	_idStack[_idStackPtr++] = _memBlockIndex[idx]->id;
 
+	if (_lastEncodedBlock == _memBlockIndex[idx])
+		_lastEncodedBlock = NULL;
+
 	// Release the memory block
 	free(_memBlockIndex[idx]->ptr);
 	_memBlockIndex[idx]->ptr = NULL;
@@ -49,6 +49,9 @@ private:
 	int16 *_idStack;
 	int16 _idStackPtr;
 
+	// The block the last encoded pointer pointed into
+	MemBlock *_lastEncodedBlock;
+
 	int16 findExactPointerInIndex(byte *ptr);
 	int16 findPointerInIndex(byte *ptr);
 	int16 findInsertionPointInIndex(byte *ptr);
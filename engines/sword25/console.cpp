@@ -22,14 +22,39 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/script/luascript.h"
+
+#include "common/lua/lua.h"
+#include "common/lua/lauxlib.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("lua_stats", WRAP_METHOD(Sword25Console, Cmd_LuaStats));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_LuaStats(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+	lua_State *L = script ? static_cast<lua_State *>(script->getScriptObject()) : nullptr;
+	if (!L) {
+		debugPrintf("Lua is not initialized\n");
+		return true;
+	}
+
+	luaL_AllocStats stats;
+	if (luaL_getallocstats(L, &stats)) {
+		debugPrintf("Memory: %u KB in use, %u KB at most\n", (uint)(stats.inUse / 1024), (uint)(stats.peakInUse / 1024));
+		debugPrintf("Allocations: %lu from pools, %lu from the heap\n", stats.poolAllocs, stats.heapAllocs);
+	}
+	debugPrintf("Garbage collector: %d KB counted\n", lua_gc(L, LUA_GCCOUNT, 0));
+	debugPrintf("Idle collection: %u steps, %u cycles, %u ms\n", script->getGCSteps(), script->getGCCycles(), script->getGCMillis());
+	return true;
+}
+
 } // End of namespace Sword25
@@ -67,6 +67,14 @@ public:
 		return _pImage->getHeight();
 	}
 
+	/**
+	    @brief Returns the size of the decoded image data in bytes.
+	*/
+	virtual uint getDataSize() const {
+		// All images are decoded to 32 bit
+		return _pImage ? _pImage->getWidth() * _pImage->getHeight() * 4 : 0;
+	}
+
 	/**
 	    @brief Rendert das Bild in den Framebuffer.
 	    @param PosX die Position auf der X-Achse im Zielbild in Pixeln, an der das Bild gerendert werden soll.<br>
@@ -38,6 +38,7 @@
 #include "sword25/gfx/panel.h"
 #include "sword25/gfx/renderobjectmanager.h"
 #include "sword25/gfx/screenshot.h"
+#include "sword25/gfx/image/imgloader.h"
 #include "sword25/gfx/image/renderedimage.h"
 #include "sword25/gfx/image/swimage.h"
 #include "sword25/gfx/image/vectorimage.h"
@@ -54,7 +55,10 @@
 #include "common/lua/lauxlib.h"
 enum {
 	BIT_DEPTH = 32,
-	BACKBUFFER_COUNT = 1
+	BACKBUFFER_COUNT = 1,
+	// The number of images which may be decoded in the background before
+	// being requested
+	MAX_PRECACHED_IMAGES = 32
 };
 
 
@@ -81,6 +85,15 @@ GraphicEngine::GraphicEngine(Kernel *pKernel) :
 }
 
 GraphicEngine::~GraphicEngine() {
+	// Drop the images which were decoded, but never requested
+	for (PrecachedImageMap::iterator it = _precachedImages.begin(); it != _precachedImages.end(); ++it) {
+		PrecachedImage *image = it->_value;
+		image->future.wait();
+		image->surface.free();
+		delete[] image->fileData;
+		delete image;
+	}
+
 	unregisterScriptBindings();
 	_backSurface.free();
 	delete _thumbnail;
@@ -330,6 +343,70 @@ Resource *GraphicEngine::loadResource(const Common::String &filename) {
 
 // -----------------------------------------------------------------------------
 
+class GraphicEngine::ImageDecodeTask : public Common::Task {
+public:
+	ImageDecodeTask(PrecachedImage &image) : _image(image) {}
+
+	virtual void run() {
+		_image.result = ImgLoader::decodePNGImage(_image.fileData, _image.fileSize, &_image.surface);
+		delete[] _image.fileData;
+		_image.fileData = 0;
+	}
+
+private:
+	PrecachedImage &_image;
+};
+
+bool GraphicEngine::precacheResource(const Common::String &filename) {
+	// Only sprite images are decoded in the background. Software buffers and
+	// savegame thumbnails are small or only loaded as part of a savegame.
+	if (!filename.hasSuffix(".png") || filename.hasSuffix("_s.png") || filename.hasPrefix("/saves"))
+		return false;
+
+	if (_precachedImages.contains(filename))
+		return true;
+
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (scheduler->isSerial() || _precachedImages.size() >= MAX_PRECACHED_IMAGES)
+		return false;
+
+	// The file is read here, as the package manager must only be used by the
+	// engine thread
+	PackageManager *pPackage = Kernel::getInstance()->getPackage();
+	assert(pPackage);
+
+	PrecachedImage *image = new PrecachedImage();
+	image->fileData = pPackage->getFile(filename, &image->fileSize);
+	if (!image->fileData) {
+		delete image;
+		return false;
+	}
+
+	image->future = scheduler->schedule(new ImageDecodeTask(*image));
+	_precachedImages[filename] = image;
+
+	return true;
+}
+
+bool GraphicEngine::takePrecachedImage(const Common::String &filename, Graphics::Surface *dest) {
+	PrecachedImageMap::iterator it = _precachedImages.find(filename);
+	if (it == _precachedImages.end())
+		return false;
+
+	PrecachedImage *image = it->_value;
+	_precachedImages.erase(it);
+
+	image->future.wait();
+	const bool result = image->result;
+	if (result)
+		*dest = image->surface;
+	else
+		image->surface.free();
+	delete image;
+
+	return result;
+}
+
 bool GraphicEngine::canLoadResource(const Common::String &filename) {
 	return filename.hasSuffix(".png") ||
 		filename.hasSuffix("_ani.xml") ||
@@ -42,9 +42,12 @@
 
 // Includes
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/rect.h"
 #include "common/ptr.h"
 #include "common/str.h"
+#include "common/taskscheduler.h"
 #include "graphics/surface.h"
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/resservice.h"
@@ -274,6 +277,15 @@ public:
 	// --------------------------
 	virtual Resource *loadResource(const Common::String &fileName);
 	virtual bool canLoadResource(const Common::String &fileName);
+	virtual bool precacheResource(const Common::String &fileName);
+
+	/**
+	 * Hands over the image decoded in the background for a file, if there is one.
+	 * @param FileName      The unique filename of the image
+	 * @param Dest          Receives the decoded image, which the caller then owns
+	 * @return              Returns true if Dest was filled
+	 */
+	bool takePrecachedImage(const Common::String &fileName, Graphics::Surface *dest);
 
 	// Persistence Methods
 	// -------------------
@@ -309,6 +321,23 @@ private:
 	Common::Array<uint> _frameTimeSamples;
 	uint _frameTimeSampleSlot;
 
+	// Background Image Decoding Variables
+	// -----------------------------------
+	class ImageDecodeTask;
+
+	struct PrecachedImage {
+		byte *fileData;
+		uint fileSize;
+		Graphics::Surface surface;
+		bool result;
+		Common::TaskFuture future;
+
+		PrecachedImage() : fileData(0), fileSize(0), result(false) {}
+	};
+
+	typedef Common::HashMap<Common::String, PrecachedImage *> PrecachedImageMap;
+	PrecachedImageMap _precachedImages;
+
 private:
 	RenderObjectPtr<Panel> _mainPanelPtr;
 
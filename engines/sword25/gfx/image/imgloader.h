@@ -62,6 +62,7 @@ public:
 	 *
 	 * @remark This function does not free the image buffer passed to it,
 	 *         it is the callers responsibility to do so.
+	 * @remark This function may be called from any thread.
 	 */
 	static bool decodePNGImage(const byte *pFileData, uint fileSize,
 	                           Graphics::Surface *dest);
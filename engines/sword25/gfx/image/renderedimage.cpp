@@ -108,38 +108,43 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
 
-	// Load file
-	byte *pFileData;
-	uint fileSize;
+	// The image may already have been decoded in the background
+	result = Kernel::getInstance()->getGfx()->takePrecachedImage(filename, &_surface);
 
-	bool isPNG = true;
+	if (!result) {
+		// Load file
+		byte *pFileData;
+		uint fileSize;
 
-	if (filename.hasPrefix("/saves")) {
-		pFileData = readSavegameThumbnail(filename, fileSize, isPNG);
-	} else {
-		pFileData = pPackage->getFile(filename, &fileSize);
-	}
+		bool isPNG = true;
 
-	if (!pFileData) {
-		error("File \"%s\" could not be loaded.", filename.c_str());
-		return;
-	}
+		if (filename.hasPrefix("/saves")) {
+			pFileData = readSavegameThumbnail(filename, fileSize, isPNG);
+		} else {
+			pFileData = pPackage->getFile(filename, &fileSize);
+		}
 
-	// Uncompress the image
-	if (isPNG)
-		result = ImgLoader::decodePNGImage(pFileData, fileSize, &_surface);
-	else
-		result = ImgLoader::decodeThumbnailImage(pFileData, fileSize, &_surface);
+		if (!pFileData) {
+			error("File \"%s\" could not be loaded.", filename.c_str());
+			return;
+		}
 
-	if (!result) {
-		error("Could not decode image.");
+		// Uncompress the image
+		if (isPNG)
+			result = ImgLoader::decodePNGImage(pFileData, fileSize, &_surface);
+		else
+			result = ImgLoader::decodeThumbnailImage(pFileData, fileSize, &_surface);
+
+		if (!result) {
+			error("Could not decode image.");
+			delete[] pFileData;
+			return;
+		}
+
+		// Cleanup FileData
 		delete[] pFileData;
-		return;
 	}
 
-	// Cleanup FileData
-	delete[] pFileData;
-
 	_doCleanup = true;
 
 #if defined(SCUMM_LITTLE_ENDIAN)
@@ -37,6 +37,7 @@
 #include "sword25/gfx/image/vectorimage.h"
 #include "sword25/gfx/image/renderedimage.h"
 
+#include "common/system.h"
 #include "graphics/colormasks.h"
 
 namespace Sword25 {
@@ -215,7 +216,7 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _fname(fname) {
 	success = false;
 	_bgColor = 0;
 
@@ -312,7 +313,11 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	free(_pixelData);
+	for (Common::List<CachedRender *>::iterator it = _renderCache.begin(); it != _renderCache.end(); ++it) {
+		(*it)->future.wait();
+		free((*it)->pixelData);
+		delete *it;
+	}
 }
 
 
@@ -610,32 +615,105 @@ bool VectorImage::setContent(const byte *pixeldata, uint size, uint offset, uint
 	return 0;
 }
 
+// The number of sizes each image is kept rasterized at
+#define MAX_CACHED_RENDERS 4
+
+class VectorImage::RenderTask : public Common::Task {
+public:
+	RenderTask(const VectorImage &image, CachedRender &render) : _image(image), _render(render) {}
+
+	virtual void run() {
+		_render.pixelData = _image.render(_render.width, _render.height);
+	}
+
+private:
+	const VectorImage &_image;
+	CachedRender &_render;
+};
+
+VectorImage::CachedRender *VectorImage::findCachedRender(int width, int height) {
+	for (Common::List<CachedRender *>::iterator it = _renderCache.begin(); it != _renderCache.end(); ++it) {
+		CachedRender *render = *it;
+		if (render->width == width && render->height == height) {
+			// Move it to the front of the list
+			_renderCache.erase(it);
+			_renderCache.push_front(render);
+			return render;
+		}
+	}
+
+	return 0;
+}
+
+VectorImage::CachedRender *VectorImage::findFinishedRender(const CachedRender *except) const {
+	for (Common::List<CachedRender *>::const_iterator it = _renderCache.begin(); it != _renderCache.end(); ++it) {
+		CachedRender *render = *it;
+		if (render != except && render->width > 0 && render->height > 0 &&
+			(!render->future.isValid() || render->future.isDone()))
+			return render;
+	}
+
+	return 0;
+}
+
+void VectorImage::trimRenderCache() {
+	while (_renderCache.size() > MAX_CACHED_RENDERS) {
+		CachedRender *render = _renderCache.back();
+		_renderCache.pop_back();
+
+		render->future.wait();
+		free(render->pixelData);
+		delete render;
+	}
+}
+
 bool VectorImage::blit(int posX, int posY,
                        int flipping,
                        Common::Rect *pPartRect,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
+	// The rasterization doesn't depend on the color modulation, which is
+	// applied while blitting, so only the size has to match
+	CachedRender *render = findCachedRender(width, height);
+	if (!render) {
+		render = new CachedRender(width, height);
+
+		// Scaling animations ask for a new size every frame. As long as
+		// another size can be shown scaled in the meantime, the new size is
+		// rasterized in the background.
+		Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+		if (!scheduler->isSerial() && !pPartRect && width > 0 && height > 0 && findFinishedRender(0))
+			render->future = scheduler->schedule(new RenderTask(*this, *render));
+		else
+			render->pixelData = this->render(width, height);
 
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
+		_renderCache.push_front(render);
+		trimRenderCache();
+	}
+
+	CachedRender *shown = render;
+	if (render->future.isValid()) {
+		if (!render->future.isDone()) {
+			// A part rectangle refers to the rasterized size, so it needs
+			// the exact one
+			shown = pPartRect ? 0 : findFinishedRender(render);
+			if (!shown) {
+				render->future.wait();
+				shown = render;
+			}
+		}
+		if (shown == render)
+			render->future = Common::TaskFuture();
 	}
 
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(shown->pixelData, shown->width, shown->height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
 
 	delete rend;
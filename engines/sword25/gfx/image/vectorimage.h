@@ -38,7 +38,9 @@
 
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/image/image.h"
+#include "common/list.h"
 #include "common/rect.h"
+#include "common/taskscheduler.h"
 
 #include "art.h"
 
@@ -183,7 +185,11 @@ public:
 	}
 	virtual bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0));
 
-	void render(int width, int height);
+	/**
+	    @brief Rasterizes the image at the given size into a newly allocated buffer, which the caller frees.
+	    @remark This method may be called from any thread.
+	*/
+	byte *render(int width, int height) const;
 
 	virtual uint getPixel(int x, int y);
 	virtual bool isBlitSource() const {
@@ -225,7 +231,25 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
+	class RenderTask;
+
+	/**
+	    @brief The image rasterized at one size. The pixel data is only valid once the future is done.
+	*/
+	struct CachedRender {
+		int width;
+		int height;
+		byte *pixelData;
+		Common::TaskFuture future;
+
+		CachedRender(int w, int h) : width(w), height(h), pixelData(0) {}
+	};
+
+	CachedRender *findCachedRender(int width, int height);
+	CachedRender *findFinishedRender(const CachedRender *except) const;
+	void trimRenderCache();
+
+	Common::List<CachedRender *> _renderCache; ///< Most recently used first
 
 	Common::String _fname;
 	uint _bgColor;
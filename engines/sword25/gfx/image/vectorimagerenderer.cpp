@@ -59,29 +59,35 @@ void art_rgb_fill_run1(byte *buf, byte r, byte g, byte b, int n) {
 }
 
 void art_rgb_run_alpha1(byte *buf, byte r, byte g, byte b, int alpha, int n) {
-	int i;
-	int v;
-
-	for (i = 0; i < n; i++) {
-#if defined(SCUMM_LITTLE_ENDIAN)
-		v = *buf;
-		*buf++ = MIN(v + alpha, 0xff);
-		v = *buf;
-		*buf++ = v + (((b - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((g - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((r - v) * alpha + 0x80) >> 8);
-#else
-		v = *buf;
-		*buf++ = v + (((r - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((g - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((b - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = MIN(v + alpha, 0xff);
-#endif
+	// Work on whole pixels, which hold the channels as R, G, B, A from the
+	// most significant byte down, regardless of the endianness
+	uint32 *pixel = (uint32 *)buf;
+	uint32 lastIn = 0, lastOut = 0;
+	bool haveLast = false;
+
+	for (int i = 0; i < n; i++, pixel++) {
+		const uint32 in = *pixel;
+
+		// Runs are mostly spans of one color over one background
+		if (haveLast && in == lastIn) {
+			*pixel = lastOut;
+			continue;
+		}
+
+		const int va = in & 0xff;
+		const int vb = (in >> 8) & 0xff;
+		const int vg = (in >> 16) & 0xff;
+		const int vr = in >> 24;
+
+		const uint32 out = MIN(va + alpha, 0xff) |
+		                   ((vb + (((b - vb) * alpha + 0x80) >> 8)) & 0xff) << 8 |
+		                   ((vg + (((g - vg) * alpha + 0x80) >> 8)) & 0xff) << 16 |
+		                   (uint32)((vr + (((r - vr) * alpha + 0x80) >> 8)) & 0xff) << 24;
+
+		*pixel = out;
+		lastIn = in;
+		lastOut = out;
+		haveLast = true;
 	}
 }
 
@@ -400,17 +406,14 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 	free(vec);
 }
 
-void VectorImage::render(int width, int height) {
+byte *VectorImage::render(int width, int height) const {
 	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
 	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
 
 	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
 
-	if (_pixelData)
-		free(_pixelData);
-
-	_pixelData = (byte *)malloc(width * height * 4);
-	memset(_pixelData, 0, width * height * 4);
+	byte *pixelData = (byte *)malloc(width * height * 4);
+	memset(pixelData, 0, width * height * 4);
 
 	for (uint e = 0; e < _elements.size(); e++) {
 
@@ -451,7 +454,7 @@ void VectorImage::render(int width, int height) {
 			(*fill0pos).code = ART_END;
 			(*fill1pos).code = ART_END;
 
-			drawBez(fill1, fill0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
+			drawBez(fill1, fill0, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
 
 			free(fill0);
 			free(fill1);
@@ -464,11 +467,13 @@ void VectorImage::render(int width, int height) {
 
 			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
 				if (_elements[e].getPathInfo(p).getLineStyle() == s + 1) {
-					drawBez(_elements[e].getPathInfo(p).getVec(), 0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
+					drawBez(_elements[e].getPathInfo(p).getVec(), 0, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
 				}
 			}
 		}
 	}
+
+	return pixelData;
 }
 
 
@@ -35,6 +35,7 @@
 #include "sword25/kernel/resmanager.h"
 #include "sword25/kernel/persistenceservice.h"
 #include "sword25/script/script.h"
+#include "sword25/script/luascript.h"
 #include "sword25/script/luabindhelper.h"
 
 namespace Sword25 {
@@ -257,7 +258,12 @@ static int processMessages(lua_State *L) {
 	// to the closeWanted() opcode; see also the TODO comment in there.
 
 	lua_pushbooleancpp(L, !Engine::shouldQuit());
-	g_system->delayMillis(10);
+
+	// Spend the time we wait anyway on collecting garbage
+	uint32 startTime = g_system->getMillis();
+	static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript())->collectGarbageStep(10);
+	uint32 elapsed = g_system->getMillis() - startTime;
+	g_system->delayMillis(elapsed < 10 ? 10 - elapsed : 0);
 
 	return 1;
 }
@@ -313,6 +319,8 @@ static int precacheResource(lua_State *L) {
 #ifdef PRECACHE_RESOURCES
 	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
 #else
+	// Decode in the background what the scripts are about to use
+	pResource->startPrecache(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
 #endif
 
@@ -328,6 +336,7 @@ static int forcePrecacheResource(lua_State *L) {
 #ifdef PRECACHE_RESOURCES
 	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1), true));
 #else
+	pResource->startPrecache(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
 #endif
 
@@ -46,6 +46,12 @@ namespace Sword25 {
 // are loaded, the resource manager will start purging resources till it
 // hits the minimum limit above
 #define SWORD25_RESOURCECACHE_MAX 500
+// The amount of decoded resource data, mostly image pixels, that is kept
+// loaded. Above the maximum, unlocked resources are purged until the data
+// falls below the minimum, so that a few large backgrounds don't pile up
+// before the resource count limits are reached
+#define SWORD25_RESOURCECACHE_MEMORY_MIN (96 * 1024 * 1024)
+#define SWORD25_RESOURCECACHE_MEMORY_MAX (128 * 1024 * 1024)
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -87,7 +93,8 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
  */
 void ResourceManager::deleteResourcesIfNecessary() {
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	const bool tooManyResources = _resources.size() >= SWORD25_RESOURCECACHE_MAX;
+	if ((!tooManyResources && _usedMemory < SWORD25_RESOURCECACHE_MEMORY_MAX) || _resources.empty())
 		return;
 
 	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
@@ -100,14 +107,17 @@ void ResourceManager::deleteResourcesIfNecessary() {
 		// The resource may be released only if it isn't locked
 		if ((*iter)->getLockCount() == 0)
 			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+	} while (iter != _resources.begin() &&
+	         (_resources.size() >= SWORD25_RESOURCECACHE_MIN || _usedMemory >= SWORD25_RESOURCECACHE_MEMORY_MIN));
+
+	debugC(kDebugResource, "Resource cache: %u resources, %u bytes", (uint)_resources.size(), (uint)_usedMemory);
 
 	// Are we still above the minimum? If yes, then start releasing locked resources
 	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
 	// in the resource lock code, and resources are not unlocked when changing rooms.
 	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
 	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
+	if (!tooManyResources || _resources.size() <= SWORD25_RESOURCECACHE_MIN)
 		return;
 
 	iter = _resources.end();
@@ -183,6 +193,27 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	return NULL;
 }
 
+/**
+ * Starts loading a resource in the background, so that requesting it later on is quicker.
+ * @param FileName      The filename of the resource
+ */
+bool ResourceManager::startPrecache(const Common::String &fileName) {
+	// Get the absolute path to the file
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty())
+		return false;
+
+	if (getResource(uniqueFileName))
+		return true;
+
+	for (uint i = 0; i < _resourceServices.size(); ++i) {
+		if (_resourceServices[i]->canLoadResource(uniqueFileName))
+			return _resourceServices[i]->precacheResource(uniqueFileName);
+	}
+
+	return false;
+}
+
 #ifdef PRECACHE_RESOURCES
 
 /**
@@ -253,6 +284,9 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 				return NULL;
 			}
 
+			pResource->_dataSize = pResource->getDataSize();
+			_usedMemory += pResource->_dataSize;
+
 			// Add the resource to the front of the list
 			_resources.push_front(pResource);
 			pResource->_iterator = _resources.begin();
@@ -296,6 +330,8 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 	// Remove the resource from the hash table
 	_resourceHashMap.erase(pResource->_fileName);
 
+	_usedMemory -= pResource->_dataSize;
+
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
 
@@ -66,6 +66,14 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Starts loading a resource in the background, so that requesting it later on is quicker.
+	 * Nothing is done if the resource is already loaded, or if its service can't load it in the background.
+	 * @param FileName      The filename of the resource
+	 * @return              Returns true if the resource is loaded or being loaded
+	 */
+	bool startPrecache(const Common::String &fileName);
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -94,7 +102,8 @@ private:
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
 	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
+		_kernelPtr(pKernel),
+		_usedMemory(0)
 	{}
 	virtual ~ResourceManager();
 
@@ -135,6 +144,7 @@ private:
 	void deleteResourcesIfNecessary();
 
 	Kernel *_kernelPtr;
+	uint32 _usedMemory;           ///< The data size of all loaded resources
 	Common::Array<ResourceService *> _resourceServices;
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
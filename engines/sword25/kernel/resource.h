@@ -92,6 +92,13 @@ public:
 		return _type;
 	}
 
+	/**
+	 * Returns the number of bytes the loaded resource takes up in memory
+	 */
+	virtual uint getDataSize() const {
+		return 0;
+	}
+
 protected:
 	virtual ~Resource() {}
 
@@ -99,6 +106,7 @@ private:
 	Common::String _fileName;          ///< The absolute filename
 	uint _refCount;          ///< The number of locks
 	uint _type;              ///< The type of the resource
+	uint _dataSize;          ///< The data size accounted for by the resource manager
 	Common::List<Resource *>::iterator _iterator;        ///< Points to the resource position in the LRU list
 };
 
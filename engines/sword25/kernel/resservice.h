@@ -63,6 +63,15 @@ public:
 	 */
 	virtual bool canLoadResource(const Common::String &fileName) = 0;
 
+	/**
+	 * Starts loading a resource in the background, for a later loadResource() call
+	 * @param FileName  The unique filename of the resource
+	 * @return          Returns true if loading was started. By default, resources can't be loaded in the background.
+	 */
+	virtual bool precacheResource(const Common::String &fileName) {
+		return false;
+	}
+
 };
 
 } // End of namespace Sword25
@@ -30,6 +30,7 @@
  */
 
 #include "common/memstream.h"
+#include "common/system.h"
 #include "common/debug-channels.h"
 
 #include "sword25/sword25.h"
@@ -50,13 +51,17 @@ namespace Sword25 {
 LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 	ScriptEngine(KernelPtr),
 	_state(0),
-	_pcallErrorhandlerRegistryIndex(0) {
+	_pcallErrorhandlerRegistryIndex(0),
+	_gcIdleThreshold(0),
+	_gcSteps(0),
+	_gcCycles(0),
+	_gcMillis(0) {
 }
 
 LuaScriptEngine::~LuaScriptEngine() {
 	// Lua de-initialisation
 	if (_state)
-		lua_close(_state);
+		luaL_closestate(_state);
 }
 
 namespace {
@@ -131,6 +136,26 @@ bool LuaScriptEngine::init() {
 	return true;
 }
 
+void LuaScriptEngine::collectGarbageStep(uint maxMillis) {
+	// Wait for the heap to grow after a cycle, as the collector would
+	// otherwise go through all of it again every frame
+	if (lua_gc(_state, LUA_GCCOUNT, 0) < _gcIdleThreshold)
+		return;
+
+	uint32 startTime = g_system->getMillis();
+	uint32 elapsed = 0;
+	while (elapsed < maxMillis) {
+		_gcSteps++;
+		if (lua_gc(_state, LUA_GCSTEP, 0)) {
+			_gcCycles++;
+			_gcIdleThreshold = lua_gc(_state, LUA_GCCOUNT, 0) * 2;
+			break;
+		}
+		elapsed = g_system->getMillis() - startTime;
+	}
+	_gcMillis += g_system->getMillis() - startTime;
+}
+
 bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 #ifdef DEBUG
 	int __startStackDepth = lua_gettop(_state);
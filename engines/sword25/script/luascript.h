@@ -93,10 +93,26 @@ public:
 	 */
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
+	/**
+	 * Runs the garbage collector for at most the given time, so that idle
+	 * frame time is spent on it instead of the scripts stalling on it later
+	 * @param maxMillis     The time the collector may take, in milliseconds
+	 */
+	void collectGarbageStep(uint maxMillis);
+
+	uint32 getGCSteps() const { return _gcSteps; }
+	uint32 getGCCycles() const { return _gcCycles; }
+	uint32 getGCMillis() const { return _gcMillis; }
+
 private:
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
 
+	int _gcIdleThreshold;
+	uint32 _gcSteps;
+	uint32 _gcCycles;
+	uint32 _gcMillis;
+
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
 	bool executeBuffer(const byte *data, uint size, const Common::String &name) const;
@@ -228,28 +228,47 @@ static void PrepBMV(byte *ScreenBeg, const byte *sourceData, int length, short d
 		switch (loopCtr) {
 		case 1: {
 			// @_rDelta:
-			const byte *saved_src = src;			// Save the source pointer
-			src = dst + ebx;			// Point it to existing data
+			if (byteLen <= 0)
+				break;
 
-			while (byteLen > 0) {
-				*dst = *src;
-				NEXT_BYTE(src);
-				NEXT_BYTE(dst);
-				--byteLen;
-			}
+			if (!forwardDirection) {
+				// Backwards the fetch is always from below, which is not
+				// written yet, so this is a plain overlapping move
+				memmove(dst - byteLen + 1, dst + ebx - byteLen + 1, byteLen);
+				dst -= byteLen;
+			} else if (ebx >= 0) {
+				memmove(dst, dst + ebx, byteLen);
+				dst += byteLen;
+			} else if (-ebx >= byteLen) {
+				memcpy(dst, dst + ebx, byteLen);
+				dst += byteLen;
+			} else {
+				// The fetch overlaps what this copy writes, which
+				// repeats the pattern, so it has to go byte by byte
+				const byte *fetch = dst + ebx;	// Point it to existing data
 
-			src = saved_src;
+				while (byteLen > 0) {
+					*dst++ = *fetch++;
+					--byteLen;
+				}
+			}
 			break;
 			}
 
 		case 2:
 			// @_rRaw
 			// Copy data from source to dest
-			while (byteLen > 0) {
-				*dst = *src;
-				NEXT_BYTE(src);
-				NEXT_BYTE(dst);
-				--byteLen;
+			if (byteLen <= 0)
+				break;
+
+			if (forwardDirection) {
+				memcpy(dst, src, byteLen);
+				src += byteLen;
+				dst += byteLen;
+			} else {
+				memcpy(dst - byteLen + 1, src - byteLen + 1, byteLen);
+				src -= byteLen;
+				dst -= byteLen;
 			}
 			break;
 
@@ -258,10 +277,15 @@ static void PrepBMV(byte *ScreenBeg, const byte *sourceData, int length, short d
 			// Repeating run of data
 			eax = forwardDirection ? *(dst - 1) : *(dst + 1);
 
-			while (byteLen > 0) {
-				*dst = (uint8)eax;
-				NEXT_BYTE(dst);
-				--byteLen;
+			if (byteLen <= 0)
+				break;
+
+			if (forwardDirection) {
+				memset(dst, (uint8)eax, byteLen);
+				dst += byteLen;
+			} else {
+				memset(dst - byteLen + 1, (uint8)eax, byteLen);
+				dst -= byteLen;
 			}
 			break;
 		default:
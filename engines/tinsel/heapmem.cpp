@@ -21,6 +21,8 @@
  * This file contains the handle based Memory Manager code.
  */
 
+#include "common/config-manager.h"
+
 #include "tinsel/heapmem.h"
 #include "tinsel/timers.h"	// For DwGetCurrentTime
 #include "tinsel/tinsel.h"
@@ -129,6 +131,14 @@ void MemoryInit() {
 	uint32 size = MemoryPoolSize[0];
 	if (TinselVersion == TINSEL_V1) size = MemoryPoolSize[1];
 	else if (TinselVersion == TINSEL_V2) size = MemoryPoolSize[2];
+
+	// Devices with memory to spare can raise the budget (in kilobytes),
+	// so that fewer graphics get discarded and loaded again
+	if (ConfMan.hasKey("tinsel_heap_size")) {
+		const int configSize = ConfMan.getInt("tinsel_heap_size");
+		if (configSize > 0 && (uint32)configSize * 1024 > size)
+			size = (uint32)configSize * 1024;
+	}
 	g_heapSentinel.size = size;
 }
 
@@ -195,34 +205,39 @@ void FreeMemNode(MEM_NODE *pMemNode) {
  */
 static bool HeapCompact(long size) {
 	const MEM_NODE *pHeap = &g_heapSentinel;
-	MEM_NODE *pCur, *pOldest;
-	uint32 oldest;		// time of the oldest discardable block
-
-	while (g_heapSentinel.size < size) {
-
-		// find the oldest discardable block
-		oldest = DwGetCurrentTime();
-		pOldest = NULL;
-		for (pCur = pHeap->pNext; pCur != pHeap; pCur = pCur->pNext) {
-			if (pCur->flags == DWM_USED) {
-				// found a non-discarded discardable block
-				if (pCur->lruTime < oldest) {
-					oldest = pCur->lruTime;
-					pOldest = pCur;
-				}
-			}
+	MEM_NODE *pCur;
+	MEM_NODE *candidates[NUM_MNODES];	// discardable blocks, oldest first
+	int numCandidates = 0;
+
+	if (g_heapSentinel.size >= size)
+		return true;
+
+	// Discarding a block does not change the age of any other one, so
+	// the discardable blocks are gathered and ordered by age in one go
+	// instead of searching the whole heap again for every discard
+	const uint32 now = DwGetCurrentTime();
+	for (pCur = pHeap->pNext; pCur != pHeap; pCur = pCur->pNext) {
+		// only non-discarded discardable blocks older than now qualify
+		if (pCur->flags != DWM_USED || pCur->lruTime >= now)
+			continue;
+
+		// insert it behind all blocks of the same age or older, so
+		// blocks of equal age go in heap order
+		int i = numCandidates++;
+		while (i > 0 && candidates[i - 1]->lruTime > pCur->lruTime) {
+			candidates[i] = candidates[i - 1];
+			i--;
 		}
+		candidates[i] = pCur;
+	}
 
-		if (pOldest)
-			// discard the oldest block
-			MemoryDiscard(pOldest);
-		else
-			// cannot discard any blocks
-			return false;
+	for (int i = 0; i < numCandidates && g_heapSentinel.size < size; i++) {
+		// discard the oldest block
+		MemoryDiscard(candidates[i]);
 	}
 
-	// we have freed enough memory
-	return true;
+	// we have freed enough memory, unless there was nothing more to discard
+	return g_heapSentinel.size >= size;
 }
 
 /**
@@ -27,9 +27,16 @@
 #include "titanic/support/files_manager.h"
 #include "titanic/support/simple_file.h"
 #include "titanic/titanic.h"
+#include "common/system.h"
+#include "common/taskscheduler.h"
 
 namespace Titanic {
 
+/**
+ * Number of stars each worker transforms at a time
+ */
+#define TRANSFORM_GRAIN 1024
+
 CBaseStarEntry::CBaseStarEntry() : _red(0), _value(0.0) {
 	Common::fill(&_data[0], &_data[5], 0);
 }
@@ -126,6 +133,43 @@ void CBaseStars::resetEntry(CBaseStarEntry &entry) {
 		entry._data[idx] = 0;
 }
 
+struct TransformStarsBody : public Common::ParallelForBody {
+	const CBaseStarEntry *_stars;
+	const FPose &_pose;
+	double *_x, *_y, *_z, *_dist2;
+
+	TransformStarsBody(const CBaseStarEntry *stars, const FPose &pose,
+			double *x, double *y, double *z, double *dist2) :
+		_stars(stars), _pose(pose), _x(x), _y(y), _z(z), _dist2(dist2) {}
+
+	void run(uint begin, uint end) {
+		const FPose &pose = _pose;
+		for (uint idx = begin; idx < end; ++idx) {
+			const FVector &vector = _stars[idx]._position;
+			double tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
+				+ vector._z * pose._row3._z + pose._vector._z;
+			double tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
+			double tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
+
+			_x[idx] = tempX;
+			_y[idx] = tempY;
+			_z[idx] = tempZ;
+			_dist2[idx] = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		}
+	}
+};
+
+void CBaseStars::transformStars(const FPose &pose) {
+	uint count = _data.size();
+	_viewX.resize(count);
+	_viewY.resize(count);
+	_viewZ.resize(count);
+	_viewDist2.resize(count);
+
+	TransformStarsBody body(&_data[0], pose, &_viewX[0], &_viewY[0], &_viewZ[0], &_viewDist2[0]);
+	g_system->getTaskScheduler()->parallelFor(0, count, body, TRANSFORM_GRAIN);
+}
+
 void CBaseStars::draw(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup) {
 	if (!_data.empty()) {
 		switch (camera->getStarColor()) {
@@ -174,17 +218,18 @@ void CBaseStars::draw1(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
+	transformStars(pose);
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
 		CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = _viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ; 
+		tempY = _viewY[idx];
+		tempX = _viewX[idx];
+		total2 = _viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
@@ -259,17 +304,18 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
+	transformStars(pose);
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
 		CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = _viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		tempY = _viewY[idx];
+		tempX = _viewX[idx];
+		total2 = _viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
@@ -348,17 +394,18 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
+	transformStars(pose);
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
 		CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = _viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		tempY = _viewY[idx];
+		tempX = _viewX[idx];
+		total2 = _viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
@@ -454,18 +501,19 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarClos
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
+	transformStars(pose);
+
 	for (uint idx = 0; idx < _data.size(); ++idx) {
 		const CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
 
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
+		tempZ = _viewZ[idx];
 		if (tempZ <= minVal)
 			continue;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+		tempY = _viewY[idx];
+		tempX = _viewX[idx];
+		total2 = _viewDist2[idx];
 
 		if (total2 < 1.0e12) {
 			// We're in close proximity to the given star, so draw a closeup of it
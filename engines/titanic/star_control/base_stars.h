@@ -36,6 +36,7 @@ enum StarMode { MODE_STARFIELD = 0, MODE_PHOTO = 1 };
 
 class CStarCamera;
 class CStarCloseup;
+class FPose;
 class CString;
 class CSurfaceArea;
 class SimpleFile;
@@ -74,6 +75,17 @@ struct CStarPosition : public Common::Point {
  */
 class CBaseStars {
 private:
+	/**
+	 * The stars as transformed by the last pose they were drawn with, and
+	 * their squared distances to the camera
+	 */
+	Common::Array<double> _viewX, _viewY, _viewZ, _viewDist2;
+private:
+	/**
+	 * Transforms all the stars by the given pose
+	 */
+	void transformStars(const FPose &pose);
+
 	void draw1(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup);
 	void draw2(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup);
 	void draw3(CSurfaceArea *surfaceArea, CStarCamera *camera, CStarCloseup *closeup);
@@ -252,6 +252,7 @@ RMGfxWoodyBuffer::RMGfxWoodyBuffer(int dimx, int dimy)
 RMGfxTargetBuffer::RMGfxTargetBuffer() {
 	_otlist = NULL;
 	_otSize = 0;
+	_nDrawOT = 0;
 	_trackDirtyRects = false;
 }
 
@@ -286,6 +287,8 @@ void RMGfxTargetBuffer::drawOT(CORO_PARAM) {
 
 	CORO_BEGIN_CODE(_ctx);
 
+	_nDrawOT++;
+
 	_ctx->prev = NULL;
 	_ctx->cur = _otlist;
 
@@ -324,6 +327,10 @@ void RMGfxTargetBuffer::drawOT(CORO_PARAM) {
 	CORO_END_CODE;
 }
 
+uint32 RMGfxTargetBuffer::getDrawOTCount() const {
+	return _nDrawOT;
+}
+
 void RMGfxTargetBuffer::addPrim(RMGfxPrimitive *prim) {
 	int nPrior;
 	OTList *cur, *n;
@@ -457,6 +457,7 @@ private:
 protected:
 	OTList *_otlist;
 	int _otSize;
+	uint32 _nDrawOT;
 
 public:
 	RMGfxTargetBuffer();
@@ -471,6 +472,9 @@ public:
 	void drawOT(CORO_PARAM);
 	void addPrim(RMGfxPrimitive *prim); // The pointer must be delted
 
+	// Number of times the OT list has been drawn
+	uint32 getDrawOTCount() const;
+
 	operator byte *();
 	operator void *();
 	operator uint16 *();
@@ -868,8 +868,10 @@ void RMWipe::draw(CORO_PARAM, RMGfxTargetBuffer &bigBuf, RMGfxPrimitive *prim) {
 		CORO_INVOKE_2(_wip0r.draw, bigBuf, prim);
 	}
 
-	if (_bEndFade)
+	if (_bEndFade) {
 		Common::fill((byte *)bigBuf, (byte *)bigBuf + bigBuf.getDimx() * bigBuf.getDimy() * 2, 0x0);
+		bigBuf.addDirtyRect(Common::Rect(bigBuf.getDimx(), bigBuf.getDimy()));
+	}
 
 	CORO_END_CODE;
 }
@@ -1871,6 +1873,7 @@ RMLocation::RMLocation() {
 	_buf = NULL;
 	TEMPNumLoc = 0;
 	_cmode = CM_256;
+	_nLastDrawOT = 0;
 }
 
 RMPoint RMLocation::TEMPGetTonyStart() {
@@ -1893,6 +1896,7 @@ bool RMLocation::load(Common::SeekableReadStream &ds) {
 	// Reset dirty rectangling
 	_prevScroll.set(-1, -1);
 	_prevFixedScroll.set(-1, -1);
+	_nLastDrawOT = 0;
 
 	// Check the ID
 	ds.read(id, 3);
@@ -2012,8 +2016,14 @@ void RMLocation::draw(CORO_PARAM, RMGfxTargetBuffer &bigBuf, RMGfxPrimitive *pri
 	CORO_BEGIN_CONTEXT;
 		bool priorTracking;
 		bool hasChanges;
+		Common::List<Common::Rect> rects;
+		Common::List<Common::Rect>::iterator i;
+		RMGfxPrimitive *restorePrim;
 	CORO_END_CONTEXT(_ctx);
 
+	RMPoint srcOrigin;
+	Common::Rect visible;
+
 	CORO_BEGIN_CODE(_ctx);
 
 	// Set the position of the source scrolling
@@ -2029,8 +2039,45 @@ void RMLocation::draw(CORO_PARAM, RMGfxTargetBuffer &bigBuf, RMGfxPrimitive *pri
 	_ctx->hasChanges = (_prevScroll != _curScroll) || (_prevFixedScroll != _fixedScroll);
 	bigBuf.setTrackDirtyRects(_ctx->priorTracking && _ctx->hasChanges);
 
-	// Invoke the drawing method fo the image class, which will draw the location background
-	CORO_INVOKE_2(_buf->draw, bigBuf, prim);
+	if (_ctx->priorTracking && !_ctx->hasChanges && _nLastDrawOT != 0 && _nLastDrawOT + 1 == bigBuf.getDrawOTCount()) {
+		// The whole picture was in the buffer after the previous frame, and everything
+		// drawn since then is in the dirty rects, so only those parts need restoring
+		_ctx->rects = bigBuf.getDirtyRects();
+
+		for (_ctx->i = _ctx->rects.begin(); _ctx->i != _ctx->rects.end(); ++_ctx->i) {
+			if (prim->haveSrc()) {
+				srcOrigin = prim->getSrc().topLeft();
+				visible = Common::Rect(_fixedScroll._x, _fixedScroll._y, _fixedScroll._x + RM_SX, _fixedScroll._y + RM_SY);
+			} else {
+				srcOrigin.set(0, 0);
+				visible = Common::Rect(_fixedScroll._x, _fixedScroll._y, _fixedScroll._x + _buf->getDimx(), _fixedScroll._y + _buf->getDimy());
+			}
+
+			// The pictures are drawn in pairs of pixels, and nothing narrower than two
+			// pixels is drawn at all, so keep the rects on even coordinates
+			_ctx->i->left &= ~1;
+			_ctx->i->top &= ~1;
+			_ctx->i->right = (_ctx->i->right + 1) & ~1;
+			_ctx->i->bottom = (_ctx->i->bottom + 1) & ~1;
+			_ctx->i->clip(visible);
+			if (_ctx->i->isEmpty())
+				continue;
+
+			srcOrigin._x += _ctx->i->left - _fixedScroll._x;
+			srcOrigin._y += _ctx->i->top - _fixedScroll._y;
+
+			_ctx->restorePrim = new RMGfxPrimitive(this);
+			_ctx->restorePrim->setSrc(RMRect(srcOrigin, srcOrigin + RMPoint(_ctx->i->width(), _ctx->i->height())));
+			_ctx->restorePrim->setDst(RMPoint(_ctx->i->left, _ctx->i->top));
+			CORO_INVOKE_2(_buf->draw, bigBuf, _ctx->restorePrim);
+			delete _ctx->restorePrim;
+		}
+	} else {
+		// Invoke the drawing method fo the image class, which will draw the location background
+		CORO_INVOKE_2(_buf->draw, bigBuf, prim);
+	}
+
+	_nLastDrawOT = bigBuf.getDrawOTCount();
 
 	if (_ctx->hasChanges) {
 		_prevScroll = _curScroll;
@@ -495,6 +495,8 @@ private:
 	RMPoint _prevScroll;     // Previous scroll position
 	RMPoint _prevFixedScroll;
 
+	uint32 _nLastDrawOT;     // OT list draw in which the picture was last drawn
+
 public:
 	// @@@@@@@@@@@@@@@@@@@@@@@
 
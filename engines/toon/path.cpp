@@ -173,6 +173,7 @@ void PathFinding::init(Picture *mask) {
 	_heap->init(500);
 	delete[] _sq;
 	_sq = new uint16[_width * _height];
+	_pathCache.clear();
 }
 
 bool PathFinding::isLikelyWalkable(int16 x, int16 y) {
@@ -209,15 +210,44 @@ bool PathFinding::findClosestWalkingPoint(int16 xx, int16 yy, int16 *fxx, int16
 	if (origY == -1)
 		origY = yy;
 
-	for (int16 y = 0; y < _height; y++) {
-		for (int16 x = 0; x < _width; x++) {
-			if (isWalkable(x, y) && isLikelyWalkable(x, y)) {
-				int32 ndist = (x - xx) * (x - xx) + (y - yy) * (y - yy);
+	const uint8 *mask = _currentMask->getDataPtr();
+
+	// Visit the lines closest to the point first, so that once a point is
+	// found only the parts of the lines which may be closer are left.
+	// Ties are broken by position in the mask, to pick the same point
+	// as scanning the whole mask in order.
+	int32 maxDy = MAX<int32>(ABS<int32>(yy), ABS<int32>(yy - (_height - 1)));
+	for (int32 d = 0; mask && d <= maxDy * 2; d++) {
+		int32 y = (d & 1) ? yy + (d + 1) / 2 : yy - d / 2;
+		if (y < 0 || y >= _height)
+			continue;
+
+		int32 dy2 = (y - yy) * (y - yy);
+		if (currentFound >= 0 && dy2 > dist)
+			break;
+
+		int32 startX = 0;
+		int32 endX = _width - 1;
+		if (currentFound >= 0) {
+			int32 dx = (int32)sqrt((double)(dist - dy2));
+			while (dx * dx > dist - dy2)
+				dx--;
+			while ((dx + 1) * (dx + 1) <= dist - dy2)
+				dx++;
+			startX = MAX<int32>(xx - dx, 0);
+			endX = MIN<int32>(xx + dx, _width - 1);
+		}
+
+		const uint8 *line = mask + y * _width;
+		for (int32 x = startX; x <= endX; x++) {
+			if ((line[x] & 0x1f) && isLikelyWalkable(x, y)) {
+				int32 ndist = (x - xx) * (x - xx) + dy2;
 				int32 ndist2 = (x - origX) * (x - origX) + (y - origY) * (y - origY);
-				if (currentFound < 0 || ndist < dist || (ndist == dist && ndist2 < dist2)) {
+				int32 found = y * _width + x;
+				if (currentFound < 0 || ndist < dist || (ndist == dist && (ndist2 < dist2 || (ndist2 == dist2 && found < currentFound)))) {
 					dist = ndist;
 					dist2 = ndist2;
-					currentFound = y * _width + x;
+					currentFound = found;
 				}
 			}
 		}
@@ -305,7 +335,13 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 		return true;
 	}
 
+	// the same search as a recent one gives the same result
+	bool found;
+	if (findCachedPath(x, y, destx, desty, found))
+		return found;
+
 	// no direct line, we use the standard A* algorithm
+	const uint8 *mask = _currentMask->getDataPtr();
 	memset(_sq , 0, _width * _height * sizeof(uint16));
 	_heap->clear();
 	int16 curX = x;
@@ -330,8 +366,8 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 				if (px != curX || py != curY) {
 					uint16 wei = abs(px - curX) + abs(py - curY);
 
-					if (isWalkable(px, py)) { // walkable ?
-						int32 curPNode = px + py * _width;
+					int32 curPNode = px + py * _width;
+					if (mask && (mask[curPNode] & 0x1f)) { // walkable ?
 						uint32 sum = _sq[curNode] + wei * (1 + (isLikelyWalkable(px, py) ? 5 : 0));
 						if (sum > (uint32)0xFFFF) {
 							warning("PathFinding::findPath sum exceeds maximum representable!");
@@ -358,6 +394,7 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 	if (!_sq[destx + desty * _width]) {
 		// didn't find anything
 		_tempPath.clear();
+		addCachedPath(x, y, destx, desty, false);
 		return false;
 	}
 
@@ -383,7 +420,7 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 			for (int16 py = startY; py <= endY; py++) {
 				if (px != curX || py != curY) {
 					int32 PNode = px + py * _width;
-					if (_sq[PNode] && (isWalkable(px, py))) {
+					if (_sq[PNode] && (mask[PNode] & 0x1f)) {
 						if (_sq[PNode] < bestscore) {
 							bestscore = _sq[PNode];
 							bestX = px;
@@ -412,9 +449,62 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 		curY = bestY;
 	}
 
+	if (retVal)
+		addCachedPath(x, y, destx, desty, true);
+
 	return retVal;
 }
 
+bool PathFinding::findCachedPath(int16 x, int16 y, int16 destX, int16 destY, bool &found) {
+	uint32 maskVersion = _currentMask->getDataVersion();
+
+	for (uint i = 0; i < _pathCache.size(); i++) {
+		const CachedPath &cached = _pathCache[i];
+		if (cached.x != x || cached.y != y || cached.destX != destX || cached.destY != destY)
+			continue;
+
+		// Masks and blocking rects change the costs of the whole search
+		if (cached.maskVersion != maskVersion || cached.numBlockingRects != _numBlockingRects ||
+				memcmp(cached.blockingRects, _blockingRects, sizeof(_blockingRects[0]) * _numBlockingRects))
+			continue;
+
+		debugC(2, kDebugPath, "findPath: reusing cached path");
+
+		found = cached.found;
+		if (found)
+			_tempPath = cached.path;
+
+		// Keep the most recently used paths first
+		if (i > 0) {
+			CachedPath entry = cached;
+			_pathCache.remove_at(i);
+			_pathCache.insert_at(0, entry);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void PathFinding::addCachedPath(int16 x, int16 y, int16 destX, int16 destY, bool found) {
+	if (_pathCache.size() >= kMaxCachedPaths)
+		_pathCache.pop_back();
+
+	CachedPath cached;
+	cached.x = x;
+	cached.y = y;
+	cached.destX = destX;
+	cached.destY = destY;
+	cached.maskVersion = _currentMask->getDataVersion();
+	memcpy(cached.blockingRects, _blockingRects, sizeof(_blockingRects[0]) * _numBlockingRects);
+	cached.numBlockingRects = _numBlockingRects;
+	cached.found = found;
+	if (found)
+		cached.path = _tempPath;
+
+	_pathCache.insert_at(0, cached);
+}
+
 void PathFinding::addBlockingRect(int16 x1, int16 y1, int16 x2, int16 y2) {
 	debugC(1, kDebugPath, "addBlockingRect(%d, %d, %d, %d)", x1, y1, x2, y2);
 	if (_numBlockingRects >= kMaxBlockingRects) {
@@ -79,6 +79,20 @@ public:
 
 private:
 	static const uint8 kMaxBlockingRects = 16;
+	static const uint8 kMaxCachedPaths = 8;
+
+	/** A path found by A*, along with everything its search depended on */
+	struct CachedPath {
+		int16 x, y, destX, destY;
+		uint32 maskVersion;
+		int16 blockingRects[kMaxBlockingRects][5];
+		uint8 numBlockingRects;
+		bool found;
+		Common::Array<Common::Point> path;
+	};
+
+	bool findCachedPath(int16 x, int16 y, int16 destX, int16 destY, bool &found);
+	void addCachedPath(int16 x, int16 y, int16 destX, int16 destY, bool found);
 
 	Picture *_currentMask;
 
@@ -92,6 +106,9 @@ private:
 
 	int16 _blockingRects[kMaxBlockingRects][5];
 	uint8 _numBlockingRects;
+
+	/** Recently found paths, the most recently used first */
+	Common::Array<CachedPath> _pathCache;
 };
 
 } // End of namespace Toon
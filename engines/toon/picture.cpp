@@ -32,6 +32,8 @@ namespace Toon {
 bool Picture::loadPicture(const Common::String &file) {
 	debugC(1, kDebugPicture, "loadPicture(%s)", file.c_str());
 
+	_dataVersion++;
+
 	uint32 size = 0;
 	uint8 *fileData = _vm->resources()->getFileData(file, &size);
 	if (!fileData)
@@ -133,6 +135,7 @@ bool Picture::loadPicture(const Common::String &file) {
 
 Picture::Picture(ToonEngine *vm) : _vm(vm) {
 	_data = NULL;
+	_dataVersion = 0;
 	_palette = NULL;
 
 	_width = 0;
@@ -265,6 +268,7 @@ uint8 Picture::getData(int16 x, int16 y) {
 // use original work from johndoe
 void Picture::floodFillNotWalkableOnMask(int16 x, int16 y) {
 	debugC(1, kDebugPicture, "floodFillNotWalkableOnMask(%d, %d)", x, y);
+	_dataVersion++;
 	// Stack-based floodFill algorithm based on
 	// http://student.kuleuven.be/~m0216922/CG/files/floodfill.cpp
 	Common::Stack<Common::Point> stack;
@@ -297,6 +301,7 @@ void Picture::floodFillNotWalkableOnMask(int16 x, int16 y) {
 
 void Picture::drawLineOnMask(int16 x, int16 y, int16 x2, int16 y2, bool walkable) {
 	debugC(1, kDebugPicture, "drawLineOnMask(%d, %d, %d, %d, %d)", x, y, x2, y2, (walkable) ? 1 : 0);
+	_dataVersion++;
 	static int16 lastX = 0;
 	static int16 lastY = 0;
 
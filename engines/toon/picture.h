@@ -51,10 +51,14 @@ public:
 	int16 getWidth() const { return _width; }
 	int16 getHeight() const { return _height; }
 
+	/** Incremented whenever the data is changed, so users can tell when to refresh what they derived from it */
+	uint32 getDataVersion() const { return _dataVersion; }
+
 protected:
 	int16 _width;
 	int16 _height;
 	uint8 *_data;
+	uint32 _dataVersion;
 	uint8 *_palette; // need to be copied at 3-387
 	int32 _paletteEntries;
 	bool _useFullPalette;
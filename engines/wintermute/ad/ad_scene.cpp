@@ -51,6 +51,7 @@
 #include "engines/wintermute/base/base_region.h"
 #include "engines/wintermute/base/base_scriptable.h"
 #include "engines/wintermute/base/base_sprite.h"
+#include "engines/wintermute/base/base_surface_storage.h"
 #include "engines/wintermute/base/base_viewport.h"
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "engines/wintermute/base/scriptables/script_stack.h"
@@ -550,6 +551,10 @@ bool AdScene::loadFile(const char *filename) {
 
 	if (DID_FAIL(ret = loadBuffer(buffer, true))) {
 		_gameRef->LOG(0, "Error parsing SCENE file '%s'", filename);
+	} else {
+		// Decode the images of the scene while its scripts start up, instead
+		// of on the first frames it is drawn
+		_gameRef->_surfaceStorage->preloadSurfaces();
 	}
 
 	setFilename(filename);
@@ -139,6 +139,21 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 }
 
 
+//////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::preloadSurfaces() {
+	uint32 preloadSize = 0;
+	for (uint32 i = 0; i < _surfaces.size(); i++) {
+		preloadSize += _surfaces[i]->getPreloadSize();
+	}
+
+	for (uint32 i = _surfaces.size(); i-- > 0 && preloadSize < kPreloadMemoryLimit;) {
+		if (_surfaces[i]->startPreload(kPreloadMemoryLimit - preloadSize)) {
+			preloadSize += _surfaces[i]->getPreloadSize();
+		}
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::restoreAll() {
 	bool ret;
@@ -36,6 +36,11 @@ namespace Wintermute {
 class BaseSurface;
 class BaseSurfaceStorage : public BaseClass {
 public:
+	enum {
+		/** The most memory held by preloaded images which were not drawn yet */
+		kPreloadMemoryLimit = 32 * 1024 * 1024
+	};
+
 	uint32 _lastCleanupTime;
 	bool initLoop();
 	bool sortSurfaces();
@@ -46,6 +51,12 @@ public:
 	bool restoreAll();
 	BaseSurface *addSurface(const Common::String &filename, bool defaultCK = true, byte ckRed = 0, byte ckGreen = 0, byte ckBlue = 0, int lifeTime = -1, bool keepLoaded = false);
 	bool removeSurface(BaseSurface *surface);
+	/**
+	 * Start decoding the images of the surfaces which were not drawn yet in
+	 * the background, starting with the last added, to be called once a scene
+	 * has been loaded.
+	 */
+	void preloadSurfaces();
 	BaseSurfaceStorage(BaseGame *inGame);
 	virtual ~BaseSurfaceStorage();
 
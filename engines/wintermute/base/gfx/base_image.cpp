@@ -59,34 +59,58 @@ BaseImage::~BaseImage() {
 	delete _deletableSurface;
 }
 
+Image::ImageDecoder *BaseImage::createDecoder(const Common::String &filename) {
+	Common::String lowerName = filename;
+	lowerName.toLowercase();
+	if (filename.hasPrefix("savegame:") || lowerName.hasSuffix(".bmp")) {
+		return new Image::BitmapDecoder();
+	} else if (lowerName.hasSuffix(".png")) {
+		return new Image::PNGDecoder();
+	} else if (lowerName.hasSuffix(".tga")) {
+		return new Image::TGADecoder();
+	} else if (lowerName.hasSuffix(".jpg")) {
+		return new Image::JPEGDecoder();
+	}
+	return nullptr;
+}
+
+bool BaseImage::isSupportedFile(const Common::String &filename) {
+	Image::ImageDecoder *decoder = createDecoder(filename);
+	delete decoder;
+	return decoder != nullptr;
+}
+
 bool BaseImage::loadFile(const Common::String &filename) {
-	_filename = filename;
-	_filename.toLowercase();
-	if (filename.hasPrefix("savegame:") || _filename.hasSuffix(".bmp")) {
-		_decoder = new Image::BitmapDecoder();
-	} else if (_filename.hasSuffix(".png")) {
-		_decoder = new Image::PNGDecoder();
-	} else if (_filename.hasSuffix(".tga")) {
-		_decoder = new Image::TGADecoder();
-	} else if (_filename.hasSuffix(".jpg")) {
-		_decoder = new Image::JPEGDecoder();
-	} else {
+	if (!isSupportedFile(filename)) {
 		error("BaseImage::loadFile : Unsupported fileformat %s", filename.c_str());
 	}
-	_filename = filename;
 	Common::SeekableReadStream *file = _fileManager->openFile(filename.c_str());
 	if (!file) {
+		_filename = filename;
 		return false;
 	}
 
-	_decoder->loadStream(*file);
-	_surface = _decoder->getSurface();
-	_palette = _decoder->getPalette();
+	loadStream(filename, *file);
 	_fileManager->closeFile(file);
 
 	return true;
 }
 
+bool BaseImage::loadStream(const Common::String &filename, Common::SeekableReadStream &stream) {
+	_filename = filename;
+	delete _decoder;
+	_decoder = createDecoder(filename);
+	if (!_decoder) {
+		return false;
+	}
+
+	const bool loaded = _decoder->loadStream(stream);
+	_surface = _decoder->getSurface();
+	_palette = _decoder->getPalette();
+
+	return loaded;
+}
+
 byte BaseImage::getAlphaAt(int x, int y) const {
 	if (!_surface) {
 		return 0xFF;
@@ -49,6 +49,13 @@ public:
 	~BaseImage();
 
 	bool loadFile(const Common::String &filename);
+	/**
+	 * Decode an image which was read already, in the format its filename
+	 * tells. Does not use the file manager, so it can run on any thread.
+	 */
+	bool loadStream(const Common::String &filename, Common::SeekableReadStream &stream);
+	/** Whether loadFile() and loadStream() know the format of filename */
+	static bool isSupportedFile(const Common::String &filename);
 	const Graphics::Surface *getSurface() const {
 		return _surface;
 	};
@@ -62,6 +69,7 @@ public:
 	bool copyFrom(BaseImage *origImage, int newWidth = 0, int newHeight = 0);
 	void copyFrom(const Graphics::Surface *surface);
 private:
+	static Image::ImageDecoder *createDecoder(const Common::String &filename);
 	Common::String _filename;
 	Image::ImageDecoder *_decoder;
 	const Graphics::Surface *_surface;
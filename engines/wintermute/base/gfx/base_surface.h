@@ -63,6 +63,18 @@ public:
 	virtual bool putSurface(const Graphics::Surface &surface, bool hasAlpha = false) {
 		return STATUS_FAILED;
 	}
+	/**
+	 * Start decoding the image file in the background, before the surface
+	 * is first drawn.
+	 * @return whether anything was started
+	 */
+	virtual bool startPreload(uint32 maxSize) {
+		return false;
+	}
+	/** The memory taken by a preload that was not picked up yet */
+	virtual uint32 getPreloadSize() const {
+		return 0;
+	}
 	virtual bool putPixel(int x, int y, byte r, byte g, byte b, int a = -1);
 	virtual bool getPixel(int x, int y, byte *r, byte *g, byte *b, byte *a = nullptr);
 	virtual bool comparePixel(int x, int y, byte r, byte g, byte b, int a = -1);
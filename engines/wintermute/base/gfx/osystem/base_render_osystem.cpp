@@ -157,6 +157,7 @@ bool BaseRenderOSystem::flip() {
 		delete _dirtyRect;
 		_dirtyRect = nullptr;
 		g_system->updateScreen();
+		_frameArena.reset();
 		_needsFlip = false;
 
 		// Reset ticketing state
@@ -165,6 +166,7 @@ bool BaseRenderOSystem::flip() {
 		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 			(*it)->_wantsDraw = false;
 		}
+		indexLastFrameTickets();
 
 		addDirtyRect(_renderRect);
 		return true;
@@ -200,8 +202,10 @@ bool BaseRenderOSystem::flip() {
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
+	indexLastFrameTickets();
 
 	g_system->updateScreen();
+	_frameArena.reset();
 
 	return STATUS_OK;
 }
@@ -271,7 +275,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform, &_frameArena, &_transformCache);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -285,25 +289,23 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
+		// All the tickets after _lastFrameIter are in the index, so this finds
+		// the first matching one of them without going through LOTS of tickets.
+		TicketIndex::iterator candidates = _lastFrameTickets.find(compare.hash());
+		if (candidates != _lastFrameTickets.end()) {
+			Common::Array<RenderQueueIterator> &tickets = candidates->_value;
+			for (uint i = 0; i < tickets.size(); i++) {
+				RenderTicket *compareTicket = *tickets[i];
+				if (*(compareTicket) == compare && compareTicket->_isValid) {
+					RenderQueueIterator it = tickets[i];
+					tickets.remove_at(i);
 					drawFromQueuedTicket(it);
+					return;
 				}
-				return;
 			}
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform, &_frameArena, &_transformCache);
 	if (!_disableDirtyRects) {
 		drawFromTicket(ticket);
 	} else {
@@ -320,6 +322,8 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	_transformCache.invalidate(surf);
+
 	RenderQueueIterator it;
 	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		if ((*it)->_owner == surf) {
@@ -364,6 +368,20 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+void BaseRenderOSystem::indexLastFrameTickets() {
+	_lastFrameTickets.clear();
+	// Without dirty rects the queue only holds this frame's tickets
+	if (_disableDirtyRects) {
+		return;
+	}
+
+	for (RenderQueueIterator it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		if ((*it)->_owner) {
+			_lastFrameTickets[(*it)->hash()].push_back(it);
+		}
+	}
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
 	if (!_dirtyRect) {
 		_dirtyRect = new Common::Rect(rect);
@@ -399,21 +417,23 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+	// If an OPAQUE ticket covers all of the dirty rect, everything drawn before it
+	// would be painted over, so we skip filling the background color and start with
+	// the last such ticket. Typical use-cases: Fullscreen FMVs and backgrounds.
+	RenderQueueIterator first = _renderQueue.end();
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		if ((*it)->coversOpaquely(*_dirtyRect)) {
+			first = it;
 		}
-		// Otherwise Do NOT fill.
-	} else {
+	}
+	if (first == _renderQueue.end()) {
 		// Apply the clear-color to the dirty rect.
 		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		first = _renderQueue.begin();
+	}
+	for (it = _renderQueue.begin(); it != first; ++it) {
+		(*it)->_wantsDraw = false;
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
@@ -575,6 +595,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	// so just skip this single frame.
 	_skipThisFrame = true;
 	_lastFrameIter = _renderQueue.end();
+	_lastFrameTickets.clear();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
@@ -32,7 +32,11 @@
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
+#include "common/framearena.h"
+#include "graphics/transform_cache.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
@@ -126,8 +130,23 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
+	/**
+	 * Start matching the draw-calls of the next frame against all tickets
+	 * currently in the queue.
+	 */
+	void indexLastFrameTickets();
 	Common::Rect *_dirtyRect;
 	Common::List<RenderTicket *> _renderQueue;
+	typedef Common::HashMap<uint, Common::Array<RenderQueueIterator> > TicketIndex;
+	/**
+	 * The tickets of the last frame which were not drawn again yet, by
+	 * RenderTicket::hash(), in queue order
+	 */
+	TicketIndex _lastFrameTickets;
+	/** Memory for temporary copies made while creating tickets, reset with every flip() */
+	Common::FrameArena _frameArena;
+	/** Scaled and rotated surfaces, shared between frames */
+	Graphics::TransformCache _transformCache;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
@@ -39,6 +39,7 @@
 #include "graphics/surface.h"
 #include "common/stream.h"
 #include "common/system.h"
+#include "common/taskscheduler.h"
 
 namespace Wintermute {
 
@@ -51,10 +52,13 @@ BaseSurfaceOSystem::BaseSurfaceOSystem(BaseGame *inGame) : BaseSurface(inGame) {
 	_lockPitch = 0;
 	_loaded = false;
 	_rotation = 0;
+	_generation = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
 BaseSurfaceOSystem::~BaseSurfaceOSystem() {
+	delete finishPreload();
+
 	if (_surface) {
 		_surface->free();
 		delete _surface;
@@ -131,15 +135,99 @@ bool BaseSurfaceOSystem::create(const Common::String &filename, bool defaultCK,
 	return STATUS_OK;
 }
 
-bool BaseSurfaceOSystem::finishLoad() {
-	BaseImage *image = new BaseImage();
-	if (!image->loadFile(_filename)) {
-		delete image;
+class BaseSurfaceOSystem::PreloadTask : public Common::Task {
+public:
+	PreloadTask(const Common::String &filename, Preload &preload) : _filename(filename.c_str()), _preload(preload) {}
+
+	virtual void run() {
+		_preload.decoded = _preload.image->loadStream(_filename, *_preload.data);
+		delete _preload.data;
+		_preload.data = nullptr;
+
+		// The image now shares the buffer. The task may be destroyed after
+		// the engine thread took the image, so drop the reference here.
+		_filename.clear();
+	}
+
+private:
+	// Not shared with the surface, as string copies share a reference count
+	// which is not thread-safe
+	Common::String _filename;
+	Preload &_preload;
+};
+
+bool BaseSurfaceOSystem::startPreload(uint32 maxSize) {
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (_loaded || _preload.future.isValid() || scheduler->isSerial() ||
+		_filename.hasPrefix("savegame:") || !BaseImage::isSupportedFile(_filename)) {
+		return false;
+	}
+
+	// The file is read here, as the file manager must only be used by the
+	// engine thread
+	Common::SeekableReadStream *file = BaseFileManager::getEngineInstance()->openFile(_filename);
+	if (!file) {
+		return false;
+	}
+	const uint32 size = file->size();
+	if (size <= maxSize) {
+		_preload.data = file->readStream(size);
+	}
+	BaseFileManager::getEngineInstance()->closeFile(file);
+	if (!_preload.data) {
 		return false;
 	}
 
+	_preload.dataSize = size;
+	_preload.image = new BaseImage();
+	_preload.future = scheduler->schedule(new PreloadTask(_filename, _preload));
+	return true;
+}
+
+uint32 BaseSurfaceOSystem::getPreloadSize() const {
+	if (!_preload.future.isValid()) {
+		return 0;
+	}
+	// Until it is decoded, the file is held
+	if (!_preload.future.isDone() || !_preload.decoded) {
+		return _preload.dataSize;
+	}
+	const Graphics::Surface *surface = _preload.image->getSurface();
+	return surface ? surface->pitch * surface->h : 0;
+}
+
+BaseImage *BaseSurfaceOSystem::finishPreload() {
+	if (!_preload.future.isValid()) {
+		return nullptr;
+	}
+
+	_preload.future.wait();
+	_preload.future = Common::TaskFuture();
+	BaseImage *image = _preload.image;
+	_preload.image = nullptr;
+	delete _preload.data;
+	_preload.data = nullptr;
+
+	if (!_preload.decoded || !image->getSurface()) {
+		delete image;
+		return nullptr;
+	}
+	return image;
+}
+
+bool BaseSurfaceOSystem::finishLoad() {
+	BaseImage *image = finishPreload();
+	if (!image) {
+		image = new BaseImage();
+		if (!image->loadFile(_filename)) {
+			delete image;
+			return false;
+		}
+	}
+
 	_width = image->getSurface()->w;
 	_height = image->getSurface()->h;
+	_generation++;
 
 	bool isSaveGameGrayscale = _filename.matchString("savegame:*g", true);
 	if (isSaveGameGrayscale) {
@@ -342,6 +430,7 @@ bool BaseSurfaceOSystem::startPixelOp() {
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::endPixelOp() {
 	//SDL_UnlockTexture(_texture);
+	_generation++;
 	return STATUS_OK;
 }
 
@@ -476,6 +565,7 @@ bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAl
 	} else {
 		_alphaType = Graphics::ALPHA_OPAQUE;
 	}
+	_generation++;
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 
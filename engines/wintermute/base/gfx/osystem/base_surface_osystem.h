@@ -33,6 +33,7 @@
 #include "graphics/transparent_surface.h"
 #include "engines/wintermute/base/gfx/base_surface.h"
 #include "common/list.h"
+#include "common/taskscheduler.h"
 
 namespace Wintermute {
 struct TransparentSurface;
@@ -60,6 +61,8 @@ public:
 	bool displayTransform(int x, int y, Rect32 rect, Rect32 newRect, const Graphics::TransformStruct &transform) override;
 	virtual bool displayTiled(int x, int y, Rect32 rect, int numTimesX, int numTimesY);
 	virtual bool putSurface(const Graphics::Surface &surface, bool hasAlpha = false) override;
+	bool startPreload(uint32 maxSize) override;
+	uint32 getPreloadSize() const override;
 	/*  static unsigned DLL_CALLCONV ReadProc(void *buffer, unsigned size, unsigned count, fi_handle handle);
 	    static int DLL_CALLCONV SeekProc(fi_handle handle, long offset, int origin);
 	    static long DLL_CALLCONV TellProc(fi_handle handle);*/
@@ -83,15 +86,38 @@ public:
 	}
 
 	Graphics::AlphaType getAlphaType() const { return _alphaType; }
+	/** Changes whenever the pixels of the surface change */
+	uint32 getGeneration() const { return _generation; }
 private:
+	class PreloadTask;
+
+	/** An image file being decoded before the surface is first drawn */
+	struct Preload {
+		Common::SeekableReadStream *data;
+		uint32 dataSize;
+		BaseImage *image;
+		bool decoded;
+		Common::TaskFuture future;
+
+		Preload() : data(nullptr), dataSize(0), image(nullptr), decoded(false) {}
+	};
+
+	/**
+	 * Wait for the preload and return the image if it was decoded,
+	 * or nullptr.
+	 */
+	BaseImage *finishPreload();
+
 	Graphics::Surface *_surface;
 	bool _loaded;
+	Preload _preload;
 	bool finishLoad();
 	bool drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect, Graphics::TransformStruct transformStruct);
 	void genAlphaMask(Graphics::Surface *surface);
 	uint32 getPixelAt(Graphics::Surface *surface, int x, int y);
 
 	uint32 _rotation;
+	uint32 _generation;
 	Graphics::AlphaType _alphaType;
 	void *_lockPixels;
 	int _lockPitch;
@@ -31,11 +31,12 @@
 #include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 #include "engines/wintermute/base/gfx/osystem/base_surface_osystem.h"
 #include "graphics/transform_tools.h"
+#include "common/framearena.h"
 #include "common/textconsole.h"
 
 namespace Wintermute {
 
-RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform) :
+RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform, Common::FrameArena *arena, Graphics::TransformCache *cache) :
 	_owner(owner),
 	_srcRect(*srcRect),
 	_dstRect(*dstRect),
@@ -43,8 +44,34 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	_wantsDraw(true),
 	_transform(transform) {
 	if (surf) {
+		const bool rotate = _transform._angle != Graphics::kDefaultAngle;
+		const bool scale = (dstRect->width() != srcRect->width() ||
+							dstRect->height() != srcRect->height()) &&
+							_transform._numTimesX * _transform._numTimesY == 1;
+
+		if (cache && owner && (rotate || scale)) {
+			const Graphics::TFilteringMode filteringMode = owner->_gameRef->getBilinearFiltering() ? Graphics::FILTER_BILINEAR : Graphics::FILTER_NEAREST;
+			Graphics::TransparentSurface src(*surf, false);
+			if (rotate) {
+				_cachedSurface = cache->rotoscale(src, *srcRect, owner, owner->getGeneration(), transform, filteringMode);
+			} else {
+				_cachedSurface = cache->scale(src, *srcRect, owner, owner->getGeneration(), dstRect->width(), dstRect->height(), filteringMode);
+			}
+			_surface = _cachedSurface.get();
+			return;
+		}
+
+		// A copy which is only the input of the scaling below can live in
+		// the renderer's frame arena
+		const bool temporary = arena && (rotate || scale);
+
 		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+		if (temporary) {
+			const int pitch = srcRect->width() * surf->format.bytesPerPixel;
+			_surface->init((uint16)srcRect->width(), (uint16)srcRect->height(), pitch, arena->allocate(pitch * srcRect->height()), surf->format);
+		} else {
+			_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+		}
 		assert(_surface->format.bytesPerPixel == 4);
 		// Get a clipped copy of the surface
 		for (int i = 0; i < _surface->h; i++) {
@@ -58,7 +85,7 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
-		if (_transform._angle != Graphics::kDefaultAngle) {
+		if (rotate) {
 			Graphics::TransparentSurface src(*_surface, false);
 			Graphics::Surface *temp;
 			if (owner->_gameRef->getBilinearFiltering()) {
@@ -66,12 +93,11 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 			} else {
 				temp = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
 			}
-			_surface->free();
+			if (!temporary)
+				_surface->free();
 			delete _surface;
 			_surface = temp;
-		} else if ((dstRect->width() != srcRect->width() ||
-					dstRect->height() != srcRect->height()) &&
-					_transform._numTimesX * _transform._numTimesY == 1) {
+		} else if (scale) {
 			Graphics::TransparentSurface src(*_surface, false);
 			Graphics::Surface *temp;
 			if (owner->_gameRef->getBilinearFiltering()) {
@@ -79,7 +105,8 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 			} else {
 				temp = src.scaleT<Graphics::FILTER_NEAREST>(dstRect->width(), dstRect->height());
 			}
-			_surface->free();
+			if (!temporary)
+				_surface->free();
 			delete _surface;
 			_surface = temp;
 		}
@@ -89,7 +116,7 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
+	if (_surface && !_cachedSurface) {
 		_surface->free();
 		delete _surface;
 	}
@@ -106,6 +133,28 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+uint RenderTicket::hash() const {
+	uint hash = (uint)(size_t)_owner;
+	hash = hash * 31 + (_srcRect.left | (_srcRect.top << 16));
+	hash = hash * 31 + (_srcRect.right | (_srcRect.bottom << 16));
+	hash = hash * 31 + (_dstRect.left | (_dstRect.top << 16));
+	hash = hash * 31 + (_dstRect.right | (_dstRect.bottom << 16));
+	hash = hash * 31 + _transform._angle;
+	return hash * 31 + _transform._rgbaMod;
+}
+
+bool RenderTicket::coversOpaquely(const Common::Rect &rect) const {
+	// Only the plain opaque copy of drawToSurface() writes every pixel
+	return _owner && _surface &&
+		_transform._alphaDisable &&
+		_transform._angle == Graphics::kDefaultAngle &&
+		_transform._rgbaMod == Graphics::kDefaultRgbaMod &&
+		_transform._blendMode == Graphics::BLEND_NORMAL &&
+		_transform._numTimesX * _transform._numTimesY == 1 &&
+		_surface->w == _dstRect.width() && _surface->h == _dstRect.height() &&
+		_dstRect.contains(rect);
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
@@ -29,10 +29,15 @@
 #ifndef WINTERMUTE_RENDER_TICKET_H
 #define WINTERMUTE_RENDER_TICKET_H
 
+#include "graphics/transform_cache.h"
 #include "graphics/transparent_surface.h"
 #include "graphics/surface.h"
 #include "common/rect.h"
 
+namespace Common {
+class FrameArena;
+}
+
 namespace Wintermute {
 
 class BaseSurfaceOSystem;
@@ -51,7 +56,13 @@ class BaseSurfaceOSystem;
  */
 class RenderTicket {
 public:
-	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
+	/**
+	 * @param arena	if given, temporary copies made while scaling or rotating
+	 *				are taken from it; it must not be reset during the call
+	 * @param cache	if given, scaled and rotated surfaces are shared with
+	 *				earlier tickets drawing the same part of the same surface
+	 */
+	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform, Common::FrameArena *arena = nullptr, Graphics::TransformCache *cache = nullptr);
 	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
 	~RenderTicket();
 	const Graphics::Surface *getSurface() const { return _surface; }
@@ -69,9 +80,18 @@ public:
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/** A hash of what operator== compares */
+	uint hash() const;
+	/**
+	 * Whether drawing the ticket replaces every pixel of rect, so that
+	 * whatever was drawn there before does not show.
+	 */
+	bool coversOpaquely(const Common::Rect &rect) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
 	Graphics::Surface *_surface;
+	/** Holds _surface if it came from the transform cache */
+	Graphics::TransformCache::SurfacePtr _cachedSurface;
 	Common::Rect _srcRect;
 };
 
@@ -261,8 +261,20 @@ bool PartEmitter::update() {
 bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
 	int numLive = 0;
 
+	Vector2 globalForce(0.0f, 0.0f);
+	for (uint32 i = 0; i < _forces.size(); i++) {
+		if (_forces[i]->_type == PartForce::FORCE_GLOBAL) {
+			globalForce += _forces[i]->_direction;
+		}
+	}
+
 	for (uint32 i = 0; i < _particles.size(); i++) {
-		_particles[i]->update(this, currentTime, timerDelta);
+		// dead particles stay dead until they are reinitialized
+		if (_particles[i]->_isDead) {
+			continue;
+		}
+
+		_particles[i]->update(this, currentTime, timerDelta, globalForce);
 
 		if (!_particles[i]->_isDead) {
 			numLive++;
@@ -282,18 +294,16 @@ bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
 			}
 
 			int toGen = MIN(_genAmount, _maxParticles - numLive);
+			// the slots before the last reused one hold no dead particles
+			uint32 deadIndex = 0;
 			while (toGen > 0) {
-				int firstDeadIndex = -1;
-				for (uint32 i = 0; i < _particles.size(); i++) {
-					if (_particles[i]->_isDead) {
-						firstDeadIndex = i;
-						break;
-					}
+				while (deadIndex < _particles.size() && !_particles[deadIndex]->_isDead) {
+					deadIndex++;
 				}
 
 				PartParticle *particle;
-				if (firstDeadIndex >= 0) {
-					particle = _particles[firstDeadIndex];
+				if (deadIndex < _particles.size()) {
+					particle = _particles[deadIndex];
 				} else {
 					particle = new PartParticle(_gameRef);
 					_particles.add(particle);
@@ -326,6 +336,10 @@ bool PartEmitter::display(BaseRegion *region) {
 	}
 
 	for (uint32 i = 0; i < _particles.size(); i++) {
+		if (_particles[i]->_isDead) {
+			continue;
+		}
+
 		if (region != nullptr && _useRegion) {
 			if (!region->pointInRegion((int)_particles[i]->_pos.x, (int)_particles[i]->_pos.y)) {
 				continue;
@@ -93,7 +93,7 @@ bool PartParticle::setSprite(const Common::String &filename) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta) {
+bool PartParticle::update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta, const Vector2 &globalForce) {
 	if (_state == PARTICLE_FADEIN) {
 		if (currentTime - _fadeStart >= (uint32)_fadeTime) {
 			_state = PARTICLE_NORMAL;
@@ -148,23 +148,21 @@ bool PartParticle::update(PartEmitter *emitter, uint32 currentTime, uint32 timer
 		// update position
 		float elapsedTime = (float)timerDelta / 1000.f;
 
+		// the global forces are the same for every particle and come summed up
+		_velocity += globalForce * elapsedTime;
+
 		for (uint32 i = 0; i < emitter->_forces.size(); i++) {
 			PartForce *force = emitter->_forces[i];
-			switch (force->_type) {
-			case PartForce::FORCE_GLOBAL:
-				_velocity += force->_direction * elapsedTime;
-				break;
+			if (force->_type != PartForce::FORCE_POINT) {
+				continue;
+			}
 
-			case PartForce::FORCE_POINT: {
-				Vector2 vecDist = force->_pos - _pos;
-				float dist = fabs(vecDist.length());
+			Vector2 vecDist = force->_pos - _pos;
+			float dist = fabs(vecDist.length());
 
-				dist = 100.0f / dist;
+			dist = 100.0f / dist;
 
-				_velocity += force->_direction * dist * elapsedTime;
-			}
-			break;
-			}
+			_velocity += force->_direction * dist * elapsedTime;
 		}
 		_pos += _velocity * elapsedTime;
 
@@ -69,7 +69,7 @@ public:
 	bool _isDead;
 	TParticleState _state;
 
-	bool update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta);
+	bool update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta, const Vector2 &globalForce);
 	bool display(PartEmitter *emitter);
 
 	bool setSprite(const Common::String &filename);
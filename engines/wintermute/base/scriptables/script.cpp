@@ -49,6 +49,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_varCache = nullptr;
 
 	_engine = engine;
 
@@ -175,6 +176,9 @@ bool ScScript::initTables() {
 		uint32 index = getDWORD();
 		_symbols[index] = getString();
 	}
+	delete[] _varCache;
+	_varCache = new VarCacheEntry[_numSymbols];
+	memset(_varCache, 0, _numSymbols * sizeof(VarCacheEntry));
 
 	// load functions table
 	_iP = _header.funcTable;
@@ -398,6 +402,9 @@ void ScScript::cleanup() {
 	_symbols = nullptr;
 	_numSymbols = 0;
 
+	delete[] _varCache;
+	_varCache = nullptr;
+
 	if (_globals && !_thread) {
 		delete _globals;
 	}
@@ -697,7 +704,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -708,15 +715,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getSymbolVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -769,7 +775,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getSymbolVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -1132,23 +1138,17 @@ ScValue *ScScript::getVar(char *name) {
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
-		}
+		ret = _scopeStack->getTop()->findProp(name);
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
-		}
+		ret = _globals->findProp(name);
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
-		}
+		ret = _engine->_globals->findProp(name);
 	}
 
 	if (ret == nullptr) {
@@ -1170,6 +1170,41 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Whether the properties of val are all that getVar() looks at
+static bool holdsPlainVars(ScValue *val) {
+	return val->_type != VAL_VARIABLE_REF && val->_type != VAL_STRING && val->_type != VAL_NATIVE;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getSymbolVar(uint32 symbol) {
+	ScValue *scope = _scopeStack->_sP >= 0 ? _scopeStack->getTop() : nullptr;
+	const bool cacheable = (!scope || holdsPlainVars(scope)) && holdsPlainVars(_globals) && holdsPlainVars(_engine->_globals);
+
+	VarCacheEntry &entry = _varCache[symbol];
+	if (cacheable && entry.var && entry.scope == scope &&
+		entry.scopeGeneration == (scope ? scope->getPropsGeneration() : 0) &&
+		entry.globalsGeneration == _globals->getPropsGeneration() &&
+		entry.engineGlobalsGeneration == _engine->_globals->getPropsGeneration()) {
+		return entry.var;
+	}
+
+	ScValue *var = getVar(_symbols[symbol]);
+
+	// Taken after getVar(), which may have created the variable
+	if (cacheable) {
+		entry.var = var;
+		entry.scope = scope;
+		entry.scopeGeneration = scope ? scope->getPropsGeneration() : 0;
+		entry.globalsGeneration = _globals->getPropsGeneration();
+		entry.engineGlobalsGeneration = _engine->_globals->getPropsGeneration();
+	} else {
+		entry.var = nullptr;
+	}
+
+	return var;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
@@ -1264,6 +1299,7 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 			persistMgr->transferSint32(TMEMBER(bufferSize));
 		}
 	} else {
+		_varCache = nullptr;
 		persistMgr->transferUint32(TMEMBER(_bufferSize));
 		if (_bufferSize > 0) {
 			_buffer = new byte[_bufferSize];
@@ -80,6 +80,8 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	/** getVar() of a symbol of the script, remembering where it was found */
+	ScValue *getSymbolVar(uint32 symbol);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -151,8 +153,22 @@ public:
 	ScScript::TExternalFunction *getExternal(char *name);
 	bool externalCall(ScStack *stack, ScStack *thisStack, ScScript::TExternalFunction *function);
 private:
+	/**
+	 * Where getSymbolVar() found a variable, valid as long as the scope,
+	 * the script globals and the engine globals have the same generations
+	 * and so the same properties.
+	 */
+	struct VarCacheEntry {
+		ScValue *var;
+		ScValue *scope;
+		uint32 scopeGeneration;
+		uint32 globalsGeneration;
+		uint32 engineGlobalsGeneration;
+	};
+
 	char **_symbols;
 	uint32 _numSymbols;
+	VarCacheEntry *_varCache; ///< One for each symbol
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
 	TEventPos *_events;
@@ -40,7 +40,15 @@ namespace Wintermute {
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-IMPLEMENT_PERSISTENT(ScValue, false)
+IMPLEMENT_PERSISTENT_POOLED(ScValue, false)
+
+// Starts with 1, so that 0 is never a valid generation
+static uint32 s_propsGeneration = 0;
+
+//////////////////////////////////////////////////////////////////////////
+void ScValue::propsChanged() {
+	_propsGeneration = ++s_propsGeneration;
+}
 
 //////////////////////////////////////////////////////////////////////////
 ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
@@ -54,6 +62,7 @@ ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	propsChanged();
 }
 
 
@@ -69,6 +78,7 @@ ScValue::ScValue(BaseGame *inGame, bool val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	propsChanged();
 }
 
 
@@ -84,6 +94,7 @@ ScValue::ScValue(BaseGame *inGame, int32 val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	propsChanged();
 }
 
 
@@ -99,6 +110,7 @@ ScValue::ScValue(BaseGame *inGame, double val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	propsChanged();
 }
 
 
@@ -115,6 +127,7 @@ ScValue::ScValue(BaseGame *inGame, const char *val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	propsChanged();
 }
 
 
@@ -191,6 +204,20 @@ ScValue *ScValue::getProp(const char *name) {
 	return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::findProp(const char *name) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->findProp(name);
+	}
+
+	if (_type == VAL_STRING || (_type == VAL_NATIVE && _valNative)) {
+		return propExists(name) ? getProp(name) : nullptr;
+	}
+
+	_valIter = _valObject.find(name);
+	return _valIter != _valObject.end() ? _valIter->_value : nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::deleteProp(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
@@ -201,6 +228,7 @@ bool ScValue::deleteProp(const char *name) {
 	if (_valIter != _valObject.end()) {
 		delete _valIter->_value;
 		_valIter->_value = nullptr;
+		propsChanged();
 	}
 
 	return STATUS_OK;
@@ -226,7 +254,8 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 		if (_valIter != _valObject.end()) {
 			newVal = _valIter->_value;
 		}
-		if (!newVal) {
+		const bool created = !newVal;
+		if (created) {
 			newVal = new ScValue(_gameRef);
 		} else {
 			newVal->cleanup();
@@ -235,6 +264,9 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 		newVal->copy(val, copyWhole);
 		newVal->_isConstVar = setAsConst;
 		_valObject[name] = newVal;
+		if (created) {
+			propsChanged();
+		}
 
 		if (_type != VAL_NATIVE) {
 			_type = VAL_OBJECT;
@@ -278,6 +310,7 @@ void ScValue::deleteProps() {
 		_valIter++;
 	}
 	_valObject.clear();
+	propsChanged();
 }
 
 
@@ -747,6 +780,7 @@ void ScValue::copy(ScValue *orig, bool copyWhole) {
 			_valObject[orig->_valIter->_key]->copy(orig->_valIter->_value);
 			orig->_valIter++;
 		}
+		propsChanged();
 	} else {
 		_valObject.clear();
 	}
@@ -822,6 +856,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			_valObject[str] = val;
 			delete[] str;
 		}
+		propsChanged();
 	}
 
 	persistMgr->transferPtr(TMEMBER_PTR(_valRef));
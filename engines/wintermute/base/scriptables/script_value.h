@@ -83,9 +83,19 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	/** The same as getProp() if propExists(), else nullptr, with one lookup */
+	ScValue *findProp(const char *name);
+	/**
+	 * Changes whenever properties are added or removed, and is unique
+	 * among all values, so it can tell when something found with getProp()
+	 * may have gone.
+	 */
+	uint32 getPropsGeneration() const { return _propsGeneration; }
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
+	void propsChanged();
+	uint32 _propsGeneration;
 	bool _valBool;
 	int32 _valInt;
 	double _valFloat;
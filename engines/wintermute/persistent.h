@@ -29,6 +29,8 @@
 #ifndef WINTERMUTE_PERSISTENT_H
 #define WINTERMUTE_PERSISTENT_H
 
+#include "common/memorypool.h"
+
 namespace Wintermute {
 
 class BasePersistenceManager;
@@ -81,6 +83,40 @@ namespace Wintermute {
 		::operator delete(p);\
 	}\
 
+// The same as IMPLEMENT_PERSISTENT, but taking the memory of the instances
+// from a Common::ObjectPool, for classes with many short-lived instances.
+// Only for classes without subclasses.
+#define IMPLEMENT_PERSISTENT_POOLED(className, persistentClass)\
+	const char className::_className[] = #className;\
+	static Common::ObjectPool<className, 256> &get##className##Pool() {\
+		static Common::ObjectPool<className, 256> pool;\
+		return pool;\
+	}\
+	\
+	void* className::persistBuild() {\
+		return ::new (get##className##Pool()) className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
+	}\
+	\
+	bool className::persistLoad(void *instance, BasePersistenceManager *persistMgr) {\
+		return ((className*)instance)->persist(persistMgr);\
+	}\
+	\
+	const char *className::getClassName() {\
+		return #className;\
+	}\
+	\
+	void* className::operator new(size_t size) {\
+		assert(size == sizeof(className));\
+		void* ret = get##className##Pool().allocChunk();\
+		SystemClassRegistry::getInstance()->registerInstance(#className, ret);\
+		return ret;\
+	}\
+	\
+	void className::operator delete(void *p) {\
+		SystemClassRegistry::getInstance()->unregisterInstance(#className, p);\
+		get##className##Pool().freeChunk(p);\
+	}\
+
 #define TMEMBER(memberName) #memberName, &memberName
 #define TMEMBER_PTR(memberName) #memberName, &memberName
 #define TMEMBER_INT(memberName) #memberName, (int32*)&memberName
@@ -35,23 +35,29 @@ namespace Xeen {
 #define SCENE_CLIP_LEFT 8
 #define SCENE_CLIP_RIGHT 223
 
+// The most pixels of decoded cells kept per sprite resource
+#define MAX_CELLS_SIZE (256 * 1024)
+
 int SpriteResource::_clippedBottom;
 
 SpriteResource::SpriteResource() {
 	_filesize = 0;
 	_data = nullptr;
 	_scaledWidth = _scaledHeight = 0;
+	_cellsSize = 0;
 }
 
 SpriteResource::SpriteResource(const Common::String &filename) {
 	_data = nullptr;
 	_scaledWidth = _scaledHeight = 0;
+	_cellsSize = 0;
 	load(filename);
 }
 
 SpriteResource::SpriteResource(const Common::String &filename, int ccMode) {
 	_data = nullptr;
 	_scaledWidth = _scaledHeight = 0;
+	_cellsSize = 0;
 	load(filename, ccMode);
 }
 
@@ -62,6 +68,7 @@ SpriteResource::~SpriteResource() {
 SpriteResource &SpriteResource::operator=(const SpriteResource &src) {
 	delete[] _data;
 	_index.clear();
+	clearCells();
 
 	_filesize = src._filesize;
 	_data = new byte[_filesize];
@@ -88,6 +95,7 @@ void SpriteResource::load(const Common::String &filename, int ccMode) {
 
 void SpriteResource::load(Common::SeekableReadStream &f) {
 	// Read in a copy of the file
+	clearCells();
 	_filesize = f.size();
 	delete[] _data;
 	_data = new byte[_filesize];
@@ -109,6 +117,32 @@ void SpriteResource::clear() {
 	_data = nullptr;
 	_filesize = 0;
 	_index.clear();
+	clearCells();
+}
+
+void SpriteResource::clearCells() {
+	for (CellMap::iterator it = _cells.begin(); it != _cells.end(); ++it)
+		delete it->_value;
+	_cells.clear();
+	_cellsSize = 0;
+}
+
+const SpriteCell &SpriteResource::getCell(SpriteDrawer &drawer, uint16 offset, bool flipped) {
+	const uint32 key = offset | (flipped ? 0x10000 : 0);
+	CellMap::iterator it = _cells.find(key);
+	if (it != _cells.end())
+		return *it->_value;
+
+	SpriteCell *cell = new SpriteCell();
+	drawer.decode(offset, flipped, *cell);
+
+	// Start over rather than let rarely seen frames pile up
+	if (_cellsSize + cell->_pixels.size() > MAX_CELLS_SIZE)
+		clearCells();
+
+	_cells[key] = cell;
+	_cellsSize += cell->_pixels.size();
+	return *cell;
 }
 
 void SpriteResource::draw(XSurface &dest, int frame, const Common::Point &destPos,
@@ -156,9 +190,10 @@ void SpriteResource::draw(XSurface &dest, int frame, const Common::Point &destPo
 	}
 
 	// Sprites can consist of separate background & foreground
-	drawer->draw(dest, _index[frame]._offset1, destPos, r, flags, scale);
+	const bool flipped = (flags & SPRFLAG_HORIZ_FLIPPED) != 0;
+	drawer->draw(dest, getCell(*drawer, _index[frame]._offset1, flipped), destPos, r, flags, scale);
 	if (_index[frame]._offset2)
-		drawer->draw(dest, _index[frame]._offset2, destPos, r, flags, scale);
+		drawer->draw(dest, getCell(*drawer, _index[frame]._offset2, flipped), destPos, r, flags, scale);
 
 	delete drawer;
 }
@@ -191,28 +226,143 @@ Common::Point SpriteResource::getFrameSize(int frame) const {
 
 /*------------------------------------------------------------------------*/
 
-void SpriteDrawer::draw(XSurface &dest, uint16 offset, const Common::Point &pt,
+void SpriteDrawer::decode(uint16 offset, bool flipped, SpriteCell &cell) {
+	static const int PATTERN_STEPS[] = { 0, 1, 1, 1, 2, 2, 3, 3, 0, -1, -1, -1, -2, -2, -3, -3 };
+	int xInc = flipped ? -1 : 1;
+
+	// Get cell header
+	Common::MemoryReadStream f(_data, _filesize);
+	f.seek(offset);
+	cell._xOffset = f.readUint16LE();
+	cell._width = f.readUint16LE();
+	cell._yOffset = f.readUint16LE();
+	cell._height = f.readUint16LE();
+
+	const int width = cell._width;
+	const int lineWidth = MIN(width, SCREEN_WIDTH * 2);
+
+	for (int yCtr = cell._height; yCtr > 0; --yCtr) {
+		// The number of bytes in this scan line
+		int lineLength = f.readByte();
+
+		if (lineLength == 0) {
+			// Skip the specified number of scan lines
+			int numLines = f.readByte();
+			cell._lines.push_back(numLines);
+			yCtr -= numLines;
+			continue;
+		}
+
+		cell._lines.push_back(-1);
+		int xOffset = f.readByte();
+
+		// Initialize the array to hold the temporary data for the line. We do this to make it simpler
+		// to handle both deciding which pixels to draw in a scaled image, as well as when images
+		// have been horizontally flipped. Note that we allocate an extra line for before and after our
+		// work line, just in case the sprite is screwed up and overruns the line. Only the part
+		// of the work line that is kept needs clearing
+		int tempLine[SCREEN_WIDTH * 3];
+		Common::fill(&tempLine[SCREEN_WIDTH], &tempLine[SCREEN_WIDTH + lineWidth], -1);
+		int *lineP = flipped ? &tempLine[SCREEN_WIDTH + width - 1 - xOffset] : &tempLine[SCREEN_WIDTH + xOffset];
+
+		// Build up the line
+		int byteCount, opr1, opr2;
+		int32 pos;
+		for (byteCount = 1; byteCount < lineLength; ) {
+			// The next byte is an opcode that determines what operators are to follow and how to interpret them.
+			int opcode = f.readByte(); ++byteCount;
+
+			// Decode the opcode
+			int len = opcode & 0x1F;
+			int cmd = (opcode & 0xE0) >> 5;
+
+			switch (cmd) {
+			case 0:   // The following len + 1 bytes are stored as indexes into the color table.
+			case 1:   // The following len + 33 bytes are stored as indexes into the color table.
+				for (int i = 0; i < opcode + 1; ++i, ++byteCount) {
+					byte b = f.readByte();
+					*lineP = b;
+					lineP += xInc;
+				}
+				break;
+
+			case 2:   // The following byte is an index into the color table, draw it len + 3 times.
+				opr1 = f.readByte(); ++byteCount;
+				for (int i = 0; i < len + 3; ++i) {
+					*lineP = opr1;
+					lineP += xInc;
+				}
+				break;
+
+			case 3:   // Stream copy command.
+				opr1 = f.readUint16LE(); byteCount += 2;
+				pos = f.pos();
+				f.seek(-opr1, SEEK_CUR);
+
+				for (int i = 0; i < len + 4; ++i) {
+					*lineP = f.readByte();
+					lineP += xInc;
+				}
+
+				f.seek(pos, SEEK_SET);
+				break;
+
+			case 4:   // The following two bytes are indexes into the color table, draw the pair len + 2 times.
+				opr1 = f.readByte(); ++byteCount;
+				opr2 = f.readByte(); ++byteCount;
+				for (int i = 0; i < len + 2; ++i) {
+					*lineP = opr1;
+					lineP += xInc;
+					*lineP = opr2;
+					lineP += xInc;
+				}
+				break;
+
+			case 5:   // Skip len + 1 pixels
+				lineP += (len + 1) * xInc;
+				break;
+
+			case 6:   // Pattern command.
+			case 7:
+				// The pattern command has a different opcode format
+				len = opcode & 0x07;
+				cmd = (opcode >> 2) & 0x0E;
+
+				opr1 = f.readByte(); ++byteCount;
+				for (int i = 0; i < len + 3; ++i) {
+					*lineP = opr1;
+					lineP += xInc;
+					opr1 += PATTERN_STEPS[cmd + (i % 2)];
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+		assert(byteCount == lineLength);
+
+		for (int xCtr = 0; xCtr < width; ++xCtr)
+			cell._pixels.push_back(xCtr < lineWidth ? tempLine[SCREEN_WIDTH + xCtr] : -1);
+	}
+}
+
+void SpriteDrawer::draw(XSurface &dest, const SpriteCell &cell, const Common::Point &pt,
 		const Common::Rect &clipRect, uint flags, int scale) {
 	static const uint SCALE_TABLE[] = {
 		0xFFFF, 0xFFEF, 0xEFEF, 0xEFEE, 0xEEEE, 0xEEAE, 0xAEAE, 0xAEAA,
 		0xAAAA, 0xAA8A, 0x8A8A, 0x8A88, 0x8888, 0x8880, 0x8080, 0x8000
 	};
-	static const int PATTERN_STEPS[] = { 0, 1, 1, 1, 2, 2, 3, 3, 0, -1, -1, -1, -2, -2, -3, -3 };
 
 	assert((scale & SCALE_MASK) < 16);
 	uint16 scaleMask = SCALE_TABLE[scale & SCALE_MASK];
 	uint16 scaleMaskX = scaleMask, scaleMaskY = scaleMask;
-	bool flipped = (flags & SPRFLAG_HORIZ_FLIPPED) != 0;
-	int xInc = flipped ? -1 : 1;
 	bool enlarge = (scale & SCALE_ENLARGE) != 0;
 
-	// Get cell header
-	Common::MemoryReadStream f(_data, _filesize);
-	f.seek(offset);
-	int xOffset = f.readUint16LE();
-	int width = f.readUint16LE();
-	int yOffset = f.readUint16LE();
-	int height = f.readUint16LE();
+	int xOffset = cell._xOffset;
+	int width = cell._width;
+	int yOffset = cell._yOffset;
+	int height = cell._height;
 
 	// Figure out drawing x, y
 	Common::Point destPos;
@@ -239,117 +389,28 @@ void SpriteDrawer::draw(XSurface &dest, uint16 offset, const Common::Point &pt,
 	drawBounds.right = drawBounds.bottom = 0;
 
 	// Main loop
-	for (int yCtr = height; yCtr > 0; --yCtr) {
-		// The number of bytes in this scan line
-		int lineLength = f.readByte();
-
-		if (lineLength == 0) {
+	const int16 *pixels = cell._pixels.begin();
+	for (uint lineNum = 0; lineNum < cell._lines.size(); ++lineNum) {
+		if (cell._lines[lineNum] >= 0) {
 			// Skip the specified number of scan lines
-			int numLines = f.readByte();
-			destPos.y += getScaledVal(numLines + 1, scaleMaskY);
-			yCtr -= numLines;
+			destPos.y += getScaledVal(cell._lines[lineNum] + 1, scaleMaskY);
 			continue;
 		}
 
+		const int16 *lineP = pixels;
+		pixels += width;
+
 		// Roll the scale mask
 		uint bit = (scaleMaskY >> 15) & 1;
 		scaleMaskY = ((scaleMaskY & 0x7fff) << 1) + bit;
 
 		if (!bit) {
 			// Not a line to be drawn due to scaling down
-			f.skip(lineLength);
 		} else if (destPos.y < bounds.top || destPos.y >= bounds.bottom) {
-			// Skip over the bytes of the line
-			f.skip(lineLength);
+			// Skip over the line
 			destPos.y++;
 		} else {
 			scaleMaskX = scaleMaskXCopy;
-			xOffset = f.readByte();
-
-			// Initialize the array to hold the temporary data for the line. We do this to make it simpler
-			// to handle both deciding which pixels to draw in a scaled image, as well as when images
-			// have been horizontally flipped. Note that we allocate an extra line for before and after our
-			// work line, just in case the sprite is screwed up and overruns the line
-			int tempLine[SCREEN_WIDTH * 3];
-			Common::fill(&tempLine[SCREEN_WIDTH], &tempLine[SCREEN_WIDTH * 3], -1);
-			int *lineP = flipped ? &tempLine[SCREEN_WIDTH + width - 1 - xOffset] : &tempLine[SCREEN_WIDTH + xOffset];
-
-			// Build up the line
-			int byteCount, opr1, opr2;
-			int32 pos;
-			for (byteCount = 1; byteCount < lineLength; ) {
-				// The next byte is an opcode that determines what operators are to follow and how to interpret them.
-				int opcode = f.readByte(); ++byteCount;
-
-				// Decode the opcode
-				int len = opcode & 0x1F;
-				int cmd = (opcode & 0xE0) >> 5;
-
-				switch (cmd) {
-				case 0:   // The following len + 1 bytes are stored as indexes into the color table.
-				case 1:   // The following len + 33 bytes are stored as indexes into the color table.
-					for (int i = 0; i < opcode + 1; ++i, ++byteCount) {
-						byte b = f.readByte();
-						*lineP = b;
-						lineP += xInc;
-					}
-					break;
-
-				case 2:   // The following byte is an index into the color table, draw it len + 3 times.
-					opr1 = f.readByte(); ++byteCount;
-					for (int i = 0; i < len + 3; ++i) {
-						*lineP = opr1;
-						lineP += xInc;
-					}
-					break;
-
-				case 3:   // Stream copy command.
-					opr1 = f.readUint16LE(); byteCount += 2;
-					pos = f.pos();
-					f.seek(-opr1, SEEK_CUR);
-
-					for (int i = 0; i < len + 4; ++i) {
-						*lineP = f.readByte();
-						lineP += xInc;
-					}
-
-					f.seek(pos, SEEK_SET);
-					break;
-
-				case 4:   // The following two bytes are indexes into the color table, draw the pair len + 2 times.
-					opr1 = f.readByte(); ++byteCount;
-					opr2 = f.readByte(); ++byteCount;
-					for (int i = 0; i < len + 2; ++i) {
-						*lineP = opr1;
-						lineP += xInc;
-						*lineP = opr2;
-						lineP += xInc;
-					}
-					break;
-
-				case 5:   // Skip len + 1 pixels
-					lineP += (len + 1) * xInc;
-					break;
-
-				case 6:   // Pattern command.
-				case 7:
-					// The pattern command has a different opcode format
-					len = opcode & 0x07;
-					cmd = (opcode >> 2) & 0x0E;
-
-					opr1 = f.readByte(); ++byteCount;
-					for (int i = 0; i < len + 3; ++i) {
-						*lineP = opr1;
-						lineP += xInc;
-						opr1 += PATTERN_STEPS[cmd + (i % 2)];
-					}
-					break;
-
-				default:
-					break;
-				}
-			}
-			assert(byteCount == lineLength);
 
 			drawBounds.top = MIN(drawBounds.top, destPos.y);
 			drawBounds.bottom = MAX((int)drawBounds.bottom, destPos.y + 1);
@@ -357,7 +418,6 @@ void SpriteDrawer::draw(XSurface &dest, uint16 offset, const Common::Point &pt,
 			// Handle drawing out the line
 			byte *destP = (byte *)dest.getBasePtr(destPos.x, destPos.y);
 			int16 xp = destPos.x;
-			lineP = &tempLine[SCREEN_WIDTH];
 
 			for (int xCtr = 0; xCtr < width; ++xCtr, ++lineP) {
 				bit = (scaleMaskX >> 15) & 1;
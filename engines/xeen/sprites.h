@@ -26,6 +26,7 @@
 #include "common/scummsys.h"
 #include "common/array.h"
 #include "common/file.h"
+#include "common/hashmap.h"
 #include "graphics/surface.h"
 #include "xeen/files.h"
 #include "xeen/xsurface.h"
@@ -34,6 +35,7 @@ namespace Xeen {
 
 class XeenEngine;
 class Window;
+class SpriteDrawer;
 
 enum {
 	SCALE_MASK = 0x7FFF, SCALE_ENLARGE = 0x8000
@@ -46,6 +48,25 @@ enum SpriteFlags {
 	SPRFLAG_BOTTOM_CLIPPED = 0x4000, SPRFLAG_HORIZ_FLIPPED = 0x8000, SPRFLAG_RESIZE = 0x10000
 };
 
+/**
+ * A sprite cell decoded into its scan lines. Drawing it only has to apply
+ * the scaling, clipping and drawer, so it is decoded once and kept.
+ */
+struct SpriteCell {
+	int _xOffset, _width, _yOffset, _height;
+
+	/**
+	 * For each entry of the sprite data, either the number of scan lines
+	 * (minus one) skipped, or -1 for a decoded line in _pixels
+	 */
+	Common::Array<int> _lines;
+
+	/**
+	 * The decoded lines, _width pixels each, with -1 for the ones not drawn
+	 */
+	Common::Array<int16> _pixels;
+};
+
 class SpriteResource {
 private:
 	struct IndexEntry {
@@ -58,11 +79,25 @@ private:
 	Common::String _filename;
 	static int _clippedBottom;
 
+	typedef Common::HashMap<uint32, SpriteCell *> CellMap;
+	CellMap _cells;
+	uint _cellsSize;
+
 	/**
 	 * Load a sprite resource from a stream
 	 */
 	void load(Common::SeekableReadStream &f);
 
+	/**
+	 * Returns the decoded cell at the given offset, decoding it if needed
+	 */
+	const SpriteCell &getCell(SpriteDrawer &drawer, uint16 offset, bool flipped);
+
+	/**
+	 * Discards all decoded cells
+	 */
+	void clearCells();
+
 	/**
 	 * Draw the sprite onto the given surface
 	 */
@@ -202,9 +237,14 @@ public:
 	virtual ~SpriteDrawer() {}
 
 	/**
-	 * Draw a sprite frame based on a passed offset into the data stream
+	 * Decode the sprite cell at the passed offset into the data stream
+	 */
+	void decode(uint16 offset, bool flipped, SpriteCell &cell);
+
+	/**
+	 * Draw a decoded sprite cell
 	 */
-	void draw(XSurface &dest, uint16 offset, const Common::Point &pt,
+	void draw(XSurface &dest, const SpriteCell &cell, const Common::Point &pt,
 		const Common::Rect &clipRect, uint flags, int scale);
 };
 
@@ -32,10 +32,13 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
-	  _renderState(FLAT) {
+	  _renderState(FLAT),
+	  _tableChanged(true) {
 	assert(numRows != 0 && numColumns != 0);
 
-	_internalBuffer = new Common::Point[numRows * numColumns];
+	_internalBuffer = new uint32[numRows * numColumns];
+	for (uint32 i = 0; i < numRows * numColumns; ++i)
+		_internalBuffer[i] = i;
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -47,6 +50,7 @@ RenderTable::~RenderTable() {
 
 void RenderTable::setRenderState(RenderState newState) {
 	_renderState = newState;
+	_tableChanged = true;
 
 	switch (newState) {
 	case PANORAMA:
@@ -74,30 +78,19 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 		return Common::Point(x, y);
 	}
 
-	uint32 index = point.y * _numColumns + point.x;
+	uint32 index = _internalBuffer[point.y * _numColumns + point.x];
 
-	Common::Point newPoint(point);
-	newPoint.x += _internalBuffer[index].x;
-	newPoint.y += _internalBuffer[index].y;
-
-	return newPoint;
+	return Common::Point(index % _numColumns, index / _numColumns);
 }
 
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
 	uint32 destOffset = 0;
 
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *index = &_internalBuffer[y * _numColumns];
 
 		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
+			destBuffer[destOffset + x - subRect.left] = sourceBuffer[index[x]];
 		}
 
 		destOffset += destWidth;
@@ -105,28 +98,130 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
+	mutateRect((uint16 *)srcBuf->getPixels(), (uint16 *)dstBuf->getPixels(), dstBuf->pitch / 2, Common::Rect(srcBuf->w, srcBuf->h));
+}
 
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
-	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+Common::Rect RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, const Common::Rect &srcDirtyRect) {
+	Common::Rect rect;
+	if (_tableChanged) {
+		rect = Common::Rect(srcBuf->w, srcBuf->h);
+		_tableChanged = false;
+	} else {
+		rect = getWarpedRect(srcDirtyRect);
+		rect.clip(srcBuf->w, srcBuf->h);
+	}
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+	if (!rect.isEmpty()) {
+		mutateRect((uint16 *)srcBuf->getPixels(), (uint16 *)dstBuf->getPixels(), dstBuf->pitch / 2, rect);
+	}
+	return rect;
+}
+
+void RenderTable::mutateRect(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destPitch, const Common::Rect &rect) const {
+	int16 width = rect.width();
 
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+	for (int16 y = rect.top; y < rect.bottom; ++y) {
+		const uint32 *index = &_internalBuffer[y * _numColumns + rect.left];
+		uint16 *dest = &destBuffer[y * destPitch + rect.left];
+
+		int16 x = 0;
+		for (; x + 4 <= width; x += 4) {
+			dest[x + 0] = sourceBuffer[index[x + 0]];
+			dest[x + 1] = sourceBuffer[index[x + 1]];
+			dest[x + 2] = sourceBuffer[index[x + 2]];
+			dest[x + 3] = sourceBuffer[index[x + 3]];
+		}
+		for (; x < width; ++x) {
+			dest[x] = sourceBuffer[index[x]];
+		}
+	}
+}
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+Common::Rect RenderTable::getWarpedRect(const Common::Rect &flatRect) const {
+	Common::Rect warpedRect;
+	if (flatRect.isEmpty()) {
+		return warpedRect;
+	}
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+	// In both modes one flat coordinate only depends on its warped row or
+	// column, and both only ever grow along a row and down a column
+	if (_renderState == PANORAMA) {
+		uint x1 = 0;
+		while (x1 < _numColumns && (int)(_internalBuffer[x1] % _numColumns) < flatRect.left)
+			++x1;
+		uint x2 = x1;
+		while (x2 < _numColumns && (int)(_internalBuffer[x2] % _numColumns) < flatRect.right)
+			++x2;
+
+		for (uint x = x1; x < x2; ++x) {
+			uint y1 = 0, y2 = _numRows;
+			// Find the first row at or below the top of the flat rect
+			uint lo = 0, hi = _numRows;
+			while (lo < hi) {
+				uint mid = (lo + hi) / 2;
+				if ((int)(_internalBuffer[mid * _numColumns + x] / _numColumns) < flatRect.top)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			y1 = lo;
+			// And the first one below its bottom
+			hi = _numRows;
+			while (lo < hi) {
+				uint mid = (lo + hi) / 2;
+				if ((int)(_internalBuffer[mid * _numColumns + x] / _numColumns) < flatRect.bottom)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			y2 = lo;
+
+			if (y1 < y2)
+				warpedRect.extend(Common::Rect(x, y1, x + 1, y2));
+		}
+	} else if (_renderState == TILT) {
+		uint y1 = 0;
+		while (y1 < _numRows && (int)(_internalBuffer[y1 * _numColumns] / _numColumns) < flatRect.top)
+			++y1;
+		uint y2 = y1;
+		while (y2 < _numRows && (int)(_internalBuffer[y2 * _numColumns] / _numColumns) < flatRect.bottom)
+			++y2;
+
+		for (uint y = y1; y < y2; ++y) {
+			const uint32 *row = &_internalBuffer[y * _numColumns];
+			uint x1, x2;
+			uint lo = 0, hi = _numColumns;
+			while (lo < hi) {
+				uint mid = (lo + hi) / 2;
+				if ((int)(row[mid] % _numColumns) < flatRect.left)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			x1 = lo;
+			hi = _numColumns;
+			while (lo < hi) {
+				uint mid = (lo + hi) / 2;
+				if ((int)(row[mid] % _numColumns) < flatRect.right)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			x2 = lo;
+
+			if (x1 < x2)
+				warpedRect.extend(Common::Rect(x1, y, x2, y + 1));
 		}
+	} else {
+		warpedRect = flatRect;
 	}
+
+	return warpedRect;
 }
 
 void RenderTable::generateRenderTable() {
+	_tableChanged = true;
+
 	switch (_renderState) {
 	case ZVision::RenderTable::PANORAMA:
 		generatePanoramaLookupTable();
@@ -141,14 +236,6 @@ void RenderTable::generateRenderTable() {
 }
 
 void RenderTable::generatePanoramaLookupTable() {
-	for (uint y = 0; y < _numRows; y++) {
-		for (uint x = 0; x < _numColumns; x++) {
-			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
-		}
-	}
-
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
 
@@ -173,9 +260,7 @@ void RenderTable::generatePanoramaLookupTable() {
 
 			uint32 index = y * _numColumns + x;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			_internalBuffer[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
@@ -208,9 +293,7 @@ void RenderTable::generateTiltLookupTable() {
 
 			uint32 index = columnIndex + x;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			_internalBuffer[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
@@ -42,8 +42,10 @@ public:
 
 private:
 	uint _numColumns, _numRows;
-	Common::Point *_internalBuffer;
+	// For each warped pixel, the index of the flat pixel it shows
+	uint32 *_internalBuffer;
 	RenderState _renderState;
+	bool _tableChanged;
 
 	struct {
 		float fieldOfView;
@@ -70,6 +72,12 @@ public:
 
 	void mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect);
 	void mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf);
+	/**
+	 * Warps the pixels of srcBuf that may show the changed flat area
+	 * srcDirtyRect, and returns the area of dstBuf that was updated.
+	 * All of it is updated after the table changed.
+	 */
+	Common::Rect mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, const Common::Rect &srcDirtyRect);
 	void generateRenderTable();
 
 	void setPanoramaFoV(float fov);
@@ -90,6 +98,9 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+
+	Common::Rect getWarpedRect(const Common::Rect &flatRect) const;
+	void mutateRect(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destPitch, const Common::Rect &rect) const;
 };
 
 } // End of namespace ZVision
@@ -28,6 +28,7 @@
 #include "common/str.h"
 
 #include "graphics/surface.h"
+#include "graphics/text_run_cache.h"
 #include "graphics/transparent_surface.h"
 
 #include "gui/ThemeEngine.h"
@@ -548,6 +549,12 @@ public:
 	 */
 	virtual void applyScreenShading(GUI::ThemeEngine::ShadingStyle) = 0;
 
+	/**
+	 * Forgets all text drawn so far. Must be called before any font
+	 * that was passed to drawString is deleted.
+	 */
+	void clearTextCache() { _textRunCache.clear(); }
+
 protected:
 	TransparentSurface *_activeSurface; /**< Pointer to the surface currently being drawn */
 
@@ -561,6 +568,8 @@ protected:
 	uint32 _dynamicData; /**< Dynamic data from the GUI Theme that modifies the drawing of the current shape */
 
 	int _gradientFactor; /**< Multiplication factor of the active gradient */
+
+	TextRunCache _textRunCache; /**< Keeps the text drawn by drawString rendered */
 };
 
 } // End of namespace Graphics
@@ -501,6 +501,34 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 	}
 }
 
+/**
+ * Fills a row with two alternating colors, as used by the dithered gradient
+ * rows. Even columns get the first color and odd ones the second.
+ *
+ * Each pair of pixels is written by straight-line code, so compilers can
+ * turn the loop into vector stores.
+ *
+ * @param first Pointer to the first pixel to fill.
+ * @param last Pointer to the last pixel to fill.
+ * @param x Column of the first pixel.
+ * @param even Color of the pixels in even columns.
+ * @param odd Color of the pixels in odd columns.
+ */
+template<typename PixelType>
+void ditherFill(PixelType *first, PixelType *last, int x, PixelType even, PixelType odd) {
+	if (first < last && (x & 1))
+		*first++ = odd;
+
+	while (last - first >= 2) {
+		first[0] = even;
+		first[1] = odd;
+		first += 2;
+	}
+
+	if (first < last)
+		*first = even;
+}
+
 
 VectorRenderer *createRenderer(int mode) {
 #ifdef DISABLE_FANCY_THEMES
@@ -584,6 +612,14 @@ calcGradient(uint32 pos, uint32 max) {
 	return output;
 }
 
+template<typename PixelType>
+inline PixelType VectorRendererSpec<PixelType>::
+ditherColor(int grad, bool oddRow, bool oddColumn, int curGrad) const {
+	// The patterns are drawn in gradientFill
+	const bool next = oddColumn ? (oddRow || grad == 3) : (oddRow && grad >= 2);
+	return _gradCache[next ? curGrad + 1 : curGrad];
+}
+
 template<typename PixelType>
 void VectorRendererSpec<PixelType>::
 precalcGradient(int h) {
@@ -630,16 +666,7 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		ditherFill<PixelType>(ptr, ptr + width, x, ditherColor(grad, ox, false, curGrad), ditherColor(grad, ox, true, curGrad));
 	}
 }
 
@@ -672,17 +699,11 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		// Only the pixels inside the clipping area are drawn
+		const int first = MAX(0, _clippingArea.left - realX);
+		const int last = MIN(width, _clippingArea.right - realX);
+		if (first < last)
+			ditherFill<PixelType>(ptr + first, ptr + last, x + first, ditherColor(grad, ox, false, curGrad), ditherColor(grad, ox, true, curGrad));
 	}
 }
 
@@ -1175,7 +1196,7 @@ drawString(const Graphics::Font *font, const Common::String &text, const Common:
 
 	if (!drawArea.isEmpty()) {
 		Surface textAreaSurface = _activeSurface->getSubArea(drawArea);
-		font->drawString(&textAreaSurface, text, area.left - drawArea.left, offset - drawArea.top, area.width() - deltax, _fgColor, alignH, deltax, ellipsis);
+		_textRunCache.drawString(*font, &textAreaSurface, text, area.left - drawArea.left, offset - drawArea.top, area.width() - deltax, _fgColor, alignH, deltax, ellipsis);
 	}
 }
 
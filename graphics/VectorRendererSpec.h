@@ -274,6 +274,16 @@ protected:
 	 */
 	inline PixelType calcGradient(uint32 pos, uint32 max);
 
+	/**
+	 * Returns the color of a pixel in a dithered gradient row.
+	 *
+	 * @param grad Dithering pattern of the row, from 0 to 3.
+	 * @param oddRow Whether the row is an odd one.
+	 * @param oddColumn Whether the pixel is in an odd column.
+	 * @param curGrad Index of the gradient strip the row is in.
+	 */
+	inline PixelType ditherColor(int grad, bool oddRow, bool oddColumn, int curGrad) const;
+
 	void precalcGradient(int h);
 	void gradientFill(PixelType *first, int width, int x, int y);
 	void gradientFillClip(PixelType *first, int width, int x, int y, int realX, int realY);
@@ -25,6 +25,14 @@
 
 #include "common/endian.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONVERSION_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CONVERSION_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 // TODO: YUV to RGB conversion function
@@ -96,6 +104,238 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+template<typename DstColor, bool backward>
+inline void crossBlitMapLogic(byte *dst, const byte *src, const uint w, const uint h,
+                              const uint srcDelta, const uint dstDelta, const uint32 *map) {
+	for (uint y = 0; y < h; ++y) {
+		uint x = 0;
+		if (!backward) {
+			// Look up four pixels at a time
+			for (; x + 4 <= w; x += 4) {
+				const uint32 c0 = map[src[0]], c1 = map[src[1]];
+				const uint32 c2 = map[src[2]], c3 = map[src[3]];
+				((DstColor *)dst)[0] = c0;
+				((DstColor *)dst)[1] = c1;
+				((DstColor *)dst)[2] = c2;
+				((DstColor *)dst)[3] = c3;
+				src += 4;
+				dst += 4 * sizeof(DstColor);
+			}
+		}
+
+		for (; x < w; ++x) {
+			*(DstColor *)dst = map[*src];
+
+			if (backward) {
+				src -= 1;
+				dst -= sizeof(DstColor);
+			} else {
+				src += 1;
+				dst += sizeof(DstColor);
+			}
+		}
+
+		if (backward) {
+			src -= srcDelta;
+			dst -= dstDelta;
+		} else {
+			src += srcDelta;
+			dst += dstDelta;
+		}
+	}
+}
+
+#if defined(CONVERSION_USE_SSE2) || defined(CONVERSION_USE_NEON)
+
+// Four 32 bit pixels
+
+#ifdef CONVERSION_USE_SSE2
+typedef __m128i PixelVec;
+
+static inline PixelVec vecLoad32(const byte *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline void vecStore32(byte *p, PixelVec v) { _mm_storeu_si128((__m128i *)p, v); }
+static inline PixelVec vecSet(uint32 x) { return _mm_set1_epi32(x); }
+static inline PixelVec vecAnd(PixelVec a, PixelVec b) { return _mm_and_si128(a, b); }
+static inline PixelVec vecOr(PixelVec a, PixelVec b) { return _mm_or_si128(a, b); }
+static inline PixelVec vecShl(PixelVec v, int n) { return _mm_sll_epi32(v, _mm_cvtsi32_si128(n)); }
+static inline PixelVec vecShr(PixelVec v, int n) { return _mm_srl_epi32(v, _mm_cvtsi32_si128(n)); }
+
+/** Loads eight 16 bit pixels, widened to 32 bits */
+static inline void vecLoad16(const byte *p, PixelVec &lo, PixelVec &hi) {
+	const __m128i v = _mm_loadu_si128((const __m128i *)p);
+	lo = _mm_unpacklo_epi16(v, _mm_setzero_si128());
+	hi = _mm_unpackhi_epi16(v, _mm_setzero_si128());
+}
+
+/** Stores eight pixels of at most 16 bits as 16 bit pixels */
+static inline void vecStore16(byte *p, PixelVec lo, PixelVec hi) {
+	// There is no unsigned saturation for this in SSE2, so sign extend
+	// the pixels to keep them in range of the signed one
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	_mm_storeu_si128((__m128i *)p, _mm_packs_epi32(lo, hi));
+}
+#else
+typedef uint32x4_t PixelVec;
+
+static inline PixelVec vecLoad32(const byte *p) { return vld1q_u32((const uint32 *)p); }
+static inline void vecStore32(byte *p, PixelVec v) { vst1q_u32((uint32 *)p, v); }
+static inline PixelVec vecSet(uint32 x) { return vdupq_n_u32(x); }
+static inline PixelVec vecAnd(PixelVec a, PixelVec b) { return vandq_u32(a, b); }
+static inline PixelVec vecOr(PixelVec a, PixelVec b) { return vorrq_u32(a, b); }
+static inline PixelVec vecShl(PixelVec v, int n) { return vshlq_u32(v, vdupq_n_s32(n)); }
+static inline PixelVec vecShr(PixelVec v, int n) { return vshlq_u32(v, vdupq_n_s32(-n)); }
+
+static inline void vecLoad16(const byte *p, PixelVec &lo, PixelVec &hi) {
+	const uint16x8_t v = vld1q_u16((const uint16 *)p);
+	lo = vmovl_u16(vget_low_u16(v));
+	hi = vmovl_u16(vget_high_u16(v));
+}
+
+static inline void vecStore16(byte *p, PixelVec lo, PixelVec hi) {
+	vst1q_u16((uint16 *)p, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+#endif
+
+static inline bool isRGB565(const PixelFormat &fmt) {
+	return fmt.bytesPerPixel == 2 && fmt.aBits() == 0 &&
+	       fmt.rBits() == 5 && fmt.gBits() == 6 && fmt.bBits() == 5 &&
+	       fmt.rShift == 11 && fmt.gShift == 5 && fmt.bShift == 0;
+}
+
+/** Whether fmt has 32 bit pixels with 8 bit components, and perhaps alpha */
+static inline bool is8888(const PixelFormat &fmt) {
+	return fmt.bytesPerPixel == 4 && (fmt.aBits() == 0 || fmt.aBits() == 8) &&
+	       fmt.rBits() == 8 && fmt.gBits() == 8 && fmt.bBits() == 8;
+}
+
+/** Converts RGB565 to 8888, eight pixels at a time */
+static uint crossBlitRowRGB565To8888(byte *dst, const byte *src, const uint w, const PixelFormat &dstFmt) {
+	const PixelVec alpha = vecSet((0xFF >> dstFmt.aLoss) << dstFmt.aShift);
+	const PixelVec mask5 = vecSet(0x1F), mask6 = vecSet(0x3F);
+
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		PixelVec pixels[2];
+		vecLoad16(src, pixels[0], pixels[1]);
+
+		for (int i = 0; i < 2; ++i) {
+			const PixelVec r = vecShr(pixels[i], 11);
+			const PixelVec g = vecAnd(vecShr(pixels[i], 5), mask6);
+			const PixelVec b = vecAnd(pixels[i], mask5);
+
+			// Expand the components the way ColorComponent does
+			const PixelVec r8 = vecOr(vecShl(r, 3), vecShr(r, 2));
+			const PixelVec g8 = vecOr(vecShl(g, 2), vecShr(g, 4));
+			const PixelVec b8 = vecOr(vecShl(b, 3), vecShr(b, 2));
+
+			vecStore32(dst + i * 16, vecOr(vecOr(vecShl(r8, dstFmt.rShift), vecShl(g8, dstFmt.gShift)),
+			                               vecOr(vecShl(b8, dstFmt.bShift), alpha)));
+		}
+
+		src += 16;
+		dst += 32;
+	}
+
+	return x;
+}
+
+/** Converts 8888 to RGB565, eight pixels at a time */
+static uint crossBlitRow8888ToRGB565(byte *dst, const byte *src, const uint w, const PixelFormat &srcFmt) {
+	const PixelVec maskR = vecSet(0xF8), maskG = vecSet(0xFC);
+
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		PixelVec pixels[2];
+
+		for (int i = 0; i < 2; ++i) {
+			const PixelVec c = vecLoad32(src + i * 16);
+			const PixelVec r = vecAnd(vecShr(c, srcFmt.rShift), maskR);
+			const PixelVec g = vecAnd(vecShr(c, srcFmt.gShift), maskG);
+			const PixelVec b = vecAnd(vecShr(c, srcFmt.bShift), maskR);
+			pixels[i] = vecOr(vecOr(vecShl(r, 8), vecShl(g, 3)), vecShr(b, 3));
+		}
+
+		vecStore16(dst, pixels[0], pixels[1]);
+		src += 32;
+		dst += 16;
+	}
+
+	return x;
+}
+
+/** Reorders the components of 8888 pixels, four pixels at a time */
+static uint crossBlitRow8888To8888(byte *dst, const byte *src, const uint w, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	const PixelVec mask = vecSet(0xFF);
+	const bool copyAlpha = srcFmt.aBits() && dstFmt.aBits();
+	const PixelVec alpha = vecSet(srcFmt.aBits() ? 0 : (0xFF >> dstFmt.aLoss) << dstFmt.aShift);
+
+	uint x = 0;
+	for (; x + 4 <= w; x += 4) {
+		const PixelVec c = vecLoad32(src);
+		PixelVec out = vecOr(vecOr(vecShl(vecAnd(vecShr(c, srcFmt.rShift), mask), dstFmt.rShift),
+		                           vecShl(vecAnd(vecShr(c, srcFmt.gShift), mask), dstFmt.gShift)),
+		                     vecOr(vecShl(vecAnd(vecShr(c, srcFmt.bShift), mask), dstFmt.bShift), alpha));
+		if (copyAlpha)
+			out = vecOr(out, vecShl(vecAnd(vecShr(c, srcFmt.aShift), mask), dstFmt.aShift));
+
+		vecStore32(dst, out);
+		src += 16;
+		dst += 16;
+	}
+
+	return x;
+}
+
+/**
+ * Converts between the common pixel formats with SIMD instructions, and
+ * the remaining pixels of each row with crossBlitLogic.
+ *
+ * @return  false if the formats are not handled here
+ */
+bool crossBlitSIMD(byte *dst, const byte *src, const uint dstPitch, const uint srcPitch,
+                   const uint w, const uint h, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	enum { kRGB565To8888, k8888ToRGB565, k8888To8888 } kind;
+	if (isRGB565(srcFmt) && is8888(dstFmt))
+		kind = kRGB565To8888;
+	else if (is8888(srcFmt) && isRGB565(dstFmt))
+		kind = k8888ToRGB565;
+	else if (is8888(srcFmt) && is8888(dstFmt))
+		kind = k8888To8888;
+	else
+		return false;
+
+	// Rows are converted front to back, which would overwrite the source
+	// of a surface converted in place to more bytes per pixel
+	if (kind == kRGB565To8888 && dst < src + srcPitch * h && src < dst + dstPitch * h)
+		return false;
+
+	for (uint y = 0; y < h; ++y) {
+		uint x;
+		switch (kind) {
+		case kRGB565To8888:
+			x = crossBlitRowRGB565To8888(dst, src, w, dstFmt);
+			crossBlitLogic<uint16, uint32, false>(dst + x * 4, src + x * 2, w - x, 1, srcFmt, dstFmt, 0, 0);
+			break;
+		case k8888ToRGB565:
+			x = crossBlitRow8888ToRGB565(dst, src, w, srcFmt);
+			crossBlitLogic<uint32, uint16, false>(dst + x * 2, src + x * 4, w - x, 1, srcFmt, dstFmt, 0, 0);
+			break;
+		default:
+			x = crossBlitRow8888To8888(dst, src, w, dstFmt, srcFmt);
+			crossBlitLogic<uint32, uint32, false>(dst + x * 4, src + x * 4, w - x, 1, srcFmt, dstFmt, 0, 0);
+			break;
+		}
+
+		src += srcPitch;
+		dst += dstPitch;
+	}
+
+	return true;
+}
+
+#endif // CONVERSION_USE_SSE2 || CONVERSION_USE_NEON
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -126,6 +366,11 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+#if defined(CONVERSION_USE_SSE2) || defined(CONVERSION_USE_NEON)
+	if (crossBlitSIMD(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt))
+		return true;
+#endif
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -167,4 +412,32 @@ bool crossBlit(byte *dst, const byte *src,
 	return true;
 }
 
+bool crossBlitMap(byte *dst, const byte *src,
+                  const uint dstPitch, const uint srcPitch,
+                  const uint w, const uint h,
+                  const uint bytesPerPixel, const uint32 *map) {
+	if (bytesPerPixel != 2 && bytesPerPixel != 4)
+		return false;
+
+	const uint srcDelta = (srcPitch - w);
+	const uint dstDelta = (dstPitch - w * bytesPerPixel);
+
+	// Like crossBlit, go from bottom right to top left when converting in
+	// place, so the source is not overwritten before it has been read
+	if (dst < src + srcPitch * h && src < dst + dstPitch * h) {
+		dst += h * dstPitch - dstDelta - bytesPerPixel;
+		src += h * srcPitch - srcDelta - 1;
+		if (bytesPerPixel == 2)
+			crossBlitMapLogic<uint16, true>(dst, src, w, h, srcDelta, dstDelta, map);
+		else
+			crossBlitMapLogic<uint32, true>(dst, src, w, h, srcDelta, dstDelta, map);
+	} else if (bytesPerPixel == 2) {
+		crossBlitMapLogic<uint16, false>(dst, src, w, h, srcDelta, dstDelta, map);
+	} else {
+		crossBlitMapLogic<uint32, false>(dst, src, w, h, srcDelta, dstDelta, map);
+	}
+
+	return true;
+}
+
 } // End of namespace Graphics
@@ -72,6 +72,30 @@ bool crossBlit(byte *dst, const byte *src,
                const uint w, const uint h,
                const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * Blits a rectangle of palette indices to a high color format, looking up
+ * the color of each pixel in a table.
+ *
+ * @param dst		the buffer which will recieve the converted graphics data
+ * @param src		the buffer containing the palette indices
+ * @param dstPitch	width in bytes of one full line of the dest buffer
+ * @param srcPitch	width in bytes of one full line of the source buffer
+ * @param w			the width of the graphics data
+ * @param h			the height of the graphics data
+ * @param bytesPerPixel	the number of bytes per pixel of the dest buffer
+ * @param map		the colors in the destination format of the palette
+ *					entries used by the source
+ * @return			true if conversion completes successfully,
+ *					false if there is an error.
+ *
+ * @note Only 2Bpp and 4Bpp destinations are supported
+ * @note This can convert a surface in place, like crossBlit.
+ */
+bool crossBlitMap(byte *dst, const byte *src,
+                  const uint dstPitch, const uint srcPitch,
+                  const uint w, const uint h,
+                  const uint bytesPerPixel, const uint32 *map);
+
 } // End of namespace Graphics
 
 #endif // GRAPHICS_CONVERSION_H
@@ -0,0 +1,256 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirtyregion.h"
+
+namespace Graphics {
+
+DirtyRegion::DirtyRegion(int16 width, int16 height, Strategy strategy, uint overdraw)
+	: _width(width), _height(height), _strategy(strategy), _overdraw(overdraw),
+	  _rectsValid(true), _tiles(nullptr), _tilesW(0), _tilesH(0) {
+	if (_strategy == kStrategyMicroTiles) {
+		_tilesW = (width + kTileSize - 1) >> kTileShift;
+		_tilesH = (height + kTileSize - 1) >> kTileShift;
+		_tiles = new TileBox[_tilesW * _tilesH];
+	}
+
+	clear();
+}
+
+DirtyRegion::~DirtyRegion() {
+	delete[] _tiles;
+}
+
+void DirtyRegion::addRect(const Common::Rect &r) {
+	Common::Rect rect = r;
+	rect.clip(_width, _height);
+	if (rect.isEmpty())
+		return;
+
+	if (_bounds.isEmpty())
+		_bounds = rect;
+	else
+		_bounds.extend(rect);
+
+	if (_strategy == kStrategyMicroTiles)
+		addTileRect(rect);
+	else
+		addListRect(rect);
+
+	_rectsValid = false;
+}
+
+void DirtyRegion::addAll() {
+	addRect(Common::Rect(_width, _height));
+}
+
+void DirtyRegion::clear() {
+	_bounds = Common::Rect();
+	_rects.resize(0);
+	_rectsValid = true;
+
+	if (_tiles)
+		memset(_tiles, 0, _tilesW * _tilesH * sizeof(TileBox));
+}
+
+bool DirtyRegion::intersects(const Common::Rect &r) const {
+	if (!_bounds.intersects(r))
+		return false;
+
+	if (_strategy != kStrategyMicroTiles) {
+		for (uint i = 0; i < _rects.size(); ++i) {
+			if (_rects[i].intersects(r))
+				return true;
+		}
+		return false;
+	}
+
+	Common::Rect rect = r;
+	rect.clip(_bounds);
+	const uint tx0 = rect.left >> kTileShift, tx1 = (rect.right - 1) >> kTileShift;
+	const uint ty0 = rect.top >> kTileShift, ty1 = (rect.bottom - 1) >> kTileShift;
+
+	for (uint ty = ty0; ty <= ty1; ++ty) {
+		for (uint tx = tx0; tx <= tx1; ++tx) {
+			const TileBox box = _tiles[ty * _tilesW + tx];
+			if (!box)
+				continue;
+
+			const int16 x = tx << kTileShift, y = ty << kTileShift;
+			const Common::Rect dirty(x + (box >> 24), y + ((box >> 16) & 0xFF),
+			                         x + ((box >> 8) & 0xFF), y + (box & 0xFF));
+			if (dirty.intersects(rect))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+const Common::Array<Common::Rect> &DirtyRegion::getRects() {
+	if (!_rectsValid) {
+		if (_strategy == kStrategyMicroTiles)
+			buildTileRects();
+		else
+			mergeListRects();
+		_rectsValid = true;
+	}
+
+	return _rects;
+}
+
+void DirtyRegion::addTileRect(const Common::Rect &r) {
+	const uint tx0 = r.left >> kTileShift, tx1 = (r.right - 1) >> kTileShift;
+	const uint ty0 = r.top >> kTileShift, ty1 = (r.bottom - 1) >> kTileShift;
+
+	for (uint ty = ty0; ty <= ty1; ++ty) {
+		const uint y0 = (ty == ty0) ? (r.top & (kTileSize - 1)) : 0;
+		const uint y1 = (ty == ty1) ? ((r.bottom - 1) & (kTileSize - 1)) + 1 : kTileSize;
+
+		TileBox *tile = &_tiles[ty * _tilesW + tx0];
+		for (uint tx = tx0; tx <= tx1; ++tx, ++tile) {
+			const uint x0 = (tx == tx0) ? (r.left & (kTileSize - 1)) : 0;
+			const uint x1 = (tx == tx1) ? ((r.right - 1) & (kTileSize - 1)) + 1 : kTileSize;
+
+			if (!*tile) {
+				*tile = makeTileBox(x0, y0, x1, y1);
+			} else {
+				*tile = makeTileBox(MIN<uint>(*tile >> 24, x0), MIN<uint>((*tile >> 16) & 0xFF, y0),
+				                    MAX<uint>((*tile >> 8) & 0xFF, x1), MAX<uint>(*tile & 0xFF, y1));
+			}
+		}
+	}
+}
+
+void DirtyRegion::buildTileRects() {
+	_rects.resize(0);
+
+	// Rectangles of the previous tile row reaching down to the current
+	// one, which can be extended by a rectangle with the same width
+	Common::Array<uint> openRows[2];
+	Common::Array<uint> *open = &openRows[0], *nextOpen = &openRows[1];
+
+	for (uint ty = 0; ty < _tilesH; ++ty) {
+		const TileBox *row = &_tiles[ty * _tilesW];
+		const int16 y = ty << kTileShift;
+		nextOpen->resize(0);
+
+		for (uint tx = 0; tx < _tilesW; ++tx) {
+			const TileBox box = row[tx];
+			if (!box)
+				continue;
+
+			// Join the boxes of the following tiles, as long as they
+			// continue this one with the same height
+			const uint y0 = (box >> 16) & 0xFF, y1 = box & 0xFF;
+			const int16 left = (tx << kTileShift) + (box >> 24);
+			TileBox last = box;
+			while (((last >> 8) & 0xFF) == kTileSize && tx + 1 < _tilesW &&
+			       row[tx + 1] && (row[tx + 1] >> 24) == 0 &&
+			       ((row[tx + 1] >> 16) & 0xFF) == y0 && (row[tx + 1] & 0xFF) == y1) {
+				last = row[++tx];
+			}
+			const int16 right = (tx << kTileShift) + ((last >> 8) & 0xFF);
+			const Common::Rect rect(left, y + y0, right, y + y1);
+
+			// Extend a rectangle of the row above if it lines up
+			uint i;
+			for (i = 0; i < open->size(); ++i) {
+				Common::Rect &above = _rects[(*open)[i]];
+				if (above.left == rect.left && above.right == rect.right && above.bottom == rect.top) {
+					above.bottom = rect.bottom;
+					break;
+				}
+			}
+
+			if (i < open->size()) {
+				if (rect.bottom == y + kTileSize)
+					nextOpen->push_back((*open)[i]);
+			} else {
+				_rects.push_back(rect);
+				if (rect.bottom == y + kTileSize)
+					nextOpen->push_back(_rects.size() - 1);
+			}
+		}
+
+		SWAP(open, nextOpen);
+	}
+}
+
+void DirtyRegion::addListRect(const Common::Rect &r) {
+	for (uint i = 0; i < _rects.size(); ) {
+		if (_rects[i].contains(r))
+			return;
+
+		if (r.contains(_rects[i])) {
+			_rects[i] = _rects.back();
+			_rects.pop_back();
+		} else {
+			++i;
+		}
+	}
+
+	_rects.push_back(r);
+}
+
+bool DirtyRegion::shouldMerge(const Common::Rect &a, const Common::Rect &b) const {
+	if (a.intersects(b) && _strategy == kStrategyMerge)
+		return true;
+	if (_strategy != kStrategyOverdraw)
+		return false;
+
+	// Compare the pixels the bounding box covers with those covered by
+	// the two rectangles
+	Common::Rect bounds = a;
+	bounds.extend(b);
+	uint64 covered = (uint64)a.width() * a.height() + (uint64)b.width() * b.height();
+	const Common::Rect overlap = a.findIntersectingRect(b);
+	if (!overlap.isEmpty())
+		covered -= (uint64)overlap.width() * overlap.height();
+
+	return (uint64)bounds.width() * bounds.height() * 100 <= covered * (100 + _overdraw);
+}
+
+void DirtyRegion::mergeListRects() {
+	bool merged = true;
+	while (merged) {
+		merged = false;
+
+		for (uint i = 0; i < _rects.size(); ++i) {
+			for (uint j = i + 1; j < _rects.size(); ) {
+				if (shouldMerge(_rects[i], _rects[j])) {
+					_rects[i].extend(_rects[j]);
+					_rects[j] = _rects.back();
+					_rects.pop_back();
+
+					// The grown rectangle may reach others checked before
+					merged = true;
+					j = i + 1;
+				} else {
+					++j;
+				}
+			}
+		}
+	}
+}
+
+} // End of namespace Graphics
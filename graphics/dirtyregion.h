@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTYREGION_H
+#define GRAPHICS_DIRTYREGION_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * Keeps track of the areas of a screen or surface that changed, and turns
+ * them into a short list of rectangles to copy.
+ *
+ * Different strategies trade the number of rectangles for the number of
+ * pixels they cover:
+ * - kStrategyMicroTiles keeps a bounding box for every 32x32 tile, so
+ *   adding a rectangle is cheap no matter how many were added before.
+ *   Boxes of neighbouring tiles are joined where they line up.
+ * - kStrategyMerge merges rectangles which overlap, and drops the ones
+ *   which are covered by others.
+ * - kStrategyOverdraw also merges rectangles which don't overlap, as long
+ *   as their bounding box adds at most the given overdraw percentage to
+ *   the pixels they cover. The resulting rectangles may overlap.
+ *
+ * With the first two strategies, the returned rectangles never overlap.
+ */
+class DirtyRegion {
+public:
+	enum Strategy {
+		kStrategyMicroTiles,
+		kStrategyMerge,
+		kStrategyOverdraw
+	};
+
+	/**
+	 * Creates a region for an area of the given size. Rectangles added
+	 * to it get clipped to that area.
+	 *
+	 * @param overdraw  For kStrategyOverdraw, the percentage of extra
+	 *                  pixels a merged rectangle may cover
+	 */
+	DirtyRegion(int16 width, int16 height, Strategy strategy = kStrategyMicroTiles, uint overdraw = 25);
+	~DirtyRegion();
+
+	Strategy getStrategy() const { return _strategy; }
+
+	/** Marks the given area as dirty. */
+	void addRect(const Common::Rect &r);
+
+	/** Marks the whole area as dirty. */
+	void addAll();
+
+	/** Marks everything as clean. */
+	void clear();
+
+	/** Returns whether anything is dirty. */
+	bool isEmpty() const { return _bounds.isEmpty(); }
+
+	/** Returns the bounding box of everything that is dirty. */
+	const Common::Rect &getBounds() const { return _bounds; }
+
+	/** Returns whether any part of the given area is dirty. */
+	bool intersects(const Common::Rect &r) const;
+
+	/**
+	 * Returns the rectangles covering everything that is dirty. They are
+	 * recomputed only after the region changed.
+	 */
+	const Common::Array<Common::Rect> &getRects();
+
+private:
+	enum {
+		kTileSize = 32,
+		kTileShift = 5
+	};
+
+	/**
+	 * The dirty part of a tile, as left, top, right and bottom offsets
+	 * in its bytes from high to low. Zero means clean.
+	 */
+	typedef uint32 TileBox;
+
+	static TileBox makeTileBox(uint x0, uint y0, uint x1, uint y1) {
+		return (x0 << 24) | (y0 << 16) | (x1 << 8) | y1;
+	}
+
+	void addTileRect(const Common::Rect &r);
+	void buildTileRects();
+
+	void addListRect(const Common::Rect &r);
+	bool shouldMerge(const Common::Rect &a, const Common::Rect &b) const;
+	void mergeListRects();
+
+	const int16 _width, _height;
+	const Strategy _strategy;
+	const uint _overdraw;
+
+	Common::Rect _bounds;
+	Common::Array<Common::Rect> _rects;
+	bool _rectsValid;
+
+	TileBox *_tiles;
+	uint _tilesW, _tilesH;
+};
+
+} // End of namespace Graphics
+
+#endif
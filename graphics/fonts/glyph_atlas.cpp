@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/fonts/glyph_atlas.h"
+
+namespace Graphics {
+
+GlyphAtlas::GlyphAtlas(int pageWidth, int pageHeight) : _pageWidth(pageWidth), _pageHeight(pageHeight) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+	clear();
+}
+
+void GlyphAtlas::clear() {
+	for (uint i = 0; i < _pages.size(); ++i) {
+		_pages[i]->surface.free();
+		delete _pages[i];
+	}
+	_pages.clear();
+}
+
+void GlyphAtlas::setPageSize(int pageWidth, int pageHeight) {
+	_pageWidth = pageWidth;
+	_pageHeight = pageHeight;
+}
+
+GlyphAtlas::Page *GlyphAtlas::addPage(int w, int h) {
+	Page *page = new Page();
+	page->surface.create(w, h, PixelFormat::createFormatCLUT8());
+	memset(page->surface.getPixels(), 0, page->surface.pitch * page->surface.h);
+	page->shelfX = page->shelfY = page->shelfHeight = 0;
+	return page;
+}
+
+void GlyphAtlas::allocate(int w, int h, Surface &image) {
+	if (w <= 0 || h <= 0) {
+		image.init(MAX(w, 0), MAX(h, 0), 0, nullptr, PixelFormat::createFormatCLUT8());
+		return;
+	}
+
+	Page *page = nullptr;
+	if (w > _pageWidth || h > _pageHeight) {
+		// Oversized glyphs get a page of their own. It is kept in front of
+		// the page that is currently being filled.
+		page = addPage(w, h);
+		if (_pages.empty())
+			_pages.push_back(page);
+		else
+			_pages.insert_at(_pages.size() - 1, page);
+	} else {
+		if (!_pages.empty())
+			page = _pages.back();
+
+		if (page && page->shelfX + w > page->surface.w) {
+			// Start a new shelf below the current one
+			page->shelfX = 0;
+			page->shelfY += page->shelfHeight;
+			page->shelfHeight = 0;
+		}
+
+		if (!page || page->shelfY + h > page->surface.h) {
+			page = addPage(_pageWidth, _pageHeight);
+			_pages.push_back(page);
+		}
+	}
+
+	image.init(w, h, page->surface.pitch, page->surface.getBasePtr(page->shelfX, page->shelfY), page->surface.format);
+	page->shelfX += w;
+	page->shelfHeight = MAX(page->shelfHeight, h);
+}
+
+} // End of namespace Graphics
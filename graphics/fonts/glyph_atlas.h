@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_FONTS_GLYPH_ATLAS_H
+#define GRAPHICS_FONTS_GLYPH_ATLAS_H
+
+#include "common/array.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+/**
+ * Packs the 8-bit coverage images of rasterized glyphs into a few large
+ * pages instead of allocating a surface for every single glyph.
+ *
+ * Glyphs are placed on shelves: rows of glyphs which are as high as the
+ * highest glyph on them. Glyphs that do not fit into a page are given a
+ * page of their own. The pages never move, so the views handed out by
+ * allocate() stay valid until the atlas is cleared or destroyed.
+ */
+class GlyphAtlas {
+public:
+	enum {
+		kDefaultPageSize = 256
+	};
+
+	explicit GlyphAtlas(int pageWidth = kDefaultPageSize, int pageHeight = kDefaultPageSize);
+	~GlyphAtlas();
+
+	/**
+	 * Reserves a zero filled area of w x h pixels.
+	 *
+	 * @param image set to a CLUT8 view of the reserved area. Its pitch is
+	 *              the pitch of the page, and it must not be freed.
+	 */
+	void allocate(int w, int h, Surface &image);
+
+	/** Frees all pages, invalidating all views handed out before. */
+	void clear();
+
+	/** Changes the size of pages created from now on. */
+	void setPageSize(int pageWidth, int pageHeight);
+
+	uint getPageCount() const { return _pages.size(); }
+	const Surface &getPage(uint index) const { return _pages[index]->surface; }
+
+private:
+	struct Page {
+		Surface surface;
+		/** Position of the next glyph on the current shelf */
+		int shelfX, shelfY;
+		int shelfHeight;
+	};
+
+	Page *addPage(int w, int h);
+
+	Common::Array<Page *> _pages;
+	int _pageWidth, _pageHeight;
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "graphics/fonts/ttf.h"
 #include "graphics/font.h"
+#include "graphics/fonts/glyph_atlas.h"
 #include "graphics/surface.h"
 
 #include "common/file.h"
@@ -136,6 +137,7 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
+		/** A view into _atlas */
 		Surface image;
 		int xOffset, yOffset;
 		int advance;
@@ -145,6 +147,7 @@ private:
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
+	mutable GlyphAtlas _atlas;
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
@@ -172,8 +175,8 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		_glyphs.clear();
+		_atlas.clear();
 
 		_initialized = false;
 	}
@@ -248,6 +251,10 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode siz
 	_width = ftCeil26_6(FT_MulFix(_face->max_advance_width, _face->size->metrics.x_scale));
 	_height = _ascent - _descent + 1;
 
+	// Make room for a few rows of the largest glyphs on every atlas page
+	const int pageSize = MAX<int>(GlyphAtlas::kDefaultPageSize, MAX(_width, _height) * 8);
+	_atlas.setPageSize(pageSize, pageSize);
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
@@ -597,7 +604,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	glyph.advance = ftCeil26_6(_face->glyph->advance.x);
 
 	const FT_Bitmap &bitmap = _face->glyph->bitmap;
-	glyph.image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
+	if (bitmap.pixel_mode != FT_PIXEL_MODE_MONO && bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
+		return false;
+	}
+
+	_atlas.allocate(bitmap.width, bitmap.rows, glyph.image);
 
 	const uint8 *src = bitmap.buffer;
 	int srcPitch = bitmap.pitch;
@@ -607,12 +619,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 	uint8 *dst = (uint8 *)glyph.image.getPixels();
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
 
 	switch (bitmap.pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
 		for (int y = 0; y < (int)bitmap.rows; ++y) {
 			const uint8 *curSrc = src;
+			uint8 *curDst = dst;
 			uint8 mask = 0;
 
 			for (int x = 0; x < (int)bitmap.width; ++x) {
@@ -620,12 +632,13 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					*curDst = 255;
 
 				mask <<= 1;
-				++dst;
+				++curDst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -639,9 +652,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		break;
 
 	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
-		glyph.image.free();
-		return false;
+		break;
 	}
 
 	return true;
@@ -23,8 +23,18 @@
 #include "larryScale.h"
 #include <cassert>
 #include "common/array.h"
+#include "common/system.h"
+#include "common/taskscheduler.h"
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LARRYSCALE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LARRYSCALE_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 typedef LarryScaleColor Color;
@@ -182,13 +192,120 @@ inline bool isLinePixel(const MarginedBitmap<Color> &src, int x, int y) {
 #undef EQUALS
 }
 
-MarginedBitmap<bool> createMarginedLinePixelsBitmap(const MarginedBitmap<Color> &src) {
-	MarginedBitmap<bool> result(src.getWidth(), src.getHeight(), false);
-	for (int y = 0; y < src.getHeight(); ++y) {
-		for (int x = 0; x < src.getWidth(); ++x) {
-			result.set(x, y, isLinePixel(src, x, y));
+#if defined(LARRYSCALE_USE_SSE2) || defined(LARRYSCALE_USE_NEON)
+
+#ifdef LARRYSCALE_USE_SSE2
+typedef __m128i PixelMask;
+
+static inline PixelMask loadPixels(const Color *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline PixelMask maskEquals(PixelMask a, PixelMask b) { return _mm_cmpeq_epi8(a, b); }
+static inline PixelMask maskAnd(PixelMask a, PixelMask b) { return _mm_and_si128(a, b); }
+static inline PixelMask maskOr(PixelMask a, PixelMask b) { return _mm_or_si128(a, b); }
+static inline void storeMask(byte *p, PixelMask m) { _mm_storeu_si128((__m128i *)p, m); }
+#else
+typedef uint8x16_t PixelMask;
+
+static inline PixelMask loadPixels(const Color *p) { return vld1q_u8(p); }
+static inline PixelMask maskEquals(PixelMask a, PixelMask b) { return vceqq_u8(a, b); }
+static inline PixelMask maskAnd(PixelMask a, PixelMask b) { return vandq_u8(a, b); }
+static inline PixelMask maskOr(PixelMask a, PixelMask b) { return vorrq_u8(a, b); }
+static inline void storeMask(byte *p, PixelMask m) { vst1q_u8(p, m); }
+#endif
+
+// Classifies 16 pixels at once, with the same rules as isLinePixel().
+// Returns how many pixels of the row are done.
+int classifyLinePixels16(const MarginedBitmap<Color> &src, MarginedBitmap<bool> &result, int y) {
+	const int width = src.getWidth();
+	const int stride = src.getStride();
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const Color *p = src.getPointerTo(x, y);
+		const PixelMask pixel = loadPixels(p);
+#define EQUALS(xOffset, yOffset) maskEquals(loadPixels(p + (yOffset) * stride + (xOffset)), pixel)
+
+		const PixelMask nw = EQUALS(-1, -1), n = EQUALS(0, -1), ne = EQUALS(1, -1), e = EQUALS(1, 0);
+		const PixelMask se = EQUALS(1, 1), s = EQUALS(0, 1), sw = EQUALS(-1, 1), w = EQUALS(-1, 0);
+
+		// Single pixels are fills
+		const PixelMask hasEqualNeighbor = maskOr(maskOr(maskOr(nw, n), maskOr(ne, e)), maskOr(maskOr(se, s), maskOr(sw, w)));
+
+		// 2x2 blocks are fills
+		PixelMask fill = maskAnd(maskAnd(n, ne), e);
+		fill = maskOr(fill, maskAnd(maskAnd(e, se), s));
+		fill = maskOr(fill, maskAnd(maskAnd(s, sw), w));
+		fill = maskOr(fill, maskAnd(maskAnd(w, nw), n));
+
+		// A pixel adjacent to a 2x2 block is a fill.
+		fill = maskOr(fill, maskAnd(maskAnd(nw, n), maskAnd(EQUALS(-1, -2), EQUALS(0, -2))));
+		fill = maskOr(fill, maskAnd(maskAnd(n, ne), maskAnd(EQUALS(0, -2), EQUALS(1, -2))));
+		fill = maskOr(fill, maskAnd(maskAnd(ne, e), maskAnd(EQUALS(2, -1), EQUALS(2, 0))));
+		fill = maskOr(fill, maskAnd(maskAnd(e, se), maskAnd(EQUALS(2, 0), EQUALS(2, 1))));
+		fill = maskOr(fill, maskAnd(maskAnd(se, s), maskAnd(EQUALS(1, 2), EQUALS(0, 2))));
+		fill = maskOr(fill, maskAnd(maskAnd(s, sw), maskAnd(EQUALS(0, 2), EQUALS(-1, 2))));
+		fill = maskOr(fill, maskAnd(maskAnd(sw, w), maskAnd(EQUALS(-2, 1), EQUALS(-2, 0))));
+		fill = maskOr(fill, maskAnd(maskAnd(w, nw), maskAnd(EQUALS(-2, 0), EQUALS(-2, -1))));
+
+#undef EQUALS
+
+		// Everything else is part of a line
+		byte lineMask[16];
+		storeMask(lineMask, hasEqualNeighbor);
+		byte fillMask[16];
+		storeMask(fillMask, fill);
+		bool *const dst = result.getPointerTo(x, y);
+		for (int i = 0; i < 16; ++i) {
+			dst[i] = lineMask[i] && !fillMask[i];
 		}
 	}
+	return x;
+}
+
+#endif // LARRYSCALE_USE_SSE2 || LARRYSCALE_USE_NEON
+
+void classifyLinePixelRow(const MarginedBitmap<Color> &src, MarginedBitmap<bool> &result, int y) {
+	int x = 0;
+#if defined(LARRYSCALE_USE_SSE2) || defined(LARRYSCALE_USE_NEON)
+	x = classifyLinePixels16(src, result, y);
+#endif
+	for (; x < src.getWidth(); ++x) {
+		result.set(x, y, isLinePixel(src, x, y));
+	}
+}
+
+// The minimum number of pixels to hand to a single task
+const uint kMinPixelsPerTask = 16 * 1024;
+
+// Runs `body` for `count` rows of `pixelsPerRow` pixels each, spread over the
+// task scheduler when there is enough work to split.
+void runRows(Common::ParallelForBody &body, int count, int pixelsPerRow) {
+	Common::TaskScheduler *scheduler = g_system ? g_system->getTaskScheduler() : nullptr;
+	const uint grainSize = MAX<uint>(1, kMinPixelsPerTask / MAX(1, pixelsPerRow));
+	if (scheduler && !scheduler->isSerial() && (uint)count >= 2 * grainSize) {
+		scheduler->parallelFor(0, count, body, grainSize);
+	} else {
+		body.run(0, count);
+	}
+}
+
+class LinePixelsBody : public Common::ParallelForBody {
+	const MarginedBitmap<Color> &_src;
+	MarginedBitmap<bool> &_result;
+public:
+	LinePixelsBody(const MarginedBitmap<Color> &src, MarginedBitmap<bool> &result) :
+		_src(src), _result(result) {}
+
+	void run(uint begin, uint end) {
+		for (uint y = begin; y < end; ++y) {
+			classifyLinePixelRow(_src, _result, y);
+		}
+	}
+};
+
+MarginedBitmap<bool> createMarginedLinePixelsBitmap(const MarginedBitmap<Color> &src) {
+	MarginedBitmap<bool> result(src.getWidth(), src.getHeight(), false);
+	LinePixelsBody body(src, result);
+	runRows(body, src.getHeight(), src.getWidth());
 	return result;
 }
 
@@ -287,6 +404,67 @@ EqualityMatrix getEqualityMatrix(const Color *pixel, int stride) {
 // scapeUp() requires generated functions
 #include "larryScale_generated.cpp"
 
+// Upscales bands of source rows into a buffer holding the whole target image.
+// Each band writes only to its own target rows, so bands can run in parallel.
+class ScaleUpBody : public Common::ParallelForBody {
+	const MarginedBitmap<Color> &_src;
+	const MarginedBitmap<bool> &_linePixels;
+	const int _dstWidth;
+	const int _dstHeight;
+	Color *const _dst;
+public:
+	ScaleUpBody(const MarginedBitmap<Color> &src, const MarginedBitmap<bool> &linePixels, int dstWidth, int dstHeight, Color *dst) :
+		_src(src), _linePixels(linePixels), _dstWidth(dstWidth), _dstHeight(dstHeight), _dst(dst) {}
+
+	void run(uint begin, uint end) {
+		const MarginedBitmap<Color> &src = _src;
+		const MarginedBitmap<bool> &linePixels = _linePixels;
+		const int dstWidth = _dstWidth;
+		const int dstHeight = _dstHeight;
+
+		for (int srcY = begin; srcY < (int)end; ++srcY) {
+			const int dstY1 = srcY * dstHeight / src.getHeight();
+			const int dstY2 = (srcY + 1) * dstHeight / src.getHeight();
+			const int dstBlockHeight = dstY2 - dstY1;
+			Color *const topDstRow = _dst + dstY1 * dstWidth;
+			// Only written to for blocks that are two pixels high
+			Color *const bottomDstRow = topDstRow + dstWidth;
+
+			for (int srcX = 0; srcX < src.getWidth(); ++srcX) {
+				const int dstX1 = srcX * dstWidth / src.getWidth();
+				const int dstX2 = (srcX + 1) * dstWidth / src.getWidth();
+				const int dstBlockWidth = dstX2 - dstX1;
+
+				if (dstBlockWidth == 1) {
+					if (dstBlockHeight == 1) {
+						// 1x1
+						topDstRow[dstX1] = src.get(srcX, srcY);
+					} else {
+						// 1x2
+						Color &top = topDstRow[dstX1];
+						Color &bottom = bottomDstRow[dstX1];
+						scalePixelTo1x2(src, linePixels, srcX, srcY, top, bottom);
+					}
+				} else {
+					if (dstBlockHeight == 1) {
+						// 2x1
+						Color &left = topDstRow[dstX1];
+						Color &right = topDstRow[dstX1 + 1];
+						scalePixelTo2x1(src, linePixels, srcX, srcY, left, right);
+					} else {
+						// 2x2
+						Color &topLeft = topDstRow[dstX1];
+						Color &topRight = topDstRow[dstX1 + 1];
+						Color &bottomLeft = bottomDstRow[dstX1];
+						Color &bottomRight = bottomDstRow[dstX1 + 1];
+						scalePixelTo2x2(src, linePixels, srcX, srcY, topLeft, topRight, bottomLeft, bottomRight);
+					}
+				}
+			}
+		}
+	}
+};
+
 void scaleUp(
 	const MarginedBitmap<Color> &src,
 	int dstWidth, int dstHeight,
@@ -301,48 +479,13 @@ void scaleUp(
 	assert(dstHeight >= srcHeight && dstHeight <= 2 * src.getHeight());
 
 	const MarginedBitmap<bool> linePixels = createMarginedLinePixelsBitmap(src);
-	Common::Array<Color> topDstRow(dstWidth);
-	Common::Array<Color> bottomDstRow(dstWidth);
-	for (int srcY = 0; srcY < src.getHeight(); ++srcY) {
-		const int dstY1 = srcY * dstHeight / src.getHeight();
-		const int dstY2 = (srcY + 1) * dstHeight / src.getHeight();
-		const int dstBlockHeight = dstY2 - dstY1;
-
-		for (int srcX = 0; srcX < src.getWidth(); ++srcX) {
-			const int dstX1 = srcX * dstWidth / src.getWidth();
-			const int dstX2 = (srcX + 1) * dstWidth / src.getWidth();
-			const int dstBlockWidth = dstX2 - dstX1;
-
-			if (dstBlockWidth == 1) {
-				if (dstBlockHeight == 1) {
-					// 1x1
-					topDstRow[dstX1] = src.get(srcX, srcY);
-				} else {
-					// 1x2
-					Color &top = topDstRow[dstX1];
-					Color &bottom = bottomDstRow[dstX1];
-					scalePixelTo1x2(src, linePixels, srcX, srcY, top, bottom);
-				}
-			} else {
-				if (dstBlockHeight == 1) {
-					// 2x1
-					Color &left = topDstRow[dstX1];
-					Color &right = topDstRow[dstX1 + 1];
-					scalePixelTo2x1(src, linePixels, srcX, srcY, left, right);
-				} else {
-					// 2x2
-					Color &topLeft = topDstRow[dstX1];
-					Color &topRight = topDstRow[dstX1 + 1];
-					Color &bottomLeft = bottomDstRow[dstX1];
-					Color &bottomRight = bottomDstRow[dstX1 + 1];
-					scalePixelTo2x2(src, linePixels, srcX, srcY, topLeft, topRight, bottomLeft, bottomRight);
-				}
-			}
-		}
-		rowWriter.writeRow(dstY1, topDstRow.data());
-		if (dstBlockHeight == 2) {
-			rowWriter.writeRow(dstY1 + 1, bottomDstRow.data());
-		}
+	Common::Array<Color> dst(dstWidth * dstHeight);
+	ScaleUpBody body(src, linePixels, dstWidth, dstHeight, dst.data());
+	runRows(body, srcHeight, dstWidth * dstHeight / srcHeight);
+
+	// Row writers need not be thread-safe, so hand them the rows in order
+	for (int dstY = 0; dstY < dstHeight; ++dstY) {
+		rowWriter.writeRow(dstY, dst.data() + dstY * dstWidth);
 	}
 }
 
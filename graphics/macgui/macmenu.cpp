@@ -552,6 +552,22 @@ bool MacMenu::draw(ManagedSurface *g, bool forceRedraw) {
 	return true;
 }
 
+Common::Rect MacMenu::getVisibleArea() {
+	if (!_isVisible)
+		return Common::Rect();
+
+	Common::Rect area(_bbox);
+	if (_activeItem != -1 && !_items[_activeItem]->subbbox.isEmpty()) {
+		// Include the shadow drawn by renderSubmenu
+		Common::Rect sub(_items[_activeItem]->subbbox);
+		sub.right += 2;
+		sub.bottom += 2;
+		area.extend(sub);
+	}
+
+	return area;
+}
+
 void MacMenu::renderSubmenu(MacMenuItem *menu) {
 	Common::Rect *r = &menu->subbbox;
 
@@ -79,6 +79,12 @@ public:
 	bool hasAllFocus() { return _menuActivated; }
 
 	bool isVisible() { return _isVisible; }
+
+	/**
+	 * Accessor for the area covered by the menu bar and the open submenu.
+	 * @return The area relative to the WM's screen, or an empty rect when hidden.
+	 */
+	Common::Rect getVisibleArea();
 	void setVisible(bool visible) { _isVisible = visible; _contentIsDirty = true; }
 
 	Common::Rect _bbox;
@@ -127,7 +127,28 @@ const MacFont *MacTextWindow::getTextWindowFont() {
 	return _font;
 }
 
-bool MacTextWindow::draw(ManagedSurface *g, bool forceRedraw) {
+Common::Rect MacTextWindow::getDirtyArea() {
+	if (_borderIsDirty || _contentIsDirty || _inputIsDirty)
+		return getComposeArea();
+
+	if (!_cursorDirty)
+		return Common::Rect();
+
+	// Only the cursor blinked or moved
+	Common::Rect cursor = getCursorComposeRect();
+	if (!_composedCursorRect.isEmpty())
+		cursor.extend(_composedCursorRect);
+	cursor.translate(_dims.left - 2, _dims.top - 2);
+	return cursor;
+}
+
+Common::Rect MacTextWindow::getCursorComposeRect() const {
+	Common::Rect cursor(_cursorRect->width(), _cursorRect->height());
+	cursor.moveTo(_cursorX + kConWOverlap - 2, _cursorY + kConHOverlap - 2);
+	return cursor;
+}
+
+bool MacTextWindow::compose(bool forceRedraw) {
 	if (!_borderIsDirty && !_contentIsDirty && !_cursorDirty && !_inputIsDirty && !forceRedraw)
 		return false;
 
@@ -143,6 +164,8 @@ bool MacTextWindow::draw(ManagedSurface *g, bool forceRedraw) {
 	}
 
 	_contentIsDirty = false;
+	_cursorDirty = false;
+	_composedCursorRect = getCursorComposeRect();
 
 	// Compose
 	_mactext->draw(&_composeSurface, 0, _scrollPos, _surface.w - 2, _scrollPos + _surface.h - 2, kConWOverlap - 2, kConWOverlap - 2);
@@ -155,8 +178,6 @@ bool MacTextWindow::draw(ManagedSurface *g, bool forceRedraw) {
 
 	_composeSurface.transBlitFrom(_borderSurface, kColorGreen);
 
-	g->transBlitFrom(_composeSurface, _composeSurface.getBounds(), Common::Point(_dims.left - 2, _dims.top - 2), kColorGreen2);
-
 	return true;
 }
 
@@ -55,7 +55,7 @@ public:
 
 	virtual bool processEvent(Common::Event &event);
 
-	virtual bool draw(ManagedSurface *g, bool forceRedraw = false);
+	virtual Common::Rect getDirtyArea();
 
 	void setTextWindowFont(const MacFont *macFont);
 	const MacFont *getTextWindowFont();
@@ -74,9 +74,14 @@ public:
 	Common::String cutSelection();
 	const SelectedText *getSelectedText() { return &_selectedText; }
 
+protected:
+	virtual bool compose(bool forceRedraw);
+
 private:
 	bool isCutAllowed();
 
+	Common::Rect getCursorComposeRect() const;
+
 	void scroll(int delta);
 
 	void undrawInput();
@@ -103,6 +108,8 @@ private:
 	const Font *_fontRef;
 
 	ManagedSurface *_cursorSurface;
+	/** Where the cursor was when _composeSurface was last updated */
+	Common::Rect _composedCursorRect;
 
 	bool _inTextSelection;
 	SelectedText _selectedText;
@@ -130,7 +130,7 @@ void MacWindow::setBackgroundPattern(int pattern) {
 	_contentIsDirty = true;
 }
 
-bool MacWindow::draw(ManagedSurface *g, bool forceRedraw) {
+bool MacWindow::compose(bool forceRedraw) {
 	if (!_borderIsDirty && !_contentIsDirty && !forceRedraw)
 		return false;
 
@@ -139,15 +139,45 @@ bool MacWindow::draw(ManagedSurface *g, bool forceRedraw) {
 
 	_contentIsDirty = false;
 
-	// Compose
 	_composeSurface.blitFrom(_surface, Common::Rect(0, 0, _surface.w - 2, _surface.h - 2), Common::Point(2, 2));
 	_composeSurface.transBlitFrom(_borderSurface, kColorGreen);
 
+	return true;
+}
+
+Common::Rect MacWindow::getComposeArea() const {
+	return Common::Rect(_dims.left - 2, _dims.top - 2, _dims.left - 2 + _composeSurface.w, _dims.top - 2 + _composeSurface.h);
+}
+
+bool MacWindow::draw(ManagedSurface *g, bool forceRedraw) {
+	if (!compose(forceRedraw))
+		return false;
+
 	g->transBlitFrom(_composeSurface, _composeSurface.getBounds(), Common::Point(_dims.left - 2, _dims.top - 2), kColorGreen2);
 
 	return true;
 }
 
+void MacWindow::drawClipped(ManagedSurface *g, const Common::Rect &clip) {
+	// The border surface is kept, so it is only redrawn when it changes
+	compose(false);
+
+	Common::Rect area = getComposeArea().findIntersectingRect(clip);
+	if (area.isEmpty())
+		return;
+
+	const Common::Point dest(area.left, area.top);
+	area.translate(2 - _dims.left, 2 - _dims.top);
+	g->transBlitFrom(_composeSurface, area, dest, kColorGreen2);
+}
+
+Common::Rect MacWindow::getDirtyArea() {
+	if (!_borderIsDirty && !_contentIsDirty)
+		return Common::Rect();
+
+	return getComposeArea();
+}
+
 
 #define ARROW_W 12
 #define ARROW_H 6
@@ -346,10 +376,13 @@ void MacWindow::loadBorder(Common::SeekableReadStream &file, bool active, int lo
 	updateInnerDims();
 	source->free();
 	delete source;
+
+	_borderIsDirty = true;
 }
 
 void MacWindow::setCloseable(bool closeable) {
 	_closeable = closeable;
+	_borderIsDirty = true;
 }
 
 void MacWindow::drawBox(ManagedSurface *g, int x, int y, int w, int h) {
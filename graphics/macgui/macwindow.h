@@ -130,6 +130,38 @@ public:
 	 */
 	virtual bool draw(ManagedSurface *g, bool forceRedraw = false) = 0;
 
+	/**
+	 * Method called by the WM to draw only the part of the window that lies
+	 * inside clip, after bringing the window up to date. Nothing outside of
+	 * clip is touched.
+	 * The default implementation draws the whole window, which is only
+	 * suitable for windows that are always on top.
+	 * @param g Surface on which to draw the window.
+	 * @param clip Area of g that may be drawn to.
+	 */
+	virtual void drawClipped(ManagedSurface *g, const Common::Rect &clip) { draw(g, true); }
+
+	/**
+	 * Method called by the WM to find out what changed since the window
+	 * was last drawn.
+	 * @return The changed area relative to the WM's screen, or an empty rect.
+	 */
+	virtual Common::Rect getDirtyArea() { return _contentIsDirty ? _dims : Common::Rect(); }
+
+	/**
+	 * Accessor for the part of the window which hides everything beneath it.
+	 * Used by the WM to skip drawing windows that are covered.
+	 * @return The opaque area relative to the WM's screen.
+	 */
+	virtual Common::Rect getOpaqueArea() { return Common::Rect(); }
+
+	/**
+	 * Accessors for the area of the WM's screen the window covered when it
+	 * was last drawn. Maintained by the WM.
+	 */
+	const Common::Rect &getComposedArea() { return _composedArea; }
+	void setComposedArea(const Common::Rect &area) { _composedArea = area; }
+
 	/**
 	 * Method called by the WM when there is an event concerning the window.
 	 * Note that depending on the subclass of the window, it might not be called
@@ -160,6 +192,7 @@ protected:
 	bool _contentIsDirty;
 
 	Common::Rect _dims;
+	Common::Rect _composedArea;
 
 	bool (*_callback)(WindowClick, Common::Event &, void *);
 	void *_dataPtr;
@@ -230,6 +263,13 @@ public:
 	 */
 	virtual bool draw(ManagedSurface *g, bool forceRedraw = false);
 
+	/**
+	 * See BaseMacWindow.
+	 */
+	virtual void drawClipped(ManagedSurface *g, const Common::Rect &clip);
+	virtual Common::Rect getDirtyArea();
+	virtual Common::Rect getOpaqueArea() { return _innerDims; }
+
 	/**
 	 * Mutator to change the active state of the window.
 	 * Most often called from the WM.
@@ -246,7 +286,7 @@ public:
 	 * Mutator to change the title of the window.
 	 * @param title Target title of the window.
 	 */
-	void setTitle(Common::String &title) { _title = title; }
+	void setTitle(Common::String &title) { _title = title; _borderIsDirty = true; }
 	/**
 	 * Highlight the target part of the window.
 	 * Used for the default borders.
@@ -303,6 +343,18 @@ protected:
 	void drawBorder();
 	WindowClick isInBorder(int x, int y);
 
+	/**
+	 * Bring _composeSurface up to date with the contents and the border.
+	 * @param forceRedraw If true, the border is redrawn as well.
+	 * @return True if anything had to be redrawn.
+	 */
+	virtual bool compose(bool forceRedraw);
+
+	/**
+	 * Accessor for the area of the WM's screen covered by _composeSurface.
+	 */
+	Common::Rect getComposeArea() const;
+
 protected:
 	ManagedSurface _borderSurface;
 	ManagedSurface _composeSurface;
@@ -167,6 +167,8 @@ MacWindowManager::MacWindowManager() {
 	_colorWhite = 2;
 
 	_fullRefresh = true;
+	_dirtyRegion = nullptr;
+	_desktop = nullptr;
 
 	for (int i = 0; i < ARRAYSIZE(fillPatterns); i++)
 		_patterns.push_back(fillPatterns[i]);
@@ -187,10 +189,28 @@ MacWindowManager::~MacWindowManager() {
 
 	delete _fontMan;
 	delete _screenCopy;
+	delete _dirtyRegion;
+	delete _desktop;
 
 	g_system->getTimerManager()->removeTimerProc(&menuTimerHandler);
 }
 
+void MacWindowManager::setScreen(ManagedSurface *screen) {
+	_screen = screen;
+	_fullRefresh = true;
+
+	// The dirty region and the desktop are made to match the screen before drawing
+	delete _dirtyRegion;
+	_dirtyRegion = nullptr;
+}
+
+void MacWindowManager::addDirtyRect(const Common::Rect &r) {
+	if (_dirtyRegion)
+		_dirtyRegion->addRect(r);
+	else
+		_fullRefresh = true;
+}
+
 MacWindow *MacWindowManager::addWindow(bool scrollable, bool resizable, bool editable) {
 	MacWindow *w = new MacWindow(_lastId, scrollable, resizable, editable, this);
 
@@ -253,7 +273,9 @@ void MacWindowManager::setActive(int id) {
 	_windowStack.remove(_windows[id]);
 	_windowStack.push_back(_windows[id]);
 
-	_fullRefresh = true;
+	// Raising the window only changes what is visible inside of it
+	addDirtyRect(_windows[id]->getComposedArea());
+	addDirtyRect(_windows[id]->getDirtyArea());
 }
 
 void MacWindowManager::removeWindow(MacWindow *target) {
@@ -297,13 +319,29 @@ void macDrawPixel(int x, int y, int color, void *data) {
 }
 
 void MacWindowManager::drawDesktop() {
-	Common::Rect r(_screen->getBounds());
+	if (!_desktop)
+		_desktop = new ManagedSurface();
+	_desktop->create(_screen->w, _screen->h, _screen->format);
+
+	Common::Rect r(_desktop->getBounds());
 
-	MacPlotData pd(_screen, &_patterns, kPatternCheckers, 1, _colorWhite);
+	MacPlotData pd(_desktop, &_patterns, kPatternCheckers, 1, _colorWhite);
 
 	Graphics::drawRoundRect(r, kDesktopArc, _colorBlack, true, macDrawPixel, &pd);
+}
+
+static Common::Rect getWindowArea(BaseMacWindow *w) {
+	const Common::Rect &dims = w->getDimensions();
+	return Common::Rect(dims.left - 2, dims.top - 2, dims.right - 2, dims.bottom - 2);
+}
+
+bool MacWindowManager::isOccluded(Common::List<BaseMacWindow *>::const_iterator window, const Common::Rect &r) {
+	for (++window; window != _windowStack.end(); ++window) {
+		if ((*window)->getOpaqueArea().contains(r))
+			return true;
+	}
 
-	g_system->copyRectToScreen(_screen->getPixels(), _screen->pitch, 0, 0, _screen->w, _screen->h);
+	return false;
 }
 
 void MacWindowManager::draw() {
@@ -311,27 +349,74 @@ void MacWindowManager::draw() {
 
 	removeMarked();
 
-	if (_fullRefresh && !(_mode & kWMModeNoDesktop))
+	if (!_dirtyRegion) {
+		_dirtyRegion = new DirtyRegion(_screen->w, _screen->h, DirtyRegion::kStrategyMerge);
+		_fullRefresh = true;
+	}
+
+	if (!_desktop || _desktop->w != _screen->w || _desktop->h != _screen->h)
 		drawDesktop();
 
+	if (_fullRefresh)
+		_dirtyRegion->addAll();
+
+	// Collect what changed: windows that moved uncover the area they were
+	// drawn to before
 	for (Common::List<BaseMacWindow *>::const_iterator it = _windowStack.begin(); it != _windowStack.end(); it++) {
 		BaseMacWindow *w = *it;
-		if (w->draw(_screen, _fullRefresh)) {
-			w->setDirty(false);
+		const Common::Rect area = getWindowArea(w);
 
-			Common::Rect clip(w->getDimensions().left - 2, w->getDimensions().top - 2, w->getDimensions().right - 2, w->getDimensions().bottom - 2);
-			clip.clip(_screen->getBounds());
-			clip.clip(Common::Rect(0, 0, g_system->getWidth() - 1, g_system->getHeight() - 1));
+		if (area != w->getComposedArea()) {
+			_dirtyRegion->addRect(w->getComposedArea());
+			_dirtyRegion->addRect(area);
+		} else {
+			_dirtyRegion->addRect(w->getDirtyArea());
+		}
+	}
 
-			if (!clip.isEmpty())
-				g_system->copyRectToScreen(_screen->getBasePtr(clip.left, clip.top), _screen->pitch, clip.left, clip.top, clip.width(), clip.height());
+	const Common::Array<Common::Rect> &rects = _dirtyRegion->getRects();
+
+	if (!(_mode & kWMModeNoDesktop)) {
+		for (uint i = 0; i < rects.size(); i++)
+			_screen->blitFrom(*_desktop, rects[i], Common::Point(rects[i].left, rects[i].top));
+	}
+
+	// Composite the damaged areas from the bottom window to the top one
+	for (Common::List<BaseMacWindow *>::const_iterator it = _windowStack.begin(); it != _windowStack.end(); it++) {
+		BaseMacWindow *w = *it;
+		const Common::Rect area = getWindowArea(w);
+		w->setComposedArea(area);
+
+		bool drawn = false;
+		for (uint i = 0; i < rects.size(); i++) {
+			const Common::Rect clip = rects[i].findIntersectingRect(area);
+			if (clip.isEmpty() || isOccluded(it, clip))
+				continue;
+
+			w->drawClipped(_screen, clip);
+			drawn = true;
 		}
+
+		// Hidden windows are brought up to date all the same, so that they
+		// do not count as changed again
+		if (!drawn)
+			w->drawClipped(_screen, Common::Rect());
+		w->setDirty(false);
+	}
+
+	const Common::Rect screenBounds(MIN<int>(_screen->w, g_system->getWidth()), MIN<int>(_screen->h, g_system->getHeight()));
+	for (uint i = 0; i < rects.size(); i++) {
+		const Common::Rect clip = rects[i].findIntersectingRect(screenBounds);
+
+		if (!clip.isEmpty())
+			g_system->copyRectToScreen(_screen->getBasePtr(clip.left, clip.top), _screen->pitch, clip.left, clip.top, clip.width(), clip.height());
 	}
 
 	// Menu is drawn on top of everything and always
 	if (_menu)
-		_menu->draw(_screen, _fullRefresh);
+		_menu->draw(_screen, _fullRefresh || _dirtyRegion->intersects(_menu->getVisibleArea()));
 
+	_dirtyRegion->clear();
 	_fullRefresh = false;
 }
 
@@ -408,11 +493,11 @@ void MacWindowManager::removeMarked() {
 
 	Common::List<BaseMacWindow *>::const_iterator it;
 	for (it = _windowsToRemove.begin(); it != _windowsToRemove.end(); it++) {
+		addDirtyRect((*it)->getComposedArea());
 		removeFromStack(*it);
 		removeFromWindowList(*it);
 		delete *it;
 		_activeWindow = 0;
-		_fullRefresh = true;
 	}
 	_windowsToRemove.clear();
 	_needsRemoval = false;
@@ -27,6 +27,7 @@
 #include "common/list.h"
 #include "common/events.h"
 
+#include "graphics/dirtyregion.h"
 #include "graphics/font.h"
 #include "graphics/fontman.h"
 #include "graphics/macgui/macwindow.h"
@@ -105,7 +106,7 @@ public:
 	 * Note that this method should be called as soon as the WM is created.
 	 * @param screen Surface on which the desktop will be drawn.
 	 */
-	void setScreen(ManagedSurface *screen) { _screen = screen; }
+	void setScreen(ManagedSurface *screen);
 	/**
 	 * Create a window with the given parameters.
 	 * Note that this method allocates the necessary memory for the window.
@@ -172,9 +173,18 @@ public:
 	 */
 	void setFullRefresh(bool redraw) { _fullRefresh = true; }
 
+	/**
+	 * Mutator to indicate that an area of the screen must be redrawn,
+	 * e.g. after drawing over it directly.
+	 * @param r The area relative to the WM's screen.
+	 */
+	void addDirtyRect(const Common::Rect &r);
+
 	/**
 	 * Method to draw the desktop into the screen,
 	 * It will take into accout the contents set as dirty.
+	 * Only the areas which changed since the last call are composited and
+	 * copied to the screen; windows hidden behind others are skipped.
 	 * Note that this method does not refresh the screen,
 	 * g_system must be called separately.
 	 */
@@ -230,6 +240,7 @@ public:
 
 private:
 	void drawDesktop();
+	bool isOccluded(Common::List<BaseMacWindow *>::const_iterator window, const Common::Rect &r);
 
 	void removeMarked();
 	void removeFromStack(BaseMacWindow *target);
@@ -250,6 +261,10 @@ private:
 	int _activeWindow;
 
 	bool _fullRefresh;
+	/** The areas of _screen which have to be composited again */
+	DirtyRegion *_dirtyRegion;
+	/** The desktop pattern, which only has to be drawn once */
+	ManagedSurface *_desktop;
 
 	MacPatterns _patterns;
 
@@ -24,6 +24,14 @@
 #include "common/algorithm.h"
 #include "common/textconsole.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MANAGED_SURFACE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MANAGED_SURFACE_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 const int SCALE_THRESHOLD = 0x100;
@@ -172,64 +180,79 @@ void ManagedSurface::blitFrom(const Surface &src, const Common::Point &destPos)
 	blitFrom(src, Common::Rect(0, 0, src.w, src.h), destPos);
 }
 
+namespace {
+
+/**
+ * Blends one line of pixels in a different format onto a dest line,
+ * using the source alpha
+ */
+template<typename TSRC, typename TDEST>
+void blitLine(const byte *srcP, byte *destP, int width, const PixelFormat &srcFormat, const PixelFormat &destFormat) {
+	const TSRC *srcLine = (const TSRC *)srcP;
+	TDEST *destLine = (TDEST *)destP;
+	byte rSrc, gSrc, bSrc, aSrc;
+	byte rDest, gDest, bDest;
+	double alpha;
+
+	for (int x = 0; x < width; ++x) {
+		srcFormat.colorToARGB(srcLine[x], aSrc, rSrc, gSrc, bSrc);
+
+		if (aSrc == 0) {
+			// Completely transparent, so skip
+			continue;
+		} else if (aSrc == 0xff) {
+			// Completely opaque, so copy RGB values over
+			rDest = rSrc;
+			gDest = gSrc;
+			bDest = bSrc;
+		} else {
+			// Partially transparent, so calculate new pixel colors
+			destFormat.colorToRGB(destLine[x], rDest, gDest, bDest);
+			alpha = (double)aSrc / 255.0;
+			rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
+			gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
+			bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
+		}
+
+		destLine[x] = destFormat.ARGBToColor(0xff, rDest, gDest, bDest);
+	}
+}
+
+typedef void (*BlitLineProc)(const byte *srcP, byte *destP, int width, const PixelFormat &srcFormat, const PixelFormat &destFormat);
+
+} // End of anonymous namespace
+
 void ManagedSurface::blitFrom(const Surface &src, const Common::Rect &srcRect,
 		const Common::Point &destPos) {
 	Common::Rect srcBounds = srcRect;
 	Common::Rect destBounds(destPos.x, destPos.y, destPos.x + srcRect.width(),
 		destPos.y + srcRect.height());
-	uint destPixel;
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest, gDest, bDest;
-	double alpha;
 
 	if (!srcRect.isValidRect() || !clip(srcBounds, destBounds))
 		return;
 
+	BlitLineProc lineProc = nullptr;
 	if (format != src.format) {
 		// When the pixel format differs, both source an dest must be
 		// 2 or 4 bytes per pixel
 		assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
 		assert(src.format.bytesPerPixel == 2 || src.format.bytesPerPixel == 4);
+
+		if (src.format.bytesPerPixel == 2)
+			lineProc = format.bytesPerPixel == 2 ? blitLine<uint16, uint16> : blitLine<uint16, uint32>;
+		else
+			lineProc = format.bytesPerPixel == 2 ? blitLine<uint32, uint16> : blitLine<uint32, uint32>;
 	}
 
 	for (int y = 0; y < srcBounds.height(); ++y) {
 		const byte *srcP = (const byte *)src.getBasePtr(srcBounds.left, srcBounds.top + y);
 		byte *destP = (byte *)getBasePtr(destBounds.left, destBounds.top + y);
 
-		if (src.format == format) {
+		if (!lineProc) {
 			// Matching surface formats, so we can do a straight copy
 			Common::copy(srcP, srcP + srcBounds.width() * format.bytesPerPixel, destP);
 		} else {
-			for (int x = 0; x < srcBounds.width(); ++x,
-					srcP += src.format.bytesPerPixel,
-					destP += format.bytesPerPixel) {
-				src.format.colorToARGB(src.format.bytesPerPixel == 2 ? *(const uint16 *)srcP : *(const uint32 *)srcP,
-					aSrc, rSrc, gSrc, bSrc);
-				format.colorToRGB(format.bytesPerPixel == 2 ? *(const uint16 *)destP : *(const uint32 *)destP,
-					rDest, gDest, bDest);
-
-				if (aSrc == 0) {
-					// Completely transparent, so skip
-					continue;
-				} else if (aSrc == 0xff) {
-					// Completely opaque, so copy RGB values over
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-				} else {
-					// Partially transparent, so calculate new pixel colors
-					alpha = (double)aSrc / 255.0;
-					rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
-					gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
-					bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
-				}
-
-				destPixel = format.ARGBToColor(0xff, rDest, gDest, bDest);
-				if (format.bytesPerPixel == 2)
-					*(uint16 *)destP = destPixel;
-				else
-					*(uint32 *)destP = destPixel;
-			}
+			lineProc(srcP, destP, srcBounds.width(), src.format, format);
 		}
 	}
 
@@ -253,66 +276,152 @@ void ManagedSurface::transBlitFrom(const Surface &src, const Common::Rect &srcRe
 		destPos.x + srcRect.width(), destPos.y + srcRect.height()), transColor, flipped, overrideColor);
 }
 
+namespace {
+
+/**
+ * Copies a line of pixels, leaving the dest pixels where the source has
+ * the transparent color alone
+ */
+template<typename T>
+void transBlitSpan(const T *srcLine, T *destLine, int width, T transColor) {
+	for (int x = 0; x < width; ++x) {
+		if (srcLine[x] != transColor)
+			destLine[x] = srcLine[x];
+	}
+}
+
+#if defined(MANAGED_SURFACE_USE_SSE2) || defined(MANAGED_SURFACE_USE_NEON)
+/** Copies CLUT8 pixels by selecting between source and dest, 16 at a time */
+template<>
+void transBlitSpan<byte>(const byte *srcLine, byte *destLine, int width, byte transColor) {
+	int x = 0;
+
+#ifdef MANAGED_SURFACE_USE_SSE2
+	const __m128i trans = _mm_set1_epi8((char)transColor);
+	for (; x + 16 <= width; x += 16) {
+		const __m128i srcVec = _mm_loadu_si128((const __m128i *)(srcLine + x));
+		const __m128i destVec = _mm_loadu_si128((const __m128i *)(destLine + x));
+		const __m128i mask = _mm_cmpeq_epi8(srcVec, trans);
+		_mm_storeu_si128((__m128i *)(destLine + x),
+			_mm_or_si128(_mm_and_si128(mask, destVec), _mm_andnot_si128(mask, srcVec)));
+	}
+#else
+	const uint8x16_t trans = vdupq_n_u8(transColor);
+	for (; x + 16 <= width; x += 16) {
+		const uint8x16_t srcVec = vld1q_u8(srcLine + x);
+		const uint8x16_t destVec = vld1q_u8(destLine + x);
+		vst1q_u8(destLine + x, vbslq_u8(vceqq_u8(srcVec, trans), destVec, srcVec));
+	}
+#endif
+
+	for (; x < width; ++x) {
+		if (srcLine[x] != transColor)
+			destLine[x] = srcLine[x];
+	}
+}
+#endif
+
+/**
+ * Draws the part of an output line between destination offsets xStart and
+ * xEnd. Flipping, horizontal scaling and whether pixels have to be converted
+ * are template parameters, so the inner loop has no branches for them.
+ */
+template<typename TSRC, typename TDEST, bool FLIPPED, bool SCALED, bool CONVERT>
+void transBlitLine(const TSRC *srcLine, TDEST *destLine, int xStart, int xEnd, int scaleX, int srcW,
+		TSRC transColor, uint overrideColor, uint srcAlpha, const PixelFormat &srcFormat, const PixelFormat &destFormat) {
+	byte aSrc, rSrc, gSrc, bSrc;
+	byte rDest, gDest, bDest;
+	double alpha;
+
+	for (int xCtr = xStart, scaleXCtr = xStart * scaleX; xCtr < xEnd; ++xCtr, scaleXCtr += scaleX) {
+		const int srcX = SCALED ? scaleXCtr / SCALE_THRESHOLD : xCtr;
+		const TSRC srcVal = srcLine[FLIPPED ? srcW - srcX - 1 : srcX];
+		if (srcVal == transColor)
+			continue;
+
+		if (!CONVERT) {
+			// Matching formats, so we can do a straight copy
+			destLine[xCtr] = overrideColor ? overrideColor : srcVal;
+			continue;
+		}
+
+		// Otherwise we have to manually decode and re-encode each pixel
+		srcFormat.colorToARGB(srcVal, aSrc, rSrc, gSrc, bSrc);
+		destFormat.colorToRGB(destLine[xCtr], rDest, gDest, bDest);
+
+		if (srcAlpha != 0xff) {
+			aSrc = aSrc * srcAlpha / 255;
+		}
+
+		if (aSrc == 0) {
+			// Completely transparent, so skip
+			continue;
+		} else if (aSrc == 0xff) {
+			// Completely opaque, so copy RGB values over
+			rDest = rSrc;
+			gDest = gSrc;
+			bDest = bSrc;
+		} else {
+			// Partially transparent, so calculate new pixel colors
+			alpha = (double)aSrc / 255.0;
+			rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
+			gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
+			bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
+		}
+
+		destLine[xCtr] = destFormat.ARGBToColor(0xff, rDest, gDest, bDest);
+	}
+}
+
+template<typename TSRC, typename TDEST, bool FLIPPED, bool SCALED>
+void (*selectTransBlitLine(bool convert))(const TSRC *, TDEST *, int, int, int, int, TSRC, uint, uint, const PixelFormat &, const PixelFormat &) {
+	if (convert)
+		return transBlitLine<TSRC, TDEST, FLIPPED, SCALED, true>;
+	return transBlitLine<TSRC, TDEST, FLIPPED, SCALED, false>;
+}
+
 template<typename TSRC, typename TDEST>
 void transBlit(const Surface &src, const Common::Rect &srcRect, Surface &dest, const Common::Rect &destRect, TSRC transColor, bool flipped, uint overrideColor, uint srcAlpha) {
 	int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
 	int scaleY = SCALE_THRESHOLD * srcRect.height() / destRect.height();
 	const Graphics::PixelFormat &srcFormat = src.format;
 	const Graphics::PixelFormat &destFormat = dest.format;
-	byte aSrc, rSrc, gSrc, bSrc;
-	byte rDest, gDest, bDest;
-	double alpha;
+
+	// Only the part of each output line within the dest surface is drawn
+	const int xStart = MAX(0, -destRect.left);
+	const int xEnd = MIN<int>(destRect.width(), dest.w - destRect.left);
+	const int yStart = MAX<int>(destRect.top, 0);
+	const int yEnd = MIN<int>(destRect.bottom, dest.h);
+	if (xStart >= xEnd || yStart >= yEnd)
+		return;
+
+	const bool scaled = srcRect.width() != destRect.width();
+	const bool convert = !(srcFormat == destFormat && srcAlpha == 0xff);
+	// Unscaled straight copies are done a whole span at a time
+	const bool span = !flipped && !scaled && !convert && !overrideColor && sizeof(TSRC) == sizeof(TDEST);
+
+	typedef void (*LineProc)(const TSRC *, TDEST *, int, int, int, int, TSRC, uint, uint, const PixelFormat &, const PixelFormat &);
+	LineProc lineProc;
+	if (flipped)
+		lineProc = scaled ? selectTransBlitLine<TSRC, TDEST, true, true>(convert) : selectTransBlitLine<TSRC, TDEST, true, false>(convert);
+	else
+		lineProc = scaled ? selectTransBlitLine<TSRC, TDEST, false, true>(convert) : selectTransBlitLine<TSRC, TDEST, false, false>(convert);
 
 	// Loop through drawing output lines
-	for (int destY = destRect.top, scaleYCtr = 0; destY < destRect.bottom; ++destY, scaleYCtr += scaleY) {
-		if (destY < 0 || destY >= dest.h)
-			continue;
+	for (int destY = yStart, scaleYCtr = (yStart - destRect.top) * scaleY; destY < yEnd; ++destY, scaleYCtr += scaleY) {
 		const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
 		TDEST *destLine = (TDEST *)dest.getBasePtr(destRect.left, destY);
 
-		// Loop through drawing the pixels of the row
-		for (int destX = destRect.left, xCtr = 0, scaleXCtr = 0; destX < destRect.right; ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= dest.w)
-				continue;
-
-			TSRC srcVal = srcLine[flipped ? src.w - scaleXCtr / SCALE_THRESHOLD - 1 : scaleXCtr / SCALE_THRESHOLD];
-			if (srcVal == transColor)
-				continue;
-
-			if (srcFormat == destFormat && srcAlpha == 0xff) {
-				// Matching formats, so we can do a straight copy
-				destLine[xCtr] = overrideColor ? overrideColor : srcVal;
-			} else {
-				// Otherwise we have to manually decode and re-encode each pixel
-				srcFormat.colorToARGB(srcVal, aSrc, rSrc, gSrc, bSrc);
-				destFormat.colorToRGB(destLine[xCtr], rDest, gDest, bDest);
-
-				if (srcAlpha != 0xff) {
-					aSrc = aSrc * srcAlpha / 255;
-				}
-
-				if (aSrc == 0) {
-					// Completely transparent, so skip
-					continue;
-				} else if (aSrc == 0xff) {
-					// Completely opaque, so copy RGB values over
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-				} else {
-					// Partially transparent, so calculate new pixel colors
-					alpha = (double)aSrc / 255.0;
-					rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
-					gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
-					bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
-				}
-
-				destLine[xCtr] = destFormat.ARGBToColor(0xff, rDest, gDest, bDest);
-			}
+		if (span) {
+			transBlitSpan<TSRC>(srcLine + xStart, (TSRC *)(destLine + xStart), xEnd - xStart, transColor);
+		} else {
+			lineProc(srcLine, destLine, xStart, xEnd, scaleX, src.w, transColor, overrideColor, srcAlpha, srcFormat, destFormat);
 		}
 	}
 }
 
+} // End of anonymous namespace
+
 #define HANDLE_BLIT(SRC_BYTES, DEST_BYTES, SRC_TYPE, DEST_TYPE) \
 	if (src.format.bytesPerPixel == SRC_BYTES && format.bytesPerPixel == DEST_BYTES) \
 		transBlit<SRC_TYPE, DEST_TYPE>(src, srcRect, _innerSurface, destRect, transColor, flipped, overrideColor, srcAlpha); \
@@ -3,10 +3,12 @@ MODULE := graphics
 MODULE_OBJS := \
 	conversion.o \
 	cursorman.o \
+	dirtyregion.o \
 	font.o \
 	fontman.o \
 	fonts/bdf.o \
 	fonts/consolefont.o \
+	fonts/glyph_atlas.o \
 	fonts/macfont.o \
 	fonts/newfont_big.o \
 	fonts/newfont.o \
@@ -30,6 +32,8 @@ MODULE_OBJS := \
 	screen.o \
 	sjis.o \
 	surface.o \
+	text_run_cache.o \
+	transform_cache.o \
 	transform_struct.o \
 	transform_tools.o \
 	transparent_surface.o \
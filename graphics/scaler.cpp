@@ -20,10 +20,12 @@
  *
  */
 
+#include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 #include "graphics/scaler/scalebit.h"
 #include "common/util.h"
 #include "common/system.h"
+#include "common/taskscheduler.h"
 #include "common/textconsole.h"
 
 int gBitFormat = 565;
@@ -178,6 +180,65 @@ void Normal1x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
 	}
 }
 
+namespace {
+
+enum {
+	// An even height keeps the pattern of DotMatrix in place, and
+	// the AdvMame scalers need at least two rows
+	kStripHeight = 16
+};
+
+struct ScaleStripsBody : public Common::ParallelForBody {
+	ScalerProc *scaler;
+	int scaleFactor;
+	const uint8 *srcPtr;
+	uint32 srcPitch;
+	uint8 *dstPtr;
+	uint32 dstPitch;
+	int width;
+	int height;
+	uint strips;
+
+	virtual void run(uint begin, uint end) {
+		const int top = begin * kStripHeight;
+		// The last strip takes the rows which do not fill a strip of their own
+		const int bottom = (end == strips) ? height : (int)end * kStripHeight;
+		scaler(srcPtr + top * srcPitch, srcPitch, dstPtr + top * scaleFactor * dstPitch, dstPitch, width, bottom - top);
+	}
+};
+
+} // End of anonymous namespace
+
+bool isScalerThreadSafe(ScalerProc *scaler) {
+#if defined(USE_HQ_SCALERS) && defined(USE_NASM)
+	// The assembly versions keep their temporaries in global variables
+	return scaler != HQ2x && scaler != HQ3x;
+#else
+	return true;
+#endif
+}
+
+void scaleInStrips(Common::TaskScheduler &scheduler, ScalerProc *scaler, int scaleFactor,
+					const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+	const uint strips = height / kStripHeight;
+	if (!isScalerThreadSafe(scaler) || scheduler.isSerial() || strips < 2) {
+		scaler(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		return;
+	}
+
+	ScaleStripsBody body;
+	body.scaler = scaler;
+	body.scaleFactor = scaleFactor;
+	body.srcPtr = srcPtr;
+	body.srcPitch = srcPitch;
+	body.dstPtr = dstPtr;
+	body.dstPitch = dstPitch;
+	body.width = width;
+	body.height = height;
+	body.strips = strips;
+	scheduler.parallelFor(0, strips, body);
+}
+
 #ifdef USE_SCALERS
 
 
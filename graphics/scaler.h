@@ -26,12 +26,31 @@
 #include "common/scummsys.h"
 #include "graphics/surface.h"
 
+namespace Common {
+class TaskScheduler;
+}
+
 extern void InitScalers(uint32 BitFormat);
 extern void DestroyScalers();
 
 typedef void ScalerProc(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height);
 
+/**
+ * Returns whether the given scaler may run on several threads at once.
+ */
+extern bool isScalerThreadSafe(ScalerProc *scaler);
+
+/**
+ * Runs a scaler on horizontal strips of the source, which are handed to the
+ * given scheduler to be scaled in parallel. Small areas, serial schedulers
+ * and scalers which are not thread safe are run in one go.
+ *
+ * @param scaleFactor	the integral factor the scaler scales by
+ */
+extern void scaleInStrips(Common::TaskScheduler &scheduler, ScalerProc *scaler, int scaleFactor,
+							const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
+
 #define DECLARE_SCALER(x)	\
 	extern void x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, \
 					uint32 dstPitch, int width, int height)
@@ -146,6 +146,47 @@ void scale2x_32_def(scale2x_uint32* dst0, scale2x_uint32* dst1, const scale2x_ui
 	scale2x_32_def_single(dst1, src2, src1, src0, count);
 }
 
+/***************************************************************************/
+/* Scale2x SSE2 and NEON implementation */
+
+#ifdef SCALER_USE_SIMD
+
+static inline void scale2x_16_simd_single(scale2x_uint16* __restrict__ dst, const scale2x_uint16* __restrict__ src0, const scale2x_uint16* __restrict__ src1, const scale2x_uint16* __restrict__ src2, unsigned count) {
+	using namespace Graphics::ScalerSIMD;
+
+	while (count >= kPixels) {
+		const Vec b = load(src0);
+		const Vec d = load(src1 - 1);
+		const Vec e = load(src1);
+		const Vec f = load(src1 + 1);
+		const Vec h = load(src2);
+
+		// Set where the pixel is left as it is
+		const Vec same = vecOr(eq(b, h), eq(d, f));
+		storeInterleaved2(dst, select(andNot(same, eq(d, b)), b, e), select(andNot(same, eq(f, b)), b, e));
+
+		src0 += kPixels;
+		src1 += kPixels;
+		src2 += kPixels;
+		dst += 2 * kPixels;
+		count -= kPixels;
+	}
+
+	scale2x_16_def_single(dst, src0, src1, src2, count);
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 16 bits.
+ * This function operates like scale2x_16_def() but uses SSE2 or NEON
+ * instructions for eight pixels at a time.
+ */
+void scale2x_16_simd(scale2x_uint16* dst0, scale2x_uint16* dst1, const scale2x_uint16* src0, const scale2x_uint16* src1, const scale2x_uint16* src2, unsigned count) {
+	scale2x_16_simd_single(dst0, src0, src1, src2, count);
+	scale2x_16_simd_single(dst1, src2, src1, src0, count);
+}
+
+#endif
+
 /***************************************************************************/
 /* Scale2x MMX implementation */
 
@@ -220,3 +220,79 @@ void scale3x_32_def(scale3x_uint32* dst0, scale3x_uint32* dst1, scale3x_uint32*
 	scale3x_32_def_center(dst1, src0, src1, src2, count);
 	scale3x_32_def_border(dst2, src2, src1, src0, count);
 }
+
+/***************************************************************************/
+/* Scale3x SSE2 and NEON implementation */
+
+#ifdef SCALER_USE_SIMD
+
+static inline void scale3x_16_simd_border(scale3x_uint16* __restrict__ dst, const scale3x_uint16* __restrict__ src0, const scale3x_uint16* __restrict__ src1, const scale3x_uint16* __restrict__ src2, unsigned count) {
+	using namespace Graphics::ScalerSIMD;
+
+	while (count >= kPixels) {
+		const Vec a = load(src0 - 1);
+		const Vec b = load(src0);
+		const Vec c = load(src0 + 1);
+		const Vec d = load(src1 - 1);
+		const Vec e = load(src1);
+		const Vec f = load(src1 + 1);
+		const Vec h = load(src2);
+
+		// Set where the pixel is left as it is
+		const Vec same = vecOr(eq(b, h), eq(d, f));
+		const Vec db = andNot(same, eq(d, b));
+		const Vec fb = andNot(same, eq(f, b));
+		const Vec mid = vecOr(andNot(eq(e, c), db), andNot(eq(e, a), fb));
+		storeInterleaved3(dst, select(db, d, e), select(mid, b, e), select(fb, f, e));
+
+		src0 += kPixels;
+		src1 += kPixels;
+		src2 += kPixels;
+		dst += 3 * kPixels;
+		count -= kPixels;
+	}
+
+	scale3x_16_def_border(dst, src0, src1, src2, count);
+}
+
+static inline void scale3x_16_simd_center(scale3x_uint16* __restrict__ dst, const scale3x_uint16* __restrict__ src0, const scale3x_uint16* __restrict__ src1, const scale3x_uint16* __restrict__ src2, unsigned count) {
+	using namespace Graphics::ScalerSIMD;
+
+	while (count >= kPixels) {
+		const Vec a = load(src0 - 1);
+		const Vec b = load(src0);
+		const Vec c = load(src0 + 1);
+		const Vec d = load(src1 - 1);
+		const Vec e = load(src1);
+		const Vec f = load(src1 + 1);
+		const Vec g = load(src2 - 1);
+		const Vec h = load(src2);
+		const Vec i = load(src2 + 1);
+
+		const Vec same = vecOr(eq(b, h), eq(d, f));
+		const Vec left = vecOr(andNot(eq(e, g), eq(d, b)), andNot(eq(e, a), eq(d, h)));
+		const Vec right = vecOr(andNot(eq(e, i), eq(f, b)), andNot(eq(e, c), eq(f, h)));
+		storeInterleaved3(dst, select(andNot(same, left), d, e), e, select(andNot(same, right), f, e));
+
+		src0 += kPixels;
+		src1 += kPixels;
+		src2 += kPixels;
+		dst += 3 * kPixels;
+		count -= kPixels;
+	}
+
+	scale3x_16_def_center(dst, src0, src1, src2, count);
+}
+
+/**
+ * Scale by a factor of 3 a row of pixels of 16 bits.
+ * This function operates like scale3x_16_def() but uses SSE2 or NEON
+ * instructions for eight pixels at a time.
+ */
+void scale3x_16_simd(scale3x_uint16* dst0, scale3x_uint16* dst1, scale3x_uint16* dst2, const scale3x_uint16* src0, const scale3x_uint16* src1, const scale3x_uint16* src2, unsigned count) {
+	scale3x_16_simd_border(dst0, src0, src1, src2, count);
+	scale3x_16_simd_center(dst1, src0, src1, src2, count);
+	scale3x_16_simd_border(dst2, src2, src1, src0, count);
+}
+
+#endif
@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_SCALER_SCALESIMD_H
+#define GRAPHICS_SCALER_SCALESIMD_H
+
+#include "common/scummsys.h"
+
+/*
+ * Thin wrappers around SSE2 and NEON, so that the vectorized scalers only
+ * need one implementation for both. A vector holds eight 16 bit pixels.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCALER_USE_SSE2
+#define SCALER_USE_SIMD
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SCALER_USE_NEON
+#define SCALER_USE_SIMD
+#include <arm_neon.h>
+#endif
+
+#ifdef SCALER_USE_SIMD
+
+namespace Graphics {
+namespace ScalerSIMD {
+
+enum {
+	kPixels = 8
+};
+
+#ifdef SCALER_USE_SSE2
+
+typedef __m128i Vec;
+
+inline Vec load(const uint16 *src) { return _mm_loadu_si128((const __m128i *)src); }
+inline void store(uint16 *dst, Vec a) { _mm_storeu_si128((__m128i *)dst, a); }
+inline Vec eq(Vec a, Vec b) { return _mm_cmpeq_epi16(a, b); }
+inline Vec vecOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+inline Vec vecAnd(Vec a, Vec b) { return _mm_and_si128(a, b); }
+/** Returns b with the bits set in a cleared */
+inline Vec andNot(Vec a, Vec b) { return _mm_andnot_si128(a, b); }
+inline Vec select(Vec mask, Vec a, Vec b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+
+inline void storeInterleaved2(uint16 *dst, Vec a, Vec b) {
+	store(dst, _mm_unpacklo_epi16(a, b));
+	store(dst + kPixels, _mm_unpackhi_epi16(a, b));
+}
+
+inline void storeInterleaved3(uint16 *dst, Vec a, Vec b, Vec c) {
+	// SSE2 has no three way interleave, but the comparisons were the
+	// expensive part anyway
+	uint16 va[kPixels], vb[kPixels], vc[kPixels];
+	store(va, a);
+	store(vb, b);
+	store(vc, c);
+	for (int i = 0; i < kPixels; ++i) {
+		dst[i * 3 + 0] = va[i];
+		dst[i * 3 + 1] = vb[i];
+		dst[i * 3 + 2] = vc[i];
+	}
+}
+
+#else
+
+typedef uint16x8_t Vec;
+
+inline Vec load(const uint16 *src) { return vld1q_u16(src); }
+inline void store(uint16 *dst, Vec a) { vst1q_u16(dst, a); }
+inline Vec eq(Vec a, Vec b) { return vceqq_u16(a, b); }
+inline Vec vecOr(Vec a, Vec b) { return vorrq_u16(a, b); }
+inline Vec vecAnd(Vec a, Vec b) { return vandq_u16(a, b); }
+inline Vec andNot(Vec a, Vec b) { return vbicq_u16(b, a); }
+inline Vec select(Vec mask, Vec a, Vec b) { return vbslq_u16(mask, a, b); }
+
+inline void storeInterleaved2(uint16 *dst, Vec a, Vec b) {
+	uint16x8x2_t v;
+	v.val[0] = a;
+	v.val[1] = b;
+	vst2q_u16(dst, v);
+}
+
+inline void storeInterleaved3(uint16 *dst, Vec a, Vec b, Vec c) {
+	uint16x8x3_t v;
+	v.val[0] = a;
+	v.val[1] = b;
+	v.val[2] = c;
+	vst3q_u16(dst, v);
+}
+
+#endif
+
+} // End of namespace ScalerSIMD
+} // End of namespace Graphics
+
+#endif // SCALER_USE_SIMD
+
+#endif
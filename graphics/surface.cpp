@@ -354,6 +354,23 @@ void Surface::move(int dx, int dy, int height) {
 	}
 }
 
+/**
+ * Converts the palette entries used by a CLUT8 surface to the given format,
+ * so crossBlitMap can look them up. Entries above the highest index used
+ * are left alone, so the palette is not read beyond them.
+ */
+static void createPaletteMap(uint32 *map, const Surface &surface, const byte *palette, const PixelFormat &dstFormat) {
+	byte maxIndex = 0;
+	for (int y = 0; y < surface.h; y++) {
+		const byte *row = (const byte *)surface.getBasePtr(0, y);
+		for (int x = 0; x < surface.w; x++)
+			maxIndex = MAX(maxIndex, row[x]);
+	}
+
+	for (uint i = 0; i <= maxIndex; i++)
+		map[i] = dstFormat.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+}
+
 void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette) {
 	// Do not convert to the same format and ignore empty surfaces.
 	if (format == dstFormat || pixels == 0) {
@@ -382,26 +399,9 @@ void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette
 	if (format.bytesPerPixel == 1) {
 		assert(palette);
 
-		for (int y = h; y > 0; --y) {
-			const byte *srcRow = (const byte *)pixels + y * pitch - 1;
-			byte *dstRow = (byte *)pixels + y * w * dstFormat.bytesPerPixel - dstFormat.bytesPerPixel;
-
-			for (int x = 0; x < w; x++) {
-				byte index = *srcRow--;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
-
-				if (dstFormat.bytesPerPixel == 2)
-					*((uint16 *)dstRow) = color;
-				else
-					*((uint32 *)dstRow) = color;
-
-				dstRow -= dstFormat.bytesPerPixel;
-			}
-		}
+		uint32 map[256];
+		createPaletteMap(map, *this, palette, dstFormat);
+		crossBlitMap((byte *)pixels, (const byte *)pixels, w * dstFormat.bytesPerPixel, pitch, w, h, dstFormat.bytesPerPixel, map);
 	} else {
 		crossBlit((byte *)pixels, (const byte *)pixels, w * dstFormat.bytesPerPixel, pitch, w, h, dstFormat, format);
 	}
@@ -443,30 +443,28 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 		// Converting from paletted to high color
 		assert(palette);
 
+		uint32 map[256];
+		createPaletteMap(map, *this, palette, dstFormat);
+
+		if (dstFormat.bytesPerPixel != 3) {
+			crossBlitMap((byte *)surface->pixels, (const byte *)pixels, surface->pitch, pitch, w, h, dstFormat.bytesPerPixel, map);
+			return surface;
+		}
+
 		for (int y = 0; y < h; y++) {
 			const byte *srcRow = (const byte *)getBasePtr(0, y);
 			byte *dstRow = (byte *)surface->getBasePtr(0, y);
 
 			for (int x = 0; x < w; x++) {
-				byte index = *srcRow++;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
-
-				if (dstFormat.bytesPerPixel == 2)
-					*((uint16 *)dstRow) = color;
-				else if (dstFormat.bytesPerPixel == 3)
-					WRITE_UINT24(dstRow, color);
-				else
-					*((uint32 *)dstRow) = color;
-
+				WRITE_UINT24(dstRow, map[*srcRow++]);
 				dstRow += dstFormat.bytesPerPixel;
 			}
 		}
-	} else {
+	} else if (dstFormat.bytesPerPixel != 3) {
 		// Converting from high color to high color
+		crossBlit((byte *)surface->pixels, (const byte *)pixels, surface->pitch, pitch, w, h, dstFormat, format);
+	} else {
+		// Converting from high color to 3Bpp, which crossBlit doesn't handle
 		for (int y = 0; y < h; y++) {
 			const byte *srcRow = (const byte *)getBasePtr(0, y);
 			byte *dstRow = (byte *)surface->getBasePtr(0, y);
@@ -0,0 +1,323 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/text_run_cache.h"
+
+#include "common/hash-str.h"
+
+namespace Graphics {
+
+namespace {
+
+enum {
+	kFlagEllipsis = 1 << 0,
+	kFlagEvenWidthLines = 1 << 1,
+	kFlagWrapOnExplicitNewLines = 1 << 2
+};
+
+// Runs are rendered in white onto black. Since the fonts blend every glyph
+// over what is already there, the red channel then holds the combined
+// coverage of all glyphs, even where they overlap.
+const PixelFormat kRunFormat(4, 8, 8, 8, 0, 16, 8, 0, 0);
+const uint32 kRunColor = 0xFFFFFF;
+
+Common::Rect getRunBounds(const Font &font, const Common::String &str, int w, TextAlign align, int deltax, bool useEllipsis) {
+	return font.getBoundingBox(str, 0, 0, w, align, deltax, useEllipsis);
+}
+
+Common::Rect getRunBounds(const Font &font, const Common::U32String &str, int w, TextAlign align, int, bool) {
+	return font.getBoundingBox(str, 0, 0, w, align);
+}
+
+void drawRun(const Font &font, Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) {
+	font.drawString(dst, str, x, y, w, color, align, deltax, useEllipsis);
+}
+
+void drawRun(const Font &font, Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool) {
+	font.drawString(dst, str, x, y, w, color, align, deltax);
+}
+
+template<typename ColorType>
+void blendMask(byte *dstPos, int dstPitch, const byte *srcPos, int srcPitch, int w, int h, uint32 color, const PixelFormat &format) {
+	uint8 sR, sG, sB;
+	format.colorToRGB(color, sR, sG, sB);
+
+	for (int y = 0; y < h; ++y) {
+		ColorType *dst = (ColorType *)dstPos;
+		const byte *src = srcPos;
+
+		for (int x = 0; x < w; ++x, ++dst, ++src) {
+			const uint8 a = *src;
+			if (a == 255) {
+				*dst = color;
+			} else if (a) {
+				uint8 dR, dG, dB;
+				format.colorToRGB(*dst, dR, dG, dB);
+				dR = ((255 - a) * dR + a * sR) / 255;
+				dG = ((255 - a) * dG + a * sG) / 255;
+				dB = ((255 - a) * dB + a * sB) / 255;
+				*dst = format.RGBToColor(dR, dG, dB);
+			}
+		}
+
+		dstPos += dstPitch;
+		srcPos += srcPitch;
+	}
+}
+
+void drawMask(Surface *dst, const Surface &mask, int x, int y, uint32 color) {
+	Common::Rect area(x, y, x + mask.w, y + mask.h);
+	area.clip(Common::Rect(dst->w, dst->h));
+	if (area.isEmpty())
+		return;
+
+	const byte *srcPos = (const byte *)mask.getBasePtr(area.left - x, area.top - y);
+	byte *dstPos = (byte *)dst->getBasePtr(area.left, area.top);
+	const int w = area.width(), h = area.height();
+
+	if (dst->format.bytesPerPixel == 1) {
+		// Color indexed modes can not take advantage of anti-aliasing
+		for (int cy = 0; cy < h; ++cy) {
+			for (int cx = 0; cx < w; ++cx) {
+				if (srcPos[cx] >= 0x80)
+					dstPos[cx] = color;
+			}
+			dstPos += dst->pitch;
+			srcPos += mask.pitch;
+		}
+	} else if (dst->format.bytesPerPixel == 2) {
+		blendMask<uint16>(dstPos, dst->pitch, srcPos, mask.pitch, w, h, color, dst->format);
+	} else if (dst->format.bytesPerPixel == 4) {
+		blendMask<uint32>(dstPos, dst->pitch, srcPos, mask.pitch, w, h, color, dst->format);
+	}
+}
+
+uint hashU32String(const Common::U32String &str) {
+	uint hash = 0;
+	for (uint i = 0; i < str.size(); ++i)
+		hash = hash * 31 + str[i];
+	return hash;
+}
+
+} // End of anonymous namespace
+
+bool TextRunCache::Key::operator==(const Key &other) const {
+	return font == other.font && kind == other.kind && width == other.width && param == other.param &&
+	       deltax == other.deltax && flags == other.flags && text == other.text && u32Text == other.u32Text;
+}
+
+uint TextRunCache::KeyHash::operator()(const Key &key) const {
+	uint hash = (uint)(size_t)key.font;
+	hash = hash * 31 + key.kind;
+	hash = hash * 31 + key.width;
+	hash = hash * 31 + key.param;
+	hash = hash * 31 + key.deltax;
+	hash = hash * 31 + key.flags;
+	hash = hash * 31 + Common::hashit(key.text);
+	return hash * 31 + hashU32String(key.u32Text);
+}
+
+TextRunCache::TextRunCache(uint32 memoryBudget)
+	: _memoryBudget(memoryBudget), _memoryUsage(0), _hits(0), _misses(0) {
+}
+
+TextRunCache::~TextRunCache() {
+	clear();
+}
+
+TextRunCache::Entry *TextRunCache::find(const Key &key) {
+	EntryMap::iterator i = _map.find(key);
+	if (i == _map.end()) {
+		++_misses;
+		return nullptr;
+	}
+
+	++_hits;
+	// Move the entry to the front of the list
+	_entries.push_front(*i->_value);
+	_entries.erase(i->_value);
+	i->_value = _entries.begin();
+	return _entries.front();
+}
+
+void TextRunCache::insert(Entry *entry) {
+	_entries.push_front(entry);
+	_map[entry->key] = _entries.begin();
+	_memoryUsage += entry->size;
+	evict();
+}
+
+void TextRunCache::remove(EntryList::iterator entry) {
+	Entry *e = *entry;
+	_memoryUsage -= e->size;
+	_map.erase(e->key);
+	_entries.erase(entry);
+	e->mask.free();
+	delete e;
+}
+
+void TextRunCache::evict() {
+	// Always keep the most recent result, even if it is above the budget
+	while (_memoryUsage > _memoryBudget && &_entries.front() != &_entries.back())
+		remove(--_entries.end());
+}
+
+template<class StringType>
+void TextRunCache::drawStringImpl(const Key &key, const Font &font, Surface *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) {
+	assert(dst != 0);
+
+	const Entry *cached = find(key);
+	if (!cached) {
+		Entry *entry = new Entry();
+		entry->key = key;
+		entry->bounds = getRunBounds(font, str, w, align, deltax, useEllipsis);
+		entry->maxLineWidth = 0;
+
+		if (!entry->bounds.isEmpty()) {
+			Surface run;
+			run.create(entry->bounds.width(), entry->bounds.height(), kRunFormat);
+			memset(run.getPixels(), 0, run.pitch * run.h);
+			drawRun(font, &run, str, -entry->bounds.left, -entry->bounds.top, w, kRunColor, align, deltax, useEllipsis);
+
+			entry->mask.create(run.w, run.h, PixelFormat::createFormatCLUT8());
+			for (int cy = 0; cy < run.h; ++cy) {
+				const uint32 *src = (const uint32 *)run.getBasePtr(0, cy);
+				byte *dstRow = (byte *)entry->mask.getBasePtr(0, cy);
+				for (int cx = 0; cx < run.w; ++cx)
+					dstRow[cx] = (src[cx] >> kRunFormat.rShift) & 0xFF;
+			}
+			run.free();
+		}
+
+		entry->size = sizeof(Entry) + entry->mask.pitch * entry->mask.h + key.text.size() + key.u32Text.size() * sizeof(uint32);
+		insert(entry);
+		cached = entry;
+	}
+
+	drawMask(dst, cached->mask, x + cached->bounds.left, y + cached->bounds.top, color);
+}
+
+void TextRunCache::drawString(const Font &font, Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) {
+	Key key;
+	key.font = &font;
+	key.kind = kKindDraw;
+	key.text = str;
+	key.width = w;
+	key.param = align;
+	key.deltax = deltax;
+	key.flags = useEllipsis ? kFlagEllipsis : 0;
+	drawStringImpl(key, font, dst, str, x, y, w, color, align, deltax, useEllipsis);
+}
+
+void TextRunCache::drawString(const Font &font, Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) {
+	// The bounding box of U32Strings can not be offset, so these runs are
+	// not worth keeping
+	if (deltax) {
+		font.drawString(dst, str, x, y, w, color, align, deltax);
+		return;
+	}
+
+	Key key;
+	key.font = &font;
+	key.kind = kKindDrawU32;
+	key.u32Text = str;
+	key.width = w;
+	key.param = align;
+	key.deltax = 0;
+	key.flags = 0;
+	drawStringImpl(key, font, dst, str, x, y, w, color, align, 0, false);
+}
+
+int TextRunCache::wordWrapText(const Font &font, const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth, bool evenWidthLinesModeEnabled, bool wrapOnExplicitNewLines) {
+	Key key;
+	key.font = &font;
+	key.kind = kKindWrap;
+	key.text = str;
+	key.width = maxWidth;
+	key.param = initWidth;
+	key.deltax = 0;
+	key.flags = (evenWidthLinesModeEnabled ? kFlagEvenWidthLines : 0) | (wrapOnExplicitNewLines ? kFlagWrapOnExplicitNewLines : 0);
+
+	const Entry *cached = find(key);
+	if (!cached) {
+		Entry *entry = new Entry();
+		entry->key = key;
+		entry->maxLineWidth = font.wordWrapText(str, maxWidth, entry->lines, initWidth, evenWidthLinesModeEnabled, wrapOnExplicitNewLines);
+		entry->size = sizeof(Entry) + str.size() * 2;
+		insert(entry);
+		cached = entry;
+	}
+
+	lines.push_back(cached->lines);
+	return cached->maxLineWidth;
+}
+
+int TextRunCache::wordWrapText(const Font &font, const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth, bool evenWidthLinesModeEnabled, bool wrapOnExplicitNewLines) {
+	Key key;
+	key.font = &font;
+	key.kind = kKindWrapU32;
+	key.u32Text = str;
+	key.width = maxWidth;
+	key.param = initWidth;
+	key.deltax = 0;
+	key.flags = (evenWidthLinesModeEnabled ? kFlagEvenWidthLines : 0) | (wrapOnExplicitNewLines ? kFlagWrapOnExplicitNewLines : 0);
+
+	const Entry *cached = find(key);
+	if (!cached) {
+		Entry *entry = new Entry();
+		entry->key = key;
+		entry->maxLineWidth = font.wordWrapText(str, maxWidth, entry->u32Lines, initWidth, evenWidthLinesModeEnabled, wrapOnExplicitNewLines);
+		entry->size = sizeof(Entry) + str.size() * sizeof(uint32) * 2;
+		insert(entry);
+		cached = entry;
+	}
+
+	lines.push_back(cached->u32Lines);
+	return cached->maxLineWidth;
+}
+
+void TextRunCache::invalidate(const Font *font) {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end();) {
+		EntryList::iterator next = i;
+		++next;
+		if ((*i)->key.font == font)
+			remove(i);
+		i = next;
+	}
+}
+
+void TextRunCache::clear() {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		(*i)->mask.free();
+		delete *i;
+	}
+	_entries.clear();
+	_map.clear();
+	_memoryUsage = 0;
+}
+
+void TextRunCache::setMemoryBudget(uint32 memoryBudget) {
+	_memoryBudget = memoryBudget;
+	evict();
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_TEXT_RUN_CACHE_H
+#define GRAPHICS_TEXT_RUN_CACHE_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/rect.h"
+#include "common/str.h"
+#include "common/ustr.h"
+#include "graphics/font.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+
+/**
+ * Remembers how strings are laid out and rendered with a font, so that text
+ * which is redrawn unchanged does not have to be measured and drawn glyph by
+ * glyph every time.
+ *
+ * drawString() renders a run into an 8-bit coverage mask once and after that
+ * blends the mask in the requested color with a single blit; wordWrapText()
+ * keeps the wrapped lines. Both take the same arguments as their Font
+ * counterparts and produce the same output. Only fonts which draw glyphs in
+ * the color they are given, like all the fonts in graphics/fonts, can be used.
+ *
+ * Results are identified by the font's address, so callers must call
+ * invalidate() or clear() before a font they used is deleted. The least
+ * recently used results are dropped once the cache grows above its memory
+ * budget.
+ */
+class TextRunCache {
+public:
+	enum {
+		kDefaultMemoryBudget = 1024 * 1024
+	};
+
+	explicit TextRunCache(uint32 memoryBudget = kDefaultMemoryBudget);
+	~TextRunCache();
+
+	/** @see Font::drawString */
+	void drawString(const Font &font, Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align = kTextAlignLeft, int deltax = 0, bool useEllipsis = true);
+	void drawString(const Font &font, Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align = kTextAlignLeft, int deltax = 0);
+
+	/** @see Font::wordWrapText */
+	int wordWrapText(const Font &font, const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth = 0, bool evenWidthLinesModeEnabled = false, bool wrapOnExplicitNewLines = true);
+	int wordWrapText(const Font &font, const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth = 0, bool evenWidthLinesModeEnabled = false, bool wrapOnExplicitNewLines = true);
+
+	/** Drops all results made with the given font. */
+	void invalidate(const Font *font);
+
+	/** Drops all results. */
+	void clear();
+
+	void setMemoryBudget(uint32 memoryBudget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Returns the approximate number of bytes used by the cached results. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	void resetStats() { _hits = _misses = 0; }
+
+private:
+	enum Kind {
+		kKindDraw,
+		kKindDrawU32,
+		kKindWrap,
+		kKindWrapU32
+	};
+
+	struct Key {
+		const Font *font;
+		Kind kind;
+		/** Only one of the strings is set, depending on kind */
+		Common::String text;
+		Common::U32String u32Text;
+		/** The area width for drawing or maxWidth for wrapping */
+		int width;
+		/** The alignment for drawing or initWidth for wrapping */
+		int param;
+		/** Only used for drawing */
+		int deltax;
+		int flags;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry {
+		Key key;
+		/** The coverage of the drawn run inside bounds, relative to the draw position */
+		Surface mask;
+		Common::Rect bounds;
+		Common::Array<Common::String> lines;
+		Common::Array<Common::U32String> u32Lines;
+		int maxLineWidth;
+		uint32 size;
+	};
+
+	/** The entries are kept on the heap so that using one does not copy its lines */
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	Entry *find(const Key &key);
+	void insert(Entry *entry);
+	void remove(EntryList::iterator entry);
+	void evict();
+
+	template<class StringType>
+	void drawStringImpl(const Key &key, const Font &font, Surface *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis);
+
+	/** Most recently used entries first */
+	EntryList _entries;
+	EntryMap _map;
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	uint32 _hits;
+	uint32 _misses;
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,183 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/transform_cache.h"
+
+namespace Graphics {
+
+bool TransformCache::Key::operator==(const Key &other) const {
+	if (source != other.source || generation != other.generation || area != other.area ||
+	    filteringMode != other.filteringMode || rotate != other.rotate)
+		return false;
+
+	// Only the geometry of the transformation matters for the result
+	if (rotate)
+		return transform._angle == other.transform._angle && transform._zoom == other.transform._zoom &&
+		       transform._hotspot == other.transform._hotspot;
+	return width == other.width && height == other.height;
+}
+
+uint TransformCache::KeyHash::operator()(const Key &key) const {
+	uint hash = (uint)(size_t)key.source;
+	hash = hash * 31 + key.generation;
+	hash = hash * 31 + (key.area.left | (key.area.top << 16));
+	hash = hash * 31 + (key.area.right | (key.area.bottom << 16));
+	if (key.rotate) {
+		hash = hash * 31 + key.transform._angle;
+		hash = hash * 31 + (key.transform._zoom.x | (key.transform._zoom.y << 16));
+	} else {
+		hash = hash * 31 + (key.width | (key.height << 16));
+	}
+	return hash * 2 + key.filteringMode;
+}
+
+TransformCache::TransformCache(uint32 memoryBudget)
+	: _memoryBudget(memoryBudget), _memoryUsage(0), _hits(0), _misses(0) {
+	Common::MemoryTracker::addReclaimer(this);
+}
+
+TransformCache::~TransformCache() {
+	Common::MemoryTracker::removeReclaimer(this);
+	clear();
+}
+
+TransformCache::SurfacePtr TransformCache::rotoscale(const TransparentSurface &src, const Common::Rect &area, const void *sourceId, uint32 generation,
+                                                     const TransformStruct &transform, TFilteringMode filteringMode) {
+	Key key;
+	key.source = sourceId;
+	key.generation = generation;
+	key.area = area;
+	key.filteringMode = filteringMode;
+	key.rotate = true;
+	key.transform = transform;
+	key.width = key.height = 0;
+	return lookup(key, src);
+}
+
+TransformCache::SurfacePtr TransformCache::scale(const TransparentSurface &src, const Common::Rect &area, const void *sourceId, uint32 generation,
+                                                 uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode) {
+	Key key;
+	key.source = sourceId;
+	key.generation = generation;
+	key.area = area;
+	key.filteringMode = filteringMode;
+	key.rotate = false;
+	key.width = newWidth;
+	key.height = newHeight;
+	return lookup(key, src);
+}
+
+TransformCache::SurfacePtr TransformCache::lookup(const Key &key, const TransparentSurface &src) {
+	EntryMap::iterator i = _map.find(key);
+	if (i != _map.end()) {
+		++_hits;
+		// Move the entry to the front of the list
+		_entries.push_front(*i->_value);
+		_entries.erase(i->_value);
+		i->_value = _entries.begin();
+		return _entries.front().surface;
+	}
+
+	++_misses;
+
+	// The bilinear scaler expects rows without any padding, so any other
+	// part of the source is copied first
+	TransparentSurface part(src, false);
+	part.setPixels(const_cast<void *>(src.getBasePtr(key.area.left, key.area.top)));
+	part.w = key.area.width();
+	part.h = key.area.height();
+	part.setAlphaMode(src.getAlphaMode());
+
+	TransparentSurface copy;
+	const TransparentSurface *input = &part;
+	if (part.pitch != part.w * part.format.bytesPerPixel) {
+		copy.copyFrom(part);
+		input = &copy;
+	}
+
+	TransparentSurface *result;
+	if (key.rotate) {
+		result = (key.filteringMode == FILTER_BILINEAR) ? input->rotoscaleT<FILTER_BILINEAR>(key.transform) : input->rotoscaleT<FILTER_NEAREST>(key.transform);
+	} else {
+		result = (key.filteringMode == FILTER_BILINEAR) ? input->scaleT<FILTER_BILINEAR>(key.width, key.height) : input->scaleT<FILTER_NEAREST>(key.width, key.height);
+	}
+	copy.free();
+
+	Entry entry;
+	entry.key = key;
+	entry.surface = SurfacePtr(result, SurfaceDeleter());
+	entry.size = result->pitch * result->h;
+
+	_entries.push_front(entry);
+	_map[key] = _entries.begin();
+	_memoryUsage += entry.size;
+	Common::MemoryTracker::add(Common::kMemoryTransformCache, entry.size);
+	evict();
+
+	return entry.surface;
+}
+
+void TransformCache::remove(EntryList::iterator entry) {
+	_memoryUsage -= entry->size;
+	Common::MemoryTracker::add(Common::kMemoryTransformCache, -(int32)entry->size);
+	_map.erase(entry->key);
+	_entries.erase(entry);
+}
+
+void TransformCache::evict() {
+	// Always keep the most recent result, even if it is above the budget
+	while (_memoryUsage > _memoryBudget && &_entries.front() != &_entries.back())
+		remove(--_entries.end());
+}
+
+uint32 TransformCache::reclaimMemory(uint32 bytes) {
+	// Results still held by callers are not freed by dropping them, but
+	// they are not accounted here anymore either
+	const uint32 oldUsage = _memoryUsage;
+	while (!_entries.empty() && oldUsage - _memoryUsage < bytes)
+		remove(--_entries.end());
+	return oldUsage - _memoryUsage;
+}
+
+void TransformCache::invalidate(const void *sourceId) {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end();) {
+		EntryList::iterator next = i;
+		++next;
+		if (i->key.source == sourceId)
+			remove(i);
+		i = next;
+	}
+}
+
+void TransformCache::clear() {
+	_entries.clear();
+	_map.clear();
+	Common::MemoryTracker::add(Common::kMemoryTransformCache, -(int32)_memoryUsage);
+	_memoryUsage = 0;
+}
+
+void TransformCache::setMemoryBudget(uint32 memoryBudget) {
+	_memoryBudget = memoryBudget;
+	evict();
+}
+
+} // End of namespace Graphics
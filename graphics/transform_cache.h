@@ -0,0 +1,145 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_TRANSFORM_CACHE_H
+#define GRAPHICS_TRANSFORM_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
+#include "common/rect.h"
+#include "common/memtracker.h"
+
+#include "graphics/transform_struct.h"
+#include "graphics/transparent_surface.h"
+
+namespace Graphics {
+
+/**
+ * Keeps the results of TransparentSurface::rotoscale and scale around, so
+ * that sprites which are drawn with the same transformation every frame
+ * are only resampled once.
+ *
+ * Results are identified by the source they were made from, the part of it
+ * that was transformed and the transformation itself. The source is any
+ * pointer the caller likes together with a generation counter; callers bump
+ * the generation or call invalidate() whenever the source pixels change.
+ *
+ * The least recently used results are dropped once the cache grows above its
+ * memory budget. The returned surfaces are shared, so they stay valid for as
+ * long as the caller keeps a reference, even after being dropped.
+ *
+ * The results are accounted as kMemoryTransformCache, and the cache gives
+ * them up when asked to by the MemoryTracker.
+ */
+class TransformCache : public Common::MemoryReclaimer {
+public:
+	typedef Common::SharedPtr<TransparentSurface> SurfacePtr;
+
+	enum {
+		kDefaultMemoryBudget = 16 * 1024 * 1024
+	};
+
+	explicit TransformCache(uint32 memoryBudget = kDefaultMemoryBudget);
+	~TransformCache();
+
+	/**
+	 * Returns the given part of src rotated and scaled by transform.
+	 *
+	 * @param src        the source surface
+	 * @param area       the part of src to transform
+	 * @param sourceId   identifies the source surface
+	 * @param generation changes whenever the source pixels change
+	 */
+	SurfacePtr rotoscale(const TransparentSurface &src, const Common::Rect &area, const void *sourceId, uint32 generation,
+	                     const TransformStruct &transform, TFilteringMode filteringMode);
+
+	/**
+	 * Returns the given part of src scaled to newWidth x newHeight.
+	 *
+	 * @see rotoscale
+	 */
+	SurfacePtr scale(const TransparentSurface &src, const Common::Rect &area, const void *sourceId, uint32 generation,
+	                 uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode);
+
+	/** Drops all results made from the given source. */
+	void invalidate(const void *sourceId);
+
+	/** Drops all results. */
+	void clear();
+
+	void setMemoryBudget(uint32 memoryBudget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Returns the number of bytes used by the cached results. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
+	virtual uint32 reclaimMemory(uint32 bytes);
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	void resetStats() { _hits = _misses = 0; }
+
+private:
+	struct Key {
+		const void *source;
+		uint32 generation;
+		Common::Rect area;
+		TFilteringMode filteringMode;
+		bool rotate;
+		/** Only used for rotation; only its geometry is compared */
+		TransformStruct transform;
+		/** Only used for scaling */
+		uint16 width, height;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry {
+		Key key;
+		SurfacePtr surface;
+		uint32 size;
+	};
+
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	SurfacePtr lookup(const Key &key, const TransparentSurface &src);
+	void remove(EntryList::iterator entry);
+	void evict();
+
+	/** Most recently used entries first */
+	EntryList _entries;
+	EntryMap _map;
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	uint32 _hits;
+	uint32 _misses;
+};
+
+} // End of namespace Graphics
+
+#endif
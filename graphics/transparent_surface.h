@@ -174,8 +174,19 @@ struct TransparentSurface : public Graphics::Surface {
 
 	AlphaType getAlphaMode() const;
 	void setAlphaMode(AlphaType);
+
+	/**
+	 * Multiplies the color channels of every pixel by its alpha.
+	 *
+	 * Blitting a premultiplied surface saves one multiplication per channel.
+	 * Only blit and blitClip are aware of premultiplied surfaces; the pixels
+	 * should not be modified in any other way afterwards.
+	 */
+	void premultiplyAlpha();
+	bool isPremultiplied() const;
 private:
 	AlphaType _alphaMode;
+	bool _premultiplied;
 
 	template <typename Size>
 	void scaleNN(int *scaleCacheX, TransparentSurface *target) const;
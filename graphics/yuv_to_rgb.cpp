@@ -83,9 +83,19 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
+#include "common/taskscheduler.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YUV_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define YUV_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -158,7 +168,7 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 }
 
 YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
+	_lookupMutex = g_system ? new Common::Mutex() : nullptr;
 
 	int16 *Cr_r_tab = &_colorTab[0 * 256];
 	int16 *Cr_g_tab = &_colorTab[1 * 256];
@@ -180,192 +190,440 @@ YUVToRGBManager::YUVToRGBManager() {
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
+	for (uint i = 0; i < _lookups.size(); i++)
+		delete _lookups[i];
+	delete _lookupMutex;
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
-	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
-		return _lookup;
+	if (_lookupMutex)
+		_lookupMutex->lock();
+
+	// Hardly any game uses more than one format
+	const YUVToRGBLookup *lookup = nullptr;
+	for (uint i = 0; i < _lookups.size() && !lookup; i++) {
+		if (_lookups[i]->getFormat() == format && _lookups[i]->getScale() == scale)
+			lookup = _lookups[i];
+	}
+
+	if (!lookup) {
+		_lookups.push_back(new YUVToRGBLookup(format, scale));
+		lookup = _lookups.back();
+	}
 
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format, scale);
-	return _lookup;
+	if (_lookupMutex)
+		_lookupMutex->unlock();
+	return lookup;
 }
 
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
+namespace {
+
+/** Everything a row conversion needs, shared by all rows of an image */
+struct YUVConvertParams {
+	const uint32 *rgbToPix;
+	const int16 *Cr_r_tab;
+	const int16 *Cr_g_tab;
+	const int16 *Cb_g_tab;
+	const int16 *Cb_b_tab;
+	YUVToRGBManager::LuminanceScale scale;
+	PixelFormat format;
+};
+
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+
+// The vector kernels compute the same values as the lookup tables. The
+// chroma tables hold the products of the chroma values with the conversion
+// factors, truncated towards zero; they are computed here as a whole part
+// plus a 16 bit fraction, which gives exactly the same results for all
+// chroma values. This is checked by the YUV to RGB test.
+enum {
+	kCrRWhole = 1, kCrRFrac = 26266, // 0.419 / 0.299
+	kCrGWhole = 0, kCrGFrac = 46773, // 0.299 / 0.419
+	kCbGWhole = 0, kCbGFrac = 22567, // 0.114 / 0.331
+	kCbBWhole = 1, kCbBFrac = 50684, // 0.587 / 0.331
+	// (x * 255) / 219 for x in [0, 219] as ((x * 255) * kITUMul) >> (16 + kITUShift)
+	kITUMul = 19153,
+	kITUShift = 6
+};
+
+#ifdef YUV_USE_SSE2
+
+/** Eight signed 16 bit values */
+typedef __m128i Vec16;
+/** Four unsigned 32 bit values */
+typedef __m128i Vec32;
+
+static inline Vec16 vecLoad8(const byte *p) { return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128()); }
+static inline Vec16 vecSet16(int x) { return _mm_set1_epi16(x); }
+static inline Vec16 vecAdd16(Vec16 a, Vec16 b) { return _mm_add_epi16(a, b); }
+static inline Vec16 vecSub16(Vec16 a, Vec16 b) { return _mm_sub_epi16(a, b); }
+static inline Vec16 vecMin16(Vec16 a, Vec16 b) { return _mm_min_epi16(a, b); }
+static inline Vec16 vecMax16(Vec16 a, Vec16 b) { return _mm_max_epi16(a, b); }
+static inline Vec16 vecMul16(Vec16 a, Vec16 b) { return _mm_mullo_epi16(a, b); }
+static inline Vec16 vecMulHiU16(Vec16 a, Vec16 b) { return _mm_mulhi_epu16(a, b); }
+static inline Vec16 vecOr16(Vec16 a, Vec16 b) { return _mm_or_si128(a, b); }
+static inline Vec16 vecXor16(Vec16 a, Vec16 b) { return _mm_xor_si128(a, b); }
+static inline Vec16 vecSign16(Vec16 a) { return _mm_srai_epi16(a, 15); }
+static inline Vec16 vecShl16(Vec16 v, int n) { return _mm_sll_epi16(v, _mm_cvtsi32_si128(n)); }
+static inline Vec16 vecShr16(Vec16 v, int n) { return _mm_srl_epi16(v, _mm_cvtsi32_si128(n)); }
+static inline void vecStore16(byte *p, Vec16 v) { _mm_storeu_si128((__m128i *)p, v); }
+
+static inline void vecDup16(Vec16 v, Vec16 &lo, Vec16 &hi) {
+	lo = _mm_unpacklo_epi16(v, v);
+	hi = _mm_unpackhi_epi16(v, v);
+}
+
+static inline void vecWiden16(Vec16 v, Vec32 &lo, Vec32 &hi) {
+	lo = _mm_unpacklo_epi16(v, _mm_setzero_si128());
+	hi = _mm_unpackhi_epi16(v, _mm_setzero_si128());
+}
+
+static inline Vec32 vecSet32(uint32 x) { return _mm_set1_epi32(x); }
+static inline Vec32 vecOr32(Vec32 a, Vec32 b) { return _mm_or_si128(a, b); }
+static inline Vec32 vecShl32(Vec32 v, int n) { return _mm_sll_epi32(v, _mm_cvtsi32_si128(n)); }
+static inline void vecStore32(byte *p, Vec32 v) { _mm_storeu_si128((__m128i *)p, v); }
+
+#else
+
+typedef int16x8_t Vec16;
+typedef uint32x4_t Vec32;
+
+static inline Vec16 vecLoad8(const byte *p) { return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p))); }
+static inline Vec16 vecSet16(int x) { return vdupq_n_s16(x); }
+static inline Vec16 vecAdd16(Vec16 a, Vec16 b) { return vaddq_s16(a, b); }
+static inline Vec16 vecSub16(Vec16 a, Vec16 b) { return vsubq_s16(a, b); }
+static inline Vec16 vecMin16(Vec16 a, Vec16 b) { return vminq_s16(a, b); }
+static inline Vec16 vecMax16(Vec16 a, Vec16 b) { return vmaxq_s16(a, b); }
+static inline Vec16 vecMul16(Vec16 a, Vec16 b) { return vmulq_s16(a, b); }
+static inline Vec16 vecMulHiU16(Vec16 a, Vec16 b) {
+	const uint16x8_t ua = vreinterpretq_u16_s16(a), ub = vreinterpretq_u16_s16(b);
+	const uint32x4_t lo = vmull_u16(vget_low_u16(ua), vget_low_u16(ub));
+	const uint32x4_t hi = vmull_u16(vget_high_u16(ua), vget_high_u16(ub));
+	return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+}
+static inline Vec16 vecOr16(Vec16 a, Vec16 b) { return vorrq_s16(a, b); }
+static inline Vec16 vecXor16(Vec16 a, Vec16 b) { return veorq_s16(a, b); }
+static inline Vec16 vecSign16(Vec16 a) { return vshrq_n_s16(a, 15); }
+static inline Vec16 vecShl16(Vec16 v, int n) { return vreinterpretq_s16_u16(vshlq_u16(vreinterpretq_u16_s16(v), vdupq_n_s16(n))); }
+static inline Vec16 vecShr16(Vec16 v, int n) { return vreinterpretq_s16_u16(vshlq_u16(vreinterpretq_u16_s16(v), vdupq_n_s16(-n))); }
+static inline void vecStore16(byte *p, Vec16 v) { vst1q_s16((int16 *)p, v); }
+
+static inline void vecDup16(Vec16 v, Vec16 &lo, Vec16 &hi) {
+	const int16x8x2_t z = vzipq_s16(v, v);
+	lo = z.val[0];
+	hi = z.val[1];
+}
+
+static inline void vecWiden16(Vec16 v, Vec32 &lo, Vec32 &hi) {
+	const uint16x8_t u = vreinterpretq_u16_s16(v);
+	lo = vmovl_u16(vget_low_u16(u));
+	hi = vmovl_u16(vget_high_u16(u));
+}
+
+static inline Vec32 vecSet32(uint32 x) { return vdupq_n_u32(x); }
+static inline Vec32 vecOr32(Vec32 a, Vec32 b) { return vorrq_u32(a, b); }
+static inline Vec32 vecShl32(Vec32 v, int n) { return vshlq_u32(v, vdupq_n_s32(n)); }
+static inline void vecStore32(byte *p, Vec32 v) { vst1q_u32((uint32 *)p, v); }
+
+#endif
+
+/** Returns the product of c and whole + frac / 65536, truncated towards zero */
+static inline Vec16 chromaProduct(Vec16 c, int whole, int frac) {
+	const Vec16 sign = vecSign16(c);
+	const Vec16 a = vecSub16(vecXor16(c, sign), sign);
+	Vec16 p = vecMulHiU16(a, vecSet16((int16)frac));
+	if (whole)
+		p = vecAdd16(p, a);
+	return vecSub16(vecXor16(p, sign), sign);
+}
+
+/** Computes the offsets the chroma values add to the luminance of each component */
+static inline void chromaOffsets(Vec16 u, Vec16 v, Vec16 &rOff, Vec16 &gOff, Vec16 &bOff) {
+	const Vec16 cb = vecSub16(u, vecSet16(128));
+	const Vec16 cr = vecSub16(v, vecSet16(128));
+	rOff = chromaProduct(cr, kCrRWhole, kCrRFrac);
+	gOff = vecSub16(vecSet16(0), vecAdd16(chromaProduct(cr, kCrGWhole, kCrGFrac), chromaProduct(cb, kCbGWhole, kCbGFrac)));
+	bOff = chromaProduct(cb, kCbBWhole, kCbBFrac);
+}
+
+/** Clamps a component to the luminance range and scales it to [0, 255] */
+static inline Vec16 scaleComponent(Vec16 c, bool itu) {
+	if (!itu)
+		return vecMin16(vecMax16(c, vecSet16(0)), vecSet16(255));
+
+	c = vecSub16(vecMin16(vecMax16(c, vecSet16(16)), vecSet16(235)), vecSet16(16));
+	return vecShr16(vecMulHiU16(vecMul16(c, vecSet16(255)), vecSet16((int16)kITUMul)), kITUShift);
+}
+
 template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
-
-	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
-			const uint32 *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+static inline void storePixels(byte *dst, Vec16 r, Vec16 g, Vec16 b, const PixelFormat &format);
+
+template<>
+inline void storePixels<uint16>(byte *dst, Vec16 r, Vec16 g, Vec16 b, const PixelFormat &format) {
+	Vec16 pixels = vecSet16((int16)((0xFF >> format.aLoss) << format.aShift));
+	pixels = vecOr16(pixels, vecShl16(vecShr16(r, format.rLoss), format.rShift));
+	pixels = vecOr16(pixels, vecShl16(vecShr16(g, format.gLoss), format.gShift));
+	pixels = vecOr16(pixels, vecShl16(vecShr16(b, format.bLoss), format.bShift));
+	vecStore16(dst, pixels);
+}
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
-		uSrc += uvPitch - yWidth;
-		vSrc += uvPitch - yWidth;
+template<>
+inline void storePixels<uint32>(byte *dst, Vec16 r, Vec16 g, Vec16 b, const PixelFormat &format) {
+	Vec32 rLo, rHi, gLo, gHi, bLo, bHi;
+	vecWiden16(vecShr16(r, format.rLoss), rLo, rHi);
+	vecWiden16(vecShr16(g, format.gLoss), gLo, gHi);
+	vecWiden16(vecShr16(b, format.bLoss), bLo, bHi);
+
+	const Vec32 alpha = vecSet32((0xFF >> format.aLoss) << format.aShift);
+	Vec32 lo = vecOr32(alpha, vecShl32(rLo, format.rShift));
+	lo = vecOr32(lo, vecShl32(gLo, format.gShift));
+	lo = vecOr32(lo, vecShl32(bLo, format.bShift));
+	Vec32 hi = vecOr32(alpha, vecShl32(rHi, format.rShift));
+	hi = vecOr32(hi, vecShl32(gHi, format.gShift));
+	hi = vecOr32(hi, vecShl32(bHi, format.bShift));
+
+	vecStore32(dst, lo);
+	vecStore32(dst + 16, hi);
+}
+
+template<typename PixelInt>
+static inline void convertPixels(byte *dst, Vec16 y, Vec16 rOff, Vec16 gOff, Vec16 bOff, const YUVConvertParams &params) {
+	const bool itu = params.scale == YUVToRGBManager::kScaleITU;
+	storePixels<PixelInt>(dst, scaleComponent(vecAdd16(y, rOff), itu), scaleComponent(vecAdd16(y, gOff), itu),
+	                      scaleComponent(vecAdd16(y, bOff), itu), params.format);
+}
+
+/** Converts the pixels of a 444 row in blocks of 8, returning the number of pixels done */
+template<typename PixelInt>
+int convertRow444SIMD(byte *dstPtr, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVConvertParams &params) {
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		Vec16 rOff, gOff, bOff;
+		chromaOffsets(vecLoad8(uSrc + x), vecLoad8(vSrc + x), rOff, gOff, bOff);
+		convertPixels<PixelInt>(dstPtr + x * sizeof(PixelInt), vecLoad8(ySrc + x), rOff, gOff, bOff, params);
 	}
+	return x;
 }
 
-void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
+/** Converts the pixels of two 420 rows in blocks of 16, returning the number of pixels done */
+template<typename PixelInt>
+int convertRows420SIMD(byte *dst0, byte *dst1, const byte *y0, const byte *y1, const byte *uSrc, const byte *vSrc, int width, const YUVConvertParams &params) {
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		Vec16 rOff, gOff, bOff;
+		chromaOffsets(vecLoad8(uSrc + x / 2), vecLoad8(vSrc + x / 2), rOff, gOff, bOff);
+
+		// Every chroma sample covers two pixels of both rows
+		Vec16 rLo, rHi, gLo, gHi, bLo, bHi;
+		vecDup16(rOff, rLo, rHi);
+		vecDup16(gOff, gLo, gHi);
+		vecDup16(bOff, bLo, bHi);
+
+		convertPixels<PixelInt>(dst0 + x * sizeof(PixelInt), vecLoad8(y0 + x), rLo, gLo, bLo, params);
+		convertPixels<PixelInt>(dst0 + (x + 8) * sizeof(PixelInt), vecLoad8(y0 + x + 8), rHi, gHi, bHi, params);
+		convertPixels<PixelInt>(dst1 + x * sizeof(PixelInt), vecLoad8(y1 + x), rLo, gLo, bLo, params);
+		convertPixels<PixelInt>(dst1 + (x + 8) * sizeof(PixelInt), vecLoad8(y1 + x + 8), rHi, gHi, bHi, params);
+	}
+	return x;
+}
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+#endif // YUV_USE_SSE2 || YUV_USE_NEON
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+template<typename PixelInt>
+void convertRow444(byte *dstPtr, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const YUVConvertParams &params) {
+	int x = 0;
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	x = convertRow444SIMD<PixelInt>(dstPtr, ySrc, uSrc, vSrc, width, params);
+#endif
+
+	// Keep the tables in locals here to avoid a dereference on each pixel
+	const int16 *Cr_r_tab = params.Cr_r_tab;
+	const int16 *Cr_g_tab = params.Cr_g_tab;
+	const int16 *Cb_g_tab = params.Cb_g_tab;
+	const int16 *Cb_b_tab = params.Cb_b_tab;
+	const uint32 *rgbToPix = params.rgbToPix;
+
+	for (; x < width; x++) {
+		const uint32 *L;
+
+		int16 cr_r  = Cr_r_tab[vSrc[x]];
+		int16 crb_g = Cr_g_tab[vSrc[x]] + Cb_g_tab[uSrc[x]];
+		int16 cb_b  = Cb_b_tab[uSrc[x]];
+
+		PUT_PIXEL(ySrc[x], dstPtr + x * sizeof(PixelInt));
+	}
+}
+
+template<typename PixelInt>
+void convertRows420(byte *dst0, byte *dst1, const byte *y0, const byte *y1, const byte *uSrc, const byte *vSrc, int width, const YUVConvertParams &params) {
+	int x = 0;
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	x = convertRows420SIMD<PixelInt>(dst0, dst1, y0, y1, uSrc, vSrc, width, params);
+#endif
+
+	const int16 *Cr_r_tab = params.Cr_r_tab;
+	const int16 *Cr_g_tab = params.Cr_g_tab;
+	const int16 *Cb_g_tab = params.Cb_g_tab;
+	const int16 *Cb_b_tab = params.Cb_b_tab;
+	const uint32 *rgbToPix = params.rgbToPix;
+
+	for (; x < width; x += 2) {
+		const uint32 *L;
+		const byte u = uSrc[x >> 1], v = vSrc[x >> 1];
+
+		int16 cr_r  = Cr_r_tab[v];
+		int16 crb_g = Cr_g_tab[v] + Cb_g_tab[u];
+		int16 cb_b  = Cb_b_tab[u];
+
+		PUT_PIXEL(y0[x], dst0 + x * sizeof(PixelInt));
+		PUT_PIXEL(y1[x], dst1 + x * sizeof(PixelInt));
+		PUT_PIXEL(y0[x + 1], dst0 + (x + 1) * sizeof(PixelInt));
+		PUT_PIXEL(y1[x + 1], dst1 + (x + 1) * sizeof(PixelInt));
+	}
 }
 
+/**
+ * Converts a range of rows. A unit is a pixel row, except for 420 where it
+ * is the pair of pixel rows sharing a chroma row.
+ */
 template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
-
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
-
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const uint32 *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
+class YUVConvertBody : public Common::ParallelForBody {
+public:
+	YUVConvertBody(YUVToRGBManager::Subsampling subsampling, const YUVConvertParams &params, byte *dstPtr, int dstPitch,
+	               const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yPitch, int uvPitch) :
+		_subsampling(subsampling), _params(params), _dstPtr(dstPtr), _dstPitch(dstPitch),
+		_ySrc(ySrc), _uSrc(uSrc), _vSrc(vSrc), _yWidth(yWidth), _yPitch(yPitch), _uvPitch(uvPitch) {}
+
+	virtual void run(uint begin, uint end) {
+		switch (_subsampling) {
+		case YUVToRGBManager::kSubsampling444:
+			for (uint y = begin; y < end; y++)
+				convertRow444<PixelInt>(_dstPtr + y * _dstPitch, _ySrc + y * _yPitch, _uSrc + y * _uvPitch, _vSrc + y * _uvPitch, _yWidth, _params);
+			break;
+
+		case YUVToRGBManager::kSubsampling420:
+			for (uint y = begin; y < end; y++) {
+				byte *dst = _dstPtr + 2 * y * _dstPitch;
+				const byte *ySrc = _ySrc + 2 * y * _yPitch;
+				convertRows420<PixelInt>(dst, dst + _dstPitch, ySrc, ySrc + _yPitch, _uSrc + y * _uvPitch, _vSrc + y * _uvPitch, _yWidth, _params);
+			}
+			break;
+
+		case YUVToRGBManager::kSubsampling410:
+			run410(begin, end);
+			break;
+		}
+	}
+
+private:
+	void run410(uint begin, uint end) {
+		// Perform bilinear interpolation on the the chroma values
+		// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
+		// The chroma rows are interpolated up to the full width first, and
+		// then converted like 444.
+		const int quarterWidth = _yWidth >> 2;
+		byte *uRow = new byte[_yWidth * 2];
+		byte *vRow = uRow + _yWidth;
+
+		for (uint y = begin; y < end; y++) {
+			const int yDiff = y & 3;
+			const byte *uTop = _uSrc + (y >> 2) * _uvPitch, *vTop = _vSrc + (y >> 2) * _uvPitch;
+
+			for (int x = 0; x < quarterWidth; x++) {
+				// The vertically interpolated chroma to the left and right of this block
+				const int uL = uTop[x] * (4 - yDiff) + uTop[x + _uvPitch] * yDiff;
+				const int uR = uTop[x + 1] * (4 - yDiff) + uTop[x + _uvPitch + 1] * yDiff;
+				const int vL = vTop[x] * (4 - yDiff) + vTop[x + _uvPitch] * yDiff;
+				const int vR = vTop[x + 1] * (4 - yDiff) + vTop[x + _uvPitch + 1] * yDiff;
+
+				for (int xDiff = 0; xDiff < 4; xDiff++) {
+					uRow[x * 4 + xDiff] = (uL * (4 - xDiff) + uR * xDiff) >> 4;
+					vRow[x * 4 + xDiff] = (vL * (4 - xDiff) + vR * xDiff) >> 4;
+				}
+			}
+
+			// Should the width not be divisible by 4, the pixels past the
+			// last block take the last chroma sample
+			for (int x = quarterWidth * 4; x < _yWidth; x++) {
+				uRow[x] = (uTop[quarterWidth] * (4 - yDiff) + uTop[quarterWidth + _uvPitch] * yDiff) >> 2;
+				vRow[x] = (vTop[quarterWidth] * (4 - yDiff) + vTop[quarterWidth + _uvPitch] * yDiff) >> 2;
+			}
+
+			convertRow444<PixelInt>(_dstPtr + y * _dstPitch, _ySrc + y * _yPitch, uRow, vRow, _yWidth, _params);
 		}
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+		delete[] uRow;
+	}
+
+	const YUVToRGBManager::Subsampling _subsampling;
+	const YUVConvertParams &_params;
+	byte *const _dstPtr;
+	const int _dstPitch;
+	const byte *const _ySrc, *const _uSrc, *const _vSrc;
+	const int _yWidth, _yPitch, _uvPitch;
+};
+
+} // End of anonymous namespace
+
+#undef PUT_PIXEL
+
+void YUVToRGBManager::convert(Subsampling subsampling, Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVConvertParams params;
+	params.rgbToPix = getLookup(dst->format, scale)->getRGBToPix();
+	params.Cr_r_tab = &_colorTab[0 * 256];
+	params.Cr_g_tab = &_colorTab[1 * 256];
+	params.Cb_g_tab = &_colorTab[2 * 256];
+	params.Cb_b_tab = &_colorTab[3 * 256];
+	params.scale = scale;
+	params.format = dst->format;
+
+	const uint units = (subsampling == kSubsampling420) ? yHeight / 2 : yHeight;
+	const uint unitPixels = (subsampling == kSubsampling420) ? yWidth * 2 : yWidth;
+	// Big enough chunks that handing them to other threads pays off
+	const uint grainSize = MAX<uint>(1, kMinPixelsPerTask / MAX<uint>(1, unitPixels));
+
+	Common::TaskScheduler *scheduler = g_system ? g_system->getTaskScheduler() : nullptr;
+
+	// Use a templated function to avoid an if check on every pixel
+	if (dst->format.bytesPerPixel == 2) {
+		YUVConvertBody<uint16> body(subsampling, params, (byte *)dst->getPixels(), dst->pitch, ySrc, uSrc, vSrc, yWidth, yPitch, uvPitch);
+		if (scheduler && !scheduler->isSerial() && units >= 2 * grainSize)
+			scheduler->parallelFor(0, units, body, grainSize);
+		else
+			body.run(0, units);
+	} else {
+		YUVConvertBody<uint32> body(subsampling, params, (byte *)dst->getPixels(), dst->pitch, ySrc, uSrc, vSrc, yWidth, yPitch, uvPitch);
+		if (scheduler && !scheduler->isSerial() && units >= 2 * grainSize)
+			scheduler->parallelFor(0, units, body, grainSize);
+		else
+			body.run(0, units);
 	}
 }
 
-void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
-	assert((yHeight & 1) == 0);
-
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	convert(kSubsampling444, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
-#define READ_QUAD(ptr, prefix) \
-	byte prefix##A = ptr[index]; \
-	byte prefix##B = ptr[index + 1]; \
-	byte prefix##C = ptr[index + uvPitch]; \
-	byte prefix##D = ptr[index + uvPitch + 1]
-
-#define DO_INTERPOLATION(out) \
-	out = (out##A * (4 - xDiff) * (4 - yDiff) + out##B * xDiff * (4 - yDiff) + \
-			out##C * yDiff * (4 - xDiff) + out##D * xDiff * yDiff) >> 4
-
-#define DO_YUV410_PIXEL() \
-	DO_INTERPOLATION(u); \
-	DO_INTERPOLATION(v); \
-	\
-	cr_r  = Cr_r_tab[v]; \
-	crb_g = Cr_g_tab[v] + Cb_g_tab[u]; \
-	cb_b  = Cb_b_tab[u]; \
-	\
-	PUT_PIXEL(*ySrc, dstPtr); \
-	dstPtr += sizeof(PixelInt); \
-	\
-	ySrc++; \
-	xDiff++
-
-template<typename PixelInt>
-void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const uint32 *rgbToPix = lookup->getRGBToPix();
-
-	int quarterWidth = yWidth >> 2;
-
-	for (int y = 0; y < yHeight; y++) {
-		for (int x = 0; x < quarterWidth; x++) {
-			// Perform bilinear interpolation on the the chroma values
-			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
-			// Feel free to optimize further
-			int targetY = y >> 2;
-			int xDiff = 0;
-			int yDiff = y & 3;
-			int index = targetY * uvPitch + x;
-
-			// Declare some variables for the following macros
-			byte u, v;
-			int16 cr_r, crb_g, cb_b;
-			const uint32 *L;
-
-			READ_QUAD(uSrc, u);
-			READ_QUAD(vSrc, v);
-
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-		}
+void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst && dst->getPixels());
+	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc);
+	assert((yWidth & 1) == 0);
+	assert((yHeight & 1) == 0);
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
-	}
+	convert(kSubsampling420, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
-#undef READ_QUAD
-#undef DO_INTERPOLATION
-#undef DO_YUV410_PIXEL
-
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -374,13 +632,7 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
-
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	convert(kSubsampling410, dst, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 } // End of namespace Graphics
@@ -36,6 +36,8 @@
 #define GRAPHICS_YUV_TO_RGB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
@@ -102,6 +104,13 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/** The layout of the chroma planes */
+	enum Subsampling {
+		kSubsampling444, /** One chroma sample per pixel */
+		kSubsampling420, /** One chroma sample per 2x2 pixels */
+		kSubsampling410  /** One chroma sample per 4x4 pixels, interpolated */
+	};
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -109,7 +118,22 @@ private:
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
-	YUVToRGBLookup *_lookup;
+	/**
+	 * Convert an image of any subsampling. Rows are converted in parallel
+	 * on the task scheduler when the image is large enough.
+	 */
+	void convert(Subsampling subsampling, Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
+	/** The minimum number of pixels to give to a single task */
+	static const uint kMinPixelsPerTask = 64 * 1024;
+
+	/**
+	 * The lookups built so far. Conversions may run on several threads
+	 * at once, so lookups are kept until the manager goes away.
+	 */
+	Common::Array<YUVToRGBLookup *> _lookups;
+	/** Guards _lookups, unless there is no OSystem and so no other thread */
+	Common::Mutex *_lookupMutex;
 	int16 _colorTab[4 * 256]; // 2048 bytes
 };
 
@@ -88,6 +88,7 @@ EventRecorder::EventRecorder() {
 	_lastScreenshotTime = 0;
 	_screenshotPeriod = 0;
 	_playbackFile = 0;
+	resetBenchmark();
 
 	DebugMan.addDebugChannel(kDebugLevelEventRec, "EventRec", "Event recorder debug level");
 }
@@ -103,6 +104,10 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	if (_benchmark) {
+		printBenchmarkReport();
+		_benchmark = false;
+	}
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -147,13 +152,34 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 		_timerManager->handler();
 		break;
 	case kRecorderPlayback:
+		if (_benchmark) {
+			uint64 tickStart = g_system->getMicroseconds();
+			if (_benchmarkTicks > 0) {
+				_benchmarkMaxTickTime = MAX(_benchmarkMaxTickTime, tickStart - _benchmarkLastTickTime);
+			} else {
+				_benchmarkStartTime = tickStart;
+			}
+			_benchmarkLastTickTime = tickStart;
+			_benchmarkTicks++;
+		}
 		updateSubsystems();
 		if (_nextEvent.recordedtype == Common::kRecorderEventTypeTimer) {
 			_fakeTimer = _nextEvent.time;
 			_nextEvent = _playbackFile->getNextEvent();
-			_timerManager->handler();
+			if (_benchmark) {
+				uint64 timersStart = g_system->getMicroseconds();
+				_timerManager->handler();
+				_benchmarkTimersTime += g_system->getMicroseconds() - timersStart;
+				updateBenchmarkChecksum();
+			} else {
+				_timerManager->handler();
+			}
 		} else {
 			if (_nextEvent.type == Common::EVENT_RTL) {
+				// The end of the record does not come back through deinit
+				if (_benchmark) {
+					printBenchmarkReport();
+				}
 				error("playback:action=stopplayback");
 			} else {
 				uint32 seconds = _fakeTimer / 1000;
@@ -270,6 +296,14 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 	_playbackFile = new Common::PlaybackFile();
 	_lastScreenshotTime = 0;
 	_recordMode = mode;
+	resetBenchmark();
+	if (_recordMode == kRecorderPlayback && ConfMan.getBool("record_benchmark")) {
+		// Events are replayed against the recorded timer events anyway,
+		// so skipping the delays only changes how long the run takes
+		_benchmark = true;
+		_benchmarkChecksum = ConfMan.getBool("record_checksum");
+		_fastPlayback = true;
+	}
 	_needcontinueGame = false;
 	if (ConfMan.hasKey("disable_display")) {
 		DebugMan.enableDebugChannel("EventRec");
@@ -430,7 +464,13 @@ void EventRecorder::updateSubsystems() {
 	}
 	RecordMode oldRecordMode = _recordMode;
 	_recordMode = kPassthrough;
-	_fakeMixerManager->update();
+	if (_benchmark) {
+		uint64 mixerStart = g_system->getMicroseconds();
+		_fakeMixerManager->update();
+		_benchmarkSubsystemsTime += g_system->getMicroseconds() - mixerStart;
+	} else {
+		_fakeMixerManager->update();
+	}
 	_recordMode = oldRecordMode;
 }
 
@@ -527,6 +567,58 @@ bool EventRecorder::grabScreenAndComputeMD5(Graphics::Surface &screen, uint8 md5
 	return true;
 }
 
+void EventRecorder::resetBenchmark() {
+	_benchmark = false;
+	_benchmarkChecksum = false;
+	_benchmarkStartTime = 0;
+	_benchmarkLastTickTime = 0;
+	_benchmarkMaxTickTime = 0;
+	_benchmarkSubsystemsTime = 0;
+	_benchmarkTimersTime = 0;
+	_benchmarkTicks = 0;
+	_benchmarkScreens = 0;
+	_benchmarkLastScreenTime = 0;
+	memset(_benchmarkMD5, 0, sizeof(_benchmarkMD5));
+}
+
+/**
+ * Folds the MD5 of the current screen into the benchmark checksum, once
+ * every screenshot period of replayed time. As the replayed time only
+ * depends on the record, two runs of the same build should end up with
+ * the same checksum.
+ */
+void EventRecorder::updateBenchmarkChecksum() {
+	if (!_benchmarkChecksum || (_fakeTimer - _benchmarkLastScreenTime) <= _screenshotPeriod) {
+		return;
+	}
+	Graphics::Surface screen;
+	uint8 md5[32];
+	if (!grabScreenAndComputeMD5(screen, md5 + 16)) {
+		return;
+	}
+	screen.free();
+	memcpy(md5, _benchmarkMD5, 16);
+	Common::MemoryReadStream md5Stream(md5, sizeof(md5));
+	computeStreamMD5(md5Stream, _benchmarkMD5);
+	_benchmarkLastScreenTime = _fakeTimer;
+	_benchmarkScreens++;
+}
+
+void EventRecorder::printBenchmarkReport() {
+	uint64 wallTime = _benchmarkLastTickTime - _benchmarkStartTime;
+	uint32 averageTickTime = _benchmarkTicks > 1 ? (uint32)(wallTime / (_benchmarkTicks - 1)) : 0;
+	debug("benchmark:ticks=%u replayedms=%u wallms=%u avgtickus=%u maxtickus=%u mixerms=%u timersms=%u",
+	      _benchmarkTicks, _fakeTimer, (uint32)(wallTime / 1000), averageTickTime, (uint32)_benchmarkMaxTickTime,
+	      (uint32)(_benchmarkSubsystemsTime / 1000), (uint32)(_benchmarkTimersTime / 1000));
+	if (_benchmarkChecksum) {
+		Common::String checksum;
+		for (int i = 0; i < 16; i++) {
+			checksum += Common::String::format("%02x", _benchmarkMD5[i]);
+		}
+		debug("benchmark:screens=%u checksum=%s", _benchmarkScreens, checksum.c_str());
+	}
+}
+
 Common::SeekableReadStream *EventRecorder::processSaveStream(const Common::String &fileName) {
 	Common::InSaveFile *saveFile;
 	switch (_recordMode) {
@@ -210,6 +210,10 @@ private:
 
 	void takeScreenshot();
 
+	void resetBenchmark();
+	void updateBenchmarkChecksum();
+	void printBenchmarkReport();
+
 	bool openRecordFile(const Common::String &fileName);
 
 	bool checkGameHash(const ADGameDescription *desc);
@@ -229,6 +233,19 @@ private:
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
+
+	/** Benchmark statistics, gathered when playing back with record_benchmark set */
+	bool _benchmark;
+	bool _benchmarkChecksum;
+	uint64 _benchmarkStartTime;
+	uint64 _benchmarkLastTickTime;
+	uint64 _benchmarkMaxTickTime;
+	uint64 _benchmarkSubsystemsTime;
+	uint64 _benchmarkTimersTime;
+	uint32 _benchmarkTicks;
+	uint32 _benchmarkScreens;
+	uint32 _benchmarkLastScreenTime;
+	uint8 _benchmarkMD5[16];
 };
 
 } // End of namespace GUI
@@ -98,6 +98,128 @@ struct WidgetDrawData {
 	void calcBackgroundOffset();
 };
 
+/**
+ * Keeps what DrawData items looked like after they were drawn over a freshly
+ * restored part of the back buffer, so that redrawing an unchanged widget,
+ * e.g. while scrolling a list, is a single blit.
+ *
+ * Such a result only depends on the item, its area, the clip rect, the
+ * dynamic parameter and the back buffer contents. The owner must call
+ * clear() whenever the back buffer, the screen format or the theme changes.
+ * The least recently used results are dropped once the cache grows above
+ * its memory budget.
+ */
+class DrawDataCache {
+public:
+	enum {
+		kDefaultMemoryBudget = 4 * 1024 * 1024
+	};
+
+	struct Key {
+		DrawData type;
+		Common::Rect area;
+		Common::Rect clip;
+		uint32 dynamic;
+
+		bool operator==(const Key &other) const {
+			return type == other.type && area == other.area && clip == other.clip && dynamic == other.dynamic;
+		}
+	};
+
+	explicit DrawDataCache(uint32 memoryBudget = kDefaultMemoryBudget) : _memoryBudget(memoryBudget), _memoryUsage(0) {}
+	~DrawDataCache() { clear(); }
+
+	/** Returns the pixels stored for the key, or 0 if there are none. */
+	const Graphics::Surface *find(const Key &key);
+
+	/** Stores a copy of the given area of the surface for the key. */
+	void insert(const Key &key, const Graphics::Surface &surf, const Common::Rect &r);
+
+	/** Drops all results. */
+	void clear();
+
+private:
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = key.type;
+			hash = hash * 31 + key.area.left;
+			hash = hash * 31 + key.area.top;
+			hash = hash * 31 + key.area.right;
+			hash = hash * 31 + key.area.bottom;
+			hash = hash * 31 + key.clip.left;
+			hash = hash * 31 + key.clip.top;
+			hash = hash * 31 + key.clip.right;
+			hash = hash * 31 + key.clip.bottom;
+			return hash * 31 + key.dynamic;
+		}
+	};
+
+	struct Entry {
+		Key key;
+		Graphics::Surface pixels;
+	};
+
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	void remove(EntryList::iterator entry);
+
+	/** Most recently used entries first */
+	EntryList _entries;
+	EntryMap _map;
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+};
+
+const Graphics::Surface *DrawDataCache::find(const Key &key) {
+	EntryMap::iterator i = _map.find(key);
+	if (i == _map.end())
+		return 0;
+
+	// Move the entry to the front of the list
+	Entry *entry = *i->_value;
+	_entries.erase(i->_value);
+	_entries.push_front(entry);
+	i->_value = _entries.begin();
+	return &entry->pixels;
+}
+
+void DrawDataCache::insert(const Key &key, const Graphics::Surface &surf, const Common::Rect &r) {
+	const uint32 size = r.width() * r.height() * surf.format.bytesPerPixel;
+	if (r.isEmpty() || size > _memoryBudget)
+		return;
+
+	EntryMap::iterator i = _map.find(key);
+	if (i != _map.end())
+		remove(i->_value);
+
+	while (_memoryUsage + size > _memoryBudget)
+		remove(--_entries.end());
+
+	Entry *entry = new Entry();
+	entry->key = key;
+	entry->pixels.create(r.width(), r.height(), surf.format);
+	entry->pixels.copyRectToSurface(surf, 0, 0, r);
+
+	_entries.push_front(entry);
+	_map[key] = _entries.begin();
+	_memoryUsage += size;
+}
+
+void DrawDataCache::remove(EntryList::iterator entry) {
+	Entry *e = *entry;
+	_memoryUsage -= e->pixels.h * e->pixels.pitch;
+	_map.erase(e->key);
+	_entries.erase(entry);
+	e->pixels.free();
+	delete e;
+}
+
+void DrawDataCache::clear() {
+	while (!_entries.empty())
+		remove(_entries.begin());
+}
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -168,7 +290,7 @@ static const DrawDataInfo kDrawDataDefaults[] = {
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
-	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
+	_font(0), _dirtyRectCount(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(0) {
 
 	_system = g_system;
@@ -181,6 +303,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 		_widgets[i] = 0;
 	}
 
+	_drawDataCache = new DrawDataCache();
+
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		_texts[i] = 0;
 	}
@@ -219,6 +343,8 @@ ThemeEngine::~ThemeEngine() {
 
 	unloadTheme();
 
+	delete _drawDataCache;
+
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
 		Graphics::Surface *surf = i->_value;
@@ -347,11 +473,33 @@ void ThemeEngine::clearAll() {
 	if (_initOk) {
 		_system->clearOverlay();
 		_system->grabOverlay(_backBuffer.getPixels(), _backBuffer.pitch);
+		_drawDataCache->clear();
 	}
 }
 
 void ThemeEngine::refresh() {
 
+	// The parsed theme only depends on the overlay size and format, so a
+	// screen change keeping both, like toggling fullscreen, only needs new
+	// surfaces instead of loading the whole theme again
+	if (_initOk && _themeOk && _overlayFormat == _system->getOverlayFormat() &&
+	        _screen.w == _system->getOverlayWidth() && _screen.h == _system->getOverlayHeight()) {
+		setGraphicsMode(_graphicsMode);
+	} else {
+		reload();
+	}
+
+	if (_enabled) {
+		_system->showOverlay();
+
+		if (_useCursor) {
+			CursorMan.replaceCursorPalette(_cursorPal, 0, _cursorPalSize);
+			CursorMan.replaceCursor(_cursor, _cursorWidth, _cursorHeight, _cursorHotspotX, _cursorHotspotY, 255, true);
+		}
+	}
+}
+
+void ThemeEngine::reload() {
 	// Flush all bitmaps if the overlay pixel format changed.
 	if (_overlayFormat != _system->getOverlayFormat()) {
 		for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
@@ -374,15 +522,6 @@ void ThemeEngine::refresh() {
 	}
 
 	init();
-
-	if (_enabled) {
-		_system->showOverlay();
-
-		if (_useCursor) {
-			CursorMan.replaceCursorPalette(_cursorPal, 0, _cursorPalSize);
-			CursorMan.replaceCursor(_cursor, _cursorWidth, _cursorHeight, _cursorHotspotX, _cursorHotspotY, 255, true);
-		}
-	}
 }
 
 void ThemeEngine::enable() {
@@ -435,6 +574,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	_drawDataCache->clear();
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -732,6 +873,12 @@ void ThemeEngine::unloadTheme() {
 		_widgets[i] = 0;
 	}
 
+	_drawDataCache->clear();
+
+	// The text drawn with the fonts of the theme is not needed anymore
+	if (_vectorRenderer)
+		_vectorRenderer->clearTextCache();
+
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		delete _texts[i];
 		_texts[i] = 0;
@@ -852,7 +999,8 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 	if (!drawData)
 		return;
 
-	if (kDrawDataDefaults[type].parent != kDDNone && kDrawDataDefaults[type].parent != type)
+	const bool hasParent = kDrawDataDefaults[type].parent != kDDNone && kDrawDataDefaults[type].parent != type;
+	if (hasParent)
 		drawDD(kDrawDataDefaults[type].parent, r, dynamic);
 
 	Common::Rect area = r;
@@ -869,7 +1017,30 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.clip(_clip);
 	}
 
-	if (forceRestore || drawData->_layer == kDrawLayerBackground)
+	const bool restore = forceRestore || drawData->_layer == kDrawLayerBackground;
+
+	// When the item is drawn to the screen over the restored background,
+	// the result only depends on the item and where it is drawn
+	const bool cacheable = restore && !hasParent && drawData->_layer == _layerToDraw &&
+	                       _vectorRenderer->getActiveSurface() == &_screen;
+	DrawDataCache::Key key;
+	Common::Rect cachedRect = extendedRect;
+	cachedRect.clip(_screen.w, _screen.h);
+	if (cacheable) {
+		key.type = type;
+		key.area = area;
+		key.clip = _clip;
+		key.dynamic = dynamic;
+
+		const Graphics::Surface *cached = _drawDataCache->find(key);
+		if (cached) {
+			_screen.copyRectToSurface(*cached, cachedRect.left, cachedRect.top, Common::Rect(cached->w, cached->h));
+			addDirtyRect(extendedRect);
+			return;
+		}
+	}
+
+	if (restore)
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
@@ -878,6 +1049,9 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 			_vectorRenderer->drawStepClip(area, _clip, *step, dynamic);
 		}
 
+		if (cacheable)
+			_drawDataCache->insert(key, _screen, cachedRect);
+
 		addDirtyRect(extendedRect);
 	}
 }
@@ -1311,6 +1485,8 @@ void ThemeEngine::addDirtyRect(Common::Rect r) {
 	if (r.isEmpty())
 		return;
 
+	_dirtyRectCount++;
+
 	// Check if the new rectangle is contained within another in the list
 	Common::List<Common::Rect>::iterator it;
 	for (it = _dirtyScreen.begin(); it != _dirtyScreen.end();) {
@@ -1892,6 +2068,9 @@ void ThemeEngine::hideCursor() {
 
 void ThemeEngine::drawToBackbuffer() {
 	_vectorRenderer->setSurface(&_backBuffer);
+
+	// Anything drawn over the old back buffer contents is outdated now
+	_drawDataCache->clear();
 }
 
 void ThemeEngine::drawToScreen() {
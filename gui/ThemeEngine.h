@@ -49,6 +49,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+class DrawDataCache;
 struct TextDrawData;
 struct TextColorData;
 class Dialog;
@@ -440,6 +441,12 @@ public:
 	 */
 	void addDirtyRect(Common::Rect r);
 
+	/**
+	 * Returns how many times something was drawn to the screen so far.
+	 * Nothing changed on screen as long as this stays the same.
+	 */
+	uint32 getDirtyRectCount() const { return _dirtyRectCount; }
+
 
 	/**
 	 * Returns the DrawData enumeration value that represents the given string
@@ -609,6 +616,11 @@ protected:
 	 */
 	void unloadTheme();
 
+	/**
+	 * Loads the theme again for a new overlay size or format.
+	 */
+	void reload();
+
 	const Graphics::Font *loadScalableFont(const Common::String &filename, const Common::String &charset, const int pointsize, Common::String &name);
 	const Graphics::Font *loadFont(const Common::String &filename, Common::String &name);
 	Common::String genCacheFilename(const Common::String &filename) const;
@@ -702,6 +714,12 @@ protected:
 	 */
 	WidgetDrawData *_widgets[kDrawDataMAX];
 
+	/**
+	 * Rendered DrawData items which were drawn over the back buffer, reused
+	 * when the same item is redrawn at the same place.
+	 */
+	DrawDataCache *_drawDataCache;
+
 	/** Array of all the text fonts that can be drawn. */
 	TextDrawData *_texts[kTextDataMAX];
 
@@ -718,6 +736,9 @@ protected:
 	/** List of all the dirty screens that must be blitted to the overlay. */
 	Common::List<Common::Rect> _dirtyScreen;
 
+	/** Number of non-empty dirty rects added, see getDirtyRectCount(). */
+	uint32 _dirtyRectCount;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
@@ -26,6 +26,11 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/system.h"
+#include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/memtracker.h"
+#include "common/savefile.h"
+#include "common/zlib.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -34,6 +39,13 @@
 #include "common/stream.h"
 #endif
 
+#ifdef ENABLE_PROFILER
+#include "common/file.h"
+#include "common/profiler.h"
+#endif
+
+#include "audio/cpustats.h"
+
 #include "engines/engine.h"
 
 #include "gui/debugger.h"
@@ -77,6 +89,13 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+#ifdef ENABLE_PROFILER
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
+#endif
+	registerCmd("audiostats",		WRAP_METHOD(Debugger, cmdAudioStats));
+	registerCmd("savespeed",		WRAP_METHOD(Debugger, cmdSaveSpeed));
+	registerCmd("frametimes",		WRAP_METHOD(Debugger, cmdFrameTimes));
+	registerCmd("memory",			WRAP_METHOD(Debugger, cmdMemory));
 }
 
 Debugger::~Debugger() {
@@ -774,6 +793,202 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef ENABLE_PROFILER
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc == 2 && !strcmp(argv[1], "start")) {
+		profiler.start();
+		debugPrintf("Profiling started\n");
+	} else if (argc == 2 && !strcmp(argv[1], "stop")) {
+		profiler.stop();
+		debugPrintf("Profiling stopped\n");
+	} else if (argc == 2 && !strcmp(argv[1], "clear")) {
+		profiler.clear();
+		debugPrintf("Recorded zones cleared\n");
+	} else if (argc == 3 && !strcmp(argv[1], "dump")) {
+		Common::DumpFile out;
+		if (!out.open(argv[2])) {
+			debugPrintf("Failed to open '%s' for writing\n", argv[2]);
+			return true;
+		}
+
+		const bool wasRecording = profiler.isRecording();
+		profiler.stop();
+		const uint zones = profiler.writeChromeTrace(out);
+		out.finalize();
+		if (wasRecording)
+			profiler.start();
+
+		debugPrintf("Wrote %u zones to '%s', open it in chrome://tracing\n", zones, argv[2]);
+	} else {
+		debugPrintf("profile start | stop | clear | dump <file>\n");
+		debugPrintf("  Records timed zones from all threads, dumped as Chrome trace JSON\n");
+	}
+	return true;
+}
+#endif
+
+bool Debugger::cmdAudioStats(int argc, const char **argv) {
+	Audio::CPUStats &stats = Audio::CPUStats::instance();
+
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		stats.setEnabled(true);
+		debugPrintf("Audio CPU accounting enabled, the first totals are ready after a second of audio\n");
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		stats.setEnabled(false);
+		debugPrintf("Audio CPU accounting disabled\n");
+	} else if (argc == 1 || (argc == 2 && !strcmp(argv[1], "show"))) {
+		if (!stats.isEnabled()) {
+			debugPrintf("Audio CPU accounting is disabled, use 'audiostats on'\n");
+			return true;
+		}
+
+		const Common::Array<Audio::CPUStats::Counter> counters = stats.getCounters();
+		debugPrintf("CPU time of the last second of audio:\n");
+		for (uint i = 0; i < counters.size(); i++) {
+			debugPrintf("  %-14s %3u.%u%%  peak %6uus\n", counters[i].name,
+			            counters[i].usec / 10000, counters[i].usec / 1000 % 10, counters[i].peakUsec);
+		}
+	} else {
+		debugPrintf("audiostats [on | off | show]\n");
+		debugPrintf("  Counts the mixing thread's CPU time per sound type and per synth\n");
+	}
+	return true;
+}
+
+bool Debugger::cmdFrameTimes(int argc, const char **argv) {
+	if (!g_engine) {
+		debugPrintf("No engine is running\n");
+		return true;
+	}
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		g_engine->resetFrameTimes();
+		debugPrintf("Frame times cleared\n");
+	} else if (argc == 1) {
+		const FrameTimeHistogram &frames = g_engine->getFrameTimes();
+		if (!frames.getTotalFrames()) {
+			debugPrintf("No frames recorded yet\n");
+			return true;
+		}
+
+		debugPrintf("%u frames, average %u ms, max %u ms\n", frames.getTotalFrames(), frames.getAverageMillis(), frames.getMaxMillis());
+		debugPrintf("50%%: %u ms  90%%: %u ms  99%%: %u ms\n", frames.getPercentile(50), frames.getPercentile(90), frames.getPercentile(99));
+
+		static const uint32 ranges[] = { 0, 17, 34, 51, 101, FrameTimeHistogram::kMaxMillis + 1 };
+		for (uint i = 0; i + 1 < ARRAYSIZE(ranges); i++) {
+			const uint32 count = frames.countFrames(ranges[i], ranges[i + 1] - 1);
+			if (i + 2 < ARRAYSIZE(ranges))
+				debugPrintf("  %3u-%3u ms %8u  %3u%%\n", ranges[i], ranges[i + 1] - 1, count, count * 100 / frames.getTotalFrames());
+			else
+				debugPrintf("   >= %3u ms %8u  %3u%%\n", ranges[i], count, count * 100 / frames.getTotalFrames());
+		}
+		debugPrintf("Frames over %d ms are logged at debug level 1 (\"frame_stall_threshold\")\n", ConfMan.getInt("frame_stall_threshold"));
+	} else {
+		debugPrintf("frametimes [reset]\n");
+		debugPrintf("  Shows a histogram of the time between the frames the engine drew\n");
+	}
+	return true;
+}
+
+bool Debugger::cmdMemory(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		Common::MemoryTracker::resetPeaks();
+		debugPrintf("Memory peaks reset\n");
+	} else if (argc == 1) {
+		debugPrintf("%-12s %10s %10s\n", "", "current KB", "peak KB");
+		for (int i = 0; i < Common::kMemoryTagCount; i++) {
+			const Common::MemoryTag tag = (Common::MemoryTag)i;
+			debugPrintf("%-12s %10u %10u\n", Common::MemoryTracker::getTagName(tag),
+			            Common::MemoryTracker::getCurrent(tag) / 1024, Common::MemoryTracker::getPeak(tag) / 1024);
+		}
+		debugPrintf("%-12s %10u\n", "total", Common::MemoryTracker::getTotal() / 1024);
+
+		if (Common::MemoryTracker::getBudget())
+			debugPrintf("Budget: %u KB (\"memory_budget\")\n", Common::MemoryTracker::getBudget() / 1024);
+		else
+			debugPrintf("No budget set (\"memory_budget\")\n");
+	} else {
+		debugPrintf("memory [reset]\n");
+		debugPrintf("  Shows the memory used by resource managers, videos, streams, images and caches\n");
+	}
+	return true;
+}
+
+bool Debugger::cmdSaveSpeed(int argc, const char **argv) {
+	if (argc != 2) {
+		debugPrintf("Usage: %s <savefile>\n", argv[0]);
+		debugPrintf("  Times saving and loading the given save with each compression method\n");
+		debugPrintf("  Current method (\"save_compression\"): %s\n", ConfMan.get("save_compression").c_str());
+		return true;
+	}
+
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(argv[1]);
+	if (!in) {
+		debugPrintf("Could not open savefile '%s'\n", argv[1]);
+		return true;
+	}
+
+	const uint32 rawSize = in->size();
+	byte *raw = (byte *)malloc(rawSize ? rawSize : 1);
+	const bool readOk = raw && in->read(raw, rawSize) == rawSize;
+	delete in;
+	if (!readOk) {
+		free(raw);
+		debugPrintf("Failed to read savefile '%s'\n", argv[1]);
+		return true;
+	}
+
+	static const struct {
+		const char *name;
+		Common::CompressionMethod method;
+	} methods[] = {
+		{ "gzip", Common::kCompressionGZip },
+		{ "lz4", Common::kCompressionLZ4 }
+	};
+
+	debugPrintf("%s: %u bytes uncompressed\n", argv[1], rawSize);
+	byte *check = (byte *)malloc(rawSize ? rawSize : 1);
+	for (uint i = 0; i < ARRAYSIZE(methods); ++i) {
+		Common::MemoryWriteStreamDynamic *buffer = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+
+		uint64 start = g_system->getMicroseconds();
+		Common::WriteStream *out = Common::wrapCompressedWriteStream(buffer, methods[i].method);
+		if (!out) {
+			delete buffer;
+			debugPrintf("  %-5s unavailable\n", methods[i].name);
+			continue;
+		}
+		out->write(raw, rawSize);
+		out->finalize();
+		const uint64 saveTime = g_system->getMicroseconds() - start;
+
+		const uint32 packedSize = buffer->size();
+		Common::SeekableReadStream *packed = new Common::MemoryReadStream(buffer->getData(), packedSize);
+		start = g_system->getMicroseconds();
+		Common::SeekableReadStream *unpacked = Common::wrapCompressedReadStream(packed);
+		const bool loadOk = unpacked && unpacked->read(check, rawSize) == rawSize && !memcmp(check, raw, rawSize);
+		delete unpacked;
+		const uint64 loadTime = g_system->getMicroseconds() - start;
+		delete out;
+
+		if (!loadOk) {
+			debugPrintf("  %-5s round trip FAILED\n", methods[i].name);
+			continue;
+		}
+
+		// Bytes per microsecond equals MB/s
+		debugPrintf("  %-5s %8u bytes (%3u%%)  save %6.1f MB/s  load %6.1f MB/s\n", methods[i].name,
+		            packedSize, rawSize ? (uint)((uint64)packedSize * 100 / rawSize) : 0,
+		            saveTime ? (double)rawSize / saveTime : 0.0, loadTime ? (double)rawSize / loadTime : 0.0);
+	}
+
+	free(check);
+	free(raw);
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
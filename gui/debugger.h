@@ -233,6 +233,13 @@ protected:
 	bool cmdDebugFlagsList(int argc, const char **argv);
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
+#ifdef ENABLE_PROFILER
+	bool cmdProfile(int argc, const char **argv);
+#endif
+	bool cmdAudioStats(int argc, const char **argv);
+	bool cmdSaveSpeed(int argc, const char **argv);
+	bool cmdFrameTimes(int argc, const char **argv);
+	bool cmdMemory(int argc, const char **argv);
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
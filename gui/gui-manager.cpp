@@ -50,7 +50,9 @@ namespace GUI {
 enum {
 	kDoubleClickDelay = 500, // milliseconds
 	kCursorAnimateDelay = 250,
-	kTooltipDelay = 1250
+	kTooltipDelay = 1250,
+	kIdleDelay = 1000,
+	kIdleFrameDuration = 1000 / 20
 };
 
 // Constructor
@@ -321,9 +323,12 @@ void GuiManager::runLoop() {
 
 	Common::EventManager *eventMan = _system->getEventManager();
 	const uint32 targetFrameDuration = 1000 / 60;
+	uint32 lastActivityTime = _system->getMillis(true);
 
 	while (!_dialogStack.empty() && activeDialog == getTopDialog() && !eventMan->shouldQuit()) {
 		uint32 frameStartTime = _system->getMillis(true);
+		uint32 dirtyRectCount = _theme->getDirtyRectCount();
+		bool hadEvents = false;
 
 		// Don't "tickle" the dialog until the theme has had a chance
 		// to re-allocate buffers in case of a scaler change.
@@ -336,6 +341,8 @@ void GuiManager::runLoop() {
 		Common::Event event;
 
 		while (eventMan->pollEvent(event)) {
+			hadEvents = true;
+
 			// We will need to check whether the screen changed while polling
 			// for an event here. While we do send EVENT_SCREEN_CHANGED
 			// whenever this happens we still cannot be sure that we get such
@@ -386,10 +393,17 @@ void GuiManager::runLoop() {
 
 		redraw();
 
+		// Once there has been no input and nothing was drawn for a while,
+		// tick less often. Animated dialogs draw on every tick, so they
+		// keep the full frame rate.
+		if (hadEvents || _theme->getDirtyRectCount() != dirtyRectCount)
+			lastActivityTime = frameStartTime;
+		uint32 frameDuration = (frameStartTime - lastActivityTime < kIdleDelay) ? targetFrameDuration : (uint32)kIdleFrameDuration;
+
 		// Delay until the allocated frame time is elapsed to match the target frame rate
 		uint32 actualFrameDuration = _system->getMillis(true) - frameStartTime;
-		if (actualFrameDuration < targetFrameDuration) {
-			_system->delayMillis(targetFrameDuration - actualFrameDuration);
+		if (actualFrameDuration < frameDuration) {
+			_system->delayMillis(frameDuration - actualFrameDuration);
 		}
 		_system->updateScreen();
 	}
@@ -22,6 +22,7 @@
 
 #include "base/version.h"
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/fs.h"
@@ -245,9 +246,33 @@ void LauncherDialog::close() {
 	Dialog::close();
 }
 
+namespace {
+
+struct LauncherEntry {
+	Common::String description;
+	Common::String domain;
+	ThemeEngine::FontColor color;
+	uint order;
+};
+
+/**
+ * Sorts by description, and games with the same description latest found
+ * first, as the list used to be built by inserting each game before the
+ * first one not sorting before it
+ */
+struct LauncherEntryLess {
+	bool operator()(const LauncherEntry &a, const LauncherEntry &b) const {
+		const int cmp = scumm_stricmp(a.description.c_str(), b.description.c_str());
+		if (cmp != 0)
+			return cmp < 0;
+		return a.order > b.order;
+	}
+};
+
+} // End of anonymous namespace
+
 void LauncherDialog::updateListing() {
-	StringArray l;
-	ListWidget::ColorList colors;
+	Common::Array<LauncherEntry> entries;
 	ThemeEngine::FontColor color;
 
 	// Retrieve a list of all games defined in the config file
@@ -280,12 +305,7 @@ void LauncherDialog::updateListing() {
 		}
 
 		if (!gameid.empty() && !description.empty()) {
-			// Insert the game into the launcher list
-			int pos = 0, size = l.size();
-
-			while (pos < size && (scumm_stricmp(description.c_str(), l[pos].c_str()) > 0))
-				pos++;
-
+			// Add the game to the launcher list
 			color = ThemeEngine::kFontColorNormal;
 			if (!path.isDirectory()) {
 				color = ThemeEngine::kFontColorAlternate;
@@ -296,12 +316,29 @@ void LauncherDialog::updateListing() {
 				// description += Common::String::format(" (%s)", _("Not found"));
 			}
 
-			l.insert_at(pos, description);
-			colors.insert_at(pos, color);
-			_domains.insert_at(pos, iter->_key);
+			LauncherEntry entry;
+			entry.description = description;
+			entry.domain = iter->_key;
+			entry.color = color;
+			entry.order = entries.size();
+			entries.push_back(entry);
 		}
 	}
 
+	// Sorting once is much faster than inserting in order with many games
+	Common::sort(entries.begin(), entries.end(), LauncherEntryLess());
+
+	StringArray l;
+	ListWidget::ColorList colors;
+	l.reserve(entries.size());
+	colors.reserve(entries.size());
+	_domains.reserve(entries.size());
+	for (uint i = 0; i < entries.size(); ++i) {
+		l.push_back(entries[i].description);
+		colors.push_back(entries[i].color);
+		_domains.push_back(entries[i].domain);
+	}
+
 	const int oldSel = _list->getSelected();
 	_list->setList(l, &colors);
 	if (oldSel < (int)l.size())
@@ -20,10 +20,13 @@
  *
  */
 
+#include "engines/advancedDetector.h"
 #include "engines/metaengine.h"
 #include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
+#include "common/mutex.h"
+#include "common/stack.h"
 #include "common/system.h"
 #include "common/taskbar.h"
 #include "common/translation.h"
@@ -53,10 +56,160 @@ enum {
 	kCancelCmd = 'CNCL'
 };
 
+/**
+ * Walks the directories below the start directory breadth-first, and runs
+ * the detector on each of them. With a threaded task scheduler the walk
+ * runs as a task, so listing slow directories does not stall the GUI;
+ * otherwise the dialog walks a few directories at a time in handleTickle().
+ *
+ * Detection uses SearchMan and the savefile manager, which may only be used
+ * from the main thread, so detectNextDirectory() is always called from the
+ * dialog. The task and the dialog only hand each other deep copies of the
+ * paths and nodes they create, since neither is reference counted safely
+ * across threads.
+ */
+class MassAddScanner : public Common::Task {
+public:
+	struct Result {
+		Common::String path;
+		DetectedGames games;
+		Common::String unknownGameReport;
+		int subdirCount;
+	};
+
+	MassAddScanner(const Common::FSNode &startDir) : _cancelled(false), _walkDone(false) {
+		_scanStack.push(Common::String(startDir.getPath().c_str()));
+	}
+
+	~MassAddScanner() {
+		for (uint i = 0; i < _listings.size(); i++)
+			delete _listings[i];
+	}
+
+	virtual void run() {
+		while (walkNextDirectory()) {
+			Common::StackLock lock(_mutex);
+			if (_cancelled)
+				break;
+		}
+	}
+
+	/**
+	 * List the next directory on the stack, and queue its files for
+	 * detectNextDirectory().
+	 *
+	 * @return false if all directories have been listed
+	 */
+	bool walkNextDirectory() {
+		if (_scanStack.empty()) {
+			Common::StackLock lock(_mutex);
+			_walkDone = true;
+			return false;
+		}
+
+		Listing *listing = new Listing();
+		listing->path = _scanStack.pop();
+		listing->subdirCount = 0;
+
+		Common::FSNode dir(listing->path);
+		Common::FSList files;
+		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+			delete listing;
+			return true;
+		}
+
+		// Only keep nodes created here, not copies of the ones listed
+		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
+			Common::String path(file->getPath().c_str());
+			listing->files.push_back(Common::FSNode(path));
+
+			// Recurse into all subdirs
+			if (file->isDirectory()) {
+				_scanStack.push(path);
+				listing->subdirCount++;
+			}
+		}
+
+		Common::StackLock lock(_mutex);
+		_listings.push_back(listing);
+		return true;
+	}
+
+	/**
+	 * Run the detector on the next directory which has been listed. This
+	 * must be called from the main thread.
+	 *
+	 * @return false if there is no listed directory left right now
+	 */
+	bool detectNextDirectory() {
+		Listing *listing;
+
+		{
+			Common::StackLock lock(_mutex);
+			if (_listings.empty())
+				return false;
+
+			listing = _listings.front();
+			_listings.remove_at(0);
+		}
+
+		Result result;
+		result.path = listing->path;
+		result.subdirCount = listing->subdirCount;
+
+		DetectionResults detectionResults(EngineMan.detectGames(listing->files));
+
+		if (detectionResults.foundUnknownGames())
+			result.unknownGameReport = detectionResults.generateUnknownGameReport(false, 80);
+
+		result.games = detectionResults.listRecognizedGames();
+		_results.push_back(result);
+
+		delete listing;
+		return true;
+	}
+
+	/** Whether all directories have been listed and detected. */
+	bool isDone() {
+		Common::StackLock lock(_mutex);
+		return _walkDone && _listings.empty();
+	}
+
+	/** Stop after the directory being listed. */
+	void cancel() {
+		Common::StackLock lock(_mutex);
+		_cancelled = true;
+	}
+
+	/** Move the results found so far into results. */
+	void takeResults(Common::Array<Result> &results) {
+		results.push_back(_results);
+		_results.clear();
+	}
+
+private:
+	struct Listing {
+		Common::String path;
+		Common::FSList files;
+		int subdirCount;
+	};
+
+	// Only used by the thread walking the directories
+	Common::Stack<Common::String> _scanStack;
+
+	Common::Mutex _mutex;
+	bool _cancelled;
+	bool _walkDone;
+	Common::Array<Listing *> _listings;
+
+	// Only used by the main thread
+	Common::Array<Result> _results;
+};
 
 
 MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	: Dialog("MassAdd"),
+	_scanner(nullptr),
 	_dirsScanned(0),
 	_oldGamesCount(0),
 	_dirTotal(0),
@@ -66,9 +219,6 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 
 	StringArray l;
 
-	// The dir we start our scan at
-	_scanStack.push(startDir);
-
 	// Removed for now... Why would you put a title on mass add dialog called "Mass Add Dialog"?
 	// new StaticTextWidget(this, "massadddialog_caption", "Mass Add Dialog");
 
@@ -114,6 +264,29 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 		if (!path.empty())
 			_pathToTargets[path].push_back(iter->_key);
 	}
+
+	// The dir we start our scan at
+	_scanner = new MassAddScanner(startDir);
+	Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+	if (!scheduler->isSerial())
+		_scanFuture = scheduler->schedule(_scanner, DisposeAfterUse::NO);
+}
+
+MassAddDialog::~MassAddDialog() {
+	stopScanner();
+}
+
+void MassAddDialog::stopScanner() {
+	if (!_scanner)
+		return;
+
+	_scanner->cancel();
+	if (_scanFuture.isValid())
+		_scanFuture.wait();
+	_scanFuture = Common::TaskFuture();
+
+	delete _scanner;
+	_scanner = nullptr;
 }
 
 struct GameTargetLess {
@@ -136,6 +309,9 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 	g_system->getTaskbarManager()->setCount(0);
 #endif
 
+	if (cmd == kOkCmd || cmd == kCancelCmd)
+		stopScanner();
+
 	// FIXME: It's a really bad thing that we use two arbitrary constants
 	if (cmd == kOkCmd) {
 		// Sort the detected games. This is not strictly necessary, but nice for
@@ -169,27 +345,30 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 }
 
 void MassAddDialog::handleTickle() {
-	if (_scanStack.empty())
+	if (!_scanner)
 		return;	// We have finished scanning
 
+	// Perform a breadth-first scan of the filesystem, unless the scanner
+	// is already walking it in the background, and run the detector on the
+	// directories listed so far
 	uint32 t = g_system->getMillis();
+	do {
+		if (!_scanFuture.isValid())
+			_scanner->walkNextDirectory();
 
-	// Perform a breadth-first scan of the filesystem.
-	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
+		// Wait for the task to list more directories
+		if (!_scanner->detectNextDirectory() && _scanFuture.isValid())
+			break;
+	} while (!_scanner->isDone() && (g_system->getMillis() - t) < kMaxScanTime);
 
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
-			continue;
-		}
+	bool scanning = !_scanner->isDone();
 
-		// Run the detector on the dir
-		DetectionResults detectionResults = EngineMan.detectGames(files);
+	Common::Array<MassAddScanner::Result> results;
+	_scanner->takeResults(results);
 
-		if (detectionResults.foundUnknownGames()) {
-			Common::String report = detectionResults.generateUnknownGameReport(false, 80);
-			g_system->logMessage(LogMessageType::kInfo, report.c_str());
-		}
+	for (Common::Array<MassAddScanner::Result>::iterator dir = results.begin(); dir != results.end(); ++dir) {
+		if (!dir->unknownGameReport.empty())
+			g_system->logMessage(LogMessageType::kInfo, dir->unknownGameReport.c_str());
 
 		// Just add all detected games / game variants. If we get more than one,
 		// that either means the directory contains multiple games, or the detector
@@ -197,11 +376,10 @@ void MassAddDialog::handleTickle() {
 		// case, let the user choose which entries he wants to keep.
 		//
 		// However, we only add games which are not already in the config file.
-		DetectedGames candidates = detectionResults.listRecognizedGames();
-		for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
+		for (DetectedGames::const_iterator cand = dir->games.begin(); cand != dir->games.end(); ++cand) {
 			const DetectedGame &result = *cand;
 
-			Common::String path = dir.getPath();
+			Common::String path = dir->path;
 
 			// Remove trailing slashes
 			while (path != "/" && path.lastChar() == '/')
@@ -237,15 +415,7 @@ void MassAddDialog::handleTickle() {
 		}
 
 
-		// Recurse into all subdirs
-		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-			if (file->isDirectory()) {
-				_scanStack.push(*file);
-
-				_dirTotal++;
-			}
-		}
-
+		_dirTotal += dir->subdirCount;
 		_dirsScanned++;
 
 #if defined(USE_TASKBAR)
@@ -254,14 +424,18 @@ void MassAddDialog::handleTickle() {
 #endif
 	}
 
+	if (!scanning)
+		stopScanner();
 
 	// Update the dialog
 	Common::String buf;
 
-	if (_scanStack.empty()) {
+	if (!_scanner) {
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
+		AdvancedMetaEngine::saveMD5Cache(true);
+
 		buf = _("Scan complete!");
 		_dirProgressText->setLabel(buf);
 
@@ -27,17 +27,19 @@
 #include "gui/widgets/list.h"
 #include "common/fs.h"
 #include "common/hashmap.h"
-#include "common/stack.h"
 #include "common/str.h"
+#include "common/taskscheduler.h"
 
 namespace GUI {
 
+class MassAddScanner;
 class StaticTextWidget;
 
 class MassAddDialog : public Dialog {
 	typedef Common::Array<Common::String> StringArray;
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog();
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
@@ -50,7 +52,11 @@ public:
 	}
 
 private:
-	Common::Stack<Common::FSNode>  _scanStack;
+	/** Cancel the scan if it is still running, and wait for it. */
+	void stopScanner();
+
+	MassAddScanner *_scanner;
+	Common::TaskFuture _scanFuture;
 	DetectedGames _games;
 
 	/**
@@ -30,6 +30,9 @@
 
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/fs.h"
+#include "common/mutex.h"
+#include "common/system.h"
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
@@ -735,9 +738,86 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+/**
+ * Queries the meta infos of a list of save slots on the task scheduler, so
+ * opening the saves and decoding their thumbnails does not block the GUI.
+ *
+ * Only one loader runs at a time, and the dialog waits for it before it
+ * talks to the MetaEngine or the save file manager itself.
+ */
+class SaveMetaInfoLoader : public Common::Task {
+public:
+	struct Result {
+		int slot;
+		SaveStateDescriptor desc;
+	};
+
+	SaveMetaInfoLoader(const MetaEngine *metaEngine, const Common::String &target, const Common::Array<int> &slots)
+		: _metaEngine(metaEngine), _target(target), _slots(slots), _cancelled(false) {}
+
+	virtual void run() {
+		for (uint i = 0; i < _slots.size(); ++i) {
+			{
+				Common::StackLock lock(_mutex);
+				if (_cancelled)
+					break;
+			}
+
+			Result result;
+			result.slot = _slots[i];
+			result.desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _slots[i]);
+
+			// The descriptor shares its thumbnail, so its last reference
+			// on this thread has to go while the lock is held, too
+			Common::StackLock lock(_mutex);
+			_results.push_back(result);
+			result.desc = SaveStateDescriptor();
+		}
+	}
+
+	/** Skip the slots which have not been loaded yet. */
+	void cancel() {
+		Common::StackLock lock(_mutex);
+		_cancelled = true;
+	}
+
+	/** Move the results loaded so far into results. */
+	void takeResults(Common::Array<Result> &results) {
+		Common::StackLock lock(_mutex);
+		results.push_back(_results);
+		_results.clear();
+	}
+
+private:
+	const MetaEngine *_metaEngine;
+	const Common::String _target;
+	const Common::Array<int> _slots;
+
+	Common::Mutex _mutex;
+	bool _cancelled;
+	Common::Array<Result> _results;
+};
+
+/**
+ * Return the newest modification time of the files in the save directory,
+ * or 0 if the save file manager does not store the saves there.
+ */
+static uint32 getSaveDirectoryStamp() {
+	const Common::FSNode saveDir(ConfMan.get("savepath"));
+	Common::FSList files;
+	if (!saveDir.isDirectory() || !saveDir.getChildren(files, Common::FSNode::kListFilesOnly))
+		return 0;
+
+	uint32 stamp = 0;
+	for (Common::FSList::const_iterator i = files.begin(); i != files.end(); ++i)
+		stamp = MAX(stamp, i->getModificationTime());
+	return stamp;
+}
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
-	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
+	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons(), _metaInfoCacheStamp(0),
+	_metaInfoLoader(nullptr) {
 	_backgroundType = ThemeEngine::kDialogBackgroundSpecial;
 
 	new StaticTextWidget(this, "SaveLoadChooser.Title", title);
@@ -756,6 +836,7 @@ SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveM
 }
 
 SaveLoadChooserGrid::~SaveLoadChooserGrid() {
+	stopMetaInfoLoader();
 	removeWidget(_pageDisplay);
 	delete _pageDisplay;
 }
@@ -819,7 +900,9 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 }
 
 void SaveLoadChooserGrid::updateSaveList() {
+	stopMetaInfoLoader();
 	SaveLoadChooserDialog::updateSaveList();
+	validateMetaInfoCache();
 	updateSaves();
 	g_gui.scheduleTopDialogRedraw();
 }
@@ -828,6 +911,7 @@ void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
 	listSaves();
+	validateMetaInfoCache();
 	_resultString.clear();
 
 	// Load information to restore the last page the user had open.
@@ -1001,10 +1085,25 @@ void SaveLoadChooserGrid::close() {
 		ConfMan.setInt("gui_saveload_last_pos", !_saveList.empty() ? _saveList[_curPage * _entriesPerPage].getSaveSlot() : 0);
 	}
 
+	stopMetaInfoLoader();
 	SaveLoadChooserDialog::close();
 	hideButtons();
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	if (_metaInfoLoader) {
+		const bool done = _metaInfoFuture.isDone();
+		applyLoadedMetaInfos();
+		if (done) {
+			delete _metaInfoLoader;
+			_metaInfoLoader = nullptr;
+			_metaInfoFuture = Common::TaskFuture();
+		}
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 int SaveLoadChooserGrid::runIntern() {
 	int slot;
 	do {
@@ -1063,60 +1162,37 @@ void SaveLoadChooserGrid::hideButtons() {
 }
 
 void SaveLoadChooserGrid::updateSaves() {
+	stopMetaInfoLoader();
 	hideButtons();
 
+	Common::Array<int> missingSlots;
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
+		const int saveSlot = _saveList[i].getSaveSlot();
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
 
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
+		if (_saveList[i].getLocked()) {
+			updateSlotButton(curButton, _saveList[i], saveSlot);
+			continue;
 		}
 
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
+		MetaInfoCache::const_iterator cached = _metaInfoCache.find(saveSlot);
+		if (cached != _metaInfoCache.end()) {
+			updateSlotButton(curButton, cached->_value, saveSlot);
 		} else {
-			curButton.button->setEnabled(true);
+			// Show the description from the save list until the meta infos
+			// have been loaded
+			updateSlotButton(curButton, _saveList[i], saveSlot);
+			missingSlots.push_back(saveSlot);
 		}
+	}
 
-		//that would make it look "disabled" if slot is locked
-		curButton.button->setEnabled(!desc.getLocked());
-		curButton.description->setEnabled(!desc.getLocked());
+	if (!missingSlots.empty()) {
+		Common::TaskScheduler *scheduler = g_system->getTaskScheduler();
+		_metaInfoLoader = new SaveMetaInfoLoader(_metaEngine, _target, missingSlots);
+		_metaInfoFuture = scheduler->schedule(_metaInfoLoader, DisposeAfterUse::NO);
+		// A serial scheduler has loaded everything already
+		applyLoadedMetaInfos();
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1133,6 +1209,106 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &curButton, const SaveStateDescriptor &desc, int saveSlot) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && desc.getWriteProtectedFlag()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+
+	//that would make it look "disabled" if slot is locked
+	curButton.button->setEnabled(!desc.getLocked());
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
+void SaveLoadChooserGrid::validateMetaInfoCache() {
+	// Saves are named by the engines, so there is no telling which file
+	// belongs to which slot. Any change to the save directory drops all
+	// meta infos instead, and backends without one do not keep them
+	// between openings of the dialog.
+	const uint32 stamp = getSaveDirectoryStamp();
+	if (stamp == 0 || stamp != _metaInfoCacheStamp || _target != _metaInfoCacheTarget)
+		_metaInfoCache.clear();
+
+	_metaInfoCacheStamp = stamp;
+	_metaInfoCacheTarget = _target;
+}
+
+void SaveLoadChooserGrid::applyLoadedMetaInfos() {
+	if (!_metaInfoLoader)
+		return;
+
+	Common::Array<SaveMetaInfoLoader::Result> results;
+	_metaInfoLoader->takeResults(results);
+	if (results.empty())
+		return;
+
+	// Keep the cache small, it only needs to cover a few pages
+	if (_metaInfoCache.size() + results.size() > 8 * _entriesPerPage)
+		_metaInfoCache.clear();
+
+	for (uint i = 0; i < results.size(); ++i) {
+		_metaInfoCache[results[i].slot] = results[i].desc;
+
+		for (uint j = _curPage * _entriesPerPage, curNum = 0; j < _saveList.size() && curNum < _entriesPerPage; ++j, ++curNum) {
+			if (_saveList[j].getSaveSlot() == results[i].slot && !_saveList[j].getLocked())
+				updateSlotButton(_buttons[curNum], results[i].desc, results[i].slot);
+		}
+	}
+
+	g_gui.scheduleTopDialogRedraw();
+}
+
+void SaveLoadChooserGrid::stopMetaInfoLoader() {
+	if (!_metaInfoLoader)
+		return;
+
+	_metaInfoLoader->cancel();
+	_metaInfoFuture.wait();
+	applyLoadedMetaInfos();
+
+	delete _metaInfoLoader;
+	_metaInfoLoader = nullptr;
+	_metaInfoFuture = Common::TaskFuture();
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
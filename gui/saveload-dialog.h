@@ -26,6 +26,9 @@
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
+#include "common/hashmap.h"
+#include "common/taskscheduler.h"
+
 #include "engines/metaengine.h"
 
 namespace GUI {
@@ -189,6 +192,8 @@ private:
 	EditTextWidget *_description;
 };
 
+class SaveMetaInfoLoader;
+
 class SaveLoadChooserGrid : public SaveLoadChooserDialog {
 public:
 	SaveLoadChooserGrid(const Common::String &title, bool saveMode);
@@ -203,6 +208,8 @@ public:
 	virtual SaveLoadChooserType getType() const { return kSaveLoadDialogGrid; }
 
 	virtual void close();
+
+	virtual void handleTickle();
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
@@ -243,6 +250,24 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, const SaveStateDescriptor &desc, int saveSlot);
+
+	/**
+	 * Meta infos of the saves, which have been loaded in the background,
+	 * by save slot. Invalidated whenever a file in the save directory
+	 * changes.
+	 */
+	typedef Common::HashMap<int, SaveStateDescriptor> MetaInfoCache;
+	MetaInfoCache _metaInfoCache;
+	Common::String _metaInfoCacheTarget;
+	uint32 _metaInfoCacheStamp;
+	void validateMetaInfoCache();
+
+	/** Loads the meta infos of the slots on the current page, if any are missing. */
+	SaveMetaInfoLoader *_metaInfoLoader;
+	Common::TaskFuture _metaInfoFuture;
+	void applyLoadedMetaInfos();
+	void stopMetaInfoLoader();
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -164,6 +164,11 @@ void ListWidget::setList(const StringArray &list, const ColorList *colors) {
 	// Copy everything
 	_dataList = list;
 	_list = list;
+	_searchList.resize(list.size());
+	for (uint i = 0; i < list.size(); ++i) {
+		_searchList[i] = list[i];
+		_searchList[i].toLowercase();
+	}
 	_filter.clear();
 	_listIndex.clear();
 	_listColors.clear();
@@ -199,6 +204,8 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 
 	_dataList.push_back(s);
 	_list.push_back(s);
+	_searchList.push_back(s);
+	_searchList.back().toLowercase();
 
 	setFilter(_filter, false);
 
@@ -704,6 +711,9 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// Typing on only narrows down the entries matched so far, since each
+	// word of the new filter contains the corresponding word of the old one
+	const bool narrowing = !_filter.empty() && filt.hasPrefix(_filter);
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -715,27 +725,35 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 		// as substrings, ignoring case.
 
 		Common::StringTokenizer tok(_filter);
-		String tmp;
-		int n = 0;
+		StringArray words;
+		while (!tok.empty())
+			words.push_back(tok.nextToken());
+
+		Common::Array<int> candidates;
+		if (narrowing) {
+			candidates = _listIndex;
+		} else {
+			candidates.resize(_dataList.size());
+			for (uint n = 0; n < _dataList.size(); ++n)
+				candidates[n] = n;
+		}
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (Common::Array<int>::const_iterator i = candidates.begin(); i != candidates.end(); ++i) {
+			const String &tmp = _searchList[*i];
 			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+			for (StringArray::const_iterator word = words.begin(); word != words.end(); ++word) {
+				if (!tmp.contains(*word)) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_list.push_back(*i);
-				_listIndex.push_back(n);
+				_list.push_back(_dataList[*i]);
+				_listIndex.push_back(*i);
 			}
 		}
 	}
@@ -55,6 +55,7 @@ public:
 protected:
 	StringArray		_list;
 	StringArray		_dataList;
+	StringArray		_searchList;	///< _dataList in lowercase, for setFilter
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
 	bool			_editable;
@@ -31,7 +31,7 @@
 
 namespace Image {
 
-BitmapDecoder::BitmapDecoder() {
+BitmapDecoder::BitmapDecoder() : _memoryUsage(Common::kMemoryImages) {
 	_surface = 0;
 	_palette = 0;
 	_paletteColorCount = 0;
@@ -44,6 +44,7 @@ BitmapDecoder::~BitmapDecoder() {
 
 void BitmapDecoder::destroy() {
 	_surface = 0;
+	_memoryUsage.set(0);
 
 	delete[] _palette;
 	_palette = 0;
@@ -119,6 +120,8 @@ bool BitmapDecoder::loadStream(Common::SeekableReadStream &stream) {
 	if (!_codec)
 		return false;
 
+	_codec->setOutputPixelFormat(_outputPixelFormat);
+
 	// If the image size is zero, set it to the rest of the stream.
 	if (imageSize == 0)
 		imageSize = stream.size() - imageOffset;
@@ -128,6 +131,7 @@ bool BitmapDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 	// We only support raw bitmaps for now
 	_surface = _codec->decodeFrame(subStream);
+	_memoryUsage.set(_surface ? _surface->h * _surface->pitch : 0);
 
 	return true;
 }
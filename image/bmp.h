@@ -31,8 +31,10 @@
 #ifndef IMAGE_BMP_H
 #define IMAGE_BMP_H
 
+#include "common/memtracker.h"
 #include "common/scummsys.h"
 #include "common/str.h"
+#include "graphics/pixelformat.h"
 #include "image/image_decoder.h"
 
 namespace Common {
@@ -59,10 +61,13 @@ public:
 	virtual const Graphics::Surface *getSurface() const { return _surface; }
 	const byte *getPalette() const { return _palette; }
 	uint16 getPaletteColorCount() const { return _paletteColorCount; }
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputPixelFormat = format; }
 
 private:
+	Graphics::PixelFormat _outputPixelFormat;
 	Codec *_codec;
 	const Graphics::Surface *_surface;
+	Common::MemoryUsage _memoryUsage;
 	byte *_palette;
 	uint16 _paletteColorCount;
 };
@@ -98,7 +98,10 @@ const Graphics::Surface *BitmapRawDecoder::decodeFrame(Common::SeekableReadStrea
 				byte r = stream.readByte();
 				uint32 color = format.RGBToColor(r, g, b);
 
-				*((uint32 *)dst) = color;
+				if (format.bytesPerPixel == 2)
+					*((uint16 *)dst) = color;
+				else
+					*((uint32 *)dst) = color;
 				dst += format.bytesPerPixel;
 			}
 
@@ -119,7 +122,10 @@ const Graphics::Surface *BitmapRawDecoder::decodeFrame(Common::SeekableReadStrea
 				stream.readByte();
 				uint32 color = format.RGBToColor(r, g, b);
 
-				*((uint32 *)dst) = color;
+				if (format.bytesPerPixel == 2)
+					*((uint16 *)dst) = color;
+				else
+					*((uint32 *)dst) = color;
 				dst += format.bytesPerPixel;
 			}
 
@@ -139,10 +145,23 @@ Graphics::PixelFormat BitmapRawDecoder::getPixelFormat() const {
 		return Graphics::PixelFormat::createFormatCLUT8();
 	case 24:
 	case 32:
+		// True color pixels are written one by one, so any 2 or 4 byte
+		// format can be output directly
+		if (_outputPixelFormat.bytesPerPixel == 2 || _outputPixelFormat.bytesPerPixel == 4)
+			return _outputPixelFormat;
 		return Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 	}
 
 	error("Unhandled BMP raw %dbpp", _bitsPerPixel);
 }
 
+void BitmapRawDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	_outputPixelFormat = format;
+
+	if (_surface.format != getPixelFormat()) {
+		_surface.free();
+		_surface.create(_width, _height, getPixelFormat());
+	}
+}
+
 } // End of namespace Image
@@ -39,9 +39,11 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
 	Graphics::PixelFormat getPixelFormat() const;
+	void setOutputPixelFormat(const Graphics::PixelFormat &format);
 
 private:
 	Graphics::Surface _surface;
+	Graphics::PixelFormat _outputPixelFormat;
 	int _width, _height;
 	int _bitsPerPixel;
 };
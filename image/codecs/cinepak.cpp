@@ -129,6 +129,39 @@ struct CodebookConverterRaw {
 	}
 };
 
+/**
+ * Codebook converter for high color output, from the codebooks converted
+ * to the output format ahead of time
+ */
+struct CodebookConverterColor {
+	template<typename PixelInt>
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+		const uint32 *colors = strip.v1_color + (codebookIndex << 2);
+		const PixelInt top[4] = { (PixelInt)colors[0], (PixelInt)colors[0], (PixelInt)colors[1], (PixelInt)colors[1] };
+		const PixelInt bottom[4] = { (PixelInt)colors[2], (PixelInt)colors[2], (PixelInt)colors[3], (PixelInt)colors[3] };
+		memcpy(rows[0], top, sizeof(top));
+		memcpy(rows[1], top, sizeof(top));
+		memcpy(rows[2], bottom, sizeof(bottom));
+		memcpy(rows[3], bottom, sizeof(bottom));
+	}
+
+	template<typename PixelInt>
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+		putQuad(strip.v4_color + (codebookIndex[0] << 2), rows[0] + 0, rows[1] + 0);
+		putQuad(strip.v4_color + (codebookIndex[1] << 2), rows[0] + 2, rows[1] + 2);
+		putQuad(strip.v4_color + (codebookIndex[2] << 2), rows[2] + 0, rows[3] + 0);
+		putQuad(strip.v4_color + (codebookIndex[3] << 2), rows[2] + 2, rows[3] + 2);
+	}
+
+private:
+	template<typename PixelInt>
+	static inline void putQuad(const uint32 *colors, PixelInt *top, PixelInt *bottom) {
+		const PixelInt quad[4] = { (PixelInt)colors[0], (PixelInt)colors[1], (PixelInt)colors[2], (PixelInt)colors[3] };
+		memcpy(top, quad, sizeof(PixelInt) * 2);
+		memcpy(bottom, quad + 2, sizeof(PixelInt) * 2);
+	}
+};
+
 /**
  * Codebook converter that dithers in VFW-style
  */
@@ -303,9 +336,9 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *c
 
 	for (uint16 y = frame.strips[strip].rect.top; y < frame.strips[strip].rect.bottom; y += 4) {
 		iy[0] = (PixelInt *)frame.surface->getBasePtr(frame.strips[strip].rect.left, + y);
-		iy[1] = iy[0] + frame.width;
-		iy[2] = iy[1] + frame.width;
-		iy[3] = iy[2] + frame.width;
+		iy[1] = iy[0] + frame.surface->pitch / sizeof(PixelInt);
+		iy[2] = iy[1] + frame.surface->pitch / sizeof(PixelInt);
+		iy[3] = iy[2] + frame.surface->pitch / sizeof(PixelInt);
 
 		for (uint16 x = frame.strips[strip].rect.left; x < frame.strips[strip].rect.right; x += 4) {
 			if ((chunkID & 0x01) && !(mask >>= 1)) {
@@ -358,15 +391,7 @@ CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec(), _bitsPerPixel(bitsPe
 	_ditherPalette = 0;
 	_ditherType = kDitherTypeUnknown;
 
-	if (bitsPerPixel == 8) {
-		_pixelFormat = Graphics::PixelFormat::createFormatCLUT8();
-	} else {
-		_pixelFormat = g_system->getScreenFormat();
-
-		// Default to a 32bpp format, if in 8bpp mode
-		if (_pixelFormat.bytesPerPixel == 1)
-			_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
-	}
+	_pixelFormat = getDefaultPixelFormat();
 
 	// Create a lookup for the clip function
 	// This dramatically improves the performance of the color conversion
@@ -397,7 +422,28 @@ CinepakDecoder::~CinepakDecoder() {
 	delete[] _ditherPalette;
 }
 
+Graphics::PixelFormat CinepakDecoder::getDefaultPixelFormat() const {
+	if (_bitsPerPixel == 8)
+		return Graphics::PixelFormat::createFormatCLUT8();
+
+	Graphics::PixelFormat format = g_system->getScreenFormat();
+
+	// Default to a 32bpp format, if in 8bpp mode
+	if (format.bytesPerPixel == 1)
+		return Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
+
+	return format;
+}
+
 const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream &stream) {
+	return decode(stream, 0);
+}
+
+const Graphics::Surface *CinepakDecoder::decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	return decode(stream, &dst);
+}
+
+const Graphics::Surface *CinepakDecoder::decode(Common::SeekableReadStream &stream, Graphics::Surface *dst) {
 	_curFrame.flags = stream.readByte();
 	_curFrame.length = (stream.readByte() << 16);
 	_curFrame.length |= stream.readUint16BE();
@@ -429,6 +475,22 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
 	}
 
+	Graphics::Surface *target = dst ? beginDirectDecode(*_curFrame.surface, *dst) : 0;
+	if (!target) {
+		endDirectDecode();
+		decodeStrips(stream);
+		return _curFrame.surface;
+	}
+
+	// Point the frame at the outside surface while decoding
+	Graphics::Surface *surface = _curFrame.surface;
+	_curFrame.surface = target;
+	decodeStrips(stream);
+	_curFrame.surface = surface;
+	return target;
+}
+
+void CinepakDecoder::decodeStrips(Common::SeekableReadStream &stream) {
 	_y = 0;
 
 	for (uint16 i = 0; i < _curFrame.stripCount; i++) {
@@ -439,9 +501,15 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				_curFrame.strips[i].v4_codebook[j] = _curFrame.strips[i - 1].v4_codebook[j];
 			}
 
-			// Copy the QuickTime dither tables
-			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
-			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
+			if (_ditherType == kDitherTypeQT) {
+				// Copy the QuickTime dither tables
+				memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
+				memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
+			} else if (!_ditherPalette && _pixelFormat.bytesPerPixel != 1) {
+				// Copy the converted codebooks
+				memcpy(_curFrame.strips[i].v1_color, _curFrame.strips[i - 1].v1_color, sizeof(_curFrame.strips[i].v1_color));
+				memcpy(_curFrame.strips[i].v4_color, _curFrame.strips[i - 1].v4_color, sizeof(_curFrame.strips[i].v4_color));
+			}
 		}
 
 		_curFrame.strips[i].id = stream.readUint16BE();
@@ -491,7 +559,7 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				break;
 			default:
 				warning("Unknown Cinepak chunk ID %02x", chunkID);
-				return _curFrame.surface;
+				return;
 			}
 
 			if (stream.pos() != startPos + (int32)chunkSize)
@@ -500,8 +568,6 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 
 		_y = _curFrame.strips[i].rect.bottom;
 	}
-
-	return _curFrame.surface;
 }
 
 void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
@@ -514,6 +580,8 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 
 		if (_ditherType == kDitherTypeQT)
 			ditherCodebookQT(strip, codebookType, i);
+		else if (!_ditherPalette && _pixelFormat.bytesPerPixel != 1)
+			convertCodebook(strip, codebookType, i);
 	}
 }
 
@@ -550,13 +618,24 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
+			// Dither the codebook if we're dithering for QuickTime,
+			// or convert it for high color output
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
+			else if (!_ditherPalette && _pixelFormat.bytesPerPixel != 1)
+				convertCodebook(strip, codebookType, i);
 		}
 	}
 }
 
+void CinepakDecoder::convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	const CinepakCodebook &codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook[codebookIndex] : _curFrame.strips[strip].v4_codebook[codebookIndex];
+	uint32 *output = ((codebookType == 1) ? _curFrame.strips[strip].v1_color : _curFrame.strips[strip].v4_color) + (codebookIndex << 2);
+
+	for (int i = 0; i < 4; i++)
+		output[i] = convertYUVToColor(_clipTable, _pixelFormat, codebook.y[i], codebook.u, codebook.v);
+}
+
 void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex) {
 	if (codebookType == 1) {
 		const CinepakCodebook &codebook = _curFrame.strips[strip].v1_codebook[codebookIndex];
@@ -619,9 +698,9 @@ void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 st
 	if (_curFrame.surface->format.bytesPerPixel == 1) {
 		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 2) {
-		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint16, CodebookConverterColor>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 4) {
-		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint32, CodebookConverterColor>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
 	}
 }
 
@@ -654,6 +733,35 @@ void CinepakDecoder::setDither(DitherType type, const byte *palette) {
 	}
 }
 
+void CinepakDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	// Palettized and dithered output stay as they are
+	if (_bitsPerPixel == 8 || _ditherPalette)
+		return;
+
+	const Graphics::PixelFormat newFormat = (format.bytesPerPixel == 2 || format.bytesPerPixel == 4) ? format : getDefaultPixelFormat();
+	if (newFormat == _pixelFormat)
+		return;
+
+	_pixelFormat = newFormat;
+
+	// Keep the current frame, as the next one may only update parts of it
+	if (_curFrame.surface) {
+		Graphics::Surface *surface = _curFrame.surface->convertTo(_pixelFormat);
+		_curFrame.surface->free();
+		delete _curFrame.surface;
+		_curFrame.surface = surface;
+	}
+
+	if (_curFrame.strips) {
+		for (uint16 i = 0; i < _curFrame.stripCount; i++) {
+			for (uint16 j = 0; j < 256; j++) {
+				convertCodebook(i, 1, j);
+				convertCodebook(i, 4, j);
+			}
+		}
+	}
+}
+
 byte CinepakDecoder::findNearestRGB(int index) const {
 	int r = s_defaultPalette[index * 3];
 	int g = s_defaultPalette[index * 3 + 1];
@@ -47,6 +47,7 @@ struct CinepakStrip {
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
 	byte v1_dither[256 * 4 * 4 * 4], v4_dither[256 * 4 * 4 * 4];
+	uint32 v1_color[256 * 4], v4_color[256 * 4]; // codebooks in the output format
 };
 
 struct CinepakFrame {
@@ -74,6 +75,7 @@ public:
 	~CinepakDecoder();
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
+	const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
 	Graphics::PixelFormat getPixelFormat() const { return _pixelFormat; }
 
 	bool containsPalette() const { return _ditherPalette != 0; }
@@ -81,6 +83,7 @@ public:
 	bool hasDirtyPalette() const { return _dirtyPalette; }
 	bool canDither(DitherType type) const;
 	void setDither(DitherType type, const byte *palette);
+	void setOutputPixelFormat(const Graphics::PixelFormat &format);
 
 private:
 	CinepakFrame _curFrame;
@@ -94,9 +97,13 @@ private:
 	byte *_colorMap;
 	DitherType _ditherType;
 
+	const Graphics::Surface *decode(Common::SeekableReadStream &stream, Graphics::Surface *dst);
+	void decodeStrips(Common::SeekableReadStream &stream);
 	void initializeCodebook(uint16 strip, byte codebookType);
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
+	void convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex);
+	Graphics::PixelFormat getDefaultPixelFormat() const;
 
 	byte findNearestRGB(int index) const;
 	void ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
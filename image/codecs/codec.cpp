@@ -195,6 +195,20 @@ byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	return buf;
 }
 
+Graphics::Surface *Codec::beginDirectDecode(const Graphics::Surface &frame, Graphics::Surface &dst) {
+	if (!dst.getPixels() || dst.format != frame.format || dst.w < frame.w || dst.h < frame.h)
+		return 0;
+
+	_directTarget = dst.getSubArea(Common::Rect(frame.w, frame.h));
+
+	// Codecs build on the previous frame, so bring it along
+	if (_directPixels != _directTarget.getPixels())
+		_directTarget.copyRectToSurface(frame, 0, 0, Common::Rect(frame.w, frame.h));
+
+	_directPixels = _directTarget.getPixels();
+	return &_directTarget;
+}
+
 Codec *createBitmapCodec(uint32 tag, int width, int height, int bitsPerPixel) {
 	switch (tag) {
 	case SWAP_CONSTANT_32(0):
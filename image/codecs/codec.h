@@ -55,7 +55,7 @@ namespace Image {
  */
 class Codec {
 public:
-	Codec() {}
+	Codec() : _directPixels(0) {}
 	virtual ~Codec() {}
 
 	/**
@@ -80,6 +80,23 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) = 0;
 
+	/**
+	 * Decode the frame for the given data straight into the given surface,
+	 * saving the copy from the codec's own surface.
+	 *
+	 * Most codecs only update the parts of a frame which changed, so the
+	 * surface must still hold the previous frame. When it did not receive
+	 * the previous frame, the codec copies it over first. The surface may
+	 * be part of a larger one, like the screen returned by
+	 * OSystem::lockScreen(), and must have the codec's pixel format.
+	 *
+	 * Codecs which cannot decode into the surface decode as usual.
+	 *
+	 * @return a pointer to the decoded frame, which shares its pixels with
+	 *         @p dst when the frame was decoded into it
+	 */
+	virtual const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) { return decodeFrame(stream); }
+
 	/**
 	 * Get the format that the surface returned from decodeImage() will
 	 * be in.
@@ -111,10 +128,39 @@ public:
 	 */
 	virtual void setDither(DitherType type, const byte *palette) {}
 
+	/**
+	 * Request the pixel format of the following decoded frames.
+	 *
+	 * Codecs may ignore this, so check getPixelFormat() afterwards.
+	 * An invalid format requests the native format again.
+	 */
+	virtual void setOutputPixelFormat(const Graphics::PixelFormat &format) {}
+
 	/**
 	 * Create a dither table, as used by QuickTime codecs.
 	 */
 	static byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
+
+protected:
+	/**
+	 * Get the surface to decode into for decodeFrameInto().
+	 *
+	 * If @p dst did not receive the last frame, this copies @p frame, the
+	 * codec's own copy of it, into @p dst.
+	 *
+	 * @return the part of @p dst matching @p frame, or 0 if it does not fit
+	 */
+	Graphics::Surface *beginDirectDecode(const Graphics::Surface &frame, Graphics::Surface &dst);
+
+	/**
+	 * Note that the codec decoded into its own surface again. Codecs which
+	 * use beginDirectDecode() call this from decodeFrame().
+	 */
+	void endDirectDecode() { _directPixels = 0; }
+
+private:
+	Graphics::Surface _directTarget;
+	const void *_directPixels;
 };
 
 /**
@@ -28,6 +28,16 @@
 
 #include "image/codecs/indeo/indeo_dsp.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INDEO_DSP_USE_SSE2
+#define INDEO_DSP_USE_SIMD
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define INDEO_DSP_USE_NEON
+#define INDEO_DSP_USE_SIMD
+#include <arm_neon.h>
+#endif
+
 namespace Image {
 namespace Indeo {
 
@@ -71,8 +81,288 @@ namespace Indeo {
 	d3 = COMPENSATE(t2);\
 	d4 = COMPENSATE(t3); }
 
+#ifdef INDEO_DSP_USE_SIMD
+
+// The vector transforms below run the integer arithmetic of INV_HAAR8 and
+// IVI_INV_SLANT8 on four columns (or, after a transpose, four rows) at once,
+// truncating to int16 just like the scalar stores, so the output is identical.
+
+#ifdef INDEO_DSP_USE_SSE2
+typedef __m128i IviVec;
+
+static inline IviVec vecLoad(const int32 *src) { return _mm_loadu_si128((const __m128i *)src); }
+static inline IviVec vecAdd(IviVec a, IviVec b) { return _mm_add_epi32(a, b); }
+static inline IviVec vecSub(IviVec a, IviVec b) { return _mm_sub_epi32(a, b); }
+static inline IviVec vecShl1(IviVec a) { return _mm_slli_epi32(a, 1); }
+static inline IviVec vecShl2(IviVec a) { return _mm_slli_epi32(a, 2); }
+static inline IviVec vecSar1(IviVec a) { return _mm_srai_epi32(a, 1); }
+static inline IviVec vecSar2(IviVec a) { return _mm_srai_epi32(a, 2); }
+static inline IviVec vecSar3(IviVec a) { return _mm_srai_epi32(a, 3); }
+static inline IviVec vecConst(int32 c) { return _mm_set1_epi32(c); }
+
+/** Zero the lanes whose column flag is 0. */
+static inline IviVec vecMaskColumns(IviVec a, const uint8 *flags) {
+	const __m128i empty = _mm_cmpeq_epi32(_mm_setr_epi32(flags[0], flags[1], flags[2], flags[3]), _mm_setzero_si128());
+	return _mm_andnot_si128(empty, a);
+}
+
+static inline void vecTranspose(IviVec *r) {
+	const __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+	const __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+	const __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+	const __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+	r[0] = _mm_unpacklo_epi64(t0, t1);
+	r[1] = _mm_unpackhi_epi64(t0, t1);
+	r[2] = _mm_unpacklo_epi64(t2, t3);
+	r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/** Store eight values truncated to int16. */
+static inline void vecStoreRow(int16 *out, IviVec lo, IviVec hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	_mm_storeu_si128((__m128i *)out, _mm_packs_epi32(lo, hi));
+}
+
+typedef __m128i IviPixels;
+
+static inline IviPixels pixLoad(const int16 *src) { return _mm_loadu_si128((const __m128i *)src); }
+static inline void pixStore(int16 *dest, IviPixels a) { _mm_storeu_si128((__m128i *)dest, a); }
+static inline IviPixels pixAdd(IviPixels a, IviPixels b) { return _mm_add_epi16(a, b); }
+static inline IviPixels pixHalve(IviPixels a) { return _mm_srai_epi16(a, 1); }
+
+/** (a + b) >> 1 without overflowing 16 bits. */
+static inline IviPixels pixAvg2(IviPixels a, IviPixels b) {
+	const __m128i carry = _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1));
+	return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1), _mm_srai_epi16(b, 1)), carry);
+}
+
+/** (a + b + c + d) >> 2, summed in 32 bits. */
+static inline IviPixels pixAvg4(IviPixels a, IviPixels b, IviPixels c, IviPixels d) {
+	const __m128i lo = _mm_add_epi32(
+		_mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16), _mm_srai_epi32(_mm_unpacklo_epi16(b, b), 16)),
+		_mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(c, c), 16), _mm_srai_epi32(_mm_unpacklo_epi16(d, d), 16)));
+	const __m128i hi = _mm_add_epi32(
+		_mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16), _mm_srai_epi32(_mm_unpackhi_epi16(b, b), 16)),
+		_mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(c, c), 16), _mm_srai_epi32(_mm_unpackhi_epi16(d, d), 16)));
+	return _mm_packs_epi32(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+}
+#else
+typedef int32x4_t IviVec;
+
+static inline IviVec vecLoad(const int32 *src) { return vld1q_s32(src); }
+static inline IviVec vecAdd(IviVec a, IviVec b) { return vaddq_s32(a, b); }
+static inline IviVec vecSub(IviVec a, IviVec b) { return vsubq_s32(a, b); }
+static inline IviVec vecShl1(IviVec a) { return vshlq_n_s32(a, 1); }
+static inline IviVec vecShl2(IviVec a) { return vshlq_n_s32(a, 2); }
+static inline IviVec vecSar1(IviVec a) { return vshrq_n_s32(a, 1); }
+static inline IviVec vecSar2(IviVec a) { return vshrq_n_s32(a, 2); }
+static inline IviVec vecSar3(IviVec a) { return vshrq_n_s32(a, 3); }
+static inline IviVec vecConst(int32 c) { return vdupq_n_s32(c); }
+
+/** Zero the lanes whose column flag is 0. */
+static inline IviVec vecMaskColumns(IviVec a, const uint8 *flags) {
+	const uint32 f[4] = { flags[0], flags[1], flags[2], flags[3] };
+	return vreinterpretq_s32_u32(vandq_u32(vreinterpretq_u32_s32(a), vtstq_u32(vld1q_u32(f), vdupq_n_u32(0xFF))));
+}
+
+static inline void vecTranspose(IviVec *r) {
+	const int32x4x2_t t0 = vtrnq_s32(r[0], r[1]);
+	const int32x4x2_t t1 = vtrnq_s32(r[2], r[3]);
+	r[0] = vcombine_s32(vget_low_s32(t0.val[0]), vget_low_s32(t1.val[0]));
+	r[1] = vcombine_s32(vget_low_s32(t0.val[1]), vget_low_s32(t1.val[1]));
+	r[2] = vcombine_s32(vget_high_s32(t0.val[0]), vget_high_s32(t1.val[0]));
+	r[3] = vcombine_s32(vget_high_s32(t0.val[1]), vget_high_s32(t1.val[1]));
+}
+
+/** Store eight values truncated to int16. */
+static inline void vecStoreRow(int16 *out, IviVec lo, IviVec hi) {
+	vst1q_s16(out, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+}
+
+typedef int16x8_t IviPixels;
+
+static inline IviPixels pixLoad(const int16 *src) { return vld1q_s16(src); }
+static inline void pixStore(int16 *dest, IviPixels a) { vst1q_s16(dest, a); }
+static inline IviPixels pixAdd(IviPixels a, IviPixels b) { return vaddq_s16(a, b); }
+static inline IviPixels pixHalve(IviPixels a) { return vshrq_n_s16(a, 1); }
+
+/** (a + b) >> 1 without overflowing 16 bits. */
+static inline IviPixels pixAvg2(IviPixels a, IviPixels b) { return vhaddq_s16(a, b); }
+
+/** (a + b + c + d) >> 2, summed in 32 bits. */
+static inline IviPixels pixAvg4(IviPixels a, IviPixels b, IviPixels c, IviPixels d) {
+	const int32x4_t lo = vaddq_s32(vaddl_s16(vget_low_s16(a), vget_low_s16(b)), vaddl_s16(vget_low_s16(c), vget_low_s16(d)));
+	const int32x4_t hi = vaddq_s32(vaddl_s16(vget_high_s16(a), vget_high_s16(b)), vaddl_s16(vget_high_s16(c), vget_high_s16(d)));
+	return vcombine_s16(vshrn_n_s32(lo, 2), vshrn_n_s32(hi, 2));
+}
+#endif
+
+/** INV_HAAR8 on eight vectors. */
+struct VecHaar8 {
+	static inline void apply(IviVec *d, const IviVec *s) {
+		// IVI_HAAR_BFLY(t1, t5, ...) on the pre-doubled s1 and s5
+		const IviVec t1a = vecShl1(s[0]), t5a = vecShl1(s[1]);
+		const IviVec t1b = vecSar1(vecAdd(t1a, t5a)), t5b = vecSar1(vecSub(t1a, t5a));
+		const IviVec t1 = vecSar1(vecAdd(t1b, s[2])), t3 = vecSar1(vecSub(t1b, s[2]));
+		const IviVec t5 = vecSar1(vecAdd(t5b, s[3])), t7 = vecSar1(vecSub(t5b, s[3]));
+		d[0] = vecSar1(vecAdd(t1, s[4]));
+		d[1] = vecSar1(vecSub(t1, s[4]));
+		d[2] = vecSar1(vecAdd(t3, s[5]));
+		d[3] = vecSar1(vecSub(t3, s[5]));
+		d[4] = vecSar1(vecAdd(t5, s[6]));
+		d[5] = vecSar1(vecSub(t5, s[6]));
+		d[6] = vecSar1(vecAdd(t7, s[7]));
+		d[7] = vecSar1(vecSub(t7, s[7]));
+	}
+};
+
+/** IVI_INV_SLANT8 on eight vectors, given in the order of the macro's arguments. */
+struct VecSlant8 {
+	static inline void apply(IviVec *d, const IviVec *s) {
+		const IviVec s1 = s[0], s4 = s[1], s8 = s[2], s5 = s[3];
+		const IviVec s2 = s[4], s6 = s[5], s3 = s[6], s7 = s[7];
+		const IviVec two = vecConst(2), four = vecConst(4);
+
+		// IVI_SLANT_PART4(s4, s5, t4, t5)
+		IviVec t4 = vecAdd(s5, vecSar3(vecAdd(vecSub(vecShl2(s4), s5), four)));
+		IviVec t5 = vecAdd(s4, vecSar3(vecAdd(vecSub(vecSub(vecConst(0), s4), vecShl2(s5)), four)));
+
+		IviVec t1 = vecAdd(s1, t5);
+		t5 = vecSub(s1, t5);
+		IviVec t2 = vecAdd(s2, s6), t6 = vecSub(s2, s6);
+		IviVec t7 = vecAdd(s7, s3), t3 = vecSub(s7, s3);
+		IviVec t8 = vecSub(t4, s8);
+		t4 = vecAdd(t4, s8);
+
+		IviVec t;
+		t = vecSub(t1, t2); t1 = vecAdd(t1, t2); t2 = t;
+		// IVI_IREFLECT(t4, t3, t4, t3)
+		t = vecAdd(vecSar2(vecAdd(vecAdd(t4, vecShl1(t3)), two)), t4);
+		t3 = vecSub(vecSar2(vecAdd(vecSub(vecShl1(t4), t3), two)), t3);
+		t4 = t;
+		t = vecSub(t5, t6); t5 = vecAdd(t5, t6); t6 = t;
+		// IVI_IREFLECT(t8, t7, t8, t7)
+		t = vecAdd(vecSar2(vecAdd(vecAdd(t8, vecShl1(t7)), two)), t8);
+		t7 = vecSub(vecSar2(vecAdd(vecSub(vecShl1(t8), t7), two)), t7);
+		t8 = t;
+
+		d[0] = vecAdd(t1, t4); d[3] = vecSub(t1, t4);
+		d[1] = vecAdd(t2, t3); d[2] = vecSub(t2, t3);
+		d[4] = vecAdd(t5, t8); d[7] = vecSub(t5, t8);
+		d[5] = vecAdd(t6, t7); d[6] = vecSub(t6, t7);
+	}
+};
+
+/** COMPENSATE(x) ((x + 1) >> 1) of the slant transforms. */
+static inline void vecRound(IviVec *d) {
+	const IviVec one = vecConst(1);
+	for (int i = 0; i < 8; i++)
+		d[i] = vecSar1(vecAdd(d[i], one));
+}
+
+/**
+ * Transform the columns of an 8x8 block, leaving row i in rows[2 * i] (left
+ * half) and rows[2 * i + 1] (right half). Empty columns are set to zero.
+ */
+template<class TRANSFORM, bool ROUND, bool PRESCALE>
+static void vecColumns8(const int32 *in, IviVec *rows, const uint8 *flags) {
+	IviVec s[8], d[8];
+
+	for (int half = 0; half < 2; half++) {
+		for (int i = 0; i < 8; i++)
+			s[i] = vecLoad(in + 8 * i + 4 * half);
+
+		// The Haar pre-scaling doubles the first four rows of the left half
+		if (PRESCALE && half == 0) {
+			for (int i = 0; i < 4; i++)
+				s[i] = vecShl1(s[i]);
+		}
+
+		TRANSFORM::apply(d, s);
+		if (ROUND)
+			vecRound(d);
+
+		for (int i = 0; i < 8; i++)
+			rows[2 * i + half] = vecMaskColumns(d[i], flags + 4 * half);
+	}
+}
+
+/** Transform the rows of an 8x8 block laid out as by vecColumns8(). */
+template<class TRANSFORM, bool ROUND>
+static void vecRows8(const IviVec *rows, int16 *out, uint32 pitch) {
+	IviVec s[8], d[8];
+
+	for (int group = 0; group < 2; group++) {
+		// Turn four rows into eight column vectors
+		for (int half = 0; half < 2; half++) {
+			for (int i = 0; i < 4; i++)
+				s[4 * half + i] = rows[2 * (4 * group + i) + half];
+			vecTranspose(&s[4 * half]);
+		}
+
+		TRANSFORM::apply(d, s);
+		if (ROUND)
+			vecRound(d);
+
+		vecTranspose(&d[0]);
+		vecTranspose(&d[4]);
+		for (int i = 0; i < 4; i++)
+			vecStoreRow(out + (4 * group + i) * pitch, d[i], d[4 + i]);
+	}
+}
+
+static inline void vecLoadRows8(const int32 *in, IviVec *rows) {
+	for (int i = 0; i < 16; i++)
+		rows[i] = vecLoad(in + 4 * i);
+}
+
+static inline void vecStoreRows8(const IviVec *rows, int16 *out, uint32 pitch) {
+	for (int i = 0; i < 8; i++, out += pitch)
+		vecStoreRow(out, rows[2 * i], rows[2 * i + 1]);
+}
+
+/** One row of the 8x8 motion compensation prediction, see IVI_MC_TEMPLATE. */
+static inline IviPixels pixPredict8(const int16 *refBuf, uint32 pitch, int mcType) {
+	switch (mcType) {
+	case 0: // fullpel (no interpolation)
+		return pixLoad(refBuf);
+	case 1: // horizontal halfpel interpolation
+		return pixAvg2(pixLoad(refBuf), pixLoad(refBuf + 1));
+	case 2: // vertical halfpel interpolation
+		return pixAvg2(pixLoad(refBuf), pixLoad(refBuf + pitch));
+	default: // vertical and horizontal halfpel interpolation
+		return pixAvg4(pixLoad(refBuf), pixLoad(refBuf + 1), pixLoad(refBuf + pitch), pixLoad(refBuf + pitch + 1));
+	}
+}
+
+template<bool DELTA>
+static void pixMc8x8(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	for (int i = 0; i < 8; i++, buf += pitch, refBuf += pitch) {
+		const IviPixels pred = pixPredict8(refBuf, pitch, mcType);
+		pixStore(buf, DELTA ? pixAdd(pixLoad(buf), pred) : pred);
+	}
+}
+
+template<bool DELTA>
+static void pixMcAvg8x8(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2) {
+	for (int i = 0; i < 8; i++, buf += pitch, refBuf += pitch, refBuf2 += pitch) {
+		const IviPixels pred = pixHalve(pixAdd(pixPredict8(refBuf, pitch, mcType), pixPredict8(refBuf2, pitch, mcType2)));
+		pixStore(buf, DELTA ? pixAdd(pixLoad(buf), pred) : pred);
+	}
+}
+
+#endif // INDEO_DSP_USE_SIMD
+
 void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 							 const uint8 *flags) {
+#ifdef INDEO_DSP_USE_SIMD
+	IviVec rows[16];
+
+	// apply the InvHaar8 to all columns, then to all rows
+	vecColumns8<VecHaar8, false, true>(in, rows, flags);
+	vecRows8<VecHaar8, false>(rows, out, pitch);
+#else
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -121,10 +411,18 @@ void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviRowHaar8(const int32 *in, int16 *out, uint32 pitch,
 					  const uint8 *flags) {
+#ifdef INDEO_DSP_USE_SIMD
+	IviVec rows[16];
+
+	// apply the InvHaar8 to all rows
+	vecLoadRows8(in, rows);
+	vecRows8<VecHaar8, false>(rows, out, pitch);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 	// apply the InvHaar8 to all rows
@@ -144,10 +442,18 @@ void IndeoDSP::ffIviRowHaar8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviColHaar8(const int32 *in, int16 *out, uint32 pitch,
 					  const uint8 *flags) {
+#ifdef INDEO_DSP_USE_SIMD
+	IviVec rows[16];
+
+	// apply the InvHaar8 to all columns
+	vecColumns8<VecHaar8, false, false>(in, rows, flags);
+	vecStoreRows8(rows, out, pitch);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 	// apply the InvHaar8 to all columns
@@ -172,6 +478,7 @@ void IndeoDSP::ffIviColHaar8(const int32 *in, int16 *out, uint32 pitch,
 		out++;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviInverseHaar4x4(const int32 *in, int16 *out, uint32 pitch,
@@ -322,6 +629,12 @@ void IndeoDSP::ffIviDcHaar2d(const int32 *in, int16 *out, uint32 pitch,
 	d4 = COMPENSATE(t4);}
 
 void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+#ifdef INDEO_DSP_USE_SIMD
+	IviVec rows[16];
+
+	vecColumns8<VecSlant8, false, false>(in, rows, flags);
+	vecRows8<VecSlant8, true>(rows, out, pitch);
+#else
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -356,6 +669,7 @@ void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, c
 		out += pitch;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviInverseSlant4x4(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
@@ -406,6 +720,12 @@ void IndeoDSP::ffIviDcSlant2d(const int32 *in, int16 *out, uint32 pitch,
 
 void IndeoDSP::ffIviRowSlant8(const int32 *in, int16 *out, uint32 pitch,
 		const uint8 *flags) {
+#ifdef INDEO_DSP_USE_SIMD
+	IviVec rows[16];
+
+	vecLoadRows8(in, rows);
+	vecRows8<VecSlant8, true>(rows, out, pitch);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 #define COMPENSATE(x) (((x) + 1)>>1)
@@ -421,6 +741,7 @@ void IndeoDSP::ffIviRowSlant8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviDcRowSlant(const int32 *in, int16 *out, uint32 pitch, int blkSize) {
@@ -438,6 +759,12 @@ void IndeoDSP::ffIviDcRowSlant(const int32 *in, int16 *out, uint32 pitch, int bl
 }
 
 void IndeoDSP::ffIviColSlant8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+#ifdef INDEO_DSP_USE_SIMD
+	IviVec rows[16];
+
+	vecColumns8<VecSlant8, true, false>(in, rows, flags);
+	vecStoreRows8(rows, out, pitch);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 	int row2 = pitch << 1;
@@ -460,6 +787,7 @@ void IndeoDSP::ffIviColSlant8(const int32 *in, int16 *out, uint32 pitch, const u
 		out++;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviDcColSlant(const int32 *in, int16 *out, uint32 pitch, int blkSize) {
@@ -564,16 +892,10 @@ static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 				OP(buf[j], (refBuf[j] + refBuf[j+1] + wptr[j] + wptr[j+1]) >> 2); \
 		break; \
 	} \
-} \
-\
-void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
-											 uint32 pitch, int mcType) \
-{ \
-	iviMc ## size ##x## size ## suffix(buf, pitch, refBuf, pitch, mcType); \
 }
 
 #define IVI_MC_AVG_TEMPLATE(size, suffix, OP) \
-void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
+static void iviMcAvg ## size ##x## size ## suffix(int16 *buf, \
 												 const int16 *refBuf, \
 												 const int16 *refBuf2, \
 												 uint32 pitch, \
@@ -602,5 +924,53 @@ IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
 
+#define IVI_MC_ENTRY(size, suffix) \
+void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
+											 uint32 pitch, int mcType) \
+{ \
+	iviMc ## size ##x## size ## suffix(buf, pitch, refBuf, pitch, mcType); \
+} \
+\
+void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
+												 const int16 *refBuf, \
+												 const int16 *refBuf2, \
+												 uint32 pitch, \
+											   int mcType, int mcType2) \
+{ \
+	iviMcAvg ## size ##x## size ## suffix(buf, refBuf, refBuf2, pitch, mcType, mcType2); \
+}
+
+#ifdef INDEO_DSP_USE_SIMD
+// The vector versions only know the four interpolation modes; anything else
+// keeps the behavior of the scalar code.
+#define IVI_MC_SIMD_ENTRY(suffix, delta) \
+void IndeoDSP::ffIviMc8x8 ## suffix(int16 *buf, const int16 *refBuf, \
+									uint32 pitch, int mcType) \
+{ \
+	if (mcType >= 0 && mcType <= 3) \
+		pixMc8x8<delta>(buf, refBuf, pitch, mcType); \
+	else \
+		iviMc8x8 ## suffix(buf, pitch, refBuf, pitch, mcType); \
+} \
+\
+void IndeoDSP::ffIviMcAvg8x8 ## suffix(int16 *buf, const int16 *refBuf, \
+									   const int16 *refBuf2, uint32 pitch, \
+									   int mcType, int mcType2) \
+{ \
+	if (mcType >= 0 && mcType <= 3 && mcType2 >= 0 && mcType2 <= 3) \
+		pixMcAvg8x8<delta>(buf, refBuf, refBuf2, pitch, mcType, mcType2); \
+	else \
+		iviMcAvg8x8 ## suffix(buf, refBuf, refBuf2, pitch, mcType, mcType2); \
+}
+
+IVI_MC_SIMD_ENTRY(NoDelta, false)
+IVI_MC_SIMD_ENTRY(Delta,   true)
+#else
+IVI_MC_ENTRY(8, NoDelta)
+IVI_MC_ENTRY(8, Delta)
+#endif
+IVI_MC_ENTRY(4, NoDelta)
+IVI_MC_ENTRY(4, Delta)
+
 } // End of namespace Indeo
 } // End of namespace Image
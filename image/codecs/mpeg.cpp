@@ -109,4 +109,8 @@ bool MPEGDecoder::decodePacket(Common::SeekableReadStream &packet, uint32 &frame
 	return foundFrame;
 }
 
+void MPEGDecoder::reset() {
+	mpeg2_reset(_mpegDecoder, 0);
+}
+
 } // End of namespace Image
@@ -60,6 +60,12 @@ public:
 	// MPEGPSDecoder call
 	bool decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst = 0);
 
+	/**
+	 * Drop any buffered data, so that decoding can continue from the next
+	 * GOP after a seek. The sequence header is kept.
+	 */
+	void reset();
+
 private:
 	Graphics::PixelFormat _pixelFormat;
 	Graphics::Surface *_surface;
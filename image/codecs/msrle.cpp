@@ -40,25 +40,40 @@ MSRLEDecoder::~MSRLEDecoder() {
 }
 
 const Graphics::Surface *MSRLEDecoder::decodeFrame(Common::SeekableReadStream &stream) {
+	endDirectDecode();
+	decode(stream, *_surface);
+	return _surface;
+}
+
+const Graphics::Surface *MSRLEDecoder::decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	Graphics::Surface *target = beginDirectDecode(*_surface, dst);
+	if (!target)
+		return decodeFrame(stream);
+
+	decode(stream, *target);
+	return target;
+}
+
+void MSRLEDecoder::decode(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
 	if (_bitsPerPixel == 8) {
-		decode8(stream);
+		decode8(stream, surface);
 	} else
 		error("Unhandled %d bit Microsoft RLE encoding", _bitsPerPixel);
-
-	return _surface;
 }
 
-void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
+void MSRLEDecoder::decode8(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
 
 	int x = 0;
-	int y = _surface->h - 1;
+	int y = surface.h - 1;
 
-	byte *data = (byte *) _surface->getPixels();
-	uint16 width  = _surface->w;
-	uint16 height = _surface->h;
+	byte *data = (byte *)surface.getPixels();
+	uint16 width  = surface.w;
+	uint16 height = surface.h;
 
-	byte *output     = data + ((height - 1) * width);
-	byte *output_end = data + ((height)     * width);
+	// The output position counts pixels as if the rows were packed, and
+	// runs which go past the end of a row continue on the next one
+	int output     = (height - 1) * width;
+	int output_end = height * width;
 
 	while (!stream.eos()) {
 		byte count = stream.readByte();
@@ -70,7 +85,7 @@ void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
 
 				x = 0;
 				y--;
-				output = data + (y * width);
+				output = y * width;
 
 			} else if (value == 1) {
 				// End of image
@@ -90,7 +105,7 @@ void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
 					return;
 				}
 
-				output = data + ((y * width) + x);
+				output = (y * width) + x;
 
 			} else {
 				// Copy data
@@ -107,8 +122,16 @@ void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
 					continue;
 				}
 
-				for (int i = 0; i < value; i++)
-					*output++ = stream.readByte();
+				byte *row = data + (output / width) * surface.pitch;
+				int col = output % width;
+				for (int i = 0; i < value; i++) {
+					row[col] = stream.readByte();
+					if (++col == width) {
+						col = 0;
+						row += surface.pitch;
+					}
+				}
+				output += value;
 
 				if (value & 1)
 					stream.skip(1);
@@ -126,8 +149,16 @@ void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
 			if (output + count > output_end)
 				continue;
 
-			for (int i = 0; i < count; i++, x++)
-				*output++ = value;
+			byte *row = data + (output / width) * surface.pitch;
+			int col = output % width;
+			for (int i = 0; i < count; i++, x++) {
+				row[col] = value;
+				if (++col == width) {
+					col = 0;
+					row += surface.pitch;
+				}
+			}
+			output += count;
 		}
 
 	}
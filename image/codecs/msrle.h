@@ -38,6 +38,7 @@ public:
 	~MSRLEDecoder();
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
+	const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
 	Graphics::PixelFormat getPixelFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
 
 private:
@@ -45,7 +46,8 @@ private:
 
 	Graphics::Surface *_surface;
 
-	void decode8(Common::SeekableReadStream &stream);
+	void decode(Common::SeekableReadStream &stream, Graphics::Surface &surface);
+	void decode8(Common::SeekableReadStream &stream, Graphics::Surface &surface);
 };
 
 } // End of namespace Image
@@ -47,14 +47,14 @@ MSVideo1Decoder::~MSVideo1Decoder() {
 	delete _surface;
 }
 
-void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
+void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
     byte colors[8];
-    byte *pixels = (byte *)_surface->getPixels();
-    uint16 stride = _surface->w;
+    byte *pixels = (byte *)surface.getPixels();
+    uint16 stride = surface.pitch;
 
     int skipBlocks = 0;
-    uint16 blocks_wide = _surface->w / 4;
-    uint16 blocks_high = _surface->h / 4;
+    uint16 blocks_wide = surface.w / 4;
+    uint16 blocks_high = surface.h / 4;
     uint32 totalBlocks = blocks_wide * blocks_high;
     uint32 blockInc = 4;
     uint16 rowDec = stride + 4;
@@ -126,15 +126,15 @@ void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
     }
 }
 
-void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
+void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
     /* decoding parameters */
     uint16 colors[8];
-    uint16 *pixels = (uint16 *)_surface->getPixels();
-    int32 stride = _surface->w;
+    uint16 *pixels = (uint16 *)surface.getPixels();
+    int32 stride = surface.pitch / 2;
 
     int32 skip_blocks = 0;
-    int32 blocks_wide = _surface->w / 4;
-    int32 blocks_high = _surface->h / 4;
+    int32 blocks_wide = surface.w / 4;
+    int32 blocks_high = surface.h / 4;
     int32 total_blocks = blocks_wide * blocks_high;
     int32 block_inc = 4;
     int32 row_dec = stride + 4;
@@ -214,12 +214,25 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 }
 
 const Graphics::Surface *MSVideo1Decoder::decodeFrame(Common::SeekableReadStream &stream) {
+	endDirectDecode();
+	decode(stream, *_surface);
+	return _surface;
+}
+
+const Graphics::Surface *MSVideo1Decoder::decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	Graphics::Surface *target = beginDirectDecode(*_surface, dst);
+	if (!target)
+		return decodeFrame(stream);
+
+	decode(stream, *target);
+	return target;
+}
+
+void MSVideo1Decoder::decode(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
 	if (_bitsPerPixel == 8)
-		decode8(stream);
+		decode8(stream, surface);
 	else
-        decode16(stream);
-
-    return _surface;
+		decode16(stream, surface);
 }
 
 } // End of namespace Image
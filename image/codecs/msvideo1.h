@@ -38,6 +38,7 @@ public:
 	~MSVideo1Decoder();
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
+	const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
 	Graphics::PixelFormat getPixelFormat() const { return _surface->format; }
 
 private:
@@ -45,8 +46,9 @@ private:
 
 	Graphics::Surface *_surface;
 
-	void decode8(Common::SeekableReadStream &stream);
-	void decode16(Common::SeekableReadStream &stream);
+	void decode(Common::SeekableReadStream &stream, Graphics::Surface &surface);
+	void decode8(Common::SeekableReadStream &stream, Graphics::Surface &surface);
+	void decode16(Common::SeekableReadStream &stream, Graphics::Surface &surface);
 };
 
 } // End of namespace Image
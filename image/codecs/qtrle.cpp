@@ -49,6 +49,8 @@ QTRLEDecoder::QTRLEDecoder(uint16 width, uint16 height, byte bitsPerPixel) : Cod
 	uint16 wMod = width % 4;
 	if (wMod != 0)
 		_paddedWidth += 4 - wMod;
+
+	_stride = _paddedWidth;
 }
 
 QTRLEDecoder::~QTRLEDecoder() {
@@ -71,8 +73,8 @@ QTRLEDecoder::~QTRLEDecoder() {
 
 #define CHECK_PIXEL_PTR(n) \
 	do { \
-		if ((int32)pixelPtr + n > (int)_paddedWidth * _surface->h) { \
-			warning("QTRLE Problem: pixel ptr = %d, pixel limit = %d", pixelPtr + n, _paddedWidth * _surface->h); \
+		if ((int32)pixelPtr + n > (int)(_stride * (_surface->h - 1) + _paddedWidth)) { \
+			warning("QTRLE Problem: pixel ptr = %d, pixel limit = %d", pixelPtr + n, _stride * (_surface->h - 1) + _paddedWidth); \
 			return; \
 		} \
 	} while (0)
@@ -91,7 +93,7 @@ void QTRLEDecoder::decode1(Common::SeekableReadStream &stream, uint32 rowPtr, ui
 
 		if (skip & 0x80) {
 			linesToChange--;
-			rowPtr += _paddedWidth;
+			rowPtr += _stride;
 			pixelPtr = rowPtr + 2 * (skip & 0x7f);
 		} else
 			pixelPtr += 2 * skip;
@@ -177,7 +179,7 @@ void QTRLEDecoder::decode2_4(Common::SeekableReadStream &stream, uint32 rowPtr,
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -222,7 +224,7 @@ void QTRLEDecoder::decode8(Common::SeekableReadStream &stream, uint32 rowPtr, ui
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -260,7 +262,7 @@ void QTRLEDecoder::decode16(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -306,7 +308,7 @@ void QTRLEDecoder::decode24(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -370,7 +372,7 @@ void QTRLEDecoder::dither24(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 		curColorTableOffset = (curColorTableOffset + 1) & 3;
 	}
 }
@@ -419,7 +421,7 @@ void QTRLEDecoder::decode32(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -427,12 +429,41 @@ const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &s
 	if (!_surface)
 		createSurface();
 
+	endDirectDecode();
+	decode(stream);
+	return _surface;
+}
+
+const Graphics::Surface *QTRLEDecoder::decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	if (!_surface)
+		createSurface();
+
+	// Rows are decoded in groups of pixels, which may cover the padding
+	Graphics::Surface padded = *_surface;
+	padded.w = _paddedWidth;
+
+	Graphics::Surface *target = beginDirectDecode(padded, dst);
+	if (!target)
+		return decodeFrame(stream);
+
+	Graphics::Surface *surface = _surface;
+	_surface = target;
+	_stride = target->pitch / target->format.bytesPerPixel;
+	decode(stream);
+	_surface = surface;
+	_stride = _paddedWidth;
+
+	target->w = _width;
+	return target;
+}
+
+void QTRLEDecoder::decode(Common::SeekableReadStream &stream) {
 	uint16 startLine = 0;
 	uint16 height = _height;
 
 	// check if this frame is even supposed to change
 	if (stream.size() < 8)
-		return _surface;
+		return;
 
 	// start after the chunk size
 	stream.readUint32BE();
@@ -443,7 +474,7 @@ const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &s
 	// if a header is present, fetch additional decoding parameters
 	if (header & 8) {
 		if (stream.size() < 14)
-			return _surface;
+			return;
 
 		startLine = stream.readUint16BE();
 		stream.readUint16BE(); // Unknown
@@ -451,7 +482,7 @@ const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &s
 		stream.readUint16BE(); // Unknown
 	}
 
-	uint32 rowPtr = _paddedWidth * startLine;
+	uint32 rowPtr = _stride * startLine;
 
 	switch (_bitsPerPixel) {
 	case 1:
@@ -485,8 +516,6 @@ const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &s
 	default:
 		error("Unsupported QTRLE bits per pixel %d", _bitsPerPixel);
 	}
-
-	return _surface;
 }
 
 Graphics::PixelFormat QTRLEDecoder::getPixelFormat() const {
@@ -39,6 +39,7 @@ public:
 	~QTRLEDecoder();
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
+	const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
 	Graphics::PixelFormat getPixelFormat() const;
 
 	bool containsPalette() const { return _ditherPalette != 0; }
@@ -52,11 +53,13 @@ private:
 	Graphics::Surface *_surface;
 	uint16 _width, _height;
 	uint32 _paddedWidth;
+	uint32 _stride; ///< Pixels between rows of the surface being decoded into
 	byte *_ditherPalette;
 	bool _dirtyPalette;
 	byte *_colorMap;
 
 	void createSurface();
+	void decode(Common::SeekableReadStream &stream);
 
 	void decode1(Common::SeekableReadStream &stream, uint32 rowPtr, uint32 linesToChange);
 	void decode2_4(Common::SeekableReadStream &stream, uint32 rowPtr, uint32 linesToChange, byte bpp);
@@ -328,6 +328,31 @@ static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt
 }
 
 const Graphics::Surface *RPZADecoder::decodeFrame(Common::SeekableReadStream &stream) {
+	createSurface();
+	endDirectDecode();
+	decode(stream, *_surface);
+	return _surface;
+}
+
+const Graphics::Surface *RPZADecoder::decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	createSurface();
+
+	// The blocks cover the padding as well
+	Graphics::Surface blocks = *_surface;
+	blocks.w = _blockWidth * 4;
+	blocks.h = _blockHeight * 4;
+
+	Graphics::Surface *target = beginDirectDecode(blocks, dst);
+	if (!target)
+		return decodeFrame(stream);
+
+	decode(stream, *target);
+	target->w = _width;
+	target->h = _height;
+	return target;
+}
+
+void RPZADecoder::createSurface() {
 	if (!_surface) {
 		_surface = new Graphics::Surface();
 
@@ -338,13 +363,13 @@ const Graphics::Surface *RPZADecoder::decodeFrame(Common::SeekableReadStream &st
 		_surface->w = _width;
 		_surface->h = _height;
 	}
+}
 
+void RPZADecoder::decode(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
 	if (_colorMap)
-		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)_surface->getPixels(), _surface->pitch, _blockWidth, _blockHeight, _colorMap);
+		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)surface.getPixels(), surface.pitch, _blockWidth, _blockHeight, _colorMap);
 	else
-		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, _colorMap);
-
-	return _surface;
+		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)surface.getPixels(), surface.pitch / 2, _blockWidth, _blockHeight, _colorMap);
 }
 
 bool RPZADecoder::canDither(DitherType type) const {
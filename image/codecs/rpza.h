@@ -39,6 +39,7 @@ public:
 	~RPZADecoder();
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
+	const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
 	Graphics::PixelFormat getPixelFormat() const { return _format; }
 
 	bool containsPalette() const { return _ditherPalette != 0; }
@@ -55,6 +56,9 @@ private:
 	byte *_colorMap;
 	uint16 _width, _height;
 	uint16 _blockWidth, _blockHeight;
+
+	void createSurface();
+	void decode(Common::SeekableReadStream &stream, Graphics::Surface &surface);
 };
 
 } // End of namespace Image
@@ -34,14 +34,14 @@ namespace Image {
 #define ADVANCE_BLOCK() \
 { \
 	pixelPtr += 4; \
-	if (pixelPtr >= _surface->w) { \
+	if (pixelPtr >= surface.w) { \
 		pixelPtr = 0; \
-		rowPtr += _surface->w * 4; \
+		rowPtr += stride * 4; \
 	} \
 	totalBlocks--; \
 	if (totalBlocks < 0) { \
 		warning("block counter just went negative (this should not happen)"); \
-		return _surface; \
+		return; \
 	} \
 }
 
@@ -56,14 +56,31 @@ SMCDecoder::~SMCDecoder() {
 }
 
 const Graphics::Surface *SMCDecoder::decodeFrame(Common::SeekableReadStream &stream) {
-	byte *pixels = (byte *)_surface->getPixels();
+	endDirectDecode();
+	decode(stream, *_surface);
+	return _surface;
+}
+
+const Graphics::Surface *SMCDecoder::decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	// Partial blocks would write past the edges of the frame
+	Graphics::Surface *target = (_surface->w % 4 || _surface->h % 4) ? 0 : beginDirectDecode(*_surface, dst);
+	if (!target)
+		return decodeFrame(stream);
+
+	decode(stream, *target);
+	return target;
+}
+
+void SMCDecoder::decode(Common::SeekableReadStream &stream, Graphics::Surface &surface) {
+	byte *pixels = (byte *)surface.getPixels();
+	const int32 stride = surface.pitch;
 
 	uint32 numBlocks = 0;
 	uint32 colorFlags = 0;
 	uint32 colorFlagsA = 0;
 	uint32 colorFlagsB = 0;
 
-	const uint16 rowInc = _surface->w - 4;
+	const uint16 rowInc = stride - 4;
 	int32 rowPtr = 0;
 	int32 pixelPtr = 0;
 	uint32 blockPtr = 0;
@@ -81,7 +98,7 @@ const Graphics::Surface *SMCDecoder::decodeFrame(Common::SeekableReadStream &str
 	if (chunkSize != stream.size())
 		warning("MOV chunk size != SMC chunk size (%d != %d); ignoring SMC chunk size", chunkSize, stream.size());
 
-	int32 totalBlocks = ((_surface->w + 3) / 4) * ((_surface->h + 3) / 4);
+	int32 totalBlocks = ((surface.w + 3) / 4) * ((surface.h + 3) / 4);
 
 	// traverse through the blocks
 	while (totalBlocks != 0) {
@@ -90,13 +107,13 @@ const Graphics::Surface *SMCDecoder::decodeFrame(Common::SeekableReadStream &str
 		// make sure stream ptr hasn't gone out of bounds
 		if (stream.pos() > stream.size()) {
 			warning("SMC decoder just went out of bounds (stream ptr = %d, chunk size = %d)", stream.pos(), stream.size());
-			return _surface;
+			return;
 		}
 
 		// make sure the row pointer hasn't gone wild
-		if (rowPtr >= _surface->w * _surface->h) {
-			warning("SMC decoder just went out of bounds (row ptr = %d, size = %d)", rowPtr, _surface->w * _surface->h);
-			return _surface;
+		if (rowPtr >= stride * surface.h) {
+			warning("SMC decoder just went out of bounds (row ptr = %d, size = %d)", rowPtr, stride * surface.h);
+			return;
 		}
 
 		byte opcode = stream.readByte();
@@ -124,7 +141,7 @@ const Graphics::Surface *SMCDecoder::decodeFrame(Common::SeekableReadStream &str
 
 			// figure out where the previous block started
 			if (pixelPtr == 0)
-				prevBlockPtr1 = (rowPtr - _surface->w * 4) + _surface->w - 4;
+				prevBlockPtr1 = (rowPtr - stride * 4) + surface.w - 4;
 			else
 				prevBlockPtr1 = rowPtr + pixelPtr - 4;
 
@@ -155,14 +172,14 @@ const Graphics::Surface *SMCDecoder::decodeFrame(Common::SeekableReadStream &str
 
 			// figure out where the previous 2 blocks started
 			if (pixelPtr == 0)
-				prevBlockPtr1 = (rowPtr - _surface->w * 4) + _surface->w - 4 * 2;
+				prevBlockPtr1 = (rowPtr - stride * 4) + surface.w - 4 * 2;
 			else if (pixelPtr == 4)
-				prevBlockPtr1 = (rowPtr - _surface->w * 4) + rowInc;
+				prevBlockPtr1 = (rowPtr - stride * 4) + surface.w - 4;
 			else
 				prevBlockPtr1 = rowPtr + pixelPtr - 4 * 2;
 
 			if (pixelPtr == 0)
-				prevBlockPtr2 = (rowPtr - _surface->w * 4) + rowInc;
+				prevBlockPtr2 = (rowPtr - stride * 4) + surface.w - 4;
 			else
 				prevBlockPtr2 = rowPtr + pixelPtr - 4;
 
@@ -382,8 +399,6 @@ const Graphics::Surface *SMCDecoder::decodeFrame(Common::SeekableReadStream &str
 			break;
 		}
 	}
-
-	return _surface;
 }
 
 } // End of namespace Image
@@ -45,11 +45,14 @@ public:
 	~SMCDecoder();
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
+	const Graphics::Surface *decodeFrameInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
 	Graphics::PixelFormat getPixelFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
 
 private:
 	Graphics::Surface *_surface;
 
+	void decode(Common::SeekableReadStream &stream, Graphics::Surface &surface);
+
 	// SMC color tables
 	byte _colorPairs[COLORS_PER_TABLE * CPAIR];
 	byte _colorQuads[COLORS_PER_TABLE * CQUAD];
@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/str.h"
+#include "graphics/pixelformat.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -101,6 +102,22 @@ public:
 	virtual byte getPaletteStartIndex() const { return 0; }
 	/** Return the number of colors in the palette. */
 	virtual uint16 getPaletteColorCount() const { return 0; }
+
+	/**
+	 * Request the pixel format of the surfaces decoded by the following
+	 * loadStream() calls.
+	 *
+	 * Decoders supporting this write every row in the requested format while
+	 * decoding, which saves converting the whole surface afterwards. This is
+	 * only a hint: decoders may ignore it, e.g. for paletted images, so
+	 * callers still have to check the format of the returned surface.
+	 *
+	 * An invalid format (with zero bytes per pixel) requests the native
+	 * format of the image again, which is the default.
+	 *
+	 * @param format the pixel format to decode to
+	 */
+	virtual void setOutputPixelFormat(const Graphics::PixelFormat &format) {}
 };
 
 } // End of namespace Image
@@ -31,6 +31,7 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -41,6 +42,11 @@ extern "C" {
 #include <jpeglib.h>
 #include <jerror.h>
 }
+
+// libjpeg-turbo 1.5 added skipping and cropping of scanlines
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+#define JPEG_HAS_SCANLINE_CROPPING
+#endif
 #endif
 
 namespace Image {
@@ -48,7 +54,10 @@ namespace Image {
 JPEGDecoder::JPEGDecoder() :
 		_surface(),
 		_colorSpace(kColorSpaceRGB),
-		_requestedPixelFormat(getByteOrderRgbPixelFormat()) {
+		_requestedPixelFormat(getByteOrderRgbPixelFormat()),
+		_scaleDenominator(1),
+		_outputRect(),
+		_memoryUsage(Common::kMemoryImages) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -69,6 +78,7 @@ const Graphics::Surface *JPEGDecoder::getSurface() const {
 
 void JPEGDecoder::destroy() {
 	_surface.free();
+	_memoryUsage.set(0);
 }
 
 const Graphics::Surface *JPEGDecoder::decodeFrame(Common::SeekableReadStream &stream) {
@@ -250,10 +260,15 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Read the file header
 	jpeg_read_header(&cinfo, TRUE);
 
+	// An invalid format requests the native format, which is byte order RGB
+	Graphics::PixelFormat requestedPixelFormat = _requestedPixelFormat;
+	if (!requestedPixelFormat.bytesPerPixel)
+		requestedPixelFormat = getByteOrderRgbPixelFormat();
+
 	// We can request YUV output because Groovie requires it
 	switch (_colorSpace) {
 	case kColorSpaceRGB: {
-		J_COLOR_SPACE colorSpace = fromScummvmPixelFormat(_requestedPixelFormat);
+		J_COLOR_SPACE colorSpace = fromScummvmPixelFormat(requestedPixelFormat);
 
 		if (colorSpace == JCS_UNKNOWN) {
 			// When libjpeg-turbo is not available or an unhandled pixel
@@ -270,50 +285,100 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		break;
 	}
 
+	// DCT scaling is done by libjpeg while decoding, which is a lot cheaper
+	// than decoding at full size and scaling down afterwards
+	cinfo.scale_num = 1;
+	cinfo.scale_denom = _scaleDenominator;
+
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
+	// The output rectangle is in scaled coordinates
+	Common::Rect rect(cinfo.output_width, cinfo.output_height);
+	if (!_outputRect.isEmpty())
+		rect.clip(_outputRect);
+	if (rect.isEmpty()) {
+		warning("JPEGDecoder: Output rectangle is outside of the %dx%d image", cinfo.output_width, cinfo.output_height);
+		jpeg_destroy_decompress(&cinfo);
+		return false;
+	}
+
+	// libjpeg-turbo can skip whole iMCU columns left and right of the
+	// rectangle. It returns where the decoded scanlines then start.
+	JDIMENSION scanlineLeft = 0;
+#ifdef JPEG_HAS_SCANLINE_CROPPING
+	if ((JDIMENSION)rect.width() != cinfo.output_width) {
+		JDIMENSION scanlineWidth = rect.width();
+		scanlineLeft = rect.left;
+		jpeg_crop_scanline(&cinfo, &scanlineLeft, &scanlineWidth);
+	}
+#endif
+
 	// Allocate buffers for the output data
+	Graphics::PixelFormat scanlinePixelFormat;
 	switch (_colorSpace) {
-	case kColorSpaceRGB: {
-		Graphics::PixelFormat outputPixelFormat;
+	case kColorSpaceRGB:
 		if (cinfo.out_color_space == JCS_RGB) {
-			outputPixelFormat = getByteOrderRgbPixelFormat();
+			scanlinePixelFormat = getByteOrderRgbPixelFormat();
 		} else {
-			outputPixelFormat = _requestedPixelFormat;
+			scanlinePixelFormat = requestedPixelFormat;
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
 		break;
-	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		scanlinePixelFormat = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
 		break;
 	}
 
+	// When libjpeg cannot output the requested format itself, every scanline
+	// is converted as soon as it is decoded. crossBlit cannot write 3 byte
+	// formats, these are still converted once the whole image is decoded.
+	const bool convertScanlines = _colorSpace == kColorSpaceRGB && scanlinePixelFormat != requestedPixelFormat &&
+		(requestedPixelFormat.bytesPerPixel == 2 || requestedPixelFormat.bytesPerPixel == 4);
+	_surface.create(rect.width(), rect.height(), convertScanlines ? requestedPixelFormat : scanlinePixelFormat);
+
 	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= pitch);
+	JDIMENSION pitch = cinfo.output_width * scanlinePixelFormat.bytesPerPixel;
 	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	const uint bufferOffset = (rect.left - scanlineLeft) * scanlinePixelFormat.bytesPerPixel;
+	const uint rowSize = rect.width() * scanlinePixelFormat.bytesPerPixel;
+	assert(convertScanlines || _surface.pitch >= rowSize);
+
+	// Skip the scanlines above the rectangle
+#ifdef JPEG_HAS_SCANLINE_CROPPING
+	jpeg_skip_scanlines(&cinfo, rect.top);
+#endif
+	while (cinfo.output_scanline < (JDIMENSION)rect.top)
+		jpeg_read_scanlines(&cinfo, buffer, 1);
 
 	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+	while (cinfo.output_scanline < (JDIMENSION)rect.bottom) {
+		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline - rect.top);
 
 		jpeg_read_scanlines(&cinfo, buffer, 1);
 
-		memcpy(dst, buffer[0], pitch);
+		if (convertScanlines) {
+			Graphics::crossBlit(dst, buffer[0] + bufferOffset, _surface.pitch, rowSize, rect.width(), 1,
+			                    _surface.format, scanlinePixelFormat);
+		} else {
+			memcpy(dst, buffer[0] + bufferOffset, rowSize);
+		}
 	}
 
-	// We are done with decompressing, thus free all the data
-	jpeg_finish_decompress(&cinfo);
+	// We are done with decompressing, thus free all the data. Scanlines
+	// below the rectangle are not decoded at all.
+	if (cinfo.output_scanline < cinfo.output_height)
+		jpeg_abort_decompress(&cinfo);
+	else
+		jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
-		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
+	if (_colorSpace == kColorSpaceRGB && _surface.format != requestedPixelFormat) {
+		_surface.convertToInPlace(requestedPixelFormat); // Slow path
 	}
 
+	_memoryUsage.set(_surface.h * _surface.pitch);
 	return true;
 #else
 	return false;
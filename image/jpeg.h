@@ -33,6 +33,8 @@
 #ifndef IMAGE_JPEG_H
 #define IMAGE_JPEG_H
 
+#include "common/memtracker.h"
+#include "common/rect.h"
 #include "graphics/surface.h"
 #include "image/image_decoder.h"
 #include "image/codecs/codec.h"
@@ -95,14 +97,45 @@ public:
 	/**
 	 * Request the output pixel format. The JPEG decoder provides high performance
 	 * color conversion routines for some pixel formats. This setting allows to use
-	 * them and avoid costly subsequent color conversion.
+	 * them and avoid costly subsequent color conversion. Other formats are
+	 * converted scanline by scanline while decoding.
 	 */
 	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _requestedPixelFormat = format; }
 
+	/**
+	 * Request the image to be scaled down while decoding. libjpeg does this
+	 * as part of the inverse DCT, so it is a lot faster than decoding the
+	 * full image. The surface size is rounded up to whole pixels.
+	 *
+	 * @param denominator 1 (the default), 2, 4 or 8 to decode at full,
+	 *                    half, quarter or eighth size.
+	 */
+	void setOutputScale(uint denominator) {
+		assert(denominator == 1 || denominator == 2 || denominator == 4 || denominator == 8);
+		_scaleDenominator = denominator;
+	}
+
+	/**
+	 * Request only a part of the image. The surface then has the size of
+	 * the rectangle clipped to the image, and loadStream() fails when they
+	 * do not overlap.
+	 *
+	 * Scanlines below the rectangle are never decoded. With libjpeg-turbo,
+	 * the scanlines above and the columns outside are mostly skipped too.
+	 *
+	 * @param rect The part to decode, in scaled coordinates when combined
+	 *             with setOutputScale(). An empty rectangle (the default)
+	 *             decodes the whole image.
+	 */
+	void setOutputRect(const Common::Rect &rect) { _outputRect = rect; }
+
 private:
 	Graphics::Surface _surface;
+	Common::MemoryUsage _memoryUsage;
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
+	uint _scaleDenominator;
+	Common::Rect _outputRect;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
 };
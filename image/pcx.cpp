@@ -36,7 +36,7 @@
 
 namespace Image {
 
-PCXDecoder::PCXDecoder() {
+PCXDecoder::PCXDecoder() : _memoryUsage(Common::kMemoryImages) {
 	_surface = 0;
 	_palette = 0;
 	_paletteColorCount = 0;
@@ -52,6 +52,7 @@ void PCXDecoder::destroy() {
 		delete _surface;
 		_surface = 0;
 	}
+	_memoryUsage.set(0);
 
 	delete[] _palette;
 	_palette = 0;
@@ -188,6 +189,7 @@ bool PCXDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 	delete[] scanLine;
 
+	_memoryUsage.set(_surface->h * _surface->pitch);
 	return true;
 }
 
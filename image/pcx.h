@@ -31,6 +31,7 @@
 #ifndef IMAGE_PCX_H
 #define IMAGE_PCX_H
 
+#include "common/memtracker.h"
 #include "common/scummsys.h"
 #include "common/str.h"
 #include "image/image_decoder.h"
@@ -57,6 +58,7 @@ private:
 	void decodeRLE(Common::SeekableReadStream &stream, byte *dst, uint32 bytesPerScanline, bool compressed);
 
 	Graphics::Surface *_surface;
+	Common::MemoryUsage _memoryUsage;
 	byte *_palette;
 	uint16 _paletteColorCount;
 };
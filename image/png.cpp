@@ -31,6 +31,7 @@
 
 #include "image/png.h"
 
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -45,7 +46,9 @@ PNGDecoder::PNGDecoder() :
         _paletteColorCount(0),
         _skipSignature(false),
 		_keepTransparencyPaletted(false),
-		_transparentColor(-1) {
+		_transparentColor(-1),
+		_outputPixelFormat(),
+		_memoryUsage(Common::kMemoryImages) {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -58,8 +61,10 @@ void PNGDecoder::destroy() {
 		delete _outputSurface;
 		_outputSurface = 0;
 	}
+	_memoryUsage.set(0);
 	delete[] _palette;
 	_palette = NULL;
+	_paletteColorCount = 0;
 }
 
 Graphics::PixelFormat PNGDecoder::getByteOrderRgbaPixelFormat() const {
@@ -159,9 +164,19 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// To keep memory framentation low this happens before allocating memory for temporary image data.
 	_outputSurface = new Graphics::Surface();
 
+	// Rows are decoded as byte order RGBA and converted to the requested
+	// format one by one. crossBlit cannot write 3 byte formats, so these
+	// are decoded to the native format instead.
+	Graphics::PixelFormat outputPixelFormat = getByteOrderRgbaPixelFormat();
+	bool trueColorRequested = false;
+	if (_outputPixelFormat.bytesPerPixel == 2 || _outputPixelFormat.bytesPerPixel == 4) {
+		outputPixelFormat = _outputPixelFormat;
+		trueColorRequested = true;
+	}
+
 	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
 	// will be transformed into ARGB images
-	if (colorType == PNG_COLOR_TYPE_PALETTE && (_keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
+	if (colorType == PNG_COLOR_TYPE_PALETTE && (_keepTransparencyPaletted || (!trueColorRequested && !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)))) {
 		int numPalette = 0;
 		png_colorp palette = NULL;
 		uint32 success = png_get_PLTE(pngPtr, infoPtr, &palette, &numPalette);
@@ -190,11 +205,11 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		_outputSurface->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
 		png_set_packing(pngPtr);
 	} else {
-		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
+		if (colorType == PNG_COLOR_TYPE_PALETTE || png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat());
+		_outputSurface->create(width, height, outputPixelFormat);
 		if (!_outputSurface->getPixels()) {
 			error("Could not allocate memory for output image.");
 		}
@@ -217,14 +232,33 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
+	const bool convertRows = _outputSurface->format.bytesPerPixel != 1 && _outputSurface->format != getByteOrderRgbaPixelFormat();
+
 	if (interlaceType == PNG_INTERLACE_NONE) {
 		// PNGs without interlacing can simply be read row by row.
-		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+		if (convertRows) {
+			byte *row = new byte[width * 4];
+			for (int i = 0; i < height; i++) {
+				png_read_row(pngPtr, row, NULL);
+				Graphics::crossBlit((byte *)_outputSurface->getBasePtr(0, i), row, _outputSurface->pitch, width * 4,
+				                    width, 1, _outputSurface->format, getByteOrderRgbaPixelFormat());
+			}
+			delete[] row;
+		} else {
+			for (int i = 0; i < height; i++) {
+				png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+			}
 		}
 	} else {
 		// PNGs with interlacing require us to allocate an auxillary
-		// buffer with pointers to all row starts.
+		// buffer with pointers to all row starts. As every pass revisits
+		// the rows, these are only converted once the image is complete.
+		Graphics::Surface interlaced;
+		Graphics::Surface *target = _outputSurface;
+		if (convertRows) {
+			interlaced.create(width, height, getByteOrderRgbaPixelFormat());
+			target = &interlaced;
+		}
 
 		// Allocate row pointer buffer
 		png_bytep *rowPtr = new png_bytep[height];
@@ -234,13 +268,20 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		// Initialize row pointers
 		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+			rowPtr[i] = (png_bytep)target->getBasePtr(0, i);
 
 		// Read image data
 		png_read_image(pngPtr, rowPtr);
 
 		// Free row pointer buffer
 		delete[] rowPtr;
+
+		if (convertRows) {
+			Graphics::crossBlit((byte *)_outputSurface->getPixels(), (const byte *)interlaced.getPixels(),
+			                    _outputSurface->pitch, interlaced.pitch, width, height,
+			                    _outputSurface->format, interlaced.format);
+			interlaced.free();
+		}
 	}
 
 	// Read additional data at the end.
@@ -249,6 +290,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Destroy libpng structures
 	png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
 
+	_memoryUsage.set(_outputSurface->h * _outputSurface->pitch);
 	return true;
 #else
 	return false;
@@ -31,6 +31,7 @@
 #ifndef IMAGE_PNG_H
 #define IMAGE_PNG_H
 
+#include "common/memtracker.h"
 #include "common/scummsys.h"
 #include "common/textconsole.h"
 #include "graphics/pixelformat.h"
@@ -60,6 +61,12 @@ public:
 	int getTransparentColor() const { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request a 2 or 4 byte true color format. Paletted images are then
+	 * expanded as well, unless setKeepTransparencyPaletted() is set.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputPixelFormat = format; }
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat() const;
 
@@ -73,7 +80,11 @@ private:
 	bool _keepTransparencyPaletted;
 	int _transparentColor;
 
+	// Requested output format, invalid for the native one
+	Graphics::PixelFormat _outputPixelFormat;
+
 	Graphics::Surface *_outputSurface;
+	Common::MemoryUsage _memoryUsage;
 };
 
 /**
@@ -31,10 +31,11 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/error.h"
+#include "graphics/conversion.h"
 
 namespace Image {
 
-TGADecoder::TGADecoder() {
+TGADecoder::TGADecoder() : _memoryUsage(Common::kMemoryImages) {
 	_colorMapSize = 0;
 	_colorMapOrigin = 0;
 	_colorMapLength = 0;
@@ -49,6 +50,7 @@ TGADecoder::~TGADecoder() {
 void TGADecoder::destroy() {
 	_surface.free();
 	delete[] _colorMap;
+	_memoryUsage.set(0);
 }
 
 bool TGADecoder::loadStream(Common::SeekableReadStream &tga) {
@@ -80,6 +82,12 @@ bool TGADecoder::loadStream(Common::SeekableReadStream &tga) {
 		warning("Failed reading TGA-file");
 		return false;
 	}
+
+	// RLE packets may span rows, so these images are converted afterwards
+	if (canConvertTo(_outputPixelFormat) && _surface.format != _outputPixelFormat)
+		_surface.convertToInPlace(_outputPixelFormat);
+
+	_memoryUsage.set(_surface.h * _surface.pitch);
 	return success;
 }
 
@@ -220,42 +228,30 @@ bool TGADecoder::readColorMap(Common::SeekableReadStream &tga, byte imageType, b
 // Additional information found from http://paulbourke.net/dataformats/tga/
 // With some details from the link referenced in the header.
 bool TGADecoder::readData(Common::SeekableReadStream &tga, byte imageType, byte pixelDepth) {
-	// TrueColor
-	if (imageType == TYPE_TRUECOLOR) {
-		_surface.create(_surface.w, _surface.h, _format);
-
-		if (pixelDepth == 16) {
-			for (int i = 0; i < _surface.h; i++) {
-				uint16 *dst;
-				if (!_originTop) {
-					dst = (uint16 *)_surface.getBasePtr(0, _surface.h - i - 1);
-				} else {
-					dst = (uint16 *)_surface.getBasePtr(0, i);
-				}
+	// Rows are converted to the requested format as soon as they are read
+	const bool convertRows = canConvertTo(_outputPixelFormat);
+	_surface.create(_surface.w, _surface.h, convertRows ? _outputPixelFormat : _format);
+	byte *line = convertRows ? new byte[_surface.w * _format.bytesPerPixel] : nullptr;
+
+	for (int i = 0; i < _surface.h; i++) {
+		// Black/White images are always stored top down
+		const bool topDown = _originTop || imageType == TYPE_BW;
+		byte *row = (byte *)_surface.getBasePtr(0, topDown ? i : _surface.h - i - 1);
+		byte *dst = convertRows ? line : row;
+
+		// TrueColor
+		if (imageType == TYPE_TRUECOLOR) {
+			if (pixelDepth == 16) {
 				for (int j = 0; j < _surface.w; j++) {
-					*dst++ = tga.readUint16LE();
-				}
-			}
-		} else if (pixelDepth == 32) {
-			for (int i = 0; i < _surface.h; i++) {
-				uint32 *dst;
-				if (!_originTop) {
-					dst = (uint32 *)_surface.getBasePtr(0, _surface.h - i - 1);
-				} else {
-					dst = (uint32 *)_surface.getBasePtr(0, i);
+					*((uint16 *)dst) = tga.readUint16LE();
+					dst += 2;
 				}
+			} else if (pixelDepth == 32) {
 				for (int j = 0; j < _surface.w; j++) {
-					*dst++ = tga.readUint32LE();
-				}
-			}
-		} else if (pixelDepth == 24) {
-			for (int i = 0; i < _surface.h; i++) {
-				byte *dst;
-				if (!_originTop) {
-					dst = (byte *)_surface.getBasePtr(0, _surface.h - i - 1);
-				} else {
-					dst = (byte *)_surface.getBasePtr(0, i);
+					*((uint32 *)dst) = tga.readUint32LE();
+					dst += 4;
 				}
+			} else if (pixelDepth == 24) {
 				for (int j = 0; j < _surface.w; j++) {
 					byte r = tga.readByte();
 					byte g = tga.readByte();
@@ -271,25 +267,34 @@ bool TGADecoder::readData(Common::SeekableReadStream &tga, byte imageType, byte
 #endif
 				}
 			}
+			// Black/White
+		} else if (imageType == TYPE_BW) {
+			for (int j = 0; j < _surface.w; j++) {
+				byte g = tga.readByte();
+				*dst++ = g;
+				*dst++ = g;
+				*dst++ = g;
+				*dst++ = g;
+			}
 		}
-		// Black/White
-	} else if (imageType == TYPE_BW) {
-		_surface.create(_surface.w, _surface.h, _format);
-
-		byte *data  = (byte *)_surface.getPixels();
-		uint32 count = _surface.w * _surface.h;
 
-		while (count-- > 0) {
-			byte g = tga.readByte();
-			*data++ = g;
-			*data++ = g;
-			*data++ = g;
-			*data++ = g;
+		if (convertRows) {
+			Graphics::crossBlit(row, line, _surface.pitch, _surface.w * _format.bytesPerPixel,
+			                    _surface.w, 1, _surface.format, _format);
 		}
 	}
+
+	delete[] line;
 	return true;
 }
 
+bool TGADecoder::canConvertTo(const Graphics::PixelFormat &format) const {
+	// crossBlit cannot write 3 byte formats, and color-mapped images keep
+	// their palette
+	return (format.bytesPerPixel == 2 || format.bytesPerPixel == 4) &&
+		_format.bytesPerPixel != 1 && format != _format;
+}
+
 bool TGADecoder::readDataColorMapped(Common::SeekableReadStream &tga, byte imageType, byte indexDepth) {
 	// Color-mapped
 	if (imageType == TYPE_CMAP) {
@@ -34,6 +34,7 @@
 #ifndef IMAGE_TGA_H
 #define IMAGE_TGA_H
 
+#include "common/memtracker.h"
 #include "graphics/surface.h"
 #include "image/image_decoder.h"
 
@@ -64,6 +65,7 @@ public:
 	virtual const byte *getPalette() const { return _colorMap; }
 	virtual uint16 getPaletteColorCount() const { return _colorMapLength; }
 	virtual bool loadStream(Common::SeekableReadStream &stream);
+	virtual void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputPixelFormat = format; }
 private:
 	// Format-spec from:
 	//http://www.ludorg.net/amnesia/TGA_File_Format_Spec.html
@@ -87,8 +89,11 @@ private:
 	bool _originTop;
 
 	Graphics::PixelFormat _format;
+	Graphics::PixelFormat _outputPixelFormat;
 	Graphics::Surface _surface;
+	Common::MemoryUsage _memoryUsage;
 	// Loading helpers
+	bool canConvertTo(const Graphics::PixelFormat &format) const;
 	bool readHeader(Common::SeekableReadStream &tga, byte &imageType, byte &pixelDepth);
 	bool readData(Common::SeekableReadStream &tga, byte imageType, byte pixelDepth);
 	bool readDataColorMapped(Common::SeekableReadStream &tga, byte imageType, byte indexDepth);
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/adpcm.h"
+#include "audio/audiostream.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+class ADPCMStreamTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** Pseudo random ADPCM data, with the step indices in MS IMA block headers kept in range */
+	static Common::Array<byte> createData(Audio::ADPCMType type, int channels, uint32 blockAlign) {
+		Common::Array<byte> data;
+		uint32 seed = 12345;
+		for (uint32 i = 0; i < 20011; i++) {
+			seed = seed * 1103515245 + 12345;
+			data.push_back(seed >> 16);
+		}
+
+		if (type == Audio::kADPCMMSIma) {
+			for (uint32 block = 0; block < data.size(); block += blockAlign) {
+				for (int i = 0; i < channels; i++) {
+					data[block + i * 4 + 2] %= 89;
+					data[block + i * 4 + 3] = 0;
+				}
+			}
+		}
+
+		return data;
+	}
+
+	/**
+	 * Decodes the whole stream in reads of the sizes given, repeating them,
+	 * and returns a hash of the output and the number of samples in it. The
+	 * block sizes used must not let the stream end within a block header.
+	 */
+	static uint32 decode(Audio::ADPCMType type, int channels, uint32 blockAlign, const int *sizes, uint sizeCount, uint32 &total) {
+		Common::Array<byte> data = createData(type, channels, blockAlign);
+		Audio::SeekableAudioStream *stream = Audio::makeADPCMStream(new Common::MemoryReadStream(data.begin(), data.size()),
+			DisposeAfterUse::YES, data.size() - 3, type, 22050, channels, blockAlign);
+
+		int16 buffer[4096];
+		uint32 hash = 2166136261U;
+		total = 0;
+		for (uint i = 0; !stream->endOfData(); i++) {
+			const int samples = stream->readBuffer(buffer, sizes[i % sizeCount]);
+			for (int j = 0; j < samples; j++)
+				hash = (hash ^ (uint16)buffer[j]) * 16777619U;
+			total += samples;
+			if (samples == 0)
+				break;
+		}
+
+		delete stream;
+		return hash;
+	}
+
+	/**
+	 * Checks the output against what the sample by sample decoders produced,
+	 * in one read and in reads that end within bytes, groups and blocks.
+	 */
+	static void checkDecode(Audio::ADPCMType type, int channels, uint32 blockAlign, uint32 expectedHash, uint32 expectedTotal) {
+		static const int oneRead[] = { 4096 };
+		uint32 total;
+		TS_ASSERT_EQUALS(decode(type, channels, blockAlign, oneRead, 1, total), expectedHash);
+		TS_ASSERT_EQUALS(total, expectedTotal);
+
+		static const int monoReads[] = { 1, 3, 16, 7, 1000, 2, 333, 8 };
+		static const int stereoReads[] = { 2, 6, 32, 14, 1000, 4, 666, 16 };
+		const int *sizes = channels == 2 ? stereoReads : monoReads;
+		const uint sizeCount = ARRAYSIZE(monoReads);
+
+		TS_ASSERT_EQUALS(decode(type, channels, blockAlign, sizes, sizeCount, total), expectedHash);
+		TS_ASSERT_EQUALS(total, expectedTotal);
+	}
+
+public:
+	void test_dvi_mono() {
+		checkDecode(Audio::kADPCMDVI, 1, 0, 0xffe43810, 40016);
+	}
+
+	void test_dvi_stereo() {
+		checkDecode(Audio::kADPCMDVI, 2, 0, 0x13d86d1e, 40016);
+	}
+
+	void test_ms_ima_mono() {
+		checkDecode(Audio::kADPCMMSIma, 1, 512, 0x7cb31981, 39696);
+	}
+
+	void test_ms_ima_stereo() {
+		checkDecode(Audio::kADPCMMSIma, 2, 1024, 0x72ac5c36, 39696);
+	}
+
+	void test_ms_mono() {
+		checkDecode(Audio::kADPCMMS, 1, 512, 0x9ff39bf0, 39536);
+	}
+
+	void test_ms_stereo() {
+		checkDecode(Audio::kADPCMMS, 2, 1012, 0x59049075, 39536);
+	}
+};
@@ -2,6 +2,9 @@
 
 #include "audio/audiostream.h"
 
+#include "common/array.h"
+#include "common/taskscheduler.h"
+
 #include "helper.h"
 
 class AudioStreamTestSuite : public CxxTest::TestSuite
@@ -205,4 +208,107 @@ public:
 	void test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() {
 		testSubLoopingAudioStreamFixedIter(22050, true, 2, 2);
 	}
+
+private:
+	/**
+	 * A scheduler which pretends to have workers, but only runs the tasks
+	 * when asked to, or when they are waited for.
+	 */
+	class DeferredScheduler : public Common::TaskScheduler {
+	public:
+		~DeferredScheduler() { runPending(); }
+
+		uint getConcurrency() const { return 2; }
+
+		void runPending() {
+			while (!_pending.empty()) {
+				Common::TaskState *state = _pending.front();
+				_pending.remove_at(0);
+				runTask(state);
+				state->done = true;
+				release(state);
+			}
+		}
+
+	protected:
+		void enqueue(Common::TaskState *state) { _pending.push_back(state); }
+		void wait(Common::TaskState *state) { runPending(); }
+
+	private:
+		Common::Array<Common::TaskState *> _pending;
+	};
+
+	void testBufferedAudioStream(const int sampleRate, const bool isStereo) {
+		const int secondLength = sampleRate * (isStereo ? 2 : 1);
+
+		int16 *sine = 0;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(sampleRate, 2, &sine, false, isStereo);
+
+		DeferredScheduler scheduler;
+		Audio::SeekableAudioStream *buffered = Audio::makeBufferedAudioStream(s, DisposeAfterUse::YES, 100, &scheduler);
+
+		TS_ASSERT_EQUALS(buffered->isStereo(), isStereo);
+		TS_ASSERT_EQUALS(buffered->getRate(), sampleRate);
+		TS_ASSERT_EQUALS(buffered->getLength().totalNumberOfFrames(), sampleRate * 2);
+
+		// Nothing was decoded yet, which is not the end
+		int16 *buffer = new int16[secondLength * 2];
+		TS_ASSERT_EQUALS(buffered->readBuffer(buffer, 512), 0);
+		TS_ASSERT_EQUALS(buffered->endOfData(), false);
+
+		// Read everything, in pieces smaller than the buffer
+		int read = 0;
+		while (!buffered->endOfData()) {
+			scheduler.runPending();
+			const int samples = buffered->readBuffer(buffer + read, MIN(1000, secondLength * 2 - read));
+			TS_ASSERT(samples > 0);
+			if (samples <= 0)
+				break;
+			read += samples;
+		}
+
+		TS_ASSERT_EQUALS(read, secondLength * 2);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, secondLength * 2 * sizeof(int16)), 0);
+
+		// Seeking drops what was decoded ahead
+		TS_ASSERT(buffered->rewind());
+		scheduler.runPending();
+		TS_ASSERT_EQUALS(buffered->readBuffer(buffer, 1000), 1000);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, 1000 * sizeof(int16)), 0);
+
+		TS_ASSERT(buffered->seek(Audio::Timestamp(1000, sampleRate)));
+		TS_ASSERT_EQUALS(buffered->readBuffer(buffer, 1000), 0);
+		scheduler.runPending();
+		TS_ASSERT_EQUALS(buffered->readBuffer(buffer, 1000), 1000);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine + secondLength, 1000 * sizeof(int16)), 0);
+
+		delete buffered;
+		delete[] buffer;
+		delete[] sine;
+	}
+
+public:
+	void test_buffered_audio_stream_mono_11025() {
+		testBufferedAudioStream(11025, false);
+	}
+
+	void test_buffered_audio_stream_stereo_22050() {
+		testBufferedAudioStream(22050, true);
+	}
+
+	void test_buffered_audio_stream_serial() {
+		int16 *sine = 0;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(11025, 1, &sine, false, false);
+
+		// Without workers, reading goes straight to the parent
+		Common::TaskScheduler scheduler;
+		Audio::SeekableAudioStream *buffered = Audio::makeBufferedAudioStream(s, DisposeAfterUse::YES, 100, &scheduler);
+
+		int16 buffer[1000];
+		TS_ASSERT_EQUALS(buffered->readBuffer(buffer, 1000), 1000);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, sizeof(buffer)), 0);
+
+		delete buffered;
+		delete[] sine;
+	}
 };
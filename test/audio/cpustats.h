@@ -0,0 +1,46 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/cpustats.h"
+
+class CPUStatsTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_counters_roll_over_per_second() {
+		Audio::CPUStats &stats = Audio::CPUStats::instance();
+		const int music = Audio::CPUStats::getSoundTypeCounter(Audio::Mixer::kMusicSoundType);
+		const int synth = stats.getDriverCounter("test synth");
+		TS_ASSERT_EQUALS(stats.getDriverCounter("test synth"), synth);
+		TS_ASSERT_DIFFERS(stats.getDriverCounter("other synth"), synth);
+
+		// Nothing is published before a second of audio was mixed
+		for (int i = 0; i < 9; i++) {
+			stats.add(Audio::CPUStats::kCounterMixer, 3000);
+			stats.add(music, 2000 + i);
+			stats.add(synth, 1000);
+			stats.endMix(1000, 10000);
+		}
+		TS_ASSERT_EQUALS(stats.getCounters().size(), 1u);
+		TS_ASSERT_EQUALS(stats.getCounters()[0].usec, 0u);
+
+		// The second is overshot by half a mix, which is scaled out
+		stats.add(Audio::CPUStats::kCounterMixer, 3000);
+		stats.add(music, 2009);
+		stats.add(synth, 1000);
+		stats.endMix(1500, 10000);
+
+		const Common::Array<Audio::CPUStats::Counter> counters = stats.getCounters();
+		TS_ASSERT_EQUALS(counters.size(), 3u);
+		TS_ASSERT_EQUALS(Common::String(counters[0].name), "mixer");
+		TS_ASSERT_EQUALS(counters[0].usec, 30000u * 10000 / 10500);
+		TS_ASSERT_EQUALS(counters[0].peakUsec, 3000u);
+		TS_ASSERT_EQUALS(Common::String(counters[1].name), "music");
+		TS_ASSERT_EQUALS(counters[1].usec, 20045u * 10000 / 10500);
+		TS_ASSERT_EQUALS(counters[1].peakUsec, 2009u);
+		TS_ASSERT_EQUALS(Common::String(counters[2].name), "test synth");
+		TS_ASSERT_EQUALS(counters[2].usec, 10000u * 10000 / 10500);
+
+		TS_ASSERT_EQUALS(stats.formatCounters(), "mixer 2.8% (peak 3000us) music 1.9% (peak 2009us) test synth 0.9% (peak 1000us)");
+
+		Audio::CPUStats::destroy();
+	}
+};
@@ -3,6 +3,7 @@
 
 #include "audio/decoders/raw.h"
 
+#include "common/array.h"
 #include "common/stream.h"
 #include "common/endian.h"
 
@@ -65,4 +66,88 @@ static Audio::SeekableAudioStream *createSineStream(const int sampleRate, const
 	return s;
 }
 
+/**
+ * Create a Protracker module with eight channels playing four looped and
+ * unlooped samples, with pitch, volume and sample offset effects.
+ */
+static Common::Array<byte> createModule() {
+	static const int sampleWords[4] = { 64, 500, 2000, 33 };
+	static const int sampleLoops[4][2] = { { 0, 64 }, { 0, 0 }, { 100, 1800 }, { 0, 0 } };
+	static const int periods[12] = { 856, 808, 762, 720, 678, 640, 604, 570, 538, 508, 480, 453 };
+
+	Common::Array<byte> module(20, 'm');
+
+	for (int i = 0; i < 31; i++) {
+		const bool used = (i < 4);
+		const int values[4] = {
+			used ? sampleWords[i] : 0,
+			used ? 48 + i * 5 : 0, // finetune and volume
+			used ? sampleLoops[i][0] : 0,
+			used ? sampleLoops[i][1] : 0
+		};
+		for (int j = 0; j < 22; j++)
+			module.push_back(0);
+		for (int j = 0; j < 4; j++) {
+			module.push_back(values[j] >> 8);
+			module.push_back(values[j] & 0xFF);
+		}
+	}
+
+	// Play patterns 0, 1 and 0
+	module.push_back(3);
+	module.push_back(127);
+	for (int i = 0; i < 128; i++)
+		module.push_back(i == 1);
+	module.push_back('8');
+	module.push_back('C');
+	module.push_back('H');
+	module.push_back('N');
+
+	uint32 seed = 1;
+	for (int i = 0; i < 2 * 64 * 8; i++) {
+		seed = seed * 1103515245 + 12345;
+		const int r = seed >> 16;
+
+		int period = 0, sample = 0, effect = 0, param = 0;
+		if ((r & 3) == 0 || i < 8) {
+			period = periods[(r >> 2) % 12] >> ((r >> 6) % 3);
+			sample = 1 + (r >> 8) % 4;
+		}
+
+		switch ((r >> 10) % 8) {
+		case 0: effect = 0xA; param = 0x02; break; // volume slide
+		case 1: effect = 0x4; param = 0x46; break; // vibrato
+		case 2: effect = 0x1; param = 0x03; break; // portamento up
+		case 3: effect = 0x9; param = 0x02; break; // sample offset
+		case 4: effect = 0xC; param = (r >> 4) & 0x3F; break; // volume
+		default: break;
+		}
+
+		module.push_back((sample & 0x10) | (period >> 8));
+		module.push_back(period & 0xFF);
+		module.push_back(((sample & 0xF) << 4) | effect);
+		module.push_back(param);
+	}
+
+	// A sine, a saw, noise and a square
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < sampleWords[i] * 2; j++) {
+			int value;
+			if (i == 0) {
+				value = (int)(100 * sin(j * 2 * M_PI / 128));
+			} else if (i == 1) {
+				value = (j % 50) * 5 - 125;
+			} else if (i == 2) {
+				seed = seed * 1103515245 + 12345;
+				value = (int8)(seed >> 24);
+			} else {
+				value = (j & 8) ? 127 : -128;
+			}
+			module.push_back((byte)value);
+		}
+	}
+
+	return module;
+}
+
 #endif
@@ -0,0 +1,143 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mididrv.h"
+#include "audio/midiparser.h"
+
+#include "common/array.h"
+
+class MidiParserTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** Records every message and meta event it is sent */
+	class RecordingDriver : public MidiDriver_BASE {
+	public:
+		void send(uint32 b) { messages.push_back(b); }
+		void metaEvent(byte type, byte *data, uint16 length) { messages.push_back(0xFF000000 | type); }
+
+		Common::Array<uint32> messages;
+	};
+
+	static void writeVLQ(Common::Array<byte> &data, uint32 value) {
+		byte bytes[4];
+		int count = 0;
+		do {
+			bytes[count++] = value & 0x7F;
+			value >>= 7;
+		} while (value);
+		while (count--)
+			data.push_back(bytes[count] | (count ? 0x80 : 0));
+	}
+
+	/** A type 0 SMF with notes, program changes and tempo changes */
+	static Common::Array<byte> makeSMF() {
+		Common::Array<byte> track;
+		for (uint i = 0; i < 1500; i++) {
+			const byte channel = i % 16;
+			if (i % 40 == 30) {
+				const uint32 tempo = 300000 + (i % 7) * 50000;
+				writeVLQ(track, i % 3);
+				track.push_back(0xFF);
+				track.push_back(0x51);
+				track.push_back(3);
+				track.push_back(tempo >> 16);
+				track.push_back(tempo >> 8);
+				track.push_back(tempo);
+			}
+			if (i % 25 == 0) {
+				writeVLQ(track, 0);
+				track.push_back(0xC0 | channel);
+				track.push_back(i % 128);
+			}
+			writeVLQ(track, (i % 5) * 7);
+			track.push_back(0x90 | channel);
+			track.push_back(40 + i % 40);
+			track.push_back(100);
+			writeVLQ(track, 3 + i % 11);
+			track.push_back(0x80 | channel);
+			track.push_back(40 + i % 40);
+			track.push_back(0);
+		}
+		writeVLQ(track, 0);
+		track.push_back(0xFF);
+		track.push_back(0x2F);
+		track.push_back(0);
+
+		static const byte header[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96, 'M', 'T', 'r', 'k' };
+		Common::Array<byte> smf(header, ARRAYSIZE(header));
+		for (int shift = 24; shift >= 0; shift -= 8)
+			smf.push_back(track.size() >> shift);
+		for (uint i = 0; i < track.size(); i++)
+			smf.push_back(track[i]);
+		return smf;
+	}
+
+	/**
+	 * Jump, then return what is sent while playing on from there, with the
+	 * tick reached first.
+	 */
+	static Common::Array<uint32> jumpAndPlay(MidiParser *parser, RecordingDriver &driver, uint32 tick, uint32 tempo, bool fireEvents) {
+		// The notes off for what played before are not part of the result
+		parser->stopPlaying();
+		parser->setTrack(0);
+		parser->setTempo(tempo);
+		driver.messages.clear();
+		TS_ASSERT(parser->jumpToTick(tick, fireEvents));
+
+		for (int i = 0; i < 20; i++)
+			parser->onTimer();
+
+		Common::Array<uint32> result;
+		result.push_back(parser->getTick());
+		result.push_back(driver.messages.size());
+		for (uint i = 0; i < driver.messages.size(); i++)
+			result.push_back(driver.messages[i]);
+		return result;
+	}
+
+	static Common::Array<uint32> freshJumpAndPlay(Common::Array<byte> &smf, uint32 tick, uint32 tempo, bool fireEvents) {
+		Common::Array<byte> data(smf);
+		RecordingDriver driver;
+		MidiParser *parser = MidiParser::createParser_SMF();
+		parser->setMidiDriver(&driver);
+		parser->setTimerRate(20000);
+		TS_ASSERT(parser->loadMusic(data.begin(), data.size()));
+
+		Common::Array<uint32> result = jumpAndPlay(parser, driver, tick, tempo, fireEvents);
+		delete parser;
+		return result;
+	}
+
+public:
+	void test_jump_resumes_like_full_scan() {
+		Common::Array<byte> smf = makeSMF();
+		Common::Array<byte> data(smf);
+		RecordingDriver driver;
+		MidiParser *parser = MidiParser::createParser_SMF();
+		parser->setMidiDriver(&driver);
+		parser->setTimerRate(20000);
+		TS_ASSERT(parser->loadMusic(data.begin(), data.size()));
+
+		// Far first, so later jumps resume from what that scan recorded,
+		// and at other tempos than the first scan started with
+		static const uint32 ticks[] = { 20000, 100, 9000, 9001, 15000, 3, 19999, 5000, 20000 };
+		static const uint32 tempos[] = { 500000, 500000, 400000, 650000, 500000, 250000, 800000, 500000, 300000 };
+		for (uint i = 0; i < ARRAYSIZE(ticks); i++) {
+			Common::Array<uint32> expected = freshJumpAndPlay(smf, ticks[i], tempos[i], false);
+			Common::Array<uint32> actual = jumpAndPlay(parser, driver, ticks[i], tempos[i], false);
+			TS_ASSERT_EQUALS(actual.size(), expected.size());
+			TS_ASSERT(actual == expected);
+		}
+
+		// Fired events are still all sent
+		Common::Array<uint32> expected = freshJumpAndPlay(smf, 12000, 500000, true);
+		Common::Array<uint32> actual = jumpAndPlay(parser, driver, 12000, 500000, true);
+		TS_ASSERT_EQUALS(actual.size(), expected.size());
+		TS_ASSERT(actual == expected);
+
+		// Past the end of the track
+		parser->setTempo(500000);
+		TS_ASSERT(!parser->jumpToTick(1000000));
+
+		delete parser;
+	}
+};
@@ -0,0 +1,44 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mods/mod_xm_s3m.h"
+
+#include "common/memstream.h"
+
+#include "helper.h"
+
+class ModXmS3mTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** Play the whole module, and return a hash of the output. */
+	static uint32 renderHash(int rate, int interpolation, int &samples) {
+		Common::Array<byte> module = createModule();
+		Audio::AudioStream *stream = Audio::makeModXmS3mStream(new Common::MemoryReadStream(module.begin(), module.size()), DisposeAfterUse::YES, rate, interpolation);
+		TS_ASSERT(stream);
+
+		uint32 hash = 2166136261u;
+		int16 buffer[1000];
+		samples = 0;
+		while (!stream->endOfData()) {
+			// Not a multiple of the tick length, nor of the vector sizes
+			const int count = stream->readBuffer(buffer, 998);
+			for (int i = 0; i < count; i++)
+				hash = (hash ^ (uint16)buffer[i]) * 16777619u;
+			samples += count;
+		}
+
+		delete stream;
+		return hash;
+	}
+
+public:
+	void test_output() {
+		int samples;
+		TS_ASSERT_EQUALS(renderHash(22050, 0, samples), 0x2cd04ae8u);
+		TS_ASSERT_EQUALS(samples, 1016962);
+		TS_ASSERT_EQUALS(renderHash(48000, 0, samples), 0xa85b83d9u);
+		TS_ASSERT_EQUALS(samples, 2212566);
+		TS_ASSERT_EQUALS(renderHash(22050, 1, samples), 0xcce47534u);
+		TS_ASSERT_EQUALS(renderHash(48000, 1, samples), 0x469c37a9u);
+	}
+};
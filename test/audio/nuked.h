@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/nuked.h"
+
+#ifndef DISABLE_NUKED_OPL
+
+class NukedOPLTestSuite : public CxxTest::TestSuite
+{
+private:
+	/**
+	 * Play a fixed pseudo-random sequence of instruments and notes, and
+	 * return a hash of the output.
+	 */
+	static uint32 renderHash(uint32 seed, bool opl3, bool rhythm, uint rate) {
+		OPL::NUKED::opl3_chip chip;
+		OPL::NUKED::OPL3_Reset(&chip, rate);
+		if (opl3) {
+			OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0x105, 0x01);
+			OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0x104, 0x09);
+		}
+
+		static const uint8 slotOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+		uint32 hash = 2166136261u;
+		int16 buffer[256 * 2];
+
+		for (int block = 0; block < 400; block++) {
+			seed = seed * 1103515245 + 12345;
+			const uint16 bank = (opl3 && (seed & 0x10000)) ? 0x100 : 0;
+			const uint channel = (seed >> 17) % 9;
+
+			if (rhythm && (seed & 0x7000) == 0) {
+				OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0xbd, 0x20 | ((seed >> 24) & 0xdf));
+			} else if (seed & 0x8000) {
+				// A new instrument and a note on
+				for (int op = 0; op < 2; op++) {
+					const uint16 slot = bank + slotOffsets[channel] + op * 3;
+					OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0x20 + slot, (uint8)(seed >> (op + 3)));
+					OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0x40 + slot, (uint8)(seed >> (op + 7)) & 0x3f);
+					OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0x60 + slot, (uint8)(seed >> (op + 11)) | 0x11);
+					OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0x80 + slot, (uint8)(seed >> (op + 15)));
+					OPL::NUKED::OPL3_WriteRegBuffered(&chip, 0xe0 + slot, (uint8)(seed >> (op + 20)) & 0x07);
+				}
+				OPL::NUKED::OPL3_WriteRegBuffered(&chip, bank + 0xc0 + channel, (uint8)(seed >> 24) | 0x30);
+				OPL::NUKED::OPL3_WriteRegBuffered(&chip, bank + 0xa0 + channel, (uint8)(seed >> 9));
+				OPL::NUKED::OPL3_WriteRegBuffered(&chip, bank + 0xb0 + channel, 0x20 | ((seed >> 2) & 0x1f));
+			} else {
+				// A note off
+				OPL::NUKED::OPL3_WriteRegBuffered(&chip, bank + 0xb0 + channel, (seed >> 2) & 0x1f);
+			}
+
+			OPL::NUKED::OPL3_GenerateStream(&chip, buffer, 256);
+			for (int i = 0; i < 256 * 2; i++)
+				hash = (hash ^ (uint16)buffer[i]) * 16777619u;
+		}
+
+		return hash;
+	}
+
+public:
+	// The hashes come from the emulator as imported, which the speed-ups
+	// must not change a single sample of
+	void test_opl2_melodic() {
+		TS_ASSERT_EQUALS(renderHash(1, false, false, 44100), 0xf3bd215du);
+	}
+
+	void test_opl3_four_operator() {
+		TS_ASSERT_EQUALS(renderHash(2, true, false, 48000), 0x5f755c61u);
+	}
+
+	void test_opl2_rhythm() {
+		TS_ASSERT_EQUALS(renderHash(3, false, true, 22050), 0xb5d3d193u);
+	}
+
+	void test_opl3_rhythm_native_rate() {
+		TS_ASSERT_EQUALS(renderHash(4, true, true, 49716), 0x3d36f260u);
+	}
+};
+
+#endif
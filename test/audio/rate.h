@@ -0,0 +1,199 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include <math.h>
+
+class RateTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** An endless stream of noise, or of a constant sample */
+	class TestStream : public Audio::AudioStream {
+	public:
+		TestStream(int rate, bool stereo, uint32 seed, bool constant = false) :
+			_rate(rate), _stereo(stereo), _seed(seed), _constant(constant) {}
+
+		int readBuffer(int16 *buffer, const int numSamples) {
+			for (int i = 0; i < numSamples; i++) {
+				if (!_constant)
+					_seed = _seed * 1103515245 + 12345;
+				buffer[i] = (int16)(_constant ? _seed : _seed >> 12);
+			}
+			return numSamples;
+		}
+
+		bool isStereo() const { return _stereo; }
+		int getRate() const { return _rate; }
+		bool endOfData() const { return false; }
+
+	private:
+		const int _rate;
+		const bool _stereo;
+		uint32 _seed;
+		const bool _constant;
+	};
+
+	/** An endless sine wave */
+	class SineStream : public Audio::AudioStream {
+	public:
+		SineStream(int rate, double frequency, int amplitude) :
+			_rate(rate), _frequency(frequency), _amplitude(amplitude), _pos(0) {}
+
+		int readBuffer(int16 *buffer, const int numSamples) {
+			for (int i = 0; i < numSamples; i++, _pos++)
+				buffer[i] = (int16)floor(_amplitude * sin(2 * M_PI * _frequency * _pos / _rate) + 0.5);
+			return numSamples;
+		}
+
+		bool isStereo() const { return false; }
+		int getRate() const { return _rate; }
+		bool endOfData() const { return false; }
+
+	private:
+		const int _rate;
+		const double _frequency;
+		const int _amplitude;
+		uint32 _pos;
+	};
+
+	/**
+	 * Resample a sine wave, and return the largest difference between the
+	 * output and the same wave sampled at the output rate, skipping the
+	 * start of the output.
+	 */
+	int resampledSineError(int inRate, int outRate, double frequency, Audio::RateConverterQuality quality, int amplitude, bool alias) {
+		const uint frames = 2000, skip = 100;
+
+		SineStream stream(inRate, frequency, amplitude);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false, false, quality);
+
+		int16 output[frames * 2];
+		memset(output, 0, sizeof(output));
+		TS_ASSERT_EQUALS(converter->flow(stream, output, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), (int)frames);
+		delete converter;
+
+		// Above the output Nyquist frequency nothing should be left
+		int maxError = 0;
+		for (uint i = skip; i < frames; i++) {
+			const double expected = alias ? 0.0 : amplitude * sin(2 * M_PI * frequency * i / outRate);
+			maxError = MAX(maxError, (int)fabs(output[i * 2] - expected));
+		}
+		return maxError;
+	}
+
+	void checkMixMatchesFlow(int inRate, bool stereo, bool reverseStereo, Audio::RateConverterQuality quality) {
+		static const Audio::st_volume_t volumes[][2] = {
+			{ Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume },
+			{ 100, 37 },
+			{ 0, 255 }
+		};
+
+		for (uint v = 0; v < ARRAYSIZE(volumes); v++) {
+			// Not a multiple of any vector size
+			const uint frames = 1001;
+
+			TestStream stream1(inRate, stereo, 1234), stream2(inRate, stereo, 1234);
+			Audio::RateConverter *converter1 = Audio::makeRateConverter(inRate, 44100, stereo, reverseStereo, quality);
+			Audio::RateConverter *converter2 = Audio::makeRateConverter(inRate, 44100, stereo, reverseStereo, quality);
+
+			int16 expected[frames * 2], packed[frames * 2];
+			int32 mixed[frames * 2];
+			memset(expected, 0, sizeof(expected));
+			memset(mixed, 0, sizeof(mixed));
+
+			TS_ASSERT_EQUALS(converter1->flow(stream1, expected, frames, volumes[v][0], volumes[v][1]), (int)frames);
+			TS_ASSERT_EQUALS(converter2->mix(stream2, mixed, frames, volumes[v][0], volumes[v][1]), (int)frames);
+
+			Audio::clampedPack(packed, mixed, frames * 2);
+			TS_ASSERT_EQUALS(memcmp(expected, packed, sizeof(expected)), 0);
+
+			delete converter1;
+			delete converter2;
+		}
+	}
+
+public:
+	void test_mix_copy() {
+		checkMixMatchesFlow(44100, false, false, Audio::kRateConverterLow);
+		checkMixMatchesFlow(44100, true, false, Audio::kRateConverterLow);
+		checkMixMatchesFlow(44100, true, true, Audio::kRateConverterLow);
+	}
+
+	void test_mix_simple() {
+		checkMixMatchesFlow(88200, false, false, Audio::kRateConverterLow);
+		checkMixMatchesFlow(88200, true, true, Audio::kRateConverterLow);
+	}
+
+	void test_mix_linear() {
+		checkMixMatchesFlow(22050, false, false, Audio::kRateConverterLow);
+		checkMixMatchesFlow(22050, true, true, Audio::kRateConverterLow);
+	}
+
+	void test_mix_sinc() {
+		checkMixMatchesFlow(22050, false, false, Audio::kRateConverterMedium);
+		checkMixMatchesFlow(22050, true, true, Audio::kRateConverterHigh);
+		checkMixMatchesFlow(11025, true, false, Audio::kRateConverterHigh);
+		checkMixMatchesFlow(48000, true, false, Audio::kRateConverterHigh);
+	}
+
+	void test_sinc_constant() {
+		static const uint rates[] = { 8000, 11025, 22050, 48000, 96000 };
+		const int16 sample = -12345;
+
+		for (uint r = 0; r < ARRAYSIZE(rates); r++) {
+			TestStream stream(rates[r], true, (uint16)sample, true);
+			Audio::RateConverter *converter = Audio::makeRateConverter(rates[r], 44100, true, false, Audio::kRateConverterHigh);
+
+			int16 output[300 * 2];
+			memset(output, 0, sizeof(output));
+			TS_ASSERT_EQUALS(converter->flow(stream, output, 300, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 300);
+			delete converter;
+
+			// Past the ringing of the step from the silence the filter starts with
+			for (int i = 200 * 2; i < 300 * 2; i++)
+				TS_ASSERT_EQUALS(output[i], sample);
+		}
+	}
+
+	void test_sinc_passband() {
+		TS_ASSERT_LESS_THAN(resampledSineError(22050, 44100, 1000, Audio::kRateConverterMedium, 10000, false), 100);
+		TS_ASSERT_LESS_THAN(resampledSineError(22050, 44100, 1000, Audio::kRateConverterHigh, 10000, false), 25);
+		TS_ASSERT_LESS_THAN(resampledSineError(11025, 48000, 2000, Audio::kRateConverterHigh, 10000, false), 25);
+		TS_ASSERT_LESS_THAN(resampledSineError(48000, 44100, 5000, Audio::kRateConverterHigh, 10000, false), 25);
+	}
+
+	void test_sinc_aliasing() {
+		// Linear interpolation lets most of a 16kHz tone through at 22050Hz
+		TS_ASSERT_LESS_THAN(5000, resampledSineError(48000, 22050, 16000, Audio::kRateConverterLow, 10000, true));
+
+		TS_ASSERT_LESS_THAN(resampledSineError(48000, 22050, 16000, Audio::kRateConverterMedium, 10000, true), 50);
+		TS_ASSERT_LESS_THAN(resampledSineError(48000, 22050, 16000, Audio::kRateConverterHigh, 10000, true), 20);
+	}
+
+	void test_mix_clips_once() {
+		// Clipping each stream would leave 32767 - 20000 here
+		const int16 samples[] = { 20000, 20000, -20000 };
+		int32 mixed[16 * 2];
+		memset(mixed, 0, sizeof(mixed));
+
+		for (uint i = 0; i < ARRAYSIZE(samples); i++) {
+			TestStream stream(44100, true, (uint16)samples[i], true);
+			Audio::RateConverter *converter = Audio::makeRateConverter(44100, 44100, true);
+			converter->mix(stream, mixed, 16, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			delete converter;
+		}
+
+		mixed[5] = 40000;
+		mixed[30] = -40000;
+
+		int16 packed[16 * 2];
+		Audio::clampedPack(packed, mixed, 16 * 2);
+
+		for (int i = 0; i < 16 * 2; i++) {
+			const int16 expected = (i == 5) ? 32767 : (i == 30) ? -32768 : 20000;
+			TS_ASSERT_EQUALS(packed[i], expected);
+		}
+	}
+};
@@ -288,4 +288,44 @@ public:
 	void test_seek_stereo() {
 		seekTest(11025, 2, true);
 	}
+
+	void test_read_pointer_follows_loops() {
+		const int samples = 5000;
+		int16 *data = (int16 *)malloc(samples * sizeof(int16));
+		for (int i = 0; i < samples; ++i)
+			data[i] = (int16)(i * 37 - 20000);
+
+#ifdef SCUMM_LITTLE_ENDIAN
+		const byte flags = Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN;
+#else
+		const byte flags = Audio::FLAG_16BITS | Audio::FLAG_STEREO;
+#endif
+		Audio::SeekableAudioStream *raw = Audio::makeRawStream((const byte *)data, samples * sizeof(int16), 11025, flags, DisposeAfterUse::YES);
+		Audio::AudioStream *stream = Audio::makeLoopingAudioStream(raw, 4);
+
+		// Every read lands within the data, in the order the loops play it
+		int read = 0, chunk = 1;
+		const int16 *ptr;
+		int count;
+		while ((count = stream->getReadPointer(ptr, chunk)) > 0) {
+			TS_ASSERT(count <= chunk);
+			TS_ASSERT(ptr >= data && ptr + count <= data + samples);
+			TS_ASSERT_EQUALS(ptr - data, read % samples);
+			read += count;
+			chunk = chunk * 3 % 1999 + 2;
+		}
+
+		TS_ASSERT_EQUALS(count, 0);
+		TS_ASSERT_EQUALS(read, samples * 4);
+		TS_ASSERT(stream->endOfStream());
+
+		delete stream;
+	}
+
+	void test_read_pointer_without_memory() {
+		Audio::SeekableAudioStream *s = createSineStream<int16>(11025, 1, 0, true, false);
+		const int16 *ptr;
+		TS_ASSERT_EQUALS(s->getReadPointer(ptr, 100), -1);
+		delete s;
+	}
 };
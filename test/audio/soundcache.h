@@ -0,0 +1,146 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/soundcache.h"
+
+class DecodedSoundCacheTestSuite : public CxxTest::TestSuite
+{
+private:
+	/** A stream of the given length, counting up from the first sample */
+	class CountingStream : public Audio::AudioStream {
+	public:
+		CountingStream(int length, bool stereo, int16 first, int *decoded = nullptr) :
+			_stereo(stereo), _next(first), _left(length), _decoded(decoded) {}
+
+		virtual int readBuffer(int16 *buffer, const int numSamples) {
+			const int samples = MIN(numSamples, _left);
+			for (int i = 0; i < samples; i++)
+				buffer[i] = _next++;
+			_left -= samples;
+			if (_decoded)
+				*_decoded += samples;
+			return samples;
+		}
+
+		virtual bool isStereo() const { return _stereo; }
+		virtual int getRate() const { return 11025; }
+		virtual bool endOfData() const { return _left == 0; }
+
+	private:
+		const bool _stereo;
+		int16 _next;
+		int _left;
+		int *_decoded;
+	};
+
+	static bool playsCounting(Audio::SeekableAudioStream *stream, int length, int16 first) {
+		int16 *buffer = new int16[length + 1];
+		const int samples = stream->readBuffer(buffer, length + 1);
+		bool result = samples == length && stream->endOfData();
+		for (int i = 0; i < samples && result; i++)
+			result = buffer[i] == (int16)(first + i);
+		delete[] buffer;
+		return result;
+	}
+
+public:
+	void test_find_after_insert() {
+		Audio::DecodedSoundCache cache(1 << 20);
+		const Audio::DecodedSoundCache::Key key("sfx.res", 7, 1);
+		TS_ASSERT(!cache.find(key));
+
+		int decoded = 0;
+		Audio::SeekableAudioStream *first = cache.insert(key, new CountingStream(10000, false, 100, &decoded));
+		TS_ASSERT(first);
+		TS_ASSERT_EQUALS(decoded, 10000);
+		TS_ASSERT_EQUALS(cache.getSize(), 20000U);
+		TS_ASSERT(cache.contains(key));
+
+		// Other ids and formats of the same archive are other sounds
+		TS_ASSERT(!cache.find(Audio::DecodedSoundCache::Key("sfx.res", 7, 2)));
+		TS_ASSERT(!cache.find(Audio::DecodedSoundCache::Key("sfx.res", 8, 1)));
+		TS_ASSERT(!cache.find(Audio::DecodedSoundCache::Key("music.res", 7, 1)));
+
+		// Two streams play the same buffer independently
+		Audio::SeekableAudioStream *second = cache.find(key);
+		TS_ASSERT(second);
+		TS_ASSERT_EQUALS(second->getRate(), 11025);
+		TS_ASSERT(!second->isStereo());
+		TS_ASSERT_EQUALS(second->getLength().totalNumberOfFrames(), 10000);
+		TS_ASSERT(playsCounting(first, 10000, 100));
+		TS_ASSERT(playsCounting(second, 10000, 100));
+
+		TS_ASSERT(second->rewind());
+		TS_ASSERT(playsCounting(second, 10000, 100));
+		TS_ASSERT(second->seek(Audio::Timestamp(0, 9000, 11025)));
+		TS_ASSERT(playsCounting(second, 1000, 9100));
+
+		delete first;
+		delete second;
+		TS_ASSERT_EQUALS(decoded, 10000);
+	}
+
+	void test_least_recently_used_dropped() {
+		// Room for three sounds of 1000 samples
+		Audio::DecodedSoundCache cache(6000);
+		typedef Audio::DecodedSoundCache::Key Key;
+
+		delete cache.insert(Key("a", 1), new CountingStream(1000, false, 0));
+		delete cache.insert(Key("a", 2), new CountingStream(1000, false, 0));
+		delete cache.insert(Key("a", 3), new CountingStream(1000, false, 0));
+		TS_ASSERT_EQUALS(cache.getSize(), 6000U);
+
+		// Using the first makes the second the least recently used one
+		delete cache.find(Key("a", 1));
+		delete cache.insert(Key("a", 4), new CountingStream(1000, false, 0));
+		TS_ASSERT(cache.contains(Key("a", 1)));
+		TS_ASSERT(!cache.contains(Key("a", 2)));
+		TS_ASSERT(cache.contains(Key("a", 3)));
+		TS_ASSERT(cache.contains(Key("a", 4)));
+		TS_ASSERT_EQUALS(cache.getSize(), 6000U);
+
+		// Replacing a sound frees what it took
+		delete cache.insert(Key("a", 3), new CountingStream(500, false, 0));
+		TS_ASSERT_EQUALS(cache.getSize(), 5000U);
+
+		cache.setMaxSize(3000);
+		TS_ASSERT(!cache.contains(Key("a", 1)));
+		TS_ASSERT(cache.contains(Key("a", 3)));
+		TS_ASSERT(cache.contains(Key("a", 4)));
+		TS_ASSERT_EQUALS(cache.getSize(), 3000U);
+
+		cache.remove(Key("a", 4));
+		TS_ASSERT(!cache.contains(Key("a", 4)));
+		TS_ASSERT_EQUALS(cache.getSize(), 1000U);
+
+		cache.clear();
+		TS_ASSERT(!cache.contains(Key("a", 3)));
+		TS_ASSERT_EQUALS(cache.getSize(), 0U);
+	}
+
+	void test_too_large_not_stored() {
+		Audio::DecodedSoundCache cache(1000);
+		const Audio::DecodedSoundCache::Key key("speech", 1);
+
+		Audio::SeekableAudioStream *stream = cache.insert(key, new CountingStream(1000, true, -500));
+		TS_ASSERT(stream);
+		TS_ASSERT(!cache.contains(key));
+		TS_ASSERT_EQUALS(cache.getSize(), 0U);
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT(playsCounting(stream, 1000, -500));
+		delete stream;
+	}
+
+	void test_streams_outlive_cache() {
+		Audio::SeekableAudioStream *stream;
+		{
+			Audio::DecodedSoundCache cache(1 << 20);
+			delete cache.insert(Audio::DecodedSoundCache::Key("a", 1), new CountingStream(3000, true, 5));
+			stream = cache.find(Audio::DecodedSoundCache::Key("a", 1));
+			cache.remove(Audio::DecodedSoundCache::Key("a", 1));
+		}
+
+		TS_ASSERT(playsCounting(stream, 3000, 5));
+		delete stream;
+	}
+};
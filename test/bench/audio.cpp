@@ -0,0 +1,347 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/bench/bench.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/mods/mod_xm_s3m.h"
+#include "audio/softsynth/sid.h"
+#include "audio/softsynth/opl/nuked.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+#include "test/audio/helper.h"
+
+namespace {
+
+const uint kOutputRate = 44100;
+const uint kOutputFrames = 4096;
+
+/** An endless stream of noise from a fixed seed. */
+class NoiseStream : public Audio::AudioStream {
+public:
+	NoiseStream(uint rate, bool stereo, uint32 seed) : _rate(rate), _stereo(stereo), _random(seed) {}
+
+	virtual int readBuffer(int16 *buffer, const int numSamples) {
+		for (int i = 0; i < numSamples; i++)
+			buffer[i] = (int16)_random.next();
+		return numSamples;
+	}
+
+	virtual bool isStereo() const { return _stereo; }
+	virtual int getRate() const { return _rate; }
+	virtual bool endOfData() const { return false; }
+
+private:
+	const uint _rate;
+	const bool _stereo;
+	Bench::Random _random;
+};
+
+/**
+ * Converts one stream to the output rate, or mixes several into one output
+ * buffer the way MixerImpl::mixCallback mixes its channels.
+ */
+class RateConversion : public Bench::Benchmark {
+public:
+	RateConversion(const char *name, uint inputRate, bool stereo, uint channels,
+	               Audio::RateConverterQuality quality = Audio::kRateConverterLow) :
+		Bench::Benchmark(name), _inputRate(inputRate), _stereo(stereo), _channelCount(channels), _quality(quality) {}
+
+	virtual void setUp() {
+		for (uint i = 0; i < _channelCount; i++) {
+			Channel channel;
+			channel.stream = new NoiseStream(_inputRate, _stereo, i + 1);
+			channel.converter = Audio::makeRateConverter(_inputRate, kOutputRate, _stereo, false, _quality);
+			_channels.push_back(channel);
+		}
+
+		_mixBuffer.resize(kOutputFrames * 2);
+		_output.resize(kOutputFrames * 2);
+	}
+
+	virtual void tearDown() {
+		for (uint i = 0; i < _channels.size(); i++) {
+			delete _channels[i].converter;
+			delete _channels[i].stream;
+		}
+		_channels.clear();
+	}
+
+	virtual uint64 run() {
+		memset(_mixBuffer.begin(), 0, _mixBuffer.size() * sizeof(int32));
+
+		for (uint i = 0; i < _channels.size(); i++) {
+			const Audio::st_volume_t volume = Audio::Mixer::kMaxMixerVolume / _channels.size();
+			_channels[i].converter->mix(*_channels[i].stream, _mixBuffer.begin(), kOutputFrames, volume, volume);
+		}
+
+		Audio::clampedPack(_output.begin(), _mixBuffer.begin(), _output.size());
+
+		Bench::consume(_output[kOutputFrames]);
+		return (uint64)kOutputFrames * 2 * sizeof(Audio::st_sample_t);
+	}
+
+private:
+	struct Channel {
+		Audio::AudioStream *stream;
+		Audio::RateConverter *converter;
+	};
+
+	const uint _inputRate;
+	const bool _stereo;
+	const uint _channelCount;
+	const Audio::RateConverterQuality _quality;
+
+	Common::Array<Channel> _channels;
+	Common::Array<int32> _mixBuffer;
+	Common::Array<Audio::st_sample_t> _output;
+};
+
+// Copy, simple (integer downsampling) and linear interpolation
+static RateConversion s_rateCopyStereo("audio/rate_copy_stereo", 44100, true, 1);
+static RateConversion s_rateSimpleMono("audio/rate_simple_mono", 88200, false, 1);
+static RateConversion s_rateLinearMono("audio/rate_linear_mono", 22050, false, 1);
+static RateConversion s_rateLinearStereo("audio/rate_linear_stereo", 22050, true, 1);
+
+// Windowed-sinc filters
+static RateConversion s_rateSincMediumMono("audio/rate_sinc16_mono", 22050, false, 1, Audio::kRateConverterMedium);
+static RateConversion s_rateSincHighMono("audio/rate_sinc32_mono", 22050, false, 1, Audio::kRateConverterHigh);
+static RateConversion s_rateSincHighStereo("audio/rate_sinc32_stereo", 48000, true, 1, Audio::kRateConverterHigh);
+
+// Mixing like MixerImpl::mixCallback, which needs an OSystem for its timing
+static RateConversion s_mix8("audio/mix_8_channels", 22050, false, 8);
+static RateConversion s_mix32("audio/mix_32_channels", 22050, false, 32);
+
+/** Plays the eight channel module of the sound tests, from the start again when it ends */
+class ModulePlayback : public Bench::Benchmark {
+public:
+	ModulePlayback(const char *name, int interpolation) : Bench::Benchmark(name), _interpolation(interpolation), _stream(nullptr) {}
+
+	virtual void setUp() {
+		_module = createModule();
+		_output.resize(kOutputFrames * 2);
+	}
+
+	virtual void tearDown() {
+		delete _stream;
+		_stream = nullptr;
+	}
+
+	virtual uint64 run() {
+		if (!_stream || _stream->endOfData()) {
+			delete _stream;
+			_stream = Audio::makeModXmS3mStream(new Common::MemoryReadStream(_module.begin(), _module.size()), DisposeAfterUse::YES, 48000, _interpolation);
+		}
+
+		_stream->readBuffer(_output.begin(), _output.size());
+
+		Bench::consume(_output[kOutputFrames]);
+		return (uint64)kOutputFrames * 2 * sizeof(int16);
+	}
+
+private:
+	const int _interpolation;
+	Common::Array<byte> _module;
+	Audio::AudioStream *_stream;
+	Common::Array<int16> _output;
+};
+
+static ModulePlayback s_modNearest("audio/mod_8_channels", 0);
+static ModulePlayback s_modInterpolated("audio/mod_8_channels_interpolated", 1);
+
+/** Decodes a long ADPCM speech stream, from the start again when it ends */
+class ADPCMDecoding : public Bench::Benchmark {
+public:
+	ADPCMDecoding(const char *name, Audio::ADPCMType type, int channels, uint32 blockAlign) :
+		Bench::Benchmark(name), _type(type), _channels(channels), _blockAlign(blockAlign), _stream(nullptr) {}
+
+	virtual void setUp() {
+		Bench::Random rnd(1);
+		_data.resize(_blockAlign * 64);
+		for (uint i = 0; i < _data.size(); i++)
+			_data[i] = rnd.next();
+
+		// Keep the step indices of the MS IMA block headers in range
+		if (_type == Audio::kADPCMMSIma) {
+			for (uint block = 0; block < _data.size(); block += _blockAlign) {
+				for (int i = 0; i < _channels; i++) {
+					_data[block + i * 4 + 2] %= 89;
+					_data[block + i * 4 + 3] = 0;
+				}
+			}
+		}
+
+		_output.resize(kOutputFrames * 2);
+	}
+
+	virtual void tearDown() {
+		delete _stream;
+		_stream = nullptr;
+	}
+
+	virtual uint64 run() {
+		int samples = 0;
+		while (samples < (int)_output.size()) {
+			if (!_stream || _stream->endOfData()) {
+				delete _stream;
+				_stream = Audio::makeADPCMStream(new Common::MemoryReadStream(_data.begin(), _data.size()), DisposeAfterUse::YES,
+				                                 _data.size(), _type, 22050, _channels, _blockAlign);
+			}
+
+			samples += _stream->readBuffer(_output.begin() + samples, _output.size() - samples);
+		}
+
+		Bench::consume(_output[kOutputFrames]);
+		return (uint64)_output.size() * sizeof(int16);
+	}
+
+private:
+	const Audio::ADPCMType _type;
+	const int _channels;
+	const uint32 _blockAlign;
+	Common::Array<byte> _data;
+	Audio::SeekableAudioStream *_stream;
+	Common::Array<int16> _output;
+};
+
+static ADPCMDecoding s_adpcmDVIMono("audio/adpcm_dvi_mono", Audio::kADPCMDVI, 1, 1024);
+static ADPCMDecoding s_adpcmMSImaStereo("audio/adpcm_ms_ima_stereo", Audio::kADPCMMSIma, 2, 2048);
+static ADPCMDecoding s_adpcmMSMono("audio/adpcm_ms_mono", Audio::kADPCMMS, 1, 1024);
+
+#ifndef DISABLE_SID
+
+/**
+ * Plays notes on the three SID voices, new ones twice a second, with the
+ * registers written once a PAL frame the way Player_SID does.
+ */
+class SIDGeneration : public Bench::Benchmark {
+public:
+	SIDGeneration(const char *name, bool filter) : Bench::Benchmark(name), _filter(filter), _frame(0) {}
+
+	virtual void setUp() {
+		_sid.set_sampling_parameters(985248, kOutputRate);
+		_sid.enable_filter(_filter);
+		_sid.reset();
+		_sid.write(0x17, 0xf1);
+		_sid.write(0x18, 0x1f);
+		_frame = 0;
+		_cycles = 0;
+		_output.resize(kOutputFrames);
+	}
+
+	virtual uint64 run() {
+		static const byte waveforms[3] = { 0x41, 0x21, 0x11 };
+
+		int samples = 0;
+		while (samples < (int)_output.size()) {
+			if (_cycles <= 0) {
+				for (int voice = 0; voice < 3; voice++) {
+					const int base = voice * 7;
+					if (_frame % 25 == voice * 4) {
+						_sid.write(base + 0, (_frame * 37 + voice * 91) & 0xff);
+						_sid.write(base + 1, 8 + ((_frame / 25 + voice * 5) & 0x1f));
+						_sid.write(base + 3, 0x08);
+						_sid.write(base + 5, 0x09);
+						_sid.write(base + 6, 0xa4);
+						_sid.write(base + 4, waveforms[voice]);
+					} else if (_frame % 25 == voice * 4 + 12) {
+						_sid.write(base + 4, waveforms[voice] & 0xfe);
+					}
+				}
+				_frame++;
+				_cycles = 312 * 63;
+			}
+
+			samples += _sid.updateClock(_cycles, _output.begin() + samples, _output.size() - samples);
+		}
+
+		Bench::consume(_output[kOutputFrames / 2]);
+		return (uint64)kOutputFrames * sizeof(int16);
+	}
+
+private:
+	const bool _filter;
+	Resid::SID _sid;
+	int _frame;
+	int _cycles;
+	Common::Array<short> _output;
+};
+
+static SIDGeneration s_sid("audio/sid", false);
+static SIDGeneration s_sidFiltered("audio/sid_filtered", true);
+
+#endif
+
+#ifndef DISABLE_NUKED_OPL
+
+/**
+ * Generates Nuked OPL output with a few notes playing on the first
+ * channels, and all other operators silent, the way most OPL2 music runs.
+ */
+class NukedOPLGeneration : public Bench::Benchmark {
+public:
+	NukedOPLGeneration(const char *name, uint notes) : Bench::Benchmark(name), _notes(notes) {}
+
+	virtual void setUp() {
+		static const uint8 slotOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+
+		OPL::NUKED::OPL3_Reset(&_chip, kOutputRate);
+		for (uint channel = 0; channel < _notes; channel++) {
+			for (uint op = 0; op < 2; op++) {
+				const uint16 slot = slotOffsets[channel] + op * 3;
+				OPL::NUKED::OPL3_WriteReg(&_chip, 0x20 + slot, 0x21);
+				OPL::NUKED::OPL3_WriteReg(&_chip, 0x40 + slot, op ? 0x00 : 0x18);
+				OPL::NUKED::OPL3_WriteReg(&_chip, 0x60 + slot, 0xf2);
+				OPL::NUKED::OPL3_WriteReg(&_chip, 0x80 + slot, 0x44);
+			}
+			OPL::NUKED::OPL3_WriteReg(&_chip, 0xc0 + channel, 0x0e);
+			OPL::NUKED::OPL3_WriteReg(&_chip, 0xa0 + channel, 0x41 + channel * 16);
+			OPL::NUKED::OPL3_WriteReg(&_chip, 0xb0 + channel, 0x32);
+		}
+
+		_output.resize(kOutputFrames * 2);
+	}
+
+	virtual uint64 run() {
+		OPL::NUKED::OPL3_GenerateStream(&_chip, _output.begin(), kOutputFrames);
+
+		Bench::consume(_output[kOutputFrames]);
+		return (uint64)kOutputFrames * 2 * sizeof(int16);
+	}
+
+private:
+	const uint _notes;
+	OPL::NUKED::opl3_chip _chip;
+	Common::Array<int16> _output;
+};
+
+static NukedOPLGeneration s_nukedOPL4Notes("audio/opl_nuked_4_notes", 4);
+static NukedOPLGeneration s_nukedOPL9Notes("audio/opl_nuked_9_notes", 9);
+
+#endif
+
+} // End of anonymous namespace
@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TEST_BENCH_BENCH_H
+#define TEST_BENCH_BENCH_H
+
+#include "common/scummsys.h"
+
+namespace Bench {
+
+/**
+ * A micro-benchmark. Instances register themselves on construction, so a
+ * benchmark is added by defining a subclass and a static instance of it,
+ * see BENCHMARK().
+ *
+ * All input has to be generated from fixed seeds in setUp(), so results
+ * are comparable between runs and machines.
+ */
+class Benchmark {
+public:
+	explicit Benchmark(const char *name);
+	virtual ~Benchmark() {}
+
+	/** Prepare the input. Not timed. */
+	virtual void setUp() {}
+
+	/** Free what setUp() allocated. Not timed. */
+	virtual void tearDown() {}
+
+	/**
+	 * Run one iteration.
+	 * @return the number of bytes processed, for the throughput, or 0
+	 */
+	virtual uint64 run() = 0;
+
+	const char *getName() const { return _name; }
+
+	static Benchmark *getFirst() { return _first; }
+	Benchmark *getNext() const { return _next; }
+
+private:
+	const char *_name;
+	Benchmark *_next;
+
+	static Benchmark *_first;
+	static Benchmark *_last;
+};
+
+/** Keep a value alive, so the compiler can not drop the work producing it. */
+void consume(uint32 value);
+
+/** Deterministic pseudo random numbers for generating input. */
+class Random {
+public:
+	explicit Random(uint32 seed) : _state(seed) {}
+
+	uint32 next() {
+		_state = _state * 1103515245 + 12345;
+		return _state >> 8;
+	}
+
+private:
+	uint32 _state;
+};
+
+} // End of namespace Bench
+
+#define BENCHMARK(cls) static cls s_benchmark##cls
+
+#endif
@@ -0,0 +1,319 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/bench/bench.h"
+
+#include "common/array.h"
+#include "common/bitstream.h"
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/zlib.h"
+
+namespace {
+
+const uint kKeyCount = 4096;
+
+Common::Array<Common::String> makeKeys(uint32 seed) {
+	Bench::Random rnd(seed);
+	Common::Array<Common::String> keys;
+
+	for (uint i = 0; i < kKeyCount; i++)
+		keys.push_back(Common::String::format("resource_%u.%03u", rnd.next() % 100000, i % 1000));
+
+	return keys;
+}
+
+class HashMapInsert : public Bench::Benchmark {
+public:
+	HashMapInsert() : Bench::Benchmark("common/hashmap_insert") {}
+
+	virtual void setUp() { _keys = makeKeys(1); }
+	virtual void tearDown() { _keys.clear(); }
+
+	virtual uint64 run() {
+		Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> map;
+		for (uint i = 0; i < _keys.size(); i++)
+			map[_keys[i]] = i;
+
+		Bench::consume(map.size());
+		return 0;
+	}
+
+private:
+	Common::Array<Common::String> _keys;
+};
+BENCHMARK(HashMapInsert);
+
+class HashMapLookup : public Bench::Benchmark {
+public:
+	HashMapLookup() : Bench::Benchmark("common/hashmap_lookup") {}
+
+	virtual void setUp() {
+		_keys = makeKeys(2);
+		for (uint i = 0; i < _keys.size(); i += 2)
+			_map[_keys[i]] = i;
+	}
+
+	virtual void tearDown() {
+		_keys.clear();
+		_map.clear();
+	}
+
+	// Half of the lookups miss
+	virtual uint64 run() {
+		uint found = 0;
+		for (uint i = 0; i < _keys.size(); i++)
+			found += _map.contains(_keys[i]);
+
+		Bench::consume(found);
+		return 0;
+	}
+
+private:
+	Common::Array<Common::String> _keys;
+	Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _map;
+};
+BENCHMARK(HashMapLookup);
+
+/**
+ * Lookups of small integer keys, as done by the resource caches of the
+ * engines, with the map type as parameter to compare HashMap and FlatHashMap.
+ */
+template<class Map>
+class IntMapLookup : public Bench::Benchmark {
+public:
+	explicit IntMapLookup(const char *name) : Bench::Benchmark(name) {}
+
+	virtual void setUp() {
+		Bench::Random rnd(3);
+		for (uint i = 0; i < kKeyCount; i++) {
+			_keys.push_back(rnd.next() % (kKeyCount * 4));
+			if (i & 1)
+				_map[_keys[i]] = i;
+		}
+	}
+
+	virtual void tearDown() {
+		_keys.clear();
+		_map.clear();
+	}
+
+	virtual uint64 run() {
+		uint found = 0;
+		for (uint i = 0; i < _keys.size(); i++)
+			found += _map.getVal(_keys[i], 0);
+
+		Bench::consume(found);
+		return 0;
+	}
+
+private:
+	Common::Array<int> _keys;
+	Map _map;
+};
+
+static IntMapLookup<Common::HashMap<int, uint> > s_hashMapIntLookup("common/hashmap_int_lookup");
+static IntMapLookup<Common::FlatHashMap<int, uint> > s_flatHashMapIntLookup("common/flathashmap_int_lookup");
+
+class FlatHashMapInsert : public Bench::Benchmark {
+public:
+	FlatHashMapInsert() : Bench::Benchmark("common/flathashmap_insert") {}
+
+	virtual void setUp() { _keys = makeKeys(1); }
+	virtual void tearDown() { _keys.clear(); }
+
+	virtual uint64 run() {
+		Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> map;
+		for (uint i = 0; i < _keys.size(); i++)
+			map[_keys[i]] = i;
+
+		Bench::consume(map.size());
+		return 0;
+	}
+
+private:
+	Common::Array<Common::String> _keys;
+};
+BENCHMARK(FlatHashMapInsert);
+
+class StringOperations : public Bench::Benchmark {
+public:
+	StringOperations() : Bench::Benchmark("common/string_ops") {}
+
+	virtual void setUp() { _keys = makeKeys(3); }
+	virtual void tearDown() { _keys.clear(); }
+
+	// Typical path handling: concatenate, compare and search, case fold
+	virtual uint64 run() {
+		uint64 bytes = 0;
+		uint result = 0;
+
+		for (uint i = 0; i < _keys.size(); i++) {
+			Common::String path = "data/" + _keys[i];
+			path += ".bak";
+			result += path.hasSuffixIgnoreCase(".BAK");
+			result += path.contains("_42");
+			path.toUppercase();
+			result += path.equalsIgnoreCase(_keys[(i + 1) % _keys.size()]);
+			bytes += path.size();
+		}
+
+		Bench::consume(result);
+		return bytes;
+	}
+
+private:
+	Common::Array<Common::String> _keys;
+};
+BENCHMARK(StringOperations);
+
+class HuffmanDecode : public Bench::Benchmark {
+public:
+	enum {
+		kSymbols = 64,
+		kDecodedSymbols = 1 << 16
+	};
+
+	HuffmanDecode() : Bench::Benchmark("common/huffman_decode"), _huffman(nullptr) {}
+
+	// A complete canonical code with lengths of 2 to 12 bits. Symbols are
+	// picked with the probabilities matching their lengths, by matching
+	// random 12 bit values against the code prefixes.
+	virtual void setUp() {
+		static const uint8 kLengthCounts[] = { 0, 0, 1, 2, 3, 4, 5, 6, 8, 10, 7, 2, 16 };
+
+		uint8 lengths[kSymbols];
+		uint32 codes[kSymbols];
+
+		uint symbol = 0;
+		for (uint length = 0; length < ARRAYSIZE(kLengthCounts); length++) {
+			for (uint i = 0; i < kLengthCounts[length]; i++)
+				lengths[symbol++] = length;
+		}
+		assert(symbol == kSymbols);
+
+		uint32 code = 0;
+		for (uint i = 0; i < kSymbols; i++) {
+			if (i > 0)
+				code = (code + 1) << (lengths[i] - lengths[i - 1]);
+			codes[i] = code;
+		}
+
+		_huffman = new Common::Huffman<Common::BitStreamMemory8MSB>(0, kSymbols, codes, lengths);
+
+		Bench::Random rnd(4);
+		uint64 bitBuffer = 0;
+		uint bitCount = 0;
+		for (uint i = 0; i < kDecodedSymbols; i++) {
+			const uint32 value = rnd.next() & 0xFFF;
+
+			uint picked = 0;
+			while ((codes[picked] + 1) << (12 - lengths[picked]) <= value)
+				picked++;
+
+			bitBuffer = (bitBuffer << lengths[picked]) | codes[picked];
+			bitCount += lengths[picked];
+			while (bitCount >= 8) {
+				bitCount -= 8;
+				_data.push_back((byte)(bitBuffer >> bitCount));
+			}
+		}
+		if (bitCount)
+			_data.push_back((byte)(bitBuffer << (8 - bitCount)));
+	}
+
+	virtual void tearDown() {
+		delete _huffman;
+		_huffman = nullptr;
+		_data.clear();
+	}
+
+	virtual uint64 run() {
+		Common::BitStreamMemoryStream stream(_data.begin(), _data.size());
+		Common::BitStreamMemory8MSB bits(stream);
+
+		uint32 sum = 0;
+		for (uint i = 0; i < kDecodedSymbols; i++)
+			sum += _huffman->getSymbol(bits);
+
+		Bench::consume(sum);
+		return _data.size();
+	}
+
+private:
+	Common::Huffman<Common::BitStreamMemory8MSB> *_huffman;
+	Common::Array<byte> _data;
+};
+BENCHMARK(HuffmanDecode);
+
+/**
+ * Writing a savegame sized buffer through the save compression, with data
+ * roughly like a save: runs of zeroes, small counters and repeated strings.
+ */
+class SaveCompression : public Bench::Benchmark {
+public:
+	SaveCompression(const char *name, Common::CompressionMethod method) : Bench::Benchmark(name), _method(method) {}
+
+	virtual void setUp() {
+		Bench::Random rnd(5);
+		static const char *const words[] = { "inventory", "flags", "room", "actor", "script" };
+		while (_data.size() < 256 * 1024) {
+			const uint32 kind = rnd.next() % 4;
+			if (kind == 0) {
+				for (uint i = rnd.next() % 64; i > 0; --i)
+					_data.push_back(0);
+			} else if (kind == 1) {
+				for (const char *w = words[rnd.next() % ARRAYSIZE(words)]; *w; ++w)
+					_data.push_back(*w);
+			} else {
+				_data.push_back(rnd.next() & 0xFF);
+				_data.push_back(rnd.next() & 0x03);
+			}
+		}
+	}
+
+	virtual void tearDown() { _data.clear(); }
+
+	virtual uint64 run() {
+		Common::MemoryWriteStreamDynamic *buffer = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::WriteStream *out = Common::wrapCompressedWriteStream(buffer, _method);
+		out->write(&_data[0], _data.size());
+		out->finalize();
+
+		Bench::consume(buffer->size());
+		delete out;
+		return _data.size();
+	}
+
+private:
+	Common::CompressionMethod _method;
+	Common::Array<byte> _data;
+};
+
+static SaveCompression s_saveGZip("common/save_gzip", Common::kCompressionGZip);
+static SaveCompression s_saveLZ4("common/save_lz4", Common::kCompressionLZ4);
+
+} // End of anonymous namespace
@@ -0,0 +1,174 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/bench/bench.h"
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+#include "graphics/scaler.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include "common/array.h"
+
+namespace {
+
+const int kWidth = 320;
+const int kHeight = 200;
+
+/** Graphics::crossBlit between two formats on a full game screen. */
+class CrossBlit : public Bench::Benchmark {
+public:
+	CrossBlit(const char *name, const Graphics::PixelFormat &src, const Graphics::PixelFormat &dst) :
+		Bench::Benchmark(name), _srcFormat(src), _dstFormat(dst) {}
+
+	virtual void setUp() {
+		Bench::Random rnd(1);
+		_src.resize(kWidth * kHeight * _srcFormat.bytesPerPixel);
+		for (uint i = 0; i < _src.size(); i++)
+			_src[i] = (byte)rnd.next();
+		_dst.resize(kWidth * kHeight * _dstFormat.bytesPerPixel);
+	}
+
+	virtual void tearDown() {
+		_src.clear();
+		_dst.clear();
+	}
+
+	virtual uint64 run() {
+		Graphics::crossBlit(_dst.begin(), _src.begin(),
+		                    kWidth * _dstFormat.bytesPerPixel, kWidth * _srcFormat.bytesPerPixel,
+		                    kWidth, kHeight, _dstFormat, _srcFormat);
+		Bench::consume(_dst[_dst.size() / 2]);
+		return _src.size();
+	}
+
+private:
+	const Graphics::PixelFormat _srcFormat;
+	const Graphics::PixelFormat _dstFormat;
+	Common::Array<byte> _src;
+	Common::Array<byte> _dst;
+};
+
+static CrossBlit s_blit565To8888("graphics/crossblit_565_to_8888",
+                                 Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+                                 Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+static CrossBlit s_blit8888To565("graphics/crossblit_8888_to_565",
+                                 Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+                                 Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+static CrossBlit s_blitRGBAToABGR("graphics/crossblit_rgba_to_abgr",
+                                  Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+                                  Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
+
+/** YUVToRGBManager::convert420 of a full game screen video frame. */
+class YUV420ToRGB : public Bench::Benchmark {
+public:
+	YUV420ToRGB(const char *name, const Graphics::PixelFormat &dst) :
+		Bench::Benchmark(name), _dstFormat(dst) {}
+
+	virtual void setUp() {
+		Bench::Random rnd(1);
+		_src.resize(kWidth * kHeight * 3 / 2);
+		for (uint i = 0; i < _src.size(); i++)
+			_src[i] = (byte)rnd.next();
+		_dst.create(kWidth, kHeight, _dstFormat);
+	}
+
+	virtual void tearDown() {
+		_src.clear();
+		_dst.free();
+	}
+
+	virtual uint64 run() {
+		const byte *ySrc = _src.begin();
+		const byte *uSrc = ySrc + kWidth * kHeight;
+		const byte *vSrc = uSrc + kWidth * kHeight / 4;
+		YUVToRGBMan.convert420(&_dst, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, kWidth, kHeight, kWidth, kWidth / 2);
+		Bench::consume(*(const byte *)_dst.getBasePtr(kWidth / 2, kHeight / 2));
+		return _src.size();
+	}
+
+private:
+	const Graphics::PixelFormat _dstFormat;
+	Common::Array<byte> _src;
+	Graphics::Surface _dst;
+};
+
+static YUV420ToRGB s_yuv420To565("graphics/yuv420_to_565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+static YUV420ToRGB s_yuv420To8888("graphics/yuv420_to_8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+
+#ifdef USE_SCALERS
+
+/**
+ * A scaler on an RGB565 game screen. The source has a border on each side,
+ * since several scalers read the pixels around the scaled area.
+ */
+class Scaler : public Bench::Benchmark {
+public:
+	Scaler(const char *name, ScalerProc *proc, int factor) :
+		Bench::Benchmark(name), _proc(proc), _factor(factor) {}
+
+	virtual void setUp() {
+		InitScalers(565);
+
+		Bench::Random rnd(2);
+		_src.resize(kSrcPitch / 2 * (kHeight + 2 * kBorder));
+		for (uint i = 0; i < _src.size(); i++)
+			_src[i] = (uint16)rnd.next();
+		_dst.resize(kWidth * _factor * kHeight * _factor);
+	}
+
+	virtual void tearDown() {
+		_src.clear();
+		_dst.clear();
+		DestroyScalers();
+	}
+
+	virtual uint64 run() {
+		const uint8 *src = (const uint8 *)&_src[kBorder * kSrcPitch / 2 + kBorder];
+		_proc(src, kSrcPitch, (uint8 *)_dst.begin(), kWidth * _factor * 2, kWidth, kHeight);
+		Bench::consume(_dst[_dst.size() / 2]);
+		return kWidth * kHeight * 2;
+	}
+
+private:
+	static const int kBorder = 4;
+	static const uint32 kSrcPitch = (kWidth + 2 * kBorder) * 2;
+
+	ScalerProc *const _proc;
+	const int _factor;
+	Common::Array<uint16> _src;
+	Common::Array<uint16> _dst;
+};
+
+static Scaler s_normal2x("graphics/scaler_normal2x", Normal2x, 2);
+static Scaler s_advMame2x("graphics/scaler_advmame2x", AdvMame2x, 2);
+static Scaler s_2xSaI("graphics/scaler_2xsai", _2xSaI, 2);
+static Scaler s_tv2x("graphics/scaler_tv2x", TV2x, 2);
+#ifdef USE_HQ_SCALERS
+static Scaler s_hq2x("graphics/scaler_hq2x", HQ2x, 2);
+static Scaler s_hq3x("graphics/scaler_hq3x", HQ3x, 3);
+#endif
+
+#endif // USE_SCALERS
+
+} // End of anonymous namespace
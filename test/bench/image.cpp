@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/bench/bench.h"
+
+#ifdef USE_PNG
+
+#include "image/png.h"
+
+#include "graphics/surface.h"
+
+#include "common/memstream.h"
+
+namespace {
+
+/**
+ * Decodes a 640x480 truecolor PNG. The image is encoded in setUp() from a
+ * gradient with some noise, which compresses roughly like game artwork.
+ */
+class PNGDecode : public Bench::Benchmark {
+public:
+	PNGDecode() : Bench::Benchmark("image/png_decode"), _data(nullptr), _size(0) {}
+
+	virtual void setUp() {
+		Graphics::Surface surface;
+		surface.create(kWidth, kHeight, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+		Bench::Random rnd(3);
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				const uint32 noise = rnd.next() & 0x0F;
+				*(uint32 *)surface.getBasePtr(x, y) = surface.format.RGBToColor(x * 255 / kWidth, y * 255 / kHeight, noise << 4);
+			}
+		}
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+		Image::writePNG(out, surface);
+		surface.free();
+
+		_data = out.getData();
+		_size = out.size();
+	}
+
+	virtual void tearDown() {
+		free(_data);
+		_data = nullptr;
+	}
+
+	virtual uint64 run() {
+		Common::MemoryReadStream stream(_data, _size);
+		Image::PNGDecoder decoder;
+		decoder.loadStream(stream);
+		Bench::consume(*(const uint32 *)decoder.getSurface()->getBasePtr(kWidth / 2, kHeight / 2));
+		return kWidth * kHeight * 4;
+	}
+
+private:
+	static const int kWidth = 640;
+	static const int kHeight = 480;
+
+	byte *_data;
+	uint32 _size;
+};
+
+BENCHMARK(PNGDecode);
+
+} // End of anonymous namespace
+
+#endif // USE_PNG
@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Runs the micro-benchmarks and prints their results as tab separated
+// values, one line per benchmark. Use "make bench" to build and run it.
+// Arguments, if given, select the benchmarks whose names contain one of them.
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/bench/bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+namespace Bench {
+
+Benchmark *Benchmark::_first = nullptr;
+Benchmark *Benchmark::_last = nullptr;
+
+Benchmark::Benchmark(const char *name) : _name(name), _next(nullptr) {
+	if (_last)
+		_last->_next = this;
+	else
+		_first = this;
+	_last = this;
+}
+
+static volatile uint32 s_sink;
+
+void consume(uint32 value) {
+	s_sink = s_sink + value;
+}
+
+} // End of namespace Bench
+
+namespace {
+
+// The best of several samples is reported, which is the most repeatable
+const int kSamples = 5;
+const double kMinSampleSeconds = 0.05;
+
+double getSeconds() {
+#ifdef POSIX
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+double timeIterations(Bench::Benchmark &bench, uint64 iterations, uint64 &bytes) {
+	bytes = 0;
+
+	const double start = getSeconds();
+	for (uint64 i = 0; i < iterations; i++)
+		bytes += bench.run();
+	return getSeconds() - start;
+}
+
+bool isSelected(const Bench::Benchmark &bench, int argc, char **argv) {
+	if (argc < 2)
+		return true;
+
+	for (int i = 1; i < argc; i++) {
+		if (strstr(bench.getName(), argv[i]))
+			return true;
+	}
+
+	return false;
+}
+
+} // End of anonymous namespace
+
+int main(int argc, char **argv) {
+	printf("# benchmark\titerations\tns_per_iteration\tmb_per_second\n");
+
+	for (Bench::Benchmark *bench = Bench::Benchmark::getFirst(); bench; bench = bench->getNext()) {
+		if (!isSelected(*bench, argc, argv))
+			continue;
+
+		bench->setUp();
+
+		// Grow the iteration count until one sample takes long enough
+		uint64 iterations = 1, bytes;
+		while (timeIterations(*bench, iterations, bytes) < kMinSampleSeconds)
+			iterations *= 2;
+
+		double best = 0.0;
+		for (int i = 0; i < kSamples; i++) {
+			const double seconds = timeIterations(*bench, iterations, bytes);
+			if (!i || seconds < best)
+				best = seconds;
+		}
+
+		bench->tearDown();
+
+		printf("%s\t%llu\t%.1f\t%.2f\n", bench->getName(), (unsigned long long)iterations,
+		       best * 1e9 / iterations, bytes / best / (1024.0 * 1024.0));
+		fflush(stdout);
+	}
+
+	return 0;
+}
@@ -0,0 +1,38 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atomic.h"
+
+/**
+ * Test suite for the single-threaded behavior of Common::AtomicInt32
+ */
+class AtomicTestSuite : public CxxTest::TestSuite {
+public:
+	void test_load_store() {
+		Common::AtomicInt32 value;
+		TS_ASSERT_EQUALS(value.load(), 0);
+
+		value.store(-42);
+		TS_ASSERT_EQUALS(value.load(), -42);
+
+		Common::AtomicInt32 initialized(7);
+		TS_ASSERT_EQUALS(initialized.load(), 7);
+	}
+
+	void test_compare_exchange() {
+		Common::AtomicInt32 value(5);
+
+		TS_ASSERT(!value.compareExchange(4, 10));
+		TS_ASSERT_EQUALS(value.load(), 5);
+
+		TS_ASSERT(value.compareExchange(5, 10));
+		TS_ASSERT_EQUALS(value.load(), 10);
+	}
+
+	void test_fetch_add() {
+		Common::AtomicInt32 value(0x7ffffffe);
+
+		TS_ASSERT_EQUALS(value.fetchAdd(1), 0x7ffffffe);
+		TS_ASSERT_EQUALS(value.fetchAdd(-3), 0x7fffffff);
+		TS_ASSERT_EQUALS(value.load(), 0x7ffffffc);
+	}
+};
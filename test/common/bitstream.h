@@ -255,4 +255,50 @@ public:
 		tmpl_align_16<Common::MemoryReadStream, Common::BitStream16BELSB>();
 		tmpl_align_16<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
 	}
+private:
+	template<class MS, class BS, class FastBS>
+	void tmpl_fast_refill() {
+		byte contents[70];
+		for (uint i = 0; i < sizeof(contents); i++)
+			contents[i] = (byte)(i * 37 + 11);
+
+		MS ms(contents, sizeof(contents));
+		MS fastMs(contents, sizeof(contents));
+
+		BS bs(ms);
+		FastBS fastBs(fastMs);
+		TS_ASSERT_EQUALS(bs.size(), fastBs.size());
+
+		// Walk past the end, so that the slow path at the tail is covered
+		uint n = 0;
+		while (bs.pos() < bs.size() + 64) {
+			TS_ASSERT_EQUALS(bs.peekBits(32), fastBs.peekBits(32));
+			TS_ASSERT_EQUALS(bs.getBits(n), fastBs.getBits(n));
+			TS_ASSERT_EQUALS(bs.pos(), fastBs.pos());
+			n = (n + 7) % 33;
+		}
+
+		bs.rewind();
+		fastBs.rewind();
+		bs.skip(123);
+		fastBs.skip(123);
+		TS_ASSERT_EQUALS(bs.getBits(17), fastBs.getBits(17));
+	}
+public:
+	void test_fast_refill() {
+		tmpl_fast_refill<Common::MemoryReadStream, Common::BitStream32LELSB, Common::BitStream32LELSBFast>();
+		tmpl_fast_refill<Common::MemoryReadStream, Common::BitStream32BEMSB, Common::BitStream32BEMSBFast>();
+		tmpl_fast_refill<Common::MemoryReadStream, Common::BitStream8MSB,
+			Common::BitStreamImpl<Common::SeekableReadStream, 8, false, true, true> >();
+		tmpl_fast_refill<Common::MemoryReadStream, Common::BitStream16LEMSB,
+			Common::BitStreamImpl<Common::SeekableReadStream, 16, true, true, true> >();
+		tmpl_fast_refill<Common::MemoryReadStream, Common::BitStream16BELSB,
+			Common::BitStreamImpl<Common::SeekableReadStream, 16, false, false, true> >();
+		tmpl_fast_refill<Common::MemoryReadStream, Common::BitStream32LEMSB,
+			Common::BitStreamImpl<Common::SeekableReadStream, 32, true, true, true> >();
+		tmpl_fast_refill<Common::BitStreamMemoryStream, Common::BitStreamMemory32BELSB,
+			Common::BitStreamImpl<Common::BitStreamMemoryStream, 32, false, false, true> >();
+		tmpl_fast_refill<Common::BitStreamMemoryStream, Common::BitStreamMemory8LSB,
+			Common::BitStreamImpl<Common::BitStreamMemoryStream, 8, false, false, true> >();
+	}
 };
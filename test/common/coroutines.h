@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/coroutines.h"
+
+namespace {
+
+int s_steps;
+int s_contexts;
+
+void countingProcess(CORO_PARAM, const void *param) {
+	CORO_BEGIN_CONTEXT;
+		int i;
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	for (_ctx->i = 0; _ctx->i < *(const int *)param; ++_ctx->i) {
+		++s_steps;
+		CORO_SLEEP(1);
+	}
+
+	CORO_END_CODE;
+}
+
+void nestedStep(CORO_PARAM, int count) {
+	CORO_BEGIN_CONTEXT;
+		int i;
+		~CoroContextTag() { --s_contexts; }
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	++s_contexts;
+	for (_ctx->i = 0; _ctx->i < count; ++_ctx->i) {
+		++s_steps;
+		CORO_SLEEP(1);
+	}
+
+	CORO_END_CODE;
+}
+
+void nestedProcess(CORO_PARAM, const void *param) {
+	CORO_BEGIN_CONTEXT;
+		~CoroContextTag() { --s_contexts; }
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	++s_contexts;
+	CORO_INVOKE_1(nestedStep, *(const int *)param);
+	CORO_INVOKE_1(nestedStep, *(const int *)param);
+
+	CORO_END_CODE;
+}
+
+void killSelfStep(CORO_PARAM) {
+	CORO_BEGIN_CONTEXT;
+		~CoroContextTag() { --s_contexts; }
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	++s_contexts;
+	CORO_SLEEP(1);
+	CORO_KILL_SELF();
+	// Never reached
+	s_steps += 100;
+
+	CORO_END_CODE;
+}
+
+void killSelfProcess(CORO_PARAM, const void *) {
+	CORO_BEGIN_CONTEXT;
+		~CoroContextTag() { --s_contexts; }
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	++s_contexts;
+	CORO_INVOKE_0(killSelfStep);
+	// Never reached
+	s_steps += 100;
+
+	CORO_END_CODE;
+}
+
+} // End of anonymous namespace
+
+class CoroutinesTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+		CoroScheduler.reset();
+		s_steps = 0;
+		s_contexts = 0;
+	}
+
+	void tearDown() {
+		CoroScheduler.reset();
+	}
+
+	void test_processes_run_until_done() {
+		const int three = 3;
+		const int five = 5;
+		const uint32 pid = CoroScheduler.createProcess(countingProcess, &three, sizeof(three));
+		CoroScheduler.createProcess(countingProcess, &five, sizeof(five));
+
+		for (int i = 0; i < 4; ++i)
+			CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 7);
+		// The first process has finished
+		TS_ASSERT_EQUALS(CoroScheduler.killMatchingProcess(pid), 0);
+
+		for (int i = 0; i < 4; ++i)
+			CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 8);
+	}
+
+	void test_nested_coroutines() {
+		const int two = 2;
+		CoroScheduler.createProcess(nestedProcess, &two, sizeof(two));
+
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 1);
+		TS_ASSERT_EQUALS(s_contexts, 2);
+
+		for (int i = 0; i < 5; ++i)
+			CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 4);
+		TS_ASSERT_EQUALS(s_contexts, 0);
+	}
+
+	void test_kill_sleeping_process() {
+		const int ten = 10;
+		const uint32 pid = CoroScheduler.createProcess(nestedProcess, &ten, sizeof(ten));
+		CoroScheduler.createProcess(countingProcess, &ten, sizeof(ten));
+
+		CoroScheduler.schedule();
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 4);
+		TS_ASSERT_EQUALS(s_contexts, 2);
+
+		// Killing a process destroys the contexts of all its active frames
+		TS_ASSERT_EQUALS(CoroScheduler.killMatchingProcess(pid), 1);
+		TS_ASSERT_EQUALS(s_contexts, 0);
+
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 5);
+
+		// Processes created afterwards reuse the freed process slot
+		const int one = 1;
+		CoroScheduler.createProcess(nestedProcess, &one, sizeof(one));
+		for (int i = 0; i < 3; ++i)
+			CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 10);
+		TS_ASSERT_EQUALS(s_contexts, 0);
+	}
+
+	void test_kill_self() {
+		CoroScheduler.createProcess(killSelfProcess, nullptr, 0);
+
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_contexts, 2);
+
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_contexts, 0);
+		TS_ASSERT_EQUALS(s_steps, 0);
+
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 0);
+	}
+
+	void test_reset_kills_processes() {
+		const int ten = 10;
+		CoroScheduler.createProcess(nestedProcess, &ten, sizeof(ten));
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_contexts, 2);
+
+		CoroScheduler.reset();
+		TS_ASSERT_EQUALS(s_contexts, 0);
+
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(s_steps, 1);
+	}
+};
@@ -0,0 +1,158 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/dcl.h"
+#include "common/memstream.h"
+
+class DCLTestSuite : public CxxTest::TestSuite
+{
+	/** Writes DCL data, using only the codes of short lengths and distances */
+	class Writer {
+	public:
+		Writer(byte mode, byte dictionaryType) : _dictionaryType(dictionaryType), _bits(0), _nBits(0) {
+			writeBits(mode, 8);
+			writeBits(dictionaryType, 8);
+		}
+
+		void literal(byte value) {
+			writeBits(0, 1);
+			writeBits(value, 8);
+		}
+
+		void asciiSpace() {
+			writeCode("01111");
+		}
+
+		// length has to be 2 to 5, distance 1 to 2 << dictionaryType
+		void match(uint length, uint distance) {
+			static const char *const lengthCodes[] = { "101", "11", "100", "011" };
+			writeBits(1, 1);
+			writeCode(lengthCodes[length - 2]);
+
+			const uint extraBits = (length == 2) ? 2 : _dictionaryType;
+			const uint value = (distance - 1) >> extraBits;
+			writeCode(value ? "1011" : "11");
+			writeBits((distance - 1) & ((1 << extraBits) - 1), extraBits);
+		}
+
+		const Common::Array<byte> &finish() {
+			writeCode("10000000");
+			writeBits(0xFF, 8);
+			if (_nBits)
+				_data.push_back(_bits);
+			return _data;
+		}
+
+	private:
+		void writeBits(uint32 value, uint count) {
+			for (uint i = 0; i < count; i++) {
+				_bits |= ((value >> i) & 1) << _nBits;
+				if (++_nBits == 8) {
+					_data.push_back(_bits);
+					_bits = 0;
+					_nBits = 0;
+				}
+			}
+		}
+
+		void writeCode(const char *code) {
+			for (; *code; code++)
+				writeBits(*code == '1', 1);
+		}
+
+		const byte _dictionaryType;
+		byte _bits;
+		uint _nBits;
+		Common::Array<byte> _data;
+	};
+
+	static Common::String decompress(const Common::Array<byte> &packed, uint32 unpackedSize) {
+		Common::Array<char> dest(unpackedSize + 1);
+		dest[unpackedSize] = 0;
+		if (!Common::decompressDCL(packed.begin(), packed.size(), (byte *)dest.begin(), unpackedSize))
+			return "<failed>";
+		return dest.begin();
+	}
+
+	public:
+	void test_binary() {
+		Writer writer(0, 4);
+		writer.literal('A');
+		writer.match(3, 1);
+		writer.literal('B');
+		writer.match(2, 2);
+		writer.match(4, 7);
+		const Common::Array<byte> &packed = writer.finish();
+
+		TS_ASSERT_EQUALS(decompress(packed, 11), "AAAABABAAAA");
+
+		// Decoding stops once the given size is reached
+		TS_ASSERT_EQUALS(decompress(packed, 5), "AAAAB");
+		// and fails when the data ends early, or a match does not fit
+		TS_ASSERT_EQUALS(decompress(packed, 12), "<failed>");
+		TS_ASSERT_EQUALS(decompress(packed, 9), "<failed>");
+	}
+
+	void test_ascii() {
+		Writer writer(1, 6);
+		writer.asciiSpace();
+		writer.asciiSpace();
+		writer.match(5, 2);
+		TS_ASSERT_EQUALS(decompress(writer.finish(), 7), "       ");
+	}
+
+	void test_errors() {
+		Writer writer(0, 4);
+		writer.literal('A');
+		writer.match(3, 2);
+		TS_ASSERT_EQUALS(decompress(writer.finish(), 4), "<failed>");
+
+		const byte badMode[] = { 2, 4, 0, 0 };
+		byte dest[4];
+		TS_ASSERT(!Common::decompressDCL(badMode, sizeof(badMode), dest, sizeof(dest)));
+
+		const byte badDictionary[] = { 0, 3, 0, 0 };
+		TS_ASSERT(!Common::decompressDCL(badDictionary, sizeof(badDictionary), dest, sizeof(dest)));
+	}
+
+	void test_streams() {
+		// Pseudo random literals and matches, with a reference decoding
+		Writer writer(0, 4);
+		Common::Array<byte> expected;
+		uint32 seed = 1;
+		while (expected.size() < 20000) {
+			seed = seed * 1103515245 + 12345;
+			const uint length = 2 + ((seed >> 8) & 3);
+			const uint distance = 1 + ((seed >> 12) % (length == 2 ? 4 : 32));
+
+			if (expected.size() < distance || ((seed >> 20) & 3) == 0) {
+				writer.literal(seed >> 24);
+				expected.push_back(seed >> 24);
+			} else {
+				writer.match(length, distance);
+				for (uint i = 0; i < length; i++)
+					expected.push_back(expected[expected.size() - distance]);
+			}
+		}
+		const Common::Array<byte> &packed = writer.finish();
+
+		Common::Array<byte> dest(expected.size());
+		TS_ASSERT(Common::decompressDCL(packed.begin(), packed.size(), dest.begin(), dest.size()));
+		TS_ASSERT(dest == expected);
+
+		Common::MemoryReadStream source(packed.begin(), packed.size());
+		Common::SeekableReadStream *unpacked = Common::decompressDCL(&source, packed.size(), expected.size());
+		TS_ASSERT(unpacked);
+		TS_ASSERT_EQUALS(source.pos(), (int32)packed.size());
+		TS_ASSERT(unpacked && !memcmp(((Common::MemoryReadStream *)unpacked)->getDataPointer(), expected.begin(), expected.size()));
+		delete unpacked;
+
+		// The variant without a known size still uses the stream decoder
+		source.seek(0);
+		unpacked = Common::decompressDCL(&source);
+		TS_ASSERT(unpacked);
+		TS_ASSERT_EQUALS(unpacked->size(), (int32)expected.size());
+		TS_ASSERT(unpacked && !memcmp(((Common::MemoryReadStream *)unpacked)->getDataPointer(), expected.begin(), expected.size()));
+		delete unpacked;
+	}
+};
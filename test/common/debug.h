@@ -0,0 +1,66 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+
+class DebugTestSuite : public CxxTest::TestSuite {
+	int _oldLevel;
+	uint32 _oldChannels;
+
+	enum {
+		kChannelA = 1 << 0,
+		kChannelB = 1 << 1
+	};
+
+public:
+	void setUp() {
+		_oldLevel = gDebugLevel;
+		_oldChannels = gDebugChannelsEnabled;
+	}
+
+	void tearDown() {
+		gDebugLevel = _oldLevel;
+		gDebugChannelsEnabled = _oldChannels;
+	}
+
+	void test_nothing_enabled() {
+		gDebugLevel = -1;
+		gDebugChannelsEnabled = 0;
+
+		TS_ASSERT(!debugLevelSet(0));
+		TS_ASSERT(!debugChannelSet(-1, kChannelA));
+		TS_ASSERT(!debugChannelSet(0, kChannelA));
+		TS_ASSERT(!debugCEnabled(0, kChannelA));
+		TS_ASSERT(!debugCEnabled(kChannelA));
+	}
+
+	void test_level_and_channel() {
+		gDebugLevel = 3;
+		gDebugChannelsEnabled = kChannelA;
+
+		TS_ASSERT(debugLevelSet(3));
+		TS_ASSERT(!debugLevelSet(4));
+
+		TS_ASSERT(debugCEnabled(3, kChannelA));
+		TS_ASSERT(debugCEnabled(2, kChannelA | kChannelB));
+		TS_ASSERT(!debugCEnabled(4, kChannelA));
+		TS_ASSERT(!debugCEnabled(1, kChannelB));
+		TS_ASSERT(debugCEnabled(kChannelA));
+		TS_ASSERT(!debugCEnabled(kChannelB));
+
+		TS_ASSERT(debugChannelSet(-1, kChannelA));
+		TS_ASSERT(debugChannelSet(3, kChannelA));
+		TS_ASSERT(!debugChannelSet(4, kChannelA));
+		TS_ASSERT(!debugChannelSet(-1, kChannelB));
+	}
+
+	void test_level_11_enables_all_channels() {
+		gDebugLevel = 11;
+		gDebugChannelsEnabled = 0;
+
+		TS_ASSERT(debugCEnabled(5, kChannelB));
+		TS_ASSERT(debugCEnabled(kChannelB));
+		TS_ASSERT(debugChannelSet(5, kChannelB));
+		// Only really enabled channels count without a level
+		TS_ASSERT(!debugChannelSet(-1, kChannelB));
+	}
+};
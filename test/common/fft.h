@@ -0,0 +1,56 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fft.h"
+
+class FFTTestSuite : public CxxTest::TestSuite
+{
+private:
+	// Compare against a plain O(n^2) DFT
+	void checkFFT(int bits, int inverse) {
+		const int n = 1 << bits;
+
+		Common::Complex *data = new Common::Complex[n];
+		Common::Complex *expected = new Common::Complex[n];
+
+		for (int i = 0; i < n; i++) {
+			data[i].re = (float)((i * 17 + 3) % 29) / 29.0f - 0.5f;
+			data[i].im = (float)((i * 11 + 7) % 23) / 23.0f - 0.5f;
+		}
+
+		const double sign = inverse ? 1.0 : -1.0;
+		for (int k = 0; k < n; k++) {
+			double re = 0.0, im = 0.0;
+			for (int j = 0; j < n; j++) {
+				const double angle = sign * 2.0 * M_PI * (double)((j * k) % n) / n;
+				re += data[j].re * cos(angle) - data[j].im * sin(angle);
+				im += data[j].re * sin(angle) + data[j].im * cos(angle);
+			}
+			expected[k].re = (float)re;
+			expected[k].im = (float)im;
+		}
+
+		Common::FFT fft(bits, inverse);
+		fft.permute(data);
+		fft.calc(data);
+
+		const float tolerance = 1e-4f * n;
+		for (int k = 0; k < n; k++) {
+			TS_ASSERT_DELTA(data[k].re, expected[k].re, tolerance);
+			TS_ASSERT_DELTA(data[k].im, expected[k].im, tolerance);
+		}
+
+		delete[] data;
+		delete[] expected;
+	}
+
+public:
+	void test_forward() {
+		for (int bits = 2; bits <= 11; bits++)
+			checkFFT(bits, 0);
+	}
+
+	void test_inverse() {
+		for (int bits = 2; bits <= 11; bits++)
+			checkFFT(bits, 1);
+	}
+};
@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		TS_ASSERT(container2.contains("FOO"));
+		TS_ASSERT_EQUALS(container2["QUUX"], "blub");
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container.setVal(2, 45);
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef[1], -1);
+		TS_ASSERT_EQUALS(containerRef.getVal(2), 45);
+		TS_ASSERT_EQUALS(containerRef.getVal(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getVal(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17, -10), -10);
+		TS_ASSERT_EQUALS(containerRef.size(), 3U);
+		TS_ASSERT(containerRef.find(17) == containerRef.end());
+		TS_ASSERT_EQUALS(containerRef.find(2)->_value, 45);
+	}
+
+	void test_erase_full_group() {
+		// Fill the storage far enough that groups overflow, so lookups have
+		// to probe past full groups and erased slots stay marked.
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 1000; ++i)
+			container[i] = i * 3;
+		for (int i = 0; i < 1000; i += 2)
+			container.erase(i);
+
+		TS_ASSERT_EQUALS(container.size(), 500U);
+		for (int i = 0; i < 1000; ++i) {
+			TS_ASSERT_EQUALS(container.contains(i), (i & 1) != 0);
+			if (i & 1)
+				TS_ASSERT_EQUALS(container.getVal(i), i * 3);
+		}
+
+		// Reinserting reuses the erased slots
+		for (int i = 0; i < 1000; i += 2)
+			container[i] = -i;
+		TS_ASSERT_EQUALS(container.size(), 1000U);
+		for (int i = 0; i < 1000; ++i)
+			TS_ASSERT_EQUALS(container.getVal(i), (i & 1) ? i * 3 : -i);
+	}
+
+	void test_against_hashmap() {
+		// Random inserts and erases, checked against HashMap
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> reference;
+
+		uint32 seed = 1;
+		for (int i = 0; i < 20000; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const uint key = (seed >> 16) % 700;
+			if ((seed >> 8) & 3) {
+				flat[key] = i;
+				reference[key] = i;
+			} else {
+				flat.erase(key);
+				reference.erase(key);
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (uint key = 0; key < 700; ++key) {
+			TS_ASSERT_EQUALS(flat.contains(key), reference.contains(key));
+			TS_ASSERT_EQUALS(flat.getVal(key, 0xFFFFFFFF), reference.getVal(key, 0xFFFFFFFF));
+		}
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator j = flat.begin(); j != flat.end(); ++j) {
+			TS_ASSERT_EQUALS(reference.getVal(j->_key, 0xFFFFFFFF), j->_value);
+			count++;
+		}
+		TS_ASSERT_EQUALS(count, flat.size());
+	}
+
+	void test_erase_while_iterating() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 100; ++i)
+			container[i] = i;
+
+		for (Common::FlatHashMap<int, int>::iterator i = container.begin(); i != container.end(); ++i) {
+			if (i->_key % 3)
+				container.erase(i);
+		}
+
+		TS_ASSERT_EQUALS(container.size(), 34U);
+		for (int i = 0; i < 100; ++i)
+			TS_ASSERT_EQUALS(container.contains(i), (i % 3) == 0);
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<int, Common::String> map1;
+		for (int i = 0; i < 50; ++i)
+			map1[i] = Common::String::format("%d", i);
+		map1.erase(7);
+
+		Common::FlatHashMap<int, Common::String> map2(map1), map3;
+		map3[1000] = "gone";
+		map3 = map1;
+		map1.clear();
+
+		TS_ASSERT_EQUALS(map2.size(), 49U);
+		TS_ASSERT_EQUALS(map3.size(), 49U);
+		TS_ASSERT(!map3.contains(1000));
+		TS_ASSERT(!map2.contains(7));
+		TS_ASSERT_EQUALS(map2[23], "23");
+		TS_ASSERT_EQUALS(map3[42], "42");
+	}
+};
@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/framearena.h"
+#include "common/rect.h"
+
+class FrameArenaTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_allocate() {
+		Common::FrameArena arena(256);
+
+		byte *a = (byte *)arena.allocate(10);
+		byte *b = (byte *)arena.allocate(10);
+		TS_ASSERT(a != b);
+		TS_ASSERT_EQUALS(((uintptr)b) & 15, 0U);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 20U);
+
+		void *aligned = arena.allocate(1, 64);
+		TS_ASSERT_EQUALS(((uintptr)aligned) & 63, 0U);
+
+		memset(a, 0xAA, 10);
+		memset(b, 0x55, 10);
+		TS_ASSERT_EQUALS(a[9], 0xAA);
+		TS_ASSERT_EQUALS(b[0], 0x55);
+	}
+
+	void test_large_allocation() {
+		Common::FrameArena arena(64);
+
+		byte *big = (byte *)arena.allocate(1000);
+		memset(big, 1, 1000);
+		byte *small = (byte *)arena.allocate(8);
+		memset(small, 2, 8);
+		TS_ASSERT_EQUALS(big[999], 1);
+		TS_ASSERT(small < big || small >= big + 1000);
+		TS_ASSERT(arena.getCapacity() >= 1008U);
+	}
+
+	void test_reset_merges_pages() {
+		Common::FrameArena arena(128);
+
+		for (int i = 0; i < 20; ++i)
+			arena.allocate(100);
+		const size_t capacity = arena.getCapacity();
+		TS_ASSERT(capacity >= 2000U);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+
+		// The next frame fits into the merged page
+		byte *first = (byte *)arena.allocate(100);
+		for (int i = 1; i < 20; ++i) {
+			byte *next = (byte *)arena.allocate(100);
+			TS_ASSERT(next > first);
+		}
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+	}
+
+	void test_placement_new() {
+		Common::FrameArena arena;
+
+		Common::Rect *rect = new (arena) Common::Rect(1, 2, 3, 4);
+		TS_ASSERT_EQUALS(rect->left, 1);
+		TS_ASSERT_EQUALS(rect->bottom, 4);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), sizeof(Common::Rect));
+	}
+
+	void test_arena_array() {
+		Common::FrameArena arena(256);
+		Common::ArenaArray<Common::Rect> rects(arena);
+		TS_ASSERT(rects.empty());
+
+		for (int i = 0; i < 100; ++i)
+			rects.push_back(Common::Rect(i, i, i + 10, i + 20));
+		TS_ASSERT_EQUALS(rects.size(), 100U);
+
+		int sum = 0;
+		for (Common::ArenaArray<Common::Rect>::const_iterator i = rects.begin(); i != rects.end(); ++i)
+			sum += i->left;
+		TS_ASSERT_EQUALS(sum, 99 * 100 / 2);
+		TS_ASSERT_EQUALS(rects[42].bottom, 62);
+		TS_ASSERT_EQUALS(rects.back().right, 109);
+
+		rects.pop_back();
+		TS_ASSERT_EQUALS(rects.size(), 99U);
+		rects.clear();
+		TS_ASSERT(rects.empty());
+	}
+};
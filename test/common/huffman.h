@@ -94,4 +94,52 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	void test_get_long_codes() {
+
+		/*
+		 * Codes longer than the first lookup level, in both bit orders.
+		 * Code k (k < 23) is k ones followed by a zero, the last one is all
+		 * ones: 0, 10, 110, ..., 1111111111111111111111 (22 bits).
+		 */
+
+		const uint32 codeCount = 23;
+		uint8 lengths[codeCount];
+		uint32 codes[codeCount];
+		uint32 symbols[codeCount];
+		for (uint32 i = 0; i < codeCount; i++) {
+			lengths[i] = MIN<uint32>(i + 1, codeCount - 1);
+			codes[i] = (i < codeCount - 1) ? ((1 << i) - 1) << 1 : (1 << (codeCount - 1)) - 1;
+			symbols[i] = 100 + i;
+		}
+
+		const uint32 sequence[] = {22, 0, 9, 10, 21, 3, 15, 1, 0, 22};
+
+		byte msb[32] = {}, lsb[32] = {};
+		uint32 pos = 0;
+		for (uint32 i = 0; i < ARRAYSIZE(sequence); i++) {
+			uint32 code = codes[sequence[i]];
+			for (int bit = lengths[sequence[i]] - 1; bit >= 0; bit--, pos++) {
+				if ((code >> bit) & 1) {
+					msb[pos / 8] |= 0x80 >> (pos % 8);
+					lsb[pos / 8] |= 1 << (pos % 8);
+				}
+			}
+		}
+
+		Common::Huffman<Common::BitStream8MSB> hMSB(0, codeCount, codes, lengths, symbols);
+		Common::MemoryReadStream msMSB(msb, sizeof(msb));
+		Common::BitStream8MSB bsMSB(msMSB);
+
+		Common::Huffman<Common::BitStream8LSB> hLSB(0, codeCount, codes, lengths, symbols);
+		Common::MemoryReadStream msLSB(lsb, sizeof(lsb));
+		Common::BitStream8LSB bsLSB(msLSB);
+
+		for (uint32 i = 0; i < ARRAYSIZE(sequence); i++) {
+			TS_ASSERT_EQUALS(hMSB.getSymbol(bsMSB), symbols[sequence[i]]);
+			TS_ASSERT_EQUALS(hLSB.getSymbol(bsLSB), symbols[sequence[i]]);
+		}
+		TS_ASSERT_EQUALS(bsMSB.pos(), pos);
+		TS_ASSERT_EQUALS(bsLSB.pos(), pos);
+	}
 };
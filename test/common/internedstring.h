@@ -0,0 +1,60 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/internedstring.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty() {
+		Common::InternedString empty, fromString(""), fromCStr((const char *)"");
+		TS_ASSERT(empty.empty());
+		TS_ASSERT(empty == fromString);
+		TS_ASSERT(empty == fromCStr);
+		TS_ASSERT_EQUALS(empty.toString(), "");
+		TS_ASSERT_EQUALS(empty.hash(), Common::hashit(""));
+		TS_ASSERT(empty.equalsIgnoreCase(fromString));
+		TS_ASSERT(empty.toLowercase().empty());
+	}
+
+	void test_equality() {
+		Common::InternedString a("Resource.MAP"), b(Common::String("Resource.MAP")), c("resource.map"), d("other");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT(a != d);
+		TS_ASSERT_EQUALS(a.c_str(), b.c_str());
+		TS_ASSERT_EQUALS(a.toString(), "Resource.MAP");
+
+		TS_ASSERT(a.equalsIgnoreCase(c));
+		TS_ASSERT(c.equalsIgnoreCase(a));
+		TS_ASSERT(!a.equalsIgnoreCase(d));
+		TS_ASSERT(!a.equalsIgnoreCase(Common::InternedString()));
+
+		TS_ASSERT(a.toLowercase() == c);
+		TS_ASSERT(c.toLowercase() == c);
+	}
+
+	void test_hashes() {
+		Common::InternedString a("Resource.MAP"), c("resource.map");
+
+		TS_ASSERT_EQUALS(a.hash(), Common::hashit("Resource.MAP"));
+		TS_ASSERT_EQUALS(a.hashIgnoreCase(), Common::hashit_lower("Resource.MAP"));
+		TS_ASSERT_EQUALS(a.hashIgnoreCase(), c.hashIgnoreCase());
+	}
+
+	void test_hashmap_key() {
+		Common::HashMap<Common::InternedString, int, Common::InternedString_IgnoreCase_Hash, Common::InternedString_IgnoreCase_EqualTo> map;
+		map[Common::InternedString("Font.001")] = 1;
+		map[Common::InternedString("view.002")] = 2;
+
+		TS_ASSERT_EQUALS(map.getVal(Common::InternedString("FONT.001"), 0), 1);
+		TS_ASSERT_EQUALS(map.getVal(Common::InternedString("View.002"), 0), 2);
+		TS_ASSERT(!map.contains(Common::InternedString("font.002")));
+
+		Common::HashMap<Common::InternedString, int, Common::InternedString_Hash, Common::InternedString_EqualTo> caseMap;
+		caseMap[Common::InternedString("Font.001")] = 1;
+		TS_ASSERT(!caseMap.contains(Common::InternedString("font.001")));
+	}
+};
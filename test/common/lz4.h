@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/lz4.h"
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+class LZ4TestSuite : public CxxTest::TestSuite {
+	static byte pattern(uint32 i) {
+		return (byte)(i * 7 + (i >> 12));
+	}
+
+	static void fillNoise(byte *data, uint32 size) {
+		uint32 seed = 0x12345678;
+		for (uint32 i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (byte)(seed >> 16);
+		}
+	}
+
+	static bool roundTrip(const byte *src, uint32 size) {
+		byte *packed = new byte[Common::getLZ4CompressBound(size)];
+		byte *unpacked = new byte[size + 1];
+		const uint32 packedSize = Common::compressLZ4(packed, src, size);
+		const bool ok = packedSize <= Common::getLZ4CompressBound(size) &&
+		                Common::decompressLZ4(unpacked, size, packed, packedSize) &&
+		                !memcmp(unpacked, src, size);
+		delete[] unpacked;
+		delete[] packed;
+		return ok;
+	}
+
+public:
+	void test_block_round_trip() {
+		const uint32 size = 64 * 1024;
+		byte *data = new byte[size];
+
+		TS_ASSERT(roundTrip(data, 0));
+
+		const byte text[] = "abracadabra abracadabra abracadabra";
+		TS_ASSERT(roundTrip(text, sizeof(text)));
+
+		for (uint32 i = 0; i < size; ++i)
+			data[i] = pattern(i);
+		TS_ASSERT(roundTrip(data, size));
+		TS_ASSERT(roundTrip(data, 13));
+
+		memset(data, 0xAA, size);
+		TS_ASSERT(roundTrip(data, size));
+
+		fillNoise(data, size);
+		TS_ASSERT(roundTrip(data, size));
+		TS_ASSERT(roundTrip(data, 1000));
+
+		delete[] data;
+	}
+
+	void test_block_compresses() {
+		const uint32 size = 64 * 1024;
+		byte *data = new byte[size];
+		byte *packed = new byte[Common::getLZ4CompressBound(size)];
+
+		memset(data, 0, size);
+		TS_ASSERT_LESS_THAN(Common::compressLZ4(packed, data, size), size / 100);
+
+		delete[] packed;
+		delete[] data;
+	}
+
+	void test_block_rejects_bad_data() {
+		const uint32 size = 4096;
+		byte *data = new byte[size];
+		byte *packed = new byte[Common::getLZ4CompressBound(size)];
+		byte *unpacked = new byte[size];
+
+		for (uint32 i = 0; i < size; ++i)
+			data[i] = pattern(i / 3);
+		const uint32 packedSize = Common::compressLZ4(packed, data, size);
+
+		// Truncated input, and output too small for the data
+		TS_ASSERT(!Common::decompressLZ4(unpacked, size, packed, packedSize / 2));
+		TS_ASSERT(!Common::decompressLZ4(unpacked, size - 1, packed, packedSize));
+
+		// A match offset reaching before the start of the output
+		const byte badOffset[] = { 0x14, 'a', 0x10, 0x00, 0x00 };
+		TS_ASSERT(!Common::decompressLZ4(unpacked, size, badOffset, sizeof(badOffset)));
+
+		delete[] unpacked;
+		delete[] packed;
+		delete[] data;
+	}
+
+	void test_stream_round_trip() {
+		// Several blocks, with a short one at the end
+		const uint32 size = 200 * 1024 + 17;
+
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *lz4 = Common::wrapCompressedWriteStream(compressed, Common::kCompressionLZ4);
+		for (uint32 i = 0; i < size; ++i)
+			lz4->writeByte(pattern(i));
+		lz4->finalize();
+		TS_ASSERT(!lz4->err());
+		byte *data = compressed->getData();
+		const uint32 dataSize = compressed->size();
+		delete lz4;
+
+		TS_ASSERT_LESS_THAN(dataSize, size);
+
+		Common::SeekableReadStream *packed = new Common::MemoryReadStream(data, dataSize, DisposeAfterUse::YES);
+		TS_ASSERT(Common::isLZ4Stream(*packed));
+		TS_ASSERT_EQUALS(packed->pos(), 0);
+
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(packed);
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+		TS_ASSERT_EQUALS(stream->size(), (int32)size);
+
+		bool same = true;
+		for (uint32 i = 0; i < size; ++i)
+			same = same && stream->readByte() == pattern(i);
+		TS_ASSERT(same);
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+		delete stream;
+	}
+
+	void test_stream_rejects_truncated_data() {
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *lz4 = Common::wrapLZ4WriteStream(compressed);
+		for (uint32 i = 0; i < 100000; ++i)
+			lz4->writeByte(pattern(i));
+		lz4->finalize();
+		byte *data = compressed->getData();
+		const uint32 dataSize = compressed->size();
+		delete lz4;
+
+		// Drop the end marker
+		Common::SeekableReadStream *stream = Common::wrapLZ4ReadStream(new Common::MemoryReadStream(data, dataSize - 4));
+		TS_ASSERT(!stream);
+		free(data);
+	}
+
+	void test_uncompressed_passthrough() {
+		const byte plain[] = "This is not compressed";
+		Common::SeekableReadStream *in = new Common::MemoryReadStream(plain, sizeof(plain));
+		TS_ASSERT(!Common::isLZ4Stream(*in));
+
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(in);
+		TS_ASSERT_EQUALS(stream, in);
+		delete stream;
+	}
+};
@@ -0,0 +1,164 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/macresman.h"
+#include "common/memstream.h"
+
+class MacResManagerTestSuite : public CxxTest::TestSuite
+{
+	struct TestRes {
+		uint32 type;
+		uint16 id;
+		const char *name;
+		const char *data;
+	};
+
+	// Builds a MacBinary file with the given data fork and resources, which
+	// have to be sorted by type
+	static Common::MemoryReadStream *createMacBinary(const char *dataFork, const TestRes *res, uint count) {
+		Common::MemoryWriteStreamDynamic data(DisposeAfterUse::NO);
+		Common::MemoryWriteStreamDynamic refs(DisposeAfterUse::NO);
+		Common::MemoryWriteStreamDynamic names(DisposeAfterUse::NO);
+		Common::Array<uint32> types;
+		Common::Array<uint16> typeCounts;
+
+		for (uint i = 0; i < count; i++) {
+			if (types.empty() || types.back() != res[i].type) {
+				types.push_back(res[i].type);
+				typeCounts.push_back(0);
+			}
+			typeCounts.back()++;
+		}
+
+		const uint32 typeListSize = 2 + types.size() * 8;
+		uint32 refOffset = typeListSize;
+		Common::MemoryWriteStreamDynamic typeList(DisposeAfterUse::NO);
+		typeList.writeUint16BE(types.size() - 1);
+		for (uint i = 0; i < types.size(); i++) {
+			typeList.writeUint32BE(types[i]);
+			typeList.writeUint16BE(typeCounts[i] - 1);
+			typeList.writeUint16BE(refOffset);
+			refOffset += typeCounts[i] * 12;
+		}
+
+		for (uint i = 0; i < count; i++) {
+			refs.writeUint16BE(res[i].id);
+			if (res[i].name) {
+				refs.writeUint16BE(names.size());
+				names.writeByte(strlen(res[i].name));
+				names.write(res[i].name, strlen(res[i].name));
+			} else {
+				refs.writeUint16BE(0xFFFF);
+			}
+			refs.writeUint32BE(data.size());
+			refs.writeUint32BE(0);
+
+			data.writeUint32BE(strlen(res[i].data));
+			data.write(res[i].data, strlen(res[i].data));
+		}
+
+		const uint32 mapLength = 28 + typeListSize + refs.size() + names.size();
+		Common::MemoryWriteStreamDynamic fork(DisposeAfterUse::NO);
+		fork.writeUint32BE(16);
+		fork.writeUint32BE(16 + data.size());
+		fork.writeUint32BE(data.size());
+		fork.writeUint32BE(mapLength);
+		fork.write(data.getData(), data.size());
+		for (uint i = 0; i < 22; i++)
+			fork.writeByte(0);
+		fork.writeUint16BE(0); // attributes
+		fork.writeUint16BE(28);
+		fork.writeUint16BE(28 + typeListSize + refs.size());
+		fork.write(typeList.getData(), typeList.size());
+		fork.write(refs.getData(), refs.size());
+		fork.write(names.getData(), names.size());
+
+		Common::MemoryWriteStreamDynamic file(DisposeAfterUse::NO);
+		byte header[128];
+		memset(header, 0, sizeof(header));
+		header[1] = 4;
+		memcpy(header + 2, "test", 4);
+		WRITE_BE_UINT32(header + 83, strlen(dataFork));
+		WRITE_BE_UINT32(header + 87, fork.size());
+		file.write(header, sizeof(header));
+		file.write(dataFork, strlen(dataFork));
+		while (file.size() % 128)
+			file.writeByte(0);
+		file.write(fork.getData(), fork.size());
+		while (file.size() % 128)
+			file.writeByte(0);
+
+		free(data.getData());
+		free(refs.getData());
+		free(names.getData());
+		free(typeList.getData());
+		free(fork.getData());
+		return new Common::MemoryReadStream(file.getData(), file.size(), DisposeAfterUse::YES);
+	}
+
+	static Common::String readAll(Common::SeekableReadStream *stream) {
+		Common::String result;
+		if (!stream)
+			return "<none>";
+		while (true) {
+			char c = stream->readByte();
+			if (stream->eos())
+				break;
+			result += c;
+		}
+		delete stream;
+		return result;
+	}
+
+	public:
+	void test_lookups() {
+		static const TestRes res[] = {
+			{ MKTAG('D', 'A', 'T', 'A'), 128, "second", "data 128" },
+			{ MKTAG('D', 'A', 'T', 'A'), 130, "first", "data 130" },
+			{ MKTAG('T', 'E', 'S', 'T'), 128, "first", "test 128" },
+			{ MKTAG('T', 'E', 'S', 'T'), 129, nullptr, "test 129" }
+		};
+
+		Common::MacResManager resMan;
+		TS_ASSERT(resMan.loadFromMacBinary(*createMacBinary("data fork", res, ARRAYSIZE(res))));
+
+		TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('T', 'E', 'S', 'T'), 129)), "test 129");
+		TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('D', 'A', 'T', 'A'), 128)), "data 128");
+		TS_ASSERT(!resMan.getResource(MKTAG('D', 'A', 'T', 'A'), 129));
+		TS_ASSERT(!resMan.getResource(MKTAG('N', 'O', 'N', 'E'), 128));
+
+		// Names are matched ignoring case, the first resource of any type wins
+		TS_ASSERT_EQUALS(readAll(resMan.getResource("FIRST")), "data 130");
+		TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('T', 'E', 'S', 'T'), "first")), "test 128");
+		TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('D', 'A', 'T', 'A'), "second")), "data 128");
+		TS_ASSERT(!resMan.getResource(MKTAG('T', 'E', 'S', 'T'), "second"));
+		TS_ASSERT(!resMan.getResource("third"));
+
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('D', 'A', 'T', 'A'), 130), "first");
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('T', 'E', 'S', 'T'), 129), "");
+
+		Common::MacResIDArray ids = resMan.getResIDArray(MKTAG('T', 'E', 'S', 'T'));
+		TS_ASSERT_EQUALS(ids.size(), 2U);
+		TS_ASSERT_EQUALS(ids[1], 129);
+	}
+
+	void test_mapped_resources() {
+		static const TestRes res[] = {
+			{ MKTAG('T', 'E', 'S', 'T'), 128, "first", "test 128" }
+		};
+
+		Common::MacResManager resMan;
+		Common::MemoryReadStream *file = createMacBinary("data fork", res, ARRAYSIZE(res));
+		TS_ASSERT(resMan.loadFromMacBinary(*file));
+
+		// Both forks point into the memory of the file
+		Common::SeekableReadStream *resource = resMan.getResource(MKTAG('T', 'E', 'S', 'T'), 128);
+		Common::SeekableReadStream *dataFork = resMan.getDataFork();
+		TS_ASSERT(resource && resource->getDataPointer() > file->getDataPointer());
+		TS_ASSERT(dataFork && dataFork->getDataPointer() == file->getDataPointer() + 128);
+
+		// and stay valid after closing
+		resMan.close();
+		TS_ASSERT_EQUALS(readAll(resource), "test 128");
+		TS_ASSERT_EQUALS(readAll(dataFork), "data fork");
+	}
+};
@@ -0,0 +1,84 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/memtracker.h"
+
+class MemoryTrackerTestSuite : public CxxTest::TestSuite
+{
+	struct TestReclaimer : public Common::MemoryReclaimer {
+		Common::MemoryUsage usage;
+		uint32 asked;
+
+		TestReclaimer(uint32 size) : usage(Common::kMemoryImages), asked(0) { usage.set(size); }
+
+		virtual uint32 reclaimMemory(uint32 bytes) {
+			asked++;
+			const uint32 freed = MIN(bytes, usage.get());
+			usage.set(usage.get() - freed);
+			return freed;
+		}
+	};
+
+	public:
+	void test_usage() {
+		const uint32 before = Common::MemoryTracker::getCurrent(Common::kMemoryVideo);
+		const uint32 total = Common::MemoryTracker::getTotal();
+
+		{
+			Common::MemoryUsage usage(Common::kMemoryVideo);
+			usage.set(1000);
+			TS_ASSERT_EQUALS(Common::MemoryTracker::getCurrent(Common::kMemoryVideo), before + 1000);
+			usage.set(400);
+			TS_ASSERT_EQUALS(Common::MemoryTracker::getCurrent(Common::kMemoryVideo), before + 400);
+			TS_ASSERT(Common::MemoryTracker::getPeak(Common::kMemoryVideo) >= before + 1000);
+			TS_ASSERT_EQUALS(Common::MemoryTracker::getTotal(), total + 400);
+		}
+
+		TS_ASSERT_EQUALS(Common::MemoryTracker::getCurrent(Common::kMemoryVideo), before);
+		TS_ASSERT_EQUALS(Common::MemoryTracker::getTotal(), total);
+
+		Common::MemoryTracker::resetPeaks();
+		TS_ASSERT_EQUALS(Common::MemoryTracker::getPeak(Common::kMemoryVideo), before);
+	}
+
+	void test_owned_streams() {
+		const uint32 before = Common::MemoryTracker::getCurrent(Common::kMemoryStreams);
+
+		byte data[16];
+		Common::MemoryReadStream *wrapped = new Common::MemoryReadStream(data, sizeof(data));
+		TS_ASSERT_EQUALS(Common::MemoryTracker::getCurrent(Common::kMemoryStreams), before);
+		delete wrapped;
+
+		Common::MemoryReadStream *owned = new Common::MemoryReadStream((byte *)malloc(32), 32, DisposeAfterUse::YES);
+		TS_ASSERT_EQUALS(Common::MemoryTracker::getCurrent(Common::kMemoryStreams), before + 32);
+		delete owned;
+		TS_ASSERT_EQUALS(Common::MemoryTracker::getCurrent(Common::kMemoryStreams), before);
+	}
+
+	void test_budget() {
+		TestReclaimer first(3000), second(3000);
+		Common::MemoryTracker::addReclaimer(&first);
+		Common::MemoryTracker::addReclaimer(&second);
+
+		Common::MemoryTracker::setBudget(0);
+		TS_ASSERT(!Common::MemoryTracker::isOverBudget());
+		TS_ASSERT_EQUALS(Common::MemoryTracker::enforceBudget(), 0U);
+
+		// The first reclaimer cannot free enough on its own
+		Common::MemoryTracker::setBudget(Common::MemoryTracker::getTotal() - 4000);
+		TS_ASSERT(Common::MemoryTracker::isOverBudget());
+		TS_ASSERT_EQUALS(Common::MemoryTracker::enforceBudget(), 4000U);
+		TS_ASSERT(!Common::MemoryTracker::isOverBudget());
+		TS_ASSERT_EQUALS(first.usage.get(), 0U);
+		TS_ASSERT_EQUALS(second.usage.get(), 2000U);
+
+		// Nothing more is asked for once within the budget
+		TS_ASSERT_EQUALS(Common::MemoryTracker::enforceBudget(), 0U);
+		TS_ASSERT_EQUALS(first.asked, 1U);
+		TS_ASSERT_EQUALS(second.asked, 1U);
+
+		Common::MemoryTracker::removeReclaimer(&first);
+		Common::MemoryTracker::removeReclaimer(&second);
+		Common::MemoryTracker::setBudget(0);
+	}
+};
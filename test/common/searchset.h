@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+namespace {
+
+// Archive holding a fixed set of names, counting how often it is probed
+class CountingArchive : public Common::Archive {
+public:
+	Common::StringArray _names;
+	mutable int _probes;
+
+	CountingArchive() : _probes(0) {}
+
+	virtual bool hasFile(const Common::String &name) const {
+		++_probes;
+		for (uint i = 0; i < _names.size(); ++i)
+			if (_names[i].equalsIgnoreCase(name))
+				return true;
+		return false;
+	}
+
+	virtual int listMembers(Common::ArchiveMemberList &list) const {
+		for (uint i = 0; i < _names.size(); ++i)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_names[i], this)));
+		return _names.size();
+	}
+
+	virtual const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+
+	virtual Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+		if (!hasFile(name))
+			return nullptr;
+		return new Common::MemoryReadStream((const byte *)this, 1);
+	}
+};
+
+} // End of anonymous namespace
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_priority_and_index() {
+		Common::SearchSet set;
+		set.setLookupIndexEnabled(true);
+
+		CountingArchive *low = new CountingArchive();
+		low->_names.push_back("a.dat");
+		low->_names.push_back("b.dat");
+		CountingArchive *high = new CountingArchive();
+		high->_names.push_back("A.DAT");
+
+		set.add("low", low, 0);
+		set.add("high", high, 10);
+
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(set.hasFile("B.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(set.getMember("a.dat")->getName(), "a.dat");
+
+		// Repeated lookups, including misses, are answered from the index
+		int probes = low->_probes + high->_probes;
+		TS_ASSERT(set.hasFile("A.dat"));
+		TS_ASSERT(!set.hasFile("C.DAT"));
+		TS_ASSERT_EQUALS(low->_probes + high->_probes, probes);
+
+		// The higher priority archive wins
+		high->_probes = 0;
+		delete set.createReadStreamForMember("a.dat");
+		TS_ASSERT_EQUALS(high->_probes, 1);
+
+		// Changing the set drops stale entries, including misses
+		CountingArchive *extra = new CountingArchive();
+		extra->_names.push_back("c.dat");
+		set.add("extra", extra, 5);
+		TS_ASSERT(set.hasFile("c.dat"));
+
+		set.remove("high");
+		TS_ASSERT(set.hasFile("a.dat"));
+		low->_probes = 0;
+		delete set.createReadStreamForMember("a.dat");
+		TS_ASSERT(low->_probes > 0);
+
+		set.setPriority("low", 20);
+		TS_ASSERT(set.hasFile("c.dat"));
+		TS_ASSERT(!set.hasFile("d.dat"));
+
+		set.clear();
+		TS_ASSERT(!set.hasFile("a.dat"));
+	}
+};
@@ -70,4 +70,13 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_data_pointer() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(ms.getDataPointer(), contents);
+
+		Common::SeekableSubReadStream ssrs(&ms, 2, 6);
+		TS_ASSERT_EQUALS(ssrs.getDataPointer(), contents + 2);
+	}
 };
@@ -108,4 +108,96 @@ public:
 	void test_read_v2_as_v2() {
 		readVersioned_v2(_inStreamV2, 2);
 	}
+
+	// Syncs a bit of everything, with the arrays in bulk and one by one
+	void syncArrays(Common::Serializer &ser, uint16 *words, int32 *longs, int32 *narrowed, byte *bytes, Common::String &str) {
+		ser.syncArray(words, 300, Common::Serializer::Uint16BE);
+		ser.syncArray(longs, 3, Common::Serializer::Sint32LE);
+		ser.syncArray(narrowed, 2, Common::Serializer::Sint16LE);
+		ser.syncString(str);
+		ser.syncArray(bytes, 4, Common::Serializer::Byte);
+		ser.syncArray(longs, 3, Common::Serializer::Sint32BE);
+	}
+
+	void roundTrip(bool inMemory) {
+		uint16 words[300];
+		for (int i = 0; i < 300; i++)
+			words[i] = 0x0102 + i;
+		int32 longs[3] = { -2, 0x01020304, 7 };
+		int32 narrowed[2] = { -3, 0x1234 };
+		byte bytes[4] = { 1, 2, 3, 4 };
+		Common::String str("test");
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		if (inMemory) {
+			Common::MemorySerializer ser(&out);
+			syncArrays(ser, words, longs, narrowed, bytes, str);
+			TS_ASSERT_EQUALS(ser.bytesSynced(), (uint)out.size());
+		} else {
+			Common::Serializer ser(0, &out);
+			syncArrays(ser, words, longs, narrowed, bytes, str);
+			TS_ASSERT_EQUALS(ser.bytesSynced(), (uint)out.size());
+		}
+
+		// Saving must leave the arrays alone
+		TS_ASSERT_EQUALS(words[1], 0x0103);
+		TS_ASSERT_EQUALS(longs[1], 0x01020304);
+
+		const byte *data = out.getData();
+		TS_ASSERT_EQUALS(out.size(), 600 + 12 + 4 + 5 + 4 + 12);
+		TS_ASSERT_EQUALS(data[0], 0x01);
+		TS_ASSERT_EQUALS(data[1], 0x02);
+		TS_ASSERT_EQUALS(data[600], 0xfe);
+		TS_ASSERT_EQUALS(data[604], 0x04);
+		TS_ASSERT_EQUALS(data[612], 0xfd);
+		TS_ASSERT_EQUALS(data[613], 0xff);
+		TS_ASSERT_EQUALS(data[625], 0xff);
+		TS_ASSERT_EQUALS(data[629], 0x01);
+		TS_ASSERT_EQUALS(data[636], 0x07);
+
+		uint16 words2[300];
+		int32 longs2[3];
+		int32 narrowed2[2];
+		byte bytes2[4];
+		Common::String str2;
+
+		Common::MemoryReadStream in(data, out.size());
+		if (inMemory) {
+			Common::MemorySerializer ser(&in);
+			syncArrays(ser, words2, longs2, narrowed2, bytes2, str2);
+		} else {
+			Common::Serializer ser(&in, 0);
+			syncArrays(ser, words2, longs2, narrowed2, bytes2, str2);
+		}
+
+		TS_ASSERT_EQUALS(memcmp(words, words2, sizeof(words)), 0);
+		TS_ASSERT_EQUALS(memcmp(longs, longs2, sizeof(longs)), 0);
+		TS_ASSERT_EQUALS(narrowed2[0], -3);
+		TS_ASSERT_EQUALS(narrowed2[1], 0x1234);
+		TS_ASSERT_EQUALS(memcmp(bytes, bytes2, sizeof(bytes)), 0);
+		TS_ASSERT_EQUALS(str2, "test");
+		TS_ASSERT(!in.eos());
+	}
+
+	void test_arrays() {
+		roundTrip(false);
+	}
+
+	void test_memory_serializer() {
+		roundTrip(true);
+	}
+
+	void test_memory_serializer_eos() {
+		static const byte data[] = { 0x01, 0x02, 0x03 };
+		Common::MemoryReadStream in(data, sizeof(data));
+		Common::MemorySerializer ser(&in);
+
+		uint32 value = 0xdeadbeef;
+		uint16 word = 0;
+		ser.syncAsUint16LE(word);
+		TS_ASSERT_EQUALS(word, 0x0201);
+		ser.syncAsUint32LE(value);
+		TS_ASSERT_EQUALS(value, 0u);
+		TS_ASSERT(in.eos());
+	}
 };
@@ -0,0 +1,60 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/taskscheduler.h"
+
+class TaskSchedulerTestSuite : public CxxTest::TestSuite
+{
+	struct CountTask : public Common::Task {
+		int *_counter;
+		CountTask(int *counter) : _counter(counter) {}
+		virtual void run() { ++*_counter; }
+	};
+
+	struct SumBody : public Common::ParallelForBody {
+		uint _sum;
+		int _calls;
+		SumBody() : _sum(0), _calls(0) {}
+		virtual void run(uint begin, uint end) {
+			for (uint i = begin; i < end; i++)
+				_sum += i;
+			_calls++;
+		}
+	};
+
+public:
+	void test_serial_schedule() {
+		Common::TaskScheduler scheduler;
+		TS_ASSERT(scheduler.isSerial());
+
+		int counter = 0;
+		Common::TaskFuture future = scheduler.schedule(new CountTask(&counter));
+		TS_ASSERT(future.isValid());
+		TS_ASSERT(future.isDone());
+		TS_ASSERT_EQUALS(counter, 1);
+
+		future.wait();
+		TS_ASSERT_EQUALS(counter, 1);
+
+		Common::TaskFuture copy = future;
+		future = Common::TaskFuture();
+		TS_ASSERT(!future.isValid());
+		TS_ASSERT(copy.isDone());
+
+		CountTask keep(&counter);
+		scheduler.schedule(&keep, DisposeAfterUse::NO).wait();
+		TS_ASSERT_EQUALS(counter, 2);
+	}
+
+	void test_serial_parallel_for() {
+		Common::TaskScheduler scheduler;
+
+		SumBody body;
+		scheduler.parallelFor(10, 110, body, 7);
+		TS_ASSERT_EQUALS(body._sum, 5950u);
+		TS_ASSERT_EQUALS(body._calls, 1);
+
+		SumBody empty;
+		scheduler.parallelFor(5, 5, empty);
+		TS_ASSERT_EQUALS(empty._calls, 0);
+	}
+};
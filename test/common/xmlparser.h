@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/xmlparser.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+class TestXMLParser : public Common::XMLParser {
+public:
+	Common::StringArray _log;
+
+protected:
+	CUSTOM_XML_PARSER(TestXMLParser) {
+		XML_KEY(layout)
+			XML_PROP(name, true)
+			XML_PROP(size, false)
+			XML_KEY(widget)
+				XML_PROP(id, true)
+				XML_PROP(text, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_layout(ParserNode *node) {
+		Common::String entry = "layout " + node->values["name"];
+		if (node->values.contains("size"))
+			entry += " " + node->values["size"];
+		_log.push_back(entry);
+		return true;
+	}
+
+	bool parserCallback_widget(ParserNode *node) {
+		_log.push_back("widget " + node->values["id"] + " '" + node->values["text"] + "' in " + getParentNode(node)->values["name"]);
+		return true;
+	}
+
+	virtual bool closedKeyCallback(ParserNode *node) {
+		_log.push_back("/" + node->name);
+		return true;
+	}
+
+	virtual void cleanup() {
+		_log.clear();
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+public:
+	void test_parse() {
+		static const char xml[] =
+			"<?xml version = '1.0'?>\n"
+			"<!-- A comment with <tags> inside -->\n"
+			"<layout name = 'main' size = 2>\n"
+			"\t<widget id = \"ok\" text = 'Press \"OK\"'/>\n"
+			"\t<widget id = cancel></widget>\n"
+			"</layout>\n"
+			"<layout name = ''/>";
+
+		TestXMLParser parser;
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(parser.parse());
+
+		TS_ASSERT_EQUALS(parser._log.size(), 9u);
+		TS_ASSERT_EQUALS(parser._log[0], "/xml");
+		TS_ASSERT_EQUALS(parser._log[1], "layout main 2");
+		TS_ASSERT_EQUALS(parser._log[2], "widget ok 'Press \"OK\"' in main");
+		TS_ASSERT_EQUALS(parser._log[3], "/widget");
+		TS_ASSERT_EQUALS(parser._log[4], "widget cancel '' in main");
+		TS_ASSERT_EQUALS(parser._log[5], "/widget");
+		TS_ASSERT_EQUALS(parser._log[6], "/layout");
+		TS_ASSERT_EQUALS(parser._log[7], "layout ");
+		TS_ASSERT_EQUALS(parser._log[8], "/layout");
+
+		// Parsing again gives the same result
+		TS_ASSERT(parser.parse());
+		TS_ASSERT_EQUALS(parser._log.size(), 9u);
+		TS_ASSERT_EQUALS(parser._log[2], "widget ok 'Press \"OK\"' in main");
+	}
+
+	void test_property_map() {
+		Common::XMLParser::PropertyMap map;
+		TS_ASSERT(map.empty());
+
+		map.add(Common::InternedString("width"), "320");
+		TS_ASSERT(map.contains("width"));
+		TS_ASSERT(map.contains(Common::InternedString("width")));
+		TS_ASSERT(!map.contains("height"));
+		TS_ASSERT_EQUALS(map["width"], "320");
+
+		// Like HashMap, looking up a missing property adds it
+		TS_ASSERT_EQUALS(map["height"], "");
+		TS_ASSERT(map.contains("height"));
+		TS_ASSERT_EQUALS(map.size(), 2u);
+	}
+};
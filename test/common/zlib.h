@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+class ZlibTestSuite : public CxxTest::TestSuite {
+	static byte pattern(uint32 i) {
+		return (byte)(i * 7 + (i >> 12));
+	}
+
+	// Raw deflate data for the given range of the pattern
+	static byte *deflatePattern(uint32 start, uint32 size, uint32 &deflatedSize) {
+		// Let the gzip writer do the compression, then strip its header and
+		// trailer to get raw deflate data.
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(compressed);
+		for (uint32 i = start; i < start + size; ++i)
+			gzip->writeByte(pattern(i));
+		gzip->finalize();
+		byte *data = compressed->getData();
+		uint32 dataSize = compressed->size();
+		delete gzip;
+
+		deflatedSize = dataSize - 18;
+		memmove(data, data + 10, deflatedSize);
+		return data;
+	}
+
+public:
+	void test_deflate_read_stream() {
+#if defined(USE_ZLIB)
+		const uint32 size = 3 * 1024 * 1024 + 123;
+
+		uint32 dataSize;
+		byte *data = deflatePattern(0, size, dataSize);
+		Common::SeekableReadStream *deflated = new Common::MemoryReadStream(data, dataSize);
+		Common::SeekableReadStream *stream = Common::wrapDeflateReadStream(deflated, size);
+		TS_ASSERT_EQUALS(stream->size(), (int32)size);
+
+		byte buf[4096];
+		bool same = true;
+		uint32 total = 0;
+		while (!stream->eos()) {
+			uint32 got = stream->read(buf, sizeof(buf));
+			for (uint32 i = 0; i < got; ++i)
+				same = same && buf[i] == pattern(total + i);
+			total += got;
+		}
+		TS_ASSERT(same);
+		TS_ASSERT_EQUALS(total, size);
+		TS_ASSERT(!stream->err());
+
+		// Backward seeks, forward seeks and seeks to checkpointed positions
+		const uint32 offsets[] = { 5, 2 * 1024 * 1024 + 17, 1024 * 1024, 1024 * 1024 - 1, 3 * 1024 * 1024, 0 };
+		for (uint i = 0; i < ARRAYSIZE(offsets); ++i) {
+			TS_ASSERT(stream->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stream->pos(), (int32)offsets[i]);
+			TS_ASSERT_EQUALS(stream->read(buf, 16), 16U);
+			same = true;
+			for (uint32 j = 0; j < 16; ++j)
+				same = same && buf[j] == pattern(offsets[i] + j);
+			TS_ASSERT(same);
+		}
+
+		TS_ASSERT(stream->seek(-3, SEEK_END));
+		TS_ASSERT_EQUALS(stream->read(buf, 16), 3U);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!stream->seek(size + 1));
+
+		delete stream;
+		free(data);
+#endif
+	}
+
+	void test_installshield_read_stream() {
+#if defined(USE_ZLIB)
+		const uint32 chunkSize = 30000;
+		const uint32 size = 5 * chunkSize + 1234;
+
+		// Independently deflated chunks, each preceded by its length
+		Common::MemoryWriteStreamDynamic chunks(DisposeAfterUse::YES);
+		for (uint32 start = 0; start < size; start += chunkSize) {
+			uint32 deflatedSize;
+			byte *deflated = deflatePattern(start, MIN(chunkSize, size - start), deflatedSize);
+			chunks.writeUint16LE(deflatedSize);
+			chunks.write(deflated, deflatedSize);
+			free(deflated);
+		}
+
+		Common::SeekableReadStream *stream = Common::wrapInstallShieldReadStream(new Common::MemoryReadStream(chunks.getData(), chunks.size()), size);
+		TS_ASSERT_EQUALS(stream->size(), (int32)size);
+
+		const uint32 offsets[] = { 0, 3 * chunkSize - 5, chunkSize + 7, size - 16, 5 };
+		byte buf[16];
+		for (uint i = 0; i < ARRAYSIZE(offsets); ++i) {
+			TS_ASSERT(stream->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stream->read(buf, 16), 16U);
+			bool same = true;
+			for (uint32 j = 0; j < 16; ++j)
+				same = same && buf[j] == pattern(offsets[i] + j);
+			TS_ASSERT(same);
+		}
+
+		TS_ASSERT_EQUALS(stream->read(buf, 16), 16U);
+		TS_ASSERT(stream->seek(-2, SEEK_END));
+		TS_ASSERT_EQUALS(stream->read(buf, 16), 2U);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!stream->err());
+
+		delete stream;
+#endif
+	}
+};
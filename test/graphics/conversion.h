@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+class ConversionTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	static uint32 readPixel(const byte *p, uint bpp) {
+		return bpp == 2 ? *(const uint16 *)p : *(const uint32 *)p;
+	}
+
+	static void writePixel(byte *p, uint bpp, uint32 color) {
+		if (bpp == 2)
+			*(uint16 *)p = color;
+		else
+			*(uint32 *)p = color;
+	}
+
+	/** Checks crossBlit against converting every pixel on its own */
+	bool checkBlit(const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt, bool inPlace) {
+		const uint w = 1 + nextRandom() % 40, h = 1 + nextRandom() % 4;
+		const uint srcBpp = srcFmt.bytesPerPixel, dstBpp = dstFmt.bytesPerPixel;
+		const uint srcPitch = inPlace ? w * srcBpp : (w + nextRandom() % 5) * srcBpp;
+		const uint dstPitch = inPlace ? w * dstBpp : (w + nextRandom() % 5) * dstBpp;
+
+		byte *src = new byte[srcPitch * h];
+		for (uint i = 0; i < srcPitch * h; ++i)
+			src[i] = nextRandom();
+
+		byte *expected = new byte[dstPitch * h];
+		memset(expected, 0, dstPitch * h);
+		for (uint y = 0; y < h; ++y) {
+			// Identical formats are copied as they are, including any padding bits
+			if (dstFmt == srcFmt) {
+				memcpy(expected + y * dstPitch, src + y * srcPitch, w * dstBpp);
+				continue;
+			}
+
+			for (uint x = 0; x < w; ++x) {
+				byte a, r, g, b;
+				srcFmt.colorToARGB(readPixel(src + y * srcPitch + x * srcBpp, srcBpp), a, r, g, b);
+				writePixel(expected + y * dstPitch + x * dstBpp, dstBpp, dstFmt.ARGBToColor(a, r, g, b));
+			}
+		}
+
+		byte *dst;
+		if (inPlace) {
+			dst = new byte[MAX(srcPitch, dstPitch) * h];
+			memcpy(dst, src, srcPitch * h);
+			Graphics::crossBlit(dst, dst, dstPitch, srcPitch, w, h, dstFmt, srcFmt);
+		} else {
+			dst = new byte[dstPitch * h];
+			memset(dst, 0, dstPitch * h);
+			Graphics::crossBlit(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt);
+		}
+
+		bool same = true;
+		for (uint y = 0; y < h; ++y)
+			same = same && !memcmp(dst + y * dstPitch, expected + y * dstPitch, w * dstBpp);
+
+		delete[] dst;
+		delete[] expected;
+		delete[] src;
+		return same;
+	}
+
+	/** Checks crossBlitMap against looking up every pixel on its own */
+	bool checkMap(uint bpp, bool inPlace) {
+		const uint w = 1 + nextRandom() % 40, h = 1 + nextRandom() % 4;
+		const uint srcPitch = inPlace ? w : w + nextRandom() % 5;
+		const uint dstPitch = inPlace ? w * bpp : (w + nextRandom() % 5) * bpp;
+
+		uint32 map[256];
+		for (uint i = 0; i < 256; ++i)
+			map[i] = bpp == 2 ? (nextRandom() & 0xFFFF) : nextRandom() ^ (nextRandom() << 16);
+
+		byte *src = new byte[srcPitch * h];
+		for (uint i = 0; i < srcPitch * h; ++i)
+			src[i] = nextRandom();
+
+		byte *dst = new byte[MAX(srcPitch, dstPitch) * h];
+		memcpy(dst, src, srcPitch * h);
+		Graphics::crossBlitMap(dst, inPlace ? dst : src, dstPitch, srcPitch, w, h, bpp, map);
+
+		bool same = true;
+		for (uint y = 0; y < h; ++y) {
+			for (uint x = 0; x < w; ++x)
+				same = same && readPixel(dst + y * dstPitch + x * bpp, bpp) == map[src[y * srcPitch + x]];
+		}
+
+		delete[] dst;
+		delete[] src;
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x12345678;
+	}
+
+	void test_cross_blit() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),  // RGB565
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),  // RGB555
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12),  // ARGB4444
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), // RGBA8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24), // ARGB8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24), // ABGR8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0), // BGRA8888
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)   // RGB888 with padding
+		};
+		const uint count = ARRAYSIZE(formats);
+
+		for (uint i = 0; i < count; ++i) {
+			for (uint j = 0; j < count; ++j) {
+				for (int k = 0; k < 20; ++k) {
+					TS_ASSERT(checkBlit(formats[i], formats[j], false));
+					TS_ASSERT(checkBlit(formats[i], formats[j], true));
+				}
+			}
+		}
+	}
+
+	void test_cross_blit_map() {
+		for (int k = 0; k < 50; ++k) {
+			TS_ASSERT(checkMap(2, false));
+			TS_ASSERT(checkMap(4, false));
+			TS_ASSERT(checkMap(2, true));
+			TS_ASSERT(checkMap(4, true));
+		}
+		TS_ASSERT(!Graphics::crossBlitMap(nullptr, nullptr, 0, 0, 0, 0, 3, nullptr));
+	}
+};
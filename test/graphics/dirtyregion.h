@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirtyregion.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite {
+	static uint32 area(const Common::Array<Common::Rect> &rects) {
+		uint32 total = 0;
+		for (uint i = 0; i < rects.size(); ++i)
+			total += rects[i].width() * rects[i].height();
+		return total;
+	}
+
+	static bool overlap(const Common::Array<Common::Rect> &rects) {
+		for (uint i = 0; i < rects.size(); ++i) {
+			for (uint j = i + 1; j < rects.size(); ++j) {
+				if (rects[i].intersects(rects[j]))
+					return true;
+			}
+		}
+		return false;
+	}
+
+	static bool covers(const Common::Array<Common::Rect> &rects, const Common::Rect &r) {
+		for (int16 y = r.top; y < r.bottom; ++y) {
+			for (int16 x = r.left; x < r.right; ++x) {
+				uint i;
+				for (i = 0; i < rects.size(); ++i) {
+					if (rects[i].contains(x, y))
+						break;
+				}
+				if (i == rects.size())
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void checkStrategy(Graphics::DirtyRegion::Strategy strategy) {
+		Graphics::DirtyRegion region(100, 70, strategy);
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT(region.getRects().empty());
+
+		const Common::Rect a(5, 5, 40, 20), b(30, 10, 50, 40), c(90, 60, 120, 90);
+		region.addRect(a);
+		region.addRect(b);
+		region.addRect(c);
+		TS_ASSERT(!region.isEmpty());
+		TS_ASSERT_EQUALS(region.getBounds(), Common::Rect(5, 5, 100, 70));
+
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		TS_ASSERT(covers(rects, a));
+		TS_ASSERT(covers(rects, b));
+		TS_ASSERT(covers(rects, Common::Rect(90, 60, 100, 70)));
+		for (uint i = 0; i < rects.size(); ++i)
+			TS_ASSERT(Common::Rect(100, 70).contains(rects[i]));
+
+		TS_ASSERT(region.intersects(Common::Rect(45, 35, 60, 60)));
+		TS_ASSERT(!region.intersects(Common::Rect(60, 0, 80, 10)));
+		TS_ASSERT(!region.intersects(Common::Rect(0, 50, 20, 70)));
+
+		region.clear();
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT(region.getRects().empty());
+		TS_ASSERT(!region.intersects(a));
+
+		region.addAll();
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(100, 70));
+	}
+
+public:
+	void test_strategies() {
+		checkStrategy(Graphics::DirtyRegion::kStrategyMicroTiles);
+		checkStrategy(Graphics::DirtyRegion::kStrategyMerge);
+		checkStrategy(Graphics::DirtyRegion::kStrategyOverdraw);
+	}
+
+	void test_microtiles() {
+		Graphics::DirtyRegion region(320, 200, Graphics::DirtyRegion::kStrategyMicroTiles);
+
+		// A dirty pixel at the corner of a tile
+		region.addRect(Common::Rect(32, 32, 33, 33));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(32, 32, 33, 33));
+
+		// Spanning several tiles joins into a single rectangle
+		region.clear();
+		region.addRect(Common::Rect(10, 20, 300, 190));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(10, 20, 300, 190));
+
+		// Boxes within a tile grow to their bounding box
+		region.clear();
+		region.addRect(Common::Rect(1, 1, 4, 4));
+		region.addRect(Common::Rect(20, 10, 25, 30));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(1, 1, 25, 30));
+
+		// Many small updates are limited by the number of tiles
+		region.clear();
+		for (int16 y = 0; y < 200; y += 3) {
+			for (int16 x = 0; x < 320; x += 3)
+				region.addRect(Common::Rect(x, y, x + 1, y + 1));
+		}
+		const Common::Array<Common::Rect> &rects = region.getRects();
+		TS_ASSERT(!overlap(rects));
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), 70U);
+	}
+
+	void test_merge() {
+		Graphics::DirtyRegion region(320, 200, Graphics::DirtyRegion::kStrategyMerge);
+
+		// Covered rectangles are dropped
+		region.addRect(Common::Rect(10, 10, 20, 20));
+		region.addRect(Common::Rect(0, 0, 50, 50));
+		region.addRect(Common::Rect(5, 5, 15, 15));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(0, 0, 50, 50));
+
+		// A chain of overlapping rectangles ends up as one
+		region.clear();
+		region.addRect(Common::Rect(0, 0, 10, 10));
+		region.addRect(Common::Rect(100, 100, 110, 110));
+		region.addRect(Common::Rect(5, 5, 105, 15));
+		region.addRect(Common::Rect(95, 12, 105, 105));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(region.getRects()[0], Common::Rect(0, 0, 110, 110));
+
+		// Separate rectangles stay separate
+		region.clear();
+		region.addRect(Common::Rect(0, 0, 10, 10));
+		region.addRect(Common::Rect(20, 0, 30, 10));
+		TS_ASSERT_EQUALS(region.getRects().size(), 2U);
+		TS_ASSERT(!overlap(region.getRects()));
+	}
+
+	void test_overdraw() {
+		Graphics::DirtyRegion region(320, 200, Graphics::DirtyRegion::kStrategyOverdraw, 25);
+
+		// Neighbours are joined when it doesn't add many pixels
+		region.addRect(Common::Rect(0, 0, 10, 10));
+		region.addRect(Common::Rect(11, 0, 21, 10));
+		TS_ASSERT_EQUALS(region.getRects().size(), 1U);
+		TS_ASSERT_EQUALS(area(region.getRects()), 210U);
+
+		// but not when the bounding box would be mostly clean
+		region.clear();
+		region.addRect(Common::Rect(0, 0, 10, 10));
+		region.addRect(Common::Rect(100, 100, 110, 110));
+		TS_ASSERT_EQUALS(region.getRects().size(), 2U);
+		TS_ASSERT_EQUALS(area(region.getRects()), 200U);
+	}
+};
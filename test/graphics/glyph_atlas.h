@@ -0,0 +1,60 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/fonts/glyph_atlas.h"
+
+class GlyphAtlasTestSuite : public CxxTest::TestSuite {
+public:
+	void test_packing() {
+		Graphics::GlyphAtlas atlas(64, 32);
+		Common::Array<Graphics::Surface> images;
+
+		for (int i = 0; i < 60; ++i) {
+			Graphics::Surface image;
+			atlas.allocate(3 + i % 11, 2 + i % 7, image);
+			TS_ASSERT_EQUALS(image.format.bytesPerPixel, 1);
+			TS_ASSERT_EQUALS(image.pitch, 64);
+
+			// Every area starts out empty and is filled with its own index
+			for (int y = 0; y < image.h; ++y) {
+				for (int x = 0; x < image.w; ++x) {
+					TS_ASSERT_EQUALS(*(byte *)image.getBasePtr(x, y), 0);
+					*(byte *)image.getBasePtr(x, y) = i + 1;
+				}
+			}
+			images.push_back(image);
+		}
+
+		// No area has been overwritten by another one
+		for (uint i = 0; i < images.size(); ++i) {
+			for (int y = 0; y < images[i].h; ++y) {
+				for (int x = 0; x < images[i].w; ++x)
+					TS_ASSERT_EQUALS(*(const byte *)images[i].getBasePtr(x, y), (byte)(i + 1));
+			}
+		}
+		TS_ASSERT_LESS_THAN(1u, atlas.getPageCount());
+		TS_ASSERT_LESS_THAN(atlas.getPageCount(), 8u);
+	}
+
+	void test_oversized_and_empty() {
+		Graphics::GlyphAtlas atlas(16, 16);
+		Graphics::Surface small, big, empty, next;
+
+		atlas.allocate(4, 4, small);
+		atlas.allocate(20, 10, big);
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 2u);
+		TS_ASSERT_EQUALS(big.pitch, 20);
+
+		// Smaller glyphs keep filling the first page
+		atlas.allocate(4, 4, next);
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 2u);
+		TS_ASSERT_EQUALS((const byte *)next.getPixels(), (const byte *)small.getPixels() + 4);
+
+		atlas.allocate(0, 5, empty);
+		TS_ASSERT_EQUALS(empty.w, 0);
+		TS_ASSERT_EQUALS(empty.h, 5);
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 2u);
+
+		atlas.clear();
+		TS_ASSERT_EQUALS(atlas.getPageCount(), 0u);
+	}
+};
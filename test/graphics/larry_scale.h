@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/larryScale.h"
+
+class LarryScaleTestImage : public Graphics::RowReader, public Graphics::RowWriter {
+public:
+	LarryScaleTestImage(int width, int height) : _width(width), _pixels(width * height) {}
+
+	const Graphics::LarryScaleColor *readRow(int y) { return &_pixels[y * _width]; }
+	void writeRow(int y, const Graphics::LarryScaleColor *row) { memcpy(&_pixels[y * _width], row, _width); }
+
+	Graphics::LarryScaleColor &at(int x, int y) { return _pixels[y * _width + x]; }
+	uint size() const { return _pixels.size(); }
+	const Graphics::LarryScaleColor &operator[](uint i) const { return _pixels[i]; }
+
+private:
+	int _width;
+	Common::Array<Graphics::LarryScaleColor> _pixels;
+};
+
+class LarryScaleTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/** Fills the image with blocks and lines of a few colors */
+	void fillCartoon(LarryScaleTestImage &image, int width, int height) {
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				if (nextRandom() % 6 == 0)
+					image.at(x, y) = 1 + nextRandom() % 4;
+				else if (y > 0 && nextRandom() % 3)
+					image.at(x, y) = image.at(x, y - 1);
+				else
+					image.at(x, y) = x > 0 ? image.at(x - 1, y) : 1;
+			}
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 0x2468ace0;
+	}
+
+	void test_flat_image_stays_flat() {
+		LarryScaleTestImage src(37, 21);
+		for (int y = 0; y < 21; ++y) {
+			for (int x = 0; x < 37; ++x)
+				src.at(x, y) = 7;
+		}
+
+		LarryScaleTestImage dst(74, 42);
+		Graphics::larryScale(37, 21, 0, src, 74, 42, dst);
+		for (uint i = 0; i < dst.size(); ++i)
+			TS_ASSERT_EQUALS(dst[i], 7);
+	}
+
+	void test_same_size_copies() {
+		LarryScaleTestImage src(40, 10);
+		fillCartoon(src, 40, 10);
+
+		LarryScaleTestImage dst(40, 10);
+		Graphics::larryScale(40, 10, 0, src, 40, 10, dst);
+		for (uint i = 0; i < dst.size(); ++i)
+			TS_ASSERT_EQUALS(dst[i], src[i]);
+	}
+
+	void test_no_new_colors() {
+		const int sizes[][2] = { { 53, 17 }, { 75, 40 }, { 106, 34 }, { 20, 9 } };
+		for (uint i = 0; i < ARRAYSIZE(sizes); ++i) {
+			LarryScaleTestImage src(53, 17);
+			fillCartoon(src, 53, 17);
+
+			const int width = sizes[i][0], height = sizes[i][1];
+			LarryScaleTestImage dst(width, height);
+			Graphics::larryScale(53, 17, 0, src, width, height, dst);
+
+			// The margin around the image has the transparent color, which
+			// edge pixels may take on
+			bool used[256] = { true };
+			for (uint j = 0; j < src.size(); ++j)
+				used[src[j]] = true;
+			for (uint j = 0; j < dst.size(); ++j)
+				TS_ASSERT(used[dst[j]]);
+		}
+	}
+
+	void test_doubled_lines_stay_connected() {
+		// A one pixel wide diagonal line on a flat background
+		LarryScaleTestImage src(24, 24);
+		for (int y = 0; y < 24; ++y) {
+			for (int x = 0; x < 24; ++x)
+				src.at(x, y) = x == y ? 2 : 1;
+		}
+
+		LarryScaleTestImage dst(48, 48);
+		Graphics::larryScale(24, 24, 0, src, 48, 48, dst);
+
+		// Every row of the doubled line has line pixels next to the previous row's
+		int lastX = -1;
+		for (int y = 4; y < 44; ++y) {
+			int x = 0;
+			while (x < 48 && dst.at(x, y) != 2)
+				++x;
+			TS_ASSERT(x < 48);
+			if (lastX >= 0)
+				TS_ASSERT(x >= lastX && x <= lastX + 2);
+			lastX = x;
+		}
+	}
+};
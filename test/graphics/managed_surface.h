@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+
+class ManagedSurfaceTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surf, int x, int y) {
+		const byte *p = (const byte *)surf.getBasePtr(x, y);
+		switch (surf.format.bytesPerPixel) {
+		case 1:
+			return *p;
+		case 2:
+			return *(const uint16 *)p;
+		default:
+			return *(const uint32 *)p;
+		}
+	}
+
+	static void setPixel(Graphics::Surface &surf, int x, int y, uint32 color) {
+		byte *p = (byte *)surf.getBasePtr(x, y);
+		switch (surf.format.bytesPerPixel) {
+		case 1:
+			*p = color;
+			break;
+		case 2:
+			*(uint16 *)p = color;
+			break;
+		default:
+			*(uint32 *)p = color;
+			break;
+		}
+	}
+
+	void fillRandom(Graphics::Surface &surf, uint32 transColor) {
+		for (int y = 0; y < surf.h; ++y) {
+			for (int x = 0; x < surf.w; ++x) {
+				// Make plenty of pixels transparent
+				uint32 color = nextRandom() % 3 ? nextRandom() ^ (nextRandom() << 16) : transColor;
+				if (surf.format.bytesPerPixel == 1)
+					color &= 0xFF;
+				else if (surf.format.bytesPerPixel == 2)
+					color &= 0xFFFF;
+				setPixel(surf, x, y, color);
+			}
+		}
+	}
+
+	/** Draws a transparent blit one pixel at a time */
+	static void referenceTransBlit(const Graphics::Surface &src, const Common::Rect &srcRect, Graphics::Surface &dest,
+			const Common::Rect &destRect, uint32 transColor, bool flipped, uint overrideColor, uint srcAlpha) {
+		const int scaleX = 0x100 * srcRect.width() / destRect.width();
+		const int scaleY = 0x100 * srcRect.height() / destRect.height();
+
+		for (int yCtr = 0; yCtr < destRect.height(); ++yCtr) {
+			const int destY = destRect.top + yCtr;
+			if (destY < 0 || destY >= dest.h)
+				continue;
+			const int srcY = srcRect.top + yCtr * scaleY / 0x100;
+
+			for (int xCtr = 0; xCtr < destRect.width(); ++xCtr) {
+				const int destX = destRect.left + xCtr;
+				if (destX < 0 || destX >= dest.w)
+					continue;
+
+				const int srcX = xCtr * scaleX / 0x100;
+				const uint32 srcVal = getPixel(src, srcRect.left + (flipped ? src.w - srcX - 1 : srcX), srcY);
+				if (srcVal == transColor)
+					continue;
+
+				if (src.format == dest.format && srcAlpha == 0xff) {
+					setPixel(dest, destX, destY, overrideColor ? overrideColor : srcVal);
+					continue;
+				}
+
+				byte a, r, g, b, rDest, gDest, bDest;
+				src.format.colorToARGB(srcVal, a, r, g, b);
+				dest.format.colorToRGB(getPixel(dest, destX, destY), rDest, gDest, bDest);
+				a = a * srcAlpha / 255;
+				if (a == 0)
+					continue;
+				const double alpha = (double)a / 255.0;
+				rDest = static_cast<byte>((r * alpha) + (rDest * (1.0 - alpha)));
+				gDest = static_cast<byte>((g * alpha) + (gDest * (1.0 - alpha)));
+				bDest = static_cast<byte>((b * alpha) + (bDest * (1.0 - alpha)));
+				setPixel(dest, destX, destY, dest.format.ARGBToColor(0xff, rDest, gDest, bDest));
+			}
+		}
+	}
+
+	bool checkTransBlit(const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &destFormat,
+			bool flipped, bool scaled, uint overrideColor, uint srcAlpha) {
+		const int srcW = 1 + nextRandom() % 50, srcH = 1 + nextRandom() % 10;
+		const int destW = 1 + nextRandom() % 60, destH = 1 + nextRandom() % 12;
+		const uint32 transColor = srcFormat.bytesPerPixel == 1 ? nextRandom() & 0xFF : srcFormat.RGBToColor(0xFF, 0, 0xFF);
+
+		Graphics::Surface src, expected;
+		src.create(srcW, srcH, srcFormat);
+		expected.create(destW, destH, destFormat);
+		fillRandom(src, transColor);
+		fillRandom(expected, 0);
+
+		Graphics::ManagedSurface dest(destW, destH, destFormat);
+		dest.blitFrom(expected);
+
+		// Flipped blits index from the end of the source surface
+		const Common::Rect srcRect = flipped ? Common::Rect(0, 0, srcW, srcH) :
+			Common::Rect(0, 0, 1 + nextRandom() % srcW, 1 + nextRandom() % srcH);
+		const int x = (int)(nextRandom() % (destW + 20)) - 10;
+		const int y = (int)(nextRandom() % (destH + 20)) - 10;
+		const Common::Rect destRect = scaled ?
+			Common::Rect(x, y, x + 1 + nextRandom() % 70, y + 1 + nextRandom() % 15) :
+			Common::Rect(x, y, x + srcRect.width(), y + srcRect.height());
+
+		dest.transBlitFrom(src, srcRect, destRect, transColor, flipped, overrideColor, srcAlpha);
+		referenceTransBlit(src, srcRect, expected, destRect, transColor, flipped, overrideColor, srcAlpha);
+
+		bool same = true;
+		for (int row = 0; row < destH; ++row)
+			same = same && !memcmp(dest.getBasePtr(0, row), expected.getBasePtr(0, row), destW * destFormat.bytesPerPixel);
+
+		expected.free();
+		src.free();
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x12345678;
+	}
+
+	void test_trans_blit_clut8() {
+		const Graphics::PixelFormat clut8 = Graphics::PixelFormat::createFormatCLUT8();
+		for (int k = 0; k < 40; ++k) {
+			TS_ASSERT(checkTransBlit(clut8, clut8, false, false, 0, 0xff));
+			TS_ASSERT(checkTransBlit(clut8, clut8, true, false, 0, 0xff));
+			TS_ASSERT(checkTransBlit(clut8, clut8, false, true, 0, 0xff));
+			TS_ASSERT(checkTransBlit(clut8, clut8, true, true, 0, 0xff));
+			TS_ASSERT(checkTransBlit(clut8, clut8, false, false, 7, 0xff));
+		}
+	}
+
+	void test_trans_blit_true_color() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		for (int k = 0; k < 20; ++k) {
+			TS_ASSERT(checkTransBlit(rgb565, rgb565, false, false, 0, 0xff));
+			TS_ASSERT(checkTransBlit(argb8888, argb8888, true, true, 0, 0xff));
+			TS_ASSERT(checkTransBlit(argb8888, argb8888, false, false, 0, 0x80));
+			TS_ASSERT(checkTransBlit(argb8888, rgb565, false, true, 0, 0xff));
+			TS_ASSERT(checkTransBlit(rgb565, argb8888, true, false, 0, 0xc0));
+		}
+	}
+
+	void test_blit_from_converts_and_blends() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
+		Graphics::Surface src;
+		src.create(3, 1, argb8888);
+		setPixel(src, 0, 0, argb8888.ARGBToColor(0, 0xFF, 0xFF, 0xFF));
+		setPixel(src, 1, 0, argb8888.ARGBToColor(0xFF, 0xFF, 0, 0));
+		setPixel(src, 2, 0, argb8888.ARGBToColor(0x80, 0xFF, 0xFF, 0xFF));
+
+		Graphics::ManagedSurface dest(4, 1, rgb565);
+		dest.clear(0);
+		dest.blitFrom(src, Common::Point(1, 0));
+
+		byte r, g, b;
+		TS_ASSERT_EQUALS(getPixel(dest.rawSurface(), 0, 0), 0u);
+		TS_ASSERT_EQUALS(getPixel(dest.rawSurface(), 1, 0), 0u);
+		TS_ASSERT_EQUALS(getPixel(dest.rawSurface(), 2, 0), rgb565.RGBToColor(0xFF, 0, 0));
+		rgb565.colorToRGB(getPixel(dest.rawSurface(), 3, 0), r, g, b);
+		TS_ASSERT(r > 0x70 && r < 0x90);
+		TS_ASSERT(g > 0x70 && g < 0x90);
+
+		src.free();
+	}
+};
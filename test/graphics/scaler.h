@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler.h"
+#include "graphics/scaler/scale2x.h"
+#include "graphics/scaler/scale3x.h"
+#include "common/taskscheduler.h"
+
+class ScalerTestSuite : public CxxTest::TestSuite {
+	/** Runs tasks right away, but splits parallel loops as if it had threads */
+	class SplittingScheduler : public Common::TaskScheduler {
+	public:
+		virtual uint getConcurrency() const { return 4; }
+	};
+
+	uint32 _seed;
+
+	uint16 nextPixel() {
+		// Few colours, so that neighbouring pixels are often equal
+		_seed = _seed * 1103515245 + 12345;
+		return ((_seed >> 16) % 3) * 0x4208;
+	}
+
+	enum {
+		kWidth = 37,
+		kHeight = 53,
+		// Room around the image for the neighbours the scalers look at
+		kSrcPitch = (kWidth + 2) * 2,
+		kSrcSize = (kHeight + 2) * kSrcPitch
+	};
+
+	void fillSource(uint16 *src) {
+		for (int i = 0; i < kSrcSize / 2; ++i)
+			src[i] = nextPixel();
+	}
+
+	bool checkStrips(ScalerProc *scaler, int scaleFactor) {
+		uint16 src[kSrcSize / 2];
+		fillSource(src);
+		const uint8 *srcPtr = (const uint8 *)src + kSrcPitch + 2;
+
+		const uint32 dstPitch = kWidth * scaleFactor * 2;
+		const uint32 dstSize = kHeight * scaleFactor * dstPitch;
+		uint8 *expected = new uint8[dstSize];
+		uint8 *dst = new uint8[dstSize];
+
+		scaler(srcPtr, kSrcPitch, expected, dstPitch, kWidth, kHeight);
+		SplittingScheduler scheduler;
+		scaleInStrips(scheduler, scaler, scaleFactor, srcPtr, kSrcPitch, dst, dstPitch, kWidth, kHeight);
+
+		const bool same = !memcmp(dst, expected, dstSize);
+		delete[] dst;
+		delete[] expected;
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x2468ACE1;
+		InitScalers(565);
+	}
+
+	void tearDown() {
+		DestroyScalers();
+	}
+
+	void test_scale_in_strips() {
+#ifdef USE_SCALERS
+		TS_ASSERT(checkStrips(Normal2x, 2));
+		TS_ASSERT(checkStrips(Normal3x, 3));
+		TS_ASSERT(checkStrips(AdvMame2x, 2));
+		TS_ASSERT(checkStrips(AdvMame3x, 3));
+		TS_ASSERT(checkStrips(_2xSaI, 2));
+		TS_ASSERT(checkStrips(DotMatrix, 2));
+#ifdef USE_HQ_SCALERS
+		TS_ASSERT(checkStrips(HQ2x, 2));
+		TS_ASSERT(checkStrips(HQ3x, 3));
+#endif
+#endif
+	}
+
+#ifdef SCALER_USE_SIMD
+	void test_simd_rows() {
+		uint16 src[kSrcSize / 2];
+		fillSource(src);
+		const uint16 *row = src + kSrcPitch / 2 + 1;
+		const uint16 *above = row - kSrcPitch / 2;
+		const uint16 *below = row + kSrcPitch / 2;
+
+		uint16 expected[3][kWidth * 3], actual[3][kWidth * 3];
+		for (uint count = 1; count <= kWidth; ++count) {
+			scale2x_16_def(expected[0], expected[1], above, row, below, count);
+			scale2x_16_simd(actual[0], actual[1], above, row, below, count);
+			TS_ASSERT(!memcmp(actual[0], expected[0], count * 2 * 2));
+			TS_ASSERT(!memcmp(actual[1], expected[1], count * 2 * 2));
+
+			scale3x_16_def(expected[0], expected[1], expected[2], above, row, below, count);
+			scale3x_16_simd(actual[0], actual[1], actual[2], above, row, below, count);
+			for (int i = 0; i < 3; ++i)
+				TS_ASSERT(!memcmp(actual[i], expected[i], count * 3 * 2));
+		}
+	}
+#endif
+};
@@ -0,0 +1,155 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/text_run_cache.h"
+
+/** A bitmap font with glyphs of different widths and a dither pattern */
+class TextRunTestFont : public Graphics::Font {
+public:
+	virtual int getFontHeight() const { return 8; }
+	virtual int getMaxCharWidth() const { return 6; }
+	virtual int getCharWidth(uint32 chr) const { return 4 + chr % 3; }
+
+	virtual void drawChar(Graphics::Surface *dst, uint32 chr, int x, int y, uint32 color) const {
+		for (int cy = MAX(y, 0); cy < MIN(y + getFontHeight(), (int)dst->h); ++cy) {
+			for (int cx = MAX(x, 0); cx < MIN(x + getCharWidth(chr), (int)dst->w); ++cx) {
+				if ((cx - x + cy - y + chr) % 3 == 0)
+					continue;
+				if (dst->format.bytesPerPixel == 1)
+					*(byte *)dst->getBasePtr(cx, cy) = color;
+				else if (dst->format.bytesPerPixel == 2)
+					*(uint16 *)dst->getBasePtr(cx, cy) = color;
+				else
+					*(uint32 *)dst->getBasePtr(cx, cy) = color;
+			}
+		}
+	}
+};
+
+class TextRunCacheTestSuite : public CxxTest::TestSuite {
+	TextRunTestFont _font;
+	Graphics::Surface _expected, _actual;
+
+	void createSurfaces(const Graphics::PixelFormat &format) {
+		_expected.create(40, 16, format);
+		_actual.create(40, 16, format);
+		byte *pixels = (byte *)_expected.getPixels();
+		for (int i = 0; i < _expected.pitch * _expected.h; ++i)
+			pixels[i] = i * 7;
+		_actual.copyFrom(_expected);
+	}
+
+	void freeSurfaces() {
+		_expected.free();
+		_actual.free();
+	}
+
+	bool sameSurfaces() const {
+		return !memcmp(_expected.getPixels(), _actual.getPixels(), _expected.pitch * _expected.h);
+	}
+
+public:
+	void test_draw_string() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat::createFormatCLUT8(),
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+		const Graphics::TextAlign aligns[] = { Graphics::kTextAlignLeft, Graphics::kTextAlignCenter, Graphics::kTextAlignRight };
+		const char *const texts[] = { "Hello", "A rather long text", "" };
+		Graphics::TextRunCache cache;
+
+		for (uint f = 0; f < ARRAYSIZE(formats); ++f) {
+			createSurfaces(formats[f]);
+			const uint32 colors[] = { 0xC3, 0xA5F1, 0xC3A5F1FF };
+			const uint32 color = colors[f];
+
+			for (uint t = 0; t < ARRAYSIZE(texts); ++t) {
+				for (uint a = 0; a < ARRAYSIZE(aligns); ++a) {
+					for (int deltax = 0; deltax < 6; deltax += 5) {
+						// Draw everything twice to compare both fresh and cached runs
+						for (int pass = 0; pass < 2; ++pass) {
+							const int x = pass * 10 - 5, y = pass * 6 - 2;
+							_font.drawString(&_expected, texts[t], x, y, 30, color, aligns[a], deltax, true);
+							cache.drawString(_font, &_actual, texts[t], x, y, 30, color, aligns[a], deltax, true);
+							TS_ASSERT(sameSurfaces());
+
+							const Common::U32String u32Text(texts[t]);
+							_font.drawString(&_expected, u32Text, x, y + 1, 24, color, aligns[a], deltax);
+							cache.drawString(_font, &_actual, u32Text, x, y + 1, 24, color, aligns[a], deltax);
+							TS_ASSERT(sameSurfaces());
+						}
+					}
+				}
+			}
+
+			freeSurfaces();
+		}
+
+		TS_ASSERT_LESS_THAN(0u, cache.getHits());
+	}
+
+	void test_hits_and_invalidate() {
+		Graphics::TextRunCache cache;
+		TextRunTestFont other;
+		createSurfaces(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+		cache.drawString(_font, &_actual, "Text", 0, 0, 40, 0xFFFF);
+		cache.drawString(_font, &_actual, "Text", 3, 4, 40, 0x1234);
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		// Anything affecting the layout makes a new run
+		cache.drawString(other, &_actual, "Text", 0, 0, 40, 0xFFFF);
+		cache.drawString(_font, &_actual, "Text", 0, 0, 39, 0xFFFF);
+		cache.drawString(_font, &_actual, "Text", 0, 0, 40, 0xFFFF, Graphics::kTextAlignRight);
+		TS_ASSERT_EQUALS(cache.getMisses(), 4u);
+
+		const uint32 usage = cache.getMemoryUsage();
+		cache.invalidate(&other);
+		TS_ASSERT_LESS_THAN(cache.getMemoryUsage(), usage);
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+
+		freeSurfaces();
+	}
+
+	void test_word_wrap() {
+		Graphics::TextRunCache cache;
+		const Common::String text("The quick brown fox jumps over the lazy dog\nagain");
+
+		for (int pass = 0; pass < 2; ++pass) {
+			Common::Array<Common::String> expected, actual;
+			expected.push_back("first");
+			actual.push_back("first");
+
+			TS_ASSERT_EQUALS(cache.wordWrapText(_font, text, 50, actual, 3), _font.wordWrapText(text, 50, expected, 3));
+			TS_ASSERT_EQUALS(actual.size(), expected.size());
+			for (uint i = 0; i < MIN(actual.size(), expected.size()); ++i)
+				TS_ASSERT_EQUALS(actual[i], expected[i]);
+
+			Common::Array<Common::U32String> expected32, actual32;
+			const Common::U32String text32(text);
+			TS_ASSERT_EQUALS(cache.wordWrapText(_font, text32, 70, actual32, 0, true, false), _font.wordWrapText(text32, 70, expected32, 0, true, false));
+			TS_ASSERT_EQUALS(actual32.size(), expected32.size());
+			for (uint i = 0; i < MIN(actual32.size(), expected32.size()); ++i)
+				TS_ASSERT(actual32[i] == expected32[i]);
+		}
+
+		TS_ASSERT_EQUALS(cache.getHits(), 2u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 2u);
+	}
+
+	void test_memory_budget() {
+		Graphics::TextRunCache cache(1);
+		Common::Array<Common::String> lines;
+
+		cache.wordWrapText(_font, "one", 40, lines);
+		cache.wordWrapText(_font, "two", 40, lines);
+		// Only the most recent result is kept when above the budget
+		cache.wordWrapText(_font, "two", 40, lines);
+		cache.wordWrapText(_font, "one", 40, lines);
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 3u);
+		TS_ASSERT_EQUALS(lines.size(), 4u);
+	}
+};
@@ -0,0 +1,87 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transform_cache.h"
+
+class TransformCacheTestSuite : public CxxTest::TestSuite {
+	Graphics::TransparentSurface _src;
+
+public:
+	void setUp() {
+		_src.create(16, 8, Graphics::TransparentSurface::getSupportedPixelFormat());
+		for (int y = 0; y < _src.h; ++y) {
+			for (int x = 0; x < _src.w; ++x)
+				*(uint32 *)_src.getBasePtr(x, y) = (x << 24) | (y << 16) | 0xFF;
+		}
+	}
+
+	void tearDown() {
+		_src.free();
+	}
+
+	void test_hits_and_misses() {
+		Graphics::TransformCache cache;
+		const Common::Rect area(0, 0, 16, 8);
+
+		Graphics::TransformCache::SurfacePtr a = cache.scale(_src, area, &_src, 0, 32, 16, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(a->w, 32);
+		TS_ASSERT_EQUALS(a->h, 16);
+		TS_ASSERT_EQUALS(*(const uint32 *)a->getBasePtr(31, 15), (uint32)((15 << 24) | (7 << 16) | 0xFF));
+
+		TS_ASSERT_EQUALS(cache.scale(_src, area, &_src, 0, 32, 16, Graphics::FILTER_NEAREST).get(), a.get());
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		// Any difference in the key makes a new result
+		TS_ASSERT_DIFFERS(cache.scale(_src, area, &_src, 1, 32, 16, Graphics::FILTER_NEAREST).get(), a.get());
+		TS_ASSERT_DIFFERS(cache.scale(_src, area, &_src, 0, 32, 16, Graphics::FILTER_BILINEAR).get(), a.get());
+		TS_ASSERT_DIFFERS(cache.scale(_src, area, &_src, 0, 32, 17, Graphics::FILTER_NEAREST).get(), a.get());
+		TS_ASSERT_EQUALS(cache.getMisses(), 4u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), (uint32)(32 * 16 * 4 * 3 + 32 * 17 * 4));
+
+		cache.invalidate(&_src);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+		// The result stays valid for as long as it is referenced
+		TS_ASSERT_EQUALS(a->w, 32);
+	}
+
+	void test_parts_and_rotation() {
+		Graphics::TransformCache cache;
+
+		Graphics::TransformCache::SurfacePtr part = cache.scale(_src, Common::Rect(4, 2, 8, 4), &_src, 0, 8, 4, Graphics::FILTER_BILINEAR);
+		TS_ASSERT_EQUALS(*(const uint32 *)part->getBasePtr(0, 0), (uint32)((4 << 24) | (2 << 16) | 0xFF));
+
+		const Graphics::TransformStruct transform(100, 100, 90);
+		Graphics::TransformCache::SurfacePtr rotated = cache.rotoscale(_src, Common::Rect(0, 0, 16, 8), &_src, 0, transform, Graphics::FILTER_NEAREST);
+		TS_ASSERT_LESS_THAN(rotated->w, rotated->h);
+
+		// Colour modulation makes no difference to the result
+		Graphics::TransformStruct tinted = transform;
+		tinted._rgbaMod = 0x80FFFFFF;
+		TS_ASSERT_EQUALS(cache.rotoscale(_src, Common::Rect(0, 0, 16, 8), &_src, 0, tinted, Graphics::FILTER_NEAREST).get(), rotated.get());
+	}
+
+	void test_memory_budget() {
+		const uint32 size = 16 * 8 * 4;
+		Graphics::TransformCache cache(size * 2);
+		const Common::Rect area(0, 0, 16, 8);
+
+		cache.scale(_src, area, &_src, 0, 16, 8, Graphics::FILTER_NEAREST);
+		cache.scale(_src, area, &_src, 1, 16, 8, Graphics::FILTER_NEAREST);
+		// Using the first result makes the second one the least recently used
+		cache.scale(_src, area, &_src, 0, 16, 8, Graphics::FILTER_NEAREST);
+		cache.scale(_src, area, &_src, 2, 16, 8, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), size * 2);
+
+		cache.resetStats();
+		cache.scale(_src, area, &_src, 0, 16, 8, Graphics::FILTER_NEAREST);
+		cache.scale(_src, area, &_src, 2, 16, 8, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getHits(), 2u);
+		cache.scale(_src, area, &_src, 1, 16, 8, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		cache.setMemoryBudget(0);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), size);
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+	}
+};
@@ -0,0 +1,148 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	uint32 randomPixel() {
+		// Favour fully transparent and fully opaque pixels
+		const uint32 rgb = (nextRandom() << 8) & 0xFFFFFF00;
+		switch (nextRandom() % 4) {
+		case 0:
+			return rgb;
+		case 1:
+			return rgb | 0xFF;
+		default:
+			return rgb | (nextRandom() & 0xFF);
+		}
+	}
+
+	/** Blends a single pixel the way the original scalar code does */
+	static uint32 blendPixel(uint32 in, uint32 out, uint32 color, Graphics::TSpriteBlendMode mode) {
+		uint32 i[4], o[4], c[4];
+		for (int k = 0; k < 4; ++k) {
+			i[k] = (in >> (k * 8)) & 0xFF;
+			o[k] = (out >> (k * 8)) & 0xFF;
+		}
+		// Color modulation in the same channel order: A, B, G, R
+		c[0] = color >> 24;
+		c[1] = color & 0xFF;
+		c[2] = (color >> 8) & 0xFF;
+		c[3] = (color >> 16) & 0xFF;
+
+		const bool tint = (color != 0xFFFFFFFF);
+		const uint32 a = i[0];
+		const uint32 ina = tint ? a * c[0] >> 8 : a;
+		for (int k = 1; k < 4; ++k) {
+			const uint32 cc = tint ? c[k] : 255;
+			switch (mode) {
+			case Graphics::BLEND_ADDITIVE:
+				o[k] = MIN<uint32>(o[k] + (cc != 255 ? i[k] * cc * ina >> 16 : i[k] * ina >> 8), 255);
+				break;
+			case Graphics::BLEND_SUBTRACTIVE:
+				o[k] -= cc != 255 ? i[k] * cc * o[k] * a >> 24 : i[k] * o[k] * a >> 16;
+				break;
+			case Graphics::BLEND_MULTIPLY:
+				if (tint || a)
+					o[k] = o[k] * (cc != 255 ? i[k] * cc * ina >> 16 : i[k] * ina >> 8) >> 8;
+				break;
+			default:
+				if (!ina)
+					break;
+				if (tint)
+					o[k] = (o[k] * (255 - ina) >> 8) + (i[k] * ina * cc >> 16);
+				else
+					o[k] = (i[k] * a + o[k] * (255 - a)) >> 8;
+				break;
+			}
+		}
+		if ((mode == Graphics::BLEND_NORMAL && ina) || (mode == Graphics::BLEND_SUBTRACTIVE && tint))
+			o[0] = 255;
+
+		return o[0] | (o[1] << 8) | (o[2] << 16) | (o[3] << 24);
+	}
+
+	bool checkBlit(Graphics::TSpriteBlendMode mode, uint32 color, int flipping, bool premultiplied) {
+		const int w = 1 + nextRandom() % 20, h = 1 + nextRandom() % 3;
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+
+		Graphics::TransparentSurface src, dst, expected;
+		src.create(w, h, format);
+		dst.create(w, h, format);
+		expected.create(w, h, format);
+
+		for (int y = 0; y < h; ++y) {
+			for (int x = 0; x < w; ++x) {
+				*(uint32 *)src.getBasePtr(x, y) = randomPixel();
+				*(uint32 *)dst.getBasePtr(x, y) = nextRandom() ^ (nextRandom() << 16);
+			}
+		}
+
+		for (int y = 0; y < h; ++y) {
+			for (int x = 0; x < w; ++x) {
+				const int sx = (flipping & Graphics::FLIP_H) ? w - 1 - x : x;
+				const int sy = (flipping & Graphics::FLIP_V) ? h - 1 - y : y;
+				*(uint32 *)expected.getBasePtr(x, y) = blendPixel(*(const uint32 *)src.getBasePtr(sx, sy), *(const uint32 *)dst.getBasePtr(x, y), color, mode);
+			}
+		}
+
+		if (premultiplied)
+			src.premultiplyAlpha();
+		src.blit(dst, 0, 0, flipping, nullptr, color, -1, -1, mode);
+
+		// Premultiplied colors are rounded differently
+		const int tolerance = premultiplied ? 2 : 0;
+		bool same = true;
+		for (int y = 0; y < h; ++y) {
+			const byte *d = (const byte *)dst.getBasePtr(0, y);
+			const byte *e = (const byte *)expected.getBasePtr(0, y);
+			for (int x = 0; x < w * 4; ++x)
+				same = same && ABS(d[x] - e[x]) <= tolerance;
+		}
+
+		src.free();
+		dst.free();
+		expected.free();
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x87654321;
+	}
+
+	void test_blend_modes() {
+		const uint32 colors[] = { 0xFFFFFFFF, 0xFF80FF40, 0x80FFFFFF, 0xC0204060 };
+		for (int mode = Graphics::BLEND_NORMAL; mode < Graphics::NUM_BLEND_MODES; ++mode) {
+			for (uint c = 0; c < ARRAYSIZE(colors); ++c) {
+				for (int flipping = 0; flipping <= Graphics::FLIP_HV; ++flipping) {
+					for (int k = 0; k < 5; ++k)
+						TS_ASSERT(checkBlit((Graphics::TSpriteBlendMode)mode, colors[c], flipping, false));
+				}
+			}
+		}
+	}
+
+	void test_premultiplied() {
+		Graphics::TransparentSurface surf;
+		surf.create(2, 1, Graphics::TransparentSurface::getSupportedPixelFormat());
+		*(uint32 *)surf.getBasePtr(0, 0) = 0xFF804080;
+		*(uint32 *)surf.getBasePtr(1, 0) = 0xFFFFFF00;
+		surf.premultiplyAlpha();
+		TS_ASSERT(surf.isPremultiplied());
+		TS_ASSERT_EQUALS(*(const uint32 *)surf.getBasePtr(0, 0), 0x80402080u);
+		TS_ASSERT_EQUALS(*(const uint32 *)surf.getBasePtr(1, 0), 0x00000000u);
+		surf.free();
+
+		for (int mode = Graphics::BLEND_NORMAL; mode < Graphics::NUM_BLEND_MODES; ++mode) {
+			for (int k = 0; k < 20; ++k)
+				TS_ASSERT(checkBlit((Graphics::TSpriteBlendMode)mode, 0xFFFFFFFF, Graphics::FLIP_NONE, true));
+		}
+	}
+};
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/** Converts a single pixel the way the original lookup tables do */
+	static uint32 referencePixel(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int y, int u, int v) {
+		const int16 cr = v - 128, cb = u - 128;
+		const int c[3] = {
+			y + (int16)((0.419 / 0.299) * cr),
+			y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb),
+			y + (int16)((0.587 / 0.331) * cb)
+		};
+
+		byte rgb[3];
+		for (int i = 0; i < 3; ++i) {
+			if (scale == Graphics::YUVToRGBManager::kScaleFull)
+				rgb[i] = CLIP(c[i], 0, 255);
+			else
+				rgb[i] = (CLIP(c[i], 16, 235) - 16) * 255 / 219;
+		}
+		return format.RGBToColor(rgb[0], rgb[1], rgb[2]);
+	}
+
+	static uint32 readPixel(const Graphics::Surface &surface, int x, int y) {
+		const byte *p = (const byte *)surface.getBasePtr(x, y);
+		return surface.format.bytesPerPixel == 2 ? *(const uint16 *)p : *(const uint32 *)p;
+	}
+
+	/** Converts a random image with the given chroma subsampling and checks every pixel */
+	bool check(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int shift, int width, int height) {
+		const int block = 1 << shift;
+		const int yPitch = width + nextRandom() % 8;
+		// 410 needs an extra chroma row and column to interpolate with
+		const int uvWidth = width / block + (shift == 2 ? 1 : 0);
+		const int uvHeight = height / block + (shift == 2 ? 1 : 0);
+		const int uvPitch = uvWidth + nextRandom() % 8;
+
+		byte *ySrc = new byte[yPitch * height];
+		byte *uSrc = new byte[uvPitch * uvHeight];
+		byte *vSrc = new byte[uvPitch * uvHeight];
+		for (int i = 0; i < yPitch * height; ++i)
+			ySrc[i] = nextRandom();
+		for (int i = 0; i < uvPitch * uvHeight; ++i) {
+			uSrc[i] = nextRandom();
+			vSrc[i] = nextRandom();
+		}
+
+		Graphics::Surface dst;
+		dst.create(width, height, format);
+
+		if (shift == 0)
+			YUVToRGBMan.convert444(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+		else if (shift == 1)
+			YUVToRGBMan.convert420(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+		else
+			YUVToRGBMan.convert410(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+		bool same = true;
+		for (int y = 0; y < height && same; ++y) {
+			for (int x = 0; x < width && same; ++x) {
+				const int index = (y >> shift) * uvPitch + (x >> shift);
+				int u = uSrc[index], v = vSrc[index];
+				if (shift == 2) {
+					const int xDiff = x & 3, yDiff = y & 3;
+					u = (uSrc[index] * (4 - xDiff) * (4 - yDiff) + uSrc[index + 1] * xDiff * (4 - yDiff) +
+					     uSrc[index + uvPitch] * yDiff * (4 - xDiff) + uSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+					v = (vSrc[index] * (4 - xDiff) * (4 - yDiff) + vSrc[index + 1] * xDiff * (4 - yDiff) +
+					     vSrc[index + uvPitch] * yDiff * (4 - xDiff) + vSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+				}
+				same = readPixel(dst, x, y) == referencePixel(format, scale, ySrc[y * yPitch + x], u, v);
+			}
+		}
+
+		dst.free();
+		delete[] vSrc;
+		delete[] uSrc;
+		delete[] ySrc;
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x87654321;
+	}
+
+	void test_formats_and_scales() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),  // RGB565
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),  // RGB555
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12),  // ARGB4444
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), // RGBA8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24), // ABGR8888
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)   // RGB888 with padding
+		};
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(formats); ++i) {
+			for (uint j = 0; j < ARRAYSIZE(scales); ++j) {
+				for (int shift = 0; shift <= 2; ++shift) {
+					// Widths that are not a multiple of the vector size leave a tail
+					TS_ASSERT(check(formats[i], scales[j], shift, 44, 8));
+					TS_ASSERT(check(formats[i], scales[j], shift, 4 << shift, 4));
+					TS_ASSERT(check(formats[i], scales[j], shift, 64, 4));
+				}
+				TS_ASSERT(check(formats[i], scales[j], 0, 27, 3));
+			}
+		}
+	}
+
+	void test_all_chroma_values() {
+		// Every chroma pair once, with the luminance at both ends of the range
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		for (int k = 0; k < 2; ++k) {
+			const Graphics::YUVToRGBManager::LuminanceScale scale = k ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull;
+			byte *ySrc = new byte[256 * 256];
+			byte *uSrc = new byte[256 * 256];
+			byte *vSrc = new byte[256 * 256];
+			for (int i = 0; i < 256 * 256; ++i) {
+				ySrc[i] = (i & 1) ? 255 - (i >> 10) : (i >> 10);
+				uSrc[i] = i & 0xFF;
+				vSrc[i] = i >> 8;
+			}
+
+			Graphics::Surface dst;
+			dst.create(256, 256, format);
+			YUVToRGBMan.convert444(&dst, scale, ySrc, uSrc, vSrc, 256, 256, 256, 256);
+
+			uint mismatches = 0;
+			for (int i = 0; i < 256 * 256; ++i) {
+				if (readPixel(dst, i & 0xFF, i >> 8) != referencePixel(format, scale, ySrc[i], uSrc[i], vSrc[i]))
+					++mismatches;
+			}
+			TS_ASSERT_EQUALS(mismatches, 0u);
+
+			dst.free();
+			delete[] vSrc;
+			delete[] uSrc;
+			delete[] ySrc;
+		}
+	}
+};
@@ -0,0 +1,147 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "image/codecs/msrle.h"
+#include "image/codecs/msvideo1.h"
+
+class CodecTestSuite : public CxxTest::TestSuite {
+	typedef void (CodecTestSuite::*FrameMaker)(Common::MemoryWriteStreamDynamic &frame);
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/** Random MS Video 1 data, which decodes whatever the bytes are */
+	void makeMSVideo1Frame(Common::MemoryWriteStreamDynamic &frame) {
+		const uint size = 2 + nextRandom() % 1200;
+		for (uint i = 0; i < size; ++i)
+			frame.writeByte(nextRandom());
+	}
+
+	/** Random MS RLE data made of runs, copies, skips and line ends */
+	void makeMSRLEFrame(Common::MemoryWriteStreamDynamic &frame) {
+		const uint codes = nextRandom() % 80;
+		for (uint i = 0; i < codes; ++i) {
+			switch (nextRandom() % 6) {
+			case 0:
+				frame.writeByte(0);
+				frame.writeByte(0);
+				break;
+			case 1:
+				frame.writeByte(0);
+				frame.writeByte(2);
+				frame.writeByte(nextRandom() % 8);
+				frame.writeByte(nextRandom() % 2);
+				break;
+			case 2: {
+				// Even lengths, as skipped copies ignore the padding byte
+				const byte count = 4 + 2 * (nextRandom() % 10);
+				frame.writeByte(0);
+				frame.writeByte(count);
+				for (uint j = 0; j < count; ++j)
+					frame.writeByte(nextRandom());
+				break;
+			}
+			default:
+				frame.writeByte(1 + nextRandom() % 30);
+				frame.writeByte(nextRandom());
+				break;
+			}
+		}
+		frame.writeByte(0);
+		frame.writeByte(1);
+	}
+
+	/**
+	 * Decodes frames once the usual way and once into part of a larger
+	 * surface, and compares the results
+	 */
+	bool checkDirectDecode(Image::Codec &expected, Image::Codec &direct, int w, int h, FrameMaker makeFrame) {
+		const Graphics::PixelFormat format = expected.getPixelFormat();
+		const int bpp = format.bytesPerPixel;
+
+		Graphics::Surface screen;
+		screen.create(w + 7, h + 5, format);
+		memset(screen.getPixels(), 0xA5, screen.pitch * screen.h);
+		Graphics::Surface area = screen.getSubArea(Common::Rect(3, 2, 3 + w, 2 + h));
+
+		bool same = true;
+		for (int i = 0; i < 12; ++i) {
+			Common::MemoryWriteStreamDynamic data(DisposeAfterUse::YES);
+			(this->*makeFrame)(data);
+
+			Common::MemoryReadStream stream1(data.getData(), data.size());
+			const Graphics::Surface *frame = expected.decodeFrame(stream1);
+
+			// The first frames go through the codec's own surface, which is
+			// then brought over to the screen
+			Common::MemoryReadStream stream2(data.getData(), data.size());
+			if (i < 2) {
+				direct.decodeFrame(stream2);
+				continue;
+			}
+
+			const Graphics::Surface *result = direct.decodeFrameInto(stream2, area);
+			same = same && result->getPixels() == area.getPixels();
+
+			for (int y = 0; y < h; ++y)
+				same = same && !memcmp(frame->getBasePtr(0, y), area.getBasePtr(0, y), w * bpp);
+		}
+
+		// Nothing outside the area was touched
+		for (int y = 0; y < screen.h; ++y) {
+			for (int x = 0; x < screen.w; ++x) {
+				if (x >= 3 && x < 3 + w && y >= 2 && y < 2 + h)
+					continue;
+				const byte *p = (const byte *)screen.getBasePtr(x, y);
+				for (int b = 0; b < bpp; ++b)
+					same = same && p[b] == 0xA5;
+			}
+		}
+
+		screen.free();
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x12345678;
+	}
+
+	void test_msvideo1_direct_decode() {
+		for (int k = 0; k < 10; ++k) {
+			const int w = 4 * (1 + nextRandom() % 10), h = 4 * (1 + nextRandom() % 8);
+			Image::MSVideo1Decoder expected8(w, h, 8), direct8(w, h, 8);
+			TS_ASSERT(checkDirectDecode(expected8, direct8, w, h, &CodecTestSuite::makeMSVideo1Frame));
+			Image::MSVideo1Decoder expected16(w, h, 16), direct16(w, h, 16);
+			TS_ASSERT(checkDirectDecode(expected16, direct16, w, h, &CodecTestSuite::makeMSVideo1Frame));
+		}
+	}
+
+	void test_msrle_direct_decode() {
+		for (int k = 0; k < 20; ++k) {
+			const int w = 1 + nextRandom() % 40, h = 1 + nextRandom() % 20;
+			Image::MSRLEDecoder expected(w, h, 8), direct(w, h, 8);
+			TS_ASSERT(checkDirectDecode(expected, direct, w, h, &CodecTestSuite::makeMSRLEFrame));
+		}
+	}
+
+	void test_direct_decode_falls_back() {
+		Image::MSRLEDecoder decoder(8, 8, 8);
+
+		// Too small for the frame, so it is decoded as usual
+		Graphics::Surface small;
+		small.create(4, 8, decoder.getPixelFormat());
+		Common::MemoryWriteStreamDynamic data(DisposeAfterUse::YES);
+		makeMSRLEFrame(data);
+		Common::MemoryReadStream stream(data.getData(), data.size());
+		const Graphics::Surface *frame = decoder.decodeFrameInto(stream, small);
+		TS_ASSERT(frame && frame->getPixels() != small.getPixels());
+		TS_ASSERT_EQUALS(frame->w, 8);
+		small.free();
+	}
+};
@@ -0,0 +1,107 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "image/bmp.h"
+#include "image/png.h"
+
+class ImageDecoderTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void fillSurface(Graphics::Surface &surface, uint w, uint h) {
+		surface.create(w, h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		for (uint y = 0; y < h; ++y) {
+			uint32 *dst = (uint32 *)surface.getBasePtr(0, y);
+			for (uint x = 0; x < w; ++x)
+				*dst++ = nextRandom() ^ (nextRandom() << 16);
+		}
+	}
+
+	static bool sameSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+		if (a.w != b.w || a.h != b.h || a.format != b.format)
+			return false;
+		for (int y = 0; y < a.h; ++y) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+	/** Checks that decoding to a format matches converting the native image */
+	bool checkDecoder(Image::ImageDecoder &decoder, Common::MemoryWriteStreamDynamic &file, const Graphics::PixelFormat &format) {
+		Common::MemoryReadStream nativeStream(file.getData(), file.size());
+		decoder.setOutputPixelFormat(Graphics::PixelFormat());
+		if (!decoder.loadStream(nativeStream))
+			return false;
+		Graphics::Surface *expected = decoder.getSurface()->convertTo(format, decoder.getPalette());
+
+		Common::MemoryReadStream stream(file.getData(), file.size());
+		decoder.setOutputPixelFormat(format);
+		const bool same = decoder.loadStream(stream) && sameSurfaces(*decoder.getSurface(), *expected);
+
+		expected->free();
+		delete expected;
+		return same;
+	}
+
+public:
+	void setUp() {
+		_seed = 0x12345678;
+	}
+
+	void test_png_output_format() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+
+		Graphics::Surface surface;
+		fillSurface(surface, 37, 11);
+		Common::MemoryWriteStreamDynamic file(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writePNG(file, surface));
+		surface.free();
+
+		Image::PNGDecoder decoder;
+		for (uint i = 0; i < ARRAYSIZE(formats); ++i)
+			TS_ASSERT(checkDecoder(decoder, file, formats[i]));
+	}
+
+	void test_bmp_output_format() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		Graphics::Surface surface;
+		fillSurface(surface, 13, 7);
+		Common::MemoryWriteStreamDynamic file(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writeBMP(file, surface));
+		surface.free();
+
+		Image::BitmapDecoder decoder;
+		for (uint i = 0; i < ARRAYSIZE(formats); ++i)
+			TS_ASSERT(checkDecoder(decoder, file, formats[i]));
+	}
+
+	void test_native_format() {
+		Graphics::Surface surface;
+		fillSurface(surface, 5, 3);
+		Common::MemoryWriteStreamDynamic file(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writePNG(file, surface));
+		surface.free();
+
+		// 3 byte formats cannot be written while decoding
+		Common::MemoryReadStream stream(file.getData(), file.size());
+		Image::PNGDecoder decoder;
+		decoder.setOutputPixelFormat(Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0));
+		TS_ASSERT(decoder.loadStream(stream));
+		TS_ASSERT_EQUALS(decoder.getSurface()->format.bytesPerPixel, 4);
+	}
+};
@@ -3,10 +3,12 @@
 # Use the 'test' target to run them.
 # Edit TESTS and TESTLIBS to add more tests.
 #
+# Micro-benchmarks live in test/bench, use the 'bench' target to run them.
+#
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/image/*.h
+TEST_LIBS    := audio/libaudio.a image/libimage.a graphics/libgraphics.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -42,8 +44,17 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+BENCH_SRCS   := $(wildcard $(srcdir)/test/bench/*.cpp)
+BENCH_LIBS   := image/libimage.a graphics/libgraphics.a audio/libaudio.a common/libcommon.a
+
+bench: test/bench/runner
+	./test/bench/runner
+test/bench/runner: $(BENCH_SRCS) $(BENCH_LIBS)
+	@mkdir -p test/bench
+	$(QUIET_CXX)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -I$(srcdir) -o $@ $+ $(TEST_LDFLAGS)
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner test/bench/runner
 
-.PHONY: test clean-test
+.PHONY: test bench clean-test
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -62,6 +63,7 @@ namespace Video {
 #define ID_REC  MKTAG('r','e','c',' ')
 #define ID_VEDT MKTAG('v','e','d','t')
 #define ID_IDX1 MKTAG('i','d','x','1')
+#define ID_INDX MKTAG('i','n','d','x')
 #define ID_STRD MKTAG('s','t','r','d')
 #define ID_INFO MKTAG('I','N','F','O')
 #define ID_ISFT MKTAG('I','S','F','T')
@@ -117,6 +119,7 @@ void AVIDecoder::initCommon() {
 	_movieListStart = 0;
 	_movieListEnd = 0;
 	_fileStream = 0;
+	_keyFrameScrubbing = false;
 	_videoTrackCounter = _audioTrackCounter = 0;
 	_lastAddedTrack = nullptr;
 	memset(&_header, 0, sizeof(_header));
@@ -216,6 +219,9 @@ bool AVIDecoder::parseNextChunk() {
 	case ID_IDX1:
 		readOldIndex(size);
 		break;
+	case ID_INDX:
+		readSuperIndex(size);
+		break;
 	default:
 		error("Unknown tag \'%s\' found", tag2str(tag));
 	}
@@ -416,6 +422,12 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 		return false;
 	}
 
+	// Fall back on the OpenDML index if there is no old-style one
+	if (_indexEntries.empty())
+		readStandardIndexes();
+
+	_indexEntries.buildStreamIndexes();
+
 	// Create the status entries
 	uint32 index = 0;
 	for (TrackListIterator it = getTrackListBegin(); it != getTrackListEnd(); it++, index++) {
@@ -462,6 +474,7 @@ void AVIDecoder::close() {
 	_movieListEnd = 0;
 
 	_indexEntries.clear();
+	_standardIndexOffsets.clear();
 	memset(&_header, 0, sizeof(_header));
 
 	_videoTracks.clear();
@@ -533,7 +546,7 @@ void AVIDecoder::handleNextPacket(TrackStatus &status) {
 				error("Expected 'rec ' LIST");
 
 			continue;
-		} else if (nextTag == ID_JUNK || nextTag == ID_IDX1) {
+		} else if (nextTag == ID_JUNK || nextTag == ID_IDX1 || isIndexChunk(nextTag)) {
 			skipChunk(size);
 			continue;
 		}
@@ -649,58 +662,47 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		frame = videoTrack->getFrameAtTime(time);
 	}
 
-	// Reset any palette, if necessary
-	videoTrack->useInitialPalette();
+	const StreamIndex *videoIndexes = _indexEntries.getStream(videoIndex);
+	if (!videoIndexes || frame >= videoIndexes->frames.size()) // This shouldn't happen.
+		return false;
 
-	int lastKeyFrame = -1;
-	int frameIndex = -1;
-	uint curFrame = 0;
+	// Binary search for the last keyframe at or before the target frame.
+	// The first frame is always a keyframe.
+	const Common::Array<uint32> &keyFrames = videoIndexes->keyFrames;
+	uint lo = 0, hi = keyFrames.size();
+	while (hi - lo > 1) {
+		uint mid = (lo + hi) / 2;
+		if (keyFrames[mid] <= frame)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	const uint keyFrame = keyFrames[lo];
 
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
+	// Without audio to keep in sync, scrubbing can present the keyframe itself
+	if (_keyFrameScrubbing && _audioTracks.empty())
+		frame = keyFrame;
 
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
+	const uint32 frameIndex = videoIndexes->frames[frame];
 
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
+	// Reset any palette, if necessary
+	videoTrack->useInitialPalette();
 
-		uint16 streamType = getStreamType(index.id);
+	// We need to handle any palette change up to the target frame since
+	// there's no flag to tell if this is a "key" palette.
+	for (uint32 i = 0; i < videoIndexes->palettes.size() && videoIndexes->palettes[i] < frameIndex; i++) {
+		const OldIndex &index = _indexEntries[videoIndexes->palettes[i]];
 
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
+		// Decode the palette
+		_fileStream->seek(index.offset + 8);
+		Common::SeekableReadStream *chunk = 0;
 
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
-
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
-			}
-
-			curFrame++;
-		}
+		videoTrack->loadPaletteFromChunk(chunk);
 	}
 
-	if (frameIndex < 0) // This shouldn't happen.
-		return false;
-
 	// Update all the audio tracks
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
 		AVIAudioTrack *audioTrack = (AVIAudioTrack *)_audioTracks[i].track;
@@ -711,25 +713,14 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
+		const StreamIndex *audioIndexes = _indexEntries.getStream(_audioTracks[i].index);
+		if (audioIndexes && frame < audioIndexes->chunks.size()) {
+			const uint32 j = audioIndexes->chunks[frame];
 			const OldIndex &index = _indexEntries[j];
-
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
-
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
-
-				chunksFound++;
-			}
+			_fileStream->seek(index.offset + 8);
+			Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
+			audioTrack->queueSound(audioChunk);
+			_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
@@ -737,25 +728,15 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	}
 
 	// Decode from keyFrame to curFrame - 1
-	for (int i = lastKeyFrame; i < frameIndex; i++) {
-		if (_indexEntries[i].id == ID_REC)
-			continue;
-
-		if (getStreamIndex(_indexEntries[i].id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(_indexEntries[i].id);
-
-		// Ignore palettes, they were already handled
-		if (streamType == kStreamTypePaletteChange)
-			continue;
+	for (uint i = keyFrame; i < frame; i++) {
+		const OldIndex &index = _indexEntries[videoIndexes->frames[i]];
 
 		// Frame, hopefully
-		_fileStream->seek(_indexEntries[i].offset + 8);
+		_fileStream->seek(index.offset + 8);
 		Common::SeekableReadStream *chunk = 0;
 
-		if (_indexEntries[i].size != 0)
-			chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
 		videoTrack->decodeFrame(chunk);
 	}
@@ -825,6 +806,8 @@ void AVIDecoder::readOldIndex(uint32 size) {
 	if (entryCount == 0)
 		return;
 
+	_indexEntries.reserve(entryCount);
+
 	// Read the first index separately
 	OldIndex firstEntry;
 	firstEntry.id = _fileStream->readUint32BE();
@@ -860,6 +843,86 @@ void AVIDecoder::readOldIndex(uint32 size) {
 	}
 }
 
+void AVIDecoder::readSuperIndex(uint32 size) {
+	uint32 startPos = _fileStream->pos();
+
+	uint16 longsPerEntry = _fileStream->readUint16LE();
+	_fileStream->readByte(); // index sub type
+	byte indexType = _fileStream->readByte();
+	uint32 entryCount = _fileStream->readUint32LE();
+	_fileStream->readUint32BE(); // chunk id
+	_fileStream->skip(12); // reserved
+
+	debug(7, "OpenDML Super Index: %d entries", entryCount);
+
+	// Only indexes of indexes are found in the stream header
+	if (indexType == AVI_INDEX_OF_INDEXES && longsPerEntry == 4) {
+		for (uint32 i = 0; i < entryCount && (uint32)_fileStream->pos() + 16 <= startPos + size; i++) {
+			uint32 offsetLow = _fileStream->readUint32LE();
+			uint32 offsetHigh = _fileStream->readUint32LE();
+			_fileStream->skip(8); // size and duration
+
+			// We only handle the first RIFF chunk, which is less than 4GB
+			if (offsetHigh == 0)
+				_standardIndexOffsets.push_back(offsetLow);
+		}
+	}
+
+	_fileStream->seek(startPos);
+	skipChunk(size);
+}
+
+bool AVIDecoder::isIndexEntryBefore(const OldIndex &a, const OldIndex &b) {
+	return a.offset < b.offset;
+}
+
+void AVIDecoder::readStandardIndexes() {
+	for (uint32 i = 0; i < _standardIndexOffsets.size(); i++) {
+		_fileStream->seek(_standardIndexOffsets[i]);
+
+		uint32 tag = _fileStream->readUint32BE();
+		_fileStream->readUint32LE(); // size
+		uint16 longsPerEntry = _fileStream->readUint16LE();
+		_fileStream->readByte(); // index sub type
+		byte indexType = _fileStream->readByte();
+		uint32 entryCount = _fileStream->readUint32LE();
+		uint32 chunkId = _fileStream->readUint32BE();
+		uint32 baseOffsetLow = _fileStream->readUint32LE();
+		uint32 baseOffsetHigh = _fileStream->readUint32LE();
+		_fileStream->readUint32LE(); // reserved
+
+		if (_fileStream->eos() || !isIndexChunk(tag) || indexType != AVI_INDEX_OF_CHUNKS || longsPerEntry != 2 || baseOffsetHigh != 0) {
+			warning("Invalid OpenDML index '%s'", tag2str(tag));
+			continue;
+		}
+
+		debug(7, "OpenDML Standard Index '%s': %d entries", tag2str(chunkId), entryCount);
+
+		for (uint32 j = 0; j < entryCount; j++) {
+			uint32 offset = _fileStream->readUint32LE();
+			uint32 size = _fileStream->readUint32LE();
+
+			// The offsets point at the chunk data, and the top bit of the
+			// size is set for chunks that aren't keyframes
+			OldIndex indexEntry;
+			indexEntry.id = chunkId;
+			indexEntry.flags = (size & 0x80000000) ? 0 : AVIIF_INDEX;
+			indexEntry.offset = baseOffsetLow + offset - 8;
+			indexEntry.size = size & 0x7FFFFFFF;
+
+			// Chunks out of the movie list are in RIFF extensions, which aren't read
+			if (indexEntry.offset < _movieListStart || indexEntry.offset + 8 > _movieListEnd)
+				continue;
+
+			_indexEntries.push_back(indexEntry);
+		}
+	}
+
+	// Each standard index only covers one stream, so bring the entries
+	// back into file order like an old-style index
+	Common::sort(_indexEntries.begin(), _indexEntries.end(), isIndexEntryBefore);
+}
+
 void AVIDecoder::checkTruemotion1() {
 	// If we got here from loadStream(), we know the track is valid
 	assert(!_videoTracks.empty());
@@ -903,6 +966,7 @@ AVIDecoder::AVIVideoTrack::AVIVideoTrack(int frameCount, const AVIStreamHeader &
 		: _frameCount(frameCount), _vidsHeader(streamHeader), _bmInfo(bitmapInfoHeader), _initialPalette(initialPalette) {
 	_videoCodec = createCodec();
 	_lastFrame = 0;
+	_outputSurface = 0;
 	_curFrame = -1;
 	_reversed = false;
 
@@ -916,7 +980,9 @@ AVIDecoder::AVIVideoTrack::~AVIVideoTrack() {
 
 void AVIDecoder::AVIVideoTrack::decodeFrame(Common::SeekableReadStream *stream) {
 	if (stream) {
-		if (_videoCodec)
+		if (_videoCodec && _outputSurface)
+			_lastFrame = _videoCodec->decodeFrameInto(*stream, *_outputSurface);
+		else if (_videoCodec)
 			_lastFrame = _videoCodec->decodeFrame(*stream);
 	} else {
 		// Empty frame
@@ -1140,15 +1206,49 @@ AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
 }
 
 AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
-	for (uint idx = 0, frameCtr = 0; idx < size(); ++idx) {
-		if ((*this)[idx].id != ID_REC &&
-				AVIDecoder::getStreamIndex((*this)[idx].id) == index) {
-			if (frameCtr++ == frameNumber)
-				return &(*this)[idx];
+	const StreamIndex *stream = getStream(index);
+	if (!stream || frameNumber >= stream->chunks.size())
+		return nullptr;
+
+	return &(*this)[stream->chunks[frameNumber]];
+}
+
+const AVIDecoder::StreamIndex *AVIDecoder::IndexEntries::getStream(uint index) const {
+	return index < _streams.size() ? &_streams[index] : nullptr;
+}
+
+void AVIDecoder::IndexEntries::buildStreamIndexes() {
+	_streams.clear();
+
+	for (uint idx = 0; idx < size(); ++idx) {
+		const OldIndex &entry = (*this)[idx];
+
+		// We don't care about RECs
+		if (entry.id == ID_REC)
+			continue;
+
+		uint streamIndex = AVIDecoder::getStreamIndex(entry.id);
+		if (streamIndex >= _streams.size())
+			_streams.resize(streamIndex + 1);
+
+		StreamIndex &stream = _streams[streamIndex];
+		stream.chunks.push_back(idx);
+
+		if ((entry.id & 0xFFFF) == kStreamTypePaletteChange) {
+			stream.palettes.push_back(idx);
+		} else {
+			// The first frame has to be a keyframe
+			if ((entry.flags & AVIIF_INDEX) || stream.frames.empty())
+				stream.keyFrames.push_back(stream.frames.size());
+
+			stream.frames.push_back(idx);
 		}
 	}
+}
 
-	return nullptr;
+void AVIDecoder::IndexEntries::clear() {
+	Common::Array<OldIndex>::clear();
+	_streams.clear();
 }
 
 } // End of namespace Video
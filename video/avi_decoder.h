@@ -96,6 +96,16 @@ public:
 	 * Decodes the next transparency track frame
 	 */
 	const Graphics::Surface *decodeNextTransparency();
+
+	/**
+	 * Enable or disable keyframe scrubbing.
+	 *
+	 * When enabled, seeking in a video without audio tracks stops at the
+	 * last keyframe before the requested time instead of decoding every
+	 * frame up to it. The remaining frames up to the requested time are
+	 * then played back as late frames.
+	 */
+	void setKeyFrameScrubbing(bool enable) { _keyFrameScrubbing = enable; }
 protected:
 	// VideoDecoder API
 	void readNextPacket();
@@ -151,6 +161,12 @@ protected:
 		uint32 size;
 	};
 
+	// OpenDML index types
+	enum IndexTypes {
+		AVI_INDEX_OF_INDEXES = 0x00,
+		AVI_INDEX_OF_CHUNKS = 0x01
+	};
+
 	// Index Flags
 	enum IndexFlags {
 		AVIIF_INDEX = 0x10
@@ -215,6 +231,7 @@ protected:
 		int getFrameCount() const { return _frameCount; }
 		Common::String &getName() { return _vidsHeader.name; }
 		const Graphics::Surface *decodeNextFrame() { return _lastFrame; }
+		void setOutputSurface(Graphics::Surface *surface) { _outputSurface = surface; }
 
 		const byte *getPalette() const;
 		bool hasDirtyPalette() const;
@@ -273,6 +290,7 @@ protected:
 
 		Image::Codec *_videoCodec;
 		const Graphics::Surface *_lastFrame;
+		Graphics::Surface *_outputSurface;
 		Image::Codec *createCodec();
 	};
 
@@ -320,15 +338,36 @@ protected:
 		uint32 chunkSearchOffset;
 	};
 
+	/** Positions in the index of the chunks of a single stream. */
+	struct StreamIndex {
+		Common::Array<uint32> chunks;    ///< All chunks, in file order
+		Common::Array<uint32> frames;    ///< Video frames, leaving out palette changes
+		Common::Array<uint32> keyFrames; ///< Frame numbers of the keyframes
+		Common::Array<uint32> palettes;  ///< Palette changes
+	};
+
 	class IndexEntries : public Common::Array<OldIndex> {
 	public:
 		OldIndex *find(uint index, uint frameNumber);
+		const StreamIndex *getStream(uint index) const;
+
+		/** Build the per-stream tables used by find() and seeking. */
+		void buildStreamIndexes();
+		void clear();
+
+	private:
+		Common::Array<StreamIndex> _streams;
 	};
 
 	AVIHeader _header;
 
 	void readOldIndex(uint32 size);
+	void readSuperIndex(uint32 size);
+	void readStandardIndexes();
+	static bool isIndexEntryBefore(const OldIndex &a, const OldIndex &b);
 	IndexEntries _indexEntries;
+	Common::Array<uint32> _standardIndexOffsets; ///< Offsets of the OpenDML 'ix##' chunks
+	bool _keyFrameScrubbing;
 
 	Common::SeekableReadStream *_fileStream;
 	bool _decodedHeader;
@@ -349,6 +388,7 @@ protected:
 	void readStreamName(uint32 size);
 	uint16 getStreamType(uint32 tag) const { return tag & 0xFFFF; }
 	static byte getStreamIndex(uint32 tag);
+	static bool isIndexChunk(uint32 tag) { return (tag >> 16) == MKTAG16('i', 'x'); }
 	void checkTruemotion1();
 	uint getVideoTrackOffset(uint trackIndex, uint frameNumber = 0);
 
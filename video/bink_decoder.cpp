@@ -46,6 +46,14 @@
 #include "video/binkdata.h"
 #include "video/bink_decoder.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BINK_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BINK_USE_NEON
+#include <arm_neon.h>
+#endif
+
 static const uint32 kBIKfID = MKTAG('B', 'I', 'K', 'f');
 static const uint32 kBIKgID = MKTAG('B', 'I', 'K', 'g');
 static const uint32 kBIKhID = MKTAG('B', 'I', 'K', 'h');
@@ -186,7 +194,7 @@ void BinkDecoder::readNextPacket() {
 			//                  Number of samples in bytes
 			audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-			audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
+			audio.bits = new Common::BitStream32LELSBFast(new Common::SeekableSubReadStream(_bink,
 					audioPacketStart + 4, audioPacketEnd), DisposeAfterUse::YES);
 
 			audioTrack->decodePacket();
@@ -203,7 +211,7 @@ void BinkDecoder::readNextPacket() {
 	uint32 videoPacketStart = _bink->pos();
 	uint32 videoPacketEnd   = _bink->pos() + frameSize;
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
+	frame.bits = new Common::BitStream32LELSBFast(new Common::SeekableSubReadStream(_bink,
 			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
 
 	videoTrack->decodePacket(frame);
@@ -594,7 +602,7 @@ void BinkDecoder::BinkVideoTrack::deinitBundles() {
 
 void BinkDecoder::BinkVideoTrack::initHuffman() {
 	for (int i = 0; i < 16; i++)
-		_huffman[i] = new Common::Huffman<Common::BitStream32LELSB>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
+		_huffman[i] = new Common::Huffman<Common::BitStream32LELSBFast>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
 }
 
 byte BinkDecoder::BinkVideoTrack::getHuffmanSymbol(VideoFrame &video, Huffman &huffman) {
@@ -686,17 +694,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, true);
 
-	IDCT(block);
-
-	int32 *src   = block;
-	byte  *dest1 = ctx.dest;
-	byte  *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16, src += 8) {
-
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
-
-	}
+	IDCTPutScaled(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledFill(DecodeContext &ctx) {
@@ -816,11 +814,7 @@ void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
 
 	readResidue(*ctx.video, block, v);
 
-	byte  *dst = ctx.dest;
-	int16 *src = block;
-	for (int i = 0; i < 8; i++, dst += ctx.pitch, src += 8)
-		for (int j = 0; j < 8; j++)
-			dst[j] += src[j];
+	residueAdd(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
@@ -1308,6 +1302,208 @@ void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, i
 #define MUNGE_ROW(x) (((x) + 0x7F)>>8)
 #define IDCT_ROW(dest,src) IDCT_TRANSFORM(dest,0,1,2,3,4,5,6,7,0,1,2,3,4,5,6,7,MUNGE_ROW,src)
 
+#if defined(BINK_USE_SSE2) || defined(BINK_USE_NEON)
+
+// The vector IDCT runs the same integer arithmetic as IDCT_TRANSFORM on
+// four columns (or, after a transpose, four rows) at once, so its output
+// is identical to the scalar version.
+
+#ifdef BINK_USE_SSE2
+typedef __m128i IDCTVec;
+
+static inline IDCTVec idctLoad(const int32 *src) { return _mm_loadu_si128((const __m128i *)src); }
+static inline void idctStore(int32 *dest, IDCTVec v) { _mm_storeu_si128((__m128i *)dest, v); }
+static inline IDCTVec idctAdd(IDCTVec a, IDCTVec b) { return _mm_add_epi32(a, b); }
+static inline IDCTVec idctSub(IDCTVec a, IDCTVec b) { return _mm_sub_epi32(a, b); }
+static inline IDCTVec idctRound(IDCTVec a) { return _mm_srai_epi32(_mm_add_epi32(a, _mm_set1_epi32(0x7F)), 8); }
+
+/** (a * c) >> 11; SSE2 has no 32-bit multiply, so build it from two 32x32->64 products. */
+static inline IDCTVec idctMulShift(IDCTVec a, int32 c) {
+	const __m128i k = _mm_set1_epi32(c);
+	const __m128i even = _mm_shuffle_epi32(_mm_mul_epu32(a, k), _MM_SHUFFLE(0, 0, 2, 0));
+	const __m128i odd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(a, 32), k), _MM_SHUFFLE(0, 0, 2, 0));
+	return _mm_srai_epi32(_mm_unpacklo_epi32(even, odd), 11);
+}
+
+static inline void idctTranspose(IDCTVec *r) {
+	const __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+	const __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+	const __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+	const __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+	r[0] = _mm_unpacklo_epi64(t0, t1);
+	r[1] = _mm_unpackhi_epi64(t0, t1);
+	r[2] = _mm_unpacklo_epi64(t2, t3);
+	r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/** Truncate eight values to bytes, like assigning them to a byte does. */
+static inline __m128i idctNarrow(IDCTVec lo, IDCTVec hi) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i words = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+	return _mm_packus_epi16(words, words);
+}
+
+static inline void idctPutRow(byte *dest, IDCTVec lo, IDCTVec hi) {
+	_mm_storel_epi64((__m128i *)dest, idctNarrow(lo, hi));
+}
+
+static inline void idctAddRow(byte *dest, IDCTVec lo, IDCTVec hi) {
+	_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(_mm_loadl_epi64((const __m128i *)dest), idctNarrow(lo, hi)));
+}
+
+static inline void idctPutScaledRow(byte *dest1, byte *dest2, IDCTVec lo, IDCTVec hi) {
+	const __m128i bytes = idctNarrow(lo, hi);
+	const __m128i doubled = _mm_unpacklo_epi8(bytes, bytes);
+	_mm_storeu_si128((__m128i *)dest1, doubled);
+	_mm_storeu_si128((__m128i *)dest2, doubled);
+}
+
+static inline void residueAddRow(byte *dest, const int16 *src) {
+	const __m128i words = _mm_and_si128(_mm_loadu_si128((const __m128i *)src), _mm_set1_epi16(0xFF));
+	_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(_mm_loadl_epi64((const __m128i *)dest), _mm_packus_epi16(words, words)));
+}
+#else
+typedef int32x4_t IDCTVec;
+
+static inline IDCTVec idctLoad(const int32 *src) { return vld1q_s32(src); }
+static inline void idctStore(int32 *dest, IDCTVec v) { vst1q_s32(dest, v); }
+static inline IDCTVec idctAdd(IDCTVec a, IDCTVec b) { return vaddq_s32(a, b); }
+static inline IDCTVec idctSub(IDCTVec a, IDCTVec b) { return vsubq_s32(a, b); }
+static inline IDCTVec idctRound(IDCTVec a) { return vshrq_n_s32(vaddq_s32(a, vdupq_n_s32(0x7F)), 8); }
+static inline IDCTVec idctMulShift(IDCTVec a, int32 c) { return vshrq_n_s32(vmulq_n_s32(a, c), 11); }
+
+static inline void idctTranspose(IDCTVec *r) {
+	const int32x4x2_t t0 = vtrnq_s32(r[0], r[1]);
+	const int32x4x2_t t1 = vtrnq_s32(r[2], r[3]);
+	r[0] = vcombine_s32(vget_low_s32(t0.val[0]), vget_low_s32(t1.val[0]));
+	r[1] = vcombine_s32(vget_low_s32(t0.val[1]), vget_low_s32(t1.val[1]));
+	r[2] = vcombine_s32(vget_high_s32(t0.val[0]), vget_high_s32(t1.val[0]));
+	r[3] = vcombine_s32(vget_high_s32(t0.val[1]), vget_high_s32(t1.val[1]));
+}
+
+/** Truncate eight values to bytes, like assigning them to a byte does. */
+static inline uint8x8_t idctNarrow(IDCTVec lo, IDCTVec hi) {
+	return vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))));
+}
+
+static inline void idctPutRow(byte *dest, IDCTVec lo, IDCTVec hi) {
+	vst1_u8(dest, idctNarrow(lo, hi));
+}
+
+static inline void idctAddRow(byte *dest, IDCTVec lo, IDCTVec hi) {
+	vst1_u8(dest, vadd_u8(vld1_u8(dest), idctNarrow(lo, hi)));
+}
+
+static inline void idctPutScaledRow(byte *dest1, byte *dest2, IDCTVec lo, IDCTVec hi) {
+	const uint8x8_t bytes = idctNarrow(lo, hi);
+	const uint8x8x2_t doubled = vzip_u8(bytes, bytes);
+	const uint8x16_t row = vcombine_u8(doubled.val[0], doubled.val[1]);
+	vst1q_u8(dest1, row);
+	vst1q_u8(dest2, row);
+}
+
+static inline void residueAddRow(byte *dest, const int16 *src) {
+	vst1_u8(dest, vadd_u8(vld1_u8(dest), vmovn_u16(vreinterpretq_u16_s16(vld1q_s16(src)))));
+}
+#endif
+
+/** One pass of IDCT_TRANSFORM over eight vectors. */
+static inline void IDCTPass(IDCTVec *d, const IDCTVec *s) {
+	const IDCTVec a0 = idctAdd(s[0], s[4]);
+	const IDCTVec a1 = idctSub(s[0], s[4]);
+	const IDCTVec a2 = idctAdd(s[2], s[6]);
+	const IDCTVec a3 = idctMulShift(idctSub(s[2], s[6]), A1);
+	const IDCTVec a4 = idctAdd(s[5], s[3]);
+	const IDCTVec a5 = idctSub(s[5], s[3]);
+	const IDCTVec a6 = idctAdd(s[1], s[7]);
+	const IDCTVec a7 = idctSub(s[1], s[7]);
+	const IDCTVec b0 = idctAdd(a4, a6);
+	const IDCTVec b1 = idctMulShift(idctAdd(a5, a7), A3);
+	const IDCTVec b2 = idctAdd(idctSub(idctMulShift(a5, A4), b0), b1);
+	const IDCTVec b3 = idctSub(idctMulShift(idctSub(a6, a4), A1), b2);
+	const IDCTVec b4 = idctSub(idctAdd(idctMulShift(a7, A2), b3), b1);
+	d[0] = idctAdd(idctAdd(a0, a2), b0);
+	d[1] = idctAdd(idctSub(idctAdd(a1, a3), a2), b2);
+	d[2] = idctAdd(idctAdd(idctSub(a1, a3), a2), b3);
+	d[3] = idctSub(idctSub(a0, a2), b4);
+	d[4] = idctAdd(idctSub(a0, a2), b4);
+	d[5] = idctSub(idctAdd(idctSub(a1, a3), a2), b3);
+	d[6] = idctSub(idctSub(idctAdd(a1, a3), a2), b2);
+	d[7] = idctSub(idctAdd(a0, a2), b0);
+}
+
+/** Transform a block, leaving row i in out[2 * i] (left half) and out[2 * i + 1] (right half). */
+static void IDCTBlock(const int32 *block, IDCTVec *out) {
+	IDCTVec temp[16];
+	IDCTVec s[8], d[8];
+
+	for (int half = 0; half < 2; half++) {
+		for (int i = 0; i < 8; i++)
+			s[i] = idctLoad(block + 8 * i + 4 * half);
+		IDCTPass(d, s);
+		for (int i = 0; i < 8; i++)
+			temp[2 * i + half] = d[i];
+	}
+
+	for (int group = 0; group < 2; group++) {
+		// Turn four rows into eight column vectors
+		for (int half = 0; half < 2; half++) {
+			for (int i = 0; i < 4; i++)
+				s[4 * half + i] = temp[2 * (4 * group + i) + half];
+			idctTranspose(&s[4 * half]);
+		}
+
+		IDCTPass(d, s);
+
+		for (int half = 0; half < 2; half++) {
+			for (int i = 0; i < 4; i++)
+				d[4 * half + i] = idctRound(d[4 * half + i]);
+			idctTranspose(&d[4 * half]);
+			for (int i = 0; i < 4; i++)
+				out[2 * (4 * group + i) + half] = d[4 * half + i];
+		}
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+	IDCTVec rows[16];
+	IDCTBlock(block, rows);
+	for (int i = 0; i < 16; i++)
+		idctStore(block + 4 * i, rows[i]);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+	IDCTVec rows[16];
+	IDCTBlock(block, rows);
+	byte *dest = ctx.dest;
+	for (int i = 0; i < 8; i++, dest += ctx.pitch)
+		idctAddRow(dest, rows[2 * i], rows[2 * i + 1]);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
+	IDCTVec rows[16];
+	IDCTBlock(block, rows);
+	byte *dest = ctx.dest;
+	for (int i = 0; i < 8; i++, dest += ctx.pitch)
+		idctPutRow(dest, rows[2 * i], rows[2 * i + 1]);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPutScaled(DecodeContext &ctx, int32 *block) {
+	IDCTVec rows[16];
+	IDCTBlock(block, rows);
+	byte *dest = ctx.dest;
+	for (int i = 0; i < 8; i++, dest += ctx.pitch << 1)
+		idctPutScaledRow(dest, dest + ctx.pitch, rows[2 * i], rows[2 * i + 1]);
+}
+
+void BinkDecoder::BinkVideoTrack::residueAdd(DecodeContext &ctx, const int16 *block) {
+	byte *dest = ctx.dest;
+	for (int i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+		residueAddRow(dest, block);
+}
+
+#else
+
 static inline void IDCTCol(int32 *dest, const int32 *src) {
 	if ((src[8] | src[16] | src[24] | src[32] | src[40] | src[48] | src[56]) == 0) {
 		dest[ 0] =
@@ -1354,6 +1550,29 @@ void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
 	}
 }
 
+void BinkDecoder::BinkVideoTrack::IDCTPutScaled(DecodeContext &ctx, int32 *block) {
+	IDCT(block);
+
+	int32 *src   = block;
+	byte  *dest1 = ctx.dest;
+	byte  *dest2 = ctx.dest + ctx.pitch;
+	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16, src += 8) {
+
+		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
+			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::residueAdd(DecodeContext &ctx, const int16 *block) {
+	byte *dst = ctx.dest;
+	for (int i = 0; i < 8; i++, dst += ctx.pitch, block += 8)
+		for (int j = 0; j < 8; j++)
+			dst[j] += block[j];
+}
+
+#endif
+
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(&audio) {
@@ -101,7 +101,7 @@ private:
 
 		uint32 sampleCount;
 
-		Common::BitStream32LELSB *bits;
+		Common::BitStream32LELSBFast *bits;
 
 		bool first;
 
@@ -134,7 +134,7 @@ private:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream32LELSB *bits;
+		Common::BitStream32LELSBFast *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -248,7 +248,7 @@ private:
 
 		Bundle _bundles[kSourceMAX]; ///< Bundles for decoding all data types.
 
-		Common::Huffman<Common::BitStream32LELSB> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
+		Common::Huffman<Common::BitStream32LELSBFast> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
 
 		/** Huffman codebooks to use for decoding high nibbles in color data types. */
 		Huffman _colHighHuffman[16];
@@ -322,6 +322,10 @@ private:
 		void IDCT(int32 *block);
 		void IDCTPut(DecodeContext &ctx, int32 *block);
 		void IDCTAdd(DecodeContext &ctx, int32 *block);
+		void IDCTPutScaled(DecodeContext &ctx, int32 *block);
+
+		/** Add a residue block to the destination block. */
+		void residueAdd(DecodeContext &ctx, const int16 *block);
 	};
 
 	class BinkAudioTrack : public AudioTrack {
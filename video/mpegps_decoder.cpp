@@ -53,6 +53,7 @@ enum {
 MPEGPSDecoder::MPEGPSDecoder(double decibel) {
 	_decibel = decibel;
 	_demuxer = new MPEGPSDemuxer();
+	_seekTime = 0;
 }
 
 MPEGPSDecoder::~MPEGPSDecoder() {
@@ -80,6 +81,7 @@ void MPEGPSDecoder::close() {
 	VideoDecoder::close();
 	_demuxer->close();
 	_streamMap.clear();
+	_seekTime = 0;
 }
 
 MPEGPSDecoder::MPEGStream *MPEGPSDecoder::getStream(uint32 startCode, Common::SeekableReadStream *packet) {
@@ -174,6 +176,10 @@ void MPEGPSDecoder::readNextPacket() {
 
 		MPEGStream *stream = getStream(startCode, packet);
 
+		// Audio from before the seek target would play out of sync
+		if (stream && stream->getStreamType() == MPEGStream::kStreamTypeAudio && pts != 0xFFFFFFFF && pts / 90 < _seekTime)
+			stream = 0;
+
 		if (stream) {
 			packet->seek(0);
 
@@ -187,6 +193,51 @@ void MPEGPSDecoder::readNextPacket() {
 	}
 }
 
+bool MPEGPSDecoder::seekIntern(const Audio::Timestamp &time) {
+	MPEGVideoTrack *videoTrack = 0;
+	for (TrackListIterator it = getTrackListBegin(); it != getTrackListEnd(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
+			videoTrack = (MPEGVideoTrack *)*it;
+
+	if (!videoTrack)
+		return false;
+
+	// libmpeg2 can only pick up from a GOP once it has seen the sequence
+	// header, which comes with the first frame
+	if (videoTrack->getCurFrame() < 0)
+		readNextPacket();
+
+	const uint32 targetTime = time.msecs();
+	uint32 keyFramePts;
+	int keyFrame;
+	if (!_demuxer->seek(targetTime * 90, keyFramePts, keyFrame))
+		return false;
+
+	// The audio tracks are recreated from the first packets after the new
+	// position, as the packetized streams cannot drop what they have queued
+	Common::Array<int> audioStreams;
+	for (StreamMap::iterator it = _streamMap.begin(); it != _streamMap.end(); it++)
+		if (it->_value && it->_value->getStreamType() == MPEGStream::kStreamTypeAudio)
+			audioStreams.push_back(it->_key);
+
+	for (uint i = 0; i < audioStreams.size(); i++)
+		_streamMap.erase(audioStreams[i]);
+
+	Common::Array<Track *> audioTracks;
+	for (TrackListIterator it = getTrackListBegin(); it != getTrackListEnd(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeAudio)
+			audioTracks.push_back(*it);
+
+	for (uint i = 0; i < audioTracks.size(); i++) {
+		eraseTrack(audioTracks[i]);
+		delete audioTracks[i];
+	}
+
+	videoTrack->startSeek(keyFrame, keyFramePts / 90, targetTime);
+	_seekTime = targetTime;
+	return true;
+}
+
 bool MPEGPSDecoder::addFirstVideoTrack() {
 	int32 startCode;
 	uint32 pts, dts;
@@ -243,6 +294,8 @@ MPEGPSDecoder::PrivateStreamType MPEGPSDecoder::detectPrivateStreamType(Common::
 
 MPEGPSDecoder::MPEGPSDemuxer::MPEGPSDemuxer() {
 	_stream = 0;
+	_packOffset = 0;
+	_indexBuilt = false;
 }
 
 MPEGPSDecoder::MPEGPSDemuxer::~MPEGPSDemuxer() {
@@ -253,11 +306,7 @@ bool MPEGPSDecoder::MPEGPSDemuxer::loadStream(Common::SeekableReadStream *stream
 	close();
 
 	_stream = stream;
-
-	int queuedPackets = 0;
-	while (queueNextPacket() && queuedPackets < PREBUFFERED_PACKETS) {
-		queuedPackets++;
-	}
+	fillQueues();
 
 	return true;
 }
@@ -266,6 +315,22 @@ void MPEGPSDecoder::MPEGPSDemuxer::close() {
 	delete _stream;
 	_stream = 0;
 
+	flushQueues();
+	_packOffset = 0;
+	_indexBuilt = false;
+	_index.clear();
+}
+
+bool MPEGPSDecoder::MPEGPSDemuxer::fillQueues() {
+	int queuedPackets = 0;
+	while (queueNextPacket() && queuedPackets < PREBUFFERED_PACKETS) {
+		queuedPackets++;
+	}
+
+	return queuedPackets != 0;
+}
+
+void MPEGPSDecoder::MPEGPSDemuxer::flushQueues() {
 	while (!_audioQueue.empty()) {
 		Packet packet = _audioQueue.pop();
 		delete packet._stream;
@@ -338,6 +403,110 @@ Common::SeekableReadStream *MPEGPSDecoder::MPEGPSDemuxer::getNextPacket(uint32 c
 	return nullptr;
 }
 
+bool MPEGPSDecoder::MPEGPSDemuxer::seek(uint32 pts, uint32 &keyFramePts, int &keyFrame) {
+	if (!_indexBuilt)
+		buildIndex();
+
+	// Binary search for the last GOP starting at or before the target.
+	// Without one, demuxing starts over from the beginning.
+	uint32 offset = 0;
+	keyFramePts = 0;
+	keyFrame = 0;
+
+	if (!_index.empty() && _index[0].pts <= pts) {
+		uint lo = 0, hi = _index.size();
+		while (hi - lo > 1) {
+			uint mid = (lo + hi) / 2;
+			if (_index[mid].pts <= pts)
+				lo = mid;
+			else
+				hi = mid;
+		}
+
+		offset = _index[lo].offset;
+		keyFramePts = _index[lo].pts;
+		keyFrame = _index[lo].frame;
+	}
+
+	flushQueues();
+
+	if (!_stream->seek(offset))
+		return false;
+
+	_packOffset = offset;
+	fillQueues();
+	return true;
+}
+
+void MPEGPSDecoder::MPEGPSDemuxer::buildIndex() {
+	const int32 pos = _stream->pos();
+	_stream->seek(0);
+	_packOffset = 0;
+
+	// The video data is scanned for start codes: pictures are counted, and
+	// sequence or GOP headers in a packet with a PTS make an index entry.
+	// The state carries over packets, as start codes can span them.
+	int32 videoStartCode = -1;
+	uint32 state = 0xFFFFFFFF;
+	int frames = 0;
+	byte buffer[4096];
+
+	for (;;) {
+		int32 startCode;
+		uint32 pts, dts;
+		int size = readNextPacketHeader(startCode, pts, dts);
+
+		if (size < 0)
+			break;
+
+		const uint32 packOffset = _packOffset;
+		const int32 end = _stream->pos() + size;
+
+		if (startCode >= 0x1E0 && startCode <= 0x1EF && videoStartCode < 0)
+			videoStartCode = startCode;
+
+		if (startCode == videoStartCode) {
+			int gopFrame = -1;
+
+			while (size > 0) {
+				const uint32 chunk = _stream->read(buffer, MIN<int>(size, sizeof(buffer)));
+				if (chunk == 0)
+					break;
+
+				size -= chunk;
+
+				for (uint32 i = 0; i < chunk; i++) {
+					state = (state << 8) | buffer[i];
+
+					if ((state & 0xFFFFFF00) != 0x100)
+						continue;
+
+					const byte code = state & 0xFF;
+					if (code == 0x00)
+						frames++;
+					else if ((code == 0xB3 || code == 0xB8) && gopFrame < 0)
+						gopFrame = frames;
+				}
+			}
+
+			if (gopFrame >= 0 && pts != 0xFFFFFFFF && (_index.empty() || pts > _index.back().pts)) {
+				IndexEntry entry;
+				entry.offset = packOffset;
+				entry.pts = pts;
+				entry.frame = gopFrame;
+				_index.push_back(entry);
+			}
+		}
+
+		_stream->seek(end);
+	}
+
+	debug(1, "MPEG-PS index: %d GOPs, %d frames", _index.size(), frames);
+
+	_stream->seek(pos);
+	_indexBuilt = true;
+}
+
 bool MPEGPSDecoder::MPEGPSDemuxer::queueNextPacket() {
 	if (_stream->eos())
 		return false;
@@ -366,7 +535,7 @@ bool MPEGPSDecoder::MPEGPSDemuxer::queueNextPacket() {
 			return true;
 		}
 
-		delete _stream;
+		delete stream;
 	}
 }
 
@@ -383,7 +552,12 @@ int MPEGPSDecoder::MPEGPSDemuxer::readNextPacketHeader(int32 &startCode, uint32
 
 		uint32 lastSync = _stream->pos();
 
-		if (startCode == kStartCodePack || startCode == kStartCodeSystemHeader)
+		if (startCode == kStartCodePack) {
+			_packOffset = lastSync - 4;
+			continue;
+		}
+
+		if (startCode == kStartCodeSystemHeader)
 			continue;
 
 		int length = _stream->readUint16BE();
@@ -580,6 +754,7 @@ MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstP
 	_endOfTrack = false;
 	_curFrame = -1;
 	_framePts = 0xFFFFFFFF;
+	_seekTime = 0;
 	_nextFrameStartTime = Audio::Timestamp(0, 27000000); // 27 MHz timer
 
 	findDimensions(firstPacket, format);
@@ -642,6 +817,12 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 		}
 
 		_framePts = 0xFFFFFFFF;
+
+		// Frames before the seek target are only needed as references
+		if (_nextFrameStartTime.msecs() < (int)_seekTime)
+			foundFrame = false;
+		else
+			_seekTime = 0;
 	}
 #endif
 
@@ -654,6 +835,18 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 #endif
 }
 
+void MPEGPSDecoder::MPEGVideoTrack::startSeek(int keyFrame, uint32 keyFrameTime, uint32 targetTime) {
+	_endOfTrack = false;
+	_curFrame = keyFrame - 1;
+	_framePts = 0xFFFFFFFF;
+	_seekTime = targetTime;
+	_nextFrameStartTime = Audio::Timestamp(keyFrameTime, 27000000);
+
+#ifdef USE_MPEG2
+	_mpegDecoder->reset();
+#endif
+}
+
 void MPEGPSDecoder::MPEGVideoTrack::findDimensions(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format) {
 	// First, check for the picture start code
 	if (firstPacket->readUint32BE() != 0x1B3)
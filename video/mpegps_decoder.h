@@ -23,6 +23,7 @@
 #ifndef VIDEO_MPEGPS_DECODER_H
 #define VIDEO_MPEGPS_DECODER_H
 
+#include "common/array.h"
 #include "common/inttypes.h"
 #include "common/hashmap.h"
 #include "common/queue.h"
@@ -60,8 +61,13 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	bool isRewindable() const { return isSeekable(); }
+	bool rewind() { return seek(Audio::Timestamp(0, 1000)); }
+	bool isSeekable() const { return isVideoLoaded(); }
+
 protected:
 	void readNextPacket();
+	bool seekIntern(const Audio::Timestamp &time);
 	bool useAudioSync() const { return false; }
 
 private:
@@ -76,7 +82,24 @@ private:
 		Common::SeekableReadStream *getFirstVideoPacket(int32 &startCode, uint32 &pts, uint32 &dts);
 		Common::SeekableReadStream *getNextPacket(uint32 currentTime, int32 &startCode, uint32 &pts, uint32 &dts);
 
+		/**
+		 * Continue demuxing from the last GOP starting at or before the
+		 * given PTS. The index of GOP starts is built by scanning the
+		 * whole stream on the first call.
+		 *
+		 * @param pts          the PTS to seek to
+		 * @param keyFramePts  the PTS of the GOP demuxing continues from
+		 * @param keyFrame     the number of the first frame of that GOP
+		 */
+		bool seek(uint32 pts, uint32 &keyFramePts, int &keyFrame);
+
 	private:
+		// The start of a GOP, or of the stream
+		struct IndexEntry {
+			uint32 offset; // of the pack holding the GOP header
+			uint32 pts;
+			int frame;
+		};
 		class Packet {
 		public:
 			Packet(Common::SeekableReadStream *stream, int32 startCode, uint32 pts, uint32 dts) : _stream(stream), _startCode(startCode), _pts(pts), _dts(dts) {}
@@ -92,10 +115,16 @@ private:
 		int findNextStartCode(uint32 &size);
 		uint32 readPTS(int c);
 		void parseProgramStreamMap(int length);
+		void flushQueues();
+		void buildIndex();
 
 		Common::SeekableReadStream *_stream;
 		Common::Queue<Packet> _videoQueue;
 		Common::Queue<Packet> _audioQueue;
+
+		uint32 _packOffset;
+		bool _indexBuilt;
+		Common::Array<IndexEntry> _index;
 	};
 
 	// Base class for handling MPEG streams
@@ -131,10 +160,17 @@ private:
 
 		void setEndOfTrack() { _endOfTrack = true; }
 
+		/**
+		 * Prepare for packets from the start of a GOP after a seek. The
+		 * frames before the target time are decoded, but not shown.
+		 */
+		void startSeek(int keyFrame, uint32 keyFrameTime, uint32 targetTime);
+
 	private:
 		bool _endOfTrack;
 		int _curFrame;
 		uint32 _framePts;
+		uint32 _seekTime;
 		Audio::Timestamp _nextFrameStartTime;
 		Graphics::Surface *_surface;
 
@@ -196,6 +232,9 @@ private:
 
 	MPEGPSDemuxer *_demuxer;
 
+	// Audio before this time is dropped after a seek
+	uint32 _seekTime;
+
 	// A map from stream types to stream handlers
 	typedef Common::HashMap<int, MPEGStream *> StreamMap;
 	StreamMap _streamMap;
@@ -293,6 +293,7 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 	_curFrame = -1;
 	_durationOverride = -1;
 	_scaledSurface = 0;
+	_outputSurface = 0;
 	_curPalette = 0;
 	_dirtyPalette = false;
 	_reversed = false;
@@ -354,9 +355,22 @@ bool QuickTimeDecoder::VideoTrackHandler::endOfTrack() const {
 
 bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requestedTime) {
 	uint32 convertedFrames = requestedTime.convertToFramerate(_decoder->_timeScale).totalNumberOfFrames();
-	for (_curEdit = 0; !atLastEdit(); _curEdit++)
-		if (convertedFrames >= _parent->editList[_curEdit].timeOffset && convertedFrames < _parent->editList[_curEdit].timeOffset + _parent->editList[_curEdit].trackDuration)
-			break;
+	uint32 oldEdit = _curEdit;
+
+	// The edits follow each other, so binary search for the last one
+	// starting at or before the time and check that it contains it
+	uint32 lo = 0, hi = _parent->editList.size();
+	while (lo < hi) {
+		uint32 mid = (lo + hi) / 2;
+		if (_parent->editList[mid].timeOffset <= convertedFrames)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	_curEdit = _parent->editList.size();
+	if (lo > 0 && convertedFrames < _parent->editList[lo - 1].timeOffset + _parent->editList[lo - 1].trackDuration)
+		_curEdit = lo - 1;
 
 	// If we did reach the end of the track, break out
 	if (atLastEdit()) {
@@ -378,6 +392,13 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 		return true;
 	}
 
+	// Seeking to where a stopped segment ended, like a sequence continuing
+	// from the previous one, lands on the frame that is decoded next. Keep
+	// the codec state instead of decoding again from the keyframe.
+	if (_curEdit == oldEdit && !_reversed && _curFrame + 1 < (int32)_parent->frameCount &&
+			getRateAdjustedFrameTime() == (uint32)requestedTime.convertToFramerate(_parent->timeScale).totalNumberOfFrames())
+		return true;
+
 	enterNewEditList(false);
 
 	// One extra check for the end of a track
@@ -390,14 +411,28 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 
 	// Now we're in the edit and need to figure out what frame we need
 	Audio::Timestamp time = requestedTime.convertToFramerate(_parent->timeScale);
-	while (getRateAdjustedFrameTime() < (uint32)time.totalNumberOfFrames()) {
-		_curFrame++;
-		if (_durationOverride >= 0) {
-			_nextFrameStartTime += _durationOverride;
-			_durationOverride = -1;
-		} else {
-			_nextFrameStartTime += getFrameDuration();
+	if (getRateAdjustedFrameTime() < (uint32)time.totalNumberOfFrames()) {
+		// Once we step to a frame, the next one starts at its end. Binary
+		// search for the first frame ending at or after the time.
+		const uint32 editStartTime = _nextFrameStartTime;
+		const uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
+		uint32 first = _curFrame + 1, last = _parent->frameCount;
+		while (first < last) {
+			uint32 mid = (first + last) / 2;
+			const Common::QuickTimeParser::SampleTableEntry &sample = _parent->getSample(mid);
+			if (getRateAdjustedFrameTime(editStartTime + sample.time + sample.duration - mediaTime) < (uint32)time.totalNumberOfFrames())
+				first = mid + 1;
+			else
+				last = mid;
 		}
+
+		if (first >= _parent->frameCount)
+			error("Cannot find duration for frame %d", _parent->frameCount);
+
+		const Common::QuickTimeParser::SampleTableEntry &sample = _parent->getSample(first);
+		_curFrame = first;
+		_nextFrameStartTime = editStartTime + sample.time + sample.duration - mediaTime;
+		_durationOverride = -1;
 	}
 
 	// Check if we went past, then adjust the frame times
@@ -614,72 +649,32 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
-
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
-
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
-
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
-
-	if (actualChunk < 0)
+	if ((uint32)_curFrame >= MAX(_parent->sampleCount, _parent->frameCount))
 		error("Could not find data for frame %d", _curFrame);
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
-
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
-	}
-
-	// Finally, read in the raw data for the frame
-	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
+	const Common::QuickTimeParser::SampleTableEntry &sample = _parent->getSample(_curFrame);
+	if (!sample.inChunk)
+		error("Could not find data for frame %d", _curFrame);
 
-	if (_parent->sampleSize != 0)
-		return stream->readStream(_parent->sampleSize);
+	descId = sample.descId;
 
-	return stream->readStream(_parent->sampleSizes[_curFrame]);
+	// Seek to the frame and read in its raw data
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(sample.offset);
+	return stream->readStream(sample.size);
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getFrameDuration() {
-	uint32 curFrameIndex = 0;
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		curFrameIndex += _parent->timeToSample[i].count;
-		if ((uint32)_curFrame < curFrameIndex) {
-			// Ok, now we have what duration this frame has.
-			return _parent->timeToSample[i].duration;
-		}
+	if ((uint32)_curFrame >= _parent->frameCount) {
+		// This should never occur
+		error("Cannot find duration for frame %d", _curFrame);
 	}
 
-	// This should never occur
-	error("Cannot find duration for frame %d", _curFrame);
-	return 0;
+	return _parent->getSample(_curFrame).duration;
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
-
-	// If none found, we'll assume the requested frame is a key frame
-	return frame;
+	return _parent->findKeyframe(frame);
 }
 
 void QuickTimeDecoder::VideoTrackHandler::enterNewEditList(bool bufferFrames) {
@@ -691,31 +686,19 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditList(bool bufferFrames) {
 		return;
 
 	uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
-	uint32 frameNum = 0;
-	uint32 totalDuration = 0;
 	_durationOverride = -1;
 
 	// Track down where the mediaTime is in the media
 	// This is basically time -> frame mapping
 	// Note that this code uses first frame = 0
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		uint32 duration = _parent->timeToSample[i].count * _parent->timeToSample[i].duration;
-
-		if (totalDuration + duration >= mediaTime) {
-			uint32 frameInc = (mediaTime - totalDuration) / _parent->timeToSample[i].duration;
-			frameNum += frameInc;
-			totalDuration += frameInc * _parent->timeToSample[i].duration;
-
-			// If we didn't get to the exact media time, mark an override for
-			// the time.
-			if (totalDuration != mediaTime)
-				_durationOverride = totalDuration + _parent->timeToSample[i].duration - mediaTime;
-
-			break;
-		}
+	uint32 frameNum = _parent->findFrameAtTime(mediaTime);
 
-		frameNum += _parent->timeToSample[i].count;
-		totalDuration += duration;
+	// If we didn't get to the exact media time, mark an override for
+	// the time.
+	if (frameNum < _parent->frameCount) {
+		const Common::QuickTimeParser::SampleTableEntry &sample = _parent->getSample(frameNum);
+		if (sample.time != mediaTime)
+			_durationOverride = sample.time + sample.duration - mediaTime;
 	}
 
 	if (bufferFrames) {
@@ -753,7 +736,14 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 		return 0;
 	}
 
-	const Graphics::Surface *frame = entry->_videoCodec->decodeFrame(*frameData);
+	// Frames which still get dithered or scaled cannot go to the output directly
+	const bool direct = _outputSurface && !_forcedDitherPalette &&
+		_parent->scaleFactorX == 1 && _parent->scaleFactorY == 1 &&
+		_decoder->_scaleFactorX == 1 && _decoder->_scaleFactorY == 1;
+
+	const Graphics::Surface *frame = direct ?
+		entry->_videoCodec->decodeFrameInto(*frameData, *_outputSurface) :
+		entry->_videoCodec->decodeFrame(*frameData);
 	delete frameData;
 
 	// Update the palette
@@ -777,8 +767,12 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime() const {
+	return getRateAdjustedFrameTime(_nextFrameStartTime);
+}
+
+uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime(uint32 frameStartTime) const {
 	// Figure out what time the next frame is at taking the edit list rate into account
-	Common::Rational offsetFromEdit = Common::Rational(_nextFrameStartTime - getCurEditTimeOffset()) / _parent->editList[_curEdit].mediaRate;
+	Common::Rational offsetFromEdit = Common::Rational(frameStartTime - getCurEditTimeOffset()) / _parent->editList[_curEdit].mediaRate;
 	uint32 convertedTime = offsetFromEdit.toInt();
 
 	if ((offsetFromEdit.getNumerator() % offsetFromEdit.getDenominator()) > (offsetFromEdit.getDenominator() / 2))
@@ -142,6 +142,7 @@ private:
 		bool isReversed() const { return _reversed; }
 		bool canDither() const;
 		void setDither(const byte *palette);
+		void setOutputSurface(Graphics::Surface *surface) { _outputSurface = surface; }
 
 		Common::Rational getScaledWidth() const;
 		Common::Rational getScaledHeight() const;
@@ -153,6 +154,7 @@ private:
 		int32 _curFrame;
 		uint32 _nextFrameStartTime;
 		Graphics::Surface *_scaledSurface;
+		Graphics::Surface *_outputSurface;
 		int32 _durationOverride;
 		const byte *_curPalette;
 		mutable bool _dirtyPalette;
@@ -170,6 +172,7 @@ private:
 		void enterNewEditList(bool bufferFrames);
 		const Graphics::Surface *bufferNextFrame();
 		uint32 getRateAdjustedFrameTime() const;
+		uint32 getRateAdjustedFrameTime(uint32 frameStartTime) const;
 		uint32 getCurEditTimeOffset() const;
 		uint32 getCurEditTrackDuration() const;
 		bool atLastEdit() const;
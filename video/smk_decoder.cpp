@@ -134,6 +134,10 @@ uint16 SmallHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
 /*
  * class BigHuffmanTree
  * A Huffman-tree to hold 16-bit values.
+ *
+ * Codes of up to kLookupBits bits are resolved with a single table lookup.
+ * The table holds tree indices rather than values, since the values of the
+ * three "last value" leaves change while decoding.
  */
 
 class BigHuffmanTree {
@@ -148,14 +152,20 @@ private:
 		SMK_NODE = 0x80000000
 	};
 
-	uint32 decodeTree(uint32 prefix, int length);
+	enum {
+		kLookupBits = 12,
+		kLookupLengthBits = 4
+	};
+
+	uint32 decodeTree();
+	void buildLookup();
 
 	uint32  _treeSize;
 	uint32 *_tree;
 	uint32  _last[3];
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+	/** Tree index and code length for the next kLookupBits bits */
+	uint32 *_lookup;
 
 	/* Used during construction */
 	Common::BitStreamMemory8LSB &_bs;
@@ -166,17 +176,18 @@ private:
 
 BigHuffmanTree::BigHuffmanTree(Common::BitStreamMemory8LSB &bs, int allocSize)
 	: _bs(bs) {
+	_lookup = new uint32[1 << kLookupBits];
+
 	uint32 bit = _bs.getBit();
 	if (!bit) {
 		_tree = new uint32[1];
 		_tree[0] = 0;
+		_treeSize = 1;
 		_last[0] = _last[1] = _last[2] = 0;
+		buildLookup();
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
 	_loBytes = new SmallHuffmanTree(_bs);
 	_hiBytes = new SmallHuffmanTree(_bs);
 
@@ -188,7 +199,7 @@ BigHuffmanTree::BigHuffmanTree(Common::BitStreamMemory8LSB &bs, int allocSize)
 
 	_treeSize = 0;
 	_tree = new uint32[allocSize / 4];
-	decodeTree(0, 0);
+	decodeTree();
 	bit = _bs.getBit();
 	assert(!bit);
 
@@ -201,17 +212,20 @@ BigHuffmanTree::BigHuffmanTree(Common::BitStreamMemory8LSB &bs, int allocSize)
 
 	delete _loBytes;
 	delete _hiBytes;
+
+	buildLookup();
 }
 
 BigHuffmanTree::~BigHuffmanTree() {
 	delete[] _tree;
+	delete[] _lookup;
 }
 
 void BigHuffmanTree::reset() {
 	_tree[_last[0]] = _tree[_last[1]] = _tree[_last[2]] = 0;
 }
 
-uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
+uint32 BigHuffmanTree::decodeTree() {
 	uint32 bit = _bs.getBit();
 
 	if (!bit) { // Leaf
@@ -222,13 +236,6 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 		_tree[_treeSize] = v;
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
-				_prefixtree[prefix | i] = _treeSize;
-				_prefixlength[prefix | i] = length;
-			}
-		}
-
 		for (int i = 0; i < 3; ++i) {
 			if (_markers[i] == v) {
 				_last[i] = _treeSize;
@@ -242,23 +249,38 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint32 t = _treeSize++;
 
-	if (length == 8) {
-		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
-	}
-
-	uint32 r1 = decodeTree(prefix, length + 1);
+	uint32 r1 = decodeTree();
 
 	_tree[t] = SMK_NODE | r1;
 
-	uint32 r2 = decodeTree(prefix | (1 << length), length + 1);
+	uint32 r2 = decodeTree();
 	return r1+r2+1;
 }
 
+void BigHuffmanTree::buildLookup() {
+	// Walk the tree along every combination of the next kLookupBits bits,
+	// the first bit read being the lowest one
+	for (uint32 bits = 0; bits < (1 << kLookupBits); ++bits) {
+		uint32 index = 0;
+		uint32 length = 0;
+
+		while (length < kLookupBits && (_tree[index] & SMK_NODE)) {
+			if (bits & (1 << length))
+				index += _tree[index] & ~SMK_NODE;
+			index++;
+			length++;
+		}
+
+		_lookup[bits] = (index << kLookupLengthBits) | length;
+	}
+}
+
 uint32 BigHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
-	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
-	uint32 *p = &_tree[_prefixtree[peek]];
-	bs.skip(_prefixlength[peek]);
+	uint32 entry = _lookup[bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), kLookupBits))];
+	uint32 *p = &_tree[entry >> kLookupLengthBits];
+	bs.skip(entry & ((1 << kLookupLengthBits) - 1));
+
+	// Codes longer than kLookupBits continue from the node reached
 
 	while (*p & SMK_NODE) {
 		if (bs.getBit())
@@ -53,6 +53,9 @@ TheoraDecoder::TheoraDecoder() {
 	_videoTrack = 0;
 	_audioTrack = 0;
 	_hasVideo = _hasAudio = false;
+
+	// Keep a frame ready, so that slow frames do not hold up the engine
+	setDecodeAhead(1);
 }
 
 TheoraDecoder::~TheoraDecoder() {
@@ -222,6 +225,20 @@ void TheoraDecoder::close() {
 	_hasVideo = _hasAudio = false;
 }
 
+void TheoraDecoder::setPostProcessingLevel(int level) {
+	if (!_videoTrack)
+		return;
+
+	// The decoder may be in use by the decode ahead task
+	suspendDecodeAhead();
+	_videoTrack->setPostProcessingLevel(level);
+	resumeDecodeAhead();
+}
+
+int TheoraDecoder::getMaxPostProcessingLevel() const {
+	return _videoTrack ? _videoTrack->getMaxPostProcessingLevel() : 0;
+}
+
 void TheoraDecoder::readNextPacket() {
 	// First, let's get our frame
 	if (_hasVideo) {
@@ -255,9 +272,9 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &f
 	if (theoraInfo.pixel_fmt != TH_PF_420)
 		error("Only theora YUV420 is supported");
 
-	int postProcessingMax;
-	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &postProcessingMax, sizeof(postProcessingMax));
-	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &postProcessingMax, sizeof(postProcessingMax));
+	_postProcessingMax = 0;
+	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &_postProcessingMax, sizeof(_postProcessingMax));
+	setPostProcessingLevel(_postProcessingMax);
 
 	_surface.create(theoraInfo.frame_width, theoraInfo.frame_height, format);
 
@@ -280,6 +297,11 @@ TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
 	_displaySurface.setPixels(0);
 }
 
+void TheoraDecoder::TheoraVideoTrack::setPostProcessingLevel(int level) {
+	level = CLIP(level, 0, _postProcessingMax);
+	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &level, sizeof(level));
+}
+
 bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket) {
 	if (th_decode_packetin(_theoraDecode, &oggPacket, 0) == 0) {
 		_curFrame++;
@@ -71,6 +71,21 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	/**
+	 * Set how much post-processing is applied to decoded frames, from 0 for
+	 * none up to getMaxPostProcessingLevel(), the default. Lower levels leave
+	 * blockier frames but save CPU time, which engines can use to keep up on
+	 * slow systems.
+	 *
+	 * This must be called after loadStream().
+	 */
+	void setPostProcessingLevel(int level);
+
+	/**
+	 * Get the highest post-processing level of the loaded video.
+	 */
+	int getMaxPostProcessingLevel() const;
+
 protected:
 	void readNextPacket();
 
@@ -91,6 +106,9 @@ private:
 		bool decodePacket(ogg_packet &oggPacket);
 		void setEndOfVideo() { _endOfVideo = true; }
 
+		void setPostProcessingLevel(int level);
+		int getMaxPostProcessingLevel() const { return _postProcessingMax; }
+
 	private:
 		int _curFrame;
 		bool _endOfVideo;
@@ -101,6 +119,7 @@ private:
 		Graphics::Surface _displaySurface;
 
 		th_dec_ctx *_theoraDecode;
+		int _postProcessingMax;
 
 		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
 	};
@@ -27,12 +27,43 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/memtracker.h"
+#include "common/profiler.h"
+#include "common/rect.h"
 #include "common/system.h"
 
+#include "graphics/conversion.h"
 #include "graphics/palette.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
 
 namespace Video {
 
+/** A frame decoded ahead, and the state of the tracks right after decoding it */
+struct VideoDecoder::DecodedFrame {
+	Graphics::Surface surface;
+	bool hasSurface;
+	bool dirtyPalette;
+	byte palette[256 * 3];
+	DecodeAheadState state;
+	Common::MemoryUsage memoryUsage;
+
+	DecodedFrame() : hasSurface(false), dirtyPalette(false), memoryUsage(Common::kMemoryVideo) {}
+};
+
+/** Decodes one frame ahead and schedules itself again while there is room */
+class VideoDecoder::DecodeAheadTask : public Common::Task {
+public:
+	DecodeAheadTask(VideoDecoder &decoder) : _decoder(decoder) {}
+
+	virtual void run() {
+		_decoder.runDecodeAhead();
+	}
+
+private:
+	VideoDecoder &_decoder;
+};
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -49,6 +80,12 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAheadFrameCount = 0;
+	_decodeAheadActive = false;
+	_shownFrame = 0;
+	_decodeAheadRunning = false;
+	_decodeAheadEnded = false;
+	_decodeAheadSuspendLevel = 0;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -57,7 +94,13 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	freeDecodeAhead();
+}
+
 void VideoDecoder::close() {
+	freeDecodeAhead();
+
 	if (isPlaying())
 		stop();
 
@@ -113,11 +156,15 @@ void VideoDecoder::pauseVideo(bool pause) {
 	if (_pauseLevel == 1 && pause) {
 		_pauseStartTime = g_system->getMillis(); // Store the starting time from pausing to keep it for later
 
+		suspendDecodeAhead();
 		for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 			(*it)->pause(true);
+		resumeDecodeAhead();
 	} else if (_pauseLevel == 0) {
+		suspendDecodeAhead();
 		for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 			(*it)->pause(false);
+		resumeDecodeAhead();
 
 		_startTime += (g_system->getMillis() - _pauseStartTime);
 	}
@@ -182,9 +229,13 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	if (useDecodeAhead())
+		return takeDecodedFrame();
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -205,23 +256,59 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+bool VideoDecoder::decodeNextFrameInto(Graphics::Surface &dst) {
+	// Frames decoded ahead are copies already
+	VideoTrack *track = useDecodeAhead() ? 0 : _nextVideoTrack;
+
+	if (track)
+		track->setOutputSurface(&dst);
+
+	const Graphics::Surface *frame = decodeNextFrame();
+
+	if (track)
+		track->setOutputSurface(0);
+
+	if (!frame)
+		return false;
+
+	// Copy frames which did not end up in the surface
+	if (frame->getPixels() != dst.getPixels()) {
+		const int width = MIN<int>(frame->w, dst.w);
+		const int height = MIN<int>(frame->h, dst.h);
+
+		if (!Graphics::crossBlit((byte *)dst.getPixels(), (const byte *)frame->getPixels(), dst.pitch, frame->pitch, width, height, dst.format, frame->format))
+			warning("VideoDecoder::decodeNextFrameInto(): Cannot convert the frame to the surface format");
+	}
+
+	return true;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	suspendDecodeAhead();
+
 	// Attempt to make sure all the tracks are in the requested direction
-	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+	bool result = true;
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end() && result; it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
-			if (!((VideoTrack *)*it)->setReverse(reverse))
-				return false;
+			// The frames decoded ahead were decoded in the other direction
+			flushDecodeAhead();
 
-			_needsUpdate = true; // force an update
+			if (!((VideoTrack *)*it)->setReverse(reverse))
+				result = false;
+			else
+				_needsUpdate = true; // force an update
 		}
 	}
 
-	findNextVideoTrack();
-	return true;
+	if (result && !_decodeAheadActive)
+		findNextVideoTrack();
+
+	resumeDecodeAhead();
+	return result;
 }
 
 const byte *VideoDecoder::getPalette() {
@@ -230,6 +317,9 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	if (_decodeAheadActive)
+		return _shownState.curFrame;
+
 	int32 frame = -1;
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
@@ -271,13 +361,29 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	if (endOfVideo() || _needsUpdate)
 		return 0;
 
+	uint32 nextFrameStartTime;
+	bool reversed;
+
+	if (_decodeAheadActive) {
+		if (_shownState.nextTrack < 0)
+			return 0;
+
+		nextFrameStartTime = _shownState.videoTracks[_shownState.nextTrack].nextFrameStartTime;
+		reversed = _shownState.nextTrackReversed;
+	} else {
+		if (!_nextVideoTrack)
+			return 0;
+
+		nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+		reversed = _nextVideoTrack->isReversed();
+	}
+
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
 
-	if (_nextVideoTrack->isReversed()) {
+	if (reversed) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -293,11 +399,20 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	uint videoTrack = 0;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
+		bool endReached;
+
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			const VideoTrackStatus status = getVideoTrackStatus((const VideoTrack *)track, videoTrack++);
+			bool videoEndTimeReached = _endTimeSet && status.nextFrameStartTime >= (uint)_endTime.msecs();
+			endReached = status.endOfTrack || (isPlaying() && videoEndTimeReached);
+		} else {
+			endReached = track->endOfTrack();
+		}
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -320,6 +435,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	flushDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -354,6 +471,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	flushDecodeAhead();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -439,8 +558,10 @@ void VideoDecoder::stop() {
 	_pauseLevel = 0;
 
 	// Reset the pause state of the tracks too
+	suspendDecodeAhead();
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		(*it)->pause(false);
+	resumeDecodeAhead();
 }
 
 void VideoDecoder::setRate(const Common::Rational &rate) {
@@ -915,14 +1036,16 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
+	uint videoTrack = 0;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
 			continue;
 
-		const VideoTrack *track = (const VideoTrack *)*it;
+		const VideoTrackStatus status = getVideoTrackStatus((const VideoTrack *)*it, videoTrack++);
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && status.nextFrameStartTime >= (uint)_endTime.msecs();
+		bool endReached = status.endOfTrack || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -938,6 +1061,245 @@ bool VideoDecoder::hasAudio() const {
 	return false;
 }
 
+void VideoDecoder::setDecodeAhead(uint frameCount) {
+	if (frameCount == _decodeAheadFrameCount)
+		return;
+
+	freeDecodeAhead();
+	_decodeAheadFrameCount = frameCount;
+}
+
+bool VideoDecoder::useDecodeAhead() const {
+	return _decodeAheadFrameCount != 0 && !g_system->getTaskScheduler()->isSerial();
+}
+
+const Graphics::Surface *VideoDecoder::takeDecodedFrame() {
+	if (!_decodeAheadActive) {
+		// Start decoding ahead from where the tracks are now. One more
+		// frame than the queue holds is needed for the frame being shown.
+		if (_decodedFrames.empty()) {
+			for (uint i = 0; i < _decodeAheadFrameCount + 1; i++)
+				_decodedFrames.push_back(new DecodedFrame());
+		}
+
+		getDecodeAheadState(_shownState);
+
+		// Singletons are not created thread-safely, and the decode task may
+		// be the first to convert a YUV frame
+		Graphics::YUVToRGBManager::instance();
+
+		Common::StackLock lock(_decodeAheadMutex);
+		_freeFrames = _decodedFrames;
+		_decodeAheadEnded = false;
+		_decodeAheadActive = true;
+	} else if (_shownFrame) {
+		// The frame returned last time may be reused now
+		Common::StackLock lock(_decodeAheadMutex);
+		_freeFrames.push_back(_shownFrame);
+	}
+
+	_shownFrame = 0;
+	scheduleDecodeAhead();
+
+	DecodedFrame *frame = 0;
+	while (!frame) {
+		Common::TaskFuture future;
+
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+			if (!_readyFrames.empty())
+				frame = _readyFrames.pop();
+			else if (!_decodeAheadRunning)
+				return 0; // The end of the video tracks was reached
+			else
+				future = _decodeAheadFuture;
+		}
+
+		if (!frame)
+			future.wait();
+	}
+
+	_shownFrame = frame;
+	_shownState = frame->state;
+
+	if (frame->dirtyPalette) {
+		memcpy(_decodeAheadPalette, frame->palette, sizeof(_decodeAheadPalette));
+		_palette = _decodeAheadPalette;
+		_dirtyPalette = true;
+	}
+
+	return frame->hasSurface ? &frame->surface : 0;
+}
+
+void VideoDecoder::runDecodeAhead() {
+	DecodedFrame *frame;
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		if (_decodeAheadSuspendLevel || _freeFrames.empty()) {
+			_decodeAheadRunning = false;
+			return;
+		}
+
+		frame = _freeFrames.back();
+		_freeFrames.pop_back();
+	}
+
+	decodeFrameAhead(*frame);
+
+	Common::StackLock lock(_decodeAheadMutex);
+	_readyFrames.push(frame);
+
+	// Without a next video track, there are no frames left to decode
+	_decodeAheadEnded = frame->state.nextTrack < 0;
+
+	if (_decodeAheadEnded || _decodeAheadSuspendLevel || _freeFrames.empty())
+		_decodeAheadRunning = false;
+	else
+		_decodeAheadFuture = g_system->getTaskScheduler()->schedule(new DecodeAheadTask(*this));
+}
+
+void VideoDecoder::decodeFrameAhead(DecodedFrame &frame) {
+	// This does what decodeNextFrame() does without decoding ahead
+	readNextPacket();
+
+	frame.hasSurface = false;
+	frame.dirtyPalette = false;
+
+	if (_nextVideoTrack) {
+		const Graphics::Surface *surface = _nextVideoTrack->decodeNextFrame();
+
+		if (surface) {
+			// The track reuses its surface, so keep a copy
+			if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format) {
+				frame.surface.free();
+				frame.surface.create(surface->w, surface->h, surface->format);
+				frame.memoryUsage.set(frame.surface.h * frame.surface.pitch);
+			}
+
+			frame.surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+			frame.hasSurface = true;
+		}
+
+		if (_nextVideoTrack->hasDirtyPalette()) {
+			memcpy(frame.palette, _nextVideoTrack->getPalette(), sizeof(frame.palette));
+			frame.dirtyPalette = true;
+		}
+
+		findNextVideoTrack();
+	}
+
+	getDecodeAheadState(frame.state);
+}
+
+void VideoDecoder::getDecodeAheadState(DecodeAheadState &state) const {
+	state.videoTracks.resize(0);
+	state.curFrame = -1;
+	state.nextTrack = -1;
+	state.nextTrackReversed = false;
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
+			continue;
+
+		const VideoTrack *track = (const VideoTrack *)*it;
+
+		if (track == _nextVideoTrack) {
+			state.nextTrack = state.videoTracks.size();
+			state.nextTrackReversed = track->isReversed();
+		}
+
+		VideoTrackStatus status;
+		status.endOfTrack = track->endOfTrack();
+		status.nextFrameStartTime = track->getNextFrameStartTime();
+		state.videoTracks.push_back(status);
+		state.curFrame += track->getCurFrame() + 1;
+	}
+}
+
+VideoDecoder::VideoTrackStatus VideoDecoder::getVideoTrackStatus(const VideoTrack *track, uint index) const {
+	if (_decodeAheadActive)
+		return _shownState.videoTracks[index];
+
+	VideoTrackStatus status;
+	status.endOfTrack = track->endOfTrack();
+	status.nextFrameStartTime = track->getNextFrameStartTime();
+	return status;
+}
+
+void VideoDecoder::scheduleDecodeAhead() {
+	Common::StackLock lock(_decodeAheadMutex);
+
+	if (!_decodeAheadActive || _decodeAheadRunning || _decodeAheadEnded || _decodeAheadSuspendLevel || _freeFrames.empty())
+		return;
+
+	_decodeAheadRunning = true;
+	_decodeAheadFuture = g_system->getTaskScheduler()->schedule(new DecodeAheadTask(*this));
+}
+
+void VideoDecoder::suspendDecodeAhead() {
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadSuspendLevel++;
+	}
+
+	// Wait for the frame being decoded, the next one is not started anymore
+	while (true) {
+		Common::TaskFuture future;
+
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+			if (!_decodeAheadRunning)
+				return;
+
+			future = _decodeAheadFuture;
+		}
+
+		future.wait();
+	}
+}
+
+void VideoDecoder::resumeDecodeAhead() {
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		assert(_decodeAheadSuspendLevel);
+		_decodeAheadSuspendLevel--;
+	}
+
+	scheduleDecodeAhead();
+}
+
+void VideoDecoder::flushDecodeAhead() {
+	if (!_decodeAheadActive)
+		return;
+
+	suspendDecodeAhead();
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		_readyFrames.clear();
+		_freeFrames.clear();
+		_decodeAheadFuture = Common::TaskFuture();
+	}
+
+	// The tracks are where the last frame decoded ahead left them
+	_shownFrame = 0;
+	_decodeAheadActive = false;
+
+	resumeDecodeAhead();
+}
+
+void VideoDecoder::freeDecodeAhead() {
+	flushDecodeAhead();
+
+	for (uint i = 0; i < _decodedFrames.size(); i++) {
+		_decodedFrames[i]->surface.free();
+		delete _decodedFrames[i];
+	}
+
+	_decodedFrames.clear();
+}
+
 void VideoDecoder::eraseTrack(Track *track) {
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
@@ -26,8 +26,11 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/mutex.h"
+#include "common/queue.h"
 #include "common/rational.h"
 #include "common/str.h"
+#include "common/taskscheduler.h"
 #include "graphics/pixelformat.h"
 
 namespace Audio {
@@ -52,7 +55,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -355,6 +358,54 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame straight into the given surface.
+	 *
+	 * Tracks whose codec can decode into outside memory skip the copy from
+	 * their own surface; the others decode as usual and the frame is copied.
+	 * The surface can be the screen returned by OSystem::lockScreen(), or an
+	 * area of it, and must have the video's size and pixel format.
+	 *
+	 * Most codecs only update the parts of a frame which changed, so keep
+	 * the surface untouched between frames. Going back to decodeNextFrame()
+	 * afterwards is only safe after seeking or rewinding.
+	 *
+	 * @param dst the surface to decode into
+	 * @return whether a frame was decoded; if not, the last frame should be
+	 *         kept on screen
+	 */
+	bool decodeNextFrameInto(Graphics::Surface &dst);
+
+	/**
+	 * Decode frames ahead on the task scheduler.
+	 *
+	 * Once enabled, the frames following the one just returned by
+	 * decodeNextFrame() are decoded in the background into a bounded queue,
+	 * and decodeNextFrame() only waits when the queue is empty. A frame which
+	 * takes longer than its display interval to decode, like a keyframe, then
+	 * does not cause a hitch. The decoded frames are copies, so this costs one
+	 * extra copy and a few surfaces worth of memory per frame.
+	 *
+	 * Seeking and rewinding drop the queued frames. Changing the direction
+	 * with setReverse() drops them as well, so the frames which were queued
+	 * are skipped. This has no effect with a serial task scheduler.
+	 *
+	 * @note The tracks are decoded on another thread. Only use this when the
+	 *       subclass does not touch its tracks or stream outside of
+	 *       readNextPacket() and the track functions called by this class,
+	 *       and when it calls close() from its destructor.
+	 *
+	 * @param frameCount The maximum number of frames to decode ahead, or 0 to
+	 *                   decode every frame when it is requested (the default)
+	 */
+	void setDecodeAhead(uint frameCount);
+
+	/**
+	 * Get the maximum number of frames decoded ahead.
+	 * @see setDecodeAhead()
+	 */
+	uint getDecodeAhead() const { return _decodeAheadFrameCount; }
+
 	/**
 	 * Set the default high color format for videos that convert from YUV.
 	 *
@@ -603,6 +654,14 @@ protected:
 		 */
 		virtual const Graphics::Surface *decodeNextFrame() = 0;
 
+		/**
+		 * Decode the following frames into the given surface where possible,
+		 * or into the track's own surface again for 0.
+		 *
+		 * @see VideoDecoder::decodeNextFrameInto()
+		 */
+		virtual void setOutputSurface(Graphics::Surface *surface) {}
+
 		/**
 		 * Get the palette currently in use by this track
 		 */
@@ -926,6 +985,18 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Wait for the frame being decoded ahead, and do not start decoding
+	 * another one until resumeDecodeAhead() is called. The tracks may be
+	 * changed in between. Calls can be nested.
+	 */
+	void suspendDecodeAhead();
+
+	/**
+	 * Let decode ahead continue after suspendDecodeAhead().
+	 */
+	void resumeDecodeAhead();
+
 private:
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
@@ -964,6 +1035,61 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decoding ahead
+	class DecodeAheadTask;
+	friend class DecodeAheadTask;
+	struct DecodedFrame;
+
+	/** What a video track reported after decoding a frame */
+	struct VideoTrackStatus {
+		bool endOfTrack;
+		uint32 nextFrameStartTime;
+	};
+
+	/** The state of the video tracks after decoding a frame */
+	struct DecodeAheadState {
+		/** The status of each video track, in track order */
+		Common::Array<VideoTrackStatus> videoTracks;
+		int curFrame;
+		/** Index of the next video track in videoTracks, or -1 */
+		int nextTrack;
+		bool nextTrackReversed;
+	};
+
+	uint _decodeAheadFrameCount;
+
+	/**
+	 * Whether frames are being decoded ahead. While this is set, only the
+	 * decode ahead task touches the video tracks, and the playback status
+	 * comes from _shownState instead.
+	 */
+	bool _decodeAheadActive;
+	DecodeAheadState _shownState;
+	DecodedFrame *_shownFrame;
+	byte _decodeAheadPalette[256 * 3];
+
+	// All decoded frames, and whether they are free or queued
+	Common::Array<DecodedFrame *> _decodedFrames;
+
+	// Guards the members below, which are shared with the decode ahead task
+	Common::Mutex _decodeAheadMutex;
+	Common::Array<DecodedFrame *> _freeFrames;
+	Common::Queue<DecodedFrame *> _readyFrames;
+	Common::TaskFuture _decodeAheadFuture;
+	bool _decodeAheadRunning;
+	bool _decodeAheadEnded;
+	uint _decodeAheadSuspendLevel;
+
+	bool useDecodeAhead() const;
+	const Graphics::Surface *takeDecodedFrame();
+	void runDecodeAhead();
+	void decodeFrameAhead(DecodedFrame &frame);
+	void getDecodeAheadState(DecodeAheadState &state) const;
+	VideoTrackStatus getVideoTrackStatus(const VideoTrack *track, uint index) const;
+	void scheduleDecodeAhead();
+	void flushDecodeAhead();
+	void freeDecodeAhead();
 };
 
 } // End of namespace Video